@@ -77,6 +77,75 @@ static void AutoTexturization_AutoTexturizeInto(benchmark::State& state)
 }
 BENCHMARK(AutoTexturization_AutoTexturizeInto);
 
+//
+// Brush-sized region, below the parallelization threshold
+//
+static void AutoTexturization_AutoTexturizeInto_SmallRegion(benchmark::State& state)
+{
+    ResourceLocator const resourceLocator = ResourceLocator(std::filesystem::current_path());
+    MaterialDatabase const materialDatabase = MaterialDatabase::Load(resourceLocator.GetMaterialDatabaseRootFilePath());
+    ShipTexturizer texturizer(materialDatabase, resourceLocator);
+
+    // Create structural layer
+    StructuralLayerData structuralLayer(StructureSize);
+    auto const & materialCategories = materialDatabase.GetStructuralMaterialPalette().Categories;
+    size_t currentCategory = 0;
+    size_t currentSubCategory = 0;
+    for (int y = 0; y < structuralLayer.Buffer.Size.height; ++y)
+    {
+        for (int x = 0; x < structuralLayer.Buffer.Size.width; ++x)
+        {
+            StructuralMaterial const * material = &materialCategories[currentCategory].SubCategories[currentSubCategory].Materials[0].get();
+            structuralLayer.Buffer[{x, y}].Material = material;
+
+            // Move to next sub-category
+            ++currentSubCategory;
+            if (currentSubCategory >= materialCategories[currentCategory].SubCategories.size())
+            {
+                currentSubCategory = 0;
+                ++currentCategory;
+                if (currentCategory >= materialCategories.size())
+                {
+                    currentCategory = 0;
+                }
+            }
+        }
+    }
+
+    // Create target texture
+    int const magnificationFactor = ShipTexturizer::CalculateHighDefinitionTextureMagnificationFactor(StructureSize);
+    ImageSize const textureSize = ImageSize(
+        StructureSize.width * magnificationFactor,
+        StructureSize.height * magnificationFactor);
+    RgbaImageData targetTextureImage = RgbaImageData(textureSize);
+
+    // Create settings
+    ShipAutoTexturizationSettings settings;
+    settings.Mode = ShipAutoTexturizationModeType::MaterialTextures;
+
+    ShipSpaceSize const regionSize = ShipSpaceSize(8, 8);
+
+    // Test
+    for (auto _ : state)
+    {
+        for (size_t i = 0; i < Repetitions * 1000; ++i)
+        {
+            // Sweep the region across the ship, like a stroke would
+            ShipSpaceCoordinates const regionOrigin = ShipSpaceCoordinates(
+                static_cast<int>((i * 3) % static_cast<size_t>(StructureSize.width - regionSize.width)),
+                static_cast<int>((i * 7) % static_cast<size_t>(StructureSize.height - regionSize.height)));
+
+            texturizer.AutoTexturizeInto(
+                structuralLayer,
+                ShipSpaceRect(regionOrigin, regionSize),
+                targetTextureImage,
+                magnificationFactor,
+                settings);
+        }
+    }
+}
+BENCHMARK(AutoTexturization_AutoTexturizeInto_SmallRegion);
+
 //
 // Original perf @ 800x400, 40 repetitions:
 // 3,341,784,000 ns 3,343,750,000 ns
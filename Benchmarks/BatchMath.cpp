@@ -0,0 +1,237 @@
+#include "Utils.h"
+
+#include <GameCore/BatchMath.h>
+#include <GameCore/SysSpecifics.h>
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+//
+// A single matrix of all functions in BatchMath, times all of their back ends;
+// each benchmark reports its throughput, together with the max relative error
+// of its results against the standard library.
+//
+
+static constexpr size_t Size = 100000;
+
+static std::vector<float> MakeRange(
+    float minValue,
+    float maxValue)
+{
+    // Golden-ratio sequence, so that values are spread evenly but not sorted
+    std::vector<float> values(Size);
+    for (size_t i = 0; i < Size; ++i)
+    {
+        double const fraction = std::fmod(static_cast<double>(i) * 0.6180339887, 1.0);
+        values[i] = minValue + (maxValue - minValue) * static_cast<float>(fraction);
+    }
+
+    return values;
+}
+
+static float CalculateMaxRelativeError(
+    std::vector<float> const & expected,
+    std::vector<float> const & actual)
+{
+    float maxError = 0.0f;
+    for (size_t i = 0; i < expected.size(); ++i)
+    {
+        if (expected[i] != 0.0f)
+            maxError = std::max(maxError, std::abs((actual[i] - expected[i]) / expected[i]));
+        else
+            maxError = std::max(maxError, std::abs(actual[i]));
+    }
+
+    return maxError;
+}
+
+static bool CheckBackend(
+    benchmark::State & state,
+    bool isAVX2)
+{
+    if (isAVX2 && !IsAVX2Supported())
+    {
+        state.SkipWithError("AVX2 is not supported");
+        return false;
+    }
+
+    return true;
+}
+
+static void Finish(
+    benchmark::State & state,
+    std::vector<float> const & expected,
+    std::vector<float> const & actual)
+{
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * Size));
+    state.counters["MaxRelError"] = CalculateMaxRelativeError(expected, actual);
+}
+
+using UnaryFunction = void(*)(float const *, float *, size_t);
+using PowFunction = void(*)(float const *, float, float *, size_t);
+using StepFunction = void(*)(float, float const *, float *, size_t);
+using NormalizeFunction = void(*)(vec2f const *, vec2f *, size_t);
+using LengthFunction = void(*)(vec2f const *, float *, size_t);
+
+static void BatchMath_FastExp(benchmark::State & state, UnaryFunction function, bool isAVX2)
+{
+    if (!CheckBackend(state, isAVX2))
+        return;
+
+    auto const x = MakeRange(-20.0f, 20.0f);
+    std::vector<float> expected(Size);
+    std::transform(x.cbegin(), x.cend(), expected.begin(), [](float v) { return std::exp(v); });
+
+    std::vector<float> results(Size);
+    for (auto _ : state)
+    {
+        function(x.data(), results.data(), Size);
+        benchmark::ClobberMemory();
+    }
+
+    Finish(state, expected, results);
+}
+
+static void BatchMath_FastLog(benchmark::State & state, UnaryFunction function, bool isAVX2)
+{
+    if (!CheckBackend(state, isAVX2))
+        return;
+
+    auto const x = MakeRange(0.01f, 1000.0f);
+    std::vector<float> expected(Size);
+    std::transform(x.cbegin(), x.cend(), expected.begin(), [](float v) { return std::log(v); });
+
+    std::vector<float> results(Size);
+    for (auto _ : state)
+    {
+        function(x.data(), results.data(), Size);
+        benchmark::ClobberMemory();
+    }
+
+    Finish(state, expected, results);
+}
+
+static void BatchMath_FastPow(benchmark::State & state, PowFunction function, bool isAVX2)
+{
+    if (!CheckBackend(state, isAVX2))
+        return;
+
+    float constexpr Exponent = 1.7f;
+
+    auto const x = MakeRange(0.01f, 100.0f);
+    std::vector<float> expected(Size);
+    std::transform(x.cbegin(), x.cend(), expected.begin(), [](float v) { return std::pow(v, Exponent); });
+
+    std::vector<float> results(Size);
+    for (auto _ : state)
+    {
+        function(x.data(), Exponent, results.data(), Size);
+        benchmark::ClobberMemory();
+    }
+
+    Finish(state, expected, results);
+}
+
+static void BatchMath_Step(benchmark::State & state, StepFunction function, bool isAVX2)
+{
+    if (!CheckBackend(state, isAVX2))
+        return;
+
+    auto const x = MakeRange(-1.0f, 1.0f);
+    std::vector<float> expected(Size);
+    std::transform(x.cbegin(), x.cend(), expected.begin(), [](float v) { return v < 0.0f ? 0.0f : 1.0f; });
+
+    std::vector<float> results(Size);
+    for (auto _ : state)
+    {
+        function(0.0f, x.data(), results.data(), Size);
+        benchmark::ClobberMemory();
+    }
+
+    Finish(state, expected, results);
+}
+
+static void BatchMath_Normalize(benchmark::State & state, NormalizeFunction function, bool isAVX2)
+{
+    if (!CheckBackend(state, isAVX2))
+        return;
+
+    auto const vectors = MakeVectors(Size);
+
+    // Accuracy is measured on the x components
+    std::vector<float> expected(Size);
+    for (size_t i = 0; i < Size; ++i)
+    {
+        double const length = std::sqrt(static_cast<double>(vectors[i].x) * vectors[i].x + static_cast<double>(vectors[i].y) * vectors[i].y);
+        expected[i] = length != 0.0 ? static_cast<float>(vectors[i].x / length) : 0.0f;
+    }
+
+    std::vector<vec2f> results(Size);
+    for (auto _ : state)
+    {
+        function(vectors.get(), results.data(), Size);
+        benchmark::ClobberMemory();
+    }
+
+    std::vector<float> resultsX(Size);
+    std::transform(results.cbegin(), results.cend(), resultsX.begin(), [](vec2f const & v) { return v.x; });
+    Finish(state, expected, resultsX);
+}
+
+static void BatchMath_Length(benchmark::State & state, LengthFunction function, bool isAVX2)
+{
+    if (!CheckBackend(state, isAVX2))
+        return;
+
+    auto const vectors = MakeVectors(Size);
+
+    std::vector<float> expected(Size);
+    for (size_t i = 0; i < Size; ++i)
+    {
+        expected[i] = static_cast<float>(std::sqrt(static_cast<double>(vectors[i].x) * vectors[i].x + static_cast<double>(vectors[i].y) * vectors[i].y));
+    }
+
+    std::vector<float> results(Size);
+    for (auto _ : state)
+    {
+        function(vectors.get(), results.data(), Size);
+        benchmark::ClobberMemory();
+    }
+
+    Finish(state, expected, results);
+}
+
+BENCHMARK_CAPTURE(BatchMath_FastExp, Naive, BatchMath::FastExp_Naive, false);
+BENCHMARK_CAPTURE(BatchMath_FastLog, Naive, BatchMath::FastLog_Naive, false);
+BENCHMARK_CAPTURE(BatchMath_FastPow, Naive, BatchMath::FastPow_Naive, false);
+BENCHMARK_CAPTURE(BatchMath_Step, Naive, BatchMath::Step_Naive, false);
+BENCHMARK_CAPTURE(BatchMath_Normalize, Naive, BatchMath::Normalize_Naive, false);
+BENCHMARK_CAPTURE(BatchMath_Length, Naive, BatchMath::Length_Naive, false);
+
+#if FS_IS_ARCHITECTURE_X86_32() || FS_IS_ARCHITECTURE_X86_64()
+BENCHMARK_CAPTURE(BatchMath_FastExp, SSE2, BatchMath::FastExp_SSE2, false);
+BENCHMARK_CAPTURE(BatchMath_FastLog, SSE2, BatchMath::FastLog_SSE2, false);
+BENCHMARK_CAPTURE(BatchMath_FastPow, SSE2, BatchMath::FastPow_SSE2, false);
+BENCHMARK_CAPTURE(BatchMath_Step, SSE2, BatchMath::Step_SSE2, false);
+BENCHMARK_CAPTURE(BatchMath_Normalize, SSE2, BatchMath::Normalize_SSE2, false);
+BENCHMARK_CAPTURE(BatchMath_Length, SSE2, BatchMath::Length_SSE2, false);
+
+BENCHMARK_CAPTURE(BatchMath_FastExp, AVX2, BatchMath::FastExp_AVX2, true);
+BENCHMARK_CAPTURE(BatchMath_FastLog, AVX2, BatchMath::FastLog_AVX2, true);
+BENCHMARK_CAPTURE(BatchMath_FastPow, AVX2, BatchMath::FastPow_AVX2, true);
+BENCHMARK_CAPTURE(BatchMath_Step, AVX2, BatchMath::Step_AVX2, true);
+BENCHMARK_CAPTURE(BatchMath_Normalize, AVX2, BatchMath::Normalize_AVX2, true);
+BENCHMARK_CAPTURE(BatchMath_Length, AVX2, BatchMath::Length_AVX2, true);
+#endif
+
+#if FS_IS_ARCHITECTURE_ARM_64()
+BENCHMARK_CAPTURE(BatchMath_FastExp, NEON, BatchMath::FastExp_NEON, false);
+BENCHMARK_CAPTURE(BatchMath_FastLog, NEON, BatchMath::FastLog_NEON, false);
+BENCHMARK_CAPTURE(BatchMath_FastPow, NEON, BatchMath::FastPow_NEON, false);
+BENCHMARK_CAPTURE(BatchMath_Step, NEON, BatchMath::Step_NEON, false);
+BENCHMARK_CAPTURE(BatchMath_Normalize, NEON, BatchMath::Normalize_NEON, false);
+BENCHMARK_CAPTURE(BatchMath_Length, NEON, BatchMath::Length_NEON, false);
+#endif
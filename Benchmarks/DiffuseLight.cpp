@@ -72,3 +72,60 @@ static void DiffuseLight_Vectorized(benchmark::State & state)
     benchmark::DoNotOptimize(outLightBuffer);
 }
 BENCHMARK(DiffuseLight_Vectorized)->Arg(4)->Arg(8)->Arg(16)->Arg(32)->Arg(128);
+
+static void DiffuseLight_Culled(benchmark::State & state)
+{
+    // Points laid out in rows - as in a ship - with lamps scattered among them
+    size_t constexpr RowWidth = 500;
+
+    auto const pointsSize = MakeSize(SampleSize);
+    auto const lampsSize = static_cast<size_t>(state.range(0));
+    auto const bufferLampsSize = make_aligned_float_element_count(lampsSize);
+
+    auto pointPositions = make_unique_buffer_aligned_to_vectorization_word<vec2f>(pointsSize);
+    for (size_t p = 0; p < pointsSize; ++p)
+    {
+        pointPositions[p] = vec2f(static_cast<float>(p % RowWidth), static_cast<float>(p / RowWidth));
+    }
+
+    auto pointPlaneIds = MakePlaneIds(pointsSize);
+
+    auto lampPositions = make_unique_buffer_aligned_to_vectorization_word<vec2f>(lampsSize);
+    for (size_t l = 0; l < lampsSize; ++l)
+    {
+        lampPositions[l] = pointPositions[(l * 7919) % pointsSize];
+    }
+
+    auto lampPlaneIds = MakePlaneIds(lampsSize);
+    auto lampDistanceCoeffs = MakeFloats(lampsSize, 0.1f);
+    auto lampSpreadMaxDistances = MakeFloats(lampsSize, 10.0f);
+
+    auto culledLampPositions = make_unique_buffer_aligned_to_vectorization_word<vec2f>(bufferLampsSize);
+    auto culledLampPlaneIds = make_unique_buffer_aligned_to_vectorization_word<PlaneId>(bufferLampsSize);
+    auto culledLampDistanceCoeffs = make_unique_buffer_aligned_to_vectorization_word<float>(bufferLampsSize);
+    auto culledLampSpreadMaxDistances = make_unique_buffer_aligned_to_vectorization_word<float>(bufferLampsSize);
+
+    auto outLightBuffer = make_unique_buffer_aligned_to_vectorization_word<float>(pointsSize);
+
+    for (auto _ : state)
+    {
+        Algorithms::DiffuseLight_Culled(
+            pointPositions.get(),
+            pointPlaneIds.get(),
+            ElementIndex(0),
+            ElementIndex(pointsSize),
+            lampPositions.get(),
+            lampPlaneIds.get(),
+            lampDistanceCoeffs.get(),
+            lampSpreadMaxDistances.get(),
+            ElementIndex(lampsSize),
+            culledLampPositions.get(),
+            culledLampPlaneIds.get(),
+            culledLampDistanceCoeffs.get(),
+            culledLampSpreadMaxDistances.get(),
+            outLightBuffer.get());
+    }
+
+    benchmark::DoNotOptimize(outLightBuffer);
+}
+BENCHMARK(DiffuseLight_Culled)->Arg(4)->Arg(8)->Arg(16)->Arg(32)->Arg(128)->Arg(512);
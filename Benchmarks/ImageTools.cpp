@@ -0,0 +1,186 @@
+#include <GameCore/ImageData.h>
+#include <GameCore/ImageTools.h>
+#include <GameCore/TaskThreadPool.h>
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+
+//
+// Per-pixel image operations on a large texture: the per-pixel rgbaColor methods
+// they are made of (Scalar), vs. their SIMD implementation (Serial), vs. their SIMD
+// implementation over parallel row tiles (Parallel).
+//
+
+static constexpr ImageSize Size = ImageSize(4096, 4096);
+
+static RgbaImageData MakeImage()
+{
+    auto data = std::make_unique<rgbaColor[]>(Size.GetLinearSize());
+    for (size_t i = 0; i < Size.GetLinearSize(); ++i)
+    {
+        auto const v = static_cast<std::uint32_t>(i) * 2654435761u;
+        data[i] = rgbaColor(
+            static_cast<std::uint8_t>(v >> 24),
+            static_cast<std::uint8_t>(v >> 16),
+            static_cast<std::uint8_t>(v >> 8),
+            static_cast<std::uint8_t>(v));
+    }
+
+    return RgbaImageData(Size, std::move(data));
+}
+
+static TaskThreadPool * GetTaskThreadPool(bool isParallel)
+{
+    static TaskThreadPool taskThreadPool;
+    return isParallel ? &taskThreadPool : nullptr;
+}
+
+static void Finish(benchmark::State & state)
+{
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * Size.GetLinearSize()));
+}
+
+static void ImageTools_BlendWithColor_Scalar(benchmark::State & state)
+{
+    auto image = MakeImage();
+
+    for (auto _ : state)
+    {
+        for (size_t i = 0; i < Size.GetLinearSize(); ++i)
+        {
+            image.Data[i] = image.Data[i].mix(rgbColor(12, 200, 77), 0.37f);
+        }
+
+        benchmark::DoNotOptimize(image.Data.get());
+    }
+
+    Finish(state);
+}
+BENCHMARK(ImageTools_BlendWithColor_Scalar);
+
+static void ImageTools_BlendWithColor(benchmark::State & state, bool isParallel)
+{
+    auto image = MakeImage();
+
+    for (auto _ : state)
+    {
+        ImageTools::BlendWithColor(image, rgbColor(12, 200, 77), 0.37f, GetTaskThreadPool(isParallel));
+        benchmark::DoNotOptimize(image.Data.get());
+    }
+
+    Finish(state);
+}
+BENCHMARK_CAPTURE(ImageTools_BlendWithColor, Serial, false);
+BENCHMARK_CAPTURE(ImageTools_BlendWithColor, Parallel, true);
+
+static void ImageTools_Overlay_Scalar(benchmark::State & state)
+{
+    auto base = MakeImage();
+    auto const overlay = MakeImage();
+
+    for (auto _ : state)
+    {
+        for (size_t i = 0; i < Size.GetLinearSize(); ++i)
+        {
+            base.Data[i] = base.Data[i].blend(overlay.Data[i]);
+        }
+
+        benchmark::DoNotOptimize(base.Data.get());
+    }
+
+    Finish(state);
+}
+BENCHMARK(ImageTools_Overlay_Scalar);
+
+static void ImageTools_Overlay(benchmark::State & state, bool isParallel)
+{
+    auto base = MakeImage();
+    auto const overlay = MakeImage();
+
+    for (auto _ : state)
+    {
+        ImageTools::Overlay(base, overlay, 0, 0, GetTaskThreadPool(isParallel));
+        benchmark::DoNotOptimize(base.Data.get());
+    }
+
+    Finish(state);
+}
+BENCHMARK_CAPTURE(ImageTools_Overlay, Serial, false);
+BENCHMARK_CAPTURE(ImageTools_Overlay, Parallel, true);
+
+static void ImageTools_AlphaPreMultiply_Scalar(benchmark::State & state)
+{
+    auto const original = MakeImage();
+    auto image = MakeImage();
+
+    for (auto _ : state)
+    {
+        // Pre-multiplying repeatedly would soon leave only zeroes
+        state.PauseTiming();
+        std::copy(original.Data.get(), original.Data.get() + Size.GetLinearSize(), image.Data.get());
+        state.ResumeTiming();
+
+        for (size_t i = 0; i < Size.GetLinearSize(); ++i)
+        {
+            image.Data[i].alpha_multiply();
+        }
+
+        benchmark::DoNotOptimize(image.Data.get());
+    }
+
+    Finish(state);
+}
+BENCHMARK(ImageTools_AlphaPreMultiply_Scalar);
+
+static void ImageTools_AlphaPreMultiply(benchmark::State & state, bool isParallel)
+{
+    auto const original = MakeImage();
+    auto image = MakeImage();
+
+    for (auto _ : state)
+    {
+        state.PauseTiming();
+        std::copy(original.Data.get(), original.Data.get() + Size.GetLinearSize(), image.Data.get());
+        state.ResumeTiming();
+
+        ImageTools::AlphaPreMultiply(image, GetTaskThreadPool(isParallel));
+        benchmark::DoNotOptimize(image.Data.get());
+    }
+
+    Finish(state);
+}
+BENCHMARK_CAPTURE(ImageTools_AlphaPreMultiply, Serial, false);
+BENCHMARK_CAPTURE(ImageTools_AlphaPreMultiply, Parallel, true);
+
+static void ImageTools_ToRgb(benchmark::State & state, bool isParallel)
+{
+    auto const image = MakeImage();
+
+    for (auto _ : state)
+    {
+        auto const rgb = ImageTools::ToRgb(image, GetTaskThreadPool(isParallel));
+        benchmark::DoNotOptimize(rgb.Data.get());
+    }
+
+    Finish(state);
+}
+BENCHMARK_CAPTURE(ImageTools_ToRgb, Serial, false);
+BENCHMARK_CAPTURE(ImageTools_ToRgb, Parallel, true);
+
+static void ImageTools_ToAlpha(benchmark::State & state, bool isParallel)
+{
+    auto const image = MakeImage();
+
+    for (auto _ : state)
+    {
+        auto const alpha = ImageTools::ToAlpha(image, GetTaskThreadPool(isParallel));
+        benchmark::DoNotOptimize(alpha.Data.get());
+    }
+
+    Finish(state);
+}
+BENCHMARK_CAPTURE(ImageTools_ToAlpha, Serial, false);
+BENCHMARK_CAPTURE(ImageTools_ToAlpha, Parallel, true);
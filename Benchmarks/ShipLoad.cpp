@@ -0,0 +1,303 @@
+#include <Game/FishSpeciesDatabase.h>
+#include <Game/GameEventDispatcher.h>
+#include <Game/GameParameters.h>
+#include <Game/ImageFileTools.h>
+#include <Game/MaterialDatabase.h>
+#include <Game/Physics.h>
+#include <Game/ResourceLocator.h>
+#include <Game/ShipDefinitionFormatDeSerializer.h>
+#include <Game/ShipFactory.h>
+#include <Game/ShipLegacyFormatDeSerializer.h>
+#include <Game/ShipStrengthRandomizer.h>
+#include <Game/ShipTexturizer.h>
+#include <Game/VisibleWorld.h>
+
+#include <GameCore/DeSerializationBuffer.h>
+#include <GameCore/GameTypes.h>
+#include <GameCore/ImageData.h>
+#include <GameCore/TaskThreadPool.h>
+
+#include <benchmark/benchmark.h>
+
+#include <array>
+#include <cstdint>
+#include <filesystem>
+#include <map>
+#include <memory>
+#include <string>
+
+//
+// The stages of loading a ship, over a corpus of small, medium, and huge ships, each
+// in both the .shp2 and the legacy (structural image) formats.
+//
+// The corpus is generated - and saved to a temporary folder - the first time it's
+// needed: each ship is an elliptical hull of all structural materials, with a texture
+// four times its size. Throughput is reported in bytes (of the files being read) and
+// in particles (the non-empty structural elements) per second.
+//
+
+namespace /* anonymous */ {
+
+struct CorpusShip
+{
+    std::string Name;
+    std::filesystem::path Shp2FilePath;
+    std::filesystem::path LegacyFilePath;
+    std::int64_t ParticleCount;
+    DeSerializationBuffer<BigEndianess> TexturePngBuffer;
+
+    CorpusShip()
+        : TexturePngBuffer(256)
+    {}
+};
+
+std::array<std::pair<char const *, ShipSpaceSize>, 3> const CorpusShipSizes = {
+    std::make_pair("Small", ShipSpaceSize(100, 40)),
+    std::make_pair("Medium", ShipSpaceSize(400, 160)),
+    std::make_pair("Huge", ShipSpaceSize(1600, 640))
+};
+
+int constexpr TextureMagnificationFactor = 4;
+
+ResourceLocator const & GetResourceLocator()
+{
+    static ResourceLocator const resourceLocator = ResourceLocator(std::filesystem::current_path());
+    return resourceLocator;
+}
+
+MaterialDatabase const & GetMaterialDatabase()
+{
+    static MaterialDatabase const materialDatabase = MaterialDatabase::Load(GetResourceLocator().GetMaterialDatabaseRootFilePath());
+    return materialDatabase;
+}
+
+CorpusShip MakeCorpusShip(size_t sizeIndex)
+{
+    auto const & [name, shipSize] = CorpusShipSizes[sizeIndex];
+
+    CorpusShip corpusShip;
+    corpusShip.Name = name;
+
+    std::filesystem::path const folderPath = std::filesystem::temp_directory_path() / "FloatingSandboxShipLoadBenchmarks";
+    std::filesystem::create_directories(folderPath);
+    corpusShip.Shp2FilePath = folderPath / (corpusShip.Name + ".shp2");
+    corpusShip.LegacyFilePath = folderPath / (corpusShip.Name + ".png");
+
+    //
+    // Structure: an elliptical hull, cycling through all materials
+    //
+
+    auto const & materialCategories = GetMaterialDatabase().GetStructuralMaterialPalette().Categories;
+
+    StructuralLayerData structuralLayer(shipSize);
+    RgbImageData legacyImage(ImageSize(shipSize.width, shipSize.height), EmptyMaterialColorKey);
+
+    corpusShip.ParticleCount = 0;
+    size_t currentCategory = 0;
+    size_t currentSubCategory = 0;
+    for (int y = 0; y < shipSize.height; ++y)
+    {
+        for (int x = 0; x < shipSize.width; ++x)
+        {
+            float const dx = (static_cast<float>(x) + 0.5f) / static_cast<float>(shipSize.width) * 2.0f - 1.0f;
+            float const dy = (static_cast<float>(y) + 0.5f) / static_cast<float>(shipSize.height) * 2.0f - 1.0f;
+            if (dx * dx + dy * dy > 1.0f)
+            {
+                continue;
+            }
+
+            StructuralMaterial const * material = &materialCategories[currentCategory].SubCategories[currentSubCategory].Materials[0].get();
+            structuralLayer.Buffer[{x, y}].Material = material;
+            legacyImage[{x, y}] = material->ColorKey;
+            ++corpusShip.ParticleCount;
+
+            // Move to next sub-category
+            ++currentSubCategory;
+            if (currentSubCategory >= materialCategories[currentCategory].SubCategories.size())
+            {
+                currentSubCategory = 0;
+                ++currentCategory;
+                if (currentCategory >= materialCategories.size())
+                {
+                    currentCategory = 0;
+                }
+            }
+        }
+    }
+
+    //
+    // Texture: a smooth pattern, which compresses as real textures do
+    //
+
+    ImageSize const textureSize(shipSize.width * TextureMagnificationFactor, shipSize.height * TextureMagnificationFactor);
+    RgbaImageData texture(textureSize);
+    for (int y = 0; y < textureSize.height; ++y)
+    {
+        for (int x = 0; x < textureSize.width; ++x)
+        {
+            texture[{x, y}] = rgbaColor(
+                static_cast<std::uint8_t>(x * 255 / textureSize.width),
+                static_cast<std::uint8_t>(y * 255 / textureSize.height),
+                static_cast<std::uint8_t>((x + y) % 256),
+                255);
+        }
+    }
+
+    ImageFileTools::EncodePngImage(texture, corpusShip.TexturePngBuffer);
+
+    //
+    // Save
+    //
+
+    ShipDefinition const shipDefinition(
+        shipSize,
+        ShipLayers(
+            std::move(structuralLayer),
+            nullptr,
+            nullptr,
+            std::make_unique<TextureLayerData>(std::move(texture))),
+        ShipMetadata(corpusShip.Name),
+        ShipPhysicsData(),
+        std::nullopt);
+
+    ShipDefinitionFormatDeSerializer::Save(shipDefinition, corpusShip.Shp2FilePath);
+
+    ImageFileTools::SavePngImage(legacyImage, corpusShip.LegacyFilePath);
+
+    return corpusShip;
+}
+
+CorpusShip const & GetCorpusShip(benchmark::State const & state)
+{
+    static std::map<size_t, CorpusShip> corpusShips;
+
+    size_t const sizeIndex = static_cast<size_t>(state.range(0));
+    auto it = corpusShips.find(sizeIndex);
+    if (it == corpusShips.end())
+    {
+        it = corpusShips.emplace(sizeIndex, MakeCorpusShip(sizeIndex)).first;
+    }
+
+    return it->second;
+}
+
+void SetThroughput(
+    benchmark::State & state,
+    CorpusShip const & corpusShip,
+    std::int64_t bytesPerIteration)
+{
+    state.SetLabel(corpusShip.Name);
+    state.SetBytesProcessed(static_cast<std::int64_t>(state.iterations()) * bytesPerIteration);
+    state.counters["particles"] = benchmark::Counter(
+        static_cast<double>(static_cast<std::int64_t>(state.iterations()) * corpusShip.ParticleCount),
+        benchmark::Counter::kIsRate);
+}
+
+}
+
+static void ShipLoad_Shp2_Load(benchmark::State & state)
+{
+    auto const & corpusShip = GetCorpusShip(state);
+    auto const & materialDatabase = GetMaterialDatabase();
+
+    for (auto _ : state)
+    {
+        auto shipDefinition = ShipDefinitionFormatDeSerializer::Load(corpusShip.Shp2FilePath, materialDatabase);
+        benchmark::DoNotOptimize(const_cast<ShipDefinition const &>(shipDefinition));
+    }
+
+    SetThroughput(state, corpusShip, static_cast<std::int64_t>(std::filesystem::file_size(corpusShip.Shp2FilePath)));
+}
+BENCHMARK(ShipLoad_Shp2_Load)->DenseRange(0, 2)->Unit(benchmark::kMillisecond);
+
+static void ShipLoad_Shp2_LoadPreviewData(benchmark::State & state)
+{
+    auto const & corpusShip = GetCorpusShip(state);
+
+    for (auto _ : state)
+    {
+        auto previewData = ShipDefinitionFormatDeSerializer::LoadPreviewData(corpusShip.Shp2FilePath);
+        benchmark::DoNotOptimize(previewData);
+    }
+
+    SetThroughput(state, corpusShip, static_cast<std::int64_t>(std::filesystem::file_size(corpusShip.Shp2FilePath)));
+}
+BENCHMARK(ShipLoad_Shp2_LoadPreviewData)->DenseRange(0, 2)->Unit(benchmark::kMicrosecond);
+
+static void ShipLoad_Legacy_LoadShipFromImageDefinition(benchmark::State & state)
+{
+    auto const & corpusShip = GetCorpusShip(state);
+    auto const & materialDatabase = GetMaterialDatabase();
+
+    for (auto _ : state)
+    {
+        auto shipDefinition = ShipLegacyFormatDeSerializer::LoadShipFromImageDefinition(corpusShip.LegacyFilePath, materialDatabase);
+        benchmark::DoNotOptimize(const_cast<ShipDefinition const &>(shipDefinition));
+    }
+
+    SetThroughput(state, corpusShip, static_cast<std::int64_t>(std::filesystem::file_size(corpusShip.LegacyFilePath)));
+}
+BENCHMARK(ShipLoad_Legacy_LoadShipFromImageDefinition)->DenseRange(0, 2)->Unit(benchmark::kMillisecond);
+
+static void ShipLoad_DecodePngImage(benchmark::State & state)
+{
+    auto const & corpusShip = GetCorpusShip(state);
+
+    for (auto _ : state)
+    {
+        auto image = ImageFileTools::DecodePngImage(corpusShip.TexturePngBuffer);
+        benchmark::DoNotOptimize(image);
+    }
+
+    SetThroughput(state, corpusShip, static_cast<std::int64_t>(corpusShip.TexturePngBuffer.GetSize()));
+}
+BENCHMARK(ShipLoad_DecodePngImage)->DenseRange(0, 2)->Unit(benchmark::kMillisecond);
+
+static void ShipLoad_ShipFactory_Create(benchmark::State & state)
+{
+    auto const & corpusShip = GetCorpusShip(state);
+    auto const & materialDatabase = GetMaterialDatabase();
+    auto const & resourceLocator = GetResourceLocator();
+
+    auto const fishSpeciesDatabase = FishSpeciesDatabase::Load(resourceLocator);
+    ShipTexturizer const shipTexturizer(materialDatabase, resourceLocator);
+    ShipStrengthRandomizer const shipStrengthRandomizer;
+    auto gameEventDispatcher = std::make_shared<GameEventDispatcher>();
+    auto taskThreadPool = std::make_shared<TaskThreadPool>();
+    GameParameters const gameParameters;
+
+    Physics::World world(
+        OceanFloorTerrain::LoadFromImage(resourceLocator.GetDefaultOceanFloorTerrainFilePath()),
+        fishSpeciesDatabase,
+        gameEventDispatcher,
+        taskThreadPool,
+        gameParameters,
+        VisibleWorld());
+
+    auto const shipDefinition = ShipDefinitionFormatDeSerializer::Load(corpusShip.Shp2FilePath, materialDatabase);
+
+    for (auto _ : state)
+    {
+        // The factory consumes its definition
+        state.PauseTiming();
+        auto shipDefinitionCopy = shipDefinition.Clone();
+        state.ResumeTiming();
+
+        auto result = ShipFactory::Create(
+            world.GetNextShipId(),
+            world,
+            std::move(shipDefinitionCopy),
+            ShipLoadOptions(),
+            materialDatabase,
+            shipTexturizer,
+            shipStrengthRandomizer,
+            gameEventDispatcher,
+            taskThreadPool,
+            gameParameters);
+
+        benchmark::DoNotOptimize(result);
+    }
+
+    SetThroughput(state, corpusShip, static_cast<std::int64_t>(std::filesystem::file_size(corpusShip.Shp2FilePath)));
+}
+BENCHMARK(ShipLoad_ShipFactory_Create)->DenseRange(0, 2)->Unit(benchmark::kMillisecond);
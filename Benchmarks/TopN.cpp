@@ -8,6 +8,7 @@
 
 #include <algorithm>
 #include <limits>
+#include <numeric>
 #include <queue>
 #include <vector>
 
@@ -235,4 +236,65 @@ static void TopN_10TruncatedPriorityQueue_Emplace(benchmark::State& state)
         benchmark::DoNotOptimize(const_cast<TruncatedPriorityQueue<float> const &>(results));
     }
 }
-BENCHMARK(TopN_10TruncatedPriorityQueue_Emplace)->Arg(20)->Arg(100)->Arg(1000)->Arg(5000);
\ No newline at end of file
+BENCHMARK(TopN_10TruncatedPriorityQueue_Emplace)->Arg(20)->Arg(100)->Arg(1000)->Arg(5000);
+
+
+//
+// Frame-coherent ordering: at each frame a few elements drift out of place
+//
+
+static void MakeNearlySortedFrame(
+    std::vector<float> & keys,
+    size_t frame)
+{
+    // Swap a couple of neighbors per frame
+    size_t const i = (frame * 7919) % (keys.size() - 1);
+    std::swap(keys[i], keys[i + 1]);
+}
+
+static void TopN_NearlySorted_Sort(benchmark::State& state)
+{
+    std::vector<float> keys(static_cast<size_t>(state.range(0)));
+    std::iota(keys.begin(), keys.end(), 0.0f);
+
+    size_t frame = 0;
+    for (auto _ : state)
+    {
+        MakeNearlySortedFrame(keys, frame++);
+
+        std::sort(keys.begin(), keys.end());
+
+        benchmark::DoNotOptimize(keys);
+    }
+}
+BENCHMARK(TopN_NearlySorted_Sort)->Arg(20)->Arg(100)->Arg(1000)->Arg(5000);
+
+static void TopN_NearlySorted_CoherentInsertionSort(benchmark::State& state)
+{
+    std::vector<float> keys(static_cast<size_t>(state.range(0)));
+    std::iota(keys.begin(), keys.end(), 0.0f);
+
+    size_t frame = 0;
+    for (auto _ : state)
+    {
+        MakeNearlySortedFrame(keys, frame++);
+
+        if (!std::is_sorted(keys.begin(), keys.end()))
+        {
+            for (size_t i = 1; i < keys.size(); ++i)
+            {
+                auto const key = keys[i];
+                size_t j = i;
+                for (; j > 0 && key < keys[j - 1]; --j)
+                {
+                    keys[j] = keys[j - 1];
+                }
+
+                keys[j] = key;
+            }
+        }
+
+        benchmark::DoNotOptimize(keys);
+    }
+}
+BENCHMARK(TopN_NearlySorted_CoherentInsertionSort)->Arg(20)->Arg(100)->Arg(1000)->Arg(5000);
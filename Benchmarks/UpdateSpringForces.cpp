@@ -1,5 +1,6 @@
 #include "Utils.h"
 
+#include <GameCore/Algorithms.h>
 #include <GameCore/SysSpecifics.h>
 
 #include <benchmark/benchmark.h>
@@ -74,6 +75,142 @@ static void UpdateSpringForces_Naive(benchmark::State& state)
 }
 BENCHMARK(UpdateSpringForces_Naive);
 
+static void MakeSoAEndpoints(
+    std::vector<SpringEndpoints> const & springsEndpoints,
+    std::vector<ElementIndex> & springsEndpointA,
+    std::vector<ElementIndex> & springsEndpointB)
+{
+    for (auto const & e : springsEndpoints)
+    {
+        springsEndpointA.push_back(e.PointAIndex);
+        springsEndpointB.push_back(e.PointBIndex);
+    }
+}
+
+static void UpdateSpringForces_SoA_Naive(benchmark::State & state)
+{
+    auto const size = MakeSize(SampleSize);
+
+    std::vector<vec2f> pointsPosition;
+    std::vector<vec2f> pointsVelocity;
+    std::vector<vec2f> pointsForce;
+    std::vector<SpringEndpoints> springsEndpoints;
+    std::vector<float> springsStiffnessCoefficient;
+    std::vector<float> springsDamperCoefficient;
+    std::vector<float> springsRestLength;
+
+    MakeGraph2(size, pointsPosition, pointsVelocity, pointsForce,
+        springsEndpoints, springsStiffnessCoefficient, springsDamperCoefficient, springsRestLength);
+
+    std::vector<ElementIndex> springsEndpointA;
+    std::vector<ElementIndex> springsEndpointB;
+    MakeSoAEndpoints(springsEndpoints, springsEndpointA, springsEndpointB);
+
+    for (auto _ : state)
+    {
+        Algorithms::ApplySpringsForces_Naive(
+            pointsPosition.data(),
+            pointsVelocity.data(),
+            springsEndpointA.data(),
+            springsEndpointB.data(),
+            springsRestLength.data(),
+            springsStiffnessCoefficient.data(),
+            springsDamperCoefficient.data(),
+            0,
+            static_cast<ElementIndex>(size),
+            pointsForce.data());
+    }
+
+    benchmark::DoNotOptimize(pointsForce);
+}
+BENCHMARK(UpdateSpringForces_SoA_Naive);
+
+#if FS_IS_ARCHITECTURE_X86_32() || FS_IS_ARCHITECTURE_X86_64()
+static void UpdateSpringForces_SoA_AVX2(benchmark::State & state)
+{
+    if (!IsAVX2Supported())
+    {
+        state.SkipWithError("AVX2 not supported");
+        return;
+    }
+
+    auto const size = MakeSize(SampleSize);
+
+    std::vector<vec2f> pointsPosition;
+    std::vector<vec2f> pointsVelocity;
+    std::vector<vec2f> pointsForce;
+    std::vector<SpringEndpoints> springsEndpoints;
+    std::vector<float> springsStiffnessCoefficient;
+    std::vector<float> springsDamperCoefficient;
+    std::vector<float> springsRestLength;
+
+    MakeGraph2(size, pointsPosition, pointsVelocity, pointsForce,
+        springsEndpoints, springsStiffnessCoefficient, springsDamperCoefficient, springsRestLength);
+
+    std::vector<ElementIndex> springsEndpointA;
+    std::vector<ElementIndex> springsEndpointB;
+    MakeSoAEndpoints(springsEndpoints, springsEndpointA, springsEndpointB);
+
+    for (auto _ : state)
+    {
+        Algorithms::ApplySpringsForces_AVX2(
+            pointsPosition.data(),
+            pointsVelocity.data(),
+            springsEndpointA.data(),
+            springsEndpointB.data(),
+            springsRestLength.data(),
+            springsStiffnessCoefficient.data(),
+            springsDamperCoefficient.data(),
+            0,
+            static_cast<ElementIndex>(size),
+            pointsForce.data());
+    }
+
+    benchmark::DoNotOptimize(pointsForce);
+}
+BENCHMARK(UpdateSpringForces_SoA_AVX2);
+#endif
+
+#if FS_IS_ARCHITECTURE_ARM_64()
+static void UpdateSpringForces_SoA_NEON(benchmark::State & state)
+{
+    auto const size = MakeSize(SampleSize);
+
+    std::vector<vec2f> pointsPosition;
+    std::vector<vec2f> pointsVelocity;
+    std::vector<vec2f> pointsForce;
+    std::vector<SpringEndpoints> springsEndpoints;
+    std::vector<float> springsStiffnessCoefficient;
+    std::vector<float> springsDamperCoefficient;
+    std::vector<float> springsRestLength;
+
+    MakeGraph2(size, pointsPosition, pointsVelocity, pointsForce,
+        springsEndpoints, springsStiffnessCoefficient, springsDamperCoefficient, springsRestLength);
+
+    std::vector<ElementIndex> springsEndpointA;
+    std::vector<ElementIndex> springsEndpointB;
+    MakeSoAEndpoints(springsEndpoints, springsEndpointA, springsEndpointB);
+
+    for (auto _ : state)
+    {
+        Algorithms::ApplySpringsForces_NEON(
+            pointsPosition.data(),
+            pointsVelocity.data(),
+            springsEndpointA.data(),
+            springsEndpointB.data(),
+            springsRestLength.data(),
+            springsStiffnessCoefficient.data(),
+            springsDamperCoefficient.data(),
+            0,
+            static_cast<ElementIndex>(size),
+            pointsForce.data());
+    }
+
+    benchmark::DoNotOptimize(pointsForce);
+}
+BENCHMARK(UpdateSpringForces_SoA_NEON);
+#endif
+
 /* LibSimDpp has been purged
 static void UpdateSpringForces_LibSimdPpAndIntrinsics(benchmark::State& state)
 {
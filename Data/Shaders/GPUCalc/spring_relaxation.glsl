@@ -0,0 +1,75 @@
+###VERTEX-130
+
+// Inputs
+in vec4 inVertexShaderInput0; // NDC position (2), texture coords (2)
+
+void main()
+{
+    gl_Position = vec4(inVertexShaderInput0.xy, -1.0, 1.0);
+}
+
+###FRAGMENT-130
+
+#define MAX_SPRINGS_PER_POINT 9
+
+// Input textures
+uniform sampler2D paramTextureInput0; // State: position (2), velocity (2)
+uniform sampler2D paramTextureInput1; // Forces: static force (2), integration factor (2)
+uniform sampler2D paramTextureInput2; // Springs: other endpoint index, rest length, stiffness, damping
+
+// Parameters
+uniform float paramDeltaTime;
+uniform vec2 paramFrameSize;
+uniform float paramVelocityFactor;
+
+out vec4 outState;
+
+void main()
+{
+    ivec2 pointCoords = ivec2(gl_FragCoord.xy);
+    int frameWidth = int(paramFrameSize.x);
+    int frameHeight = int(paramFrameSize.y);
+
+    vec4 state = texelFetch(paramTextureInput0, pointCoords, 0);
+    vec4 forces = texelFetch(paramTextureInput1, pointCoords, 0);
+
+    //
+    // Gather spring forces
+    //
+
+    vec2 springForce = vec2(0.0);
+
+    for (int s = 0; s < MAX_SPRINGS_PER_POINT; ++s)
+    {
+        vec4 spring = texelFetch(paramTextureInput2, ivec2(pointCoords.x, pointCoords.y + s * frameHeight), 0);
+        if (spring.x < 0.0)
+            break;
+
+        int otherPointIndex = int(spring.x);
+        vec4 otherState = texelFetch(paramTextureInput0, ivec2(otherPointIndex % frameWidth, otherPointIndex / frameWidth), 0);
+
+        vec2 displacement = otherState.xy - state.xy;
+        float displacementLength = length(displacement);
+        vec2 springDir = displacementLength != 0.0 ? displacement / displacementLength : vec2(0.0);
+
+        // Hooke's law
+        float fSpring = (displacementLength - spring.y) * spring.z;
+
+        // Damper forces
+        float fDamp = dot(otherState.zw - state.zw, springDir) * spring.w;
+
+        springForce += springDir * (fSpring + fDamp);
+    }
+
+    //
+    // Integrate
+    //
+
+    vec2 deltaPos =
+        state.zw * paramDeltaTime
+        + (springForce + forces.xy) * forces.zw;
+
+    outState = vec4(
+        state.xy + deltaPos,
+        deltaPos * paramVelocityFactor);
+}
@@ -134,9 +134,195 @@ BootSettingsDialog::BootSettingsDialog(
             optionsSizer->Add(forceNoMultithreadedRenderingBox, 0, wxALIGN_CENTER_VERTICAL | wxALL, InternalWindowMargin);
         }
 
+        {
+            wxStaticBox * useHugePagesBox = new wxStaticBox(this, wxID_ANY, _("Use huge pages"));
+
+            {
+                wxBoxSizer * useHugePagesBoxSizer = new wxBoxSizer(wxVERTICAL);
+
+                useHugePagesBoxSizer->AddSpacer(StaticBoxTopMargin);
+
+                mDoUseHugePages_UnsetRadioButton = new wxRadioButton(useHugePagesBox, wxID_ANY, _("Default"),
+                    wxDefaultPosition, wxDefaultSize, wxRB_GROUP);
+
+                useHugePagesBoxSizer->Add(
+                    mDoUseHugePages_UnsetRadioButton,
+                    0,
+                    wxALIGN_LEFT | wxLEFT | wxRIGHT | wxBOTTOM,
+                    RadioButtonMargin);
+
+                useHugePagesBoxSizer->AddSpacer(InterRadioBoxMargin);
+
+                mDoUseHugePages_TrueRadioButton = new wxRadioButton(useHugePagesBox, wxID_ANY, _("True"),
+                    wxDefaultPosition, wxDefaultSize);
+
+                useHugePagesBoxSizer->Add(
+                    mDoUseHugePages_TrueRadioButton,
+                    0,
+                    wxALIGN_LEFT | wxLEFT | wxRIGHT | wxBOTTOM,
+                    RadioButtonMargin);
+
+                useHugePagesBoxSizer->AddSpacer(InterRadioBoxMargin);
+
+                mDoUseHugePages_FalseRadioButton = new wxRadioButton(useHugePagesBox, wxID_ANY, _("False"),
+                    wxDefaultPosition, wxDefaultSize);
+
+                useHugePagesBoxSizer->Add(
+                    mDoUseHugePages_FalseRadioButton,
+                    0,
+                    wxALIGN_LEFT | wxLEFT | wxRIGHT | wxBOTTOM,
+                    RadioButtonMargin);
+
+                useHugePagesBox->SetSizer(useHugePagesBoxSizer);
+            }
+
+            optionsSizer->Add(useHugePagesBox, 0, wxALIGN_CENTER_VERTICAL | wxALL, InternalWindowMargin);
+        }
+
         vSizer->Add(optionsSizer, 0, wxALIGN_CENTER_HORIZONTAL | wxALL, InternalWindowMargin);
     }
 
+    {
+        wxBoxSizer * threadingOptionsSizer = new wxBoxSizer(wxHORIZONTAL);
+
+        {
+            wxStaticBox * preferPerformanceCoresBox = new wxStaticBox(this, wxID_ANY, _("Prefer performance cores for simulation"));
+
+            {
+                wxBoxSizer * preferPerformanceCoresBoxSizer = new wxBoxSizer(wxVERTICAL);
+
+                preferPerformanceCoresBoxSizer->AddSpacer(StaticBoxTopMargin);
+
+                mDoPreferPerformanceCores_UnsetRadioButton = new wxRadioButton(preferPerformanceCoresBox, wxID_ANY, _("Default"),
+                    wxDefaultPosition, wxDefaultSize, wxRB_GROUP);
+
+                preferPerformanceCoresBoxSizer->Add(
+                    mDoPreferPerformanceCores_UnsetRadioButton,
+                    0,
+                    wxALIGN_LEFT | wxLEFT | wxRIGHT | wxBOTTOM,
+                    RadioButtonMargin);
+
+                preferPerformanceCoresBoxSizer->AddSpacer(InterRadioBoxMargin);
+
+                mDoPreferPerformanceCores_TrueRadioButton = new wxRadioButton(preferPerformanceCoresBox, wxID_ANY, _("True"),
+                    wxDefaultPosition, wxDefaultSize);
+
+                preferPerformanceCoresBoxSizer->Add(
+                    mDoPreferPerformanceCores_TrueRadioButton,
+                    0,
+                    wxALIGN_LEFT | wxLEFT | wxRIGHT | wxBOTTOM,
+                    RadioButtonMargin);
+
+                preferPerformanceCoresBoxSizer->AddSpacer(InterRadioBoxMargin);
+
+                mDoPreferPerformanceCores_FalseRadioButton = new wxRadioButton(preferPerformanceCoresBox, wxID_ANY, _("False"),
+                    wxDefaultPosition, wxDefaultSize);
+
+                preferPerformanceCoresBoxSizer->Add(
+                    mDoPreferPerformanceCores_FalseRadioButton,
+                    0,
+                    wxALIGN_LEFT | wxLEFT | wxRIGHT | wxBOTTOM,
+                    RadioButtonMargin);
+
+                preferPerformanceCoresBox->SetSizer(preferPerformanceCoresBoxSizer);
+            }
+
+            threadingOptionsSizer->Add(preferPerformanceCoresBox, 0, wxALIGN_CENTER_VERTICAL | wxALL, InternalWindowMargin);
+        }
+
+        {
+            wxStaticBox * separateRenderThreadBox = new wxStaticBox(this, wxID_ANY, _("Separate render thread from simulation"));
+
+            {
+                wxBoxSizer * separateRenderThreadBoxSizer = new wxBoxSizer(wxVERTICAL);
+
+                separateRenderThreadBoxSizer->AddSpacer(StaticBoxTopMargin);
+
+                mDoSeparateRenderThread_UnsetRadioButton = new wxRadioButton(separateRenderThreadBox, wxID_ANY, _("Default"),
+                    wxDefaultPosition, wxDefaultSize, wxRB_GROUP);
+
+                separateRenderThreadBoxSizer->Add(
+                    mDoSeparateRenderThread_UnsetRadioButton,
+                    0,
+                    wxALIGN_LEFT | wxLEFT | wxRIGHT | wxBOTTOM,
+                    RadioButtonMargin);
+
+                separateRenderThreadBoxSizer->AddSpacer(InterRadioBoxMargin);
+
+                mDoSeparateRenderThread_TrueRadioButton = new wxRadioButton(separateRenderThreadBox, wxID_ANY, _("True"),
+                    wxDefaultPosition, wxDefaultSize);
+
+                separateRenderThreadBoxSizer->Add(
+                    mDoSeparateRenderThread_TrueRadioButton,
+                    0,
+                    wxALIGN_LEFT | wxLEFT | wxRIGHT | wxBOTTOM,
+                    RadioButtonMargin);
+
+                separateRenderThreadBoxSizer->AddSpacer(InterRadioBoxMargin);
+
+                mDoSeparateRenderThread_FalseRadioButton = new wxRadioButton(separateRenderThreadBox, wxID_ANY, _("False"),
+                    wxDefaultPosition, wxDefaultSize);
+
+                separateRenderThreadBoxSizer->Add(
+                    mDoSeparateRenderThread_FalseRadioButton,
+                    0,
+                    wxALIGN_LEFT | wxLEFT | wxRIGHT | wxBOTTOM,
+                    RadioButtonMargin);
+
+                separateRenderThreadBox->SetSizer(separateRenderThreadBoxSizer);
+            }
+
+            threadingOptionsSizer->Add(separateRenderThreadBox, 0, wxALIGN_CENTER_VERTICAL | wxALL, InternalWindowMargin);
+        }
+
+        {
+            wxStaticBox * elevateMainThreadPriorityBox = new wxStaticBox(this, wxID_ANY, _("Elevate main thread priority"));
+
+            {
+                wxBoxSizer * elevateMainThreadPriorityBoxSizer = new wxBoxSizer(wxVERTICAL);
+
+                elevateMainThreadPriorityBoxSizer->AddSpacer(StaticBoxTopMargin);
+
+                mDoElevateMainThreadPriority_UnsetRadioButton = new wxRadioButton(elevateMainThreadPriorityBox, wxID_ANY, _("Default"),
+                    wxDefaultPosition, wxDefaultSize, wxRB_GROUP);
+
+                elevateMainThreadPriorityBoxSizer->Add(
+                    mDoElevateMainThreadPriority_UnsetRadioButton,
+                    0,
+                    wxALIGN_LEFT | wxLEFT | wxRIGHT | wxBOTTOM,
+                    RadioButtonMargin);
+
+                elevateMainThreadPriorityBoxSizer->AddSpacer(InterRadioBoxMargin);
+
+                mDoElevateMainThreadPriority_TrueRadioButton = new wxRadioButton(elevateMainThreadPriorityBox, wxID_ANY, _("True"),
+                    wxDefaultPosition, wxDefaultSize);
+
+                elevateMainThreadPriorityBoxSizer->Add(
+                    mDoElevateMainThreadPriority_TrueRadioButton,
+                    0,
+                    wxALIGN_LEFT | wxLEFT | wxRIGHT | wxBOTTOM,
+                    RadioButtonMargin);
+
+                elevateMainThreadPriorityBoxSizer->AddSpacer(InterRadioBoxMargin);
+
+                mDoElevateMainThreadPriority_FalseRadioButton = new wxRadioButton(elevateMainThreadPriorityBox, wxID_ANY, _("False"),
+                    wxDefaultPosition, wxDefaultSize);
+
+                elevateMainThreadPriorityBoxSizer->Add(
+                    mDoElevateMainThreadPriority_FalseRadioButton,
+                    0,
+                    wxALIGN_LEFT | wxLEFT | wxRIGHT | wxBOTTOM,
+                    RadioButtonMargin);
+
+                elevateMainThreadPriorityBox->SetSizer(elevateMainThreadPriorityBoxSizer);
+            }
+
+            threadingOptionsSizer->Add(elevateMainThreadPriorityBox, 0, wxALIGN_CENTER_VERTICAL | wxALL, InternalWindowMargin);
+        }
+
+        vSizer->Add(threadingOptionsSizer, 0, wxALIGN_CENTER_HORIZONTAL | wxALL, InternalWindowMargin);
+    }
+
     {
         wxBoxSizer * hSizer = new wxBoxSizer(wxHORIZONTAL);
 
@@ -193,6 +379,46 @@ void BootSettingsDialog::PopulateCheckboxes(BootSettings const & settings)
         else
             mDoForceNoMultithreadedRendering_FalseRadioButton->SetValue(true);
     }
+
+    if (!settings.DoUseHugePages.has_value())
+        mDoUseHugePages_UnsetRadioButton->SetValue(true);
+    else
+    {
+        if (*(settings.DoUseHugePages))
+            mDoUseHugePages_TrueRadioButton->SetValue(true);
+        else
+            mDoUseHugePages_FalseRadioButton->SetValue(true);
+    }
+
+    if (!settings.DoPreferPerformanceCores.has_value())
+        mDoPreferPerformanceCores_UnsetRadioButton->SetValue(true);
+    else
+    {
+        if (*(settings.DoPreferPerformanceCores))
+            mDoPreferPerformanceCores_TrueRadioButton->SetValue(true);
+        else
+            mDoPreferPerformanceCores_FalseRadioButton->SetValue(true);
+    }
+
+    if (!settings.DoSeparateRenderThread.has_value())
+        mDoSeparateRenderThread_UnsetRadioButton->SetValue(true);
+    else
+    {
+        if (*(settings.DoSeparateRenderThread))
+            mDoSeparateRenderThread_TrueRadioButton->SetValue(true);
+        else
+            mDoSeparateRenderThread_FalseRadioButton->SetValue(true);
+    }
+
+    if (!settings.DoElevateMainThreadPriority.has_value())
+        mDoElevateMainThreadPriority_UnsetRadioButton->SetValue(true);
+    else
+    {
+        if (*(settings.DoElevateMainThreadPriority))
+            mDoElevateMainThreadPriority_TrueRadioButton->SetValue(true);
+        else
+            mDoElevateMainThreadPriority_FalseRadioButton->SetValue(true);
+    }
 }
 
 void BootSettingsDialog::OnRevertToDefaultsButton(wxCommandEvent & /*event*/)
@@ -216,9 +442,37 @@ void BootSettingsDialog::OnSaveAndQuitButton(wxCommandEvent & /*event*/)
     else if (mDoForceNoMultithreadedRendering_FalseRadioButton->GetValue())
         doForceNoMultithrededRendering = false;
 
+    std::optional<bool> doUseHugePages;
+    if (mDoUseHugePages_TrueRadioButton->GetValue())
+        doUseHugePages = true;
+    else if (mDoUseHugePages_FalseRadioButton->GetValue())
+        doUseHugePages = false;
+
+    std::optional<bool> doPreferPerformanceCores;
+    if (mDoPreferPerformanceCores_TrueRadioButton->GetValue())
+        doPreferPerformanceCores = true;
+    else if (mDoPreferPerformanceCores_FalseRadioButton->GetValue())
+        doPreferPerformanceCores = false;
+
+    std::optional<bool> doSeparateRenderThread;
+    if (mDoSeparateRenderThread_TrueRadioButton->GetValue())
+        doSeparateRenderThread = true;
+    else if (mDoSeparateRenderThread_FalseRadioButton->GetValue())
+        doSeparateRenderThread = false;
+
+    std::optional<bool> doElevateMainThreadPriority;
+    if (mDoElevateMainThreadPriority_TrueRadioButton->GetValue())
+        doElevateMainThreadPriority = true;
+    else if (mDoElevateMainThreadPriority_FalseRadioButton->GetValue())
+        doElevateMainThreadPriority = false;
+
     BootSettings settings(
         doForceNoGlFinish,
-        doForceNoMultithrededRendering);
+        doForceNoMultithrededRendering,
+        doUseHugePages,
+        doPreferPerformanceCores,
+        doSeparateRenderThread,
+        doElevateMainThreadPriority);
 
     BootSettings defaultSettings;
 
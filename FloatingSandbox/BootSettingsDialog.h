@@ -35,6 +35,18 @@ private:
     wxRadioButton * mDoForceNoMultithreadedRendering_UnsetRadioButton;
     wxRadioButton * mDoForceNoMultithreadedRendering_TrueRadioButton;
     wxRadioButton * mDoForceNoMultithreadedRendering_FalseRadioButton;
+    wxRadioButton * mDoUseHugePages_UnsetRadioButton;
+    wxRadioButton * mDoUseHugePages_TrueRadioButton;
+    wxRadioButton * mDoUseHugePages_FalseRadioButton;
+    wxRadioButton * mDoPreferPerformanceCores_UnsetRadioButton;
+    wxRadioButton * mDoPreferPerformanceCores_TrueRadioButton;
+    wxRadioButton * mDoPreferPerformanceCores_FalseRadioButton;
+    wxRadioButton * mDoSeparateRenderThread_UnsetRadioButton;
+    wxRadioButton * mDoSeparateRenderThread_TrueRadioButton;
+    wxRadioButton * mDoSeparateRenderThread_FalseRadioButton;
+    wxRadioButton * mDoElevateMainThreadPriority_UnsetRadioButton;
+    wxRadioButton * mDoElevateMainThreadPriority_TrueRadioButton;
+    wxRadioButton * mDoElevateMainThreadPriority_FalseRadioButton;
 
 private:
 
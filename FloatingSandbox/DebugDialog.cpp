@@ -5,7 +5,11 @@
  ***************************************************************************************/
 #include "DebugDialog.h"
 
+#include <GameCore/Profiler.h>
+
+#include <wx/filedlg.h>
 #include <wx/gbsizer.h>
+#include <wx/msgdlg.h>
 #include <wx/notebook.h>
 #include <wx/settings.h>
 #include <wx/statbox.h>
@@ -78,6 +82,44 @@ DebugDialog::DebugDialog(
     }
 
 
+    //
+    // Profiling
+    //
+
+    {
+        wxPanel * profilingPanel = new wxPanel(notebook);
+
+        PopulateProfilingPanel(profilingPanel);
+
+        notebook->AddPage(profilingPanel, _("Profiling"));
+    }
+
+
+    //
+    // Memory
+    //
+
+    {
+        wxPanel * memoryPanel = new wxPanel(notebook);
+
+        PopulateMemoryPanel(memoryPanel);
+
+        notebook->AddPage(memoryPanel, _("Memory"));
+    }
+
+    //
+    // Ship Costs
+    //
+
+    {
+        wxPanel * shipCostsPanel = new wxPanel(notebook);
+
+        PopulateShipCostsPanel(shipCostsPanel);
+
+        notebook->AddPage(shipCostsPanel, _("Ship Costs"));
+    }
+
+
     //
     // Finalize dialog
     //
@@ -238,6 +280,8 @@ void DebugDialog::PopulateEventRecordingPanel(wxPanel * panel)
                 mRecordEventStopButton->Enable(true);
                 mRecordEventStepButton->Enable(false);
                 mRecordEventRewindButton->Enable(false);
+                mRecordEventReplayAllButton->Enable(false);
+                mRecordEventSaveButton->Enable(false);
 
                 mRecordedEventTextCtrl->Clear();
 
@@ -272,20 +316,7 @@ void DebugDialog::PopulateEventRecordingPanel(wxPanel * panel)
                 mRecordedEvents = std::make_shared<RecordedEvents>(
                     mGameController->StopRecordingEvents());
 
-                mCurrentRecordedEventIndex = 0;
-
-                if (mRecordedEvents->GetSize() > 0)
-                {
-                    mRecordEventStepButton->Enable(true);
-                    mRecordEventRewindButton->Enable(true);
-                    SetRecordedEventText(0, mRecordedEvents->GetEvent(0));
-                }
-                else
-                {
-                    mRecordEventStepButton->Enable(false);
-                    mRecordEventRewindButton->Enable(false);
-                    mRecordedEventTextCtrl->Clear();
-                }
+                OnRecordedEventsAvailable();
             });
 
         gridSizer->Add(
@@ -331,6 +362,7 @@ void DebugDialog::PopulateEventRecordingPanel(wxPanel * panel)
                 if (mCurrentRecordedEventIndex >= mRecordedEvents->GetSize())
                 {
                     mRecordEventStepButton->Enable(false);
+                    mRecordEventReplayAllButton->Enable(false);
                 }
                 else
                 {
@@ -357,6 +389,8 @@ void DebugDialog::PopulateEventRecordingPanel(wxPanel * panel)
             {
                 assert(!!mRecordedEvents);
                 mCurrentRecordedEventIndex = 0;
+                mRecordEventStepButton->Enable(true);
+                mRecordEventReplayAllButton->Enable(true);
                 SetRecordedEventText(mCurrentRecordedEventIndex, mRecordedEvents->GetEvent(mCurrentRecordedEventIndex));
             });
 
@@ -368,7 +402,422 @@ void DebugDialog::PopulateEventRecordingPanel(wxPanel * panel)
             CellBorder);
     }
 
+    {
+        mRecordEventReplayAllButton = new wxButton(panel, wxID_ANY, _("Replay All"));
+
+        mRecordEventReplayAllButton->Enable(false);
+
+        mRecordEventReplayAllButton->Bind(
+            wxEVT_BUTTON,
+            [this](wxCommandEvent &)
+            {
+                assert(!!mRecordedEvents);
+
+                // Fast-forward through all the remaining events
+                for (; mCurrentRecordedEventIndex < mRecordedEvents->GetSize(); ++mCurrentRecordedEventIndex)
+                {
+                    mGameController->ReplayRecordedEvent(
+                        mRecordedEvents->GetEvent(mCurrentRecordedEventIndex));
+                }
+
+                mRecordEventStepButton->Enable(false);
+                mRecordEventReplayAllButton->Enable(false);
+                mRecordedEventTextCtrl->Clear();
+            });
+
+        gridSizer->Add(
+            mRecordEventReplayAllButton,
+            wxGBPosition(3, 0),
+            wxGBSpan(1, 2),
+            wxEXPAND | wxALL,
+            CellBorder);
+    }
+
+    //
+    // Persistence
+    //
+
+    {
+        mRecordEventSaveButton = new wxButton(panel, wxID_ANY, _("Save..."));
+
+        mRecordEventSaveButton->Enable(false);
+
+        mRecordEventSaveButton->Bind(
+            wxEVT_BUTTON,
+            [this](wxCommandEvent &)
+            {
+                assert(!!mRecordedEvents);
+
+                wxFileDialog saveDialog(
+                    this,
+                    _("Save Recorded Events"),
+                    wxEmptyString,
+                    "events.fsre",
+                    _("Recorded events files") + wxS(" (*.fsre)|*.fsre"),
+                    wxFD_SAVE | wxFD_OVERWRITE_PROMPT);
+
+                if (saveDialog.ShowModal() == wxID_OK)
+                {
+                    try
+                    {
+                        mRecordedEvents->SaveTo(
+                            std::filesystem::path(saveDialog.GetPath().ToStdString()));
+                    }
+                    catch (std::exception const & e)
+                    {
+                        wxMessageBox(std::string(e.what()), _("Error"), wxICON_ERROR);
+                    }
+                }
+            });
+
+        gridSizer->Add(
+            mRecordEventSaveButton,
+            wxGBPosition(4, 0),
+            wxGBSpan(1, 1),
+            wxEXPAND | wxALL,
+            CellBorder);
+    }
+
+    {
+        auto loadButton = new wxButton(panel, wxID_ANY, _("Load..."));
+
+        loadButton->Bind(
+            wxEVT_BUTTON,
+            [this](wxCommandEvent &)
+            {
+                wxFileDialog loadDialog(
+                    this,
+                    _("Load Recorded Events"),
+                    wxEmptyString,
+                    wxEmptyString,
+                    _("Recorded events files") + wxS(" (*.fsre)|*.fsre"),
+                    wxFD_OPEN | wxFD_FILE_MUST_EXIST);
+
+                if (loadDialog.ShowModal() == wxID_OK)
+                {
+                    try
+                    {
+                        mRecordedEvents = std::make_shared<RecordedEvents>(
+                            RecordedEvents::LoadFrom(
+                                std::filesystem::path(loadDialog.GetPath().ToStdString())));
+                    }
+                    catch (std::exception const & e)
+                    {
+                        wxMessageBox(std::string(e.what()), _("Error"), wxICON_ERROR);
+                        return;
+                    }
+
+                    OnRecordedEventsAvailable();
+                }
+            });
+
+        gridSizer->Add(
+            loadButton,
+            wxGBPosition(4, 1),
+            wxGBSpan(1, 1),
+            wxEXPAND | wxALL,
+            CellBorder);
+    }
+
     // Finalize panel
 
     panel->SetSizerAndFit(gridSizer);
-}
\ No newline at end of file
+}
+
+void DebugDialog::OnRecordedEventsAvailable()
+{
+    assert(!!mRecordedEvents);
+
+    mCurrentRecordedEventIndex = 0;
+
+    bool const hasEvents = (mRecordedEvents->GetSize() > 0);
+
+    mRecordEventStepButton->Enable(hasEvents);
+    mRecordEventRewindButton->Enable(hasEvents);
+    mRecordEventReplayAllButton->Enable(hasEvents);
+    mRecordEventSaveButton->Enable(true);
+
+    if (hasEvents)
+    {
+        SetRecordedEventText(0, mRecordedEvents->GetEvent(0));
+    }
+    else
+    {
+        mRecordedEventTextCtrl->Clear();
+    }
+}
+
+void DebugDialog::PopulateProfilingPanel(wxPanel * panel)
+{
+    wxGridBagSizer * gridSizer = new wxGridBagSizer(0, 0);
+
+    //
+    // Control
+    //
+
+    {
+        mProfilingStartButton = new wxButton(panel, wxID_ANY, _("Start"));
+
+        mProfilingStartButton->Bind(
+            wxEVT_BUTTON,
+            [this](wxCommandEvent &)
+            {
+                mProfilingStartButton->Enable(false);
+                mProfilingStopButton->Enable(true);
+
+                Profiler::GetInstance().Clear();
+                Profiler::GetInstance().SetEnabled(true);
+            });
+
+        gridSizer->Add(
+            mProfilingStartButton,
+            wxGBPosition(0, 0),
+            wxGBSpan(1, 1),
+            wxEXPAND | wxALL,
+            CellBorder);
+    }
+
+    {
+        mProfilingStopButton = new wxButton(panel, wxID_ANY, _("Stop"));
+
+        mProfilingStopButton->Enable(false);
+
+        mProfilingStopButton->Bind(
+            wxEVT_BUTTON,
+            [this](wxCommandEvent &)
+            {
+                mProfilingStartButton->Enable(true);
+                mProfilingStopButton->Enable(false);
+
+                Profiler::GetInstance().SetEnabled(false);
+            });
+
+        gridSizer->Add(
+            mProfilingStopButton,
+            wxGBPosition(0, 1),
+            wxGBSpan(1, 1),
+            wxEXPAND | wxALL,
+            CellBorder);
+    }
+
+    //
+    // Export
+    //
+
+    {
+        auto saveButton = new wxButton(panel, wxID_ANY, _("Save Trace..."));
+
+        saveButton->Bind(
+            wxEVT_BUTTON,
+            [this](wxCommandEvent &)
+            {
+                wxFileDialog saveDialog(
+                    this,
+                    _("Save Profiling Trace"),
+                    wxEmptyString,
+                    "trace.json",
+                    _("Chrome trace files") + wxS(" (*.json)|*.json"),
+                    wxFD_SAVE | wxFD_OVERWRITE_PROMPT);
+
+                if (saveDialog.ShowModal() == wxID_OK)
+                {
+                    try
+                    {
+                        Profiler::GetInstance().ExportChromeTrace(
+                            std::filesystem::path(saveDialog.GetPath().ToStdString()));
+                    }
+                    catch (std::exception const & e)
+                    {
+                        wxMessageBox(std::string(e.what()), _("Error"), wxICON_ERROR);
+                    }
+                }
+            });
+
+        gridSizer->Add(
+            saveButton,
+            wxGBPosition(1, 0),
+            wxGBSpan(1, 2),
+            wxEXPAND | wxALL,
+            CellBorder);
+    }
+
+    //
+    // Telemetry
+    //
+
+    {
+        mTelemetryStartButton = new wxButton(panel, wxID_ANY, _("Start Telemetry..."));
+
+        mTelemetryStartButton->Enable(!mGameController->IsTelemetryStarted());
+
+        mTelemetryStartButton->Bind(
+            wxEVT_BUTTON,
+            [this](wxCommandEvent &)
+            {
+                wxFileDialog saveDialog(
+                    this,
+                    _("Save Telemetry"),
+                    wxEmptyString,
+                    "telemetry.txt",
+                    _("Line protocol files") + wxS(" (*.txt)|*.txt"),
+                    wxFD_SAVE | wxFD_OVERWRITE_PROMPT);
+
+                if (saveDialog.ShowModal() == wxID_OK)
+                {
+                    try
+                    {
+                        mGameController->StartTelemetry(
+                            std::filesystem::path(saveDialog.GetPath().ToStdString()));
+
+                        mTelemetryStartButton->Enable(false);
+                        mTelemetryStopButton->Enable(true);
+                    }
+                    catch (std::exception const & e)
+                    {
+                        wxMessageBox(std::string(e.what()), _("Error"), wxICON_ERROR);
+                    }
+                }
+            });
+
+        gridSizer->Add(
+            mTelemetryStartButton,
+            wxGBPosition(2, 0),
+            wxGBSpan(1, 1),
+            wxEXPAND | wxALL,
+            CellBorder);
+    }
+
+    {
+        mTelemetryStopButton = new wxButton(panel, wxID_ANY, _("Stop Telemetry"));
+
+        mTelemetryStopButton->Enable(mGameController->IsTelemetryStarted());
+
+        mTelemetryStopButton->Bind(
+            wxEVT_BUTTON,
+            [this](wxCommandEvent &)
+            {
+                mTelemetryStartButton->Enable(true);
+                mTelemetryStopButton->Enable(false);
+
+                mGameController->StopTelemetry();
+            });
+
+        gridSizer->Add(
+            mTelemetryStopButton,
+            wxGBPosition(2, 1),
+            wxGBSpan(1, 1),
+            wxEXPAND | wxALL,
+            CellBorder);
+    }
+
+    // Finalize panel
+
+    panel->SetSizerAndFit(gridSizer);
+}
+
+void DebugDialog::PopulateMemoryPanel(wxPanel * panel)
+{
+    wxGridBagSizer * gridSizer = new wxGridBagSizer(0, 0);
+
+    //
+    // Report
+    //
+
+    {
+        mMemoryReportTextCtrl = new wxTextCtrl(panel, wxID_ANY, wxEmptyString, wxDefaultPosition, wxSize(480, 160),
+            wxTE_MULTILINE | wxTE_READONLY);
+
+        gridSizer->Add(
+            mMemoryReportTextCtrl,
+            wxGBPosition(0, 0),
+            wxGBSpan(1, 1),
+            wxEXPAND | wxALL,
+            CellBorder);
+    }
+
+    //
+    // Refresh
+    //
+
+    {
+        auto refreshButton = new wxButton(panel, wxID_ANY, _("Refresh"));
+
+        refreshButton->Bind(
+            wxEVT_BUTTON,
+            [this](wxCommandEvent &)
+            {
+                std::string report;
+                for (auto const & shipReport : mGameController->GetShipMemoryReports())
+                {
+                    report += shipReport.ToString() + "\n";
+                }
+
+                mMemoryReportTextCtrl->SetValue(report);
+            });
+
+        gridSizer->Add(
+            refreshButton,
+            wxGBPosition(1, 0),
+            wxGBSpan(1, 1),
+            wxALIGN_RIGHT | wxALL,
+            CellBorder);
+    }
+
+    // Finalize panel
+
+    panel->SetSizerAndFit(gridSizer);
+}
+
+void DebugDialog::PopulateShipCostsPanel(wxPanel * panel)
+{
+    wxGridBagSizer * gridSizer = new wxGridBagSizer(0, 0);
+
+    //
+    // Report
+    //
+
+    {
+        mShipCostsReportTextCtrl = new wxTextCtrl(panel, wxID_ANY, wxEmptyString, wxDefaultPosition, wxSize(480, 240),
+            wxTE_MULTILINE | wxTE_READONLY);
+
+        gridSizer->Add(
+            mShipCostsReportTextCtrl,
+            wxGBPosition(0, 0),
+            wxGBSpan(1, 1),
+            wxEXPAND | wxALL,
+            CellBorder);
+    }
+
+    //
+    // Refresh
+    //
+
+    {
+        auto refreshButton = new wxButton(panel, wxID_ANY, _("Refresh"));
+
+        refreshButton->Bind(
+            wxEVT_BUTTON,
+            [this](wxCommandEvent &)
+            {
+                // The costs in the last stats period, the most expensive ship first
+                std::string report;
+                for (auto const & shipReport : mGameController->GetShipPerfReports())
+                {
+                    report += shipReport + "\n";
+                }
+
+                mShipCostsReportTextCtrl->SetValue(report);
+            });
+
+        gridSizer->Add(
+            refreshButton,
+            wxGBPosition(1, 0),
+            wxGBSpan(1, 1),
+            wxALIGN_RIGHT | wxALL,
+            CellBorder);
+    }
+
+    // Finalize panel
+
+    panel->SetSizerAndFit(gridSizer);
+}
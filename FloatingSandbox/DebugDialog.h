@@ -32,6 +32,11 @@ private:
 
     void PopulateTrianglesPanel(wxPanel * panel);
     void PopulateEventRecordingPanel(wxPanel * panel);
+    void PopulateProfilingPanel(wxPanel * panel);
+    void PopulateMemoryPanel(wxPanel * panel);
+    void PopulateShipCostsPanel(wxPanel * panel);
+
+    void OnRecordedEventsAvailable();
 
     inline void SetRecordedEventText(
         uint32_t eventIndex,
@@ -52,6 +57,14 @@ private:
     wxButton * mRecordEventStopButton;
     wxButton * mRecordEventStepButton;
     wxButton * mRecordEventRewindButton;
+    wxButton * mRecordEventReplayAllButton;
+    wxButton * mRecordEventSaveButton;
+    wxButton * mProfilingStartButton;
+    wxButton * mProfilingStopButton;
+    wxButton * mTelemetryStartButton;
+    wxButton * mTelemetryStopButton;
+    wxTextCtrl * mMemoryReportTextCtrl;
+    wxTextCtrl * mShipCostsReportTextCtrl;
 
 private:
 
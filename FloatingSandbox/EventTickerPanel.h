@@ -38,7 +38,7 @@ public:
     void RegisterEventHandler(IGameController & gameController)
     {
         gameController.RegisterLifecycleEventHandler(this);
-        gameController.RegisterStructuralEventHandler(this);
+        gameController.RegisterStructuralEventHandler(this, StructuralGameEventMask::Stress | StructuralGameEventMask::Break);
         gameController.RegisterWavePhenomenaEventHandler(this);
         gameController.RegisterElectricalElementEventHandler(this);
         gameController.RegisterGenericEventHandler(this);
@@ -170,7 +170,7 @@ MainApp::MainApp()
     // Initialize this thread
     //
 
-    SystemThreadManager::GetInstance().InitializeThisThread();
+    SystemThreadManager::GetInstance().InitializeThisThread(SystemThreadManager::ThreadRole::Main);
 
     //
     // Install handler for unhandled exceptions
@@ -313,6 +313,13 @@ int MainApp::FilterEvent(wxEvent & event)
 {
     if (nullptr != mMainFrame)
     {
+        // Any user input - anywhere - might change what the game renders;
+        // note: we don't care about UI events, as those include our own paints
+        if (event.GetEventCategory() == wxEVT_CATEGORY_USER_INPUT)
+        {
+            mMainFrame->OnUserInput();
+        }
+
         // This is the only way for us to catch KEY_UP events
         if (event.GetEventType() == wxEVT_KEY_UP)
         {
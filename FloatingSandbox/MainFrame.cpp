@@ -20,6 +20,8 @@
 #include <GameCore/BootSettings.h>
 #include <GameCore/GameException.h>
 #include <GameCore/Log.h>
+#include <GameCore/SysSpecifics.h>
+#include <GameCore/SystemThreadManager.h>
 #include <GameCore/Utils.h>
 #include <GameCore/Version.h>
 
@@ -30,6 +32,7 @@
 #include <wx/sizer.h>
 #include <wx/string.h>
 #include <wx/tooltip.h>
+#include <wx/utils.h>
 
 #include <cassert>
 #include <chrono>
@@ -38,6 +41,7 @@
 #include <map>
 #include <sstream>
 #include <thread>
+#include <utility>
 
 #ifdef _MSC_VER
  // Nothing to do here - we use RC files
@@ -118,6 +122,9 @@ MainFrame::MainFrame(
     , mInitialShipFilePath(initialShipFilePath)
     , mCurrentShipLoadSpecs()
     , mPreviousShipLoadSpecs()
+    , mShipLoadProgress()
+    , mPendingShipDescription()
+    , mPendingShipLoadError()
     , mHasWindowBeenShown(false)
     , mHasStartupTipBeenChecked(false)
     , mIsGameFrozen(false)
@@ -127,6 +134,7 @@ MainFrame::MainFrame(
     , mCurrentAntiMatterBombCount(0u)
     , mIsShiftKeyDown(false)
     , mIsMouseCapturedByGLCanvas(false)
+    , mStartupTimestamp(std::chrono::steady_clock::now())
 {
     Create(
         nullptr,
@@ -751,6 +759,14 @@ bool MainFrame::ProcessKeyDown(
     return false;
 }
 
+void MainFrame::OnUserInput()
+{
+    if (!!mGameController)
+    {
+        mGameController->RequestRender();
+    }
+}
+
 bool MainFrame::ProcessKeyUp(
     int keyCode,
     int keyModifiers)
@@ -824,6 +840,15 @@ void MainFrame::OnPostInitializeTrigger(wxTimerEvent & /*event*/)
 
     auto const bootSettings = BootSettings::Load(mResourceLocator.GetBootSettingsFilePath());
 
+    // Needs to be set before any of the large buffers is allocated
+    SetUseHugePagesForLargeBuffers(bootSettings.DoUseHugePages.value_or(false));
+
+    // Needs to be set before any of the threads is started
+    SystemThreadManager::GetInstance().SetPolicies(
+        SystemThreadManager::ThreadPolicies(
+            bootSettings.DoPreferPerformanceCores.value_or(false),
+            bootSettings.DoSeparateRenderThread.value_or(false),
+            bootSettings.DoElevateMainThreadPriority.value_or(false)));
 
     //
     // Create splash screen
@@ -853,6 +878,24 @@ void MainFrame::OnPostInitializeTrigger(wxTimerEvent & /*event*/)
     // Create the main - and only - OpenGL context on the current (splash) canvas
     mMainGLCanvasContext = std::make_unique<wxGLContext>(mCurrentOpenGLCanvas.load());
 
+    std::optional<bool> doForceNoMultithreadedRendering = bootSettings.DoForceNoMultithreadedRendering;
+
+#if FS_IS_OS_LINUX()
+    // Create the render thread's context, sharing objects with the main one
+    mRenderThreadGLCanvasContext = std::make_unique<wxGLContext>(mCurrentOpenGLCanvas.load(), mMainGLCanvasContext.get());
+    if (!mRenderThreadGLCanvasContext->IsOK())
+    {
+        LogMessage("MainFrame::OnPostInitializeTrigger: cannot create shared OpenGL context for render thread");
+        mRenderThreadGLCanvasContext.reset();
+
+        // Do not share the main context with the render thread, unless explicitly asked for
+        if (!doForceNoMultithreadedRendering.has_value())
+        {
+            doForceNoMultithreadedRendering = true;
+        }
+    }
+#endif
+
 #if defined(_DEBUG) && defined(_WIN32)
     LogMessage("MainFrame::OnPostInitializeTrigger: Hiding SplashScreenDialog");
     // The guy is pesky while debugging
@@ -875,7 +918,7 @@ void MainFrame::OnPostInitializeTrigger(wxTimerEvent & /*event*/)
                     mMainGLCanvas->GetSize().GetHeight()),
                 mMainGLCanvas->GetContentScaleFactor(),
                 bootSettings.DoForceNoGlFinish,
-                bootSettings.DoForceNoMultithreadedRendering,
+                doForceNoMultithreadedRendering,
                 std::bind(&MainFrame::MakeOpenGLContextCurrent, this),
                 [this]()
                 {
@@ -1055,45 +1098,9 @@ void MainFrame::OnPostInitializeTrigger(wxTimerEvent & /*event*/)
 
 
     //
-    // Create ShipBuilder frame
+    // Note: the ShipBuilder frame - together with its textures - is only created at first use
     //
 
-    {
-        try
-        {
-            mShipBuilderMainFrame = std::make_unique<ShipBuilder::MainFrame>(
-                mMainApp,
-                GetIcon(),
-                mResourceLocator,
-                mLocalizationManager,
-                mGameController->GetMaterialDatabase(),
-                mGameController->GetShipTexturizer(),                
-                [this](std::optional<std::filesystem::path> shipFilePath)
-                {
-                    this->SwitchFromShipBuilder(shipFilePath);
-                },
-                [&splash, this](float progress, ProgressMessageType message)
-                {
-                    // 0.85 -> 0.99
-                    splash->UpdateProgress(0.85f + progress * 0.14f, message);
-                    this->mMainApp->Yield();
-                    this->mMainApp->Yield();
-                    this->mMainApp->Yield();
-                });
-        }
-        catch (std::exception const & e)
-        {
-            splash.reset();
-
-            OnError("Error during initialization of ship builder: " + std::string(e.what()), true);
-
-            return;
-        }
-
-        // Given that we might have made another OpenGL context current, make our context current again
-        mGameController->RebindOpenGLContext();
-    }
-
     //
     // Register game event handlers
     //
@@ -1215,7 +1222,7 @@ void MainFrame::OnPostInitializeTrigger(wxTimerEvent & /*event*/)
 
     // Ensure 1 second of real time is (no less than) 1 second of simulation
     mGameTimerDuration = std::chrono::duration_cast<std::chrono::milliseconds>(
-        std::chrono::duration<float>(mGameController->GetSimulationStepTimeDuration()));
+        std::chrono::duration<float>(mGameController->GetGameIterationTimeDuration()));
 
     LogMessage("Game timer duration: ", mGameTimerDuration.count());
 
@@ -1388,6 +1395,12 @@ void MainFrame::OnMainGLCanvasPaint(wxPaintEvent & event)
         mSplashScreenDialog.reset();
     }
 
+    // The canvas has been (at least partially) invalidated
+    if (!!mGameController)
+    {
+        mGameController->RequestRender();
+    }
+
     event.Skip();
 }
 
@@ -1505,7 +1518,8 @@ void MainFrame::OnLoadShipMenuItemSelected(wxCommandEvent & /*event*/)
     {
         mShipLoadDialog = std::make_unique<ShipLoadDialog<ShipLoadDialogUsageType::ForGame>>(
             this,
-            mResourceLocator);
+            mResourceLocator,
+            &mGameController->GetMaterialDatabase());
     }
 
     // Open dialog
@@ -2118,6 +2132,24 @@ void MainFrame::RunGameIteration()
         }
     }
 
+    // Tell the user about the outcome of ship loads, now that we're out of the game iteration
+    // (immediately forgetting about it, to prevent events firing while the dialog is open to re-enter here)
+    if (mPendingShipLoadError)
+    {
+        auto const error = std::exchange(mPendingShipLoadError, nullptr);
+        OnShipLoadFailed(error);
+    }
+    else if (mPendingShipDescription.has_value())
+    {
+        auto const shipMetadata = std::move(*mPendingShipDescription);
+        mPendingShipDescription.reset();
+        ShowShipDescription(shipMetadata);
+    }
+
+    // The game iteration rate changes when rendering is interpolated
+    mGameTimerDuration = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::duration<float>(mGameController->GetGameIterationTimeDuration()));
+
 #if FS_IS_OS_WINDOWS()
     if (mHasStartupTipBeenChecked)
     {
@@ -2171,6 +2203,12 @@ void MainFrame::RunGameIteration()
         assert(!!mToolController);
         mToolController->UpdateSimulation(mGameController->GetCurrentSimulationTime());
 
+        // Tools keep acting for as long as the mouse is held down, regardless of input
+        if (mIsMouseCapturedByGLCanvas)
+        {
+            mGameController->RequestRender();
+        }
+
         // Update and render
         ////LogMessage("TODOTEST: MainFrame::OnGameTimerTrigger: Running game iteration; IsSplashShown=",
         ////    !!mSplashScreenDialog ? std::to_string(mSplashScreenDialog->IsShown()) : "<NoSplash>",
@@ -2179,6 +2217,14 @@ void MainFrame::RunGameIteration()
         assert(!!mGameController);
         mGameController->RunGameIteration();
 
+        if (mStartupTimestamp.has_value())
+        {
+            auto const elapsed = std::chrono::duration_cast<std::chrono::duration<float>>(std::chrono::steady_clock::now() - *mStartupTimestamp);
+            LogMessage("Time to first frame: ", elapsed.count(), "s");
+
+            mStartupTimestamp.reset();
+        }
+
         // Update probe panel
         assert(!!mProbePanel);
         mProbePanel->UpdateSimulation();
@@ -2289,6 +2335,13 @@ void MainFrame::UpdateFrameTitle()
             << Utils::Join(mCurrentShipTitles, " + ");
     }
 
+    if (mShipLoadProgress.has_value())
+    {
+        ss << " - "
+            << _("Loading ship...").ToStdString()
+            << " " << static_cast<int>(*mShipLoadProgress * 100.0f) << "%";
+    }
+
     SetTitle(ss.str());
 }
 
@@ -2506,9 +2559,54 @@ void MainFrame::LoadShip(
     bool isFromUser)
 {
     //
-    // Reset
+    // Load ship - in the background, while the current one keeps going;
+    // this also cancels any other ship we might be still loading
     //
 
+    assert(!!mGameController);
+    mGameController->ResetAndLoadShipAsync(
+        loadSpecs,
+        ShipLoadCallbacks{
+            // OnProgress
+            [this](float progress, ProgressMessageType /*message*/)
+            {
+                mShipLoadProgress = progress;
+                UpdateFrameTitle();
+            },
+            // OnBeforeShipSwap
+            [this]()
+            {
+                ResetForNewShip();
+            },
+            // OnShipLoaded
+            [this, loadSpecs, isFromUser](ShipMetadata const & shipMetadata)
+            {
+                mShipLoadProgress.reset();
+                UpdateFrameTitle();
+
+                OnShipLoaded(loadSpecs);
+
+                // Open description, if a description exists and the user allows
+                if (isFromUser
+                    && shipMetadata.Description.has_value()
+                    && mUIPreferencesManager->GetShowShipDescriptionsAtShipLoad())
+                {
+                    mPendingShipDescription = shipMetadata;
+                }
+            },
+            // OnShipLoadFailed
+            [this](std::exception_ptr error)
+            {
+                mShipLoadProgress.reset();
+                UpdateFrameTitle();
+
+                mPendingShipLoadError = error;
+            }
+        });
+}
+
+void MainFrame::ResetForNewShip()
+{
     assert(!!mToolController);
     mToolController->Reset();
 
@@ -2519,49 +2617,6 @@ void MainFrame::LoadShip(
     mMusicController->Reset();
 
     ResetShipUIState();
-    
-    //
-    // Load ship
-    //
-
-    try
-    {
-        // Load
-        assert(!!mGameController);
-        auto const shipMetadata = mGameController->ResetAndLoadShip(loadSpecs);
-
-        // Succeeded
-        OnShipLoaded(loadSpecs);
-
-        // Open description, if a description exists and the user allows
-        if (isFromUser
-            && shipMetadata.Description.has_value()
-            && mUIPreferencesManager->GetShowShipDescriptionsAtShipLoad())
-        {
-            ShipDescriptionDialog shipDescriptionDialog(
-                this,
-                shipMetadata,
-                true,
-                mResourceLocator);
-
-            shipDescriptionDialog.ShowModal();
-
-            // Store user preference, in case they made a choice
-            auto const showDescriptionsUserPreference = shipDescriptionDialog.GetShowDescriptionsUserPreference();
-            if (showDescriptionsUserPreference.has_value())
-            {
-                mUIPreferencesManager->SetShowShipDescriptionsAtShipLoad(*showDescriptionsUserPreference);
-            }
-        }
-    }
-    catch (UserGameException const & exc)
-    {
-        OnError(mLocalizationManager.MakeErrorMessage(exc), false);
-    }
-    catch (std::exception const & ex)
-    {
-        OnError(ex.what(), false);
-    }
 }
 
 void MainFrame::OnShipLoaded(ShipLoadSpecifications loadSpecs)
@@ -2585,7 +2640,43 @@ void MainFrame::OnShipLoaded(ShipLoadSpecifications loadSpecs)
     mCurrentShipLoadSpecs = loadSpecs;
 
     assert(!!mUIPreferencesManager);
-    mUIPreferencesManager->SetLastShipLoadedSpecifications(loadSpecs);
+    ShipLoadSpecifications lastShipLoadedSpecs = loadSpecs;
+    lastShipLoadedSpecs.Definition.reset(); // Not persisted, no need to keep it alive
+    mUIPreferencesManager->SetLastShipLoadedSpecifications(lastShipLoadedSpecs);
+}
+
+void MainFrame::OnShipLoadFailed(std::exception_ptr error)
+{
+    try
+    {
+        std::rethrow_exception(error);
+    }
+    catch (UserGameException const & exc)
+    {
+        OnError(mLocalizationManager.MakeErrorMessage(exc), false);
+    }
+    catch (std::exception const & ex)
+    {
+        OnError(ex.what(), false);
+    }
+}
+
+void MainFrame::ShowShipDescription(ShipMetadata const & shipMetadata)
+{
+    ShipDescriptionDialog shipDescriptionDialog(
+        this,
+        shipMetadata,
+        true,
+        mResourceLocator);
+
+    shipDescriptionDialog.ShowModal();
+
+    // Store user preference, in case they made a choice
+    auto const showDescriptionsUserPreference = shipDescriptionDialog.GetShowDescriptionsUserPreference();
+    if (showDescriptionsUserPreference.has_value())
+    {
+        mUIPreferencesManager->SetShowShipDescriptionsAtShipLoad(*showDescriptionsUserPreference);
+    }
 }
 
 wxAcceleratorEntry MainFrame::MakePlainAcceleratorKey(int key, wxMenuItem * menuItem)
@@ -2611,8 +2702,56 @@ wxAcceleratorEntry MainFrame::MakePlainAcceleratorKey(int key, wxMenuItem * menu
     return entry;
 }
 
+bool MainFrame::EnsureShipBuilder()
+{
+    if (!mShipBuilderMainFrame)
+    {
+        wxBusyCursor wait;
+
+        try
+        {
+            mShipBuilderMainFrame = std::make_unique<ShipBuilder::MainFrame>(
+                mMainApp,
+                GetIcon(),
+                mResourceLocator,
+                mLocalizationManager,
+                mGameController->GetMaterialDatabase(),
+                mGameController->GetShipTexturizer(),
+                [this](std::optional<std::filesystem::path> shipFilePath, std::shared_ptr<ShipDefinition const> shipDefinition)
+                {
+                    this->SwitchFromShipBuilder(shipFilePath, std::move(shipDefinition));
+                },
+                [this](float /*progress*/, ProgressMessageType /*message*/)
+                {
+                    this->mMainApp->Yield();
+                });
+        }
+        catch (std::exception const & e)
+        {
+            mShipBuilderMainFrame.reset();
+
+            // Given that we might have made another OpenGL context current, make our context current again
+            mGameController->RebindOpenGLContext();
+
+            OnError("Error during initialization of ship builder: " + std::string(e.what()), false);
+
+            return false;
+        }
+
+        // Given that we might have made another OpenGL context current, make our context current again
+        mGameController->RebindOpenGLContext();
+    }
+
+    return true;
+}
+
 void MainFrame::SwitchToShipBuilderForNewShip()
 {
+    if (!EnsureShipBuilder())
+    {
+        return;
+    }
+
     // Freeze game
     FreezeGame();
 
@@ -2626,6 +2765,11 @@ void MainFrame::SwitchToShipBuilderForNewShip()
 
 void MainFrame::SwitchToShipBuilderForCurrentShip()
 {
+    if (!EnsureShipBuilder())
+    {
+        return;
+    }
+
     // Freeze game
     FreezeGame();
 
@@ -2635,10 +2779,23 @@ void MainFrame::SwitchToShipBuilderForCurrentShip()
     // Open ShipBuilder frame for editing current ship
     assert(mShipBuilderMainFrame);
     assert(mCurrentShipLoadSpecs.has_value());
-    mShipBuilderMainFrame->OpenForLoadShip(mCurrentShipLoadSpecs->DefinitionFilepath, mUIPreferencesManager->GetDisplayUnitsSystem());
+    if (mCurrentShipLoadSpecs->Definition)
+    {
+        // We still have the ship the builder gave us, no need to load it again
+        mShipBuilderMainFrame->OpenForLoadShip(
+            mCurrentShipLoadSpecs->Definition->Clone(),
+            mCurrentShipLoadSpecs->DefinitionFilepath,
+            mUIPreferencesManager->GetDisplayUnitsSystem());
+    }
+    else
+    {
+        mShipBuilderMainFrame->OpenForLoadShip(mCurrentShipLoadSpecs->DefinitionFilepath, mUIPreferencesManager->GetDisplayUnitsSystem());
+    }
 }
 
-void MainFrame::SwitchFromShipBuilder(std::optional<std::filesystem::path> shipFilePath)
+void MainFrame::SwitchFromShipBuilder(
+    std::optional<std::filesystem::path> shipFilePath,
+    std::shared_ptr<ShipDefinition const> shipDefinition)
 {
     // Show us
     Show(true);
@@ -2652,8 +2809,8 @@ void MainFrame::SwitchFromShipBuilder(std::optional<std::filesystem::path> shipF
 
     if (shipFilePath.has_value())
     {
-        // Load the ship
-        LoadShip(ShipLoadSpecifications(*shipFilePath), false);
+        // Load the ship - straight from its definition, when the builder gave it to us
+        LoadShip(ShipLoadSpecifications(*shipFilePath, std::move(shipDefinition)), false);
     }
     else
     {
@@ -29,7 +29,9 @@
 #include <Game/GameController.h>
 #include <Game/IGameEventHandlers.h>
 #include <Game/ResourceLocator.h>
+#include <Game/ShipDefinition.h>
 #include <Game/ShipLoadSpecifications.h>
+#include <Game/ShipMetadata.h>
 
 #include "SplashScreenDialog.h" // Need to include this (which includes wxGLCanvas) *after* our glad.h has been included,
  // so that wxGLCanvas ends up *not* including the system's OpenGL header but glad's instead
@@ -37,11 +39,13 @@
 #include <wx/frame.h>
 #include <wx/menu.h>
 #include <wx/sizer.h>
+#include <wx/thread.h>
 #include <wx/timer.h>
 
 #include <atomic>
 #include <chrono>
 #include <cstdint>
+#include <exception>
 #include <filesystem>
 #include <memory>
 #include <optional>
@@ -72,6 +76,8 @@ public:
         int keyCode,
         int keyModifiers);
 
+    void OnUserInput();
+
     void OnSecretTypingBootSettings();
     void OnSecretTypingDebug();
     void OnSecretTypingLoadBuiltInShip(int ship);
@@ -88,6 +94,10 @@ private:
     GLCanvas * mMainGLCanvas;
     std::unique_ptr<wxGLContext> mMainGLCanvasContext;
 
+    // On X11 the render thread gets its own context, sharing objects with the main one,
+    // so that no context is ever current on more than one thread
+    std::unique_ptr<wxGLContext> mRenderThreadGLCanvasContext;
+
     // Pointer to the canvas that the OpenGL context may be made current on
     std::atomic<wxGLCanvas *> mCurrentOpenGLCanvas;
 
@@ -269,6 +279,13 @@ private:
         UpdateFrameTitle();
     }
 
+    virtual void OnShipSplit(ShipId /*shipId*/) override
+    {
+        // The elements the current tool is working on are gone
+        assert(!!mToolController);
+        mToolController->Reset();
+    }
+
     virtual void OnStormBegin() override
     {
         mTriggerStormMenuItem->Enable(false);
@@ -329,7 +346,16 @@ private:
         LogMessage("MainFrame::MakeOpenGLContextCurrent()");
 
         assert(mCurrentOpenGLCanvas.load() != nullptr);
-        mMainGLCanvasContext->SetCurrent(*(mCurrentOpenGLCanvas.load()));
+
+        if (!!mRenderThreadGLCanvasContext && !wxIsMainThread())
+        {
+            mRenderThreadGLCanvasContext->SetCurrent(*(mCurrentOpenGLCanvas.load()));
+        }
+        else
+        {
+            // Also when the render context has fallen back on single-threaded rendering
+            mMainGLCanvasContext->SetCurrent(*(mCurrentOpenGLCanvas.load()));
+        }
     }
 
     inline void AfterGameRender()
@@ -384,21 +410,31 @@ private:
         ShipLoadSpecifications const & loadSpecs,
         bool isFromUser);
 
+    void ResetForNewShip();
+
     void OnShipLoaded(ShipLoadSpecifications loadSpecs); // By val to have own copy vs current/prev
 
+    void OnShipLoadFailed(std::exception_ptr error);
+
+    void ShowShipDescription(ShipMetadata const & shipMetadata);
+
     wxAcceleratorEntry MakePlainAcceleratorKey(int key, wxMenuItem * menuItem);
 
+    bool EnsureShipBuilder();
+
     void SwitchToShipBuilderForNewShip();
 
     void SwitchToShipBuilderForCurrentShip();
 
-    void SwitchFromShipBuilder(std::optional<std::filesystem::path> shipFilePath);
+    void SwitchFromShipBuilder(
+        std::optional<std::filesystem::path> shipFilePath,
+        std::shared_ptr<ShipDefinition const> shipDefinition);
 
 private:
 
     wxApp * const mMainApp;
 
-    std::unique_ptr<ShipBuilder::MainFrame> mShipBuilderMainFrame;
+    std::unique_ptr<ShipBuilder::MainFrame> mShipBuilderMainFrame; // Created at first use
 
     //
     // Helpers
@@ -422,6 +458,11 @@ private:
     std::optional<ShipLoadSpecifications> mCurrentShipLoadSpecs;
     std::optional<ShipLoadSpecifications> mPreviousShipLoadSpecs;
 
+    // Ship being loaded in the background
+    std::optional<float> mShipLoadProgress;
+    std::optional<ShipMetadata> mPendingShipDescription; // To be shown at the next game iteration
+    std::exception_ptr mPendingShipLoadError; // To be shown at the next game iteration
+
     bool mHasWindowBeenShown;
     bool mHasStartupTipBeenChecked;
     bool mIsGameFrozen;
@@ -431,4 +472,5 @@ private:
     size_t mCurrentAntiMatterBombCount;
     bool mIsShiftKeyDown;
     bool mIsMouseCapturedByGLCanvas;
+    std::optional<std::chrono::steady_clock::time_point> mStartupTimestamp; // Reset after the first frame
 };
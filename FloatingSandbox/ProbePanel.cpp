@@ -31,8 +31,9 @@ ProbePanel::ProbePanel(wxWindow* parent)
 
     mProbesSizer = new wxBoxSizer(wxHORIZONTAL);
 
-    mFrameRateProbe = AddScalarTimeSeriesProbe<ScalarTimeSeriesProbeControl>(_("Frame Rate"), 200);
-    mCurrentUpdateDurationProbe = AddScalarTimeSeriesProbe<ScalarTimeSeriesProbeControl>(_("Update Time"), 200);
+    // Sampled at each frame: two frames per column, so that spikes stand out over a longer history
+    mFrameRateProbe = AddScalarTimeSeriesProbe<ScalarTimeSeriesProbeControl>(_("Frame Rate"), 200, 2);
+    mCurrentUpdateDurationProbe = AddScalarTimeSeriesProbe<ScalarTimeSeriesProbeControl>(_("Update Time"), 200, 2);
 
     mWaterTakenProbe = AddScalarTimeSeriesProbe<ScalarTimeSeriesProbeControl>(_("Water Inflow"), 120);
 
@@ -80,13 +81,14 @@ void ProbePanel::UpdateSimulation()
 template<typename TProbeControl>
 std::unique_ptr<TProbeControl> ProbePanel::AddScalarTimeSeriesProbe(
     wxString const & name,
-    int sampleCount)
+    int width,
+    int samplesPerColumn)
 {
     wxBoxSizer * sizer = new wxBoxSizer(wxVERTICAL);
 
     sizer->AddSpacer(TopPadding);
 
-    auto probe = std::make_unique<TProbeControl>(this, sampleCount);
+    auto probe = std::make_unique<TProbeControl>(this, width, samplesPerColumn);
     sizer->Add(probe.get(), 1, wxALIGN_CENTRE, 0);
 
     wxStaticText * label = new wxStaticText(this, wxID_ANY, name, wxDefaultPosition, wxDefaultSize, wxALIGN_CENTRE_HORIZONTAL);
@@ -165,10 +167,14 @@ void ProbePanel::OnStaticPressureUpdated(
     mStaticPressureComplexityProbe->RegisterSample(complexity);
 }
 
-void ProbePanel::OnBreak(
-    StructuralMaterial const & /*structuralMaterial*/,
-    bool /*isUnderwater*/,
-    unsigned int size)
+void ProbePanel::OnBreakBatch(StructuralMaterialEventAggregation const & events)
 {
+    // One sample for all of the damage since the last flush
+    unsigned int size = 0;
+    for (auto const & entry : events)
+    {
+        size += entry.second;
+    }
+
     mTotalDamageProbe->RegisterSample(static_cast<float>(size));
 }
\ No newline at end of file
@@ -46,7 +46,7 @@ public:
         gameController.RegisterStatisticsEventHandler(this);
 		gameController.RegisterAtmosphereEventHandler(this);
         gameController.RegisterGenericEventHandler(this);
-        gameController.RegisterStructuralEventHandler(this);
+        gameController.RegisterStructuralEventHandler(this, StructuralGameEventMask::Break);
     }
 
     void OnGameReset() override;
@@ -75,10 +75,7 @@ public:
         float netForce,
         float complexity) override;
 
-    void OnBreak(
-        StructuralMaterial const & structuralMaterial,
-        bool isUnderwater,
-        unsigned int size) override;
+    void OnBreakBatch(StructuralMaterialEventAggregation const & events) override;
 
 private:
 
@@ -90,7 +87,8 @@ private:
     template<typename TProbeControl>
     std::unique_ptr<TProbeControl> AddScalarTimeSeriesProbe(
         wxString const & name,
-        int sampleCount);
+        int width,
+        int samplesPerColumn = 1);
 
 private:
 
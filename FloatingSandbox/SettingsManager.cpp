@@ -145,6 +145,20 @@ BaseSettingsManager<GameSettings>::BaseSettingsManagerFactory SettingsManager::M
     ADD_GC_SETTING(unsigned int, NumberOfClouds);
     ADD_GC_SETTING(bool, DoDayLightCycle);
     ADD_GC_SETTING(std::chrono::minutes, DayLightCycleDuration);
+    ADD_GC_SETTING(bool, DoUpdateShipsConcurrently);
+    ADD_GC_SETTING(bool, DoUpdateOceanSurfaceConcurrently);
+    ADD_GC_SETTING(bool, DoPipelineFrames);
+    ADD_GC_SETTING(bool, DoInterpolateRendering);
+    ADD_GC_SETTING(float, RenderFrameRate);
+    ADD_GC_SETTING(bool, DoRenderOnDemand);
+    ADD_GC_SETTING(bool, DoThrottleIdleGameIterations);
+    ADD_GC_SETTING(bool, DoUpdateWaterAndPressureConcurrently);
+    ADD_GC_SETTING(bool, DoAdaptMechanicalDynamicsIterations);
+    ADD_GC_SETTING(bool, DoGovernSimulationTimeBudget);
+    ADD_GC_SETTING(bool, DoPutRestingConnectedComponentsToSleep);
+    ADD_GC_SETTING(bool, DoCompactDestroyedSprings);
+    ADD_GC_SETTING(bool, DoSplitDetachedFragments);
+    ADD_GC_SETTING(bool, DoUseImplicitHeatPropagation);
     ADD_GC_SETTING(float, ShipStrengthRandomizationDensityAdjustment);
     ADD_GC_SETTING(float, ShipStrengthRandomizationExtent);
 
@@ -200,7 +214,10 @@ SettingsManager::SettingsManager(
         MakeSettingsFactory(gameControllerSettings, soundController),
         rootSystemSettingsDirectoryPath,
         rootUserSettingsDirectoryPath)
-{}
+{
+    // Save user settings in the compact format, which is faster to list
+    SetPersistedSettingsFormat(PersistedSettingsFormats::Binary);
+}
 
 //
 // Specializations for special settings
@@ -118,6 +118,20 @@ enum class GameSettings : size_t
     NumberOfClouds,
     DoDayLightCycle,
     DayLightCycleDuration,
+    DoUpdateShipsConcurrently,
+    DoUpdateOceanSurfaceConcurrently,
+    DoPipelineFrames,
+    DoInterpolateRendering,
+    RenderFrameRate,
+    DoRenderOnDemand,
+    DoThrottleIdleGameIterations,
+    DoUpdateWaterAndPressureConcurrently,
+    DoAdaptMechanicalDynamicsIterations,
+    DoGovernSimulationTimeBudget,
+    DoPutRestingConnectedComponentsToSleep,
+    DoCompactDestroyedSprings,
+    DoSplitDetachedFragments,
+    DoUseImplicitHeatPropagation,
     ShipStrengthRandomizationDensityAdjustment,
     ShipStrengthRandomizationExtent,
 
@@ -11,6 +11,7 @@
 #include <GameCore/GameException.h>
 #include <GameCore/GameMath.h>
 #include <GameCore/Log.h>
+#include <GameCore/TaskThreadPool.h>
 
 #include <algorithm>
 #include <cassert>
@@ -18,6 +19,7 @@
 #include <cmath>
 #include <limits>
 #include <regex>
+#include <tuple>
 
 using namespace std::chrono_literals;
 
@@ -58,6 +60,8 @@ SoundController::SoundController(
     , mUOneShotMultipleChoiceSounds()
     , mOneShotMultipleChoiceSounds()
     , mCurrentlyPlayingOneShotSounds()
+    , mCurrentlyPlayingOneShotSoundsCount(0)
+    , mNewOneShotEffectSoundsInCurrentFrameCount(0)
     // Continuous sounds
     , mSawedMetalSound(SawedInertiaDuration)
     , mSawedWoodSound(SawedInertiaDuration)
@@ -103,20 +107,67 @@ SoundController::SoundController(
 
     auto soundNames = resourceLocator.GetSoundNames();
 
-    for (size_t i = 0; i < soundNames.size(); ++i)
+    //
+    // Load all sound files in parallel - decoding them is what takes the time;
+    // we do so in batches, so that we may notify progress from this thread
+    //
+
+    std::vector<std::unique_ptr<SoundFile>> soundFiles(soundNames.size());
+    std::vector<std::string> soundFileLoadErrors(soundNames.size());
+
     {
-        std::string const & soundName = soundNames[i];
+        TaskThreadPool taskThreadPool;
 
-        // Notify progress
-        progressCallback(
-            static_cast<float>(i + 1) / static_cast<float>(soundNames.size()),
-            ProgressMessageType::LoadingSounds);
+        size_t const batchSize = taskThreadPool.GetParallelism() * 4;
+        for (size_t batchStart = 0; batchStart < soundNames.size(); batchStart += batchSize)
+        {
+            size_t const batchEnd = std::min(batchStart + batchSize, soundNames.size());
 
-        //
-        // Load sound file
-        //
+            taskThreadPool.ParallelFor(
+                batchStart,
+                batchEnd,
+                1,
+                [&](size_t chunkStart, size_t chunkEnd)
+                {
+                    for (size_t i = chunkStart; i < chunkEnd; ++i)
+                    {
+                        try
+                        {
+                            soundFiles[i] = SoundFile::Load(resourceLocator.GetSoundFilePath(soundNames[i]));
+                        }
+                        catch (std::exception const & ex)
+                        {
+                            // Rethrown on this thread
+                            soundFileLoadErrors[i] = ex.what();
+                        }
+                    }
+                });
+
+            // Notify progress
+            progressCallback(
+                static_cast<float>(batchEnd) / static_cast<float>(soundNames.size()),
+                ProgressMessageType::LoadingSounds);
+        }
+    }
+
+    for (auto const & soundFileLoadError : soundFileLoadErrors)
+    {
+        if (!soundFileLoadError.empty())
+        {
+            throw GameException(soundFileLoadError);
+        }
+    }
+
+    //
+    // Register sounds
+    //
+
+    for (size_t i = 0; i < soundNames.size(); ++i)
+    {
+        std::string const & soundName = soundNames[i];
 
-        std::unique_ptr<SoundFile> soundFile = SoundFile::Load(resourceLocator.GetSoundFilePath(soundName));
+        std::unique_ptr<SoundFile> soundFile = std::move(soundFiles[i]);
+        assert(!!soundFile);
 
         //
         // Parse filename
@@ -1544,6 +1595,9 @@ void SoundController::PlayErrorSound()
 
 void SoundController::UpdateSimulation()
 {
+    // Start a new frame's budget of one-shot sounds
+    mNewOneShotEffectSoundsInCurrentFrameCount = 0;
+
     mWaveMakerSound.UpdateSimulation();
     mAirBubblesSurfacingSound.UpdateSimulation();
     mFireBurningSound.UpdateSimulation();
@@ -1578,6 +1632,7 @@ void SoundController::Reset()
     }
 
     mCurrentlyPlayingOneShotSounds.clear();
+    mCurrentlyPlayingOneShotSoundsCount = 0;
 
     mSawedMetalSound.Reset();
     mSawedWoodSound.Reset();
@@ -3031,6 +3086,16 @@ void SoundController::PlayOneShotSound(
         }
     }
 
+    //
+    // Make sure this frame's budget allows for this sound
+    //
+
+    if (soundGroupType == SoundGroupType::Effects
+        && mNewOneShotEffectSoundsInCurrentFrameCount >= MaxNewOneShotEffectSoundsPerFrame)
+    {
+        return;
+    }
+
     //
     // Make sure there's room for this sound
     //
@@ -3050,6 +3115,23 @@ void SoundController::PlayOneShotSound(
 
     assert(thisTypeCurrentlyPlayingSounds.size() < maxPlayingSoundsForThisType);
 
+    if (mCurrentlyPlayingOneShotSoundsCount >= MaxPlayingOneShotSounds)
+    {
+        for (auto & playingSoundIt : mCurrentlyPlayingOneShotSounds)
+        {
+            ScavengeStoppedSounds(playingSoundIt.second);
+        }
+
+        if (mCurrentlyPlayingOneShotSoundsCount >= MaxPlayingOneShotSounds
+            && !ScavengeLowestPrioritySound(GetPriorityForType(soundType, soundGroupType)))
+        {
+            // All voices are taken by more important sounds
+            return;
+        }
+    }
+
+    assert(mCurrentlyPlayingOneShotSoundsCount < MaxPlayingOneShotSounds);
+
     //
     // Create and play sound
     //
@@ -3092,6 +3174,13 @@ void SoundController::PlayOneShotSound(
         std::move(sound),
         now,
         isInterruptible);
+
+    ++mCurrentlyPlayingOneShotSoundsCount;
+
+    if (soundGroupType == SoundGroupType::Effects)
+    {
+        ++mNewOneShotEffectSoundsInCurrentFrameCount;
+    }
 }
 
 void SoundController::ScavengeStoppedSounds(std::vector<PlayingSound> & playingSounds)
@@ -3103,6 +3192,9 @@ void SoundController::ScavengeStoppedSounds(std::vector<PlayingSound> & playingS
         {
             // Scavenge
             it = playingSounds.erase(it);
+
+            assert(mCurrentlyPlayingOneShotSoundsCount > 0);
+            --mCurrentlyPlayingOneShotSoundsCount;
         }
         else
         {
@@ -3155,4 +3247,53 @@ void SoundController::ScavengeOldestSound(std::vector<PlayingSound> & playingSou
     assert(!!playingSounds[iSoundToStop].Sound);
     playingSounds[iSoundToStop].Sound->stop();
     playingSounds.erase(playingSounds.begin() + iSoundToStop);
-}
\ No newline at end of file
+
+    assert(mCurrentlyPlayingOneShotSoundsCount > 0);
+    --mCurrentlyPlayingOneShotSoundsCount;
+}
+
+bool SoundController::ScavengeLowestPrioritySound(int maxPriority)
+{
+    //
+    // Choose - among all types - the sound with the lowest priority, and among
+    // those the oldest one, preferring interruptible sounds to non interruptible ones
+    //
+
+    std::vector<PlayingSound> * victimPlayingSounds = nullptr;
+    size_t iVictimSound = 0;
+    auto victimKey = std::make_tuple(std::numeric_limits<int>::max(), true, std::chrono::steady_clock::time_point::max());
+
+    for (auto & playingSoundIt : mCurrentlyPlayingOneShotSounds)
+    {
+        auto & playingSounds = playingSoundIt.second;
+        for (size_t i = 0; i < playingSounds.size(); ++i)
+        {
+            int const priority = GetPriorityForType(playingSounds[i].Type, playingSounds[i].GroupType);
+            if (priority > maxPriority)
+                continue;
+
+            auto const key = std::make_tuple(priority, !playingSounds[i].IsInterruptible, playingSounds[i].StartedTimestamp);
+            if (key < victimKey)
+            {
+                victimPlayingSounds = &playingSounds;
+                iVictimSound = i;
+                victimKey = key;
+            }
+        }
+    }
+
+    if (victimPlayingSounds == nullptr)
+    {
+        // Nothing we may steal
+        return false;
+    }
+
+    assert(!!(*victimPlayingSounds)[iVictimSound].Sound);
+    (*victimPlayingSounds)[iVictimSound].Sound->stop();
+    victimPlayingSounds->erase(victimPlayingSounds->begin() + iVictimSound);
+
+    assert(mCurrentlyPlayingOneShotSoundsCount > 0);
+    --mCurrentlyPlayingOneShotSoundsCount;
+
+    return true;
+}
@@ -506,6 +506,8 @@ private:
 
     void ScavengeOldestSound(std::vector<PlayingSound> & playingSounds);
 
+    bool ScavengeLowestPrioritySound(int maxPriority);
+
 private:
 
     //
@@ -560,6 +562,37 @@ private:
         }
     }
 
+    // The max number of one-shot sounds playing at any moment, across all types;
+    // leaves room in the audio device for the continuous sounds and the music
+    static size_t constexpr MaxPlayingOneShotSounds = 160;
+
+    // The max number of new one-shot effect sounds that may be started in a single frame;
+    // events beyond these are dropped, as they would hardly be heard anyway
+    static size_t constexpr MaxNewOneShotEffectSoundsPerFrame = 24;
+
+    // The priority of a one-shot sound when competing for a voice;
+    // a new sound may only steal the voice of a sound with the same or lower priority
+    static constexpr int GetPriorityForType(SoundType soundType, SoundGroupType soundGroupType)
+    {
+        if (soundGroupType == SoundGroupType::Tools)
+        {
+            // Direct feedback to the user's actions
+            return 3;
+        }
+
+        switch (soundType)
+        {
+            case SoundType::Stress:
+                return 0;
+            case SoundType::Break:
+            case SoundType::Destroy:
+            case SoundType::LightFlicker:
+                return 1;
+            default:
+                return 2;
+        }
+    }
+
     static constexpr std::chrono::milliseconds GetMinDeltaTimeSoundForType(SoundType soundType)
     {
         switch (soundType)
@@ -605,6 +638,8 @@ private:
         OneShotMultipleChoiceSound> mOneShotMultipleChoiceSounds;
 
     std::unordered_map<SoundType, std::vector<PlayingSound>> mCurrentlyPlayingOneShotSounds;
+    size_t mCurrentlyPlayingOneShotSoundsCount; // Across all types
+    size_t mNewOneShotEffectSoundsInCurrentFrameCount;
 
     //
     // Continuous sounds
@@ -126,6 +126,8 @@ SplashScreenDialog::SplashScreenDialog(ResourceLocator const & resourceLocator)
         mProgressStrings.Add(_("Loading ShipBuilder..."));
         mProgressStrings.Add(_("Loading materials palette..."));
         mProgressStrings.Add(_("Calibrating game on the computer..."));
+        mProgressStrings.Add(_("Loading ship..."));
+        mProgressStrings.Add(_("Building ship..."));
         mProgressStrings.Add(_("Ready!"));
 
         assert(mProgressStrings.GetCount() == static_cast<size_t>(ProgressMessageType::_Last) + 1);
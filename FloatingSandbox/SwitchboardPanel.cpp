@@ -56,6 +56,7 @@ SwitchboardPanel::SwitchboardPanel(
     , mBackgroundSelectorPopup()
     //
     , mElementMap()
+    , mPendingUpdateElementIds()
     , mUpdateableElements()
     , mKeyboardShortcutToElementId()
     , mCurrentKeyDownElementId()
@@ -350,10 +351,28 @@ SwitchboardPanel::~SwitchboardPanel()
 {
 }
 
+void SwitchboardPanel::UpdateSimulation()
+{
+    // Nothing to update while the controls are not visible; the updates
+    // coalesce in the meantime
+    if (IsShowingFully())
+    {
+        ApplyPendingUpdates();
+
+        for (auto ctrl : mUpdateableElements)
+        {
+            ctrl->UpdateSimulation();
+        }
+    }
+}
+
 bool SwitchboardPanel::ProcessKeyDown(
     int keyCode,
     int keyModifiers)
 {
+    // Make sure the controls see their current state
+    ApplyPendingUpdates();
+
     if (!!mCurrentKeyDownElementId)
     {
         // This is the subsequent in a sequence of key downs...
@@ -465,6 +484,7 @@ void SwitchboardPanel::OnElectricalElementAnnouncementsBegin()
     // Clear maps
     mElementMap.clear();
     mUpdateableElements.clear();
+    mPendingUpdateElementIds.clear();
 
     // Clear keyboard shortcuts map
     mKeyboardShortcutToElementId.clear();
@@ -1191,10 +1211,10 @@ void SwitchboardPanel::OnSwitchEnabled(
     auto & elementInfo = mElementMap.at(electricalElementId);
     assert(elementInfo.Control == nullptr || elementInfo.Control->GetControlType() == ElectricalElementControl::ControlType::Switch);
 
-    SwitchElectricalElementControl * swCtrl = dynamic_cast<SwitchElectricalElementControl *>(elementInfo.Control);
-    if (swCtrl != nullptr)
+    if (elementInfo.Control != nullptr)
     {
-        swCtrl->SetEnabled(isEnabled);
+        elementInfo.PendingIsEnabled = isEnabled;
+        MarkPendingUpdate(electricalElementId, elementInfo);
     }
 }
 
@@ -1209,10 +1229,10 @@ void SwitchboardPanel::OnSwitchToggled(
     auto & elementInfo = mElementMap.at(electricalElementId);
     assert(elementInfo.Control == nullptr || elementInfo.Control->GetControlType() == ElectricalElementControl::ControlType::Switch);
 
-    SwitchElectricalElementControl * swCtrl = dynamic_cast<SwitchElectricalElementControl *>(elementInfo.Control);
-    if (swCtrl != nullptr)
+    if (elementInfo.Control != nullptr)
     {
-        swCtrl->SetState(newState);
+        elementInfo.PendingState = newState;
+        MarkPendingUpdate(electricalElementId, elementInfo);
     }
 }
 
@@ -1229,20 +1249,16 @@ void SwitchboardPanel::OnPowerProbeToggled(
     {
         if (elementInfo.Control->GetControlType() == ElectricalElementControl::ControlType::PowerMonitor)
         {
-            PowerMonitorElectricalElementControl * pmCtrl = dynamic_cast<PowerMonitorElectricalElementControl *>(elementInfo.Control);
-            assert(pmCtrl != nullptr);
-
-            pmCtrl->SetState(newState);
+            elementInfo.PendingState = newState;
         }
         else
         {
             assert(elementInfo.Control->GetControlType() == ElectricalElementControl::ControlType::Gauge);
 
-            GaugeElectricalElementControl * ggCtrl = dynamic_cast<GaugeElectricalElementControl *>(elementInfo.Control);
-            assert(ggCtrl != nullptr);
-
-            ggCtrl->SetValue(newState == ElectricalState::On ? 0.0f : 1.0f);
+            elementInfo.PendingValue = (newState == ElectricalState::On ? 0.0f : 1.0f);
         }
+
+        MarkPendingUpdate(electricalElementId, elementInfo);
     }
 }
 
@@ -1257,10 +1273,10 @@ void SwitchboardPanel::OnEngineControllerEnabled(
     auto & elementInfo = mElementMap.at(electricalElementId);
     assert(elementInfo.Control == nullptr || elementInfo.Control->GetControlType() == ElectricalElementControl::ControlType::EngineController);
 
-    EngineControllerElectricalElementControl * ecCtrl = dynamic_cast<EngineControllerElectricalElementControl *>(elementInfo.Control);
-    if (ecCtrl != nullptr)
+    if (elementInfo.Control != nullptr)
     {
-        ecCtrl->SetEnabled(isEnabled);
+        elementInfo.PendingIsEnabled = isEnabled;
+        MarkPendingUpdate(electricalElementId, elementInfo);
     }
 }
 
@@ -1277,10 +1293,10 @@ void SwitchboardPanel::OnEngineControllerUpdated(
     auto & elementInfo = mElementMap.at(electricalElementId);
     assert(elementInfo.Control == nullptr || elementInfo.Control->GetControlType() == ElectricalElementControl::ControlType::EngineController);
 
-    EngineControllerElectricalElementControl * ecCtrl = dynamic_cast<EngineControllerElectricalElementControl *>(elementInfo.Control);
-    if (ecCtrl != nullptr)
+    if (elementInfo.Control != nullptr)
     {
-        ecCtrl->SetValue(newControllerValue);
+        elementInfo.PendingValue = newControllerValue;
+        MarkPendingUpdate(electricalElementId, elementInfo);
     }
 }
 
@@ -1296,10 +1312,10 @@ void SwitchboardPanel::OnEngineMonitorUpdated(
     auto & elementInfo = mElementMap.at(electricalElementId);
     assert(elementInfo.Control == nullptr || elementInfo.Control->GetControlType() == ElectricalElementControl::ControlType::Gauge);
 
-    GaugeElectricalElementControl * ggCtrl = dynamic_cast<GaugeElectricalElementControl *>(elementInfo.Control);
-    if (ggCtrl != nullptr)
+    if (elementInfo.Control != nullptr)
     {
-        ggCtrl->SetValue(1.0f - rpm);
+        elementInfo.PendingValue = 1.0f - rpm;
+        MarkPendingUpdate(electricalElementId, elementInfo);
     }
 }
 
@@ -1322,10 +1338,10 @@ void SwitchboardPanel::OnWaterPumpUpdated(
     auto & elementInfo = mElementMap.at(electricalElementId);
     assert(elementInfo.Control == nullptr || elementInfo.Control->GetControlType() == ElectricalElementControl::ControlType::Gauge);
 
-    GaugeElectricalElementControl * ggCtrl = dynamic_cast<GaugeElectricalElementControl *>(elementInfo.Control);
-    if (ggCtrl != nullptr)
+    if (elementInfo.Control != nullptr)
     {
-        ggCtrl->SetValue(1.0f - normalizedForce);
+        elementInfo.PendingValue = 1.0f - normalizedForce;
+        MarkPendingUpdate(electricalElementId, elementInfo);
     }
 }
 
@@ -1340,10 +1356,10 @@ void SwitchboardPanel::OnWatertightDoorEnabled(
     auto & elementInfo = mElementMap.at(electricalElementId);
     assert(elementInfo.Control == nullptr || elementInfo.Control->GetControlType() == ElectricalElementControl::ControlType::Switch);
 
-    SwitchElectricalElementControl * swCtrl = dynamic_cast<SwitchElectricalElementControl *>(elementInfo.Control);
-    if (swCtrl != nullptr)
+    if (elementInfo.Control != nullptr)
     {
-        swCtrl->SetEnabled(isEnabled);
+        elementInfo.PendingIsEnabled = isEnabled;
+        MarkPendingUpdate(electricalElementId, elementInfo);
     }
 }
 
@@ -1358,10 +1374,10 @@ void SwitchboardPanel::OnWatertightDoorUpdated(
     auto & elementInfo = mElementMap.at(electricalElementId);
     assert(elementInfo.Control == nullptr || elementInfo.Control->GetControlType() == ElectricalElementControl::ControlType::Switch);
 
-    SwitchElectricalElementControl * swCtrl = dynamic_cast<SwitchElectricalElementControl *>(elementInfo.Control);
-    if (swCtrl != nullptr)
+    if (elementInfo.Control != nullptr)
     {
-        swCtrl->SetState(isOpen ? ElectricalState::On : ElectricalState::Off);
+        elementInfo.PendingState = isOpen ? ElectricalState::On : ElectricalState::Off;
+        MarkPendingUpdate(electricalElementId, elementInfo);
     }
 }
 
@@ -1429,6 +1445,7 @@ void SwitchboardPanel::ShowFullyFloating()
     mMainVSizer2->Show(mHintPanel);
 
     // Show switch panel
+    ApplyPendingUpdates();
     mMainVSizer2->Show(mSwitchPanel);
 
     // Transition state
@@ -1445,6 +1462,7 @@ void SwitchboardPanel::ShowFullyDocked()
     mMainVSizer2->Show(mHintPanel);
 
     // Show switch panel
+    ApplyPendingUpdates();
     mMainVSizer2->Show(mSwitchPanel);
 
     // Transition state
@@ -1604,4 +1622,78 @@ void SwitchboardPanel::OnTick(ElectricalElementId electricalElementId)
 {
     this->mGameController->HighlightElectricalElement(electricalElementId);
     this->mSoundController->PlayTickSound();
+}
+
+void SwitchboardPanel::MarkPendingUpdate(
+    ElectricalElementId electricalElementId,
+    ElectricalElementInfo & elementInfo)
+{
+    if (!elementInfo.HasPendingUpdate)
+    {
+        elementInfo.HasPendingUpdate = true;
+        mPendingUpdateElementIds.push_back(electricalElementId);
+    }
+}
+
+void SwitchboardPanel::ApplyPendingUpdates()
+{
+    for (auto const electricalElementId : mPendingUpdateElementIds)
+    {
+        auto & elementInfo = mElementMap.at(electricalElementId);
+        assert(elementInfo.HasPendingUpdate);
+        assert(elementInfo.Control != nullptr);
+
+        if (elementInfo.PendingIsEnabled.has_value())
+        {
+            assert(elementInfo.DisablableControl != nullptr);
+            elementInfo.DisablableControl->SetEnabled(*elementInfo.PendingIsEnabled);
+        }
+
+        if (elementInfo.PendingState.has_value())
+        {
+            if (elementInfo.Control->GetControlType() == ElectricalElementControl::ControlType::PowerMonitor)
+            {
+                PowerMonitorElectricalElementControl * pmCtrl = dynamic_cast<PowerMonitorElectricalElementControl *>(elementInfo.Control);
+                assert(pmCtrl != nullptr);
+
+                pmCtrl->SetState(*elementInfo.PendingState);
+            }
+            else
+            {
+                assert(elementInfo.Control->GetControlType() == ElectricalElementControl::ControlType::Switch);
+
+                SwitchElectricalElementControl * swCtrl = dynamic_cast<SwitchElectricalElementControl *>(elementInfo.Control);
+                assert(swCtrl != nullptr);
+
+                swCtrl->SetState(*elementInfo.PendingState);
+            }
+        }
+
+        if (elementInfo.PendingValue.has_value())
+        {
+            if (elementInfo.Control->GetControlType() == ElectricalElementControl::ControlType::EngineController)
+            {
+                EngineControllerElectricalElementControl * ecCtrl = dynamic_cast<EngineControllerElectricalElementControl *>(elementInfo.Control);
+                assert(ecCtrl != nullptr);
+
+                ecCtrl->SetValue(*elementInfo.PendingValue);
+            }
+            else
+            {
+                assert(elementInfo.Control->GetControlType() == ElectricalElementControl::ControlType::Gauge);
+
+                GaugeElectricalElementControl * ggCtrl = dynamic_cast<GaugeElectricalElementControl *>(elementInfo.Control);
+                assert(ggCtrl != nullptr);
+
+                ggCtrl->SetValue(*elementInfo.PendingValue);
+            }
+        }
+
+        elementInfo.PendingIsEnabled.reset();
+        elementInfo.PendingState.reset();
+        elementInfo.PendingValue.reset();
+        elementInfo.HasPendingUpdate = false;
+    }
+
+    mPendingUpdateElementIds.clear();
 }
\ No newline at end of file
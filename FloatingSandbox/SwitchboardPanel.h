@@ -54,13 +54,7 @@ public:
 
     ~SwitchboardPanel();
 
-    void UpdateSimulation()
-    {
-        for (auto ctrl : mUpdateableElements)
-        {
-            ctrl->UpdateSimulation();
-        }
-    }
+    void UpdateSimulation();
 
     bool ProcessKeyDown(
         int keyCode,
@@ -191,6 +185,12 @@ private:
         return mShowingMode != ShowingMode::NotShowing;
     }
 
+    bool IsShowingFully() const
+    {
+        return mShowingMode == ShowingMode::ShowingFullyFloating
+            || mShowingMode == ShowingMode::ShowingFullyDocked;
+    }
+
     void HideFully();
 
     void ShowPartially();
@@ -221,6 +221,16 @@ private:
 
     void OnTick(ElectricalElementId electricalElementId);
 
+private:
+
+    struct ElectricalElementInfo;
+
+    void MarkPendingUpdate(
+        ElectricalElementId electricalElementId,
+        ElectricalElementInfo & elementInfo);
+
+    void ApplyPendingUpdates();
+
 private:
 
     enum class ShowingMode
@@ -264,6 +274,13 @@ private:
         IInteractiveElectricalElementControl * InteractiveControl;
         std::optional<ElectricalPanelElementMetadata> PanelElementMetadata;
 
+        // The latest state received for the control since it was last updated;
+        // events are coalesced here and applied once per frame
+        std::optional<bool> PendingIsEnabled;
+        std::optional<ElectricalState> PendingState;
+        std::optional<float> PendingValue;
+        bool HasPendingUpdate;
+
         ElectricalElementInfo(
             ElectricalElementInstanceIndex instanceIndex,
             ElectricalElementControl * control,
@@ -275,11 +292,18 @@ private:
             , DisablableControl(disablableControl)
             , InteractiveControl(interactiveControl)
             , PanelElementMetadata(panelElementMetadata)
+            , PendingIsEnabled()
+            , PendingState()
+            , PendingValue()
+            , HasPendingUpdate(false)
         {}
     };
 
     std::unordered_map<ElectricalElementId, ElectricalElementInfo> mElementMap;
 
+    // The elements with pending updates
+    std::vector<ElectricalElementId> mPendingUpdateElementIds;
+
     // The electrical elements that need to be updated
     std::vector<IUpdateableElectricalElementControl *> mUpdateableElements;
 
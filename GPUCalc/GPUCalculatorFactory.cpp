@@ -40,6 +40,17 @@ std::unique_ptr<AddGPUCalculator> GPUCalculatorFactory::CreateAddCalculator(size
             dataPoints));
 }
 
+std::unique_ptr<SpringRelaxationGPUCalculator> GPUCalculatorFactory::CreateSpringRelaxationCalculator(size_t pointCount)
+{
+    CheckInitialized();
+
+    return std::unique_ptr<SpringRelaxationGPUCalculator>(
+        new SpringRelaxationGPUCalculator(
+            mOpenGLContextFactory(),
+            mShadersRootDirectory,
+            pointCount));
+}
+
 void GPUCalculatorFactory::CheckInitialized()
 {
     if (!mOpenGLContextFactory)
@@ -11,6 +11,7 @@
 
 #include "AddGPUCalculator.h"
 #include "PixelCoordsGPUCalculator.h"
+#include "SpringRelaxationGPUCalculator.h"
 
 #include <cassert>
 #include <filesystem>
@@ -36,6 +37,8 @@ public:
 
     std::unique_ptr<AddGPUCalculator> CreateAddCalculator(size_t dataPoints);
 
+    std::unique_ptr<SpringRelaxationGPUCalculator> CreateSpringRelaxationCalculator(size_t pointCount);
+
 private:
 
     GPUCalculatorFactory()
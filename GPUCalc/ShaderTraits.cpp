@@ -17,6 +17,8 @@ GPUCalcProgramType ShaderFilenameToGPUCalcProgramType(std::string const & str)
         return GPUCalcProgramType::PixelCoords;
     else if (lstr == "add")
         return GPUCalcProgramType::Add;
+    else if (lstr == "spring_relaxation")
+        return GPUCalcProgramType::SpringRelaxation;
     else
         throw GameException("Unrecognized program \"" + str + "\"");
 }
@@ -29,18 +31,34 @@ std::string GPUCalcProgramTypeToStr(GPUCalcProgramType program)
             return "PixelCoords";
         case GPUCalcProgramType::Add:
             return "Add";
+        case GPUCalcProgramType::SpringRelaxation:
+            return "SpringRelaxation";
         default:
             assert(false);
             throw GameException("Unsupported GPUCalcProgramType");
     }
 }
 
+bool IsLazilyCompiledGPUCalcProgram(GPUCalcProgramType /*program*/)
+{
+    // Each calculator only uses its own program
+    return true;
+}
+
 GPUCalcProgramParameterType StrToGPUCalcProgramParameterType(std::string const & str)
 {
     if (str == "TextureInput0")
         return GPUCalcProgramParameterType::TextureInput0;
     else if (str == "TextureInput1")
         return GPUCalcProgramParameterType::TextureInput1;
+    else if (str == "TextureInput2")
+        return GPUCalcProgramParameterType::TextureInput2;
+    else if (str == "DeltaTime")
+        return GPUCalcProgramParameterType::DeltaTime;
+    else if (str == "FrameSize")
+        return GPUCalcProgramParameterType::FrameSize;
+    else if (str == "VelocityFactor")
+        return GPUCalcProgramParameterType::VelocityFactor;
     else
         throw GameException("Unrecognized program parameter \"" + str + "\"");
 }
@@ -53,6 +71,14 @@ std::string GPUCalcProgramParameterTypeToStr(GPUCalcProgramParameterType program
             return "TextureInput0";
         case GPUCalcProgramParameterType::TextureInput1:
             return "TextureInput1";
+        case GPUCalcProgramParameterType::TextureInput2:
+            return "TextureInput2";
+        case GPUCalcProgramParameterType::DeltaTime:
+            return "DeltaTime";
+        case GPUCalcProgramParameterType::FrameSize:
+            return "FrameSize";
+        case GPUCalcProgramParameterType::VelocityFactor:
+            return "VelocityFactor";
         default:
             assert(false);
             throw GameException("Unsupported GPUCalcProgramParameterType");
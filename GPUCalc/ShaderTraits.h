@@ -14,22 +14,32 @@ enum class GPUCalcProgramType
 {
     PixelCoords = 0,
     Add = 1,
+    SpringRelaxation = 2,
 
-    _Last = Add
+    _Last = SpringRelaxation
 };
 
 GPUCalcProgramType ShaderFilenameToGPUCalcProgramType(std::string const & str);
 
 std::string GPUCalcProgramTypeToStr(GPUCalcProgramType program);
 
+// Programs which are only compiled the first time they are used
+bool IsLazilyCompiledGPUCalcProgram(GPUCalcProgramType program);
+
 enum class GPUCalcProgramParameterType : uint8_t
 {
     // Textures
     TextureInput0,                  // 0
     TextureInput1,                  // 1
+    TextureInput2,                  // 2
+
+    // Other parameters
+    DeltaTime,
+    FrameSize,
+    VelocityFactor,
 
     _FirstTexture = TextureInput0,
-    _LastTexture = TextureInput1
+    _LastTexture = TextureInput2
 };
 
 GPUCalcProgramParameterType StrToGPUCalcProgramParameterType(std::string const & str);
@@ -53,6 +63,7 @@ struct GPUCalcShaderManagerTraits
 
     static constexpr auto ShaderFilenameToProgramType = ShaderFilenameToGPUCalcProgramType;
     static constexpr auto ProgramTypeToStr = GPUCalcProgramTypeToStr;
+    static constexpr auto IsLazilyCompiledProgram = IsLazilyCompiledGPUCalcProgram;
     static constexpr auto StrToProgramParameterType = StrToGPUCalcProgramParameterType;
     static constexpr auto ProgramParameterTypeToStr = GPUCalcProgramParameterTypeToStr;
     static constexpr auto StrToVertexAttributeType = StrToGPUCalcVertexAttributeType;
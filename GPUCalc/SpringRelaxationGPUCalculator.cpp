@@ -0,0 +1,443 @@
+/***************************************************************************************
+* Original Author:      Gabriele Giuseppini
+* Created:              2026-10-14
+* Copyright:            Gabriele Giuseppini  (https://github.com/GabrieleGiuseppini)
+***************************************************************************************/
+#include "SpringRelaxationGPUCalculator.h"
+
+#include <GameOpenGL/GameOpenGL.h>
+
+#include <GameCore/GameException.h>
+#include <GameCore/Log.h>
+
+#include <algorithm>
+#include <string>
+
+SpringRelaxationGPUCalculator::SpringRelaxationGPUCalculator(
+    std::unique_ptr<IOpenGLContext> openGLContext,
+    std::filesystem::path const & shadersRootDirectory,
+    size_t pointCount)
+    : GPUCalculator(
+        std::move(openGLContext),
+        shadersRootDirectory)
+    , mPointCount(pointCount)
+    , mFrameSize(0, 0) // Temporary
+    , mCurrentStateIndex(0)
+    , mPointTransferBuffer()
+    , mSpringTransferBuffer()
+    , mSpringsPerPoint()
+{
+    assert(pointCount > 0);
+
+    // We need float render targets and texel fetches
+    if (GameOpenGL::MaxSupportedOpenGLVersionMajor < 3)
+    {
+        throw GameException("The spring relaxation GPU calculator requires OpenGL 3.0 or later");
+    }
+
+    GLuint tmpGLuint;
+
+    //
+    // Calculate geometry of buffers
+    //
+
+    assert(GameOpenGL::MaxViewportWidth > 0 && GameOpenGL::MaxViewportHeight > 0);
+    assert(GameOpenGL::MaxTextureSize > 0);
+    assert(GameOpenGL::MaxRenderbufferSize > 0);
+
+    // State textures are also render targets, hence the max possible width
+    // we consider is the min of the two max widths
+    int const maxWidth = std::min(GameOpenGL::MaxViewportWidth, GameOpenGL::MaxTextureSize);
+
+    // One pixel per point
+    mWholeRows = static_cast<int>(pointCount) / maxWidth;
+    mRemainderCols = static_cast<int>(pointCount) % maxWidth;
+
+    if (mWholeRows == 0)
+    {
+        // Less than a width
+        mFrameSize = ImageSize(mRemainderCols, 1);
+    }
+    else
+    {
+        // More than one full row
+        mFrameSize = ImageSize(maxWidth, mWholeRows + (mRemainderCols > 0 ? 1 : 0));
+    }
+
+    if (mFrameSize.height * static_cast<int>(MaxSpringsPerPoint) > GameOpenGL::MaxTextureSize)
+    {
+        throw GameException("Too many points for the spring relaxation GPU calculator");
+    }
+
+    LogMessage(
+        "SpringRelaxationGPUCalculator: FrameSize=", mFrameSize.width, "x", mFrameSize.height,
+        ", WholeRows=", mWholeRows, ", RemainderCols=", mRemainderCols);
+
+    size_t const frameTexelCount = static_cast<size_t>(mFrameSize.width) * static_cast<size_t>(mFrameSize.height);
+    mPointTransferBuffer.resize(frameTexelCount, vec4f::zero());
+    mSpringTransferBuffer.resize(frameTexelCount * MaxSpringsPerPoint, vec4f::zero());
+    mSpringsPerPoint.resize(pointCount, 0);
+
+
+    //
+    // Initialize this context
+    //
+
+    this->ActivateOpenGLContext();
+
+    // Set viewport size
+    glViewport(0, 0, mFrameSize.width, mFrameSize.height);
+    CheckOpenGLError();
+
+    // Set polygon mode
+    glPolygonMode(GL_FRONT_AND_BACK, GL_FILL);
+
+    // Disable stenciling, blend, and depth test
+    glDisable(GL_BLEND);
+    glDisable(GL_DEPTH_TEST);
+    glDepthMask(GL_FALSE);
+    glDisable(GL_STENCIL_TEST);
+
+
+    //
+    // Initialize program
+    //
+
+    GetShaderManager().ActivateProgram<GPUCalcProgramType::SpringRelaxation>();
+
+    GetShaderManager().SetTextureParameters<GPUCalcProgramType::SpringRelaxation>();
+
+    GetShaderManager().SetProgramParameter<GPUCalcProgramType::SpringRelaxation, GPUCalcProgramParameterType::FrameSize>(
+        static_cast<float>(mFrameSize.width),
+        static_cast<float>(mFrameSize.height));
+
+
+    //
+    // Prepare textures
+    //
+
+    glActiveTexture(GL_TEXTURE0);
+    CheckOpenGLError();
+
+    mStateTextures[0] = CreateDataTexture(mFrameSize.width, mFrameSize.height);
+    mStateTextures[1] = CreateDataTexture(mFrameSize.width, mFrameSize.height);
+
+    glActiveTexture(GL_TEXTURE1);
+    CheckOpenGLError();
+
+    // Start with no forces
+    mForcesTexture = CreateDataTexture(mFrameSize.width, mFrameSize.height);
+    UploadDataTexture(mForcesTexture, mFrameSize.height, mPointTransferBuffer.data());
+
+    glActiveTexture(GL_TEXTURE2);
+    CheckOpenGLError();
+
+    // Start with no springs
+    mSpringsTexture = CreateDataTexture(mFrameSize.width, mFrameSize.height * static_cast<int>(MaxSpringsPerPoint));
+    std::fill(mSpringTransferBuffer.begin(), mSpringTransferBuffer.end(), vec4f(-1.0f, 0.0f, 0.0f, 0.0f));
+    UploadDataTexture(mSpringsTexture, mFrameSize.height * static_cast<int>(MaxSpringsPerPoint), mSpringTransferBuffer.data());
+
+
+    //
+    // Create framebuffers, each rendering into one of the state textures
+    //
+
+    for (size_t s = 0; s < 2; ++s)
+    {
+        glGenFramebuffers(1, &tmpGLuint);
+        mStateFramebuffers[s] = tmpGLuint;
+
+        glBindFramebuffer(GL_FRAMEBUFFER, *mStateFramebuffers[s]);
+        CheckOpenGLError();
+
+        glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, *mStateTextures[s], 0);
+        CheckOpenGLError();
+
+        // Verify framebuffer is complete
+        if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE)
+        {
+            throw GameException("Framebuffer is not complete");
+        }
+
+        // Clear state
+        glClearColor(0.0f, 0.0f, 0.0f, 0.0f);
+        glClear(GL_COLOR_BUFFER_BIT);
+    }
+
+
+    //
+    // Create VBO and populate it with whole NDC world
+    //
+
+    glGenBuffers(1, &tmpGLuint);
+    mVertexVBO = tmpGLuint;
+
+    // Bind VBO
+    glBindBuffer(GL_ARRAY_BUFFER, *mVertexVBO);
+    CheckOpenGLError();
+
+    // Initialize buffer
+    // - Quad NDC coords
+    // - Texture coords (unused, as we fetch texels by pixel coordinates)
+    static vec4f quadVertices[6] = {
+        {-1.0f, -1.0f, 0.0f, 0.0f}, // LB
+        {-1.0f, 1.0f, 0.0f, 1.0f},  // LT
+        {1.0f, -1.0f, 1.0f, 0.0f},  // RB
+        {-1.0f, 1.0f, 0.0f, 1.0f},  // LT
+        {1.0f, -1.0f, 1.0f, 0.0f},  // RB
+        {1.0f, 1.0f, 1.0f, 1.0f}    // RT
+    };
+
+    // Upload buffer
+    glBufferData(
+        GL_ARRAY_BUFFER,
+        4 * sizeof(float) * 6,
+        quadVertices,
+        GL_STATIC_DRAW);
+
+    // Describe vertex attribute
+    glVertexAttribPointer(
+        static_cast<GLuint>(GPUCalcVertexAttributeType::VertexShaderInput0),
+        4,
+        GL_FLOAT,
+        GL_FALSE,
+        4 * sizeof(float),
+        (void*)0);
+
+    // Enable vertex attribute
+    glEnableVertexAttribArray(static_cast<GLuint>(GPUCalcVertexAttributeType::VertexShaderInput0));
+}
+
+void SpringRelaxationGPUCalculator::UploadSprings(
+    ElementIndex const * endpointAIndices,
+    ElementIndex const * endpointBIndices,
+    float const * restLengths,
+    float const * stiffnessCoefficients,
+    float const * dampingCoefficients,
+    size_t springCount)
+{
+    assert(nullptr != endpointAIndices);
+    assert(nullptr != endpointBIndices);
+    assert(nullptr != restLengths);
+    assert(nullptr != stiffnessCoefficients);
+    assert(nullptr != dampingCoefficients);
+
+    //
+    // Distribute springs to both of their endpoints
+    //
+
+    std::fill(mSpringTransferBuffer.begin(), mSpringTransferBuffer.end(), vec4f(-1.0f, 0.0f, 0.0f, 0.0f));
+    std::fill(mSpringsPerPoint.begin(), mSpringsPerPoint.end(), size_t(0));
+
+    size_t const springSlotStride = static_cast<size_t>(mFrameSize.width) * static_cast<size_t>(mFrameSize.height);
+
+    auto const addSpringToPoint = [&](ElementIndex pointIndex, ElementIndex otherPointIndex, size_t s)
+    {
+        assert(pointIndex < mPointCount);
+
+        size_t & springSlot = mSpringsPerPoint[pointIndex];
+        if (springSlot >= MaxSpringsPerPoint)
+        {
+            throw GameException("Point " + std::to_string(pointIndex) + " has too many springs for the spring relaxation GPU calculator");
+        }
+
+        // Pixels are laid out in the same order as points
+        mSpringTransferBuffer[springSlot * springSlotStride + pointIndex] = vec4f(
+            static_cast<float>(otherPointIndex),
+            restLengths[s],
+            stiffnessCoefficients[s],
+            dampingCoefficients[s]);
+
+        ++springSlot;
+    };
+
+    for (size_t s = 0; s < springCount; ++s)
+    {
+        if (stiffnessCoefficients[s] == 0.0f && dampingCoefficients[s] == 0.0f)
+        {
+            // Deleted spring, it imparts no forces
+            continue;
+        }
+
+        addSpringToPoint(endpointAIndices[s], endpointBIndices[s], s);
+        addSpringToPoint(endpointBIndices[s], endpointAIndices[s], s);
+    }
+
+    //
+    // Upload
+    //
+
+    this->ActivateOpenGLContext();
+
+    glActiveTexture(GL_TEXTURE2);
+
+    UploadDataTexture(mSpringsTexture, mFrameSize.height * static_cast<int>(MaxSpringsPerPoint), mSpringTransferBuffer.data());
+}
+
+void SpringRelaxationGPUCalculator::UploadPoints(
+    vec2f const * positions,
+    vec2f const * velocities)
+{
+    assert(nullptr != positions);
+    assert(nullptr != velocities);
+
+    for (size_t p = 0; p < mPointCount; ++p)
+    {
+        mPointTransferBuffer[p] = vec4f(positions[p].x, positions[p].y, velocities[p].x, velocities[p].y);
+    }
+
+    this->ActivateOpenGLContext();
+
+    glActiveTexture(GL_TEXTURE0);
+
+    UploadDataTexture(mStateTextures[mCurrentStateIndex], mFrameSize.height, mPointTransferBuffer.data());
+}
+
+void SpringRelaxationGPUCalculator::UploadForces(
+    vec2f const * staticForces,
+    vec2f const * integrationFactors)
+{
+    assert(nullptr != staticForces);
+    assert(nullptr != integrationFactors);
+
+    for (size_t p = 0; p < mPointCount; ++p)
+    {
+        mPointTransferBuffer[p] = vec4f(staticForces[p].x, staticForces[p].y, integrationFactors[p].x, integrationFactors[p].y);
+    }
+
+    this->ActivateOpenGLContext();
+
+    glActiveTexture(GL_TEXTURE1);
+
+    UploadDataTexture(mForcesTexture, mFrameSize.height, mPointTransferBuffer.data());
+}
+
+void SpringRelaxationGPUCalculator::Run(
+    size_t iterations,
+    float dt,
+    float velocityFactor)
+{
+    this->ActivateOpenGLContext();
+
+    GetShaderManager().ActivateProgram<GPUCalcProgramType::SpringRelaxation>();
+
+    GetShaderManager().SetProgramParameter<GPUCalcProgramType::SpringRelaxation, GPUCalcProgramParameterType::DeltaTime>(dt);
+    GetShaderManager().SetProgramParameter<GPUCalcProgramType::SpringRelaxation, GPUCalcProgramParameterType::VelocityFactor>(velocityFactor);
+
+    glActiveTexture(GL_TEXTURE0);
+
+    for (size_t i = 0; i < iterations; ++i)
+    {
+        // Read from the current state, and render into the other one
+        size_t const nextStateIndex = 1 - mCurrentStateIndex;
+
+        glBindTexture(GL_TEXTURE_2D, *mStateTextures[mCurrentStateIndex]);
+        glBindFramebuffer(GL_FRAMEBUFFER, *mStateFramebuffers[nextStateIndex]);
+
+        glDrawArrays(GL_TRIANGLES, 0, 6);
+        CheckOpenGLError();
+
+        mCurrentStateIndex = nextStateIndex;
+    }
+
+    glFlush();
+}
+
+void SpringRelaxationGPUCalculator::DownloadPositions(vec2f * positions)
+{
+    assert(nullptr != positions);
+
+    this->ActivateOpenGLContext();
+
+    ReadState();
+
+    // Positions are the first two components of the state
+    for (size_t p = 0; p < mPointCount; ++p)
+    {
+        positions[p] = vec2f(mPointTransferBuffer[p].x, mPointTransferBuffer[p].y);
+    }
+}
+
+void SpringRelaxationGPUCalculator::DownloadVelocities(vec2f * velocities)
+{
+    assert(nullptr != velocities);
+
+    this->ActivateOpenGLContext();
+
+    ReadState();
+
+    // Velocities are the last two components of the state
+    for (size_t p = 0; p < mPointCount; ++p)
+    {
+        velocities[p] = vec2f(mPointTransferBuffer[p].z, mPointTransferBuffer[p].w);
+    }
+}
+
+GameOpenGLTexture SpringRelaxationGPUCalculator::CreateDataTexture(
+    int width,
+    int height)
+{
+    GLuint tmpTexture;
+    glGenTextures(1, &tmpTexture);
+    GameOpenGLTexture texture(tmpTexture);
+
+    glBindTexture(GL_TEXTURE_2D, *texture);
+    CheckOpenGLError();
+
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA32F, width, height, 0, GL_RGBA, GL_FLOAT, nullptr);
+    CheckOpenGLError();
+
+    // Make sure we don't do any fancy filtering
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+    CheckOpenGLError();
+
+    return texture;
+}
+
+void SpringRelaxationGPUCalculator::UploadDataTexture(
+    GameOpenGLTexture const & texture,
+    int height,
+    vec4f const * data)
+{
+    // Transfer buffers span whole rows, hence we may upload them at once
+    glBindTexture(GL_TEXTURE_2D, *texture);
+
+    glTexSubImage2D(
+        GL_TEXTURE_2D,
+        0,                              // Level
+        0, 0,                           // X offset, Y offset
+        mFrameSize.width, height,       // Width, Height
+        GL_RGBA, GL_FLOAT,
+        data);
+
+    CheckOpenGLError();
+}
+
+void SpringRelaxationGPUCalculator::ReadState()
+{
+    glBindFramebuffer(GL_FRAMEBUFFER, *mStateFramebuffers[mCurrentStateIndex]);
+    glReadBuffer(GL_COLOR_ATTACHMENT0);
+
+    if (mWholeRows > 0)
+    {
+        glReadPixels(
+            0, 0,
+            mFrameSize.width, mWholeRows,
+            GL_RGBA, GL_FLOAT,
+            mPointTransferBuffer.data());
+
+        CheckOpenGLError();
+    }
+
+    if (mRemainderCols > 0)
+    {
+        glReadPixels(
+            0, mWholeRows,
+            mRemainderCols, 1,
+            GL_RGBA, GL_FLOAT,
+            &(mPointTransferBuffer[static_cast<size_t>(mFrameSize.width) * static_cast<size_t>(mWholeRows)]));
+
+        CheckOpenGLError();
+    }
+}
@@ -0,0 +1,128 @@
+/***************************************************************************************
+* Original Author:      Gabriele Giuseppini
+* Created:              2026-10-14
+* Copyright:            Gabriele Giuseppini  (https://github.com/GabrieleGiuseppini)
+***************************************************************************************/
+#pragma once
+
+#include "GPUCalculator.h"
+
+#include <GameCore/GameTypes.h>
+#include <GameCore/Vectors.h>
+
+#include <filesystem>
+#include <vector>
+
+/*
+ * Calculator that runs the mechanical dynamics of a set of points connected by springs -
+ * i.e. spring relaxation and integration - on the GPU.
+ *
+ * Point positions, velocities, and spring data stay resident on the GPU across runs;
+ * a run executes all the mechanical iterations of a simulation step, after which the
+ * caller only needs to read back what its CPU stages need - usually just positions.
+ *
+ * Each point is a fragment, hence spring forces are gathered by each point from its
+ * connected springs - rather than being scattered by each spring onto its endpoints.
+ */
+class SpringRelaxationGPUCalculator : public GPUCalculator
+{
+public:
+
+    // The max number of springs that may be connected to a single point
+    static size_t constexpr MaxSpringsPerPoint = 9;
+
+public:
+
+    /*
+     * Replaces all springs. Deleted springs are expected to have zero coefficients,
+     * and may thus be skipped.
+     */
+    void UploadSprings(
+        ElementIndex const * endpointAIndices,
+        ElementIndex const * endpointBIndices,
+        float const * restLengths,
+        float const * stiffnessCoefficients,
+        float const * dampingCoefficients,
+        size_t springCount);
+
+    /*
+     * Replaces the positions and velocities of all points; only needed after
+     * they have been changed on the CPU.
+     */
+    void UploadPoints(
+        vec2f const * positions,
+        vec2f const * velocities);
+
+    /*
+     * Replaces the static forces and the integration factors of all points;
+     * both are constant throughout a run.
+     */
+    void UploadForces(
+        vec2f const * staticForces,
+        vec2f const * integrationFactors);
+
+    /*
+     * Runs the specified number of mechanical iterations.
+     *
+     * The velocity factor is the scalar factor which, when multiplied with a displacement,
+     * provides the final, damped velocity.
+     */
+    void Run(
+        size_t iterations,
+        float dt,
+        float velocityFactor);
+
+    void DownloadPositions(vec2f * positions);
+
+    void DownloadVelocities(vec2f * velocities);
+
+private:
+
+    friend class GPUCalculatorFactory;
+
+    SpringRelaxationGPUCalculator(
+        std::unique_ptr<IOpenGLContext> openGLContext,
+        std::filesystem::path const & shadersRootDirectory,
+        size_t pointCount);
+
+    GameOpenGLTexture CreateDataTexture(
+        int width,
+        int height);
+
+    void UploadDataTexture(
+        GameOpenGLTexture const & texture,
+        int height,
+        vec4f const * data);
+
+    // Reads the current state into the point transfer buffer
+    void ReadState();
+
+private:
+
+    size_t const mPointCount;
+
+    ImageSize mFrameSize;
+    int mWholeRows;
+    int mRemainderCols;
+
+    // Position and velocity of each point, as (pos.x, pos.y, vel.x, vel.y);
+    // we ping-pong between the two at each iteration
+    GameOpenGLTexture mStateTextures[2];
+    GameOpenGLFramebuffer mStateFramebuffers[2];
+    size_t mCurrentStateIndex;
+
+    // Static force and integration factor of each point, as (f.x, f.y, if.x, if.y)
+    GameOpenGLTexture mForcesTexture;
+
+    // The springs connected to each point, as (other endpoint index, rest length, stiffness, damping);
+    // the i-th spring of the point at (x, y) is at (x, y + i * frame height), and an other endpoint
+    // index of -1 marks the end of the springs of the point
+    GameOpenGLTexture mSpringsTexture;
+
+    GameOpenGLVBO mVertexVBO;
+
+    // Transfer buffers, kept across transfers to save allocations
+    std::vector<vec4f> mPointTransferBuffer;
+    std::vector<vec4f> mSpringTransferBuffer;
+    std::vector<size_t> mSpringsPerPoint;
+};
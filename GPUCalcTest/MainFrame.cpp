@@ -11,6 +11,7 @@
 #include "AddTest.h"
 #include "OpenGLInitTest.h"
 #include "PixelCoordsTest.h"
+#include "SpringRelaxationTest.h"
 
 #include <GPUCalc/GPUCalculatorFactory.h>
 
@@ -108,6 +109,26 @@ MainFrame::MainFrame(wxApp * mainApp)
         });
     buttonCol1Sizer->Add(Add65536TestButton, 1, wxEXPAND);
 
+    auto springRelaxation3TestButton = new wxButton(this, wxID_ANY, "Run SpringRelaxation(3x3) Test");
+    springRelaxation3TestButton->SetMaxSize(wxSize(-1, 20));
+    springRelaxation3TestButton->Bind(
+        wxEVT_BUTTON,
+        [this](wxEvent & /*event*/)
+        {
+            this->RunSpringRelaxationTest(3);
+        });
+    buttonCol1Sizer->Add(springRelaxation3TestButton, 1, wxEXPAND);
+
+    auto springRelaxation300TestButton = new wxButton(this, wxID_ANY, "Run SpringRelaxation(300x300) Test");
+    springRelaxation300TestButton->SetMaxSize(wxSize(-1, 20));
+    springRelaxation300TestButton->Bind(
+        wxEVT_BUTTON,
+        [this](wxEvent & /*event*/)
+        {
+            this->RunSpringRelaxationTest(300);
+        });
+    buttonCol1Sizer->Add(springRelaxation300TestButton, 1, wxEXPAND);
+
     auto allTestsButton = new wxButton(this, wxID_ANY, "Run All Tests");
     allTestsButton->SetMaxSize(wxSize(-1, 20));
     allTestsButton->Bind(
@@ -335,6 +356,16 @@ void MainFrame::RunAddTest(size_t dataPoints)
     test.Run();
 }
 
+void MainFrame::RunSpringRelaxationTest(size_t pointsPerSide)
+{
+    ClearLog();
+
+    ScopedTestRun testRun;
+
+    SpringRelaxationTest test(pointsPerSide);
+    test.Run();
+}
+
 void MainFrame::RunAllTests()
 {
     ClearLog();
@@ -366,5 +397,15 @@ void MainFrame::RunAllTests()
         test.Run();
     }
 
+    {
+        SpringRelaxationTest test(3);
+        test.Run();
+    }
+
+    {
+        SpringRelaxationTest test(300);
+        test.Run();
+    }
+
     // TODO: all other tests
 }
\ No newline at end of file
@@ -61,6 +61,7 @@ private:
     void RunOpenGLTest();
     void RunPixelCoordsTest(size_t dataPoints);
     void RunAddTest(size_t dataPoints);
+    void RunSpringRelaxationTest(size_t pointsPerSide);
     void RunAllTests();
 
 private:
@@ -0,0 +1,161 @@
+/***************************************************************************************
+ * Original Author:     Gabriele Giuseppini
+ * Created:             2026-10-14
+ * Copyright:           Gabriele Giuseppini  (https://github.com/GabrieleGiuseppini)
+ ***************************************************************************************/
+#include "SpringRelaxationTest.h"
+
+#include <GPUCalc/GPUCalculatorFactory.h>
+
+#include <GameCore/Algorithms.h>
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+void SpringRelaxationTest::InternalRun()
+{
+    size_t const pointCount = mPointsPerSide * mPointsPerSide;
+
+    auto calculator = GPUCalculatorFactory::GetInstance().CreateSpringRelaxationCalculator(pointCount);
+
+    //
+    // Create a lattice of points, slightly perturbed, connected by
+    // horizontal, vertical, and diagonal springs
+    //
+
+    float constexpr Dt = 0.001f;
+    float constexpr Mass = 1.0f;
+    float constexpr VelocityFactor = 0.9999f / Dt;
+    size_t constexpr Iterations = 30;
+
+    std::vector<vec2f> positions(pointCount);
+    std::vector<vec2f> velocities(pointCount, vec2f::zero());
+    std::vector<vec2f> staticForces(pointCount);
+    std::vector<vec2f> integrationFactors(pointCount, vec2f(Dt * Dt / Mass, Dt * Dt / Mass));
+
+    for (size_t y = 0; y < mPointsPerSide; ++y)
+    {
+        for (size_t x = 0; x < mPointsPerSide; ++x)
+        {
+            size_t const p = y * mPointsPerSide + x;
+
+            positions[p] = vec2f(
+                static_cast<float>(x) + 0.1f * std::sin(static_cast<float>(p)),
+                static_cast<float>(y) + 0.1f * std::cos(static_cast<float>(p)));
+
+            staticForces[p] = vec2f(0.0f, -9.8f * Mass);
+        }
+    }
+
+    std::vector<ElementIndex> endpointAIndices;
+    std::vector<ElementIndex> endpointBIndices;
+    std::vector<float> restLengths;
+
+    auto const addSpring = [&](size_t a, size_t b)
+    {
+        endpointAIndices.push_back(static_cast<ElementIndex>(a));
+        endpointBIndices.push_back(static_cast<ElementIndex>(b));
+        restLengths.push_back((positions[b] - positions[a]).length() * 0.95f);
+    };
+
+    for (size_t y = 0; y < mPointsPerSide; ++y)
+    {
+        for (size_t x = 0; x < mPointsPerSide; ++x)
+        {
+            size_t const p = y * mPointsPerSide + x;
+
+            if (x + 1 < mPointsPerSide)
+                addSpring(p, p + 1);
+            if (y + 1 < mPointsPerSide)
+                addSpring(p, p + mPointsPerSide);
+            if (x + 1 < mPointsPerSide && y + 1 < mPointsPerSide)
+                addSpring(p, p + mPointsPerSide + 1);
+            if (x > 0 && y + 1 < mPointsPerSide)
+                addSpring(p, p + mPointsPerSide - 1);
+        }
+    }
+
+    size_t const springCount = endpointAIndices.size();
+
+    std::vector<float> stiffnessCoefficients(springCount, 0.1f * Mass / (Dt * Dt));
+    std::vector<float> dampingCoefficients(springCount, 0.01f * Mass / Dt);
+
+    //
+    // Run on the GPU
+    //
+
+    calculator->UploadSprings(
+        endpointAIndices.data(),
+        endpointBIndices.data(),
+        restLengths.data(),
+        stiffnessCoefficients.data(),
+        dampingCoefficients.data(),
+        springCount);
+
+    calculator->UploadPoints(positions.data(), velocities.data());
+    calculator->UploadForces(staticForces.data(), integrationFactors.data());
+
+    calculator->Run(Iterations, Dt, VelocityFactor);
+
+    std::vector<vec2f> gpuPositions(pointCount);
+    calculator->DownloadPositions(gpuPositions.data());
+
+    std::vector<vec2f> gpuVelocities(pointCount);
+    calculator->DownloadVelocities(gpuVelocities.data());
+
+    //
+    // Run on the CPU
+    //
+
+    std::vector<vec2f> springForces(pointCount);
+
+    for (size_t i = 0; i < Iterations; ++i)
+    {
+        std::fill(springForces.begin(), springForces.end(), vec2f::zero());
+
+        Algorithms::ApplySpringsForces_Naive(
+            positions.data(),
+            velocities.data(),
+            endpointAIndices.data(),
+            endpointBIndices.data(),
+            restLengths.data(),
+            stiffnessCoefficients.data(),
+            dampingCoefficients.data(),
+            0,
+            static_cast<ElementIndex>(springCount),
+            springForces.data());
+
+        for (size_t p = 0; p < pointCount; ++p)
+        {
+            vec2f const deltaPos =
+                velocities[p] * Dt
+                + vec2f(
+                    (springForces[p].x + staticForces[p].x) * integrationFactors[p].x,
+                    (springForces[p].y + staticForces[p].y) * integrationFactors[p].y);
+
+            positions[p] += deltaPos;
+            velocities[p] = deltaPos * VelocityFactor;
+        }
+    }
+
+    //
+    // Verify
+    //
+
+    LogBuffer("positions", gpuPositions.data(), pointCount);
+
+    float maxPositionDelta = 0.0f;
+    float maxVelocityDelta = 0.0f;
+    for (size_t p = 0; p < pointCount; ++p)
+    {
+        maxPositionDelta = std::max(maxPositionDelta, (gpuPositions[p] - positions[p]).length());
+        maxVelocityDelta = std::max(maxVelocityDelta, (gpuVelocities[p] - velocities[p]).length());
+    }
+
+    LogMessage("MaxPositionDelta=", maxPositionDelta, " MaxVelocityDelta=", maxVelocityDelta);
+
+    // Summation order differs between the GPU and the CPU
+    TEST_VERIFY(maxPositionDelta < 0.001f);
+    TEST_VERIFY(maxVelocityDelta < 0.01f);
+}
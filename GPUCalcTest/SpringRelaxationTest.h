@@ -0,0 +1,28 @@
+/***************************************************************************************
+ * Original Author:     Gabriele Giuseppini
+ * Created:             2026-10-14
+ * Copyright:           Gabriele Giuseppini  (https://github.com/GabrieleGiuseppini)
+ ***************************************************************************************/
+#pragma once
+
+#include "TestCase.h"
+
+#include <string>
+
+class SpringRelaxationTest : public TestCase
+{
+public:
+
+    SpringRelaxationTest(size_t pointsPerSide)
+        : TestCase("SpringRelaxation " + std::to_string(pointsPerSide) + "x" + std::to_string(pointsPerSide))
+        , mPointsPerSide(pointsPerSide)
+    {}
+
+protected:
+
+    virtual void InternalRun() override;
+
+private:
+
+    size_t const mPointsPerSide;
+};
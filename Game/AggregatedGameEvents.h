@@ -0,0 +1,160 @@
+/***************************************************************************************
+* Original Author:      Gabriele Giuseppini
+* Created:              2026-10-14
+* Copyright:            Gabriele Giuseppini  (https://github.com/GabrieleGiuseppini)
+***************************************************************************************/
+#pragma once
+
+#include "Materials.h"
+
+#include <GameCore/GameTypes.h>
+
+#include <tuple>
+#include <utility>
+#include <vector>
+
+/*
+ * An aggregation of values keyed by small tuples.
+ *
+ * Aggregations only ever see a handful of distinct keys per frame - e.g. the materials
+ * being stressed - hence the entries are kept in a flat vector and looked up linearly;
+ * entries are visited in the order in which their keys were first seen.
+ */
+template<typename TKey, typename TValue>
+class FlatAggregation final
+{
+public:
+
+    using entry_type = std::pair<TKey, TValue>;
+
+    TValue & operator[](TKey const & key)
+    {
+        for (auto & entry : mEntries)
+        {
+            if (entry.first == key)
+                return entry.second;
+        }
+
+        return mEntries.emplace_back(key, TValue()).second;
+    }
+
+    bool empty() const
+    {
+        return mEntries.empty();
+    }
+
+    void clear()
+    {
+        mEntries.clear();
+    }
+
+    auto begin() const
+    {
+        return mEntries.cbegin();
+    }
+
+    auto end() const
+    {
+        return mEntries.cend();
+    }
+
+private:
+
+    std::vector<entry_type> mEntries;
+};
+
+// Events keyed by structural material and whether they happened underwater
+using StructuralMaterialEventAggregation = FlatAggregation<std::tuple<StructuralMaterial const *, bool>, unsigned int>;
+
+/*
+ * The game events that are aggregated - rather than dispatched one by one - until
+ * the next flush.
+ *
+ * Producers that run concurrently aggregate into their own instance, which is then
+ * merged into the main one; since merging only sums values by key, the result does
+ * not depend on the order in which the producers ran.
+ */
+struct AggregatedGameEvents final
+{
+    StructuralMaterialEventAggregation StressEvents;
+    StructuralMaterialEventAggregation BreakEvents;
+    FlatAggregation<std::tuple<bool>, unsigned int> LampBrokenEvents;
+    FlatAggregation<std::tuple<bool>, unsigned int> LampExplodedEvents;
+    FlatAggregation<std::tuple<bool>, unsigned int> LampImplodedEvents;
+    FlatAggregation<std::tuple<bool>, unsigned int> CombustionExplosionEvents;
+    FlatAggregation<std::tuple<StructuralMaterial const *>, unsigned int> LightningHitEvents;
+    FlatAggregation<std::tuple<DurationShortLongType, bool>, unsigned int> LightFlickerEvents;
+    FlatAggregation<std::tuple<StructuralMaterial const *, bool>, unsigned int> SpringRepairedEvents;
+    FlatAggregation<std::tuple<StructuralMaterial const *, bool>, unsigned int> TriangleRepairedEvents;
+    FlatAggregation<std::tuple<bool, bool>, unsigned int> PinToggledEvents; // Only keys are published
+    float WaterDisplacedEvents;
+    unsigned int AirBubbleSurfacedEvents;
+    FlatAggregation<std::tuple<GadgetType, bool>, unsigned int> BombExplosionEvents;
+    FlatAggregation<std::tuple<bool>, unsigned int> RCBombPingEvents;
+    FlatAggregation<std::tuple<bool>, unsigned int> TimerBombDefusedEvents;
+    FlatAggregation<std::tuple<bool>, unsigned int> WatertightDoorOpenedEvents;
+    FlatAggregation<std::tuple<bool>, unsigned int> WatertightDoorClosedEvents;
+
+    AggregatedGameEvents()
+        : StressEvents()
+        , BreakEvents()
+        , LampBrokenEvents()
+        , LampExplodedEvents()
+        , LampImplodedEvents()
+        , CombustionExplosionEvents()
+        , LightningHitEvents()
+        , LightFlickerEvents()
+        , SpringRepairedEvents()
+        , TriangleRepairedEvents()
+        , PinToggledEvents()
+        , WaterDisplacedEvents(0.0f)
+        , AirBubbleSurfacedEvents(0u)
+        , BombExplosionEvents()
+        , RCBombPingEvents()
+        , TimerBombDefusedEvents()
+        , WatertightDoorOpenedEvents()
+        , WatertightDoorClosedEvents()
+    {}
+
+    /*
+     * Adds the specified events to these ones, and clears the specified events.
+     */
+    void MergeFrom(AggregatedGameEvents & other)
+    {
+        Merge(StressEvents, other.StressEvents);
+        Merge(BreakEvents, other.BreakEvents);
+        Merge(LampBrokenEvents, other.LampBrokenEvents);
+        Merge(LampExplodedEvents, other.LampExplodedEvents);
+        Merge(LampImplodedEvents, other.LampImplodedEvents);
+        Merge(CombustionExplosionEvents, other.CombustionExplosionEvents);
+        Merge(LightningHitEvents, other.LightningHitEvents);
+        Merge(LightFlickerEvents, other.LightFlickerEvents);
+        Merge(SpringRepairedEvents, other.SpringRepairedEvents);
+        Merge(TriangleRepairedEvents, other.TriangleRepairedEvents);
+        Merge(PinToggledEvents, other.PinToggledEvents);
+        WaterDisplacedEvents += other.WaterDisplacedEvents;
+        other.WaterDisplacedEvents = 0.0f;
+        AirBubbleSurfacedEvents += other.AirBubbleSurfacedEvents;
+        other.AirBubbleSurfacedEvents = 0u;
+        Merge(BombExplosionEvents, other.BombExplosionEvents);
+        Merge(RCBombPingEvents, other.RCBombPingEvents);
+        Merge(TimerBombDefusedEvents, other.TimerBombDefusedEvents);
+        Merge(WatertightDoorOpenedEvents, other.WatertightDoorOpenedEvents);
+        Merge(WatertightDoorClosedEvents, other.WatertightDoorClosedEvents);
+    }
+
+private:
+
+    template<typename TKey, typename TValue>
+    static void Merge(
+        FlatAggregation<TKey, TValue> & target,
+        FlatAggregation<TKey, TValue> & source)
+    {
+        for (auto const & entry : source)
+        {
+            target[entry.first] += entry.second;
+        }
+
+        source.clear();
+    }
+};
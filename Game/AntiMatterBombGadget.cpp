@@ -38,6 +38,28 @@ AntiMatterBombGadget::AntiMatterBombGadget(
     mGameEventHandler->OnAntiMatterBombContained(mId, true);
 }
 
+AntiMatterBombGadget::AntiMatterBombGadget(
+    AntiMatterBombGadget const & other,
+    ShipFragmentMap const & fragmentMap,
+    IShipPhysicsHandler & shipPhysicsHandler,
+    Points & shipPoints,
+    Springs & shipSprings)
+    : Gadget(
+        other,
+        fragmentMap,
+        shipPhysicsHandler,
+        shipPoints,
+        shipSprings)
+    , mState(other.mState)
+    , mLastUpdateTimePoint(other.mLastUpdateTimePoint)
+    , mNextStateTransitionTimePoint(other.mNextStateTransitionTimePoint)
+    , mCurrentStateStartTimePoint(other.mCurrentStateStartTimePoint)
+    , mCurrentStateProgress(other.mCurrentStateProgress)
+    , mCurrentCloudRotationAngle(other.mCurrentCloudRotationAngle)
+    , mExplosionPosition(other.mExplosionPosition)
+{
+}
+
 bool AntiMatterBombGadget::Update(
     GameWallClock::time_point currentWallClockTime,
     float /*currentSimulationTime*/,
@@ -16,11 +16,12 @@ namespace Physics {
 //  Z: 0.0 closest, 1.0 furthest
 //
 
-float constexpr CloudSpaceWidth = 3.0f;
-float constexpr MaxCloudSpaceX = CloudSpaceWidth / 2.0f;
+// The number of updates over which all clouds are checked for having left space; at the speeds
+// of clouds, a cloud that has left space is still far from the visible region when checked
+size_t constexpr RolloverCheckPeriod = 16;
 
 void Clouds::Update(
-    float /*currentSimulationTime*/,
+    float currentSimulationTime,
     float baseAndStormSpeedMagnitude,
     Storm::Parameters const & stormParameters,
     GameParameters const & gameParameters)
@@ -72,7 +73,8 @@ void Clouds::Update(
                 scale,
                 1.0f, // Darkening
                 linearSpeedX,
-                GameRandomEngine::GetInstance().GenerateNormalizedUniformReal())); // Initial growth phase
+                GameRandomEngine::GetInstance().GenerateNormalizedUniformReal(), // Initial growth phase
+                mCloudSpaceDrift));
         }
 
         // Sort by Z, so that we upload the furthest clouds first
@@ -94,27 +96,38 @@ void Clouds::Update(
     {
         // Add a cloud if the last cloud (arbitrary) is already enough ahead
         if (mStormClouds.empty()
-            || (baseAndStormSpeedMagnitude >= 0.0f && mStormClouds.back()->X >= -MaxCloudSpaceX + CloudSpaceWidth / static_cast<float>(stormParameters.NumberOfClouds))
-            || (baseAndStormSpeedMagnitude < 0.0f && mStormClouds.back()->X <= MaxCloudSpaceX - CloudSpaceWidth / static_cast<float>(stormParameters.NumberOfClouds)))
+            || (baseAndStormSpeedMagnitude >= 0.0f && mStormClouds.back()->CalculateX(mCloudSpaceDrift) >= -MaxCloudSpaceX + CloudSpaceWidth / static_cast<float>(stormParameters.NumberOfClouds))
+            || (baseAndStormSpeedMagnitude < 0.0f && mStormClouds.back()->CalculateX(mCloudSpaceDrift) <= MaxCloudSpaceX - CloudSpaceWidth / static_cast<float>(stormParameters.NumberOfClouds)))
         {
+            // Start just inside of space, so that the cloud is not immediately seen as leaving it
+            float constexpr StartMargin = 0.001f;
+
             mStormClouds.emplace_back(
                 new Cloud(
                     mLastCloudId++,
-                    -MaxCloudSpaceX * windSign, // Initial X
+                    -(MaxCloudSpaceX - StartMargin) * windSign, // Initial X
                     GameRandomEngine::GetInstance().GenerateUniformReal(-1.0f, 1.0f), // Y [-1.0 -> 1.0]
                     0.0f, // Z
                     stormParameters.CloudsSize,
                     stormParameters.CloudDarkening, // Darkening
                     GameRandomEngine::GetInstance().GenerateUniformReal(0.003f, 0.007f), // Linear speed X
-                    GameRandomEngine::GetInstance().GenerateNormalizedUniformReal())); // Initial growth phase
+                    GameRandomEngine::GetInstance().GenerateNormalizedUniformReal(), // Initial growth phase
+                    mCloudSpaceDrift));
         }
     }
 
 
     //
-    // Update clouds
+    // Advance drift and growth
+    //
+    // Clouds are not moved individually: their positions and growths are calculated from
+    // these two integrals when they are uploaded. We integrate over the actual elapsed time,
+    // as we are not necessarily updated at each simulation step.
     //
 
+    float const dt = currentSimulationTime - mLastUpdateSimulationTime;
+    mLastUpdateSimulationTime = currentSimulationTime;
+
     // Convert wind speed into cloud speed.
     //
     // We do not take variable wind speed into account, otherwise clouds would move with gusts
@@ -124,63 +137,85 @@ void Clouds::Update(
     // A linear factor of 1.0/8.0 worked fine at low wind speeds.
     float const globalCloudSpeed = windSign * 0.03f * std::pow(std::abs(baseAndStormSpeedMagnitude), 1.7f);
 
-    for (auto & cloud : mClouds)
+    mCloudSpaceDrift += static_cast<double>(globalCloudSpeed * dt);
+
+    float const growthProgressSpeed =
+        (1.0f / 45.0f) // Basal velocity
+        + std::abs(globalCloudSpeed) / (400.0f);
+
+    mGrowthProgressPhase = std::fmod(mGrowthProgressPhase + static_cast<double>(growthProgressSpeed * dt), 1.0);
+
+    //
+    // Manage clouds leaving space
+    //
+
+    UpdateRollovers(baseAndStormSpeedMagnitude, stormParameters);
+}
+
+void Clouds::UpdateRollovers(
+    float baseAndStormSpeedMagnitude,
+    Storm::Parameters const & stormParameters)
+{
+    // Normal clouds: update darkening when crossing border
+
+    size_t const cloudsToCheck = std::min(
+        (mClouds.size() + RolloverCheckPeriod - 1) / RolloverCheckPeriod,
+        mClouds.size());
+
+    for (size_t i = 0; i < cloudsToCheck; ++i)
     {
-        cloud->Update(globalCloudSpeed);
+        if (mCloudsRolloverCursor >= mClouds.size())
+            mCloudsRolloverCursor = 0;
 
-        // Manage clouds leaving space: rollover and update darkening when crossing border
-        if (baseAndStormSpeedMagnitude >= 0.0f && cloud->X > MaxCloudSpaceX)
-        {
-            cloud->X -= CloudSpaceWidth;
-            cloud->Darkening = stormParameters.CloudDarkening;
-        }
-        else if (baseAndStormSpeedMagnitude < 0.0f && cloud->X < -MaxCloudSpaceX)
+        auto & cloud = *mClouds[mCloudsRolloverCursor];
+
+        std::int64_t const rolloverCount = cloud.CalculateRolloverCount(mCloudSpaceDrift);
+        if (rolloverCount != cloud.RolloverCount)
         {
-            cloud->X += CloudSpaceWidth;
-            cloud->Darkening = stormParameters.CloudDarkening;
+            cloud.RolloverCount = rolloverCount;
+            cloud.Darkening = stormParameters.CloudDarkening;
         }
+
+        ++mCloudsRolloverCursor;
     }
 
-    for (auto it = mStormClouds.begin(); it != mStormClouds.end();)
+    // Storm clouds: retire when crossing border if too many, else catch up
+
+    size_t const stormCloudsToCheck = std::min(
+        (mStormClouds.size() + RolloverCheckPeriod - 1) / RolloverCheckPeriod,
+        mStormClouds.size());
+
+    for (size_t i = 0; i < stormCloudsToCheck && !mStormClouds.empty(); ++i)
     {
-        (*it)->Update(globalCloudSpeed);
+        if (mStormCloudsRolloverCursor >= mStormClouds.size())
+            mStormCloudsRolloverCursor = 0;
 
-        // Manage clouds leaving space: retire when cross border if too many, else rollover
-        if (baseAndStormSpeedMagnitude >= 0.0f && (*it)->X > MaxCloudSpaceX)
-        {
-            if (mStormClouds.size() > stormParameters.NumberOfClouds)
-            {
-                it = mStormClouds.erase(it);
-            }
-            else
-            {
-                // Rollover and catch up
-                (*it)->X -= CloudSpaceWidth;
-                (*it)->Scale = stormParameters.CloudsSize;
-                (*it)->Darkening = stormParameters.CloudDarkening;
-                ++it;
-            }
-        }
-        else if (baseAndStormSpeedMagnitude < 0.0f && (*it)->X < -MaxCloudSpaceX)
+        auto & cloud = *mStormClouds[mStormCloudsRolloverCursor];
+
+        std::int64_t const rolloverCount = cloud.CalculateRolloverCount(mCloudSpaceDrift);
+
+        // Only rollovers in the direction of the wind count - clouds going back into space
+        // after a change of wind direction are simply repositioned
+        bool const hasLeftSpace =
+            (baseAndStormSpeedMagnitude >= 0.0f && rolloverCount > cloud.RolloverCount)
+            || (baseAndStormSpeedMagnitude < 0.0f && rolloverCount < cloud.RolloverCount);
+
+        cloud.RolloverCount = rolloverCount;
+
+        if (hasLeftSpace)
         {
             if (mStormClouds.size() > stormParameters.NumberOfClouds)
             {
-                it = mStormClouds.erase(it);
+                mStormClouds.erase(mStormClouds.begin() + mStormCloudsRolloverCursor);
+                continue;
             }
-            else
-            {
-                // Rollover and catch up
-                (*it)->X += CloudSpaceWidth;
-                (*it)->Scale = stormParameters.CloudsSize;
-                (*it)->Darkening = stormParameters.CloudDarkening;
-                ++it;
-            }
-        }
-        else
-        {
-            ++it;
+
+            cloud.Scale = stormParameters.CloudsSize;
+            cloud.Darkening = stormParameters.CloudDarkening;
         }
+
+        ++mStormCloudsRolloverCursor;
     }
 }
 
-}
\ No newline at end of file
+}
@@ -12,6 +12,7 @@
 #include <GameCore/GameRandomEngine.h>
 
 #include <cmath>
+#include <cstdint>
 #include <memory>
 #include <vector>
 
@@ -27,6 +28,11 @@ public:
         : mLastCloudId(0)
         , mClouds()
         , mStormClouds()
+        , mLastUpdateSimulationTime(0.0f)
+        , mCloudSpaceDrift(0.0)
+        , mGrowthProgressPhase(0.0)
+        , mCloudsRolloverCursor(0)
+        , mStormCloudsRolloverCursor(0)
     {}
 
     void Update(
@@ -43,24 +49,24 @@ public:
         {
             renderContext.UploadCloud(
                 cloud->Id,
-                cloud->X,
+                cloud->CalculateX(mCloudSpaceDrift),
                 cloud->Y,
                 cloud->Z,
                 cloud->Scale,
                 cloud->Darkening,
-                cloud->GrowthProgress);
+                cloud->CalculateGrowthProgress(mGrowthProgressPhase));
         }
 
         for (auto const & cloud : mStormClouds)
         {
             renderContext.UploadCloud(
                 cloud->Id,
-                cloud->X,
+                cloud->CalculateX(mCloudSpaceDrift),
                 cloud->Y,
                 cloud->Z,
                 cloud->Scale,
                 cloud->Darkening,
-                cloud->GrowthProgress);
+                cloud->CalculateGrowthProgress(mGrowthProgressPhase));
         }
 
         renderContext.UploadCloudsEnd();
@@ -68,17 +74,25 @@ public:
 
 private:
 
+    // The width of the virtual cloud space
+    static float constexpr CloudSpaceWidth = 3.0f;
+    static float constexpr MaxCloudSpaceX = CloudSpaceWidth / 2.0f;
+
+    /*
+     * A cloud's position and growth are not stepped; rather, they are functions of
+     * the drift and of the growth phase shared by all clouds, which are the only
+     * quantities that are integrated at each update.
+     */
     struct Cloud
     {
     public:
 
         uint32_t const Id; // Not consecutive, only guaranteed to be sticky and unique across all clouds (used as texture frame index)
-        float X;
         float const Y; // 0.0 -> 1.0 (above horizon)
         float const Z; // 0.0 -> 1.0
         float Scale;
         float Darkening; // 0.0: dark, 1.0: light
-        float GrowthProgress;
+        std::int64_t RolloverCount; // The number of times this cloud has left space, as of the last check
 
         Cloud(
             uint32_t id,
@@ -88,42 +102,71 @@ private:
             float scale,
             float darkening,
             float linearSpeedX,
-            float initialGrowthProgressPhase)
+            float initialGrowthProgressPhase,
+            double cloudSpaceDrift)
             : Id(id)
-            , X(initialX)
             , Y(y)
             , Z(z)
             , Scale(scale)
             , Darkening(darkening)
-            , GrowthProgress(0.0f)
+            , RolloverCount(0)
+            , mOriginX(static_cast<double>(initialX) - static_cast<double>(linearSpeedX) * cloudSpaceDrift)
             , mLinearSpeedX(linearSpeedX)
-            , mGrowthProgressPhase(initialGrowthProgressPhase)
+            , mInitialGrowthProgressPhase(initialGrowthProgressPhase)
         {
+            RolloverCount = CalculateRolloverCount(cloudSpaceDrift);
         }
 
-        inline void Update(float globalCloudSpeed)
+        // Unbounded X, as if space would never end
+        inline double CalculateUnboundedX(double cloudSpaceDrift) const
         {
-            X += mLinearSpeedX * globalCloudSpeed * GameParameters::SimulationStepTimeDuration<float>;
+            return mOriginX + static_cast<double>(mLinearSpeedX) * cloudSpaceDrift;
+        }
 
-            float const growthProgressSpeed =
-                (1.0f / 45.0f) // Basal velocity
-                + std::abs(globalCloudSpeed) / (400.0f);
+        inline std::int64_t CalculateRolloverCount(double cloudSpaceDrift) const
+        {
+            return static_cast<std::int64_t>(std::floor((CalculateUnboundedX(cloudSpaceDrift) + CloudSpaceWidth / 2.0) / CloudSpaceWidth));
+        }
 
-            mGrowthProgressPhase += growthProgressSpeed * GameParameters::SimulationStepTimeDuration<float>;
+        // X, rolled over into [-1.5, +1.5)
+        inline float CalculateX(double cloudSpaceDrift) const
+        {
+            double const x = CalculateUnboundedX(cloudSpaceDrift);
+            return static_cast<float>(x - std::floor((x + CloudSpaceWidth / 2.0) / CloudSpaceWidth) * CloudSpaceWidth);
+        }
 
-            GrowthProgress = 0.3f + (1.0f + std::sin(mGrowthProgressPhase * Pi<float> * 2.0f)) * 0.7f / 2.0f;
+        inline float CalculateGrowthProgress(double growthProgressPhase) const
+        {
+            float const phase = static_cast<float>(std::fmod(static_cast<double>(mInitialGrowthProgressPhase) + growthProgressPhase, 1.0));
+            return 0.3f + (1.0f + std::sin(phase * Pi<float> * 2.0f)) * 0.7f / 2.0f;
         }
 
     private:
 
+        double const mOriginX; // X at zero drift
         float const mLinearSpeedX;
-        float mGrowthProgressPhase;
+        float const mInitialGrowthProgressPhase;
     };
 
+    void UpdateRollovers(
+        float baseAndStormSpeedMagnitude,
+        Storm::Parameters const & stormParameters);
+
     uint32_t mLastCloudId;
 
     std::vector<std::unique_ptr<Cloud>> mClouds;
     std::vector<std::unique_ptr<Cloud>> mStormClouds;
+
+    float mLastUpdateSimulationTime;
+
+    // The integrals over time of the global cloud speed and of the growth progress speed;
+    // grow unbounded, hence kept in double precision
+    double mCloudSpaceDrift;
+    double mGrowthProgressPhase;
+
+    // The next clouds whose rollovers are to be checked
+    size_t mCloudsRolloverCursor;
+    size_t mStormCloudsRolloverCursor;
 };
 
 }
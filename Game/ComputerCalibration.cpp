@@ -7,58 +7,209 @@
 
 #include <GameOpenGL/GameOpenGL.h>
 
+#include <GameCore/Algorithms.h>
 #include <GameCore/GameMath.h>
 #include <GameCore/Log.h>
+#include <GameCore/SysSpecifics.h>
 #include <GameCore/SystemThreadManager.h>
+#include <GameCore/TaskThreadPool.h>
+#include <GameCore/Utils.h>
 #include <GameCore/Vectors.h>
+#include <GameCore/Version.h>
 
+#include <algorithm>
 #include <chrono>
-#include <cmath>
 #include <cstdint>
-#include <random>
-#include <thread>
+#include <cstring>
+#include <vector>
 
-ComputerCalibrationScore ComputerCalibrator::Calibrate()
-{
-    //
-    // CPU calibration
-    //
+namespace /* anonymous */ {
 
-    auto const startTime = std::chrono::steady_clock::now();
+    // The duration of each micro-benchmark
+    auto constexpr BenchmarkDuration = std::chrono::milliseconds(100);
 
-    std::uint64_t iterationCount;
-    for (iterationCount = 0;
-        std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - startTime).count() < 1000;
-        ++iterationCount)
+    // The springs/s that the game needs to run the basis number of mechanical
+    // iterations on a large (100K springs) ship at full frame rate
+    float constexpr RequiredSpringForcesThroughput =
+        30.0f // Basis mechanical iterations
+        * 64.0f // Simulation steps/s
+        * 100000.0f // Springs
+        / 1000000.0f; // Millions
+
+    // A parallelism is optimal when it reaches this fraction of the best throughput,
+    // as long as no smaller parallelism does
+    float constexpr OptimalParallelismThroughputFraction = 0.9f;
+
+    /*
+     * A synthetic lattice of points and springs, shaped after a ship's structure.
+     */
+    struct SpringLattice
     {
-        float val = RunComputation();
-        if (val > 2.0f) // Impossible
-            break;
-    }
+        static size_t constexpr Width = 150;
+        static size_t constexpr Height = 150;
 
-    float const normalizedCpuScore = SmoothStep(
-        0.0f,
-        100.0f,
-        static_cast<float>(iterationCount));
+        std::vector<vec2f> PointPositions;
+        std::vector<vec2f> PointVelocities;
 
-    LogMessage("CPU Calibration: iterationCount=", iterationCount, " score=", normalizedCpuScore);
+        std::vector<ElementIndex> SpringEndpointAIndices;
+        std::vector<ElementIndex> SpringEndpointBIndices;
+        std::vector<float> SpringRestLengths;
+        std::vector<float> SpringStiffnessCoefficients;
+        std::vector<float> SpringDampingCoefficients;
 
-    //
-    // Graphics calibration
-    //
+        // One force buffer for each partition, so that partitions never share force slots
+        std::vector<std::vector<vec2f>> PartitionPointForces;
 
-    float const normalizedGraphicsScore =
-        SmoothStep(0.0f, 16384.0f, static_cast<float>(GameOpenGL::MaxRenderbufferSize))
-        * SmoothStep(0.0f, 4.0f, static_cast<float>(GameOpenGL::MaxSupportedOpenGLVersionMajor));
+        SpringLattice()
+        {
+            for (size_t y = 0; y < Height; ++y)
+            {
+                for (size_t x = 0; x < Width; ++x)
+                {
+                    // Displace points a bit from their rest positions, so that springs are strained
+                    PointPositions.emplace_back(
+                        static_cast<float>(x) + 0.01f * static_cast<float>((x * 7 + y * 3) % 5),
+                        static_cast<float>(y) - 0.01f * static_cast<float>((x * 3 + y * 7) % 5));
+
+                    PointVelocities.emplace_back(0.001f * static_cast<float>(x % 3), 0.0f);
+
+                    ElementIndex const pointIndex = static_cast<ElementIndex>(y * Width + x);
+
+                    if (x + 1 < Width)
+                        AddSpring(pointIndex, pointIndex + 1, 1.0f);
+
+                    if (y + 1 < Height)
+                    {
+                        AddSpring(pointIndex, static_cast<ElementIndex>(pointIndex + Width), 1.0f);
+
+                        if (x + 1 < Width)
+                            AddSpring(pointIndex, static_cast<ElementIndex>(pointIndex + Width + 1), 1.41421356f);
+
+                        if (x > 0)
+                            AddSpring(pointIndex, static_cast<ElementIndex>(pointIndex + Width - 1), 1.41421356f);
+                    }
+                }
+            }
+        }
+
+        size_t GetSpringCount() const
+        {
+            return SpringEndpointAIndices.size();
+        }
+
+        /*
+         * Returns the springs/s, in millions.
+         */
+        float MeasureThroughput(
+            SpringForcesKernelType kernel,
+            TaskThreadPool & taskThreadPool)
+        {
+            size_t const partitionCount = taskThreadPool.GetParallelism();
+            if (PartitionPointForces.size() < partitionCount)
+            {
+                PartitionPointForces.resize(partitionCount, std::vector<vec2f>(PointPositions.size(), vec2f::zero()));
+            }
+
+            size_t const springCount = GetSpringCount();
+            size_t const partitionSize = (springCount + partitionCount - 1) / partitionCount;
+
+            auto const startTime = std::chrono::steady_clock::now();
+
+            std::uint64_t runCount = 0;
+            std::chrono::steady_clock::duration elapsed;
+            do
+            {
+                taskThreadPool.ParallelFor(
+                    0,
+                    partitionCount,
+                    1,
+                    [&](size_t start, size_t end)
+                    {
+                        for (size_t p = start; p < end; ++p)
+                        {
+                            Algorithms::ApplySpringsForces(
+                                kernel,
+                                PointPositions.data(),
+                                PointVelocities.data(),
+                                SpringEndpointAIndices.data(),
+                                SpringEndpointBIndices.data(),
+                                SpringRestLengths.data(),
+                                SpringStiffnessCoefficients.data(),
+                                SpringDampingCoefficients.data(),
+                                static_cast<ElementIndex>(p * partitionSize),
+                                static_cast<ElementIndex>(std::min((p + 1) * partitionSize, springCount)),
+                                PartitionPointForces[p].data());
+                        }
+                    });
+
+                ++runCount;
+                elapsed = std::chrono::steady_clock::now() - startTime;
+            } while (elapsed < BenchmarkDuration);
 
-    LogMessage("Graphics Calibration: score=", normalizedGraphicsScore);
+            float const elapsedSeconds = std::chrono::duration<float>(elapsed).count();
 
-    return ComputerCalibrationScore(normalizedCpuScore, normalizedGraphicsScore);
+            return static_cast<float>(runCount * springCount) / elapsedSeconds / 1000000.0f;
+        }
+
+    private:
+
+        void AddSpring(
+            ElementIndex endpointA,
+            ElementIndex endpointB,
+            float restLength)
+        {
+            SpringEndpointAIndices.push_back(endpointA);
+            SpringEndpointBIndices.push_back(endpointB);
+            SpringRestLengths.push_back(restLength);
+            SpringStiffnessCoefficients.push_back(0.5f);
+            SpringDampingCoefficients.push_back(0.03f);
+        }
+    };
+
+    char const * ToString(SpringForcesKernelType kernel)
+    {
+        return kernel == SpringForcesKernelType::Scalar ? "Scalar" : "Vectorized";
+    }
+
+    std::string GetOpenGLVersionString()
+    {
+        return std::to_string(GameOpenGL::MaxSupportedOpenGLVersionMajor) + "." + std::to_string(GameOpenGL::MaxSupportedOpenGLVersionMinor);
+    }
+}
+
+ComputerCalibrationScore ComputerCalibrator::Calibrate(std::filesystem::path const & resultsFilePath)
+{
+    auto score = LoadResults(resultsFilePath);
+    if (score.has_value())
+    {
+        LogMessage("ComputerCalibration: re-using results from \"", resultsFilePath.string(), "\"");
+    }
+    else
+    {
+        score.emplace(RunBenchmarks());
+
+        try
+        {
+            SaveResults(*score, resultsFilePath);
+        }
+        catch (...)
+        {
+            // Ignore, we'll just calibrate again next time
+        }
+    }
+
+    LogMessage("ComputerCalibration: CPUScore=", score->NormalizedCPUScore, " GfxScore=", score->NormalizedGfxScore,
+        " FastestSpringForcesKernel=", ToString(score->FastestSpringForcesKernel),
+        " SpringForcesThroughput=", score->SpringForcesThroughput, "M/s",
+        " OptimalParallelism=", score->OptimalParallelism,
+        " MemoryBandwidth=", score->MemoryBandwidth, "GB/s");
+
+    return *score;
 }
 
 void ComputerCalibrator::TuneGame(
     ComputerCalibrationScore const & score,
-    GameParameters & /*gameParameters*/,
+    GameParameters & gameParameters,
     Render::RenderContext & renderContext)
 {
     //
@@ -66,6 +217,19 @@ void ComputerCalibrator::TuneGame(
     // performance
     //
 
+    gameParameters.SpringForcesKernel = score.FastestSpringForcesKernel;
+
+    if (score.SpringForcesThroughput < RequiredSpringForcesThroughput)
+    {
+        // Trade stiffness for frame rate
+        gameParameters.NumMechanicalDynamicsIterationsAdjustment = std::min(
+            gameParameters.NumMechanicalDynamicsIterationsAdjustment,
+            Clamp(
+                score.SpringForcesThroughput / RequiredSpringForcesThroughput,
+                GameParameters::MinNumMechanicalDynamicsIterationsAdjustment,
+                1.0f));
+    }
+
     if (score.NormalizedCPUScore < 0.65f
         || score.NormalizedGfxScore < 0.1f)
     {
@@ -87,45 +251,190 @@ void ComputerCalibrator::TuneGame(
     }
 
     LogMessage("ComputerCalibration:"
+        " SpringForcesKernel=", ToString(gameParameters.SpringForcesKernel),
+        " NumMechanicalDynamicsIterationsAdjustment=", gameParameters.NumMechanicalDynamicsIterationsAdjustment,
         " OceanRenderDetail=", renderContext.GetOceanRenderDetail() == OceanRenderDetailType::Basic ? "Basic" : "Advanced",
         " HeatRenderMode=", renderContext.GetHeatRenderMode() == HeatRenderModeType::None ? "None" : (renderContext.GetHeatRenderMode() == HeatRenderModeType::HeatOverlay ? "HeatOverlay" : "Incandescence"));
 }
 
-float ComputerCalibrator::RunComputation()
+ComputerCalibrationScore ComputerCalibrator::RunBenchmarks()
 {
-    size_t constexpr SampleSize = 100000;
+    SpringLattice lattice;
 
     //
-    // Prepare input
+    // Kernels, on a single thread
     //
 
-    std::seed_seq seed_seq({ 1, 242, 19730528 });
-    std::ranlux48_base randomEngine(seed_seq);
-    std::uniform_real_distribution<float> randomUniformDistribution(0.0f, 1.0f);
+    SpringForcesKernelType fastestKernel;
 
-    std::vector<vec2f> inputData;
-    inputData.reserve(SampleSize);
-    for (size_t i = 0; i < SampleSize; ++i)
     {
-        inputData.emplace_back(
-            randomUniformDistribution(randomEngine),
-            randomUniformDistribution(randomEngine));
+        TaskThreadPool singleThreadPool(1);
+
+        float const scalarThroughput = lattice.MeasureThroughput(SpringForcesKernelType::Scalar, singleThreadPool);
+        float const vectorizedThroughput = lattice.MeasureThroughput(SpringForcesKernelType::Vectorized, singleThreadPool);
+
+        fastestKernel = (vectorizedThroughput >= scalarThroughput)
+            ? SpringForcesKernelType::Vectorized
+            : SpringForcesKernelType::Scalar;
+
+        size_t const vectorizedWidth =
+#if FS_IS_ARCHITECTURE_X86_32() || FS_IS_ARCHITECTURE_X86_64()
+            IsAVX2Supported() ? 8 : 1;
+#elif FS_IS_ARCHITECTURE_ARM_64()
+            4;
+#else
+            1;
+#endif
+
+        LogMessage("ComputerCalibration: springs=", lattice.GetSpringCount(), " Scalar=", scalarThroughput, "M/s",
+            " Vectorized(width=", vectorizedWidth, ")=", vectorizedThroughput, "M/s");
     }
 
     //
-    // Calculate
+    // Parallelism, with the fastest kernel
     //
 
-    float accum = 0.0f;
-    for (size_t i = 0; i < SampleSize; ++i)
+    size_t const numberOfProcessors = SystemThreadManager::GetInstance().GetNumberOfProcessors();
+
+    std::vector<float> throughputs;
+    for (size_t numberOfThreads = 1; ; ++numberOfThreads)
+    {
+        TaskThreadPool taskThreadPool(numberOfThreads);
+        if (taskThreadPool.GetParallelism() < numberOfThreads)
+        {
+            // Reached the max parallelism of the pool
+            break;
+        }
+
+        throughputs.push_back(lattice.MeasureThroughput(fastestKernel, taskThreadPool));
+
+        LogMessage("ComputerCalibration: parallelism=", taskThreadPool.GetParallelism(), " throughput=", throughputs.back(), "M/s");
+
+        if (numberOfThreads >= numberOfProcessors)
+            break;
+    }
+
+    float const bestThroughput = *std::max_element(throughputs.cbegin(), throughputs.cend());
+
+    size_t optimalParallelism = 1;
+    while (throughputs[optimalParallelism - 1] < bestThroughput * OptimalParallelismThroughputFraction)
     {
-        auto const n1 = inputData[i % SampleSize].normalise().length();
-        auto const n2 = SmoothStep(0.0f, 1.0f, n1);
-        if (n2 < 0.5f)
-            accum += 1.0;
-        else
-            accum += -1.0f;
+        ++optimalParallelism;
     }
 
-    return std::abs(accum / static_cast<float>(SampleSize));
-}
\ No newline at end of file
+    float const springForcesThroughput = throughputs[optimalParallelism - 1];
+
+    //
+    // Memory
+    //
+
+    float const memoryBandwidth = MeasureMemoryBandwidth();
+
+    //
+    // Scores
+    //
+
+    float const normalizedCpuScore = SmoothStep(
+        0.0f,
+        2.0f * RequiredSpringForcesThroughput,
+        springForcesThroughput);
+
+    float const normalizedGraphicsScore =
+        SmoothStep(0.0f, 16384.0f, static_cast<float>(GameOpenGL::MaxRenderbufferSize))
+        * SmoothStep(0.0f, 4.0f, static_cast<float>(GameOpenGL::MaxSupportedOpenGLVersionMajor));
+
+    return ComputerCalibrationScore(
+        normalizedCpuScore,
+        normalizedGraphicsScore,
+        fastestKernel,
+        springForcesThroughput,
+        optimalParallelism,
+        memoryBandwidth);
+}
+
+std::optional<ComputerCalibrationScore> ComputerCalibrator::LoadResults(std::filesystem::path const & resultsFilePath)
+{
+    try
+    {
+        auto const rootValue = Utils::ParseJSONFile(resultsFilePath);
+        if (rootValue.is<picojson::object>())
+        {
+            auto const rootObject = rootValue.get<picojson::object>();
+
+            // Results are only valid on the computer and the version they're created for
+            if (Utils::GetMandatoryJsonMember<std::string>(rootObject, "version") == Version::CurrentVersion().ToString()
+                && Utils::GetMandatoryJsonMember<size_t>(rootObject, "number_of_processors") == SystemThreadManager::GetInstance().GetNumberOfProcessors()
+                && Utils::GetMandatoryJsonMember<bool>(rootObject, "is_avx2_supported") == IsAVX2Supported()
+                && Utils::GetMandatoryJsonMember<std::string>(rootObject, "opengl_version") == GetOpenGLVersionString()
+                && Utils::GetMandatoryJsonMember<int>(rootObject, "max_renderbuffer_size") == GameOpenGL::MaxRenderbufferSize)
+            {
+                return ComputerCalibrationScore(
+                    Utils::GetMandatoryJsonMember<float>(rootObject, "normalized_cpu_score"),
+                    Utils::GetMandatoryJsonMember<float>(rootObject, "normalized_gfx_score"),
+                    Utils::GetMandatoryJsonMember<std::string>(rootObject, "fastest_spring_forces_kernel") == "Scalar"
+                        ? SpringForcesKernelType::Scalar
+                        : SpringForcesKernelType::Vectorized,
+                    Utils::GetMandatoryJsonMember<float>(rootObject, "spring_forces_throughput"),
+                    std::max(Utils::GetMandatoryJsonMember<size_t>(rootObject, "optimal_parallelism"), size_t(1)),
+                    Utils::GetMandatoryJsonMember<float>(rootObject, "memory_bandwidth"));
+            }
+        }
+    }
+    catch (...)
+    {
+        // Ignore
+    }
+
+    return std::nullopt;
+}
+
+void ComputerCalibrator::SaveResults(
+    ComputerCalibrationScore const & score,
+    std::filesystem::path const & resultsFilePath)
+{
+    picojson::object rootObject;
+
+    rootObject["version"] = picojson::value(Version::CurrentVersion().ToString());
+    rootObject["number_of_processors"] = picojson::value(static_cast<std::int64_t>(SystemThreadManager::GetInstance().GetNumberOfProcessors()));
+    rootObject["is_avx2_supported"] = picojson::value(IsAVX2Supported());
+    rootObject["opengl_version"] = picojson::value(GetOpenGLVersionString());
+    rootObject["max_renderbuffer_size"] = picojson::value(static_cast<std::int64_t>(GameOpenGL::MaxRenderbufferSize));
+
+    rootObject["normalized_cpu_score"] = picojson::value(static_cast<double>(score.NormalizedCPUScore));
+    rootObject["normalized_gfx_score"] = picojson::value(static_cast<double>(score.NormalizedGfxScore));
+    rootObject["fastest_spring_forces_kernel"] = picojson::value(std::string(ToString(score.FastestSpringForcesKernel)));
+    rootObject["spring_forces_throughput"] = picojson::value(static_cast<double>(score.SpringForcesThroughput));
+    rootObject["optimal_parallelism"] = picojson::value(static_cast<std::int64_t>(score.OptimalParallelism));
+    rootObject["memory_bandwidth"] = picojson::value(static_cast<double>(score.MemoryBandwidth));
+
+    // Save
+    Utils::SaveJSONFile(
+        picojson::value(rootObject),
+        resultsFilePath);
+}
+
+float ComputerCalibrator::MeasureMemoryBandwidth()
+{
+    // Large enough to not fit in caches, as the buffers we stage uploads from
+    size_t constexpr BufferSize = 32 * 1024 * 1024;
+
+    std::vector<std::uint8_t> source(BufferSize, 0x5a);
+    std::vector<std::uint8_t> destination(BufferSize, 0);
+
+    auto const startTime = std::chrono::steady_clock::now();
+
+    std::uint64_t copyCount = 0;
+    std::chrono::steady_clock::duration elapsed;
+    do
+    {
+        std::memcpy(destination.data(), source.data(), BufferSize);
+        source[copyCount % BufferSize] = destination[(copyCount * 7) % BufferSize]; // Keep copies observable
+
+        ++copyCount;
+        elapsed = std::chrono::steady_clock::now() - startTime;
+    } while (elapsed < BenchmarkDuration);
+
+    float const elapsedSeconds = std::chrono::duration<float>(elapsed).count();
+
+    return static_cast<float>(copyCount * BufferSize) / elapsedSeconds / (1024.0f * 1024.0f * 1024.0f);
+}
@@ -8,16 +8,34 @@
 #include "GameParameters.h"
 #include "RenderContext.h"
 
+#include <GameCore/GameTypes.h>
+
+#include <filesystem>
+#include <optional>
+
 struct ComputerCalibrationScore
 {
     float NormalizedCPUScore; // 0.0 -> 1.0
     float NormalizedGfxScore; // 0.0 -> 1.0
 
+    SpringForcesKernelType FastestSpringForcesKernel;
+    float SpringForcesThroughput; // Millions of springs/s, fastest kernel at optimal parallelism
+    size_t OptimalParallelism; // Smallest parallelism that reaches (nearly) the best throughput
+    float MemoryBandwidth; // GB/s
+
     ComputerCalibrationScore(
         float normalizedCPUScore,
-        float normalizedGfxScore)
+        float normalizedGfxScore,
+        SpringForcesKernelType fastestSpringForcesKernel,
+        float springForcesThroughput,
+        size_t optimalParallelism,
+        float memoryBandwidth)
         : NormalizedCPUScore(normalizedCPUScore)
         , NormalizedGfxScore(normalizedGfxScore)
+        , FastestSpringForcesKernel(fastestSpringForcesKernel)
+        , SpringForcesThroughput(springForcesThroughput)
+        , OptimalParallelism(optimalParallelism)
+        , MemoryBandwidth(memoryBandwidth)
     {}
 };
 
@@ -25,7 +43,13 @@ class ComputerCalibrator
 {
 public:
 
-    static ComputerCalibrationScore Calibrate();
+    /*
+     * Calibrates the computer by running micro-benchmarks of the simulation kernels.
+     *
+     * The results are persisted at the specified path, and re-used by later calibrations
+     * as long as the computer and the game version do not change.
+     */
+    static ComputerCalibrationScore Calibrate(std::filesystem::path const & resultsFilePath);
 
     static void TuneGame(
         ComputerCalibrationScore const & score,
@@ -34,5 +58,13 @@ public:
 
 private:
 
-    static float RunComputation();
-};
\ No newline at end of file
+    static ComputerCalibrationScore RunBenchmarks();
+
+    static std::optional<ComputerCalibrationScore> LoadResults(std::filesystem::path const & resultsFilePath);
+
+    static void SaveResults(
+        ComputerCalibrationScore const & score,
+        std::filesystem::path const & resultsFilePath);
+
+    static float MeasureMemoryBandwidth();
+};
@@ -7,6 +7,7 @@
 
 #include <GameCore/GameGeometry.h>
 #include <GameCore/GameRandomEngine.h>
+#include <GameCore/Profiler.h>
 
 #include <cmath>
 #include <queue>
@@ -76,7 +77,6 @@ void ElectricalElements::Add(
             mElementStateBuffer.emplace_back(ElementState::EngineControllerState(0.0f, false));
 
             // Indices
-            mSinks.emplace_back(elementIndex);
             mEngineControllers.emplace_back(elementIndex);
 
             break;
@@ -131,7 +131,6 @@ void ElectricalElements::Add(
                     externalPressureBreakageThreshold * 1000.0f)); // KPa->Pa
 
             // Indices
-            mSinks.emplace_back(elementIndex);
             mLamps.emplace_back(elementIndex);
 
             // Lighting
@@ -153,7 +152,7 @@ void ElectricalElements::Add(
             mElementStateBuffer.emplace_back(ElementState::OtherSinkState(false));
 
             // Indices
-            mSinks.emplace_back(elementIndex);
+            mOtherSinks.emplace_back(elementIndex);
 
             break;
         }
@@ -164,7 +163,7 @@ void ElectricalElements::Add(
             mElementStateBuffer.emplace_back(ElementState::PowerMonitorState(false));
 
             // Indices
-            mSinks.emplace_back(elementIndex);
+            mPowerMonitors.emplace_back(elementIndex);
 
             break;
         }
@@ -175,7 +174,7 @@ void ElectricalElements::Add(
             mElementStateBuffer.emplace_back(ElementState::ShipSoundState(electricalMaterial.IsSelfPowered, false));
 
             // Indices
-            mSinks.emplace_back(elementIndex);
+            mShipSounds.emplace_back(elementIndex);
 
             break;
         }
@@ -186,7 +185,7 @@ void ElectricalElements::Add(
             mElementStateBuffer.emplace_back(ElementState::SmokeEmitterState(electricalMaterial.ParticleEmissionRate, false));
 
             // Indices
-            mSinks.emplace_back(elementIndex);
+            mSmokeEmitters.emplace_back(elementIndex);
 
             break;
         }
@@ -197,7 +196,7 @@ void ElectricalElements::Add(
             mElementStateBuffer.emplace_back(ElementState::WaterPumpState(electricalMaterial.WaterPumpNominalForce));
 
             // Indices
-            mSinks.emplace_back(elementIndex);
+            mWaterPumps.emplace_back(elementIndex);
 
             break;
         }
@@ -222,7 +221,7 @@ void ElectricalElements::Add(
                     !points.GetStructuralMaterial(pointElementIndex).IsHull)); // DefaultIsOpen: open <=> material open (==not hull)
 
             // Indices
-            mSinks.emplace_back(elementIndex);
+            mWatertightDoors.emplace_back(elementIndex);
 
             break;
         }
@@ -242,10 +241,163 @@ void ElectricalElements::Add(
 }
 
 
-void ElectricalElements::AnnounceInstancedElements()
+void ElectricalElements::AddFragment(
+    ElectricalElements const & other,
+    ShipFragmentMap const & fragmentMap,
+    Points const & points)
+{
+    assert(mIsDeletedBuffer.GetCurrentPopulatedSize() == 0);
+
+    auto const & pointMap = fragmentMap.PointIndices;
+    auto const & elementMap = fragmentMap.ElectricalElementIndices;
+
+    assert(elementMap.GetNewElementCount() == GetElementCount());
+
+    //
+    // Add the elements as from the factory, so to populate the per-type indices in order,
+    // and then take over their current state
+    //
+
+    for (ElementIndex elementIndex = 0; elementIndex < GetElementCount(); ++elementIndex)
+    {
+        ElementIndex const otherElementIndex = elementMap.NewToOld[elementIndex];
+
+        assert(pointMap.Contains(other.mPointIndexBuffer[otherElementIndex]));
+
+        Add(
+            pointMap.OldToNew[other.mPointIndexBuffer[otherElementIndex]],
+            other.mInstanceInfos[otherElementIndex].InstanceIndex,
+            other.mInstanceInfos[otherElementIndex].PanelElementMetadata,
+            *other.mMaterialBuffer[otherElementIndex],
+            points);
+
+        mIsDeletedBuffer[elementIndex] = other.mIsDeletedBuffer[otherElementIndex];
+        mConductivityBuffer[elementIndex] = other.mConductivityBuffer[otherElementIndex];
+        mAvailableLightBuffer[elementIndex] = other.mAvailableLightBuffer[otherElementIndex];
+
+        auto & elementState = mElementStateBuffer[elementIndex];
+        ElementIndex const lampElementIndex = elementState.Lamp.LampElementIndex; // Only meaningful for lamps
+        elementState = other.mElementStateBuffer[otherElementIndex];
+
+        // Visit sequence numbers restart with the container, and nothing has been published yet
+        switch (mMaterialTypeBuffer[elementIndex])
+        {
+            case ElectricalMaterial::ElectricalElementType::Engine:
+            {
+                elementState.Engine.EngineConnectivityVisitSequenceNumber = SequenceNumber();
+                elementState.Engine.LastPublishedAbsRpm = 0.0f;
+                elementState.Engine.LastPublishedThrustMagnitude = 0.0f;
+
+                // Recalculated with the engine groups, anyway
+                if (elementState.Engine.ReferencePointIndex != NoneElementIndex)
+                    elementState.Engine.ReferencePointIndex = pointMap.OldToNew[elementState.Engine.ReferencePointIndex];
+
+                break;
+            }
+
+            case ElectricalMaterial::ElectricalElementType::EngineController:
+            {
+                elementState.EngineController.EngineConnectivityVisitSequenceNumber = SequenceNumber();
+                break;
+            }
+
+            case ElectricalMaterial::ElectricalElementType::EngineTransmission:
+            {
+                elementState.EngineTransmission.EngineConnectivityVisitSequenceNumber = SequenceNumber();
+                break;
+            }
+
+            case ElectricalMaterial::ElectricalElementType::Lamp:
+            {
+                elementState.Lamp.LampElementIndex = lampElementIndex;
+                break;
+            }
+
+            case ElectricalMaterial::ElectricalElementType::ShipSound:
+            {
+                elementState.ShipSound.IsPlaying = false;
+                break;
+            }
+
+            case ElectricalMaterial::ElectricalElementType::WaterPump:
+            {
+                elementState.WaterPump.LastPublishedNormalizedForce = 0.0f;
+                break;
+            }
+
+            default:
+            {
+                break;
+            }
+        }
+    }
+
+    //
+    // Connections: elements are connected via springs, hence connected elements
+    // are in the same fragment
+    //
+
+    for (ElementIndex elementIndex = 0; elementIndex < GetElementCount(); ++elementIndex)
+    {
+        ElementIndex const otherElementIndex = elementMap.NewToOld[elementIndex];
+
+        for (auto const otherConnectedElementIndex : other.mConnectedElectricalElementsBuffer[otherElementIndex])
+        {
+            if (elementMap.Contains(otherConnectedElementIndex))
+                mConnectedElectricalElementsBuffer[elementIndex].push_back(elementMap.OldToNew[otherConnectedElementIndex]);
+        }
+
+        for (auto const otherConnectedElementIndex : other.mConductingConnectedElectricalElementsBuffer[otherElementIndex])
+        {
+            if (elementMap.Contains(otherConnectedElementIndex))
+                mConductingConnectedElectricalElementsBuffer[elementIndex].push_back(elementMap.OldToNew[otherConnectedElementIndex]);
+        }
+    }
+
+    // Engine groups and power are recalculated at the first update
+    assert(mHasConnectivityStructureChangedInCurrentStep);
+    assert(mIsPowerPropagationDirty);
+}
+
+void ElectricalElements::PublishFragmentationSilencing() const
 {
-    mGameEventHandler->OnElectricalElementAnnouncementsBegin();
+    for (auto const engineElementIndex : mEngines)
+    {
+        auto const & engineState = mElementStateBuffer[engineElementIndex].Engine;
+        if (engineState.LastPublishedAbsRpm != 0.0f || engineState.LastPublishedThrustMagnitude != 0.0f)
+        {
+            mGameEventHandler->OnEngineMonitorUpdated(
+                ElectricalElementId(mShipId, engineElementIndex),
+                0.0f,
+                0.0f);
+        }
+    }
+
+    for (auto const shipSoundElementIndex : mShipSounds)
+    {
+        if (mElementStateBuffer[shipSoundElementIndex].ShipSound.IsPlaying)
+        {
+            mGameEventHandler->OnShipSoundUpdated(
+                ElectricalElementId(mShipId, shipSoundElementIndex),
+                *mMaterialBuffer[shipSoundElementIndex],
+                false,
+                false); // Irrelevant
+        }
+    }
+
+    for (auto const waterPumpElementIndex : mWaterPumps)
+    {
+        if (mElementStateBuffer[waterPumpElementIndex].WaterPump.LastPublishedNormalizedForce != 0.0f)
+        {
+            mGameEventHandler->OnWaterPumpUpdated(
+                ElectricalElementId(mShipId, waterPumpElementIndex),
+                0.0f);
+        }
+    }
+}
 
+void ElectricalElements::AnnounceInstancedElements()
+{
     for (auto elementIndex : *this)
     {
         assert(elementIndex < mInstanceInfos.size());
@@ -274,6 +426,12 @@ void ElectricalElements::AnnounceInstancedElements()
                     *mMaterialBuffer[elementIndex],
                     mInstanceInfos[elementIndex].PanelElementMetadata);
 
+                // Elements are re-announced after their ship has split
+                if (mIsDeletedBuffer[elementIndex])
+                {
+                    mGameEventHandler->OnEngineControllerEnabled(ElectricalElementId(mShipId, elementIndex), false);
+                }
+
                 break;
             }
 
@@ -320,6 +478,11 @@ void ElectricalElements::AnnounceInstancedElements()
                     *mMaterialBuffer[elementIndex],
                     mInstanceInfos[elementIndex].PanelElementMetadata);
 
+                if (mIsDeletedBuffer[elementIndex])
+                {
+                    mGameEventHandler->OnSwitchEnabled(ElectricalElementId(mShipId, elementIndex), false);
+                }
+
                 break;
             }
 
@@ -347,6 +510,11 @@ void ElectricalElements::AnnounceInstancedElements()
                     *mMaterialBuffer[elementIndex],
                     mInstanceInfos[elementIndex].PanelElementMetadata);
 
+                if (mIsDeletedBuffer[elementIndex])
+                {
+                    mGameEventHandler->OnSwitchEnabled(ElectricalElementId(mShipId, elementIndex), false);
+                }
+
                 break;
             }
 
@@ -359,6 +527,11 @@ void ElectricalElements::AnnounceInstancedElements()
                     * mMaterialBuffer[elementIndex],
                     mInstanceInfos[elementIndex].PanelElementMetadata);
 
+                if (mIsDeletedBuffer[elementIndex])
+                {
+                    mGameEventHandler->OnWaterPumpEnabled(ElectricalElementId(mShipId, elementIndex), false);
+                }
+
                 break;
             }
 
@@ -374,6 +547,11 @@ void ElectricalElements::AnnounceInstancedElements()
                         static_cast<ElectricalState>(mConductivityBuffer[elementIndex].ConductsElectricity),
                         *mMaterialBuffer[elementIndex],
                         mInstanceInfos[elementIndex].PanelElementMetadata);
+
+                    if (mIsDeletedBuffer[elementIndex])
+                    {
+                        mGameEventHandler->OnSwitchEnabled(ElectricalElementId(mShipId, elementIndex), false);
+                    }
                 }
 
                 break;
@@ -381,15 +559,20 @@ void ElectricalElements::AnnounceInstancedElements()
 
             case ElectricalMaterial::ElectricalElementType::WatertightDoor:
             {
-                assert(!mElementStateBuffer[elementIndex].WatertightDoor.IsActivated);
-
+                // Doors are at their default state at ship load, but not necessarily
+                // when re-announced after their ship has split
                 mGameEventHandler->OnWatertightDoorCreated(
                     ElectricalElementId(mShipId, elementIndex),
                     mInstanceInfos[elementIndex].InstanceIndex,
-                    mElementStateBuffer[elementIndex].WatertightDoor.DefaultIsOpen,
+                    mElementStateBuffer[elementIndex].WatertightDoor.IsOpen(),
                     *mMaterialBuffer[elementIndex],
                     mInstanceInfos[elementIndex].PanelElementMetadata);
 
+                if (mIsDeletedBuffer[elementIndex])
+                {
+                    mGameEventHandler->OnWatertightDoorEnabled(ElectricalElementId(mShipId, elementIndex), false);
+                }
+
                 break;
             }
 
@@ -404,8 +587,6 @@ void ElectricalElements::AnnounceInstancedElements()
             }
         }
     }
-
-    mGameEventHandler->OnElectricalElementAnnouncementsEnd();
 }
 
 void ElectricalElements::HighlightElectricalElement(
@@ -786,6 +967,7 @@ void ElectricalElements::Destroy(
 
     // Remember that connectivity structure has changed during this step
     mHasConnectivityStructureChangedInCurrentStep = true;
+    mIsPowerPropagationDirty = true;
 
     // Remember there's been a power failure in this step;
     // note we also set it in case a *lamp* is broken, not only when a generator
@@ -930,6 +1112,7 @@ void ElectricalElements::Restore(ElementIndex electricalElementIndex)
 
     // Remember that connectivity structure has changed during this step
     mHasConnectivityStructureChangedInCurrentStep = true;
+    mIsPowerPropagationDirty = true;
 }
 
 void ElectricalElements::OnPhysicalStructureChanged(Points const & points)
@@ -1005,6 +1188,16 @@ void ElectricalElements::OnElectricSpark(
 
 void ElectricalElements::UpdateForGameParameters(GameParameters const & gameParameters)
 {
+    FS_PROFILE_SCOPE("ElectricalElements::UpdateForGameParameters");
+
+    if (gameParameters.Generation == mCurrentGameParametersGeneration)
+    {
+        // No parameter has changed
+        return;
+    }
+
+    mCurrentGameParametersGeneration = gameParameters.Generation;
+
     //
     // Recalculate lamp coefficients, if needed
     //
@@ -1039,6 +1232,8 @@ void ElectricalElements::Update(
     Storm::Parameters const & stormParameters,
     GameParameters const & gameParameters)
 {
+    FS_PROFILE_SCOPE("ElectricalElements::Update");
+
     //
     // 1. Update engine conductivity
     //
@@ -1065,8 +1260,9 @@ void ElectricalElements::Update(
     //
     // 3. Update sources and connectivity
     //
-    // We do this regardless of dirty elements, as elements might have changed their state autonomously
-    // (e.g. generators might have become wet, switches might have been toggled, etc.)
+    // We run the sources' state machines regardless of dirty elements, as elements might have changed
+    // their state autonomously (e.g. generators might have become wet); connectivity is re-propagated
+    // only when the circuit or the state of its sources has changed
     //
 
     UpdateSourcesAndPropagation(
@@ -1084,7 +1280,7 @@ void ElectricalElements::Update(
     UpdateSinks(
         currentWallClockTime,
         currentSimulationTime,
-        newConnectivityVisitSequenceNumber,
+        mPowerPropagationVisitSequenceNumber,
         points,
         effectiveAirDensity,
         effectiveWaterDensity,
@@ -1166,6 +1362,12 @@ void ElectricalElements::InternalChangeConductivity(
     ElementIndex elementIndex,
     bool value)
 {
+    if (mConductivityBuffer[elementIndex].ConductsElectricity != value)
+    {
+        // Powered-ness might change
+        mIsPowerPropagationDirty = true;
+    }
+
     // Update conductive connectivity
     if (mConductivityBuffer[elementIndex].ConductsElectricity == false && value == true)
     {
@@ -1458,25 +1660,17 @@ void ElectricalElements::UpdateSourcesAndPropagation(
     GameParameters const & gameParameters)
 {
     //
-    // Visit electrical graph starting from sources, and propagate connectivity state
-    // by means of visit sequence number
+    // 1. Run sources' state machines, checking the pre-conditions that need to be
+    //    satisfied before visiting the connectivity graph
     //
 
-    std::queue<ElementIndex> electricalElementsToVisit;
-
     for (auto const sourceElementIndex : mSources)
     {
         // Do not visit deleted sources
         if (!IsDeleted(sourceElementIndex))
         {
-            //
-            // Check pre-conditions that need to be satisfied before visiting the connectivity graph
-            //
-
             auto const sourcePointIndex = GetPointIndex(sourceElementIndex);
 
-            bool preconditionsSatisfied = false;
-
             switch (GetMaterialType(sourceElementIndex))
             {
                 case ElectricalMaterial::ElectricalElementType::Generator:
@@ -1540,8 +1734,6 @@ void ElectricalElements::UpdateSourcesAndPropagation(
                         }
                     }
 
-                    preconditionsSatisfied = isProducingCurrent;
-
                     //
                     // Check if it's a state change
                     //
@@ -1551,6 +1743,9 @@ void ElectricalElements::UpdateSourcesAndPropagation(
                         // Change state
                         mElementStateBuffer[sourceElementIndex].Generator.IsProducingCurrent = isProducingCurrent;
 
+                        // Powered-ness changes
+                        mIsPowerPropagationDirty = true;
+
                         // See whether we need to publish a power probe change
                         if (mInstanceInfos[sourceElementIndex].InstanceIndex != NoneElectricalElementInstanceIndex)
                         {
@@ -1576,8 +1771,28 @@ void ElectricalElements::UpdateSourcesAndPropagation(
                     break;
                 }
             }
+        }
+    }
+
+    //
+    // 2. Visit electrical graph starting from sources, and propagate connectivity state
+    //    by means of visit sequence number.
+    //
+    //    The powered set only changes when the conductive connectivity or the state
+    //    of the sources changes, hence we re-propagate only then, and otherwise keep
+    //    the sequence number of the last propagation
+    //
+
+    if (mIsPowerPropagationDirty)
+    {
+        mPowerPropagatingSources.clear();
+
+        std::queue<ElementIndex> electricalElementsToVisit;
 
-            if (preconditionsSatisfied
+        for (auto const sourceElementIndex : mSources)
+        {
+            if (!IsDeleted(sourceElementIndex)
+                && mElementStateBuffer[sourceElementIndex].Generator.IsProducingCurrent
                 // Make sure we haven't visited it already
                 && newConnectivityVisitSequenceNumber != mCurrentConnectivityVisitSequenceNumberBuffer[sourceElementIndex])
             {
@@ -1617,16 +1832,27 @@ void ElectricalElements::UpdateSourcesAndPropagation(
                     }
                 }
 
-                //
-                // Generate heat
-                //
-
-                points.AddHeat(sourcePointIndex,
-                    mMaterialHeatGeneratedBuffer[sourceElementIndex]
-                    * gameParameters.ElectricalElementHeatProducedAdjustment
-                    * GameParameters::SimulationStepTimeDuration<float>);
+                // Remember this source as powering its circuit
+                mPowerPropagatingSources.push_back(sourceElementIndex);
             }
         }
+
+        mPowerPropagationVisitSequenceNumber = newConnectivityVisitSequenceNumber;
+        mIsPowerPropagationDirty = false;
+    }
+
+    //
+    // 3. Generate heat at the sources that power a circuit
+    //
+
+    for (auto const sourceElementIndex : mPowerPropagatingSources)
+    {
+        assert(!IsDeleted(sourceElementIndex));
+
+        points.AddHeat(GetPointIndex(sourceElementIndex),
+            mMaterialHeatGeneratedBuffer[sourceElementIndex]
+            * gameParameters.ElectricalElementHeatProducedAdjustment
+            * GameParameters::SimulationStepTimeDuration<float>);
     }
 }
 
@@ -1675,636 +1901,612 @@ void ElectricalElements::UpdateSinks(
         }
     }
 
-    for (auto const sinkElementIndex : mSinks)
-    {
-        //
-        // Update state machine
-        //
+    //
+    // Visit all engine controllers and run their state machine
+    //
 
+    for (auto const sinkElementIndex : mEngineControllers)
+    {
         bool const isConnectedToPower =
             (mCurrentConnectivityVisitSequenceNumberBuffer[sinkElementIndex] == currentConnectivityVisitSequenceNumber);
 
-        bool isProducingHeat = false;
-
-        switch (GetMaterialType(sinkElementIndex))
+        if (!IsDeleted(sinkElementIndex))
         {
-            case ElectricalMaterial::ElectricalElementType::EngineController:
+            auto & controllerState = mElementStateBuffer[sinkElementIndex].EngineController;
+
+            // Check whether it's powered
+            bool isPowered = false;
+            if (isConnectedToPower)
             {
-                if (!IsDeleted(sinkElementIndex))
+                if (controllerState.IsPowered
+                    && mMaterialOperatingTemperaturesBuffer[sinkElementIndex].IsInRange(points.GetTemperature(GetPointIndex(sinkElementIndex))))
+                {
+                    isPowered = true;
+                }
+                else if (!controllerState.IsPowered
+                    && mMaterialOperatingTemperaturesBuffer[sinkElementIndex].IsBackInRange(points.GetTemperature(GetPointIndex(sinkElementIndex))))
                 {
-                    auto & controllerState = mElementStateBuffer[sinkElementIndex].EngineController;
+                    isPowered = true;
+                }
+            }
+
+            if (isPowered)
+            {
+                //
+                // Update engine group for this controller
+                //                        
+
+                assert(controllerState.EngineGroup != 0);
 
-                    // Check whether it's powered
-                    bool isPowered = false;
-                    if (isConnectedToPower)
+                float controllerRpm = 0.0f;
+                float controllerThrustMagnitude = 0.0f;
+                switch (mMaterialBuffer[sinkElementIndex]->EngineControllerType)
+                {
+                    case ElectricalMaterial::EngineControllerElementType::JetThrottle:
                     {
-                        if (controllerState.IsPowered
-                            && mMaterialOperatingTemperaturesBuffer[sinkElementIndex].IsInRange(points.GetTemperature(GetPointIndex(sinkElementIndex))))
+                        // RPM: 0, +/- 1/N, ..., +/- 1
+                        controllerRpm = controllerState.CurrentValue;
+
+                        // Thrust magnitude: 0, 0, 1/N, ..., 1
+                        float constexpr ThrottleIdleFraction = GameParameters::EngineControllerJetThrottleIdleFraction;
+                        if (controllerState.CurrentValue > ThrottleIdleFraction)
                         {
-                            isPowered = true;
+                            controllerThrustMagnitude = (controllerState.CurrentValue - ThrottleIdleFraction) / (1.0f - ThrottleIdleFraction);
                         }
-                        else if (!controllerState.IsPowered
-                            && mMaterialOperatingTemperaturesBuffer[sinkElementIndex].IsBackInRange(points.GetTemperature(GetPointIndex(sinkElementIndex))))
+                        else if (controllerState.CurrentValue < -ThrottleIdleFraction)
                         {
-                            isPowered = true;
+                            controllerThrustMagnitude = (controllerState.CurrentValue + ThrottleIdleFraction) / (1.0f - ThrottleIdleFraction);
                         }
-                    }
-
-                    if (isPowered)
-                    {
-                        //
-                        // Update engine group for this controller
-                        //                        
-
-                        assert(controllerState.EngineGroup != 0);
-
-                        float controllerRpm = 0.0f;
-                        float controllerThrustMagnitude = 0.0f;
-                        switch (mMaterialBuffer[sinkElementIndex]->EngineControllerType)
+                        else
                         {
-                            case ElectricalMaterial::EngineControllerElementType::JetThrottle:
-                            {
-                                // RPM: 0, +/- 1/N, ..., +/- 1
-                                controllerRpm = controllerState.CurrentValue;
-
-                                // Thrust magnitude: 0, 0, 1/N, ..., 1
-                                float constexpr ThrottleIdleFraction = GameParameters::EngineControllerJetThrottleIdleFraction;
-                                if (controllerState.CurrentValue > ThrottleIdleFraction)
-                                {
-                                    controllerThrustMagnitude = (controllerState.CurrentValue - ThrottleIdleFraction) / (1.0f - ThrottleIdleFraction);
-                                }
-                                else if (controllerState.CurrentValue < -ThrottleIdleFraction)
-                                {
-                                    controllerThrustMagnitude = (controllerState.CurrentValue + ThrottleIdleFraction) / (1.0f - ThrottleIdleFraction);
-                                }
-                                else
-                                {
-                                    controllerThrustMagnitude = 0.0f;
-                                }
+                            controllerThrustMagnitude = 0.0f;
+                        }
 
-                                break;
-                            }
+                        break;
+                    }
 
-                            case ElectricalMaterial::EngineControllerElementType::JetThrust:
-                            {
-                                // RPM: 0, +/- 1
-                                controllerRpm = controllerState.CurrentValue;
+                    case ElectricalMaterial::EngineControllerElementType::JetThrust:
+                    {
+                        // RPM: 0, +/- 1
+                        controllerRpm = controllerState.CurrentValue;
 
-                                // Thrust magnitude: 0, +/- 1
-                                controllerThrustMagnitude = controllerState.CurrentValue;
-                                
-                                break;
-                            }
+                        // Thrust magnitude: 0, +/- 1
+                        controllerThrustMagnitude = controllerState.CurrentValue;
 
-                            case ElectricalMaterial::EngineControllerElementType::Telegraph:
-                            {
-                                // RPM: 0, +/- 1/N, ..., +/- 1
-                                controllerRpm = controllerState.CurrentValue;
+                        break;
+                    }
 
-                                // Thrust magnitude: 0, 0, 1/N, ..., 1
-                                float constexpr TelegraphIdleFraction = 1.0f / static_cast<float>(GameParameters::EngineControllerTelegraphDegreesOfFreedom / 2);
-                                if (controllerState.CurrentValue > TelegraphIdleFraction)
-                                {
-                                    controllerThrustMagnitude = (controllerState.CurrentValue - TelegraphIdleFraction) / (1.0f - TelegraphIdleFraction);
-                                }
-                                else if (controllerState.CurrentValue < -TelegraphIdleFraction)
-                                {
-                                    controllerThrustMagnitude = (controllerState.CurrentValue + TelegraphIdleFraction) / (1.0f - TelegraphIdleFraction);
-                                }
-                                else
-                                {
-                                    controllerThrustMagnitude = 0.0f;
-                                }
+                    case ElectricalMaterial::EngineControllerElementType::Telegraph:
+                    {
+                        // RPM: 0, +/- 1/N, ..., +/- 1
+                        controllerRpm = controllerState.CurrentValue;
 
-                                break;
-                            }
+                        // Thrust magnitude: 0, 0, 1/N, ..., 1
+                        float constexpr TelegraphIdleFraction = 1.0f / static_cast<float>(GameParameters::EngineControllerTelegraphDegreesOfFreedom / 2);
+                        if (controllerState.CurrentValue > TelegraphIdleFraction)
+                        {
+                            controllerThrustMagnitude = (controllerState.CurrentValue - TelegraphIdleFraction) / (1.0f - TelegraphIdleFraction);
                         }
-
-                        // Group RPM = max (of absolute value)
-                        if (std::abs(controllerRpm) >= std::abs(mEngineGroupStates[controllerState.EngineGroup].GroupRpm))
+                        else if (controllerState.CurrentValue < -TelegraphIdleFraction)
+                        {
+                            controllerThrustMagnitude = (controllerState.CurrentValue + TelegraphIdleFraction) / (1.0f - TelegraphIdleFraction);
+                        }
+                        else
                         {
-                            mEngineGroupStates[controllerState.EngineGroup].GroupRpm = controllerRpm;
+                            controllerThrustMagnitude = 0.0f;
                         }
 
-                        // Group thrust magnitude = sum
-                        mEngineGroupStates[controllerState.EngineGroup].GroupThrustMagnitude += controllerThrustMagnitude;
+                        break;
                     }
-
-                    // Remember controller state
-                    mElementStateBuffer[sinkElementIndex].EngineController.IsPowered = isPowered;
                 }
 
-                break;
-            }
-
-            case ElectricalMaterial::ElectricalElementType::Lamp:
-            {
-                if (!IsDeleted(sinkElementIndex))
+                // Group RPM = max (of absolute value)
+                if (std::abs(controllerRpm) >= std::abs(mEngineGroupStates[controllerState.EngineGroup].GroupRpm))
                 {
-                    // Calculate external pressure
-                    vec2f const & pointPosition = points.GetPosition(GetPointIndex(sinkElementIndex));
-                    float const totalExternalPressure = 
-                        Formulae::CalculateTotalPressureAt(
-                            pointPosition.y,
-                            mParentWorld.GetOceanSurface().GetHeightAt(pointPosition.x),
-                            effectiveAirDensity,
-                            effectiveWaterDensity,
-                            gameParameters)
-                        * gameParameters.StaticPressureForceAdjustment;
-
-                    // Check against lamp's limit
-                    if (totalExternalPressure >= mElementStateBuffer[sinkElementIndex].Lamp.ExternalPressureBreakageThreshold)
-                    {
-                        // Lamp implosion!
-                        Destroy(
-                            sinkElementIndex,
-                            ElectricalElements::DestroyReason::LampImplosion,
-                            currentSimulationTime,
-                            gameParameters);
-                    }
-                    else
-                    {
-                        // Update state machine
-                        RunLampStateMachine(
-                            isConnectedToPower,
-                            powerFailureSequenceType,
-                            sinkElementIndex,
-                            currentWallClockTime,
-                            currentSimulationTime,
-                            points,
-                            gameParameters);
-
-                        isProducingHeat = (GetAvailableLight(sinkElementIndex) > 0.0f);
-                    }                    
+                    mEngineGroupStates[controllerState.EngineGroup].GroupRpm = controllerRpm;
                 }
 
-                break;
+                // Group thrust magnitude = sum
+                mEngineGroupStates[controllerState.EngineGroup].GroupThrustMagnitude += controllerThrustMagnitude;
             }
 
-            case ElectricalMaterial::ElectricalElementType::OtherSink:
-            {
-                if (!IsDeleted(sinkElementIndex))
-                {
-                    // Update state machine
-                    if (mElementStateBuffer[sinkElementIndex].OtherSink.IsPowered)
-                    {
-                        if (!isConnectedToPower
-                            || !mMaterialOperatingTemperaturesBuffer[sinkElementIndex].IsInRange(points.GetTemperature(GetPointIndex(sinkElementIndex))))
-                        {
-                            mElementStateBuffer[sinkElementIndex].OtherSink.IsPowered = false;
-                        }
-                    }
-                    else
-                    {
-                        if (isConnectedToPower
-                            && mMaterialOperatingTemperaturesBuffer[sinkElementIndex].IsBackInRange(points.GetTemperature(GetPointIndex(sinkElementIndex))))
-                        {
-                            mElementStateBuffer[sinkElementIndex].OtherSink.IsPowered = true;
-                        }
-                    }
+            // Remember controller state
+            mElementStateBuffer[sinkElementIndex].EngineController.IsPowered = isPowered;
+        }
+    }
 
-                    isProducingHeat = mElementStateBuffer[sinkElementIndex].OtherSink.IsPowered;
-                }
+    //
+    // Visit all lamps and run their state machine
+    //
 
-                break;
-            }
+    for (auto const sinkElementIndex : mLamps)
+    {
+        bool const isConnectedToPower =
+            (mCurrentConnectivityVisitSequenceNumberBuffer[sinkElementIndex] == currentConnectivityVisitSequenceNumber);
 
-            case ElectricalMaterial::ElectricalElementType::PowerMonitor:
-            {
-                if (!IsDeleted(sinkElementIndex))
-                {
-                    // Update state machine
-                    if (mElementStateBuffer[sinkElementIndex].PowerMonitor.IsPowered)
-                    {
-                        if (!isConnectedToPower)
-                        {
-                            //
-                            // Toggle state ON->OFF
-                            //
+        bool isProducingHeat = false;
 
-                            mElementStateBuffer[sinkElementIndex].PowerMonitor.IsPowered = false;
+        if (!IsDeleted(sinkElementIndex))
+        {
+            // Calculate external pressure
+            vec2f const & pointPosition = points.GetPosition(GetPointIndex(sinkElementIndex));
+            float const totalExternalPressure = 
+                Formulae::CalculateTotalPressureAt(
+                    pointPosition.y,
+                    mParentWorld.GetOceanSurface().GetHeightAt(pointPosition.x),
+                    effectiveAirDensity,
+                    effectiveWaterDensity,
+                    gameParameters)
+                * gameParameters.StaticPressureForceAdjustment;
+
+            // Check against lamp's limit
+            if (totalExternalPressure >= mElementStateBuffer[sinkElementIndex].Lamp.ExternalPressureBreakageThreshold)
+            {
+                // Lamp implosion!
+                Destroy(
+                    sinkElementIndex,
+                    ElectricalElements::DestroyReason::LampImplosion,
+                    currentSimulationTime,
+                    gameParameters);
+            }
+            else
+            {
+                // Update state machine
+                RunLampStateMachine(
+                    isConnectedToPower,
+                    powerFailureSequenceType,
+                    sinkElementIndex,
+                    currentWallClockTime,
+                    currentSimulationTime,
+                    points,
+                    gameParameters);
 
-                            // Notify
-                            mGameEventHandler->OnPowerProbeToggled(
-                                ElectricalElementId(mShipId, sinkElementIndex),
-                                ElectricalState::Off);
+                isProducingHeat = (GetAvailableLight(sinkElementIndex) > 0.0f);
+            }                    
+        }
 
-                            // Show notifications
-                            if (gameParameters.DoShowElectricalNotifications)
-                            {
-                                HighlightElectricalElement(sinkElementIndex, points);
-                            }
-                        }
-                    }
-                    else
-                    {
-                        if (isConnectedToPower)
-                        {
-                            //
-                            // Toggle state OFF->ON
-                            //
+        //
+        // Generate heat if sink is working
+        //
 
-                            mElementStateBuffer[sinkElementIndex].PowerMonitor.IsPowered = true;
+        if (isProducingHeat)
+        {
+            points.AddHeat(GetPointIndex(sinkElementIndex),
+                mMaterialHeatGeneratedBuffer[sinkElementIndex]
+                * gameParameters.ElectricalElementHeatProducedAdjustment
+                * GameParameters::SimulationStepTimeDuration<float>);
+        }
+    }
 
-                            // Notify
-                            mGameEventHandler->OnPowerProbeToggled(
-                                ElectricalElementId(mShipId, sinkElementIndex),
-                                ElectricalState::On);
+    //
+    // Visit all other sinks and run their state machine
+    //
 
-                            // Show notifications
-                            if (gameParameters.DoShowElectricalNotifications)
-                            {
-                                HighlightElectricalElement(sinkElementIndex, points);
-                            }
-                        }
-                    }
-                }
+    for (auto const sinkElementIndex : mOtherSinks)
+    {
+        bool const isConnectedToPower =
+            (mCurrentConnectivityVisitSequenceNumberBuffer[sinkElementIndex] == currentConnectivityVisitSequenceNumber);
 
-                break;
-            }
+        bool isProducingHeat = false;
 
-            case ElectricalMaterial::ElectricalElementType::ShipSound:
+        if (!IsDeleted(sinkElementIndex))
+        {
+            // Update state machine
+            if (mElementStateBuffer[sinkElementIndex].OtherSink.IsPowered)
+            {
+                if (!isConnectedToPower
+                    || !mMaterialOperatingTemperaturesBuffer[sinkElementIndex].IsInRange(points.GetTemperature(GetPointIndex(sinkElementIndex))))
+                {
+                    mElementStateBuffer[sinkElementIndex].OtherSink.IsPowered = false;
+                }
+            }
+            else
             {
-                if (!IsDeleted(sinkElementIndex))
+                if (isConnectedToPower
+                    && mMaterialOperatingTemperaturesBuffer[sinkElementIndex].IsBackInRange(points.GetTemperature(GetPointIndex(sinkElementIndex))))
                 {
-                    auto & state = mElementStateBuffer[sinkElementIndex].ShipSound;
+                    mElementStateBuffer[sinkElementIndex].OtherSink.IsPowered = true;
+                }
+            }
 
-                    // Update state machine
-                    if (state.IsPlaying)
-                    {
-                        if ((!state.IsSelfPowered && !isConnectedToPower)
-                            || !mConductivityBuffer[sinkElementIndex].ConductsElectricity)
-                        {
-                            //
-                            // Toggle state ON->OFF
-                            //
+            isProducingHeat = mElementStateBuffer[sinkElementIndex].OtherSink.IsPowered;
+        }
 
-                            state.IsPlaying = false;
+        //
+        // Generate heat if sink is working
+        //
 
-                            // Notify sound
-                            mGameEventHandler->OnShipSoundUpdated(
-                                ElectricalElementId(mShipId, sinkElementIndex),
-                                *(mMaterialBuffer[sinkElementIndex]),
-                                false,
-                                false); // Irrelevant
+        if (isProducingHeat)
+        {
+            points.AddHeat(GetPointIndex(sinkElementIndex),
+                mMaterialHeatGeneratedBuffer[sinkElementIndex]
+                * gameParameters.ElectricalElementHeatProducedAdjustment
+                * GameParameters::SimulationStepTimeDuration<float>);
+        }
+    }
 
-                            // Show notifications
-                            if (gameParameters.DoShowElectricalNotifications)
-                            {
-                                HighlightElectricalElement(sinkElementIndex, points);
-                            }
-                        }
-                    }
-                    else
-                    {
-                        if ((state.IsSelfPowered || isConnectedToPower)
-                            && mConductivityBuffer[sinkElementIndex].ConductsElectricity)
-                        {
-                            //
-                            // Toggle state OFF->ON
-                            //
+    //
+    // Visit all power monitors and run their state machine
+    //
 
-                            state.IsPlaying = true;
+    for (auto const sinkElementIndex : mPowerMonitors)
+    {
+        bool const isConnectedToPower =
+            (mCurrentConnectivityVisitSequenceNumberBuffer[sinkElementIndex] == currentConnectivityVisitSequenceNumber);
 
-                            // Notify sound
-                            mGameEventHandler->OnShipSoundUpdated(
-                                ElectricalElementId(mShipId, sinkElementIndex),
-                                *(mMaterialBuffer[sinkElementIndex]),
-                                true,
-                                points.IsCachedUnderwater(GetPointIndex(sinkElementIndex)));
+        if (!IsDeleted(sinkElementIndex))
+        {
+            // Update state machine
+            if (mElementStateBuffer[sinkElementIndex].PowerMonitor.IsPowered)
+            {
+                if (!isConnectedToPower)
+                {
+                    //
+                    // Toggle state ON->OFF
+                    //
 
-                            // Disturb ocean, with delays depending on sound
-                            switch (mMaterialBuffer[sinkElementIndex]->ShipSoundType)
-                            {
-                            case ElectricalMaterial::ShipSoundElementType::QueenMaryHorn:
-                            {
-                                mParentWorld.DisturbOcean(std::chrono::milliseconds(250));
-                                break;
-                            }
+                    mElementStateBuffer[sinkElementIndex].PowerMonitor.IsPowered = false;
 
-                            case ElectricalMaterial::ShipSoundElementType::FourFunnelLinerWhistle:
-                            {
-                                mParentWorld.DisturbOcean(std::chrono::milliseconds(600));
-                                break;
-                            }
+                    // Notify
+                    mGameEventHandler->OnPowerProbeToggled(
+                        ElectricalElementId(mShipId, sinkElementIndex),
+                        ElectricalState::Off);
 
-                            case ElectricalMaterial::ShipSoundElementType::TripodHorn:
-                            {
-                                mParentWorld.DisturbOcean(std::chrono::milliseconds(500));
-                                break;
-                            }
+                    // Show notifications
+                    if (gameParameters.DoShowElectricalNotifications)
+                    {
+                        HighlightElectricalElement(sinkElementIndex, points);
+                    }
+                }
+            }
+            else
+            {
+                if (isConnectedToPower)
+                {
+                    //
+                    // Toggle state OFF->ON
+                    //
 
-                            case ElectricalMaterial::ShipSoundElementType::LakeFreighterHorn:
-                            {
-                                mParentWorld.DisturbOcean(std::chrono::milliseconds(150));
-                                break;
-                            }
+                    mElementStateBuffer[sinkElementIndex].PowerMonitor.IsPowered = true;
 
-                            case ElectricalMaterial::ShipSoundElementType::ShieldhallSteamSiren:
-                            {
-                                mParentWorld.DisturbOcean(std::chrono::milliseconds(550));
-                                break;
-                            }
+                    // Notify
+                    mGameEventHandler->OnPowerProbeToggled(
+                        ElectricalElementId(mShipId, sinkElementIndex),
+                        ElectricalState::On);
 
-                            case ElectricalMaterial::ShipSoundElementType::QueenElizabeth2Horn:
-                            {
-                                mParentWorld.DisturbOcean(std::chrono::milliseconds(250));
-                                break;
-                            }
+                    // Show notifications
+                    if (gameParameters.DoShowElectricalNotifications)
+                    {
+                        HighlightElectricalElement(sinkElementIndex, points);
+                    }
+                }
+            }
+        }
+    }
 
-                            case ElectricalMaterial::ShipSoundElementType::SSRexWhistle:
-                            {
-                                mParentWorld.DisturbOcean(std::chrono::milliseconds(250));
-                                break;
-                            }
+    //
+    // Visit all ship sounds and run their state machine
+    //
 
-                            case ElectricalMaterial::ShipSoundElementType::Klaxon1:
-                            {
-                                mParentWorld.DisturbOcean(std::chrono::milliseconds(100));
-                                break;
-                            }
+    for (auto const sinkElementIndex : mShipSounds)
+    {
+        bool const isConnectedToPower =
+            (mCurrentConnectivityVisitSequenceNumberBuffer[sinkElementIndex] == currentConnectivityVisitSequenceNumber);
 
-                            case ElectricalMaterial::ShipSoundElementType::NuclearAlarm1:
-                            {
-                                mParentWorld.DisturbOcean(std::chrono::milliseconds(500));
-                                break;
-                            }
+        if (!IsDeleted(sinkElementIndex))
+        {
+            auto & state = mElementStateBuffer[sinkElementIndex].ShipSound;
 
-                            case ElectricalMaterial::ShipSoundElementType::EvacuationAlarm1:
-                            {
-                                mParentWorld.DisturbOcean(std::chrono::milliseconds(100));
-                                break;
-                            }
+            // Update state machine
+            if (state.IsPlaying)
+            {
+                if ((!state.IsSelfPowered && !isConnectedToPower)
+                    || !mConductivityBuffer[sinkElementIndex].ConductsElectricity)
+                {
+                    //
+                    // Toggle state ON->OFF
+                    //
 
-                            case ElectricalMaterial::ShipSoundElementType::EvacuationAlarm2:
-                            {
-                                mParentWorld.DisturbOcean(std::chrono::milliseconds(100));
-                                break;
-                            }
+                    state.IsPlaying = false;
 
-                            default:
-                            {
-                                // Do not disturb
-                                break;
-                            }
-                            }
+                    // Notify sound
+                    mGameEventHandler->OnShipSoundUpdated(
+                        ElectricalElementId(mShipId, sinkElementIndex),
+                        *(mMaterialBuffer[sinkElementIndex]),
+                        false,
+                        false); // Irrelevant
 
-                            // Show notifications
-                            if (gameParameters.DoShowElectricalNotifications)
-                            {
-                                HighlightElectricalElement(sinkElementIndex, points);
-                            }
-                        }
+                    // Show notifications
+                    if (gameParameters.DoShowElectricalNotifications)
+                    {
+                        HighlightElectricalElement(sinkElementIndex, points);
                     }
                 }
-
-                break;
             }
-
-            case ElectricalMaterial::ElectricalElementType::SmokeEmitter:
+            else
             {
-                auto const emitterPointIndex = GetPointIndex(sinkElementIndex);
-                float const emitterDepth = points.GetCachedDepth(emitterPointIndex);
-
-                if (!IsDeleted(sinkElementIndex))
+                if ((state.IsSelfPowered || isConnectedToPower)
+                    && mConductivityBuffer[sinkElementIndex].ConductsElectricity)
                 {
-                    // Update state machine
-                    if (mElementStateBuffer[sinkElementIndex].SmokeEmitter.IsOperating)
+                    //
+                    // Toggle state OFF->ON
+                    //
+
+                    state.IsPlaying = true;
+
+                    // Notify sound
+                    mGameEventHandler->OnShipSoundUpdated(
+                        ElectricalElementId(mShipId, sinkElementIndex),
+                        *(mMaterialBuffer[sinkElementIndex]),
+                        true,
+                        points.IsCachedUnderwater(GetPointIndex(sinkElementIndex)));
+
+                    // Disturb ocean, with delays depending on sound
+                    switch (mMaterialBuffer[sinkElementIndex]->ShipSoundType)
                     {
-                        if (!isConnectedToPower
-                            || emitterDepth > 0.0f)
-                        {
-                            // Stop operating
-                            mElementStateBuffer[sinkElementIndex].SmokeEmitter.IsOperating = false;
-                        }
-                    }
-                    else
+                    case ElectricalMaterial::ShipSoundElementType::QueenMaryHorn:
                     {
-                        if (isConnectedToPower
-                            && emitterDepth <= 0.0f)
-                        {
-                            // Start operating
-                            mElementStateBuffer[sinkElementIndex].SmokeEmitter.IsOperating = true;
-
-                            // Make sure we calculate the next emission timestamp
-                            mElementStateBuffer[sinkElementIndex].SmokeEmitter.NextEmissionSimulationTimestamp = 0.0f;
-                        }
+                        mParentWorld.DisturbOcean(std::chrono::milliseconds(250));
+                        break;
                     }
 
-                    if (mElementStateBuffer[sinkElementIndex].SmokeEmitter.IsOperating)
+                    case ElectricalMaterial::ShipSoundElementType::FourFunnelLinerWhistle:
                     {
-                        // See if we need to calculate the next emission timestamp
-                        if (mElementStateBuffer[sinkElementIndex].SmokeEmitter.NextEmissionSimulationTimestamp == 0.0f)
-                        {
-                            mElementStateBuffer[sinkElementIndex].SmokeEmitter.NextEmissionSimulationTimestamp =
-                                currentSimulationTime
-                                + GameRandomEngine::GetInstance().GenerateExponentialReal(
-                                gameParameters.SmokeEmissionDensityAdjustment
-                                / mElementStateBuffer[sinkElementIndex].SmokeEmitter.EmissionRate);
-                        }
-
-                        // See if it's time to emit smoke
-                        if (currentSimulationTime >= mElementStateBuffer[sinkElementIndex].SmokeEmitter.NextEmissionSimulationTimestamp)
-                        {
-                            //
-                            // Emit smoke
-                            //
-
-                            // Choose temperature: highest of emitter's and current air + something (to ensure buoyancy)
-                            float const smokeTemperature = std::max(
-                                points.GetTemperature(emitterPointIndex),
-                                effectiveSmokeTemperature);
+                        mParentWorld.DisturbOcean(std::chrono::milliseconds(600));
+                        break;
+                    }
 
-                            // Generate particle
-                            points.CreateEphemeralParticleLightSmoke(
-                                points.GetPosition(emitterPointIndex),
-                                emitterDepth,
-                                smokeTemperature,
-                                currentSimulationTime,
-                                points.GetPlaneId(emitterPointIndex),
-                                gameParameters);
+                    case ElectricalMaterial::ShipSoundElementType::TripodHorn:
+                    {
+                        mParentWorld.DisturbOcean(std::chrono::milliseconds(500));
+                        break;
+                    }
 
-                            // Make sure we re-calculate the next emission timestamp
-                            mElementStateBuffer[sinkElementIndex].SmokeEmitter.NextEmissionSimulationTimestamp = 0.0f;
-                        }
+                    case ElectricalMaterial::ShipSoundElementType::LakeFreighterHorn:
+                    {
+                        mParentWorld.DisturbOcean(std::chrono::milliseconds(150));
+                        break;
                     }
-                }
 
-                break;
-            }
+                    case ElectricalMaterial::ShipSoundElementType::ShieldhallSteamSiren:
+                    {
+                        mParentWorld.DisturbOcean(std::chrono::milliseconds(550));
+                        break;
+                    }
 
-            case ElectricalMaterial::ElectricalElementType::WaterPump:
-            {
-                auto const pointIndex = GetPointIndex(sinkElementIndex);
+                    case ElectricalMaterial::ShipSoundElementType::QueenElizabeth2Horn:
+                    {
+                        mParentWorld.DisturbOcean(std::chrono::milliseconds(250));
+                        break;
+                    }
 
-                auto & waterPumpState = mElementStateBuffer[sinkElementIndex].WaterPump;
+                    case ElectricalMaterial::ShipSoundElementType::SSRexWhistle:
+                    {
+                        mParentWorld.DisturbOcean(std::chrono::milliseconds(250));
+                        break;
+                    }
 
-                //
-                // 1) If not deleted, run operating state machine (connectivity, operating temperature)
-                //    in order to come up with TargetForce
-                //
+                    case ElectricalMaterial::ShipSoundElementType::Klaxon1:
+                    {
+                        mParentWorld.DisturbOcean(std::chrono::milliseconds(100));
+                        break;
+                    }
 
-                if (!IsDeleted(sinkElementIndex))
-                {
-                    if (waterPumpState.TargetNormalizedForce != 0.0f)
+                    case ElectricalMaterial::ShipSoundElementType::NuclearAlarm1:
                     {
-                        // Currently it's powered...
-                        // ...see if it stops being powered
-                        if (!isConnectedToPower
-                            || !mMaterialOperatingTemperaturesBuffer[sinkElementIndex].IsInRange(points.GetTemperature(pointIndex)))
-                        {
-                            // State change: stop operating
-                            waterPumpState.TargetNormalizedForce = 0.0f;
+                        mParentWorld.DisturbOcean(std::chrono::milliseconds(500));
+                        break;
+                    }
 
-                            // Show notifications
-                            if (gameParameters.DoShowElectricalNotifications)
-                            {
-                                HighlightElectricalElement(sinkElementIndex, points);
-                            }
-                        }
-                        else
-                        {
-                            // Operating, thus producing heat
-                            isProducingHeat = true;
-                        }
+                    case ElectricalMaterial::ShipSoundElementType::EvacuationAlarm1:
+                    {
+                        mParentWorld.DisturbOcean(std::chrono::milliseconds(100));
+                        break;
                     }
-                    else
+
+                    case ElectricalMaterial::ShipSoundElementType::EvacuationAlarm2:
                     {
-                        // Currently it's not powered...
-                        // ...see if it becomes powered
-                        if (isConnectedToPower
-                            && mMaterialOperatingTemperaturesBuffer[sinkElementIndex].IsBackInRange(points.GetTemperature(pointIndex)))
-                        {
-                            // State change: start operating
-                            waterPumpState.TargetNormalizedForce = 1.0f;
+                        mParentWorld.DisturbOcean(std::chrono::milliseconds(100));
+                        break;
+                    }
 
-                            // Operating, thus producing heat
-                            isProducingHeat = true;
+                    default:
+                    {
+                        // Do not disturb
+                        break;
+                    }
+                    }
 
-                            // Show notifications
-                            if (gameParameters.DoShowElectricalNotifications)
-                            {
-                                HighlightElectricalElement(sinkElementIndex, points);
-                            }
-                        }
+                    // Show notifications
+                    if (gameParameters.DoShowElectricalNotifications)
+                    {
+                        HighlightElectricalElement(sinkElementIndex, points);
                     }
                 }
+            }
+        }
+    }
 
-                //
-                // 2) Converge CurrentForce towards TargetForce and eventually act on particle
-                //
-                // We run this also when deleted, as it's part of our wind-down state machine
-                //
+    //
+    // Visit all smoke emitters and run their state machine
+    //
 
-                // Converge current force
-                waterPumpState.CurrentNormalizedForce +=
-                    (waterPumpState.TargetNormalizedForce - waterPumpState.CurrentNormalizedForce)
-                    * 0.03f; // Convergence rate, magic number
-                if (std::abs(waterPumpState.CurrentNormalizedForce - waterPumpState.TargetNormalizedForce) < 0.001f)
-                {
-                    waterPumpState.CurrentNormalizedForce = waterPumpState.TargetNormalizedForce;
-                }
+    for (auto const sinkElementIndex : mSmokeEmitters)
+    {
+        bool const isConnectedToPower =
+            (mCurrentConnectivityVisitSequenceNumberBuffer[sinkElementIndex] == currentConnectivityVisitSequenceNumber);
+
+        auto const emitterPointIndex = GetPointIndex(sinkElementIndex);
+        float const emitterDepth = points.GetCachedDepth(emitterPointIndex);
 
-                // Calculate force
-                float waterPumpForce = waterPumpState.CurrentNormalizedForce * waterPumpState.NominalForce;
-                if (waterPumpForce == 0.0f) // Ensure -0.0 is +0.0, or else CompositeIsLeaking's union trick won't work
+        if (!IsDeleted(sinkElementIndex))
+        {
+            // Update state machine
+            if (mElementStateBuffer[sinkElementIndex].SmokeEmitter.IsOperating)
+            {
+                if (!isConnectedToPower
+                    || emitterDepth > 0.0f)
                 {
-                    waterPumpForce = 0.0f;
+                    // Stop operating
+                    mElementStateBuffer[sinkElementIndex].SmokeEmitter.IsOperating = false;
                 }
-
-                // Apply force to point
-                points.GetLeakingComposite(pointIndex).LeakingSources.WaterPumpForce = waterPumpForce;
-
-                // Eventually publish force change notification
-                if (waterPumpState.CurrentNormalizedForce != waterPumpState.LastPublishedNormalizedForce)
+            }
+            else
+            {
+                if (isConnectedToPower
+                    && emitterDepth <= 0.0f)
                 {
-                    // Notify
-                    mGameEventHandler->OnWaterPumpUpdated(
-                        ElectricalElementId(mShipId, sinkElementIndex),
-                        waterPumpState.CurrentNormalizedForce);
+                    // Start operating
+                    mElementStateBuffer[sinkElementIndex].SmokeEmitter.IsOperating = true;
 
-                    // Remember last-published value
-                    waterPumpState.LastPublishedNormalizedForce = waterPumpState.CurrentNormalizedForce;
+                    // Make sure we calculate the next emission timestamp
+                    mElementStateBuffer[sinkElementIndex].SmokeEmitter.NextEmissionSimulationTimestamp = 0.0f;
                 }
-
-                break;
             }
 
-            case ElectricalMaterial::ElectricalElementType::WatertightDoor:
+            if (mElementStateBuffer[sinkElementIndex].SmokeEmitter.IsOperating)
             {
-                //
-                // Run operating state machine (connectivity, operating temperature)
-                //
+                // See if we need to calculate the next emission timestamp
+                if (mElementStateBuffer[sinkElementIndex].SmokeEmitter.NextEmissionSimulationTimestamp == 0.0f)
+                {
+                    mElementStateBuffer[sinkElementIndex].SmokeEmitter.NextEmissionSimulationTimestamp =
+                        currentSimulationTime
+                        + GameRandomEngine::GetInstance().GenerateExponentialReal(
+                        gameParameters.SmokeEmissionDensityAdjustment
+                        / mElementStateBuffer[sinkElementIndex].SmokeEmitter.EmissionRate);
+                }
 
-                if (!IsDeleted(sinkElementIndex))
+                // See if it's time to emit smoke
+                if (currentSimulationTime >= mElementStateBuffer[sinkElementIndex].SmokeEmitter.NextEmissionSimulationTimestamp)
                 {
-                    auto const pointIndex = GetPointIndex(sinkElementIndex);
+                    //
+                    // Emit smoke
+                    //
 
-                    auto & watertightDoorState = mElementStateBuffer[sinkElementIndex].WatertightDoor;
+                    // Choose temperature: highest of emitter's and current air + something (to ensure buoyancy)
+                    float const smokeTemperature = std::max(
+                        points.GetTemperature(emitterPointIndex),
+                        effectiveSmokeTemperature);
 
-                    bool hasStateChanged = false;
-                    if (watertightDoorState.IsActivated)
-                    {
-                        // Currently it's activated...
-                        // ...see if it stops being activated
-                        if (!isConnectedToPower
-                            || !mMaterialOperatingTemperaturesBuffer[sinkElementIndex].IsInRange(points.GetTemperature(pointIndex)))
-                        {
-                            //
-                            // State change: stop operating
-                            //
+                    // Generate particle
+                    points.CreateEphemeralParticleLightSmoke(
+                        points.GetPosition(emitterPointIndex),
+                        emitterDepth,
+                        smokeTemperature,
+                        currentSimulationTime,
+                        points.GetPlaneId(emitterPointIndex),
+                        gameParameters);
 
-                            watertightDoorState.IsActivated = false;
+                    // Make sure we re-calculate the next emission timestamp
+                    mElementStateBuffer[sinkElementIndex].SmokeEmitter.NextEmissionSimulationTimestamp = 0.0f;
+                }
+            }
+        }
+    }
 
-                            hasStateChanged = true;
-                        }
-                    }
-                    else
-                    {
-                        // Currently it's not activated...
-                        // ...see if it becomes activated
-                        if (isConnectedToPower
-                            && mMaterialOperatingTemperaturesBuffer[sinkElementIndex].IsBackInRange(points.GetTemperature(pointIndex)))
-                        {
-                            //
-                            // State change: start operating
-                            //
+    //
+    // Visit all water pumps and run their state machine
+    //
 
-                            watertightDoorState.IsActivated = true;
+    for (auto const sinkElementIndex : mWaterPumps)
+    {
+        bool const isConnectedToPower =
+            (mCurrentConnectivityVisitSequenceNumberBuffer[sinkElementIndex] == currentConnectivityVisitSequenceNumber);
 
-                            hasStateChanged = true;
-                        }
-                    }
+        bool isProducingHeat = false;
 
-                    if (hasStateChanged)
-                    {
-                        // Propagate structural effect
-                        assert(nullptr != mShipPhysicsHandler);
-                        mShipPhysicsHandler->HandleWatertightDoorUpdated(pointIndex, watertightDoorState.IsOpen());
+        auto const pointIndex = GetPointIndex(sinkElementIndex);
 
-                        // Publish state change
-                        mGameEventHandler->OnWatertightDoorUpdated(
-                            ElectricalElementId(mShipId, sinkElementIndex),
-                            watertightDoorState.IsOpen());
+        auto & waterPumpState = mElementStateBuffer[sinkElementIndex].WaterPump;
 
-                        // Show notifications
-                        if (gameParameters.DoShowElectricalNotifications)
-                        {
-                            HighlightElectricalElement(sinkElementIndex, points);
-                        }
+        //
+        // 1) If not deleted, run operating state machine (connectivity, operating temperature)
+        //    in order to come up with TargetForce
+        //
+
+        if (!IsDeleted(sinkElementIndex))
+        {
+            if (waterPumpState.TargetNormalizedForce != 0.0f)
+            {
+                // Currently it's powered...
+                // ...see if it stops being powered
+                if (!isConnectedToPower
+                    || !mMaterialOperatingTemperaturesBuffer[sinkElementIndex].IsInRange(points.GetTemperature(pointIndex)))
+                {
+                    // State change: stop operating
+                    waterPumpState.TargetNormalizedForce = 0.0f;
+
+                    // Show notifications
+                    if (gameParameters.DoShowElectricalNotifications)
+                    {
+                        HighlightElectricalElement(sinkElementIndex, points);
                     }
                 }
-
-                break;
+                else
+                {
+                    // Operating, thus producing heat
+                    isProducingHeat = true;
+                }
             }
-
-            default:
+            else
             {
-                assert(false);
-                break;
+                // Currently it's not powered...
+                // ...see if it becomes powered
+                if (isConnectedToPower
+                    && mMaterialOperatingTemperaturesBuffer[sinkElementIndex].IsBackInRange(points.GetTemperature(pointIndex)))
+                {
+                    // State change: start operating
+                    waterPumpState.TargetNormalizedForce = 1.0f;
+
+                    // Operating, thus producing heat
+                    isProducingHeat = true;
+
+                    // Show notifications
+                    if (gameParameters.DoShowElectricalNotifications)
+                    {
+                        HighlightElectricalElement(sinkElementIndex, points);
+                    }
+                }
             }
         }
 
+        //
+        // 2) Converge CurrentForce towards TargetForce and eventually act on particle
+        //
+        // We run this also when deleted, as it's part of our wind-down state machine
+        //
+
+        // Converge current force
+        waterPumpState.CurrentNormalizedForce +=
+            (waterPumpState.TargetNormalizedForce - waterPumpState.CurrentNormalizedForce)
+            * 0.03f; // Convergence rate, magic number
+        if (std::abs(waterPumpState.CurrentNormalizedForce - waterPumpState.TargetNormalizedForce) < 0.001f)
+        {
+            waterPumpState.CurrentNormalizedForce = waterPumpState.TargetNormalizedForce;
+        }
+
+        // Calculate force
+        float waterPumpForce = waterPumpState.CurrentNormalizedForce * waterPumpState.NominalForce;
+        if (waterPumpForce == 0.0f) // Ensure -0.0 is +0.0, or else CompositeIsLeaking's union trick won't work
+        {
+            waterPumpForce = 0.0f;
+        }
+
+        // Apply force to point
+        points.SetWaterPumpForce(pointIndex, waterPumpForce);
+
+        // Eventually publish force change notification
+        if (waterPumpState.CurrentNormalizedForce != waterPumpState.LastPublishedNormalizedForce)
+        {
+            // Notify
+            mGameEventHandler->OnWaterPumpUpdated(
+                ElectricalElementId(mShipId, sinkElementIndex),
+                waterPumpState.CurrentNormalizedForce);
+
+            // Remember last-published value
+            waterPumpState.LastPublishedNormalizedForce = waterPumpState.CurrentNormalizedForce;
+        }
+
         //
         // Generate heat if sink is working
         //
@@ -2318,6 +2520,79 @@ void ElectricalElements::UpdateSinks(
         }
     }
 
+    //
+    // Visit all watertight doors and run their state machine
+    //
+
+    for (auto const sinkElementIndex : mWatertightDoors)
+    {
+        bool const isConnectedToPower =
+            (mCurrentConnectivityVisitSequenceNumberBuffer[sinkElementIndex] == currentConnectivityVisitSequenceNumber);
+
+        //
+        // Run operating state machine (connectivity, operating temperature)
+        //
+
+        if (!IsDeleted(sinkElementIndex))
+        {
+            auto const pointIndex = GetPointIndex(sinkElementIndex);
+
+            auto & watertightDoorState = mElementStateBuffer[sinkElementIndex].WatertightDoor;
+
+            bool hasStateChanged = false;
+            if (watertightDoorState.IsActivated)
+            {
+                // Currently it's activated...
+                // ...see if it stops being activated
+                if (!isConnectedToPower
+                    || !mMaterialOperatingTemperaturesBuffer[sinkElementIndex].IsInRange(points.GetTemperature(pointIndex)))
+                {
+                    //
+                    // State change: stop operating
+                    //
+
+                    watertightDoorState.IsActivated = false;
+
+                    hasStateChanged = true;
+                }
+            }
+            else
+            {
+                // Currently it's not activated...
+                // ...see if it becomes activated
+                if (isConnectedToPower
+                    && mMaterialOperatingTemperaturesBuffer[sinkElementIndex].IsBackInRange(points.GetTemperature(pointIndex)))
+                {
+                    //
+                    // State change: start operating
+                    //
+
+                    watertightDoorState.IsActivated = true;
+
+                    hasStateChanged = true;
+                }
+            }
+
+            if (hasStateChanged)
+            {
+                // Propagate structural effect
+                assert(nullptr != mShipPhysicsHandler);
+                mShipPhysicsHandler->HandleWatertightDoorUpdated(pointIndex, watertightDoorState.IsOpen());
+
+                // Publish state change
+                mGameEventHandler->OnWatertightDoorUpdated(
+                    ElectricalElementId(mShipId, sinkElementIndex),
+                    watertightDoorState.IsOpen());
+
+                // Show notifications
+                if (gameParameters.DoShowElectricalNotifications)
+                {
+                    HighlightElectricalElement(sinkElementIndex, points);
+                }
+            }
+        }
+    }
+
     //
     // Visit all engines and run their state machine
     //
@@ -2936,4 +3211,93 @@ bool ElectricalElements::CheckWetFailureTime(
     return isFailure;
 }
 
+size_t ElectricalElements::GetByteSize() const
+{
+    return
+        mIsDeletedBuffer.GetByteSize()
+        + mPointIndexBuffer.GetByteSize()
+        + mMaterialBuffer.GetByteSize()
+        + mMaterialTypeBuffer.GetByteSize()
+        + mConductivityBuffer.GetByteSize()
+        + mMaterialHeatGeneratedBuffer.GetByteSize()
+        + mMaterialOperatingTemperaturesBuffer.GetByteSize()
+        + mMaterialLuminiscenceBuffer.GetByteSize()
+        + mMaterialLightColorBuffer.GetByteSize()
+        + mMaterialLightSpreadBuffer.GetByteSize()
+        + mConnectedElectricalElementsBuffer.GetByteSize()
+        + mConductingConnectedElectricalElementsBuffer.GetByteSize()
+        + mElementStateBuffer.GetByteSize()
+        + mAvailableLightBuffer.GetByteSize()
+        + mCurrentConnectivityVisitSequenceNumberBuffer.GetByteSize()
+        + mLampRawDistanceCoefficientBuffer.GetByteSize()
+        + mLampLightSpreadMaxDistanceBuffer.GetByteSize()
+        + mLampPositionWorkBuffer.GetByteSize()
+        + mLampPlaneIdWorkBuffer.GetByteSize()
+        + mLampDistanceCoefficientWorkBuffer.GetByteSize();
+}
+
+static std::uint32_t constexpr StateSectionTag = 0x53434C45; // ELCS
+
+void ElectricalElements::SaveState(StateSnapshotWriter & writer) const
+{
+    writer.BeginSection(StateSectionTag);
+
+    ArchiveState(*this, writer);
+}
+
+void ElectricalElements::LoadState(StateSnapshotReader & reader)
+{
+    reader.BeginSection(StateSectionTag);
+
+    ArchiveState(*this, reader);
+
+    // Re-do all that depends on connectivity, and re-propagate power
+    mHasConnectivityStructureChangedInCurrentStep = true;
+    mIsPowerPropagationDirty = true;
+    mPowerFailureReasonInCurrentStep.reset();
+}
+
+template<typename TSelf, typename TArchive>
+void ElectricalElements::ArchiveState(
+    TSelf & self,
+    TArchive & archive)
+{
+    // Materials and instance infos are not archived, as they are immutable
+    // and not plain data
+
+    archive.Archive(self.mIsDeletedBuffer);
+    archive.Archive(self.mPointIndexBuffer);
+    archive.Archive(self.mMaterialTypeBuffer);
+    archive.Archive(self.mConductivityBuffer);
+    archive.Archive(self.mMaterialHeatGeneratedBuffer);
+    archive.Archive(self.mMaterialOperatingTemperaturesBuffer);
+    archive.Archive(self.mMaterialLuminiscenceBuffer);
+    archive.Archive(self.mMaterialLightColorBuffer);
+    archive.Archive(self.mMaterialLightSpreadBuffer);
+    archive.Archive(self.mConnectedElectricalElementsBuffer);
+    archive.Archive(self.mConductingConnectedElectricalElementsBuffer);
+    archive.Archive(self.mElementStateBuffer);
+    archive.Archive(self.mEngineGroupStates);
+    archive.Archive(self.mAvailableLightBuffer);
+    archive.Archive(self.mCurrentConnectivityVisitSequenceNumberBuffer);
+    archive.Archive(self.mLampRawDistanceCoefficientBuffer);
+    archive.Archive(self.mLampLightSpreadMaxDistanceBuffer);
+
+    archive.Archive(self.mAutomaticConductivityTogglingElements);
+    archive.Archive(self.mSources);
+    archive.Archive(self.mLamps);
+    archive.Archive(self.mEngineControllers);
+    archive.Archive(self.mEngines);
+    archive.Archive(self.mOtherSinks);
+    archive.Archive(self.mPowerMonitors);
+    archive.Archive(self.mShipSounds);
+    archive.Archive(self.mSmokeEmitters);
+    archive.Archive(self.mWaterPumps);
+    archive.Archive(self.mWatertightDoors);
+    archive.Archive(self.mJetEnginesSortedByPlaneId);
+
+    archive.Archive(self.mPowerPropagationVisitSequenceNumber);
+    archive.Archive(self.mPowerPropagatingSources);
+}
+
 }
\ No newline at end of file
@@ -11,6 +11,7 @@
 #include <GameCore/ElementContainer.h>
 #include <GameCore/FixedSizeVector.h>
 #include <GameCore/GameWallClock.h>
+#include <GameCore/StateSnapshot.h>
 
 #include <cassert>
 #include <chrono>
@@ -497,14 +498,23 @@ public:
         , mShipPhysicsHandler(nullptr)
         , mAutomaticConductivityTogglingElements()
         , mSources()
-        , mSinks()
         , mLamps()
         , mEngineControllers()
         , mEngines()
+        , mOtherSinks()
+        , mPowerMonitors()
+        , mShipSounds()
+        , mSmokeEmitters()
+        , mWaterPumps()
+        , mWatertightDoors()
         , mJetEnginesSortedByPlaneId()
+        , mCurrentGameParametersGeneration(gameParameters.Generation)
         , mCurrentLightSpreadAdjustment(gameParameters.LightSpreadAdjustment)
         , mCurrentLuminiscenceAdjustment(gameParameters.LuminiscenceAdjustment)
         , mHasConnectivityStructureChangedInCurrentStep(true)
+        , mIsPowerPropagationDirty(true)
+        , mPowerPropagationVisitSequenceNumber()
+        , mPowerPropagatingSources()
         , mPowerFailureReasonInCurrentStep()
     {
         mInstanceInfos.reserve(mElementCount);
@@ -532,6 +542,26 @@ public:
         ElectricalMaterial const & electricalMaterial,
         Points const & points);
 
+    /*
+     * Populates this container - which must be empty - with the elements of a fragment
+     * of another ship, in their current state; point indices are remapped to the
+     * fragment's, whose points must have already been populated.
+     */
+    void AddFragment(
+        ElectricalElements const & other,
+        ShipFragmentMap const & fragmentMap,
+        Points const & points);
+
+    /*
+     * Publishes the events that silence the elements that are currently playing,
+     * running, or pumping, before this container is replaced by its fragments.
+     */
+    void PublishFragmentationSilencing() const;
+
+    /*
+     * Announces the instanced elements; the caller is responsible for enclosing the
+     * announcements of all ships between OnElectricalElementAnnouncementsBegin/End.
+     */
     void AnnounceInstancedElements();
 
     void HighlightElectricalElement(
@@ -594,6 +624,19 @@ public:
         Render::ShipRenderContext & shipRenderContext,
         Points const & points) const;
 
+    /*
+     * Gets the number of bytes occupied by all of our buffers; for diagnostics only.
+     */
+    size_t GetByteSize() const;
+
+    /*
+     * Saves and restores the whole simulation state of the electrical elements,
+     * except for their materials, which are expected to be the same as the ones
+     * of the elements the state has been saved from.
+     */
+    void SaveState(StateSnapshotWriter & writer) const;
+    void LoadState(StateSnapshotReader & reader);
+
 public:
 
     //
@@ -669,6 +712,7 @@ public:
 
         // Remember that connectivity structure has changed during this step
         mHasConnectivityStructureChangedInCurrentStep = true;
+        mIsPowerPropagationDirty = true;
     }
 
     inline void RemoveConnectedElectricalElement(
@@ -690,6 +734,7 @@ public:
 
         // Remember that connectivity structure has changed during this step
         mHasConnectivityStructureChangedInCurrentStep = true;
+        mIsPowerPropagationDirty = true;
 
         if (hasBeenSevered)
         {
@@ -787,6 +832,11 @@ public:
 
 private:
 
+    template<typename TSelf, typename TArchive>
+    static void ArchiveState(
+        TSelf & self,
+        TArchive & archive);
+
     void InternalSetSwitchState(
         ElementIndex elementIndex,
         ElectricalState switchState,
@@ -958,11 +1008,18 @@ private:
     // Indices of specific types in this container - just a shortcut
     std::vector<ElementIndex> mAutomaticConductivityTogglingElements;
     std::vector<ElementIndex> mSources;
-    std::vector<ElementIndex> mSinks;
     std::vector<ElementIndex> mLamps;
     std::vector<ElementIndex> mEngineControllers;
     std::vector<ElementIndex> mEngines;
 
+    // Indices of sinks, partitioned by type - so that sinks are visited one type at a time
+    std::vector<ElementIndex> mOtherSinks;
+    std::vector<ElementIndex> mPowerMonitors;
+    std::vector<ElementIndex> mShipSounds;
+    std::vector<ElementIndex> mSmokeEmitters;
+    std::vector<ElementIndex> mWaterPumps;
+    std::vector<ElementIndex> mWatertightDoors;
+
     // Subset of mEngines index vector, only for jets *and* sorted by particle Plane ID;
     // never changes size, only order
     std::vector<ElementIndex> mJetEnginesSortedByPlaneId;
@@ -970,6 +1027,7 @@ private:
     // The game parameter values that we are current with; changes
     // in the values of these parameters will trigger a re-calculation
     // of pre-calculated coefficients
+    std::uint64_t mCurrentGameParametersGeneration;
     float mCurrentLightSpreadAdjustment;
     float mCurrentLuminiscenceAdjustment;
 
@@ -978,6 +1036,18 @@ private:
     // to happen at these changes
     bool mHasConnectivityStructureChangedInCurrentStep;
 
+    // Flag indicating that the set of powered elements might have changed -
+    // because of changes in conductive connectivity or in the state of the
+    // sources - and thus that power needs to be re-propagated from the sources
+    bool mIsPowerPropagationDirty;
+
+    // The visit sequence number stamped by the last power propagation; elements
+    // stamped with it are the ones connected to power
+    SequenceNumber mPowerPropagationVisitSequenceNumber;
+
+    // The sources that powered a circuit at the last power propagation
+    std::vector<ElementIndex> mPowerPropagatingSources;
+
     // Flag indicating the cause of a power failure during the current
     // simulation step; cleared at the end of sinks' update.
     // Set only when there's been a failure; not set if power disappears
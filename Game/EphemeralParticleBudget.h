@@ -0,0 +1,234 @@
+/***************************************************************************************
+* Original Author:      Gabriele Giuseppini
+* Created:              2026-10-14
+* Copyright:            Gabriele Giuseppini  (https://github.com/GabrieleGiuseppini)
+***************************************************************************************/
+#pragma once
+
+#include <GameCore/GameTypes.h>
+#include <GameCore/StateSnapshot.h>
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cstdint>
+
+namespace Physics
+{
+
+/*
+ * This class apportions the ephemeral particle region among the types of
+ * ephemeral particles, so that no single type - e.g. smoke during a big fire -
+ * may take over the whole region and push out the others.
+ *
+ * Each type has a cap - a fraction of the region's capacity - and a priority;
+ * a type that has reached its cap may only replace its own particles, while a
+ * type below its cap may replace the particles of types with a lower or equal
+ * priority. A type may also not be allowed to replace particles at all.
+ *
+ * On top of this, a level of detail thins out the particles being spawned -
+ * e.g. when the camera is zoomed out and individual particles are barely visible.
+ */
+template<std::size_t TypeCount>
+class EphemeralParticleBudget final
+{
+public:
+
+    struct TypeBudget
+    {
+        float CapacityFraction; // Fraction of the capacity that may be taken by particles of this type
+        int Priority; // Higher number means the particles of this type are more important
+        bool CanReplace; // Whether this type may replace existing particles when a new one has no room
+
+        TypeBudget()
+            : CapacityFraction(1.0f)
+            , Priority(0)
+            , CanReplace(false)
+        {}
+
+        TypeBudget(
+            float capacityFraction,
+            int priority,
+            bool canReplace)
+            : CapacityFraction(capacityFraction)
+            , Priority(priority)
+            , CanReplace(canReplace)
+        {}
+    };
+
+    struct Statistics
+    {
+        std::uint64_t DropCount; // Particles that have not been spawned as they found no room
+        std::uint64_t LevelOfDetailSkipCount; // Particles that have not been spawned because of the level of detail
+
+        Statistics()
+            : DropCount(0)
+            , LevelOfDetailSkipCount(0)
+        {}
+    };
+
+public:
+
+    EphemeralParticleBudget(
+        std::array<TypeBudget, TypeCount> const & typeBudgets,
+        ElementCount capacity)
+        : mTypeBudgets(typeBudgets)
+        , mCaps()
+        , mCounts()
+        , mLevelOfDetail(1.0f)
+        , mLevelOfDetailAccumulators()
+        , mStatistics()
+    {
+        mCounts.fill(0);
+        mLevelOfDetailAccumulators.fill(0.0f);
+
+        SetCapacity(capacity);
+    }
+
+    EphemeralParticleBudget(EphemeralParticleBudget && other) = default;
+
+    void SetCapacity(ElementCount capacity) noexcept
+    {
+        for (std::size_t t = 0; t < TypeCount; ++t)
+        {
+            mCaps[t] = std::max(
+                static_cast<ElementCount>(static_cast<float>(capacity) * mTypeBudgets[t].CapacityFraction),
+                ElementCount(1));
+        }
+    }
+
+    inline float GetLevelOfDetail() const noexcept
+    {
+        return mLevelOfDetail;
+    }
+
+    /*
+     * Sets the fraction of the requested particles that are actually spawned: 1.0 spawns
+     * all of them, 0.5 every other one, and so on.
+     */
+    inline void SetLevelOfDetail(float levelOfDetail) noexcept
+    {
+        assert(levelOfDetail > 0.0f && levelOfDetail <= 1.0f);
+
+        mLevelOfDetail = levelOfDetail;
+    }
+
+    /*
+     * Decides - deterministically - whether a requested particle of the specified type
+     * has to be spawned, according to the current level of detail.
+     */
+    inline bool ShouldSpawn(std::size_t type) noexcept
+    {
+        assert(type < TypeCount);
+
+        mLevelOfDetailAccumulators[type] += mLevelOfDetail;
+        if (mLevelOfDetailAccumulators[type] >= 1.0f)
+        {
+            mLevelOfDetailAccumulators[type] -= 1.0f;
+            return true;
+        }
+
+        ++(mStatistics.LevelOfDetailSkipCount);
+        return false;
+    }
+
+    inline bool IsOverBudget(std::size_t type) const noexcept
+    {
+        assert(type < TypeCount);
+
+        return mCounts[type] >= mCaps[type];
+    }
+
+    /*
+     * Decides whether a new particle of the specified type - which has found no room -
+     * may take the place of an existing particle of the other specified type.
+     */
+    inline bool CanReplace(
+        std::size_t type,
+        std::size_t existingType) const noexcept
+    {
+        assert(type < TypeCount && existingType < TypeCount);
+
+        if (!mTypeBudgets[type].CanReplace)
+            return false;
+
+        if (IsOverBudget(type))
+            return existingType == type;
+
+        return mTypeBudgets[existingType].Priority <= mTypeBudgets[type].Priority;
+    }
+
+    inline void OnSpawned(std::size_t type) noexcept
+    {
+        assert(type < TypeCount);
+
+        ++mCounts[type];
+    }
+
+    inline void OnExpired(std::size_t type) noexcept
+    {
+        assert(type < TypeCount);
+        assert(mCounts[type] > 0);
+
+        --mCounts[type];
+    }
+
+    inline void OnDropped() noexcept
+    {
+        ++(mStatistics.DropCount);
+    }
+
+    inline ElementCount GetCount(std::size_t type) const noexcept
+    {
+        assert(type < TypeCount);
+
+        return mCounts[type];
+    }
+
+    inline ElementCount GetCap(std::size_t type) const noexcept
+    {
+        assert(type < TypeCount);
+
+        return mCaps[type];
+    }
+
+    inline Statistics const & GetStatistics() const noexcept
+    {
+        return mStatistics;
+    }
+
+    inline void ResetStatistics() noexcept
+    {
+        mStatistics = Statistics();
+    }
+
+    void SaveState(StateSnapshotWriter & writer) const
+    {
+        writer.Archive(mCaps);
+        writer.Archive(mCounts);
+        writer.Archive(mLevelOfDetail);
+        writer.Archive(mLevelOfDetailAccumulators);
+    }
+
+    void LoadState(StateSnapshotReader & reader)
+    {
+        reader.Archive(mCaps);
+        reader.Archive(mCounts);
+        reader.Archive(mLevelOfDetail);
+        reader.Archive(mLevelOfDetailAccumulators);
+    }
+
+private:
+
+    std::array<TypeBudget, TypeCount> const mTypeBudgets;
+
+    std::array<ElementCount, TypeCount> mCaps;
+    std::array<ElementCount, TypeCount> mCounts;
+
+    float mLevelOfDetail;
+    std::array<float, TypeCount> mLevelOfDetailAccumulators;
+
+    Statistics mStatistics;
+};
+
+}
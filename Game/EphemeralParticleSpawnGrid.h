@@ -0,0 +1,133 @@
+/***************************************************************************************
+* Original Author:      Gabriele Giuseppini
+* Created:              2026-10-14
+* Copyright:            Gabriele Giuseppini  (https://github.com/GabrieleGiuseppini)
+***************************************************************************************/
+#pragma once
+
+#include <GameCore/Vectors.h>
+
+#include <array>
+#include <cassert>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+
+namespace Physics
+{
+
+/*
+ * This class caps the rate at which ephemeral particles are spawned within each
+ * cell of a coarse world grid, so that the cost of spawning tracks the density
+ * of particles that may actually be seen - rather than the number of events
+ * requesting particles, e.g. a fast engine requesting bubbles at every step.
+ *
+ * Cells are kept in a small, fixed-size table indexed by a hash of the cell's
+ * coordinates; cells colliding in the table while both active share the same
+ * rate, which only makes the cap more conservative.
+ */
+class EphemeralParticleSpawnGrid final
+{
+public:
+
+    EphemeralParticleSpawnGrid(
+        float cellSize,
+        std::uint32_t maxSpawnsPerCellPerSecond)
+        : mCellSizeReciprocal(1.0f / cellSize)
+        , mMaxSpawnsPerCellPerSecond(maxSpawnsPerCellPerSecond)
+        , mCells()
+        , mSkipCount(0)
+    {
+        assert(cellSize > 0.0f);
+
+        Reset();
+    }
+
+    EphemeralParticleSpawnGrid(EphemeralParticleSpawnGrid && other) = default;
+
+    /*
+     * Forgets all spawns, e.g. after the state of the ship has been restored.
+     */
+    void Reset() noexcept
+    {
+        mCells.fill(Cell());
+    }
+
+    /*
+     * Decides whether a particle may be spawned at the specified position, accounting
+     * for it if so.
+     */
+    inline bool TrySpawn(
+        vec2f const & position,
+        float currentSimulationTime) noexcept
+    {
+        std::int32_t const cellX = static_cast<std::int32_t>(std::floor(position.x * mCellSizeReciprocal));
+        std::int32_t const cellY = static_cast<std::int32_t>(std::floor(position.y * mCellSizeReciprocal));
+
+        Cell & cell = mCells[GetCellSlot(cellX, cellY)];
+
+        // Start a new window when the current one is over - or when time
+        // has gone backwards, as the state has been restored
+        if (currentSimulationTime - cell.WindowStartSimulationTime >= 1.0f
+            || currentSimulationTime < cell.WindowStartSimulationTime)
+        {
+            cell.WindowStartSimulationTime = currentSimulationTime;
+            cell.SpawnCount = 0;
+        }
+
+        if (cell.SpawnCount >= mMaxSpawnsPerCellPerSecond)
+        {
+            ++mSkipCount;
+            return false;
+        }
+
+        ++cell.SpawnCount;
+        return true;
+    }
+
+    /*
+     * Returns the number of particles that have not been spawned since the last
+     * invocation of this method.
+     */
+    inline std::uint64_t ResetSkipCount() noexcept
+    {
+        std::uint64_t const skipCount = mSkipCount;
+        mSkipCount = 0;
+        return skipCount;
+    }
+
+private:
+
+    static std::size_t constexpr CellSlotCount = 256; // Power of two
+
+    static inline std::size_t GetCellSlot(
+        std::int32_t cellX,
+        std::int32_t cellY) noexcept
+    {
+        std::uint32_t const hash =
+            (static_cast<std::uint32_t>(cellX) * 73856093u)
+            ^ (static_cast<std::uint32_t>(cellY) * 19349663u);
+
+        return static_cast<std::size_t>(hash ^ (hash >> 16)) & (CellSlotCount - 1);
+    }
+
+    struct Cell
+    {
+        float WindowStartSimulationTime;
+        std::uint32_t SpawnCount;
+
+        Cell()
+            : WindowStartSimulationTime(std::numeric_limits<float>::lowest())
+            , SpawnCount(0)
+        {}
+    };
+
+    float const mCellSizeReciprocal;
+    std::uint32_t const mMaxSpawnsPerCellPerSecond;
+
+    std::array<Cell, CellSlotCount> mCells;
+
+    std::uint64_t mSkipCount;
+};
+
+}
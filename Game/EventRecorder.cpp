@@ -0,0 +1,165 @@
+/***************************************************************************************
+* Original Author:      Gabriele Giuseppini
+* Created:              2026-10-14
+* Copyright:            Gabriele Giuseppini  (https://github.com/GabrieleGiuseppini)
+***************************************************************************************/
+#include "EventRecorder.h"
+
+#include <GameCore/GameException.h>
+
+#include <cstring>
+#include <fstream>
+
+namespace /* anonymous */ {
+
+    char constexpr FileMagic[4] = { 'F', 'S', 'R', 'E' };
+
+    std::uint16_t constexpr CurrentFileVersion = 1;
+
+    template<typename T>
+    size_t ReadChecked(
+        DeSerializationBuffer<BigEndianess> const & buffer,
+        size_t index,
+        T & value)
+    {
+        if (index + sizeof(T) > buffer.GetSize())
+        {
+            throw GameException("Recorded events file is truncated");
+        }
+
+        return buffer.ReadAt<T>(index, value);
+    }
+}
+
+void RecordedEvents::SaveTo(std::filesystem::path const & filePath) const
+{
+    DeSerializationBuffer<BigEndianess> buffer(64 + mEvents.size() * 20);
+    Serialize(buffer);
+
+    std::ofstream outputFile(
+        filePath,
+        std::ios_base::out | std::ios_base::binary | std::ios_base::trunc);
+
+    if (!outputFile)
+    {
+        throw GameException("Cannot create file \"" + filePath.string() + "\"");
+    }
+
+    outputFile.write(reinterpret_cast<char const *>(buffer.GetData()), buffer.GetSize());
+}
+
+RecordedEvents RecordedEvents::LoadFrom(std::filesystem::path const & filePath)
+{
+    std::ifstream inputFile(
+        filePath,
+        std::ios_base::in | std::ios_base::binary);
+
+    if (!inputFile)
+    {
+        throw GameException("Cannot open file \"" + filePath.string() + "\"");
+    }
+
+    inputFile.seekg(0, std::ios_base::end);
+    size_t const fileSize = static_cast<size_t>(inputFile.tellg());
+    inputFile.seekg(0, std::ios_base::beg);
+
+    DeSerializationBuffer<BigEndianess> buffer(fileSize + 1);
+    inputFile.read(reinterpret_cast<char *>(buffer.Receive(fileSize)), fileSize);
+
+    return Deserialize(buffer);
+}
+
+void RecordedEvents::Serialize(DeSerializationBuffer<BigEndianess> & buffer) const
+{
+    // Header
+    buffer.Append(reinterpret_cast<unsigned char const *>(FileMagic), sizeof(FileMagic));
+    buffer.Append(CurrentFileVersion);
+    buffer.Append(static_cast<std::uint32_t>(mEvents.size()));
+
+    // Events
+    for (auto const & event : mEvents)
+    {
+        buffer.Append(static_cast<std::uint8_t>(event->GetType()));
+        event->Serialize(buffer);
+    }
+}
+
+RecordedEvents RecordedEvents::Deserialize(DeSerializationBuffer<BigEndianess> const & buffer)
+{
+    size_t readOffset = 0;
+
+    //
+    // Header
+    //
+
+    if (buffer.GetSize() < sizeof(FileMagic)
+        || std::memcmp(buffer.GetData(), FileMagic, sizeof(FileMagic)) != 0)
+    {
+        throw GameException("File is not a recorded events file");
+    }
+
+    readOffset += sizeof(FileMagic);
+
+    std::uint16_t fileVersion;
+    readOffset += ReadChecked(buffer, readOffset, fileVersion);
+    if (fileVersion > CurrentFileVersion)
+    {
+        throw GameException("Recorded events file has been created with a newer version of the game");
+    }
+
+    std::uint32_t eventCount;
+    readOffset += ReadChecked(buffer, readOffset, eventCount);
+
+    //
+    // Events
+    //
+
+    std::vector<std::unique_ptr<RecordedEvent>> events;
+    events.reserve(eventCount);
+
+    for (std::uint32_t e = 0; e < eventCount; ++e)
+    {
+        std::uint8_t eventType;
+        readOffset += ReadChecked(buffer, readOffset, eventType);
+
+        switch (static_cast<RecordedEvent::RecordedEventType>(eventType))
+        {
+            case RecordedEvent::RecordedEventType::PointDetachForDestroy:
+            {
+                std::uint32_t pointIndex;
+                readOffset += ReadChecked(buffer, readOffset, pointIndex);
+                vec2f detachVelocity;
+                readOffset += ReadChecked(buffer, readOffset, detachVelocity.x);
+                readOffset += ReadChecked(buffer, readOffset, detachVelocity.y);
+                float simulationTime;
+                readOffset += ReadChecked(buffer, readOffset, simulationTime);
+
+                events.emplace_back(
+                    new RecordedPointDetachForDestroyEvent(
+                        static_cast<ElementIndex>(pointIndex),
+                        detachVelocity,
+                        simulationTime));
+
+                break;
+            }
+
+            case RecordedEvent::RecordedEventType::TriangleDestroy:
+            {
+                std::uint32_t pointIndex;
+                readOffset += ReadChecked(buffer, readOffset, pointIndex);
+
+                events.emplace_back(
+                    new RecordedTriangleDestroyEvent(static_cast<ElementIndex>(pointIndex)));
+
+                break;
+            }
+
+            default:
+            {
+                throw GameException("Recorded events file contains an unrecognized event type");
+            }
+        }
+    }
+
+    return RecordedEvents(std::move(events));
+}
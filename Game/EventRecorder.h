@@ -5,10 +5,13 @@
 ***************************************************************************************/
 #pragma once
 
+#include <GameCore/DeSerializationBuffer.h>
+#include <GameCore/Endian.h>
 #include <GameCore/GameTypes.h>
 #include <GameCore/Vectors.h>
 
 #include <cstdint>
+#include <filesystem>
 #include <functional>
 #include <memory>
 #include <sstream>
@@ -22,10 +25,10 @@ public:
     virtual ~RecordedEvent()
     {}
 
-    enum class RecordedEventType
+    enum class RecordedEventType : std::uint8_t
     {
-        PointDetachForDestroy,
-        TriangleDestroy
+        PointDetachForDestroy = 0,
+        TriangleDestroy = 1
     };
 
     RecordedEventType GetType() const
@@ -35,6 +38,11 @@ public:
 
     virtual std::string ToString() const = 0;
 
+    /*
+     * Appends the event's own data - not its type - to the buffer.
+     */
+    virtual void Serialize(DeSerializationBuffer<BigEndianess> & buffer) const = 0;
+
 protected:
 
     RecordedEvent(RecordedEventType type)
@@ -83,6 +91,14 @@ public:
         return ss.str();
     }
 
+    void Serialize(DeSerializationBuffer<BigEndianess> & buffer) const override
+    {
+        buffer.Append(static_cast<std::uint32_t>(mPointIndex));
+        buffer.Append(mDetachVelocity.x);
+        buffer.Append(mDetachVelocity.y);
+        buffer.Append(mSimulationTime);
+    }
+
 private:
 
     ElementIndex const mPointIndex;
@@ -111,6 +127,11 @@ public:
         return ss.str();
     }
 
+    void Serialize(DeSerializationBuffer<BigEndianess> & buffer) const override
+    {
+        buffer.Append(static_cast<std::uint32_t>(mPointIndex));
+    }
+
 private:
 
     ElementIndex const mPointIndex;
@@ -135,6 +156,18 @@ public:
         return *mEvents[index];
     }
 
+    /*
+     * Saves the events to a compact binary file, so that a session may be replayed
+     * elsewhere - e.g. on a profiling machine.
+     */
+    void SaveTo(std::filesystem::path const & filePath) const;
+
+    static RecordedEvents LoadFrom(std::filesystem::path const & filePath);
+
+    void Serialize(DeSerializationBuffer<BigEndianess> & buffer) const;
+
+    static RecordedEvents Deserialize(DeSerializationBuffer<BigEndianess> const & buffer);
+
 private:
 
     std::vector<std::unique_ptr<RecordedEvent>> mEvents;
@@ -7,6 +7,7 @@
 
 #include <GameCore/GameMath.h>
 #include <GameCore/GameRandomEngine.h>
+#include <GameCore/Profiler.h>
 #include <GameCore/Utils.h>
 
 #include <picojson.h>
@@ -23,16 +24,27 @@ float constexpr PositionYVariance = 10.0f;
 
 float constexpr AABBMargin = 4.0f;
 
+float constexpr OceanSurfaceLowWatermark = 3.0f;
+
+float constexpr OceanSurfaceDisturbanceMagnitude = 8.0f; // Magic number
+
 }
 
 Fishes::Fishes(
     FishSpeciesDatabase const & fishSpeciesDatabase,
-    std::shared_ptr<GameEventDispatcher> gameEventDispatcher)
+    std::shared_ptr<GameEventDispatcher> gameEventDispatcher,
+    std::shared_ptr<TaskThreadPool> taskThreadPool)
     : mFishSpeciesDatabase(fishSpeciesDatabase)
     , mGameEventHandler(std::move(gameEventDispatcher))
+    , mTaskThreadPool(std::move(taskThreadPool))
     , mFishShoals()
     , mFishes()
     , mInteractions()
+    , mFishPositionIndex(FishPositionIndexCellSize)
+    , mFishPositionIndexPositions()
+    , mFishPositionIndexMaxHeadOffset(0.0f)
+    , mFishQueryResult()
+    , mPendingFishDynamics()
     , mCurrentFishSizeMultiplier(0.0f)
     , mCurrentFishSpeedAdjustment(0.0f)
     , mCurrentDoFishShoaling(false)
@@ -47,6 +59,8 @@ void Fishes::Update(
     VisibleWorld const & visibleWorld,
     Geometry::AABBSet const & aabbSet)
 {
+    FS_PROFILE_SCOPE("Fishes::Update");
+
     //
     // Update parameters that changed, if any
     //
@@ -400,12 +414,24 @@ void Fishes::UpdateNumberOfFishes(
 
 void Fishes::UpdateInteractions(GameParameters const & gameParameters)
 {
+    FS_PROFILE_SCOPE("Fishes::UpdateInteractions");
+
     auto const now = GameWallClock::GetInstance().Now();
 
+    bool isFishPositionIndexCurrent = false;
+
     for (auto it = mInteractions.begin(); it != mInteractions.end(); /* incremented in loop */)
     {
         if (now >= it->StartTime)
         {
+            // Make sure the fish position index reflects the current positions; fishes
+            // don't move while interactions are enacted, hence once is enough
+            if (it->Area.has_value() && !isFishPositionIndexCurrent)
+            {
+                RebuildFishPositionIndex();
+                isFishPositionIndexCurrent = true;
+            }
+
             //
             // Enact this disturbance
             //
@@ -459,459 +485,583 @@ void Fishes::UpdateDynamics(
     GameParameters const & gameParameters,
     VisibleWorld const & visibleWorld)
 {
-    float constexpr OceanSurfaceLowWatermark = 3.0f;
+    FS_PROFILE_SCOPE("Fishes::UpdateDynamics");
 
     float const outOfWaterVelocityAmplification = (1.0f + std::max(5.0f - mCurrentFishSpeedAdjustment, 0.0f)); // 5 at adj==1
 
     ElementCount const fishCount = static_cast<ElementCount>(mFishes.size());
+
+    mPendingFishDynamics.resize(fishCount);
+
+    //
+    // Run the bulk of the update concurrently
+    //
+
+    mTaskThreadPool->ParallelFor(
+        0,
+        fishCount,
+        32,
+        [&](size_t startFish, size_t endFish)
+        {
+            // Query the water surface level at the fishes in batches
+            static size_t constexpr OceanYBatchSize = 32;
+            float fishXs[OceanYBatchSize];
+            float oceanYs[OceanYBatchSize];
+
+            for (size_t f = startFish; f < endFish; ++f)
+            {
+                size_t const batchIndex = (f - startFish) % OceanYBatchSize;
+                if (batchIndex == 0)
+                {
+                    size_t const batchSize = std::min(OceanYBatchSize, endFish - f);
+                    for (size_t b = 0; b < batchSize; ++b)
+                    {
+                        fishXs[b] = mFishes[f + b].CurrentPosition.x;
+                    }
+
+                    oceanSurface.GetHeightsAt(fishXs, batchSize, oceanYs);
+                }
+
+                mPendingFishDynamics[f] = PendingFishDynamics();
+                mPendingFishDynamics[f].OceanY = oceanYs[batchIndex];
+
+                UpdateFishDynamics(
+                    mFishes[f],
+                    currentSimulationTime,
+                    oceanFloor,
+                    aabbSet,
+                    gameParameters,
+                    outOfWaterVelocityAmplification,
+                    mPendingFishDynamics[f]);
+            }
+        });
+
+    //
+    // Complete the update serially, in fish order, so to consume random
+    // numbers in the same order as a serial update would
+    //
+
     for (ElementIndex f = 0; f < fishCount; ++f)
     {
         Fish & fish = mFishes[f];
-        FishShoal const & fishShoal = mFishShoals[fish.ShoalId];
-        FishSpecies const & fishSpecies = fishShoal.Species;
-
-        ///////////////////////////////////////////////////////////////////
-        // 1) Steer or auto-smooth direction
-        ///////////////////////////////////////////////////////////////////
+        PendingFishDynamics const & pendingFishDynamics = mPendingFishDynamics[f];
 
-        if (fish.CruiseSteeringState.has_value())
+        if (pendingFishDynamics.OceanSurfaceDisplacementX.has_value())
         {
-            //
-            // Cruise steering
-            //
-
-            float const elapsedSteeringDurationFraction = (currentSimulationTime - fish.CruiseSteeringState->SimulationTimeStart) / fish.CruiseSteeringState->SimulationTimeDuration;
+            oceanSurface.DisplaceAt(*pendingFishDynamics.OceanSurfaceDisplacementX, OceanSurfaceDisturbanceMagnitude);
+        }
 
-            // Check whether we should stop steering
-            if (elapsedSteeringDurationFraction >= 1.0f)
+        switch (pendingFishDynamics.Continuation)
+        {
+            case PendingFishDynamics::ContinuationType::None:
             {
-                // Stop steering
+                break;
+            }
 
-                // Change state
-                fish.CruiseSteeringState.reset();
+            case PendingFishDynamics::ContinuationType::WorldBoundaryBounce:
+            {
+                // Find a new target position away
+                fish.TargetPosition = FindNewCruisingTargetPosition(
+                    fish.CurrentPosition,
+                    fish.TargetVelocity.normalise(),
+                    mFishShoals[fish.ShoalId].Species,
+                    visibleWorld);
 
-                // Reach all targets
-                fish.CurrentVelocity = fish.TargetVelocity;
-                fish.CurrentRenderVector = fish.TargetVelocity.normalise();
+                break;
             }
-            else
+
+            case PendingFishDynamics::ContinuationType::TargetReached:
             {
                 //
-                // |      Velocity -> 0        |      Velocity -> Target      |
-                // |  DirY -> 0  |                          |  DirY -> Target |
-                // |        |            DirX -> Target             |         |
+                // Target Reached
                 //
 
-                // Velocity:
-                // - smooth towards zero during first half
-                // - smooth towards target during second half
-                if (elapsedSteeringDurationFraction <= 0.5f)
-                {
-                    fish.CurrentVelocity =
-                        fish.CruiseSteeringState->StartVelocity * (1.0f - SmoothStep(0.0f, 0.5f, elapsedSteeringDurationFraction));
-                }
-                else
-                {
-                    fish.CurrentVelocity =
-                        fish.TargetVelocity * SmoothStep(0.5f, 1.0f, elapsedSteeringDurationFraction);
-                }
+                // Choose new target position
+                fish.TargetPosition = FindNewCruisingTargetPosition(
+                    fish.CurrentPosition,
+                    -fish.CurrentVelocity.normalise(),
+                    mFishShoals[fish.ShoalId].Species,
+                    visibleWorld);
 
-                vec2f const targetRenderVector = fish.TargetVelocity.normalise();
+                // Calculate new target velocity
+                fish.TargetVelocity = MakeCuisingVelocity((fish.TargetPosition - fish.CurrentPosition).normalise(), mFishShoals[fish.ShoalId].Species, fish.PersonalitySeed, gameParameters);
 
-                // RenderVector Y:
-                // - smooth towards zero during an initial interval
-                // - smooth towards target during a second interval
-                if (elapsedSteeringDurationFraction <= 0.5f)
+                // Setup steering, depending on whether we're turning or not
+                if (fish.TargetVelocity.x * fish.CurrentVelocity.x < 0.0f
+                    && !fish.CruiseSteeringState.has_value()) // Not steering already
                 {
-                    fish.CurrentRenderVector.y =
-                        fish.CruiseSteeringState->StartRenderVector.y
-                        * (1.0f - 2.0f * SmoothStep(0.0f, 1.0f, elapsedSteeringDurationFraction));
+                    // Perform a cruise steering
+                    fish.CruiseSteeringState.emplace(
+                        fish.CurrentVelocity,
+                        fish.CurrentRenderVector,
+                        currentSimulationTime,
+                        1.5f); // Slow turn
+
+                    // Remember the time at which we did the last steering
+                    fish.LastSteeringSimulationTime = currentSimulationTime;
                 }
                 else
-                {
-
-                    fish.CurrentRenderVector.y =
-                        targetRenderVector.y
-                        * (1.0f - 2.0f * SmoothStep(0.0f, 1.0f, 1.0f - elapsedSteeringDurationFraction));
+                {    // Converge direction change at this rate
+                    fish.CurrentDirectionSmoothingConvergenceRate = std::max(
+                        0.15f,
+                        fish.CurrentDirectionSmoothingConvergenceRate);
                 }
 
-                // RenderVector X:
-                // - smooth towards target during a central interval (actual turning around),
-                //   without crossing zero
-                float constexpr TimeMargin = 0.15f; // Time of start of the turn
-                float constexpr TurnLimit = 0.05f; // Minimum multiplier of render vector X - not going to zero
-                if (elapsedSteeringDurationFraction <= 0.5f)
-                {
-                    fish.CurrentRenderVector.x =
-                        fish.CruiseSteeringState->StartRenderVector.x
-                        * (1.0f - (1.0f - TurnLimit) * 2.0f * SmoothStep(TimeMargin, 1.0f - TimeMargin, elapsedSteeringDurationFraction));
-                }
-                else
-                {
-                    fish.CurrentRenderVector.x =
-                        targetRenderVector.x
-                        * (1.0f - (1.0f - TurnLimit) * 2.0f * SmoothStep(TimeMargin, 1.0f - TimeMargin, 1.0f - elapsedSteeringDurationFraction));
-                }
+                UpdateFishBoundaryAvoidance(
+                    fish,
+                    pendingFishDynamics.OceanY,
+                    oceanFloor,
+                    aabbSet,
+                    gameParameters);
+
+                break;
             }
         }
+    }
+}
+
+void Fishes::UpdateFishDynamics(
+    Fish & fish,
+    float currentSimulationTime,
+    OceanFloor const & oceanFloor,
+    Geometry::AABBSet const & aabbSet,
+    GameParameters const & gameParameters,
+    float outOfWaterVelocityAmplification,
+    PendingFishDynamics & pendingFishDynamics) const
+{
+    FishSpecies const & fishSpecies = mFishShoals[fish.ShoalId].Species;
+
+    ///////////////////////////////////////////////////////////////////
+    // 1) Steer or auto-smooth direction
+    ///////////////////////////////////////////////////////////////////
+
+    if (fish.CruiseSteeringState.has_value())
+    {
+        //
+        // Cruise steering
+        //
+
+        float const elapsedSteeringDurationFraction = (currentSimulationTime - fish.CruiseSteeringState->SimulationTimeStart) / fish.CruiseSteeringState->SimulationTimeDuration;
+
+        // Check whether we should stop steering
+        if (elapsedSteeringDurationFraction >= 1.0f)
+        {
+            // Stop steering
+
+            // Change state
+            fish.CruiseSteeringState.reset();
+
+            // Reach all targets
+            fish.CurrentVelocity = fish.TargetVelocity;
+            fish.CurrentRenderVector = fish.TargetVelocity.normalise();
+        }
         else
         {
             //
-            // Automated direction smoothing
+            // |      Velocity -> 0        |      Velocity -> Target      |
+            // |  DirY -> 0  |                          |  DirY -> Target |
+            // |        |            DirX -> Target             |         |
             //
 
-            if (!fish.IsInFreefall) // If we're free-falling, current velocity has already converged towards target velocity
+            // Velocity:
+            // - smooth towards zero during first half
+            // - smooth towards target during second half
+            if (elapsedSteeringDurationFraction <= 0.5f)
             {
-                // Smooth velocity towards target + shoaling
-                fish.CurrentVelocity +=
-                    ((fish.TargetVelocity + fish.ShoalingVelocity) - fish.CurrentVelocity) * fish.CurrentDirectionSmoothingConvergenceRate;
+                fish.CurrentVelocity =
+                    fish.CruiseSteeringState->StartVelocity * (1.0f - SmoothStep(0.0f, 0.5f, elapsedSteeringDurationFraction));
+            }
+            else
+            {
+                fish.CurrentVelocity =
+                    fish.TargetVelocity * SmoothStep(0.5f, 1.0f, elapsedSteeringDurationFraction);
+            }
+
+            vec2f const targetRenderVector = fish.TargetVelocity.normalise();
+
+            // RenderVector Y:
+            // - smooth towards zero during an initial interval
+            // - smooth towards target during a second interval
+            if (elapsedSteeringDurationFraction <= 0.5f)
+            {
+                fish.CurrentRenderVector.y =
+                    fish.CruiseSteeringState->StartRenderVector.y
+                    * (1.0f - 2.0f * SmoothStep(0.0f, 1.0f, elapsedSteeringDurationFraction));
+            }
+            else
+            {
+
+                fish.CurrentRenderVector.y =
+                    targetRenderVector.y
+                    * (1.0f - 2.0f * SmoothStep(0.0f, 1.0f, 1.0f - elapsedSteeringDurationFraction));
             }
 
-            // Make RenderVector match current velocity
-            fish.CurrentRenderVector = fish.CurrentVelocity.normalise();
+            // RenderVector X:
+            // - smooth towards target during a central interval (actual turning around),
+            //   without crossing zero
+            float constexpr TimeMargin = 0.15f; // Time of start of the turn
+            float constexpr TurnLimit = 0.05f; // Minimum multiplier of render vector X - not going to zero
+            if (elapsedSteeringDurationFraction <= 0.5f)
+            {
+                fish.CurrentRenderVector.x =
+                    fish.CruiseSteeringState->StartRenderVector.x
+                    * (1.0f - (1.0f - TurnLimit) * 2.0f * SmoothStep(TimeMargin, 1.0f - TimeMargin, elapsedSteeringDurationFraction));
+            }
+            else
+            {
+                fish.CurrentRenderVector.x =
+                    targetRenderVector.x
+                    * (1.0f - (1.0f - TurnLimit) * 2.0f * SmoothStep(TimeMargin, 1.0f - TimeMargin, 1.0f - elapsedSteeringDurationFraction));
+            }
+        }
+    }
+    else
+    {
+        //
+        // Automated direction smoothing
+        //
 
-            // Converge smoothing convergence rate to its ideal value
-            fish.CurrentDirectionSmoothingConvergenceRate =
-                Fish::IdealDirectionSmoothingConvergenceRate
-                + (fish.CurrentDirectionSmoothingConvergenceRate - Fish::IdealDirectionSmoothingConvergenceRate) * 0.98f;
+        if (!fish.IsInFreefall) // If we're free-falling, current velocity has already converged towards target velocity
+        {
+            // Smooth velocity towards target + shoaling
+            fish.CurrentVelocity +=
+                ((fish.TargetVelocity + fish.ShoalingVelocity) - fish.CurrentVelocity) * fish.CurrentDirectionSmoothingConvergenceRate;
         }
 
-        ///////////////////////////////////////////////////////////////////
-        // 2) Update dynamics
-        ///////////////////////////////////////////////////////////////////
+        // Make RenderVector match current velocity
+        fish.CurrentRenderVector = fish.CurrentVelocity.normalise();
 
-        float constexpr OceanSurfaceDisturbanceMagnitude = 8.0f; // Magic number
+        // Converge smoothing convergence rate to its ideal value
+        fish.CurrentDirectionSmoothingConvergenceRate =
+            Fish::IdealDirectionSmoothingConvergenceRate
+            + (fish.CurrentDirectionSmoothingConvergenceRate - Fish::IdealDirectionSmoothingConvergenceRate) * 0.98f;
+    }
 
-        // Get water surface level at this fish
-        float const oceanY = oceanSurface.GetHeightAt(fish.CurrentPosition.x);
+    ///////////////////////////////////////////////////////////////////
+    // 2) Update dynamics
+    ///////////////////////////////////////////////////////////////////
+
+    // Water surface level at this fish, queried before steering - which doesn't move the fish
+    float const oceanY = pendingFishDynamics.OceanY;
+
+    //
+    // Run freefall state machine
+    //
 
+    if (!fish.IsInFreefall
+        && fish.CurrentPosition.y > oceanY)
+    {
         //
-        // Run freefall state machine
+        // Enter freefall
         //
 
-        if (!fish.IsInFreefall
-            && fish.CurrentPosition.y > oceanY)
-        {
-            //
-            // Enter freefall
-            //
+        fish.IsInFreefall = true;
 
-            fish.IsInFreefall = true;
+        // Stop u-turn, in case we were across it
+        fish.CruiseSteeringState.reset();
 
-            // Stop u-turn, in case we were across it
-            fish.CruiseSteeringState.reset();
+        // Create a little disturbance in the ocean surface (later)
+        pendingFishDynamics.OceanSurfaceDisplacementX = fish.CurrentPosition.x;
+    }
+    else if (fish.IsInFreefall
+        && fish.CurrentPosition.y <= oceanY - OceanSurfaceLowWatermark)  // Lower level for re-entry, so that jump is more pronounced
+    {
+        //
+        // Leave freefall (re-entry!)
+        //
 
-            // Create a little disturbance in the ocean surface
-            oceanSurface.DisplaceAt(fish.CurrentPosition.x, OceanSurfaceDisturbanceMagnitude);
-        }
-        else if (fish.IsInFreefall
-            && fish.CurrentPosition.y <= oceanY - OceanSurfaceLowWatermark)  // Lower level for re-entry, so that jump is more pronounced
-        {
-            //
-            // Leave freefall (re-entry!)
-            //
+        fish.IsInFreefall = false;
 
-            fish.IsInFreefall = false;
+        // Drag velocity down
+        float const currentVelocityMagnitude = fish.CurrentVelocity.length();
+        float constexpr MaxVelocityMagnitude = 1.3f; // Magic number
+        fish.TargetVelocity =
+            fish.CurrentVelocity.normalise(currentVelocityMagnitude)
+            * Clamp(currentVelocityMagnitude, 0.0f, MaxVelocityMagnitude);
 
-            // Drag velocity down
-            float const currentVelocityMagnitude = fish.CurrentVelocity.length();
-            float constexpr MaxVelocityMagnitude = 1.3f; // Magic number
-            fish.TargetVelocity =
-                fish.CurrentVelocity.normalise(currentVelocityMagnitude)
-                * Clamp(currentVelocityMagnitude, 0.0f, MaxVelocityMagnitude);
+        // Converge to dragged velocity at this rate, overriding current rate
+        fish.CurrentDirectionSmoothingConvergenceRate = 0.05f;
 
-            // Converge to dragged velocity at this rate, overriding current rate
-            fish.CurrentDirectionSmoothingConvergenceRate = 0.05f;
+        // Note: no need to change render vector, velocity direction has not changed
 
-            // Note: no need to change render vector, velocity direction has not changed
+        // Enter "a bit of" panic mode (overriding current panic);
+        // after exhausting this panic charge, the fish will resume
+        // swimming towards it current target position
+        fish.PanicCharge = 0.03f;
 
-            // Enter "a bit of" panic mode (overriding current panic);
-            // after exhausting this panic charge, the fish will resume
-            // swimming towards it current target position
-            fish.PanicCharge = 0.03f;
+        // Create a little disturbance in the ocean surface (later)
+        pendingFishDynamics.OceanSurfaceDisplacementX = fish.CurrentPosition.x;
+    }
 
-            // Create a little disturbance in the ocean surface
-            oceanSurface.DisplaceAt(fish.CurrentPosition.x, OceanSurfaceDisturbanceMagnitude);
-        }
+    //
+    // Dynamics update
+    //
 
+    if (!fish.IsInFreefall)
+    {
         //
-        // Dynamics update
+        // Swimming
         //
 
-        if (!fish.IsInFreefall)
-        {
-            //
-            // Swimming
-            //
+        float const speedMultiplier = (fish.PanicCharge * 8.5f + 1.0f);
 
-            float const speedMultiplier = (fish.PanicCharge * 8.5f + 1.0f);
+        // Update position: add current velocity
+        fish.CurrentPosition +=
+            fish.CurrentVelocity
+            * GameParameters::SimulationStepTimeDuration<float>
+            * speedMultiplier;
 
-            // Update position: add current velocity
+        // Update tail progress phase: add basal speed
+        fish.CurrentTailProgressPhase += fishSpecies.TailSpeed * speedMultiplier * gameParameters.FishSpeedAdjustment;
+
+        // Update position: superimpose a small sin component, unless we're steering
+        if (!fish.CruiseSteeringState.has_value())
+        {
             fish.CurrentPosition +=
-                fish.CurrentVelocity
-                * GameParameters::SimulationStepTimeDuration<float>
-                * speedMultiplier;
+                fish.CurrentRenderVector
+                * (1.0f + std::sin(2.0f * fish.CurrentTailProgressPhase))
+                * (1.0f + fish.PanicCharge) // Grow incisiveness with panic
+                / 150.0f; // Magic number
+        }
+    }
+    else
+    {
+        //
+        // Free-falling
+        //
 
-            // Update tail progress phase: add basal speed
-            fish.CurrentTailProgressPhase += fishSpecies.TailSpeed * speedMultiplier * gameParameters.FishSpeedAdjustment;
+        // Update velocity with gravity
+        float const newVelocityY = fish.CurrentVelocity.y
+            - 2.0f // Magnification factor
+            * GameParameters::GravityMagnitude
+            * GameParameters::SimulationStepTimeDuration<float>;
 
-            // Update position: superimpose a small sin component, unless we're steering
-            if (!fish.CruiseSteeringState.has_value())
-            {
-                fish.CurrentPosition +=
-                    fish.CurrentRenderVector
-                    * (1.0f + std::sin(2.0f * fish.CurrentTailProgressPhase))
-                    * (1.0f + fish.PanicCharge) // Grow incisiveness with panic
-                    / 150.0f; // Magic number
-            }
-        }
-        else
-        {
-            //
-            // Free-falling
-            //
+        fish.TargetVelocity = vec2f(
+            fish.CurrentVelocity.x,
+            newVelocityY);
 
-            // Update velocity with gravity
-            float const newVelocityY = fish.CurrentVelocity.y
-                - 2.0f // Magnification factor
-                * GameParameters::GravityMagnitude
-                * GameParameters::SimulationStepTimeDuration<float>;
+        fish.CurrentVelocity = fish.TargetVelocity; // Converge immediately
 
-            fish.TargetVelocity = vec2f(
-                fish.CurrentVelocity.x,
-                newVelocityY);
+        // Converge direction at this rate, overriding current convergence rate
+        fish.CurrentDirectionSmoothingConvergenceRate = 0.06f;
 
-            fish.CurrentVelocity = fish.TargetVelocity; // Converge immediately
+        // Update position: add velocity
+        fish.CurrentPosition +=
+            fish.CurrentVelocity
+            * GameParameters::SimulationStepTimeDuration<float>
+            * outOfWaterVelocityAmplification;
 
-            // Converge direction at this rate, overriding current convergence rate
-            fish.CurrentDirectionSmoothingConvergenceRate = 0.06f;
+        // Update tail progress phase: add extra speed (fish flapping its tail)
+        fish.CurrentTailProgressPhase += fishSpecies.TailSpeed * 20.0f;
+    }
 
-            // Update position: add velocity
-            fish.CurrentPosition +=
-                fish.CurrentVelocity
-                * GameParameters::SimulationStepTimeDuration<float>
-                * outOfWaterVelocityAmplification;
+    // Decay panic charge
+    fish.PanicCharge *= 0.985f;
 
-            // Update tail progress phase: add extra speed (fish flapping its tail)
-            fish.CurrentTailProgressPhase += fishSpecies.TailSpeed * 20.0f;
-        }
+    // Decay attraction timer
+    fish.AttractionDecayTimer *= 0.75f;
 
-        // Decay panic charge
-        fish.PanicCharge *= 0.985f;
+    ///////////////////////////////////////////////////////////////////
+    // 3) World boundaries check
+    ///////////////////////////////////////////////////////////////////
 
-        // Decay attraction timer
-        fish.AttractionDecayTimer *= 0.75f;
+    bool hasBouncedAgainstWorldBoundaries = false;
 
-        ///////////////////////////////////////////////////////////////////
-        // 3) World boundaries check
-        ///////////////////////////////////////////////////////////////////
+    if (fish.CurrentPosition.x < -GameParameters::HalfMaxWorldWidth)
+    {
+        // Bounce position
+        fish.CurrentPosition.x = -GameParameters::HalfMaxWorldWidth + (-GameParameters::HalfMaxWorldWidth - fish.CurrentPosition.x);
 
-        bool hasBouncedAgainstWorldBoundaries = false;
+        // Bounce both current and target velocity
+        fish.CurrentVelocity.x = std::abs(fish.CurrentVelocity.x);
+        fish.TargetVelocity.x = std::abs(fish.TargetVelocity.x);
 
-        if (fish.CurrentPosition.x < -GameParameters::HalfMaxWorldWidth)
-        {
-            // Bounce position
-            fish.CurrentPosition.x = -GameParameters::HalfMaxWorldWidth + (-GameParameters::HalfMaxWorldWidth - fish.CurrentPosition.x);
+        // Adjust other fish properties
+        hasBouncedAgainstWorldBoundaries = true;
+    }
+    else if (fish.CurrentPosition.x > GameParameters::HalfMaxWorldWidth)
+    {
+        // Bounce position
+        fish.CurrentPosition.x = GameParameters::HalfMaxWorldWidth - (fish.CurrentPosition.x - GameParameters::HalfMaxWorldWidth);
 
-            // Bounce both current and target velocity
-            fish.CurrentVelocity.x = std::abs(fish.CurrentVelocity.x);
-            fish.TargetVelocity.x = std::abs(fish.TargetVelocity.x);
+        // Bounce both current and target velocity
+        fish.CurrentVelocity.x = -std::abs(fish.CurrentVelocity.x);
+        fish.TargetVelocity.x = -std::abs(fish.TargetVelocity.x);
 
-            // Adjust other fish properties
-            hasBouncedAgainstWorldBoundaries = true;
-        }
-        else if (fish.CurrentPosition.x > GameParameters::HalfMaxWorldWidth)
-        {
-            // Bounce position
-            fish.CurrentPosition.x = GameParameters::HalfMaxWorldWidth - (fish.CurrentPosition.x - GameParameters::HalfMaxWorldWidth);
+        // Adjust other fish properties
+        hasBouncedAgainstWorldBoundaries = true;
+    }
 
-            // Bounce both current and target velocity
-            fish.CurrentVelocity.x = -std::abs(fish.CurrentVelocity.x);
-            fish.TargetVelocity.x = -std::abs(fish.TargetVelocity.x);
+    if (hasBouncedAgainstWorldBoundaries)
+    {
+        // Stop cruising, in case we were cruising
+        fish.CruiseSteeringState.reset();
 
-            // Adjust other fish properties
-            hasBouncedAgainstWorldBoundaries = true;
-        }
+        // Find a new target position away (later)
+        pendingFishDynamics.Continuation = PendingFishDynamics::ContinuationType::WorldBoundaryBounce;
 
-        if (hasBouncedAgainstWorldBoundaries)
-        {
-            // Find a new target position away
-            fish.TargetPosition = FindNewCruisingTargetPosition(
-                fish.CurrentPosition,
-                fish.TargetVelocity.normalise(),
-                fishSpecies,
-                visibleWorld);
+        // Skip everything else
+        return;
+    }
 
-            // Stop cruising, in case we were cruising
-            fish.CruiseSteeringState.reset();
+    assert(fish.CurrentPosition.x >= -GameParameters::HalfMaxWorldWidth
+        && fish.CurrentPosition.x <= GameParameters::HalfMaxWorldWidth);
 
-            // Skip everything else
-            continue;
-        }
+    // Stop now if we're free-falling
+    if (fish.IsInFreefall)
+    {
+        // Cut short state machine now, this fish can't swim
+        return;
+    }
 
-        assert(fish.CurrentPosition.x >= -GameParameters::HalfMaxWorldWidth
-            && fish.CurrentPosition.x <= GameParameters::HalfMaxWorldWidth);
+    ///////////////////////////////////////////////////////////////////
+    // 4) Check state machine transitions
+    ///////////////////////////////////////////////////////////////////
 
-        // Stop now if we're free-falling
-        if (fish.IsInFreefall)
-        {
-            // Cut short state machine now, this fish can't swim
-            continue;
-        }
+    // Check whether this fish has reached its target
+    if (std::abs(fish.CurrentPosition.x - fish.TargetPosition.x) < 7.0f
+        && fish.PanicCharge == 0.0f) // Not in panic
+    {
+        //
+        // Target Reached
+        //
 
-        ///////////////////////////////////////////////////////////////////
-        // 4) Check state machine transitions
-        ///////////////////////////////////////////////////////////////////
+        // Choose new target position and continue from there (later)
+        pendingFishDynamics.Continuation = PendingFishDynamics::ContinuationType::TargetReached;
 
-        // Check whether this fish has reached its target
-        if (std::abs(fish.CurrentPosition.x - fish.TargetPosition.x) < 7.0f
-            && fish.PanicCharge == 0.0f) // Not in panic
-        {
-            //
-            // Target Reached
-            //
+        return;
+    }
+    // Check whether this fish has reached the end of panic mode
+    else if (fish.PanicCharge != 0.0f && fish.PanicCharge < 0.02f) // Reached end of panic
+    {
+        //
+        // End of Panic
+        //
 
-            // Choose new target position
-            fish.TargetPosition = FindNewCruisingTargetPosition(
-                fish.CurrentPosition,
-                -fish.CurrentVelocity.normalise(),
-                fishSpecies,
-                visibleWorld);
+        fish.PanicCharge = 0.0f;
 
-            // Calculate new target velocity
-            fish.TargetVelocity = MakeCuisingVelocity((fish.TargetPosition - fish.CurrentPosition).normalise(), fishSpecies, fish.PersonalitySeed, gameParameters);
+        // Continue to current target
 
-            // Setup steering, depending on whether we're turning or not
-            if (fish.TargetVelocity.x * fish.CurrentVelocity.x < 0.0f
-                && !fish.CruiseSteeringState.has_value()) // Not steering already
-            {
-                // Perform a cruise steering
-                fish.CruiseSteeringState.emplace(
-                    fish.CurrentVelocity,
-                    fish.CurrentRenderVector,
-                    currentSimulationTime,
-                    1.5f); // Slow turn
+        // Calculate new target velocity
+        fish.TargetVelocity = MakeCuisingVelocity((fish.TargetPosition - fish.CurrentPosition).normalise(), fishSpecies, fish.PersonalitySeed, gameParameters);
 
-                // Remember the time at which we did the last steering
-                fish.LastSteeringSimulationTime = currentSimulationTime;
-            }
-            else
-            {    // Converge direction change at this rate
-                fish.CurrentDirectionSmoothingConvergenceRate = std::max(
-                    0.15f,
-                    fish.CurrentDirectionSmoothingConvergenceRate);
-            }
-        }
-        // Check whether this fish has reached the end of panic mode
-        else if (fish.PanicCharge != 0.0f && fish.PanicCharge < 0.02f) // Reached end of panic
+        // Setup steering, depending on whether we're turning or not
+        if (fish.TargetVelocity.x * fish.CurrentVelocity.x < 0.0f
+            && !fish.CruiseSteeringState.has_value()) // Not steering already
         {
-            //
-            // End of Panic
-            //
+            // Perform a cruise steering
+            fish.CruiseSteeringState.emplace(
+                fish.CurrentVelocity,
+                fish.CurrentRenderVector,
+                currentSimulationTime,
+                1.5f); // Slow turn
+
+            // Remember the time at which we did the last steering
+            fish.LastSteeringSimulationTime = currentSimulationTime;
+        }
+        else
+        {    // Converge direction change at this rate
+            fish.CurrentDirectionSmoothingConvergenceRate = std::max(
+                0.08f,
+                fish.CurrentDirectionSmoothingConvergenceRate);
+        }
+    }
 
-            fish.PanicCharge = 0.0f;
+    UpdateFishBoundaryAvoidance(
+        fish,
+        oceanY,
+        oceanFloor,
+        aabbSet,
+        gameParameters);
+}
 
-            // Continue to current target
+void Fishes::UpdateFishBoundaryAvoidance(
+    Fish & fish,
+    float oceanY,
+    OceanFloor const & oceanFloor,
+    Geometry::AABBSet const & aabbSet,
+    GameParameters const & gameParameters) const
+{
+    FishShoal const & fishShoal = mFishShoals[fish.ShoalId];
+    FishSpecies const & fishSpecies = fishShoal.Species;
 
-            // Calculate new target velocity
-            fish.TargetVelocity = MakeCuisingVelocity((fish.TargetPosition - fish.CurrentPosition).normalise(), fishSpecies, fish.PersonalitySeed, gameParameters);
+    ///////////////////////////////////////////////////////////////////
+    // 5) Check ocean boundaries
+    ///////////////////////////////////////////////////////////////////
 
-            // Setup steering, depending on whether we're turning or not
-            if (fish.TargetVelocity.x * fish.CurrentVelocity.x < 0.0f
-                && !fish.CruiseSteeringState.has_value()) // Not steering already
-            {
-                // Perform a cruise steering
-                fish.CruiseSteeringState.emplace(
-                    fish.CurrentVelocity,
-                    fish.CurrentRenderVector,
-                    currentSimulationTime,
-                    1.5f); // Slow turn
+    // Calculate position of head
+    vec2f const fishHeadPosition =
+        fish.CurrentPosition
+        + fish.CurrentRenderVector * fish.HeadOffset;
 
-                // Remember the time at which we did the last steering
-                fish.LastSteeringSimulationTime = currentSimulationTime;
-            }
-            else
-            {    // Converge direction change at this rate
-                fish.CurrentDirectionSmoothingConvergenceRate = std::max(
-                    0.08f,
-                    fish.CurrentDirectionSmoothingConvergenceRate);
-            }
-        }
+    // Calculate depth of fish head
+    float const fishHeadDepth = oceanY - fishHeadPosition.y;
 
-        ///////////////////////////////////////////////////////////////////
-        // 5) Check ocean boundaries
-        ///////////////////////////////////////////////////////////////////
+    // Check whether we're too close to the water surface (idealized as being horizontal) - but only if fish is not in too much panic
+    if (fishHeadDepth < 2.0f + OceanSurfaceLowWatermark
+        && fish.PanicCharge <= 0.3f // Not too much panic
+        && fish.TargetVelocity.y >= 0.0f) // Bounce away only if we're really going into it
+    {
+        //
+        // OceanSurface Bounce
+        //
 
-        // Calculate position of head
-        vec2f const fishHeadPosition =
-            fish.CurrentPosition
-            + fish.CurrentRenderVector * fish.HeadOffset;
+        // Bounce direction, opposite of target
+        vec2f const bounceDirection = vec2f(fish.TargetVelocity.x, -fish.TargetVelocity.y).normalise();
 
-        // Calculate depth of fish head
-        float const fishHeadDepth = oceanY - fishHeadPosition.y;
+        // Calculate new target velocity - along bounce direction
+        fish.TargetVelocity = MakeCuisingVelocity(bounceDirection, fishSpecies, fish.PersonalitySeed, gameParameters);
 
-        // Check whether we're too close to the water surface (idealized as being horizontal) - but only if fish is not in too much panic
-        if (fishHeadDepth < 2.0f + OceanSurfaceLowWatermark
-            && fish.PanicCharge <= 0.3f // Not too much panic
-            && fish.TargetVelocity.y >= 0.0f) // Bounce away only if we're really going into it
-        {
-            //
-            // OceanSurface Bounce
-            //
+        // Converge direction change at this rate
+        fish.CurrentDirectionSmoothingConvergenceRate = std::max(
+            0.05f * (1.0f + fish.PanicCharge),
+            fish.CurrentDirectionSmoothingConvergenceRate);
+    }
 
-            // Bounce direction, opposite of target
-            vec2f const bounceDirection = vec2f(fish.TargetVelocity.x, -fish.TargetVelocity.y).normalise();
+    // Check ocean floor collision
+    float const clampedX = Clamp(fishHeadPosition.x, -GameParameters::HalfMaxWorldWidth, GameParameters::HalfMaxWorldWidth);
+    if (auto const [isUnderneathFloor, oceanFloorHeight, oceanFloorIndexI] = oceanFloor.GetHeightIfUnderneathAt(clampedX, fishHeadPosition.y);
+        isUnderneathFloor // fishHeadPosition.y < oceanFloorHeight
+        && fishHeadDepth > fishShoal.MaxWorldDimension * 2.0f)
+    {
+        //
+        // Ocean floor collision
+        //
 
-            // Calculate new target velocity - along bounce direction
-            fish.TargetVelocity = MakeCuisingVelocity(bounceDirection, fishSpecies, fish.PersonalitySeed, gameParameters);
+        // Calculate sea floor normal (positive points up, out)
+        vec2f const seaFloorNormal = oceanFloor.GetNormalAt(oceanFloorIndexI);
 
-            // Converge direction change at this rate
-            fish.CurrentDirectionSmoothingConvergenceRate = std::max(
-                0.05f * (1.0f + fish.PanicCharge),
-                fish.CurrentDirectionSmoothingConvergenceRate);
-        }
+        // Calculate the component of the fish's target velocity along the normal,
+        // i.e. towards the outside of the floor...
+        float const targetVelocityAlongNormal = fish.TargetVelocity.dot(seaFloorNormal);
 
-        // Check ocean floor collision
-        float const clampedX = Clamp(fishHeadPosition.x, -GameParameters::HalfMaxWorldWidth, GameParameters::HalfMaxWorldWidth);
-        if (auto const [isUnderneathFloor, oceanFloorHeight, oceanFloorIndexI] = oceanFloor.GetHeightIfUnderneathAt(clampedX, fishHeadPosition.y);
-            isUnderneathFloor // fishHeadPosition.y < oceanFloorHeight
-            && fishHeadDepth > fishShoal.MaxWorldDimension * 2.0f)
+        // ...if positive, it will soon be going already outside of the floor, hence we leave it as-is
+        if (targetVelocityAlongNormal <= 0.0f)
         {
-            //
-            // Ocean floor collision
-            //
-
-            // Calculate sea floor normal (positive points up, out)
-            vec2f const seaFloorNormal = oceanFloor.GetNormalAt(oceanFloorIndexI);
-
-            // Calculate the component of the fish's target velocity along the normal,
-            // i.e. towards the outside of the floor...
-            float const targetVelocityAlongNormal = fish.TargetVelocity.dot(seaFloorNormal);
-
-            // ...if positive, it will soon be going already outside of the floor, hence we leave it as-is
-            if (targetVelocityAlongNormal <= 0.0f)
-            {
-                // Set target velocity to reflection of fish's target velocity around normal:
-                // R = V − 2(V⋅N^)N^
-                fish.TargetVelocity =
-                    fish.TargetVelocity
-                    - seaFloorNormal * 2.0f * targetVelocityAlongNormal;
+            // Set target velocity to reflection of fish's target velocity around normal:
+            // R = V − 2(V⋅N^)N^
+            fish.TargetVelocity =
+                fish.TargetVelocity
+                - seaFloorNormal * 2.0f * targetVelocityAlongNormal;
 
-                // Converge direction change at this rate
-                fish.CurrentDirectionSmoothingConvergenceRate = std::max(
-                    0.15f,
-                    fish.CurrentDirectionSmoothingConvergenceRate);
-            }
+            // Converge direction change at this rate
+            fish.CurrentDirectionSmoothingConvergenceRate = std::max(
+                0.15f,
+                fish.CurrentDirectionSmoothingConvergenceRate);
         }
+    }
 
-        ///////////////////////////////////////////////////////////////////
-        // 6) Check AABB boundaries
-        ///////////////////////////////////////////////////////////////////
+    ///////////////////////////////////////////////////////////////////
+    // 6) Check AABB boundaries
+    ///////////////////////////////////////////////////////////////////
 
-        //if (fish.PanicCharge <= 0.3f) // Only if we're not in panic
-        if (fish.PanicCharge <= 0.1f) // Only if we're not in panic
-        {
-            for (auto const & aabb : aabbSet.GetItems())
+    //if (fish.PanicCharge <= 0.3f) // Only if we're not in panic
+    if (fish.PanicCharge <= 0.1f) // Only if we're not in panic
+    {
+        aabbSet.ForEachContaining(
+            fishHeadPosition,
+            AABBMargin,
+            [&](Geometry::AABB const & aabb)
             {
                 float const lMargin = fishHeadPosition.x - (aabb.BottomLeft.x - AABBMargin);
                 float const rMargin = (aabb.TopRight.x + AABBMargin) - fishHeadPosition.x;
@@ -958,8 +1108,7 @@ void Fishes::UpdateDynamics(
                     // Stop steering, if we're steering
                     fish.CruiseSteeringState.reset();
                 }
-            }
-        }
+            });
     }
 }
 
@@ -968,6 +1117,11 @@ void Fishes::UpdateShoaling(
     GameParameters const & gameParameters,
     VisibleWorld const & visibleWorld)
 {
+    FS_PROFILE_SCOPE("Fishes::UpdateShoaling");
+
+    // Fishes don't move while shoaling, hence we may index them once
+    RebuildFishPositionIndex();
+
     // Visit all shoals
     for (auto const & fishShoal : mFishShoals)
     {
@@ -1005,8 +1159,21 @@ void Fishes::UpdateShoaling(
                     ElementIndex furthestFishIndex = NoneElementIndex; // Furthest neighbour among those that are further from fish than spacing
                     float furthestFishDistance = std::numeric_limits<float>::lowest();
 
-                    for (ElementIndex n = fishShoal.StartFishIndex; n < endFishIndex; ++n)
+                    mFishPositionIndex.Query(
+                        Geometry::AABB(
+                            fish.CurrentPosition.x - fishShoalRadius,
+                            fish.CurrentPosition.x + fishShoalRadius,
+                            fish.CurrentPosition.y + fishShoalRadius,
+                            fish.CurrentPosition.y - fishShoalRadius),
+                        mFishQueryResult);
+
+                    // Candidates are sorted, hence we only need to visit those in this shoal's range
+                    for (auto candidateIt = std::lower_bound(mFishQueryResult.cbegin(), mFishQueryResult.cend(), fishShoal.StartFishIndex);
+                        candidateIt != mFishQueryResult.cend() && *candidateIt < endFishIndex;
+                        ++candidateIt)
                     {
+                        ElementIndex const n = *candidateIt;
+
                         assert(mFishes[n].ShoalId == fish.ShoalId);
                         if (n != f) // Not same fish
                         {
@@ -1170,8 +1337,10 @@ void Fishes::EnactDisturbance(
         worldRadius
         * (gameParameters.IsUltraViolentMode ? 5.0f : 1.0f);
 
-    for (auto & fish : mFishes)
+    for (auto const f : QueryFishesWithHeadInRadius(worldCoordinates, effectiveRadius))
     {
+        Fish & fish = mFishes[f];
+
         if (!fish.IsInFreefall)
         {
             FishSpecies const & species = mFishShoals[fish.ShoalId].Species;
@@ -1238,8 +1407,10 @@ void Fishes::EnactAttraction(
         worldRadius
         * (gameParameters.IsUltraViolentMode ? 5.0f : 1.0f);
 
-    for (auto & fish : mFishes)
+    for (auto const f : QueryFishesWithHeadInRadius(worldCoordinates, effectiveRadius))
     {
+        Fish & fish = mFishes[f];
+
         if (!fish.IsInFreefall
             && fish.PanicCharge < 0.65f) // Don't attract fish in much panic
         {
@@ -1338,6 +1509,45 @@ void Fishes::EnactWidespreadPanic(GameParameters const & gameParameters)
     }
 }
 
+void Fishes::RebuildFishPositionIndex()
+{
+    mFishPositionIndexPositions.clear();
+    mFishPositionIndexPositions.reserve(mFishes.size());
+
+    mFishPositionIndexMaxHeadOffset = 0.0f;
+
+    for (auto const & fish : mFishes)
+    {
+        mFishPositionIndexPositions.push_back(fish.CurrentPosition);
+
+        mFishPositionIndexMaxHeadOffset = std::max(
+            mFishPositionIndexMaxHeadOffset,
+            std::abs(fish.HeadOffset));
+    }
+
+    mFishPositionIndex.Rebuild(
+        mFishPositionIndexPositions.data(),
+        static_cast<ElementCount>(mFishPositionIndexPositions.size()));
+}
+
+std::vector<ElementIndex> const & Fishes::QueryFishesWithHeadInRadius(
+    vec2f const & position,
+    float radius)
+{
+    // Heads are at most at the max head offset from the indexed positions
+    float const searchRadius = radius + mFishPositionIndexMaxHeadOffset;
+
+    mFishPositionIndex.Query(
+        Geometry::AABB(
+            position.x - searchRadius,
+            position.x + searchRadius,
+            position.y + searchRadius,
+            position.y - searchRadius),
+        mFishQueryResult);
+
+    return mFishQueryResult;
+}
+
 vec2f Fishes::ChoosePosition(
     vec2f const & averagePosition,
     float xVariance,
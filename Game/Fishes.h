@@ -15,9 +15,12 @@
 #include <GameCore/AABBSet.h>
 #include <GameCore/GameTypes.h>
 #include <GameCore/GameWallClock.h>
+#include <GameCore/SpatialHashGrid.h>
+#include <GameCore/TaskThreadPool.h>
 #include <GameCore/Vectors.h>
 
 #include <chrono>
+#include <cstdint>
 #include <memory>
 #include <optional>
 #include <vector>
@@ -32,7 +35,8 @@ public:
 
     explicit Fishes(
         FishSpeciesDatabase const & fishSpeciesDatabase,
-        std::shared_ptr<GameEventDispatcher> gameEventDispatcher);
+        std::shared_ptr<GameEventDispatcher> gameEventDispatcher,
+        std::shared_ptr<TaskThreadPool> taskThreadPool);
 
     void Update(
         float currentSimulationTime,
@@ -218,6 +222,31 @@ private:
         {}
     };
 
+    /*
+     * The outcome of the concurrent part of the dynamics update of a fish, which
+     * is completed serially - in fish order - as it involves state shared among
+     * all fishes (random engine, ocean surface).
+     */
+    struct PendingFishDynamics
+    {
+        enum class ContinuationType : std::uint8_t
+        {
+            None,
+            WorldBoundaryBounce, // Needs a new target position, after having bounced against the world boundaries
+            TargetReached // Needs a new target position, followed by the rest of the update
+        };
+
+        ContinuationType Continuation;
+        float OceanY; // Water surface level at the fish, at the beginning of the update; an input
+        std::optional<float> OceanSurfaceDisplacementX;
+
+        PendingFishDynamics()
+            : Continuation(ContinuationType::None)
+            , OceanY(0.0f)
+            , OceanSurfaceDisplacementX()
+        {}
+    };
+
 private:
 
     void UpdateNumberOfFishes(
@@ -238,6 +267,25 @@ private:
         GameParameters const & gameParameters,
         VisibleWorld const & visibleWorld);
 
+    // Only touches the specified fish, hence may run concurrently on different fishes;
+    // expects the water surface level at the fish in the pending dynamics
+    void UpdateFishDynamics(
+        Fish & fish,
+        float currentSimulationTime,
+        OceanFloor const & oceanFloor,
+        Geometry::AABBSet const & aabbSet,
+        GameParameters const & gameParameters,
+        float outOfWaterVelocityAmplification,
+        PendingFishDynamics & pendingFishDynamics) const;
+
+    // Only touches the specified fish, hence may run concurrently on different fishes
+    void UpdateFishBoundaryAvoidance(
+        Fish & fish,
+        float oceanY,
+        OceanFloor const & oceanFloor,
+        Geometry::AABBSet const & aabbSet,
+        GameParameters const & gameParameters) const;
+
     void UpdateShoaling(
         float currentSimulationTime,
         GameParameters const & gameParameters,
@@ -255,6 +303,14 @@ private:
 
     void EnactWidespreadPanic(GameParameters const & gameParameters);
 
+    void RebuildFishPositionIndex();
+
+    // Returns the indices of the fishes whose heads might be within the specified
+    // radius of the specified position, in ascending order
+    std::vector<ElementIndex> const & QueryFishesWithHeadInRadius(
+        vec2f const & position,
+        float radius);
+
     inline static vec2f ChoosePosition(
         vec2f const & averagePosition,
         float xVariance,
@@ -283,6 +339,7 @@ private:
 
     FishSpeciesDatabase const & mFishSpeciesDatabase;
     std::shared_ptr<GameEventDispatcher> mGameEventHandler;
+    std::shared_ptr<TaskThreadPool> mTaskThreadPool;
 
     // Shoals never move around in this vector
     std::vector<FishShoal> mFishShoals;
@@ -293,6 +350,16 @@ private:
     // Delayed interactions
     std::vector<Interaction> mInteractions;
 
+    // Spatial index of fish positions, rebuilt whenever neighbors need to be looked up
+    static float constexpr FishPositionIndexCellSize = 8.0f;
+    SpatialHashGrid mFishPositionIndex;
+    std::vector<vec2f> mFishPositionIndexPositions; // Snapshot of fish positions at last rebuild
+    float mFishPositionIndexMaxHeadOffset; // Max distance of a head from its fish position, at last rebuild
+    std::vector<ElementIndex> mFishQueryResult;
+
+    // Pending dynamics, one for each fish
+    std::vector<PendingFishDynamics> mPendingFishDynamics;
+
     // Parameters that the calculated values are current with
     float mCurrentFishSizeMultiplier;
     float mCurrentFishSpeedAdjustment;
@@ -75,6 +75,43 @@ void Frontiers::AddFrontier(
     }
 }
 
+void Frontiers::AddFragment(
+    Frontiers const & other,
+    ShipFragmentMap const & fragmentMap,
+    Springs const & springs)
+{
+    assert(mFrontierIds.empty());
+
+    for (auto const otherFrontierId : other.GetFrontierIds())
+    {
+        auto const & otherFrontier = other.GetFrontier(otherFrontierId);
+
+        // Frontier edges are live springs along a closed curve, hence a frontier
+        // is either entirely in the fragment or entirely out of it
+        if (!fragmentMap.SpringIndices.Contains(otherFrontier.StartingEdgeIndex))
+            continue;
+
+        std::vector<ElementIndex> edgeIndices;
+        edgeIndices.reserve(otherFrontier.Size);
+
+        ElementIndex otherEdgeIndex = otherFrontier.StartingEdgeIndex;
+        for (ElementCount e = 0; e < otherFrontier.Size; ++e)
+        {
+            assert(fragmentMap.SpringIndices.Contains(otherEdgeIndex));
+            edgeIndices.push_back(fragmentMap.SpringIndices.OldToNew[otherEdgeIndex]);
+
+            otherEdgeIndex = other.mFrontierEdges[otherEdgeIndex].NextEdgeIndex;
+        }
+
+        assert(otherEdgeIndex == otherFrontier.StartingEdgeIndex);
+
+        AddFrontier(
+            otherFrontier.Type,
+            std::move(edgeIndices),
+            springs);
+    }
+}
+
 void Frontiers::HandleTriangleDestroy(
     ElementIndex triangleElementIndex,
     Points const & points,
@@ -86,6 +123,11 @@ void Frontiers::HandleTriangleDestroy(
     auto const edgeBIndex = triangles.GetSubSpringBIndex(triangleElementIndex);
     auto const edgeCIndex = triangles.GetSubSpringCIndex(triangleElementIndex);
 
+    // The frontiers that are about to change: any frontier changed by this
+    // operation has one of the triangle's edges, either before or after it -
+    // or is a brand new one
+    MarkFrontiersOfEdgesDirtyForRendering(edgeAIndex, edgeBIndex, edgeCIndex);
+
     // Springs are already consistent with the removal of this triangle
     assert(springs.GetSuperTriangles(edgeAIndex).size() == 0
         || (springs.GetSuperTriangles(edgeAIndex).size() == 1 && springs.GetSuperTriangles(edgeAIndex)[0] != triangleElementIndex));
@@ -292,6 +334,9 @@ void Frontiers::HandleTriangleDestroy(
 
     ////////////////////////////////////////
 
+    // The frontiers that have changed
+    MarkFrontiersOfEdgesDirtyForRendering(edgeAIndex, edgeBIndex, edgeCIndex);
+
     // Remember we are now dirty - frontiers need
     // to be re-uploaded
     mIsDirtyForRendering = true;
@@ -308,6 +353,11 @@ void Frontiers::HandleTriangleRestore(
     auto const edgeBIndex = triangles.GetSubSpringBIndex(triangleElementIndex);
     auto const edgeCIndex = triangles.GetSubSpringCIndex(triangleElementIndex);
 
+    // The frontiers that are about to change: any frontier changed by this
+    // operation has one of the triangle's edges, either before or after it -
+    // or is a brand new one
+    MarkFrontiersOfEdgesDirtyForRendering(edgeAIndex, edgeBIndex, edgeCIndex);
+
     // Count edges with frontiers
     size_t edgesWithFrontierCount = 0;
     ElementIndex lastEdgeWithFrontier = NoneElementIndex;
@@ -585,11 +635,81 @@ void Frontiers::HandleTriangleRestore(
 
     ////////////////////////////////////////
 
+    // The frontiers that have changed
+    MarkFrontiersOfEdgesDirtyForRendering(edgeAIndex, edgeBIndex, edgeCIndex);
+
     // Remember we are now dirty - frontiers need
     // to be re-uploaded
     mIsDirtyForRendering = true;
 }
 
+void Frontiers::RemapEdgeIndices(
+    std::vector<ElementIndex> const & newToOldSpringIndices,
+    std::vector<ElementIndex> const & oldToNewSpringIndices)
+{
+    assert(newToOldSpringIndices.size() == mEdgeCount);
+
+    // Move edges
+    mEdges.permute(newToOldSpringIndices);
+    mFrontierEdges.permute(newToOldSpringIndices);
+
+    // Remap links between edges
+    for (size_t e = 0; e < mEdgeCount; ++e)
+    {
+        auto & frontierEdge = mFrontierEdges[e];
+
+        if (frontierEdge.NextEdgeIndex != NoneElementIndex)
+            frontierEdge.NextEdgeIndex = oldToNewSpringIndices[frontierEdge.NextEdgeIndex];
+
+        if (frontierEdge.PrevEdgeIndex != NoneElementIndex)
+            frontierEdge.PrevEdgeIndex = oldToNewSpringIndices[frontierEdge.PrevEdgeIndex];
+    }
+
+    for (auto & frontier : mFrontiers)
+    {
+        if (frontier.has_value() && frontier->StartingEdgeIndex != NoneElementIndex)
+        {
+            frontier->StartingEdgeIndex = oldToNewSpringIndices[frontier->StartingEdgeIndex];
+        }
+    }
+}
+
+static std::uint32_t constexpr StateSectionTag = 0x53544E46; // FNTS
+
+void Frontiers::SaveState(StateSnapshotWriter & writer) const
+{
+    writer.BeginSection(StateSectionTag);
+
+    ArchiveState(*this, writer);
+}
+
+void Frontiers::LoadState(StateSnapshotReader & reader)
+{
+    reader.BeginSection(StateSectionTag);
+
+    ArchiveState(*this, reader);
+
+    // All frontiers need to be re-uploaded
+    mIsDirtyForRendering = true;
+}
+
+template<typename TSelf, typename TArchive>
+void Frontiers::ArchiveState(
+    TSelf & self,
+    TArchive & archive)
+{
+    archive.Archive(self.mEdges);
+    archive.Archive(self.mFrontierEdges);
+    archive.Archive(self.mFrontiers);
+    archive.Archive(self.mFrontierIds);
+    archive.Archive(self.mFrontierIdPositions);
+    archive.Archive(self.mFreeFrontierIds);
+    archive.Archive(self.mIsFrontierDirtyForRendering);
+    archive.Archive(self.mDirtyForRenderingFrontierIds);
+    archive.Archive(self.mPointColors);
+    archive.Archive(self.mCurrentVisitSequenceNumber);
+}
+
 void Frontiers::Upload(
     ShipId shipId,
     Render::RenderContext & renderContext)
@@ -602,10 +722,18 @@ void Frontiers::Upload(
         //
 
         // Generate point colors
-        RegeneratePointColors();
+        DirtyRange const pointColorsDirtyRange = RegeneratePointColors();
 
-        // Upload point colors
-        renderContext.UploadShipPointFrontierColorsAsync(shipId, mPointColors.data());
+        // Upload point colors - only the range spanned by frontier points, as the
+        // colors of all other points are not rendered
+        if (!pointColorsDirtyRange.IsEmpty())
+        {
+            renderContext.UploadShipPointFrontierColorsAsync(
+                shipId,
+                mPointColorsUploadSnapshotAllocator.AllocateSnapshot(mPointColors.data(), pointColorsDirtyRange.GetStart(), pointColorsDirtyRange.GetSize()),
+                pointColorsDirtyRange.GetStart(),
+                pointColorsDirtyRange.GetSize());
+        }
 
         //
         // Upload frontier point indices
@@ -663,17 +791,24 @@ FrontierId Frontiers::CreateNewFrontier(
     ElementIndex startingEdgeIndex,
     ElementCount size)
 {
-    // Check if we may find an unused slot
+    // Re-use an unused slot, if we have one
     FrontierId newFrontierId;
-    for (newFrontierId = 0; newFrontierId < mFrontiers.size() && mFrontiers[newFrontierId].has_value(); ++newFrontierId);
-
-    if (newFrontierId == mFrontiers.size())
+    if (!mFreeFrontierIds.empty())
+    {
+        newFrontierId = mFreeFrontierIds.back();
+        mFreeFrontierIds.pop_back();
+    }
+    else
     {
         // Create new slot
+        newFrontierId = static_cast<FrontierId>(mFrontiers.size());
         mFrontiers.emplace_back();
+        mFrontierIdPositions.emplace_back();
+        mIsFrontierDirtyForRendering.emplace_back(false);
     }
 
     assert(newFrontierId < mFrontiers.size());
+    assert(!mFrontiers[newFrontierId].has_value());
 
     mFrontiers[newFrontierId].emplace(
         type,
@@ -681,8 +816,11 @@ FrontierId Frontiers::CreateNewFrontier(
         size);
 
     // Add to frontier indices
+    mFrontierIdPositions[newFrontierId] = mFrontierIds.size();
     mFrontierIds.emplace_back(newFrontierId);
 
+    MarkFrontierDirtyForRendering(newFrontierId);
+
     return newFrontierId;
 }
 
@@ -694,16 +832,22 @@ void Frontiers::DestroyFrontier(
 
     mFrontiers[frontierId].reset();
 
-    // Remove from frontier indices
+    //
+    // Remove from frontier indices, moving the last one into its position - so that
+    // destroying a frontier does not cost more when there are many of them, as it
+    // happens when large regions are shattered
+    //
 
-    auto const indexIt = std::find(
-        mFrontierIds.cbegin(),
-        mFrontierIds.cend(),
-        frontierId);
+    size_t const position = mFrontierIdPositions[frontierId];
+    assert(position < mFrontierIds.size() && mFrontierIds[position] == frontierId);
 
-    assert(indexIt != mFrontierIds.cend());
+    FrontierId const lastFrontierId = mFrontierIds.back();
+    mFrontierIds[position] = lastFrontierId;
+    mFrontierIdPositions[lastFrontierId] = position;
+    mFrontierIds.pop_back();
 
-    mFrontierIds.erase(indexIt);
+    // Make slot available
+    mFreeFrontierIds.emplace_back(frontierId);
 }
 
 FrontierId Frontiers::SplitIntoNewFrontier(
@@ -1542,7 +1686,7 @@ bool Frontiers::IsCounterClockwiseFrontier(
     return totalArea < 0.0f;
 }
 
-void Frontiers::RegeneratePointColors()
+DirtyRange Frontiers::RegeneratePointColors()
 {
     static std::array<rgbColor, 4> const ExternalColors
     {
@@ -1561,11 +1705,22 @@ void Frontiers::RegeneratePointColors()
 
     };
 
-    size_t externalUsed = 0;
-    size_t internalUsed = 0;
+    DirtyRange dirtyRange;
 
-    for (auto & frontier : mFrontiers)
+    //
+    // Only visit the frontiers that have changed since the last regeneration; the colors
+    // of all other frontiers are still current.
+    //
+    // Colors are chosen by frontier ID, so that a frontier keeps its color regardless of
+    // changes to other frontiers.
+    //
+
+    for (FrontierId const frontierId : mDirtyForRenderingFrontierIds)
     {
+        assert(mIsFrontierDirtyForRendering[frontierId]);
+        mIsFrontierDirtyForRendering[frontierId] = false;
+
+        auto const & frontier = mFrontiers[frontierId];
         if (frontier.has_value())
         {
             //
@@ -1573,8 +1728,8 @@ void Frontiers::RegeneratePointColors()
             //
 
             vec3f const baseColor = (frontier->Type == FrontierType::External)
-                ? ExternalColors[(externalUsed++) % ExternalColors.size()].toVec3f()
-                : InternalColors[(internalUsed++) % InternalColors.size()].toVec3f();
+                ? ExternalColors[frontierId % ExternalColors.size()].toVec3f()
+                : InternalColors[frontierId % InternalColors.size()].toVec3f();
 
             ElementIndex const startingEdgeIndex = frontier->StartingEdgeIndex;
             ElementIndex edgeIndex = startingEdgeIndex;
@@ -1585,6 +1740,7 @@ void Frontiers::RegeneratePointColors()
             {
                 mPointColors[mFrontierEdges[edgeIndex].PointAIndex].frontierBaseColor = baseColor;
                 mPointColors[mFrontierEdges[edgeIndex].PointAIndex].positionalProgress = positionalProgress;
+                dirtyRange.Add(mFrontierEdges[edgeIndex].PointAIndex);
 
                 // Advance
                 edgeIndex = mFrontierEdges[edgeIndex].NextEdgeIndex;
@@ -1593,6 +1749,10 @@ void Frontiers::RegeneratePointColors()
             } while (edgeIndex != startingEdgeIndex);
         }
     }
+
+    mDirtyForRenderingFrontierIds.clear();
+
+    return dirtyRange;
 }
 
 #ifdef _DEBUG
@@ -1691,11 +1851,27 @@ void Frontiers::VerifyInvariants(
     // Frontier IDs
     //
 
-    for (auto frontierId : mFrontierIds)
+    for (size_t p = 0; p < mFrontierIds.size(); ++p)
     {
+        auto const frontierId = mFrontierIds[p];
+
         Verify(frontierId < mFrontiers.size());
 
         Verify(mFrontiers[frontierId].has_value());
+
+        Verify(mFrontierIdPositions[frontierId] == p);
+    }
+
+    for (auto frontierId : mFreeFrontierIds)
+    {
+        Verify(frontierId < mFrontiers.size());
+
+        Verify(!mFrontiers[frontierId].has_value());
+    }
+
+    for (auto frontierId : mDirtyForRenderingFrontierIds)
+    {
+        Verify(mIsFrontierDirtyForRendering[frontierId]);
     }
 
     //
@@ -11,8 +11,12 @@
 
 #include <GameCore/AABB.h>
 #include <GameCore/Buffer.h>
+#include <GameCore/BufferAllocator.h>
+#include <GameCore/DirtyRange.h>
+#include <GameCore/StateSnapshot.h>
 
 #include <array>
+#include <initializer_list>
 #include <optional>
 #include <vector>
 
@@ -76,7 +80,12 @@ public:
         , mFrontierEdges(mEdgeCount, 0, FrontierEdge())
         , mFrontiers()
         , mFrontierIds()
+        , mFrontierIdPositions()
+        , mFreeFrontierIds()
+        , mIsFrontierDirtyForRendering()
+        , mDirtyForRenderingFrontierIds()
         , mPointColors(pointCount, 0, Render::FrontierColor(vec3f::zero(), 0.0f))
+        , mPointColorsUploadSnapshotAllocator(pointCount)
         , mCurrentVisitSequenceNumber()
         , mIsDirtyForRendering(true)
     {}
@@ -86,6 +95,15 @@ public:
         std::vector<ElementIndex> edgeIndices,
         Springs const & springs);
 
+    /*
+     * Populates this container - which must be empty - with the frontiers of a fragment
+     * of another ship, whose edges have already been populated in the specified springs.
+     */
+    void AddFragment(
+        Frontiers const & other,
+        ShipFragmentMap const & fragmentMap,
+        Springs const & springs);
+
     /*
      * Maintains the frontiers consistent with the removal of the specified triangle.
      * Springs and points: assumed to be already consistent with the removal of the triangle.
@@ -106,10 +124,23 @@ public:
         Springs const & springs,
         Triangles const & triangles);
 
+    /*
+     * Moves the edges into the new order of springs, after springs have been permuted.
+     */
+    void RemapEdgeIndices(
+        std::vector<ElementIndex> const & newToOldSpringIndices,
+        std::vector<ElementIndex> const & oldToNewSpringIndices);
+
     void Upload(
         ShipId shipId,
         Render::RenderContext & renderContext);
 
+    /*
+     * Saves and restores all frontiers.
+     */
+    void SaveState(StateSnapshotWriter & writer) const;
+    void LoadState(StateSnapshotReader & reader);
+
 #ifdef _DEBUG
     void VerifyInvariants(
         Points const & points,
@@ -174,6 +205,11 @@ private:
 
 private:
 
+    template<typename TSelf, typename TArchive>
+    static void ArchiveState(
+        TSelf & self,
+        TArchive & archive);
+
     static inline int PreviousEdgeOrdinal(int edgeOrdinal)
     {
         int edgeOrd = edgeOrdinal - 1;
@@ -262,7 +298,30 @@ private:
         ElementIndex endEdgeIndex,
         Points const & points) const;
 
-    void RegeneratePointColors();
+    inline void MarkFrontierDirtyForRendering(FrontierId frontierId)
+    {
+        if (!mIsFrontierDirtyForRendering[frontierId])
+        {
+            mIsFrontierDirtyForRendering[frontierId] = true;
+            mDirtyForRenderingFrontierIds.push_back(frontierId);
+        }
+    }
+
+    inline void MarkFrontiersOfEdgesDirtyForRendering(
+        ElementIndex edgeAIndex,
+        ElementIndex edgeBIndex,
+        ElementIndex edgeCIndex)
+    {
+        for (ElementIndex const edgeIndex : { edgeAIndex, edgeBIndex, edgeCIndex })
+        {
+            if (mEdges[edgeIndex].FrontierIndex != NoneFrontierId)
+            {
+                MarkFrontierDirtyForRendering(mEdges[edgeIndex].FrontierIndex);
+            }
+        }
+    }
+
+    DirtyRange RegeneratePointColors();
 
 private:
 
@@ -288,10 +347,27 @@ private:
     // contiguous and compact
     std::vector<FrontierId> mFrontierIds;
 
+    // The position of each frontier in the frontier indices vector,
+    // indexed by frontier indices; significant only for existing frontiers.
+    // Cardinality: same as Frontiers vector
+    std::vector<size_t> mFrontierIdPositions;
+
+    // The indices of the unused slots in the Frontiers vector
+    std::vector<FrontierId> mFreeFrontierIds;
+
+    // The frontiers whose point colors need to be regenerated, with a flag
+    // per slot in the Frontiers vector to keep them unique.
+    // Slots might have been freed in the meantime.
+    std::vector<bool> mIsFrontierDirtyForRendering;
+    std::vector<FrontierId> mDirtyForRenderingFrontierIds;
+
     // Frontier coloring info.
     // Cardinality: points
     Buffer<Render::FrontierColor> mPointColors;
 
+    // Allocator for the snapshots of the point colors, which are uploaded asynchronously
+    BufferAllocator<Render::FrontierColor> mPointColorsUploadSnapshotAllocator;
+
     // The visit number used to mark edges as visited during the
     // region/frontier check
     SequenceNumber mCurrentVisitSequenceNumber;
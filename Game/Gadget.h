@@ -18,6 +18,7 @@
 #include <functional>
 #include <memory>
 #include <optional>
+#include <vector>
 
 namespace Physics
 {
@@ -87,6 +88,16 @@ public:
         ShipId shipId,
         Render::RenderContext & renderContext) const = 0;
 
+    /*
+     * Makes a copy of this gadget for the fragment of the ship that the gadget's
+     * point has moved to, when the ship splits; the gadget keeps its ID.
+     */
+    virtual std::unique_ptr<Gadget> MigrateToFragment(
+        ShipFragmentMap const & fragmentMap,
+        IShipPhysicsHandler & shipPhysicsHandler,
+        Points & shipPoints,
+        Springs & shipSprings) const = 0;
+
     /*
      * Invoked when the spring tracked by the gadget is destroyed.
      */
@@ -103,6 +114,17 @@ public:
         mTrackedSpringIndex.reset();
     }
 
+    /*
+     * Invoked when the ship's springs have been renumbered.
+     */
+    void OnSpringsRenumbered(std::vector<ElementIndex> const & oldToNewSpringIndices)
+    {
+        if (mTrackedSpringIndex.has_value())
+        {
+            mTrackedSpringIndex = oldToNewSpringIndices[*mTrackedSpringIndex];
+        }
+    }
+
     /*
      * Gets the point that the gadget is attached to.
      */
@@ -155,6 +177,42 @@ protected:
     {
     }
 
+    Gadget(
+        Gadget const & other,
+        ShipFragmentMap const & fragmentMap,
+        IShipPhysicsHandler & shipPhysicsHandler,
+        Points & shipPoints,
+        Springs & shipSprings)
+        : mId(other.mId)
+        , mType(other.mType)
+        , mPointIndex(fragmentMap.PointIndices.OldToNew[other.mPointIndex])
+        , mParentWorld(other.mParentWorld)
+        , mGameEventHandler(other.mGameEventHandler)
+        , mShipPhysicsHandler(shipPhysicsHandler)
+        , mShipPoints(shipPoints)
+        , mShipSprings(shipSprings)
+        //
+        , mTrackedSpringIndex(std::nullopt)
+        , mRotationBaseAxis(other.mRotationBaseAxis)
+        , mFrozenRotationOffsetAxis(other.mFrozenRotationOffsetAxis)
+        , mPersonalitySeed(other.mPersonalitySeed)
+    {
+        assert(mPointIndex != NoneElementIndex);
+
+        if (other.mTrackedSpringIndex.has_value())
+        {
+            if (fragmentMap.SpringIndices.Contains(*other.mTrackedSpringIndex))
+            {
+                mTrackedSpringIndex = fragmentMap.SpringIndices.OldToNew[*other.mTrackedSpringIndex];
+            }
+            else
+            {
+                // The tracked spring has been left behind, hence we freeze its current rotation offset
+                mFrozenRotationOffsetAxis = other.GetRotationOffsetAxis();
+            }
+        }
+    }
+
     static inline ElementIndex GetTrackedSpringIndex(
         ElementIndex pointIndex,
         Points const & shipPoints)
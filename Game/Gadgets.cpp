@@ -5,6 +5,8 @@
 ***************************************************************************************/
 #include "Physics.h"
 
+#include <GameCore/Profiler.h>
+
 namespace Physics {
 
 void Gadgets::Update(
@@ -13,6 +15,8 @@ void Gadgets::Update(
     Storm::Parameters const & stormParameters,
     GameParameters const & gameParameters)
 {
+    FS_PROFILE_SCOPE("Gadgets::Update");
+
     //
     // Gadgets
     //
@@ -138,6 +142,19 @@ void Gadgets::OnSpringDestroyed(ElementIndex springElementIndex)
     }
 }
 
+void Gadgets::OnSpringsRenumbered(std::vector<ElementIndex> const & oldToNewSpringIndices)
+{
+    for (auto & gadget : mCurrentGadgets)
+    {
+        gadget->OnSpringsRenumbered(oldToNewSpringIndices);
+    }
+
+    if (!!mCurrentPhysicsProbeGadget)
+    {
+        mCurrentPhysicsProbeGadget->OnSpringsRenumbered(oldToNewSpringIndices);
+    }
+}
+
 void Gadgets::OnElectricSpark(ElementIndex pointElementIndex)
 {
     //
@@ -278,6 +295,77 @@ void Gadgets::RemovePhysicsProbe()
     }
 }
 
+void Gadgets::RemoveAllGadgets()
+{
+    for (auto & gadget : mCurrentGadgets)
+    {
+        InternalPreGadgetRemoval(
+            *gadget,
+            StrongTypedTrue<DoNotify>);
+
+        gadget.reset();
+    }
+
+    mCurrentGadgets.clear();
+
+    if (!!mCurrentPhysicsProbeGadget)
+    {
+        InternalPreGadgetRemoval(
+            *mCurrentPhysicsProbeGadget,
+            StrongTypedTrue<DoNotify>);
+
+        mCurrentPhysicsProbeGadget.reset();
+    }
+}
+
+void Gadgets::AddFragment(
+    Gadgets const & other,
+    ShipFragmentMap const & fragmentMap)
+{
+    assert(mCurrentGadgets.size() == 0);
+
+    // The other list is most recent first, hence we add in reverse
+    std::vector<Gadget const *> otherGadgets;
+    for (auto const & otherGadget : other.mCurrentGadgets)
+    {
+        if (fragmentMap.PointIndices.Contains(otherGadget->GetPointIndex()))
+        {
+            otherGadgets.push_back(otherGadget.get());
+        }
+    }
+
+    for (auto it = otherGadgets.crbegin(); it != otherGadgets.crend(); ++it)
+    {
+        assert(mShipPoints.IsGadgetAttached(fragmentMap.PointIndices.OldToNew[(*it)->GetPointIndex()]));
+
+        mCurrentGadgets.emplace(
+            [this](std::unique_ptr<Gadget> const & purgedGadget)
+            {
+                InternalPreGadgetRemoval(
+                    *purgedGadget,
+                    StrongTypedTrue<DoNotify>);
+            },
+            (*it)->MigrateToFragment(
+                fragmentMap,
+                mShipPhysicsHandler,
+                mShipPoints,
+                mShipSprings));
+    }
+
+    if (!!other.mCurrentPhysicsProbeGadget
+        && fragmentMap.PointIndices.Contains(other.mCurrentPhysicsProbeGadget->GetPointIndex()))
+    {
+        mCurrentPhysicsProbeGadget = other.mCurrentPhysicsProbeGadget->MigrateToFragment(
+            fragmentMap,
+            mShipPhysicsHandler,
+            mShipPoints,
+            mShipSprings);
+    }
+
+    // Gadgets keep their IDs, hence we continue the other's numbering
+    mNextLocalGadgetId = other.mNextLocalGadgetId;
+}
+
 void Gadgets::DetonateRCBombs()
 {
     for (auto & gadget : mCurrentGadgets)
@@ -17,6 +17,7 @@
 
 #include <functional>
 #include <memory>
+#include <vector>
 
 namespace Physics
 {
@@ -60,6 +61,8 @@ public:
 
     void OnSpringDestroyed(ElementIndex springElementIndex);
 
+    void OnSpringsRenumbered(std::vector<ElementIndex> const & oldToNewSpringIndices);
+
     void OnElectricSpark(ElementIndex pointElementIndex);
 
     bool ToggleAntiMatterBombAt(
@@ -86,6 +89,19 @@ public:
 
     void RemovePhysicsProbe();
 
+    /*
+     * Removes all gadgets - the physics probe included - without detonating them.
+     */
+    void RemoveAllGadgets();
+
+    /*
+     * Takes over the gadgets of a fragment of another ship; the gadgets' masses
+     * have already been taken over with the points.
+     */
+    void AddFragment(
+        Gadgets const & other,
+        ShipFragmentMap const & fragmentMap);
+
     bool ToggleRCBombAt(
         vec2f const & targetPos,
         GameParameters const & gameParameters)
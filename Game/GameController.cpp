@@ -10,21 +10,61 @@
 
 #include <GameCore/GameMath.h>
 #include <GameCore/Log.h>
+#include <GameCore/Profiler.h>
+#include <GameCore/TaskGraph.h>
 
+#include <algorithm>
 #include <ctime>
 #include <iomanip>
+#include <limits>
 #include <sstream>
 
+// Simulation seconds between two frames of the snapshot history
+static float constexpr SnapshotHistoryInterval = 1.0f;
+
+// Frames between two keyframes of the snapshot history
+static size_t constexpr SnapshotHistoryKeyframeInterval = 10;
+
+static size_t constexpr DefaultSnapshotHistoryMaxByteSize = 64 * 1024 * 1024;
+
 std::unique_ptr<GameController> GameController::Create(
     RenderDeviceProperties const & renderDeviceProperties,
     ResourceLocator const & resourceLocator,
     ProgressCallback const & progressCallback)
 {
-    // Load fish species
-    FishSpeciesDatabase fishSpeciesDatabase = FishSpeciesDatabase::Load(resourceLocator);
+    //
+    // Load databases concurrently among themselves, and with the creation of the
+    // render context - which spends most of its time waiting for the render thread
+    //
+
+    std::optional<FishSpeciesDatabase> fishSpeciesDatabase;
+    std::optional<MaterialDatabase> materialDatabase;
+
+    TaskGraph databasesLoadGraph;
+
+    databasesLoadGraph.AddTask(
+        "Load fish species",
+        [&]()
+        {
+            fishSpeciesDatabase.emplace(FishSpeciesDatabase::Load(resourceLocator));
+        });
 
-    // Load materials
-    MaterialDatabase materialDatabase = MaterialDatabase::Load(resourceLocator);
+    databasesLoadGraph.AddTask(
+        "Load materials",
+        [&]()
+        {
+            materialDatabase.emplace(MaterialDatabase::Load(resourceLocator));
+        });
+
+    // Note: the thread must be destroyed before everything it uses
+    TaskThreadPool databasesLoadThreadPool(databasesLoadGraph.GetTaskCount());
+    TaskThread databasesLoadThread;
+
+    auto const databasesLoadCompletionIndicator = databasesLoadThread.QueueTask(
+        [&]()
+        {
+            databasesLoadGraph.Run(databasesLoadThreadPool);
+        });
 
     // Create game event dispatcher
     auto gameEventDispatcher = std::make_shared<GameEventDispatcher>();
@@ -42,6 +82,12 @@ std::unique_ptr<GameController> GameController::Create(
             progressCallback(0.9f * progress, message);
         });
 
+    // Wait for databases - rethrowing their load errors
+    databasesLoadCompletionIndicator->Wait();
+
+    assert(fishSpeciesDatabase.has_value());
+    assert(materialDatabase.has_value());
+
     //
     // Create controller
     //
@@ -51,8 +97,8 @@ std::unique_ptr<GameController> GameController::Create(
             std::move(renderContext),
             std::move(gameEventDispatcher),
             std::move(perfStats),
-            std::move(fishSpeciesDatabase),
-            std::move(materialDatabase),
+            std::move(*fishSpeciesDatabase),
+            std::move(*materialDatabase),
             resourceLocator,
             progressCallback));
 }
@@ -71,17 +117,26 @@ GameController::GameController(
     , mDayLightCycleStateMachine()
     // World
     , mWorld()
+    , mShipTextureImages()
     , mFishSpeciesDatabase(std::move(fishSpeciesDatabase))
     , mMaterialDatabase(std::move(materialDatabase))
     // Ship factory
     , mShipStrengthRandomizer()
     , mShipTexturizer(mMaterialDatabase, resourceLocator)
+    , mShipFactoryCache(resourceLocator.GetShipFactoryCacheFolderPath())
     // State
     , mGameParameters()
     , mIsFrozen(false)
     , mIsPaused(false)
     , mIsPulseUpdateSet(false)
     , mIsMoveToolEngaged(false)
+    , mSimulationGovernor()
+    , mIsInterpolatingRendering(false)
+    , mSimulationTimeAccumulator(0.0f)
+    , mLastGameIterationTimestampReal(GameChronometer::now())
+    , mIsRenderRequested(true)
+    , mLastRenderedGameParametersGeneration(0)
+    , mIdleGameIterationCount(0)
     // Parameters that we own
     , mDoShowTsunamiNotifications(true)
     , mDoDrawHeatBlasterFlame(true)    
@@ -105,10 +160,28 @@ GameController::GameController(
     , mOriginTimestampGame(GameWallClock::GetInstance().Now())
     , mTotalPerfStats(std::move(perfStats))
     , mLastPublishedTotalPerfStats()
+    , mLastDeltaPerfStats()
     , mTotalFrameCount(0u)
     , mLastPublishedTotalFrameCount(0u)
     , mSkippedFirstStatPublishes(0)
-{
+    // Telemetry
+    , mTelemetrySink()
+    // Quick-save
+    , mQuickSave()
+    , mQuickSaveWriteThread(std::make_unique<TaskThread>())
+    // Snapshot history
+    , mIsSnapshotHistoryEnabled(false)
+    , mSnapshotHistoryMaxByteSize(DefaultSnapshotHistoryMaxByteSize)
+    , mSnapshotHistory(DefaultSnapshotHistoryMaxByteSize, SnapshotHistoryKeyframeInterval)
+    , mLastSnapshotHistorySimulationTime(std::numeric_limits<float>::lowest())
+    // Asynchronous ship loading
+    , mAsyncShipLoad()
+    , mShipLoadTaskThreadPool()
+    , mShipLoadThread(std::make_unique<TaskThread>())
+{
+    // Name the thread driving the simulation, for profiling
+    Profiler::GetInstance().SetCurrentThreadName("Main Thread");
+
     // Create world
     mWorld = std::make_unique<Physics::World>(
         OceanFloorTerrain::LoadFromImage(resourceLocator.GetDefaultOceanFloorTerrainFilePath()),
@@ -122,6 +195,12 @@ GameController::GameController(
     mGameEventDispatcher->RegisterLifecycleEventHandler(this);
     mGameEventDispatcher->RegisterWavePhenomenaEventHandler(this);
 
+    // Register the telemetry sink, which ignores events until started
+    mGameEventDispatcher->RegisterLifecycleEventHandler(&mTelemetrySink);
+    mGameEventDispatcher->RegisterWavePhenomenaEventHandler(&mTelemetrySink);
+    mGameEventDispatcher->RegisterStatisticsEventHandler(&mTelemetrySink);
+    mGameEventDispatcher->RegisterAtmosphereEventHandler(&mTelemetrySink);
+
     //
     // Initialize parameter smoothers
     //
@@ -138,6 +217,7 @@ GameController::GameController(
         [this](float const & value)
         {
             this->mGameParameters.SpringStiffnessAdjustment = value;
+            ++this->mGameParameters.Generation;
         },
         GenericParameterConvergenceFactor,
         GenericParameterTerminationThreshold);
@@ -151,6 +231,7 @@ GameController::GameController(
         [this](float const & value)
         {
             this->mGameParameters.SpringStrengthAdjustment = value;
+            ++this->mGameParameters.Generation;
         },
         GenericParameterConvergenceFactor,
         GenericParameterTerminationThreshold);
@@ -164,6 +245,7 @@ GameController::GameController(
         [this](float const & value)
         {
             this->mGameParameters.SeaDepth = value;
+            ++this->mGameParameters.Generation;
         },
         GenericParameterConvergenceFactor,
         GenericParameterTerminationThreshold);
@@ -177,6 +259,7 @@ GameController::GameController(
         [this](float const & value)
         {
             this->mGameParameters.OceanFloorBumpiness = value;
+            ++this->mGameParameters.Generation;
         },
         GenericParameterConvergenceFactor,
         GenericParameterTerminationThreshold);
@@ -190,6 +273,7 @@ GameController::GameController(
         [this](float const & value)
         {
             this->mGameParameters.OceanFloorDetailAmplification = value;
+            ++this->mGameParameters.Generation;
         },
         GenericParameterConvergenceFactor,
         GenericParameterTerminationThreshold);
@@ -216,6 +300,7 @@ GameController::GameController(
         [this](float const & value)
         {
             this->mGameParameters.BasalWaveHeightAdjustment = value;
+            ++this->mGameParameters.Generation;
         },
         GenericParameterConvergenceFactor,
         GenericParameterTerminationThreshold);
@@ -229,6 +314,7 @@ GameController::GameController(
         [this](float const & value)
         {
             this->mGameParameters.FishSizeMultiplier = value;
+            ++this->mGameParameters.Generation;
         },
         GenericParameterConvergenceFactor,
         GenericParameterTerminationThreshold);
@@ -239,13 +325,22 @@ GameController::GameController(
 
     progressCallback(1.0f, ProgressMessageType::Calibrating);
 
-    auto const & score = ComputerCalibrator::Calibrate();
+    auto const & score = ComputerCalibrator::Calibrate(resourceLocator.GetComputerCalibrationFilePath());
 
     ComputerCalibrator::TuneGame(score, mGameParameters, *mRenderContext);
+    ++mGameParameters.Generation;
+
+    if (score.OptimalParallelism != mTaskThreadPool->GetParallelism())
+    {
+        // No ships exist yet, hence nobody else is using the current pool
+        mTaskThreadPool = std::make_shared<TaskThreadPool>(score.OptimalParallelism);
+    }
 }
 
 GameController::~GameController()
 {
+    // Don't bother finishing a load that nobody is going to see
+    CancelShipLoad();
 }
 
 void GameController::RebindOpenGLContext()
@@ -266,8 +361,11 @@ ShipMetadata GameController::ResetAndReloadShip(ShipLoadSpecifications const & l
 
 ShipMetadata GameController::AddShip(ShipLoadSpecifications const & loadSpecs)
 {
+    // This ship supersedes any other one that is still being loaded
+    CancelShipLoadAndWait();
+
     // Load ship definition
-    auto shipDefinition = ShipDeSerializer::LoadShip(loadSpecs.DefinitionFilepath, mMaterialDatabase);
+    auto shipDefinition = LoadShipDefinition(loadSpecs);
 
     // Pre-validate ship's texture, if any
     if (shipDefinition.Layers.TextureLayer)
@@ -292,7 +390,8 @@ ShipMetadata GameController::AddShip(ShipLoadSpecifications const & loadSpecs)
         mShipStrengthRandomizer,
         mGameEventDispatcher,
         mTaskThreadPool,
-        mGameParameters);
+        mGameParameters,
+        &mShipFactoryCache);
 
     //
     // No errors, so we may continue
@@ -306,6 +405,151 @@ ShipMetadata GameController::AddShip(ShipLoadSpecifications const & loadSpecs)
     return shipMetadata;
 }
 
+void GameController::ResetAndLoadShipAsync(
+    ShipLoadSpecifications const & loadSpecs,
+    ShipLoadCallbacks && callbacks)
+{
+    assert(!!mWorld);
+
+    // This ship supersedes any other one that is still being loaded
+    CancelShipLoad();
+
+    mAsyncShipLoad = std::make_shared<AsyncShipLoad>(loadSpecs, std::move(callbacks));
+
+    // Create the new world here, as it's made out of the current one; from now on it's
+    // owned by the ship load thread, until the load is complete
+    mAsyncShipLoad->NewWorld = std::make_unique<Physics::World>(
+        OceanFloorTerrain(mWorld->GetOceanFloorTerrain()),
+        mFishSpeciesDatabase,
+        mGameEventDispatcher,
+        std::make_shared<TaskThreadPool>(mTaskThreadPool->GetParallelism()),
+        mGameParameters,
+        mRenderContext->GetVisibleWorld());
+
+    mShipLoadThread->QueueTask(
+        [this, asyncShipLoad = mAsyncShipLoad]()
+        {
+            RunAsyncShipLoad(*asyncShipLoad);
+        });
+}
+
+void GameController::CancelShipLoad()
+{
+    if (mAsyncShipLoad)
+    {
+        LogMessage("GameController::CancelShipLoad(", mAsyncShipLoad->LoadSpecs.DefinitionFilepath.string(), ")");
+
+        // The ship load thread will notice at its next step, and throw everything away
+        mAsyncShipLoad->IsCancelled = true;
+        mAsyncShipLoad.reset();
+    }
+}
+
+void GameController::QuickSave()
+{
+    assert(!!mWorld);
+
+    mQuickSave = std::make_shared<StateSnapshot const>(mWorld->TakeSnapshot());
+
+    LogMessage("GameController::QuickSave(): ", mQuickSave->GetByteSize(), " bytes");
+}
+
+void GameController::QuickSaveToFile(std::filesystem::path const & filePath)
+{
+    QuickSave();
+
+    // Write in the background, while the simulation keeps running
+    mQuickSaveWriteThread->QueueTask(
+        [quickSave = mQuickSave, filePath]()
+        {
+            try
+            {
+                quickSave->SaveToFile(filePath);
+            }
+            catch (std::exception const & ex)
+            {
+                LogMessage("GameController::QuickSaveToFile(", filePath.string(), "): error: ", ex.what());
+            }
+        });
+}
+
+void GameController::QuickLoad()
+{
+    assert(!!mWorld);
+
+    if (!mQuickSave)
+        return;
+
+    // Wait for pending render tasks, as they might still be reading from the world
+    mRenderContext->WaitForPendingTasks();
+
+    mWorld->RestoreSnapshot(*mQuickSave);
+
+    // Forget the state of the tools, which no longer applies
+    ResetStateMachines();
+
+    // The history no longer leads to the present
+    ClearSnapshotHistory();
+}
+
+void GameController::QuickLoadFromFile(std::filesystem::path const & filePath)
+{
+    // Wait for pending writes, which might be writing the same file
+    mQuickSaveWriteThread->QueueSynchronizationPoint()->Wait();
+
+    auto snapshot = std::make_shared<StateSnapshot const>(StateSnapshot::LoadFromFile(filePath));
+
+    mRenderContext->WaitForPendingTasks();
+
+    mWorld->RestoreSnapshot(*snapshot);
+
+    ResetStateMachines();
+
+    ClearSnapshotHistory();
+
+    // It's now our quick-save
+    mQuickSave = std::move(snapshot);
+}
+
+void GameController::SetSnapshotHistoryEnabled(bool value)
+{
+    if (!value)
+    {
+        ClearSnapshotHistory();
+    }
+
+    mIsSnapshotHistoryEnabled = value;
+}
+
+void GameController::SetSnapshotHistoryMaxByteSize(size_t value)
+{
+    mSnapshotHistoryMaxByteSize = value;
+    mSnapshotHistory.SetMaxByteSize(value);
+}
+
+void GameController::ScrubToSnapshotHistoryFrame(size_t frameIndex)
+{
+    assert(!!mWorld);
+
+    // Wait for the frame to be stored, so that its index is stable
+    mSnapshotHistory.WaitForPendingPushes();
+
+    if (frameIndex >= mSnapshotHistory.GetFrameCount())
+        return;
+
+    auto const snapshot = mSnapshotHistory.DecodeFrame(frameIndex);
+
+    mRenderContext->WaitForPendingTasks();
+
+    mWorld->RestoreSnapshot(snapshot);
+
+    ResetStateMachines();
+
+    // Resume recording from here
+    mSnapshotHistory.TruncateAfter(frameIndex);
+    mLastSnapshotHistorySimulationTime = mSnapshotHistory.GetFrameSimulationTime(frameIndex);
+}
+
 RgbImageData GameController::TakeScreenshot()
 {
     return mRenderContext->TakeScreenshot();
@@ -313,8 +557,18 @@ RgbImageData GameController::TakeScreenshot()
 
 void GameController::RunGameIteration()
 {
+    FS_PROFILE_SCOPE("GameController::RunGameIteration");
+
     assert(!mIsFrozen); // Not supposed to be invoked at all if we're frozen
 
+    //
+    // Check on the ship being loaded, if any
+    //
+
+    bool const isShipLoadInProgress = !!mAsyncShipLoad;
+
+    UpdateAsyncShipLoad();
+
     //
     // Initialize stats, if needed
     //
@@ -339,13 +593,71 @@ void GameController::RunGameIteration()
     // Update
     ////////////////////////////////////////////////////////////////////////////
 
-    // Decide whether we are going to run a simulation update
+    // Decide whether we are going to run simulation updates
     bool const doUpdate = ((!mIsPaused || mIsPulseUpdateSet) && !mIsMoveToolEngaged);
 
     // Clear pulse
     mIsPulseUpdateSet = false;
 
-    if (doUpdate)
+    //
+    // Decide how many simulation updates we are going to run, and where
+    // between the last two simulation steps we are going to render.
+    //
+    // When rendering is interpolated, each game iteration - hence each
+    // frame - consumes the real time elapsed since the previous iteration,
+    // running as many fixed simulation steps as fit in the accumulated time;
+    // otherwise, each game iteration runs exactly one simulation step.
+    //
+
+    auto const nowReal = GameChronometer::now();
+    float const elapsedReal = std::chrono::duration<float>(nowReal - mLastGameIterationTimestampReal).count();
+    mLastGameIterationTimestampReal = nowReal;
+
+    size_t updateCount = 0;
+    float pointPositionInterpolationFactor = 1.0f;
+
+    if (doUpdate && mGameParameters.DoInterpolateRendering && !mIsPaused)
+    {
+        float constexpr StepDuration = GameParameters::SimulationStepTimeDuration<float>;
+
+        if (!mIsInterpolatingRendering)
+        {
+            // Start with a full step, so that the positions to interpolate
+            // from are captured right away
+            mSimulationTimeAccumulator = StepDuration;
+            mIsInterpolatingRendering = true;
+        }
+        else
+        {
+            mSimulationTimeAccumulator += std::min(
+                elapsedReal,
+                static_cast<float>(MaxSimulationStepsPerGameIteration) * StepDuration);
+        }
+
+        updateCount = std::min(
+            static_cast<size_t>(mSimulationTimeAccumulator / StepDuration),
+            MaxSimulationStepsPerGameIteration);
+
+        // Consume the time of the steps we're going to run; if we're falling
+        // behind, we drop the excess time - thus slowing down the simulation -
+        // rather than accumulating ever more steps
+        mSimulationTimeAccumulator = std::min(
+            mSimulationTimeAccumulator - static_cast<float>(updateCount) * StepDuration,
+            StepDuration);
+
+        pointPositionInterpolationFactor = mSimulationTimeAccumulator / StepDuration;
+    }
+    else
+    {
+        if (doUpdate)
+        {
+            updateCount = 1;
+        }
+
+        mIsInterpolatingRendering = false;
+    }
+
+    for (size_t u = 0; u < updateCount; ++u)
     {
         auto const startTime = GameChronometer::now();
 
@@ -389,6 +701,9 @@ void GameController::RunGameIteration()
         // Update state machines
         UpdateStateMachines(mWorld->GetCurrentSimulationTime());
 
+        // Update snapshot history
+        UpdateSnapshotHistory();
+
         // Update notification layer
         mNotificationLayer.Update(nowGame);
 
@@ -399,6 +714,46 @@ void GameController::RunGameIteration()
         mTotalPerfStats->TotalUpdateDuration.Update(GameChronometer::now() - startTime);
     }
 
+    // Split off detached fragments, now that the structure of the ships is settled
+    if (updateCount > 0 && mGameParameters.DoSplitDetachedFragments)
+    {
+        SplitDetachedFragments();
+    }
+
+    // Update view manager
+    // Note: some Upload()'s need to use ViewModel values, which have then to match the
+    // ViewModel values used by the subsequent render
+    mViewManager.Update(mWorld->GetAllShipsAABB());
+
+    //
+    // Decide whether we are going to render.
+    //
+    // When rendering on demand, we skip frames that would look exactly like the
+    // previous one: that is, when the simulation has not run and neither the
+    // user, nor settings, nor the camera, nor notifications have changed anything.
+    // Note that we keep rendering while the simulation runs, as the ocean and the
+    // sky are always moving, regardless of the ships being at rest.
+    //
+
+    bool const doRender =
+        !mGameParameters.DoRenderOnDemand
+        || updateCount > 0
+        || mIsRenderRequested
+        || isShipLoadInProgress
+        || mGameParameters.Generation != mLastRenderedGameParametersGeneration
+        || mRenderContext->AreRenderParametersDirty()
+        || mNotificationLayer.IsDirty();
+
+    if (!doRender)
+    {
+        ++mIdleGameIterationCount;
+        return;
+    }
+
+    mIsRenderRequested = false;
+    mLastRenderedGameParametersGeneration = mGameParameters.Generation;
+    mIdleGameIterationCount = 0;
+
     ////////////////////////////////////////////////////////////////////////////
     // Render Upload
     ////////////////////////////////////////////////////////////////////////////
@@ -406,16 +761,25 @@ void GameController::RunGameIteration()
     // Tell RenderContext we're starting a new rendering cycle
     mRenderContext->RenderStart();
 
+    mRenderContext->SetPointPositionInterpolationFactor(pointPositionInterpolationFactor);
+
+    if (mGameParameters.DoPipelineFrames)
+    {
+        // Upload double-buffered data now, while the render thread
+        // might still be drawing the previous frame
+        auto const netStartTime = GameChronometer::now();
+
+        assert(!!mWorld);
+        mWorld->RenderUploadAhead(*mRenderContext);
+
+        mTotalPerfStats->TotalNetRenderUploadDuration.Update(GameChronometer::now() - netStartTime);
+    }
+
     {
         mRenderContext->UploadStart();
 
         auto const netStartTime = GameChronometer::now();
 
-        // Update view manager
-        // Note: some Upload()'s need to use ViewModel values, which have then to match the
-        // ViewModel values used by the subsequent render
-        mViewManager.Update(mWorld->GetAllAABBs());
-
         //
         // Upload world
         //
@@ -453,6 +817,24 @@ void GameController::RunGameIteration()
     // Tell RenderContext we've finished a rendering cycle
     mRenderContext->RenderEnd();
 
+    //
+    // Govern simulation time budget
+    //
+
+    if (mGameParameters.DoGovernSimulationTimeBudget)
+    {
+        if (mSimulationGovernor.Update(*mTotalPerfStats))
+        {
+            mGameParameters.SimulationDegradationLevel = mSimulationGovernor.GetDegradationLevel();
+        }
+    }
+    else if (mGameParameters.SimulationDegradationLevel != 0)
+    {
+        // Restore full simulation
+        mSimulationGovernor.Reset();
+        mGameParameters.SimulationDegradationLevel = 0;
+    }
+
     //
     // Update stats
     //
@@ -460,6 +842,21 @@ void GameController::RunGameIteration()
     ++mTotalFrameCount;
 }
 
+float GameController::GetGameIterationTimeDuration() const
+{
+    if (mGameParameters.DoThrottleIdleGameIterations
+        && mIdleGameIterationCount >= GameParameters::IdleGameIterationsBeforeThrottling)
+    {
+        // Nothing has been rendered for a while, hence we may as well check less often;
+        // as soon as something renders again, we're back at full rate
+        return 1.0f / GameParameters::IdleGameIterationRate;
+    }
+
+    return mGameParameters.DoInterpolateRendering
+        ? 1.0f / mGameParameters.RenderFrameRate
+        : GameParameters::SimulationStepTimeDuration<float>;
+}
+
 void GameController::LowFrequencyUpdate()
 {
     std::chrono::steady_clock::time_point const nowReal = std::chrono::steady_clock::now();
@@ -483,6 +880,10 @@ void GameController::LowFrequencyUpdate()
         mTotalPerfStats->Reset();
         mTotalFrameCount = 0u;
 
+        // Start governing from scratch
+        mSimulationGovernor.Reset();
+        mGameParameters.SimulationDegradationLevel = 0;
+
         ++mSkippedFirstStatPublishes;
     }
 
@@ -1295,6 +1696,49 @@ bool GameController::RestoreTriangle(ElementId triangleId)
     return mWorld->RestoreTriangle(triangleId);
 }
 
+std::vector<ShipMemoryReport> GameController::GetShipMemoryReports() const
+{
+    assert(!!mWorld);
+
+    auto reports = mWorld->GetShipMemoryReports();
+
+    for (auto const & report : reports)
+    {
+        LogMessage("Memory: ", report.ToString());
+    }
+
+    return reports;
+}
+
+std::vector<std::string> GameController::GetShipPerfReports() const
+{
+    std::vector<ShipId> shipIds;
+    for (size_t s = 0; s < mLastDeltaPerfStats.Ships.size(); ++s)
+    {
+        if (mLastDeltaPerfStats.Ships[s].UpdateDuration.GetCount() > 0)
+        {
+            shipIds.push_back(static_cast<ShipId>(s));
+        }
+    }
+
+    std::sort(
+        shipIds.begin(),
+        shipIds.end(),
+        [this](ShipId lhs, ShipId rhs)
+        {
+            return mLastDeltaPerfStats.Ships[lhs].UpdateDuration.ToRatio<std::chrono::milliseconds>()
+                > mLastDeltaPerfStats.Ships[rhs].UpdateDuration.ToRatio<std::chrono::milliseconds>();
+        });
+
+    std::vector<std::string> reports;
+    for (ShipId const shipId : shipIds)
+    {
+        reports.push_back(mLastDeltaPerfStats.Ships[shipId].ToString(shipId));
+    }
+
+    return reports;
+}
+
 //
 // Render controls
 //
@@ -1330,7 +1774,7 @@ void GameController::ResetView()
 {
     if (mWorld)
     {
-        mViewManager.ResetView(mWorld->GetAllAABBs());
+        mViewManager.ResetView(mWorld->GetAllShipsAABB());
     }
 }
 
@@ -1338,7 +1782,7 @@ void GameController::FocusOnShip()
 {
     if (mWorld)
     {
-        mViewManager.FocusOnShip(mWorld->GetAllAABBs());
+        mViewManager.FocusOnShip(mWorld->GetAllShipsAABB());
     }
 }
 
@@ -1357,6 +1801,7 @@ vec2f GameController::ScreenOffsetToWorldOffset(DisplayLogicalSize const & scree
 void GameController::SetDoDayLightCycle(bool value)
 {
     mGameParameters.DoDayLightCycle = value;
+    ++mGameParameters.Generation;
 
     if (value)
     {
@@ -1391,8 +1836,11 @@ ShipMetadata GameController::InternalResetAndLoadShip(ShipLoadSpecifications con
 {
     assert(!!mWorld);
 
+    // This ship supersedes any other one that is still being loaded
+    CancelShipLoadAndWait();
+
     // Load ship definition
-    auto shipDefinition = ShipDeSerializer::LoadShip(loadSpecs.DefinitionFilepath, mMaterialDatabase);
+    auto shipDefinition = LoadShipDefinition(loadSpecs);
 
     // Pre-validate ship's texture
     if (shipDefinition.Layers.TextureLayer)
@@ -1406,7 +1854,7 @@ ShipMetadata GameController::InternalResetAndLoadShip(ShipLoadSpecifications con
         OceanFloorTerrain(mWorld->GetOceanFloorTerrain()),
         mFishSpeciesDatabase,
         mGameEventDispatcher,
-        std::make_shared<TaskThreadPool>(),
+        std::make_shared<TaskThreadPool>(mTaskThreadPool->GetParallelism()),
         mGameParameters,
         mRenderContext->GetVisibleWorld());
 
@@ -1422,7 +1870,8 @@ ShipMetadata GameController::InternalResetAndLoadShip(ShipLoadSpecifications con
         mShipStrengthRandomizer,
         mGameEventDispatcher,
         mTaskThreadPool,
-        mGameParameters);
+        mGameParameters,
+        &mShipFactoryCache);
 
     //
     // No errors, so we may continue
@@ -1438,11 +1887,179 @@ ShipMetadata GameController::InternalResetAndLoadShip(ShipLoadSpecifications con
     return shipMetadata;
 }
 
+ShipDefinition GameController::LoadShipDefinition(ShipLoadSpecifications const & loadSpecs) const
+{
+    if (loadSpecs.Definition)
+    {
+        // Clone it, as the specs may be used to load the same ship again
+        return loadSpecs.Definition->Clone();
+    }
+    else
+    {
+        return ShipDeSerializer::LoadShip(loadSpecs.DefinitionFilepath, mMaterialDatabase);
+    }
+}
+
+void GameController::RunAsyncShipLoad(AsyncShipLoad & asyncShipLoad)
+{
+    // Runs on the ship load thread
+
+    if (asyncShipLoad.IsCancelled)
+        return;
+
+    try
+    {
+        // Load ship definition
+
+        asyncShipLoad.SetProgress(0.0f, ProgressMessageType::LoadingShip);
+
+        auto shipDefinition = LoadShipDefinition(asyncShipLoad.LoadSpecs);
+
+        ShipMetadata shipMetadata(shipDefinition.Metadata);
+
+        if (asyncShipLoad.IsCancelled)
+            return;
+
+        // Produce ship
+
+        asyncShipLoad.SetProgress(0.3f, ProgressMessageType::BuildingShip);
+
+        auto const shipId = asyncShipLoad.NewWorld->GetNextShipId();
+        auto [ship, textureImage] = ShipFactory::Create(
+            shipId,
+            *asyncShipLoad.NewWorld,
+            std::move(shipDefinition),
+            asyncShipLoad.LoadSpecs.LoadOptions,
+            mMaterialDatabase,
+            mShipTexturizer,
+            mShipStrengthRandomizer,
+            mGameEventDispatcher,
+            mTaskThreadPool,
+            mGameParameters,
+            &mShipFactoryCache,
+            &mShipLoadTaskThreadPool);
+
+        if (asyncShipLoad.IsCancelled)
+            return;
+
+        // Hand over to the main thread, which will also upload the texture
+
+        std::lock_guard const lock{ asyncShipLoad.Mutex };
+
+        asyncShipLoad.Ship = std::move(ship);
+        asyncShipLoad.TextureImage.emplace(std::move(textureImage));
+        asyncShipLoad.Metadata.emplace(shipMetadata);
+        asyncShipLoad.Progress = 0.9f;
+        asyncShipLoad.ProgressMessage = ProgressMessageType::BuildingShip;
+        asyncShipLoad.IsProgressChanged = true;
+        asyncShipLoad.IsCompleted = true;
+    }
+    catch (...)
+    {
+        std::lock_guard const lock{ asyncShipLoad.Mutex };
+
+        asyncShipLoad.Error = std::current_exception();
+        asyncShipLoad.IsCompleted = true;
+    }
+}
+
+void GameController::CancelShipLoadAndWait()
+{
+    CancelShipLoad();
+
+    // Wait until the ship load thread is done with whatever it's doing - even
+    // with loads cancelled earlier on
+    mShipLoadThread->QueueSynchronizationPoint()->Wait();
+}
+
+void GameController::UpdateAsyncShipLoad()
+{
+    if (!mAsyncShipLoad)
+        return;
+
+    // Keep it alive, as callbacks might start other loads
+    auto const asyncShipLoad = mAsyncShipLoad;
+
+    std::optional<std::tuple<float, ProgressMessageType>> progress;
+    bool isCompleted;
+
+    {
+        std::lock_guard const lock{ asyncShipLoad->Mutex };
+
+        if (asyncShipLoad->IsProgressChanged)
+        {
+            progress.emplace(asyncShipLoad->Progress, asyncShipLoad->ProgressMessage);
+            asyncShipLoad->IsProgressChanged = false;
+        }
+
+        isCompleted = asyncShipLoad->IsCompleted;
+    }
+
+    if (progress.has_value() && asyncShipLoad->Callbacks.OnProgress)
+    {
+        asyncShipLoad->Callbacks.OnProgress(std::get<0>(*progress), std::get<1>(*progress));
+    }
+
+    if (!isCompleted)
+        return;
+
+    //
+    // The ship load thread is done with it
+    //
+
+    mAsyncShipLoad.reset();
+
+    if (asyncShipLoad->Error)
+    {
+        if (asyncShipLoad->Callbacks.OnShipLoadFailed)
+            asyncShipLoad->Callbacks.OnShipLoadFailed(asyncShipLoad->Error);
+
+        return;
+    }
+
+    assert(!!asyncShipLoad->NewWorld && !!asyncShipLoad->Ship && asyncShipLoad->TextureImage.has_value() && asyncShipLoad->Metadata.has_value());
+
+    try
+    {
+        // Validate ship's texture before we get rid of the current world
+        mRenderContext->ValidateShipTexture(*asyncShipLoad->TextureImage);
+
+        if (asyncShipLoad->Callbacks.OnBeforeShipSwap)
+            asyncShipLoad->Callbacks.OnBeforeShipSwap();
+
+        Reset(std::move(asyncShipLoad->NewWorld));
+
+        InternalAddShip(
+            std::move(asyncShipLoad->Ship),
+            std::move(*asyncShipLoad->TextureImage),
+            *asyncShipLoad->Metadata);
+    }
+    catch (...)
+    {
+        if (asyncShipLoad->Callbacks.OnShipLoadFailed)
+            asyncShipLoad->Callbacks.OnShipLoadFailed(std::current_exception());
+
+        return;
+    }
+
+    if (asyncShipLoad->Callbacks.OnShipLoaded)
+        asyncShipLoad->Callbacks.OnShipLoaded(*asyncShipLoad->Metadata);
+}
+
 void GameController::Reset(std::unique_ptr<Physics::World> newWorld)
 {
+    // Wait for pending render tasks, as they might still hold
+    // snapshots allocated by the old world
+    mRenderContext->WaitForPendingTasks();
+
     // Reset world
     assert(!!mWorld);
     mWorld = std::move(newWorld);
+    mShipTextureImages.clear();
+
+    // The quick-save and the snapshot history are of the old world
+    mQuickSave.reset();
+    ClearSnapshotHistory();
 
     // Set event recorder (if any)
     mWorld->SetEventRecorder(mEventRecorder.get());
@@ -1471,6 +2088,15 @@ void GameController::InternalAddShip(
     // Set recorder in ship (if any)
     ship->SetEventRecorder(mEventRecorder.get());
 
+    LogMessage("Memory: ", ship->GetMemoryReport().ToString());
+
+    // Remember texture, in case the ship's fragments need it
+    assert(mShipTextureImages.size() == static_cast<size_t>(shipId));
+    if (mGameParameters.DoSplitDetachedFragments)
+        mShipTextureImages.emplace_back(textureImage.Clone());
+    else
+        mShipTextureImages.emplace_back();
+
     // Add ship to our world
     mWorld->AddShip(std::move(ship));
 
@@ -1481,7 +2107,7 @@ void GameController::InternalAddShip(
         std::move(textureImage));
 
     // Tell view manager
-    mViewManager.OnNewShip(mWorld->GetAllAABBs());
+    mViewManager.OnNewShip(mWorld->GetAllShipsAABB());
 
     // Notify ship load
     mGameEventDispatcher->OnShipLoaded(
@@ -1492,9 +2118,93 @@ void GameController::InternalAddShip(
     mWorld->Announce();
 }
 
+void GameController::UpdateSnapshotHistory()
+{
+    if (!mIsSnapshotHistoryEnabled)
+        return;
+
+    assert(!!mWorld);
+    float const currentSimulationTime = mWorld->GetCurrentSimulationTime();
+    if (currentSimulationTime - mLastSnapshotHistorySimulationTime < SnapshotHistoryInterval)
+        return;
+
+    // Taking the snapshot is just a copy; its encoding happens on the history's own thread
+    mSnapshotHistory.Push(currentSimulationTime, mWorld->TakeSnapshot());
+    mLastSnapshotHistorySimulationTime = currentSimulationTime;
+}
+
+void GameController::ClearSnapshotHistory()
+{
+    mSnapshotHistory.Clear();
+    mLastSnapshotHistorySimulationTime = std::numeric_limits<float>::lowest();
+}
+
+void GameController::SplitDetachedFragments()
+{
+    bool hasSplit = false;
+
+    // Note: we only visit the ships we have now; fragments are not split further
+    // in the same iteration
+    size_t const shipCount = mShipTextureImages.size();
+    for (size_t s = 0; s < shipCount; ++s)
+    {
+        ShipId const shipId = static_cast<ShipId>(s);
+
+        if (!mShipTextureImages[s].has_value()
+            || !mWorld->HasDetachedFragments(shipId, GameParameters::MinDetachedFragmentPointCount))
+        {
+            continue;
+        }
+
+        // Wait for pending render tasks, as they might still hold
+        // snapshots allocated by the ship being split
+        mRenderContext->WaitForPendingTasks();
+
+        auto const newShipIds = mWorld->SplitDetachedFragments(
+            shipId,
+            GameParameters::MinDetachedFragmentPointCount,
+            mGameParameters);
+
+        assert(!newShipIds.empty());
+        hasSplit = true;
+
+        // Replace ship in rendering engine
+        mRenderContext->ReplaceShip(
+            shipId,
+            mWorld->GetShipPointCount(shipId),
+            mShipTextureImages[s]->Clone());
+
+        // Add the fragments
+        for (ShipId const newShipId : newShipIds)
+        {
+            assert(mShipTextureImages.size() == static_cast<size_t>(newShipId));
+            mShipTextureImages.emplace_back(mShipTextureImages[s]->Clone());
+
+            mRenderContext->AddShip(
+                newShipId,
+                mWorld->GetShipPointCount(newShipId),
+                mShipTextureImages[s]->Clone());
+        }
+
+        // Notify
+        mGameEventDispatcher->OnShipSplit(shipId);
+    }
+
+    if (hasSplit)
+    {
+        // The quick-save and the snapshot history are of the ships as they were
+        mQuickSave.reset();
+        ClearSnapshotHistory();
+
+        // Announce
+        mWorld->Announce();
+    }
+}
+
 void GameController::PublishStats(std::chrono::steady_clock::time_point nowReal)
 {
-    PerfStats const lastDeltaPerfStats = *mTotalPerfStats - mLastPublishedTotalPerfStats;
+    mLastDeltaPerfStats = *mTotalPerfStats - mLastPublishedTotalPerfStats;
+    PerfStats const & lastDeltaPerfStats = mLastDeltaPerfStats;
     uint64_t const lastDeltaFrameCount = mTotalFrameCount - mLastPublishedTotalFrameCount;
 
     // Calculate fps
@@ -1520,6 +2230,14 @@ void GameController::PublishStats(std::chrono::steady_clock::time_point nowReal)
     assert(!!mGameEventDispatcher);
     mGameEventDispatcher->OnCurrentUpdateDurationUpdated(lastDeltaPerfStats.TotalUpdateDuration.ToRatio<std::chrono::milliseconds>());
 
+    // Stream telemetry
+    if (mTelemetrySink.IsStarted())
+    {
+        mTelemetrySink.RecordPerfStats(lastDeltaPerfStats);
+        mTelemetrySink.RecordProfilerZones();
+        mTelemetrySink.Flush();
+    }
+
     // Update status text
     mNotificationLayer.SetStatusTexts(
         lastFps,
@@ -1528,6 +2246,7 @@ void GameController::PublishStats(std::chrono::steady_clock::time_point nowReal)
         *mTotalPerfStats,
         std::chrono::duration<float>(GameWallClock::GetInstance().Now() - mOriginTimestampGame),
         mIsPaused,
+        mGameParameters.SimulationDegradationLevel,
         mRenderContext->GetZoom(),
         mRenderContext->GetCameraWorldPosition(),
         mRenderContext->GetStatistics());
@@ -19,9 +19,13 @@
 #include "RenderContext.h"
 #include "RenderDeviceProperties.h"
 #include "ResourceLocator.h"
+#include "ShipDefinition.h"
 #include "ShipFactory.h"
+#include "ShipLoadCallbacks.h"
 #include "ShipLoadSpecifications.h"
 #include "ShipMetadata.h"
+#include "SimulationGovernor.h"
+#include "TelemetrySink.h"
 #include "ViewManager.h"
 
 #include <GameCore/Colors.h>
@@ -31,15 +35,19 @@
 #include <GameCore/ImageData.h>
 #include <GameCore/ParameterSmoother.h>
 #include <GameCore/ProgressCallback.h>
+#include <GameCore/SnapshotHistory.h>
+#include <GameCore/TaskThread.h>
 #include <GameCore/TaskThreadPool.h>
 #include <GameCore/Vectors.h>
 
 #include <algorithm>
+#include <atomic>
 #include <cassert>
 #include <chrono>
 #include <filesystem>
 #include <functional>
 #include <memory>
+#include <mutex>
 #include <optional>
 #include <string>
 #include <vector>
@@ -91,10 +99,12 @@ public:
         mGameEventDispatcher->RegisterLifecycleEventHandler(handler);
     }
 
-    void RegisterStructuralEventHandler(IStructuralGameEventHandler * handler) override
+    void RegisterStructuralEventHandler(
+        IStructuralGameEventHandler * handler,
+        std::uint32_t eventMask = StructuralGameEventMask::All) override
     {
         assert(!!mGameEventDispatcher);
-        mGameEventDispatcher->RegisterStructuralEventHandler(handler);
+        mGameEventDispatcher->RegisterStructuralEventHandler(handler, eventMask);
     }
 
     void RegisterWavePhenomenaEventHandler(IWavePhenomenaGameEventHandler * handler) override
@@ -139,6 +149,30 @@ public:
     ShipMetadata ResetAndReloadShip(ShipLoadSpecifications const & loadSpecs) override;
     ShipMetadata AddShip(ShipLoadSpecifications const & loadSpecs) override;
 
+    void ResetAndLoadShipAsync(
+        ShipLoadSpecifications const & loadSpecs,
+        ShipLoadCallbacks && callbacks) override;
+    void CancelShipLoad() override;
+    bool IsLoadingShip() const override { return !!mAsyncShipLoad; }
+
+    void QuickSave() override;
+    void QuickSaveToFile(std::filesystem::path const & filePath) override;
+    bool HasQuickSave() const override { return !!mQuickSave; }
+    void QuickLoad() override;
+    void QuickLoadFromFile(std::filesystem::path const & filePath) override;
+
+    bool GetSnapshotHistoryEnabled() const override { return mIsSnapshotHistoryEnabled; }
+    void SetSnapshotHistoryEnabled(bool value) override;
+    size_t GetSnapshotHistoryMaxByteSize() const override { return mSnapshotHistoryMaxByteSize; }
+    void SetSnapshotHistoryMaxByteSize(size_t value) override;
+    size_t GetSnapshotHistoryFrameCount() const override { return mSnapshotHistory.GetFrameCount(); }
+    float GetSnapshotHistoryFrameSimulationTime(size_t frameIndex) const override { return mSnapshotHistory.GetFrameSimulationTime(frameIndex); }
+    void ScrubToSnapshotHistoryFrame(size_t frameIndex) override;
+
+    bool IsTelemetryStarted() const override { return mTelemetrySink.IsStarted(); }
+    void StartTelemetry(std::filesystem::path const & outputFilePath) override { mTelemetrySink.Start(outputFilePath); }
+    void StopTelemetry() override { mTelemetrySink.Stop(); }
+
     RgbImageData TakeScreenshot() override;
 
     void RunGameIteration() override;
@@ -149,6 +183,11 @@ public:
         mIsPulseUpdateSet = true;
     }
 
+    void RequestRender() override
+    {
+        mIsRenderRequested = true;
+    }
+
     void StartRecordingEvents(std::function<void(uint32_t, RecordedEvent const &)> onEventCallback) override;
     RecordedEvents StopRecordingEvents() override;
     void ReplayRecordedEvent(RecordedEvent const & event) override;
@@ -242,6 +281,9 @@ public:
     bool DestroyTriangle(ElementId triangleId) override;
     bool RestoreTriangle(ElementId triangleId) override;
 
+    std::vector<ShipMemoryReport> GetShipMemoryReports() const override;
+    std::vector<std::string> GetShipPerfReports() const override;
+
     //
     // Render controls
     //
@@ -274,7 +316,7 @@ public:
     void SetDoShowTsunamiNotifications(bool value) override { mDoShowTsunamiNotifications = value; }
 
     bool GetDoShowElectricalNotifications() const override { return mGameParameters.DoShowElectricalNotifications; }
-    void SetDoShowElectricalNotifications(bool value) override { mGameParameters.DoShowElectricalNotifications = value; }
+    void SetDoShowElectricalNotifications(bool value) override { mGameParameters.DoShowElectricalNotifications = value; ++mGameParameters.Generation; }
 
     UnitsSystem GetDisplayUnitsSystem() const override { return mRenderContext->GetDisplayUnitsSystem(); }
     void SetDisplayUnitsSystem(UnitsSystem value) override { mRenderContext->SetDisplayUnitsSystem(value); mNotificationLayer.SetDisplayUnitsSystem(value); }
@@ -299,9 +341,10 @@ public:
     //
 
     float GetSimulationStepTimeDuration() const override { return GameParameters::SimulationStepTimeDuration<float>; }
+    float GetGameIterationTimeDuration() const override;
 
     float GetNumMechanicalDynamicsIterationsAdjustment() const override { return mGameParameters.NumMechanicalDynamicsIterationsAdjustment; }
-    void SetNumMechanicalDynamicsIterationsAdjustment(float value) override { mGameParameters.NumMechanicalDynamicsIterationsAdjustment = value; }
+    void SetNumMechanicalDynamicsIterationsAdjustment(float value) override { mGameParameters.NumMechanicalDynamicsIterationsAdjustment = value; ++mGameParameters.Generation; }
     float GetMinNumMechanicalDynamicsIterationsAdjustment() const override { return GameParameters::MinNumMechanicalDynamicsIterationsAdjustment; }
     float GetMaxNumMechanicalDynamicsIterationsAdjustment() const override { return GameParameters::MaxNumMechanicalDynamicsIterationsAdjustment; }
 
@@ -311,7 +354,7 @@ public:
     float GetMaxSpringStiffnessAdjustment() const override { return GameParameters::MaxSpringStiffnessAdjustment; }
 
     float GetSpringDampingAdjustment() const override { return mGameParameters.SpringDampingAdjustment; }
-    void SetSpringDampingAdjustment(float value) override { mGameParameters.SpringDampingAdjustment = value; }
+    void SetSpringDampingAdjustment(float value) override { mGameParameters.SpringDampingAdjustment = value; ++mGameParameters.Generation; }
     float GetMinSpringDampingAdjustment() const override { return GameParameters::MinSpringDampingAdjustment; }
     float GetMaxSpringDampingAdjustment() const override { return GameParameters::MaxSpringDampingAdjustment; }
 
@@ -321,99 +364,99 @@ public:
     float GetMaxSpringStrengthAdjustment() const override { return GameParameters::MaxSpringStrengthAdjustment; }
 
     float GetGlobalDampingAdjustment() const override { return mGameParameters.GlobalDampingAdjustment; }
-    void SetGlobalDampingAdjustment(float value) override { mGameParameters.GlobalDampingAdjustment = value; }
+    void SetGlobalDampingAdjustment(float value) override { mGameParameters.GlobalDampingAdjustment = value; ++mGameParameters.Generation; }
     float GetMinGlobalDampingAdjustment() const override { return GameParameters::MinGlobalDampingAdjustment; }
     float GetMaxGlobalDampingAdjustment() const override { return GameParameters::MaxGlobalDampingAdjustment; }
 
     float GetRotAcceler8r() const override { return mGameParameters.RotAcceler8r; }
-    void SetRotAcceler8r(float value) override { mGameParameters.RotAcceler8r = value; }
+    void SetRotAcceler8r(float value) override { mGameParameters.RotAcceler8r = value; ++mGameParameters.Generation; }
     float GetMinRotAcceler8r() const override { return GameParameters::MinRotAcceler8r; }
     float GetMaxRotAcceler8r() const override { return GameParameters::MaxRotAcceler8r; }
 
     float GetStaticPressureForceAdjustment() const override { return mGameParameters.StaticPressureForceAdjustment; }
-    void SetStaticPressureForceAdjustment(float value) override { mGameParameters.StaticPressureForceAdjustment = value; }
+    void SetStaticPressureForceAdjustment(float value) override { mGameParameters.StaticPressureForceAdjustment = value; ++mGameParameters.Generation; }
     float GetMinStaticPressureForceAdjustment() const override { return GameParameters::MinStaticPressureForceAdjustment; }
     float GetMaxStaticPressureForceAdjustment() const override { return GameParameters::MaxStaticPressureForceAdjustment; }
 
     // Air
 
     float GetAirDensityAdjustment() const override { return mGameParameters.AirDensityAdjustment; }
-    void SetAirDensityAdjustment(float value) override { mGameParameters.AirDensityAdjustment = value; }
+    void SetAirDensityAdjustment(float value) override { mGameParameters.AirDensityAdjustment = value; ++mGameParameters.Generation; }
     float GetMinAirDensityAdjustment() const override { return GameParameters::MinAirDensityAdjustment; }
     float GetMaxAirDensityAdjustment() const override { return GameParameters::MaxAirDensityAdjustment; }
 
     float GetAirFrictionDragAdjustment() const override { return mGameParameters.AirFrictionDragAdjustment; }
-    void SetAirFrictionDragAdjustment(float value) override { mGameParameters.AirFrictionDragAdjustment = value; }
+    void SetAirFrictionDragAdjustment(float value) override { mGameParameters.AirFrictionDragAdjustment = value; ++mGameParameters.Generation; }
     float GetMinAirFrictionDragAdjustment() const override { return GameParameters::MinAirFrictionDragAdjustment; }
     float GetMaxAirFrictionDragAdjustment() const override { return GameParameters::MaxAirFrictionDragAdjustment; }
 
     float GetAirPressureDragAdjustment() const override { return mGameParameters.AirPressureDragAdjustment; }
-    void SetAirPressureDragAdjustment(float value) override { mGameParameters.AirPressureDragAdjustment = value; }
+    void SetAirPressureDragAdjustment(float value) override { mGameParameters.AirPressureDragAdjustment = value; ++mGameParameters.Generation; }
     float GetMinAirPressureDragAdjustment() const override { return GameParameters::MinAirPressureDragAdjustment; }
     float GetMaxAirPressureDragAdjustment() const override { return GameParameters::MaxAirPressureDragAdjustment; }
 
     // Water
 
     float GetWaterDensityAdjustment() const override { return mGameParameters.WaterDensityAdjustment; }
-    void SetWaterDensityAdjustment(float value) override { mGameParameters.WaterDensityAdjustment = value; }
+    void SetWaterDensityAdjustment(float value) override { mGameParameters.WaterDensityAdjustment = value; ++mGameParameters.Generation; }
     float GetMinWaterDensityAdjustment() const override { return GameParameters::MinWaterDensityAdjustment; }
     float GetMaxWaterDensityAdjustment() const override { return GameParameters::MaxWaterDensityAdjustment; }
 
     float GetWaterFrictionDragAdjustment() const override { return mGameParameters.WaterFrictionDragAdjustment; }
-    void SetWaterFrictionDragAdjustment(float value) override { mGameParameters.WaterFrictionDragAdjustment = value; }
+    void SetWaterFrictionDragAdjustment(float value) override { mGameParameters.WaterFrictionDragAdjustment = value; ++mGameParameters.Generation; }
     float GetMinWaterFrictionDragAdjustment() const override { return GameParameters::MinWaterFrictionDragAdjustment; }
     float GetMaxWaterFrictionDragAdjustment() const override { return GameParameters::MaxWaterFrictionDragAdjustment; }
 
     float GetWaterPressureDragAdjustment() const override { return mGameParameters.WaterPressureDragAdjustment; }
-    void SetWaterPressureDragAdjustment(float value) override { mGameParameters.WaterPressureDragAdjustment = value; }
+    void SetWaterPressureDragAdjustment(float value) override { mGameParameters.WaterPressureDragAdjustment = value; ++mGameParameters.Generation; }
     float GetMinWaterPressureDragAdjustment() const override { return GameParameters::MinWaterPressureDragAdjustment; }
     float GetMaxWaterPressureDragAdjustment() const override { return GameParameters::MaxWaterPressureDragAdjustment; }
 
     float GetWaterImpactForceAdjustment() const override { return mGameParameters.WaterImpactForceAdjustment; }
-    void SetWaterImpactForceAdjustment(float value) override { mGameParameters.WaterImpactForceAdjustment = value; }
+    void SetWaterImpactForceAdjustment(float value) override { mGameParameters.WaterImpactForceAdjustment = value; ++mGameParameters.Generation; }
     float GetMinWaterImpactForceAdjustment() const override { return GameParameters::MinWaterImpactForceAdjustment; }
     float GetMaxWaterImpactForceAdjustment() const override { return GameParameters::MaxWaterImpactForceAdjustment; }
 
     float GetHydrostaticPressureCounterbalanceAdjustment() const override { return mGameParameters.HydrostaticPressureCounterbalanceAdjustment; }
-    void SetHydrostaticPressureCounterbalanceAdjustment(float value) override { mGameParameters.HydrostaticPressureCounterbalanceAdjustment = value; }
+    void SetHydrostaticPressureCounterbalanceAdjustment(float value) override { mGameParameters.HydrostaticPressureCounterbalanceAdjustment = value; ++mGameParameters.Generation; }
     float GetMinHydrostaticPressureCounterbalanceAdjustment() const override { return GameParameters::MinHydrostaticPressureCounterbalanceAdjustment; }
     float GetMaxHydrostaticPressureCounterbalanceAdjustment() const override { return GameParameters::MaxHydrostaticPressureCounterbalanceAdjustment; }
 
     float GetWaterIntakeAdjustment() const override { return mGameParameters.WaterIntakeAdjustment; }
-    void SetWaterIntakeAdjustment(float value) override { mGameParameters.WaterIntakeAdjustment = value; }
+    void SetWaterIntakeAdjustment(float value) override { mGameParameters.WaterIntakeAdjustment = value; ++mGameParameters.Generation; }
     float GetMinWaterIntakeAdjustment() const override { return GameParameters::MinWaterIntakeAdjustment; }
     float GetMaxWaterIntakeAdjustment() const override { return GameParameters::MaxWaterIntakeAdjustment; }
 
     float GetWaterDiffusionSpeedAdjustment() const override { return mGameParameters.WaterDiffusionSpeedAdjustment; }
-    void SetWaterDiffusionSpeedAdjustment(float value) override { mGameParameters.WaterDiffusionSpeedAdjustment = value; }
+    void SetWaterDiffusionSpeedAdjustment(float value) override { mGameParameters.WaterDiffusionSpeedAdjustment = value; ++mGameParameters.Generation; }
     float GetMinWaterDiffusionSpeedAdjustment() const override { return GameParameters::MinWaterDiffusionSpeedAdjustment; }
     float GetMaxWaterDiffusionSpeedAdjustment() const override { return GameParameters::MaxWaterDiffusionSpeedAdjustment; }
 
     float GetWaterCrazyness() const override { return mGameParameters.WaterCrazyness; }
-    void SetWaterCrazyness(float value) override { mGameParameters.WaterCrazyness = value; }
+    void SetWaterCrazyness(float value) override { mGameParameters.WaterCrazyness = value; ++mGameParameters.Generation; }
     float GetMinWaterCrazyness() const override { return GameParameters::MinWaterCrazyness; }
     float GetMaxWaterCrazyness() const override { return GameParameters::MaxWaterCrazyness; }
 
     float GetSmokeEmissionDensityAdjustment() const override { return mGameParameters.SmokeEmissionDensityAdjustment; }
-    void SetSmokeEmissionDensityAdjustment(float value) override { mGameParameters.SmokeEmissionDensityAdjustment = value; }
+    void SetSmokeEmissionDensityAdjustment(float value) override { mGameParameters.SmokeEmissionDensityAdjustment = value; ++mGameParameters.Generation; }
     float GetMinSmokeEmissionDensityAdjustment() const override { return GameParameters::MinSmokeEmissionDensityAdjustment; }
     float GetMaxSmokeEmissionDensityAdjustment() const override { return GameParameters::MaxSmokeEmissionDensityAdjustment; }
 
     float GetSmokeParticleLifetimeAdjustment() const override { return mGameParameters.SmokeParticleLifetimeAdjustment; }
-    void SetSmokeParticleLifetimeAdjustment(float value) override { mGameParameters.SmokeParticleLifetimeAdjustment = value; }
+    void SetSmokeParticleLifetimeAdjustment(float value) override { mGameParameters.SmokeParticleLifetimeAdjustment = value; ++mGameParameters.Generation; }
     float GetMinSmokeParticleLifetimeAdjustment() const override { return GameParameters::MinSmokeParticleLifetimeAdjustment; }
     float GetMaxSmokeParticleLifetimeAdjustment() const override { return GameParameters::MaxSmokeParticleLifetimeAdjustment; }
 
     bool GetDoModulateWind() const override { return mGameParameters.DoModulateWind; }
-    void SetDoModulateWind(bool value) override { mGameParameters.DoModulateWind = value; }
+    void SetDoModulateWind(bool value) override { mGameParameters.DoModulateWind = value; ++mGameParameters.Generation; }
 
     float GetWindSpeedBase() const override { return mGameParameters.WindSpeedBase; }
-    void SetWindSpeedBase(float value) override { mGameParameters.WindSpeedBase = value; }
+    void SetWindSpeedBase(float value) override { mGameParameters.WindSpeedBase = value; ++mGameParameters.Generation; }
     float GetMinWindSpeedBase() const override { return GameParameters::MinWindSpeedBase; }
     float GetMaxWindSpeedBase() const override { return GameParameters::MaxWindSpeedBase; }
 
     float GetWindSpeedMaxFactor() const override { return mGameParameters.WindSpeedMaxFactor; }
-    void SetWindSpeedMaxFactor(float value) override { mGameParameters.WindSpeedMaxFactor = value; }
+    void SetWindSpeedMaxFactor(float value) override { mGameParameters.WindSpeedMaxFactor = value; ++mGameParameters.Generation; }
     float GetMinWindSpeedMaxFactor() const override { return GameParameters::MinWindSpeedMaxFactor; }
     float GetMaxWindSpeedMaxFactor() const override { return GameParameters::MaxWindSpeedMaxFactor; }
 
@@ -423,147 +466,147 @@ public:
     float GetMaxBasalWaveHeightAdjustment() const override { return GameParameters::MaxBasalWaveHeightAdjustment; }
 
     float GetBasalWaveLengthAdjustment() const override { return mGameParameters.BasalWaveLengthAdjustment; }
-    void SetBasalWaveLengthAdjustment(float value) override { mGameParameters.BasalWaveLengthAdjustment = value; }
+    void SetBasalWaveLengthAdjustment(float value) override { mGameParameters.BasalWaveLengthAdjustment = value; ++mGameParameters.Generation; }
     float GetMinBasalWaveLengthAdjustment() const override { return GameParameters::MinBasalWaveLengthAdjustment; }
     float GetMaxBasalWaveLengthAdjustment() const override { return GameParameters::MaxBasalWaveLengthAdjustment; }
 
     float GetBasalWaveSpeedAdjustment() const override { return mGameParameters.BasalWaveSpeedAdjustment; }
-    void SetBasalWaveSpeedAdjustment(float value) override { mGameParameters.BasalWaveSpeedAdjustment = value; }
+    void SetBasalWaveSpeedAdjustment(float value) override { mGameParameters.BasalWaveSpeedAdjustment = value; ++mGameParameters.Generation; }
     float GetMinBasalWaveSpeedAdjustment() const override { return GameParameters::MinBasalWaveSpeedAdjustment; }
     float GetMaxBasalWaveSpeedAdjustment() const override { return GameParameters::MaxBasalWaveSpeedAdjustment; }
 
     std::chrono::minutes GetTsunamiRate() const override { return mGameParameters.TsunamiRate; }
-    void SetTsunamiRate(std::chrono::minutes value) override { mGameParameters.TsunamiRate = value; }
+    void SetTsunamiRate(std::chrono::minutes value) override { mGameParameters.TsunamiRate = value; ++mGameParameters.Generation; }
     std::chrono::minutes GetMinTsunamiRate() const override { return GameParameters::MinTsunamiRate; }
     std::chrono::minutes GetMaxTsunamiRate() const override { return GameParameters::MaxTsunamiRate; }
 
     std::chrono::seconds GetRogueWaveRate() const override { return mGameParameters.RogueWaveRate; }
-    void SetRogueWaveRate(std::chrono::seconds value) override { mGameParameters.RogueWaveRate = value; }
+    void SetRogueWaveRate(std::chrono::seconds value) override { mGameParameters.RogueWaveRate = value; ++mGameParameters.Generation; }
     std::chrono::seconds GetMinRogueWaveRate() const override { return GameParameters::MinRogueWaveRate; }
     std::chrono::seconds GetMaxRogueWaveRate() const override { return GameParameters::MaxRogueWaveRate; }
 
     bool GetDoDisplaceWater() const override { return mGameParameters.DoDisplaceWater; }
-    void SetDoDisplaceWater(bool value) override { mGameParameters.DoDisplaceWater = value; }
+    void SetDoDisplaceWater(bool value) override { mGameParameters.DoDisplaceWater = value; ++mGameParameters.Generation; }
 
     float GetWaterDisplacementWaveHeightAdjustment() const override { return mGameParameters.WaterDisplacementWaveHeightAdjustment; }
-    void SetWaterDisplacementWaveHeightAdjustment(float value) override { mGameParameters.WaterDisplacementWaveHeightAdjustment = value; }
+    void SetWaterDisplacementWaveHeightAdjustment(float value) override { mGameParameters.WaterDisplacementWaveHeightAdjustment = value; ++mGameParameters.Generation; }
     float GetMinWaterDisplacementWaveHeightAdjustment() const override { return GameParameters::MinWaterDisplacementWaveHeightAdjustment; }
     float GetMaxWaterDisplacementWaveHeightAdjustment() const override { return GameParameters::MaxWaterDisplacementWaveHeightAdjustment; }
 
     float GetWaveSmoothnessAdjustment() const override { return mGameParameters.WaveSmoothnessAdjustment; }
-    void SetWaveSmoothnessAdjustment(float value) override { mGameParameters.WaveSmoothnessAdjustment = value; }
+    void SetWaveSmoothnessAdjustment(float value) override { mGameParameters.WaveSmoothnessAdjustment = value; ++mGameParameters.Generation; }
     float GetMinWaveSmoothnessAdjustment() const override { return GameParameters::MinWaveSmoothnessAdjustment; }
     float GetMaxWaveSmoothnessAdjustment() const override { return GameParameters::MaxWaveSmoothnessAdjustment; }
 
     // Storm
 
     std::chrono::minutes GetStormRate() const override { return mGameParameters.StormRate; }
-    void SetStormRate(std::chrono::minutes value) override { mGameParameters.StormRate = value; }
+    void SetStormRate(std::chrono::minutes value) override { mGameParameters.StormRate = value; ++mGameParameters.Generation; }
     std::chrono::minutes GetMinStormRate() const override { return GameParameters::MinStormRate; }
     std::chrono::minutes GetMaxStormRate() const override { return GameParameters::MaxStormRate; }
 
     std::chrono::seconds GetStormDuration() const override { return mGameParameters.StormDuration; }
-    void SetStormDuration(std::chrono::seconds value) override { mGameParameters.StormDuration = value; }
+    void SetStormDuration(std::chrono::seconds value) override { mGameParameters.StormDuration = value; ++mGameParameters.Generation; }
     std::chrono::seconds GetMinStormDuration() const override { return GameParameters::MinStormDuration; }
     std::chrono::seconds GetMaxStormDuration() const override { return GameParameters::MaxStormDuration; }
 
     float GetStormStrengthAdjustment() const override { return mGameParameters.StormStrengthAdjustment; }
-    void SetStormStrengthAdjustment(float value) override { mGameParameters.StormStrengthAdjustment = value; }
+    void SetStormStrengthAdjustment(float value) override { mGameParameters.StormStrengthAdjustment = value; ++mGameParameters.Generation; }
     float GetMinStormStrengthAdjustment() const override { return GameParameters::MinStormStrengthAdjustment; }
     float GetMaxStormStrengthAdjustment() const override { return GameParameters::MaxStormStrengthAdjustment; }
 
     bool GetDoRainWithStorm() const override { return mGameParameters.DoRainWithStorm; }
-    void SetDoRainWithStorm(bool value) override { mGameParameters.DoRainWithStorm = value; }
+    void SetDoRainWithStorm(bool value) override { mGameParameters.DoRainWithStorm = value; ++mGameParameters.Generation; }
 
     float GetRainFloodAdjustment() const override { return mGameParameters.RainFloodAdjustment; }
-    void SetRainFloodAdjustment(float value) override { mGameParameters.RainFloodAdjustment = value; }
+    void SetRainFloodAdjustment(float value) override { mGameParameters.RainFloodAdjustment = value; ++mGameParameters.Generation; }
     float GetMinRainFloodAdjustment() const override { return GameParameters::MinRainFloodAdjustment; }
     float GetMaxRainFloodAdjustment() const override { return GameParameters::MaxRainFloodAdjustment; }
 
     float GetLightningBlastProbability() const override { return mGameParameters.LightningBlastProbability; }
-    void SetLightningBlastProbability(float value) override { mGameParameters.LightningBlastProbability = value; }
+    void SetLightningBlastProbability(float value) override { mGameParameters.LightningBlastProbability = value; ++mGameParameters.Generation; }
 
     // Heat
 
     float GetAirTemperature() const override { return mGameParameters.AirTemperature; }
-    void SetAirTemperature(float value) override { mGameParameters.AirTemperature = value; }
+    void SetAirTemperature(float value) override { mGameParameters.AirTemperature = value; ++mGameParameters.Generation; }
     float GetMinAirTemperature() const override { return GameParameters::MinAirTemperature; }
     float GetMaxAirTemperature() const override { return GameParameters::MaxAirTemperature; }
 
     float GetWaterTemperature() const override { return mGameParameters.WaterTemperature; }
-    void SetWaterTemperature(float value) override { mGameParameters.WaterTemperature = value; }
+    void SetWaterTemperature(float value) override { mGameParameters.WaterTemperature = value; ++mGameParameters.Generation; }
     float GetMinWaterTemperature() const override { return GameParameters::MinWaterTemperature; }
     float GetMaxWaterTemperature() const override { return GameParameters::MaxWaterTemperature; }
 
     unsigned int GetMaxBurningParticles() const override { return mGameParameters.MaxBurningParticles; }
-    void SetMaxBurningParticles(unsigned int value) override { mGameParameters.MaxBurningParticles = value; }
+    void SetMaxBurningParticles(unsigned int value) override { mGameParameters.MaxBurningParticles = value; ++mGameParameters.Generation; }
     unsigned int GetMinMaxBurningParticles() const override { return GameParameters::MinMaxBurningParticles; }
     unsigned int GetMaxMaxBurningParticles() const override { return GameParameters::MaxMaxBurningParticles; }
 
     float GetThermalConductivityAdjustment() const override { return mGameParameters.ThermalConductivityAdjustment; }
-    void SetThermalConductivityAdjustment(float value) override { mGameParameters.ThermalConductivityAdjustment = value; }
+    void SetThermalConductivityAdjustment(float value) override { mGameParameters.ThermalConductivityAdjustment = value; ++mGameParameters.Generation; }
     float GetMinThermalConductivityAdjustment() const override { return GameParameters::MinThermalConductivityAdjustment; }
     float GetMaxThermalConductivityAdjustment() const override { return GameParameters::MaxThermalConductivityAdjustment; }
 
     float GetHeatDissipationAdjustment() const override { return mGameParameters.HeatDissipationAdjustment; }
-    void SetHeatDissipationAdjustment(float value) override { mGameParameters.HeatDissipationAdjustment = value; }
+    void SetHeatDissipationAdjustment(float value) override { mGameParameters.HeatDissipationAdjustment = value; ++mGameParameters.Generation; }
     float GetMinHeatDissipationAdjustment() const override { return GameParameters::MinHeatDissipationAdjustment; }
     float GetMaxHeatDissipationAdjustment() const override { return GameParameters::MaxHeatDissipationAdjustment; }
 
     float GetIgnitionTemperatureAdjustment() const override { return mGameParameters.IgnitionTemperatureAdjustment; }
-    void SetIgnitionTemperatureAdjustment(float value) override { mGameParameters.IgnitionTemperatureAdjustment = value; }
+    void SetIgnitionTemperatureAdjustment(float value) override { mGameParameters.IgnitionTemperatureAdjustment = value; ++mGameParameters.Generation; }
     float GetMinIgnitionTemperatureAdjustment() const override { return GameParameters::MinIgnitionTemperatureAdjustment; }
     float GetMaxIgnitionTemperatureAdjustment() const override { return GameParameters::MaxIgnitionTemperatureAdjustment; }
 
     float GetMeltingTemperatureAdjustment() const override { return mGameParameters.MeltingTemperatureAdjustment; }
-    void SetMeltingTemperatureAdjustment(float value) override { mGameParameters.MeltingTemperatureAdjustment = value; }
+    void SetMeltingTemperatureAdjustment(float value) override { mGameParameters.MeltingTemperatureAdjustment = value; ++mGameParameters.Generation; }
     float GetMinMeltingTemperatureAdjustment() const override { return GameParameters::MinMeltingTemperatureAdjustment; }
     float GetMaxMeltingTemperatureAdjustment() const override { return GameParameters::MaxMeltingTemperatureAdjustment; }
 
     float GetCombustionSpeedAdjustment() const override { return mGameParameters.CombustionSpeedAdjustment; }
-    void SetCombustionSpeedAdjustment(float value) override { mGameParameters.CombustionSpeedAdjustment = value; }
+    void SetCombustionSpeedAdjustment(float value) override { mGameParameters.CombustionSpeedAdjustment = value; ++mGameParameters.Generation; }
     float GetMinCombustionSpeedAdjustment() const override { return GameParameters::MinCombustionSpeedAdjustment; }
     float GetMaxCombustionSpeedAdjustment() const override { return GameParameters::MaxCombustionSpeedAdjustment; }
 
     float GetCombustionHeatAdjustment() const override { return mGameParameters.CombustionHeatAdjustment; }
-    void SetCombustionHeatAdjustment(float value) override { mGameParameters.CombustionHeatAdjustment = value; }
+    void SetCombustionHeatAdjustment(float value) override { mGameParameters.CombustionHeatAdjustment = value; ++mGameParameters.Generation; }
     float GetMinCombustionHeatAdjustment() const override { return GameParameters::MinCombustionHeatAdjustment; }
     float GetMaxCombustionHeatAdjustment() const override { return GameParameters::MaxCombustionHeatAdjustment; }
 
     float GetHeatBlasterHeatFlow() const override { return mGameParameters.HeatBlasterHeatFlow; }
-    void SetHeatBlasterHeatFlow(float value) override { mGameParameters.HeatBlasterHeatFlow = value; }
+    void SetHeatBlasterHeatFlow(float value) override { mGameParameters.HeatBlasterHeatFlow = value; ++mGameParameters.Generation; }
     float GetMinHeatBlasterHeatFlow() const override { return GameParameters::MinHeatBlasterHeatFlow; }
     float GetMaxHeatBlasterHeatFlow() const override { return GameParameters::MaxHeatBlasterHeatFlow; }
 
     float GetHeatBlasterRadius() const override { return mGameParameters.HeatBlasterRadius; }
-    void SetHeatBlasterRadius(float value) override { mGameParameters.HeatBlasterRadius = value; }
+    void SetHeatBlasterRadius(float value) override { mGameParameters.HeatBlasterRadius = value; ++mGameParameters.Generation; }
     float GetMinHeatBlasterRadius() const override { return GameParameters::MinHeatBlasterRadius; }
     float GetMaxHeatBlasterRadius() const override { return GameParameters::MaxHeatBlasterRadius; }
 
     float GetLaserRayHeatFlow() const override { return mGameParameters.LaserRayHeatFlow; }
-    void SetLaserRayHeatFlow(float value) override { mGameParameters.LaserRayHeatFlow = value; }
+    void SetLaserRayHeatFlow(float value) override { mGameParameters.LaserRayHeatFlow = value; ++mGameParameters.Generation; }
     float GetMinLaserRayHeatFlow() const override { return GameParameters::MinLaserRayHeatFlow; }
     float GetMaxLaserRayHeatFlow() const override { return GameParameters::MaxLaserRayHeatFlow; }
 
     float GetElectricalElementHeatProducedAdjustment() const override { return mGameParameters.ElectricalElementHeatProducedAdjustment; }
-    void SetElectricalElementHeatProducedAdjustment(float value) override { mGameParameters.ElectricalElementHeatProducedAdjustment = value; }
+    void SetElectricalElementHeatProducedAdjustment(float value) override { mGameParameters.ElectricalElementHeatProducedAdjustment = value; ++mGameParameters.Generation; }
     float GetMinElectricalElementHeatProducedAdjustment() const override { return GameParameters::MinElectricalElementHeatProducedAdjustment; }
     float GetMaxElectricalElementHeatProducedAdjustment() const override { return GameParameters::MaxElectricalElementHeatProducedAdjustment; }
 
     float GetEngineThrustAdjustment() const override { return mGameParameters.EngineThrustAdjustment; }
-    void SetEngineThrustAdjustment(float value) override { mGameParameters.EngineThrustAdjustment = value; }
+    void SetEngineThrustAdjustment(float value) override { mGameParameters.EngineThrustAdjustment = value; ++mGameParameters.Generation; }
     float GetMinEngineThrustAdjustment() const override { return GameParameters::MinEngineThrustAdjustment; }
     float GetMaxEngineThrustAdjustment() const override { return GameParameters::MaxEngineThrustAdjustment; }
 
     float GetWaterPumpPowerAdjustment() const override { return mGameParameters.WaterPumpPowerAdjustment; }
-    void SetWaterPumpPowerAdjustment(float value) override { mGameParameters.WaterPumpPowerAdjustment = value; }
+    void SetWaterPumpPowerAdjustment(float value) override { mGameParameters.WaterPumpPowerAdjustment = value; ++mGameParameters.Generation; }
     float GetMinWaterPumpPowerAdjustment() const override { return GameParameters::MinWaterPumpPowerAdjustment; }
     float GetMaxWaterPumpPowerAdjustment() const override { return GameParameters::MaxWaterPumpPowerAdjustment; }
 
     // Fishes
 
     unsigned int GetNumberOfFishes() const override { return mGameParameters.NumberOfFishes; }
-    void SetNumberOfFishes(unsigned int value) override { mGameParameters.NumberOfFishes = value; }
+    void SetNumberOfFishes(unsigned int value) override { mGameParameters.NumberOfFishes = value; ++mGameParameters.Generation; }
     unsigned int GetMinNumberOfFishes() const override { return GameParameters::MinNumberOfFishes; }
     unsigned int GetMaxNumberOfFishes() const override { return GameParameters::MaxNumberOfFishes; }
 
@@ -573,15 +616,15 @@ public:
     float GetMaxFishSizeMultiplier() const override { return GameParameters::MaxFishSizeMultiplier; }
 
     float GetFishSpeedAdjustment() const override { return mGameParameters.FishSpeedAdjustment; }
-    void SetFishSpeedAdjustment(float value) override { mGameParameters.FishSpeedAdjustment = value; }
+    void SetFishSpeedAdjustment(float value) override { mGameParameters.FishSpeedAdjustment = value; ++mGameParameters.Generation; }
     float GetMinFishSpeedAdjustment() const override { return GameParameters::MinFishSpeedAdjustment; }
     float GetMaxFishSpeedAdjustment() const override { return GameParameters::MaxFishSpeedAdjustment; }
 
     bool GetDoFishShoaling() const override { return mGameParameters.DoFishShoaling; }
-    void SetDoFishShoaling(bool value) override { mGameParameters.DoFishShoaling = value; }
+    void SetDoFishShoaling(bool value) override { mGameParameters.DoFishShoaling = value; ++mGameParameters.Generation; }
 
     float GetFishShoalRadiusAdjustment() const override { return mGameParameters.FishShoalRadiusAdjustment; }
-    void SetFishShoalRadiusAdjustment(float value) override { mGameParameters.FishShoalRadiusAdjustment = value; }
+    void SetFishShoalRadiusAdjustment(float value) override { mGameParameters.FishShoalRadiusAdjustment = value; ++mGameParameters.Generation; }
     float GetMinFishShoalRadiusAdjustment() const override { return GameParameters::MinFishShoalRadiusAdjustment; }
     float GetMaxFishShoalRadiusAdjustment() const override { return GameParameters::MaxFishShoalRadiusAdjustment; }
 
@@ -608,124 +651,124 @@ public:
     float GetMaxOceanFloorDetailAmplification() const override { return GameParameters::MaxOceanFloorDetailAmplification; }
 
     float GetOceanFloorElasticity() const override { return mGameParameters.OceanFloorElasticity; }
-    void SetOceanFloorElasticity(float value) override { mGameParameters.OceanFloorElasticity = value; }
+    void SetOceanFloorElasticity(float value) override { mGameParameters.OceanFloorElasticity = value; ++mGameParameters.Generation; }
     float GetMinOceanFloorElasticity() const override { return GameParameters::MinOceanFloorElasticity; }
     float GetMaxOceanFloorElasticity() const override { return GameParameters::MaxOceanFloorElasticity; }
 
     float GetOceanFloorFriction() const override { return mGameParameters.OceanFloorFriction; }
-    void SetOceanFloorFriction(float value) override { mGameParameters.OceanFloorFriction = value; }
+    void SetOceanFloorFriction(float value) override { mGameParameters.OceanFloorFriction = value; ++mGameParameters.Generation; }
     float GetMinOceanFloorFriction() const override { return GameParameters::MinOceanFloorFriction; }
     float GetMaxOceanFloorFriction() const override { return GameParameters::MaxOceanFloorFriction; }
 
     float GetOceanFloorSiltHardness() const override { return mGameParameters.OceanFloorSiltHardness; }
-    void SetOceanFloorSiltHardness(float value) override { mGameParameters.OceanFloorSiltHardness = value; }
+    void SetOceanFloorSiltHardness(float value) override { mGameParameters.OceanFloorSiltHardness = value; ++mGameParameters.Generation; }
     float GetMinOceanFloorSiltHardness() const override { return GameParameters::MinOceanFloorSiltHardness; }
     float GetMaxOceanFloorSiltHardness() const override { return GameParameters::MaxOceanFloorSiltHardness; }
 
     float GetDestroyRadius() const override { return mGameParameters.DestroyRadius; }
-    void SetDestroyRadius(float value) override { mGameParameters.DestroyRadius = value; }
+    void SetDestroyRadius(float value) override { mGameParameters.DestroyRadius = value; ++mGameParameters.Generation; }
     float GetMinDestroyRadius() const override { return GameParameters::MinDestroyRadius; }
     float GetMaxDestroyRadius() const override { return GameParameters::MaxDestroyRadius; }
 
     float GetRepairRadius() const override { return mGameParameters.RepairRadius; }
-    void SetRepairRadius(float value) override { mGameParameters.RepairRadius = value; }
+    void SetRepairRadius(float value) override { mGameParameters.RepairRadius = value; ++mGameParameters.Generation; }
     float GetMinRepairRadius() const override { return GameParameters::MinRepairRadius; }
     float GetMaxRepairRadius() const override { return GameParameters::MaxRepairRadius; }
 
     float GetRepairSpeedAdjustment() const override { return mGameParameters.RepairSpeedAdjustment; }
-    void SetRepairSpeedAdjustment(float value) override { mGameParameters.RepairSpeedAdjustment = value; }
+    void SetRepairSpeedAdjustment(float value) override { mGameParameters.RepairSpeedAdjustment = value; ++mGameParameters.Generation; }
     float GetMinRepairSpeedAdjustment() const override { return GameParameters::MinRepairSpeedAdjustment; }
     float GetMaxRepairSpeedAdjustment() const override { return GameParameters::MaxRepairSpeedAdjustment; }
 
     float GetBombBlastRadius() const override { return mGameParameters.BombBlastRadius; }
-    void SetBombBlastRadius(float value) override { mGameParameters.BombBlastRadius = value; }
+    void SetBombBlastRadius(float value) override { mGameParameters.BombBlastRadius = value; ++mGameParameters.Generation; }
     float GetMinBombBlastRadius() const override { return GameParameters::MinBombBlastRadius; }
     float GetMaxBombBlastRadius() const override { return GameParameters::MaxBombBlastRadius; }
 
     float GetBombBlastForceAdjustment() const override { return mGameParameters.BombBlastForceAdjustment; }
-    void SetBombBlastForceAdjustment(float value) override { mGameParameters.BombBlastForceAdjustment = value; }
+    void SetBombBlastForceAdjustment(float value) override { mGameParameters.BombBlastForceAdjustment = value; ++mGameParameters.Generation; }
     float GetMinBombBlastForceAdjustment() const override { return GameParameters::MinBombBlastForceAdjustment; }
     float GetMaxBombBlastForceAdjustment() const override { return GameParameters::MaxBombBlastForceAdjustment; }
 
     float GetBombBlastHeat() const override { return mGameParameters.BombBlastHeat; }
-    void SetBombBlastHeat(float value) override { mGameParameters.BombBlastHeat = value; }
+    void SetBombBlastHeat(float value) override { mGameParameters.BombBlastHeat = value; ++mGameParameters.Generation; }
     float GetMinBombBlastHeat() const override { return GameParameters::MinBombBlastHeat; }
     float GetMaxBombBlastHeat() const override { return GameParameters::MaxBombBlastHeat; }
 
     float GetAntiMatterBombImplosionStrength() const override { return mGameParameters.AntiMatterBombImplosionStrength; }
-    void SetAntiMatterBombImplosionStrength(float value) override { mGameParameters.AntiMatterBombImplosionStrength = value; }
+    void SetAntiMatterBombImplosionStrength(float value) override { mGameParameters.AntiMatterBombImplosionStrength = value; ++mGameParameters.Generation; }
     float GetMinAntiMatterBombImplosionStrength() const override { return GameParameters::MinAntiMatterBombImplosionStrength; }
     float GetMaxAntiMatterBombImplosionStrength() const override { return GameParameters::MaxAntiMatterBombImplosionStrength; }
 
     float GetFloodRadius() const override { return mGameParameters.FloodRadius; }
-    void SetFloodRadius(float value) override { mGameParameters.FloodRadius = value; }
+    void SetFloodRadius(float value) override { mGameParameters.FloodRadius = value; ++mGameParameters.Generation; }
     float GetMinFloodRadius() const override { return GameParameters::MinFloodRadius; }
     float GetMaxFloodRadius() const override { return GameParameters::MaxFloodRadius; }
 
     float GetFloodQuantity() const override { return mGameParameters.FloodQuantity; }
-    void SetFloodQuantity(float value) override { mGameParameters.FloodQuantity = value; }
+    void SetFloodQuantity(float value) override { mGameParameters.FloodQuantity = value; ++mGameParameters.Generation; }
     float GetMinFloodQuantity() const override { return GameParameters::MinFloodQuantity; }
     float GetMaxFloodQuantity() const override { return GameParameters::MaxFloodQuantity; }
 
     float GetInjectPressureQuantity() const override { return mGameParameters.InjectPressureQuantity; }
-    void SetInjectPressureQuantity(float value) override { mGameParameters.InjectPressureQuantity = value; }
+    void SetInjectPressureQuantity(float value) override { mGameParameters.InjectPressureQuantity = value; ++mGameParameters.Generation; }
     float GetMinInjectPressureQuantity() const override { return GameParameters::MinInjectPressureQuantity; }
     float GetMaxInjectPressureQuantity() const override { return GameParameters::MaxInjectPressureQuantity; }
 
     float GetBlastToolRadius() const override { return mGameParameters.BlastToolRadius; }
-    void SetBlastToolRadius(float value) override { mGameParameters.BlastToolRadius = value; }
+    void SetBlastToolRadius(float value) override { mGameParameters.BlastToolRadius = value; ++mGameParameters.Generation; }
     float GetMinBlastToolRadius() const override { return GameParameters::MinBlastToolRadius; }
     float GetMaxBlastToolRadius() const override { return GameParameters::MaxBlastToolRadius; }
 
     float GetBlastToolForceAdjustment() const override { return mGameParameters.BlastToolForceAdjustment; }
-    void SetBlastToolForceAdjustment(float value) override { mGameParameters.BlastToolForceAdjustment = value; }
+    void SetBlastToolForceAdjustment(float value) override { mGameParameters.BlastToolForceAdjustment = value; ++mGameParameters.Generation; }
     float GetMinBlastToolForceAdjustment() const override { return GameParameters::MinBlastToolForceAdjustment; }
     float GetMaxBlastToolForceAdjustment() const override { return GameParameters::MaxBlastToolForceAdjustment; }
 
     float GetScrubRotToolRadius() const override { return mGameParameters.ScrubRotToolRadius; }
-    void SetScrubRotToolRadius(float value) override { mGameParameters.ScrubRotToolRadius = value; }
+    void SetScrubRotToolRadius(float value) override { mGameParameters.ScrubRotToolRadius = value; ++mGameParameters.Generation; }
     float GetMinScrubRotToolRadius() const override { return GameParameters::MinScrubRotToolRadius; }
     float GetMaxScrubRotToolRadius() const override { return GameParameters::MaxScrubRotToolRadius; }
 
     float GetWindMakerToolWindSpeed() const override { return mGameParameters.WindMakerToolWindSpeed; }
-    void SetWindMakerToolWindSpeed(float value) override { mGameParameters.WindMakerToolWindSpeed = value; }
+    void SetWindMakerToolWindSpeed(float value) override { mGameParameters.WindMakerToolWindSpeed = value; ++mGameParameters.Generation; }
     float GetMinWindMakerToolWindSpeed() const override { return GameParameters::MinWindMakerToolWindSpeed; }
     float GetMaxWindMakerToolWindSpeed() const override { return GameParameters::MaxWindMakerToolWindSpeed; }
 
     float GetLuminiscenceAdjustment() const override { return mGameParameters.LuminiscenceAdjustment; }
-    void SetLuminiscenceAdjustment(float value) override { mGameParameters.LuminiscenceAdjustment = value; }
+    void SetLuminiscenceAdjustment(float value) override { mGameParameters.LuminiscenceAdjustment = value; ++mGameParameters.Generation; }
     float GetMinLuminiscenceAdjustment() const override { return GameParameters::MinLuminiscenceAdjustment; }
     float GetMaxLuminiscenceAdjustment() const override { return GameParameters::MaxLuminiscenceAdjustment; }
 
     float GetLightSpreadAdjustment() const override { return mGameParameters.LightSpreadAdjustment; }
-    void SetLightSpreadAdjustment(float value) override { mGameParameters.LightSpreadAdjustment = value; }
+    void SetLightSpreadAdjustment(float value) override { mGameParameters.LightSpreadAdjustment = value; ++mGameParameters.Generation; }
     float GetMinLightSpreadAdjustment() const override { return GameParameters::MinLightSpreadAdjustment; }
     float GetMaxLightSpreadAdjustment() const override { return GameParameters::MaxLightSpreadAdjustment; }
 
     bool GetUltraViolentMode() const override { return mGameParameters.IsUltraViolentMode; }
-    void SetUltraViolentMode(bool value) override { mGameParameters.IsUltraViolentMode = value; mNotificationLayer.SetUltraViolentModeIndicator(value); }
+    void SetUltraViolentMode(bool value) override { mGameParameters.IsUltraViolentMode = value; ++mGameParameters.Generation; mNotificationLayer.SetUltraViolentModeIndicator(value); }
 
     bool GetDoGenerateDebris() const override { return mGameParameters.DoGenerateDebris; }
-    void SetDoGenerateDebris(bool value) override { mGameParameters.DoGenerateDebris = value; }
+    void SetDoGenerateDebris(bool value) override { mGameParameters.DoGenerateDebris = value; ++mGameParameters.Generation; }
 
     bool GetDoGenerateSparklesForCuts() const override { return mGameParameters.DoGenerateSparklesForCuts; }
-    void SetDoGenerateSparklesForCuts(bool value) override { mGameParameters.DoGenerateSparklesForCuts = value; }
+    void SetDoGenerateSparklesForCuts(bool value) override { mGameParameters.DoGenerateSparklesForCuts = value; ++mGameParameters.Generation; }
 
     float GetAirBubblesDensity() const override { return mGameParameters.AirBubblesDensity; }
-    void SetAirBubblesDensity(float value) override { mGameParameters.AirBubblesDensity = value; }
+    void SetAirBubblesDensity(float value) override { mGameParameters.AirBubblesDensity = value; ++mGameParameters.Generation; }
     float GetMaxAirBubblesDensity() const override { return GameParameters::MaxAirBubblesDensity; }
     float GetMinAirBubblesDensity() const override { return GameParameters::MinAirBubblesDensity; }
 
     bool GetDoGenerateEngineWakeParticles() const override { return mGameParameters.DoGenerateEngineWakeParticles; }
-    void SetDoGenerateEngineWakeParticles(bool value) override { mGameParameters.DoGenerateEngineWakeParticles = value; }
+    void SetDoGenerateEngineWakeParticles(bool value) override { mGameParameters.DoGenerateEngineWakeParticles = value; ++mGameParameters.Generation; }
 
     unsigned int GetNumberOfStars() const override { return mGameParameters.NumberOfStars; }
-    void SetNumberOfStars(unsigned int value) override { mGameParameters.NumberOfStars = value; }
+    void SetNumberOfStars(unsigned int value) override { mGameParameters.NumberOfStars = value; ++mGameParameters.Generation; }
     unsigned int GetMinNumberOfStars() const override { return GameParameters::MinNumberOfStars; }
     unsigned int GetMaxNumberOfStars() const override { return GameParameters::MaxNumberOfStars; }
 
     unsigned int GetNumberOfClouds() const override { return mGameParameters.NumberOfClouds; }
-    void SetNumberOfClouds(unsigned int value) override { mGameParameters.NumberOfClouds = value; }
+    void SetNumberOfClouds(unsigned int value) override { mGameParameters.NumberOfClouds = value; ++mGameParameters.Generation; }
     unsigned int GetMinNumberOfClouds() const override { return GameParameters::MinNumberOfClouds; }
     unsigned int GetMaxNumberOfClouds() const override { return GameParameters::MaxNumberOfClouds; }
 
@@ -733,10 +776,54 @@ public:
     void SetDoDayLightCycle(bool value) override;
 
     std::chrono::minutes GetDayLightCycleDuration() const override { return mGameParameters.DayLightCycleDuration; }
-    void SetDayLightCycleDuration(std::chrono::minutes value) override { mGameParameters.DayLightCycleDuration = value; }
+    void SetDayLightCycleDuration(std::chrono::minutes value) override { mGameParameters.DayLightCycleDuration = value; ++mGameParameters.Generation; }
     std::chrono::minutes GetMinDayLightCycleDuration() const override { return GameParameters::MinDayLightCycleDuration; }
     std::chrono::minutes GetMaxDayLightCycleDuration() const override { return GameParameters::MaxDayLightCycleDuration; }
 
+    bool GetDoUpdateShipsConcurrently() const override { return mGameParameters.DoUpdateShipsConcurrently; }
+    void SetDoUpdateShipsConcurrently(bool value) override { mGameParameters.DoUpdateShipsConcurrently = value; ++mGameParameters.Generation; }
+
+    bool GetDoUpdateOceanSurfaceConcurrently() const override { return mGameParameters.DoUpdateOceanSurfaceConcurrently; }
+    void SetDoUpdateOceanSurfaceConcurrently(bool value) override { mGameParameters.DoUpdateOceanSurfaceConcurrently = value; ++mGameParameters.Generation; }
+
+    bool GetDoPipelineFrames() const override { return mGameParameters.DoPipelineFrames; }
+    void SetDoPipelineFrames(bool value) override { mGameParameters.DoPipelineFrames = value; ++mGameParameters.Generation; }
+
+    bool GetDoInterpolateRendering() const override { return mGameParameters.DoInterpolateRendering; }
+    void SetDoInterpolateRendering(bool value) override { mGameParameters.DoInterpolateRendering = value; ++mGameParameters.Generation; }
+
+    float GetRenderFrameRate() const override { return mGameParameters.RenderFrameRate; }
+    void SetRenderFrameRate(float value) override { mGameParameters.RenderFrameRate = value; ++mGameParameters.Generation; }
+    float GetMinRenderFrameRate() const override { return GameParameters::MinRenderFrameRate; }
+    float GetMaxRenderFrameRate() const override { return GameParameters::MaxRenderFrameRate; }
+
+    bool GetDoRenderOnDemand() const override { return mGameParameters.DoRenderOnDemand; }
+    void SetDoRenderOnDemand(bool value) override { mGameParameters.DoRenderOnDemand = value; ++mGameParameters.Generation; }
+
+    bool GetDoThrottleIdleGameIterations() const override { return mGameParameters.DoThrottleIdleGameIterations; }
+    void SetDoThrottleIdleGameIterations(bool value) override { mGameParameters.DoThrottleIdleGameIterations = value; ++mGameParameters.Generation; }
+
+    bool GetDoUpdateWaterAndPressureConcurrently() const override { return mGameParameters.DoUpdateWaterAndPressureConcurrently; }
+    void SetDoUpdateWaterAndPressureConcurrently(bool value) override { mGameParameters.DoUpdateWaterAndPressureConcurrently = value; ++mGameParameters.Generation; }
+
+    bool GetDoAdaptMechanicalDynamicsIterations() const override { return mGameParameters.DoAdaptMechanicalDynamicsIterations; }
+    void SetDoAdaptMechanicalDynamicsIterations(bool value) override { mGameParameters.DoAdaptMechanicalDynamicsIterations = value; ++mGameParameters.Generation; }
+
+    bool GetDoGovernSimulationTimeBudget() const override { return mGameParameters.DoGovernSimulationTimeBudget; }
+    void SetDoGovernSimulationTimeBudget(bool value) override { mGameParameters.DoGovernSimulationTimeBudget = value; ++mGameParameters.Generation; }
+
+    bool GetDoPutRestingConnectedComponentsToSleep() const override { return mGameParameters.DoPutRestingConnectedComponentsToSleep; }
+    void SetDoPutRestingConnectedComponentsToSleep(bool value) override { mGameParameters.DoPutRestingConnectedComponentsToSleep = value; ++mGameParameters.Generation; }
+
+    bool GetDoCompactDestroyedSprings() const override { return mGameParameters.DoCompactDestroyedSprings; }
+    void SetDoCompactDestroyedSprings(bool value) override { mGameParameters.DoCompactDestroyedSprings = value; ++mGameParameters.Generation; }
+
+    bool GetDoSplitDetachedFragments() const override { return mGameParameters.DoSplitDetachedFragments; }
+    void SetDoSplitDetachedFragments(bool value) override { mGameParameters.DoSplitDetachedFragments = value; ++mGameParameters.Generation; }
+
+    bool GetDoUseImplicitHeatPropagation() const override { return mGameParameters.DoUseImplicitHeatPropagation; }
+    void SetDoUseImplicitHeatPropagation(bool value) override { mGameParameters.DoUseImplicitHeatPropagation = value; ++mGameParameters.Generation; }
+
     float GetShipStrengthRandomizationDensityAdjustment() const override { return mShipStrengthRandomizer.GetDensityAdjustment(); }
     void SetShipStrengthRandomizationDensityAdjustment(float value) override { mShipStrengthRandomizer.SetDensityAdjustment(value); }
     float GetMinShipStrengthRandomizationDensityAdjustment() const override { return 0.0f; }
@@ -877,6 +964,73 @@ private:
 
     ShipMetadata InternalResetAndLoadShip(ShipLoadSpecifications const & loadSpecs);
 
+    // Takes the definition handed over in the specs, if any, or else loads it from file;
+    // invoked also on the ship load thread
+    ShipDefinition LoadShipDefinition(ShipLoadSpecifications const & loadSpecs) const;
+
+    /*
+     * The state of a ship load running on the ship load thread; shared with the thread,
+     * so that the load may be abandoned while the thread is still working on it.
+     */
+    struct AsyncShipLoad
+    {
+        ShipLoadSpecifications const LoadSpecs;
+        ShipLoadCallbacks const Callbacks;
+
+        std::atomic<bool> IsCancelled;
+
+        // Protected by the mutex - written by the ship load thread
+
+        std::mutex Mutex;
+
+        float Progress;
+        ProgressMessageType ProgressMessage;
+        bool IsProgressChanged;
+
+        bool IsCompleted;
+        std::unique_ptr<Physics::World> NewWorld;
+        std::unique_ptr<Physics::Ship> Ship;
+        std::optional<RgbaImageData> TextureImage;
+        std::optional<ShipMetadata> Metadata;
+        std::exception_ptr Error;
+
+        AsyncShipLoad(
+            ShipLoadSpecifications const & loadSpecs,
+            ShipLoadCallbacks && callbacks)
+            : LoadSpecs(loadSpecs)
+            , Callbacks(std::move(callbacks))
+            , IsCancelled(false)
+            , Mutex()
+            , Progress(0.0f)
+            , ProgressMessage(ProgressMessageType::LoadingShip)
+            , IsProgressChanged(true)
+            , IsCompleted(false)
+            , NewWorld()
+            , Ship()
+            , TextureImage()
+            , Metadata()
+            , Error()
+        {}
+
+        void SetProgress(
+            float progress,
+            ProgressMessageType progressMessage)
+        {
+            std::lock_guard const lock{ Mutex };
+
+            Progress = progress;
+            ProgressMessage = progressMessage;
+            IsProgressChanged = true;
+        }
+    };
+
+    void RunAsyncShipLoad(AsyncShipLoad & asyncShipLoad);
+
+    void UpdateAsyncShipLoad();
+
+    // For synchronous loads, which use the ship factory on this thread
+    void CancelShipLoadAndWait();
+
     void Reset(std::unique_ptr<Physics::World> newWorld);
 
     void InternalAddShip(
@@ -886,6 +1040,11 @@ private:
 
     void PublishStats(std::chrono::steady_clock::time_point nowReal);
 
+    void UpdateSnapshotHistory();
+    void ClearSnapshotHistory();
+
+    void SplitDetachedFragments();
+
 private:
 
     //
@@ -927,6 +1086,10 @@ private:
 
     std::unique_ptr<Physics::World> mWorld;
 
+    // The texture of each ship, kept only for the ships loaded while detached
+    // fragments are split off, as their fragments need a texture of their own
+    std::vector<std::optional<RgbaImageData>> mShipTextureImages;
+
     FishSpeciesDatabase mFishSpeciesDatabase;
     MaterialDatabase mMaterialDatabase;
 
@@ -939,6 +1102,7 @@ private:
 
     ShipStrengthRandomizer mShipStrengthRandomizer;
     ShipTexturizer mShipTexturizer;
+    ShipFactoryCache mShipFactoryCache;
 
 
     //
@@ -951,6 +1115,19 @@ private:
     bool mIsPulseUpdateSet;
     bool mIsMoveToolEngaged;
 
+    SimulationGovernor mSimulationGovernor;
+
+    // Interpolated rendering
+    static size_t constexpr MaxSimulationStepsPerGameIteration = 4;
+    bool mIsInterpolatingRendering;
+    float mSimulationTimeAccumulator; // Simulation time not yet run, in seconds
+    GameChronometer::time_point mLastGameIterationTimestampReal;
+
+    // Render-on-demand
+    bool mIsRenderRequested;
+    std::uint64_t mLastRenderedGameParametersGeneration;
+    size_t mIdleGameIterationCount; // Consecutive game iterations that did not render
+
 
     //
     // The parameters that we own
@@ -996,7 +1173,38 @@ private:
     GameWallClock::time_point mOriginTimestampGame;
     std::unique_ptr<PerfStats> mTotalPerfStats;
     PerfStats mLastPublishedTotalPerfStats;
+    PerfStats mLastDeltaPerfStats; // Between the last two publishes
     uint64_t mTotalFrameCount;
     uint64_t mLastPublishedTotalFrameCount;
     int mSkippedFirstStatPublishes;
+
+    //
+    // Telemetry
+    //
+
+    TelemetrySink mTelemetrySink;
+
+    //
+    // Quick-save
+    //
+
+    std::shared_ptr<StateSnapshot const> mQuickSave; // Shared with the writes in progress
+    std::unique_ptr<TaskThread> mQuickSaveWriteThread;
+
+    //
+    // Snapshot history
+    //
+
+    bool mIsSnapshotHistoryEnabled;
+    size_t mSnapshotHistoryMaxByteSize;
+    SnapshotHistory mSnapshotHistory;
+    float mLastSnapshotHistorySimulationTime;
+
+    //
+    // Asynchronous ship loading
+    //
+
+    std::shared_ptr<AsyncShipLoad> mAsyncShipLoad;
+    TaskThreadPool mShipLoadTaskThreadPool; // The main one is busy with the simulation
+    std::unique_ptr<TaskThread> mShipLoadThread; // Last, so that it's joined before anything it uses goes away
 };
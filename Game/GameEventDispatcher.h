@@ -5,17 +5,25 @@
 ***************************************************************************************/
 #pragma once
 
+#include "AggregatedGameEvents.h"
 #include "IGameEventHandlers.h"
+#include "ShipUpdateStaging.h"
 
 #include <GameCore/Log.h>
-#include <GameCore/TupleKeys.h>
 
 #include <algorithm>
+#include <cassert>
+#include <cstdint>
 #include <optional>
+#include <utility>
 #include <vector>
 
 /*
  * Dispatches events to multiple sinks, aggregating some events in the process.
+ *
+ * Events raised while a ship update staging area is installed on the calling
+ * thread are deferred until the staging area is merged; events that are aggregated
+ * are aggregated directly into the staging area's own aggregation.
  */
 class GameEventDispatcher final
     : public ILifecycleGameEventHandler
@@ -30,24 +38,7 @@ class GameEventDispatcher final
 public:
 
     GameEventDispatcher()
-        : mStressEvents()
-        , mBreakEvents()
-        , mLampBrokenEvents()
-        , mLampExplodedEvents()
-        , mLampImplodedEvents()
-        , mCombustionExplosionEvents()
-        , mLightningHitEvents()
-        , mLightFlickerEvents()
-        , mSpringRepairedEvents()
-        , mTriangleRepairedEvents()
-        , mPinToggledEvents()
-        , mWaterDisplacedEvents(0.0f)
-        , mAirBubbleSurfacedEvents(0u)
-        , mBombExplosionEvents()
-        , mRCBombPingEvents()
-        , mTimerBombDefusedEvents()
-        , mWatertightDoorOpenedEvents()
-        , mWatertightDoorClosedEvents()
+        : mAggregatedEvents()
         // Sinks
         , mLifecycleSinks()
         , mStructuralSinks()
@@ -68,6 +59,9 @@ public:
 
     void OnGameReset() override
     {
+        if (Stage([=]() { OnGameReset(); }))
+            return;
+
         for (auto sink : mLifecycleSinks)
         {
             sink->OnGameReset();
@@ -78,6 +72,9 @@ public:
         ShipId id,
         ShipMetadata const & shipMetadata) override
     {
+        if (Stage([=]() { OnShipLoaded(id, shipMetadata); }))
+            return;
+
         for (auto sink : mLifecycleSinks)
         {
             sink->OnShipLoaded(id, shipMetadata);
@@ -86,6 +83,9 @@ public:
 
     void OnSinkingBegin(ShipId shipId) override
     {
+        if (Stage([=]() { OnSinkingBegin(shipId); }))
+            return;
+
         for (auto sink : mLifecycleSinks)
         {
             sink->OnSinkingBegin(shipId);
@@ -94,6 +94,9 @@ public:
 
     void OnSinkingEnd(ShipId shipId) override
     {
+        if (Stage([=]() { OnSinkingEnd(shipId); }))
+            return;
+
         for (auto sink : mLifecycleSinks)
         {
             sink->OnSinkingEnd(shipId);
@@ -102,12 +105,26 @@ public:
 
     void OnShipRepaired(ShipId shipId) override
     {
+        if (Stage([=]() { OnShipRepaired(shipId); }))
+            return;
+
         for (auto sink : mLifecycleSinks)
         {
             sink->OnShipRepaired(shipId);
         }
     }
 
+    void OnShipSplit(ShipId shipId) override
+    {
+        if (Stage([=]() { OnShipSplit(shipId); }))
+            return;
+
+        for (auto sink : mLifecycleSinks)
+        {
+            sink->OnShipSplit(shipId);
+        }
+    }
+
     //
     // Structural
     //
@@ -117,7 +134,7 @@ public:
         bool isUnderwater,
         unsigned int size) override
     {
-        mStressEvents[std::make_tuple(&structuralMaterial, isUnderwater)] += size;
+        GetCurrentAggregatedEvents().StressEvents[std::make_tuple(&structuralMaterial, isUnderwater)] += size;
     }
 
     void OnBreak(
@@ -125,28 +142,28 @@ public:
         bool isUnderwater,
         unsigned int size) override
     {
-        mBreakEvents[std::make_tuple(&structuralMaterial, isUnderwater)] += size;
+        GetCurrentAggregatedEvents().BreakEvents[std::make_tuple(&structuralMaterial, isUnderwater)] += size;
     }
 
     void OnLampBroken(
         bool isUnderwater,
         unsigned int size) override
     {
-        mLampBrokenEvents[std::make_tuple(isUnderwater)] += size;
+        GetCurrentAggregatedEvents().LampBrokenEvents[std::make_tuple(isUnderwater)] += size;
     }
 
     void OnLampExploded(
         bool isUnderwater,
         unsigned int size) override
     {
-        mLampExplodedEvents[std::make_tuple(isUnderwater)] += size;
+        GetCurrentAggregatedEvents().LampExplodedEvents[std::make_tuple(isUnderwater)] += size;
     }
 
     void OnLampImploded(
         bool isUnderwater,
         unsigned int size) override
     {
-        mLampImplodedEvents[std::make_tuple(isUnderwater)] += size;
+        GetCurrentAggregatedEvents().LampImplodedEvents[std::make_tuple(isUnderwater)] += size;
     }
 
     //
@@ -155,6 +172,9 @@ public:
 
     void OnTsunami(float x) override
     {
+        if (Stage([=]() { OnTsunami(x); }))
+            return;
+
         for (auto sink : mWavePhenomenaSinks)
         {
             sink->OnTsunami(x);
@@ -163,6 +183,9 @@ public:
 
     void OnTsunamiNotification(float x) override
     {
+        if (Stage([=]() { OnTsunamiNotification(x); }))
+            return;
+
         for (auto sink : mWavePhenomenaSinks)
         {
             sink->OnTsunamiNotification(x);
@@ -175,6 +198,9 @@ public:
 
     void OnPointCombustionBegin() override
     {
+        if (Stage([=]() { OnPointCombustionBegin(); }))
+            return;
+
         for (auto sink : mCombustionSinks)
         {
             sink->OnPointCombustionBegin();
@@ -183,6 +209,9 @@ public:
 
     void OnPointCombustionEnd() override
     {
+        if (Stage([=]() { OnPointCombustionEnd(); }))
+            return;
+
         for (auto sink : mCombustionSinks)
         {
             sink->OnPointCombustionEnd();
@@ -191,6 +220,9 @@ public:
 
     void OnCombustionSmothered() override
     {
+        if (Stage([=]() { OnCombustionSmothered(); }))
+            return;
+
         for (auto sink : mCombustionSinks)
         {
             sink->OnCombustionSmothered();
@@ -201,7 +233,7 @@ public:
         bool isUnderwater,
         unsigned int size) override
     {
-        mCombustionExplosionEvents[std::make_tuple(isUnderwater)] += size;
+        GetCurrentAggregatedEvents().CombustionExplosionEvents[std::make_tuple(isUnderwater)] += size;
     }
 
     //
@@ -212,6 +244,9 @@ public:
         float immediateFps,
         float averageFps) override
     {
+        if (Stage([=]() { OnFrameRateUpdated(immediateFps, averageFps); }))
+            return;
+
         for (auto sink : mStatisticsSinks)
         {
             sink->OnFrameRateUpdated(
@@ -222,6 +257,9 @@ public:
 
     void OnCurrentUpdateDurationUpdated(float currentUpdateDuration) override
     {
+        if (Stage([=]() { OnCurrentUpdateDurationUpdated(currentUpdateDuration); }))
+            return;
+
         for (auto sink : mStatisticsSinks)
         {
             sink->OnCurrentUpdateDurationUpdated(currentUpdateDuration);
@@ -232,6 +270,9 @@ public:
         float netForce,
         float complexity) override
     {
+        if (Stage([=]() { OnStaticPressureUpdated(netForce, complexity); }))
+            return;
+
         for (auto sink : mStatisticsSinks)
         {
             sink->OnStaticPressureUpdated(
@@ -246,6 +287,9 @@ public:
 
     void OnStormBegin() override
     {
+        if (Stage([=]() { OnStormBegin(); }))
+            return;
+
         for (auto sink : mAtmosphereSinks)
         {
             sink->OnStormBegin();
@@ -254,6 +298,9 @@ public:
 
     void OnStormEnd() override
     {
+        if (Stage([=]() { OnStormEnd(); }))
+            return;
+
         for (auto sink : mAtmosphereSinks)
         {
             sink->OnStormEnd();
@@ -268,6 +315,9 @@ public:
         float const maxSpeedMagnitude,
         vec2f const & windSpeed) override
     {
+        if (Stage([=]() { OnWindSpeedUpdated(zeroSpeedMagnitude, baseSpeedMagnitude, baseAndStormSpeedMagnitude, preMaxSpeedMagnitude, maxSpeedMagnitude, windSpeed); }))
+            return;
+
         for (auto sink : mAtmosphereSinks)
         {
             sink->OnWindSpeedUpdated(
@@ -282,6 +332,9 @@ public:
 
     void OnRainUpdated(float const density) override
     {
+        if (Stage([=]() { OnRainUpdated(density); }))
+            return;
+
         for (auto sink : mAtmosphereSinks)
         {
             sink->OnRainUpdated(density);
@@ -290,6 +343,9 @@ public:
 
     void OnThunder() override
     {
+        if (Stage([=]() { OnThunder(); }))
+            return;
+
         for (auto sink : mAtmosphereSinks)
         {
             sink->OnThunder();
@@ -298,6 +354,9 @@ public:
 
     void OnLightning() override
     {
+        if (Stage([=]() { OnLightning(); }))
+            return;
+
         for (auto sink : mAtmosphereSinks)
         {
             sink->OnLightning();
@@ -306,7 +365,7 @@ public:
 
     void OnLightningHit(StructuralMaterial const & structuralMaterial) override
     {
-        mLightningHitEvents[std::make_tuple(&structuralMaterial)] += 1;
+        GetCurrentAggregatedEvents().LightningHitEvents[std::make_tuple(&structuralMaterial)] += 1;
     }
 
     //
@@ -318,11 +377,14 @@ public:
         bool isUnderwater,
         unsigned int size) override
     {
-        mLightFlickerEvents[std::make_tuple(duration, isUnderwater)] += size;
+        GetCurrentAggregatedEvents().LightFlickerEvents[std::make_tuple(duration, isUnderwater)] += size;
     }
 
     void OnElectricalElementAnnouncementsBegin() override
     {
+        if (Stage([=]() { OnElectricalElementAnnouncementsBegin(); }))
+            return;
+
         for (auto sink : mElectricalElementSinks)
         {
             sink->OnElectricalElementAnnouncementsBegin();
@@ -337,6 +399,9 @@ public:
         ElectricalMaterial const & electricalMaterial,
         std::optional<ElectricalPanelElementMetadata> const & panelElementMetadata) override
     {
+        if (Stage([=, &electricalMaterial]() { OnSwitchCreated(electricalElementId, instanceIndex, type, state, electricalMaterial, panelElementMetadata); }))
+            return;
+
         LogMessage("OnSwitchCreated(EEID=", electricalElementId, " IID=", int(instanceIndex), "): State=", static_cast<bool>(state));
 
         for (auto sink : mElectricalElementSinks)
@@ -353,6 +418,9 @@ public:
         ElectricalMaterial const & electricalMaterial,
         std::optional<ElectricalPanelElementMetadata> const & panelElementMetadata) override
     {
+        if (Stage([=, &electricalMaterial]() { OnPowerProbeCreated(electricalElementId, instanceIndex, type, state, electricalMaterial, panelElementMetadata); }))
+            return;
+
         LogMessage("OnPowerProbeCreated(EEID=", electricalElementId, " IID=", int(instanceIndex), "): State=", static_cast<bool>(state));
 
         for (auto sink : mElectricalElementSinks)
@@ -367,6 +435,9 @@ public:
         ElectricalMaterial const & electricalMaterial,
         std::optional<ElectricalPanelElementMetadata> const & panelElementMetadata) override
     {
+        if (Stage([=, &electricalMaterial]() { OnEngineControllerCreated(electricalElementId, instanceIndex, electricalMaterial, panelElementMetadata); }))
+            return;
+
         LogMessage("OnEngineControllerCreated(EEID=", electricalElementId, " IID=", int(instanceIndex), ")");
 
         for (auto sink : mElectricalElementSinks)
@@ -383,6 +454,9 @@ public:
         ElectricalMaterial const & electricalMaterial,
         std::optional<ElectricalPanelElementMetadata> const & panelElementMetadata) override
     {
+        if (Stage([=, &electricalMaterial]() { OnEngineMonitorCreated(electricalElementId, instanceIndex, thrustMagnitude, rpm, electricalMaterial, panelElementMetadata); }))
+            return;
+
         LogMessage("OnEngineMonitorCreated(EEID=", electricalElementId, " IID=", int(instanceIndex), "): Thrust=", thrustMagnitude, " RPM=", rpm);
 
         for (auto sink : mElectricalElementSinks)
@@ -398,6 +472,9 @@ public:
         ElectricalMaterial const & electricalMaterial,
         std::optional<ElectricalPanelElementMetadata> const & panelElementMetadata) override
     {
+        if (Stage([=, &electricalMaterial]() { OnWaterPumpCreated(electricalElementId, instanceIndex, normalizedForce, electricalMaterial, panelElementMetadata); }))
+            return;
+
         LogMessage("OnWaterPumpCreated(EEID=", electricalElementId, " IID=", int(instanceIndex), ")");
 
         for (auto sink : mElectricalElementSinks)
@@ -413,6 +490,9 @@ public:
         ElectricalMaterial const & electricalMaterial,
         std::optional<ElectricalPanelElementMetadata> const & panelElementMetadata) override
     {
+        if (Stage([=, &electricalMaterial]() { OnWatertightDoorCreated(electricalElementId, instanceIndex, isOpen, electricalMaterial, panelElementMetadata); }))
+            return;
+
         LogMessage("OnWatertightDoorCreated(EEID=", electricalElementId, " IID=", int(instanceIndex), ")");
 
         for (auto sink : mElectricalElementSinks)
@@ -423,6 +503,9 @@ public:
 
     void OnElectricalElementAnnouncementsEnd() override
     {
+        if (Stage([=]() { OnElectricalElementAnnouncementsEnd(); }))
+            return;
+
         for (auto sink : mElectricalElementSinks)
         {
             sink->OnElectricalElementAnnouncementsEnd();
@@ -433,6 +516,9 @@ public:
         ElectricalElementId electricalElementId,
         bool isEnabled) override
     {
+        if (Stage([=]() { OnSwitchEnabled(electricalElementId, isEnabled); }))
+            return;
+
         for (auto sink : mElectricalElementSinks)
         {
             sink->OnSwitchEnabled(electricalElementId, isEnabled);
@@ -443,6 +529,9 @@ public:
         ElectricalElementId electricalElementId,
         ElectricalState newState) override
     {
+        if (Stage([=]() { OnSwitchToggled(electricalElementId, newState); }))
+            return;
+
         for (auto sink : mElectricalElementSinks)
         {
             sink->OnSwitchToggled(electricalElementId, newState);
@@ -453,6 +542,9 @@ public:
         ElectricalElementId electricalElementId,
         ElectricalState newState) override
     {
+        if (Stage([=]() { OnPowerProbeToggled(electricalElementId, newState); }))
+            return;
+
         for (auto sink : mElectricalElementSinks)
         {
             sink->OnPowerProbeToggled(electricalElementId, newState);
@@ -463,6 +555,9 @@ public:
         ElectricalElementId electricalElementId,
         bool isEnabled) override
     {
+        if (Stage([=]() { OnEngineControllerEnabled(electricalElementId, isEnabled); }))
+            return;
+
         for (auto sink : mElectricalElementSinks)
         {
             sink->OnEngineControllerEnabled(electricalElementId, isEnabled);
@@ -475,6 +570,9 @@ public:
         float oldControllerValue,
         float newControllerValue) override
     {
+        if (Stage([=, &electricalMaterial]() { OnEngineControllerUpdated(electricalElementId, electricalMaterial, oldControllerValue, newControllerValue); }))
+            return;
+
         for (auto sink : mElectricalElementSinks)
         {
             sink->OnEngineControllerUpdated(electricalElementId, electricalMaterial, oldControllerValue, newControllerValue);
@@ -486,6 +584,9 @@ public:
         float thrustMagnitude,
         float rpm) override
     {
+        if (Stage([=]() { OnEngineMonitorUpdated(electricalElementId, thrustMagnitude, rpm); }))
+            return;
+
         for (auto sink : mElectricalElementSinks)
         {
             sink->OnEngineMonitorUpdated(electricalElementId, thrustMagnitude, rpm);
@@ -498,6 +599,9 @@ public:
         bool isPlaying,
         bool isUnderwater) override
     {
+        if (Stage([=, &electricalMaterial]() { OnShipSoundUpdated(electricalElementId, electricalMaterial, isPlaying, isUnderwater); }))
+            return;
+
         for (auto sink : mElectricalElementSinks)
         {
             sink->OnShipSoundUpdated(electricalElementId, electricalMaterial, isPlaying, isUnderwater);
@@ -508,6 +612,9 @@ public:
         ElectricalElementId electricalElementId,
         bool isEnabled) override
     {
+        if (Stage([=]() { OnWaterPumpEnabled(electricalElementId, isEnabled); }))
+            return;
+
         for (auto sink : mElectricalElementSinks)
         {
             sink->OnWaterPumpEnabled(electricalElementId, isEnabled);
@@ -518,6 +625,9 @@ public:
         ElectricalElementId electricalElementId,
         float normalizedForce) override
     {
+        if (Stage([=]() { OnWaterPumpUpdated(electricalElementId, normalizedForce); }))
+            return;
+
         for (auto sink : mElectricalElementSinks)
         {
             sink->OnWaterPumpUpdated(electricalElementId, normalizedForce);
@@ -528,6 +638,9 @@ public:
         ElectricalElementId electricalElementId,
         bool isEnabled) override
     {
+        if (Stage([=]() { OnWatertightDoorEnabled(electricalElementId, isEnabled); }))
+            return;
+
         for (auto sink : mElectricalElementSinks)
         {
             sink->OnWatertightDoorEnabled(electricalElementId, isEnabled);
@@ -538,6 +651,9 @@ public:
         ElectricalElementId electricalElementId,
         bool isOpen) override
     {
+        if (Stage([=]() { OnWatertightDoorUpdated(electricalElementId, isOpen); }))
+            return;
+
         for (auto sink : mElectricalElementSinks)
         {
             sink->OnWatertightDoorUpdated(electricalElementId, isOpen);
@@ -553,6 +669,9 @@ public:
         bool isUnderwater,
         unsigned int size) override
     {
+        if (Stage([=, &structuralMaterial]() { OnDestroy(structuralMaterial, isUnderwater, size); }))
+            return;
+
         for (auto sink : mGenericSinks)
         {
             sink->OnDestroy(structuralMaterial, isUnderwater, size);
@@ -564,7 +683,7 @@ public:
         bool isUnderwater,
         unsigned int size) override
     {
-        mSpringRepairedEvents[std::make_tuple(&structuralMaterial, isUnderwater)] += size;
+        GetCurrentAggregatedEvents().SpringRepairedEvents[std::make_tuple(&structuralMaterial, isUnderwater)] += size;
     }
 
     void OnTriangleRepaired(
@@ -572,13 +691,16 @@ public:
         bool isUnderwater,
         unsigned int size) override
     {
-        mTriangleRepairedEvents[std::make_tuple(&structuralMaterial, isUnderwater)] += size;
+        GetCurrentAggregatedEvents().TriangleRepairedEvents[std::make_tuple(&structuralMaterial, isUnderwater)] += size;
     }
 
     void OnSawed(
         bool isMetal,
         unsigned int size) override
     {
+        if (Stage([=]() { OnSawed(isMetal, size); }))
+            return;
+
         for (auto sink : mGenericSinks)
         {
             sink->OnSawed(isMetal, size);
@@ -587,6 +709,9 @@ public:
 
     virtual void OnLaserCut(unsigned int size) override
     {
+        if (Stage([=]() { OnLaserCut(size); }))
+            return;
+
         for (auto sink : mGenericSinks)
         {
             sink->OnLaserCut(size);
@@ -597,11 +722,14 @@ public:
         bool isPinned,
         bool isUnderwater) override
     {
-        mPinToggledEvents.emplace(isPinned, isUnderwater);
+        GetCurrentAggregatedEvents().PinToggledEvents[std::make_tuple(isPinned, isUnderwater)] += 1;
     }
 
     void OnWaterTaken(float waterTaken) override
     {
+        if (Stage([=]() { OnWaterTaken(waterTaken); }))
+            return;
+
         for (auto sink : mGenericSinks)
         {
             sink->OnWaterTaken(waterTaken);
@@ -610,6 +738,9 @@ public:
 
     void OnWaterSplashed(float waterSplashed) override
     {
+        if (Stage([=]() { OnWaterSplashed(waterSplashed); }))
+            return;
+
         for (auto sink : mGenericSinks)
         {
             sink->OnWaterSplashed(waterSplashed);
@@ -618,18 +749,21 @@ public:
 
     void OnWaterDisplaced(float waterDisplacedMagnitude) override
     {
-        mWaterDisplacedEvents += waterDisplacedMagnitude;
+        GetCurrentAggregatedEvents().WaterDisplacedEvents += waterDisplacedMagnitude;
     }
 
     void OnAirBubbleSurfaced(unsigned int size) override
     {
-        mAirBubbleSurfacedEvents += size;
+        GetCurrentAggregatedEvents().AirBubbleSurfacedEvents += size;
     }
 
     void OnWaterReaction(
         bool isUnderwater,
         unsigned int size) override
     {
+        if (Stage([=]() { OnWaterReaction(isUnderwater, size); }))
+            return;
+
         for (auto sink : mGenericSinks)
         {
             sink->OnWaterReaction(isUnderwater, size);
@@ -640,6 +774,9 @@ public:
         bool isUnderwater,
         unsigned int size) override
     {
+        if (Stage([=]() { OnWaterReactionExplosion(isUnderwater, size); }))
+            return;
+
         for (auto sink : mGenericSinks)
         {
             sink->OnWaterReactionExplosion(isUnderwater, size);
@@ -648,6 +785,9 @@ public:
 
     void OnSilenceStarted() override
     {
+        if (Stage([=]() { OnSilenceStarted(); }))
+            return;
+
         for (auto sink : mGenericSinks)
         {
             sink->OnSilenceStarted();
@@ -656,6 +796,9 @@ public:
 
     void OnSilenceLifted() override
     {
+        if (Stage([=]() { OnSilenceLifted(); }))
+            return;
+
         for (auto sink : mGenericSinks)
         {
             sink->OnSilenceLifted();
@@ -668,6 +811,9 @@ public:
         float depth,
         float pressure) override
     {
+        if (Stage([=]() { OnPhysicsProbeReading(velocity, temperature, depth, pressure); }))
+            return;
+
         for (auto sink : mGenericSinks)
         {
             sink->OnPhysicsProbeReading(
@@ -682,6 +828,9 @@ public:
         std::string const & name,
         float value) override
     {
+        if (Stage([=]() { OnCustomProbe(name, value); }))
+            return;
+
         for (auto sink : mGenericSinks)
         {
             sink->OnCustomProbe(
@@ -695,6 +844,9 @@ public:
         GadgetType gadgetType,
         bool isUnderwater) override
     {
+        if (Stage([=]() { OnGadgetPlaced(gadgetId, gadgetType, isUnderwater); }))
+            return;
+
         for (auto sink : mGenericSinks)
         {
             sink->OnGadgetPlaced(
@@ -709,6 +861,9 @@ public:
         GadgetType gadgetType,
         std::optional<bool> isUnderwater) override
     {
+        if (Stage([=]() { OnGadgetRemoved(gadgetId, gadgetType, isUnderwater); }))
+            return;
+
         for (auto sink : mGenericSinks)
         {
             sink->OnGadgetRemoved(
@@ -723,20 +878,23 @@ public:
         bool isUnderwater,
         unsigned int size) override
     {
-        mBombExplosionEvents[std::make_tuple(gadgetType, isUnderwater)] += size;
+        GetCurrentAggregatedEvents().BombExplosionEvents[std::make_tuple(gadgetType, isUnderwater)] += size;
     }
 
     void OnRCBombPing(
         bool isUnderwater,
         unsigned int size) override
     {
-        mRCBombPingEvents[std::make_tuple(isUnderwater)] += size;
+        GetCurrentAggregatedEvents().RCBombPingEvents[std::make_tuple(isUnderwater)] += size;
     }
 
     void OnTimerBombFuse(
         GadgetId gadgetId,
         std::optional<bool> isFast) override
     {
+        if (Stage([=]() { OnTimerBombFuse(gadgetId, isFast); }))
+            return;
+
         for (auto sink : mGenericSinks)
         {
             sink->OnTimerBombFuse(
@@ -749,13 +907,16 @@ public:
         bool isUnderwater,
         unsigned int size) override
     {
-        mTimerBombDefusedEvents[std::make_tuple(isUnderwater)] += size;
+        GetCurrentAggregatedEvents().TimerBombDefusedEvents[std::make_tuple(isUnderwater)] += size;
     }
 
     void OnAntiMatterBombContained(
         GadgetId gadgetId,
         bool isContained) override
     {
+        if (Stage([=]() { OnAntiMatterBombContained(gadgetId, isContained); }))
+            return;
+
         for (auto sink : mGenericSinks)
         {
             sink->OnAntiMatterBombContained(
@@ -766,6 +927,9 @@ public:
 
     void OnAntiMatterBombPreImploding() override
     {
+        if (Stage([=]() { OnAntiMatterBombPreImploding(); }))
+            return;
+
         for (auto sink : mGenericSinks)
         {
             sink->OnAntiMatterBombPreImploding();
@@ -774,6 +938,9 @@ public:
 
     void OnAntiMatterBombImploding() override
     {
+        if (Stage([=]() { OnAntiMatterBombImploding(); }))
+            return;
+
         for (auto sink : mGenericSinks)
         {
             sink->OnAntiMatterBombImploding();
@@ -784,18 +951,21 @@ public:
         bool isUnderwater,
         unsigned int size) override
     {
-        mWatertightDoorOpenedEvents[std::make_tuple(isUnderwater)] += size;
+        GetCurrentAggregatedEvents().WatertightDoorOpenedEvents[std::make_tuple(isUnderwater)] += size;
     }
 
     void OnWatertightDoorClosed(
         bool isUnderwater,
         unsigned int size) override
     {
-        mWatertightDoorClosedEvents[std::make_tuple(isUnderwater)] += size;
+        GetCurrentAggregatedEvents().WatertightDoorClosedEvents[std::make_tuple(isUnderwater)] += size;
     }
 
     void OnFishCountUpdated(size_t count) override
     {
+        if (Stage([=]() { OnFishCountUpdated(count); }))
+            return;
+
         for (auto sink : mGenericSinks)
         {
             sink->OnFishCountUpdated(count);
@@ -804,6 +974,9 @@ public:
 
     void OnPhysicsProbePanelOpened() override
     {
+        if (Stage([=]() { OnPhysicsProbePanelOpened(); }))
+            return;
+
         for (auto sink : mGenericSinks)
         {
             sink->OnPhysicsProbePanelOpened();
@@ -812,6 +985,9 @@ public:
 
     void OnPhysicsProbePanelClosed() override
     {
+        if (Stage([=]() { OnPhysicsProbePanelClosed(); }))
+            return;
+
         for (auto sink : mGenericSinks)
         {
             sink->OnPhysicsProbePanelClosed();
@@ -820,6 +996,19 @@ public:
 
 public:
 
+    /*
+     * Adds the events aggregated by a ship update staging area to our aggregations,
+     * and clears them from the staging area.
+     *
+     * Must be invoked on the main thread, with no staging area installed.
+     */
+    void MergeAggregatedEvents(ShipUpdateStaging & staging)
+    {
+        assert(ShipUpdateStaging::GetCurrent() == nullptr);
+
+        mAggregatedEvents.MergeFrom(staging.GetAggregatedGameEvents());
+    }
+
     /*
      * Flushes all events aggregated so far and clears the state.
      */
@@ -829,133 +1018,144 @@ public:
         // Publish aggregations
         //
 
-        for (auto * sink : mStructuralSinks)
+        for (auto const & [sink, eventMask] : mStructuralSinks)
         {
-            for (auto const & entry : mStressEvents)
+            if ((eventMask & StructuralGameEventMask::Stress) != 0
+                && !mAggregatedEvents.StressEvents.empty())
             {
-                sink->OnStress(*(std::get<0>(entry.first)), std::get<1>(entry.first), entry.second);
+                sink->OnStressBatch(mAggregatedEvents.StressEvents);
             }
 
-            for (auto const & entry : mBreakEvents)
+            if ((eventMask & StructuralGameEventMask::Break) != 0
+                && !mAggregatedEvents.BreakEvents.empty())
             {
-                sink->OnBreak(*(std::get<0>(entry.first)), std::get<1>(entry.first), entry.second);
+                sink->OnBreakBatch(mAggregatedEvents.BreakEvents);
             }
 
-            for (auto const & entry : mLampBrokenEvents)
+            if ((eventMask & StructuralGameEventMask::LampBroken) != 0)
             {
-                sink->OnLampBroken(std::get<0>(entry.first), entry.second);
+                for (auto const & entry : mAggregatedEvents.LampBrokenEvents)
+                {
+                    sink->OnLampBroken(std::get<0>(entry.first), entry.second);
+                }
             }
 
-            for (auto const & entry : mLampExplodedEvents)
+            if ((eventMask & StructuralGameEventMask::LampExploded) != 0)
             {
-                sink->OnLampExploded(std::get<0>(entry.first), entry.second);
+                for (auto const & entry : mAggregatedEvents.LampExplodedEvents)
+                {
+                    sink->OnLampExploded(std::get<0>(entry.first), entry.second);
+                }
             }
 
-            for (auto const & entry : mLampImplodedEvents)
+            if ((eventMask & StructuralGameEventMask::LampImploded) != 0)
             {
-                sink->OnLampImploded(std::get<0>(entry.first), entry.second);
+                for (auto const & entry : mAggregatedEvents.LampImplodedEvents)
+                {
+                    sink->OnLampImploded(std::get<0>(entry.first), entry.second);
+                }
             }
         }
 
-        mStressEvents.clear();
-        mBreakEvents.clear();
-        mLampBrokenEvents.clear();
-        mLampExplodedEvents.clear();
-        mLampImplodedEvents.clear();
+        mAggregatedEvents.StressEvents.clear();
+        mAggregatedEvents.BreakEvents.clear();
+        mAggregatedEvents.LampBrokenEvents.clear();
+        mAggregatedEvents.LampExplodedEvents.clear();
+        mAggregatedEvents.LampImplodedEvents.clear();
 
         for (auto * sink : mCombustionSinks)
         {
-            for (auto const & entry : mCombustionExplosionEvents)
+            for (auto const & entry : mAggregatedEvents.CombustionExplosionEvents)
             {
                 sink->OnCombustionExplosion(std::get<0>(entry.first), entry.second);
             }
         }
 
-        mCombustionExplosionEvents.clear();
+        mAggregatedEvents.CombustionExplosionEvents.clear();
 
         for (auto * sink : mAtmosphereSinks)
         {
-            for (auto const & entry : mLightningHitEvents)
+            for (auto const & entry : mAggregatedEvents.LightningHitEvents)
             {
                 sink->OnLightningHit(*(std::get<0>(entry.first)));
             }
         }
 
-        mLightningHitEvents.clear();
+        mAggregatedEvents.LightningHitEvents.clear();
 
         for (auto * sink : mElectricalElementSinks)
         {
-            for (auto const & entry : mLightFlickerEvents)
+            for (auto const & entry : mAggregatedEvents.LightFlickerEvents)
             {
                 sink->OnLightFlicker(std::get<0>(entry.first), std::get<1>(entry.first), entry.second);
             }
         }
 
-        mLightFlickerEvents.clear();
+        mAggregatedEvents.LightFlickerEvents.clear();
 
         for (auto * sink : mGenericSinks)
         {
-            for (auto const & entry : mSpringRepairedEvents)
+            for (auto const & entry : mAggregatedEvents.SpringRepairedEvents)
             {
                 sink->OnSpringRepaired(*(std::get<0>(entry.first)), std::get<1>(entry.first), entry.second);
             }
 
-            for (auto const & entry : mTriangleRepairedEvents)
+            for (auto const & entry : mAggregatedEvents.TriangleRepairedEvents)
             {
                 sink->OnTriangleRepaired(*(std::get<0>(entry.first)), std::get<1>(entry.first), entry.second);
             }
 
-            for (auto const & entry : mPinToggledEvents)
+            for (auto const & entry : mAggregatedEvents.PinToggledEvents)
             {
-                sink->OnPinToggled(std::get<0>(entry), std::get<1>(entry));
+                sink->OnPinToggled(std::get<0>(entry.first), std::get<1>(entry.first));
             }
 
-            if (mWaterDisplacedEvents != 0.0f)
+            if (mAggregatedEvents.WaterDisplacedEvents != 0.0f)
             {
-                sink->OnWaterDisplaced(mWaterDisplacedEvents);
+                sink->OnWaterDisplaced(mAggregatedEvents.WaterDisplacedEvents);
             }
 
-            if (mAirBubbleSurfacedEvents > 0)
+            if (mAggregatedEvents.AirBubbleSurfacedEvents > 0)
             {
-                sink->OnAirBubbleSurfaced(mAirBubbleSurfacedEvents);
+                sink->OnAirBubbleSurfaced(mAggregatedEvents.AirBubbleSurfacedEvents);
             }
 
-            for (auto const & entry : mBombExplosionEvents)
+            for (auto const & entry : mAggregatedEvents.BombExplosionEvents)
             {
                 sink->OnBombExplosion(std::get<0>(entry.first), std::get<1>(entry.first), entry.second);
             }
 
-            for (auto const & entry : mRCBombPingEvents)
+            for (auto const & entry : mAggregatedEvents.RCBombPingEvents)
             {
                 sink->OnRCBombPing(std::get<0>(entry.first), entry.second);
             }
 
-            for (auto const & entry : mTimerBombDefusedEvents)
+            for (auto const & entry : mAggregatedEvents.TimerBombDefusedEvents)
             {
                 sink->OnTimerBombDefused(std::get<0>(entry.first), entry.second);
             }
 
-            for (auto const & entry : mWatertightDoorOpenedEvents)
+            for (auto const & entry : mAggregatedEvents.WatertightDoorOpenedEvents)
             {
                 sink->OnWatertightDoorOpened(std::get<0>(entry.first), entry.second);
             }
 
-            for (auto const & entry : mWatertightDoorClosedEvents)
+            for (auto const & entry : mAggregatedEvents.WatertightDoorClosedEvents)
             {
                 sink->OnWatertightDoorClosed(std::get<0>(entry.first), entry.second);
             }
         }
 
-        mSpringRepairedEvents.clear();
-        mTriangleRepairedEvents.clear();
-        mPinToggledEvents.clear();
-        mWaterDisplacedEvents = 0.0f;
-        mAirBubbleSurfacedEvents = 0u;
-        mBombExplosionEvents.clear();
-        mRCBombPingEvents.clear();
-        mTimerBombDefusedEvents.clear();
-        mWatertightDoorOpenedEvents.clear();
-        mWatertightDoorClosedEvents.clear();
+        mAggregatedEvents.SpringRepairedEvents.clear();
+        mAggregatedEvents.TriangleRepairedEvents.clear();
+        mAggregatedEvents.PinToggledEvents.clear();
+        mAggregatedEvents.WaterDisplacedEvents = 0.0f;
+        mAggregatedEvents.AirBubbleSurfacedEvents = 0u;
+        mAggregatedEvents.BombExplosionEvents.clear();
+        mAggregatedEvents.RCBombPingEvents.clear();
+        mAggregatedEvents.TimerBombDefusedEvents.clear();
+        mAggregatedEvents.WatertightDoorOpenedEvents.clear();
+        mAggregatedEvents.WatertightDoorClosedEvents.clear();
     }
 
     void RegisterLifecycleEventHandler(ILifecycleGameEventHandler * sink)
@@ -963,9 +1163,11 @@ public:
         mLifecycleSinks.push_back(sink);
     }
 
-    void RegisterStructuralEventHandler(IStructuralGameEventHandler * sink)
+    void RegisterStructuralEventHandler(
+        IStructuralGameEventHandler * sink,
+        std::uint32_t eventMask = StructuralGameEventMask::All)
     {
-        mStructuralSinks.push_back(sink);
+        mStructuralSinks.emplace_back(sink, eventMask);
     }
 
     void RegisterWavePhenomenaEventHandler(IWavePhenomenaGameEventHandler * sink)
@@ -998,31 +1200,46 @@ public:
         mGenericSinks.push_back(sink);
     }
 
+private:
+
+    /*
+     * When a ship update staging area is installed on the calling thread,
+     * records the event into it - to be re-raised once staging areas are
+     * merged - and returns true; otherwise returns false.
+     */
+    template<typename TEvent>
+    inline bool Stage(TEvent && event)
+    {
+        ShipUpdateStaging * const staging = ShipUpdateStaging::GetCurrent();
+        if (staging == nullptr)
+            return false;
+
+        staging->Defer(std::forward<TEvent>(event));
+        return true;
+    }
+
+    /*
+     * Returns the aggregation that aggregated events raised on the calling thread
+     * go to: the one of the ship update staging area installed on the thread, if
+     * any, or else our own.
+     */
+    inline AggregatedGameEvents & GetCurrentAggregatedEvents()
+    {
+        ShipUpdateStaging * const staging = ShipUpdateStaging::GetCurrent();
+        if (staging != nullptr)
+            return staging->GetAggregatedGameEvents();
+
+        return mAggregatedEvents;
+    }
+
 private:
 
     // The current events being aggregated
-    unordered_tuple_map<std::tuple<StructuralMaterial const *, bool>, unsigned int> mStressEvents;
-    unordered_tuple_map<std::tuple<StructuralMaterial const *, bool>, unsigned int> mBreakEvents;
-    unordered_tuple_map<std::tuple<bool>, unsigned int> mLampBrokenEvents;
-    unordered_tuple_map<std::tuple<bool>, unsigned int> mLampExplodedEvents;
-    unordered_tuple_map<std::tuple<bool>, unsigned int> mLampImplodedEvents;
-    unordered_tuple_map<std::tuple<bool>, unsigned int> mCombustionExplosionEvents;
-    unordered_tuple_map<std::tuple<StructuralMaterial const *>, unsigned int> mLightningHitEvents;
-    unordered_tuple_map<std::tuple<DurationShortLongType, bool>, unsigned int> mLightFlickerEvents;
-    unordered_tuple_map<std::tuple<StructuralMaterial const *, bool>, unsigned int> mSpringRepairedEvents;
-    unordered_tuple_map<std::tuple<StructuralMaterial const *, bool>, unsigned int> mTriangleRepairedEvents;
-    unordered_tuple_set<std::tuple<bool, bool>> mPinToggledEvents;
-    float mWaterDisplacedEvents;
-    unsigned int mAirBubbleSurfacedEvents;
-    unordered_tuple_map<std::tuple<GadgetType, bool>, unsigned int> mBombExplosionEvents;
-    unordered_tuple_map<std::tuple<bool>, unsigned int> mRCBombPingEvents;
-    unordered_tuple_map<std::tuple<bool>, unsigned int> mTimerBombDefusedEvents;
-    unordered_tuple_map<std::tuple<bool>, unsigned int> mWatertightDoorOpenedEvents;
-    unordered_tuple_map<std::tuple<bool>, unsigned int> mWatertightDoorClosedEvents;
+    AggregatedGameEvents mAggregatedEvents;
 
     // The registered sinks
     std::vector<ILifecycleGameEventHandler *> mLifecycleSinks;
-    std::vector<IStructuralGameEventHandler *> mStructuralSinks;
+    std::vector<std::pair<IStructuralGameEventHandler *, std::uint32_t>> mStructuralSinks; // With their event masks
     std::vector<IWavePhenomenaGameEventHandler *> mWavePhenomenaSinks;
     std::vector<ICombustionGameEventHandler *> mCombustionSinks;
     std::vector<IStatisticsGameEventHandler *> mStatisticsSinks;
@@ -6,8 +6,9 @@
 #include "GameParameters.h"
 
 GameParameters::GameParameters()
+    : Generation(0)
     // Dynamics
-    : NumMechanicalDynamicsIterationsAdjustment(1.0f)
+    , NumMechanicalDynamicsIterationsAdjustment(1.0f)
     , SpringStiffnessAdjustment(1.0f)
     , SpringDampingAdjustment(1.0f)
     , SpringStrengthAdjustment(1.0f)
@@ -94,6 +95,22 @@ GameParameters::GameParameters()
     , NumberOfClouds(48)
     , DoDayLightCycle(false)
     , DayLightCycleDuration(std::chrono::minutes(4))
+    , DoUpdateShipsConcurrently(false)
+    , DoUpdateOceanSurfaceConcurrently(false)
+    , DoPipelineFrames(false)
+    , DoInterpolateRendering(false)
+    , RenderFrameRate(120.0f)
+    , DoRenderOnDemand(true)
+    , DoThrottleIdleGameIterations(true)
+    , DoUpdateWaterAndPressureConcurrently(false)
+    , DoAdaptMechanicalDynamicsIterations(false)
+    , DoPutRestingConnectedComponentsToSleep(false)
+    , DoCompactDestroyedSprings(false)
+    , DoSplitDetachedFragments(false)
+    , DoUseImplicitHeatPropagation(false)
+    , SpringForcesKernel(SpringForcesKernelType::Vectorized)
+    , DoGovernSimulationTimeBudget(true)
+    , SimulationDegradationLevel(0)
     // Interactions
     , ToolSearchRadius(2.0f)
     , DestroyRadius(0.5f)
@@ -9,6 +9,7 @@
 #include <GameCore/Vectors.h>
 
 #include <chrono>
+#include <cstdint>
 
 /*
  * Parameters that affect the game's physics and its world.
@@ -17,6 +18,14 @@ struct GameParameters
 {
     GameParameters();
 
+    //
+    // Incremented at each change of any parameter; consumers that cache values derived
+    // from the parameters only need to look for changes when this differs from the
+    // generation they are current with
+    //
+
+    std::uint64_t Generation;
+
     //
     // The dt of each step
     //
@@ -473,6 +482,43 @@ struct GameParameters
     static std::chrono::minutes constexpr MinDayLightCycleDuration = std::chrono::minutes(1);
     static std::chrono::minutes constexpr MaxDayLightCycleDuration = std::chrono::minutes(60);
 
+    bool DoUpdateShipsConcurrently;
+
+    bool DoUpdateOceanSurfaceConcurrently;
+
+    bool DoPipelineFrames;
+
+    bool DoInterpolateRendering; // When set, we render at RenderFrameRate, interpolating between simulation steps
+
+    float RenderFrameRate; // Frames/second
+    static float constexpr MinRenderFrameRate = 30.0f;
+    static float constexpr MaxRenderFrameRate = 240.0f;
+
+    bool DoRenderOnDemand; // When set, we only render when something might have changed since the last frame
+
+    bool DoThrottleIdleGameIterations; // When set, game iterations slow down to IdleGameIterationRate while nothing is rendered
+    static float constexpr IdleGameIterationRate = 20.0f; // Iterations/second
+    static size_t constexpr IdleGameIterationsBeforeThrottling = 30;
+
+    bool DoUpdateWaterAndPressureConcurrently;
+
+    bool DoAdaptMechanicalDynamicsIterations;
+
+    bool DoPutRestingConnectedComponentsToSleep;
+
+    bool DoCompactDestroyedSprings;
+
+    bool DoSplitDetachedFragments; // When set, large detached fragments become ships of their own
+    static constexpr ElementCount MinDetachedFragmentPointCount = 64;
+
+    bool DoUseImplicitHeatPropagation; // When set, heat propagates implicitly at the low-frequency cadence
+
+    SpringForcesKernelType SpringForcesKernel; // Chosen by computer calibration
+
+    bool DoGovernSimulationTimeBudget;
+
+    unsigned int SimulationDegradationLevel; // Chosen by the simulation governor; 0 is no degradation
+
     // Interactions
 
     float ToolSearchRadius;
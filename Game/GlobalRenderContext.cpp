@@ -81,7 +81,9 @@ void GlobalRenderContext::InitializeNoiseTextures(ResourceLocator const & resour
     mShaderManager.SetTextureParameters<ProgramType::LaserRay>();
 }
 
-void GlobalRenderContext::InitializeGenericTextures(ResourceLocator const & resourceLocator)
+void GlobalRenderContext::InitializeGenericTextures(
+    ResourceLocator const & resourceLocator,
+    TaskThreadPool & taskThreadPool)
 {
     //
     // Create generic linear texture atlas
@@ -92,10 +94,18 @@ void GlobalRenderContext::InitializeGenericTextures(ResourceLocator const & reso
         resourceLocator.GetTexturesRootFolderPath());
 
     // Create atlas
-    auto genericLinearTextureAtlas = TextureAtlasBuilder<GenericLinearTextureGroups>::BuildAtlas(
+    auto genericLinearTextureAtlas = TextureAtlasCache<Render::GenericLinearTextureTextureDatabaseTraits>::LoadOrBuild(
         genericLinearTextureDatabase,
         AtlasOptions::None,
-        [](float, ProgressMessageType) {});
+        resourceLocator.GetTextureAtlasCacheFolderPath(),
+        [&taskThreadPool](auto const & database, AtlasOptions options)
+        {
+            return TextureAtlasBuilder<GenericLinearTextureGroups>::BuildAtlas(
+                database,
+                options,
+                [](float, ProgressMessageType) {},
+                &taskThreadPool);
+        });
 
     LogMessage("Generic linear texture atlas size: ", genericLinearTextureAtlas.AtlasData.Size.ToString());
 
@@ -166,10 +176,18 @@ void GlobalRenderContext::InitializeGenericTextures(ResourceLocator const & reso
         resourceLocator.GetTexturesRootFolderPath());
 
     // Create atlas
-    auto genericMipMappedTextureAtlas = TextureAtlasBuilder<GenericMipMappedTextureGroups>::BuildAtlas(
+    auto genericMipMappedTextureAtlas = TextureAtlasCache<Render::GenericMipMappedTextureTextureDatabaseTraits>::LoadOrBuild(
         genericMipMappedTextureDatabase,
         AtlasOptions::None,
-        [](float, ProgressMessageType) {});
+        resourceLocator.GetTextureAtlasCacheFolderPath(),
+        [&taskThreadPool](auto const & database, AtlasOptions options)
+        {
+            return TextureAtlasBuilder<GenericMipMappedTextureGroups>::BuildAtlas(
+                database,
+                options,
+                [](float, ProgressMessageType) {},
+                &taskThreadPool);
+        });
 
     LogMessage("Generic mipmapped texture atlas size: ", genericMipMappedTextureAtlas.AtlasData.Size.ToString());
 
@@ -187,7 +205,8 @@ void GlobalRenderContext::InitializeGenericTextures(ResourceLocator const & reso
     // Upload atlas texture
     GameOpenGL::UploadMipmappedPowerOfTwoTexture(
         std::move(genericMipMappedTextureAtlas.AtlasData),
-        genericMipMappedTextureAtlas.Metadata.GetMaxDimension());
+        genericMipMappedTextureAtlas.Metadata.GetMaxDimension(),
+        &taskThreadPool);
 
     // Set repeat mode
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
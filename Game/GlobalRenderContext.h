@@ -15,6 +15,8 @@
 #include <GameOpenGL/GameOpenGL.h>
 #include <GameOpenGL/ShaderManager.h>
 
+#include <GameCore/TaskThreadPool.h>
+
 #include <cassert>
 #include <memory>
 
@@ -30,7 +32,9 @@ public:
 
     void InitializeNoiseTextures(ResourceLocator const & resourceLocator);
 
-    void InitializeGenericTextures(ResourceLocator const & resourceLocator);
+    void InitializeGenericTextures(
+        ResourceLocator const & resourceLocator,
+        TaskThreadPool & taskThreadPool);
 
     void InitializeExplosionTextures(ResourceLocator const & resourceLocator);
 
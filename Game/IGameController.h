@@ -9,7 +9,9 @@
 #include "IGameEventHandlers.h"
 #include "ResourceLocator.h"
 #include "ShipAutoTexturizationSettings.h"
+#include "ShipLoadCallbacks.h"
 #include "ShipLoadSpecifications.h"
+#include "ShipMemoryReport.h"
 #include "ShipMetadata.h"
 
 #include <GameCore/Colors.h>
@@ -33,7 +35,9 @@ struct IGameController
     {}
 
     virtual void RegisterLifecycleEventHandler(ILifecycleGameEventHandler * handler) = 0;
-    virtual void RegisterStructuralEventHandler(IStructuralGameEventHandler * handler) = 0;
+    virtual void RegisterStructuralEventHandler(
+        IStructuralGameEventHandler * handler,
+        std::uint32_t eventMask = StructuralGameEventMask::All) = 0;
     virtual void RegisterWavePhenomenaEventHandler(IWavePhenomenaGameEventHandler * handler) = 0;
     virtual void RegisterCombustionEventHandler(ICombustionGameEventHandler * handler) = 0;
     virtual void RegisterStatisticsEventHandler(IStatisticsGameEventHandler * handler) = 0;
@@ -45,6 +49,40 @@ struct IGameController
     virtual ShipMetadata ResetAndReloadShip(ShipLoadSpecifications const & loadSpecs) = 0;
     virtual ShipMetadata AddShip(ShipLoadSpecifications const & loadSpecs) = 0;
 
+    // Loads and builds the ship in the background, while the current world keeps running;
+    // the ship resets the world once it's ready. Cancels any load that is still in progress.
+    virtual void ResetAndLoadShipAsync(
+        ShipLoadSpecifications const & loadSpecs,
+        ShipLoadCallbacks && callbacks) = 0;
+    virtual void CancelShipLoad() = 0;
+    virtual bool IsLoadingShip() const = 0;
+
+    // Quick-save: a snapshot of the current world, which may be restored in an instant
+    // as long as no ships have been loaded in the meantime; saving to a file happens
+    // in the background, and loading from a file requires the same ships to be loaded
+    virtual void QuickSave() = 0;
+    virtual void QuickSaveToFile(std::filesystem::path const & filePath) = 0;
+    virtual bool HasQuickSave() const = 0;
+    virtual void QuickLoad() = 0;
+    virtual void QuickLoadFromFile(std::filesystem::path const & filePath) = 0;
+
+    // Snapshot history: a rolling, memory-bounded timeline of snapshots taken every
+    // so often while the simulation runs, which may be scrubbed back through; scrubbing
+    // to a frame forgets all the frames after it
+    virtual bool GetSnapshotHistoryEnabled() const = 0;
+    virtual void SetSnapshotHistoryEnabled(bool value) = 0;
+    virtual size_t GetSnapshotHistoryMaxByteSize() const = 0;
+    virtual void SetSnapshotHistoryMaxByteSize(size_t value) = 0;
+    virtual size_t GetSnapshotHistoryFrameCount() const = 0;
+    virtual float GetSnapshotHistoryFrameSimulationTime(size_t frameIndex) const = 0;
+    virtual void ScrubToSnapshotHistoryFrame(size_t frameIndex) = 0;
+
+    // Telemetry: statistics, perf stats, profiler zone totals, and ship and world events,
+    // streamed as line protocol to a file or named pipe
+    virtual bool IsTelemetryStarted() const = 0;
+    virtual void StartTelemetry(std::filesystem::path const & outputFilePath) = 0;
+    virtual void StopTelemetry() = 0;
+
     virtual RgbImageData TakeScreenshot() = 0;
 
     virtual void RunGameIteration() = 0;
@@ -52,6 +90,10 @@ struct IGameController
 
     virtual void PulseUpdateAtNextGameIteration() = 0;
 
+    // Makes the next game iteration render even when the simulation is not running,
+    // e.g. after the user has interacted with the game
+    virtual void RequestRender() = 0;
+
     virtual void StartRecordingEvents(std::function<void(uint32_t, RecordedEvent const &)> onEventCallback) = 0;
     virtual RecordedEvents StopRecordingEvents() = 0;
     virtual void ReplayRecordedEvent(RecordedEvent const & event) = 0;
@@ -146,6 +188,11 @@ struct IGameController
     virtual bool DestroyTriangle(ElementId triangleId) = 0;
     virtual bool RestoreTriangle(ElementId triangleId) = 0;
 
+    virtual std::vector<ShipMemoryReport> GetShipMemoryReports() const = 0;
+
+    // The costs of the ships updated in the last stats period, the most expensive first
+    virtual std::vector<std::string> GetShipPerfReports() const = 0;
+
     //
     // Rendering controls and parameters
     //
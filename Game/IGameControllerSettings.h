@@ -26,6 +26,7 @@
 struct IGameControllerSettings
 {
     virtual float GetSimulationStepTimeDuration() const = 0;
+    virtual float GetGameIterationTimeDuration() const = 0;
 
     virtual float GetNumMechanicalDynamicsIterationsAdjustment() const = 0;
     virtual void SetNumMechanicalDynamicsIterationsAdjustment(float value) = 0;
@@ -316,6 +317,48 @@ struct IGameControllerSettings
     virtual std::chrono::minutes GetDayLightCycleDuration() const = 0;
     virtual void SetDayLightCycleDuration(std::chrono::minutes value) = 0;
 
+    virtual bool GetDoUpdateShipsConcurrently() const = 0;
+    virtual void SetDoUpdateShipsConcurrently(bool value) = 0;
+
+    virtual bool GetDoUpdateOceanSurfaceConcurrently() const = 0;
+    virtual void SetDoUpdateOceanSurfaceConcurrently(bool value) = 0;
+
+    virtual bool GetDoPipelineFrames() const = 0;
+    virtual void SetDoPipelineFrames(bool value) = 0;
+
+    virtual bool GetDoInterpolateRendering() const = 0;
+    virtual void SetDoInterpolateRendering(bool value) = 0;
+
+    virtual float GetRenderFrameRate() const = 0;
+    virtual void SetRenderFrameRate(float value) = 0;
+
+    virtual bool GetDoRenderOnDemand() const = 0;
+    virtual void SetDoRenderOnDemand(bool value) = 0;
+
+    virtual bool GetDoThrottleIdleGameIterations() const = 0;
+    virtual void SetDoThrottleIdleGameIterations(bool value) = 0;
+
+    virtual bool GetDoUpdateWaterAndPressureConcurrently() const = 0;
+    virtual void SetDoUpdateWaterAndPressureConcurrently(bool value) = 0;
+
+    virtual bool GetDoAdaptMechanicalDynamicsIterations() const = 0;
+    virtual void SetDoAdaptMechanicalDynamicsIterations(bool value) = 0;
+
+    virtual bool GetDoGovernSimulationTimeBudget() const = 0;
+    virtual void SetDoGovernSimulationTimeBudget(bool value) = 0;
+
+    virtual bool GetDoPutRestingConnectedComponentsToSleep() const = 0;
+    virtual void SetDoPutRestingConnectedComponentsToSleep(bool value) = 0;
+
+    virtual bool GetDoCompactDestroyedSprings() const = 0;
+    virtual void SetDoCompactDestroyedSprings(bool value) = 0;
+
+    virtual bool GetDoSplitDetachedFragments() const = 0;
+    virtual void SetDoSplitDetachedFragments(bool value) = 0;
+
+    virtual bool GetDoUseImplicitHeatPropagation() const = 0;
+    virtual void SetDoUseImplicitHeatPropagation(bool value) = 0;
+
     virtual float GetShipStrengthRandomizationDensityAdjustment() const = 0;
     virtual void SetShipStrengthRandomizationDensityAdjustment(float value) = 0;
 
@@ -275,6 +275,9 @@ struct IGameControllerSettingsOptions
     virtual unsigned int GetMinNumberOfClouds() const = 0;
     virtual unsigned int GetMaxNumberOfClouds() const = 0;
 
+    virtual float GetMinRenderFrameRate() const = 0;
+    virtual float GetMaxRenderFrameRate() const = 0;
+
     virtual std::chrono::minutes GetMinDayLightCycleDuration() const = 0;
     virtual std::chrono::minutes GetMaxDayLightCycleDuration() const = 0;
 
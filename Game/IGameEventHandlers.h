@@ -5,11 +5,13 @@
 ***************************************************************************************/
 #pragma once
 
+#include "AggregatedGameEvents.h"
 #include "Materials.h"
 #include "ShipMetadata.h"
 
 #include <GameCore/GameTypes.h>
 
+#include <cstdint>
 #include <optional>
 
 /*
@@ -47,10 +49,42 @@ struct ILifecycleGameEventHandler
     {
         // Default-implemented
     }
+
+    virtual void OnShipSplit(ShipId /*shipId*/)
+    {
+        // Default-implemented
+    }
+};
+
+/*
+ * The structural events a handler may subscribe to, when registering; a handler
+ * only receives the events it has subscribed to.
+ */
+struct StructuralGameEventMask
+{
+    static std::uint32_t constexpr Stress = 1u << 0;
+    static std::uint32_t constexpr Break = 1u << 1;
+    static std::uint32_t constexpr LampBroken = 1u << 2;
+    static std::uint32_t constexpr LampExploded = 1u << 3;
+    static std::uint32_t constexpr LampImploded = 1u << 4;
+
+    static std::uint32_t constexpr All = Stress | Break | LampBroken | LampExploded | LampImploded;
 };
 
 struct IStructuralGameEventHandler
 {
+    /*
+     * Receives all of the stress events aggregated since the last flush, at once;
+     * by default each event goes to OnStress().
+     */
+    virtual void OnStressBatch(StructuralMaterialEventAggregation const & events)
+    {
+        for (auto const & entry : events)
+        {
+            OnStress(*(std::get<0>(entry.first)), std::get<1>(entry.first), entry.second);
+        }
+    }
+
     virtual void OnStress(
         StructuralMaterial const & /*structuralMaterial*/,
         bool /*isUnderwater*/,
@@ -59,6 +93,18 @@ struct IStructuralGameEventHandler
         // Default-implemented
     }
 
+    /*
+     * Receives all of the break events aggregated since the last flush, at once;
+     * by default each event goes to OnBreak().
+     */
+    virtual void OnBreakBatch(StructuralMaterialEventAggregation const & events)
+    {
+        for (auto const & entry : events)
+        {
+            OnBreak(*(std::get<0>(entry.first)), std::get<1>(entry.first), entry.second);
+        }
+    }
+
     virtual void OnBreak(
         StructuralMaterial const & /*structuralMaterial*/,
         bool /*isUnderwater*/,
@@ -6,19 +6,187 @@
 #include "ImageFileTools.h"
 
 #include <GameCore/GameException.h>
+#include <GameCore/ImageTools.h>
 
 #include <IL/il.h>
 #include <IL/ilu.h>
 
+#include <png.h>
+
 #include <algorithm>
 #include <cassert>
+#include <cctype>
 #include <cstring>
+#include <fstream>
 #include <regex>
+#include <type_traits>
+#include <vector>
+
+namespace {
+
+struct PngReadState
+{
+    unsigned char const * Data;
+    size_t Size;
+    size_t Offset;
+};
+
+void PngErrorHandler(png_structp png, png_const_charp /*message*/)
+{
+    // Back to the setjmp of whoever's running libpng
+    png_longjmp(png, 1);
+}
+
+void PngWarningHandler(png_structp /*png*/, png_const_charp /*message*/)
+{
+    // Ignore
+}
+
+void PngReadHandler(png_structp png, png_bytep data, png_size_t length)
+{
+    auto * const readState = reinterpret_cast<PngReadState *>(png_get_io_ptr(png));
+    if (length > readState->Size - readState->Offset)
+    {
+        png_error(png, "Unexpected end of PNG data");
+    }
+
+    std::memcpy(data, readState->Data + readState->Offset, length);
+    readState->Offset += length;
+}
+
+void PngWriteHandler(png_structp png, png_bytep data, png_size_t length)
+{
+    auto * const buffer = reinterpret_cast<DeSerializationBuffer<BigEndianess> *>(png_get_io_ptr(png));
+    std::memcpy(buffer->Receive(length), data, length);
+}
+
+void PngFlushHandler(png_structp /*png*/)
+{
+    // Nop
+}
+
+//
+// The functions below run libpng, which reports errors by longjmp'ing back into them;
+// hence they only hold plain data, which may be safely jumped over.
+//
+
+bool PngReadHeader(
+    png_structp png,
+    png_infop info,
+    png_uint_32 & width,
+    png_uint_32 & height)
+{
+    if (setjmp(png_jmpbuf(png)))
+    {
+        return false;
+    }
+
+    png_read_info(png, info);
+
+    int const colorType = png_get_color_type(png, info);
+    int const bitDepth = png_get_bit_depth(png, info);
+    bool const hasTransparency = (png_get_valid(png, info, PNG_INFO_tRNS) != 0);
+
+    //
+    // Everything becomes 8-bit RGBA; we take stored values as they are - with no
+    // gamma correction - as material color keys have to match exactly
+    //
+
+    if (bitDepth == 16)
+        png_set_strip_16(png);
+
+    if (colorType == PNG_COLOR_TYPE_PALETTE)
+        png_set_palette_to_rgb(png);
+
+    if (colorType == PNG_COLOR_TYPE_GRAY && bitDepth < 8)
+        png_set_expand_gray_1_2_4_to_8(png);
+
+    if (hasTransparency)
+        png_set_tRNS_to_alpha(png);
+
+    if (colorType == PNG_COLOR_TYPE_GRAY || colorType == PNG_COLOR_TYPE_GRAY_ALPHA)
+        png_set_gray_to_rgb(png);
+
+    if ((colorType & PNG_COLOR_MASK_ALPHA) == 0 && !hasTransparency)
+        png_set_filler(png, 0xff, PNG_FILLER_AFTER);
+
+    png_set_interlace_handling(png);
+
+    png_read_update_info(png, info);
+
+    width = png_get_image_width(png, info);
+    height = png_get_image_height(png, info);
+
+    return png_get_rowbytes(png, info) == static_cast<png_size_t>(width) * 4;
+}
+
+bool PngReadRows(
+    png_structp png,
+    png_bytepp rows)
+{
+    if (setjmp(png_jmpbuf(png)))
+    {
+        return false;
+    }
+
+    png_read_image(png, rows);
+    png_read_end(png, nullptr);
+
+    return true;
+}
+
+bool PngWrite(
+    png_structp png,
+    png_infop info,
+    png_uint_32 width,
+    png_uint_32 height,
+    png_bytepp rows)
+{
+    if (setjmp(png_jmpbuf(png)))
+    {
+        return false;
+    }
+
+    png_set_IHDR(
+        png,
+        info,
+        width,
+        height,
+        8,
+        PNG_COLOR_TYPE_RGBA,
+        PNG_INTERLACE_NONE,
+        PNG_COMPRESSION_TYPE_DEFAULT,
+        PNG_FILTER_TYPE_DEFAULT);
+
+    png_write_info(png, info);
+    png_write_image(png, rows);
+    png_write_end(png, nullptr);
+
+    return true;
+}
+
+}
 
 bool ImageFileTools::mIsInitialized = false;
 
+std::mutex ImageFileTools::mDevILMutex;
+
 ImageSize ImageFileTools::GetImageSize(std::filesystem::path const & filepath)
 {
+    // PNGs tell their size in their header, no need to decode them
+    if (IsPngFile(filepath))
+    {
+        auto const pngImageSize = InternalGetPngImageSize(filepath);
+        if (pngImageSize.has_value()
+            && pngImageSize->width > 0
+            && pngImageSize->height > 0)
+        {
+            return *pngImageSize;
+        }
+    }
+
+    std::lock_guard const lock{ mDevILMutex };
+
     //
     // Load image
     //
@@ -55,18 +223,16 @@ ImageSize ImageFileTools::GetImageSize(std::filesystem::path const & filepath)
 RgbaImageData ImageFileTools::LoadImageRgba(std::filesystem::path const & filepath)
 {
     return InternalLoadImage<rgbaColor>(
-        InternalOpenImage(filepath),
+        filepath,
         IL_RGBA,
-        IL_ORIGIN_LOWER_LEFT,
         std::nullopt);
 }
 
 RgbImageData ImageFileTools::LoadImageRgb(std::filesystem::path const & filepath)
 {
     return InternalLoadImage<rgbColor>(
-        InternalOpenImage(filepath),
+        filepath,
         IL_RGB,
-        IL_ORIGIN_LOWER_LEFT,
         std::nullopt);
 }
 
@@ -75,9 +241,8 @@ RgbaImageData ImageFileTools::LoadImageRgbaAndMagnify(
     int magnificationFactor)
 {
     return InternalLoadImage<rgbaColor>(
-        InternalOpenImage(filepath),
+        filepath,
         IL_RGBA,
-        IL_ORIGIN_LOWER_LEFT,
         ResizeInfo(
             [magnificationFactor](ImageSize const & originalImageSize)
             {
@@ -93,9 +258,8 @@ RgbaImageData ImageFileTools::LoadImageRgbaAndResize(
     int resizedWidth)
 {
     return InternalLoadImage<rgbaColor>(
-        InternalOpenImage(filepath),
+        filepath,
         IL_RGBA,
-        IL_ORIGIN_LOWER_LEFT,
         ResizeInfo(
             [resizedWidth](ImageSize const & originalImageSize)
             {
@@ -114,20 +278,20 @@ RgbaImageData ImageFileTools::LoadImageRgbaAndResize(
     std::filesystem::path const & filepath,
     ImageSize const & maxSize)
 {
-    return InternalLoadImageAndResize<rgbaColor>(
-        InternalOpenImage(filepath),
+    return InternalLoadImage<rgbaColor>(
+        filepath,
         IL_RGBA,
-        maxSize);
+        MakeShrinkToFitResizeInfo(maxSize));
 }
 
 RgbImageData ImageFileTools::LoadImageRgbAndResize(
     std::filesystem::path const & filepath,
     ImageSize const & maxSize)
 {
-    return InternalLoadImageAndResize<rgbColor>(
-        InternalOpenImage(filepath),
+    return InternalLoadImage<rgbColor>(
+        filepath,
         IL_RGB,
-        maxSize);
+        MakeShrinkToFitResizeInfo(maxSize));
 }
 
 void ImageFileTools::SavePngImage(
@@ -157,9 +321,8 @@ void ImageFileTools::SavePngImage(
 RgbaImageData ImageFileTools::DecodePngImage(DeSerializationBuffer<BigEndianess> const & buffer)
 {
     return InternalLoadImage<rgbaColor>(
-        InternalOpenImage(buffer, IL_PNG),
+        buffer,
         IL_RGBA,
-        IL_ORIGIN_LOWER_LEFT,
         std::nullopt);
 }
 
@@ -167,43 +330,65 @@ RgbaImageData ImageFileTools::DecodePngImageAndResize(
     DeSerializationBuffer<BigEndianess> const & buffer,
     ImageSize const & maxSize)
 {
-    return InternalLoadImageAndResize<rgbaColor>(
-        InternalOpenImage(buffer, IL_PNG),
+    return InternalLoadImage<rgbaColor>(
+        buffer,
         IL_RGBA,
-        maxSize);
+        MakeShrinkToFitResizeInfo(maxSize));
 }
 
 size_t ImageFileTools::EncodePngImage(
     RgbaImageData const & image,
     DeSerializationBuffer<BigEndianess> & buffer)
 {
-    CheckInitialized();
+    //
+    // Encode via libpng, straight into the buffer
+    //
 
-    ILuint imageHandle;
-    ilGenImages(1, &imageHandle);
-    ilBindImage(imageHandle);
+    png_structp png = png_create_write_struct(PNG_LIBPNG_VER_STRING, nullptr, PngErrorHandler, PngWarningHandler);
+    if (png == nullptr)
+    {
+        throw GameException("Could not encode image: cannot initialize PNG encoder");
+    }
 
-    ilTexImage(
-        image.Size.width,
-        image.Size.height,
-        1,
-        static_cast<ILubyte>(4), // bpp
-        IL_RGBA,
-        IL_UNSIGNED_BYTE,
-        const_cast<void *>(reinterpret_cast<void const *>(image.Data.get())));
+    png_infop info = png_create_info_struct(png);
+    if (info == nullptr)
+    {
+        png_destroy_write_struct(&png, nullptr);
+        throw GameException("Could not encode image: cannot initialize PNG encoder");
+    }
 
-    // Get required size
-    auto const requiredSize = ilSaveL(IL_PNG, nullptr, 0);
+    png_set_write_fn(png, &buffer, PngWriteHandler, PngFlushHandler);
 
-    // Reserve room and advance
-    void * buf = reinterpret_cast<void *>(buffer.Receive(static_cast<size_t>(requiredSize)));
+    // Favor speed over size: a single filter rather than trying all of them at each row,
+    // and a low compression level - a few times faster than the defaults, for ~15% bigger
+    // files with textures
+    png_set_filter(png, PNG_FILTER_TYPE_BASE, PNG_FILTER_UP);
+    png_set_compression_level(png, 2);
 
-    // Encode to buffer
-    ilSaveL(IL_PNG, buf, requiredSize);
+    // PNG rows go top to bottom, while our origin is at lower-left
+    std::vector<png_bytep> rows(image.Size.height);
+    for (int y = 0; y < image.Size.height; ++y)
+    {
+        rows[y] = reinterpret_cast<png_bytep>(const_cast<rgbaColor *>(image.Data.get() + (image.Size.height - 1 - y) * image.Size.width));
+    }
 
-    ilDeleteImage(imageHandle);
+    size_t const startSize = buffer.GetSize();
+
+    bool const isSuccess = PngWrite(
+        png,
+        info,
+        static_cast<png_uint_32>(image.Size.width),
+        static_cast<png_uint_32>(image.Size.height),
+        rows.data());
 
-    return static_cast<size_t>(requiredSize);
+    png_destroy_write_struct(&png, &info);
+
+    if (!isSuccess)
+    {
+        throw GameException("Could not encode image");
+    }
+
+    return buffer.GetSize() - startSize;
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////
@@ -283,17 +468,40 @@ unsigned int ImageFileTools::InternalOpenImage(
     return static_cast<unsigned int>(imghandle);
 }
 
-template <typename TColor>
-ImageData<TColor> ImageFileTools::InternalLoadImageAndResize(
-    unsigned int imageHandle,
-    int targetFormat,
-    ImageSize const & maxSize)
+unsigned int ImageFileTools::InternalOpenImage(RgbaImageData const & image)
 {
-    return InternalLoadImage<TColor>(
-        imageHandle,
-        targetFormat,
-        IL_ORIGIN_LOWER_LEFT,
-        ResizeInfo(
+    CheckInitialized();
+
+    ILuint imghandle;
+    ilGenImages(1, &imghandle);
+    ilBindImage(imghandle);
+
+    if (!ilTexImage(
+        image.Size.width,
+        image.Size.height,
+        1,
+        static_cast<ILubyte>(4), // bpp
+        IL_RGBA,
+        IL_UNSIGNED_BYTE,
+        const_cast<void *>(reinterpret_cast<void const *>(image.Data.get()))))
+    {
+        ILint const devilError = ilGetError();
+
+        ilDeleteImage(imghandle);
+
+        // Provide DevIL's error message now
+        std::string const devilErrorMessage(iluErrorString(devilError));
+        throw GameException("Could not load image: " + devilErrorMessage);
+    }
+
+    ilRegisterOrigin(IL_ORIGIN_LOWER_LEFT);
+
+    return static_cast<unsigned int>(imghandle);
+}
+
+ImageFileTools::ResizeInfo ImageFileTools::MakeShrinkToFitResizeInfo(ImageSize const & maxSize)
+{
+    return ResizeInfo(
             [maxSize](ImageSize const & originalImageSize)
             {
                 float wShrinkFactor = static_cast<float>(maxSize.width) / static_cast<float>(originalImageSize.width);
@@ -306,7 +514,107 @@ ImageData<TColor> ImageFileTools::InternalLoadImageAndResize(
                     static_cast<int>(round(static_cast<float>(originalImageSize.width) * shrinkFactor)),
                     static_cast<int>(round(static_cast<float>(originalImageSize.height) * shrinkFactor)));
             },
-            ILU_BILINEAR));
+            ILU_BILINEAR);
+}
+
+template <typename TColor>
+ImageData<TColor> ImageFileTools::InternalLoadImage(
+    std::filesystem::path const & filepath,
+    int targetFormat,
+    std::optional<ResizeInfo> resizeInfo)
+{
+    // PNGs - by far the most common of our images - we decode ourselves,
+    // leaving everything else to DevIL
+    if (IsPngFile(filepath))
+    {
+        std::ifstream file(filepath, std::ios::in | std::ios::binary | std::ios::ate);
+        if (file.is_open())
+        {
+            std::vector<unsigned char> fileData(static_cast<size_t>(file.tellg()));
+
+            file.seekg(0);
+            if (file.read(reinterpret_cast<char *>(fileData.data()), fileData.size()))
+            {
+                auto image = InternalDecodePngImage(fileData.data(), fileData.size());
+                if (image.has_value())
+                {
+                    return InternalLoadImage<TColor>(
+                        std::move(*image),
+                        targetFormat,
+                        std::move(resizeInfo));
+                }
+            }
+        }
+    }
+
+    std::lock_guard const lock{ mDevILMutex };
+
+    return InternalLoadImage<TColor>(
+        InternalOpenImage(filepath),
+        targetFormat,
+        IL_ORIGIN_LOWER_LEFT,
+        std::move(resizeInfo));
+}
+
+template <typename TColor>
+ImageData<TColor> ImageFileTools::InternalLoadImage(
+    DeSerializationBuffer<BigEndianess> const & pngBuffer,
+    int targetFormat,
+    std::optional<ResizeInfo> resizeInfo)
+{
+    auto image = InternalDecodePngImage(pngBuffer.GetData(), pngBuffer.GetSize());
+    if (image.has_value())
+    {
+        return InternalLoadImage<TColor>(
+            std::move(*image),
+            targetFormat,
+            std::move(resizeInfo));
+    }
+
+    std::lock_guard const lock{ mDevILMutex };
+
+    return InternalLoadImage<TColor>(
+        InternalOpenImage(pngBuffer, IL_PNG),
+        targetFormat,
+        IL_ORIGIN_LOWER_LEFT,
+        std::move(resizeInfo));
+}
+
+template <typename TColor>
+ImageData<TColor> ImageFileTools::InternalLoadImage(
+    RgbaImageData && image,
+    int targetFormat,
+    std::optional<ResizeInfo> resizeInfo)
+{
+    if constexpr (std::is_same_v<TColor, rgbaColor>)
+    {
+        if (!resizeInfo)
+        {
+            return std::move(image);
+        }
+
+        auto const newImageSize = resizeInfo->ResizeHandler(image.Size);
+
+        if (newImageSize == image.Size)
+        {
+            return std::move(image);
+        }
+
+        if (newImageSize.width > 0 && newImageSize.width <= image.Size.width
+            && newImageSize.height > 0 && newImageSize.height <= image.Size.height)
+        {
+            return ImageTools::Downsample(image, newImageSize);
+        }
+    }
+
+    // Conversions and enlargements we still leave to DevIL
+    std::lock_guard const lock{ mDevILMutex };
+
+    return InternalLoadImage<TColor>(
+        InternalOpenImage(image),
+        targetFormat,
+        IL_ORIGIN_LOWER_LEFT,
+        std::move(resizeInfo));
 }
 
 template <typename TColor>
@@ -396,6 +704,8 @@ void ImageFileTools::InternalSavePngImage(
     int format,
     std::filesystem::path filepath)
 {
+    std::lock_guard const lock{ mDevILMutex };
+
     CheckInitialized();
 
     ILuint imghandle;
@@ -415,4 +725,101 @@ void ImageFileTools::InternalSavePngImage(
     ilSave(IL_PNG, filepath.string().c_str());
 
     ilDeleteImage(imghandle);
-}
\ No newline at end of file
+}
+
+bool ImageFileTools::IsPngFile(std::filesystem::path const & filepath)
+{
+    std::string extension = filepath.extension().string();
+    std::transform(
+        extension.begin(),
+        extension.end(),
+        extension.begin(),
+        [](unsigned char c)
+        {
+            return static_cast<char>(std::tolower(c));
+        });
+
+    return extension == ".png";
+}
+
+std::optional<ImageSize> ImageFileTools::InternalGetPngImageSize(std::filesystem::path const & filepath)
+{
+    // Signature (8), IHDR length (4), IHDR tag (4), width (4), height (4)
+    unsigned char header[24];
+
+    std::ifstream file(filepath, std::ios::in | std::ios::binary);
+    if (!file.is_open()
+        || !file.read(reinterpret_cast<char *>(header), sizeof(header))
+        || png_sig_cmp(header, 0, 8) != 0
+        || std::memcmp(header + 12, "IHDR", 4) != 0)
+    {
+        return std::nullopt;
+    }
+
+    auto const readBigEndian32 = [&header](size_t offset)
+    {
+        return static_cast<int>(
+            (static_cast<std::uint32_t>(header[offset]) << 24)
+            | (static_cast<std::uint32_t>(header[offset + 1]) << 16)
+            | (static_cast<std::uint32_t>(header[offset + 2]) << 8)
+            | static_cast<std::uint32_t>(header[offset + 3]));
+    };
+
+    return ImageSize(
+        readBigEndian32(16),
+        readBigEndian32(20));
+}
+
+std::optional<RgbaImageData> ImageFileTools::InternalDecodePngImage(
+    unsigned char const * data,
+    size_t size)
+{
+    if (size < 8 || png_sig_cmp(data, 0, 8) != 0)
+    {
+        return std::nullopt;
+    }
+
+    png_structp png = png_create_read_struct(PNG_LIBPNG_VER_STRING, nullptr, PngErrorHandler, PngWarningHandler);
+    if (png == nullptr)
+    {
+        return std::nullopt;
+    }
+
+    png_infop info = png_create_info_struct(png);
+    if (info == nullptr)
+    {
+        png_destroy_read_struct(&png, nullptr, nullptr);
+        return std::nullopt;
+    }
+
+    PngReadState readState{ data, size, 0 };
+    png_set_read_fn(png, &readState, PngReadHandler);
+
+    std::optional<RgbaImageData> result;
+
+    png_uint_32 width = 0;
+    png_uint_32 height = 0;
+    if (PngReadHeader(png, info, width, height)
+        && width > 0
+        && height > 0)
+    {
+        ImageSize const imageSize(static_cast<int>(width), static_cast<int>(height));
+        auto imageData = std::make_unique<rgbaColor[]>(imageSize.GetLinearSize());
+
+        // PNG rows go top to bottom, while our origin is at lower-left
+        std::vector<png_bytep> rows(height);
+        for (png_uint_32 y = 0; y < height; ++y)
+        {
+            rows[y] = reinterpret_cast<png_bytep>(imageData.get() + (height - 1 - y) * width);
+        }
+
+        if (PngReadRows(png, rows.data()))
+        {
+            result.emplace(imageSize, std::move(imageData));
+        }
+    }
+
+    png_destroy_read_struct(&png, &info, nullptr);
+
+    return result;
+}
@@ -10,11 +10,15 @@
 
 #include <filesystem>
 #include <functional>
+#include <mutex>
 #include <optional>
 
 /*
  * Image standards:
  *  - Coordinates have origin at lower-left
+ *
+ * Thread-safe: PNGs are decoded and encoded independently on each thread, while
+ * everything left to DevIL - whose state is global - is serialized.
  */
 class ImageFileTools
 {
@@ -57,6 +61,8 @@ private:
         DeSerializationBuffer<BigEndianess> const & buffer,
         unsigned int imageType);
 
+    static unsigned int InternalOpenImage(RgbaImageData const & image);
+
     struct ResizeInfo
     {
         std::function<ImageSize(ImageSize const &)> ResizeHandler;
@@ -70,11 +76,25 @@ private:
         {}
     };
 
+    static ResizeInfo MakeShrinkToFitResizeInfo(ImageSize const & maxSize);
+
     template <typename TColor>
-    static ImageData<TColor> InternalLoadImageAndResize(
-        unsigned int imageHandle,
+    static ImageData<TColor> InternalLoadImage(
+        std::filesystem::path const & filepath,
         int targetFormat,
-        ImageSize const & maxSize);
+        std::optional<ResizeInfo> resizeInfo);
+
+    template <typename TColor>
+    static ImageData<TColor> InternalLoadImage(
+        DeSerializationBuffer<BigEndianess> const & pngBuffer,
+        int targetFormat,
+        std::optional<ResizeInfo> resizeInfo);
+
+    template <typename TColor>
+    static ImageData<TColor> InternalLoadImage(
+        RgbaImageData && image,
+        int targetFormat,
+        std::optional<ResizeInfo> resizeInfo);
 
     template <typename TColor>
     static ImageData<TColor> InternalLoadImage(
@@ -83,6 +103,18 @@ private:
         int targetOrigin,
         std::optional<ResizeInfo> resizeInfo);
 
+    static bool IsPngFile(std::filesystem::path const & filepath);
+
+    static std::optional<ImageSize> InternalGetPngImageSize(std::filesystem::path const & filepath);
+
+    /*
+     * Decodes a PNG image via libpng, into an image with origin at lower-left; returns
+     * none if libpng can't decode it, in which case we leave it to DevIL.
+     */
+    static std::optional<RgbaImageData> InternalDecodePngImage(
+        unsigned char const * data,
+        size_t size);
+
     static void InternalSavePngImage(
         ImageSize imageSize,
         void const * imageData,
@@ -93,4 +125,7 @@ private:
 private:
 
     static bool mIsInitialized;
+
+    // Guards all uses of DevIL
+    static std::mutex mDevILMutex;
 };
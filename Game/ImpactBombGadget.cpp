@@ -33,6 +33,25 @@ ImpactBombGadget::ImpactBombGadget(
 {
 }
 
+ImpactBombGadget::ImpactBombGadget(
+    ImpactBombGadget const & other,
+    ShipFragmentMap const & fragmentMap,
+    IShipPhysicsHandler & shipPhysicsHandler,
+    Points & shipPoints,
+    Springs & shipSprings)
+    : Gadget(
+        other,
+        fragmentMap,
+        shipPhysicsHandler,
+        shipPoints,
+        shipSprings)
+    , mState(other.mState)
+    , mExplosionFadeoutCounter(other.mExplosionFadeoutCounter)
+    , mExplosionPosition(other.mExplosionPosition)
+    , mExplosionPlaneId(other.mExplosionPlaneId)
+{
+}
+
 bool ImpactBombGadget::Update(
     GameWallClock::time_point /*currentWallClockTime*/,
     float currentSimulationTime,
@@ -9,9 +9,11 @@
 #include "RopeBuffer.h"
 
 #include <GameCore/Buffer2D.h>
+#include <GameCore/Buffer2DTileSnapshot.h>
 #include <GameCore/Colors.h>
 #include <GameCore/GameTypes.h>
 #include <GameCore/ImageData.h>
+#include <GameCore/SparseBuffer2D.h>
 
 #include <cassert>
 #include <map>
@@ -142,6 +144,35 @@ private:
         ShipSpaceRect const & rect) const;
 };
 
+/*
+ * An electrical layer in run-length-encoded form, for keeping layers aside - e.g. for undo;
+ * electrical layers are mostly empty, and this form only costs their occupied particles.
+ */
+struct SparseElectricalLayerData
+{
+    SparseBuffer2D<ElectricalElement, struct ShipSpaceTag> Buffer;
+    ElectricalPanelMetadata Panel;
+
+    explicit SparseElectricalLayerData(ElectricalLayerData const & electricalLayer)
+        : Buffer(electricalLayer.Buffer)
+        , Panel(electricalLayer.Panel)
+    {}
+
+    ElectricalLayerData MakeDense() const
+    {
+        ElectricalPanelMetadata panelClone = Panel;
+
+        return ElectricalLayerData(
+            Buffer.MakeDense(),
+            std::move(panelClone));
+    }
+
+    size_t GetByteSize() const
+    {
+        return Buffer.GetByteSize();
+    }
+};
+
 template <>
 struct LayerTypeTraits<LayerType::Electrical>
 {
@@ -226,6 +257,9 @@ struct LayerTypeTraits<LayerType::Texture>
     using layer_data_type = TextureLayerData;
 };
 
+// Copy-on-write snapshot of a texture layer's buffer, for cheap undo of edits
+using TextureLayerSnapshot = Buffer2DTileSnapshot<rgbaColor, struct ImageTag>;
+
 //////////////////////////////////////////////////////////////////
 // All Layers
 //////////////////////////////////////////////////////////////////
@@ -266,6 +300,15 @@ struct ShipLayers
         return (bool)TextureLayer;
     }
 
+    ShipLayers Clone() const
+    {
+        return ShipLayers(
+            StructuralLayer.Clone(),
+            ElectricalLayer ? std::make_unique<ElectricalLayerData>(ElectricalLayer->Clone()) : nullptr,
+            RopesLayer ? std::make_unique<RopesLayerData>(RopesLayer->Clone()) : nullptr,
+            TextureLayer ? std::make_unique<TextureLayerData>(TextureLayer->Clone()) : nullptr);
+    }
+
     void Flip(DirectionType direction);
     
     void Rotate90(RotationDirectionType direction);
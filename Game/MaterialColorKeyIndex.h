@@ -0,0 +1,145 @@
+/***************************************************************************************
+* Original Author:      Gabriele Giuseppini
+* Created:              2026-10-14
+* Copyright:            Gabriele Giuseppini  (https://github.com/GabrieleGiuseppini)
+***************************************************************************************/
+#pragma once
+
+#include <GameCore/GameTypes.h>
+
+#include <cstdint>
+#include <vector>
+
+/*
+ * A flat, open-addressing index from material color keys to materials, built
+ * once at material database load time and queried once per pixel when
+ * converting images into layers.
+ *
+ * Color keys are packed into their 24 bits, and the table is kept at most
+ * half-full, so that lookups - found or not - are a multiply, a shift, and
+ * a handful of linear probes over contiguous memory.
+ */
+template<typename TMaterial>
+class MaterialColorKeyIndex final
+{
+public:
+
+    MaterialColorKeyIndex()
+        : mSlots(2, Slot{ EmptyKey, nullptr })
+        , mShift(31)
+        , mCount(0)
+    {}
+
+    /*
+     * Reserves room for the specified number of entries; entries inserted earlier
+     * are kept.
+     */
+    void Reserve(size_t count)
+    {
+        unsigned int bits = 1;
+        while ((size_t(1) << bits) < count * 2)
+        {
+            ++bits;
+        }
+
+        if ((size_t(1) << bits) <= mSlots.size())
+            return;
+
+        std::vector<Slot> oldSlots(std::move(mSlots));
+        mSlots.assign(size_t(1) << bits, Slot{ EmptyKey, nullptr });
+        mShift = 32 - bits;
+        mCount = 0;
+
+        for (auto const & slot : oldSlots)
+        {
+            if (slot.Key != EmptyKey)
+            {
+                TryInsert(slot.Key, slot.Material);
+            }
+        }
+    }
+
+    /*
+     * Inserts the material for the specified key, unless the key is already there;
+     * returns whether the material has been inserted.
+     */
+    bool TryInsert(
+        MaterialColorKey const & colorKey,
+        TMaterial const * material)
+    {
+        return TryInsert(Pack(colorKey), material);
+    }
+
+    TMaterial const * Find(MaterialColorKey const & colorKey) const
+    {
+        std::uint32_t const key = Pack(colorKey);
+        size_t const mask = mSlots.size() - 1;
+        for (size_t s = Hash(key);; s = (s + 1) & mask)
+        {
+            if (mSlots[s].Key == key)
+                return mSlots[s].Material;
+            else if (mSlots[s].Key == EmptyKey)
+                return nullptr;
+        }
+    }
+
+    size_t GetSize() const
+    {
+        return mCount;
+    }
+
+private:
+
+    // Not a valid 24-bit key
+    static std::uint32_t constexpr EmptyKey = 0xffffffffu;
+
+    struct Slot
+    {
+        std::uint32_t Key;
+        TMaterial const * Material;
+    };
+
+    static std::uint32_t Pack(MaterialColorKey const & colorKey)
+    {
+        return (static_cast<std::uint32_t>(colorKey.r) << 16)
+            | (static_cast<std::uint32_t>(colorKey.g) << 8)
+            | static_cast<std::uint32_t>(colorKey.b);
+    }
+
+    size_t Hash(std::uint32_t key) const
+    {
+        // Fibonacci hashing
+        return static_cast<size_t>((key * 0x9e3779b1u) >> mShift);
+    }
+
+    bool TryInsert(
+        std::uint32_t key,
+        TMaterial const * material)
+    {
+        if ((mCount + 1) * 2 > mSlots.size())
+        {
+            Reserve(mCount + 1);
+        }
+
+        size_t const mask = mSlots.size() - 1;
+        for (size_t s = Hash(key);; s = (s + 1) & mask)
+        {
+            if (mSlots[s].Key == key)
+            {
+                return false;
+            }
+            else if (mSlots[s].Key == EmptyKey)
+            {
+                mSlots[s] = Slot{ key, material };
+                ++mCount;
+                return true;
+            }
+        }
+    }
+
+private:
+
+    std::vector<Slot> mSlots; // Size is a power of two
+    unsigned int mShift; // 32 - log2(size)
+    size_t mCount;
+};
@@ -8,6 +8,331 @@
 #include <GameCore/Log.h>
 
 #include <algorithm>
+#include <fstream>
+#include <iterator>
+#include <type_traits>
+
+namespace /* anonymous */ {
+
+    // Bump whenever the compiled form changes, including when a material gains or loses a field
+    static std::uint32_t constexpr CompiledDatabaseVersion = 1;
+
+    // FNV-1a
+    class Hasher
+    {
+    public:
+
+        void AddBytes(void const * bytes, size_t size)
+        {
+            for (size_t b = 0; b < size; ++b)
+            {
+                mHash ^= static_cast<std::uint64_t>(static_cast<unsigned char const *>(bytes)[b]);
+                mHash *= 1099511628211ull;
+            }
+        }
+
+        std::uint64_t GetHash() const
+        {
+            return mHash;
+        }
+
+    private:
+
+        std::uint64_t mHash{ 14695981039346656037ull };
+    };
+
+#pragma pack(push, 1)
+
+    struct CompiledDatabaseFileHeader
+    {
+        std::uint32_t Version;
+        std::uint64_t Key;
+    };
+
+#pragma pack(pop)
+
+    class CompiledDatabaseWriter
+    {
+    public:
+
+        explicit CompiledDatabaseWriter(std::ostream & os)
+            : mOs(os)
+        {}
+
+        template<typename T>
+        void operator()(T const & value)
+        {
+            static_assert(std::is_trivially_copyable_v<T>);
+            mOs.write(reinterpret_cast<char const *>(&value), sizeof(T));
+        }
+
+        void operator()(std::string const & value)
+        {
+            (*this)(static_cast<std::uint32_t>(value.size()));
+            mOs.write(value.data(), value.size());
+        }
+
+        void operator()(MaterialPaletteCoordinatesType const & value)
+        {
+            (*this)(value.Category);
+            (*this)(value.SubCategory);
+            (*this)(value.SubCategoryOrdinal);
+        }
+
+        template<typename T>
+        void operator()(std::optional<T> const & value)
+        {
+            (*this)(value.has_value());
+            if (value.has_value())
+            {
+                (*this)(*value);
+            }
+        }
+
+    private:
+
+        std::ostream & mOs;
+    };
+
+    class CompiledDatabaseReader
+    {
+    public:
+
+        explicit CompiledDatabaseReader(std::istream & is)
+            : mIs(is)
+        {}
+
+        template<typename T>
+        void operator()(T & value)
+        {
+            static_assert(std::is_trivially_copyable_v<T>);
+            ReadBytes(&value, sizeof(T));
+        }
+
+        void operator()(std::string & value)
+        {
+            std::uint32_t size;
+            (*this)(size);
+            value.resize(size);
+            ReadBytes(value.data(), size);
+        }
+
+        void operator()(MaterialPaletteCoordinatesType & value)
+        {
+            (*this)(value.Category);
+            (*this)(value.SubCategory);
+            (*this)(value.SubCategoryOrdinal);
+        }
+
+        template<typename T>
+        void operator()(std::optional<T> & value)
+        {
+            bool hasValue;
+            (*this)(hasValue);
+            if (hasValue)
+            {
+                T v{};
+                (*this)(v);
+                value = std::move(v);
+            }
+            else
+            {
+                value.reset();
+            }
+        }
+
+        template<typename T>
+        T Read()
+        {
+            T value{};
+            (*this)(value);
+            return value;
+        }
+
+    private:
+
+        void ReadBytes(void * bytes, size_t size)
+        {
+            mIs.read(reinterpret_cast<char *>(bytes), size);
+            if (!mIs)
+            {
+                throw GameException("Compiled material database is truncated");
+            }
+        }
+
+    private:
+
+        std::istream & mIs;
+    };
+
+    /*
+     * The single list of the fields of each material that make it to the compiled form;
+     * visited in the same order when writing and when reading, so that the two never get
+     * out of sync.
+     */
+
+    template<typename TArchive, typename TMaterial>
+    void VisitStructuralMaterialFields(TArchive & archive, TMaterial & material)
+    {
+        archive(material.Strength);
+        archive(material.NominalMass);
+        archive(material.Density);
+        archive(material.BuoyancyVolumeFill);
+        archive(material.Stiffness);
+        archive(material.StrainThresholdFraction);
+        archive(material.UniqueType);
+        archive(material.MaterialSound);
+        archive(material.MaterialTextureName);
+        archive(material.Opacity);
+        archive(material.IsHull);
+        archive(material.WaterIntake);
+        archive(material.WaterDiffusionSpeed);
+        archive(material.WaterRetention);
+        archive(material.RustReceptivity);
+        archive(material.IgnitionTemperature);
+        archive(material.MeltingTemperature);
+        archive(material.ThermalConductivity);
+        archive(material.ThermalExpansionCoefficient);
+        archive(material.SpecificHeat);
+        archive(material.CombustionType);
+        archive(material.ExplosiveCombustionRadius);
+        archive(material.ExplosiveCombustionStrength);
+        archive(material.WindReceptivity);
+        archive(material.WaterReactivity);
+        archive(material.IsLegacyElectrical);
+        archive(material.PaletteCoordinates);
+    }
+
+    template<typename TArchive, typename TMaterial>
+    void VisitElectricalMaterialFields(TArchive & archive, TMaterial & material)
+    {
+        archive(material.ElectricalType);
+        archive(material.IsSelfPowered);
+        archive(material.ConductsElectricity);
+        archive(material.Luminiscence);
+        archive(material.LightColor);
+        archive(material.LightSpread);
+        archive(material.WetFailureRate);
+        archive(material.ExternalPressureBreakageThreshold);
+        archive(material.HeatGenerated);
+        archive(material.MinimumOperatingTemperature);
+        archive(material.MaximumOperatingTemperature);
+        archive(material.ParticleEmissionRate);
+        archive(material.IsInstanced);
+        archive(material.EngineType);
+        archive(material.EngineCCWDirection);
+        archive(material.EnginePower);
+        archive(material.EngineResponsiveness);
+        archive(material.EngineControllerType);
+        archive(material.InteractiveSwitchType);
+        archive(material.ShipSoundType);
+        archive(material.WaterPumpNominalForce);
+        archive(material.PaletteCoordinates);
+    }
+
+    template<typename TMaterial>
+    void WritePalette(
+        CompiledDatabaseWriter & writer,
+        MaterialDatabase::Palette<TMaterial> const & palette)
+    {
+        writer(static_cast<std::uint32_t>(palette.Categories.size()));
+        for (auto const & category : palette.Categories)
+        {
+            writer(category.Name);
+            writer(static_cast<std::uint32_t>(category.SubCategories.size()));
+            for (auto const & subCategory : category.SubCategories)
+            {
+                writer(subCategory.Name);
+                writer(subCategory.ParentGroup.Name);
+                writer(static_cast<std::uint64_t>(subCategory.ParentGroup.UniqueId));
+                writer(static_cast<std::uint32_t>(subCategory.Materials.size()));
+                for (TMaterial const & material : subCategory.Materials)
+                {
+                    writer(material.ColorKey);
+                }
+            }
+        }
+    }
+
+    template<typename TMaterial>
+    MaterialDatabase::Palette<TMaterial> ReadPalette(
+        CompiledDatabaseReader & reader,
+        MaterialDatabase::MaterialMap<TMaterial> const & materialMap)
+    {
+        using SubCategory = typename MaterialDatabase::Palette<TMaterial>::Category::SubCategory;
+
+        MaterialDatabase::Palette<TMaterial> palette;
+
+        auto const categoryCount = reader.Read<std::uint32_t>();
+        for (std::uint32_t c = 0; c < categoryCount; ++c)
+        {
+            auto & category = palette.Categories.emplace_back(reader.Read<std::string>());
+
+            auto const subCategoryCount = reader.Read<std::uint32_t>();
+            for (std::uint32_t s = 0; s < subCategoryCount; ++s)
+            {
+                auto const name = reader.Read<std::string>();
+                auto const groupName = reader.Read<std::string>();
+                auto const groupId = reader.Read<std::uint64_t>();
+                auto & subCategory = category.SubCategories.emplace_back(
+                    name,
+                    typename SubCategory::Group(groupName, static_cast<size_t>(groupId)));
+
+                auto const materialCount = reader.Read<std::uint32_t>();
+                for (std::uint32_t m = 0; m < materialCount; ++m)
+                {
+                    auto const materialIt = materialMap.find(reader.Read<MaterialColorKey>());
+                    if (materialIt == materialMap.end())
+                    {
+                        throw GameException("Compiled material database has a palette referring to an unknown material");
+                    }
+
+                    subCategory.Materials.emplace_back(materialIt->second);
+                }
+            }
+        }
+
+        return palette;
+    }
+}
+
+MaterialDatabase MaterialDatabase::Load(
+    std::filesystem::path const & materialsRootDirectory,
+    std::filesystem::path const & compiledDatabaseFilePath)
+{
+    std::optional<std::uint64_t> key;
+    try
+    {
+        key = CalculateCompiledDatabaseKey(materialsRootDirectory);
+
+        auto compiledDatabase = LoadCompiled(compiledDatabaseFilePath, *key);
+        if (compiledDatabase.has_value())
+        {
+            return std::move(*compiledDatabase);
+        }
+    }
+    catch (std::exception const & ex)
+    {
+        LogMessage("MaterialDatabase: error loading compiled database: ", ex.what());
+    }
+
+    // Parse the definitions - letting their errors through
+    MaterialDatabase materialDatabase = Load(materialsRootDirectory);
+
+    if (key.has_value())
+    {
+        try
+        {
+            materialDatabase.SaveCompiled(compiledDatabaseFilePath, *key);
+        }
+        catch (std::exception const & ex)
+        {
+            LogMessage("MaterialDatabase: error saving compiled database: ", ex.what());
+        }
+    }
+
+    return materialDatabase;
+}
 
 MaterialDatabase MaterialDatabase::Load(std::filesystem::path materialsRootDirectory)
 {
@@ -483,4 +808,254 @@ void MaterialDatabase::Palette<TMaterial>::CheckComplete()
             }
         }
     }
-}
\ No newline at end of file
+}
+
+void MaterialDatabase::BuildColorKeyIndices()
+{
+    //
+    // Structural: verbatim keys, and then all the keys of rope endpoints - i.e.
+    // those matching the rope's r and the top nibble of its g - that are not
+    // taken already
+    //
+
+    mStructuralMaterialIndex.Reserve(mStructuralMaterialMap.size() + 16 * 256);
+
+    for (auto const & kv : mStructuralMaterialMap)
+    {
+        mStructuralMaterialIndex.TryInsert(kv.first, &(kv.second));
+    }
+
+    auto const & [ropeColorKey, ropeMaterial] = mUniqueStructuralMaterials[RopeUniqueMaterialIndex];
+    if (nullptr != ropeMaterial)
+    {
+        for (int gLow = 0; gLow < 16; ++gLow)
+        {
+            for (int b = 0; b < 256; ++b)
+            {
+                mStructuralMaterialIndex.TryInsert(
+                    MaterialColorKey(
+                        ropeColorKey.r,
+                        static_cast<MaterialColorKey::data_type>((ropeColorKey.g & 0xF0) | gLow),
+                        static_cast<MaterialColorKey::data_type>(b)),
+                    ropeMaterial);
+            }
+        }
+    }
+
+    //
+    // Electrical: verbatim keys; legacy also gets all the keys of instanced
+    // materials - i.e. those matching their r and g - that are not taken already
+    //
+
+    mElectricalMaterialIndex.Reserve(mElectricalMaterialMap.size());
+    mLegacyElectricalMaterialIndex.Reserve(mElectricalMaterialMap.size() + mInstancedElectricalMaterialMap.size() * 256);
+
+    for (auto const & kv : mElectricalMaterialMap)
+    {
+        mElectricalMaterialIndex.TryInsert(kv.first, &(kv.second));
+        mLegacyElectricalMaterialIndex.TryInsert(kv.first, &(kv.second));
+    }
+
+    for (auto const & kv : mInstancedElectricalMaterialMap)
+    {
+        for (int b = 0; b < 256; ++b)
+        {
+            mLegacyElectricalMaterialIndex.TryInsert(
+                MaterialColorKey(kv.first.r, kv.first.g, static_cast<MaterialColorKey::data_type>(b)),
+                kv.second);
+        }
+    }
+}
+
+std::uint64_t MaterialDatabase::CalculateCompiledDatabaseKey(std::filesystem::path const & materialsRootDirectory)
+{
+    Hasher hasher;
+
+    hasher.AddBytes(&CompiledDatabaseVersion, sizeof(CompiledDatabaseVersion));
+
+    for (auto const & definitionFileName : { "materials_structural.json", "materials_electrical.json" })
+    {
+        std::ifstream definitionFile(materialsRootDirectory / definitionFileName, std::ios::in | std::ios::binary);
+        if (!definitionFile)
+        {
+            throw GameException("Cannot open material definition file \"" + std::string(definitionFileName) + "\"");
+        }
+
+        std::vector<char> const definition{ std::istreambuf_iterator<char>(definitionFile), std::istreambuf_iterator<char>() };
+        std::uint64_t const definitionSize = definition.size();
+        hasher.AddBytes(&definitionSize, sizeof(definitionSize));
+        hasher.AddBytes(definition.data(), definition.size());
+    }
+
+    return hasher.GetHash();
+}
+
+std::optional<MaterialDatabase> MaterialDatabase::LoadCompiled(
+    std::filesystem::path const & compiledDatabaseFilePath,
+    std::uint64_t key)
+{
+    std::ifstream compiledFile(compiledDatabaseFilePath, std::ios::in | std::ios::binary);
+    if (!compiledFile)
+    {
+        // First run
+        return std::nullopt;
+    }
+
+    CompiledDatabaseReader reader(compiledFile);
+
+    auto const header = reader.Read<CompiledDatabaseFileHeader>();
+    if (header.Version != CompiledDatabaseVersion || header.Key != key)
+    {
+        LogMessage("MaterialDatabase: compiled database is stale");
+        return std::nullopt;
+    }
+
+    //
+    // Structural
+    //
+
+    MaterialMap<StructuralMaterial> structuralMaterialMap;
+
+    UniqueStructuralMaterialsArray uniqueStructuralMaterials;
+    for (size_t i = 0; i < uniqueStructuralMaterials.size(); ++i)
+        uniqueStructuralMaterials[i].second = nullptr;
+
+    float largestMass = 0.0f;
+    float largestStrength = 0.0f;
+
+    auto const structuralMaterialCount = reader.Read<std::uint32_t>();
+    for (std::uint32_t m = 0; m < structuralMaterialCount; ++m)
+    {
+        auto const colorKey = reader.Read<MaterialColorKey>();
+        auto const name = reader.Read<std::string>();
+        auto const renderColor = reader.Read<rgbaColor>();
+
+        StructuralMaterial material(colorKey, name, renderColor);
+        VisitStructuralMaterialFields(reader, material);
+
+        auto const storedEntry = structuralMaterialMap.emplace(colorKey, std::move(material));
+        StructuralMaterial const & storedMaterial = storedEntry.first->second;
+
+        if (storedMaterial.UniqueType.has_value())
+        {
+            size_t const uniqueTypeIndex = static_cast<size_t>(*storedMaterial.UniqueType);
+            if (uniqueTypeIndex >= uniqueStructuralMaterials.size())
+            {
+                throw GameException("Compiled material database has an invalid unique material type");
+            }
+
+            uniqueStructuralMaterials[uniqueTypeIndex] = std::make_pair(colorKey, &storedMaterial);
+        }
+
+        largestMass = std::max(storedMaterial.GetMass(), largestMass);
+        largestStrength = std::max(storedMaterial.Strength, largestStrength);
+    }
+
+    for (size_t i = 0; i < uniqueStructuralMaterials.size(); ++i)
+    {
+        if (nullptr == uniqueStructuralMaterials[i].second)
+        {
+            throw GameException("Compiled material database is missing a unique material");
+        }
+    }
+
+    Palette<StructuralMaterial> structuralMaterialPalette = ReadPalette(reader, structuralMaterialMap);
+    Palette<StructuralMaterial> ropeMaterialPalette = ReadPalette(reader, structuralMaterialMap);
+
+    //
+    // Electrical
+    //
+
+    MaterialMap<ElectricalMaterial> electricalMaterialMap;
+    std::map<MaterialColorKey, ElectricalMaterial const *, InstancedColorKeyComparer> instancedElectricalMaterialMap;
+
+    auto const electricalMaterialCount = reader.Read<std::uint32_t>();
+    for (std::uint32_t m = 0; m < electricalMaterialCount; ++m)
+    {
+        auto const colorKey = reader.Read<MaterialColorKey>();
+        auto const name = reader.Read<std::string>();
+        auto const renderColor = reader.Read<rgbColor>();
+
+        ElectricalMaterial material(colorKey, name, renderColor, false);
+        VisitElectricalMaterialFields(reader, material);
+
+        auto const storedEntry = electricalMaterialMap.emplace(colorKey, std::move(material));
+        if (storedEntry.first->second.IsInstanced)
+        {
+            instancedElectricalMaterialMap.emplace(colorKey, &(storedEntry.first->second));
+        }
+    }
+
+    Palette<ElectricalMaterial> electricalMaterialPalette = ReadPalette(reader, electricalMaterialMap);
+
+    LogMessage("MaterialDatabase: loaded compiled database with " + std::to_string(structuralMaterialMap.size()) + " structural materials and "
+        + std::to_string(electricalMaterialMap.size()) + " electrical materials.");
+
+    return MaterialDatabase(
+        std::move(structuralMaterialMap),
+        std::move(structuralMaterialPalette),
+        std::move(ropeMaterialPalette),
+        std::move(electricalMaterialMap),
+        std::move(instancedElectricalMaterialMap),
+        std::move(electricalMaterialPalette),
+        uniqueStructuralMaterials,
+        largestMass,
+        largestStrength);
+}
+
+void MaterialDatabase::SaveCompiled(
+    std::filesystem::path const & compiledDatabaseFilePath,
+    std::uint64_t key) const
+{
+    std::filesystem::create_directories(compiledDatabaseFilePath.parent_path());
+
+    // Write to a temporary file first, so that concurrent launches never see a partial file
+    std::filesystem::path const temporaryFilePath = std::filesystem::path(compiledDatabaseFilePath).concat(".tmp");
+
+    {
+        std::ofstream compiledFile(temporaryFilePath, std::ios::out | std::ios::binary | std::ios::trunc);
+        if (!compiledFile)
+        {
+            throw GameException("Cannot create compiled material database");
+        }
+
+        CompiledDatabaseWriter writer(compiledFile);
+
+        CompiledDatabaseFileHeader header;
+        header.Version = CompiledDatabaseVersion;
+        header.Key = key;
+        writer(header);
+
+        writer(static_cast<std::uint32_t>(mStructuralMaterialMap.size()));
+        for (auto const & [colorKey, material] : mStructuralMaterialMap)
+        {
+            writer(colorKey);
+            writer(material.Name);
+            writer(material.RenderColor);
+            VisitStructuralMaterialFields(writer, material);
+        }
+
+        WritePalette(writer, mStructuralMaterialPalette);
+        WritePalette(writer, mRopeMaterialPalette);
+
+        writer(static_cast<std::uint32_t>(mElectricalMaterialMap.size()));
+        for (auto const & [colorKey, material] : mElectricalMaterialMap)
+        {
+            writer(colorKey);
+            writer(material.Name);
+            writer(material.RenderColor);
+            VisitElectricalMaterialFields(writer, material);
+        }
+
+        WritePalette(writer, mElectricalMaterialPalette);
+
+        if (!compiledFile.flush())
+        {
+            throw GameException("Cannot write compiled material database");
+        }
+    }
+
+    std::filesystem::rename(temporaryFilePath, compiledDatabaseFilePath);
+
+    LogMessage("MaterialDatabase: saved compiled database");
+}
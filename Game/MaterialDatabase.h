@@ -5,6 +5,7 @@
 ***************************************************************************************/
 #pragma once
 
+#include "MaterialColorKeyIndex.h"
 #include "Materials.h"
 #include "ResourceLocator.h"
 
@@ -115,29 +116,27 @@ public:
 
     static MaterialDatabase Load(ResourceLocator const & resourceLocator)
     {
-        return Load(resourceLocator.GetMaterialDatabaseRootFilePath());
+        return Load(
+            resourceLocator.GetMaterialDatabaseRootFilePath(),
+            resourceLocator.GetCompiledMaterialDatabaseFilePath());
     }
 
+    /*
+     * Loads the database from its compiled form at the specified path, if that is up-to-date
+     * with the JSON definitions in the materials root directory; otherwise, parses the JSON
+     * definitions and (re-)creates the compiled form. Failures with the compiled form are
+     * never fatal.
+     */
+    static MaterialDatabase Load(
+        std::filesystem::path const & materialsRootDirectory,
+        std::filesystem::path const & compiledDatabaseFilePath);
+
     static MaterialDatabase Load(std::filesystem::path materialsRootDirectory);
 
     StructuralMaterial const * FindStructuralMaterial(MaterialColorKey const & colorKey) const
     {
-        if (auto srchIt = mStructuralMaterialMap.find(colorKey);
-            srchIt != mStructuralMaterialMap.end())
-        {
-            // Found color key verbatim!
-            return &(srchIt->second);
-        }
-
-        // Check whether it's a rope endpoint
-        if (colorKey.r == mUniqueStructuralMaterials[RopeUniqueMaterialIndex].first.r
-            && ((colorKey.g & 0xF0) == (mUniqueStructuralMaterials[RopeUniqueMaterialIndex].first.g & 0xF0)))
-        {
-            return mUniqueStructuralMaterials[RopeUniqueMaterialIndex].second;
-        }
-
-        // No luck
-        return nullptr;
+        // Finds color keys verbatim first, and then rope endpoints
+        return mStructuralMaterialIndex.Find(colorKey);
     }
 
     MaterialMap<StructuralMaterial> const & GetStructuralMaterialMap() const
@@ -159,36 +158,13 @@ public:
 
     ElectricalMaterial const * FindElectricalMaterial(MaterialColorKey const & colorKey) const
     {
-        if (auto srchIt = mElectricalMaterialMap.find(colorKey);
-            srchIt != mElectricalMaterialMap.end())
-        {
-            // Found color key verbatim!
-            return &(srchIt->second);
-        }
-
-        // No luck
-        return nullptr;
+        return mElectricalMaterialIndex.Find(colorKey);
     }
 
     ElectricalMaterial const * FindElectricalMaterialLegacy(MaterialColorKey const & colorKey) const
     {
-        // Try verbatim first
-        ElectricalMaterial const * verbatimMatch = FindElectricalMaterial(colorKey);
-        if (verbatimMatch != nullptr)
-        {
-            // Found!
-            return verbatimMatch;
-        }
-
-        // Try just instanced now (i.e. matching on r and g only)
-        if (auto srchIt = mInstancedElectricalMaterialMap.find(colorKey);
-            srchIt != mInstancedElectricalMaterialMap.end())
-        {
-            return srchIt->second;
-        }
-
-        // No luck
-        return nullptr;
+        // Finds color keys verbatim first, and then instanced materials (i.e. matching on r and g only)
+        return mLegacyElectricalMaterialIndex.Find(colorKey);
     }
 
     MaterialMap<ElectricalMaterial> const & GetElectricalMaterialMap() const
@@ -270,8 +246,21 @@ private:
         , mLargestMass(largestMass)
         , mLargestStrength(largestStrength)
     {
+        BuildColorKeyIndices();
     }
 
+    void BuildColorKeyIndices();
+
+    static std::uint64_t CalculateCompiledDatabaseKey(std::filesystem::path const & materialsRootDirectory);
+
+    static std::optional<MaterialDatabase> LoadCompiled(
+        std::filesystem::path const & compiledDatabaseFilePath,
+        std::uint64_t key);
+
+    void SaveCompiled(
+        std::filesystem::path const & compiledDatabaseFilePath,
+        std::uint64_t key) const;
+
 private:
 
     // Structural
@@ -284,6 +273,11 @@ private:
     std::map<MaterialColorKey, ElectricalMaterial const *, InstancedColorKeyComparer> mInstancedElectricalMaterialMap; // Redundant map for (legacy) instanced material lookup
     Palette<ElectricalMaterial> mElectricalMaterialPalette;
 
+    // Flat lookup indices, pointing into the maps above - whose nodes survive moves
+    MaterialColorKeyIndex<StructuralMaterial> mStructuralMaterialIndex;
+    MaterialColorKeyIndex<ElectricalMaterial> mElectricalMaterialIndex;
+    MaterialColorKeyIndex<ElectricalMaterial> mLegacyElectricalMaterialIndex;
+
     UniqueStructuralMaterialsArray mUniqueStructuralMaterials;
     float mLargestMass;
     float mLargestStrength;
@@ -62,6 +62,8 @@ public:
 
 public:
 
+    // When adding fields, add them also to the compiled form of the material database
+
     MaterialColorKey ColorKey;
 
     std::string Name;
@@ -310,6 +312,8 @@ public:
 
 public:
 
+    // When adding fields, add them also to the compiled form of the material database
+
     MaterialColorKey ColorKey;
 
     std::string Name;
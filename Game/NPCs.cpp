@@ -0,0 +1,259 @@
+/***************************************************************************************
+ * Original Author:     Gabriele Giuseppini
+ * Created:             2026-10-14
+ * Copyright:           Gabriele Giuseppini  (https://github.com/GabrieleGiuseppini)
+ ***************************************************************************************/
+#include "Physics.h"
+
+#include <algorithm>
+#include <cassert>
+#include <numeric>
+
+namespace Physics {
+
+NPCs::NPCs()
+    : mRegimeBuffer()
+    , mTriangleBuffer()
+    , mBarycentricCoordinatesBuffer()
+    , mPositionBuffer()
+    , mVelocityBuffer()
+    , mIsBucketOrderDirty(false)
+    , mSortIndices()
+{
+}
+
+void NPCs::Add(
+    vec2f const & position,
+    ElementIndex triangleElementIndex,
+    vec2f const * restrict pointPositionBuffer,
+    Triangles const & triangles)
+{
+    assert(!triangles.IsDeleted(triangleElementIndex));
+
+    auto const & pointIndices = triangles.GetPointIndices(triangleElementIndex);
+
+    mRegimeBuffer.push_back(RegimeType::Constrained);
+    mTriangleBuffer.push_back(triangleElementIndex);
+    mBarycentricCoordinatesBuffer.push_back(
+        CalculateBarycentricCoordinates(
+            position,
+            pointPositionBuffer[pointIndices[0]],
+            pointPositionBuffer[pointIndices[1]],
+            pointPositionBuffer[pointIndices[2]]));
+    mPositionBuffer.push_back(position);
+    mVelocityBuffer.push_back(vec2f::zero());
+
+    mIsBucketOrderDirty = true;
+}
+
+void NPCs::Clear()
+{
+    mRegimeBuffer.clear();
+    mTriangleBuffer.clear();
+    mBarycentricCoordinatesBuffer.clear();
+    mPositionBuffer.clear();
+    mVelocityBuffer.clear();
+
+    mIsBucketOrderDirty = false;
+}
+
+void NPCs::AddFragment(
+    NPCs const & other,
+    ShipFragmentMap const & fragmentMap,
+    bool doTakeFreeNpcs)
+{
+    assert(GetNpcCount() == 0);
+
+    for (ElementIndex n = 0; n < other.GetNpcCount(); ++n)
+    {
+        ElementIndex triangleIndex = NoneElementIndex;
+        if (other.mTriangleBuffer[n] != NoneElementIndex)
+        {
+            triangleIndex = fragmentMap.TriangleIndices.OldToNew[other.mTriangleBuffer[n]];
+            if (triangleIndex == NoneElementIndex)
+                continue;
+        }
+        else if (!doTakeFreeNpcs)
+        {
+            continue;
+        }
+
+        mRegimeBuffer.push_back(other.mRegimeBuffer[n]);
+        mTriangleBuffer.push_back(triangleIndex);
+        mBarycentricCoordinatesBuffer.push_back(other.mBarycentricCoordinatesBuffer[n]);
+        mPositionBuffer.push_back(other.mPositionBuffer[n]);
+        mVelocityBuffer.push_back(other.mVelocityBuffer[n]);
+    }
+
+    // Triangles keep their relative order, hence so does the bucket order
+    mIsBucketOrderDirty = other.mIsBucketOrderDirty;
+}
+
+void NPCs::Update(
+    float dt,
+    vec2f const & gravity,
+    vec2f const * restrict pointPositionBuffer,
+    Triangles const & triangles)
+{
+    if (mIsBucketOrderDirty)
+    {
+        SortByTriangle();
+    }
+
+    ElementCount const npcCount = GetNpcCount();
+
+    RegimeType * const restrict regimeBuffer = mRegimeBuffer.data();
+    ElementIndex * const restrict triangleBuffer = mTriangleBuffer.data();
+    vec3f const * const restrict barycentricCoordinatesBuffer = mBarycentricCoordinatesBuffer.data();
+    vec2f * const restrict positionBuffer = mPositionBuffer.data();
+    vec2f * const restrict velocityBuffer = mVelocityBuffer.data();
+
+    float const invDt = 1.0f / dt;
+
+    //
+    // Constrained NPCs, one triangle bucket at a time
+    //
+
+    ElementIndex n = 0;
+    while (n < npcCount && triangleBuffer[n] != NoneElementIndex)
+    {
+        ElementIndex const triangleIndex = triangleBuffer[n];
+
+        // Find the end of this triangle's bucket
+        ElementIndex bucketEnd = n + 1;
+        while (bucketEnd < npcCount && triangleBuffer[bucketEnd] == triangleIndex)
+        {
+            ++bucketEnd;
+        }
+
+        if (triangles.IsDeleted(triangleIndex))
+        {
+            // The triangle is gone - its NPCs are free now, retaining their last velocity
+            for (; n < bucketEnd; ++n)
+            {
+                regimeBuffer[n] = RegimeType::Free;
+                triangleBuffer[n] = NoneElementIndex;
+            }
+
+            mIsBucketOrderDirty = true;
+
+            continue;
+        }
+
+        auto const & pointIndices = triangles.GetPointIndices(triangleIndex);
+        vec2f const a = pointPositionBuffer[pointIndices[0]];
+        vec2f const b = pointPositionBuffer[pointIndices[1]];
+        vec2f const c = pointPositionBuffer[pointIndices[2]];
+
+        for (; n < bucketEnd; ++n)
+        {
+            vec3f const & bc = barycentricCoordinatesBuffer[n];
+            vec2f const newPosition = a * bc.x + b * bc.y + c * bc.z;
+
+            velocityBuffer[n] = (newPosition - positionBuffer[n]) * invDt;
+            positionBuffer[n] = newPosition;
+        }
+    }
+
+    //
+    // Free NPCs - those that have just become free included
+    //
+
+    for (n = 0; n < npcCount; ++n)
+    {
+        if (regimeBuffer[n] == RegimeType::Free)
+        {
+            velocityBuffer[n] += gravity * dt;
+            positionBuffer[n] += velocityBuffer[n] * dt;
+        }
+    }
+}
+
+std::optional<ElementIndex> NPCs::FindTriangleAt(
+    vec2f const & position,
+    vec2f const * restrict pointPositionBuffer,
+    Triangles const & triangles)
+{
+    std::optional<ElementIndex> result;
+
+    triangles.GetLiveTriangles().ForEachSet(
+        [&](ElementIndex t)
+        {
+            if (result.has_value())
+                return;
+
+            auto const & pointIndices = triangles.GetPointIndices(t);
+            vec3f const bc = CalculateBarycentricCoordinates(
+                position,
+                pointPositionBuffer[pointIndices[0]],
+                pointPositionBuffer[pointIndices[1]],
+                pointPositionBuffer[pointIndices[2]]);
+
+            if (bc.x >= 0.0f && bc.y >= 0.0f && bc.z >= 0.0f)
+            {
+                result = t;
+            }
+        });
+
+    return result;
+}
+
+vec3f NPCs::CalculateBarycentricCoordinates(
+    vec2f const & position,
+    vec2f const & a,
+    vec2f const & b,
+    vec2f const & c)
+{
+    float const denominator =
+        (b.y - c.y) * (a.x - c.x)
+        + (c.x - b.x) * (a.y - c.y);
+
+    if (denominator == 0.0f)
+    {
+        // Degenerate triangle - pin to its first vertex
+        return vec3f(1.0f, 0.0f, 0.0f);
+    }
+
+    float const l1 = ((b.y - c.y) * (position.x - c.x) + (c.x - b.x) * (position.y - c.y)) / denominator;
+    float const l2 = ((c.y - a.y) * (position.x - c.x) + (a.x - c.x) * (position.y - c.y)) / denominator;
+
+    return vec3f(l1, l2, 1.0f - l1 - l2);
+}
+
+void NPCs::SortByTriangle()
+{
+    ElementCount const npcCount = GetNpcCount();
+
+    // Stable, so that NPCs keep their order within a bucket
+    mSortIndices.resize(npcCount);
+    std::iota(mSortIndices.begin(), mSortIndices.end(), ElementIndex(0));
+    std::stable_sort(
+        mSortIndices.begin(),
+        mSortIndices.end(),
+        [this](ElementIndex l, ElementIndex r)
+        {
+            return mTriangleBuffer[l] < mTriangleBuffer[r];
+        });
+
+    auto const permute = [this, npcCount](auto & buffer)
+    {
+        std::remove_reference_t<decltype(buffer)> sortedBuffer;
+        sortedBuffer.reserve(npcCount);
+        for (ElementIndex i : mSortIndices)
+        {
+            sortedBuffer.push_back(buffer[i]);
+        }
+
+        buffer.swap(sortedBuffer);
+    };
+
+    permute(mRegimeBuffer);
+    permute(mTriangleBuffer);
+    permute(mBarycentricCoordinatesBuffer);
+    permute(mPositionBuffer);
+    permute(mVelocityBuffer);
+
+    mIsBucketOrderDirty = false;
+}
+
+}
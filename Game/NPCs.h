@@ -0,0 +1,159 @@
+/***************************************************************************************
+ * Original Author:     Gabriele Giuseppini
+ * Created:             2026-10-14
+ * Copyright:           Gabriele Giuseppini  (https://github.com/GabrieleGiuseppini)
+ ***************************************************************************************/
+#pragma once
+
+#include "Physics.h"
+
+#include <GameCore/GameTypes.h>
+#include <GameCore/SysSpecifics.h>
+#include <GameCore/Vectors.h>
+
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+namespace Physics
+{
+
+/*
+ * The NPCs of a ship, as planned in NPCs.txt.
+ *
+ * An NPC is a single particle which, in the constrained regime, lives in a triangle
+ * of the ship and is expressed in barycentric coordinates wrt that triangle; when its
+ * triangle is destroyed, the NPC enters the free regime and moves as a free particle.
+ *
+ * Designed for ships crowded with thousands of NPCs: the state is kept as parallel
+ * buffers - one per attribute - which are kept sorted by triangle, so that the NPCs
+ * of a triangle form a contiguous bucket; the update visits each bucket once, fetches
+ * the positions of its triangle's endpoints once for all of its NPCs, and walks all
+ * buffers sequentially. Free NPCs come last.
+ */
+class NPCs final
+{
+public:
+
+    enum class RegimeType : std::uint8_t
+    {
+        Constrained,
+        Free
+    };
+
+public:
+
+    NPCs();
+
+    NPCs(NPCs && other) = default;
+
+    ElementCount GetNpcCount() const
+    {
+        return static_cast<ElementCount>(mPositionBuffer.size());
+    }
+
+    /*
+     * Adds an NPC in the constrained regime, at the specified position within the
+     * specified triangle.
+     */
+    void Add(
+        vec2f const & position,
+        ElementIndex triangleElementIndex,
+        vec2f const * restrict pointPositionBuffer,
+        Triangles const & triangles);
+
+    /*
+     * Removes all NPCs, e.g. after the state of the ship has been restored.
+     */
+    void Clear();
+
+    /*
+     * Takes over the NPCs of a fragment of another ship: constrained NPCs follow
+     * their triangles, while free NPCs - which belong to no triangle - are taken
+     * over only when requested.
+     */
+    void AddFragment(
+        NPCs const & other,
+        ShipFragmentMap const & fragmentMap,
+        bool doTakeFreeNpcs);
+
+    /*
+     * Moves all NPCs for one simulation step, after the ship's particles have been
+     * integrated: constrained NPCs follow their triangles, and free NPCs fall.
+     */
+    void Update(
+        float dt,
+        vec2f const & gravity,
+        vec2f const * restrict pointPositionBuffer,
+        Triangles const & triangles);
+
+    /*
+     * Finds the non-deleted triangle containing the specified position, if any.
+     */
+    static std::optional<ElementIndex> FindTriangleAt(
+        vec2f const & position,
+        vec2f const * restrict pointPositionBuffer,
+        Triangles const & triangles);
+
+    /*
+     * Calculates the barycentric coordinates of the specified position wrt the
+     * triangle with the specified vertices; the coordinates are all within [0, 1]
+     * only when the position is within the triangle.
+     */
+    static vec3f CalculateBarycentricCoordinates(
+        vec2f const & position,
+        vec2f const & a,
+        vec2f const & b,
+        vec2f const & c);
+
+public:
+
+    //
+    // NPCs are in bucket order, hence an index is only valid until the next Update()
+    //
+
+    RegimeType GetRegime(ElementIndex npcIndex) const
+    {
+        return mRegimeBuffer[npcIndex];
+    }
+
+    // NoneElementIndex when in free regime
+    ElementIndex GetTriangle(ElementIndex npcIndex) const
+    {
+        return mTriangleBuffer[npcIndex];
+    }
+
+    vec2f const & GetPosition(ElementIndex npcIndex) const
+    {
+        return mPositionBuffer[npcIndex];
+    }
+
+    vec2f const & GetVelocity(ElementIndex npcIndex) const
+    {
+        return mVelocityBuffer[npcIndex];
+    }
+
+private:
+
+    void SortByTriangle();
+
+private:
+
+    //
+    // The NPCs' state, in bucket order
+    //
+
+    std::vector<RegimeType> mRegimeBuffer;
+    std::vector<ElementIndex> mTriangleBuffer; // NoneElementIndex when free, hence free NPCs sort last
+    std::vector<vec3f> mBarycentricCoordinatesBuffer; // Only meaningful when constrained
+    std::vector<vec2f> mPositionBuffer;
+    std::vector<vec2f> mVelocityBuffer;
+
+    // Set when NPCs are no longer in bucket order
+    bool mIsBucketOrderDirty;
+
+    // Scratch for sorting, kept to avoid reallocations
+    std::vector<ElementIndex> mSortIndices;
+};
+
+}
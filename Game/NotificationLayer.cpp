@@ -71,6 +71,7 @@ void NotificationLayer::SetStatusTexts(
     PerfStats const & totalPerfStats,
     std::chrono::duration<float> elapsedGameSeconds,
     bool isPaused,
+    unsigned int simulationDegradationLevel,
     float zoom,
     vec2f const & camera,
     Render::RenderStatistics renderStats)
@@ -96,6 +97,9 @@ void NotificationLayer::SetStatusTexts(
         if (isPaused)
             ss << " (PAUSED)";
 
+        if (simulationDegradationLevel > 0)
+            ss << " (DEGRADED:" << simulationDegradationLevel << ")";
+
 		mStatusTextLines[0] = ss.str();
 
 		// Text needs to be re-uploaded
@@ -117,9 +121,9 @@ void NotificationLayer::SetStatusTexts(
 			ss << std::fixed
 				<< std::setprecision(2)
 				<< "UPD:" << totalPerfStats.TotalUpdateDuration.ToRatio<std::chrono::milliseconds>() << "MS"
-				<< " (W=" << lastDeltaPerfStats.TotalWaitForRenderUploadDuration.ToRatio<std::chrono::milliseconds>() << "MS +"
-				<< " " << totalNetUpdate << "MS"
-				<< " (S=" << shipsSpringsUpdatePercent << "%))"
+				<< " (N=" << totalNetUpdate << "MS"
+				<< " (S=" << shipsSpringsUpdatePercent << "%"
+				<< " IT=" << lastDeltaPerfStats.TotalShipsMechanicalDynamicsIterations.ToAverage() << "))"
 				<< " UPL:(W=" << lastDeltaPerfStats.TotalWaitForRenderDrawDuration.ToRatio<std::chrono::milliseconds>() << "MS +"
 				<< " " << lastDeltaPerfStats.TotalNetRenderUploadDuration.ToRatio<std::chrono::milliseconds>() << "MS)"
 				;
@@ -138,6 +142,9 @@ void NotificationLayer::SetStatusTexts(
 				<< " (" << lastDeltaPerfStats.TotalRenderDrawDuration.ToRatio<std::chrono::milliseconds>() << "MS)"
 				<< " (UPL=" << lastDeltaPerfStats.TotalUploadRenderDrawDuration.ToRatio<std::chrono::milliseconds>() << "MS"
 				<< " MT=" << lastDeltaPerfStats.TotalMainThreadRenderDrawDuration.ToRatio<std::chrono::milliseconds>() << "MS)"
+				<< " GPU:(W=" << lastDeltaPerfStats.TotalWorldGpuRenderDrawDuration.ToRatio<std::chrono::milliseconds>() << "MS"
+				<< " S=" << lastDeltaPerfStats.TotalShipsGpuRenderDrawDuration.ToRatio<std::chrono::milliseconds>() << "MS"
+				<< " N=" << lastDeltaPerfStats.TotalNotificationsGpuRenderDrawDuration.ToRatio<std::chrono::milliseconds>() << "MS)"
 				;
 
 			mStatusTextLines[2] = ss.str();
@@ -161,6 +168,23 @@ void NotificationLayer::SetStatusTexts(
 			mStatusTextLines[3] = ss.str();
 		}
 
+		ss.str("");
+
+		{
+			ss << std::fixed
+				<< std::setprecision(0)
+				<< "EPH:(AB=" << lastDeltaPerfStats.TotalShipsAirBubbleParticles.ToAverage()
+				<< " DB=" << lastDeltaPerfStats.TotalShipsDebrisParticles.ToAverage()
+				<< " SM=" << lastDeltaPerfStats.TotalShipsSmokeParticles.ToAverage()
+				<< " SP=" << lastDeltaPerfStats.TotalShipsSparkleParticles.ToAverage()
+				<< " WB=" << lastDeltaPerfStats.TotalShipsWakeBubbleParticles.ToAverage() << ")"
+				<< std::setprecision(2)
+				<< " EXH=" << lastDeltaPerfStats.TotalShipsEphemeralParticleExhaustions.ToAverage()
+				<< " LOD=" << lastDeltaPerfStats.TotalShipsEphemeralParticleLevelOfDetailSkips.ToAverage();
+
+			mStatusTextLines[4] = ss.str();
+		}
+
 		// Text needs to be re-uploaded
 		mIsStatusTextDirty = true;
     }
@@ -43,6 +43,7 @@ public:
         PerfStats const & totalPerfStats,
         std::chrono::duration<float> elapsedGameSeconds,
         bool isPaused,
+        unsigned int simulationDegradationLevel,
         float zoom,
         vec2f const & camera,
         Render::RenderStatistics renderStats);
@@ -142,6 +143,16 @@ public:
 
 	void RenderUpload(Render::RenderContext & renderContext);
 
+	// Tells whether anything has changed since the last upload
+	bool IsDirty() const
+	{
+		return mIsStatusTextDirty
+			|| mIsNotificationTextDirty
+			|| mAreTextureNotificationsDirty
+			|| mIsPhysicsProbePanelDirty
+			|| mArePhysicsProbeReadingStringsDirty;
+	}
+
 private:
 
 	//
@@ -174,7 +185,7 @@ private:
 
     bool mIsStatusTextEnabled;
     bool mIsExtendedStatusTextEnabled;
-	std::array<std::string, 4> mStatusTextLines;
+	std::array<std::string, 5> mStatusTextLines;
 	bool mIsStatusTextDirty;
 
 	//
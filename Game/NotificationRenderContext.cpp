@@ -132,7 +132,7 @@ NotificationRenderContext::NotificationRenderContext(
     //
 
     // Set texture parameters
-    mShaderManager.ActivateProgram<ProgramType::Text>();
+    mShaderManager.ActivateProgramForParameters<ProgramType::Text>();
     mShaderManager.SetTextureParameters<ProgramType::Text>();
 
     // Initialize VBO
@@ -229,7 +229,7 @@ NotificationRenderContext::NotificationRenderContext(
 
     {
         // Set texture parameters
-        mShaderManager.ActivateProgram<ProgramType::TextureNotifications>();
+        mShaderManager.ActivateProgramForParameters<ProgramType::TextureNotifications>();
         mShaderManager.SetTextureParameters<ProgramType::TextureNotifications>();
 
         // Initialize VAO
@@ -280,7 +280,7 @@ NotificationRenderContext::NotificationRenderContext(
         // Set noise in shader
         mShaderManager.ActivateTexture<ProgramParameterType::NoiseTexture2>();
         glBindTexture(GL_TEXTURE_2D, globalRenderContext.GetNoiseTextureOpenGLHandle(1));
-        mShaderManager.ActivateProgram<ProgramType::PhysicsProbePanel>();
+        mShaderManager.ActivateProgramForParameters<ProgramType::PhysicsProbePanel>();
         mShaderManager.SetTextureParameters<ProgramType::PhysicsProbePanel>();
     }
 
@@ -310,9 +310,9 @@ NotificationRenderContext::NotificationRenderContext(
         // Set noise in shader
         mShaderManager.ActivateTexture<ProgramParameterType::NoiseTexture2>();
         glBindTexture(GL_TEXTURE_2D, globalRenderContext.GetNoiseTextureOpenGLHandle(1));
-        mShaderManager.ActivateProgram<ProgramType::HeatBlasterFlameCool>();
+        mShaderManager.ActivateProgramForParameters<ProgramType::HeatBlasterFlameCool>();
         mShaderManager.SetTextureParameters<ProgramType::HeatBlasterFlameCool>();
-        mShaderManager.ActivateProgram<ProgramType::HeatBlasterFlameHeat>();
+        mShaderManager.ActivateProgramForParameters<ProgramType::HeatBlasterFlameHeat>();
         mShaderManager.SetTextureParameters<ProgramType::HeatBlasterFlameHeat>();
     }
 
@@ -342,7 +342,7 @@ NotificationRenderContext::NotificationRenderContext(
         // Set noise in shader
         mShaderManager.ActivateTexture<ProgramParameterType::NoiseTexture2>();
         glBindTexture(GL_TEXTURE_2D, globalRenderContext.GetNoiseTextureOpenGLHandle(1));
-        mShaderManager.ActivateProgram<ProgramType::FireExtinguisherSpray>();
+        mShaderManager.ActivateProgramForParameters<ProgramType::FireExtinguisherSpray>();
         mShaderManager.SetTextureParameters<ProgramType::FireExtinguisherSpray>();
     }
 
@@ -374,7 +374,7 @@ NotificationRenderContext::NotificationRenderContext(
         // Set noise in shader
         mShaderManager.ActivateTexture<ProgramParameterType::NoiseTexture2>();
         glBindTexture(GL_TEXTURE_2D, globalRenderContext.GetNoiseTextureOpenGLHandle(1));
-        mShaderManager.ActivateProgram<ProgramType::BlastToolHalo>();
+        mShaderManager.ActivateProgramForParameters<ProgramType::BlastToolHalo>();
         mShaderManager.SetTextureParameters<ProgramType::BlastToolHalo>();
     }
 
@@ -432,7 +432,7 @@ NotificationRenderContext::NotificationRenderContext(
         // Set noise in shader
         mShaderManager.ActivateTexture<ProgramParameterType::NoiseTexture2>();
         glBindTexture(GL_TEXTURE_2D, globalRenderContext.GetNoiseTextureOpenGLHandle(1));
-        mShaderManager.ActivateProgram<ProgramType::WindSphere>();
+        mShaderManager.ActivateProgramForParameters<ProgramType::WindSphere>();
         mShaderManager.SetTextureParameters<ProgramType::WindSphere>();
     }
 
@@ -490,7 +490,7 @@ NotificationRenderContext::NotificationRenderContext(
         // Set noise in shader
         mShaderManager.ActivateTexture<ProgramParameterType::NoiseTexture2>();
         glBindTexture(GL_TEXTURE_2D, globalRenderContext.GetNoiseTextureOpenGLHandle(1));
-        mShaderManager.ActivateProgram<ProgramType::LaserRay>();
+        mShaderManager.ActivateProgramForParameters<ProgramType::LaserRay>();
         mShaderManager.SetTextureParameters<ProgramType::LaserRay>();
     }
 
@@ -767,27 +767,27 @@ void NotificationRenderContext::ApplyViewModelChanges(RenderParameters const & r
     ViewModel::ProjectionMatrix globalOrthoMatrix;
     renderParameters.View.CalculateGlobalOrthoMatrix(ZFar, ZNear, globalOrthoMatrix);
 
-    mShaderManager.ActivateProgram<ProgramType::HeatBlasterFlameCool>();
+    mShaderManager.ActivateProgramForParameters<ProgramType::HeatBlasterFlameCool>();
     mShaderManager.SetProgramParameter<ProgramType::HeatBlasterFlameCool, ProgramParameterType::OrthoMatrix>(
         globalOrthoMatrix);
 
-    mShaderManager.ActivateProgram<ProgramType::HeatBlasterFlameHeat>();
+    mShaderManager.ActivateProgramForParameters<ProgramType::HeatBlasterFlameHeat>();
     mShaderManager.SetProgramParameter<ProgramType::HeatBlasterFlameHeat, ProgramParameterType::OrthoMatrix>(
         globalOrthoMatrix);
 
-    mShaderManager.ActivateProgram<ProgramType::FireExtinguisherSpray>();
+    mShaderManager.ActivateProgramForParameters<ProgramType::FireExtinguisherSpray>();
     mShaderManager.SetProgramParameter<ProgramType::FireExtinguisherSpray, ProgramParameterType::OrthoMatrix>(
         globalOrthoMatrix);
 
-    mShaderManager.ActivateProgram<ProgramType::BlastToolHalo>();
+    mShaderManager.ActivateProgramForParameters<ProgramType::BlastToolHalo>();
     mShaderManager.SetProgramParameter<ProgramType::BlastToolHalo, ProgramParameterType::OrthoMatrix>(
         globalOrthoMatrix);
 
-    mShaderManager.ActivateProgram<ProgramType::PressureInjectionHalo>();
+    mShaderManager.ActivateProgramForParameters<ProgramType::PressureInjectionHalo>();
     mShaderManager.SetProgramParameter<ProgramType::PressureInjectionHalo, ProgramParameterType::OrthoMatrix>(
         globalOrthoMatrix);
 
-    mShaderManager.ActivateProgram<ProgramType::WindSphere>();
+    mShaderManager.ActivateProgramForParameters<ProgramType::WindSphere>();
     mShaderManager.SetProgramParameter<ProgramType::WindSphere, ProgramParameterType::OrthoMatrix>(
         globalOrthoMatrix);
 }
@@ -807,6 +807,11 @@ void NotificationRenderContext::ApplyCanvasSizeChanges(RenderParameters const &
     // at the next iteration
     for (auto & tntc : mTextNotificationTypeContexts)
     {
+        for (auto & textLine : tntc.TextLines)
+        {
+            textLine.AreQuadVerticesDirty = true;
+        }
+
         tntc.AreTextLinesDirty = true;
     }
 
@@ -821,7 +826,7 @@ void NotificationRenderContext::ApplyCanvasSizeChanges(RenderParameters const &
         static_cast<float>(atlasFrame.FrameMetadata.Size.height) * mScreenToNdcY);
 
     // Set parameters
-    mShaderManager.ActivateProgram<ProgramType::PhysicsProbePanel>();
+    mShaderManager.ActivateProgramForParameters<ProgramType::PhysicsProbePanel>();
     mShaderManager.SetProgramParameter<ProgramType::PhysicsProbePanel, ProgramParameterType::WidthNdc>(
         mPhysicsProbePanelNdcDimensions.x);
 }
@@ -832,11 +837,11 @@ void NotificationRenderContext::ApplyEffectiveAmbientLightIntensityChanges(Rende
 
     float const lighteningStrength = Step(0.5f, 1.0f - renderParameters.EffectiveAmbientLightIntensity);
 
-    mShaderManager.ActivateProgram<ProgramType::Text>();
+    mShaderManager.ActivateProgramForParameters<ProgramType::Text>();
     mShaderManager.SetProgramParameter<ProgramType::Text, ProgramParameterType::TextLighteningStrength>(
         lighteningStrength);
 
-    mShaderManager.ActivateProgram<ProgramType::TextureNotifications>();
+    mShaderManager.ActivateProgramForParameters<ProgramType::TextureNotifications>();
     mShaderManager.SetProgramParameter<ProgramType::TextureNotifications, ProgramParameterType::TextureLighteningStrength>(
         lighteningStrength);
 }
@@ -871,7 +876,7 @@ void NotificationRenderContext::ApplyDisplayUnitsSystemChanges(RenderParameters
     auto const & frameMetadata = mGenericLinearTextureAtlasMetadata.GetFrameMetadata(TextureFrameId<GenericLinearTextureGroups>(GenericLinearTextureGroups::PhysicsProbePanel, frameIndex));
 
     // Set texture offset in program
-    mShaderManager.ActivateProgram<ProgramType::PhysicsProbePanel>();
+    mShaderManager.ActivateProgramForParameters<ProgramType::PhysicsProbePanel>();
     mShaderManager.SetProgramParameter<ProgramType::PhysicsProbePanel, ProgramParameterType::AtlasTile1LeftBottomTextureCoordinates>(frameMetadata.TextureCoordinatesBottomLeft);
 }
 
@@ -1326,13 +1331,7 @@ void NotificationRenderContext::GenerateTextVertices(TextNotificationTypeContext
     FontMetadata const & fontMetadata = fontTextureAtlasMetadata.OriginalFontMetadata;
 
     //
-    // Reset quad vertices
-    //
-
-    context.TextQuadVertexBuffer.clear();
-
-    //
-    // Rebuild quad vertices
+    // Rebuild quad vertices of the lines that have changed
     //
 
     // Hardcoded pixel offsets of readings in physics probe panel,
@@ -1343,8 +1342,14 @@ void NotificationRenderContext::GenerateTextVertices(TextNotificationTypeContext
     vec2f constexpr PhysicsProbePanelDepthBottomRight(371.0f, PhysicsProbePanelTextBottomY);
     vec2f constexpr PhysicsProbePanelPressureBottomRight(506.0f, PhysicsProbePanelTextBottomY);
 
-    for (auto const & textLine : context.TextLines)
+    for (auto & textLine : context.TextLines)
     {
+        if (!textLine.AreQuadVerticesDirty)
+        {
+            // Re-use this line's quads
+            continue;
+        }
+
         //
         // Calculate line position in NDC coordinates
         //
@@ -1457,7 +1462,9 @@ void NotificationRenderContext::GenerateTextVertices(TextNotificationTypeContext
         //
 
         float const alpha = textLine.Alpha;
-        auto & vertices = context.TextQuadVertexBuffer;
+        auto & vertices = textLine.QuadVertices;
+
+        vertices.clear();
 
         for (char _ch : textLine.Text)
         {
@@ -1521,6 +1528,22 @@ void NotificationRenderContext::GenerateTextVertices(TextNotificationTypeContext
 
             linePositionNdc.x += glyphWidthNdc;
         }
+
+        textLine.AreQuadVerticesDirty = false;
+    }
+
+    //
+    // Assemble the quads of all lines
+    //
+
+    context.TextQuadVertexBuffer.clear();
+
+    for (auto const & textLine : context.TextLines)
+    {
+        context.TextQuadVertexBuffer.insert(
+            context.TextQuadVertexBuffer.end(),
+            textLine.QuadVertices.cbegin(),
+            textLine.QuadVertices.cend());
     }
 }
 
@@ -84,9 +84,8 @@ public:
 		vec2f const & screenOffset, // In font cell-size fraction (0.0 -> 1.0)
 		float alpha)
 	{
-		auto & textNotificationContext = mTextNotificationTypeContexts[static_cast<size_t>(TextNotificationType::StatusText)];
-
-		textNotificationContext.TextLines.emplace_back(
+		UploadTextLine(
+			TextNotificationType::StatusText,
 			text,
 			TranslateAnchorPosition(anchor),
 			screenOffset,
@@ -95,7 +94,7 @@ public:
 
 	inline void UploadStatusTextEnd()
 	{
-		// Nop
+		UploadTextEnd(TextNotificationType::StatusText);
 	}
 
 	inline void UploadNotificationTextStart()
@@ -109,9 +108,8 @@ public:
 		vec2f const & screenOffset, // In font cell-size fraction (0.0 -> 1.0)
 		float alpha)
 	{
-		auto & textNotificationContext = mTextNotificationTypeContexts[static_cast<size_t>(TextNotificationType::NotificationText)];
-
-		textNotificationContext.TextLines.emplace_back(
+		UploadTextLine(
+			TextNotificationType::NotificationText,
 			text,
 			TranslateAnchorPosition(anchor),
 			screenOffset,
@@ -120,7 +118,7 @@ public:
 
 	inline void UploadNotificationTextEnd()
 	{
-		// Nop
+		UploadTextEnd(TextNotificationType::NotificationText);
 	}
 
 	inline void UploadTextureNotificationStart()
@@ -261,43 +259,43 @@ public:
 		std::string const & depth,
 		std::string const & pressure)
 	{
-		auto & textNotificationContext = mTextNotificationTypeContexts[static_cast<size_t>(TextNotificationType::PhysicsProbeReading)];
+		UploadTextStart(TextNotificationType::PhysicsProbeReading);
 
-		textNotificationContext.TextLines.clear();
-
-		textNotificationContext.TextLines.emplace_back(
+		UploadTextLine(
+			TextNotificationType::PhysicsProbeReading,
 			speed,
 			NotificationAnchorPositionType::PhysicsProbeReadingSpeed,
 			vec2f::zero(),
 			1.0f);
 
-		textNotificationContext.TextLines.emplace_back(
+		UploadTextLine(
+			TextNotificationType::PhysicsProbeReading,
 			temperature,
 			NotificationAnchorPositionType::PhysicsProbeReadingTemperature,
 			vec2f::zero(),
 			1.0f);
 
-		textNotificationContext.TextLines.emplace_back(
+		UploadTextLine(
+			TextNotificationType::PhysicsProbeReading,
 			depth,
 			NotificationAnchorPositionType::PhysicsProbeReadingDepth,
 			vec2f::zero(),
 			1.0f);
 
-		textNotificationContext.TextLines.emplace_back(
+		UploadTextLine(
+			TextNotificationType::PhysicsProbeReading,
 			pressure,
 			NotificationAnchorPositionType::PhysicsProbeReadingPressure,
 			vec2f::zero(),
 			1.0f);
 
-		textNotificationContext.AreTextLinesDirty = true;
+		UploadTextEnd(TextNotificationType::PhysicsProbeReading);
 	}
 
 	inline void UploadPhysicsProbeReadingClear()
 	{
-		auto & textNotificationContext = mTextNotificationTypeContexts[static_cast<size_t>(TextNotificationType::PhysicsProbeReading)];
-
-		textNotificationContext.TextLines.clear();
-		textNotificationContext.AreTextLinesDirty = true;
+		UploadTextStart(TextNotificationType::PhysicsProbeReading);
+		UploadTextEnd(TextNotificationType::PhysicsProbeReading);
 	}
 
 	inline void UploadHeatBlasterFlame(
@@ -650,13 +648,68 @@ private:
 	{
 		//
 		// Text notifications are sticky: we upload them once in a while and
-		// continue drawing the same buffer
+		// continue drawing the same buffer.
+		//
+		// Uploaded lines are compared with the lines of the previous upload,
+		// so that we only re-build the quads of the lines that have changed
 		//
 
-		// Cleanup line buffers for this notification type
 		auto & textContext = mTextNotificationTypeContexts[static_cast<size_t>(textNotificationType)];
-		textContext.TextLines.clear();
-		textContext.AreTextLinesDirty = true;
+		textContext.UploadedTextLineCount = 0;
+	}
+
+	inline void UploadTextLine(
+		TextNotificationType textNotificationType,
+		std::string const & text,
+		NotificationAnchorPositionType anchor,
+		vec2f const & screenOffset,
+		float alpha)
+	{
+		auto & textContext = mTextNotificationTypeContexts[static_cast<size_t>(textNotificationType)];
+
+		if (textContext.UploadedTextLineCount < textContext.TextLines.size())
+		{
+			auto & textLine = textContext.TextLines[textContext.UploadedTextLineCount];
+			if (textLine.Text != text
+				|| textLine.Anchor != anchor
+				|| textLine.ScreenOffset != screenOffset
+				|| textLine.Alpha != alpha)
+			{
+				textLine.Text = text;
+				textLine.Anchor = anchor;
+				textLine.ScreenOffset = screenOffset;
+				textLine.Alpha = alpha;
+				textLine.AreQuadVerticesDirty = true;
+
+				textContext.AreTextLinesDirty = true;
+			}
+		}
+		else
+		{
+			textContext.TextLines.emplace_back(
+				text,
+				anchor,
+				screenOffset,
+				alpha);
+
+			textContext.AreTextLinesDirty = true;
+		}
+
+		++textContext.UploadedTextLineCount;
+	}
+
+	inline void UploadTextEnd(TextNotificationType textNotificationType)
+	{
+		auto & textContext = mTextNotificationTypeContexts[static_cast<size_t>(textNotificationType)];
+
+		if (textContext.UploadedTextLineCount < textContext.TextLines.size())
+		{
+			// Lines have been removed
+			textContext.TextLines.erase(
+				textContext.TextLines.begin() + textContext.UploadedTextLineCount,
+				textContext.TextLines.end());
+			textContext.AreTextLinesDirty = true;
+		}
 	}
 
 	void GenerateTextVertices(TextNotificationTypeContext & context) const;
@@ -877,6 +930,9 @@ private:
 		vec2f ScreenOffset; // In font cell-size fraction (0.0 -> 1.0)
 		float Alpha;
 
+		std::vector<TextQuadVertex> QuadVertices; // Cached quads of this line
+		bool AreQuadVerticesDirty; // When dirty, we'll re-build the quads of this line
+
 		TextLine(
 			std::string const & text,
 			NotificationAnchorPositionType anchor,
@@ -886,6 +942,8 @@ private:
 			, Anchor(anchor)
 			, ScreenOffset(screenOffset)
 			, Alpha(alpha)
+			, QuadVertices()
+			, AreQuadVerticesDirty(true)
 		{}
 	};
 
@@ -897,12 +955,14 @@ private:
 		FontTextureAtlasMetadata const & NotificationFontTextureAtlasMetadata; // The metadata of the font to be used for this notification type
 
 		std::vector<TextLine> TextLines;
-		bool AreTextLinesDirty; // When dirty, we'll re-build the quads for this notification type
+		size_t UploadedTextLineCount; // Number of lines uploaded so far in the current upload
+		bool AreTextLinesDirty; // When dirty, we'll re-assemble - and re-upload - the quads for this notification type
 		std::vector<TextQuadVertex> TextQuadVertexBuffer;
 
 		explicit TextNotificationTypeContext(FontTextureAtlasMetadata const & notificationFontTextureAtlasMetadata)
 			: NotificationFontTextureAtlasMetadata(notificationFontTextureAtlasMetadata)
 			, TextLines()
+			, UploadedTextLineCount(0)
 			, AreTextLinesDirty(false)
 			, TextQuadVertexBuffer()
 		{}
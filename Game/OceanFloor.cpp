@@ -20,7 +20,9 @@ OceanFloor::OceanFloor(OceanFloorTerrain && terrain)
     // Regarding the number of samples:
     //  - The sample index for x==max (HalfMaxWorldWidth) is SamplesCount - 1
     //  - To allow for our "rough check" at x==max, we need an addressable value for sample[SamplesCount].SampleValue
-    , mSamples(new Sample[SamplesCount + 1])
+    , mSamples(make_unique_buffer_aligned_to_vectorization_word<Sample>(SamplesCount + 1))
+    , mSamplesDirtyRange()
+    , mLastLandUpload()
     , mCurrentSeaDepth(0.0f)
     , mCurrentOceanFloorBumpiness(0.0f)
     , mCurrentOceanFloorDetailAmplification(0.0f)
@@ -79,19 +81,47 @@ void OceanFloor::Upload(
     GameParameters const & /*gameParameters*/,
     Render::RenderContext & renderContext) const
 {
+    auto const & visibleWorld = renderContext.GetVisibleWorld();
+
+    if (mLastLandUpload.has_value()
+        && mLastLandUpload->VisibleWorldLeftX == visibleWorld.TopLeft.x
+        && mLastLandUpload->VisibleWorldRightX == visibleWorld.BottomRight.x
+        && mLastLandUpload->VisibleWorldBottomY == visibleWorld.BottomRight.y)
+    {
+        //
+        // Same slices as last time, just update those that have changed
+        //
+
+        if (!mSamplesDirtyRange.IsEmpty())
+        {
+            UploadChangedSlices(renderContext);
+        }
+
+        mSamplesDirtyRange.Clear();
+
+        return;
+    }
+
     //
     // We want to upload at most RenderSlices slices
     //
 
     // Find index of leftmost sample, and its corresponding world X
-    auto const sampleIndex = FastTruncateToArchInt((renderContext.GetVisibleWorld().TopLeft.x + GameParameters::HalfMaxWorldWidth) / Dx);
+    auto const sampleIndex = FastTruncateToArchInt((visibleWorld.TopLeft.x + GameParameters::HalfMaxWorldWidth) / Dx);
     float sampleIndexX = -GameParameters::HalfMaxWorldWidth + (Dx * sampleIndex);
 
     // Calculate number of samples required to cover screen from leftmost sample
     // up to the visible world right (included)
-    float const coverageWidth = renderContext.GetVisibleWorld().BottomRight.x - sampleIndexX;
+    float const coverageWidth = visibleWorld.BottomRight.x - sampleIndexX;
     size_t const numberOfSamplesToRender = static_cast<size_t>(ceil(coverageWidth / Dx));
 
+    LandUpload landUpload;
+    landUpload.VisibleWorldLeftX = visibleWorld.TopLeft.x;
+    landUpload.VisibleWorldRightX = visibleWorld.BottomRight.x;
+    landUpload.VisibleWorldBottomY = visibleWorld.BottomRight.y;
+    landUpload.FirstSampleIndex = static_cast<size_t>(sampleIndex);
+    landUpload.FirstSampleX = sampleIndexX;
+
     if (numberOfSamplesToRender >= RenderSlices<size_t>)
     {
         //
@@ -105,14 +135,19 @@ void OceanFloor::Upload(
 
         // We do one extra iteration as the number of slices is the number of quads, and the last vertical
         // quad side must be at the end of the width
-        for (size_t s = 0;
-            s <= RenderSlices<size_t>;
-            ++s, sampleIndexX = std::min(sampleIndexX + sliceDx, GameParameters::HalfMaxWorldWidth))
+        for (size_t s = 0; s <= RenderSlices<size_t>; ++s)
         {
+            // Calculated the same way as when updating slices
+            float const sliceX = std::min(sampleIndexX + sliceDx * static_cast<float>(s), GameParameters::HalfMaxWorldWidth);
+
             renderContext.UploadLand(
-                sampleIndexX,
-                GetHeightAt(sampleIndexX));
+                sliceX,
+                GetHeightAt(sliceX));
         }
+
+        landUpload.SliceCount = RenderSlices<size_t>;
+        landUpload.IsOneSamplePerSlice = false;
+        landUpload.SliceDx = sliceDx;
     }
     else
     {
@@ -132,9 +167,16 @@ void OceanFloor::Upload(
                 sampleIndexX,
                 mSamples[s + sampleIndex].SampleValue);
         }
+
+        landUpload.SliceCount = numberOfSamplesToRender;
+        landUpload.IsOneSamplePerSlice = true;
+        landUpload.SliceDx = Dx;
     }
 
     renderContext.UploadLandEnd();
+
+    mLastLandUpload = landUpload;
+    mSamplesDirtyRange.Clear();
 }
 
 std::optional<bool> OceanFloor::AdjustTo(
@@ -262,6 +304,12 @@ void OceanFloor::SetTerrainHeight(
     // Update terrain
     mTerrain[sampleIndex] = terrainHeight;
 
+    // Remember the samples we change - this one, the delta of the previous one,
+    // and the extra one
+    mSamplesDirtyRange.Add(
+        static_cast<ElementIndex>(sampleIndex > 0 ? sampleIndex - 1 : 0),
+        static_cast<ElementIndex>(std::min(sampleIndex + 2, SamplesCount + 1)));
+
     // Recalculate sample value
     float const newSampleValue = CalculateResultantSampleValue(sampleIndex);
 
@@ -283,6 +331,70 @@ void OceanFloor::SetTerrainHeight(
     mSamples[SamplesCount].SampleValue = mSamples[SamplesCount - 1].SampleValue;
 }
 
+void OceanFloor::UploadChangedSlices(Render::RenderContext & renderContext) const
+{
+    assert(mLastLandUpload.has_value());
+    assert(!mSamplesDirtyRange.IsEmpty());
+
+    size_t const firstChangedSample = mSamplesDirtyRange.GetStart();
+    size_t const lastChangedSample = firstChangedSample + mSamplesDirtyRange.GetSize(); // Excluded
+
+    size_t const sliceVertexCount = mLastLandUpload->SliceCount + 1;
+
+    if (mLastLandUpload->IsOneSamplePerSlice)
+    {
+        //
+        // Slice s is sample FirstSampleIndex + s
+        //
+
+        size_t const firstSlice = firstChangedSample > mLastLandUpload->FirstSampleIndex
+            ? firstChangedSample - mLastLandUpload->FirstSampleIndex
+            : 0;
+
+        size_t const lastSlice = lastChangedSample > mLastLandUpload->FirstSampleIndex
+            ? std::min(lastChangedSample - mLastLandUpload->FirstSampleIndex, sliceVertexCount)
+            : 0;
+
+        for (size_t s = firstSlice; s < lastSlice; ++s)
+        {
+            renderContext.UploadLandUpdate(
+                s,
+                mSamples[mLastLandUpload->FirstSampleIndex + s].SampleValue);
+        }
+    }
+    else
+    {
+        //
+        // Slices are interpolated between samples; a changed sample i changes
+        // the slices between samples i - 1 and i + 1
+        //
+
+        float const firstChangedX =
+            -GameParameters::HalfMaxWorldWidth
+            + Dx * static_cast<float>(firstChangedSample > 0 ? firstChangedSample - 1 : 0);
+
+        float const lastChangedX =
+            -GameParameters::HalfMaxWorldWidth
+            + Dx * static_cast<float>(lastChangedSample);
+
+        float const firstSliceF = std::floor((firstChangedX - mLastLandUpload->FirstSampleX) / mLastLandUpload->SliceDx);
+        float const lastSliceF = std::floor((lastChangedX - mLastLandUpload->FirstSampleX) / mLastLandUpload->SliceDx) + 2.0f;
+
+        size_t const firstSlice = firstSliceF > 0.0f ? static_cast<size_t>(firstSliceF) : 0;
+        size_t const lastSlice = lastSliceF > 0.0f ? std::min(static_cast<size_t>(lastSliceF), sliceVertexCount) : 0;
+
+        for (size_t s = firstSlice; s < lastSlice; ++s)
+        {
+            // Calculated the same way as when uploading all slices
+            float const sliceX = std::min(mLastLandUpload->FirstSampleX + mLastLandUpload->SliceDx * static_cast<float>(s), GameParameters::HalfMaxWorldWidth);
+
+            renderContext.UploadLandUpdate(
+                s,
+                GetHeightAt(sliceX));
+        }
+    }
+}
+
 void OceanFloor::CalculateBumpProfile()
 {
     static constexpr float BumpFrequency1 = 0.005f;
@@ -301,6 +413,8 @@ void OceanFloor::CalculateBumpProfile()
 
 void OceanFloor::CalculateResultantSampleValues()
 {
+    mSamplesDirtyRange.Add(0, static_cast<ElementIndex>(SamplesCount + 1));
+
     // sample index = 0
     float previousSampleValue;
     {
@@ -10,7 +10,9 @@
 #include "GameParameters.h"
 #include "OceanFloorTerrain.h"
 
+#include <GameCore/DirtyRange.h>
 #include <GameCore/GameMath.h>
+#include <GameCore/SysSpecifics.h>
 #include <GameCore/UniqueBuffer.h>
 
 #include <memory>
@@ -134,6 +136,8 @@ private:
 
     void CalculateResultantSampleValues();
 
+    void UploadChangedSlices(Render::RenderContext & renderContext) const;
+
     inline float CalculateResultantSampleValue(size_t sampleIndex) const
     {
         assert(sampleIndex < SamplesCount);
@@ -172,7 +176,33 @@ private:
     };
 
     // The current samples, calculated from the components
-    std::unique_ptr<Sample[]> mSamples;
+    unique_aligned_buffer<Sample> mSamples;
+
+    //
+    // Upload state
+    //
+    // The render context keeps the land we upload, hence after a full upload
+    // we only upload the slices whose samples have changed - until the visible
+    // world changes
+    //
+
+    // The samples that have changed since the last upload
+    DirtyRange mutable mSamplesDirtyRange;
+
+    // How we have last uploaded the whole land
+    struct LandUpload
+    {
+        float VisibleWorldLeftX;
+        float VisibleWorldRightX;
+        float VisibleWorldBottomY;
+        size_t FirstSampleIndex;
+        float FirstSampleX;
+        size_t SliceCount;
+        bool IsOneSamplePerSlice;
+        float SliceDx; // When not one sample per slice
+    };
+
+    std::optional<LandUpload> mutable mLastLandUpload;
 
     //
     // The game parameters for which we're current
@@ -8,6 +8,7 @@
 #include <GameCore/Algorithms.h>
 #include <GameCore/GameRandomEngine.h>
 #include <GameCore/GameWallClock.h>
+#include <GameCore/Profiler.h>
 
 #include <algorithm>
 #include <chrono>
@@ -22,11 +23,16 @@ T constexpr RenderSlices = 768;
 
 static std::chrono::seconds constexpr TsunamiGracePeriod(120);
 
+// The granularity of the slabs of the concurrent update; a cache line's worth of floats
+static size_t constexpr SlabGranularity = 64 / sizeof(float);
+
 OceanSurface::OceanSurface(
     World & parentWorld,
-    std::shared_ptr<GameEventDispatcher> gameEventDispatcher)
+    std::shared_ptr<GameEventDispatcher> gameEventDispatcher,
+    std::shared_ptr<TaskThreadPool> taskThreadPool)
     : mParentWorld(parentWorld)
     , mGameEventHandler(std::move(gameEventDispatcher))
+    , mTaskThreadPool(std::move(taskThreadPool))
     ////////
     , mBasalWaveAmplitude1(0.0f)
     , mBasalWaveAmplitude2(0.0f)
@@ -48,7 +54,13 @@ OceanSurface::OceanSurface(
     , mSamples(SamplesCount + 1)
     , mSWEHeightField(SWEBufferAlignmentPrefixSize + SWEBoundaryConditionsSamples + SamplesCount + SWEBoundaryConditionsSamples)
     , mSWEVelocityField(SWEBufferAlignmentPrefixSize + SWEBoundaryConditionsSamples + SamplesCount + SWEBoundaryConditionsSamples + 1)
+    , mSWEHeightFieldWorkBuffer(mSWEHeightField.GetSize())
+    , mSWEVelocityFieldWorkBuffer(mSWEVelocityField.GetSize())
+    , mSWEActiveStart(SWETotalSamples)
+    , mSWEActiveEnd(0)
     , mDeltaHeightBuffer(DeltaHeightBufferAlignmentPrefixSize + (DeltaHeightSmoothing / 2) + SamplesCount + (DeltaHeightSmoothing / 2))
+    , mDeltaHeightDirtyStart(SamplesCount)
+    , mDeltaHeightDirtyEnd(0)
     ////////
     , mSWEInteractiveWaveStateMachine()
     , mSWETsunamiWaveStateMachine()
@@ -60,6 +72,8 @@ OceanSurface::OceanSurface(
     mSamples.fill({ 0.0f, 0.0f });
     mSWEHeightField.fill(SWEHeightFieldOffset);
     mSWEVelocityField.fill(0.0f);
+    mSWEHeightFieldWorkBuffer.fill(SWEHeightFieldOffset);
+    mSWEVelocityFieldWorkBuffer.fill(0.0f);
     mDeltaHeightBuffer.fill(0.0f);
 
     // Initialize constant sample values
@@ -72,6 +86,8 @@ void OceanSurface::Update(
     Wind const & wind,
     GameParameters const & gameParameters)
 {
+    FS_PROFILE_SCOPE("OceanSurface::Update");
+
     auto const now = GameWallClock::GetInstance().Now();
 
     //
@@ -301,6 +317,10 @@ void OceanSurface::ApplyThanosSnap(
 
     for (auto idx = sweIndexStart; idx <= sweIndexEnd; ++idx)
         mSWEHeightField[idx] -= WaterDepression;
+
+    MarkSWEActive(
+        sweIndexStart - SWEBufferAlignmentPrefixSize,
+        sweIndexEnd + 1 - SWEBufferAlignmentPrefixSize);
 }
 
 void OceanSurface::TriggerTsunami(float currentSimulationTime)
@@ -374,6 +394,48 @@ void OceanSurface::TriggerRogueWave(
         currentSimulationTime);
 }
 
+static std::uint32_t constexpr StateSectionTag = 0x53464E4F; // ONFS
+
+void OceanSurface::SaveState(StateSnapshotWriter & writer) const
+{
+    writer.BeginSection(StateSectionTag);
+
+    ArchiveState(*this, writer);
+}
+
+void OceanSurface::LoadState(StateSnapshotReader & reader)
+{
+    reader.BeginSection(StateSectionTag);
+
+    ArchiveState(*this, reader);
+
+    // We know nothing about where the surface is at rest; the work buffers
+    // are rest-state-agnostic as long as the whole range is active
+    MarkSWEActive(0, SWETotalSamples);
+    mDeltaHeightDirtyStart = 0;
+    mDeltaHeightDirtyEnd = SamplesCount;
+
+    // The wave state machines refer to simulation times of the past,
+    // hence we simply let the waves go
+    mSWEInteractiveWaveStateMachine.reset();
+    mSWETsunamiWaveStateMachine.reset();
+    mSWERogueWaveWaveStateMachine.reset();
+}
+
+template<typename TSelf, typename TArchive>
+void OceanSurface::ArchiveState(
+    TSelf & self,
+    TArchive & archive)
+{
+    // Timestamps of abnormal waves are not archived, as they are wall-clock times
+
+    archive.Archive(self.mWindIncisivenessRunningAverage);
+    archive.Archive(self.mSamples);
+    archive.Archive(self.mSWEHeightField);
+    archive.Archive(self.mSWEVelocityField);
+    archive.Archive(self.mDeltaHeightBuffer);
+}
+
 ///////////////////////////////////////////////////////////////////////////////////////////////
 
 template<OceanRenderDetailType DetailType>
@@ -798,12 +860,29 @@ void OceanSurface::SmoothDeltaBufferIntoHeightField()
     // centered on the sample
     //
 
+    if (mDeltaHeightDirtyStart >= mDeltaHeightDirtyEnd)
+    {
+        // Nothing to incorporate
+        return;
+    }
+
     Algorithms::SmoothBufferAndAdd<SamplesCount, DeltaHeightSmoothing>(
         mDeltaHeightBuffer.data() + DeltaHeightBufferPrefixSize,
         mSWEHeightField.data() + SWEBufferPrefixSize);
 
+    // The smoothed deltas spill over by half a window
+    MarkSWEActive(
+        SWEBoundaryConditionsSamples + mDeltaHeightDirtyStart - std::min(mDeltaHeightDirtyStart, DeltaHeightSmoothing / 2),
+        SWEBoundaryConditionsSamples + mDeltaHeightDirtyEnd + DeltaHeightSmoothing / 2);
+
     // Clear delta-height buffer
-    mDeltaHeightBuffer.fill(0.0f);
+    std::fill(
+        mDeltaHeightBuffer.data() + DeltaHeightBufferPrefixSize + mDeltaHeightDirtyStart,
+        mDeltaHeightBuffer.data() + DeltaHeightBufferPrefixSize + mDeltaHeightDirtyEnd,
+        0.0f);
+
+    mDeltaHeightDirtyStart = SamplesCount;
+    mDeltaHeightDirtyEnd = 0;
 }
 
 void OceanSurface::ApplyDampingBoundaryConditions()
@@ -836,46 +915,148 @@ void OceanSurface::UpdateFields(GameParameters const & gameParameters)
     //
     // SWE Update
     //
-    // "q‐Upwind Numerical Scheme" from "Improving the stability of a simple formulation of the shallow water equations for 2‐D flood modeling",
-    //      de Almeida, Bates, Freer, Souvignet (2012), https://agupubs.onlinelibrary.wiley.com/doi/full/10.1029/2011WR011570
-    //
     // Height field  : from 0 to SWETotalSamples
     // Velocity field: from 1 to SWETotalSamples (i.e. at boundaries it's inner only)
     //                 H[i] has V[i] at its left and V[i+1] at its right
     //
 
+    if (mSWEActiveStart >= mSWEActiveEnd)
+    {
+        // All at rest, and thus staying at rest
+        return;
+    }
+
+    //
+    // Run on the active range, widened by the samples which may get disturbed
+    // during this step:
+    //  - At the left, disturbances travel by one sample per step, and the velocity
+    //    at the left of the leftmost height needs updating too;
+    //  - At the right, the sweep drags along a tail decaying by at least 1/2 per sample,
+    //    which has vanished below the rest tolerance within SWERightMarginSamples
+    //
+
+    size_t constexpr SWELeftMarginSamples = 2;
+    size_t constexpr SWERightMarginSamples = 32;
+
+    // Keep slabs aligned to cache lines
+    size_t const startSample = (mSWEActiveStart - std::min(mSWEActiveStart, SWELeftMarginSamples)) / SlabGranularity * SlabGranularity;
+    size_t const endSample = std::min(mSWEActiveEnd + SWERightMarginSamples, SWETotalSamples);
+
     float constexpr G = GameParameters::GravityMagnitude;
     float constexpr Dt = GameParameters::SimulationStepTimeDuration<float>;
     float const previousVWeight1 = 1.0f - gameParameters.WaveSmoothnessAdjustment;
     float const previousVWeight2 = gameParameters.WaveSmoothnessAdjustment / 2.0f; // Includes /2 for average
 
+    size_t const slabCount = CalculateSlabCount(gameParameters);
+    if (slabCount > 1)
+    {
+        //
+        // Update slabs concurrently, from the fields into the work buffers
+        //
+
+        float const * const restrict inHeightField = mSWEHeightField.data() + SWEBufferAlignmentPrefixSize;
+        float const * const restrict inVelocityField = mSWEVelocityField.data() + SWEBufferAlignmentPrefixSize;
+        float * const restrict outHeightField = mSWEHeightFieldWorkBuffer.data() + SWEBufferAlignmentPrefixSize;
+        float * const restrict outVelocityField = mSWEVelocityFieldWorkBuffer.data() + SWEBufferAlignmentPrefixSize;
+
+        size_t const slabSize = CalculateSlabSize(endSample - startSample, slabCount);
+
+        mTaskThreadPool->ParallelFor(
+            0,
+            slabCount,
+            1,
+            [&](size_t startSlab, size_t endSlab)
+            {
+                for (size_t slab = startSlab; slab < endSlab; ++slab)
+                {
+                    size_t const slabStartSample = startSample + slab * slabSize;
+                    size_t const slabEndSample = std::min(slabStartSample + slabSize, endSample);
+                    if (slabStartSample < slabEndSample)
+                    {
+                        Algorithms::UpdateSWEFieldsSlab(
+                            inHeightField,
+                            inVelocityField,
+                            outHeightField,
+                            outVelocityField,
+                            SWETotalSamples,
+                            slabStartSample,
+                            slabEndSample,
+                            Dt / Dx,
+                            G * Dt / Dx,
+                            previousVWeight1,
+                            previousVWeight2);
+                    }
+                }
+            });
+
+        mSWEHeightField.swap(mSWEHeightFieldWorkBuffer);
+        mSWEVelocityField.swap(mSWEVelocityFieldWorkBuffer);
+    }
+    else
+    {
+        // The velocity at the left of the first height is not updated, but it's at rest
+        Algorithms::UpdateSWEFields(
+            mSWEHeightField.data() + SWEBufferAlignmentPrefixSize + startSample,
+            mSWEVelocityField.data() + SWEBufferAlignmentPrefixSize + startSample,
+            endSample - startSample,
+            Dt / Dx,
+            G * Dt / Dx,
+            previousVWeight1,
+            previousVWeight2);
+    }
+
+    mSWEActiveStart = startSample;
+    mSWEActiveEnd = endSample;
+
+    ShrinkSWEActiveRange();
+}
+
+void OceanSurface::ShrinkSWEActiveRange()
+{
     float * const restrict heightField = mSWEHeightField.data() + SWEBufferAlignmentPrefixSize;
     float * const restrict velocityField = mSWEVelocityField.data() + SWEBufferAlignmentPrefixSize;
+    float * const restrict heightFieldWorkBuffer = mSWEHeightFieldWorkBuffer.data() + SWEBufferAlignmentPrefixSize;
+    float * const restrict velocityFieldWorkBuffer = mSWEVelocityFieldWorkBuffer.data() + SWEBufferAlignmentPrefixSize;
 
-    // Update first height field value
-    heightField[0] *=
-        1.0f + Dt / Dx * (velocityField[0] - velocityField[0 + 1]);
+    auto const isAtRest = [&](size_t i)
+    {
+        return std::abs(heightField[i] - SWEHeightFieldOffset) < SWERestTolerance
+            && std::abs(velocityField[i]) < SWERestTolerance;
+    };
 
-    for (size_t i = 1; i < SWEBoundaryConditionsSamples + SamplesCount + SWEBoundaryConditionsSamples; ++i)
+    // The work buffers get back to rest too, as they become the fields at the next (concurrent) update
+    auto const restoreRest = [&](size_t i)
     {
-        // Update height field
-        heightField[i] *=
-            1.0f + Dt / Dx * (velocityField[i] - velocityField[i + 1]);
+        heightField[i] = SWEHeightFieldOffset;
+        velocityField[i] = 0.0f;
+        heightFieldWorkBuffer[i] = SWEHeightFieldOffset;
+        velocityFieldWorkBuffer[i] = 0.0f;
+    };
 
-        // V @ t-1: mix of V[i] and of avg(V[i-1], V[i+1])
-        float const previousV =
-            previousVWeight1 * velocityField[i]
-            + previousVWeight2 * (velocityField[i - 1] + velocityField[i + 1]);
+    while (mSWEActiveEnd > mSWEActiveStart && isAtRest(mSWEActiveEnd - 1))
+    {
+        restoreRest(mSWEActiveEnd - 1);
+        --mSWEActiveEnd;
+    }
 
-        // Update velocity field
-        velocityField[i] = previousV - G * Dt / Dx * (heightField[i] - heightField[i - 1]);
+    while (mSWEActiveStart < mSWEActiveEnd && isAtRest(mSWEActiveStart))
+    {
+        restoreRest(mSWEActiveStart);
+        ++mSWEActiveStart;
+    }
+
+    if (mSWEActiveStart >= mSWEActiveEnd)
+    {
+        // Canonical empty range
+        mSWEActiveStart = SWETotalSamples;
+        mSWEActiveEnd = 0;
     }
 }
 
 void OceanSurface::GenerateSamples(
     float currentSimulationTime,
     Wind const & wind,
-    GameParameters const & /*gameParameters*/)
+    GameParameters const & gameParameters)
 {
     //
     // Sample values are a combination of:
@@ -925,81 +1106,184 @@ void OceanSurface::GenerateSamples(
         ? windRipplesWaveHeight / mBasalWaveAmplitude1
         : 0.0f;
 
-    float sinArg1 = (mBasalWaveNumber1 * x - mBasalWaveAngularVelocity1 * currentSimulationTime) / (2 * Pi<float>);
-    float sinArg2 = (mBasalWaveNumber2 * x - mBasalWaveAngularVelocity2 * currentSimulationTime + secondaryBasalComponentPhase) / (2 * Pi<float>);
-    float sinArgRipple = (WindRippleWaveNumber * x - windRipplesAngularVelocity * currentSimulationTime) / (2 * Pi<float>);
+    SampleGenerationParameters const parameters{
+        (mBasalWaveNumber1 * x - mBasalWaveAngularVelocity1 * currentSimulationTime) / (2 * Pi<float>),
+        (mBasalWaveNumber2 * x - mBasalWaveAngularVelocity2 * currentSimulationTime + secondaryBasalComponentPhase) / (2 * Pi<float>),
+        (WindRippleWaveNumber * x - windRipplesAngularVelocity * currentSimulationTime) / (2 * Pi<float>),
+        mBasalWaveNumber1 * Dx / (2 * Pi<float>),
+        mBasalWaveNumber2 * Dx / (2 * Pi<float>),
+        WindRippleWaveNumber * Dx / (2 * Pi<float>),
+        basalWave2AmplitudeCoeff,
+        rippleWaveAmplitudeCoeff };
+
+    size_t const slabCount = CalculateSlabCount(gameParameters);
+    if (slabCount > 1)
+    {
+        size_t const slabSize = CalculateSlabSize(SamplesCount, slabCount);
 
-    // sample index = 0
-    float previousSampleValue;
+        mTaskThreadPool->ParallelFor(
+            0,
+            slabCount,
+            1,
+            [&](size_t startSlab, size_t endSlab)
+            {
+                for (size_t slab = startSlab; slab < endSlab; ++slab)
+                {
+                    size_t const startSample = slab * slabSize;
+                    size_t const endSample = std::min(startSample + slabSize, SamplesCount);
+                    if (startSample < endSample)
+                    {
+                        GenerateSamples(startSample, endSample, parameters);
+                    }
+                }
+            });
+    }
+    else
     {
-        float const sweValue =
-            (mSWEHeightField[SWEBufferPrefixSize + 0] - SWEHeightFieldOffset)
-            * SWEHeightFieldAmplification;
+        GenerateSamples(0, SamplesCount, parameters);
+    }
+
+    assert(mSamples[SamplesCount - 1].SampleValuePlusOneMinusSampleValue == 0.0f); // From cctor
+
+    // Populate extra sample - same value as last sample
+    mSamples[SamplesCount].SampleValue = mSamples[SamplesCount - 1].SampleValue;
 
-        float const basalValue1 =
-            mBasalWaveSin1.GetLinearlyInterpolatedPeriodic(sinArg1);
+    assert(mSamples[SamplesCount].SampleValuePlusOneMinusSampleValue == 0.0f); // From cctor
+}
 
-        float const basalValue2 =
-            basalWave2AmplitudeCoeff
-            * mBasalWaveSin1.GetLinearlyInterpolatedPeriodic(sinArg2);
+void OceanSurface::GenerateSamples(
+    size_t startSample,
+    size_t endSample,
+    SampleGenerationParameters const & parameters)
+{
+    assert(startSample < endSample && endSample <= SamplesCount);
 
-        float const rippleValue =
-            rippleWaveAmplitudeCoeff
-            * mBasalWaveSin1.GetLinearlyInterpolatedPeriodic(sinArgRipple);
+    // Slabs other than the first one start from the analytical arguments at their first sample;
+    // no-op for the first slab
+    float sinArg1 = parameters.SinArg1 + parameters.SinArg1Dx * static_cast<float>(startSample);
+    float sinArg2 = parameters.SinArg2 + parameters.SinArg2Dx * static_cast<float>(startSample);
+    float sinArgRipple = parameters.SinArgRipple + parameters.SinArgRippleDx * static_cast<float>(startSample);
 
-        previousSampleValue =
-            sweValue
-            + basalValue1
-            + basalValue2
-            + rippleValue;
+    // First sample
+    float previousSampleValue = CalculateSampleValue(startSample, sinArg1, sinArg2, sinArgRipple, parameters);
+    mSamples[startSample].SampleValue = previousSampleValue;
 
-        mSamples[0].SampleValue = previousSampleValue;
-    }
+    // All other samples, in batches: first the arguments, then the
+    // wave lookups - each in a loop of its own - and finally the sums
+
+    size_t constexpr BatchSize = 64;
 
-    float const sinArg1Dx = mBasalWaveNumber1 * Dx / (2 * Pi<float>);
-    float const sinArg2Dx = mBasalWaveNumber2 * Dx / (2 * Pi<float>);
-    float const sinArgRippleDx = WindRippleWaveNumber * Dx / (2 * Pi<float>);
+    float sinArgs1[BatchSize];
+    float sinArgs2[BatchSize];
+    float sinArgsRipple[BatchSize];
+    float basalValues1[BatchSize];
+    float basalValues2[BatchSize];
+    float rippleValues[BatchSize];
 
-    // sample index = 1...SamplesCount - 1
-    for (size_t i = 1; i < SamplesCount; ++i)
+    for (size_t batchStart = startSample + 1; batchStart < endSample; batchStart += BatchSize)
     {
-        float const sweValue =
-            (mSWEHeightField[SWEBufferPrefixSize + i] - SWEHeightFieldOffset)
-            * SWEHeightFieldAmplification;
-
-        sinArg1 += sinArg1Dx;
-        float const basalValue1 =
-            mBasalWaveSin1.GetLinearlyInterpolatedPeriodic(sinArg1);
-
-        sinArg2 += sinArg2Dx;
-        float const basalValue2 =
-            basalWave2AmplitudeCoeff
-            * mBasalWaveSin1.GetLinearlyInterpolatedPeriodic(sinArg2);
-
-        sinArgRipple += sinArgRippleDx;
-        float const rippleValue =
-            rippleWaveAmplitudeCoeff
-            * mBasalWaveSin1.GetLinearlyInterpolatedPeriodic(sinArgRipple);
-
-        float const sampleValue =
-            sweValue
-            + basalValue1
-            + basalValue2
-            + rippleValue;
-
-        mSamples[i].SampleValue = sampleValue;
-        mSamples[i - 1].SampleValuePlusOneMinusSampleValue = sampleValue - previousSampleValue;
-
-        previousSampleValue = sampleValue;
+        size_t const batchCount = std::min(BatchSize, endSample - batchStart);
+
+        for (size_t b = 0; b < batchCount; ++b)
+        {
+            sinArg1 += parameters.SinArg1Dx;
+            sinArg2 += parameters.SinArg2Dx;
+            sinArgRipple += parameters.SinArgRippleDx;
+
+            sinArgs1[b] = sinArg1;
+            sinArgs2[b] = sinArg2;
+            sinArgsRipple[b] = sinArgRipple;
+        }
+
+        mBasalWaveSin1.GetLinearlyInterpolatedPeriodic(sinArgs1, basalValues1, batchCount);
+        mBasalWaveSin1.GetLinearlyInterpolatedPeriodic(sinArgs2, basalValues2, batchCount);
+        mBasalWaveSin1.GetLinearlyInterpolatedPeriodic(sinArgsRipple, rippleValues, batchCount);
+
+        for (size_t b = 0; b < batchCount; ++b)
+        {
+            size_t const i = batchStart + b;
+
+            float const sampleValue = CombineSampleValue(i, basalValues1[b], basalValues2[b], rippleValues[b], parameters);
+
+            mSamples[i].SampleValue = sampleValue;
+            mSamples[i - 1].SampleValuePlusOneMinusSampleValue = sampleValue - previousSampleValue;
+
+            previousSampleValue = sampleValue;
+        }
     }
 
-    assert(mSamples[SamplesCount - 1].SampleValuePlusOneMinusSampleValue == 0.0f); // From cctor
+    if (endSample < SamplesCount)
+    {
+        // Calculate the first sample of the next slab - exactly as that slab does - so to
+        // calculate the delta of our last sample
+        float const nextSlabSampleValue = CalculateSampleValue(
+            endSample,
+            parameters.SinArg1 + parameters.SinArg1Dx * static_cast<float>(endSample),
+            parameters.SinArg2 + parameters.SinArg2Dx * static_cast<float>(endSample),
+            parameters.SinArgRipple + parameters.SinArgRippleDx * static_cast<float>(endSample),
+            parameters);
+
+        mSamples[endSample - 1].SampleValuePlusOneMinusSampleValue = nextSlabSampleValue - previousSampleValue;
+    }
+}
 
-    // Populate extra sample - same value as last sample
-    assert(previousSampleValue == mSamples[SamplesCount - 1].SampleValue);
-    mSamples[SamplesCount].SampleValue = previousSampleValue;
+float OceanSurface::CalculateSampleValue(
+    size_t sample,
+    float sinArg1,
+    float sinArg2,
+    float sinArgRipple,
+    SampleGenerationParameters const & parameters) const
+{
+    return CombineSampleValue(
+        sample,
+        mBasalWaveSin1.GetLinearlyInterpolatedPeriodic(sinArg1),
+        mBasalWaveSin1.GetLinearlyInterpolatedPeriodic(sinArg2),
+        mBasalWaveSin1.GetLinearlyInterpolatedPeriodic(sinArgRipple),
+        parameters);
+}
 
-    assert(mSamples[SamplesCount].SampleValuePlusOneMinusSampleValue == 0.0f); // From cctor
+float OceanSurface::CombineSampleValue(
+    size_t sample,
+    float basalWaveSin1Value,
+    float basalWaveSin2Value,
+    float rippleWaveSinValue,
+    SampleGenerationParameters const & parameters) const
+{
+    float const sweValue =
+        (mSWEHeightField[SWEBufferPrefixSize + sample] - SWEHeightFieldOffset)
+        * SWEHeightFieldAmplification;
+
+    float const basalValue1 = basalWaveSin1Value;
+
+    float const basalValue2 =
+        parameters.BasalWave2AmplitudeCoeff
+        * basalWaveSin2Value;
+
+    float const rippleValue =
+        parameters.RippleWaveAmplitudeCoeff
+        * rippleWaveSinValue;
+
+    return
+        sweValue
+        + basalValue1
+        + basalValue2
+        + rippleValue;
+}
+
+size_t OceanSurface::CalculateSlabCount(GameParameters const & gameParameters) const
+{
+    return gameParameters.DoUpdateOceanSurfaceConcurrently
+        ? mTaskThreadPool->GetParallelism()
+        : 1;
+}
+
+size_t OceanSurface::CalculateSlabSize(
+    size_t totalSize,
+    size_t slabCount)
+{
+    size_t const slabSize = (totalSize + slabCount - 1) / slabCount;
+
+    return (slabSize + SlabGranularity - 1) / SlabGranularity * SlabGranularity;
 }
 
 ///////////////////////////////////////////////////////////////////////////////////////////
@@ -12,11 +12,20 @@
 #include <GameCore/GameMath.h>
 #include <GameCore/PrecalculatedFunction.h>
 #include <GameCore/RunningAverage.h>
+#include <GameCore/StateSnapshot.h>
 #include <GameCore/StrongTypeDef.h>
 #include <GameCore/SysSpecifics.h>
+#include <GameCore/TaskThreadPool.h>
 
+#include <algorithm>
+#include <cstdint>
+#include <memory>
 #include <optional>
 
+#if FS_IS_ARCHITECTURE_X86_32() || FS_IS_ARCHITECTURE_X86_64()
+#include <immintrin.h>
+#endif
+
 namespace Physics
 {
 
@@ -26,7 +35,8 @@ public:
 
     OceanSurface(
         World & parentWorld,
-        std::shared_ptr<GameEventDispatcher> gameEventDispatcher);
+        std::shared_ptr<GameEventDispatcher> gameEventDispatcher,
+        std::shared_ptr<TaskThreadPool> taskThreadPool);
 
     void Update(
         float currentSimulationTime,
@@ -64,11 +74,72 @@ public:
             + mSamples[sampleIndexI].SampleValuePlusOneMinusSampleValue * sampleIndexDx;
     }
 
+    /*
+     * Equivalent to invoking GetHeightAt() on each of the specified x's, but
+     * interpolating four x's at a time; only the fetching of the samples is
+     * done one x at a time.
+     *
+     * Assumption: all x's are in world boundaries.
+     */
+    inline void GetHeightsAt(
+        float const * restrict xs,
+        size_t count,
+        float * restrict outHeights) const noexcept
+    {
+        size_t i = 0;
+
+#if FS_IS_ARCHITECTURE_X86_32() || FS_IS_ARCHITECTURE_X86_64()
+        for (; i + 4 <= count; i += 4)
+        {
+            _mm_storeu_ps(outHeights + i, GetHeightsAt_4(_mm_loadu_ps(xs + i)));
+        }
+#endif
+
+        for (; i < count; ++i)
+        {
+            outHeights[i] = GetHeightAt(xs[i]);
+        }
+    }
+
     inline float GetDepth(vec2f const & position) const noexcept
     {
         return GetHeightAt(position.x) - position.y;
     }
 
+    /*
+     * Equivalent to invoking GetDepth() on each of the specified positions, but
+     * interpolating four positions at a time, as GetHeightsAt() does.
+     *
+     * Assumption: all x's are in world boundaries.
+     */
+    inline void GetDepths(
+        vec2f const * restrict positions,
+        size_t count,
+        float * restrict outDepths) const noexcept
+    {
+        size_t i = 0;
+
+#if FS_IS_ARCHITECTURE_X86_32() || FS_IS_ARCHITECTURE_X86_64()
+        float const * const restrict positionsFloat = reinterpret_cast<float const *>(positions);
+
+        for (; i + 4 <= count; i += 4)
+        {
+            __m128 const p01 = _mm_loadu_ps(positionsFloat + 2 * i); // x0,y0,x1,y1
+            __m128 const p23 = _mm_loadu_ps(positionsFloat + 2 * i + 4); // x2,y2,x3,y3
+
+            __m128 const x_4 = _mm_shuffle_ps(p01, p23, 0x88); // x0,x1,x2,x3
+            __m128 const y_4 = _mm_shuffle_ps(p01, p23, 0xDD); // y0,y1,y2,y3
+
+            _mm_storeu_ps(outDepths + i, _mm_sub_ps(GetHeightsAt_4(x_4), y_4));
+        }
+#endif
+
+        for (; i < count; ++i)
+        {
+            outDepths[i] = GetHeightAt(positions[i].x) - positions[i].y;
+        }
+    }
+
     inline bool IsUnderwater(vec2f const & position) const noexcept
     {
         return GetDepth(position) > 0.0f;
@@ -121,6 +192,7 @@ public:
         if (std::abs(yDisplacement) > mDeltaHeightBuffer[DeltaHeightBufferPrefixSize + sampleIndexI])
         {
             mDeltaHeightBuffer[DeltaHeightBufferPrefixSize + sampleIndexI] = yDisplacement;
+            MarkDeltaHeightDirty(static_cast<size_t>(sampleIndexI));
         }
     }
 
@@ -134,11 +206,69 @@ public:
         float currentSimulationTime,
         Wind const & wind);
 
+    /*
+     * Saves and restores the shape of the surface; the drivers of interactive and
+     * abnormal waves are not saved, and they are stopped at restore.
+     */
+    void SaveState(StateSnapshotWriter & writer) const;
+    void LoadState(StateSnapshotReader & reader);
+
 private:
 
+    template<typename TSelf, typename TArchive>
+    static void ArchiveState(
+        TSelf & self,
+        TArchive & archive);
+
     template<OceanRenderDetailType DetailType>
     void InternalUpload(Render::RenderContext & renderContext) const;
 
+#if FS_IS_ARCHITECTURE_X86_32() || FS_IS_ARCHITECTURE_X86_64()
+
+    /*
+     * Calculates GetHeightAt() of four x's with the same operations, in the same order.
+     */
+    inline __m128 GetHeightsAt_4(__m128 const x_4) const noexcept
+    {
+        // Fractional index in the sample array
+        __m128 const sampleIndexF_4 = _mm_div_ps(
+            _mm_add_ps(x_4, _mm_set1_ps(GameParameters::HalfMaxWorldWidth)),
+            _mm_set1_ps(Dx));
+
+        // Integral part
+        __m128i const sampleIndexI_4 = _mm_cvttps_epi32(sampleIndexF_4);
+
+        // Fractional part within sample index and the next sample index
+        __m128 const sampleIndexDx_4 = _mm_sub_ps(sampleIndexF_4, _mm_cvtepi32_ps(sampleIndexI_4));
+
+        // Fetch the samples - there's no gather in SSE2
+        alignas(16) std::int32_t sampleIndexI[4];
+        _mm_store_si128(reinterpret_cast<__m128i *>(sampleIndexI), sampleIndexI_4);
+
+        assert(sampleIndexI[0] >= 0 && sampleIndexI[0] < static_cast<std::int32_t>(SamplesCount));
+        assert(sampleIndexI[1] >= 0 && sampleIndexI[1] < static_cast<std::int32_t>(SamplesCount));
+        assert(sampleIndexI[2] >= 0 && sampleIndexI[2] < static_cast<std::int32_t>(SamplesCount));
+        assert(sampleIndexI[3] >= 0 && sampleIndexI[3] < static_cast<std::int32_t>(SamplesCount));
+
+        Sample const * const restrict samples = mSamples.data();
+
+        __m128 const s01 = _mm_loadh_pi( // v0,d0,v1,d1
+            _mm_loadl_pi(_mm_setzero_ps(), reinterpret_cast<__m64 const *>(samples + sampleIndexI[0])),
+            reinterpret_cast<__m64 const *>(samples + sampleIndexI[1]));
+        __m128 const s23 = _mm_loadh_pi( // v2,d2,v3,d3
+            _mm_loadl_pi(_mm_setzero_ps(), reinterpret_cast<__m64 const *>(samples + sampleIndexI[2])),
+            reinterpret_cast<__m64 const *>(samples + sampleIndexI[3]));
+
+        __m128 const sampleValue_4 = _mm_shuffle_ps(s01, s23, 0x88);
+        __m128 const sampleValuePlusOneMinusSampleValue_4 = _mm_shuffle_ps(s01, s23, 0xDD);
+
+        return _mm_add_ps(
+            sampleValue_4,
+            _mm_mul_ps(sampleValuePlusOneMinusSampleValue_4, sampleIndexDx_4));
+    }
+
+#endif
+
     static inline auto ToSampleIndex(float x) noexcept
     {
         // Calculate sample index, minimizing error
@@ -155,8 +285,26 @@ private:
     {
         float const currentSWEHeight = mSWEHeightField[centerIndex];
         mDeltaHeightBuffer[centerIndex - SWEBufferPrefixSize + DeltaHeightBufferPrefixSize] += (height - currentSWEHeight);
+        MarkDeltaHeightDirty(centerIndex - SWEBufferPrefixSize);
     }
 
+    void MarkDeltaHeightDirty(size_t sampleIndex) // Sample coordinate
+    {
+        mDeltaHeightDirtyStart = std::min(mDeltaHeightDirtyStart, sampleIndex);
+        mDeltaHeightDirtyEnd = std::max(mDeltaHeightDirtyEnd, sampleIndex + 1);
+    }
+
+    void MarkSWEActive(
+        size_t start, // Coords are in SWE "total" space, i.e. past the alignment prefix
+        size_t end)
+    {
+        mSWEActiveStart = std::min(mSWEActiveStart, start);
+        mSWEActiveEnd = std::max(mSWEActiveEnd, std::min(end, SWETotalSamples));
+    }
+
+    // Restores the rest state of the samples at the ends of the active range, shrinking it
+    void ShrinkSWEActiveRange();
+
     void RecalculateWaveCoefficients(
         Wind const & wind,
         GameParameters const & gameParameters);
@@ -182,10 +330,54 @@ private:
         Wind const & wind,
         GameParameters const & gameParameters);
 
+    struct SampleGenerationParameters
+    {
+        float SinArg1;
+        float SinArg2;
+        float SinArgRipple;
+        float SinArg1Dx;
+        float SinArg2Dx;
+        float SinArgRippleDx;
+        float BasalWave2AmplitudeCoeff;
+        float RippleWaveAmplitudeCoeff;
+    };
+
+    // Generates samples [startSample, endSample), together with the deltas
+    // of all of them with their next sample (except the very last sample)
+    void GenerateSamples(
+        size_t startSample,
+        size_t endSample,
+        SampleGenerationParameters const & parameters);
+
+    inline float CalculateSampleValue(
+        size_t sample,
+        float sinArg1,
+        float sinArg2,
+        float sinArgRipple,
+        SampleGenerationParameters const & parameters) const;
+
+    // Given the sin values of the waves, as looked up for their arguments
+    inline float CombineSampleValue(
+        size_t sample,
+        float basalWaveSin1Value,
+        float basalWaveSin2Value,
+        float rippleWaveSinValue,
+        SampleGenerationParameters const & parameters) const;
+
+    // The number of slabs to split SWE and sample work in, when running concurrently;
+    // 1 when not running concurrently
+    inline size_t CalculateSlabCount(GameParameters const & gameParameters) const;
+
+    // The size of each slab, a multiple of a cache line's worth of floats
+    static inline size_t CalculateSlabSize(
+        size_t totalSize,
+        size_t slabCount);
+
 private:
 
     World & mParentWorld;
     std::shared_ptr<GameEventDispatcher> mGameEventHandler;
+    std::shared_ptr<TaskThreadPool> mTaskThreadPool;
 
     // Smoothing of wind incisiveness
     RunningAverage<15> mWindIncisivenessRunningAverage;
@@ -250,6 +442,8 @@ private:
         float SampleValuePlusOneMinusSampleValue; // Delta between next sample and this sample
     };
 
+    static_assert(sizeof(Sample) == 2 * sizeof(float)); // Fetched whole by GetHeightsAt_4()
+
     // The samples
     Buffer<Sample> mSamples;
 
@@ -275,6 +469,9 @@ private:
     static size_t constexpr SWEBufferPrefixSize = SWEBufferAlignmentPrefixSize + SWEBoundaryConditionsSamples;
     static_assert(is_aligned_to_float_element_count(SWEBufferPrefixSize));
 
+    // The number of samples the SWE update runs on, i.e. body and boundary conditions
+    static size_t constexpr SWETotalSamples = SWEBoundaryConditionsSamples + SamplesCount + SWEBoundaryConditionsSamples;
+
     // SWE height field
     // - Height values are at the center of the staggered grid cells
     Buffer<float> mSWEHeightField;
@@ -284,6 +481,22 @@ private:
     //      - H[i] has V[i] at its left and V[i+1] at its right
     Buffer<float> mSWEVelocityField;
 
+    // Output buffers for the concurrent SWE update, swapped with the fields after each update
+    Buffer<float> mSWEHeightFieldWorkBuffer;
+    Buffer<float> mSWEVelocityFieldWorkBuffer;
+
+    // The range [start, end) of SWE "total" samples outside of which both the fields and the work
+    // buffers are at rest - heights at the offset and velocities at zero. Most of the world's surface
+    // is usually at rest, and the SWE update only runs on this range - plus the margins into which
+    // waves may travel during one step - hence its cost follows the extent of the disturbances rather
+    // than the width of the world. The update is the same as on the whole field, save for the wave
+    // tails that have decayed below SWERestTolerance and are snapped back to rest.
+    size_t mSWEActiveStart;
+    size_t mSWEActiveEnd;
+
+    // Deviation from rest below which a sample at the ends of the active range is considered at rest
+    static float constexpr SWERestTolerance = 1e-6f; // About the resolution of heights around the offset
+
     //
     // Delta height buffer
     //
@@ -310,6 +523,10 @@ private:
 
     Buffer<float> mDeltaHeightBuffer;
 
+    // The range [start, end) of delta-height samples which may be non-zero; body coordinates
+    size_t mDeltaHeightDirtyStart;
+    size_t mDeltaHeightDirtyEnd;
+
 private:
 
     //
@@ -6,8 +6,15 @@
 #pragma once
 
 #include <GameCore/GameChronometer.h>
+#include <GameCore/GameTypes.h>
 
+#include <array>
 #include <atomic>
+#include <cstdint>
+#include <iomanip>
+#include <sstream>
+#include <string>
+#include <vector>
 
 struct PerfStats
 {
@@ -54,10 +61,13 @@ struct PerfStats
 
         inline void Update(GameChronometer::duration duration)
         {
+            // May be updated concurrently - e.g. by ships being updated in parallel
             auto ratio = mRatio.load();
-            ratio.Duration += duration;
-            ratio.Denominator += 1;
-            mRatio.store(ratio);
+            _Ratio newRatio;
+            do
+            {
+                newRatio = _Ratio(ratio.Duration + duration, ratio.Denominator + 1);
+            } while (!mRatio.compare_exchange_weak(ratio, newRatio));
         }
 
         template<typename TDuration>
@@ -73,6 +83,11 @@ struct PerfStats
                 / static_cast<float>(ratio.Denominator);
         }
 
+        inline size_t GetCount() const
+        {
+            return mRatio.load().Denominator;
+        }
+
         inline void Reset()
         {
             mRatio.store(_Ratio());
@@ -92,14 +107,225 @@ struct PerfStats
         }
     };
 
+    struct Average
+    {
+    private:
+
+        struct _Average
+        {
+            std::uint64_t Sum;
+            size_t Count;
+
+            _Average() noexcept
+                : Sum(0)
+                , Count(0)
+            {}
+
+            _Average(
+                std::uint64_t sum,
+                size_t count)
+                : Sum(sum)
+                , Count(count)
+            {}
+        };
+
+        std::atomic<_Average> mAverage;
+
+    public:
+
+        Average()
+            : mAverage()
+        {}
+
+        Average(Average const & other)
+        {
+            mAverage.store(other.mAverage.load());
+        }
+
+        Average const & operator=(Average const & other)
+        {
+            mAverage.store(other.mAverage.load());
+            return *this;
+        }
+
+        inline void Update(std::uint64_t value)
+        {
+            // May be updated concurrently - e.g. by ships being updated in parallel
+            auto average = mAverage.load();
+            _Average newAverage;
+            do
+            {
+                newAverage = _Average(average.Sum + value, average.Count + 1);
+            } while (!mAverage.compare_exchange_weak(average, newAverage));
+        }
+
+        inline float ToAverage() const
+        {
+            _Average const average = mAverage.load();
+
+            if (average.Count == 0)
+                return 0.0f;
+
+            return static_cast<float>(average.Sum) / static_cast<float>(average.Count);
+        }
+
+        inline void Reset()
+        {
+            mAverage.store(_Average());
+        }
+
+        friend Average operator-(Average const & lhs, Average const & rhs)
+        {
+            auto const lAverage = lhs.mAverage.load();
+            auto const rAverage = rhs.mAverage.load();
+            _Average result(
+                lAverage.Sum - rAverage.Sum,
+                lAverage.Count - rAverage.Count);
+
+            Average res;
+            res.mAverage.store(result);
+            return res;
+        }
+    };
+
+    /*
+     * The stages of Ship::Update() whose costs are attributed to each ship; each stage
+     * is charged with the time since the end of the previous one.
+     */
+    enum class ShipUpdateStageType : size_t
+    {
+        Preparation = 0,
+        Masses,
+        MechanicalDynamics,
+        Sleep,
+        Strains,
+        WorldForces,
+        StaticPressure,
+        Rot,
+        Gadgets,
+        StateMachines,
+        WaterInflow,
+        InternalPressure,
+        WaterVelocities,
+        Electricals,
+        ConcurrentStages, // The stages run as a task graph
+        _Last = ConcurrentStages
+    };
+
+    static size_t constexpr ShipUpdateStageCount = static_cast<size_t>(ShipUpdateStageType::_Last) + 1;
+
+    static char const * GetShipUpdateStageName(ShipUpdateStageType stage)
+    {
+        static char const * const Names[ShipUpdateStageCount] = {
+            "Preparation",
+            "Masses",
+            "MechanicalDynamics",
+            "Sleep",
+            "Strains",
+            "WorldForces",
+            "StaticPressure",
+            "Rot",
+            "Gadgets",
+            "StateMachines",
+            "WaterInflow",
+            "InternalPressure",
+            "WaterVelocities",
+            "Electricals",
+            "ConcurrentStages"
+        };
+
+        return Names[static_cast<size_t>(stage)];
+    }
+
+    /*
+     * The costs of the updates of a single ship, for telling - in worlds with many
+     * ships - which ship is expensive, and why.
+     */
+    struct ShipPerfStats
+    {
+        Ratio UpdateDuration;
+        std::array<Ratio, ShipUpdateStageCount> StageDurations;
+        Average LivePoints; // Per update; ship points, i.e. not ephemeral
+        Average LiveSprings; // Per update
+        Average EphemeralParticles; // Per update
+        Average Frontiers; // Per update
+
+        void Reset()
+        {
+            UpdateDuration.Reset();
+            for (auto & stageDuration : StageDurations)
+            {
+                stageDuration.Reset();
+            }
+
+            LivePoints.Reset();
+            LiveSprings.Reset();
+            EphemeralParticles.Reset();
+            Frontiers.Reset();
+        }
+
+        std::string ToString(ShipId shipId) const
+        {
+            std::stringstream ss;
+
+            ss << std::fixed << std::setprecision(2)
+                << "Ship " << static_cast<int>(shipId) << ": " << UpdateDuration.ToRatio<std::chrono::milliseconds>() << " ms"
+                << " - points: " << LivePoints.ToAverage()
+                << ", springs: " << LiveSprings.ToAverage()
+                << ", ephemeral particles: " << EphemeralParticles.ToAverage()
+                << ", frontiers: " << Frontiers.ToAverage();
+
+            for (size_t s = 0; s < ShipUpdateStageCount; ++s)
+            {
+                if (StageDurations[s].GetCount() > 0)
+                {
+                    ss << "\n    " << GetShipUpdateStageName(static_cast<ShipUpdateStageType>(s)) << ": "
+                        << StageDurations[s].ToRatio<std::chrono::milliseconds>() << " ms";
+                }
+            }
+
+            return ss.str();
+        }
+
+        friend ShipPerfStats operator-(ShipPerfStats const & lhs, ShipPerfStats const & rhs)
+        {
+            ShipPerfStats res;
+
+            res.UpdateDuration = lhs.UpdateDuration - rhs.UpdateDuration;
+            for (size_t s = 0; s < ShipUpdateStageCount; ++s)
+            {
+                res.StageDurations[s] = lhs.StageDurations[s] - rhs.StageDurations[s];
+            }
+
+            res.LivePoints = lhs.LivePoints - rhs.LivePoints;
+            res.LiveSprings = lhs.LiveSprings - rhs.LiveSprings;
+            res.EphemeralParticles = lhs.EphemeralParticles - rhs.EphemeralParticles;
+            res.Frontiers = lhs.Frontiers - rhs.Frontiers;
+
+            return res;
+        }
+    };
+
     // Update
     Ratio TotalUpdateDuration;
     Ratio TotalFishUpdateDuration;
     Ratio TotalOceanSurfaceUpdateDuration;
     Ratio TotalShipsUpdateDuration;
     Ratio TotalShipsSpringsUpdateDuration;
-    Ratio TotalWaitForRenderUploadDuration;
-    Ratio TotalNetUpdateDuration; // = TotalUpdateDuration - TotalWaitForRenderUploadDuration
+    Average TotalShipsMechanicalDynamicsIterations; // Per ship per update
+    Average TotalShipsEphemeralParticleExhaustions; // Per ship per update; allocations of ephemeral particles finding no room
+    Average TotalShipsEphemeralParticleLevelOfDetailSkips; // Per ship per update; ephemeral particles not spawned because of the level of detail
+    Average TotalShipsAirBubbleParticles; // Per ship per update; live ephemeral particles of each type
+    Average TotalShipsDebrisParticles;
+    Average TotalShipsSmokeParticles;
+    Average TotalShipsSparkleParticles;
+    Average TotalShipsWakeBubbleParticles;
+    Ratio TotalNetUpdateDuration; // Excluding RenderContext::UpdateStart()
+
+    // Update, per ship, by ship ID; each ship only updates its own, and entries
+    // are only added - via EnsureShipCount() - while no ship is being updated;
+    // entries outlive their ships, and do not accumulate anymore afterwards
+    std::vector<ShipPerfStats> Ships;
 
     // Render-Upload
     Ratio TotalWaitForRenderDrawDuration;
@@ -110,11 +336,24 @@ struct PerfStats
     Ratio TotalRenderDrawDuration; // In render thread
     Ratio TotalUploadRenderDrawDuration;
 
+    // Render-Draw, in GPU; measured a few frames late, and only when supported
+    Ratio TotalWorldGpuRenderDrawDuration;
+    Ratio TotalShipsGpuRenderDrawDuration;
+    Ratio TotalNotificationsGpuRenderDrawDuration;
+
     PerfStats()
     {
         Reset();
     }
 
+    void EnsureShipCount(size_t shipCount)
+    {
+        if (Ships.size() < shipCount)
+        {
+            Ships.resize(shipCount);
+        }
+    }
+
     void Reset()
     {
         TotalUpdateDuration.Reset();
@@ -122,8 +361,19 @@ struct PerfStats
         TotalOceanSurfaceUpdateDuration.Reset();
         TotalShipsUpdateDuration.Reset();
         TotalShipsSpringsUpdateDuration.Reset();
-        TotalWaitForRenderUploadDuration.Reset();
+        TotalShipsMechanicalDynamicsIterations.Reset();
+        TotalShipsEphemeralParticleExhaustions.Reset();
+        TotalShipsEphemeralParticleLevelOfDetailSkips.Reset();
+        TotalShipsAirBubbleParticles.Reset();
+        TotalShipsDebrisParticles.Reset();
+        TotalShipsSmokeParticles.Reset();
+        TotalShipsSparkleParticles.Reset();
+        TotalShipsWakeBubbleParticles.Reset();
         TotalNetUpdateDuration.Reset();
+        for (auto & ship : Ships)
+        {
+            ship.Reset();
+        }
 
         TotalWaitForRenderDrawDuration.Reset();
         TotalNetRenderUploadDuration.Reset();
@@ -131,6 +381,10 @@ struct PerfStats
         TotalMainThreadRenderDrawDuration.Reset();
         TotalRenderDrawDuration.Reset();
         TotalUploadRenderDrawDuration.Reset();
+
+        TotalWorldGpuRenderDrawDuration.Reset();
+        TotalShipsGpuRenderDrawDuration.Reset();
+        TotalNotificationsGpuRenderDrawDuration.Reset();
     }
 
     PerfStats & operator=(PerfStats const & other) = default;
@@ -145,9 +399,24 @@ inline PerfStats operator-(PerfStats const & lhs, PerfStats const & rhs)
     perfStats.TotalOceanSurfaceUpdateDuration = lhs.TotalOceanSurfaceUpdateDuration - rhs.TotalOceanSurfaceUpdateDuration;
     perfStats.TotalShipsUpdateDuration = lhs.TotalShipsUpdateDuration - rhs.TotalShipsUpdateDuration;
     perfStats.TotalShipsSpringsUpdateDuration = lhs.TotalShipsSpringsUpdateDuration - rhs.TotalShipsSpringsUpdateDuration;
-    perfStats.TotalWaitForRenderUploadDuration = lhs.TotalWaitForRenderUploadDuration - rhs.TotalWaitForRenderUploadDuration;
+    perfStats.TotalShipsMechanicalDynamicsIterations = lhs.TotalShipsMechanicalDynamicsIterations - rhs.TotalShipsMechanicalDynamicsIterations;
+    perfStats.TotalShipsEphemeralParticleExhaustions = lhs.TotalShipsEphemeralParticleExhaustions - rhs.TotalShipsEphemeralParticleExhaustions;
+    perfStats.TotalShipsEphemeralParticleLevelOfDetailSkips = lhs.TotalShipsEphemeralParticleLevelOfDetailSkips - rhs.TotalShipsEphemeralParticleLevelOfDetailSkips;
+    perfStats.TotalShipsAirBubbleParticles = lhs.TotalShipsAirBubbleParticles - rhs.TotalShipsAirBubbleParticles;
+    perfStats.TotalShipsDebrisParticles = lhs.TotalShipsDebrisParticles - rhs.TotalShipsDebrisParticles;
+    perfStats.TotalShipsSmokeParticles = lhs.TotalShipsSmokeParticles - rhs.TotalShipsSmokeParticles;
+    perfStats.TotalShipsSparkleParticles = lhs.TotalShipsSparkleParticles - rhs.TotalShipsSparkleParticles;
+    perfStats.TotalShipsWakeBubbleParticles = lhs.TotalShipsWakeBubbleParticles - rhs.TotalShipsWakeBubbleParticles;
     perfStats.TotalNetUpdateDuration = lhs.TotalNetUpdateDuration - rhs.TotalNetUpdateDuration;
 
+    perfStats.Ships.resize(lhs.Ships.size());
+    for (size_t s = 0; s < lhs.Ships.size(); ++s)
+    {
+        perfStats.Ships[s] = (s < rhs.Ships.size())
+            ? lhs.Ships[s] - rhs.Ships[s]
+            : lhs.Ships[s];
+    }
+
     perfStats.TotalWaitForRenderDrawDuration = lhs.TotalWaitForRenderDrawDuration - rhs.TotalWaitForRenderDrawDuration;
     perfStats.TotalNetRenderUploadDuration = lhs.TotalNetRenderUploadDuration - rhs.TotalNetRenderUploadDuration;
 
@@ -155,5 +424,9 @@ inline PerfStats operator-(PerfStats const & lhs, PerfStats const & rhs)
     perfStats.TotalRenderDrawDuration = lhs.TotalRenderDrawDuration - rhs.TotalRenderDrawDuration;
     perfStats.TotalUploadRenderDrawDuration = lhs.TotalUploadRenderDrawDuration - rhs.TotalUploadRenderDrawDuration;
 
+    perfStats.TotalWorldGpuRenderDrawDuration = lhs.TotalWorldGpuRenderDrawDuration - rhs.TotalWorldGpuRenderDrawDuration;
+    perfStats.TotalShipsGpuRenderDrawDuration = lhs.TotalShipsGpuRenderDrawDuration - rhs.TotalShipsGpuRenderDrawDuration;
+    perfStats.TotalNotificationsGpuRenderDrawDuration = lhs.TotalNotificationsGpuRenderDrawDuration - rhs.TotalNotificationsGpuRenderDrawDuration;
+
     return perfStats;
 }
\ No newline at end of file
@@ -12,6 +12,7 @@ namespace Physics
     class Fishes;
     class Frontiers;
     class Gadgets;
+    class NPCs;
     class OceanFloor;
     class OceanSurface;
     class PinnedPoints;
@@ -39,6 +40,7 @@ namespace Physics
 #include "Triangles.h"
 #include "ElectricalElements.h"
 #include "Frontiers.h"
+#include "NPCs.h"
 
 #include "Clouds.h"
 #include "Fishes.h"
@@ -31,6 +31,23 @@ PhysicsProbeGadget::PhysicsProbeGadget(
 {
 }
 
+PhysicsProbeGadget::PhysicsProbeGadget(
+    PhysicsProbeGadget const & other,
+    ShipFragmentMap const & fragmentMap,
+    IShipPhysicsHandler & shipPhysicsHandler,
+    Points & shipPoints,
+    Springs & shipSprings)
+    : Gadget(
+        other,
+        fragmentMap,
+        shipPhysicsHandler,
+        shipPoints,
+        shipSprings)
+    , mState(other.mState)
+    , mNextStateTransitionTimePoint(other.mNextStateTransitionTimePoint)
+{
+}
+
 bool PhysicsProbeGadget::Update(
     GameWallClock::time_point currentWallClockTime,
     float /*currentSimulationTime*/,
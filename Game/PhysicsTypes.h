@@ -5,8 +5,12 @@
 ***************************************************************************************/
 #pragma once
 
+#include <GameCore/GameTypes.h>
 #include <GameCore/Vectors.h>
 
+#include <cassert>
+#include <vector>
+
 //
 // Wind field (interactive)
 //
@@ -25,4 +29,68 @@ struct WindField
         , FieldRadius(fieldRadius)
         , WindSpeed(windSpeed)
     {}
+};
+
+//
+// Ship fragments
+//
+
+/*
+ * The correspondence between the indices of the elements of a container and
+ * the indices of those elements in a container built from a subset of them.
+ *
+ * Elements are added in increasing order of their old indices, hence the
+ * relative order of the elements is preserved.
+ */
+struct ElementIndexRemap
+{
+    std::vector<ElementIndex> NewToOld;
+    std::vector<ElementIndex> OldToNew; // NoneElementIndex for the elements that are not kept
+
+    explicit ElementIndexRemap(ElementCount oldElementCount)
+        : NewToOld()
+        , OldToNew(oldElementCount, NoneElementIndex)
+    {}
+
+    void Add(ElementIndex oldElementIndex)
+    {
+        assert(oldElementIndex < OldToNew.size());
+        assert(NewToOld.empty() || NewToOld.back() < oldElementIndex);
+
+        OldToNew[oldElementIndex] = static_cast<ElementIndex>(NewToOld.size());
+        NewToOld.push_back(oldElementIndex);
+    }
+
+    bool Contains(ElementIndex oldElementIndex) const
+    {
+        assert(oldElementIndex < OldToNew.size());
+        return OldToNew[oldElementIndex] != NoneElementIndex;
+    }
+
+    ElementCount GetNewElementCount() const
+    {
+        return static_cast<ElementCount>(NewToOld.size());
+    }
+};
+
+/*
+ * The elements of a ship that make up one of its fragments.
+ */
+struct ShipFragmentMap
+{
+    ElementIndexRemap PointIndices;
+    ElementIndexRemap SpringIndices;
+    ElementIndexRemap TriangleIndices;
+    ElementIndexRemap ElectricalElementIndices;
+
+    ShipFragmentMap(
+        ElementCount pointCount,
+        ElementCount springCount,
+        ElementCount triangleCount,
+        ElementCount electricalElementCount)
+        : PointIndices(pointCount)
+        , SpringIndices(springCount)
+        , TriangleIndices(triangleCount)
+        , ElectricalElementIndices(electricalElementCount)
+    {}
 };
\ No newline at end of file
@@ -11,9 +11,12 @@
 #include "RenderContext.h"
 
 #include <GameCore/CircularList.h>
+#include <GameCore/StateSnapshot.h>
 #include <GameCore/Vectors.h>
 
+#include <cassert>
 #include <memory>
+#include <vector>
 
 namespace Physics
 {
@@ -155,6 +158,55 @@ public:
         mCurrentPinnedPoints.clear();
     }
 
+    /*
+     * Takes over the pins of a fragment of another ship; the pinning of the points
+     * themselves has already been taken over with the points. Pinned ephemeral
+     * particles are not part of any fragment.
+     */
+    void AddFragment(
+        PinnedPoints const & other,
+        ShipFragmentMap const & fragmentMap)
+    {
+        assert(mCurrentPinnedPoints.size() == 0);
+
+        // The other list is most recent first, hence we re-pin in reverse
+        std::vector<ElementIndex> pinnedPointIndices;
+        for (auto const otherPointIndex : other.mCurrentPinnedPoints)
+        {
+            if (otherPointIndex < fragmentMap.PointIndices.OldToNew.size()
+                && fragmentMap.PointIndices.Contains(otherPointIndex))
+            {
+                pinnedPointIndices.push_back(fragmentMap.PointIndices.OldToNew[otherPointIndex]);
+            }
+        }
+
+        for (auto it = pinnedPointIndices.crbegin(); it != pinnedPointIndices.crend(); ++it)
+        {
+            assert(mShipPoints.IsPinned(*it));
+
+            mCurrentPinnedPoints.emplace(
+                [this](auto purgedPinnedPointIndex)
+                {
+                    this->mShipPoints.Unpin(purgedPinnedPointIndex);
+                },
+                *it);
+        }
+    }
+
+    //
+    // State; the pinning of the points themselves is part of the state of the points
+    //
+
+    void SaveState(StateSnapshotWriter & writer) const
+    {
+        writer.Archive(mCurrentPinnedPoints);
+    }
+
+    void LoadState(StateSnapshotReader & reader)
+    {
+        reader.Archive(mCurrentPinnedPoints);
+    }
+
     //
     // Render
     //
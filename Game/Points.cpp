@@ -5,12 +5,16 @@
 ***************************************************************************************/
 #include "Physics.h"
 
+#include <GameCore/BatchMath.h>
 #include <GameCore/GameMath.h>
 #include <GameCore/Log.h>
 #include <GameCore/PrecalculatedFunction.h>
+#include <GameCore/Profiler.h>
 
 #include <cmath>
 #include <limits>
+#include <numeric>
+#include <type_traits>
 
 namespace Physics {
 
@@ -28,13 +32,13 @@ void Points::Add(
     vec2f const & textureCoordinates,
     float randomNormalizedUniformFloat)
 {
-    ElementIndex const pointIndex = static_cast<ElementIndex>(mIsDamagedBuffer.GetCurrentPopulatedSize());
+    ElementIndex const pointIndex = static_cast<ElementIndex>(mMaterialsBuffer.GetCurrentPopulatedSize());
 
-    mIsDamagedBuffer.emplace_back(false);
     mMaterialsBuffer.emplace_back(&structuralMaterial, electricalMaterial);
-    mIsRopeBuffer.emplace_back(isRope);
+    mIsRopeBitmap.Assign(pointIndex, isRope);
 
     mPositionBuffer.emplace_back(position);
+    mPreviousPositionBuffer.emplace_back(position);
     mFactoryPositionBuffer.emplace_back(position);
     mVelocityBuffer.emplace_back(vec2f::zero());
     mDynamicForceBuffer.emplace_back(vec2f::zero());
@@ -46,6 +50,7 @@ void Points::Add(
     mStressBuffer.emplace_back(0.0f);
     mDecayBuffer.emplace_back(1.0f);
     mFrozenCoefficientBuffer.emplace_back(1.0f);
+    mSleepCoefficientBuffer.emplace_back(1.0f);
     mIntegrationFactorTimeCoefficientBuffer.emplace_back(CalculateIntegrationFactorTimeCoefficient(mCurrentNumMechanicalDynamicsIterations, 1.0f));
     mBuoyancyCoefficientsBuffer.emplace_back(CalculateBuoyancyCoefficients(
         structuralMaterial.BuoyancyVolumeFill,
@@ -61,13 +66,15 @@ void Points::Add(
     mMaterialWaterDiffusionSpeedBuffer.emplace_back(structuralMaterial.WaterDiffusionSpeed);
 
     mWaterBuffer.emplace_back(water);
+    if (water != 0.0f)
+        mWetPoints.Add(pointIndex);
     mWaterVelocityBuffer.emplace_back(vec2f::zero());
     mWaterMomentumBuffer.emplace_back(vec2f::zero());
     mCumulatedIntakenWater.emplace_back(0.0f);
     mLeakingCompositeBuffer.emplace_back(LeakingComposite(isStructurallyLeaking));
     if (isStructurallyLeaking)
         SetStructurallyLeaking(pointIndex);
-    mFactoryIsStructurallyLeakingBuffer.emplace_back(isStructurallyLeaking);
+    mFactoryIsStructurallyLeakingBitmap.Assign(pointIndex, isStructurallyLeaking);
     mTotalFactoryWetPoints += (water > 0.0f ? 1 : 0);
 
     // Heat dynamics
@@ -77,7 +84,8 @@ void Points::Add(
     mMaterialThermalExpansionCoefficientBuffer.emplace_back(structuralMaterial.ThermalExpansionCoefficient);
     mMaterialIgnitionTemperatureBuffer.emplace_back(structuralMaterial.IgnitionTemperature);
     mMaterialCombustionTypeBuffer.emplace_back(structuralMaterial.CombustionType);
-    mCombustionStateBuffer.emplace_back(CombustionState());
+    mCombustionStateBuffer.emplace_back(CombustionState::StateType::NotBurning);
+    mBurningPointSlotBuffer.emplace_back(NoneElementIndex);
 
     // Water raction dynamics
     mWaterReactionStateBuffer.emplace_back(structuralMaterial.WaterReactivity);
@@ -92,10 +100,6 @@ void Points::Add(
     // Rust dynamics
     mMaterialRustReceptivityBuffer.emplace_back(structuralMaterial.RustReceptivity);
 
-    // Ephemeral particles
-    mEphemeralParticleAttributes1Buffer.emplace_back();
-    mEphemeralParticleAttributes2Buffer.emplace_back();
-
     // Structure
     mConnectedSpringsBuffer.emplace_back();
     mFactoryConnectedSpringsBuffer.emplace_back();
@@ -111,9 +115,6 @@ void Points::Add(
     // Repair state
     mRepairStateBuffer.emplace_back();
 
-    // Gadgets
-    mIsGadgetAttachedBuffer.emplace_back(false);
-
     // Randomness
     mRandomNormalizedUniformFloatBuffer.emplace_back(randomNormalizedUniformFloat);
 
@@ -122,6 +123,182 @@ void Points::Add(
     mTextureCoordinatesBuffer.emplace_back(textureCoordinates);
 }
 
+void Points::AddFragment(
+    Points const & other,
+    ShipFragmentMap const & fragmentMap)
+{
+    assert(mMaterialsBuffer.GetCurrentPopulatedSize() == 0);
+
+    auto const & pointMap = fragmentMap.PointIndices;
+    auto const & springMap = fragmentMap.SpringIndices;
+    auto const & triangleMap = fragmentMap.TriangleIndices;
+
+    assert(pointMap.GetNewElementCount() == mRawShipPointCount);
+
+    auto const & oldIndices = pointMap.NewToOld;
+
+    //
+    // Buffers
+    //
+
+    mMaterialsBuffer.emplace_back_from(other.mMaterialsBuffer, oldIndices);
+
+    mPositionBuffer.emplace_back_from(other.mPositionBuffer, oldIndices);
+    mPreviousPositionBuffer.emplace_back_from(other.mPreviousPositionBuffer, oldIndices);
+    mFactoryPositionBuffer.emplace_back_from(other.mFactoryPositionBuffer, oldIndices);
+    mVelocityBuffer.emplace_back_from(other.mVelocityBuffer, oldIndices);
+    mDynamicForceBuffer.emplace_back_from(other.mDynamicForceBuffer, oldIndices);
+    mStaticForceBuffer.emplace_back_from(other.mStaticForceBuffer, oldIndices);
+    mAugmentedMaterialMassBuffer.emplace_back_from(other.mAugmentedMaterialMassBuffer, oldIndices);
+    mMassBuffer.emplace_back_from(other.mMassBuffer, oldIndices);
+    mMaterialBuoyancyVolumeFillBuffer.emplace_back_from(other.mMaterialBuoyancyVolumeFillBuffer, oldIndices);
+    mStrengthBuffer.emplace_back_from(other.mStrengthBuffer, oldIndices);
+    mStressBuffer.emplace_back_from(other.mStressBuffer, oldIndices);
+    mDecayBuffer.emplace_back_from(other.mDecayBuffer, oldIndices);
+    mFrozenCoefficientBuffer.emplace_back_from(other.mFrozenCoefficientBuffer, oldIndices);
+    mSleepCoefficientBuffer.emplace_back_from(other.mSleepCoefficientBuffer, oldIndices);
+    mIntegrationFactorTimeCoefficientBuffer.emplace_back_from(other.mIntegrationFactorTimeCoefficientBuffer, oldIndices);
+    mBuoyancyCoefficientsBuffer.emplace_back_from(other.mBuoyancyCoefficientsBuffer, oldIndices);
+    mCachedDepthBuffer.emplace_back_from(other.mCachedDepthBuffer, oldIndices);
+    mIntegrationFactorBuffer.emplace_back_from(other.mIntegrationFactorBuffer, oldIndices);
+
+    mIsHullBuffer.emplace_back_from(other.mIsHullBuffer, oldIndices);
+    mInternalPressureBuffer.emplace_back_from(other.mInternalPressureBuffer, oldIndices);
+    mMaterialWaterIntakeBuffer.emplace_back_from(other.mMaterialWaterIntakeBuffer, oldIndices);
+    mMaterialWaterRestitutionBuffer.emplace_back_from(other.mMaterialWaterRestitutionBuffer, oldIndices);
+    mMaterialWaterDiffusionSpeedBuffer.emplace_back_from(other.mMaterialWaterDiffusionSpeedBuffer, oldIndices);
+    mWaterBuffer.emplace_back_from(other.mWaterBuffer, oldIndices);
+    mWaterVelocityBuffer.emplace_back_from(other.mWaterVelocityBuffer, oldIndices);
+    mWaterMomentumBuffer.emplace_back_from(other.mWaterMomentumBuffer, oldIndices);
+    mCumulatedIntakenWater.emplace_back_from(other.mCumulatedIntakenWater, oldIndices);
+    mLeakingCompositeBuffer.emplace_back_from(other.mLeakingCompositeBuffer, oldIndices);
+
+    mTemperatureBuffer.emplace_back_from(other.mTemperatureBuffer, oldIndices);
+    mMaterialHeatCapacityReciprocalBuffer.emplace_back_from(other.mMaterialHeatCapacityReciprocalBuffer, oldIndices);
+    mMaterialThermalExpansionCoefficientBuffer.emplace_back_from(other.mMaterialThermalExpansionCoefficientBuffer, oldIndices);
+    mMaterialIgnitionTemperatureBuffer.emplace_back_from(other.mMaterialIgnitionTemperatureBuffer, oldIndices);
+    mMaterialCombustionTypeBuffer.emplace_back_from(other.mMaterialCombustionTypeBuffer, oldIndices);
+    mCombustionStateBuffer.emplace_back_from(other.mCombustionStateBuffer, oldIndices);
+
+    mWaterReactionStateBuffer.emplace_back_from(other.mWaterReactionStateBuffer, oldIndices);
+
+    mLightBuffer.emplace_back_from(other.mLightBuffer, oldIndices);
+
+    mMaterialWindReceptivityBuffer.emplace_back_from(other.mMaterialWindReceptivityBuffer, oldIndices);
+
+    mMaterialRustReceptivityBuffer.emplace_back_from(other.mMaterialRustReceptivityBuffer, oldIndices);
+
+    mConnectedComponentIdBuffer.emplace_back_from(other.mConnectedComponentIdBuffer, oldIndices);
+    mPlaneIdBuffer.emplace_back_from(other.mPlaneIdBuffer, oldIndices);
+    mPlaneIdFloatBuffer.emplace_back_from(other.mPlaneIdFloatBuffer, oldIndices);
+
+    mRepairStateBuffer.emplace_back_from(other.mRepairStateBuffer, oldIndices);
+
+    mRandomNormalizedUniformFloatBuffer.emplace_back_from(other.mRandomNormalizedUniformFloatBuffer, oldIndices);
+
+    mColorBuffer.emplace_back_from(other.mColorBuffer, oldIndices);
+    mTextureCoordinatesBuffer.emplace_back_from(other.mTextureCoordinatesBuffer, oldIndices);
+
+    //
+    // Per-point state holding indices, and flags
+    //
+
+    for (ElementIndex pointIndex = 0; pointIndex < mRawShipPointCount; ++pointIndex)
+    {
+        ElementIndex const otherPointIndex = oldIndices[pointIndex];
+
+        mIsDamagedBitmap.Assign(pointIndex, other.mIsDamagedBitmap.Test(otherPointIndex));
+        mIsRopeBitmap.Assign(pointIndex, other.mIsRopeBitmap.Test(otherPointIndex));
+        mFactoryIsStructurallyLeakingBitmap.Assign(pointIndex, other.mFactoryIsStructurallyLeakingBitmap.Test(otherPointIndex));
+        mIsGadgetAttachedBitmap.Assign(pointIndex, other.mIsGadgetAttachedBitmap.Test(otherPointIndex));
+
+        mBurningPointSlotBuffer.emplace_back(NoneElementIndex); // Populated below
+
+        ElementIndex const otherElectricalElementIndex = other.mElectricalElementBuffer[otherPointIndex];
+        mElectricalElementBuffer.emplace_back(
+            otherElectricalElementIndex != NoneElementIndex
+            ? fragmentMap.ElectricalElementIndices.OldToNew[otherElectricalElementIndex]
+            : NoneElementIndex);
+
+        // Springs and triangles owned by a point are those whose other endpoints
+        // have higher indices, which the monotonic renumbering preserves
+
+        auto const remapConnectedSprings = [&](ConnectedSpringsVector const & otherConnectedSprings, ConnectedSpringsVector & connectedSprings)
+        {
+            for (auto const & cs : otherConnectedSprings.ConnectedSprings)
+            {
+                if (springMap.Contains(cs.SpringIndex))
+                {
+                    ElementIndex const otherEndpointIndex = pointMap.OldToNew[cs.OtherEndpointIndex];
+                    assert(otherEndpointIndex != NoneElementIndex);
+
+                    connectedSprings.ConnectSpring(
+                        springMap.OldToNew[cs.SpringIndex],
+                        otherEndpointIndex,
+                        pointIndex < otherEndpointIndex);
+                }
+            }
+        };
+
+        remapConnectedSprings(other.mConnectedSpringsBuffer[otherPointIndex], mConnectedSpringsBuffer.emplace_back());
+        remapConnectedSprings(other.mFactoryConnectedSpringsBuffer[otherPointIndex], mFactoryConnectedSpringsBuffer.emplace_back());
+
+        auto const remapConnectedTriangles = [&](ConnectedTrianglesVector const & otherConnectedTriangles, ConnectedTrianglesVector & connectedTriangles)
+        {
+            for (size_t ct = 0; ct < otherConnectedTriangles.ConnectedTriangles.size(); ++ct)
+            {
+                ElementIndex const otherTriangleIndex = otherConnectedTriangles.ConnectedTriangles[ct];
+                if (triangleMap.Contains(otherTriangleIndex))
+                {
+                    connectedTriangles.ConnectTriangle(
+                        triangleMap.OldToNew[otherTriangleIndex],
+                        ct < otherConnectedTriangles.OwnedConnectedTrianglesCount);
+                }
+            }
+        };
+
+        remapConnectedTriangles(other.mConnectedTrianglesBuffer[otherPointIndex], mConnectedTrianglesBuffer.emplace_back());
+        remapConnectedTriangles(other.mFactoryConnectedTrianglesBuffer[otherPointIndex], mFactoryConnectedTrianglesBuffer.emplace_back());
+
+        // Connectivity visits start over in the new ship
+        mCurrentConnectivityVisitSequenceNumberBuffer.emplace_back();
+
+        if (other.mLeakingPoints.Contains(otherPointIndex))
+            mLeakingPoints.Add(pointIndex);
+        if (other.mWetPoints.Contains(otherPointIndex))
+            mWetPoints.Add(pointIndex);
+        if (other.mHotPoints.Contains(otherPointIndex))
+            mHotPoints.Add(pointIndex);
+    }
+
+    // We do not know which of the points were wet at factory time, hence we
+    // apportion the factory wet points by the size of the fragment
+    mTotalFactoryWetPoints = static_cast<ElementCount>(
+        static_cast<std::uint64_t>(other.mTotalFactoryWetPoints) * mRawShipPointCount / std::max(other.mRawShipPointCount, ElementCount(1)));
+
+    mIsConnectedSpringsAdjacencyDirty = true;
+
+    //
+    // Burning points: the other ship's are sorted by plane ID and height,
+    // and so is any subset of them
+    //
+
+    for (size_t s = 0; s < other.mBurningPoints.size(); ++s)
+    {
+        ElementIndex const pointIndex = pointMap.OldToNew[other.mBurningPoints[s]];
+        if (pointIndex != NoneElementIndex)
+        {
+            mBurningPointSlotBuffer[pointIndex] = static_cast<ElementIndex>(mBurningPoints.size());
+
+            mBurningPoints.push_back(pointIndex);
+            mBurningPointFlameDevelopments.push_back(other.mBurningPointFlameDevelopments[s]);
+            mBurningPointMaxFlameDevelopments.push_back(other.mBurningPointMaxFlameDevelopments[s]);
+            mBurningPointFlameVectors.push_back(other.mBurningPointFlameVectors[s]);
+            mBurningPointFlameWindRotationAngles.push_back(other.mBurningPointFlameWindRotationAngles[s]);
+        }
+    }
+}
+
 void Points::CreateEphemeralParticleAirBubble(
     vec2f const & position,
     float depth,
@@ -132,8 +309,8 @@ void Points::CreateEphemeralParticleAirBubble(
     float currentSimulationTime,
     PlaneId planeId)
 {
-    // Get a free slot (but don't steal one)
-    auto pointIndex = FindFreeEphemeralParticle(currentSimulationTime, false);
+    // Get a slot, as allowed by the budget of this type
+    auto pointIndex = AllocateEphemeralParticle(EphemeralType::AirBubble);
     if (NoneElementIndex == pointIndex)
         return; // No luck
 
@@ -146,9 +323,11 @@ void Points::CreateEphemeralParticleAirBubble(
     // We want to limit the buoyancy applied to air - using 1.0 makes an air particle boost up too quickly
     float const airBubbleBuoyancyVolumeFill = 0.003f * buoyancyVolumeFillAdjustment;;
 
-    assert(mIsDamagedBuffer[pointIndex] == false); // Ephemeral points are never damaged
+    assert(!mIsDamagedBitmap.Test(pointIndex)); // Ephemeral points are never damaged
     mMaterialsBuffer[pointIndex] = Materials(&airStructuralMaterial, nullptr);
     mPositionBuffer[pointIndex] = position;
+    mPreviousPositionBuffer[pointIndex] = position;
+    mIsSpatialIndexDirty = true;
     mVelocityBuffer[pointIndex] = vec2f::zero();
     assert(mDynamicForceBuffer[pointIndex] == vec2f::zero()); // Ephemeral points never participate in dynamic forces (springs + surface pressure)
     mStaticForceBuffer[pointIndex] = vec2f::zero();
@@ -190,10 +369,10 @@ void Points::CreateEphemeralParticleAirBubble(
     assert(mMaterialRustReceptivityBuffer[pointIndex] == 0.0f);
     //mMaterialRustReceptivityBuffer[pointIndex] = 0.0f;
 
-    mEphemeralParticleAttributes1Buffer[pointIndex].Type = EphemeralType::AirBubble;
-    mEphemeralParticleAttributes1Buffer[pointIndex].StartSimulationTime = currentSimulationTime;
-    mEphemeralParticleAttributes2Buffer[pointIndex].MaxSimulationLifetime = std::numeric_limits<float>::max();
-    mEphemeralParticleAttributes2Buffer[pointIndex].State = EphemeralState::AirBubbleState(
+    mEphemeralParticleAttributes1Buffer[ToEphemeralSlot(pointIndex)].Type = EphemeralType::AirBubble;
+    mEphemeralParticleAttributes1Buffer[ToEphemeralSlot(pointIndex)].StartSimulationTime = currentSimulationTime;
+    mEphemeralParticleAttributes2Buffer[ToEphemeralSlot(pointIndex)].MaxSimulationLifetime = std::numeric_limits<float>::max();
+    mEphemeralParticleAttributes2Buffer[ToEphemeralSlot(pointIndex)].State = EphemeralState::AirBubbleState(
         vortexAmplitude,
         vortexPeriod);
 
@@ -201,7 +380,7 @@ void Points::CreateEphemeralParticleAirBubble(
     //mConnectedComponentIdBuffer[pointIndex] = NoneConnectedComponentId;
     mPlaneIdBuffer[pointIndex] = planeId;
     mPlaneIdFloatBuffer[pointIndex] = static_cast<float>(planeId);
-    mIsPlaneIdBufferEphemeralDirty = true;
+    mPlaneIdBufferEphemeralDirtyRange.Add(pointIndex);
 
     mColorBuffer[pointIndex] = airStructuralMaterial.RenderColor.toVec4f();
     mIsEphemeralColorBufferDirty = true;
@@ -217,17 +396,20 @@ void Points::CreateEphemeralParticleDebris(
     float maxSimulationLifetime,
     PlaneId planeId)
 {
-    // Get a free slot (or steal one)
-    auto pointIndex = FindFreeEphemeralParticle(currentSimulationTime, true);
-    assert(NoneElementIndex != pointIndex);
+    // Get a slot, as allowed by the budget of this type
+    auto pointIndex = AllocateEphemeralParticle(EphemeralType::Debris);
+    if (NoneElementIndex == pointIndex)
+        return; // No luck
 
     //
     // Store attributes
     //
 
-    assert(mIsDamagedBuffer[pointIndex] == false); // Ephemeral points are never damaged
+    assert(!mIsDamagedBitmap.Test(pointIndex)); // Ephemeral points are never damaged
     mMaterialsBuffer[pointIndex] = Materials(&structuralMaterial, nullptr);
     mPositionBuffer[pointIndex] = position;
+    mPreviousPositionBuffer[pointIndex] = position;
+    mIsSpatialIndexDirty = true;
     mVelocityBuffer[pointIndex] = velocity;
     assert(mDynamicForceBuffer[pointIndex] == vec2f::zero()); // Ephemeral points never participate in springs + surface pressure
     mStaticForceBuffer[pointIndex] = vec2f::zero();
@@ -267,16 +449,16 @@ void Points::CreateEphemeralParticleDebris(
     assert(mMaterialRustReceptivityBuffer[pointIndex] == 0.0f);
     //mMaterialRustReceptivityBuffer[pointIndex] = 0.0f;
 
-    mEphemeralParticleAttributes1Buffer[pointIndex].Type = EphemeralType::Debris;
-    mEphemeralParticleAttributes1Buffer[pointIndex].StartSimulationTime = currentSimulationTime;
-    mEphemeralParticleAttributes2Buffer[pointIndex].MaxSimulationLifetime = maxSimulationLifetime;
-    mEphemeralParticleAttributes2Buffer[pointIndex].State = EphemeralState::DebrisState();
+    mEphemeralParticleAttributes1Buffer[ToEphemeralSlot(pointIndex)].Type = EphemeralType::Debris;
+    mEphemeralParticleAttributes1Buffer[ToEphemeralSlot(pointIndex)].StartSimulationTime = currentSimulationTime;
+    mEphemeralParticleAttributes2Buffer[ToEphemeralSlot(pointIndex)].MaxSimulationLifetime = maxSimulationLifetime;
+    mEphemeralParticleAttributes2Buffer[ToEphemeralSlot(pointIndex)].State = EphemeralState::DebrisState();
 
     assert(mConnectedComponentIdBuffer[pointIndex] == NoneConnectedComponentId);
     //mConnectedComponentIdBuffer[pointIndex] = NoneConnectedComponentId;
     mPlaneIdBuffer[pointIndex] = planeId;
     mPlaneIdFloatBuffer[pointIndex] = static_cast<float>(planeId);
-    mIsPlaneIdBufferEphemeralDirty = true;
+    mPlaneIdBufferEphemeralDirtyRange.Add(pointIndex);
 
     mColorBuffer[pointIndex] = structuralMaterial.RenderColor.toVec4f();
     mIsEphemeralColorBufferDirty = true;
@@ -295,9 +477,10 @@ void Points::CreateEphemeralParticleSmoke(
     PlaneId planeId,
     GameParameters const & gameParameters)
 {
-    // Get a free slot (or steal one)
-    auto pointIndex = FindFreeEphemeralParticle(currentSimulationTime, true);
-    assert(NoneElementIndex != pointIndex);
+    // Get a slot, as allowed by the budget of this type
+    auto pointIndex = AllocateEphemeralParticle(EphemeralType::Smoke);
+    if (NoneElementIndex == pointIndex)
+        return; // No luck
 
     // Choose a lifetime
     float const maxSimulationLifetime =
@@ -312,9 +495,11 @@ void Points::CreateEphemeralParticleSmoke(
 
     StructuralMaterial const & airStructuralMaterial = mMaterialDatabase.GetUniqueStructuralMaterial(StructuralMaterial::MaterialUniqueType::Air);
 
-    assert(mIsDamagedBuffer[pointIndex] == false); // Ephemeral points are never damaged
+    assert(!mIsDamagedBitmap.Test(pointIndex)); // Ephemeral points are never damaged
     mMaterialsBuffer[pointIndex] = Materials(&airStructuralMaterial, nullptr);
     mPositionBuffer[pointIndex] = position;
+    mPreviousPositionBuffer[pointIndex] = position;
+    mIsSpatialIndexDirty = true;
     mVelocityBuffer[pointIndex] = vec2f::zero();
     assert(mDynamicForceBuffer[pointIndex] == vec2f::zero()); // Ephemeral points never participate in springs nor surface pressure
     mStaticForceBuffer[pointIndex] = vec2f::zero();
@@ -356,10 +541,10 @@ void Points::CreateEphemeralParticleSmoke(
     assert(mMaterialRustReceptivityBuffer[pointIndex] == 0.0f);
     //mMaterialRustReceptivityBuffer[pointIndex] = 0.0f;
 
-    mEphemeralParticleAttributes1Buffer[pointIndex].Type = EphemeralType::Smoke;
-    mEphemeralParticleAttributes1Buffer[pointIndex].StartSimulationTime = currentSimulationTime;
-    mEphemeralParticleAttributes2Buffer[pointIndex].MaxSimulationLifetime = maxSimulationLifetime;
-    mEphemeralParticleAttributes2Buffer[pointIndex].State = EphemeralState::SmokeState(
+    mEphemeralParticleAttributes1Buffer[ToEphemeralSlot(pointIndex)].Type = EphemeralType::Smoke;
+    mEphemeralParticleAttributes1Buffer[ToEphemeralSlot(pointIndex)].StartSimulationTime = currentSimulationTime;
+    mEphemeralParticleAttributes2Buffer[ToEphemeralSlot(pointIndex)].MaxSimulationLifetime = maxSimulationLifetime;
+    mEphemeralParticleAttributes2Buffer[ToEphemeralSlot(pointIndex)].State = EphemeralState::SmokeState(
         textureGroup,
         growth,
         GameRandomEngine::GetInstance().GenerateNormalizedUniformReal());
@@ -368,7 +553,7 @@ void Points::CreateEphemeralParticleSmoke(
     //mConnectedComponentIdBuffer[pointIndex] = NoneConnectedComponentId;
     mPlaneIdBuffer[pointIndex] = planeId;
     mPlaneIdFloatBuffer[pointIndex] = static_cast<float>(planeId);
-    mIsPlaneIdBufferEphemeralDirty = true;
+    mPlaneIdBufferEphemeralDirtyRange.Add(pointIndex);
 
     mColorBuffer[pointIndex] = airStructuralMaterial.RenderColor.toVec4f();
     mIsEphemeralColorBufferDirty = true;
@@ -383,17 +568,20 @@ void Points::CreateEphemeralParticleSparkle(
     float maxSimulationLifetime,
     PlaneId planeId)
 {
-    // Get a free slot (or steal one)
-    auto pointIndex = FindFreeEphemeralParticle(currentSimulationTime, true);
-    assert(NoneElementIndex != pointIndex);
+    // Get a slot, as allowed by the budget of this type
+    auto pointIndex = AllocateEphemeralParticle(EphemeralType::Sparkle);
+    if (NoneElementIndex == pointIndex)
+        return; // No luck
 
     //
     // Store attributes
     //
 
-    assert(mIsDamagedBuffer[pointIndex] == false); // Ephemeral points are never damaged
+    assert(!mIsDamagedBitmap.Test(pointIndex)); // Ephemeral points are never damaged
     mMaterialsBuffer[pointIndex] = Materials(&structuralMaterial, nullptr);
     mPositionBuffer[pointIndex] = position;
+    mPreviousPositionBuffer[pointIndex] = position;
+    mIsSpatialIndexDirty = true;
     mVelocityBuffer[pointIndex] = velocity;
     assert(mDynamicForceBuffer[pointIndex] == vec2f::zero()); // Ephemeral points never participate in springs + surface pressure
     mStaticForceBuffer[pointIndex] = vec2f::zero();
@@ -433,16 +621,16 @@ void Points::CreateEphemeralParticleSparkle(
     assert(mMaterialRustReceptivityBuffer[pointIndex] == 0.0f);
     //mMaterialRustReceptivityBuffer[pointIndex] = 0.0f;
 
-    mEphemeralParticleAttributes1Buffer[pointIndex].Type = EphemeralType::Sparkle;
-    mEphemeralParticleAttributes1Buffer[pointIndex].StartSimulationTime = currentSimulationTime;
-    mEphemeralParticleAttributes2Buffer[pointIndex].MaxSimulationLifetime = maxSimulationLifetime;
-    mEphemeralParticleAttributes2Buffer[pointIndex].State = EphemeralState::SparkleState();
+    mEphemeralParticleAttributes1Buffer[ToEphemeralSlot(pointIndex)].Type = EphemeralType::Sparkle;
+    mEphemeralParticleAttributes1Buffer[ToEphemeralSlot(pointIndex)].StartSimulationTime = currentSimulationTime;
+    mEphemeralParticleAttributes2Buffer[ToEphemeralSlot(pointIndex)].MaxSimulationLifetime = maxSimulationLifetime;
+    mEphemeralParticleAttributes2Buffer[ToEphemeralSlot(pointIndex)].State = EphemeralState::SparkleState();
 
     assert(mConnectedComponentIdBuffer[pointIndex] == NoneConnectedComponentId);
     //mConnectedComponentIdBuffer[pointIndex] = NoneConnectedComponentId;
     mPlaneIdBuffer[pointIndex] = planeId;
     mPlaneIdFloatBuffer[pointIndex] = static_cast<float>(planeId);
-    mIsPlaneIdBufferEphemeralDirty = true;
+    mPlaneIdBufferEphemeralDirtyRange.Add(pointIndex);
 }
 
 void Points::CreateEphemeralParticleWakeBubble(
@@ -453,8 +641,12 @@ void Points::CreateEphemeralParticleWakeBubble(
     PlaneId planeId,
     GameParameters const & gameParameters)
 {
-    // Get a free slot (but don't steal one)
-    auto pointIndex = FindFreeEphemeralParticle(currentSimulationTime, false);
+    // Do not exceed the density at which bubbles may still be told apart
+    if (!mWakeBubbleSpawnGrid.TrySpawn(position, currentSimulationTime))
+        return;
+
+    // Get a slot, as allowed by the budget of this type
+    auto pointIndex = AllocateEphemeralParticle(EphemeralType::WakeBubble);
     if (NoneElementIndex == pointIndex)
         return; // No luck
 
@@ -464,9 +656,11 @@ void Points::CreateEphemeralParticleWakeBubble(
 
     StructuralMaterial const & waterStructuralMaterial = mMaterialDatabase.GetUniqueStructuralMaterial(StructuralMaterial::MaterialUniqueType::Water);
 
-    assert(mIsDamagedBuffer[pointIndex] == false); // Ephemeral points are never damaged
+    assert(!mIsDamagedBitmap.Test(pointIndex)); // Ephemeral points are never damaged
     mMaterialsBuffer[pointIndex] = Materials(&waterStructuralMaterial, nullptr);
     mPositionBuffer[pointIndex] = position;
+    mPreviousPositionBuffer[pointIndex] = position;
+    mIsSpatialIndexDirty = true;
     mVelocityBuffer[pointIndex] = velocity;
     assert(mDynamicForceBuffer[pointIndex] == vec2f::zero()); // Ephemeral points never participate in springs + surface pressure
     mStaticForceBuffer[pointIndex] = vec2f::zero();
@@ -508,16 +702,16 @@ void Points::CreateEphemeralParticleWakeBubble(
     assert(mMaterialRustReceptivityBuffer[pointIndex] == 0.0f);
     //mMaterialRustReceptivityBuffer[pointIndex] = 0.0f;
 
-    mEphemeralParticleAttributes1Buffer[pointIndex].Type = EphemeralType::WakeBubble;
-    mEphemeralParticleAttributes1Buffer[pointIndex].StartSimulationTime = currentSimulationTime;
-    mEphemeralParticleAttributes2Buffer[pointIndex].MaxSimulationLifetime = 0.4f; // Magic number
-    mEphemeralParticleAttributes2Buffer[pointIndex].State = EphemeralState::WakeBubbleState();
+    mEphemeralParticleAttributes1Buffer[ToEphemeralSlot(pointIndex)].Type = EphemeralType::WakeBubble;
+    mEphemeralParticleAttributes1Buffer[ToEphemeralSlot(pointIndex)].StartSimulationTime = currentSimulationTime;
+    mEphemeralParticleAttributes2Buffer[ToEphemeralSlot(pointIndex)].MaxSimulationLifetime = 0.4f; // Magic number
+    mEphemeralParticleAttributes2Buffer[ToEphemeralSlot(pointIndex)].State = EphemeralState::WakeBubbleState();
 
     assert(mConnectedComponentIdBuffer[pointIndex] == NoneConnectedComponentId);
     //mConnectedComponentIdBuffer[pointIndex] = NoneConnectedComponentId;
     mPlaneIdBuffer[pointIndex] = planeId;
     mPlaneIdFloatBuffer[pointIndex] = static_cast<float>(planeId);
-    mIsPlaneIdBufferEphemeralDirty = true;
+    mPlaneIdBufferEphemeralDirtyRange.Add(pointIndex);
 
     mColorBuffer[pointIndex] = waterStructuralMaterial.RenderColor.toVec4f();
     mIsEphemeralColorBufferDirty = true;
@@ -549,13 +743,13 @@ void Points::Detach(
     }
 
     // Check if it's the first time we get damaged
-    if (!mIsDamagedBuffer[pointElementIndex])
+    if (!mIsDamagedBitmap.Test(pointElementIndex))
     {
         // Invoke handler
         mShipPhysicsHandler->HandlePointDamaged(pointElementIndex);
 
         // Flag ourselves as damaged
-        mIsDamagedBuffer[pointElementIndex] = true;
+        mIsDamagedBitmap.Set(pointElementIndex);
     }
 }
 
@@ -564,26 +758,21 @@ void Points::Restore(ElementIndex pointElementIndex)
     assert(IsDamaged(pointElementIndex));
 
     // Clear the damaged flag
-    mIsDamagedBuffer[pointElementIndex] = false;
+    mIsDamagedBitmap.Clear(pointElementIndex);
 
     // Restore factory-time structural IsLeaking
     mLeakingCompositeBuffer[pointElementIndex].LeakingSources.StructuralLeak =
-        mFactoryIsStructurallyLeakingBuffer[pointElementIndex] ? 1.0f : 0.0f;
+        mFactoryIsStructurallyLeakingBitmap.Test(pointElementIndex) ? 1.0f : 0.0f;
 
     // Remove point from set of burning points, in case it was burning
-    if (mCombustionStateBuffer[pointElementIndex].State != CombustionState::StateType::NotBurning)
+    if (mBurningPointSlotBuffer[pointElementIndex] != NoneElementIndex)
     {
-        auto pointIt = std::find(
-            mBurningPoints.cbegin(),
-            mBurningPoints.cend(),
-            pointElementIndex);
-        assert(pointIt != mBurningPoints.cend());
-        mBurningPoints.erase(pointIt);
-
-        // Restore combustion state
-        mCombustionStateBuffer[pointElementIndex].Reset();
+        RemoveBurningPoint(pointElementIndex);
     }
 
+    // Restore combustion state
+    mCombustionStateBuffer[pointElementIndex] = CombustionState::StateType::NotBurning;
+
     // Reset water reaction state
     mWaterReactionStateBuffer[pointElementIndex].Reset();
 
@@ -598,14 +787,53 @@ void Points::OnOrphaned(ElementIndex pointElementIndex)
     // If we're in flames, make the flame tiny
     //
 
-    if (mCombustionStateBuffer[pointElementIndex].State == CombustionState::StateType::Burning)
+    if (mCombustionStateBuffer[pointElementIndex] == CombustionState::StateType::Burning)
     {
+        ElementIndex const burningPointSlot = mBurningPointSlotBuffer[pointElementIndex];
+        assert(burningPointSlot != NoneElementIndex);
+
         // New target: fraction of current size plus something
-        mCombustionStateBuffer[pointElementIndex].MaxFlameDevelopment =
-            mCombustionStateBuffer[pointElementIndex].FlameDevelopment / 3.0f
+        mBurningPointMaxFlameDevelopments[burningPointSlot] =
+            mBurningPointFlameDevelopments[burningPointSlot] / 3.0f
             + 0.04f * mRandomNormalizedUniformFloatBuffer[pointElementIndex];
 
-        mCombustionStateBuffer[pointElementIndex].State = CombustionState::StateType::Developing_2;
+        mCombustionStateBuffer[pointElementIndex] = CombustionState::StateType::Developing_2;
+    }
+}
+
+void Points::RemapSpringIndices(std::vector<ElementIndex> const & oldToNewSpringIndices)
+{
+    for (ElementIndex pointIndex = 0; pointIndex < mRawShipPointCount; ++pointIndex)
+    {
+        for (auto & cs : mConnectedSpringsBuffer[pointIndex].ConnectedSprings)
+        {
+            cs.SpringIndex = oldToNewSpringIndices[cs.SpringIndex];
+        }
+
+        for (auto & cs : mFactoryConnectedSpringsBuffer[pointIndex].ConnectedSprings)
+        {
+            cs.SpringIndex = oldToNewSpringIndices[cs.SpringIndex];
+        }
+    }
+
+    RebuildConnectedSpringsAdjacency();
+}
+
+void Points::RebuildConnectedSpringsAdjacency()
+{
+    // Room for all factory-connected springs, as those are the only ones that may ever be connected
+    mConnectedSpringsAdjacency.BuildLayout(
+        mRawShipPointCount,
+        [this](ElementIndex pointIndex)
+        {
+            return static_cast<ElementCount>(mFactoryConnectedSpringsBuffer[pointIndex].ConnectedSprings.size());
+        });
+
+    mIsConnectedSpringsAdjacencyDirty = false;
+
+    for (ElementIndex pointIndex = 0; pointIndex < mRawShipPointCount; ++pointIndex)
+    {
+        PatchConnectedSpringsAdjacency(pointIndex);
     }
 }
 
@@ -628,6 +856,16 @@ void Points::DestroyEphemeralParticle(
 
 void Points::UpdateForGameParameters(GameParameters const & gameParameters)
 {
+    FS_PROFILE_SCOPE("Points::UpdateForGameParameters");
+
+    if (gameParameters.Generation == mCurrentGameParametersGeneration)
+    {
+        // No parameter has changed
+        return;
+    }
+
+    mCurrentGameParametersGeneration = gameParameters.Generation;
+
     //
     // Check parameter changes
     //
@@ -640,7 +878,7 @@ void Points::UpdateForGameParameters(GameParameters const & gameParameters)
         {
             mIntegrationFactorTimeCoefficientBuffer[i] = CalculateIntegrationFactorTimeCoefficient(
                 numMechanicalDynamicsIterations,
-                mFrozenCoefficientBuffer[i]);
+                mFrozenCoefficientBuffer[i] * mSleepCoefficientBuffer[i]);
         }
 
         // Remember the new value
@@ -682,6 +920,8 @@ void Points::UpdateCombustionLowFrequency(
     Storm::Parameters const & stormParameters,
     GameParameters const & gameParameters)
 {
+    FS_PROFILE_SCOPE("Points::UpdateCombustionLowFrequency");
+
     /////////////////////////////////////////////////////////////////////////////
     // Take care of following:
     // - Combustion:
@@ -713,7 +953,7 @@ void Points::UpdateCombustionLowFrequency(
         // Combustion
         //
 
-        auto const currentCombustionState = mCombustionStateBuffer[pointIndex].State;
+        auto const currentCombustionState = mCombustionStateBuffer[pointIndex];
 
         if (currentCombustionState == CombustionState::StateType::NotBurning)
         {
@@ -769,7 +1009,7 @@ void Points::UpdateCombustionLowFrequency(
                 // Transition to Extinguishing - by consumption
                 //
 
-                mCombustionStateBuffer[pointIndex].State = CombustionState::StateType::Extinguishing_Consumed;
+                mCombustionStateBuffer[pointIndex] = CombustionState::StateType::Extinguishing_Consumed;
 
                 // Notify combustion end
                 mGameEventHandler->OnPointCombustionEnd();
@@ -800,6 +1040,7 @@ void Points::UpdateCombustionLowFrequency(
 
                 // Decay point
                 mDecayBuffer[pointIndex] *= decayAlpha;
+                mDecayBufferDirtyRange.Add(pointIndex);
 
                 //
                 // 2. Decay neighbors
@@ -808,6 +1049,7 @@ void Points::UpdateCombustionLowFrequency(
                 for (auto const s : GetConnectedSprings(pointIndex).ConnectedSprings)
                 {
                     mDecayBuffer[s.OtherEndpointIndex] *= decayAlpha;
+                    mDecayBufferDirtyRange.Add(s.OtherEndpointIndex);
                 }
             }
         }
@@ -884,10 +1126,10 @@ void Points::UpdateCombustionLowFrequency(
             // Ignite!
             //
 
-            mCombustionStateBuffer[pointIndex].State = CombustionState::StateType::Developing_1;
+            mCombustionStateBuffer[pointIndex] = CombustionState::StateType::Developing_1;
 
             // Initial development depends on how deep this particle is in its burning zone
-            mCombustionStateBuffer[pointIndex].FlameDevelopment =
+            float const flameDevelopment =
                 0.1f + 0.5f * SmoothStep(0.0f, 2.0f, std::get<1>(mCombustionIgnitionCandidates[i]));
 
             // Calculate max development: random and depending on number of springs connected to this point
@@ -895,29 +1137,18 @@ void Points::UpdateCombustionLowFrequency(
             float const deltaSizeDueToConnectedSprings =
                 static_cast<float>(mConnectedSpringsBuffer[pointIndex].ConnectedSprings.size())
                 * 0.0625f; // 0.0625 -> 0.50 (@8)
-            mCombustionStateBuffer[pointIndex].MaxFlameDevelopment = std::max(
+            float const maxFlameDevelopment = std::max(
                 0.25f + deltaSizeDueToConnectedSprings + 0.5f * mRandomNormalizedUniformFloatBuffer[pointIndex], // 0.25 + dsdtcs -> 0.75 + dsdtcs
-                mCombustionStateBuffer[pointIndex].FlameDevelopment);
-
-            // Initialize flame vector
-            mCombustionStateBuffer[pointIndex].FlameVector = CalculateIdealFlameVector(
-                GetVelocity(pointIndex),
-                200.0f); // For an initial flame, we want the particle's current velocity to have a smaller impact on the flame vector
-
-            // Add point to vector of burning points, sorted by plane ID
-            assert(mBurningPoints.cend() == std::find(mBurningPoints.cbegin(), mBurningPoints.cend(), pointIndex));
-            mBurningPoints.insert(
-                std::lower_bound( // Earlier than others at same plane ID, so it's drawn behind them
-                    mBurningPoints.cbegin(),
-                    mBurningPoints.cend(),
-                    pointIndex,
-                    [this](auto p1, auto p2)
-                    {
-                        // Sort by plane and then by vertical position, so bottommost flames cover uppermost ones
-                        return mPlaneIdBuffer[p1] < mPlaneIdBuffer[p2]
-                            || (mPlaneIdBuffer[p1] == mPlaneIdBuffer[p2] && mPositionBuffer[p1].y > mPositionBuffer[p2].y);
-                    }),
-                pointIndex);
+                flameDevelopment);
+
+            // Add point to burning points, with its initial flame vector
+            AddBurningPoint(
+                pointIndex,
+                flameDevelopment,
+                maxFlameDevelopment,
+                CalculateIdealFlameVector(
+                    GetVelocity(pointIndex),
+                    200.0f)); // For an initial flame, we want the particle's current velocity to have a smaller impact on the flame vector
 
             // Notify
             mGameEventHandler->OnPointCombustionBegin();
@@ -988,7 +1219,7 @@ void Points::UpdateCombustionLowFrequency(
                 1);
 
             // Transition state
-            mCombustionStateBuffer[pointIndex].State = CombustionState::StateType::Exploded;
+            mCombustionStateBuffer[pointIndex] = CombustionState::StateType::Exploded;
         }
     }
 
@@ -1060,10 +1291,11 @@ void Points::UpdateCombustionLowFrequency(
 void Points::UpdateCombustionHighFrequency(
     float /*currentSimulationTime*/,
     float dt,
-    vec2f const & globalWindSpeed,
-    std::optional<WindField> const & windField,
+    Wind const & wind,
     GameParameters const & gameParameters)
 {
+    FS_PROFILE_SCOPE("Points::UpdateCombustionHighFrequency");
+
     //
     // For all burning points, take care of following:
     // - Developing points: development up
@@ -1080,22 +1312,22 @@ void Points::UpdateCombustionHighFrequency(
         * dt
         * gameParameters.CombustionHeatAdjustment;
 
-    // Points that are not burning anymore after this step
-    assert(mStoppedBurningPoints.empty());
+    // Whether some points are not burning anymore after this step
+    bool hasStoppedBurningPoints = false;
 
-    for (auto const pointIndex : mBurningPoints)
+    for (size_t s = 0; s < mBurningPoints.size(); ++s)
     {
-        vec2f const & pointPosition = GetPosition(pointIndex);
+        auto const pointIndex = mBurningPoints[s];
 
-        CombustionState & pointCombustionState = mCombustionStateBuffer[pointIndex];
+        vec2f const & pointPosition = GetPosition(pointIndex);
 
-        assert(pointCombustionState.State != CombustionState::StateType::NotBurning); // Otherwise it wouldn't be in this set
+        assert(mCombustionStateBuffer[pointIndex] != CombustionState::StateType::NotBurning); // Otherwise it wouldn't be in this set
 
         //
         // Check if this point should stop developing/burning or start extinguishing faster
         //
 
-        auto const currentState = pointCombustionState.State;
+        auto const currentState = mCombustionStateBuffer[pointIndex];
 
         if ((currentState == CombustionState::StateType::Developing_1
             || currentState == CombustionState::StateType::Developing_2
@@ -1124,6 +1356,8 @@ void Points::UpdateCombustionHighFrequency(
                 * gameParameters.IgnitionTemperatureAdjustment
                 * 1.1f;
 
+            mHotPoints.Add(pointIndex);
+
             // Neighbors
             for (auto const s : GetConnectedSprings(pointIndex).ConnectedSprings)
             {
@@ -1142,6 +1376,8 @@ void Points::UpdateCombustionHighFrequency(
                     * dirAlpha
                     * mMaterialHeatCapacityReciprocalBuffer[otherEndpointIndex]
                     * mDecayBuffer[otherEndpointIndex];
+
+                mHotPoints.Add(otherEndpointIndex);
             }
         }
 
@@ -1158,7 +1394,7 @@ void Points::UpdateCombustionHighFrequency(
         // Check if this point should emit smoke
         //
 
-        if (pointCombustionState.State != CombustionState::StateType::NotBurning)
+        if (mCombustionStateBuffer[pointIndex] != CombustionState::StateType::NotBurning)
         {
             // See if we need to calculate the next emission timestamp
             if (pointCombustionState.NextSmokeEmissionSimulationTimestamp == 0.0f)
@@ -1196,7 +1432,10 @@ void Points::UpdateCombustionHighFrequency(
         // Run development/extinguishing state machine now
         //
 
-        switch (pointCombustionState.State)
+        float & flameDevelopment = mBurningPointFlameDevelopments[s];
+        float const maxFlameDevelopment = mBurningPointMaxFlameDevelopments[s];
+
+        switch (mCombustionStateBuffer[pointIndex])
         {
             case CombustionState::StateType::Developing_1:
             {
@@ -1207,13 +1446,13 @@ void Points::UpdateCombustionHighFrequency(
                 // http://www.calcul.com/show/calculator/recursive?values=[{%22n%22:0,%22value%22:0.1,%22valid%22:true}]&expression=f(n-1)%20+%200.105*f(n-1)&target=0&endTarget=25&range=true
                 //
 
-                pointCombustionState.FlameDevelopment +=
-                    0.04f * pointCombustionState.FlameDevelopment;
+                flameDevelopment +=
+                    0.04f * flameDevelopment;
 
                 // Check whether it's time to transition to the next development phase
-                if (pointCombustionState.FlameDevelopment > pointCombustionState.MaxFlameDevelopment + 0.1f)
+                if (flameDevelopment > maxFlameDevelopment + 0.1f)
                 {
-                    pointCombustionState.State = CombustionState::StateType::Developing_2;
+                    mCombustionStateBuffer[pointIndex] = CombustionState::StateType::Developing_2;
                 }
 
                 break;
@@ -1226,18 +1465,18 @@ void Points::UpdateCombustionHighFrequency(
                 //
 
                 // FlameDevelopment is now in the (MFD + epsilon, MFD) range
-                auto const extraFlameDevelopment = pointCombustionState.FlameDevelopment - pointCombustionState.MaxFlameDevelopment;
+                auto const extraFlameDevelopment = flameDevelopment - maxFlameDevelopment;
 
                 // Check whether it's time to transition to burning
                 if (extraFlameDevelopment < 0.02f)
                 {
-                    pointCombustionState.State = CombustionState::StateType::Burning;
-                    pointCombustionState.FlameDevelopment = pointCombustionState.MaxFlameDevelopment;
+                    mCombustionStateBuffer[pointIndex] = CombustionState::StateType::Burning;
+                    flameDevelopment = maxFlameDevelopment;
                 }
                 else
                 {
                     // Keep converging to goal
-                    pointCombustionState.FlameDevelopment -= 0.35f * extraFlameDevelopment;
+                    flameDevelopment -= 0.35f * extraFlameDevelopment;
                 }
 
 
@@ -1252,51 +1491,52 @@ void Points::UpdateCombustionHighFrequency(
                 // Un-develop
                 //
 
-                if (pointCombustionState.State == CombustionState::StateType::Extinguishing_Consumed)
+                if (mCombustionStateBuffer[pointIndex] == CombustionState::StateType::Extinguishing_Consumed)
                 {
                     //
                     // f(n-1) - 0.0625*(1.01 - f(n-1)): when starting from 1, after 75 steps (1.5s) it's under 0.02
                     // http://www.calcul.com/show/calculator/recursive?values=[{%22n%22:0,%22value%22:1,%22valid%22:true}]&expression=f(n-1)%20-%200.0625*(1.01%20-%20f(n-1))&target=0&endTarget=80&range=true
                     //
 
-                    pointCombustionState.FlameDevelopment -=
+                    flameDevelopment -=
                         0.0625f
-                        * (pointCombustionState.MaxFlameDevelopment - pointCombustionState.FlameDevelopment + 0.01f);
+                        * (maxFlameDevelopment - flameDevelopment + 0.01f);
                 }
-                else if (pointCombustionState.State == CombustionState::StateType::Extinguishing_SmotheredRain)
+                else if (mCombustionStateBuffer[pointIndex] == CombustionState::StateType::Extinguishing_SmotheredRain)
                 {
                     //
                     // f(n-1) - 0.075*f(n-1): when starting from 1, after 50 steps (1.0s) it's under 0.02
                     // http://www.calcul.com/show/calculator/recursive?values=[{%22n%22:0,%22value%22:1,%22valid%22:true}]&expression=f(n-1)%20-%200.075*f(n-1)&target=0&endTarget=75&range=true
                     //
 
-                    pointCombustionState.FlameDevelopment -=
-                        0.075f * pointCombustionState.FlameDevelopment;
+                    flameDevelopment -=
+                        0.075f * flameDevelopment;
                 }
                 else
                 {
-                    assert(pointCombustionState.State == CombustionState::StateType::Extinguishing_SmotheredWater);
+                    assert(mCombustionStateBuffer[pointIndex] == CombustionState::StateType::Extinguishing_SmotheredWater);
 
                     //
                     // f(n-1) - 0.3*f(n-1): when starting from 1, after 10 steps (0.2s) it's under 0.02
                     // http://www.calcul.com/show/calculator/recursive?values=[{%22n%22:0,%22value%22:1,%22valid%22:true}]&expression=f(n-1)%20-%200.3*f(n-1)&target=0&endTarget=25&range=true
                     //
 
-                    pointCombustionState.FlameDevelopment -=
-                        0.3f * pointCombustionState.FlameDevelopment;
+                    flameDevelopment -=
+                        0.3f * flameDevelopment;
                 }
 
                 // Check whether we are done now
-                if (pointCombustionState.FlameDevelopment <= 0.02f)
+                if (flameDevelopment <= 0.02f)
                 {
                     //
                     // Stop burning
                     //
 
-                    pointCombustionState.State = CombustionState::StateType::NotBurning;
+                    mCombustionStateBuffer[pointIndex] = CombustionState::StateType::NotBurning;
 
                     // Remove point from set of burning points
-                    mStoppedBurningPoints.emplace_back(pointIndex);
+                    mBurningPointSlotBuffer[pointIndex] = NoneElementIndex;
+                    hasStoppedBurningPoints = true;
                 }
 
                 break;
@@ -1310,120 +1550,131 @@ void Points::UpdateCombustionHighFrequency(
                 break;
             }
         }
+    }
 
-        //
-        // Calculate flame vector
-        //
-        // Note: the point might not be burning anymore, in case we've just extinguished it
-        //
-
-        // Vector Q is the vector describing the ideal, final flame's
-        // direction and length
-        vec2f const & pointVelocity = GetVelocity(pointIndex);
-        vec2f const Q = CalculateIdealFlameVector(
-            pointVelocity,
-            100.0f); // Particle's velocity has a larger impact on the final vector
+    //
+    // Calculate flame vectors and flame wind rotation angles, in batch
+    //
+    // Note: some points might not be burning anymore, in case we've just extinguished them
+    //
 
-        // Inertia: converge current flame vector towards target vector Q
-        //
-        // Convergence rate inversely depends on the magnitude of change:
-        // - A big change: little rate (lots of inertia)
-        // - A small change: big rate (immediately responsive)
-        float constexpr MinFlameVectorConvergenceRate = 0.02f;
-        float constexpr MaxFlameVectorConvergenceRate = 0.05f;
-        float const flameVectorChangeMagnitude = std::abs(Q.angleCw(pointCombustionState.FlameVector));
-        float const flameVectorConvergenceRate =
-            MinFlameVectorConvergenceRate
-            + (MaxFlameVectorConvergenceRate - MinFlameVectorConvergenceRate) * (1.0f - LinearStep(0.0f, Pi<float>, flameVectorChangeMagnitude));
-
-        pointCombustionState.FlameVector +=
-            (Q - pointCombustionState.FlameVector)
-            * flameVectorConvergenceRate;
+    UpdateFlames(wind);
 
-        //
-        // Calculate flame wind rotation angle
-        //
-        // The wind rotation angle has three components:
-        //  - Global wind
-        //  - Interactive wind (i.e. the WindMaker), if any
-        //  - Particle's velocity
-        //
-        // We simulate inertia by converging slowly to the target angle.
-        //
-
-        vec2f resultantWindSpeedVector =
-            globalWindSpeed
-            - pointVelocity;
+    //
+    // Remove points that have stopped burning, compacting the burning points
+    // while preserving their order
+    //
 
-        if (windField.has_value())
+    if (hasStoppedBurningPoints)
+    {
+        size_t burningPointCount = 0;
+        for (size_t s = 0; s < mBurningPoints.size(); ++s)
         {
-            vec2f const displacement = pointPosition - windField->FieldCenterPos;
-            float const radius = displacement.length();
-            if (radius < windField->FieldRadius)
+            auto const pointIndex = mBurningPoints[s];
+            if (mBurningPointSlotBuffer[pointIndex] != NoneElementIndex)
             {
-                resultantWindSpeedVector +=
-                    displacement.normalise(radius)
-                    * windField->WindSpeed;
+                mBurningPoints[burningPointCount] = pointIndex;
+                mBurningPointFlameDevelopments[burningPointCount] = mBurningPointFlameDevelopments[s];
+                mBurningPointMaxFlameDevelopments[burningPointCount] = mBurningPointMaxFlameDevelopments[s];
+                mBurningPointFlameVectors[burningPointCount] = mBurningPointFlameVectors[s];
+                mBurningPointFlameWindRotationAngles[burningPointCount] = mBurningPointFlameWindRotationAngles[s];
+
+                mBurningPointSlotBuffer[pointIndex] = static_cast<ElementIndex>(burningPointCount);
+
+                ++burningPointCount;
             }
         }
 
-        // Projection of wind speed vector along flame
-        vec2f const flameDir = pointCombustionState.FlameVector.normalise();
-        float const windSpeedMagnitudeAlongFlame = resultantWindSpeedVector.dot(flameDir);
-
-        // Our angle moves opposite to the projection of wind along the flame:
-        //  - Wind aligned with flame: proj=|W|, angle = 0
-        //  - Wind perpendicular to flame: proj=|0|, angle = +/-MAX/2
-        //  - Wind against flame: proj=-|W|, angle = +/-MAX
-        float const targetFlameWindRotationAngle =
-            0.45f
-            * LinearStep(0.0f, 100.0f, resultantWindSpeedVector.length() - windSpeedMagnitudeAlongFlame)
-            * (resultantWindSpeedVector.cross(flameDir) > 0.0f ? -1.0f : 1.0f); // The sign of the angle is positive (CW) when the wind vector is to the right of the flame vector
-
-        // Converge
-        float constexpr FlameWindRotationAngleConvergenceRate = 0.055f;
-        pointCombustionState.FlameWindRotationAngle +=
-            (targetFlameWindRotationAngle - pointCombustionState.FlameWindRotationAngle)
-            * FlameWindRotationAngleConvergenceRate;
+        mBurningPoints.resize(burningPointCount);
+        mBurningPointFlameDevelopments.resize(burningPointCount);
+        mBurningPointMaxFlameDevelopments.resize(burningPointCount);
+        mBurningPointFlameVectors.resize(burningPointCount);
+        mBurningPointFlameWindRotationAngles.resize(burningPointCount);
+    }
+}
+
+void Points::ReorderBurningPointsForDepth()
+{
+    // Sort the slots of the burning points, and then permute the
+    // burning points and their flames accordingly
+
+    auto const isSlotLess = [this](auto s1, auto s2)
+    {
+        auto const p1 = mBurningPoints[s1];
+        auto const p2 = mBurningPoints[s2];
+
+        // Sort by plane and then by vertical position, so bottommost flames cover uppermost ones
+        return mPlaneIdBuffer[p1] < mPlaneIdBuffer[p2]
+            || (mPlaneIdBuffer[p1] == mPlaneIdBuffer[p2] && mPositionBuffer[p1].y > mPositionBuffer[p2].y);
+    };
+
+    // The order is still that of the previous reorder with a few new points
+    // inserted in place, and plane IDs and vertical positions rarely swap
+    // between two connectivity visits - so most times there's nothing to do,
+    // and else only a few slots are out of place
+    size_t outOfOrderSlotCount = 0;
+    for (ElementIndex s = 1; s < mBurningPoints.size(); ++s)
+    {
+        if (isSlotLess(s, s - 1))
+            ++outOfOrderSlotCount;
     }
 
-    //
-    // Remove points that have stopped burning
-    //
+    if (outOfOrderSlotCount == 0)
+        return;
 
-    if (!mStoppedBurningPoints.empty())
+    std::vector<ElementIndex> sortedSlots(mBurningPoints.size());
+    std::iota(sortedSlots.begin(), sortedSlots.end(), ElementIndex(0));
+
+    if (outOfOrderSlotCount <= MaxOutOfOrderSlotsForInsertionSort)
     {
-        for (auto stoppedBurningPoint : mStoppedBurningPoints)
+        // Nearly sorted: an insertion sort is linear here
+        for (size_t i = 1; i < sortedSlots.size(); ++i)
         {
-            auto burningPointIt = std::find(
-                mBurningPoints.cbegin(),
-                mBurningPoints.cend(),
-                stoppedBurningPoint);
-            assert(burningPointIt != mBurningPoints.cend());
-            mBurningPoints.erase(burningPointIt);
-        }
+            auto const slot = sortedSlots[i];
+            size_t j = i;
+            for (; j > 0 && isSlotLess(slot, sortedSlots[j - 1]); --j)
+            {
+                sortedSlots[j] = sortedSlots[j - 1];
+            }
 
-        mStoppedBurningPoints.clear();
+            sortedSlots[j] = slot;
+        }
+    }
+    else
+    {
+        std::sort(
+            sortedSlots.begin(),
+            sortedSlots.end(),
+            isSlotLess);
     }
-}
 
-void Points::ReorderBurningPointsForDepth()
-{
-    std::sort(
-        mBurningPoints.begin(),
-        mBurningPoints.end(),
-        [this](auto p1, auto p2)
+    auto const permute = [&sortedSlots](auto & values)
+    {
+        std::remove_reference_t<decltype(values)> permutedValues;
+        permutedValues.reserve(values.size());
+        for (auto const s : sortedSlots)
         {
-            // Sort by plane and then by vertical position, so bottommost flames cover uppermost ones
-            return mPlaneIdBuffer[p1] < mPlaneIdBuffer[p2]
-                || (mPlaneIdBuffer[p1] == mPlaneIdBuffer[p2] && mPositionBuffer[p1].y > mPositionBuffer[p2].y);
-        });
+            permutedValues.push_back(values[s]);
+        }
+
+        values.swap(permutedValues);
+    };
+
+    permute(mBurningPoints);
+    permute(mBurningPointFlameDevelopments);
+    permute(mBurningPointMaxFlameDevelopments);
+    permute(mBurningPointFlameVectors);
+    permute(mBurningPointFlameWindRotationAngles);
+
+    RenumberBurningPointSlots(0);
 }
 
 void Points::UpdateEphemeralParticles(
     float currentSimulationTime,
     GameParameters const & gameParameters)
 {
+    FS_PROFILE_SCOPE("Points::UpdateEphemeralParticles");
+
     // Transformation from desired velocity impulse to force
     float const randomWalkVelocityImpulseToForceCoefficient =
         GameParameters::AirMass
@@ -1463,7 +1714,7 @@ void Points::UpdateEphemeralParticles(
                             // Update state
                             //
 
-                            auto & state = mEphemeralParticleAttributes2Buffer[pointIndex].State.AirBubble;
+                            auto & state = mEphemeralParticleAttributes2Buffer[ToEphemeralSlot(pointIndex)].State.AirBubble;
 
                             // DeltaY
 
@@ -1473,7 +1724,7 @@ void Points::UpdateEphemeralParticles(
 
                             auto const simulationLifetime =
                                 currentSimulationTime
-                                - mEphemeralParticleAttributes1Buffer[pointIndex].StartSimulationTime;
+                                - mEphemeralParticleAttributes1Buffer[ToEphemeralSlot(pointIndex)].StartSimulationTime;
 
                             state.SimulationLifetime = simulationLifetime;
 
@@ -1514,8 +1765,8 @@ void Points::UpdateEphemeralParticles(
                 case EphemeralType::Debris:
                 {
                     // Check if expired
-                    auto const elapsedSimulationLifetime = currentSimulationTime - mEphemeralParticleAttributes1Buffer[pointIndex].StartSimulationTime;
-                    auto const maxSimulationLifetime = mEphemeralParticleAttributes2Buffer[pointIndex].MaxSimulationLifetime;
+                    auto const elapsedSimulationLifetime = currentSimulationTime - mEphemeralParticleAttributes1Buffer[ToEphemeralSlot(pointIndex)].StartSimulationTime;
+                    auto const maxSimulationLifetime = mEphemeralParticleAttributes2Buffer[ToEphemeralSlot(pointIndex)].MaxSimulationLifetime;
                     if (elapsedSimulationLifetime >= maxSimulationLifetime)
                     {
                         ExpireEphemeralParticle(pointIndex);
@@ -1541,11 +1792,11 @@ void Points::UpdateEphemeralParticles(
                 case EphemeralType::Smoke:
                 {
                     // Calculate progress
-                    auto const elapsedSimulationLifetime = currentSimulationTime - mEphemeralParticleAttributes1Buffer[pointIndex].StartSimulationTime;
-                    assert(mEphemeralParticleAttributes2Buffer[pointIndex].MaxSimulationLifetime > 0.0f);
+                    auto const elapsedSimulationLifetime = currentSimulationTime - mEphemeralParticleAttributes1Buffer[ToEphemeralSlot(pointIndex)].StartSimulationTime;
+                    assert(mEphemeralParticleAttributes2Buffer[ToEphemeralSlot(pointIndex)].MaxSimulationLifetime > 0.0f);
                     float const lifetimeProgress =
                         elapsedSimulationLifetime
-                        / mEphemeralParticleAttributes2Buffer[pointIndex].MaxSimulationLifetime;
+                        / mEphemeralParticleAttributes2Buffer[ToEphemeralSlot(pointIndex)].MaxSimulationLifetime;
 
                     // Check if expired
                     if (lifetimeProgress >= 1.0f
@@ -1564,16 +1815,16 @@ void Points::UpdateEphemeralParticles(
                         //
 
                         // Update progress
-                        mEphemeralParticleAttributes2Buffer[pointIndex].State.Smoke.LifetimeProgress = lifetimeProgress;
-                        if (EphemeralState::SmokeState::GrowthType::Slow == mEphemeralParticleAttributes2Buffer[pointIndex].State.Smoke.Growth)
+                        mEphemeralParticleAttributes2Buffer[ToEphemeralSlot(pointIndex)].State.Smoke.LifetimeProgress = lifetimeProgress;
+                        if (EphemeralState::SmokeState::GrowthType::Slow == mEphemeralParticleAttributes2Buffer[ToEphemeralSlot(pointIndex)].State.Smoke.Growth)
                         {
-                            mEphemeralParticleAttributes2Buffer[pointIndex].State.Smoke.ScaleProgress =
+                            mEphemeralParticleAttributes2Buffer[ToEphemeralSlot(pointIndex)].State.Smoke.ScaleProgress =
                                 std::min(1.0f, elapsedSimulationLifetime / 5.0f);
                         }
                         else
                         {
-                            assert(EphemeralState::SmokeState::GrowthType::Fast == mEphemeralParticleAttributes2Buffer[pointIndex].State.Smoke.Growth);
-                            mEphemeralParticleAttributes2Buffer[pointIndex].State.Smoke.ScaleProgress =
+                            assert(EphemeralState::SmokeState::GrowthType::Fast == mEphemeralParticleAttributes2Buffer[ToEphemeralSlot(pointIndex)].State.Smoke.Growth);
+                            mEphemeralParticleAttributes2Buffer[ToEphemeralSlot(pointIndex)].State.Smoke.ScaleProgress =
                                 1.07f * (1.0f - exp(-3.0f * lifetimeProgress));
                         }
 
@@ -1593,8 +1844,8 @@ void Points::UpdateEphemeralParticles(
                 case EphemeralType::Sparkle:
                 {
                     // Check if expired
-                    auto const elapsedSimulationLifetime = currentSimulationTime - mEphemeralParticleAttributes1Buffer[pointIndex].StartSimulationTime;
-                    auto const maxSimulationLifetime = mEphemeralParticleAttributes2Buffer[pointIndex].MaxSimulationLifetime;
+                    auto const elapsedSimulationLifetime = currentSimulationTime - mEphemeralParticleAttributes1Buffer[ToEphemeralSlot(pointIndex)].StartSimulationTime;
+                    auto const maxSimulationLifetime = mEphemeralParticleAttributes2Buffer[ToEphemeralSlot(pointIndex)].MaxSimulationLifetime;
                     if (elapsedSimulationLifetime >= maxSimulationLifetime
                         || IsCachedUnderwater(pointIndex))
                     {
@@ -1604,7 +1855,7 @@ void Points::UpdateEphemeralParticles(
                     {
                         // Update progress based off remaining time
                         assert(maxSimulationLifetime > 0.0f);
-                        mEphemeralParticleAttributes2Buffer[pointIndex].State.Sparkle.Progress =
+                        mEphemeralParticleAttributes2Buffer[ToEphemeralSlot(pointIndex)].State.Sparkle.Progress =
                             elapsedSimulationLifetime / maxSimulationLifetime;
                     }
 
@@ -1614,8 +1865,8 @@ void Points::UpdateEphemeralParticles(
                 case EphemeralType::WakeBubble:
                 {
                     // Check if expired
-                    auto const elapsedSimulationLifetime = currentSimulationTime - mEphemeralParticleAttributes1Buffer[pointIndex].StartSimulationTime;
-                    auto const maxSimulationLifetime = mEphemeralParticleAttributes2Buffer[pointIndex].MaxSimulationLifetime;
+                    auto const elapsedSimulationLifetime = currentSimulationTime - mEphemeralParticleAttributes1Buffer[ToEphemeralSlot(pointIndex)].StartSimulationTime;
+                    auto const maxSimulationLifetime = mEphemeralParticleAttributes2Buffer[ToEphemeralSlot(pointIndex)].MaxSimulationLifetime;
                     if (elapsedSimulationLifetime >= maxSimulationLifetime
                         || !IsCachedUnderwater(pointIndex))
                     {
@@ -1625,7 +1876,7 @@ void Points::UpdateEphemeralParticles(
                     {
                         // Update progress based off remaining time
                         assert(maxSimulationLifetime > 0.0f);
-                        mEphemeralParticleAttributes2Buffer[pointIndex].State.WakeBubble.Progress =
+                        mEphemeralParticleAttributes2Buffer[ToEphemeralSlot(pointIndex)].State.WakeBubble.Progress =
                             elapsedSimulationLifetime / maxSimulationLifetime;
                     }
 
@@ -1703,6 +1954,60 @@ void Points::Query(ElementIndex pointElementIndex) const
     LogMessage("PlaneID: ", mPlaneIdBuffer[pointElementIndex], " ConnectedComponentID: ", mConnectedComponentIdBuffer[pointElementIndex]);
 }
 
+std::vector<ElementIndex> const & Points::QueryPointsInBox(
+    Geometry::AABB const & box,
+    bool doIncludeEphemeralPoints) const
+{
+    PrepareSpatialIndex();
+
+    QueryPointsInBox(box, doIncludeEphemeralPoints, mSpatialQueryResult);
+
+    return mSpatialQueryResult;
+}
+
+void Points::QueryPointsInBox(
+    Geometry::AABB const & box,
+    bool doIncludeEphemeralPoints,
+    std::vector<ElementIndex> & pointIndices) const
+{
+    assert(!mIsSpatialIndexDirty);
+
+    mSpatialIndex.Query(box, pointIndices);
+
+    if (!doIncludeEphemeralPoints)
+    {
+        // Results are sorted, hence ship points come first
+        pointIndices.erase(
+            std::lower_bound(pointIndices.begin(), pointIndices.end(), mRawShipPointCount),
+            pointIndices.end());
+    }
+}
+
+ElementIndex Points::FindNearestActivePointInRadius(
+    vec2f const & position,
+    float radius) const
+{
+    float const squareRadius = radius * radius;
+
+    ElementIndex bestPointIndex = NoneElementIndex;
+    float bestSquareDistance = std::numeric_limits<float>::max();
+
+    for (auto const pointIndex : QueryPointsInRadius(position, radius, true))
+    {
+        if (IsActive(pointIndex))
+        {
+            float const squareDistance = (GetPosition(pointIndex) - position).squareLength();
+            if (squareDistance < squareRadius && squareDistance < bestSquareDistance)
+            {
+                bestPointIndex = pointIndex;
+                bestSquareDistance = squareDistance;
+            }
+        }
+    }
+
+    return bestPointIndex;
+}
+
 void Points::ColorPointForDebugging(
     ElementIndex pointIndex,
     rgbaColor const & color)
@@ -1730,7 +2035,7 @@ void Points::UploadAttributes(
     {
         renderContext.UploadShipPointColorsAsync(
             shipId,
-            mColorBuffer.data(),
+            mVec4fUploadSnapshotAllocator.AllocateSnapshot(mColorBuffer.data(), 0, mAllPointCount),
             0,
             mAllPointCount);
 
@@ -1742,7 +2047,7 @@ void Points::UploadAttributes(
         // Only upload ephemeral particle portion
         renderContext.UploadShipPointColorsAsync(
             shipId,
-            &(mColorBuffer.data()[mAlignedShipPointCount]),
+            mVec4fUploadSnapshotAllocator.AllocateSnapshot(mColorBuffer.data(), mAlignedShipPointCount, mEphemeralPointCount),
             mAlignedShipPointCount,
             mEphemeralPointCount);
 
@@ -1755,46 +2060,51 @@ void Points::UploadAttributes(
 
     shipRenderContext.UploadPointMutableAttributesStart();
 
-    shipRenderContext.UploadPointMutableAttributes(
-        mPositionBuffer.data(),
-        mLightBuffer.data(),
-        mWaterBuffer.data());
-
-    if (mIsPlaneIdBufferNonEphemeralDirty)
+    if (!shipRenderContext.ArePointMutableAttributesUploaded())
     {
-        if (mIsPlaneIdBufferEphemeralDirty)
-        {
-            // Whole
+        shipRenderContext.UploadPointMutableAttributes(
+            GetRenderPositions(renderContext),
+            mLightBuffer.data(),
+            mWaterBuffer.data());
+    }
 
-            shipRenderContext.UploadPointMutableAttributesPlaneId(
-                mPlaneIdFloatBuffer.data(),
-                0,
-                mAllPointCount);
+    // Plane IDs and decay change sparingly, hence we only upload the
+    // ranges that have changed since the last upload
 
-            mIsPlaneIdBufferEphemeralDirty = false;
-        }
-        else
-        {
-            // Just non-ephemeral portion
+    if (!mPlaneIdBufferNonEphemeralDirtyRange.IsEmpty())
+    {
+        ElementIndex const start = mPlaneIdBufferNonEphemeralDirtyRange.GetStart();
 
-            shipRenderContext.UploadPointMutableAttributesPlaneId(
-                mPlaneIdFloatBuffer.data(),
-                0,
-                mRawShipPointCount);
-        }
+        shipRenderContext.UploadPointMutableAttributesPlaneId(
+            &(mPlaneIdFloatBuffer.data()[start]),
+            start,
+            mPlaneIdBufferNonEphemeralDirtyRange.GetSize());
 
-        mIsPlaneIdBufferNonEphemeralDirty = false;
+        mPlaneIdBufferNonEphemeralDirtyRange.Clear();
     }
-    else if (mIsPlaneIdBufferEphemeralDirty)
+
+    if (!mPlaneIdBufferEphemeralDirtyRange.IsEmpty())
     {
-        // Just ephemeral portion
+        ElementIndex const start = mPlaneIdBufferEphemeralDirtyRange.GetStart();
 
         shipRenderContext.UploadPointMutableAttributesPlaneId(
-            &(mPlaneIdFloatBuffer.data()[mAlignedShipPointCount]),
-            mAlignedShipPointCount,
-            mEphemeralPointCount);
+            &(mPlaneIdFloatBuffer.data()[start]),
+            start,
+            mPlaneIdBufferEphemeralDirtyRange.GetSize());
 
-        mIsPlaneIdBufferEphemeralDirty = false;
+        mPlaneIdBufferEphemeralDirtyRange.Clear();
+    }
+
+    if (!mDecayBufferDirtyRange.IsEmpty())
+    {
+        ElementIndex const start = mDecayBufferDirtyRange.GetStart();
+
+        shipRenderContext.UploadPointMutableAttributesDecay(
+            &(mDecayBuffer.data()[start]),
+            start,
+            mDecayBufferDirtyRange.GetSize());
+
+        mDecayBufferDirtyRange.Clear();
     }
 
     // The following attributes never change for ephemeral particles,
@@ -1803,21 +2113,11 @@ void Points::UploadAttributes(
     // not for the ephemeral ones
     size_t const partialPointCount = mHaveWholeBuffersBeenUploadedOnce ? mRawShipPointCount : mAllPointCount;
 
-    if (mIsDecayBufferDirty)
-    {
-        shipRenderContext.UploadPointMutableAttributesDecay(
-            mDecayBuffer.data(),
-            0,
-            partialPointCount);
-
-        mIsDecayBufferDirty = false;
-    }
-
     if (renderContext.GetHeatRenderMode() != HeatRenderModeType::None)
     {
         renderContext.UploadShipPointTemperatureAsync(
             shipId,
-            mTemperatureBuffer.data(),
+            mFloatUploadSnapshotAllocator.AllocateSnapshot(mTemperatureBuffer.data(), 0, partialPointCount),
             0,
             partialPointCount);
     }
@@ -1826,7 +2126,7 @@ void Points::UploadAttributes(
     {
         renderContext.UploadShipPointStressAsync(
             shipId,
-            mStressBuffer.data(),
+            mFloatUploadSnapshotAllocator.AllocateSnapshot(mStressBuffer.data(), 0, partialPointCount),
             0,
             partialPointCount);
     }
@@ -1835,7 +2135,7 @@ void Points::UploadAttributes(
     {
         renderContext.UploadShipPointAuxiliaryDataAsync(
             shipId,
-            mInternalPressureBuffer.data(),
+            mFloatUploadSnapshotAllocator.AllocateSnapshot(mInternalPressureBuffer.data(), 0, partialPointCount),
             0,
             partialPointCount);
     }
@@ -1843,7 +2143,7 @@ void Points::UploadAttributes(
     {
         renderContext.UploadShipPointAuxiliaryDataAsync(
             shipId,
-            mStrengthBuffer.data(),
+            mFloatUploadSnapshotAllocator.AllocateSnapshot(mStrengthBuffer.data(), 0, partialPointCount),
             0,
             partialPointCount);
     }
@@ -1853,6 +2153,40 @@ void Points::UploadAttributes(
     mHaveWholeBuffersBeenUploadedOnce = true;
 }
 
+void Points::UploadMutableAttributes(
+    ShipId shipId,
+    Render::RenderContext & renderContext) const
+{
+    renderContext.GetShipRenderContext(shipId).UploadPointMutableAttributes(
+        GetRenderPositions(renderContext),
+        mLightBuffer.data(),
+        mWaterBuffer.data());
+}
+
+vec2f const * Points::GetRenderPositions(Render::RenderContext const & renderContext) const
+{
+    float const interpolationFactor = renderContext.GetPointPositionInterpolationFactor();
+    if (interpolationFactor >= 1.0f)
+    {
+        // Render the current positions
+        return mPositionBuffer.data();
+    }
+
+    vec2f const * restrict const previousPositionBuffer = mPreviousPositionBuffer.data();
+    vec2f const * restrict const positionBuffer = mPositionBuffer.data();
+    vec2f * restrict const interpolatedPositionBuffer = mInterpolatedPositionBuffer.data();
+
+    size_t const count = GetBufferElementCount();
+    for (size_t p = 0; p < count; ++p)
+    {
+        interpolatedPositionBuffer[p] =
+            previousPositionBuffer[p]
+            + (positionBuffer[p] - previousPositionBuffer[p]) * interpolationFactor;
+    }
+
+    return interpolatedPositionBuffer;
+}
+
 void Points::UploadNonEphemeralPointElements(
     ShipId shipId,
     Render::RenderContext & renderContext) const
@@ -1890,31 +2224,33 @@ void Points::UploadFlames(
     shipRenderContext.UploadFlamesStart(mBurningPoints.size());
 
     // Background
-    for (auto const pointIndex : mBurningPoints)
+    for (size_t s = 0; s < mBurningPoints.size(); ++s)
     {
+        auto const pointIndex = mBurningPoints[s];
         if (mFactoryConnectedTrianglesBuffer[pointIndex].ConnectedTriangles.empty())
         {
             shipRenderContext.UploadBackgroundFlame(
                 GetPlaneId(pointIndex),
                 GetPosition(pointIndex),
-                mCombustionStateBuffer[pointIndex].FlameVector,
-                mCombustionStateBuffer[pointIndex].FlameWindRotationAngle,
-                mCombustionStateBuffer[pointIndex].FlameDevelopment, // scale
+                mBurningPointFlameVectors[s],
+                mBurningPointFlameWindRotationAngles[s],
+                mBurningPointFlameDevelopments[s], // scale
                 mRandomNormalizedUniformFloatBuffer[pointIndex]);
         }
     }
 
     // Foreground
-    for (auto const pointIndex : mBurningPoints)
+    for (size_t s = 0; s < mBurningPoints.size(); ++s)
     {
+        auto const pointIndex = mBurningPoints[s];
         if (!mFactoryConnectedTrianglesBuffer[pointIndex].ConnectedTriangles.empty())
         {
             shipRenderContext.UploadForegroundFlame(
                 GetPlaneId(pointIndex),
                 GetPosition(pointIndex),
-                mCombustionStateBuffer[pointIndex].FlameVector,
-                mCombustionStateBuffer[pointIndex].FlameWindRotationAngle,
-                mCombustionStateBuffer[pointIndex].FlameDevelopment, // scale
+                mBurningPointFlameVectors[s],
+                mBurningPointFlameWindRotationAngles[s],
+                mBurningPointFlameDevelopments[s], // scale
                 mRandomNormalizedUniformFloatBuffer[pointIndex]);
         }
     }
@@ -1981,6 +2317,8 @@ void Points::UploadVectors(
 
         case VectorFieldRenderModeType::None:
         {
+            // Not invoked when there are no vectors to show
+            assert(false);
             return;
         }
     }
@@ -2032,7 +2370,7 @@ void Points::UploadEphemeralParticles(
         {
             case EphemeralType::AirBubble:
             {
-                auto const & state = mEphemeralParticleAttributes2Buffer[pointIndex].State.AirBubble;
+                auto const & state = mEphemeralParticleAttributes2Buffer[ToEphemeralSlot(pointIndex)].State.AirBubble;
 
                 // Calculate scale based on lifetime
                 float constexpr ScaleMax = 0.275f;
@@ -2062,7 +2400,7 @@ void Points::UploadEphemeralParticles(
 
             case EphemeralType::Smoke:
             {
-                auto const & state = mEphemeralParticleAttributes2Buffer[pointIndex].State.Smoke;
+                auto const & state = mEphemeralParticleAttributes2Buffer[ToEphemeralSlot(pointIndex)].State.Smoke;
 
                 // Calculate scale
                 float const scale = state.ScaleProgress;
@@ -2091,14 +2429,14 @@ void Points::UploadEphemeralParticles(
                     GetPlaneId(pointIndex),
                     GetPosition(pointIndex),
                     GetVelocity(pointIndex),
-                    mEphemeralParticleAttributes2Buffer[pointIndex].State.Sparkle.Progress);
+                    mEphemeralParticleAttributes2Buffer[ToEphemeralSlot(pointIndex)].State.Sparkle.Progress);
 
                 break;
             }
 
             case EphemeralType::WakeBubble:
             {
-                auto const & state = mEphemeralParticleAttributes2Buffer[pointIndex].State.WakeBubble;
+                auto const & state = mEphemeralParticleAttributes2Buffer[ToEphemeralSlot(pointIndex)].State.WakeBubble;
 
                 shipRenderContext.UploadGenericMipMappedTextureRenderSpecification(
                     GetPlaneId(pointIndex),
@@ -2178,6 +2516,8 @@ void Points::AugmentMaterialMass(
 
 void Points::UpdateMasses(GameParameters const & gameParameters)
 {
+    FS_PROFILE_SCOPE("Points::UpdateMasses");
+
     //
     // Update:
     //  - Current mass: augmented material mass + point's water mass, slowly converging to avoid discontinuities
@@ -2216,6 +2556,23 @@ void Points::UpdateMasses(GameParameters const & gameParameters)
 
 //////////////////////////////////////////////////////////////////////////////////////////////////
 
+std::array<EphemeralParticleBudget<Points::EphemeralTypeCount>::TypeBudget, Points::EphemeralTypeCount> Points::MakeEphemeralParticleTypeBudgets()
+{
+    using TypeBudget = EphemeralParticleBudget<EphemeralTypeCount>::TypeBudget;
+
+    std::array<TypeBudget, EphemeralTypeCount> typeBudgets;
+
+    // Bubbles only use free slots, the others may replace older particles; smoke
+    // - which is the most abundant and the least noticeable - only replaces smoke
+    typeBudgets[static_cast<size_t>(EphemeralType::AirBubble)] = TypeBudget(0.4f, 1, false);
+    typeBudgets[static_cast<size_t>(EphemeralType::Debris)] = TypeBudget(0.3f, 3, true);
+    typeBudgets[static_cast<size_t>(EphemeralType::Smoke)] = TypeBudget(0.4f, 0, true);
+    typeBudgets[static_cast<size_t>(EphemeralType::Sparkle)] = TypeBudget(0.3f, 2, true);
+    typeBudgets[static_cast<size_t>(EphemeralType::WakeBubble)] = TypeBudget(0.3f, 1, false);
+
+    return typeBudgets;
+}
+
 void Points::CalculateCombustionDecayParameters(
     float combustionSpeedAdjustment,
     float dt)
@@ -2298,75 +2655,362 @@ vec2f Points::CalculateIdealFlameVector(
     return Q;
 }
 
-ElementIndex Points::FindFreeEphemeralParticle(
-    float currentSimulationTime,
-    bool doForce)
+void Points::AddBurningPoint(
+    ElementIndex pointElementIndex,
+    float flameDevelopment,
+    float maxFlameDevelopment,
+    vec2f const & flameVector)
+{
+    assert(mBurningPointSlotBuffer[pointElementIndex] == NoneElementIndex);
+
+    // Find slot, keeping burning points sorted by depth
+    auto const slot = static_cast<size_t>(std::distance(
+        mBurningPoints.cbegin(),
+        std::lower_bound( // Earlier than others at same plane ID, so it's drawn behind them
+            mBurningPoints.cbegin(),
+            mBurningPoints.cend(),
+            pointElementIndex,
+            [this](auto p1, auto p2)
+            {
+                // Sort by plane and then by vertical position, so bottommost flames cover uppermost ones
+                return mPlaneIdBuffer[p1] < mPlaneIdBuffer[p2]
+                    || (mPlaneIdBuffer[p1] == mPlaneIdBuffer[p2] && mPositionBuffer[p1].y > mPositionBuffer[p2].y);
+            })));
+
+    mBurningPoints.insert(mBurningPoints.cbegin() + slot, pointElementIndex);
+    mBurningPointFlameDevelopments.insert(mBurningPointFlameDevelopments.cbegin() + slot, flameDevelopment);
+    mBurningPointMaxFlameDevelopments.insert(mBurningPointMaxFlameDevelopments.cbegin() + slot, maxFlameDevelopment);
+    mBurningPointFlameVectors.insert(mBurningPointFlameVectors.cbegin() + slot, flameVector);
+    mBurningPointFlameWindRotationAngles.insert(mBurningPointFlameWindRotationAngles.cbegin() + slot, 0.0f);
+
+    RenumberBurningPointSlots(slot);
+}
+
+void Points::RemoveBurningPoint(ElementIndex pointElementIndex)
+{
+    size_t const slot = mBurningPointSlotBuffer[pointElementIndex];
+    assert(slot < mBurningPoints.size());
+
+    mBurningPoints.erase(mBurningPoints.cbegin() + slot);
+    mBurningPointFlameDevelopments.erase(mBurningPointFlameDevelopments.cbegin() + slot);
+    mBurningPointMaxFlameDevelopments.erase(mBurningPointMaxFlameDevelopments.cbegin() + slot);
+    mBurningPointFlameVectors.erase(mBurningPointFlameVectors.cbegin() + slot);
+    mBurningPointFlameWindRotationAngles.erase(mBurningPointFlameWindRotationAngles.cbegin() + slot);
+
+    mBurningPointSlotBuffer[pointElementIndex] = NoneElementIndex;
+
+    RenumberBurningPointSlots(slot);
+}
+
+void Points::UpdateFlames(Wind const & wind)
 {
     //
-    // Search for the firt free ephemeral particle; if a free one is not found, reuse the
-    // oldest particle
+    // Visit all burning points in their dense order; besides the (gathered)
+    // position and velocity of each point, this only touches the contiguous
+    // flame arrays
     //
 
-    ElementIndex oldestParticle = NoneElementIndex;
-    float oldestParticleLifetime = 0.0f;
+    size_t const burningPointCount = mBurningPoints.size();
 
-    assert(mFreeEphemeralParticleSearchStartIndex >= mAlignedShipPointCount
-        && mFreeEphemeralParticleSearchStartIndex < mAllPointCount);
+    ElementIndex const * restrict const burningPoints = mBurningPoints.data();
+    vec2f const * restrict const positionBuffer = mPositionBuffer.data();
+    vec2f const * restrict const velocityBuffer = mVelocityBuffer.data();
+    vec2f * restrict const flameVectors = mBurningPointFlameVectors.data();
+    float * restrict const flameWindRotationAngles = mBurningPointFlameWindRotationAngles.data();
 
-    for (ElementIndex p = mFreeEphemeralParticleSearchStartIndex; ; /*incremented in loop*/)
-    {
-        if (EphemeralType::None == mEphemeralParticleAttributes1Buffer[p].Type)
-        {
-            // Found!
+    // Inertia: converge current flame vector towards target vector Q
+    //
+    // Convergence rate inversely depends on the magnitude of change:
+    // - A big change: little rate (lots of inertia)
+    // - A small change: big rate (immediately responsive)
+    float constexpr MinFlameVectorConvergenceRate = 0.02f;
+    float constexpr MaxFlameVectorConvergenceRate = 0.05f;
 
-            // Remember to start after this one next time
-            mFreeEphemeralParticleSearchStartIndex = p + 1;
-            if (mFreeEphemeralParticleSearchStartIndex >= mAllPointCount)
-                mFreeEphemeralParticleSearchStartIndex = mAlignedShipPointCount;
+    float constexpr FlameWindRotationAngleConvergenceRate = 0.055f;
 
-            return p;
-        }
+    // Flames are visited in batches, so that the flame directions of a batch
+    // may be calculated together, with the batched math
+    size_t constexpr FlameBatchSize = 64;
+    vec2f flameDirs[FlameBatchSize];
+
+    for (size_t batchStart = 0; batchStart < burningPointCount; batchStart += FlameBatchSize)
+    {
+        size_t const batchEnd = std::min(batchStart + FlameBatchSize, burningPointCount);
 
-        // Check whether it's the oldest
-        auto const lifetime = currentSimulationTime - mEphemeralParticleAttributes1Buffer[p].StartSimulationTime;
-        if (lifetime >= oldestParticleLifetime)
+        for (size_t s = batchStart; s < batchEnd; ++s)
         {
-            oldestParticle = p;
-            oldestParticleLifetime = lifetime;
+            // Vector Q is the vector describing the ideal, final flame's
+            // direction and length
+            vec2f const Q = CalculateIdealFlameVector(
+                velocityBuffer[burningPoints[s]],
+                100.0f); // Particle's velocity has a larger impact on the final vector
+
+            // Converge current flame vector towards target vector Q
+            float const flameVectorChangeMagnitude = std::abs(Q.angleCw(flameVectors[s]));
+            float const flameVectorConvergenceRate =
+                MinFlameVectorConvergenceRate
+                + (MaxFlameVectorConvergenceRate - MinFlameVectorConvergenceRate) * (1.0f - LinearStep(0.0f, Pi<float>, flameVectorChangeMagnitude));
+
+            flameVectors[s] +=
+                (Q - flameVectors[s])
+                * flameVectorConvergenceRate;
         }
 
-        // Advance
-        ++p;
-        if (p >= mAllPointCount)
-            p = mAlignedShipPointCount;
+        BatchMath::Normalize(
+            flameVectors + batchStart,
+            flameDirs,
+            batchEnd - batchStart);
 
-        if (p == mFreeEphemeralParticleSearchStartIndex)
+        for (size_t s = batchStart; s < batchEnd; ++s)
         {
-            // Went around
-            break;
+            auto const pointIndex = burningPoints[s];
+
+            //
+            // Calculate flame wind rotation angle
+            //
+            // The wind rotation angle has three components:
+            //  - Global wind
+            //  - Interactive wind (i.e. the WindMaker), if any
+            //  - Particle's velocity
+            //
+            // We simulate inertia by converging slowly to the target angle.
+            //
+
+            vec2f const resultantWindSpeedVector =
+                wind.GetCurrentWindSpeedAt(positionBuffer[pointIndex])
+                - velocityBuffer[pointIndex];
+
+            // Projection of wind speed vector along flame
+            vec2f const & flameDir = flameDirs[s - batchStart];
+            float const windSpeedMagnitudeAlongFlame = resultantWindSpeedVector.dot(flameDir);
+
+            // Our angle moves opposite to the projection of wind along the flame:
+            //  - Wind aligned with flame: proj=|W|, angle = 0
+            //  - Wind perpendicular to flame: proj=|0|, angle = +/-MAX/2
+            //  - Wind against flame: proj=-|W|, angle = +/-MAX
+            float const targetFlameWindRotationAngle =
+                0.45f
+                * LinearStep(0.0f, 100.0f, resultantWindSpeedVector.length() - windSpeedMagnitudeAlongFlame)
+                * (resultantWindSpeedVector.cross(flameDir) > 0.0f ? -1.0f : 1.0f); // The sign of the angle is positive (CW) when the wind vector is to the right of the flame vector
+
+            // Converge
+            flameWindRotationAngles[s] +=
+                (targetFlameWindRotationAngle - flameWindRotationAngles[s])
+                * FlameWindRotationAngleConvergenceRate;
         }
     }
+}
 
-    //
-    // No luck
-    //
+size_t Points::GetByteSize() const
+{
+    return
+        mIsDamagedBitmap.GetByteSize()
+        + mMaterialsBuffer.GetByteSize()
+        + mIsRopeBitmap.GetByteSize()
+        + mPositionBuffer.GetByteSize()
+        + mPreviousPositionBuffer.GetByteSize()
+        + mFactoryPositionBuffer.GetByteSize()
+        + mVelocityBuffer.GetByteSize()
+        + mDynamicForceBuffer.GetByteSize()
+        + mStaticForceBuffer.GetByteSize()
+        + mAugmentedMaterialMassBuffer.GetByteSize()
+        + mMassBuffer.GetByteSize()
+        + mMaterialBuoyancyVolumeFillBuffer.GetByteSize()
+        + mStrengthBuffer.GetByteSize()
+        + mStressBuffer.GetByteSize()
+        + mDecayBuffer.GetByteSize()
+        + mFrozenCoefficientBuffer.GetByteSize()
+        + mSleepCoefficientBuffer.GetByteSize()
+        + mIntegrationFactorTimeCoefficientBuffer.GetByteSize()
+        + mBuoyancyCoefficientsBuffer.GetByteSize()
+        + mCachedDepthBuffer.GetByteSize()
+        + mIntegrationFactorBuffer.GetByteSize()
+        + mIsHullBuffer.GetByteSize()
+        + mInternalPressureBuffer.GetByteSize()
+        + mMaterialWaterIntakeBuffer.GetByteSize()
+        + mMaterialWaterRestitutionBuffer.GetByteSize()
+        + mMaterialWaterDiffusionSpeedBuffer.GetByteSize()
+        + mWaterBuffer.GetByteSize()
+        + mWaterVelocityBuffer.GetByteSize()
+        + mWaterMomentumBuffer.GetByteSize()
+        + mCumulatedIntakenWater.GetByteSize()
+        + mLeakingCompositeBuffer.GetByteSize()
+        + mFactoryIsStructurallyLeakingBitmap.GetByteSize()
+        + mTemperatureBuffer.GetByteSize()
+        + mMaterialHeatCapacityReciprocalBuffer.GetByteSize()
+        + mMaterialThermalExpansionCoefficientBuffer.GetByteSize()
+        + mMaterialIgnitionTemperatureBuffer.GetByteSize()
+        + mMaterialCombustionTypeBuffer.GetByteSize()
+        + mCombustionStateBuffer.GetByteSize()
+        + mBurningPointSlotBuffer.GetByteSize()
+        + mWaterReactionStateBuffer.GetByteSize()
+        + mElectricalElementBuffer.GetByteSize()
+        + mLightBuffer.GetByteSize()
+        + mMaterialWindReceptivityBuffer.GetByteSize()
+        + mMaterialRustReceptivityBuffer.GetByteSize()
+        + mConnectedSpringsBuffer.GetByteSize()
+        + mFactoryConnectedSpringsBuffer.GetByteSize()
+        + mConnectedTrianglesBuffer.GetByteSize()
+        + mFactoryConnectedTrianglesBuffer.GetByteSize()
+        + mConnectedComponentIdBuffer.GetByteSize()
+        + mPlaneIdBuffer.GetByteSize()
+        + mPlaneIdFloatBuffer.GetByteSize()
+        + mCurrentConnectivityVisitSequenceNumberBuffer.GetByteSize()
+        + mRepairStateBuffer.GetByteSize()
+        + mIsGadgetAttachedBitmap.GetByteSize()
+        + mRandomNormalizedUniformFloatBuffer.GetByteSize()
+        + mColorBuffer.GetByteSize()
+        + mTextureCoordinatesBuffer.GetByteSize()
+        + mInterpolatedPositionBuffer.GetByteSize();
+}
 
-    if (!doForce)
-        return NoneElementIndex;
+static std::uint32_t constexpr StateSectionTag = 0x53544E50; // PNTS
 
+void Points::SaveState(StateSnapshotWriter & writer) const
+{
+    writer.BeginSection(StateSectionTag);
+
+    ArchiveState(*this, writer);
+}
+
+void Points::LoadState(StateSnapshotReader & reader)
+{
+    reader.BeginSection(StateSectionTag);
+
+    ArchiveState(*this, reader);
 
     //
-    // Steal the oldest
+    // Invalidate all that is derived from the state
     //
 
-    assert(NoneElementIndex != oldestParticle);
+    RebuildConnectedSpringsAdjacency();
+
+    mElectricalElementHighlightedPoints.clear();
+    mCircleHighlightedPoints.clear();
+
+    mIsWholeColorBufferDirty = true;
+    mIsEphemeralColorBufferDirty = true;
+    mIsTextureCoordinatesBufferDirty = true;
+    mHaveWholeBuffersBeenUploadedOnce = false;
+    mAreEphemeralPointElementsDirtyForRendering = true;
+
+    mPlaneIdBufferNonEphemeralDirtyRange.Add(0, mAlignedShipPointCount);
+    mPlaneIdBufferEphemeralDirtyRange.Add(mAlignedShipPointCount, mAllPointCount);
+    mDecayBufferDirtyRange.Add(0, mAllPointCount);
+
+    mIsSpatialIndexDirty = true;
+}
+
+template<typename TSelf, typename TArchive>
+void Points::ArchiveState(
+    TSelf & self,
+    TArchive & archive)
+{
+    // Materials are not archived, as they are pointers into the material database
+
+    archive.Archive(self.mIsDamagedBitmap);
+    archive.Archive(self.mIsRopeBitmap);
+
+    // Mechanical dynamics
+    archive.Archive(self.mPositionBuffer);
+    archive.Archive(self.mPreviousPositionBuffer);
+    archive.Archive(self.mFactoryPositionBuffer);
+    archive.Archive(self.mVelocityBuffer);
+    archive.Archive(self.mDynamicForceBuffer);
+    archive.Archive(self.mStaticForceBuffer);
+    archive.Archive(self.mAugmentedMaterialMassBuffer);
+    archive.Archive(self.mMassBuffer);
+    archive.Archive(self.mMaterialBuoyancyVolumeFillBuffer);
+    archive.Archive(self.mStrengthBuffer);
+    archive.Archive(self.mStressBuffer);
+    archive.Archive(self.mDecayBuffer);
+    archive.Archive(self.mFrozenCoefficientBuffer);
+    archive.Archive(self.mSleepCoefficientBuffer);
+    archive.Archive(self.mIntegrationFactorTimeCoefficientBuffer);
+    archive.Archive(self.mBuoyancyCoefficientsBuffer);
+    archive.Archive(self.mCachedDepthBuffer);
+    archive.Archive(self.mIntegrationFactorBuffer);
+
+    // Pressure and water dynamics
+    archive.Archive(self.mIsHullBuffer);
+    archive.Archive(self.mInternalPressureBuffer);
+    archive.Archive(self.mMaterialWaterIntakeBuffer);
+    archive.Archive(self.mMaterialWaterRestitutionBuffer);
+    archive.Archive(self.mMaterialWaterDiffusionSpeedBuffer);
+    archive.Archive(self.mWaterBuffer);
+    archive.Archive(self.mWaterVelocityBuffer);
+    archive.Archive(self.mWaterMomentumBuffer);
+    archive.Archive(self.mCumulatedIntakenWater);
+    archive.Archive(self.mLeakingCompositeBuffer);
+    archive.Archive(self.mFactoryIsStructurallyLeakingBitmap);
+    archive.Archive(self.mTotalFactoryWetPoints);
+
+    // Heat dynamics
+    archive.Archive(self.mTemperatureBuffer);
+    archive.Archive(self.mMaterialHeatCapacityReciprocalBuffer);
+    archive.Archive(self.mMaterialThermalExpansionCoefficientBuffer);
+    archive.Archive(self.mMaterialIgnitionTemperatureBuffer);
+    archive.Archive(self.mMaterialCombustionTypeBuffer);
+    archive.Archive(self.mCombustionStateBuffer);
+    archive.Archive(self.mBurningPointSlotBuffer);
+
+    // Water reactions
+    archive.Archive(self.mWaterReactionStateBuffer);
 
-    // Remember to start after this one next time
-    mFreeEphemeralParticleSearchStartIndex = oldestParticle + 1;
-    if (mFreeEphemeralParticleSearchStartIndex >= mAllPointCount)
-        mFreeEphemeralParticleSearchStartIndex = mAlignedShipPointCount;
+    // Electrical dynamics
+    archive.Archive(self.mElectricalElementBuffer);
+    archive.Archive(self.mLightBuffer);
+
+    // Wind dynamics
+    archive.Archive(self.mMaterialWindReceptivityBuffer);
+
+    // Rust dynamics
+    archive.Archive(self.mMaterialRustReceptivityBuffer);
+
+    // Ephemeral particles
+    archive.Archive(self.mEphemeralParticleAttributes1Buffer);
+    archive.Archive(self.mEphemeralParticleAttributes2Buffer);
+
+    // Structure
+    archive.Archive(self.mConnectedSpringsBuffer);
+    archive.Archive(self.mFactoryConnectedSpringsBuffer);
+    archive.Archive(self.mConnectedTrianglesBuffer);
+    archive.Archive(self.mFactoryConnectedTrianglesBuffer);
 
-    return oldestParticle;
+    // Connectivity
+    archive.Archive(self.mConnectedComponentIdBuffer);
+    archive.Archive(self.mPlaneIdBuffer);
+    archive.Archive(self.mPlaneIdFloatBuffer);
+    archive.Archive(self.mCurrentConnectivityVisitSequenceNumberBuffer);
+
+    // Repair state
+    archive.Archive(self.mRepairStateBuffer);
+
+    // Gadgets
+    archive.Archive(self.mIsGadgetAttachedBitmap);
+
+    // Randomness
+    archive.Archive(self.mRandomNormalizedUniformFloatBuffer);
+
+    // Immutable render attributes
+    archive.Archive(self.mColorBuffer);
+    archive.Archive(self.mTextureCoordinatesBuffer);
+
+    // Combustion
+    archive.Archive(self.mBurningPoints);
+    archive.Archive(self.mBurningPointFlameDevelopments);
+    archive.Archive(self.mBurningPointMaxFlameDevelopments);
+    archive.Archive(self.mBurningPointFlameVectors);
+    archive.Archive(self.mBurningPointFlameWindRotationAngles);
+
+    // Active sets
+    archive.ArchiveContainer(self.mLeakingPoints);
+    archive.ArchiveContainer(self.mWetPoints);
+    archive.ArchiveContainer(self.mHotPoints);
+
+    // Ephemeral particle allocation
+    archive.ArchiveContainer(self.mEphemeralParticlePool);
+    archive.ArchiveContainer(self.mEphemeralParticleBudget);
 }
 
 }
\ No newline at end of file
@@ -5,6 +5,8 @@
 ***************************************************************************************/
 #pragma once
 
+#include "EphemeralParticleBudget.h"
+#include "EphemeralParticleSpawnGrid.h"
 #include "GameEventDispatcher.h"
 #include "GameParameters.h"
 #include "MaterialDatabase.h"
@@ -12,8 +14,13 @@
 #include "RenderContext.h"
 
 #include <GameCore/AABB.h>
+#include <GameCore/ActiveElementSet.h>
+#include <GameCore/AgeOrderedElementPool.h>
 #include <GameCore/Buffer.h>
 #include <GameCore/BufferAllocator.h>
+#include <GameCore/CompressedAdjacency.h>
+#include <GameCore/DirtyRange.h>
+#include <GameCore/ElementBitmap.h>
 #include <GameCore/ElementContainer.h>
 #include <GameCore/ElementIndexRangeIterator.h>
 #include <GameCore/EnumFlags.h>
@@ -21,9 +28,12 @@
 #include <GameCore/GameRandomEngine.h>
 #include <GameCore/GameTypes.h>
 #include <GameCore/GameWallClock.h>
+#include <GameCore/SpatialHashGrid.h>
+#include <GameCore/StateSnapshot.h>
 #include <GameCore/Vectors.h>
 
 #include <algorithm>
+#include <array>
 #include <cassert>
 #include <chrono>
 #include <cstring>
@@ -57,6 +67,21 @@ public:
         WakeBubble
     };
 
+    static std::size_t constexpr EphemeralTypeCount = static_cast<std::size_t>(EphemeralType::WakeBubble) + 1;
+
+    struct EphemeralParticleStatistics
+    {
+        std::uint64_t ExhaustionCount; // Allocations that found no room, and have thus either replaced another particle or have been dropped
+        std::uint64_t LevelOfDetailSkipCount; // Particles not spawned because of the level of detail, or of their density
+
+        EphemeralParticleStatistics(
+            std::uint64_t exhaustionCount,
+            std::uint64_t levelOfDetailSkipCount)
+            : ExhaustionCount(exhaustionCount)
+            , LevelOfDetailSkipCount(levelOfDetailSkipCount)
+        {}
+    };
+
     /*
      * The metadata of a single spring connected to a point.
      */
@@ -204,12 +229,15 @@ private:
 
     /*
      * The combustion state.
+     *
+     * The state proper is kept for each point, while the flame of each burning point
+     * is kept in structure-of-arrays form, parallel to the list of burning points.
      */
     struct CombustionState
     {
     public:
 
-        enum class StateType
+        enum class StateType : std::uint8_t
         {
             NotBurning,
             Developing_1,
@@ -220,43 +248,6 @@ private:
             Extinguishing_SmotheredWater,
             Exploded
         };
-
-    public:
-
-        StateType State;
-
-        float FlameDevelopment;
-        float MaxFlameDevelopment;
-        // FUTUREWORK
-        //float NextSmokeEmissionSimulationTimestamp;
-
-        // The current flame vector, which provides direction and magnitude
-        // of the flame quad.
-        // Slowly converges to the target vector, which is the resultant of
-        // (air) buoyancy making the flame upwards, added to the particle's
-        // current velocity
-        vec2f FlameVector;
-
-        // Angle of the flame tilt due to moving air; consumed by the shader.
-        // Slowly converges to the target value.
-        // Domain: ~[-0.5, 0.5].
-        float FlameWindRotationAngle;
-
-        CombustionState()
-        {
-            Reset();
-        }
-
-        inline void Reset()
-        {
-            State = StateType::NotBurning;
-            FlameDevelopment = 0.0f;
-            MaxFlameDevelopment = 0.0f;
-            // FUTUREWORK
-            //NextSmokeEmissionSimulationTimestamp = 0.0f;
-            FlameVector = vec2f(0.0f, 1.0f);
-            FlameWindRotationAngle = 0.0f;
-        }
     };
 
     /*
@@ -566,12 +557,13 @@ public:
         //////////////////////////////////
         // Buffers
         //////////////////////////////////
-        , mIsDamagedBuffer(mBufferElementCount, shipPointCount, false)
+        , mIsDamagedBitmap(mBufferElementCount)
         // Materials
         , mMaterialsBuffer(mBufferElementCount, shipPointCount, Materials(nullptr, nullptr))
-        , mIsRopeBuffer(mBufferElementCount, shipPointCount, false)
+        , mIsRopeBitmap(mBufferElementCount)
         // Mechanical dynamics
         , mPositionBuffer(mBufferElementCount, shipPointCount, vec2f::zero())
+        , mPreviousPositionBuffer(mBufferElementCount, shipPointCount, vec2f::zero())
         , mFactoryPositionBuffer(mBufferElementCount, shipPointCount, vec2f::zero())
         , mVelocityBuffer(mBufferElementCount, shipPointCount, vec2f::zero())
         , mDynamicForceBuffer(mBufferElementCount, shipPointCount, vec2f::zero())
@@ -582,8 +574,9 @@ public:
         , mStrengthBuffer(mBufferElementCount, shipPointCount, 0.0f)
         , mStressBuffer(mBufferElementCount, shipPointCount, 0.0f)
         , mDecayBuffer(mBufferElementCount, shipPointCount, 1.0f)
-        , mIsDecayBufferDirty(true)
+        , mDecayBufferDirtyRange()
         , mFrozenCoefficientBuffer(mBufferElementCount, shipPointCount, 1.0f)
+        , mSleepCoefficientBuffer(mBufferElementCount, shipPointCount, 1.0f)
         , mIntegrationFactorTimeCoefficientBuffer(mBufferElementCount, shipPointCount, 0.0f)
         , mBuoyancyCoefficientsBuffer(mBufferElementCount, shipPointCount, BuoyancyCoefficients(0.0f, 0.0f))
         , mCachedDepthBuffer(mBufferElementCount, shipPointCount, 0.0f)
@@ -599,7 +592,7 @@ public:
         , mWaterMomentumBuffer(mBufferElementCount, shipPointCount, vec2f::zero())
         , mCumulatedIntakenWater(mBufferElementCount, shipPointCount, 0.0f)
         , mLeakingCompositeBuffer(mBufferElementCount, shipPointCount, LeakingComposite(false))
-        , mFactoryIsStructurallyLeakingBuffer(mBufferElementCount, shipPointCount, false)
+        , mFactoryIsStructurallyLeakingBitmap(mBufferElementCount)
         , mTotalFactoryWetPoints(0)
         // Heat dynamics
         , mTemperatureBuffer(mBufferElementCount, shipPointCount, 0.0f)
@@ -607,7 +600,8 @@ public:
         , mMaterialThermalExpansionCoefficientBuffer(mBufferElementCount, shipPointCount, 0.0f)
         , mMaterialIgnitionTemperatureBuffer(mBufferElementCount, shipPointCount, 0.0f)
         , mMaterialCombustionTypeBuffer(mBufferElementCount, shipPointCount, StructuralMaterial::MaterialCombustionType::Combustion) // Arbitrary
-        , mCombustionStateBuffer(mBufferElementCount, shipPointCount, CombustionState())
+        , mCombustionStateBuffer(mBufferElementCount, shipPointCount, CombustionState::StateType::NotBurning)
+        , mBurningPointSlotBuffer(mBufferElementCount, shipPointCount, NoneElementIndex)
         // Water reaction dynamics
         , mWaterReactionStateBuffer(mBufferElementCount, shipPointCount, WaterReactionState(0.0f))
         // Electrical dynamics
@@ -618,19 +612,21 @@ public:
         // Rust dynamics
         , mMaterialRustReceptivityBuffer(mBufferElementCount, shipPointCount, 0.0f)
         // Ephemeral particles
-        , mEphemeralParticleAttributes1Buffer(mBufferElementCount, shipPointCount, EphemeralParticleAttributes1())
-        , mEphemeralParticleAttributes2Buffer(mBufferElementCount, shipPointCount, EphemeralParticleAttributes2())
+        , mEphemeralParticleAttributes1Buffer(GameParameters::MaxEphemeralParticles, 0, EphemeralParticleAttributes1())
+        , mEphemeralParticleAttributes2Buffer(GameParameters::MaxEphemeralParticles, 0, EphemeralParticleAttributes2())
         // Structure
         , mConnectedSpringsBuffer(mBufferElementCount, shipPointCount, ConnectedSpringsVector())
         , mFactoryConnectedSpringsBuffer(mBufferElementCount, shipPointCount, ConnectedSpringsVector())
         , mConnectedTrianglesBuffer(mBufferElementCount, shipPointCount, ConnectedTrianglesVector())
         , mFactoryConnectedTrianglesBuffer(mBufferElementCount, shipPointCount, ConnectedTrianglesVector())
+        , mConnectedSpringsAdjacency()
+        , mIsConnectedSpringsAdjacencyDirty(true)
         // Connected component and plane ID
         , mConnectedComponentIdBuffer(mBufferElementCount, shipPointCount, NoneConnectedComponentId)
         , mPlaneIdBuffer(mBufferElementCount, shipPointCount, NonePlaneId)
         , mPlaneIdFloatBuffer(mBufferElementCount, shipPointCount, 0.0)
-        , mIsPlaneIdBufferNonEphemeralDirty(true)
-        , mIsPlaneIdBufferEphemeralDirty(true)
+        , mPlaneIdBufferNonEphemeralDirtyRange()
+        , mPlaneIdBufferEphemeralDirtyRange()
         , mCurrentConnectivityVisitSequenceNumberBuffer(mBufferElementCount, shipPointCount, SequenceNumber())
         // Repair
         , mRepairStateBuffer(mBufferElementCount, shipPointCount, RepairState())
@@ -638,7 +634,7 @@ public:
         , mElectricalElementHighlightedPoints()
         , mCircleHighlightedPoints()
         // Gadgets
-        , mIsGadgetAttachedBuffer(mBufferElementCount, mElementCount, false)
+        , mIsGadgetAttachedBitmap(mBufferElementCount)
         // Randomness
         , mRandomNormalizedUniformFloatBuffer(mBufferElementCount, shipPointCount, [](size_t){ return GameRandomEngine::GetInstance().GenerateNormalizedUniformReal(); })
         // Immutable render attributes
@@ -647,6 +643,7 @@ public:
         , mIsEphemeralColorBufferDirty(true)
         , mTextureCoordinatesBuffer(mBufferElementCount, shipPointCount, vec2f::zero())
         , mIsTextureCoordinatesBufferDirty(true)
+        , mInterpolatedPositionBuffer(mBufferElementCount, shipPointCount, vec2f::zero())
         //////////////////////////////////
         // Container
         //////////////////////////////////
@@ -660,23 +657,43 @@ public:
         , mGameEventHandler(std::move(gameEventDispatcher))
         , mShipPhysicsHandler(nullptr)
         , mHaveWholeBuffersBeenUploadedOnce(false)
+        , mCurrentGameParametersGeneration(gameParameters.Generation)
         , mCurrentNumMechanicalDynamicsIterations(gameParameters.NumMechanicalDynamicsIterations<float>())
         , mCurrentCumulatedIntakenWaterThresholdForAirBubbles(GameParameters::AirBubblesDensityToCumulatedIntakenWater(gameParameters.AirBubblesDensity))
         , mCurrentCombustionSpeedAdjustment(gameParameters.CombustionSpeedAdjustment)
         , mFloatBufferAllocator(mBufferElementCount)
         , mVec2fBufferAllocator(mBufferElementCount)
+        , mVec4fUploadSnapshotAllocator(mBufferElementCount)
+        , mFloatUploadSnapshotAllocator(mBufferElementCount)
         , mCombustionIgnitionCandidates(mRawShipPointCount)
         , mCombustionExplosionCandidates(mRawShipPointCount)
         , mWaterReactionExplosionCandidates(mRawShipPointCount)
         , mBurningPoints()
-        , mStoppedBurningPoints()
-        , mFreeEphemeralParticleSearchStartIndex(mAlignedShipPointCount)
+        , mBurningPointFlameDevelopments()
+        , mBurningPointMaxFlameDevelopments()
+        , mBurningPointFlameVectors()
+        , mBurningPointFlameWindRotationAngles()
+        , mLeakingPoints(mRawShipPointCount, ActivePointsInactiveStepsBeforeRemoval)
+        , mWetPoints(mRawShipPointCount, ActivePointsInactiveStepsBeforeRemoval)
+        , mHotPoints(mRawShipPointCount, ActivePointsInactiveStepsBeforeRemoval)
+        , mEphemeralParticlePool(mAlignedShipPointCount, mAllPointCount - mAlignedShipPointCount)
+        , mEphemeralParticleBudget(MakeEphemeralParticleTypeBudgets(), mAllPointCount - mAlignedShipPointCount)
+        , mWakeBubbleSpawnGrid(WakeBubbleSpawnGridCellSize, WakeBubbleMaxSpawnsPerCellPerSecond)
         , mAreEphemeralPointElementsDirtyForRendering(false)
+        , mSpatialIndex(SpatialIndexCellSize)
+        , mIsSpatialIndexDirty(true)
+        , mSpatialIndexVersion(0)
+        , mSpatialQueryResult()
 #ifdef _DEBUG
         , mDiagnostic_ArePositionsDirty(false)
 #endif
     {
         CalculateCombustionDecayParameters(mCurrentCombustionSpeedAdjustment, GameParameters::ParticleUpdateLowFrequencyStepTimeDuration<float>);
+
+        // The first upload covers all points, so that ephemerals get reasonable defaults
+        mDecayBufferDirtyRange.Add(0, mAllPointCount);
+        mPlaneIdBufferNonEphemeralDirtyRange.Add(0, mAlignedShipPointCount);
+        mPlaneIdBufferEphemeralDirtyRange.Add(mAlignedShipPointCount, mAllPointCount);
     }
 
     Points(Points && other) = default;
@@ -723,7 +740,7 @@ public:
     inline bool IsActive(ElementIndex pointIndex) const
     {
         return pointIndex < mRawShipPointCount
-            || EphemeralType::None != mEphemeralParticleAttributes1Buffer[pointIndex].Type;
+            || EphemeralType::None != GetEphemeralType(pointIndex);
     }
 
     inline bool IsEphemeral(ElementIndex pointIndex) const
@@ -750,6 +767,15 @@ public:
         vec2f const & textureCoordinates,
         float randomNormalizedUniformFloat);
 
+    /*
+     * Populates this container - which must be empty - with the points of a fragment
+     * of another ship, in their current state; spring, triangle, and electrical element
+     * indices are remapped to the fragment's. Ephemeral particles are not carried over.
+     */
+    void AddFragment(
+        Points const & other,
+        ShipFragmentMap const & fragmentMap);
+
     void CreateEphemeralParticleAirBubble(
         vec2f const & position,
         float depth,
@@ -862,8 +888,7 @@ public:
     void UpdateCombustionHighFrequency(
         float currentSimulationTime,
         float dt,
-        vec2f const & globalWindSpeed,
-        std::optional<WindField> const & windField,
+        Wind const & wind,
         GameParameters const & gameParameters);
 
     void ReorderBurningPointsForDepth();
@@ -872,10 +897,91 @@ public:
         float currentSimulationTime,
         GameParameters const & gameParameters);
 
+    bool HasHighlights() const
+    {
+        return !mElectricalElementHighlightedPoints.empty()
+            || !mCircleHighlightedPoints.empty();
+    }
+
     void UpdateHighlights(GameWallClock::float_time currentWallClockTime);
 
     void Query(ElementIndex pointElementIndex) const;
 
+    //
+    // Spatial queries
+    //
+
+    /*
+     * Returns the indices - in ascending order - of all points that might be within
+     * the specified box; ephemeral points are included only if requested. Callers
+     * are responsible for checking the actual position of each point, as well as
+     * whether it's active.
+     *
+     * The returned vector is only valid until the next query.
+     */
+    std::vector<ElementIndex> const & QueryPointsInBox(
+        Geometry::AABB const & box,
+        bool doIncludeEphemeralPoints) const;
+
+    /*
+     * As above, but populates the specified vector; may be invoked concurrently,
+     * as long as PrepareSpatialIndex() has been invoked after positions last changed.
+     */
+    void QueryPointsInBox(
+        Geometry::AABB const & box,
+        bool doIncludeEphemeralPoints,
+        std::vector<ElementIndex> & pointIndices) const;
+
+    /*
+     * Brings the spatial index up-to-date with the current positions.
+     */
+    void PrepareSpatialIndex() const
+    {
+        if (mIsSpatialIndexDirty)
+        {
+            mSpatialIndex.Rebuild(
+                mPositionBuffer.data(),
+                GetElementCount());
+
+            mIsSpatialIndexDirty = false;
+            ++mSpatialIndexVersion;
+        }
+    }
+
+    /*
+     * Returns a number that changes whenever the spatial index is rebuilt, i.e. after
+     * positions have changed; indices of other elements whose positions derive from
+     * point positions use it to detect when they are stale.
+     */
+    std::uint64_t GetSpatialIndexVersion() const
+    {
+        PrepareSpatialIndex();
+
+        return mSpatialIndexVersion;
+    }
+
+    std::vector<ElementIndex> const & QueryPointsInRadius(
+        vec2f const & position,
+        float radius,
+        bool doIncludeEphemeralPoints) const
+    {
+        return QueryPointsInBox(
+            Geometry::AABB(
+                position.x - radius,
+                position.x + radius,
+                position.y + radius,
+                position.y - radius),
+            doIncludeEphemeralPoints);
+    }
+
+    /*
+     * Returns the active point - ship or ephemeral - nearest to the specified position
+     * and strictly within the specified radius, or NoneElementIndex if none.
+     */
+    ElementIndex FindNearestActivePointInRadius(
+        vec2f const & position,
+        float radius) const;
+
     // For debugging
     void ColorPointForDebugging(
         ElementIndex pointIndex,
@@ -901,6 +1007,14 @@ public:
         ShipId shipId,
         Render::RenderContext & renderContext) const;
 
+    /*
+     * Uploads only the attributes that change at each cycle; may be invoked
+     * ahead of UploadAttributes(), while the previous frame is still being drawn.
+     */
+    void UploadMutableAttributes(
+        ShipId shipId,
+        Render::RenderContext & renderContext) const;
+
     void UploadNonEphemeralPointElements(
         ShipId shipId,
         Render::RenderContext & renderContext) const;
@@ -921,6 +1035,22 @@ public:
         ShipId shipId,
         Render::RenderContext & renderContext) const;
 
+    /*
+     * Gets the number of bytes occupied by all of our buffers; for diagnostics only.
+     */
+    size_t GetByteSize() const;
+
+    /*
+     * Saves and restores the whole simulation state of the points, except for
+     * their materials, which are expected to be the same as the ones of the
+     * points the state has been saved from.
+     *
+     * Highlights are not saved, and gadget attachments are restored only as flags;
+     * it is up to the caller to re-attach or detach gadgets.
+     */
+    void SaveState(StateSnapshotWriter & writer) const;
+    void LoadState(StateSnapshotReader & reader);
+
 public:
 
     //
@@ -930,7 +1060,7 @@ public:
 
     bool IsDamaged(ElementIndex springElementIndex) const
     {
-        return mIsDamagedBuffer[springElementIndex];
+        return mIsDamagedBitmap.Test(springElementIndex);
     }
 
     //
@@ -951,7 +1081,7 @@ public:
 
     bool IsRope(ElementIndex pointElementIndex) const
     {
-        return mIsRopeBuffer[pointElementIndex];
+        return mIsRopeBitmap.Test(pointElementIndex);
     }
 
     //
@@ -964,12 +1094,23 @@ public:
     }
 
     vec2f * GetPositionBufferAsVec2()
+    {
+        // Positions are about to change
+        mIsSpatialIndexDirty = true;
+
+        return mPositionBuffer.data();
+    }
+
+    vec2f const * GetPositionBufferAsVec2() const
     {
         return mPositionBuffer.data();
     }
 
     float * GetPositionBufferAsFloat()
     {
+        // Positions are about to change
+        mIsSpatialIndexDirty = true;
+
         return reinterpret_cast<float *>(mPositionBuffer.data());
     }
 
@@ -987,11 +1128,22 @@ public:
     {
         mPositionBuffer[pointElementIndex] = position;
 
+        mIsSpatialIndexDirty = true;
+
 #ifdef _DEBUG
         mDiagnostic_ArePositionsDirty = true;
 #endif
     }
 
+    /*
+     * Remembers the current positions as the positions at the previous simulation
+     * step, from which positions are interpolated at render time.
+     */
+    void SnapshotPositions()
+    {
+        mPreviousPositionBuffer.copy_from(mPositionBuffer);
+    }
+
     vec2f const & GetFactoryPosition(ElementIndex pointElementIndex) const noexcept
     {
         return mFactoryPositionBuffer[pointElementIndex];
@@ -1151,11 +1303,19 @@ public:
         float value)
     {
         mDecayBuffer[pointElementIndex] = value;
+        mDecayBufferDirtyRange.Add(pointElementIndex);
     }
 
-    void MarkDecayBufferAsDirty()
+    float * GetDecayBufferAsFloat()
     {
-        mIsDecayBufferDirty = true;
+        return mDecayBuffer.data();
+    }
+
+    void MarkDecayBufferAsDirty(
+        ElementIndex startPointIndex,
+        ElementIndex endPointIndex)
+    {
+        mDecayBufferDirtyRange.Add(startPointIndex, endPointIndex);
     }
 
     bool IsPinned(ElementIndex pointElementIndex) const
@@ -1236,12 +1396,41 @@ public:
         // Recalc integration factor time coefficient, freezing point
         mIntegrationFactorTimeCoefficientBuffer[pointElementIndex] = CalculateIntegrationFactorTimeCoefficient(
             mCurrentNumMechanicalDynamicsIterations,
-            mFrozenCoefficientBuffer[pointElementIndex]);
+            mFrozenCoefficientBuffer[pointElementIndex] * mSleepCoefficientBuffer[pointElementIndex]);
 
         // Also zero-out velocity, wiping all traces of this point moving
         mVelocityBuffer[pointElementIndex] = vec2f(0.0f, 0.0f);
     }
 
+    bool IsSleeping(ElementIndex pointElementIndex) const
+    {
+        return (mSleepCoefficientBuffer[pointElementIndex] == 0.0f);
+    }
+
+    // Like freezing, but independent from it: the point rests in place - oblivious
+    // to forces - until it's woken up
+    void PutToSleep(ElementIndex pointElementIndex)
+    {
+        assert(1.0f == mSleepCoefficientBuffer[pointElementIndex]);
+
+        mSleepCoefficientBuffer[pointElementIndex] = 0.0f;
+
+        mIntegrationFactorTimeCoefficientBuffer[pointElementIndex] = 0.0f;
+
+        mVelocityBuffer[pointElementIndex] = vec2f(0.0f, 0.0f);
+    }
+
+    void WakeUp(ElementIndex pointElementIndex)
+    {
+        assert(0.0f == mSleepCoefficientBuffer[pointElementIndex]);
+
+        mSleepCoefficientBuffer[pointElementIndex] = 1.0f;
+
+        mIntegrationFactorTimeCoefficientBuffer[pointElementIndex] = CalculateIntegrationFactorTimeCoefficient(
+            mCurrentNumMechanicalDynamicsIterations,
+            mFrozenCoefficientBuffer[pointElementIndex]);
+    }
+
     // Changes the point's dynamics so that the point reacts again to forces
     void Thaw(ElementIndex pointElementIndex)
     {
@@ -1251,7 +1440,7 @@ public:
         // Re-populate its integration factor time coefficient, thawing point
         mIntegrationFactorTimeCoefficientBuffer[pointElementIndex] = CalculateIntegrationFactorTimeCoefficient(
             mCurrentNumMechanicalDynamicsIterations,
-            mFrozenCoefficientBuffer[pointElementIndex]);
+            mFrozenCoefficientBuffer[pointElementIndex] * mSleepCoefficientBuffer[pointElementIndex]);
     }
 
     //
@@ -1317,6 +1506,11 @@ public:
         float value)
     {
         mWaterBuffer[pointElementIndex] = value;
+
+        if (value != 0.0f && pointElementIndex < mRawShipPointCount)
+        {
+            mWetPoints.Add(pointElementIndex);
+        }
     }
 
     float * GetWaterBufferAsFloat()
@@ -1331,6 +1525,15 @@ public:
         return mWaterBuffer[pointElementIndex] > threshold;
     }
 
+    /*
+     * The (non-ephemeral) points that have - or have recently had - water;
+     * all the points that have water are in this set.
+     */
+    ActiveElementSet & GetWetPoints()
+    {
+        return mWetPoints;
+    }
+
     std::shared_ptr<Buffer<float>> MakeWaterBufferCopy()
     {
         auto waterBufferCopy = mFloatBufferAllocator.Allocate();
@@ -1342,6 +1545,14 @@ public:
     void UpdateWaterBuffer(std::shared_ptr<Buffer<float>> newWaterBuffer)
     {
         mWaterBuffer.copy_from(*newWaterBuffer);
+
+        for (ElementIndex p = 0; p < mRawShipPointCount; ++p)
+        {
+            if (mWaterBuffer[p] != 0.0f)
+            {
+                mWetPoints.Add(p);
+            }
+        }
     }
 
     vec2f const & GetWaterVelocity(ElementIndex pointElementIndex) const
@@ -1354,6 +1565,11 @@ public:
         vec2f const & waterVelocity)
     {
         mWaterVelocityBuffer[pointElementIndex] = waterVelocity;
+
+        if (waterVelocity != vec2f::zero() && pointElementIndex < mRawShipPointCount)
+        {
+            mWetPoints.Add(pointElementIndex);
+        }
     }
 
     vec2f * GetWaterVelocityBufferAsVec2()
@@ -1370,6 +1586,10 @@ public:
         return mWaterMomentumBuffer.data();
     }
 
+    /*
+     * The points that are not wet have neither water nor water velocity,
+     * and thus no water momentum either.
+     */
     void UpdateWaterMomentaFromVelocities()
     {
         float * const restrict waterBuffer = mWaterBuffer.data();
@@ -1377,7 +1597,7 @@ public:
         vec2f * restrict waterMomentumBuffer = mWaterMomentumBuffer.data();
 
         // No need to visit ephemerals, as they don't get water
-        for (ElementIndex p = 0; p < mRawShipPointCount; ++p)
+        for (ElementIndex p : mWetPoints.GetMembers())
         {
             waterMomentumBuffer[p] =
                 waterVelocityBuffer[p]
@@ -1392,7 +1612,7 @@ public:
         vec2f * const restrict waterMomentumBuffer = mWaterMomentumBuffer.data();
 
         // No need to visit ephemerals, as they don't get water
-        for (ElementIndex p = 0; p < mRawShipPointCount; ++p)
+        for (ElementIndex p : mWetPoints.GetMembers())
         {
             if (waterBuffer[p] != 0.0f)
             {
@@ -1423,11 +1643,41 @@ public:
         return mLeakingCompositeBuffer[pointElementIndex];
     }
 
+    // The (StructuralLeak, WaterPumpForce) pairs of all points
+    float const * GetLeakingSourcesBufferAsFloat() const
+    {
+        static_assert(sizeof(LeakingComposite) == 2 * sizeof(float));
+        return reinterpret_cast<float const *>(mLeakingCompositeBuffer.data());
+    }
+
     LeakingComposite & GetLeakingComposite(ElementIndex pointElementIndex)
     {
         return mLeakingCompositeBuffer[pointElementIndex];
     }
 
+    void SetWaterPumpForce(
+        ElementIndex pointElementIndex,
+        float waterPumpForce)
+    {
+        assert(waterPumpForce != 0.0f || !std::signbit(waterPumpForce)); // Or else IsCumulativelyLeaking's union trick won't work
+
+        mLeakingCompositeBuffer[pointElementIndex].LeakingSources.WaterPumpForce = waterPumpForce;
+
+        if (waterPumpForce != 0.0f)
+        {
+            mLeakingPoints.Add(pointElementIndex);
+        }
+    }
+
+    /*
+     * The (non-ephemeral) points that are - or have recently been - leaking;
+     * all the points that are leaking are in this set.
+     */
+    ActiveElementSet & GetLeakingPoints()
+    {
+        return mLeakingPoints;
+    }
+
     ElementCount GetTotalFactoryWetPoints() const
     {
         return mTotalFactoryWetPoints;
@@ -1443,13 +1693,13 @@ public:
         }
 
         // Check if it's the first time we get damaged
-        if (!mIsDamagedBuffer[pointElementIndex])
+        if (!mIsDamagedBitmap.Test(pointElementIndex))
         {
             // Invoke handler
             mShipPhysicsHandler->HandlePointDamaged(pointElementIndex);
 
             // Flag ourselves as damaged
-            mIsDamagedBuffer[pointElementIndex] = true;
+            mIsDamagedBitmap.Set(pointElementIndex);
         }
     }
 
@@ -1472,6 +1722,11 @@ public:
         float value)
     {
         mTemperatureBuffer[pointElementIndex] = value;
+
+        if (pointElementIndex < mRawShipPointCount)
+        {
+            mHotPoints.Add(pointElementIndex);
+        }
     }
 
     std::shared_ptr<Buffer<float>> MakeTemperatureBufferCopy()
@@ -1487,6 +1742,17 @@ public:
         mTemperatureBuffer.copy_from(*newTemperatureBuffer);
     }
 
+    /*
+     * The (non-ephemeral) points whose temperature is - or has recently been -
+     * away from the temperature of their environment; points are added to this set
+     * whenever they are heated, while points drifting away from the temperature of
+     * their environment for other reasons are only added by the heat propagation stage.
+     */
+    ActiveElementSet & GetHotPoints()
+    {
+        return mHotPoints;
+    }
+
     float GetMaterialHeatCapacityReciprocal(ElementIndex pointElementIndex) const
     {
         return mMaterialHeatCapacityReciprocalBuffer[pointElementIndex];
@@ -1497,7 +1763,7 @@ public:
      */
     bool IsBurningForSmothering(ElementIndex pointElementIndex) const
     {
-        auto const combustionState = mCombustionStateBuffer[pointElementIndex].State;
+        auto const combustionState = mCombustionStateBuffer[pointElementIndex];
 
         return combustionState == CombustionState::StateType::Burning
             || combustionState == CombustionState::StateType::Developing_1
@@ -1511,7 +1777,7 @@ public:
     {
         assert(IsBurningForSmothering(pointElementIndex));
 
-        auto const combustionState = mCombustionStateBuffer[pointElementIndex].State;
+        auto const combustionState = mCombustionStateBuffer[pointElementIndex];
 
         // Notify combustion end - if we are burning
         if (combustionState == CombustionState::StateType::Developing_1
@@ -1520,7 +1786,7 @@ public:
             mGameEventHandler->OnPointCombustionEnd();
 
         // Transition
-        mCombustionStateBuffer[pointElementIndex].State = isWater
+        mCombustionStateBuffer[pointElementIndex] = isWater
             ? CombustionState::StateType::Extinguishing_SmotheredWater
             : CombustionState::StateType::Extinguishing_SmotheredRain;
 
@@ -1535,6 +1801,11 @@ public:
         mTemperatureBuffer[pointElementIndex] +=
             heat
             * GetMaterialHeatCapacityReciprocal(pointElementIndex);
+
+        if (pointElementIndex < mRawShipPointCount)
+        {
+            mHotPoints.Add(pointElementIndex);
+        }
     }
 
     //
@@ -1574,13 +1845,65 @@ public:
         return mMaterialRustReceptivityBuffer[pointElementIndex];
     }
 
+    float const * GetMaterialRustReceptivityBufferAsFloat() const
+    {
+        return mMaterialRustReceptivityBuffer.data();
+    }
+
     //
     // Ephemeral Particles
     //
 
     EphemeralType GetEphemeralType(ElementIndex pointElementIndex) const
     {
-        return mEphemeralParticleAttributes1Buffer[pointElementIndex].Type;
+        return IsEphemeral(pointElementIndex)
+            ? mEphemeralParticleAttributes1Buffer[ToEphemeralSlot(pointElementIndex)].Type
+            : EphemeralType::None;
+    }
+
+    ElementCount GetEphemeralParticleCount(EphemeralType type) const
+    {
+        return mEphemeralParticleBudget.GetCount(static_cast<std::size_t>(type));
+    }
+
+    /*
+     * Limits the number of ephemeral particles that may be alive at the same time;
+     * the caps of the individual types are scaled accordingly.
+     */
+    void SetEphemeralParticleCapacity(ElementCount capacity)
+    {
+        ElementCount const effectiveCapacity = std::min(capacity, mEphemeralPointCount);
+
+        mEphemeralParticlePool.SetCapacity(effectiveCapacity);
+        mEphemeralParticleBudget.SetCapacity(effectiveCapacity);
+    }
+
+    /*
+     * Sets the fraction (0.0, 1.0] of the requested ephemeral particles that are actually
+     * spawned.
+     */
+    void SetEphemeralParticleLevelOfDetail(float levelOfDetail)
+    {
+        mEphemeralParticleBudget.SetLevelOfDetail(levelOfDetail);
+    }
+
+    /*
+     * Returns the statistics of ephemeral particle allocations since the last invocation
+     * of this method.
+     */
+    EphemeralParticleStatistics ResetEphemeralParticleStatistics()
+    {
+        auto const & poolStatistics = mEphemeralParticlePool.GetStatistics();
+        auto const & budgetStatistics = mEphemeralParticleBudget.GetStatistics();
+
+        EphemeralParticleStatistics const statistics(
+            poolStatistics.RecycleCount + poolStatistics.FailureCount + budgetStatistics.DropCount,
+            budgetStatistics.LevelOfDetailSkipCount + mWakeBubbleSpawnGrid.ResetSkipCount());
+
+        mEphemeralParticlePool.ResetStatistics();
+        mEphemeralParticleBudget.ResetStatistics();
+
+        return statistics;
     }
 
     //
@@ -1610,6 +1933,8 @@ public:
             springElementIndex,
             otherEndpointElementIndex,
             isAtOwner);
+
+        PatchConnectedSpringsAdjacency(pointElementIndex);
     }
 
     void DisconnectSpring(
@@ -1623,6 +1948,8 @@ public:
         mConnectedSpringsBuffer[pointElementIndex].DisconnectSpring(
             springElementIndex,
             isAtOwner);
+
+        PatchConnectedSpringsAdjacency(pointElementIndex);
     }
 
     auto const & GetFactoryConnectedSprings(ElementIndex pointElementIndex) const
@@ -1649,8 +1976,42 @@ public:
             springElementIndex,
             otherEndpointElementIndex,
             isAtOwner);
+
+        // The layout of the adjacency has to change
+        mIsConnectedSpringsAdjacencyDirty = true;
     }
 
+    /*
+     * The connected springs of a (non-ephemeral) point, as a cache-dense row with
+     * the same entries - in the same order - as GetConnectedSprings(); edges are
+     * springs, and neighbors are the springs' other endpoints.
+     */
+    inline CompressedAdjacency::Row GetConnectedSpringsAdjacency(ElementIndex pointElementIndex) const
+    {
+        assert(!mIsConnectedSpringsAdjacencyDirty);
+        assert(pointElementIndex < mRawShipPointCount);
+
+        return mConnectedSpringsAdjacency.GetRow(pointElementIndex);
+    }
+
+    /*
+     * Builds the adjacency of connected springs, if factory springs have been added since it
+     * was last built.
+     */
+    void UpdateConnectedSpringsAdjacency()
+    {
+        if (mIsConnectedSpringsAdjacencyDirty)
+        {
+            RebuildConnectedSpringsAdjacency();
+        }
+    }
+
+    /*
+     * Replaces the indices of all (factory-)connected springs after springs have been
+     * permuted.
+     */
+    void RemapSpringIndices(std::vector<ElementIndex> const & oldToNewSpringIndices);
+
     auto const & GetConnectedTriangles(ElementIndex pointElementIndex) const
     {
         return mConnectedTrianglesBuffer[pointElementIndex];
@@ -1742,11 +2103,7 @@ public:
     {
         mPlaneIdBuffer[pointElementIndex] = planeId;
         mPlaneIdFloatBuffer[pointElementIndex] = planeIdFloat;
-    }
-
-    void MarkPlaneIdBufferNonEphemeralAsDirty()
-    {
-        mIsPlaneIdBufferNonEphemeralDirty = true;
+        mPlaneIdBufferNonEphemeralDirtyRange.Add(pointElementIndex);
     }
 
     SequenceNumber GetCurrentConnectivityVisitSequenceNumber(ElementIndex pointElementIndex) const
@@ -1837,7 +2194,7 @@ public:
 
     bool IsGadgetAttached(ElementIndex pointElementIndex) const
     {
-        return mIsGadgetAttachedBuffer[pointElementIndex];
+        return mIsGadgetAttachedBitmap.Test(pointElementIndex);
     }
 
     void AttachGadget(
@@ -1845,9 +2202,9 @@ public:
         float mass,
         Springs & springs)
     {
-        assert(false == mIsGadgetAttachedBuffer[pointElementIndex]);
+        assert(!mIsGadgetAttachedBitmap.Test(pointElementIndex));
 
-        mIsGadgetAttachedBuffer[pointElementIndex] = true;
+        mIsGadgetAttachedBitmap.Set(pointElementIndex);
 
         // Augment mass due to gadget
         AugmentMaterialMass(
@@ -1860,9 +2217,9 @@ public:
         ElementIndex pointElementIndex,
         Springs & springs)
     {
-        assert(true == mIsGadgetAttachedBuffer[pointElementIndex]);
+        assert(mIsGadgetAttachedBitmap.Test(pointElementIndex));
 
-        mIsGadgetAttachedBuffer[pointElementIndex] = false;
+        mIsGadgetAttachedBitmap.Clear(pointElementIndex);
 
         // Reset mass of endpoints
 
@@ -1914,6 +2271,27 @@ public:
     // Diagnostics
     //
 
+    /*
+     * Visits the buffers that make up the dynamic state of the points - ephemeral
+     * particles included - as (name, floats, float count), e.g. for comparing the
+     * states of ships with each other.
+     */
+    template<typename TVisitor>
+    void VisitStateBuffers(TVisitor && visitor) const
+    {
+        size_t const elementCount = static_cast<size_t>(GetBufferElementCount());
+
+        visitor("P.Position", reinterpret_cast<float const *>(mPositionBuffer.data()), elementCount * 2);
+        visitor("P.Velocity", reinterpret_cast<float const *>(mVelocityBuffer.data()), elementCount * 2);
+        visitor("P.StaticForce", reinterpret_cast<float const *>(mStaticForceBuffer.data()), elementCount * 2);
+        visitor("P.InternalPressure", mInternalPressureBuffer.data(), elementCount);
+        visitor("P.Water", mWaterBuffer.data(), elementCount);
+        visitor("P.WaterVelocity", reinterpret_cast<float const *>(mWaterVelocityBuffer.data()), elementCount * 2);
+        visitor("P.Temperature", mTemperatureBuffer.data(), elementCount);
+        visitor("P.Decay", mDecayBuffer.data(), elementCount);
+        visitor("P.Light", mLightBuffer.data(), elementCount);
+    }
+
 #ifdef _DEBUG
 
     bool Diagnostic_ArePositionsDirty() const
@@ -1935,10 +2313,37 @@ public:
 
 private:
 
+    template<typename TSelf, typename TArchive>
+    static void ArchiveState(
+        TSelf & self,
+        TArchive & archive);
+
     void CalculateCombustionDecayParameters(
         float combustionSpeedAdjustment,
         float dt);
 
+    // Returns the positions to be rendered, interpolated if needed
+    vec2f const * GetRenderPositions(Render::RenderContext const & renderContext) const;
+
+    static std::array<EphemeralParticleBudget<EphemeralTypeCount>::TypeBudget, EphemeralTypeCount> MakeEphemeralParticleTypeBudgets();
+
+    void RebuildConnectedSpringsAdjacency();
+
+    inline void PatchConnectedSpringsAdjacency(ElementIndex pointElementIndex)
+    {
+        if (mIsConnectedSpringsAdjacencyDirty)
+        {
+            // Will be rebuilt anyway
+            return;
+        }
+
+        mConnectedSpringsAdjacency.ClearRow(pointElementIndex);
+        for (auto const & cs : mConnectedSpringsBuffer[pointElementIndex].ConnectedSprings)
+        {
+            mConnectedSpringsAdjacency.AppendToRow(pointElementIndex, cs.SpringIndex, cs.OtherEndpointIndex);
+        }
+    }
+
     static inline float CalculateIntegrationFactorTimeCoefficient(
         float numMechanicalDynamicsIterations,
         float frozenCoefficient)
@@ -1978,17 +2383,79 @@ private:
         vec2f const & pointVelocity,
         float pointVelocityMagnitudeThreshold);
 
+    void AddBurningPoint(
+        ElementIndex pointElementIndex,
+        float flameDevelopment,
+        float maxFlameDevelopment,
+        vec2f const & flameVector);
+
+    void RemoveBurningPoint(ElementIndex pointElementIndex);
+
+    void UpdateFlames(Wind const & wind);
+
+    inline void RenumberBurningPointSlots(size_t startSlot)
+    {
+        for (size_t s = startSlot; s < mBurningPoints.size(); ++s)
+        {
+            mBurningPointSlotBuffer[mBurningPoints[s]] = static_cast<ElementIndex>(s);
+        }
+    }
+
     inline void SetStructurallyLeaking(ElementIndex pointElementIndex)
     {
         mLeakingCompositeBuffer[pointElementIndex].LeakingSources.StructuralLeak = 1.0f;
+        mLeakingPoints.Add(pointElementIndex);
 
         // Randomize the initial water intaken, so that air bubbles won't come out all at the same moment
         mCumulatedIntakenWater[pointElementIndex] = RandomizeCumulatedIntakenWater(mCurrentCumulatedIntakenWaterThresholdForAirBubbles);
     }
 
-    inline ElementIndex FindFreeEphemeralParticle(
-        float currentSimulationTime,
-        bool doForce);
+    // The index of an ephemeral point in the buffers that only hold ephemeral points
+    inline ElementIndex ToEphemeralSlot(ElementIndex pointElementIndex) const
+    {
+        assert(IsEphemeral(pointElementIndex));
+        return pointElementIndex - mAlignedShipPointCount;
+    }
+
+    /*
+     * Finds a slot for a new ephemeral particle of the specified type, according to the
+     * level of detail and to the budget of the type; returns NoneElementIndex if the
+     * particle is not to be spawned.
+     */
+    inline ElementIndex AllocateEphemeralParticle(EphemeralType type)
+    {
+        std::size_t const t = static_cast<std::size_t>(type);
+
+        if (!mEphemeralParticleBudget.ShouldSpawn(t))
+        {
+            return NoneElementIndex;
+        }
+
+        if (!mEphemeralParticleBudget.IsOverBudget(t)
+            && mEphemeralParticlePool.CanAllocate())
+        {
+            mEphemeralParticleBudget.OnSpawned(t);
+            return mEphemeralParticlePool.Allocate();
+        }
+
+        // No room, see whether we may take the place of the oldest particle
+        ElementIndex const oldestPointElementIndex = mEphemeralParticlePool.GetOldest();
+        if (NoneElementIndex != oldestPointElementIndex)
+        {
+            std::size_t const oldestType = static_cast<std::size_t>(mEphemeralParticleAttributes1Buffer[ToEphemeralSlot(oldestPointElementIndex)].Type);
+            assert(oldestType != static_cast<std::size_t>(EphemeralType::None));
+
+            if (mEphemeralParticleBudget.CanReplace(t, oldestType))
+            {
+                mEphemeralParticleBudget.OnExpired(oldestType);
+                mEphemeralParticleBudget.OnSpawned(t);
+                return mEphemeralParticlePool.RecycleOldest();
+            }
+        }
+
+        mEphemeralParticleBudget.OnDropped();
+        return NoneElementIndex;
+    }
 
     inline void ExpireEphemeralParticle(ElementIndex pointElementIndex)
     {
@@ -1999,7 +2466,10 @@ private:
         // - Being rendered
         // - Being updated
         // ...and it will allow its slot to be chosen for a new ephemeral particle
-        mEphemeralParticleAttributes1Buffer[pointElementIndex].Type = EphemeralType::None;
+        mEphemeralParticleBudget.OnExpired(static_cast<std::size_t>(mEphemeralParticleAttributes1Buffer[ToEphemeralSlot(pointElementIndex)].Type));
+        mEphemeralParticleAttributes1Buffer[ToEphemeralSlot(pointElementIndex)].Type = EphemeralType::None;
+
+        mEphemeralParticlePool.Free(pointElementIndex);
     }
 
 private:
@@ -2011,17 +2481,18 @@ private:
     // Damage: true when the point has been irrevocably modified
     // (such as detached or set to leaking); only a Restore will
     // make things right again
-    Buffer<bool> mIsDamagedBuffer;
+    ElementBitmap mIsDamagedBitmap;
 
     // Materials
     Buffer<Materials> mMaterialsBuffer;
-    Buffer<bool> mIsRopeBuffer;
+    ElementBitmap mIsRopeBitmap;
 
     //
     // Dynamics
     //
 
     Buffer<vec2f> mPositionBuffer;
+    Buffer<vec2f> mPreviousPositionBuffer; // As of the beginning of the last simulation step
     Buffer<vec2f> mFactoryPositionBuffer;
     Buffer<vec2f> mVelocityBuffer;
     Buffer<vec2f> mDynamicForceBuffer; // Forces that vary across the multiple mechanical iterations (i.e. spring, hydrostatic surface pressure)
@@ -2032,9 +2503,10 @@ private:
     Buffer<float> mStrengthBuffer; // Immutable
     Buffer<float> mStressBuffer; // -1.0 -> 1.0, only calculated (at springs) if rendering it
     Buffer<float> mDecayBuffer; // 1.0 -> 0.0 (completely decayed)
-    bool mutable mIsDecayBufferDirty; // Only tracks non-ephemerals
+    DirtyRange mutable mDecayBufferDirtyRange; // Only tracks non-ephemerals
     Buffer<float> mFrozenCoefficientBuffer; // 1.0: not frozen; 0.0f: frozen
-    Buffer<float> mIntegrationFactorTimeCoefficientBuffer; // dt^2 or zero when the point is frozen
+    Buffer<float> mSleepCoefficientBuffer; // 1.0: awake; 0.0f: sleeping
+    Buffer<float> mIntegrationFactorTimeCoefficientBuffer; // dt^2 or zero when the point is frozen or sleeping
     Buffer<BuoyancyCoefficients> mBuoyancyCoefficientsBuffer;
     Buffer<float> mCachedDepthBuffer; // Positive when underwater
 
@@ -2066,7 +2538,7 @@ private:
 
     // Indicators of point intaking water
     Buffer<LeakingComposite> mLeakingCompositeBuffer;
-    Buffer<bool> mFactoryIsStructurallyLeakingBuffer;
+    ElementBitmap mFactoryIsStructurallyLeakingBitmap;
 
     // Total number of points that where wet at factory time
     ElementCount mTotalFactoryWetPoints;
@@ -2080,7 +2552,11 @@ private:
     Buffer<float> mMaterialThermalExpansionCoefficientBuffer;
     Buffer<float> mMaterialIgnitionTemperatureBuffer;
     Buffer<StructuralMaterial::MaterialCombustionType> mMaterialCombustionTypeBuffer;
-    Buffer<CombustionState> mCombustionStateBuffer;
+    Buffer<CombustionState::StateType> mCombustionStateBuffer;
+
+    // The position of each point in the list of burning points, or NoneElementIndex
+    // if the point is not in the list
+    Buffer<ElementIndex> mBurningPointSlotBuffer;
 
     //
     // Water reaction dynamics
@@ -2114,6 +2590,7 @@ private:
     // Ephemeral Particles
     //
 
+    // Only for ephemeral points, indexed by ephemeral slot
     Buffer<EphemeralParticleAttributes1> mEphemeralParticleAttributes1Buffer;
     Buffer<EphemeralParticleAttributes2> mEphemeralParticleAttributes2Buffer;
 
@@ -2126,6 +2603,12 @@ private:
     Buffer<ConnectedTrianglesVector> mConnectedTrianglesBuffer;
     Buffer<ConnectedTrianglesVector> mFactoryConnectedTrianglesBuffer;
 
+    // The connected springs of all ship points, packed - in the same order - for
+    // the stages that walk the spring network; laid out for the factory-connected
+    // springs, and patched whenever a spring is (dis)connected
+    CompressedAdjacency mConnectedSpringsAdjacency;
+    bool mIsConnectedSpringsAdjacencyDirty; // Set while factory springs are being added
+
     //
     // Connectivity
     //
@@ -2133,8 +2616,8 @@ private:
     Buffer<ConnectedComponentId> mConnectedComponentIdBuffer;
     Buffer<PlaneId> mPlaneIdBuffer;
     Buffer<float> mPlaneIdFloatBuffer;
-    bool mutable mIsPlaneIdBufferNonEphemeralDirty;
-    bool mutable mIsPlaneIdBufferEphemeralDirty;
+    DirtyRange mutable mPlaneIdBufferNonEphemeralDirtyRange;
+    DirtyRange mutable mPlaneIdBufferEphemeralDirtyRange;
     Buffer<SequenceNumber> mCurrentConnectivityVisitSequenceNumberBuffer;
 
     //
@@ -2154,7 +2637,7 @@ private:
     // Gadgets
     //
 
-    Buffer<bool> mIsGadgetAttachedBuffer;
+    ElementBitmap mIsGadgetAttachedBitmap;
 
     //
     // Randomness
@@ -2172,6 +2655,9 @@ private:
     Buffer<vec2f> mTextureCoordinatesBuffer;
     bool mutable mIsTextureCoordinatesBufferDirty; // Whether or not is dirty since last render upload
 
+    // Positions interpolated between the previous and the current simulation steps, for rendering
+    Buffer<vec2f> mutable mInterpolatedPositionBuffer;
+
     //////////////////////////////////////////////////////////
     // Container
     //////////////////////////////////////////////////////////
@@ -2199,6 +2685,7 @@ private:
     // The game parameter values that we are current with; changes
     // in the values of these parameters will trigger a re-calculation
     // of pre-calculated coefficients
+    std::uint64_t mCurrentGameParametersGeneration;
     float mCurrentNumMechanicalDynamicsIterations;
     float mCurrentCumulatedIntakenWaterThresholdForAirBubbles;
     float mCurrentCombustionSpeedAdjustment;
@@ -2207,6 +2694,10 @@ private:
     BufferAllocator<float> mFloatBufferAllocator;
     BufferAllocator<vec2f> mVec2fBufferAllocator;
 
+    // Allocators for the snapshots of buffers that are uploaded asynchronously
+    BufferAllocator<vec4f> mutable mVec4fUploadSnapshotAllocator;
+    BufferAllocator<float> mutable mFloatUploadSnapshotAllocator;
+
     // The list of candidates for burning and exploding during combustion,
     // and for exploding during a reaction with water;
     // member only to save allocations at use time
@@ -2214,16 +2705,52 @@ private:
     BoundedVector<std::tuple<ElementIndex, float>> mCombustionExplosionCandidates;
     BoundedVector<std::tuple<ElementIndex, float>> mWaterReactionExplosionCandidates;
 
-    // The indices of the points that are currently burning
+    // The indices of the points that are currently burning, sorted by depth
     std::vector<ElementIndex> mBurningPoints;
 
-    // The indices of the points that have stopped burning;
-    // member only to save allocations at use time
-    std::vector<ElementIndex> mStoppedBurningPoints;
+    //
+    // The flames of the burning points, parallel to mBurningPoints
+    //
+
+    std::vector<float> mBurningPointFlameDevelopments;
+    std::vector<float> mBurningPointMaxFlameDevelopments;
 
-    // The index at which to start searching for free ephemeral particles
-    // (just an optimization over restarting from zero each time)
-    ElementIndex mFreeEphemeralParticleSearchStartIndex;
+    // The current flame vector, which provides direction and magnitude
+    // of the flame quad.
+    // Slowly converges to the target vector, which is the resultant of
+    // (air) buoyancy making the flame upwards, added to the particle's
+    // current velocity
+    std::vector<vec2f> mBurningPointFlameVectors;
+
+    // Angle of the flame tilt due to moving air; consumed by the shader.
+    // Slowly converges to the target value.
+    // Domain: ~[-0.5, 0.5].
+    std::vector<float> mBurningPointFlameWindRotationAngles;
+
+    // Above this many out-of-order burning points, ReorderBurningPointsForDepth
+    // gives up on a coherent insertion sort and sorts from scratch
+    static size_t constexpr MaxOutOfOrderSlotsForInsertionSort = 16;
+
+    // The (non-ephemeral) points that are - or have recently been - leaking,
+    // wet, or away from the temperature of their environment; the stages that
+    // propagate water and heat only visit these points and their neighbors
+    static std::uint32_t constexpr ActivePointsInactiveStepsBeforeRemoval = 64;
+    ActiveElementSet mLeakingPoints;
+    ActiveElementSet mWetPoints;
+    ActiveElementSet mHotPoints;
+
+    // The allocator of ephemeral particles; when exhausted, it may
+    // recycle the oldest particles
+    AgeOrderedElementPool mEphemeralParticlePool;
+
+    // The apportioning of the ephemeral particles among their types
+    EphemeralParticleBudget<EphemeralTypeCount> mEphemeralParticleBudget;
+
+    // The cap on the density of wake bubbles: beyond a few hundred bubbles per
+    // second in a few meters, more bubbles are just indistinguishable
+    static float constexpr WakeBubbleSpawnGridCellSize = 4.0f;
+    static std::uint32_t constexpr WakeBubbleMaxSpawnsPerCellPerSecond = 160;
+    EphemeralParticleSpawnGrid mWakeBubbleSpawnGrid;
 
     // Flag remembering whether the set of ephemeral point *elements* is dirty
     // (i.e. whether there are more or less points than previously
@@ -2232,6 +2759,17 @@ private:
     // (thus no AirBubbles nor Sparkles, which are both uploaded specially)
     bool mutable mAreEphemeralPointElementsDirtyForRendering;
 
+    // The spatial index of all points, rebuilt lazily at the first
+    // query after positions have changed - i.e. at most once per
+    // simulation step
+    static float constexpr SpatialIndexCellSize = 2.0f;
+    SpatialHashGrid mutable mSpatialIndex;
+    bool mutable mIsSpatialIndexDirty;
+    std::uint64_t mutable mSpatialIndexVersion;
+
+    // The result of the last spatial query; member only to save allocations
+    std::vector<ElementIndex> mutable mSpatialQueryResult;
+
     // Calculated constants for combustion decay
     float mCombustionDecayAlphaFunctionA;
     float mCombustionDecayAlphaFunctionB;
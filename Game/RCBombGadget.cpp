@@ -36,6 +36,28 @@ RCBombGadget::RCBombGadget(
 {
 }
 
+RCBombGadget::RCBombGadget(
+    RCBombGadget const & other,
+    ShipFragmentMap const & fragmentMap,
+    IShipPhysicsHandler & shipPhysicsHandler,
+    Points & shipPoints,
+    Springs & shipSprings)
+    : Gadget(
+        other,
+        fragmentMap,
+        shipPhysicsHandler,
+        shipPoints,
+        shipSprings)
+    , mState(other.mState)
+    , mNextStateTransitionTimePoint(other.mNextStateTransitionTimePoint)
+    , mExplosionIgnitionTimestamp(other.mExplosionIgnitionTimestamp)
+    , mPingOnStepCounter(other.mPingOnStepCounter)
+    , mExplosionFadeoutCounter(other.mExplosionFadeoutCounter)
+    , mExplosionPosition(other.mExplosionPosition)
+    , mExplosionPlaneId(other.mExplosionPlaneId)
+{
+}
+
 bool RCBombGadget::Update(
     GameWallClock::time_point currentWallClockTime,
     float currentSimulationTime,
@@ -31,6 +31,25 @@ public:
         Points & shipPoints,
         Springs & shipSprings);
 
+    /*
+     * Takes over a gadget of a ship that has split into fragments.
+     */
+    RCBombGadget(
+        RCBombGadget const & other,
+        ShipFragmentMap const & fragmentMap,
+        IShipPhysicsHandler & shipPhysicsHandler,
+        Points & shipPoints,
+        Springs & shipSprings);
+
+    virtual std::unique_ptr<Gadget> MigrateToFragment(
+        ShipFragmentMap const & fragmentMap,
+        IShipPhysicsHandler & shipPhysicsHandler,
+        Points & shipPoints,
+        Springs & shipSprings) const override
+    {
+        return std::make_unique<RCBombGadget>(*this, fragmentMap, shipPhysicsHandler, shipPoints, shipSprings);
+    }
+
     virtual float GetMass() const override
     {
         return GameParameters::BombMass;
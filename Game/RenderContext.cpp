@@ -10,7 +10,10 @@
 #include <GameCore/GameChronometer.h>
 #include <GameCore/GameException.h>
 #include <GameCore/Log.h>
+#include <GameCore/Profiler.h>
 #include <GameCore/SysSpecifics.h>
+#include <GameCore/SystemThreadManager.h>
+#include <GameCore/TaskThreadPool.h>
 
 #include <cstring>
 
@@ -31,6 +34,40 @@ namespace /*anonymous*/ {
         }
     }
 
+    bool RunRenderThreadSelfTest()
+    {
+        // Make sure the context is current on this thread
+        if (nullptr == glGetString(GL_VERSION))
+        {
+            LogMessage("RenderContext: self-test: no current context");
+            return false;
+        }
+
+        // Clear pending errors
+        for (int i = 0; i < 16 && glGetError() != GL_NO_ERROR; ++i);
+
+        // Clear to a known color, and read it back
+        std::array<GLubyte, 4> pixel{ 0, 0, 0, 0 };
+        glClearColor(1.0f, 0.0f, 1.0f, 1.0f);
+        glClear(GL_COLOR_BUFFER_BIT);
+        glReadPixels(0, 0, 1, 1, GL_RGBA, GL_UNSIGNED_BYTE, pixel.data());
+
+        GLenum const glError = glGetError();
+        if (GL_NO_ERROR != glError)
+        {
+            LogMessage("RenderContext: self-test: error ", glError);
+            return false;
+        }
+
+        if (pixel[0] != 0xff || pixel[1] != 0x00 || pixel[2] != 0xff)
+        {
+            LogMessage("RenderContext: self-test: unexpected pixel (", int(pixel[0]), ",", int(pixel[1]), ",", int(pixel[2]), ")");
+            return false;
+        }
+
+        return true;
+    }
+
     bool CalculateDoForceNoMultithreadedRendering(std::optional<bool> override)
     {
         if (override.has_value())
@@ -42,9 +79,7 @@ namespace /*anonymous*/ {
         {
 #if FS_IS_OS_MACOS() // Do not use multi-threaded rendering on MacOS
             return true;
-#elif FS_IS_OS_LINUX() // Do not use multi-threaded rendering on X11
-            return true;
-#else
+#else // Including X11, where the render thread has its own context
             return false;
 #endif
         }
@@ -58,9 +93,11 @@ RenderContext::RenderContext(
     ProgressCallback const & progressCallback)
     : mDoInvokeGlFinish(false) // Will be recalculated
     // Thread
-    , mRenderThread(CalculateDoForceNoMultithreadedRendering(renderDeviceProperties.DoForceNoMultithreadedRendering))
-    , mLastRenderUploadEndCompletionIndicator()
-    , mLastRenderDrawCompletionIndicator()
+    , mRenderThread(std::make_unique<CommandRingThread>(
+        CalculateDoForceNoMultithreadedRendering(renderDeviceProperties.DoForceNoMultithreadedRendering),
+        SystemThreadManager::ThreadRole::Render))
+    , mLastRenderDrawTicket()
+    , mTextureCompressionThread(std::make_unique<TaskThread>())
     // Shader manager
     , mShaderManager()
     // Child contextes
@@ -74,6 +111,7 @@ RenderContext::RenderContext(
     , mShipDefaultWaterColor(0x00, 0x00, 0xcc)
     , mVectorFieldRenderMode(VectorFieldRenderModeType::None)
     , mVectorFieldLengthMultiplier(1.0f)
+    , mPointPositionInterpolationFactor(1.0f)
     // Rendering externals
     , mMakeRenderContextCurrentFunction(renderDeviceProperties.MakeRenderContextCurrentFunction)
     , mSwapRenderBuffersFunction(renderDeviceProperties.SwapRenderBuffersFunction)
@@ -87,10 +125,11 @@ RenderContext::RenderContext(
     // Statistics
     , mPerfStats(perfStats)
     , mRenderStats()
+    , mGpuTimerQueries()
 {
     progressCallback(0.0f, ProgressMessageType::InitializingOpenGL);
 
-    mRenderThread.RunSynchronously(
+    mRenderThread->RunSynchronously(
         [&, doForceNoGlFinish = renderDeviceProperties.DoForceNoGlFinish]()
         {
             //
@@ -106,6 +145,11 @@ RenderContext::RenderContext(
             mDoInvokeGlFinish = CalculateDoInvokeGlFinish(doForceNoGlFinish);
             LogMessage("RenderContext: DoInvokeGlFinish=", mDoInvokeGlFinish);
 
+            if (GameOpenGL::SupportsTimerQueries)
+            {
+                mGpuTimerQueries = std::make_unique<GameOpenGLTimerQueries<static_cast<size_t>(GpuTimerSegmentType::_Last) + 1>>();
+            }
+
             // Initialize the shared texture unit once and for all
             mShaderManager->ActivateTexture<ProgramParameterType::SharedTexture>();
 
@@ -130,21 +174,51 @@ RenderContext::RenderContext(
             glDepthFunc(GL_LEQUAL);
         });
 
+    if (mRenderThread->HasThread())
+    {
+        //
+        // Verify that we may render from the render thread, falling back
+        // on rendering from this thread otherwise
+        //
+
+        bool isRenderThreadUsable = false;
+        mRenderThread->RunSynchronously(
+            [&]()
+            {
+                isRenderThreadUsable = RunRenderThreadSelfTest();
+            });
+
+        if (!isRenderThreadUsable)
+        {
+            LogMessage("RenderContext: render thread failed self-test; falling back on single-threaded rendering");
+
+            mRenderThread = std::make_unique<CommandRingThread>(true);
+
+            mRenderThread->RunSynchronously(
+                [&]()
+                {
+                    mMakeRenderContextCurrentFunction();
+                });
+        }
+    }
+
     progressCallback(0.05f, ProgressMessageType::LoadingShaders);
 
-    mRenderThread.RunSynchronously(
+    mRenderThread->RunSynchronously(
         [&]()
         {
             //
             // Load shader manager
             //
 
-            mShaderManager = ShaderManager<ShaderManagerTraits>::CreateInstance(resourceLocator.GetGameShadersRootPath());
+            mShaderManager = ShaderManager<ShaderManagerTraits>::CreateInstance(
+                resourceLocator.GetGameShadersRootPath(),
+                resourceLocator.GetShaderProgramBinaryCacheFolderPath("Game"));
         });
 
     progressCallback(0.1f, ProgressMessageType::InitializingNoise);
 
-    mRenderThread.RunSynchronously(
+    mRenderThread->RunSynchronously(
         [&]()
         {
             mGlobalRenderContext = std::make_unique<GlobalRenderContext>(*mShaderManager);
@@ -152,23 +226,27 @@ RenderContext::RenderContext(
             mGlobalRenderContext->InitializeNoiseTextures(resourceLocator);
         });
 
+    // To load and pack the texture atlases with, and to minify their mipmaps with; only
+    // invoked from the render thread, while we wait for it
+    TaskThreadPool initializationTaskThreadPool;
+
     progressCallback(0.15f, ProgressMessageType::LoadingGenericTextures);
 
-    mRenderThread.RunSynchronously(
+    mRenderThread->RunSynchronously(
         [&]()
         {
-            mGlobalRenderContext->InitializeGenericTextures(resourceLocator);
+            mGlobalRenderContext->InitializeGenericTextures(resourceLocator, initializationTaskThreadPool);
         });
 
     progressCallback(0.2f, ProgressMessageType::LoadingExplosionTextureAtlas);
 
-    mRenderThread.RunSynchronously(
+    mRenderThread->RunSynchronously(
         [&]()
         {
             mGlobalRenderContext->InitializeExplosionTextures(resourceLocator);
         });
 
-    mRenderThread.RunSynchronously(
+    mRenderThread->RunSynchronously(
         [&]()
         {
             mWorldRenderContext = std::make_unique<WorldRenderContext>(
@@ -178,23 +256,23 @@ RenderContext::RenderContext(
 
     progressCallback(0.45f, ProgressMessageType::LoadingCloudTextureAtlas);
 
-    mRenderThread.RunSynchronously(
+    mRenderThread->RunSynchronously(
         [&]()
         {
-            mWorldRenderContext->InitializeCloudTextures(resourceLocator);
+            mWorldRenderContext->InitializeCloudTextures(resourceLocator, initializationTaskThreadPool);
         });
 
     progressCallback(0.65f, ProgressMessageType::LoadingFishTextureAtlas);
 
-    mRenderThread.RunSynchronously(
+    mRenderThread->RunSynchronously(
         [&]()
         {
-            mWorldRenderContext->InitializeFishTextures(resourceLocator);
+            mWorldRenderContext->InitializeFishTextures(resourceLocator, initializationTaskThreadPool);
         });
 
     progressCallback(0.7f, ProgressMessageType::LoadingWorldTextures);
 
-    mRenderThread.RunSynchronously(
+    mRenderThread->RunSynchronously(
         [&]()
         {
             mWorldRenderContext->InitializeWorldTextures(resourceLocator);
@@ -202,7 +280,7 @@ RenderContext::RenderContext(
 
     progressCallback(0.8f, ProgressMessageType::LoadingFonts);
 
-    mRenderThread.RunSynchronously(
+    mRenderThread->RunSynchronously(
         [&]()
         {
             //
@@ -217,7 +295,7 @@ RenderContext::RenderContext(
 
     progressCallback(0.9f, ProgressMessageType::InitializingGraphics);
 
-    mRenderThread.RunSynchronously(
+    mRenderThread->RunSynchronously(
         [&]()
         {
             //
@@ -265,10 +343,10 @@ RenderContext::~RenderContext()
     // (this destructor may only be invoked between two cycles,
     // hence knowing that there's no more render's is enough to ensure
     // nothing is using OpenGL at this moment)
-    if (!!mLastRenderDrawCompletionIndicator)
+    if (mLastRenderDrawTicket.has_value())
     {
-        mLastRenderDrawCompletionIndicator->Wait();
-        mLastRenderDrawCompletionIndicator.reset();
+        mRenderThread->Wait(*mLastRenderDrawTicket);
+        mLastRenderDrawTicket.reset();
     }
 }
 
@@ -276,7 +354,7 @@ RenderContext::~RenderContext()
 
 void RenderContext::RebindContext()
 {
-    mRenderThread.RunSynchronously(
+    mRenderThread->RunSynchronously(
         [&]()
         {
             mMakeRenderContextCurrentFunction();
@@ -288,7 +366,7 @@ void RenderContext::Reset()
     // Ship's destructors do OpenGL cleanups, hence we
     // want to clear the vector on the rendering thread
     // (synchronously)
-    mRenderThread.RunSynchronously(
+    mRenderThread->RunSynchronously(
         [&]()
         {
             // Clear ships
@@ -335,7 +413,7 @@ void RenderContext::AddShip(
     }
 
     // Add the ship - synchronously
-    mRenderThread.RunSynchronously(
+    mRenderThread->RunSynchronously(
         [&]()
         {
             mShips.emplace_back(
@@ -344,6 +422,43 @@ void RenderContext::AddShip(
                     pointCount,
                     newShipCount,
                     std::move(texture),
+                    *mTextureCompressionThread,
+                    *mShaderManager,
+                    *mGlobalRenderContext,
+                    mRenderParameters,
+                    mShipFlameSizeAdjustment,
+                    mVectorFieldLengthMultiplier));
+        });
+}
+
+void RenderContext::ReplaceShip(
+    ShipId shipId,
+    size_t pointCount,
+    RgbaImageData texture)
+{
+    //
+    // Validate ship
+    //
+
+    ValidateShipTexture(texture);
+
+    //
+    // Replace ship
+    //
+
+    assert(shipId >= 0 && shipId < mShips.size());
+
+    // Replace the ship - synchronously
+    mRenderThread->RunSynchronously(
+        [&]()
+        {
+            mShips[shipId].reset(
+                new ShipRenderContext(
+                    shipId,
+                    pointCount,
+                    mShips.size(),
+                    std::move(texture),
+                    *mTextureCompressionThread,
                     *mShaderManager,
                     *mGlobalRenderContext,
                     mRenderParameters,
@@ -366,7 +481,7 @@ RgbImageData RenderContext::TakeScreenshot()
     // Take screnshot - synchronously
     //
 
-    mRenderThread.RunSynchronously(
+    mRenderThread->RunSynchronously(
         [&]()
         {
             //
@@ -395,17 +510,8 @@ RgbImageData RenderContext::TakeScreenshot()
 
 void RenderContext::UpdateStart()
 {
-    // If there's a pending RenderUploadEnd, wait for it so we
-    // know that CPU buffers are safe to be used
-    if (!!mLastRenderUploadEndCompletionIndicator)
-    {
-        auto const waitStart = GameChronometer::now();
-
-        mLastRenderUploadEndCompletionIndicator->Wait();
-        mLastRenderUploadEndCompletionIndicator.reset();
-
-        mPerfStats.TotalWaitForRenderUploadDuration.Update(GameChronometer::now() - waitStart);
-    }
+    // Nop: buffers uploaded asynchronously are snapshots, hence the
+    // simulation is free to touch its own buffers right away
 }
 
 void RenderContext::UpdateEnd()
@@ -417,21 +523,19 @@ void RenderContext::UpdateEnd()
 
 void RenderContext::RenderStart()
 {
-    // Cleanup an eventual pending RenderUploadEnd - may be left behind if
-    // this cycle did not do an Update
-    mLastRenderUploadEndCompletionIndicator.reset();
+    // Nop
 }
 
 void RenderContext::UploadStart()
 {
     // Wait for an eventual pending RenderDraw, so that we know
     // GPU buffers are free to be used
-    if (!!mLastRenderDrawCompletionIndicator)
+    if (mLastRenderDrawTicket.has_value())
     {
         auto const waitStart = GameChronometer::now();
 
-        mLastRenderDrawCompletionIndicator->Wait();
-        mLastRenderDrawCompletionIndicator.reset();
+        mRenderThread->Wait(*mLastRenderDrawTicket);
+        mLastRenderDrawTicket.reset();
 
         mPerfStats.TotalWaitForRenderDrawDuration.Update(GameChronometer::now() - waitStart);
     }
@@ -446,24 +550,21 @@ void RenderContext::UploadEnd()
     mWorldRenderContext->UploadEnd();
 
     mNotificationRenderContext->UploadEnd();
-
-    // Queue an indicator here, so we may wait for it
-    // when we want to touch CPU buffers again
-    assert(!mLastRenderUploadEndCompletionIndicator);
-    mLastRenderUploadEndCompletionIndicator = mRenderThread.QueueSynchronizationPoint();
 }
 
 void RenderContext::Draw()
 {
-    assert(!mLastRenderDrawCompletionIndicator);
+    assert(!mLastRenderDrawTicket.has_value());
 
     // Render asynchronously; we will wait for this render to complete
     // when we want to touch GPU buffers again.
     //
     // Take a copy of the current render parameters and clean its dirtyness
-    mLastRenderDrawCompletionIndicator = mRenderThread.QueueTask(
+    mLastRenderDrawTicket = mRenderThread->QueueTask(
         [this, renderParameters = mRenderParameters.TakeSnapshotAndClear()]() mutable
         {
+            FS_PROFILE_SCOPE("RenderContext::Draw");
+
             auto const startTime = GameChronometer::now();
 
             RenderStatistics renderStats;
@@ -494,6 +595,9 @@ void RenderContext::Draw()
             // Clear canvas - and depth buffer
             glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
 
+            // Collect GPU times of an earlier frame
+            UpdateGpuPerfStats();
+
             //
             // Prepare
             //
@@ -535,6 +639,8 @@ void RenderContext::Draw()
             //
 
             {
+                BeginGpuTimerSegment(GpuTimerSegmentType::WorldBackground);
+
                 mWorldRenderContext->RenderDrawStars(renderParameters);
 
                 mWorldRenderContext->RenderDrawCloudsAndBackgroundLightnings(renderParameters);
@@ -542,6 +648,10 @@ void RenderContext::Draw()
                 // Render ocean opaquely, over sky
                 mWorldRenderContext->RenderDrawOcean(true, renderParameters);
 
+                EndGpuTimerSegment();
+
+                BeginGpuTimerSegment(GpuTimerSegmentType::Ships);
+
                 glEnable(GL_DEPTH_TEST); // Required by ships
 
                 for (auto const & ship : mShips)
@@ -551,6 +661,10 @@ void RenderContext::Draw()
 
                 glDisable(GL_DEPTH_TEST);
 
+                EndGpuTimerSegment();
+
+                BeginGpuTimerSegment(GpuTimerSegmentType::WorldForeground);
+
                 mWorldRenderContext->RenderDrawOceanFloor(renderParameters);
 
                 mWorldRenderContext->RenderDrawFishes(renderParameters);
@@ -573,7 +687,13 @@ void RenderContext::Draw()
 
                 mWorldRenderContext->RenderDrawWorldBorder(renderParameters);
 
+                EndGpuTimerSegment();
+
+                BeginGpuTimerSegment(GpuTimerSegmentType::Notifications);
+
                 mNotificationRenderContext->RenderDraw();
+
+                EndGpuTimerSegment();
             }
 
             //
@@ -602,10 +722,12 @@ void RenderContext::RenderEnd()
 
 void RenderContext::WaitForPendingTasks()
 {
-    if (!!mLastRenderDrawCompletionIndicator)
+    FS_PROFILE_SCOPE("RenderContext::WaitForPendingTasks");
+
+    if (mLastRenderDrawTicket.has_value())
     {
-        mLastRenderDrawCompletionIndicator->Wait();
-        mLastRenderDrawCompletionIndicator.reset();
+        mRenderThread->Wait(*mLastRenderDrawTicket);
+        mLastRenderDrawTicket.reset();
     }
 }
 
@@ -692,4 +814,27 @@ vec3f RenderContext::CalculateShipWaterColor() const
     }
 }
 
+void RenderContext::UpdateGpuPerfStats()
+{
+    if (mGpuTimerQueries)
+    {
+        auto const segmentDurations = mGpuTimerQueries->BeginFrame();
+        if (segmentDurations.has_value())
+        {
+            auto const toDuration = [&segmentDurations](GpuTimerSegmentType segment)
+            {
+                return std::chrono::duration_cast<GameChronometer::duration>((*segmentDurations)[static_cast<size_t>(segment)]);
+            };
+
+            mPerfStats.TotalWorldGpuRenderDrawDuration.Update(
+                toDuration(GpuTimerSegmentType::WorldBackground)
+                + toDuration(GpuTimerSegmentType::WorldForeground));
+
+            mPerfStats.TotalShipsGpuRenderDrawDuration.Update(toDuration(GpuTimerSegmentType::Ships));
+
+            mPerfStats.TotalNotificationsGpuRenderDrawDuration.Update(toDuration(GpuTimerSegmentType::Notifications));
+        }
+    }
+}
+
 }
\ No newline at end of file
@@ -21,6 +21,7 @@
 
 #include <GameOpenGL/GameOpenGL.h>
 #include <GameOpenGL/GameOpenGLMappedBuffer.h>
+#include <GameOpenGL/GameOpenGLTimerQueries.h>
 #include <GameOpenGL/ShaderManager.h>
 
 #include <Game/GameParameters.h>
@@ -28,7 +29,9 @@
 
 #include <GameCore/AABB.h>
 #include <GameCore/BoundedVector.h>
+#include <GameCore/Buffer.h>
 #include <GameCore/Colors.h>
+#include <GameCore/CommandRingThread.h>
 #include <GameCore/GameTypes.h>
 #include <GameCore/ImageData.h>
 #include <GameCore/ProgressCallback.h>
@@ -545,6 +548,21 @@ public:
         mVectorFieldLengthMultiplier = vectorFieldLengthMultiplier;
     }
 
+    /*
+     * The fraction (0.0 -> 1.0) of the current simulation step that has elapsed at
+     * the time of the upload; point positions are interpolated between the previous
+     * step (0.0) and the current step (1.0).
+     */
+    float GetPointPositionInterpolationFactor() const
+    {
+        return mPointPositionInterpolationFactor;
+    }
+
+    void SetPointPositionInterpolationFactor(float pointPositionInterpolationFactor)
+    {
+        mPointPositionInterpolationFactor = pointPositionInterpolationFactor;
+    }
+
     DebugShipRenderModeType GetDebugShipRenderMode() const
     {
         return mRenderParameters.DebugShipRenderMode;
@@ -632,6 +650,15 @@ public:
         size_t pointCount,
         RgbaImageData texture);
 
+    /*
+     * Replaces the render context of an existing ship, e.g. after the ship has been
+     * split into fragments.
+     */
+    void ReplaceShip(
+        ShipId shipId,
+        size_t pointCount,
+        RgbaImageData texture);
+
     inline ShipRenderContext & GetShipRenderContext(ShipId shipId) const
     {
         assert(shipId >= 0 && shipId < mShips.size());
@@ -648,6 +675,14 @@ public:
 
     RgbImageData TakeScreenshot();
 
+    /*
+     * Tells whether any render parameter has changed since the last frame was drawn.
+     */
+    bool AreRenderParametersDirty() const
+    {
+        return mRenderParameters.IsDirty();
+    }
+
 public:
 
     void UpdateStart();
@@ -658,11 +693,9 @@ public:
 
     void UploadStart();
 
-    inline void UploadStarsStart(
-        size_t uploadCount,
-        size_t totalCount)
+    inline void UploadStarsStart(size_t starCount)
     {
-        mWorldRenderContext->UploadStarsStart(uploadCount, totalCount);
+        mWorldRenderContext->UploadStarsStart(starCount);
     }
 
     inline void UploadStar(
@@ -681,6 +714,15 @@ public:
         mWorldRenderContext->UploadStarsEnd();
     }
 
+    inline void UploadMovingStar(
+        vec2f const & positionNdc,
+        float brightness)
+    {
+        mWorldRenderContext->UploadMovingStar(
+            positionNdc,
+            brightness);
+    }
+
     inline void UploadWind(vec2f speed)
     {
         float const smoothedWindMagnitude = mWindSpeedMagnitudeRunningAverage.Update(speed.x);
@@ -716,30 +758,28 @@ public:
 
     inline void UploadBackgroundLightning(
         float ndcX,
-        float progress,
-        float renderProgress,
+        float startTime, // GameWallClock time
+        float duration,
         float personalitySeed)
     {
         mWorldRenderContext->UploadBackgroundLightning(
             ndcX,
-            progress,
-            renderProgress,
-            personalitySeed,
-            mRenderParameters);
+            startTime,
+            duration,
+            personalitySeed);
     }
 
     inline void UploadForegroundLightning(
         vec2f tipWorldCoordinates,
-        float progress,
-        float renderProgress,
+        float startTime, // GameWallClock time
+        float duration,
         float personalitySeed)
     {
         mWorldRenderContext->UploadForegroundLightning(
             tipWorldCoordinates,
-            progress,
-            renderProgress,
-            personalitySeed,
-            mRenderParameters);
+            startTime,
+            duration,
+            personalitySeed);
     }
 
     inline void UploadLightningsEnd()
@@ -797,9 +837,25 @@ public:
         mWorldRenderContext->UploadLandEnd();
     }
 
+    /*
+     * Changes the height of a slice of the last-uploaded land, in lieu of
+     * re-uploading all of it.
+     */
+    inline void UploadLandUpdate(
+        size_t sliceIndex,
+        float yLand)
+    {
+        mWorldRenderContext->UploadLandUpdate(
+            sliceIndex,
+            yLand,
+            mRenderParameters);
+    }
+
     inline void UploadOceanBasicStart(size_t slices)
     {
-        mWorldRenderContext->UploadOceanBasicStart(slices);
+        mWorldRenderContext->UploadOceanBasicStart(
+            slices,
+            mRenderParameters);
     }
 
     inline void UploadOceanBasic(
@@ -808,8 +864,7 @@ public:
     {
         mWorldRenderContext->UploadOceanBasic(
             x,
-            yOcean,
-            mRenderParameters);
+            yOcean);
     }
 
     inline void UploadOceanBasicEnd()
@@ -819,7 +874,9 @@ public:
 
     inline void UploadOceanDetailedStart(size_t slices)
     {
-        mWorldRenderContext->UploadOceanDetailedStart(slices);
+        mWorldRenderContext->UploadOceanDetailedStart(
+            slices,
+            mRenderParameters);
     }
 
     inline void UploadOceanDetailed(
@@ -834,8 +891,7 @@ public:
             yBack,
             yMid,
             yFront,
-            d2YFront,
-            mRenderParameters);
+            d2YFront);
     }
 
     inline void UploadOceanDetailedEnd()
@@ -919,103 +975,112 @@ public:
         // Nop
     }
 
-    // Upload is Asynchronous - buffer may not be used until the
-    // next UpdateStart
+    // Upload is Asynchronous - the buffer is a snapshot of the elements in
+    // [startDst, startDst + count), at the same indices, which is released
+    // once uploaded
     inline void UploadShipPointColorsAsync(
         ShipId shipId,
-        vec4f const * color,
+        std::shared_ptr<Buffer<vec4f>> color,
         size_t startDst,
         size_t count)
     {
         assert(shipId >= 0 && shipId < mShips.size());
 
         // Run upload asynchronously
-        mRenderThread.QueueTask(
-            [=]()
+        mRenderThread->QueueTask(
+            [=, color = std::move(color)]()
             {
                 mShips[shipId]->UploadPointColors(
-                    color,
+                    color->data() + startDst,
                     startDst,
                     count);
             });
     }
 
-    // Upload is Asynchronous - buffer may not be used until the
-    // next UpdateStart
+    // Upload is Asynchronous - the buffer is a snapshot of the elements in
+    // [startDst, startDst + count), at the same indices, which is released
+    // once uploaded
     inline void UploadShipPointTemperatureAsync(
         ShipId shipId,
-        float const * temperature,
+        std::shared_ptr<Buffer<float>> temperature,
         size_t startDst,
         size_t count)
     {
         assert(shipId >= 0 && shipId < mShips.size());
 
         // Run upload asynchronously
-        mRenderThread.QueueTask(
-            [=]()
+        mRenderThread->QueueTask(
+            [=, temperature = std::move(temperature)]()
             {
                 mShips[shipId]->UploadPointTemperature(
-                    temperature,
+                    temperature->data() + startDst,
                     startDst,
                     count);
             });
     }
 
-    // Upload is Asynchronous - buffer may not be used until the
-    // next UpdateStart
+    // Upload is Asynchronous - the buffer is a snapshot of the elements in
+    // [startDst, startDst + count), at the same indices, which is released
+    // once uploaded
     inline void UploadShipPointStressAsync(
         ShipId shipId,
-        float const * stress,
+        std::shared_ptr<Buffer<float>> stress,
         size_t startDst,
         size_t count)
     {
         assert(shipId >= 0 && shipId < mShips.size());
 
         // Run upload asynchronously
-        mRenderThread.QueueTask(
-            [=]()
+        mRenderThread->QueueTask(
+            [=, stress = std::move(stress)]()
             {
                 mShips[shipId]->UploadPointStress(
-                    stress,
+                    stress->data() + startDst,
                     startDst,
                     count);
             });
     }
 
-    // Upload is Asynchronous - buffer may not be used until the
-    // next UpdateStart
+    // Upload is Asynchronous - the buffer is a snapshot of the elements in
+    // [startDst, startDst + count), at the same indices, which is released
+    // once uploaded
     inline void UploadShipPointAuxiliaryDataAsync(
         ShipId shipId,
-        float const * auxiliaryData,
+        std::shared_ptr<Buffer<float>> auxiliaryData,
         size_t startDst,
         size_t count)
     {
         assert(shipId >= 0 && shipId < mShips.size());
 
         // Run upload asynchronously
-        mRenderThread.QueueTask(
-            [=]()
+        mRenderThread->QueueTask(
+            [=, auxiliaryData = std::move(auxiliaryData)]()
             {
                 mShips[shipId]->UploadPointAuxiliaryData(
-                    auxiliaryData,
+                    auxiliaryData->data() + startDst,
                     startDst,
                     count);
             });
     }
 
-    // Upload is Asynchronous - buffer may not be used until the
-    // next UpdateStart
+    // Upload is Asynchronous - the buffer is a snapshot of the colors,
+    // which is released once uploaded
     inline void UploadShipPointFrontierColorsAsync(
         ShipId shipId,
-        FrontierColor const * colors)
+        std::shared_ptr<Buffer<FrontierColor>> colors,
+        size_t startDst,
+        size_t count)
     {
         assert(shipId >= 0 && shipId < mShips.size());
 
         // Run upload asynchronously
-        mRenderThread.QueueTask(
-            [=]()
+        mRenderThread->QueueTask(
+            [=, colors = std::move(colors)]()
             {
-                mShips[shipId]->UploadPointFrontierColors(colors);
+                mShips[shipId]->UploadPointFrontierColors(
+                    colors->data() + startDst,
+                    startDst,
+                    count);
             });
     }
 
@@ -1047,6 +1112,35 @@ private:
 
     vec3f CalculateShipWaterColor() const;
 
+    // The segments of a frame whose GPU time we measure
+    enum class GpuTimerSegmentType : size_t
+    {
+        WorldBackground = 0,
+        Ships,
+        WorldForeground,
+        Notifications, // Including text
+
+        _Last = Notifications
+    };
+
+    inline void BeginGpuTimerSegment(GpuTimerSegmentType segment)
+    {
+        if (mGpuTimerQueries)
+        {
+            mGpuTimerQueries->BeginSegment(static_cast<size_t>(segment));
+        }
+    }
+
+    inline void EndGpuTimerSegment()
+    {
+        if (mGpuTimerQueries)
+        {
+            mGpuTimerQueries->EndSegment();
+        }
+    }
+
+    void UpdateGpuPerfStats();
+
 private:
 
     //
@@ -1059,13 +1153,19 @@ private:
     // Render Thread
     //
 
-    // The thread running all of our OpenGL calls
-    TaskThread mRenderThread;
+    // The thread running all of our OpenGL calls; re-created without
+    // a real thread when the render thread fails its self-test.
+    // Fed via a lock-free ring, so that the many tasks we queue at each
+    // frame require neither allocations nor locks
+    std::unique_ptr<CommandRingThread> mRenderThread;
 
-    // The asynchronous rendering tasks from the previous iteration,
+    // The asynchronous rendering task from the previous iteration,
     // which we have to wait for before proceeding further
-    TaskThread::TaskCompletionIndicator mLastRenderUploadEndCompletionIndicator;
-    TaskThread::TaskCompletionIndicator mLastRenderDrawCompletionIndicator;
+    std::optional<CommandRingThread::Ticket> mLastRenderDrawTicket;
+
+    // The thread compressing ship textures after they've been uploaded uncompressed;
+    // outlives the ships, which check on their compressions
+    std::unique_ptr<TaskThread> mTextureCompressionThread;
 
     //
     // Shader manager
@@ -1094,6 +1194,7 @@ private:
     rgbColor mShipDefaultWaterColor;
     VectorFieldRenderModeType mVectorFieldRenderMode;
     float mVectorFieldLengthMultiplier; // Storage
+    float mPointPositionInterpolationFactor;
 
 
     //
@@ -1125,6 +1226,9 @@ private:
 
     PerfStats & mPerfStats;
     std::atomic<RenderStatistics> mRenderStats;
+
+    // Only when supported
+    std::unique_ptr<GameOpenGLTimerQueries<static_cast<size_t>(GpuTimerSegmentType::_Last) + 1>> mGpuTimerQueries;
 };
 
 }
\ No newline at end of file
@@ -64,6 +64,27 @@ RenderParameters::RenderParameters(
 {
 }
 
+bool RenderParameters::IsDirty() const
+{
+	return IsViewDirty
+		|| IsCanvasSizeDirty
+		|| IsEffectiveAmbientLightIntensityDirty
+		|| IsFlatSkyColorDirty
+		|| IsOceanDarkeningRateDirty
+		|| AreOceanRenderModeParametersDirty
+		|| IsOceanTextureIndexDirty
+		|| AreLandRenderParametersDirty
+		|| IsLandTextureIndexDirty
+		|| IsShipAmbientLightSensitivityDirty
+		|| IsFlatLampLightColorDirty
+		|| IsShipWaterColorDirty
+		|| IsShipWaterContrastDirty
+		|| IsShipWaterLevelOfDetailDirty
+		|| IsHeatSensitivityDirty
+		|| AreShipStructureRenderModeSelectorsDirty
+		|| IsDisplayUnitsSystemDirty;
+}
+
 RenderParameters RenderParameters::TakeSnapshotAndClear()
 {
 	// Make copy
@@ -96,6 +96,8 @@ struct RenderParameters
         DisplayLogicalSize const & initialCanvasSize,
         int logicalToPhysicalDisplayFactor);
 
+    bool IsDirty() const;
+
     RenderParameters TakeSnapshotAndClear();
 };
 
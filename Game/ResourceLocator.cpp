@@ -71,6 +71,42 @@ std::filesystem::path ResourceLocator::GetMaterialTextureFilePath(std::string co
     return GetTexturesRootFolderPath() / "Material" / (materialTextureName + ".png");
 }
 
+std::filesystem::path ResourceLocator::GetTextureAtlasCacheFolderPath() const
+{
+    // Not in our installation folder, which might not be writable
+    return std::filesystem::temp_directory_path() / "FloatingSandbox" / "AtlasCache";
+}
+
+std::filesystem::path ResourceLocator::GetShipPreviewThumbnailStoreFilePath() const
+{
+    // Not in our installation folder, which might not be writable
+    return std::filesystem::temp_directory_path() / "FloatingSandbox" / "ShipPreviewThumbnails.pack";
+}
+
+std::filesystem::path ResourceLocator::GetMaterialThumbnailStoreFilePath() const
+{
+    // Not in our installation folder, which might not be writable
+    return std::filesystem::temp_directory_path() / "FloatingSandbox" / "MaterialThumbnails.pack";
+}
+
+std::filesystem::path ResourceLocator::GetShipFactoryCacheFolderPath() const
+{
+    // Not in our installation folder, which might not be writable
+    return std::filesystem::temp_directory_path() / "FloatingSandbox" / "ShipFactoryCache";
+}
+
+std::filesystem::path ResourceLocator::GetComputerCalibrationFilePath() const
+{
+    // Not in our installation folder, which might not be writable
+    return std::filesystem::temp_directory_path() / "FloatingSandbox" / "ComputerCalibration.json";
+}
+
+std::filesystem::path ResourceLocator::GetShaderProgramBinaryCacheFolderPath(std::string const & shaderSetName) const
+{
+    // Not in our installation folder, which might not be writable
+    return std::filesystem::temp_directory_path() / "FloatingSandbox" / "ShaderCache" / shaderSetName;
+}
+
 ////////////////////////////////////////////////////////////////////////////////////////////
 // Fonts
 ////////////////////////////////////////////////////////////////////////////////////////////
@@ -100,6 +136,12 @@ std::filesystem::path ResourceLocator::GetMaterialDatabaseRootFilePath() const
     return MakeAbsolutePath(std::filesystem::path("Data"));
 }
 
+std::filesystem::path ResourceLocator::GetCompiledMaterialDatabaseFilePath() const
+{
+    // Not in our installation folder, which might not be writable
+    return std::filesystem::temp_directory_path() / "FloatingSandbox" / "MaterialDatabase.bin";
+}
+
 ////////////////////////////////////////////////////////////////////////////////////////////
 // Music
 ////////////////////////////////////////////////////////////////////////////////////////////
@@ -42,6 +42,18 @@ public:
 
     std::filesystem::path GetMaterialTextureFilePath(std::string const & materialTextureName) const;
 
+    std::filesystem::path GetTextureAtlasCacheFolderPath() const;
+
+    std::filesystem::path GetShipPreviewThumbnailStoreFilePath() const;
+
+    std::filesystem::path GetMaterialThumbnailStoreFilePath() const;
+
+    std::filesystem::path GetShipFactoryCacheFolderPath() const;
+
+    std::filesystem::path GetComputerCalibrationFilePath() const;
+
+    std::filesystem::path GetShaderProgramBinaryCacheFolderPath(std::string const & shaderSetName) const;
+
 
     //
     // Fonts
@@ -56,6 +68,8 @@ public:
 
     std::filesystem::path GetMaterialDatabaseRootFilePath() const;
 
+    std::filesystem::path GetCompiledMaterialDatabaseFilePath() const;
+
 
     //
     // Music
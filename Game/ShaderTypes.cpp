@@ -377,6 +377,54 @@ std::string ProgramTypeToStr(ProgramType program)
     throw GameException("Unsupported ProgramType");
 }
 
+bool IsLazilyCompiledProgram(ProgramType program)
+{
+    switch (program)
+    {
+        // Debug views
+        case ProgramType::AABBs:
+        case ProgramType::ShipCenters:
+        case ProgramType::ShipFrontierEdges:
+        case ProgramType::ShipSpringsDecay:
+        case ProgramType::ShipSpringsInternalPressure:
+        case ProgramType::ShipSpringsStrength:
+        case ProgramType::ShipTrianglesDecay:
+        case ProgramType::ShipTrianglesInternalPressure:
+        case ProgramType::ShipTrianglesStrength:
+        case ProgramType::ShipVectors:
+
+        // Heat and stress render modes
+        case ProgramType::ShipPointsColorStress:
+        case ProgramType::ShipPointsColorHeatOverlay:
+        case ProgramType::ShipPointsColorHeatOverlayStress:
+        case ProgramType::ShipPointsColorIncandescenceStress:
+        case ProgramType::ShipRopesStress:
+        case ProgramType::ShipRopesHeatOverlay:
+        case ProgramType::ShipRopesHeatOverlayStress:
+        case ProgramType::ShipRopesIncandescenceStress:
+        case ProgramType::ShipSpringsColorStress:
+        case ProgramType::ShipSpringsColorHeatOverlay:
+        case ProgramType::ShipSpringsColorHeatOverlayStress:
+        case ProgramType::ShipSpringsColorIncandescenceStress:
+        case ProgramType::ShipSpringsTextureStress:
+        case ProgramType::ShipSpringsTextureHeatOverlay:
+        case ProgramType::ShipSpringsTextureHeatOverlayStress:
+        case ProgramType::ShipSpringsTextureIncandescenceStress:
+        case ProgramType::ShipTrianglesColorStress:
+        case ProgramType::ShipTrianglesColorHeatOverlay:
+        case ProgramType::ShipTrianglesColorHeatOverlayStress:
+        case ProgramType::ShipTrianglesColorIncandescenceStress:
+        case ProgramType::ShipTrianglesTextureStress:
+        case ProgramType::ShipTrianglesTextureHeatOverlay:
+        case ProgramType::ShipTrianglesTextureHeatOverlayStress:
+        case ProgramType::ShipTrianglesTextureIncandescenceStress:
+            return true;
+
+        default:
+            return false;
+    }
+}
+
 ProgramParameterType StrToProgramParameterType(std::string const & str)
 {
     if (str == "AtlasTile1Dx")
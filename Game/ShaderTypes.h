@@ -113,6 +113,9 @@ ProgramType ShaderFilenameToProgramType(std::string const & str);
 
 std::string ProgramTypeToStr(ProgramType program);
 
+// Rarely-used programs, which are only compiled the first time they are used
+bool IsLazilyCompiledProgram(ProgramType program);
+
 enum class ProgramParameterType : uint8_t
 {
     AtlasTile1Dx = 0,
@@ -296,6 +299,7 @@ struct ShaderManagerTraits
 
     static constexpr auto ShaderFilenameToProgramType = Render::ShaderFilenameToProgramType;
     static constexpr auto ProgramTypeToStr = Render::ProgramTypeToStr;
+    static constexpr auto IsLazilyCompiledProgram = Render::IsLazilyCompiledProgram;
     static constexpr auto StrToProgramParameterType = Render::StrToProgramParameterType;
     static constexpr auto ProgramParameterTypeToStr = Render::ProgramParameterTypeToStr;
     static constexpr auto StrToVertexAttributeType = Render::StrToVertexAttributeType;
@@ -13,6 +13,8 @@
 #include <GameCore/GameMath.h>
 #include <GameCore/GameRandomEngine.h>
 #include <GameCore/Log.h>
+#include <GameCore/Profiler.h>
+#include <GameCore/StaggeredScheduler.h>
 
 #include <algorithm>
 #include <array>
@@ -21,6 +23,7 @@
 #include <limits>
 #include <queue>
 #include <set>
+#include <tuple>
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////
 //
@@ -28,29 +31,68 @@
 //
 // While most physics updates run for every simulation step (i.e. for each frame), a few
 // more expensive ones run only every nth step. In order to improve omogeneity of runtime,
-// we distribute all of these low-frequency updates across the low-frequency period.
+// we distribute all of these low-frequency updates across the low-frequency period,
+// interleaving the partitions of all stages.
 //
-// We have the following:
-// CombustionStateMachineSlow x 4
-// RotPoints x 4
-// SpringDecayAndTemperature x 4
-// UpdateSinking x 1
-
-static int constexpr CombustionStateMachineSlowStep1 = 2;
-static int constexpr SpringDecayAndTemperatureStep1 = 5;
-static int constexpr RotPointsStep1 = 8;
-static int constexpr CombustionStateMachineSlowStep2 = 11;
-static int constexpr SpringDecayAndTemperatureStep2 = 14;
-static int constexpr RotPointsStep2 = 17;
-static int constexpr UpdateSinkingStep = 18;
-static int constexpr CombustionStateMachineSlowStep3 = 20;
-static int constexpr SpringDecayAndTemperatureStep3 = 23;
-static int constexpr RotPointsStep3 = 26;
-static int constexpr CombustionStateMachineSlowStep4 = 29;
-static int constexpr SpringDecayAndTemperatureStep4 = 32;
-static int constexpr RotPointsStep4 = 35;
-
-static_assert(RotPointsStep4 < GameParameters::ParticleUpdateLowFrequencyPeriod);
+
+enum LowFrequencyStage : size_t
+{
+    CombustionStateMachineSlowStage = 0,
+    SpringDecayAndTemperatureStage,
+    RotPointsStage,
+    UpdateSinkingStage
+};
+
+static StaggeredScheduler const LowFrequencyScheduler(
+    GameParameters::ParticleUpdateLowFrequencyPeriod,
+    {
+        4, // CombustionStateMachineSlow
+        4, // SpringDecayAndTemperature
+        4, // RotPoints
+        1  // UpdateSinking
+    });
+
+// The minimum number of springs that make it worth to relax a partition of springs
+// on a separate thread
+static size_t constexpr MinSpringsPerSpringRelaxationPartition = 8192;
+
+// The minimum number of springs that need to have been destroyed since the last
+// spring compaction before we compact them again
+static ElementCount constexpr MinDestroyedSpringsForCompaction = 1024;
+
+// The minimum number of points that make it worth to update water and pressure concurrently,
+// and the number of points in each concurrent chunk
+static ElementCount constexpr MinPointsForConcurrentWaterAndPressureUpdate = 8192;
+static size_t constexpr WaterAndPressureUpdatePointGrain = 1024;
+static size_t constexpr WorldForcesPointGrain = 2048;
+
+// The maximum number of endpoints of destroyed springs for which we maintain connected
+// components incrementally, rather than by visiting all points again
+static size_t constexpr MaxConnectivityVisitSeedPoints = 4096;
+
+// The minimum number of points that make it worth to diffuse light to a partition of points
+// on a separate thread
+static ElementCount constexpr MinPointsPerLightDiffusionPartition = 2048;
+
+// The differences between the temperature of a point and that of its environment
+// above which the point starts taking part in heat propagation, and below which it
+// eventually stops; and the number of steps over which all points are checked for
+// having drifted away from the temperature of their environment
+static float constexpr HotPointEnterTemperatureDelta = 0.1f;
+static float constexpr HotPointLeaveTemperatureDelta = 0.01f;
+static ElementCount constexpr HotPointsSweepPeriod = 64;
+
+// When heat propagates implicitly: the number of simulation steps between propagations,
+// aligned with the low-frequency period; and the number of solver sweeps at each propagation
+static std::uint32_t constexpr ImplicitHeatPropagationPeriod = 4;
+static_assert(GameParameters::ParticleUpdateLowFrequencyPeriod % ImplicitHeatPropagationPeriod == 0);
+static int constexpr ImplicitHeatPropagationIterations = 4;
+
+// The height of the visible world up to which all of the requested ephemeral particles
+// are spawned; when zoomed out beyond this, particles are thinned out proportionally,
+// down to the minimum level of detail
+static float constexpr EphemeralParticleFullDetailVisibleWorldHeight = 140.0f; // Zoom=1
+static float constexpr MinEphemeralParticleLevelOfDetail = 0.25f;
 
 /////////////////////////////////////////////////////////////////////////////////////////////////////////
 /////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -85,11 +127,17 @@ Ship::Ship(
     , mGameEventHandler(std::move(gameEventDispatcher))
     , mTaskThreadPool(std::move(taskThreadPool))
     , mEventRecorder(nullptr)
+    , mStageObserver()
+    , mUpdateTaskGraph()
+    , mUpdateTaskGraphArguments()
+    , mShipCollisionCandidatePoints()
+    , mShipContactPartitions()
     , mPoints(std::move(points))
     , mSprings(std::move(springs))
     , mTriangles(std::move(triangles))
     , mElectricalElements(std::move(electricalElements))
     , mFrontiers(std::move(frontiers))
+    , mHasElectricalElements(mElectricalElements.GetElementCount() > 0)
     , mPinnedPoints(
         mParentWorld,
         mGameEventHandler,
@@ -105,12 +153,18 @@ Ship::Ship(
         *this,
         mPoints,
         mSprings)
+    , mNPCs()
     , mOverlays()
     , mCurrentSimulationSequenceNumber()
     , mCurrentConnectivityVisitSequenceNumber()
     , mMaxMaxPlaneId(0)
     , mCurrentElectricalVisitSequenceNumber()
     , mConnectedComponentSizes()
+    , mConnectedComponentTriangleCounts()
+    , mConnectivityVisitSeedPoints()
+    , mIsFullConnectivityVisitRequired(true)
+    , mConnectivityFronts()
+    , mConnectivityFrontOfPoint()
     , mIsStructureDirty(true)
     , mDamagedPointsCount(0)
     , mBrokenSpringsCount(0)
@@ -120,17 +174,67 @@ Ship::Ship(
     , mLastLuminiscenceAdjustmentDiffused(-1.0f)
     , mRepairGracePeriodMultiplier(1.0f)
     , mLastQueriedPointIndex(NoneElementIndex)
-    , mWindField()
     , mAirBubblesCreatedCount(0)
     // Static pressure
-    , mStaticPressureBuffer(mPoints.GetAlignedShipPointCount())
+    , mStaticPressureExternalFrontierIds()
+    , mStaticPressurePartitions()
     , mStaticPressureNetForceMagnitudeSum(0.0f)
     , mStaticPressureNetForceMagnitudeCount(0.0f)
     , mStaticPressureIterationsPercentagesSum(0.0f)
     , mStaticPressureIterationsCount(0.0f)
+    // Spring relaxation
+    , mSpringRelaxationParallelism(1)
+    , mSpringRelaxationTasks()
+    , mSpringRelaxationDynamicForceBuffers()
+    , mSpringForcesKernel(SpringForcesKernelType::Vectorized)
+    // Concurrent water and pressure update
+    , mColouredPoints()
+    , mPointColourStarts()
+    , mSpringOutboundQuantitiesOfWater()
+    , mSpringOutboundWaterVelocities()
+    // Sparse water and heat propagation
+    , mPointNeighborhood()
+    , mIsPointInNeighborhood()
+    // Implicit heat propagation
+    , mHeatSolverLocalIndices()
+    , mHeatSolverEnvironmentTemperatures()
+    , mHeatSolverEnvironmentCoefficients()
+    , mHeatSolverTemperatures()
+    , mHeatSolverRightHandSides()
+    , mHeatSolverDiagonalReciprocals()
+    , mHeatSolverRowStarts()
+    , mHeatSolverCouplingLocalIndices()
+    , mHeatSolverCouplingCoefficients()
+    , mHeatSolverBoundaryCouplings()
+    // Light diffusion
+    , mLightDiffusionPartitions()
+    , mNextHotPointsSweepPointIndex(0)
+    // Sleeping connected components
+    , mConnectedComponentSleepStates()
+    , mSleepingConnectedComponentCount(0)
+    , mSleepingPointPositions(mPoints.GetRawShipPointCount(), vec2f::zero())
+    , mSleepingPointStaticForces(mPoints.GetRawShipPointCount(), vec2f::zero())
+    , mAwakeSpringRanges()
+    // Spring compaction
+    , mDestroyedSpringsSinceLastCompactionCount(0)
+    // Repair
+    , mRepairPointsInRadius()
+    , mRepairDeferredAttractors()
+    , mRepairDeferredAttractorsStepId()
+    , mRepairCurrentDeferredAttractors()
+    // Bulk detach
+    , mIsBulkDetaching(false)
+    , mBulkDetachDebrisSourcePoints()
+    , mBulkDetachDestroyEvents()
+    , mIsBulkRestoring(false)
+    , mWasDamagedAtBulkRestoreStart(false)
+    // Rope constraints
+    , mRopeSpringIndices()
     // Render
     , mLastUploadedDebugShipRenderMode()
     , mPlaneTriangleIndicesToRender()
+    , mIsTriangleLayoutDirty(true)
+    , mTrianglesToTombstone()
 {
     mPlaneTriangleIndicesToRender.reserve(mTriangles.GetElementCount());
 
@@ -140,6 +244,104 @@ Ship::Ship(
     mTriangles.RegisterShipPhysicsHandler(this);
     mElectricalElements.RegisterShipPhysicsHandler(this);
 
+    //
+    // Prepare spring relaxation partitions
+    //
+
+    ElementCount const springCount = mSprings.GetElementCount();
+
+    mSpringRelaxationParallelism = std::max(
+        std::min(
+            mTaskThreadPool->GetParallelism(),
+            static_cast<size_t>(springCount) / MinSpringsPerSpringRelaxationPartition),
+        size_t(1));
+
+    LogMessage("Ship::Ship(): spring relaxation parallelism: ", mSpringRelaxationParallelism);
+
+    if (mSpringRelaxationParallelism > 1)
+    {
+        // Partitions are carved out at each run, as the range of springs
+        // that need to be simulated shrinks when springs are compacted
+
+        for (size_t p = 0; p < mSpringRelaxationParallelism; ++p)
+        {
+            if (p == 0)
+            {
+                // First partition writes directly into the points' dynamic force buffer
+                mSpringRelaxationTasks.emplace_back(
+                    [this, p]()
+                    {
+                        auto const [startSpringIndex, endSpringIndex] = GetSpringRelaxationPartition(p);
+
+                        ApplyAwakeSpringsForces(
+                            startSpringIndex,
+                            endSpringIndex,
+                            mPoints.GetDynamicForceBufferAsVec2());
+                    });
+            }
+            else
+            {
+                // Other partitions write into their own dynamic force buffers
+                mSpringRelaxationDynamicForceBuffers.emplace_back(
+                    mPoints.GetBufferElementCount(),
+                    0,
+                    vec2f::zero());
+
+                size_t const bufferIndex = mSpringRelaxationDynamicForceBuffers.size() - 1;
+
+                mSpringRelaxationTasks.emplace_back(
+                    [this, p, bufferIndex]()
+                    {
+                        auto const [startSpringIndex, endSpringIndex] = GetSpringRelaxationPartition(p);
+
+                        ApplyAwakeSpringsForces(
+                            startSpringIndex,
+                            endSpringIndex,
+                            mSpringRelaxationDynamicForceBuffers[bufferIndex].data());
+                    });
+            }
+        }
+    }
+
+    //
+    // Prepare light diffusion partitions
+    //
+
+    if (mElectricalElements.GetLampCount() > 0)
+    {
+        ElementCount const pointCount = mPoints.GetAlignedShipPointCount();
+
+        size_t const lightDiffusionParallelism = std::max(
+            std::min(
+                mTaskThreadPool->GetParallelism(),
+                static_cast<size_t>(pointCount / MinPointsPerLightDiffusionPartition)),
+            size_t(1));
+
+        // Partitions need to be aligned to the vectorization float count
+        ElementCount const pointsPerPartition = make_aligned_float_element_count(
+            pointCount / static_cast<ElementCount>(lightDiffusionParallelism));
+
+        for (ElementIndex startPointIndex = 0; startPointIndex < pointCount; startPointIndex += pointsPerPartition)
+        {
+            mLightDiffusionPartitions.emplace_back(
+                startPointIndex,
+                std::min(startPointIndex + pointsPerPartition, pointCount),
+                mElectricalElements.GetBufferLampCount());
+        }
+    }
+
+    //
+    // Prepare rope constraints
+    //
+
+    RecalculateRopeSpringIndices();
+
+    //
+    // Prepare update graph
+    //
+
+    BuildUpdateTaskGraph();
+
     // Finalize
     Finalize();
 }
@@ -150,6 +352,119 @@ void Ship::Announce()
     mElectricalElements.AnnounceInstancedElements();
 }
 
+ShipMemoryReport Ship::GetMemoryReport() const
+{
+    return ShipMemoryReport(
+        mId,
+        mPoints.GetElementCount(),
+        mPoints.GetByteSize(),
+        mSprings.GetElementCount(),
+        mSprings.GetByteSize(),
+        mTriangles.GetElementCount(),
+        mTriangles.GetByteSize(),
+        mElectricalElements.GetElementCount(),
+        mElectricalElements.GetByteSize());
+}
+
+static std::uint32_t constexpr StateSectionTag = 0x53504853; // SHPS
+
+void Ship::SaveState(StateSnapshotWriter & writer) const
+{
+    writer.BeginSection(StateSectionTag);
+    writer.Archive(mId);
+
+    ArchiveState(*this, writer);
+}
+
+void Ship::LoadState(StateSnapshotReader & reader)
+{
+    reader.BeginSection(StateSectionTag);
+
+    ShipId shipId;
+    reader.Archive(shipId);
+    if (shipId != mId)
+    {
+        throw GameException("The snapshot does not match the world being restored");
+    }
+
+    //
+    // Remove all that is not part of the snapshot; gadgets are removed
+    // while the points still have the state they have been attached to
+    //
+
+    mGadgets.RemoveAllGadgets();
+    mElectricSparks.Reset();
+    mNPCs.Clear();
+    mStateMachines.clear();
+    mQueuedInteractions.clear();
+    mRepairDeferredAttractors.clear();
+    mRepairCurrentDeferredAttractors.clear();
+
+    ArchiveState(*this, reader);
+
+    //
+    // The gadgets of the snapshot are gone, hence forget their masses
+    //
+
+    for (auto const pointIndex : mPoints)
+    {
+        if (mPoints.IsGadgetAttached(pointIndex))
+        {
+            mPoints.DetachGadget(pointIndex, mSprings);
+        }
+    }
+
+    //
+    // Re-derive all that is derived from the state
+    //
+
+    RecalculateRopeSpringIndices();
+
+    if (mSleepingConnectedComponentCount > 0)
+    {
+        RecalculateAwakeSpringRanges();
+    }
+
+    mIsStructureDirty = true;
+    mIsFullConnectivityVisitRequired = true;
+    mLastLuminiscenceAdjustmentDiffused = -1.0f;
+    mLastUploadedDebugShipRenderMode.reset();
+}
+
+template<typename TSelf, typename TArchive>
+void Ship::ArchiveState(
+    TSelf & self,
+    TArchive & archive)
+{
+    archive.ArchiveContainer(self.mPoints);
+    archive.ArchiveContainer(self.mSprings);
+    archive.ArchiveContainer(self.mTriangles);
+    archive.ArchiveContainer(self.mElectricalElements);
+    archive.ArchiveContainer(self.mFrontiers);
+    archive.ArchiveContainer(self.mPinnedPoints);
+
+    archive.Archive(self.mCurrentSimulationSequenceNumber);
+    archive.Archive(self.mCurrentConnectivityVisitSequenceNumber);
+    archive.Archive(self.mMaxMaxPlaneId);
+    archive.Archive(self.mCurrentElectricalVisitSequenceNumber);
+    archive.Archive(self.mConnectedComponentSizes);
+    archive.Archive(self.mConnectedComponentTriangleCounts);
+    archive.Archive(self.mDamagedPointsCount);
+    archive.Archive(self.mBrokenSpringsCount);
+    archive.Archive(self.mBrokenTrianglesCount);
+    archive.Archive(self.mIsSinking);
+    archive.Archive(self.mWaterSplashedRunningAverage);
+    archive.Archive(self.mRepairGracePeriodMultiplier);
+    archive.Archive(self.mAirBubblesCreatedCount);
+    archive.Archive(self.mNextHotPointsSweepPointIndex);
+    archive.Archive(self.mConnectedComponentSleepStates);
+    archive.Archive(self.mSleepingConnectedComponentCount);
+    archive.Archive(self.mSleepingPointPositions);
+    archive.Archive(self.mSleepingPointStaticForces);
+    archive.Archive(self.mDestroyedSpringsSinceLastCompactionCount);
+    archive.Archive(self.mRepairDeferredAttractorsStepId);
+}
+
 Geometry::AABBSet Ship::CalculateAABBs() const
 {
     Geometry::AABBSet allAABBs;
@@ -187,6 +502,12 @@ void Ship::SetEventRecorder(EventRecorder * eventRecorder)
     mEventRecorder = eventRecorder;
 }
 
+void Ship::SetStageObserver(StageObserver observer)
+{
+    mStageObserver = std::move(observer);
+    mUpdateTaskGraph.SetTaskObserver(mStageObserver);
+}
+
 bool Ship::ReplayRecordedEvent(
     RecordedEvent const & event,
     GameParameters const & gameParameters)
@@ -210,15 +531,22 @@ void Ship::Update(
     Storm::Parameters const & stormParameters,
     GameParameters const & gameParameters,
     StressRenderModeType stressRenderMode,
+    VisibleWorld const & visibleWorld,
     Geometry::AABBSet & externalAabbSet,
     PerfStats & perfStats)
 {
+    FS_PROFILE_SCOPE("Ship::Update");
+
+    assert(mId < perfStats.Ships.size());
+    PerfStats::ShipPerfStats & shipPerfStats = perfStats.Ships[mId];
+
+    auto const updateStartTime = GameChronometer::now();
+    auto stageStartTime = updateStartTime;
+
     /////////////////////////////////////////////////////////////////
     //         This is where most of the magic happens             //
     /////////////////////////////////////////////////////////////////
 
-    std::vector<TaskThreadPool::Task> parallelTasks;
-
     /////////////////////////////////////////////////////////////////
     // At this moment:
     //  - Particle positions are within world boundaries
@@ -232,10 +560,43 @@ void Ship::Update(
     // Advance the current simulation sequence
     ++mCurrentSimulationSequenceNumber;
 
+    // The step within the low-frequency period, at which we run low-frequency stages' partitions
+    std::uint32_t const lowFrequencyStep = mCurrentSimulationSequenceNumber.GetStepOf(LowFrequencyScheduler.GetPeriod());
+
+    // Limit ephemeral particles when the simulation is degraded
+    mPoints.SetEphemeralParticleCapacity(
+        gameParameters.SimulationDegradationLevel >= 2
+        ? GameParameters::MaxEphemeralParticles / 4
+        : GameParameters::MaxEphemeralParticles);
+
+    // Spawn less ephemeral particles when they are too small to be noticed
+    mPoints.SetEphemeralParticleLevelOfDetail(
+        Clamp(
+            EphemeralParticleFullDetailVisibleWorldHeight / visibleWorld.Height,
+            MinEphemeralParticleLevelOfDetail,
+            1.0f));
+
+    // Remember the positions at the beginning of this step, from which
+    // positions are interpolated when rendering in-between steps
+    if (gameParameters.DoInterpolateRendering)
+    {
+        mPoints.SnapshotPositions();
+    }
+
+    // Compact springs if enough of them have been destroyed since the last time,
+    // so that simulation loops do not keep sweeping over dead springs
+    if (gameParameters.DoCompactDestroyedSprings
+        && mDestroyedSpringsSinceLastCompactionCount >= std::max(MinDestroyedSpringsForCompaction, mSprings.GetElementCount() / 16))
+    {
+        CompactSprings();
+    }
+
 #ifdef _DEBUG
     VerifyInvariants();
 #endif
 
+    EndStage(PerfStats::ShipUpdateStageType::Preparation, shipPerfStats, stageStartTime);
+
     ///////////////////////////////////////////////////////////////////
     // Process eventual parameter changes
     ///////////////////////////////////////////////////////////////////
@@ -245,10 +606,14 @@ void Ship::Update(
 
     mSprings.UpdateForGameParameters(
         gameParameters,
-        mPoints);
+        mPoints,
+        *mTaskThreadPool);
 
-    mElectricalElements.UpdateForGameParameters(
-        gameParameters);
+    if (mHasElectricalElements)
+    {
+        mElectricalElements.UpdateForGameParameters(
+            gameParameters);
+    }
 
     ///////////////////////////////////////////////////////////////////
     // Calculate some widely-used physical constants
@@ -266,10 +631,16 @@ void Ship::Update(
     // Recalculate current masses and everything else that derives from them
     ///////////////////////////////////////////////////////////////////
 
+    // Wake up the sleeping connected components that have been disturbed;
+    // needs to come before masses, as it changes integration factors
+    WakeUpDisturbedConnectedComponents(gameParameters);
+
     // - Inputs: Water, AugmentedMaterialMass
     // - Outputs: Mass
     mPoints.UpdateMasses(gameParameters);
 
+    EndStage(PerfStats::ShipUpdateStageType::Masses, shipPerfStats, stageStartTime);
+
     ///////////////////////////////////////////////////////////////////
     // Run spring relaxation iterations, together with integration
     // and ocean floor collision handling
@@ -283,7 +654,23 @@ void Ship::Update(
     int constexpr SeaFloorCollisionPeriod = 2;
     float const seaFloorCollisionDt = gameParameters.MechanicalSimulationStepTimeDuration<float>() * static_cast<float>(SeaFloorCollisionPeriod);
 
-    for (int iter = 0; iter < numMechanicalDynamicsIterations; ++iter)
+    // When adapting the number of iterations, we run at least a fraction of them,
+    // and stop as soon as the ship has converged; a ship under stress will never
+    // converge, and thus will run all of them; we also adapt them when the
+    // simulation is degraded
+    int constexpr MinAdaptiveMechanicalDynamicsIterationsDivisor = 4;
+    float constexpr AdaptiveMechanicalDynamicsConvergenceAcceleration = 0.1f; // m/s^2
+    int const minNumMechanicalDynamicsIterations = (gameParameters.DoAdaptMechanicalDynamicsIterations || gameParameters.SimulationDegradationLevel >= 3)
+        ? std::max(numMechanicalDynamicsIterations / MinAdaptiveMechanicalDynamicsIterationsDivisor, 1)
+        : numMechanicalDynamicsIterations;
+
+    // The max velocity change - at an iteration - below which the ship has converged
+    float const convergenceMaxVelocityDelta =
+        AdaptiveMechanicalDynamicsConvergenceAcceleration
+        * gameParameters.MechanicalSimulationStepTimeDuration<float>();
+
+    int iter = 0;
+    while (iter < numMechanicalDynamicsIterations)
     {
         // - DynamicForces = 0 | others at first iteration only
 
@@ -292,23 +679,60 @@ void Ship::Update(
 
         // - DynamicForces = fs | fs + others at first iteration only
 
-        // Integrate dynamic and static forces,
-        // and reset dynamic forces
-        IntegrateAndResetDynamicForces(gameParameters);
+        // Integrate dynamic and static forces, reset dynamic forces,
+        // and - every so often - handle collisions with sea floor,
+        // all in the same pass over the points
+        //  - Changes position and velocity
+        bool const doHandleCollisionsWithSeaFloor = ((iter % SeaFloorCollisionPeriod) == SeaFloorCollisionPeriod - 1);
+        bool hasConverged = false;
+        if (iter + 1 >= minNumMechanicalDynamicsIterations && iter + 1 < numMechanicalDynamicsIterations)
+        {
+            float const maxVelocityDelta = IntegrateAndResetDynamicForces<true>(
+                doHandleCollisionsWithSeaFloor,
+                seaFloorCollisionDt,
+                gameParameters);
+
+            hasConverged = (maxVelocityDelta < convergenceMaxVelocityDelta);
+        }
+        else
+        {
+            IntegrateAndResetDynamicForces<false>(
+                doHandleCollisionsWithSeaFloor,
+                seaFloorCollisionDt,
+                gameParameters);
+        }
 
         // - DynamicForces = 0
 
-        if ((iter % SeaFloorCollisionPeriod) == SeaFloorCollisionPeriod - 1)
+        ++iter;
+
+        if (hasConverged)
         {
-            // Handle collisions with sea floor
-            //  - Changes position and velocity
+            // Cover the time of the remaining iterations
+            ExtrapolateConvergedMechanicalDynamics(
+                numMechanicalDynamicsIterations - iter,
+                gameParameters);
+
             HandleCollisionsWithSeaFloor(
                 seaFloorCollisionDt,
                 gameParameters);
+
+            break;
         }
     }
 
+    ///////////////////////////////////////////////////////////////////
+    // Keep ropes from stretching
+    ///////////////////////////////////////////////////////////////////
+
+    // - Inputs: Position, Velocity, Mass
+    // - Outputs: Position, Velocity
+    SolveRopeConstraints();
+
+    EndStage(PerfStats::ShipUpdateStageType::MechanicalDynamics, shipPerfStats, stageStartTime);
+
     perfStats.TotalShipsSpringsUpdateDuration.Update(std::chrono::steady_clock::now() - springsStartTime);
+    perfStats.TotalShipsMechanicalDynamicsIterations.Update(static_cast<std::uint64_t>(iter));
 
     ///////////////////////////////////////////////////////////////////
     // Trim for world bounds
@@ -318,6 +742,16 @@ void Ship::Update(
     // - Outputs: Position, Velocity
     TrimForWorldBounds(gameParameters);
 
+    ///////////////////////////////////////////////////////////////////
+    // Put to sleep the connected components that have come to rest
+    ///////////////////////////////////////////////////////////////////
+
+    // - Inputs: Position, Velocity, Mass, StaticForces
+    // - Outputs: Velocity
+    PutRestingConnectedComponentsToSleep(gameParameters);
+
+    EndStage(PerfStats::ShipUpdateStageType::Sleep, shipPerfStats, stageStartTime);
+
     // We're done with changing positions for the rest of the Update() loop
 #ifdef _DEBUG
     mPoints.Diagnostic_ClearDirtyPositions();
@@ -334,18 +768,16 @@ void Ship::Update(
     // rerouting frontiers
     ///////////////////////////////////////////////////////////////////
 
-    if (stressRenderMode != StressRenderModeType::None)
-    {
-        mPoints.ResetStress();
-    }
-
     // - Inputs: P.Position, S.SpringDeletion, S.ResetLength, S.BreakingElongation
-    // - Outputs: S.Destroy(), P.Stress
+    // - Outputs: S.Destroy(), S.Stress
     // - Fires events, updates frontiers
     mSprings.UpdateForStrains(
         gameParameters,
         mPoints,
-        stressRenderMode);
+        stressRenderMode,
+        *mTaskThreadPool);
+
+    EndStage(PerfStats::ShipUpdateStageType::Strains, shipPerfStats, stageStartTime);
 
     ///////////////////////////////////////////////////////////////////
     // Reset static forces, now that we have integrated them
@@ -373,6 +805,8 @@ void Ship::Update(
         gameParameters,
         externalAabbSet);
 
+    EndStage(PerfStats::ShipUpdateStageType::WorldForces, shipPerfStats, stageStartTime);
+
     // Cached depths are valid from now on --------------------------->
 
     ///////////////////////////////////////////////////////////////////
@@ -385,6 +819,8 @@ void Ship::Update(
             effectiveAirDensity,
             effectiveWaterDensity,
             gameParameters);
+
+        EndStage(PerfStats::ShipUpdateStageType::StaticPressure, shipPerfStats, stageStartTime);
     }
 
     ///////////////////////////////////////////////////////////////////
@@ -394,33 +830,16 @@ void Ship::Update(
     // - Inputs: Position, Water, IsLeaking
     // - Output: Decay
 
-    if (mCurrentSimulationSequenceNumber.IsStepOf(RotPointsStep1, GameParameters::ParticleUpdateLowFrequencyPeriod))
-    {
-        RotPoints(
-            0, 4,
-            currentSimulationTime,
-            gameParameters);
-    }
-    else if (mCurrentSimulationSequenceNumber.IsStepOf(RotPointsStep2, GameParameters::ParticleUpdateLowFrequencyPeriod))
-    {
-        RotPoints(
-            1, 4,
-            currentSimulationTime,
-            gameParameters);
-    }
-    else if (mCurrentSimulationSequenceNumber.IsStepOf(RotPointsStep3, GameParameters::ParticleUpdateLowFrequencyPeriod))
-    {
-        RotPoints(
-            2, 4,
-            currentSimulationTime,
-            gameParameters);
-    }
-    else if (mCurrentSimulationSequenceNumber.IsStepOf(RotPointsStep4, GameParameters::ParticleUpdateLowFrequencyPeriod))
+    if (auto const partition = LowFrequencyScheduler.GetScheduledPartition(RotPointsStage, lowFrequencyStep);
+        partition.has_value())
     {
         RotPoints(
-            3, 4,
+            *partition,
+            LowFrequencyScheduler.GetPartitionCount(RotPointsStage),
             currentSimulationTime,
             gameParameters);
+
+        EndStage(PerfStats::ShipUpdateStageType::Rot, shipPerfStats, stageStartTime);
     }
 
     /////////////////////////////////////////////////////////////////
@@ -435,6 +854,8 @@ void Ship::Update(
         stormParameters,
         gameParameters);
 
+    EndStage(PerfStats::ShipUpdateStageType::Gadgets, shipPerfStats, stageStartTime);
+
     ///////////////////////////////////////////////////////////////////
     // Update state machines
     ///////////////////////////////////////////////////////////////////
@@ -443,6 +864,8 @@ void Ship::Update(
     //              Point Detach, Debris generation
     UpdateStateMachines(currentSimulationTime, gameParameters);
 
+    EndStage(PerfStats::ShipUpdateStageType::StateMachines, shipPerfStats, stageStartTime);
+
     /////////////////////////////////////////////////////////////////
     // Update water dynamics - may generate ephemeral particles
     /////////////////////////////////////////////////////////////////
@@ -469,6 +892,8 @@ void Ship::Update(
         mGameEventHandler->OnWaterTaken(waterTakenInStep);
     }
 
+    EndStage(PerfStats::ShipUpdateStageType::WaterInflow, shipPerfStats, stageStartTime);
+
     //
     // Equalize internal pressure
     //
@@ -477,6 +902,8 @@ void Ship::Update(
     // - Outpus: InternalPressure, DynamicForces
     EqualizeInternalPressure(gameParameters);
 
+    EndStage(PerfStats::ShipUpdateStageType::InternalPressure, shipPerfStats, stageStartTime);
+
     //
     // Diffuse water
     //
@@ -490,11 +917,13 @@ void Ship::Update(
     // Notify
     mGameEventHandler->OnWaterSplashed(waterSplashedInStep);
 
+    EndStage(PerfStats::ShipUpdateStageType::WaterVelocities, shipPerfStats, stageStartTime);
+
     //
     // Run sinking/unsinking detection
     //
 
-    if (mCurrentSimulationSequenceNumber.IsStepOf(UpdateSinkingStep, GameParameters::ParticleUpdateLowFrequencyPeriod))
+    if (LowFrequencyScheduler.GetScheduledPartition(UpdateSinkingStage, lowFrequencyStep).has_value())
     {
         UpdateSinking();
     }
@@ -507,193 +936,360 @@ void Ship::Update(
     // Update electrical dynamics
     ///////////////////////////////////////////////////////////////////
 
-    // Generate a new visit sequence number
-    ++mCurrentElectricalVisitSequenceNumber;
-
-    mElectricalElements.Update(
-        currentWallClockTime,
-        currentSimulationTime,
-        mCurrentElectricalVisitSequenceNumber,
-        mPoints,
-        mSprings,
-        effectiveAirDensity,
-        effectiveWaterDensity,
-        stormParameters,
-        gameParameters);
+    // - Inputs: P.Water, P.Temperature, P.CachedDepth
+    // - Outputs: EL, P.Temperature, P.StaticForce, P.WaterPumpForce
+    // - Needs the water just diffused, hence it may not run concurrently with it
 
-    ///////////////////////////////////////////////////////////////////
-    // Update heat dynamics
-    ///////////////////////////////////////////////////////////////////
+    if (mHasElectricalElements)
+    {
+        // Generate a new visit sequence number
+        ++mCurrentElectricalVisitSequenceNumber;
 
-    assert(parallelTasks.empty()); // We want this to run on the main thread
+        mElectricalElements.Update(
+            currentWallClockTime,
+            currentSimulationTime,
+            mCurrentElectricalVisitSequenceNumber,
+            mPoints,
+            mSprings,
+            effectiveAirDensity,
+            effectiveWaterDensity,
+            stormParameters,
+            gameParameters);
 
-    parallelTasks.emplace_back(
-        [&]()
-        {
-            //
-            // Propagate heat
-            //
+        EndStage(PerfStats::ShipUpdateStageType::Electricals, shipPerfStats, stageStartTime);
+    }
 
-            // - Inputs: P.Position, P.Temperature, P.ConnectedSprings, P.Water
-            // - Outputs: P.Temperature
-            PropagateHeat(
-                currentSimulationTime,
-                GameParameters::SimulationStepTimeDuration<float>,
-                stormParameters,
-                gameParameters);
+    ///////////////////////////////////////////////////////////////////
+    // Run the remaining stages as a graph, whose dependencies derive
+    // from the buffers they declare to read and write, so that
+    // independent stages run concurrently; the graph is built once,
+    // and here we only bind the arguments of this step
+    ///////////////////////////////////////////////////////////////////
 
-            //
-            // Update slow combustion state machine
-            //
+    mUpdateTaskGraphArguments.CurrentSimulationTime = currentSimulationTime;
+    mUpdateTaskGraphArguments.CurrentWallClockTimeFloat = currentWallClockTimeFloat;
+    mUpdateTaskGraphArguments.LowFrequencyStep = lowFrequencyStep;
+    mUpdateTaskGraphArguments.StormParams = &stormParameters;
+    mUpdateTaskGraphArguments.GameParams = &gameParameters;
 
-            if (mCurrentSimulationSequenceNumber.IsStepOf(CombustionStateMachineSlowStep1, GameParameters::ParticleUpdateLowFrequencyPeriod))
-            {
-                mPoints.UpdateCombustionLowFrequency(
-                    0,
-                    4,
-                    currentWallClockTimeFloat,
-                    currentSimulationTime,
-                    stormParameters,
-                    gameParameters);
-            }
-            else if (mCurrentSimulationSequenceNumber.IsStepOf(CombustionStateMachineSlowStep2, GameParameters::ParticleUpdateLowFrequencyPeriod))
-            {
-                mPoints.UpdateCombustionLowFrequency(
-                    1,
-                    4,
-                    currentWallClockTimeFloat,
-                    currentSimulationTime,
-                    stormParameters,
-                    gameParameters);
-            }
-            else if (mCurrentSimulationSequenceNumber.IsStepOf(CombustionStateMachineSlowStep3, GameParameters::ParticleUpdateLowFrequencyPeriod))
-            {
-                mPoints.UpdateCombustionLowFrequency(
-                    2,
-                    4,
-                    currentWallClockTimeFloat,
-                    currentSimulationTime,
-                    stormParameters,
-                    gameParameters);
-            }
-            else if (mCurrentSimulationSequenceNumber.IsStepOf(CombustionStateMachineSlowStep4, GameParameters::ParticleUpdateLowFrequencyPeriod))
-            {
-                mPoints.UpdateCombustionLowFrequency(
-                    3,
-                    4,
-                    currentWallClockTimeFloat,
-                    currentSimulationTime,
-                    stormParameters,
-                    gameParameters);
-            }
+    // - Inputs: P.Position, P.PlaneId, EL.AvailableLight
+    //      - EL.AvailableLight depends on electricals which depend on water
+    mUpdateTaskGraphArguments.DoDiffuseLight = PrepareLightDiffusion(gameParameters);
 
-            //
-            // Update fast combustion state machine
-            //
+    mUpdateTaskGraph.Run(*mTaskThreadPool, false);
 
-            mPoints.UpdateCombustionHighFrequency(
-                currentSimulationTime,
-                GameParameters::SimulationStepTimeDuration<float>,
-                mParentWorld.GetCurrentWindSpeed(),
-                mWindField,
-                gameParameters);
-        });
+    EndStage(PerfStats::ShipUpdateStageType::ConcurrentStages, shipPerfStats, stageStartTime);
 
     ///////////////////////////////////////////////////////////////////
-    // Diffuse light from lamps
+    // Stats
     ///////////////////////////////////////////////////////////////////
 
-    parallelTasks.emplace_back(
-        [&]()
-        {
-            // - Inputs: P.Position, P.PlaneId, EL.AvailableLight
-            //      - EL.AvailableLight depends on electricals which depend on water
-            // - Outputs: P.Light
-            DiffuseLight(gameParameters);
-        });
+    auto const ephemeralParticleStatistics = mPoints.ResetEphemeralParticleStatistics();
+    perfStats.TotalShipsEphemeralParticleExhaustions.Update(ephemeralParticleStatistics.ExhaustionCount);
+    perfStats.TotalShipsEphemeralParticleLevelOfDetailSkips.Update(ephemeralParticleStatistics.LevelOfDetailSkipCount);
+    perfStats.TotalShipsAirBubbleParticles.Update(mPoints.GetEphemeralParticleCount(Points::EphemeralType::AirBubble));
+    perfStats.TotalShipsDebrisParticles.Update(mPoints.GetEphemeralParticleCount(Points::EphemeralType::Debris));
+    perfStats.TotalShipsSmokeParticles.Update(mPoints.GetEphemeralParticleCount(Points::EphemeralType::Smoke));
+    perfStats.TotalShipsSparkleParticles.Update(mPoints.GetEphemeralParticleCount(Points::EphemeralType::Sparkle));
+    perfStats.TotalShipsWakeBubbleParticles.Update(mPoints.GetEphemeralParticleCount(Points::EphemeralType::WakeBubble));
+
+    ElementCount ephemeralParticleCount = 0;
+    for (size_t t = static_cast<size_t>(Points::EphemeralType::AirBubble); t < Points::EphemeralTypeCount; ++t)
+    {
+        ephemeralParticleCount += mPoints.GetEphemeralParticleCount(static_cast<Points::EphemeralType>(t));
+    }
 
-    mTaskThreadPool->RunAndClear(parallelTasks);
+    shipPerfStats.LivePoints.Update(mPoints.GetRawShipPointCount());
+    shipPerfStats.LiveSprings.Update(mSprings.GetLiveSprings().CountSet());
+    shipPerfStats.EphemeralParticles.Update(ephemeralParticleCount);
+    shipPerfStats.Frontiers.Update(mFrontiers.GetElementCount());
 
     ///////////////////////////////////////////////////////////////////
-    // Update spring parameters
+    // Diagnostics
     ///////////////////////////////////////////////////////////////////
 
-    if (mCurrentSimulationSequenceNumber.IsStepOf(SpringDecayAndTemperatureStep1, GameParameters::ParticleUpdateLowFrequencyPeriod))
-    {
-        mSprings.UpdateForDecayAndTemperature(
-            0, 4,
-            mPoints);
-    }
-    else if (mCurrentSimulationSequenceNumber.IsStepOf(SpringDecayAndTemperatureStep2, GameParameters::ParticleUpdateLowFrequencyPeriod))
-    {
-        mSprings.UpdateForDecayAndTemperature(
-            1, 4,
-            mPoints);
-    }
-    else if (mCurrentSimulationSequenceNumber.IsStepOf(SpringDecayAndTemperatureStep3, GameParameters::ParticleUpdateLowFrequencyPeriod))
-    {
-        mSprings.UpdateForDecayAndTemperature(
-            2, 4,
-            mPoints);
-    }
-    else if (mCurrentSimulationSequenceNumber.IsStepOf(SpringDecayAndTemperatureStep4, GameParameters::ParticleUpdateLowFrequencyPeriod))
-    {
-        mSprings.UpdateForDecayAndTemperature(
-            3, 4,
-            mPoints);
-    }
+#ifdef _DEBUG
 
-    ///////////////////////////////////////////////////////////////////
-    // Update ephemeral particles
-    ///////////////////////////////////////////////////////////////////
+    Verify(!mPoints.Diagnostic_ArePositionsDirty());
 
-    mPoints.UpdateEphemeralParticles(
-        currentSimulationTime,
-        gameParameters);
+    VerifyInvariants();
+
+#endif
 
     ///////////////////////////////////////////////////////////////////
-    // Update highlights
+    // Preparations for next step
     ///////////////////////////////////////////////////////////////////
 
-    mPoints.UpdateHighlights(currentWallClockTimeFloat);
+    // Continue recovering from a repair
+    if (mRepairGracePeriodMultiplier != 1.0f)
+    {
+        mRepairGracePeriodMultiplier += 0.2f * (1.0f - mRepairGracePeriodMultiplier);
+        if (std::abs(1.0f - mRepairGracePeriodMultiplier) < 0.02f)
+        {
+            mRepairGracePeriodMultiplier = 1.0f;
+        }
+    }
 
-    ///////////////////////////////////////////////////////////////////
-    // Electric sparks
-    ///////////////////////////////////////////////////////////////////
+    shipPerfStats.UpdateDuration.Update(GameChronometer::now() - updateStartTime);
+}
+
+void Ship::BuildUpdateTaskGraph()
+{
+    TaskGraph & updateGraph = mUpdateTaskGraph;
+    updateGraph.Clear();
+
+#ifdef _DEBUG
+    updateGraph.SetAccessVerification(true);
+#endif
+
+    // Point buffers are allocated once, hence their memory may be declared once
+    auto const pointBufferByteSize = mPoints.GetBufferElementCount() * sizeof(float);
+
+    auto const waterResource = updateGraph.AddResource("P.Water", mPoints.GetWaterBufferAsFloat(), pointBufferByteSize);
+    auto const temperatureResource = updateGraph.AddResource("P.Temperature", mPoints.GetTemperatureBufferAsFloat(), pointBufferByteSize);
+    auto const decayResource = updateGraph.AddResource("P.Decay", mPoints.GetDecayBufferAsFloat(), pointBufferByteSize);
+    auto const lightResource = updateGraph.AddResource("P.Light", mPoints.GetLightBufferAsFloat(), pointBufferByteSize);
+    auto const staticForceResource = updateGraph.AddResource("P.StaticForce", mPoints.GetStaticForceBufferAsFloat(), pointBufferByteSize * 2);
+    auto const combustionResource = updateGraph.AddResource("P.Combustion");
+    auto const ephemeralParticlesResource = updateGraph.AddResource("P.EphemeralParticles");
+    auto const highlightsResource = updateGraph.AddResource("P.Highlights");
+    auto const electricalsResource = updateGraph.AddResource("EL");
+    auto const springCoefficientsResource = updateGraph.AddResource("S.Coefficients");
+    auto const electricSparksResource = updateGraph.AddResource("ElectricSparks");
+    auto const npcsResource = updateGraph.AddResource("NPCs");
 
-    mElectricSparks.Update();
+    // The random engine, the world, and the event handler, none of which is thread-safe
+    auto const environmentResource = updateGraph.AddResource("Environment");
+
+    //
+    // Stages read the arguments of the current step from mUpdateTaskGraphArguments;
+    // stages that only run at some steps, or only with some state, check for that
+    // themselves - doing nothing otherwise
+    //
 
     ///////////////////////////////////////////////////////////////////
-    // Diagnostics
+    // Update heat dynamics
     ///////////////////////////////////////////////////////////////////
 
-#ifdef _DEBUG
+    updateGraph.AddStage(
+        "Heat",
+        [this]()
+        {
+            auto const & args = mUpdateTaskGraphArguments;
 
-    Verify(!mPoints.Diagnostic_ArePositionsDirty());
+            //
+            // Propagate heat
+            //
 
-    VerifyInvariants();
+            // - Inputs: P.Position, P.Temperature, P.ConnectedSprings, P.Water
+            // - Outputs: P.Temperature
+            if (!args.GameParams->DoUseImplicitHeatPropagation)
+            {
+                PropagateHeat(
+                    args.CurrentSimulationTime,
+                    GameParameters::SimulationStepTimeDuration<float>,
+                    *args.StormParams,
+                    *args.GameParams);
+            }
+            else if (args.LowFrequencyStep % ImplicitHeatPropagationPeriod == 0)
+            {
+                // Stable at this step, which covers all the steps since the last propagation
+                PropagateHeat(
+                    args.CurrentSimulationTime,
+                    GameParameters::SimulationStepTimeDuration<float> * static_cast<float>(ImplicitHeatPropagationPeriod),
+                    *args.StormParams,
+                    *args.GameParams);
+            }
 
-#endif
+            //
+            // Update slow combustion state machine
+            //
+
+            if (auto const partition = LowFrequencyScheduler.GetScheduledPartition(CombustionStateMachineSlowStage, args.LowFrequencyStep);
+                partition.has_value())
+            {
+                mPoints.UpdateCombustionLowFrequency(
+                    *partition,
+                    LowFrequencyScheduler.GetPartitionCount(CombustionStateMachineSlowStage),
+                    args.CurrentWallClockTimeFloat,
+                    args.CurrentSimulationTime,
+                    *args.StormParams,
+                    *args.GameParams);
+            }
+
+            //
+            // Update fast combustion state machine
+            //
+
+            mPoints.UpdateCombustionHighFrequency(
+                args.CurrentSimulationTime,
+                GameParameters::SimulationStepTimeDuration<float>,
+                mParentWorld.GetWind(),
+                *args.GameParams);
+        },
+        {
+            // Includes the attributes of the ephemeral particles it spawns
+            {},
+            { waterResource, temperatureResource, decayResource, staticForceResource, combustionResource, ephemeralParticlesResource, environmentResource }
+        },
+        true); // We want this to run on the main thread
 
     ///////////////////////////////////////////////////////////////////
-    // Preparations for next step
+    // Diffuse light from lamps
     ///////////////////////////////////////////////////////////////////
 
-    // Continue recovering from a repair
-    if (mRepairGracePeriodMultiplier != 1.0f)
+    // Partitions are decided at construction
+    if (!mLightDiffusionPartitions.empty())
     {
-        mRepairGracePeriodMultiplier += 0.2f * (1.0f - mRepairGracePeriodMultiplier);
-        if (std::abs(1.0f - mRepairGracePeriodMultiplier) < 0.02f)
+        std::vector<TaskGraph::Task> lightDiffusionTasks;
+        for (size_t p = 0; p < mLightDiffusionPartitions.size(); ++p)
         {
-            mRepairGracePeriodMultiplier = 1.0f;
+            lightDiffusionTasks.emplace_back(
+                [this, p]()
+                {
+                    // Only when prepared at this step
+                    if (mUpdateTaskGraphArguments.DoDiffuseLight)
+                    {
+                        // - Outputs: P.Light
+                        DiffuseLight(p);
+                    }
+                });
         }
+
+        updateGraph.AddStage(
+            "LightDiffusion",
+            std::move(lightDiffusionTasks),
+            {
+                { electricalsResource },
+                { lightResource }
+            });
+    }
+
+    ///////////////////////////////////////////////////////////////////
+    // Update spring parameters
+    ///////////////////////////////////////////////////////////////////
+
+    updateGraph.AddStage(
+        "SpringDecay",
+        [this]()
+        {
+            if (auto const partition = LowFrequencyScheduler.GetScheduledPartition(SpringDecayAndTemperatureStage, mUpdateTaskGraphArguments.LowFrequencyStep);
+                partition.has_value())
+            {
+                mSprings.UpdateForDecayAndTemperature(
+                    *partition,
+                    LowFrequencyScheduler.GetPartitionCount(SpringDecayAndTemperatureStage),
+                    mPoints);
+            }
+        },
+        {
+            { decayResource, temperatureResource },
+            { springCoefficientsResource }
+        });
+
+    ///////////////////////////////////////////////////////////////////
+    // Update ephemeral particles
+    ///////////////////////////////////////////////////////////////////
+
+    updateGraph.AddStage(
+        "EphemeralParticles",
+        [this]()
+        {
+            mPoints.UpdateEphemeralParticles(
+                mUpdateTaskGraphArguments.CurrentSimulationTime,
+                *mUpdateTaskGraphArguments.GameParams);
+        },
+        {
+            {},
+            { staticForceResource, ephemeralParticlesResource, environmentResource }
+        },
+        true); // Fires events
+
+    ///////////////////////////////////////////////////////////////////
+    // Update highlights
+    ///////////////////////////////////////////////////////////////////
+
+    updateGraph.AddStage(
+        "Highlights",
+        [this]()
+        {
+            // Only while there are any, as they only exist while tools are being used
+            if (mPoints.HasHighlights())
+            {
+                mPoints.UpdateHighlights(mUpdateTaskGraphArguments.CurrentWallClockTimeFloat);
+            }
+        },
+        {
+            {},
+            { highlightsResource }
+        });
+
+    ///////////////////////////////////////////////////////////////////
+    // Electric sparks
+    ///////////////////////////////////////////////////////////////////
+
+    updateGraph.AddStage(
+        "ElectricSparks",
+        [this]()
+        {
+            mElectricSparks.Update();
+        },
+        {
+            {},
+            { electricSparksResource }
+        });
+
+    ///////////////////////////////////////////////////////////////////
+    // NPCs
+    ///////////////////////////////////////////////////////////////////
+
+    updateGraph.AddStage(
+        "NPCs",
+        [this]()
+        {
+            if (mNPCs.GetNpcCount() > 0)
+            {
+                // - Inputs: P.Position, T.IsDeleted
+                // - Outputs: NPCs
+                mNPCs.Update(
+                    GameParameters::SimulationStepTimeDuration<float>,
+                    GameParameters::Gravity,
+                    mPoints.GetPositionBufferAsVec2(),
+                    mTriangles);
+            }
+        },
+        {
+            {},
+            { npcsResource }
+        });
+}
+
+void Ship::UpdateStructureHeadless()
+{
+    // Run the connectivity tasks that would otherwise run at render upload
+    if (mIsStructureDirty)
+    {
+        RunConnectivityVisit();
+
+        mElectricalElements.OnPhysicalStructureChanged(mPoints);
+
+        mIsStructureDirty = false;
     }
+}
 
-    mWindField.reset();
+void Ship::RenderUploadAhead(Render::RenderContext & renderContext)
+{
+    // Upload the double-buffered point attributes, which are safe
+    // to be uploaded while the previous frame is being drawn
+    mPoints.UploadMutableAttributes(
+        mId,
+        renderContext);
 }
 
 void Ship::RenderUpload(Render::RenderContext & renderContext)
 {
+    FS_PROFILE_SCOPE("Ship::RenderUpload");
+
     //
     // Run all tasks that need to run when connectivity has changed
     // (i.e. when the connected components have changed, e.g. because
@@ -727,6 +1323,11 @@ void Ship::RenderUpload(Render::RenderContext & renderContext)
     // Upload points's immutable and mutable attributes
     //
 
+    if (renderContext.GetStressRenderMode() != StressRenderModeType::None)
+    {
+        mSprings.CalculatePointStress(mPoints);
+    }
+
     mPoints.UploadAttributes(
         mId,
         renderContext);
@@ -736,6 +1337,8 @@ void Ship::RenderUpload(Render::RenderContext & renderContext)
     //
 
     if (mIsStructureDirty
+        || mIsTriangleLayoutDirty
+        || !mTrianglesToTombstone.empty()
         || !mLastUploadedDebugShipRenderMode
         || *mLastUploadedDebugShipRenderMode != renderContext.GetDebugShipRenderMode())
     {
@@ -760,11 +1363,12 @@ void Ship::RenderUpload(Render::RenderContext & renderContext)
             renderContext);
 
         //
-        // Upload triangles, but only if structure is dirty
-        // (we can't upload more frequently as mPlaneTriangleIndicesToRender is a one-time use)
+        // Upload triangles, but only if their layout is dirty
+        // (we can't upload more frequently as mPlaneTriangleIndicesToRender is a one-time use);
+        // otherwise, just tombstone the ones that have been destroyed
         //
 
-        if (mIsStructureDirty)
+        if (mIsTriangleLayoutDirty)
         {
             assert(mPlaneTriangleIndicesToRender.size() >= 1);
 
@@ -777,6 +1381,18 @@ void Ship::RenderUpload(Render::RenderContext & renderContext)
                 renderContext);
 
             shipRenderContext.UploadElementTrianglesEnd();
+
+            mIsTriangleLayoutDirty = false;
+            mTrianglesToTombstone.clear();
+        }
+        else
+        {
+            for (ElementIndex const triangleElementIndex : mTrianglesToTombstone)
+            {
+                shipRenderContext.UploadElementTriangleTombstone(triangleElementIndex);
+            }
+
+            mTrianglesToTombstone.clear();
         }
 
         shipRenderContext.UploadElementsEnd();
@@ -786,27 +1402,31 @@ void Ship::RenderUpload(Render::RenderContext & renderContext)
     // Upload stressed springs
     //
     // We do this regardless of whether or not elements are dirty,
-    // as the set of stressed springs is bound to change from frame to frame
+    // as the set of stressed springs is bound to change from frame to frame;
+    // while they're not shown, stale ones are not drawn
     //
 
-    shipRenderContext.UploadElementStressedSpringsStart();
-
     if (renderContext.GetShowStressedSprings())
     {
+        shipRenderContext.UploadElementStressedSpringsStart();
+
         mSprings.UploadStressedSpringElements(
             mId,
             renderContext);
-    }
 
-    shipRenderContext.UploadElementStressedSpringsEnd();
+        shipRenderContext.UploadElementStressedSpringsEnd();
+    }
 
     //
     // Upload electrical elements
     //
 
-    mElectricalElements.Upload(
-        shipRenderContext,
-        mPoints);
+    if (mHasElectricalElements)
+    {
+        mElectricalElements.Upload(
+            shipRenderContext,
+            mPoints);
+    }
 
     //
     // Upload electric sparks
@@ -858,20 +1478,26 @@ void Ship::RenderUpload(Render::RenderContext & renderContext)
         renderContext);
 
     //
-    // Upload highlights
+    // Upload highlights - cleared at each upload - only while there are any
     //
 
-    mPoints.UploadHighlights(
-        mId,
-        renderContext);
+    if (mPoints.HasHighlights())
+    {
+        mPoints.UploadHighlights(
+            mId,
+            renderContext);
+    }
 
     //
-    // Upload vector fields
+    // Upload vector fields - cleared at each upload - only while shown
     //
 
-    mPoints.UploadVectors(
-        mId,
-        renderContext);
+    if (renderContext.GetVectorFieldRenderMode() != VectorFieldRenderModeType::None)
+    {
+        mPoints.UploadVectors(
+            mId,
+            renderContext);
+    }
 
     //
     // Upload state machines
@@ -909,6 +1535,9 @@ void Ship::RenderUpload(Render::RenderContext & renderContext)
 
 void Ship::Finalize()
 {
+    // Pack the spring network, now that all factory springs are there
+    mPoints.UpdateConnectedSpringsAdjacency();
+
     //
     // 1. Propagate (ship) point materials' hullness
     //
@@ -935,6 +1564,18 @@ void Ship::Finalize()
 
 void Ship::ApplyQueuedInteractionForces()
 {
+    FS_PROFILE_SCOPE("Ship::ApplyQueuedInteractionForces");
+
+    //
+    // Interactions that only touch a few points are applied right away, while those
+    // acting on all points are coalesced by type and applied in a single pass; all
+    // forces are static forces, hence the order in which we add them is immaterial
+    //
+
+    mCoalescedDrawInteractions.clear();
+    mCoalescedSwirlInteractions.clear();
+    mCoalescedRadialWindInteractions.clear();
+
     for (auto const & interaction : mQueuedInteractions)
     {
         switch (interaction.Type)
@@ -948,7 +1589,13 @@ void Ship::ApplyQueuedInteractionForces()
 
             case Interaction::InteractionType::Draw:
             {
-                DrawTo(interaction.Arguments.Draw);
+                // Forces are proportional to strength, hence draws at the same
+                // position - e.g. while the mouse is still - merge into one
+                auto const & args = interaction.Arguments.Draw;
+                if (!mCoalescedDrawInteractions.empty() && mCoalescedDrawInteractions.back().CenterPos == args.CenterPos)
+                    mCoalescedDrawInteractions.back().Strength += args.Strength;
+                else
+                    mCoalescedDrawInteractions.push_back(args);
 
                 break;
             }
@@ -962,14 +1609,19 @@ void Ship::ApplyQueuedInteractionForces()
 
             case Interaction::InteractionType::Swirl:
             {
-                SwirlAt(interaction.Arguments.Swirl);
+                // Same as draws
+                auto const & args = interaction.Arguments.Swirl;
+                if (!mCoalescedSwirlInteractions.empty() && mCoalescedSwirlInteractions.back().CenterPos == args.CenterPos)
+                    mCoalescedSwirlInteractions.back().Strength += args.Strength;
+                else
+                    mCoalescedSwirlInteractions.push_back(args);
 
                 break;
             }
 
             case Interaction::InteractionType::RadialWind:
             {
-                ApplyRadialWindFrom(interaction.Arguments.RadialWind);
+                mCoalescedRadialWindInteractions.push_back(interaction.Arguments.RadialWind);
 
                 break;
             }
@@ -977,6 +1629,13 @@ void Ship::ApplyQueuedInteractionForces()
     }
 
     mQueuedInteractions.clear();
+
+    if (!mCoalescedDrawInteractions.empty()
+        || !mCoalescedSwirlInteractions.empty()
+        || !mCoalescedRadialWindInteractions.empty())
+    {
+        ApplyCoalescedInteractions();
+    }
 }
 
 void Ship::ApplyWorldForces(
@@ -985,6 +1644,8 @@ void Ship::ApplyWorldForces(
     GameParameters const & gameParameters,
     Geometry::AABBSet & externalAabbSet)
 {
+    FS_PROFILE_SCOPE("Ship::ApplyWorldForces");
+
     // New buffer to which new cached depths will be written to
     std::shared_ptr<Buffer<float>> newCachedPointDepths = mPoints.AllocateWorkBufferFloat();
 
@@ -1037,75 +1698,86 @@ void Ship::ApplyWorldParticleForces(
     float * const restrict newCachedPointDepthsBuffer = newCachedPointDepths.data();
     vec2f * const restrict staticForcesBuffer = mPoints.GetStaticForceBufferAsVec2();
 
-    for (auto pointIndex : mPoints.BufferElements())
-    {
-        vec2f staticForce = vec2f::zero();
+    // Each point only depends on itself, hence we may split points among threads
+    mTaskThreadPool->ParallelFor(
+        0,
+        mPoints.GetBufferElementCount(),
+        WorldForcesPointGrain,
+        [&](size_t start, size_t end)
+        {
+            //
+            // Calculate and store depths
+            //
 
-        //
-        // Calculate and store depth
-        //
+            oceanSurface.GetDepths(
+                &(mPoints.GetPosition(static_cast<ElementIndex>(start))),
+                end - start,
+                newCachedPointDepthsBuffer + start);
 
-        newCachedPointDepthsBuffer[pointIndex] = oceanSurface.GetDepth(mPoints.GetPosition(pointIndex));
+            for (ElementIndex pointIndex = static_cast<ElementIndex>(start); pointIndex < end; ++pointIndex)
+            {
+                vec2f staticForce = vec2f::zero();
 
-        //
-        // Calculate above/under-water coefficient
-        //
-        // 0.0: above water
-        // 1.0: under water
-        // in-between: smooth air-water interface (nature abhors discontinuities)
-        //
+                //
+                // Calculate above/under-water coefficient
+                //
+                // 0.0: above water
+                // 1.0: under water
+                // in-between: smooth air-water interface (nature abhors discontinuities)
+                //
 
-        float const uwCoefficient = Clamp(newCachedPointDepthsBuffer[pointIndex], 0.0f, 1.0f);
+                float const uwCoefficient = Clamp(newCachedPointDepthsBuffer[pointIndex], 0.0f, 1.0f);
 
-        //
-        // Apply gravity
-        //
+                //
+                // Apply gravity
+                //
 
-        staticForce +=
-            gameParameters.Gravity
-            * mPoints.GetMass(pointIndex); // Material + Augmentation + Water
+                staticForce +=
+                    gameParameters.Gravity
+                    * mPoints.GetMass(pointIndex); // Material + Augmentation + Water
 
-        //
-        // Apply water/air buoyancy
-        //
+                //
+                // Apply water/air buoyancy
+                //
 
-        // Calculate upward push of water/air mass
-        auto const & buoyancyCoefficients = mPoints.GetBuoyancyCoefficients(pointIndex);
-        float const buoyancyPush =
-            buoyancyCoefficients.Coefficient1
-            + buoyancyCoefficients.Coefficient2 * mPoints.GetTemperature(pointIndex);
+                // Calculate upward push of water/air mass
+                auto const & buoyancyCoefficients = mPoints.GetBuoyancyCoefficients(pointIndex);
+                float const buoyancyPush =
+                    buoyancyCoefficients.Coefficient1
+                    + buoyancyCoefficients.Coefficient2 * mPoints.GetTemperature(pointIndex);
 
-        // Apply buoyancy
-        staticForce.y +=
-            buoyancyPush
-            * Mix(effectiveAirDensity, effectiveWaterDensity, uwCoefficient);
+                // Apply buoyancy
+                staticForce.y +=
+                    buoyancyPush
+                    * Mix(effectiveAirDensity, effectiveWaterDensity, uwCoefficient);
 
-        //
-        // Apply friction drag
-        //
-        // We use a linear law for simplicity.
-        //
-        // With a linear law, we know that the force will never overcome the current velocity
-        // as long as m > (C * dt) (~=0.0016 for water drag), which is a mass we won't have in our system (air is 1.2754);
-        // hence we don't care here about capping the force to prevent overcoming accelerations.
-        //
+                //
+                // Apply friction drag
+                //
+                // We use a linear law for simplicity.
+                //
+                // With a linear law, we know that the force will never overcome the current velocity
+                // as long as m > (C * dt) (~=0.0016 for water drag), which is a mass we won't have in our system (air is 1.2754);
+                // hence we don't care here about capping the force to prevent overcoming accelerations.
+                //
 
-        staticForce +=
-            -mPoints.GetVelocity(pointIndex)
-            * Mix(airFrictionDragCoefficient, waterFrictionDragCoefficient, uwCoefficient);
+                staticForce +=
+                    -mPoints.GetVelocity(pointIndex)
+                    * Mix(airFrictionDragCoefficient, waterFrictionDragCoefficient, uwCoefficient);
 
-        //
-        // Wind force
-        //
+                //
+                // Wind force
+                //
 
-        // Note: should be based on relative velocity, but we simplify here for performance reasons
-        staticForce +=
-            windForce
-            * mPoints.GetMaterialWindReceptivity(pointIndex)
-            * (1.0f - uwCoefficient); // Only above-water
+                // Note: should be based on relative velocity, but we simplify here for performance reasons
+                staticForce +=
+                    windForce
+                    * mPoints.GetMaterialWindReceptivity(pointIndex)
+                    * (1.0f - uwCoefficient); // Only above-water
 
-        staticForcesBuffer[pointIndex] += staticForce;
-    }
+                staticForcesBuffer[pointIndex] += staticForce;
+            }
+        });
 }
 
 template<bool DoDisplaceWater>
@@ -1421,6 +2093,8 @@ void Ship::ApplyStaticPressureForces(
     float effectiveWaterDensity,
     GameParameters const & gameParameters)
 {
+    FS_PROFILE_SCOPE("Ship::ApplyStaticPressureForces");
+
     //
     // At this moment, dynamic forces are all zero - we are the first populating those
     //
@@ -1433,26 +2107,90 @@ void Ship::ApplyStaticPressureForces(
             return v == vec2f::zero();
         }));
 
-    // Initialize stats
+    //
+    // 1. Gather external frontiers - the only ones we consider
+    //
+
+    mStaticPressureExternalFrontierIds.clear();
+
+    for (FrontierId const frontierId : mFrontiers.GetFrontierIds())
+    {
+        if (mFrontiers.GetFrontier(frontierId).Type == FrontierType::External)
+        {
+            mStaticPressureExternalFrontierIds.push_back(frontierId);
+        }
+    }
+
+    //
+    // 2. Calculate, concurrently, the static pressure forces of each frontier;
+    //    frontiers are independent of each other, hence each partition works on
+    //    its own range of frontiers, accumulating forces and stats privately
+    //
+
+    size_t const frontierCount = mStaticPressureExternalFrontierIds.size();
+
+    size_t const partitionCount = std::max(
+        std::min(
+            mTaskThreadPool->GetParallelism(),
+            frontierCount / MinFrontiersPerStaticPressurePartition),
+        size_t(1));
+
+    if (mStaticPressurePartitions.size() < partitionCount)
+    {
+        mStaticPressurePartitions.resize(partitionCount);
+    }
+
+    size_t const partitionSize = (frontierCount + partitionCount - 1) / partitionCount;
+
+    mTaskThreadPool->ParallelFor(
+        0,
+        partitionCount,
+        1,
+        [&](size_t start, size_t end)
+        {
+            for (size_t p = start; p < end; ++p)
+            {
+                auto & partition = mStaticPressurePartitions[p];
+                partition.Reset();
+
+                size_t const partitionEnd = std::min((p + 1) * partitionSize, frontierCount);
+                for (size_t f = p * partitionSize; f < partitionEnd; ++f)
+                {
+                    ApplyStaticPressureForces(
+                        mFrontiers.GetFrontier(mStaticPressureExternalFrontierIds[f]),
+                        effectiveAirDensity,
+                        effectiveWaterDensity,
+                        gameParameters,
+                        partition);
+                }
+            }
+        });
+
+    //
+    // 3. Apply forces as dynamic forces, serially and in partition order - hence
+    //    in the same order as if they had been calculated by a serial visit
+    //
+
     mStaticPressureNetForceMagnitudeSum = 0.0f;
     mStaticPressureNetForceMagnitudeCount = 0.0f;
     mStaticPressureIterationsPercentagesSum = 0.0f;
     mStaticPressureIterationsCount = 0.0f;
 
-    // Visit all frontiers and apply static pressure forces on each
-    for (FrontierId const frontierId : mFrontiers.GetFrontierIds())
+    for (size_t p = 0; p < partitionCount; ++p)
     {
-        auto const & frontier = mFrontiers.GetFrontier(frontierId);
+        auto const & partition = mStaticPressurePartitions[p];
 
-        // Only consider external frontiers
-        if (frontier.Type == FrontierType::External)
+        for (auto const & sp : partition.Forces)
         {
-            ApplyStaticPressureForces(
-                frontier,
-                effectiveAirDensity,
-                effectiveWaterDensity,
-                gameParameters);
+            mPoints.AddDynamicForce(
+                sp.PointIndex,
+                sp.ForceVector);
         }
+
+        mStaticPressureNetForceMagnitudeSum += partition.NetForceMagnitudeSum;
+        mStaticPressureNetForceMagnitudeCount += partition.NetForceMagnitudeCount;
+        mStaticPressureIterationsPercentagesSum += partition.IterationsPercentagesSum;
+        mStaticPressureIterationsCount += partition.IterationsCount;
     }
 
     // Publish stats
@@ -1465,7 +2203,8 @@ void Ship::ApplyStaticPressureForces(
     Frontiers::Frontier const & frontier,
     float effectiveAirDensity,
     float effectiveWaterDensity,
-    GameParameters const & gameParameters)
+    GameParameters const & gameParameters,
+    StaticPressurePartition & partition) const
 {
     //
     // The hydrostatic pressure force acting on point P, between edges
@@ -1535,8 +2274,12 @@ void Ship::ApplyStaticPressureForces(
     // to take into account the length of the edge, as the pressure force on an edge is
     // proportional to its length
     //
+    // The forces of this frontier are appended to the ones of the frontiers that
+    // the partition has already visited
+    //
 
-    mStaticPressureBuffer.clear();
+    auto & staticPressureBuffer = partition.Forces;
+    size_t const firstHPIndex = staticPressureBuffer.size();
 
     vec2f netForce = vec2f::zero();
     float netTorque = 0.0f;
@@ -1589,7 +2332,7 @@ void Ship::ApplyStaticPressureForces(
             vec2f const forceVector = (edge1PerpVector + edge2PerpVector) / 2.0f * internalPressureCounterbalanceFactor;
             vec2f const torqueArm = mPoints.GetPosition(thisPointIndex) - geometricCenterPosition;
 
-            mStaticPressureBuffer.emplace_back(
+            staticPressureBuffer.emplace_back(
                 thisPointIndex,
                 forceVector,
                 torqueArm);
@@ -1646,9 +2389,9 @@ void Ship::ApplyStaticPressureForces(
 
             float minNetForceMagnitude = std::numeric_limits<float>::max();
             float minNetTorqueMagnitude = std::numeric_limits<float>::max();
-            for (size_t hpi = 0; hpi < mStaticPressureBuffer.GetCurrentPopulatedSize(); ++hpi)
+            for (size_t hpi = firstHPIndex; hpi < staticPressureBuffer.size(); ++hpi)
             {
-                auto const & hp = mStaticPressureBuffer[hpi];
+                auto const & hp = staticPressureBuffer[hpi];
 
                 vec2f const & thisForce = hp.ForceVector;
 
@@ -1688,9 +2431,9 @@ void Ship::ApplyStaticPressureForces(
 
             float minNetForceMagnitude = std::numeric_limits<float>::max();
             float minNetTorqueMagnitude = std::numeric_limits<float>::max();
-            for (size_t hpi = 0; hpi < mStaticPressureBuffer.GetCurrentPopulatedSize(); ++hpi)
+            for (size_t hpi = firstHPIndex; hpi < staticPressureBuffer.size(); ++hpi)
             {
-                auto const & hp = mStaticPressureBuffer[hpi];
+                auto const & hp = staticPressureBuffer[hpi];
 
                 vec2f const & thisForce = hp.ForceVector;
                 float const thisTorque = hp.TorqueArm.cross(thisForce);
@@ -1729,11 +2472,11 @@ void Ship::ApplyStaticPressureForces(
             break;
         }
 
-        vec2f const thisForce = mStaticPressureBuffer[*bestHPIndex].ForceVector;
-        float const thisTorque = mStaticPressureBuffer[*bestHPIndex].TorqueArm.cross(thisForce);
+        vec2f const thisForce = staticPressureBuffer[*bestHPIndex].ForceVector;
+        float const thisTorque = staticPressureBuffer[*bestHPIndex].TorqueArm.cross(thisForce);
 
         // Adjust force vector of optimal particle
-        mStaticPressureBuffer[*bestHPIndex].ForceVector *= bestLambda;
+        staticPressureBuffer[*bestHPIndex].ForceVector *= bestLambda;
 
         // Update net force and torque
         netForce -= thisForce * (1.0f - bestLambda);
@@ -1743,15 +2486,15 @@ void Ship::ApplyStaticPressureForces(
     }
 
     // Update stats
-    mStaticPressureNetForceMagnitudeSum += netForce.length();
-    mStaticPressureNetForceMagnitudeCount += 1.0f;
-    mStaticPressureIterationsPercentagesSum += static_cast<float>(iter + 1) / static_cast<float>(frontier.Size);
-    mStaticPressureIterationsCount += 1.0f;
+    partition.NetForceMagnitudeSum += netForce.length();
+    partition.NetForceMagnitudeCount += 1.0f;
+    partition.IterationsPercentagesSum += static_cast<float>(iter + 1) / static_cast<float>(frontier.Size);
+    partition.IterationsCount += 1.0f;
 
     //
-    // 3. Apply forces as dynamic forces - so they only apply to current positions,
-    //    as these forces are very sensitive to their position, and would generate
-    //    phantom forces and torques otherwise
+    // 3. Finalize forces, which will be applied by the caller as dynamic forces - so they
+    //    only apply to current positions, as these forces are very sensitive to their
+    //    position, and would generate phantom forces and torques otherwise
     //
 
     float const forceMultiplier =
@@ -1759,74 +2502,336 @@ void Ship::ApplyStaticPressureForces(
         * gameParameters.StaticPressureForceAdjustment
         * mRepairGracePeriodMultiplier; // Static pressure hinders the repair process
 
-    size_t const particleCount = mStaticPressureBuffer.GetCurrentPopulatedSize();
-    for (size_t hpi = 0; hpi < particleCount; ++hpi)
+    for (size_t hpi = firstHPIndex; hpi < staticPressureBuffer.size(); ++hpi)
     {
-        mPoints.AddDynamicForce(
-            mStaticPressureBuffer[hpi].PointIndex,
-            mStaticPressureBuffer[hpi].ForceVector * forceMultiplier);
+        staticPressureBuffer[hpi].ForceVector *= forceMultiplier;
     }
 }
 
-void Ship::ApplySpringsForces_BySprings(GameParameters const & /*gameParameters*/)
+void Ship::ApplySpringsForces_BySprings(GameParameters const & gameParameters)
 {
-    vec2f const * restrict const pointPositionBuffer = mPoints.GetPositionBufferAsVec2();
-    vec2f const * restrict const pointVelocityBuffer = mPoints.GetVelocityBufferAsVec2();
-    vec2f * restrict const pointDynamicForceBuffer = mPoints.GetDynamicForceBufferAsVec2();
+    FS_PROFILE_SCOPE("Ship::ApplySpringsForces_BySprings");
 
-    Springs::Endpoints const * restrict const endpointsBuffer = mSprings.GetEndpointsBuffer();
-    float const * restrict const restLengthBuffer = mSprings.GetRestLengthBuffer();
-    Springs::DynamicsCoefficients const * restrict const dynamicsCoefficientsBuffer = mSprings.GetDynamicsCoefficientsBuffer();
+    mSpringForcesKernel = gameParameters.SpringForcesKernel;
 
-    ElementCount const springCount = mSprings.GetElementCount();
-    for (ElementIndex springIndex = 0; springIndex < springCount; ++springIndex)
+    if (mSpringRelaxationParallelism == 1)
+    {
+        ApplyAwakeSpringsForces(
+            0,
+            mSprings.GetSimulatedElementCount(),
+            mPoints.GetDynamicForceBufferAsVec2());
+    }
+    else
     {
-        auto const pointAIndex = endpointsBuffer[springIndex].PointAIndex;
-        auto const pointBIndex = endpointsBuffer[springIndex].PointBIndex;
+        // Each partition writes to its own buffer, hence there are no write conflicts;
+        // buffers are reduced at integration time
+        mTaskThreadPool->Run(mSpringRelaxationTasks);
+    }
+}
 
-        // No need to check whether the spring is deleted, as a deleted spring
-        // has zero coefficients
+std::pair<ElementIndex, ElementIndex> Ship::GetSpringRelaxationPartition(size_t partitionIndex) const
+{
+    ElementCount const simulatedSpringCount = mSprings.GetSimulatedElementCount();
+    ElementCount const springsPerPartition = simulatedSpringCount / static_cast<ElementCount>(mSpringRelaxationParallelism);
 
-        vec2f const displacement = pointPositionBuffer[pointBIndex] - pointPositionBuffer[pointAIndex];
-        float const displacementLength = displacement.length();
-        vec2f const springDir = displacement.normalise(displacementLength);
+    ElementIndex const startSpringIndex = static_cast<ElementIndex>(partitionIndex) * springsPerPartition;
+    ElementIndex const endSpringIndex = (partitionIndex < mSpringRelaxationParallelism - 1)
+        ? startSpringIndex + springsPerPartition
+        : simulatedSpringCount;
 
-        //
-        // 1. Hooke's law
-        //
+    return { startSpringIndex, endSpringIndex };
+}
 
-        // Calculate spring force on point A
-        float const fSpring =
-            (displacementLength - restLengthBuffer[springIndex])
-            * dynamicsCoefficientsBuffer[springIndex].StiffnessCoefficient;
+void Ship::ApplySpringsForces(
+    ElementIndex startSpringIndex,
+    ElementIndex endSpringIndex,
+    vec2f * restrict dynamicForceBuffer)
+{
+    // No need to check whether springs are deleted, as a deleted spring
+    // has zero coefficients
 
-        //
-        // 2. Damper forces
-        //
-        // Damp the velocities of the two points, as if the points were also connected by a damper
-        // along the same direction as the spring
-        //
+    Algorithms::ApplySpringsForces(
+        mSpringForcesKernel,
+        mPoints.GetPositionBufferAsVec2(),
+        mPoints.GetVelocityBufferAsVec2(),
+        mSprings.GetEndpointAIndexBuffer(),
+        mSprings.GetEndpointBIndexBuffer(),
+        mSprings.GetRestLengthBuffer(),
+        mSprings.GetStiffnessCoefficientBuffer(),
+        mSprings.GetDampingCoefficientBuffer(),
+        startSpringIndex,
+        endSpringIndex,
+        dynamicForceBuffer);
+}
+
+void Ship::ApplyAwakeSpringsForces(
+    ElementIndex startSpringIndex,
+    ElementIndex endSpringIndex,
+    vec2f * restrict dynamicForceBuffer)
+{
+    if (mSleepingConnectedComponentCount == 0)
+    {
+        ApplySpringsForces(
+            startSpringIndex,
+            endSpringIndex,
+            dynamicForceBuffer);
+    }
+    else
+    {
+        // The springs of sleeping connected components would only impart
+        // forces on points that are oblivious to them
+        for (auto const & [awakeStartSpringIndex, awakeEndSpringIndex] : mAwakeSpringRanges)
+        {
+            ElementIndex const rangeStartSpringIndex = std::max(awakeStartSpringIndex, startSpringIndex);
+            ElementIndex const rangeEndSpringIndex = std::min(awakeEndSpringIndex, endSpringIndex);
+            if (rangeStartSpringIndex < rangeEndSpringIndex)
+            {
+                ApplySpringsForces(
+                    rangeStartSpringIndex,
+                    rangeEndSpringIndex,
+                    dynamicForceBuffer);
+            }
+        }
+    }
+}
+
+template<bool DoMeasureConvergence>
+float Ship::IntegrateAndResetDynamicForces(
+    bool doHandleCollisionsWithSeaFloor,
+    float seaFloorCollisionDt,
+    GameParameters const & gameParameters)
+{
+    FS_PROFILE_SCOPE("Ship::IntegrateAndResetDynamicForces");
+
+    float const dt = gameParameters.MechanicalSimulationStepTimeDuration<float>();
+
+    // Pre-divide damp coefficient by dt to provide the scalar factor which, when multiplied with a displacement,
+    // provides the final, damped velocity
+    float const velocityFactor = CalculateGlobalDampingCoefficient(gameParameters) / dt;
+
+    //
+    // We visit the points in blocks small enough to stay in cache while we reduce,
+    // integrate, and collide them; blocks are independent of each other, hence
+    // we run them in parallel when the ship is large enough to relax its springs
+    // in parallel
+    //
+
+    size_t const bufferPointCount = mPoints.GetBufferElementCount();
+    size_t const blockCount = (bufferPointCount + IntegrationBlockSize - 1) / IntegrationBlockSize;
+
+    if (mIntegrationBlockMaxVelocityDeltas.size() < blockCount)
+    {
+        mIntegrationBlockMaxVelocityDeltas.resize(blockCount);
+    }
+
+    // Taken here, on this thread, as taking positions marks the spatial index as dirty
+    vec2f * const positionBuffer = mPoints.GetPositionBufferAsVec2();
+    vec2f * const velocityBuffer = mPoints.GetVelocityBufferAsVec2();
+
+    auto const integrateBlocks = [&](size_t startBlock, size_t endBlock)
+    {
+        for (size_t b = startBlock; b < endBlock; ++b)
+        {
+            size_t const startPointIndex = b * IntegrationBlockSize;
+            size_t const endPointIndex = std::min(startPointIndex + IntegrationBlockSize, bufferPointCount);
+
+            mIntegrationBlockMaxVelocityDeltas[b] = IntegrateAndResetDynamicForces<DoMeasureConvergence>(
+                startPointIndex,
+                endPointIndex,
+                positionBuffer,
+                velocityBuffer,
+                dt,
+                velocityFactor);
+
+            if (doHandleCollisionsWithSeaFloor)
+            {
+                // Ephemeral particles beyond the last in use stay untouched
+                size_t const endCollisionPointIndex = std::min(endPointIndex, static_cast<size_t>(mPoints.GetElementCount()));
+                if (startPointIndex < endCollisionPointIndex)
+                {
+                    HandleCollisionsWithSeaFloor(
+                        static_cast<ElementIndex>(startPointIndex),
+                        static_cast<ElementIndex>(endCollisionPointIndex),
+                        positionBuffer,
+                        velocityBuffer,
+                        seaFloorCollisionDt,
+                        gameParameters);
+                }
+            }
+        }
+    };
+
+    if (mSpringRelaxationParallelism > 1 && blockCount > 1)
+    {
+        mTaskThreadPool->ParallelFor(
+            0,
+            blockCount,
+            1,
+            integrateBlocks);
+    }
+    else
+    {
+        integrateBlocks(0, blockCount);
+    }
+
+#ifdef _DEBUG
+    mPoints.Diagnostic_MarkPositionsAsDirty();
+#endif
 
-        // Calculate damp force on point A
-        vec2f const relVelocity = pointVelocityBuffer[pointBIndex] - pointVelocityBuffer[pointAIndex];
-        float const fDamp =
-            relVelocity.dot(springDir)
-            * dynamicsCoefficientsBuffer[springIndex].DampingCoefficient;
+    float maxVelocityDelta = 0.0f;
 
+    if constexpr (DoMeasureConvergence)
+    {
+        for (size_t b = 0; b < blockCount; ++b)
+        {
+            maxVelocityDelta = std::max(maxVelocityDelta, mIntegrationBlockMaxVelocityDeltas[b]);
+        }
+    }
+
+    return maxVelocityDelta;
+}
+
+template<bool DoMeasureConvergence>
+float Ship::IntegrateAndResetDynamicForces(
+    size_t startPointIndex,
+    size_t endPointIndex,
+    vec2f * restrict positionBufferVec2,
+    vec2f * restrict velocityBufferVec2,
+    float dt,
+    float velocityFactor)
+{
+    //
+    // Take the buffers that we need as restrict pointers, so that the compiler
+    // can better see it should parallelize this loop as much as possible
+    //
+    // This loop is compiled with single-precision packet SSE instructions on MSVC 17,
+    // integrating two points at each iteration
+    //
+
+    float * const restrict positionBuffer = reinterpret_cast<float *>(positionBufferVec2);
+    float * const restrict velocityBuffer = reinterpret_cast<float *>(velocityBufferVec2);
+    float * const restrict dynamicForceBuffer = mPoints.GetDynamicForceBufferAsFloat();
+    float const * const restrict staticForceBuffer = mPoints.GetStaticForceBufferAsFloat();
+    float const * const restrict integrationFactorBuffer = mPoints.GetIntegrationFactorBufferAsFloat();
+
+    size_t const start = startPointIndex * 2; // Two components per vector
+    size_t const end = endPointIndex * 2; // Two components per vector
+
+    // Ephemeral particles are not part of the ship's structure, hence they do
+    // not take part in convergence
+    size_t const shipCount = mPoints.GetAlignedShipPointCount() * 2; // Two components per vector
+    float maxVelocityDelta = 0.0f;
+
+    //
+    // Reduce the dynamic forces of the parallel spring relaxation partitions,
+    // in partition order, zeroing them out for the next iteration
+    //
+
+    for (auto & partitionDynamicForceBuffer : mSpringRelaxationDynamicForceBuffers)
+    {
+        float * const restrict partitionDynamicForceBufferFloat = reinterpret_cast<float *>(partitionDynamicForceBuffer.data());
+
+        for (size_t i = start; i < end; ++i)
+        {
+            dynamicForceBuffer[i] += partitionDynamicForceBufferFloat[i];
+            partitionDynamicForceBufferFloat[i] = 0.0f;
+        }
+    }
+
+    for (size_t i = start; i < end; ++i)
+    {
         //
-        // Apply forces
+        // Verlet integration (fourth order, with velocity being first order)
         //
 
-        vec2f const forceA = springDir * (fSpring + fDamp);
-        pointDynamicForceBuffer[pointAIndex] += forceA;
-        pointDynamicForceBuffer[pointBIndex] -= forceA;
+        float const deltaPos =
+            velocityBuffer[i] * dt
+            + (dynamicForceBuffer[i] + staticForceBuffer[i]) * integrationFactorBuffer[i];
+
+        positionBuffer[i] += deltaPos;
+
+        float const newVelocity = deltaPos * velocityFactor;
+
+        if constexpr (DoMeasureConvergence)
+        {
+            if (i < shipCount)
+            {
+                maxVelocityDelta = std::max(maxVelocityDelta, std::abs(newVelocity - velocityBuffer[i]));
+            }
+        }
+
+        velocityBuffer[i] = newVelocity;
+
+        // Zero out dynamic force now that we've integrated it
+        dynamicForceBuffer[i] = 0.0f;
     }
+
+    return maxVelocityDelta;
 }
 
-void Ship::IntegrateAndResetDynamicForces(GameParameters const & gameParameters)
+void Ship::ExtrapolateConvergedMechanicalDynamics(
+    int iterationCount,
+    GameParameters const & gameParameters)
 {
+    //
+    // The forces acting on the ship are balanced, hence over the specified iterations
+    // its points would just keep moving at their current velocities, damped at each
+    // iteration; we thus cover all these iterations at once
+    //
+    // Ephemeral particles are not part of the ship's structure and might be far from
+    // any equilibrium, hence we keep integrating them - as they have no springs, this
+    // is exactly what the iterations would do
+    //
+
     float const dt = gameParameters.MechanicalSimulationStepTimeDuration<float>();
+    float const globalDampingCoefficient = CalculateGlobalDampingCoefficient(gameParameters);
+    float const velocityFactor = globalDampingCoefficient / dt;
+
+    float * const restrict positionBuffer = mPoints.GetPositionBufferAsFloat();
+    float * const restrict velocityBuffer = mPoints.GetVelocityBufferAsFloat();
+    float const * const restrict staticForceBuffer = mPoints.GetStaticForceBufferAsFloat();
+    float const * const restrict integrationFactorBuffer = mPoints.GetIntegrationFactorBufferAsFloat();
+
+    size_t const count = mPoints.GetBufferElementCount() * 2; // Two components per vector
+    size_t const shipCount = mPoints.GetAlignedShipPointCount() * 2; // Two components per vector
 
+    // Displacement and velocity multipliers after all iterations: 1 + d + ... + d^(n-1) and d^n
+    float displacementMultiplier = 0.0f;
+    float velocityMultiplier = 1.0f;
+    for (int iter = 0; iter < iterationCount; ++iter)
+    {
+        displacementMultiplier += velocityMultiplier;
+        velocityMultiplier *= globalDampingCoefficient;
+    }
+
+    displacementMultiplier *= dt;
+
+    for (size_t i = 0; i < shipCount; ++i)
+    {
+        positionBuffer[i] += velocityBuffer[i] * displacementMultiplier;
+        velocityBuffer[i] *= velocityMultiplier;
+    }
+
+    for (int iter = 0; iter < iterationCount; ++iter)
+    {
+        for (size_t i = shipCount; i < count; ++i)
+        {
+            float const deltaPos =
+                velocityBuffer[i] * dt
+                + staticForceBuffer[i] * integrationFactorBuffer[i];
+
+            positionBuffer[i] += deltaPos;
+            velocityBuffer[i] = deltaPos * velocityFactor;
+        }
+    }
+
+#ifdef _DEBUG
+    mPoints.Diagnostic_MarkPositionsAsDirty();
+#endif
+}
+
+float Ship::CalculateGlobalDampingCoefficient(GameParameters const & gameParameters)
+{
     // Global damp - lowers velocity uniformly, damping oscillations originating between gravity and buoyancy
     //
     // Considering that:
@@ -1858,50 +2863,31 @@ void Ship::IntegrateAndResetDynamicForces(GameParameters const & gameParameters)
                 * (1.0f - globalDamping)
         );
 
-    // Pre-divide damp coefficient by dt to provide the scalar factor which, when multiplied with a displacement,
-    // provides the final, damped velocity
-    float const velocityFactor = globalDampingCoefficient / dt;
-
-    //
-    // Take the four buffers that we need as restrict pointers, so that the compiler
-    // can better see it should parallelize this loop as much as possible
-    //
-    // This loop is compiled with single-precision packet SSE instructions on MSVC 17,
-    // integrating two points at each iteration
-    //
-
-    float * const restrict positionBuffer = mPoints.GetPositionBufferAsFloat();
-    float * const restrict velocityBuffer = mPoints.GetVelocityBufferAsFloat();
-    float * const restrict dynamicForceBuffer = mPoints.GetDynamicForceBufferAsFloat();
-    float const * const restrict staticForceBuffer = mPoints.GetStaticForceBufferAsFloat();
-    float const * const restrict integrationFactorBuffer = mPoints.GetIntegrationFactorBufferAsFloat();
-
-    size_t const count = mPoints.GetBufferElementCount() * 2; // Two components per vector
-    for (size_t i = 0; i < count; ++i)
-    {
-        //
-        // Verlet integration (fourth order, with velocity being first order)
-        //
-
-        float const deltaPos =
-            velocityBuffer[i] * dt
-            + (dynamicForceBuffer[i] + staticForceBuffer[i]) * integrationFactorBuffer[i];
-
-        positionBuffer[i] += deltaPos;
-        velocityBuffer[i] = deltaPos * velocityFactor;
+    return globalDampingCoefficient;
+}
 
-        // Zero out dynamic force now that we've integrated it
-        dynamicForceBuffer[i] = 0.0f;
-    }
+void Ship::HandleCollisionsWithSeaFloor(
+    float dt,
+    GameParameters const & gameParameters)
+{
+    FS_PROFILE_SCOPE("Ship::HandleCollisionsWithSeaFloor");
 
-#ifdef _DEBUG
-    mPoints.Diagnostic_MarkPositionsAsDirty();
-#endif
+    HandleCollisionsWithSeaFloor(
+        0,
+        mPoints.GetElementCount(),
+        mPoints.GetPositionBufferAsVec2(),
+        mPoints.GetVelocityBufferAsVec2(),
+        dt,
+        gameParameters);
 }
 
 void Ship::HandleCollisionsWithSeaFloor(
+    ElementIndex startPointIndex,
+    ElementIndex endPointIndex, // Excluded
+    vec2f * restrict positionBuffer,
+    vec2f * restrict velocityBuffer,
     float dt,
-    GameParameters const & gameParameters)
+    GameParameters const & gameParameters) const
 {
     OceanFloor const & oceanFloor = mParentWorld.GetOceanFloor();
 
@@ -1911,9 +2897,9 @@ void Ship::HandleCollisionsWithSeaFloor(
     float const siltingFactor1 = gameParameters.OceanFloorSiltHardness;
     float const siltingFactor2 = 1.0f - gameParameters.OceanFloorSiltHardness;
 
-    for (auto pointIndex : mPoints)
+    for (ElementIndex pointIndex = startPointIndex; pointIndex < endPointIndex; ++pointIndex)
     {
-        auto const & position = mPoints.GetPosition(pointIndex);
+        vec2f const position = positionBuffer[pointIndex];
 
         // Check if point is below the sea floor
         //
@@ -1929,7 +2915,7 @@ void Ship::HandleCollisionsWithSeaFloor(
             // Calculate post-bounce velocity
             //
 
-            vec2f const pointVelocity = mPoints.GetVelocity(pointIndex);
+            vec2f const pointVelocity = velocityBuffer[pointIndex];
 
             // Calculate sea floor anti-normal
             // (positive points down)
@@ -1974,21 +2960,451 @@ void Ship::HandleCollisionsWithSeaFloor(
                 vec2f deltaPosition = pointVelocity * dt * siltingCoeff;
                 float const deltaPositionLength = deltaPosition.length();
                 deltaPosition = deltaPosition.normalise_approx(deltaPositionLength) * std::min(deltaPositionLength, 0.01f); // Magic number, empirical
-                mPoints.SetPosition(
-                    pointIndex,
-                    mPoints.GetPosition(pointIndex) - deltaPosition);
+                positionBuffer[pointIndex] = position - deltaPosition;
+
+                // Set velocity to resultant collision velocity
+                velocityBuffer[pointIndex] = (normalResponse + tangentialResponse) * siltingCoeff;
+            }
+        }
+    }
+}
+
+void Ship::SolveRopeConstraints()
+{
+    if (mRopeSpringIndices.empty())
+    {
+        return;
+    }
+
+    FS_PROFILE_SCOPE("Ship::SolveRopeConstraints");
+
+    //
+    // Rope springs alone can't keep long ropes from stretching, unless they are made
+    // of many points and relaxed with many iterations; we thus complement them with
+    // a position-based, stretch-only distance constraint on each rope spring, solved
+    // with a few Gauss-Seidel iterations.
+    //
+    // The solver is warm-started with a fraction of the shortening that each spring
+    // needed at the previous step; since we accumulate the total shortening and clamp
+    // it to non-negative values, a warm-start that turns out to be excessive is undone
+    // by the iterations.
+    //
+
+    // Ropes may stretch up to this fraction of their rest length before being constrained
+    float constexpr RopeMaxStretch = 0.02f;
+
+    // The fraction of the last step's correction that we start from
+    float constexpr RopeWarmStartFactor = 0.8f;
+
+    size_t constexpr RopeConstraintIterations = 4;
+
+    vec2f * const restrict positionBuffer = mPoints.GetPositionBufferAsVec2();
+    vec2f * const restrict velocityBuffer = mPoints.GetVelocityBufferAsVec2();
+
+    auto const getInverseMass = [this](ElementIndex pointIndex)
+    {
+        return (mPoints.IsPinned(pointIndex) || mPoints.IsSleeping(pointIndex))
+            ? 0.0f
+            : 1.0f / mPoints.GetMass(pointIndex);
+    };
+
+    //
+    // 1. Warm-start
+    //
+
+    for (auto const springIndex : mRopeSpringIndices)
+    {
+        float correction = 0.0f;
+
+        ElementIndex const pointAIndex = mSprings.GetEndpointAIndex(springIndex);
+        ElementIndex const pointBIndex = mSprings.GetEndpointBIndex(springIndex);
+
+        float const inverseMassA = getInverseMass(pointAIndex);
+        float const inverseMassB = getInverseMass(pointBIndex);
+        float const totalInverseMass = inverseMassA + inverseMassB;
+
+        if (!mSprings.IsDeleted(springIndex) && totalInverseMass != 0.0f)
+        {
+            vec2f const displacement = positionBuffer[pointBIndex] - positionBuffer[pointAIndex];
+            float const length = displacement.length();
+            if (length > 0.0f)
+            {
+                correction = mSprings.GetRopeConstraintCorrection(springIndex) * RopeWarmStartFactor;
+
+                vec2f const correctionVector = displacement.normalise(length) * (correction / totalInverseMass);
+                positionBuffer[pointAIndex] += correctionVector * inverseMassA;
+                positionBuffer[pointBIndex] -= correctionVector * inverseMassB;
+            }
+        }
+
+        mSprings.SetRopeConstraintCorrection(springIndex, correction);
+    }
+
+    //
+    // 2. Iterate
+    //
+
+    for (size_t iter = 0; iter < RopeConstraintIterations; ++iter)
+    {
+        for (auto const springIndex : mRopeSpringIndices)
+        {
+            if (mSprings.IsDeleted(springIndex))
+            {
+                continue;
+            }
+
+            ElementIndex const pointAIndex = mSprings.GetEndpointAIndex(springIndex);
+            ElementIndex const pointBIndex = mSprings.GetEndpointBIndex(springIndex);
+
+            float const inverseMassA = getInverseMass(pointAIndex);
+            float const inverseMassB = getInverseMass(pointBIndex);
+            float const totalInverseMass = inverseMassA + inverseMassB;
+            if (totalInverseMass == 0.0f)
+            {
+                continue;
+            }
+
+            vec2f const displacement = positionBuffer[pointBIndex] - positionBuffer[pointAIndex];
+            float const length = displacement.length();
+            if (length == 0.0f)
+            {
+                continue;
+            }
+
+            float const maxLength = mSprings.GetRestLength(springIndex) * (1.0f + RopeMaxStretch);
+
+            // Accumulate, keeping the total shortening non-negative - ropes only pull
+            float const oldCorrection = mSprings.GetRopeConstraintCorrection(springIndex);
+            float const newCorrection = std::max(oldCorrection + (length - maxLength), 0.0f);
+            mSprings.SetRopeConstraintCorrection(springIndex, newCorrection);
+
+            vec2f const correctionVector = displacement.normalise(length) * ((newCorrection - oldCorrection) / totalInverseMass);
+            positionBuffer[pointAIndex] += correctionVector * inverseMassA;
+            positionBuffer[pointBIndex] -= correctionVector * inverseMassB;
+        }
+    }
+
+    //
+    // 3. Remove the separating velocity of the endpoints of taut ropes, or else
+    //    the next step would stretch them again
+    //
+
+    for (auto const springIndex : mRopeSpringIndices)
+    {
+        if (mSprings.IsDeleted(springIndex) || mSprings.GetRopeConstraintCorrection(springIndex) == 0.0f)
+        {
+            continue;
+        }
+
+        ElementIndex const pointAIndex = mSprings.GetEndpointAIndex(springIndex);
+        ElementIndex const pointBIndex = mSprings.GetEndpointBIndex(springIndex);
+
+        float const inverseMassA = getInverseMass(pointAIndex);
+        float const inverseMassB = getInverseMass(pointBIndex);
+        float const totalInverseMass = inverseMassA + inverseMassB;
+
+        vec2f const displacement = positionBuffer[pointBIndex] - positionBuffer[pointAIndex];
+        float const length = displacement.length();
+        if (totalInverseMass == 0.0f || length == 0.0f)
+        {
+            continue;
+        }
+
+        vec2f const direction = displacement.normalise(length);
+        float const separatingVelocity = (velocityBuffer[pointBIndex] - velocityBuffer[pointAIndex]).dot(direction);
+        if (separatingVelocity > 0.0f)
+        {
+            vec2f const velocityCorrection = direction * (separatingVelocity / totalInverseMass);
+            velocityBuffer[pointAIndex] += velocityCorrection * inverseMassA;
+            velocityBuffer[pointBIndex] -= velocityCorrection * inverseMassB;
+        }
+    }
+}
+
+void Ship::RecalculateRopeSpringIndices()
+{
+    mRopeSpringIndices.clear();
+
+    for (auto const springIndex : mSprings)
+    {
+        if (mSprings.IsRope(springIndex))
+        {
+            mRopeSpringIndices.push_back(springIndex);
+        }
+    }
+}
+
+void Ship::WakeUpDisturbedConnectedComponents(GameParameters const & gameParameters)
+{
+    if (mSleepingConnectedComponentCount == 0)
+    {
+        return;
+    }
+
+    if (!gameParameters.DoPutRestingConnectedComponentsToSleep)
+    {
+        WakeUpAllConnectedComponents();
+        return;
+    }
+
+    FS_PROFILE_SCOPE("Ship::WakeUpDisturbedConnectedComponents");
+
+    //
+    // A sleeping connected component is disturbed when any of its points has been moved
+    // or has been given a velocity - e.g. by interactions - or when the static force on
+    // any of its points has changed significantly since the component fell asleep - e.g.
+    // because of water intake or explosions
+    //
+
+    float constexpr MaxStaticForceChange = 0.05f; // Fraction
+    float constexpr MinStaticForceMagnitude = 1.0f; // N
+
+    size_t wokenUpConnectedComponentCount = 0;
+
+    for (auto const pointIndex : mPoints.RawShipPoints())
+    {
+        if (mPoints.IsSleeping(pointIndex))
+        {
+            auto & sleepState = mConnectedComponentSleepStates[mPoints.GetConnectedComponentId(pointIndex)];
+            if (sleepState.IsAsleep)
+            {
+                vec2f const & sleepingStaticForce = mSleepingPointStaticForces[pointIndex];
+
+                if (mPoints.GetPosition(pointIndex) != mSleepingPointPositions[pointIndex]
+                    || mPoints.GetVelocity(pointIndex) != vec2f::zero()
+                    || (mPoints.GetStaticForce(pointIndex) - sleepingStaticForce).squareLength()
+                        > MaxStaticForceChange * MaxStaticForceChange
+                            * std::max(sleepingStaticForce.squareLength(), MinStaticForceMagnitude * MinStaticForceMagnitude))
+                {
+                    sleepState.IsAsleep = false;
+                    sleepState.RestingStepCount = 0;
+
+                    ++wokenUpConnectedComponentCount;
+                }
+            }
+        }
+    }
+
+    if (wokenUpConnectedComponentCount > 0)
+    {
+        for (auto const pointIndex : mPoints.RawShipPoints())
+        {
+            if (mPoints.IsSleeping(pointIndex)
+                && !mConnectedComponentSleepStates[mPoints.GetConnectedComponentId(pointIndex)].IsAsleep)
+            {
+                mPoints.WakeUp(pointIndex);
+            }
+        }
+
+        assert(mSleepingConnectedComponentCount >= wokenUpConnectedComponentCount);
+        mSleepingConnectedComponentCount -= wokenUpConnectedComponentCount;
+
+        RecalculateAwakeSpringRanges();
+    }
+}
+
+void Ship::PutRestingConnectedComponentsToSleep(GameParameters const & gameParameters)
+{
+    if (!gameParameters.DoPutRestingConnectedComponentsToSleep)
+    {
+        return;
+    }
+
+    FS_PROFILE_SCOPE("Ship::PutRestingConnectedComponentsToSleep");
+
+    // The kinetic energy per unit of mass below which a connected component is at rest,
+    // i.e. the energy of a component whose points all move at ~3cm/s
+    float constexpr RestingKineticEnergyPerMass = 0.0005f; // J/kg
+
+    // The number of consecutive steps a connected component has to be at rest
+    // for, before it falls asleep
+    std::uint32_t constexpr RestingStepsBeforeSleep = 128;
+
+    assert(mConnectedComponentSleepStates.size() == mConnectedComponentSizes.size());
+
+    //
+    // Calculate the kinetic energy of all awake connected components
+    //
+
+    for (auto const pointIndex : mPoints.RawShipPoints())
+    {
+        auto & sleepState = mConnectedComponentSleepStates[mPoints.GetConnectedComponentId(pointIndex)];
+        if (!sleepState.IsAsleep)
+        {
+            float const mass = mPoints.GetMass(pointIndex);
+            sleepState.KineticEnergy += 0.5f * mass * mPoints.GetVelocity(pointIndex).squareLength();
+            sleepState.Mass += mass;
+        }
+    }
+
+    //
+    // Detect those that have been at rest long enough
+    //
+
+    size_t fallenAsleepConnectedComponentCount = 0;
+
+    for (auto & sleepState : mConnectedComponentSleepStates)
+    {
+        if (!sleepState.IsAsleep)
+        {
+            if (sleepState.KineticEnergy <= RestingKineticEnergyPerMass * sleepState.Mass)
+            {
+                ++sleepState.RestingStepCount;
+                if (sleepState.RestingStepCount >= RestingStepsBeforeSleep)
+                {
+                    sleepState.IsAsleep = true;
+
+                    ++fallenAsleepConnectedComponentCount;
+                }
+            }
+            else
+            {
+                sleepState.RestingStepCount = 0;
+            }
+
+            sleepState.KineticEnergy = 0.0f;
+            sleepState.Mass = 0.0f;
+        }
+    }
+
+    //
+    // Put their points to sleep
+    //
+
+    if (fallenAsleepConnectedComponentCount > 0)
+    {
+        for (auto const pointIndex : mPoints.RawShipPoints())
+        {
+            if (!mPoints.IsSleeping(pointIndex)
+                && mConnectedComponentSleepStates[mPoints.GetConnectedComponentId(pointIndex)].IsAsleep)
+            {
+                mPoints.PutToSleep(pointIndex);
+
+                mSleepingPointPositions[pointIndex] = mPoints.GetPosition(pointIndex);
+                mSleepingPointStaticForces[pointIndex] = mPoints.GetStaticForce(pointIndex);
+            }
+        }
+
+        mSleepingConnectedComponentCount += fallenAsleepConnectedComponentCount;
+
+        RecalculateAwakeSpringRanges();
+    }
+}
+
+void Ship::WakeUpAllConnectedComponents()
+{
+    if (mSleepingConnectedComponentCount > 0)
+    {
+        for (auto const pointIndex : mPoints.RawShipPoints())
+        {
+            if (mPoints.IsSleeping(pointIndex))
+            {
+                mPoints.WakeUp(pointIndex);
+            }
+        }
+
+        mSleepingConnectedComponentCount = 0;
+        mAwakeSpringRanges.clear();
+    }
+
+    for (auto & sleepState : mConnectedComponentSleepStates)
+    {
+        sleepState = ConnectedComponentSleepState();
+    }
+}
+
+void Ship::RecalculateAwakeSpringRanges()
+{
+    // Awake springs separated by no more than this number of other springs are
+    // relaxed together, as relaxing a few more springs is cheaper than splitting
+    // the vectorized loop
+    ElementIndex constexpr MaxRangeGap = 32;
+
+    mAwakeSpringRanges.clear();
+
+    for (auto const springIndex : mSprings)
+    {
+        // Deleted springs have zero coefficients, and thus may be skipped
+        if (!mSprings.IsDeleted(springIndex)
+            && !mPoints.IsSleeping(mSprings.GetEndpointAIndex(springIndex)))
+        {
+            if (!mAwakeSpringRanges.empty()
+                && springIndex - mAwakeSpringRanges.back().second <= MaxRangeGap)
+            {
+                mAwakeSpringRanges.back().second = springIndex + 1;
+            }
+            else
+            {
+                mAwakeSpringRanges.emplace_back(springIndex, springIndex + 1);
+            }
+        }
+    }
+}
+
+void Ship::CompactSprings()
+{
+    FS_PROFILE_SCOPE("Ship::CompactSprings");
+
+    //
+    // Move all live springs to the front - preserving their relative order, and
+    // thus their cache-friendly layout - followed by all deleted springs; deleted
+    // springs are kept as they may be restored by repair
+    //
+
+    ElementCount const springCount = mSprings.GetElementCount();
+
+    std::vector<ElementIndex> newToOldSpringIndices;
+    newToOldSpringIndices.reserve(springCount);
+
+    for (auto const springIndex : mSprings)
+    {
+        if (!mSprings.IsDeleted(springIndex))
+            newToOldSpringIndices.push_back(springIndex);
+    }
+
+    for (auto const springIndex : mSprings)
+    {
+        if (mSprings.IsDeleted(springIndex))
+            newToOldSpringIndices.push_back(springIndex);
+    }
+
+    std::vector<ElementIndex> oldToNewSpringIndices(springCount);
+    for (ElementIndex newSpringIndex = 0; newSpringIndex < springCount; ++newSpringIndex)
+    {
+        oldToNewSpringIndices[newToOldSpringIndices[newSpringIndex]] = newSpringIndex;
+    }
+
+    //
+    // Renumber springs and all their references
+    //
 
-                // Set velocity to resultant collision velocity
-                mPoints.SetVelocity(
-                    pointIndex,
-                    (normalResponse + tangentialResponse) * siltingCoeff);
-            }
-        }
+    mSprings.Permute(newToOldSpringIndices);
+    mPoints.RemapSpringIndices(oldToNewSpringIndices);
+    mTriangles.RemapSpringIndices(oldToNewSpringIndices);
+    mFrontiers.RemapEdgeIndices(newToOldSpringIndices, oldToNewSpringIndices);
+    mElectricSparks.RemapSpringIndices(newToOldSpringIndices);
+    mGadgets.OnSpringsRenumbered(oldToNewSpringIndices);
+
+    RecalculateRopeSpringIndices();
+
+    if (mSleepingConnectedComponentCount > 0)
+    {
+        RecalculateAwakeSpringRanges();
     }
+
+    LogMessage("Ship::CompactSprings(): compacted ", mDestroyedSpringsSinceLastCompactionCount, " destroyed springs; simulating ",
+        mSprings.GetSimulatedElementCount(), " out of ", springCount, " springs");
+
+    mDestroyedSpringsSinceLastCompactionCount = 0;
+
+    // Springs need to be re-uploaded
+    mIsStructureDirty = true;
 }
 
 void Ship::TrimForWorldBounds(GameParameters const & gameParameters)
 {
+    FS_PROFILE_SCOPE("Ship::TrimForWorldBounds");
+
     float constexpr MaxWorldLeft = -GameParameters::HalfMaxWorldWidth;
     float constexpr MaxWorldRight = GameParameters::HalfMaxWorldWidth;
 
@@ -2067,6 +3483,8 @@ void Ship::UpdatePressureAndWaterInflow(
     GameParameters const & gameParameters,
     float & waterTakenInStep)
 {
+    FS_PROFILE_SCOPE("Ship::UpdatePressureAndWaterInflow");
+
     //
     // Intake/outtake pressure and water into/from all the leaking nodes (structural or forced)
     // that are either underwater or are overwater and taking rain.
@@ -2093,11 +3511,17 @@ void Ship::UpdatePressureAndWaterInflow(
     float const cumulatedIntakenWaterThresholdForAirBubbles =
         GameParameters::AirBubblesDensityToCumulatedIntakenWater(gameParameters.AirBubblesDensity);
 
-    for (auto pointIndex : mPoints.RawShipPoints())
+    // We expect a tiny fraction of all points to be leaking at any moment, hence
+    // we only visit the points that are - or have recently been - leaking
+    auto & leakingPoints = mPoints.GetLeakingPoints();
+    leakingPoints.Update(
+        [this](ElementIndex pointIndex)
+        {
+            return !mPoints.GetLeakingComposite(pointIndex).IsCumulativelyLeaking;
+        });
+
+    for (auto pointIndex : leakingPoints.GetMembers())
     {
-        // This is one of the few cases in which we prefer branching over calculating
-        // for all points, mostly because we expect a tiny fraction of all points to
-        // be leaking at any moment
         auto const & pointCompositeLeaking = mPoints.GetLeakingComposite(pointIndex);
         if (pointCompositeLeaking.IsCumulativelyLeaking)
         {
@@ -2291,10 +3715,9 @@ void Ship::UpdatePressureAndWaterInflow(
     }
 }
 
-void Ship::EqualizeInternalPressure(GameParameters const & /*gameParameters*/)
+void Ship::EqualizeInternalPressure(GameParameters const & gameParameters)
 {
-    // Local cache of indices of other endpoints
-    FixedSizeVector<ElementIndex, GameParameters::MaxSpringsPerPoint> otherEndpoints;
+    FS_PROFILE_SCOPE("Ship::EqualizeInternalPressure");
 
     //
     // For each (non-ephemeral) point, equalize its internal pressure with its
@@ -2304,104 +3727,353 @@ void Ship::EqualizeInternalPressure(GameParameters const & /*gameParameters*/)
     float * restrict internalPressureBufferData = mPoints.GetInternalPressureBufferAsFloat();
     bool const * restrict isHullBufferData = mPoints.GetIsHullBuffer();
 
-    for (auto pointIndex : mPoints.RawShipPoints()) // No need to visit ephemeral points as they have no springs
+    if (IsWaterAndPressureUpdateConcurrent(gameParameters))
     {
-        if (!isHullBufferData[pointIndex])
+        //
+        // Visit one colour at a time; points of the same colour have disjoint
+        // neighborhoods, hence the visit is equivalent to a serial visit in
+        // which points are ordered by colour
+        //
+
+        if (mPointColourStarts.empty())
         {
-            //
-            // Non-hull particle: flow its surplus pressure to its neighbors
-            //
+            CalculatePointColouring();
+        }
+
+        for (size_t c = 0; c < mPointColourStarts.size() - 1; ++c)
+        {
+            mTaskThreadPool->ParallelFor(
+                mPointColourStarts[c],
+                mPointColourStarts[c + 1],
+                WaterAndPressureUpdatePointGrain,
+                [&](size_t start, size_t end)
+                {
+                    for (size_t i = start; i < end; ++i)
+                    {
+                        EqualizeInternalPressureAt(
+                            mColouredPoints[i],
+                            internalPressureBufferData,
+                            isHullBufferData);
+                    }
+                });
+        }
+    }
+    else
+    {
+        for (auto pointIndex : mPoints.RawShipPoints()) // No need to visit ephemeral points as they have no springs
+        {
+            EqualizeInternalPressureAt(
+                pointIndex,
+                internalPressureBufferData,
+                isHullBufferData);
+        }
+    }
+}
 
-            float const internalPressure = internalPressureBufferData[pointIndex];
+inline void Ship::EqualizeInternalPressureAt(
+    ElementIndex pointIndex,
+    float * restrict internalPressureBufferData,
+    bool const * restrict isHullBufferData)
+{
+    if (!isHullBufferData[pointIndex])
+    {
+        //
+        // Non-hull particle: flow its surplus pressure to its neighbors
+        //
 
-            //
-            // 1. Calculate average internal pressure among this particle and all its neighbors that have
-            // lower internal pressure
-            //
+        // Local cache of indices of other endpoints
+        FixedSizeVector<ElementIndex, GameParameters::MaxSpringsPerPoint> otherEndpoints;
 
-            float averageInternalPressure = internalPressure;
-            float targetEndpointsCount = 1.0f;
+        float const internalPressure = internalPressureBufferData[pointIndex];
 
-            for (auto const & cs : mPoints.GetConnectedSprings(pointIndex).ConnectedSprings)
-            {
-                ElementIndex const otherEndpointIndex = cs.OtherEndpointIndex;
+        //
+        // 1. Calculate average internal pressure among this particle and all its neighbors that have
+        // lower internal pressure
+        //
 
-                // We only consider outgoing pressure, not towards hull points
-                float const otherEndpointInternalPressure = internalPressureBufferData[otherEndpointIndex];
-                if (internalPressure > otherEndpointInternalPressure
-                    && !isHullBufferData[otherEndpointIndex])
-                {
-                    averageInternalPressure += otherEndpointInternalPressure;
-                    targetEndpointsCount += 1.0f;
+        float averageInternalPressure = internalPressure;
+        float targetEndpointsCount = 1.0f;
 
-                    otherEndpoints.emplace_back(otherEndpointIndex);
-                }
+        auto const connectedSprings = mPoints.GetConnectedSpringsAdjacency(pointIndex);
+        for (ElementCount s = 0; s < connectedSprings.Count; ++s)
+        {
+            ElementIndex const otherEndpointIndex = connectedSprings.NeighborIndices[s];
+
+            // We only consider outgoing pressure, not towards hull points
+            float const otherEndpointInternalPressure = internalPressureBufferData[otherEndpointIndex];
+            if (internalPressure > otherEndpointInternalPressure
+                && !isHullBufferData[otherEndpointIndex])
+            {
+                averageInternalPressure += otherEndpointInternalPressure;
+                targetEndpointsCount += 1.0f;
+
+                otherEndpoints.emplace_back(otherEndpointIndex);
             }
+        }
 
-            averageInternalPressure /= targetEndpointsCount;
+        averageInternalPressure /= targetEndpointsCount;
 
-            //
-            // 2. Distribute surplus pressure
-            //
+        //
+        // 2. Distribute surplus pressure
+        //
+
+        internalPressureBufferData[pointIndex] = averageInternalPressure;
+
+        for (auto const & otherEndpointIndex : otherEndpoints)
+        {
+            internalPressureBufferData[otherEndpointIndex] = averageInternalPressure;
+        }
+    }
+    else
+    {
+        //
+        // Hull particle: set its internal pressure to the average internal pressure
+        // of all its non-hull neighbors
+        //
 
-            internalPressureBufferData[pointIndex] = averageInternalPressure;
+        float averageInternalPressure = 0.0f;
+        float neighborsCount = 0.0f;
 
-            for (auto const & otherEndpointIndex : otherEndpoints)
+        auto const connectedSprings = mPoints.GetConnectedSpringsAdjacency(pointIndex);
+        for (ElementCount s = 0; s < connectedSprings.Count; ++s)
+        {
+            ElementIndex const otherEndpointIndex = connectedSprings.NeighborIndices[s];
+            if (!isHullBufferData[otherEndpointIndex])
             {
-                internalPressureBufferData[otherEndpointIndex] = averageInternalPressure;
+                averageInternalPressure += internalPressureBufferData[otherEndpointIndex];
+                neighborsCount += 1.0f;
             }
+        }
 
-            otherEndpoints.clear();
+        if (neighborsCount != 0.0f)
+        {
+            internalPressureBufferData[pointIndex] = averageInternalPressure / neighborsCount;
         }
-        else
+    }
+}
+
+void Ship::UpdateWaterVelocities(
+    GameParameters const & gameParameters,
+    float & waterSplashed)
+{
+    FS_PROFILE_SCOPE("Ship::UpdateWaterVelocities");
+
+    //
+    // For each (non-ephemeral) point, move each spring's outgoing water momentum to
+    // its destination point
+    //
+    // Implementation of https://gabrielegiuseppini.wordpress.com/2018/09/08/momentum-based-simulation-of-water-flooding-2d-spaces/
+    //
+    // Points without water send out no water, hence we only visit wet points as
+    // sources of flows; the result is identical to visiting all points
+    //
+
+    auto & wetPoints = mPoints.GetWetPoints();
+
+    if (!wetPoints.IsEmpty())
+    {
+        // Calculate water momenta
+        mPoints.UpdateWaterMomentaFromVelocities();
+
+        // Source and result water buffers
+        auto oldPointWaterBuffer = mPoints.MakeWaterBufferCopy();
+        float const * restrict oldPointWaterBufferData = oldPointWaterBuffer->data();
+        float * restrict newPointWaterBufferData = mPoints.GetWaterBufferAsFloat();
+        vec2f * restrict oldPointWaterVelocityBufferData = mPoints.GetWaterVelocityBufferAsVec2();
+        vec2f * restrict newPointWaterMomentumBufferData = mPoints.GetWaterMomentumBufferAsVec2f();
+
+        // The wet points, in ascending order; points that become wet during this
+        // step are appended to the set, and need not be visited
+        auto const & wetPointIndices = wetPoints.GetMembers();
+        size_t const wetPointCount = wetPointIndices.size();
+
+        if (IsWaterAndPressureUpdateConcurrent(gameParameters))
         {
             //
-            // Hull particle: set its internal pressure to the average internal pressure
-            // of all its non-hull neighbors
+            // Two phases: first we calculate - concurrently - the outbound flows of all wet points,
+            // and then we make each wet point and each of their neighbors gather - concurrently - its
+            // outbound and inbound flows, in the same order in which the serial visit would apply them;
+            // the result is hence identical to the serial visit's
             //
 
-            float averageInternalPressure = 0.0f;
-            float neighborsCount = 0.0f;
+            size_t const slotCount = static_cast<size_t>(mPoints.GetRawShipPointCount()) * GameParameters::MaxSpringsPerPoint;
+            if (mSpringOutboundQuantitiesOfWater.size() != slotCount)
+            {
+                mSpringOutboundQuantitiesOfWater.resize(slotCount);
+                mSpringOutboundWaterVelocities.resize(slotCount);
+            }
+
+            auto pointWaterSplashedBuffer = mPoints.AllocateWorkBufferFloat();
+            float * restrict pointWaterSplashedBufferData = pointWaterSplashedBuffer->data();
+
+            mTaskThreadPool->ParallelFor(
+                0,
+                wetPointCount,
+                WaterAndPressureUpdatePointGrain,
+                [&](size_t start, size_t end)
+                {
+                    for (size_t i = start; i < end; ++i)
+                    {
+                        ElementIndex const pointIndex = wetPointIndices[i];
+                        size_t const firstSlot = static_cast<size_t>(pointIndex) * GameParameters::MaxSpringsPerPoint;
+
+                        pointWaterSplashedBufferData[pointIndex] = CalculateWaterOutboundFlowsAt(
+                            pointIndex,
+                            oldPointWaterBufferData,
+                            oldPointWaterVelocityBufferData,
+                            gameParameters,
+                            mSpringOutboundQuantitiesOfWater.data() + firstSlot,
+                            mSpringOutboundWaterVelocities.data() + firstSlot);
+                    }
+                });
+
+            CalculatePointNeighborhood(wetPointIndices, mPointNeighborhood);
+
+            mTaskThreadPool->ParallelFor(
+                0,
+                mPointNeighborhood.size(),
+                WaterAndPressureUpdatePointGrain,
+                [&](size_t start, size_t end)
+                {
+                    for (size_t i = start; i < end; ++i)
+                    {
+                        GatherWaterFlowsAt(
+                            mPointNeighborhood[i],
+                            wetPoints,
+                            oldPointWaterVelocityBufferData,
+                            newPointWaterBufferData,
+                            newPointWaterMomentumBufferData);
+                    }
+                });
+
+            // Sum splashes in point order, for determinism
+            for (size_t i = 0; i < wetPointCount; ++i)
+            {
+                waterSplashed += pointWaterSplashedBufferData[wetPointIndices[i]];
+            }
 
-            for (auto const & cs : mPoints.GetConnectedSprings(pointIndex).ConnectedSprings)
+            // Remember the points that got wet
+            for (auto const pointIndex : mPointNeighborhood)
             {
-                ElementIndex const otherEndpointIndex = cs.OtherEndpointIndex;
-                if (!isHullBufferData[otherEndpointIndex])
+                if (newPointWaterBufferData[pointIndex] != 0.0f)
                 {
-                    averageInternalPressure += internalPressureBufferData[otherEndpointIndex];
-                    neighborsCount += 1.0f;
+                    wetPoints.Add(pointIndex);
                 }
             }
+        }
+        else
+        {
+            // Outbound quantities of water and velocities along each spring of the point being visited
+            std::array<float, GameParameters::MaxSpringsPerPoint> springOutboundQuantitiesOfWater;
+            std::array<vec2f, GameParameters::MaxSpringsPerPoint> springOutboundWaterVelocities;
 
-            if (neighborsCount != 0.0f)
+            for (size_t i = 0; i < wetPointCount; ++i)
             {
-                internalPressureBufferData[pointIndex] = averageInternalPressure / neighborsCount;
+                ElementIndex const pointIndex = wetPointIndices[i];
+
+                waterSplashed += CalculateWaterOutboundFlowsAt(
+                    pointIndex,
+                    oldPointWaterBufferData,
+                    oldPointWaterVelocityBufferData,
+                    gameParameters,
+                    springOutboundQuantitiesOfWater.data(),
+                    springOutboundWaterVelocities.data());
+
+                //
+                // Move water along all springs according to their flows,
+                // and update destination's momenta accordingly
+                //
+
+                auto const connectedSprings = mPoints.GetConnectedSpringsAdjacency(pointIndex);
+                ElementCount const connectedSpringCount = connectedSprings.Count;
+                for (ElementCount s = 0; s < connectedSpringCount; ++s)
+                {
+                    ElementIndex const springIndex = connectedSprings.EdgeIndices[s];
+                    ElementIndex const otherEndpointIndex = connectedSprings.NeighborIndices[s];
+
+                    float const springOutboundQuantityOfWater = springOutboundQuantitiesOfWater[s];
+
+                    if (mSprings.GetWaterPermeability(springIndex) != 0.0f)
+                    {
+                        //
+                        // Water - and momentum - move from point to endpoint
+                        //
+
+                        // Move water quantity
+                        newPointWaterBufferData[pointIndex] -= springOutboundQuantityOfWater;
+                        newPointWaterBufferData[otherEndpointIndex] += springOutboundQuantityOfWater;
+
+                        // Remove "old momentum" (old velocity) from point
+                        newPointWaterMomentumBufferData[pointIndex] -=
+                            oldPointWaterVelocityBufferData[pointIndex]
+                            * springOutboundQuantityOfWater;
+
+                        // Add "new momentum" (old velocity + velocity gained) to other endpoint
+                        newPointWaterMomentumBufferData[otherEndpointIndex] +=
+                            springOutboundWaterVelocities[s]
+                            * springOutboundQuantityOfWater;
+
+                        // Remember the other endpoint got wet
+                        if (springOutboundQuantityOfWater != 0.0f)
+                        {
+                            wetPoints.Add(otherEndpointIndex);
+                        }
+                    }
+                    else
+                    {
+                        //
+                        // New momentum (old velocity + velocity gained) bounces back
+                        // (and zeroes outgoing), assuming perfectly inelastic collision
+                        //
+                        // No changes to other endpoint
+                        //
+
+                        newPointWaterMomentumBufferData[pointIndex] -=
+                            springOutboundWaterVelocities[s]
+                            * springOutboundQuantityOfWater;
+                    }
+                }
             }
         }
+
+        //
+        // Transforming momenta into velocities
+        //
+
+        mPoints.UpdateWaterVelocitiesFromMomenta();
+
+        //
+        // Forget the points that have been dry for a while
+        //
+
+        wetPoints.Update(
+            [newPointWaterBufferData](ElementIndex pointIndex)
+            {
+                return newPointWaterBufferData[pointIndex] == 0.0f;
+            });
     }
+
+
+    //
+    // Average kinetic energy loss
+    //
+
+    waterSplashed = mWaterSplashedRunningAverage.Update(waterSplashed);
 }
 
-void Ship::UpdateWaterVelocities(
+inline float Ship::CalculateWaterOutboundFlowsAt(
+    ElementIndex pointIndex,
+    float const * restrict oldPointWaterBufferData,
+    vec2f const * restrict oldPointWaterVelocityBufferData,
     GameParameters const & gameParameters,
-    float & waterSplashed)
+    float * restrict springOutboundQuantitiesOfWater,
+    vec2f * restrict springOutboundWaterVelocities) const
 {
     //
-    // For each (non-ephemeral) point, move each spring's outgoing water momentum to
-    // its destination point
-    //
-    // Implementation of https://gabrielegiuseppini.wordpress.com/2018/09/08/momentum-based-simulation-of-water-flooding-2d-spaces/
+    // Calculates the quantities of water that the point sends out along its springs,
+    // together with their velocities, and returns the water splashed at the point
     //
 
-    // Calculate water momenta
-    mPoints.UpdateWaterMomentaFromVelocities();
-
-    // Source and result water buffers
-    auto oldPointWaterBuffer = mPoints.MakeWaterBufferCopy();
-    float const * restrict oldPointWaterBufferData = oldPointWaterBuffer->data();
-    float * restrict newPointWaterBufferData = mPoints.GetWaterBufferAsFloat();
-    vec2f * restrict oldPointWaterVelocityBufferData = mPoints.GetWaterVelocityBufferAsVec2();
-    vec2f * restrict newPointWaterMomentumBufferData = mPoints.GetWaterMomentumBufferAsVec2f();
-
     // Weights of outbound water flows along each spring, including impermeable ones;
     // set to zero for springs whose resultant scalar water velocities are
     // directed towards the point being visited
@@ -2410,281 +4082,485 @@ void Ship::UpdateWaterVelocities(
     // Total weight
     float totalOutboundWaterFlowWeight;
 
-    // Resultant water velocities along each spring
-    std::array<vec2f, GameParameters::MaxSpringsPerPoint> springOutboundWaterVelocities;
+    //
+    // 1) Calculate water momenta along *all* springs connected to this point,
+    //    including impermeable ones - as we'll eventually bounce back along those
+    //
 
+    // A higher crazyness gives more emphasys to bernoulli's velocity, as if pressures
+    // and gravity were exaggerated
     //
-    // Precalculate point "freeness factors", i.e. how much each point's
-    // quantity of water "suppresses" splashes from adjacent kinetic energy losses
+    // WV[t] = WV[t-1] + alpha * Bernoulli
     //
+    // WaterCrazyness=0   -> alpha=1
+    // WaterCrazyness=0.5 -> alpha=0.5 + 0.5*Wh
+    // WaterCrazyness=1   -> alpha=Wh
+    float const alphaCrazyness = 1.0f + gameParameters.WaterCrazyness * (oldPointWaterBufferData[pointIndex] - 1.0f);
 
-    auto pointFreenessFactorBuffer = mPoints.AllocateWorkBufferFloat();
-    float * restrict pointFreenessFactorBufferData = pointFreenessFactorBuffer->data();
-    for (auto pointIndex : mPoints.RawShipPoints())
-    {
-        pointFreenessFactorBufferData[pointIndex] =
-            FastExp(-oldPointWaterBufferData[pointIndex] * 10.0f);
-    }
+    // Kinetic energy lost at this point
+    float pointKineticEnergyLoss = 0.0f;
 
+    // Count of non-hull free and drowned neighbor points
+    float pointSplashNeighbors = 0.0f;
+    float pointSplashFreeNeighbors = 0.0f;
 
-    //
-    // Visit all non-ephemeral points and move water and its momenta
-    //
-    // No need to visit ephemeral points as they have no springs
-    //
+    totalOutboundWaterFlowWeight = 0.0f;
 
-    for (auto pointIndex : mPoints.RawShipPoints())
+    auto const connectedSprings = mPoints.GetConnectedSpringsAdjacency(pointIndex);
+    ElementCount const connectedSpringCount = connectedSprings.Count;
+    for (ElementCount s = 0; s < connectedSpringCount; ++s)
     {
+        ElementIndex const springIndex = connectedSprings.EdgeIndices[s];
+        ElementIndex const otherEndpointIndex = connectedSprings.NeighborIndices[s];
+
+        // Normalized spring vector, oriented point -> other endpoint
+        vec2f const springNormalizedVector = (mPoints.GetPosition(otherEndpointIndex) - mPoints.GetPosition(pointIndex)).normalise_approx();
+
+        // Component of the point's own water velocity along the spring
+        float const pointWaterVelocityAlongSpring =
+            oldPointWaterVelocityBufferData[pointIndex]
+            .dot(springNormalizedVector);
+
         //
-        // 1) Calculate water momenta along *all* springs connected to this point,
-        //    including impermeable ones - as we'll eventually bounce back along those
+        // Calulate Bernoulli's velocity gained along this spring, from this point to
+        // the other endpoint
         //
 
-        // A higher crazyness gives more emphasys to bernoulli's velocity, as if pressures
-        // and gravity were exaggerated
+        // Pressure difference (positive implies point -> other endpoint flow)
+        float const dw = oldPointWaterBufferData[pointIndex] - oldPointWaterBufferData[otherEndpointIndex];
+
+        // Gravity potential difference (positive implies point -> other endpoint flow)
+        float const dy = mPoints.GetPosition(pointIndex).y - mPoints.GetPosition(otherEndpointIndex).y;
+
+        // Calculate gained water velocity along this spring, from point to other endpoint
+        // (Bernoulli, 1738)
+        float bernoulliVelocityAlongSpring;
+        float const dwy = dw + dy;
+        if (dwy >= 0.0f)
+        {
+            // Gained velocity goes from point to other endpoint
+            bernoulliVelocityAlongSpring = sqrtf(2.0f * GameParameters::GravityMagnitude * dwy);
+        }
+        else
+        {
+            // Gained velocity goes from other endpoint to point
+            bernoulliVelocityAlongSpring = -sqrtf(2.0f * GameParameters::GravityMagnitude * -dwy);
+        }
+
+        // Resultant scalar velocity along spring; outbound only, as
+        // if this were inbound it wouldn't result in any movement of the point's
+        // water between these two springs. Morevoer, Bernoulli's velocity injected
+        // along this spring will be picked up later also by the other endpoint,
+        // and at that time it would move water if it agrees with its velocity
+        float const springOutboundScalarWaterVelocity = std::max(
+            pointWaterVelocityAlongSpring + bernoulliVelocityAlongSpring * alphaCrazyness,
+            0.0f);
+
+        // Store weight along spring, scaling for the greater distance traveled along
+        // diagonal springs
+        springOutboundWaterFlowWeights[s] =
+            springOutboundScalarWaterVelocity
+            / mSprings.GetFactoryRestLength(springIndex);
+
+        // Resultant outbound velocity along spring
+        springOutboundWaterVelocities[s] =
+            springNormalizedVector
+            * springOutboundScalarWaterVelocity;
+
+        // Update total outbound flow weight
+        totalOutboundWaterFlowWeight += springOutboundWaterFlowWeights[s];
+
+
         //
-        // WV[t] = WV[t-1] + alpha * Bernoulli
+        // Update splash neighbors counts
         //
-        // WaterCrazyness=0   -> alpha=1
-        // WaterCrazyness=0.5 -> alpha=0.5 + 0.5*Wh
-        // WaterCrazyness=1   -> alpha=Wh
-        float const alphaCrazyness = 1.0f + gameParameters.WaterCrazyness * (oldPointWaterBufferData[pointIndex] - 1.0f);
 
-        // Kinetic energy lost at this point
-        float pointKineticEnergyLoss = 0.0f;
+        // The "freeness factor" of the other endpoint, i.e. how much its quantity
+        // of water "suppresses" splashes from adjacent kinetic energy losses
+        pointSplashFreeNeighbors +=
+            mSprings.GetWaterPermeability(springIndex)
+            * FastExp(-oldPointWaterBufferData[otherEndpointIndex] * 10.0f);
 
-        // Count of non-hull free and drowned neighbor points
-        float pointSplashNeighbors = 0.0f;
-        float pointSplashFreeNeighbors = 0.0f;
+        pointSplashNeighbors += mSprings.GetWaterPermeability(springIndex);
+    }
 
-        totalOutboundWaterFlowWeight = 0.0f;
 
-        size_t const connectedSpringCount = mPoints.GetConnectedSprings(pointIndex).ConnectedSprings.size();
-        for (size_t s = 0; s < connectedSpringCount; ++s)
-        {
-            auto const & cs = mPoints.GetConnectedSprings(pointIndex).ConnectedSprings[s];
 
-            // Normalized spring vector, oriented point -> other endpoint
-            vec2f const springNormalizedVector = (mPoints.GetPosition(cs.OtherEndpointIndex) - mPoints.GetPosition(pointIndex)).normalise_approx();
+    //
+    // 2) Calculate normalization factor for water flows:
+    //    the quantity of water along a spring is proportional to the weight of the spring
+    //    (resultant velocity along that spring), and the sum of all outbound water flows must
+    //    match the water currently at the point times the water speed fraction and the adjustment
+    //
 
-            // Component of the point's own water velocity along the spring
-            float const pointWaterVelocityAlongSpring =
-                oldPointWaterVelocityBufferData[pointIndex]
-                .dot(springNormalizedVector);
+    assert(totalOutboundWaterFlowWeight >= 0.0f);
 
-            //
-            // Calulate Bernoulli's velocity gained along this spring, from this point to
-            // the other endpoint
-            //
+    float waterQuantityNormalizationFactor = 0.0f;
+    if (totalOutboundWaterFlowWeight != 0.0f)
+    {
+        waterQuantityNormalizationFactor =
+            oldPointWaterBufferData[pointIndex]
+            * mPoints.GetMaterialWaterDiffusionSpeed(pointIndex) * gameParameters.WaterDiffusionSpeedAdjustment
+            / totalOutboundWaterFlowWeight;
+    }
 
-            // Pressure difference (positive implies point -> other endpoint flow)
-            float const dw = oldPointWaterBufferData[pointIndex] - oldPointWaterBufferData[cs.OtherEndpointIndex];
 
-            // Gravity potential difference (positive implies point -> other endpoint flow)
-            float const dy = mPoints.GetPosition(pointIndex).y - mPoints.GetPosition(cs.OtherEndpointIndex).y;
+    //
+    // 3) Calculate quantities of water along all springs according to their flows,
+    //    and the kinetic energy lost by moving them
+    //
 
-            // Calculate gained water velocity along this spring, from point to other endpoint
-            // (Bernoulli, 1738)
-            float bernoulliVelocityAlongSpring;
-            float const dwy = dw + dy;
-            if (dwy >= 0.0f)
-            {
-                // Gained velocity goes from point to other endpoint
-                bernoulliVelocityAlongSpring = sqrtf(2.0f * GameParameters::GravityMagnitude * dwy);
-            }
-            else
-            {
-                // Gained velocity goes from other endpoint to point
-                bernoulliVelocityAlongSpring = -sqrtf(2.0f * GameParameters::GravityMagnitude * -dwy);
-            }
+    for (ElementCount s = 0; s < connectedSpringCount; ++s)
+    {
+        ElementIndex const springIndex = connectedSprings.EdgeIndices[s];
+        ElementIndex const otherEndpointIndex = connectedSprings.NeighborIndices[s];
+
+        // Calculate quantity of water directed outwards
+        float const springOutboundQuantityOfWater =
+            springOutboundWaterFlowWeights[s]
+            * waterQuantityNormalizationFactor;
+
+        assert(springOutboundQuantityOfWater >= 0.0f);
+
+        springOutboundQuantitiesOfWater[s] = springOutboundQuantityOfWater;
+
+        if (mSprings.GetWaterPermeability(springIndex) != 0.0f)
+        {
+            //
+            // Update point's kinetic energy loss:
+            // splintered water colliding with whole other endpoint
+            //
 
-            // Resultant scalar velocity along spring; outbound only, as
-            // if this were inbound it wouldn't result in any movement of the point's
-            // water between these two springs. Morevoer, Bernoulli's velocity injected
-            // along this spring will be picked up later also by the other endpoint,
-            // and at that time it would move water if it agrees with its velocity
-            float const springOutboundScalarWaterVelocity = std::max(
-                pointWaterVelocityAlongSpring + bernoulliVelocityAlongSpring * alphaCrazyness,
-                0.0f);
+            // FUTURE: get rid of this re-calculation once we pre-calculate all spring normalized vectors
+            vec2f const springNormalizedVector = (mPoints.GetPosition(otherEndpointIndex) - mPoints.GetPosition(pointIndex)).normalise_approx();
 
-            // Store weight along spring, scaling for the greater distance traveled along
-            // diagonal springs
-            springOutboundWaterFlowWeights[s] =
-                springOutboundScalarWaterVelocity
-                / mSprings.GetFactoryRestLength(cs.SpringIndex);
+            float ma = springOutboundQuantityOfWater;
+            float va = springOutboundWaterVelocities[s].length();
+            float mb = oldPointWaterBufferData[otherEndpointIndex];
+            float vb = oldPointWaterVelocityBufferData[otherEndpointIndex].dot(springNormalizedVector);
 
-            // Resultant outbound velocity along spring
-            springOutboundWaterVelocities[s] =
-                springNormalizedVector
-                * springOutboundScalarWaterVelocity;
+            float vf = 0.0f;
+            if (ma + mb != 0.0f)
+                vf = (ma * va + mb * vb) / (ma + mb);
 
-            // Update total outbound flow weight
-            totalOutboundWaterFlowWeight += springOutboundWaterFlowWeights[s];
+            float deltaKa =
+                0.5f
+                * ma
+                * (va * va - vf * vf);
 
+            // Note: deltaKa might be negative, in which case deltaKb would have been
+            // more positive (perfectly inelastic -> deltaK == max); we will pickup
+            // deltaKb later
+            pointKineticEnergyLoss += std::max(deltaKa, 0.0f);
+        }
+        else
+        {
+            // Deleted springs are removed from points' connected springs
+            assert(!mSprings.IsDeleted(springIndex));
 
             //
-            // Update splash neighbors counts
+            // Update point's kinetic energy loss:
+            // entire splintered water
             //
 
-            pointSplashFreeNeighbors +=
-                mSprings.GetWaterPermeability(cs.SpringIndex)
-                * pointFreenessFactorBufferData[cs.OtherEndpointIndex];
+            float ma = springOutboundQuantityOfWater;
+            float va = springOutboundWaterVelocities[s].length();
 
-            pointSplashNeighbors += mSprings.GetWaterPermeability(cs.SpringIndex);
+            float deltaKa =
+                0.5f
+                * ma
+                * va * va;
+
+            assert(deltaKa >= 0.0f);
+            pointKineticEnergyLoss += deltaKa;
         }
+    }
+
+    //
+    // 4) Calculate water splash
+    //
+
+    if (pointSplashNeighbors != 0.0f)
+    {
+        // Water splashed is proportional to kinetic energy loss that took
+        // place near free points (i.e. not drowned by water)
+        return
+            pointKineticEnergyLoss
+            * pointSplashFreeNeighbors
+            / pointSplashNeighbors;
+    }
+    else
+    {
+        return 0.0f;
+    }
+}
 
+inline void Ship::GatherWaterFlowsAt(
+    ElementIndex pointIndex,
+    ActiveElementSet const & wetPoints,
+    vec2f const * restrict oldPointWaterVelocityBufferData,
+    float * restrict newPointWaterBufferData,
+    vec2f * restrict newPointWaterMomentumBufferData) const
+{
+    //
+    // Applies to the point all the flows that the serial visit would apply to it,
+    // in the same order - i.e. by ascending index of the point sending the flow
+    //
+    // Only wet points have calculated their outbound flows - the flows of all other
+    // points being zero
+    //
 
+    auto const connectedSprings = mPoints.GetConnectedSpringsAdjacency(pointIndex);
 
-        //
-        // 2) Calculate normalization factor for water flows:
-        //    the quantity of water along a spring is proportional to the weight of the spring
-        //    (resultant velocity along that spring), and the sum of all outbound water flows must
-        //    match the water currently at the point times the water speed fraction and the adjustment
-        //
+    // The points sending flows to this point, together with the slot of the flow
+    struct FlowSource
+    {
+        ElementIndex PointIndex;
+        size_t Slot;
+    };
 
-        assert(totalOutboundWaterFlowWeight >= 0.0f);
+    std::array<FlowSource, GameParameters::MaxSpringsPerPoint> flowSources;
+    size_t flowSourceCount = 0;
 
-        float waterQuantityNormalizationFactor = 0.0f;
-        if (totalOutboundWaterFlowWeight != 0.0f)
+    for (ElementCount c = 0; c < connectedSprings.Count; ++c)
+    {
+        ElementIndex const otherEndpointIndex = connectedSprings.NeighborIndices[c];
+        if (!wetPoints.Contains(otherEndpointIndex))
         {
-            waterQuantityNormalizationFactor =
-                oldPointWaterBufferData[pointIndex]
-                * mPoints.GetMaterialWaterDiffusionSpeed(pointIndex) * gameParameters.WaterDiffusionSpeedAdjustment
-                / totalOutboundWaterFlowWeight;
+            continue;
         }
 
+        auto const otherConnectedSprings = mPoints.GetConnectedSpringsAdjacency(otherEndpointIndex);
+        for (size_t s = 0; s < otherConnectedSprings.Count; ++s)
+        {
+            if (otherConnectedSprings.EdgeIndices[s] == connectedSprings.EdgeIndices[c])
+            {
+                assert(flowSourceCount < flowSources.size());
+                flowSources[flowSourceCount++] = FlowSource{ otherEndpointIndex, s };
+                break;
+            }
+        }
+    }
 
-        //
-        // 3) Move water along all springs according to their flows,
-        //    and update destination's momenta accordingly
-        //
-
-        for (size_t s = 0; s < connectedSpringCount; ++s)
+    std::sort(
+        flowSources.data(),
+        flowSources.data() + flowSourceCount,
+        [](FlowSource const & a, FlowSource const & b)
         {
-            auto const & cs = mPoints.GetConnectedSprings(pointIndex).ConnectedSprings[s];
+            return a.PointIndex < b.PointIndex;
+        });
 
-            // Calculate quantity of water directed outwards
-            float const springOutboundQuantityOfWater =
-                springOutboundWaterFlowWeights[s]
-                * waterQuantityNormalizationFactor;
+    float newPointWater = newPointWaterBufferData[pointIndex];
+    vec2f newPointWaterMomentum = newPointWaterMomentumBufferData[pointIndex];
 
-            assert(springOutboundQuantityOfWater >= 0.0f);
+    auto const applyOwnFlows = [&]()
+    {
+        size_t const firstSlot = static_cast<size_t>(pointIndex) * GameParameters::MaxSpringsPerPoint;
+        for (size_t s = 0; s < connectedSprings.Count; ++s)
+        {
+            float const springOutboundQuantityOfWater = mSpringOutboundQuantitiesOfWater[firstSlot + s];
 
-            if (mSprings.GetWaterPermeability(cs.SpringIndex) != 0.0f)
+            if (mSprings.GetWaterPermeability(connectedSprings.EdgeIndices[s]) != 0.0f)
             {
-                //
-                // Water - and momentum - move from point to endpoint
-                //
+                newPointWater -= springOutboundQuantityOfWater;
 
-                // Move water quantity
-                newPointWaterBufferData[pointIndex] -= springOutboundQuantityOfWater;
-                newPointWaterBufferData[cs.OtherEndpointIndex] += springOutboundQuantityOfWater;
-
-                // Remove "old momentum" (old velocity) from point
-                newPointWaterMomentumBufferData[pointIndex] -=
+                newPointWaterMomentum -=
                     oldPointWaterVelocityBufferData[pointIndex]
                     * springOutboundQuantityOfWater;
-
-                // Add "new momentum" (old velocity + velocity gained) to other endpoint
-                newPointWaterMomentumBufferData[cs.OtherEndpointIndex] +=
-                    springOutboundWaterVelocities[s]
+            }
+            else
+            {
+                newPointWaterMomentum -=
+                    mSpringOutboundWaterVelocities[firstSlot + s]
                     * springOutboundQuantityOfWater;
+            }
+        }
+    };
 
+    bool hasAppliedOwnFlows = !wetPoints.Contains(pointIndex);
+    for (size_t f = 0; f < flowSourceCount; ++f)
+    {
+        auto const & flowSource = flowSources[f];
 
-                //
-                // Update point's kinetic energy loss:
-                // splintered water colliding with whole other endpoint
-                //
+        if (!hasAppliedOwnFlows && flowSource.PointIndex > pointIndex)
+        {
+            applyOwnFlows();
+            hasAppliedOwnFlows = true;
+        }
+
+        size_t const slot = static_cast<size_t>(flowSource.PointIndex) * GameParameters::MaxSpringsPerPoint + flowSource.Slot;
+        ElementIndex const springIndex = mPoints.GetConnectedSpringsAdjacency(flowSource.PointIndex).EdgeIndices[flowSource.Slot];
+        if (mSprings.GetWaterPermeability(springIndex) != 0.0f)
+        {
+            float const springOutboundQuantityOfWater = mSpringOutboundQuantitiesOfWater[slot];
 
-                // FUTURE: get rid of this re-calculation once we pre-calculate all spring normalized vectors
-                vec2f const springNormalizedVector = (mPoints.GetPosition(cs.OtherEndpointIndex) - mPoints.GetPosition(pointIndex)).normalise_approx();
+            newPointWater += springOutboundQuantityOfWater;
 
-                float ma = springOutboundQuantityOfWater;
-                float va = springOutboundWaterVelocities[s].length();
-                float mb = oldPointWaterBufferData[cs.OtherEndpointIndex];
-                float vb = oldPointWaterVelocityBufferData[cs.OtherEndpointIndex].dot(springNormalizedVector);
+            newPointWaterMomentum +=
+                mSpringOutboundWaterVelocities[slot]
+                * springOutboundQuantityOfWater;
+        }
+    }
+
+    if (!hasAppliedOwnFlows)
+    {
+        applyOwnFlows();
+    }
 
-                float vf = 0.0f;
-                if (ma + mb != 0.0f)
-                    vf = (ma * va + mb * vb) / (ma + mb);
+    newPointWaterBufferData[pointIndex] = newPointWater;
+    newPointWaterMomentumBufferData[pointIndex] = newPointWaterMomentum;
+}
 
-                float deltaKa =
-                    0.5f
-                    * ma
-                    * (va * va - vf * vf);
+bool Ship::IsWaterAndPressureUpdateConcurrent(GameParameters const & gameParameters) const
+{
+    return gameParameters.DoUpdateWaterAndPressureConcurrently
+        && mTaskThreadPool->GetParallelism() > 1
+        && mPoints.GetRawShipPointCount() >= MinPointsForConcurrentWaterAndPressureUpdate;
+}
 
-                // Note: deltaKa might be negative, in which case deltaKb would have been
-                // more positive (perfectly inelastic -> deltaK == max); we will pickup
-                // deltaKb later
-                pointKineticEnergyLoss += std::max(deltaKa, 0.0f);
-            }
-            else
-            {
-                // Deleted springs are removed from points' connected springs
-                assert(!mSprings.IsDeleted(cs.SpringIndex));
+void Ship::CalculatePointColouring()
+{
+    //
+    // Greedy distance-2 colouring of the graph of factory springs; colours are
+    // assigned in point order, each point taking the lowest colour not taken
+    // by any of the points within two springs from it
+    //
 
-                //
-                // New momentum (old velocity + velocity gained) bounces back
-                // (and zeroes outgoing), assuming perfectly inelastic collision
-                //
-                // No changes to other endpoint
-                //
+    ElementCount const pointCount = mPoints.GetRawShipPointCount();
 
-                newPointWaterMomentumBufferData[pointIndex] -=
-                    springOutboundWaterVelocities[s]
-                    * springOutboundQuantityOfWater;
+    std::vector<std::uint32_t> pointColours(pointCount);
 
+    // For each colour, the last point (plus one) for which the colour is forbidden
+    std::vector<ElementIndex> forbiddenColourStamps;
 
-                //
-                // Update point's kinetic energy loss:
-                // entire splintered water
-                //
+    std::uint32_t colourCount = 0;
 
-                float ma = springOutboundQuantityOfWater;
-                float va = springOutboundWaterVelocities[s].length();
+    for (ElementIndex pointIndex = 0; pointIndex < pointCount; ++pointIndex)
+    {
+        ElementIndex const stamp = pointIndex + 1;
 
-                float deltaKa =
-                    0.5f
-                    * ma
-                    * va * va;
+        for (auto const & cs1 : mPoints.GetFactoryConnectedSprings(pointIndex).ConnectedSprings)
+        {
+            if (cs1.OtherEndpointIndex < pointIndex)
+            {
+                forbiddenColourStamps[pointColours[cs1.OtherEndpointIndex]] = stamp;
+            }
 
-                assert(deltaKa >= 0.0f);
-                pointKineticEnergyLoss += deltaKa;
+            for (auto const & cs2 : mPoints.GetFactoryConnectedSprings(cs1.OtherEndpointIndex).ConnectedSprings)
+            {
+                if (cs2.OtherEndpointIndex < pointIndex)
+                {
+                    forbiddenColourStamps[pointColours[cs2.OtherEndpointIndex]] = stamp;
+                }
             }
         }
 
-        //
-        // 4) Update water splash
-        //
+        std::uint32_t colour = 0;
+        while (colour < colourCount && forbiddenColourStamps[colour] == stamp)
+        {
+            ++colour;
+        }
 
-        if (pointSplashNeighbors != 0.0f)
+        if (colour == colourCount)
         {
-            // Water splashed is proportional to kinetic energy loss that took
-            // place near free points (i.e. not drowned by water)
-            waterSplashed +=
-                pointKineticEnergyLoss
-                * pointSplashFreeNeighbors
-                / pointSplashNeighbors;
+            ++colourCount;
+            forbiddenColourStamps.push_back(0);
         }
-    }
 
+        pointColours[pointIndex] = colour;
+    }
 
     //
-    // Average kinetic energy loss
+    // Group points by colour, keeping them in ascending order within each colour
     //
 
-    waterSplashed = mWaterSplashedRunningAverage.Update(waterSplashed);
+    mPointColourStarts.assign(colourCount + 1, 0);
+    for (ElementIndex pointIndex = 0; pointIndex < pointCount; ++pointIndex)
+    {
+        ++mPointColourStarts[pointColours[pointIndex] + 1];
+    }
+
+    for (size_t c = 1; c <= colourCount; ++c)
+    {
+        mPointColourStarts[c] += mPointColourStarts[c - 1];
+    }
 
+    mColouredPoints.resize(pointCount);
+    std::vector<size_t> colourInsertionPoints(mPointColourStarts.cbegin(), mPointColourStarts.cend() - 1);
+    for (ElementIndex pointIndex = 0; pointIndex < pointCount; ++pointIndex)
+    {
+        mColouredPoints[colourInsertionPoints[pointColours[pointIndex]]++] = pointIndex;
+    }
+
+    LogMessage("Ship::CalculatePointColouring(): ", colourCount, " colours for ", pointCount, " points");
+}
 
+void Ship::CalculatePointNeighborhood(
+    std::vector<ElementIndex> const & pointIndices,
+    std::vector<ElementIndex> & neighborhood)
+{
     //
-    // Transforming momenta into velocities
+    // Populates the neighborhood with the specified points and with all the points
+    // connected to them, without duplicates and in ascending order
     //
 
-    mPoints.UpdateWaterVelocitiesFromMomenta();
+    ElementCount const pointCount = mPoints.GetRawShipPointCount();
+
+    if (mIsPointInNeighborhood.size() != pointCount)
+    {
+        mIsPointInNeighborhood.assign(pointCount, false);
+    }
+
+    neighborhood.clear();
+
+    auto const addPoint = [&](ElementIndex pointIndex)
+    {
+        if (!mIsPointInNeighborhood[pointIndex])
+        {
+            mIsPointInNeighborhood[pointIndex] = true;
+            neighborhood.push_back(pointIndex);
+        }
+    };
+
+    for (auto const pointIndex : pointIndices)
+    {
+        addPoint(pointIndex);
+
+        auto const connectedSprings = mPoints.GetConnectedSpringsAdjacency(pointIndex);
+        for (ElementCount s = 0; s < connectedSprings.Count; ++s)
+        {
+            addPoint(connectedSprings.NeighborIndices[s]);
+        }
+    }
+
+    if (neighborhood.size() > pointCount / 16)
+    {
+        // Cheaper to collect the points in order than to sort them
+        neighborhood.clear();
+        for (ElementIndex pointIndex = 0; pointIndex < pointCount; ++pointIndex)
+        {
+            if (mIsPointInNeighborhood[pointIndex])
+            {
+                neighborhood.push_back(pointIndex);
+                mIsPointInNeighborhood[pointIndex] = false;
+            }
+        }
+    }
+    else
+    {
+        std::sort(neighborhood.begin(), neighborhood.end());
+
+        for (auto const pointIndex : neighborhood)
+        {
+            mIsPointInNeighborhood[pointIndex] = false;
+        }
+    }
 }
 
 void Ship::UpdateSinking()
 {
+    FS_PROFILE_SCOPE("Ship::UpdateSinking");
+
     //
     // Calculate total number of wet points
     //
@@ -2721,8 +4597,10 @@ void Ship::UpdateSinking()
 // Electrical Dynamics
 ///////////////////////////////////////////////////////////////////////////////////
 
-void Ship::DiffuseLight(GameParameters const & gameParameters)
+bool Ship::PrepareLightDiffusion(GameParameters const & gameParameters)
 {
+    FS_PROFILE_SCOPE("Ship::PrepareLightDiffusion");
+
     //
     // Diffuse light from each lamp to all points on the same or lower plane ID,
     // inverse-proportionally to the lamp-point distance
@@ -2732,11 +4610,11 @@ void Ship::DiffuseLight(GameParameters const & gameParameters)
     if (mElectricalElements.Lamps().empty()
         || (gameParameters.LuminiscenceAdjustment == 0.0f && mLastLuminiscenceAdjustmentDiffused == 0.0f))
     {
-        return;
+        return false;
     }
 
     //
-    // 1. Prepare lamp data
+    // Prepare lamp data
     //
 
     auto & lampPositions = mElectricalElements.GetLampPositionWorkBuffer(); // Padded to vectorization float count
@@ -2756,23 +4634,33 @@ void Ship::DiffuseLight(GameParameters const & gameParameters)
             * mElectricalElements.GetAvailableLight(lampElectricalElementIndex);
     }
 
-    //
-    // 2. Diffuse light
-    //
+    // Remember that we've diffused light with this luminiscence adjustment
+    mLastLuminiscenceAdjustmentDiffused = gameParameters.LuminiscenceAdjustment;
+
+    return true;
+}
+
+void Ship::DiffuseLight(size_t partitionIndex)
+{
+    FS_PROFILE_SCOPE("Ship::DiffuseLight");
+
+    auto & partition = mLightDiffusionPartitions[partitionIndex];
 
-    Algorithms::DiffuseLight(
+    Algorithms::DiffuseLight_Culled(
         mPoints.GetPositionBufferAsVec2(),
         mPoints.GetPlaneIdBufferAsPlaneId(),
-        mPoints.GetAlignedShipPointCount(), // No real reason to skip ephemerals, other than they're not expected to have light
-        lampPositions.data(),
-        lampPlaneIds.data(),
-        lampDistanceCoeffs.data(),
+        partition.StartPointIndex,
+        partition.EndPointIndex, // No real reason to skip ephemerals, other than they're not expected to have light
+        mElectricalElements.GetLampPositionWorkBuffer().data(),
+        mElectricalElements.GetLampPlaneIdWorkBuffer().data(),
+        mElectricalElements.GetLampDistanceCoefficientWorkBuffer().data(),
         mElectricalElements.GetLampLightSpreadMaxDistanceBufferAsFloat(),
-        mElectricalElements.GetBufferLampCount(),
+        mElectricalElements.GetLampCount(),
+        partition.CulledLampPositions.data(),
+        partition.CulledLampPlaneIds.data(),
+        partition.CulledLampDistanceCoefficients.data(),
+        partition.CulledLampSpreadMaxDistances.data(),
         mPoints.GetLightBufferAsFloat());
-
-    // Remember that we've diffused light with this luminiscence adjustment
-    mLastLuminiscenceAdjustmentDiffused = gameParameters.LuminiscenceAdjustment;
 }
 
 ///////////////////////////////////////////////////////////////////////////////////
@@ -2785,165 +4673,425 @@ void Ship::PropagateHeat(
     Storm::Parameters const & stormParameters,
     GameParameters const & gameParameters)
 {
+    FS_PROFILE_SCOPE("Ship::PropagateHeat");
+
     //
     // Propagate temperature (via heat), and dissipate temperature
     //
+    // Points at the temperature of their environment neither exchange any
+    // (noticeable) heat with each other, nor dissipate any, hence we only visit
+    // the points that are away from the temperature of their environment - the
+    // "hot" points - together with their neighbors
+    //
 
-    // Source and result temperature buffers
-    auto oldPointTemperatureBuffer = mPoints.MakeTemperatureBufferCopy();
-    float const * restrict const oldPointTemperatureBufferData = oldPointTemperatureBuffer->data();
-    float * restrict const newPointTemperatureBufferData = mPoints.GetTemperatureBufferAsFloat();
+    float const effectiveWaterConvectiveHeatTransferCoefficient =
+        GameParameters::WaterConvectiveHeatTransferCoefficient
+        * dt
+        * gameParameters.HeatDissipationAdjustment
+        * 2.0f; // We exaggerate a bit to take into account water wetting the material and thus making it more difficult for fire to re-kindle
+
+    // Water temperature
+    // We approximate the thermocline as a linear decrease of
+    // temperature: 15 degrees in MaxSeaDepth meters
+    float const surfaceWaterTemperature = gameParameters.WaterTemperature;
+    float constexpr ThermoclineSlope = -15.0f / GameParameters::MaxSeaDepth;
 
-    // Outbound heat flows along each spring
-    std::array<float, GameParameters::MaxSpringsPerPoint> springOutboundHeatFlows;
+    // We include rain in air
+    float const effectiveAirConvectiveHeatTransferCoefficient =
+        GameParameters::AirConvectiveHeatTransferCoefficient
+        * dt
+        * gameParameters.HeatDissipationAdjustment
+        + FastPow(stormParameters.RainDensity, 0.3f) * effectiveWaterConvectiveHeatTransferCoefficient;
 
-    //
-    // Visit all non-ephemeral points
-    //
-    // No particular reason to not do ephemeral points as well - it's just
-    // that at the moment ephemeral particles are not connected to each other
-    //
+    float const airTemperature =
+        gameParameters.AirTemperature
+        + stormParameters.AirTemperatureDelta;
+
+    // Calculates the temperature of the environment of a point, and the
+    // coefficient of heat transfer with it
+    auto const calculateEnvironment = [&](ElementIndex pointIndex) -> std::tuple<float, float>
+    {
+        if (mPoints.IsCachedUnderwater(pointIndex)
+            || mPoints.GetWater(pointIndex) > GameParameters::SmotheringWaterHighWatermark)
+        {
+            // Water
+            return {
+                surfaceWaterTemperature - Clamp(mPoints.GetPosition(pointIndex).y * ThermoclineSlope, 0.0f, surfaceWaterTemperature),
+                effectiveWaterConvectiveHeatTransferCoefficient };
+        }
+        else
+        {
+            // Air
+            return {
+                airTemperature,
+                effectiveAirConvectiveHeatTransferCoefficient };
+        }
+    };
+
+    float * restrict const newPointTemperatureBufferData = mPoints.GetTemperatureBufferAsFloat();
 
-    for (auto pointIndex : mPoints.RawShipPoints())
+    auto const dissipateHeat = [&](ElementIndex pointIndex)
     {
-        // Temperature of this point
-        float const pointTemperature = oldPointTemperatureBufferData[pointIndex];
+        auto const [environmentTemperature, heatTransferCoefficient] = calculateEnvironment(pointIndex);
 
-        //
-        // 1) Calculate total outgoing heat
-        //
+        float const deltaT = newPointTemperatureBufferData[pointIndex] - environmentTemperature; // Temperature delta (particle - env)
+        float const heatLost = heatTransferCoefficient * deltaT; // Heat lost in this time quantum (positive when outgoing)
 
-        float totalOutgoingHeat = 0.0f;
+        // Temperature delta due to heat removal
+        float const dissipationDeltaT = heatLost * mPoints.GetMaterialHeatCapacityReciprocal(pointIndex);
 
-        // Visit all springs
-        size_t const connectedSpringCount = mPoints.GetConnectedSprings(pointIndex).ConnectedSprings.size();
-        for (size_t s = 0; s < connectedSpringCount; ++s)
+        // Remove this heat from the point, making sure we don't overshoot
+        if (deltaT >= 0)
+        {
+            newPointTemperatureBufferData[pointIndex] -=
+                std::min(dissipationDeltaT, deltaT);
+        }
+        else
         {
-            auto const & cs = mPoints.GetConnectedSprings(pointIndex).ConnectedSprings[s];
+            newPointTemperatureBufferData[pointIndex] -=
+                std::max(dissipationDeltaT, deltaT);
+        }
+    };
 
-            // Calculate outgoing heat flow per unit of time
-            //
-            // q = Ki * (Tp - Tpi) * dt / Li
-            float const outgoingHeatFlow =
-                mSprings.GetMaterialThermalConductivity(cs.SpringIndex) * gameParameters.ThermalConductivityAdjustment
-                * std::max(pointTemperature - oldPointTemperatureBufferData[cs.OtherEndpointIndex], 0.0f) // DeltaT, positive if going out
-                * dt
-                / mSprings.GetFactoryRestLength(cs.SpringIndex);
+    auto const calculateEnvironmentTemperatureDelta = [&](ElementIndex pointIndex) -> float
+    {
+        return std::abs(newPointTemperatureBufferData[pointIndex] - std::get<0>(calculateEnvironment(pointIndex)));
+    };
+
+    auto & hotPoints = mPoints.GetHotPoints();
+
+    //
+    // Points may also drift away from the temperature of their environment without
+    // being heated - e.g. when the environment changes, or when they move from air
+    // into water - hence at each step we check a slice of all the points
+    //
 
-            // Store flow
-            springOutboundHeatFlows[s] = outgoingHeatFlow;
+    ElementCount const pointCount = mPoints.GetRawShipPointCount();
+    ElementCount const stepCount = std::max(
+        static_cast<ElementCount>(std::round(dt / GameParameters::SimulationStepTimeDuration<float>)),
+        ElementCount(1));
+    ElementCount const sweepPointCount = std::min(
+        (pointCount * stepCount + HotPointsSweepPeriod - 1) / HotPointsSweepPeriod,
+        pointCount);
+
+    for (ElementCount i = 0; i < sweepPointCount; ++i)
+    {
+        if (mNextHotPointsSweepPointIndex >= pointCount)
+        {
+            mNextHotPointsSweepPointIndex = 0;
+        }
 
-            // Update total outgoing heat
-            totalOutgoingHeat += outgoingHeatFlow;
+        if (calculateEnvironmentTemperatureDelta(mNextHotPointsSweepPointIndex) > HotPointEnterTemperatureDelta)
+        {
+            hotPoints.Add(mNextHotPointsSweepPointIndex);
         }
 
+        ++mNextHotPointsSweepPointIndex;
+    }
 
-        //
-        // 2) Calculate normalization factor - to ensure that point's temperature won't go below zero (Kelvin)
-        //
+    if (!hotPoints.IsEmpty())
+    {
+        // The points to visit
+        CalculatePointNeighborhood(hotPoints.GetMembers(), mPointNeighborhood);
 
-        float normalizationFactor;
-        if (totalOutgoingHeat > 0.0f)
+        if (gameParameters.DoUseImplicitHeatPropagation)
         {
-            // Q = Kp * Tp
-            float const pointHeat =
-                pointTemperature
-                / mPoints.GetMaterialHeatCapacityReciprocal(pointIndex);
+            // Environment of each point
+            mHeatSolverEnvironmentTemperatures.resize(mPointNeighborhood.size());
+            mHeatSolverEnvironmentCoefficients.resize(mPointNeighborhood.size());
+            for (size_t l = 0; l < mPointNeighborhood.size(); ++l)
+            {
+                std::tie(mHeatSolverEnvironmentTemperatures[l], mHeatSolverEnvironmentCoefficients[l]) = calculateEnvironment(mPointNeighborhood[l]);
+            }
 
-            normalizationFactor = std::min(
-                pointHeat / totalOutgoingHeat,
-                1.0f);
+            PropagateHeatImplicitly(dt, gameParameters);
         }
         else
         {
-            normalizationFactor = 0.0f;
-        }
+            // Source temperature buffer
+            auto oldPointTemperatureBuffer = mPoints.MakeTemperatureBufferCopy();
+            float const * restrict const oldPointTemperatureBufferData = oldPointTemperatureBuffer->data();
+
+            // Outbound heat flows along each spring
+            std::array<float, GameParameters::MaxSpringsPerPoint> springOutboundHeatFlows;
+
+            //
+            // Visit all non-ephemeral points in the neighborhood
+            //
+            // No particular reason to not do ephemeral points as well - it's just
+            // that at the moment ephemeral particles are not connected to each other
+            //
+
+            for (auto pointIndex : mPointNeighborhood)
+            {
+                // Temperature of this point
+                float const pointTemperature = oldPointTemperatureBufferData[pointIndex];
+
+                //
+                // 1) Calculate total outgoing heat
+                //
+
+                float totalOutgoingHeat = 0.0f;
+
+                // Visit all springs
+                auto const connectedSprings = mPoints.GetConnectedSpringsAdjacency(pointIndex);
+                ElementCount const connectedSpringCount = connectedSprings.Count;
+                for (ElementCount s = 0; s < connectedSpringCount; ++s)
+                {
+                    ElementIndex const springIndex = connectedSprings.EdgeIndices[s];
+
+                    // Calculate outgoing heat flow per unit of time
+                    //
+                    // q = Ki * (Tp - Tpi) * dt / Li
+                    float const outgoingHeatFlow =
+                        mSprings.GetMaterialThermalConductivity(springIndex) * gameParameters.ThermalConductivityAdjustment
+                        * std::max(pointTemperature - oldPointTemperatureBufferData[connectedSprings.NeighborIndices[s]], 0.0f) // DeltaT, positive if going out
+                        * dt
+                        / mSprings.GetFactoryRestLength(springIndex);
+
+                    // Store flow
+                    springOutboundHeatFlows[s] = outgoingHeatFlow;
+
+                    // Update total outgoing heat
+                    totalOutgoingHeat += outgoingHeatFlow;
+                }
+
+
+                //
+                // 2) Calculate normalization factor - to ensure that point's temperature won't go below zero (Kelvin)
+                //
+
+                float normalizationFactor;
+                if (totalOutgoingHeat > 0.0f)
+                {
+                    // Q = Kp * Tp
+                    float const pointHeat =
+                        pointTemperature
+                        / mPoints.GetMaterialHeatCapacityReciprocal(pointIndex);
+
+                    normalizationFactor = std::min(
+                        pointHeat / totalOutgoingHeat,
+                        1.0f);
+                }
+                else
+                {
+                    normalizationFactor = 0.0f;
+                }
+
+
+                //
+                // 3) Transfer outgoing heat, lowering temperature of point and increasing temperature of target points
+                //
+
+                for (ElementCount s = 0; s < connectedSpringCount; ++s)
+                {
+                    ElementIndex const otherEndpointIndex = connectedSprings.NeighborIndices[s];
+
+                    // Raise target temperature due to this flow
+                    newPointTemperatureBufferData[otherEndpointIndex] +=
+                        springOutboundHeatFlows[s] * normalizationFactor
+                        * mPoints.GetMaterialHeatCapacityReciprocal(otherEndpointIndex);
+                }
+
+                // Update point's temperature due to total flow
+                newPointTemperatureBufferData[pointIndex] -=
+                    totalOutgoingHeat * normalizationFactor
+                    * mPoints.GetMaterialHeatCapacityReciprocal(pointIndex);
+            }
+
+            //
+            // Dissipate heat
+            //
 
+            for (auto pointIndex : mPointNeighborhood)
+            {
+                dissipateHeat(pointIndex);
+            }
+        }
 
         //
-        // 3) Transfer outgoing heat, lowering temperature of point and increasing temperature of target points
+        // Update the set of hot points: neighbors that got hot enough join it,
+        // while members that have been close to their environment's temperature
+        // for a while leave it
         //
 
-        for (size_t s = 0; s < connectedSpringCount; ++s)
+        for (auto pointIndex : mPointNeighborhood)
         {
-            auto const & cs = mPoints.GetConnectedSprings(pointIndex).ConnectedSprings[s];
-
-            // Raise target temperature due to this flow
-            newPointTemperatureBufferData[cs.OtherEndpointIndex] +=
-                springOutboundHeatFlows[s] * normalizationFactor
-                * mPoints.GetMaterialHeatCapacityReciprocal(cs.OtherEndpointIndex);
+            if (!hotPoints.Contains(pointIndex)
+                && calculateEnvironmentTemperatureDelta(pointIndex) > HotPointEnterTemperatureDelta)
+            {
+                hotPoints.Add(pointIndex);
+            }
         }
 
-        // Update point's temperature due to total flow
-        newPointTemperatureBufferData[pointIndex] -=
-            totalOutgoingHeat * normalizationFactor
-            * mPoints.GetMaterialHeatCapacityReciprocal(pointIndex);
+        hotPoints.Update(
+            [&](ElementIndex pointIndex)
+            {
+                return calculateEnvironmentTemperatureDelta(pointIndex) < HotPointLeaveTemperatureDelta;
+            });
     }
 
     //
-    // Dissipate heat
+    // Dissipate heat of ephemeral points, as they may be heated
+    // and have a temperature
     //
 
-    float const effectiveWaterConvectiveHeatTransferCoefficient =
-        GameParameters::WaterConvectiveHeatTransferCoefficient
-        * dt
-        * gameParameters.HeatDissipationAdjustment
-        * 2.0f; // We exaggerate a bit to take into account water wetting the material and thus making it more difficult for fire to re-kindle
+    for (auto pointIndex : mPoints.EphemeralPoints())
+    {
+        dissipateHeat(pointIndex);
+    }
+}
 
-    // Water temperature
-    // We approximate the thermocline as a linear decrease of
-    // temperature: 15 degrees in MaxSeaDepth meters
-    float const surfaceWaterTemperature = gameParameters.WaterTemperature;
-    float constexpr ThermoclineSlope = -15.0f / GameParameters::MaxSeaDepth;
+void Ship::PropagateHeatImplicitly(
+    float dt,
+    GameParameters const & gameParameters)
+{
+    //
+    // We solve backward-Euler heat diffusion along the springs among the points of the
+    // neighborhood, together with convection with their environment:
+    //
+    //  Ti' = Ti + HCRi * (hi * (TEnvi - Ti') + SUMj(gij * (Tj' - Ti')))
+    //
+    // ...which is stable at any step, unlike the explicit propagation. Points outside of
+    // the neighborhood are close to the temperature of their environment; they are kept
+    // at their temperature while solving, and exchange heat with the neighborhood after.
+    //
+    // The system is diagonally dominant, hence a few Gauss-Seidel sweeps converge; we start
+    // them from the current temperatures, i.e. from the solution of the previous propagation.
+    //
 
-    // We include rain in air
-    float const effectiveAirConvectiveHeatTransferCoefficient =
-        GameParameters::AirConvectiveHeatTransferCoefficient
-        * dt
-        * gameParameters.HeatDissipationAdjustment
-        + FastPow(stormParameters.RainDensity, 0.3f) * effectiveWaterConvectiveHeatTransferCoefficient;
+    size_t const neighborhoodSize = mPointNeighborhood.size();
+
+    assert(mHeatSolverEnvironmentTemperatures.size() == neighborhoodSize);
+    assert(mHeatSolverEnvironmentCoefficients.size() == neighborhoodSize);
+
+    if (mHeatSolverLocalIndices.size() != mPoints.GetRawShipPointCount())
+    {
+        mHeatSolverLocalIndices.assign(mPoints.GetRawShipPointCount(), NoneElementIndex);
+    }
+
+    for (size_t l = 0; l < neighborhoodSize; ++l)
+    {
+        mHeatSolverLocalIndices[mPointNeighborhood[l]] = static_cast<ElementIndex>(l);
+    }
+
+    float * restrict const pointTemperatureBufferData = mPoints.GetTemperatureBufferAsFloat();
+
+    //
+    // Build system
+    //
+
+    mHeatSolverTemperatures.resize(neighborhoodSize);
+    mHeatSolverRightHandSides.resize(neighborhoodSize);
+    mHeatSolverDiagonalReciprocals.resize(neighborhoodSize);
+    mHeatSolverRowStarts.resize(neighborhoodSize + 1);
+    mHeatSolverCouplingLocalIndices.clear();
+    mHeatSolverCouplingCoefficients.clear();
+    mHeatSolverBoundaryCouplings.clear();
+
+    for (size_t l = 0; l < neighborhoodSize; ++l)
+    {
+        ElementIndex const pointIndex = mPointNeighborhood[l];
+        float const pointTemperature = pointTemperatureBufferData[pointIndex];
+        float const heatCapacityReciprocal = mPoints.GetMaterialHeatCapacityReciprocal(pointIndex);
+
+        float totalConductance = mHeatSolverEnvironmentCoefficients[l];
+        float rightHandSide = pointTemperature + heatCapacityReciprocal * mHeatSolverEnvironmentCoefficients[l] * mHeatSolverEnvironmentTemperatures[l];
+
+        mHeatSolverRowStarts[l] = static_cast<ElementIndex>(mHeatSolverCouplingLocalIndices.size());
+
+        auto const connectedSprings = mPoints.GetConnectedSpringsAdjacency(pointIndex);
+        for (ElementCount s = 0; s < connectedSprings.Count; ++s)
+        {
+            ElementIndex const springIndex = connectedSprings.EdgeIndices[s];
+            ElementIndex const otherEndpointIndex = connectedSprings.NeighborIndices[s];
+
+            // g = Ki * dt / Li
+            float const conductance =
+                mSprings.GetMaterialThermalConductivity(springIndex) * gameParameters.ThermalConductivityAdjustment
+                * dt
+                / mSprings.GetFactoryRestLength(springIndex);
+
+            totalConductance += conductance;
+
+            ElementIndex const otherEndpointLocalIndex = mHeatSolverLocalIndices[otherEndpointIndex];
+            if (otherEndpointLocalIndex != NoneElementIndex)
+            {
+                mHeatSolverCouplingLocalIndices.push_back(otherEndpointLocalIndex);
+                mHeatSolverCouplingCoefficients.push_back(heatCapacityReciprocal * conductance);
+            }
+            else
+            {
+                // Fixed while solving
+                rightHandSide += heatCapacityReciprocal * conductance * pointTemperatureBufferData[otherEndpointIndex];
+
+                mHeatSolverBoundaryCouplings.push_back({ static_cast<ElementIndex>(l), otherEndpointIndex, conductance });
+            }
+        }
 
-    float const airTemperature =
-        gameParameters.AirTemperature
-        + stormParameters.AirTemperatureDelta;
+        mHeatSolverTemperatures[l] = pointTemperature;
+        mHeatSolverRightHandSides[l] = rightHandSide;
+        mHeatSolverDiagonalReciprocals[l] = 1.0f / (1.0f + heatCapacityReciprocal * totalConductance);
+    }
 
-    // We also include ephemeral points, as they may be heated
-    // and have a temperature
-    for (auto pointIndex : mPoints)
-    {
-        float deltaT; // Temperature delta (particle - env)
-        float heatLost; // Heat lost in this time quantum (positive when outgoing)
+    mHeatSolverRowStarts[neighborhoodSize] = static_cast<ElementIndex>(mHeatSolverCouplingLocalIndices.size());
 
-        if (mPoints.IsCachedUnderwater(pointIndex)
-            || mPoints.GetWater(pointIndex) > GameParameters::SmotheringWaterHighWatermark)
-        {
-            // Dissipation in water
-            float const waterTemperature = surfaceWaterTemperature - Clamp(mPoints.GetPosition(pointIndex).y * ThermoclineSlope, 0.0f, surfaceWaterTemperature);
-            deltaT = newPointTemperatureBufferData[pointIndex] - waterTemperature;
-            heatLost = effectiveWaterConvectiveHeatTransferCoefficient * deltaT;
-        }
-        else
+    //
+    // Solve
+    //
+
+    float * restrict const temperatures = mHeatSolverTemperatures.data();
+    float const * restrict const rightHandSides = mHeatSolverRightHandSides.data();
+    float const * restrict const diagonalReciprocals = mHeatSolverDiagonalReciprocals.data();
+    ElementIndex const * restrict const rowStarts = mHeatSolverRowStarts.data();
+    ElementIndex const * restrict const couplingLocalIndices = mHeatSolverCouplingLocalIndices.data();
+    float const * restrict const couplingCoefficients = mHeatSolverCouplingCoefficients.data();
+
+    for (int iteration = 0; iteration < ImplicitHeatPropagationIterations; ++iteration)
+    {
+        for (size_t l = 0; l < neighborhoodSize; ++l)
         {
-            // Dissipation in air
-            deltaT = newPointTemperatureBufferData[pointIndex] - airTemperature;
-            heatLost = effectiveAirConvectiveHeatTransferCoefficient * deltaT;
+            float sum = rightHandSides[l];
+            for (ElementIndex c = rowStarts[l]; c < rowStarts[l + 1]; ++c)
+            {
+                sum += couplingCoefficients[c] * temperatures[couplingLocalIndices[c]];
+            }
+
+            temperatures[l] = sum * diagonalReciprocals[l];
         }
+    }
 
-        // Temperature delta due to heat removal
-        float const dissipationDeltaT = heatLost * mPoints.GetMaterialHeatCapacityReciprocal(pointIndex);
+    //
+    // Exchange heat with the points outside of the neighborhood, making sure
+    // they don't overshoot the temperature of the point they exchange with
+    //
 
-        // Remove this heat from the point, making sure we don't overshoot
-        if (deltaT >= 0)
+    for (auto const & coupling : mHeatSolverBoundaryCouplings)
+    {
+        float const deltaT = temperatures[coupling.LocalIndex] - pointTemperatureBufferData[coupling.PointIndex]; // Positive if going out
+        float const outsideDeltaT = coupling.Conductance * deltaT * mPoints.GetMaterialHeatCapacityReciprocal(coupling.PointIndex);
+
+        if (deltaT >= 0.0f)
         {
-            newPointTemperatureBufferData[pointIndex] -=
-                std::min(dissipationDeltaT, deltaT);
+            pointTemperatureBufferData[coupling.PointIndex] += std::min(outsideDeltaT, deltaT);
         }
         else
         {
-            newPointTemperatureBufferData[pointIndex] -=
-                std::max(dissipationDeltaT, deltaT);
+            pointTemperatureBufferData[coupling.PointIndex] += std::max(outsideDeltaT, deltaT);
         }
     }
+
+    //
+    // Store solution
+    //
+
+    for (size_t l = 0; l < neighborhoodSize; ++l)
+    {
+        ElementIndex const pointIndex = mPointNeighborhood[l];
+
+        pointTemperatureBufferData[pointIndex] = temperatures[l];
+        mHeatSolverLocalIndices[pointIndex] = NoneElementIndex;
+    }
 }
 
 ///////////////////////////////////////////////////////////////////////////////////
@@ -2956,6 +5104,8 @@ void Ship::RotPoints(
     float /*currentSimulationTime*/,
     GameParameters const & gameParameters)
 {
+    FS_PROFILE_SCOPE("Ship::RotPoints");
+
     if (gameParameters.RotAcceler8r == 0.0f)
     {
         // Disable rotting altogether
@@ -3014,37 +5164,72 @@ void Ship::RotPoints(
     ElementCount const partitionSize = (mPoints.GetRawShipPointCount() / partitionCount) + ((mPoints.GetRawShipPointCount() % partitionCount) ? 1 : 0);
     ElementCount const startPointIndex = partition * partitionSize;
     ElementCount const endPointIndex = std::min(startPointIndex + partitionSize, mPoints.GetRawShipPointCount());
-    for (ElementIndex p = startPointIndex; p < endPointIndex; ++p)
+    Algorithms::RotPoints(
+        mPoints.GetCachedDepthBufferAsFloat(),
+        mPoints.GetWaterBufferAsFloat(),
+        mPoints.GetLeakingSourcesBufferAsFloat(),
+        mPoints.GetMaterialRustReceptivityBufferAsFloat(),
+        mPoints.GetDecayBufferAsFloat(),
+        startPointIndex,
+        endPointIndex,
+        x_uw,
+        beta);
+
+    mPoints.MarkDecayBufferAsDirty(startPointIndex, endPointIndex);
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////
+// Private helpers
+///////////////////////////////////////////////////////////////////////////////////////////////
+
+//#define RENDER_FLOOD_DISTANCE
+
+void Ship::RunConnectivityVisit()
+{
+    FS_PROFILE_SCOPE("Ship::RunConnectivityVisit");
+
+    if (mIsFullConnectivityVisitRequired)
     {
-        float x =
-            (mPoints.IsCachedUnderwater(p) ? x_uw : 0.0f) // x_uw
-            + std::min(mPoints.GetWater(p), 1.0f); // x_fl
+        RunFullConnectivityVisit();
 
-        // Adjust with leaking: if leaking and subject to rusting, then rusts faster
-        x += mPoints.GetLeakingComposite(p).LeakingSources.StructuralLeak * x * x_uw;
+        // Planes might have changed
+        mIsTriangleLayoutDirty = true;
 
-        // Adjust with material's rust receptivity
-        x *= mPoints.GetMaterialRustReceptivity(p);
+        //
+        // Wake up all connected components, as they might have changed
+        //
 
-        // Calculate alpha
-        float const alpha = std::max(1.0f - beta * x, 0.0f);
+        WakeUpAllConnectedComponents();
+        mConnectedComponentSleepStates.resize(mConnectedComponentSizes.size());
 
-        // Decay
-        mPoints.SetDecay(p, mPoints.GetDecay(p) * alpha);
+        mIsFullConnectivityVisitRequired = false;
     }
+    else
+    {
+        auto const oldConnectedComponentCount = mConnectedComponentSizes.size();
 
-    // Remember that the decay buffer is dirty
-    mPoints.MarkDecayBufferAsDirty();
-}
+        RunIncrementalConnectivityVisit();
 
-///////////////////////////////////////////////////////////////////////////////////////////////
-// Private helpers
-///////////////////////////////////////////////////////////////////////////////////////////////
+        if (mConnectedComponentSizes.size() != oldConnectedComponentCount)
+        {
+            // Connected components have split, hence some triangles have changed plane
+            mIsTriangleLayoutDirty = true;
+        }
+    }
 
-//#define RENDER_FLOOD_DISTANCE
+    mConnectivityVisitSeedPoints.clear();
 
-void Ship::RunConnectivityVisit()
+    //
+    // Re-order burning points, as their plane IDs might have changed
+    //
+
+    mPoints.ReorderBurningPointsForDepth();
+}
+
+void Ship::RunFullConnectivityVisit()
 {
+    FS_PROFILE_SCOPE("Ship::RunFullConnectivityVisit");
+
     //
     //
     // Here we visit the entire network of points (NOT including the ephemerals - they'll be assigned
@@ -3071,8 +5256,9 @@ void Ship::RunConnectivityVisit()
     PlaneId currentPlaneId = 0; // Also serves as Connected Component ID
     float currentPlaneIdFloat = 0.0f;
 
-    // Reset count of points per connected component
+    // Reset count of points and triangles per connected component
     mConnectedComponentSizes.clear();
+    mConnectedComponentTriangleCounts.clear();
 
 #ifdef RENDER_FLOOD_DISTANCE
     std::optional<float> floodDistanceColor;
@@ -3133,20 +5319,23 @@ void Ship::RunConnectivityVisit()
 #endif
 
                 // Visit all its non-visited connected points
-                for (auto const & cs : mPoints.GetConnectedSprings(currentPointIndex).ConnectedSprings)
+                auto const connectedSprings = mPoints.GetConnectedSpringsAdjacency(currentPointIndex);
+                for (ElementCount s = 0; s < connectedSprings.Count; ++s)
                 {
-                    if (visitSequenceNumber != mPoints.GetCurrentConnectivityVisitSequenceNumber(cs.OtherEndpointIndex))
+                    ElementIndex const otherEndpointIndex = connectedSprings.NeighborIndices[s];
+
+                    if (visitSequenceNumber != mPoints.GetCurrentConnectivityVisitSequenceNumber(otherEndpointIndex))
                     {
                         //
                         // Visit point
                         //
 
-                        mPoints.SetPlaneId(cs.OtherEndpointIndex, currentPlaneId, currentPlaneIdFloat);
-                        mPoints.SetConnectedComponentId(cs.OtherEndpointIndex, static_cast<ConnectedComponentId>(currentPlaneId));
-                        mPoints.SetCurrentConnectivityVisitSequenceNumber(cs.OtherEndpointIndex, visitSequenceNumber);
+                        mPoints.SetPlaneId(otherEndpointIndex, currentPlaneId, currentPlaneIdFloat);
+                        mPoints.SetConnectedComponentId(otherEndpointIndex, static_cast<ConnectedComponentId>(currentPlaneId));
+                        mPoints.SetCurrentConnectivityVisitSequenceNumber(otherEndpointIndex, visitSequenceNumber);
 
                         // Add point to queue
-                        pointsToPropagateFrom.push(cs.OtherEndpointIndex);
+                        pointsToPropagateFrom.push(otherEndpointIndex);
 
                         // Update count of points in this connected component
                         ++currentConnectedComponentPointCount;
@@ -3161,6 +5350,9 @@ void Ship::RunConnectivityVisit()
             assert(mConnectedComponentSizes.size() == static_cast<size_t>(currentPlaneId));
             mConnectedComponentSizes.push_back(currentConnectedComponentPointCount);
 
+            // Remember count of triangles in this connected component
+            mConnectedComponentTriangleCounts.push_back(totalPlaneTrianglesCount - mPlaneTriangleIndicesToRender.back());
+
             // Remember the starting index of the triangles in the next plane
             assert(mPlaneTriangleIndicesToRender.size() == static_cast<size_t>(currentPlaneId + 1));
             mPlaneTriangleIndicesToRender.push_back(totalPlaneTrianglesCount);
@@ -3182,15 +5374,218 @@ void Ship::RunConnectivityVisit()
     // Remember colors are dirty
     mPoints.MarkColorBufferAsDirty();
 #endif
+}
 
-    // Remember non-ephemeral portion of plane IDs is dirty
-    mPoints.MarkPlaneIdBufferNonEphemeralAsDirty();
+void Ship::RunIncrementalConnectivityVisit()
+{
+    FS_PROFILE_SCOPE("Ship::RunIncrementalConnectivityVisit");
 
     //
-    // Re-order burning points, as their plane IDs might have changed
+    // Since the last visit springs have only been destroyed, hence connected components
+    // may only have split, and each of their pieces must contain an endpoint of a destroyed
+    // spring (the "seeds").
+    //
+    // For each affected connected component we flood from all of its seeds concurrently,
+    // one point per front at a time, merging fronts into groups as they meet. As soon as a
+    // single group is left with points to propagate from, all other groups have completely
+    // flooded pieces that are not connected to it anymore: they become new connected components
+    // - and planes - while the remainder keeps the connected component without ever having to
+    // be flooded completely.
     //
 
-    mPoints.ReorderBurningPointsForDepth();
+    // Generate a new visit sequence number
+    auto const visitSequenceNumber = ++mCurrentConnectivityVisitSequenceNumber;
+
+    mConnectivityFrontOfPoint.resize(mPoints.GetRawShipPointCount());
+
+    // Group seeds by connected component
+    std::sort(
+        mConnectivityVisitSeedPoints.begin(),
+        mConnectivityVisitSeedPoints.end(),
+        [this](ElementIndex a, ElementIndex b)
+        {
+            return std::make_pair(mPoints.GetConnectedComponentId(a), a) < std::make_pair(mPoints.GetConnectedComponentId(b), b);
+        });
+
+    mConnectivityVisitSeedPoints.erase(
+        std::unique(mConnectivityVisitSeedPoints.begin(), mConnectivityVisitSeedPoints.end()),
+        mConnectivityVisitSeedPoints.end());
+
+    ConnectedComponentId const oldConnectedComponentCount = static_cast<ConnectedComponentId>(mConnectedComponentSizes.size());
+    bool isAnySplitConnectedComponentAsleep = false;
+
+    for (auto seedIt = mConnectivityVisitSeedPoints.cbegin(); seedIt != mConnectivityVisitSeedPoints.cend(); )
+    {
+        ConnectedComponentId const connectedComponentId = mPoints.GetConnectedComponentId(*seedIt);
+        assert(connectedComponentId < oldConnectedComponentCount);
+
+        //
+        // Start one front at each seed
+        //
+
+        size_t frontCount = 0;
+        for (; seedIt != mConnectivityVisitSeedPoints.cend() && mPoints.GetConnectedComponentId(*seedIt) == connectedComponentId; ++seedIt)
+        {
+            if (frontCount == mConnectivityFronts.size())
+            {
+                mConnectivityFronts.emplace_back();
+            }
+
+            auto & front = mConnectivityFronts[frontCount];
+            front.Points.clear();
+            front.Points.push_back(*seedIt);
+            front.NextPointToPropagateFrom = 0;
+            front.Group = frontCount;
+            front.ActiveFrontCount = 1;
+            front.NewConnectedComponentId = NoneConnectedComponentId;
+
+            mPoints.SetCurrentConnectivityVisitSequenceNumber(*seedIt, visitSequenceNumber);
+            mConnectivityFrontOfPoint[*seedIt] = static_cast<std::uint32_t>(frontCount);
+
+            ++frontCount;
+        }
+
+        //
+        // Flood until one group is left with points to propagate from
+        //
+
+        size_t activeGroupCount = frontCount;
+
+        while (activeGroupCount > 1)
+        {
+            for (size_t f = 0; f < frontCount && activeGroupCount > 1; ++f)
+            {
+                auto & front = mConnectivityFronts[f];
+                if (front.NextPointToPropagateFrom == front.Points.size())
+                {
+                    continue;
+                }
+
+                ElementIndex const currentPointIndex = front.Points[front.NextPointToPropagateFrom++];
+
+                auto const connectedSprings = mPoints.GetConnectedSpringsAdjacency(currentPointIndex);
+                for (ElementCount s = 0; s < connectedSprings.Count; ++s)
+                {
+                    ElementIndex const otherEndpointIndex = connectedSprings.NeighborIndices[s];
+
+                    if (visitSequenceNumber != mPoints.GetCurrentConnectivityVisitSequenceNumber(otherEndpointIndex))
+                    {
+                        mPoints.SetCurrentConnectivityVisitSequenceNumber(otherEndpointIndex, visitSequenceNumber);
+                        mConnectivityFrontOfPoint[otherEndpointIndex] = static_cast<std::uint32_t>(f);
+                        front.Points.push_back(otherEndpointIndex);
+                    }
+                    else
+                    {
+                        size_t const group = FindConnectivityFrontGroup(f);
+                        size_t const otherGroup = FindConnectivityFrontGroup(mConnectivityFrontOfPoint[otherEndpointIndex]);
+                        if (group != otherGroup)
+                        {
+                            // Fronts have met; a completely-flooded group can't meet any other group
+                            assert(mConnectivityFronts[otherGroup].ActiveFrontCount > 0);
+                            mConnectivityFronts[otherGroup].Group = group;
+                            mConnectivityFronts[group].ActiveFrontCount += mConnectivityFronts[otherGroup].ActiveFrontCount;
+                            --activeGroupCount;
+                        }
+                    }
+                }
+
+                if (front.NextPointToPropagateFrom == front.Points.size())
+                {
+                    // This front has no more points to propagate from
+                    size_t const group = FindConnectivityFrontGroup(f);
+                    assert(mConnectivityFronts[group].ActiveFrontCount > 0);
+                    if (--(mConnectivityFronts[group].ActiveFrontCount) == 0)
+                    {
+                        // This group has completely flooded its piece
+                        --activeGroupCount;
+                    }
+                }
+            }
+        }
+
+        //
+        // Make each completely-flooded group a new connected component
+        //
+
+        for (size_t f = 0; f < frontCount; ++f)
+        {
+            auto & group = mConnectivityFronts[FindConnectivityFrontGroup(f)];
+            if (group.ActiveFrontCount > 0)
+            {
+                // The remainder
+                continue;
+            }
+
+            if (group.NewConnectedComponentId == NoneConnectedComponentId)
+            {
+                group.NewConnectedComponentId = static_cast<ConnectedComponentId>(mConnectedComponentSizes.size());
+                mConnectedComponentSizes.push_back(0);
+                mConnectedComponentTriangleCounts.push_back(0);
+
+                // Remember max plane ID ever
+                mMaxMaxPlaneId = std::max(mMaxMaxPlaneId, static_cast<PlaneId>(group.NewConnectedComponentId));
+            }
+
+            ConnectedComponentId const newConnectedComponentId = group.NewConnectedComponentId;
+            PlaneId const newPlaneId = static_cast<PlaneId>(newConnectedComponentId);
+            float const newPlaneIdFloat = static_cast<float>(newPlaneId);
+
+            for (auto const pointIndex : mConnectivityFronts[f].Points)
+            {
+                mPoints.SetPlaneId(pointIndex, newPlaneId, newPlaneIdFloat);
+                mPoints.SetConnectedComponentId(pointIndex, newConnectedComponentId);
+
+                size_t const pointTrianglesCount = mPoints.GetConnectedOwnedTrianglesCount(pointIndex);
+                mConnectedComponentTriangleCounts[newConnectedComponentId] += pointTrianglesCount;
+                mConnectedComponentTriangleCounts[connectedComponentId] -= pointTrianglesCount;
+            }
+
+            mConnectedComponentSizes[newConnectedComponentId] += mConnectivityFronts[f].Points.size();
+            mConnectedComponentSizes[connectedComponentId] -= mConnectivityFronts[f].Points.size();
+
+            if (mConnectedComponentSleepStates[connectedComponentId].IsAsleep)
+            {
+                isAnySplitConnectedComponentAsleep = true;
+            }
+
+            mConnectedComponentSleepStates[connectedComponentId].RestingStepCount = 0;
+        }
+    }
+
+    //
+    // Re-calculate per-plane triangle indices
+    //
+
+    mPlaneTriangleIndicesToRender.resize(mConnectedComponentTriangleCounts.size() + 1);
+    mPlaneTriangleIndicesToRender[0] = 0;
+    for (size_t c = 0; c < mConnectedComponentTriangleCounts.size(); ++c)
+    {
+        mPlaneTriangleIndicesToRender[c + 1] = mPlaneTriangleIndicesToRender[c] + mConnectedComponentTriangleCounts[c];
+    }
+
+    //
+    // Maintain sleep states; new connected components start awake
+    //
+
+    if (isAnySplitConnectedComponentAsleep)
+    {
+        WakeUpAllConnectedComponents();
+    }
+
+    mConnectedComponentSleepStates.resize(mConnectedComponentSizes.size());
+}
+
+size_t Ship::FindConnectivityFrontGroup(size_t frontIndex)
+{
+    // Find root, halving paths along the way
+    while (mConnectivityFronts[frontIndex].Group != frontIndex)
+    {
+        size_t const parentIndex = mConnectivityFronts[frontIndex].Group;
+        mConnectivityFronts[frontIndex].Group = mConnectivityFronts[parentIndex].Group;
+        frontIndex = parentIndex;
+    }
+
+    return frontIndex;
 }
 
 void Ship::SetAndPropagateResultantPointHullness(
@@ -3353,6 +5748,86 @@ void Ship::GenerateDebris(
     }
 }
 
+void Ship::BeginBulkDetach()
+{
+    assert(!mIsBulkDetaching);
+
+    mIsBulkDetaching = true;
+
+    mBulkDetachDebrisSourcePoints.clear();
+    mBulkDetachDestroyEvents.clear();
+}
+
+void Ship::EndBulkDetach(
+    float currentSimulationTime,
+    GameParameters const & gameParameters)
+{
+    assert(mIsBulkDetaching);
+
+    mIsBulkDetaching = false;
+
+    //
+    // Generate debris from an evenly-spaced subset of the source points, so
+    // that debris grows with the destruction but stays bounded
+    //
+
+    size_t const sourcePointCount = mBulkDetachDebrisSourcePoints.size();
+    size_t const debrisSourcePointCount = std::min(sourcePointCount, MaxDebrisSourcePointsPerBulkDetach);
+    for (size_t d = 0; d < debrisSourcePointCount; ++d)
+    {
+        ElementIndex const pointIndex = mBulkDetachDebrisSourcePoints[d * sourcePointCount / debrisSourcePointCount];
+
+        GenerateDebris(
+            pointIndex,
+            mPoints.GetStructuralMaterial(pointIndex),
+            currentSimulationTime,
+            gameParameters);
+    }
+
+    //
+    // Fire aggregated destroy events
+    //
+
+    for (auto const & destroyEvent : mBulkDetachDestroyEvents)
+    {
+        mGameEventHandler->OnDestroy(
+            *(destroyEvent.Material),
+            destroyEvent.IsUnderwater,
+            destroyEvent.Count);
+    }
+
+    mBulkDetachDebrisSourcePoints.clear();
+    mBulkDetachDestroyEvents.clear();
+}
+
+void Ship::BeginBulkRestore()
+{
+    assert(!mIsBulkRestoring);
+
+    mIsBulkRestoring = true;
+
+    mWasDamagedAtBulkRestoreStart = (mDamagedPointsCount > 0 || mBrokenSpringsCount > 0 || mBrokenTrianglesCount > 0);
+
+    mSprings.BeginCoefficientsUpdateBatch();
+}
+
+void Ship::EndBulkRestore()
+{
+    assert(mIsBulkRestoring);
+
+    mIsBulkRestoring = false;
+
+    // Recalculate, once, the coefficients of all the springs restored or
+    // re-lengthened during the bulk restore
+    mSprings.EndCoefficientsUpdateBatch(mPoints);
+
+    // Notify if we've just completely restored the ship
+    if (mWasDamagedAtBulkRestoreStart && mDamagedPointsCount == 0 && mBrokenSpringsCount == 0 && mBrokenTrianglesCount == 0)
+    {
+        mGameEventHandler->OnShipRepaired(mId);
+    }
+}
+
 void Ship::GenerateSparklesForCut(
     ElementIndex springElementIndex,
     vec2f const & cutDirectionStartPos,
@@ -3512,21 +5987,51 @@ void Ship::HandlePointDetach(
 
         if (generateDebris)
         {
-            // Emit debris
-            GenerateDebris(
-                pointElementIndex,
-                mPoints.GetStructuralMaterial(pointElementIndex),
-                currentSimulationTime,
-                gameParameters);
+            if (mIsBulkDetaching)
+            {
+                // Emit debris later
+                mBulkDetachDebrisSourcePoints.push_back(pointElementIndex);
+            }
+            else
+            {
+                // Emit debris
+                GenerateDebris(
+                    pointElementIndex,
+                    mPoints.GetStructuralMaterial(pointElementIndex),
+                    currentSimulationTime,
+                    gameParameters);
+            }
         }
 
         if (fireDestroyEvent)
         {
-            // Notify destroy
-            mGameEventHandler->OnDestroy(
-                mPoints.GetStructuralMaterial(pointElementIndex),
-                mParentWorld.GetOceanSurface().IsUnderwater(mPoints.GetPosition(pointElementIndex)),
-                1);
+            StructuralMaterial const & structuralMaterial = mPoints.GetStructuralMaterial(pointElementIndex);
+            bool const isUnderwater = mParentWorld.GetOceanSurface().IsUnderwater(mPoints.GetPosition(pointElementIndex));
+
+            if (mIsBulkDetaching)
+            {
+                // Aggregate destroy
+                auto it = std::find_if(
+                    mBulkDetachDestroyEvents.begin(),
+                    mBulkDetachDestroyEvents.end(),
+                    [&](BulkDetachDestroyEvent const & e)
+                    {
+                        return e.Material == &structuralMaterial && e.IsUnderwater == isUnderwater;
+                    });
+
+                if (it != mBulkDetachDestroyEvents.end())
+                    ++(it->Count);
+                else
+                    mBulkDetachDestroyEvents.emplace_back(&structuralMaterial, isUnderwater, 1);
+            }
+            else
+            {
+                // Notify destroy
+                mGameEventHandler->OnDestroy(
+                    structuralMaterial,
+                    isUnderwater,
+                    1);
+            }
         }
 
         // Remember the structure is now dirty
@@ -3566,7 +6071,7 @@ void Ship::HandlePointRestore(ElementIndex pointElementIndex)
     --mDamagedPointsCount;
 
     // Notify if we've just completely restored the ship
-    if (mDamagedPointsCount == 0 && mBrokenSpringsCount == 0 && mBrokenTrianglesCount == 0)
+    if (!mIsBulkRestoring && mDamagedPointsCount == 0 && mBrokenSpringsCount == 0 && mBrokenTrianglesCount == 0)
     {
         mGameEventHandler->OnShipRepaired(mId);
     }
@@ -3660,11 +6165,29 @@ void Ship::HandleSpringDestroy(
     // Notify gadgets
     mGadgets.OnSpringDestroyed(springElementIndex);
 
+    // Remember the endpoints for the next connectivity visit, unless there
+    // are too many of them to make an incremental visit worthwhile
+    if (!mIsFullConnectivityVisitRequired)
+    {
+        if (mConnectivityVisitSeedPoints.size() + 2 <= MaxConnectivityVisitSeedPoints)
+        {
+            mConnectivityVisitSeedPoints.push_back(pointAIndex);
+            mConnectivityVisitSeedPoints.push_back(pointBIndex);
+        }
+        else
+        {
+            mIsFullConnectivityVisitRequired = true;
+        }
+    }
+
     // Remember our structure is now dirty
     mIsStructureDirty = true;
 
     // Update count of broken springs
     ++mBrokenSpringsCount;
+
+    // Remember we've got one more dead spring in the simulated range
+    ++mDestroyedSpringsSinceLastCompactionCount;
 }
 
 void Ship::HandleSpringRestore(
@@ -3724,6 +6247,9 @@ void Ship::HandleSpringRestore(
         1);
 
     // Remember our structure is now dirty
+    // Connected components might have merged
+    mIsFullConnectivityVisitRequired = true;
+
     mIsStructureDirty = true;
 
     // Update count of broken springs
@@ -3731,7 +6257,7 @@ void Ship::HandleSpringRestore(
     --mBrokenSpringsCount;
 
     // Notify if we've just completely restored the ship
-    if (mDamagedPointsCount == 0 && mBrokenSpringsCount == 0 && mBrokenTrianglesCount == 0)
+    if (!mIsBulkRestoring && mDamagedPointsCount == 0 && mBrokenSpringsCount == 0 && mBrokenTrianglesCount == 0)
     {
         mGameEventHandler->OnShipRepaired(mId);
     }
@@ -3773,11 +6299,26 @@ void Ship::HandleTriangleDestroy(ElementIndex triangleElementIndex)
         mSprings,
         mTriangles);
 
+    // Maintain count of triangles of the owner's connected component
+    if (auto const connectedComponentId = mPoints.GetConnectedComponentId(mTriangles.GetPointAIndex(triangleElementIndex));
+        connectedComponentId < mConnectedComponentTriangleCounts.size())
+    {
+        assert(mConnectedComponentTriangleCounts[connectedComponentId] > 0);
+        --mConnectedComponentTriangleCounts[connectedComponentId];
+    }
+
     /////////////////////////////////////////////////////////
 
     // Remember our structure is now dirty
     mIsStructureDirty = true;
 
+    // Remember to take the triangle out of the uploaded ones, unless
+    // we're going to upload all of them anyway
+    if (!mIsTriangleLayoutDirty)
+    {
+        mTrianglesToTombstone.push_back(triangleElementIndex);
+    }
+
     // Update count of broken triangles
     ++mBrokenTrianglesCount;
 }
@@ -3826,14 +6367,24 @@ void Ship::HandleTriangleRestore(ElementIndex triangleElementIndex)
         1);
 
     // Remember our structure is now dirty
+    // Maintain count of triangles of the owner's connected component
+    if (auto const connectedComponentId = mPoints.GetConnectedComponentId(mTriangles.GetPointAIndex(triangleElementIndex));
+        connectedComponentId < mConnectedComponentTriangleCounts.size())
+    {
+        ++mConnectedComponentTriangleCounts[connectedComponentId];
+    }
+
     mIsStructureDirty = true;
 
+    // The triangle has no slot among the uploaded ones
+    mIsTriangleLayoutDirty = true;
+
     // Update count of broken triangles
     assert(mBrokenTrianglesCount > 0);
     --mBrokenTrianglesCount;
 
     // Notify if we've just completely restored the ship
-    if (mDamagedPointsCount == 0 && mBrokenSpringsCount == 0 && mBrokenTrianglesCount == 0)
+    if (!mIsBulkRestoring && mDamagedPointsCount == 0 && mBrokenSpringsCount == 0 && mBrokenTrianglesCount == 0)
     {
         mGameEventHandler->OnShipRepaired(mId);
     }
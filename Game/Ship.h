@@ -14,12 +14,17 @@
 #include "RenderContext.h"
 #include "ShipDefinition.h"
 #include "ShipElectricSparks.h"
+#include "ShipMemoryReport.h"
 #include "ShipOverlays.h"
+#include "VisibleWorld.h"
 
 #include <GameCore/AABBSet.h>
+#include <GameCore/ActiveElementSet.h>
 #include <GameCore/Buffer.h>
 #include <GameCore/GameTypes.h>
 #include <GameCore/RunningAverage.h>
+#include <GameCore/StateSnapshot.h>
+#include <GameCore/TaskGraph.h>
 #include <GameCore/TaskThreadPool.h>
 #include <GameCore/Vectors.h>
 
@@ -68,6 +73,16 @@ public:
 
     void SetEventRecorder(EventRecorder * eventRecorder);
 
+    // Invoked after each stage of Update(), with the name of the stage
+    using StageObserver = TaskGraph::TaskObserver;
+
+    /*
+     * Sets a function to be invoked after each stage of Update(), e.g. for comparing
+     * the state of the ship with that of another ship at each stage; while set, the
+     * stages of the update graph run one at a time on the calling thread.
+     */
+    void SetStageObserver(StageObserver observer);
+
     bool ReplayRecordedEvent(
         RecordedEvent const & event,
         GameParameters const & gameParameters);
@@ -77,11 +92,54 @@ public:
 		Storm::Parameters const & stormParameters,
         GameParameters const & gameParameters,
         StressRenderModeType stressRenderMode,
+        VisibleWorld const & visibleWorld,
         Geometry::AABBSet & externalAabbSet,
         PerfStats & perfStats);
 
+    /*
+     * Resolves the contacts between the points of this ship and the points of the
+     * other ship that lie within the specified box - the intersection of the ships'
+     * AABBs; changes the positions and velocities of the points of both ships.
+     *
+     * Must be invoked between ship updates, when no ship is being updated.
+     */
+    void HandleCollisionsWithShip(
+        Ship & otherShip,
+        Geometry::AABB const & overlapBox,
+        GameParameters const & gameParameters);
+
     void RenderUpload(Render::RenderContext & renderContext);
 
+    void RenderUploadAhead(Render::RenderContext & renderContext);
+
+    /*
+     * Brings the structure up-to-date after an update when the ship is not being
+     * rendered, in which case RenderUpload() - which would take care of it - is
+     * never invoked; the ship can't be rendered after this.
+     */
+    void UpdateStructureHeadless();
+
+    /*
+     * Splits off the detached connected components that have at least the specified
+     * number of points into ships of their own. The first returned ship replaces this
+     * one - it keeps this ship's ID, its largest connected component, and all of the
+     * smaller fragments - and the others take consecutive IDs starting from the
+     * specified one. Returns nothing when there is nothing to split, or when the
+     * structure has changed since the last connectivity visit.
+     *
+     * This ship is left in an unspecified state whenever it's been split.
+     */
+    std::vector<std::unique_ptr<Ship>> SplitDetachedFragments(
+        ShipId firstNewShipId,
+        ElementCount minFragmentPointCount,
+        GameParameters const & gameParameters);
+
+    /*
+     * Tells whether SplitDetachedFragments() would split this ship; cheap, as it
+     * only visits the connected components.
+     */
+    bool HasDetachedFragments(ElementCount minFragmentPointCount) const;
+
 public:
 
     void Finalize();
@@ -201,6 +259,11 @@ public:
 
     void RemoveAllPins();
 
+    /*
+     * Spawns an NPC in the ship's triangle at the specified position, if any.
+     */
+    bool SpawnNPCAt(vec2f const & targetPos);
+
     std::optional<ToolApplicationLocus> InjectBubblesAt(
         vec2f const & targetPos,
         float currentSimulationTime,
@@ -291,8 +354,47 @@ public:
 
     bool RestoreTriangle(ElementIndex triangleIndex);
 
+    ShipMemoryReport GetMemoryReport() const;
+
+    /*
+     * Saves and restores the simulation state of the ship; the state may only be
+     * restored into a ship created from the same definition as the ship the state
+     * has been saved from.
+     *
+     * Gadgets, electric sparks, explosions and queued interactions are not saved;
+     * at restore, they are all removed.
+     */
+    void SaveState(StateSnapshotWriter & writer) const;
+    void LoadState(StateSnapshotReader & reader);
+
 private:
 
+    template<typename TSelf, typename TArchive>
+    static void ArchiveState(
+        TSelf & self,
+        TArchive & archive);
+
+    // Charges the specified stage of Update() with the time since the end of the previous
+    // stage, and lets the observer see the state at its end - on its own time
+    inline void EndStage(
+        PerfStats::ShipUpdateStageType stage,
+        PerfStats::ShipPerfStats & shipPerfStats,
+        GameChronometer::time_point & stageStartTime) const
+    {
+        auto const now = GameChronometer::now();
+        shipPerfStats.StageDurations[static_cast<size_t>(stage)].Update(now - stageStartTime);
+
+        if (mStageObserver)
+        {
+            mStageObserver(PerfStats::GetShipUpdateStageName(stage));
+            stageStartTime = GameChronometer::now();
+        }
+        else
+        {
+            stageStartTime = now;
+        }
+    }
+
     // Queued interactions
 
     struct Interaction
@@ -455,15 +557,18 @@ private:
 
     std::list<Interaction> mQueuedInteractions;
 
-    void ApplyBlastAt(Interaction::ArgumentsUnion::BlastArguments const & args);
+    // The queued interactions that act on all points, coalesced by type so that
+    // all of them are applied in a single pass over the points; kept to avoid
+    // reallocations
+    std::vector<Interaction::ArgumentsUnion::DrawArguments> mCoalescedDrawInteractions;
+    std::vector<Interaction::ArgumentsUnion::SwirlArguments> mCoalescedSwirlInteractions;
+    std::vector<Interaction::ArgumentsUnion::RadialWindArguments> mCoalescedRadialWindInteractions;
 
-    void DrawTo(Interaction::ArgumentsUnion::DrawArguments const & args);
+    void ApplyBlastAt(Interaction::ArgumentsUnion::BlastArguments const & args);
 
     void Pull(Interaction::ArgumentsUnion::PullArguments const & args);
 
-    void SwirlAt(Interaction::ArgumentsUnion::SwirlArguments const & args);
-
-    void ApplyRadialWindFrom(Interaction::ArgumentsUnion::RadialWindArguments const & args);
+    void ApplyCoalescedInteractions();
 
 private:
 
@@ -500,20 +605,83 @@ private:
         float effectiveWaterDensity,
         GameParameters const & gameParameters);
 
+    struct StaticPressurePartition;
+
     void ApplyStaticPressureForces(
         Frontiers::Frontier const & frontier,
         float effectiveAirDensity,
         float effectiveWaterDensity,
-        GameParameters const & gameParameters);
+        GameParameters const & gameParameters,
+        StaticPressurePartition & partition) const;
 
     void ApplySpringsForces_BySprings(GameParameters const & gameParameters);
 
-    void IntegrateAndResetDynamicForces(GameParameters const & gameParameters);
+    void ApplySpringsForces(
+        ElementIndex startSpringIndex,
+        ElementIndex endSpringIndex, // Excluded
+        vec2f * restrict dynamicForceBuffer);
+
+    void ApplyAwakeSpringsForces(
+        ElementIndex startSpringIndex,
+        ElementIndex endSpringIndex, // Excluded
+        vec2f * restrict dynamicForceBuffer);
+
+    std::pair<ElementIndex, ElementIndex> GetSpringRelaxationPartition(size_t partitionIndex) const;
+
+    void WakeUpDisturbedConnectedComponents(GameParameters const & gameParameters);
+
+    void PutRestingConnectedComponentsToSleep(GameParameters const & gameParameters);
+
+    void WakeUpAllConnectedComponents();
+
+    void RecalculateAwakeSpringRanges();
+
+    void CompactSprings();
+
+    /*
+     * Integrates all points and, if requested, handles their collisions with the sea floor,
+     * in a single pass over blocks of points.
+     *
+     * When measuring convergence, returns the maximum change - along any axis - of the
+     * velocity of the ship's (non-ephemeral) points.
+     */
+    template<bool DoMeasureConvergence>
+    float IntegrateAndResetDynamicForces(
+        bool doHandleCollisionsWithSeaFloor,
+        float seaFloorCollisionDt,
+        GameParameters const & gameParameters);
+
+    template<bool DoMeasureConvergence>
+    float IntegrateAndResetDynamicForces(
+        size_t startPointIndex,
+        size_t endPointIndex, // Excluded
+        vec2f * restrict positionBuffer,
+        vec2f * restrict velocityBuffer,
+        float dt,
+        float velocityFactor);
+
+    void ExtrapolateConvergedMechanicalDynamics(
+        int iterationCount,
+        GameParameters const & gameParameters);
+
+    static float CalculateGlobalDampingCoefficient(GameParameters const & gameParameters);
 
     void HandleCollisionsWithSeaFloor(
         float dt,
         GameParameters const & gameParameters);
 
+    void HandleCollisionsWithSeaFloor(
+        ElementIndex startPointIndex,
+        ElementIndex endPointIndex, // Excluded
+        vec2f * restrict positionBuffer,
+        vec2f * restrict velocityBuffer,
+        float dt,
+        GameParameters const & gameParameters) const;
+
+    void SolveRopeConstraints();
+
+    void RecalculateRopeSpringIndices();
+
     void TrimForWorldBounds(GameParameters const & gameParameters);
 
     // Pressure and water
@@ -528,15 +696,48 @@ private:
 
     void EqualizeInternalPressure(GameParameters const & gameParameters);
 
+    inline void EqualizeInternalPressureAt(
+        ElementIndex pointIndex,
+        float * restrict internalPressureBufferData,
+        bool const * restrict isHullBufferData);
+
     void UpdateWaterVelocities(
         GameParameters const & gameParameters,
         float & waterSplashed);
 
+    inline float CalculateWaterOutboundFlowsAt(
+        ElementIndex pointIndex,
+        float const * restrict oldPointWaterBufferData,
+        vec2f const * restrict oldPointWaterVelocityBufferData,
+        GameParameters const & gameParameters,
+        float * restrict springOutboundQuantitiesOfWater,
+        vec2f * restrict springOutboundWaterVelocities) const;
+
+    inline void GatherWaterFlowsAt(
+        ElementIndex pointIndex,
+        ActiveElementSet const & wetPoints,
+        vec2f const * restrict oldPointWaterVelocityBufferData,
+        float * restrict newPointWaterBufferData,
+        vec2f * restrict newPointWaterMomentumBufferData) const;
+
+    bool IsWaterAndPressureUpdateConcurrent(GameParameters const & gameParameters) const;
+
+    void CalculatePointColouring();
+
+    void CalculatePointNeighborhood(
+        std::vector<ElementIndex> const & pointIndices,
+        std::vector<ElementIndex> & neighborhood);
+
     void UpdateSinking();
 
     // Electrical
 
-    void DiffuseLight(GameParameters const & gameParameters);
+    // Returns whether light needs to be diffused
+    bool PrepareLightDiffusion(GameParameters const & gameParameters);
+
+    void DiffuseLight(size_t partitionIndex);
+
+    void BuildUpdateTaskGraph();
 
     // Heat
 
@@ -546,6 +747,13 @@ private:
 		Storm::Parameters const & stormParameters,
         GameParameters const & gameParameters);
 
+    // Exchanges heat among the points of the current point neighborhood, and between
+    // them and their environment, solving implicitly for their new temperatures;
+    // expects the heat solver's environment buffers to be populated
+    void PropagateHeatImplicitly(
+        float dt,
+        GameParameters const & gameParameters);
+
     // Misc
 
     void RotPoints(
@@ -588,6 +796,20 @@ private:
 
     void RunConnectivityVisit();
 
+    void RunFullConnectivityVisit();
+
+    ConnectedComponentId FindLargestConnectedComponent() const;
+
+    std::unique_ptr<Ship> MakeFragment(
+        ShipId shipId,
+        ShipFragmentMap const & fragmentMap,
+        bool isMainFragment,
+        GameParameters const & gameParameters);
+
+    void RunIncrementalConnectivityVisit();
+
+    size_t FindConnectivityFrontGroup(size_t frontIndex);
+
     inline void SetAndPropagateResultantPointHullness(
         ElementIndex pointElementIndex,
         bool isHull);
@@ -635,6 +857,27 @@ private:
         return mConnectedComponentSizes[static_cast<size_t>(connCompId)];
     }
 
+    /*
+     * Starts a bulk detach: until the matching EndBulkDetach(), detached points
+     * do not fire destroy events nor generate debris individually; at the end
+     * we fire one destroy event per material and generate debris for a capped,
+     * evenly-spaced subset of the detached points.
+     */
+    void BeginBulkDetach();
+
+    void EndBulkDetach(
+        float currentSimulationTime,
+        GameParameters const & gameParameters);
+
+    /*
+     * Starts a bulk restore: until the matching EndBulkRestore(), the coefficients of
+     * restored springs - and of springs whose rest length changes - are calculated
+     * only once at the end, and the ship-repaired event is only fired at the end.
+     */
+    void BeginBulkRestore();
+
+    void EndBulkRestore();
+
     inline void DetachPointForDestroy(
         ElementIndex pointIndex,
         vec2f const & detachVelocity,
@@ -787,6 +1030,7 @@ private:
         vec2f const & targetPos,
         float squareSearchRadius,
         SequenceNumber repairStepId,
+        size_t & attractorBudget,
         GameParameters const & gameParameters);
 
     bool RepairFromAttractor(
@@ -803,6 +1047,52 @@ private:
     std::shared_ptr<GameEventDispatcher> mGameEventHandler;
     std::shared_ptr<TaskThreadPool> mTaskThreadPool;
     EventRecorder * mEventRecorder;
+    StageObserver mStageObserver;
+
+    // The stages that Update() runs as a graph; built once at construction,
+    // with each step only binding the arguments that its stages read
+    TaskGraph mUpdateTaskGraph;
+
+    struct UpdateTaskGraphArguments
+    {
+        float CurrentSimulationTime;
+        float CurrentWallClockTimeFloat;
+        std::uint32_t LowFrequencyStep;
+        Storm::Parameters const * StormParams;
+        GameParameters const * GameParams;
+        bool DoDiffuseLight;
+    };
+
+    UpdateTaskGraphArguments mUpdateTaskGraphArguments;
+
+    // Ship-to-ship collision state, kept across steps so that its storage is reused
+    struct ShipContact
+    {
+        ElementIndex PointIndex;
+        ElementIndex OtherPointIndex;
+        vec2f Normal; // From the other point towards our point
+        float Penetration;
+
+        ShipContact(
+            ElementIndex pointIndex,
+            ElementIndex otherPointIndex,
+            vec2f const & normal,
+            float penetration)
+            : PointIndex(pointIndex)
+            , OtherPointIndex(otherPointIndex)
+            , Normal(normal)
+            , Penetration(penetration)
+        {}
+    };
+
+    struct ShipContactPartition
+    {
+        std::vector<ShipContact> Contacts;
+        std::vector<ElementIndex> QueryResult;
+    };
+
+    std::vector<ElementIndex> mShipCollisionCandidatePoints;
+    std::vector<ShipContactPartition> mShipContactPartitions;
 
     // All the ship elements - never removed, the repositories maintain their own size forever
     Points mPoints;
@@ -811,6 +1101,10 @@ private:
     ElectricalElements mElectricalElements;
     Frontiers mFrontiers;
 
+    // Electrical elements are only ever made at creation, hence ships without
+    // any skip all of the electrical stages altogether
+    bool const mHasElectricalElements;
+
     // Pinned points
     PinnedPoints mPinnedPoints;
 
@@ -820,6 +1114,9 @@ private:
     // Electric sparks
     ShipElectricSparks mElectricSparks;
 
+    // NPCs
+    NPCs mNPCs;
+
     // Overlays
     ShipOverlays mOverlays;
 
@@ -838,6 +1135,41 @@ private:
     // The number of points in each connected component
     std::vector<size_t> mConnectedComponentSizes;
 
+    // The number of triangles owned by the points of each connected component
+    std::vector<size_t> mConnectedComponentTriangleCounts;
+
+    // The endpoints of the springs destroyed since the last connectivity visit,
+    // from which the next visit re-floods the connected components that might
+    // have split
+    std::vector<ElementIndex> mConnectivityVisitSeedPoints;
+
+    // Set when the next connectivity visit has to visit all points, e.g.
+    // because connected components might have merged
+    bool mIsFullConnectivityVisitRequired;
+
+    // A flood of an incremental connectivity visit; fronts that meet are
+    // merged into groups, via union-find
+    struct ConnectivityFront
+    {
+        std::vector<ElementIndex> Points; // All points flooded by this front, in order
+        size_t NextPointToPropagateFrom; // Index in Points
+        size_t Group; // Parent front
+        size_t ActiveFrontCount; // Group root only: fronts that still have points to propagate from
+        ConnectedComponentId NewConnectedComponentId; // Group root only
+
+        ConnectivityFront()
+            : Points()
+            , NextPointToPropagateFrom(0)
+            , Group(0)
+            , ActiveFrontCount(0)
+            , NewConnectedComponentId(NoneConnectedComponentId)
+        {}
+    };
+
+    // Work buffers of incremental connectivity visits
+    std::vector<ConnectivityFront> mConnectivityFronts;
+    std::vector<std::uint32_t> mConnectivityFrontOfPoint;
+
     // Flag remembering whether the structure of the ship (i.e. the connectivity between elements)
     // has changed since the last step.
     // When this flag is set, we'll re-detect connected components and planes, and re-upload elements
@@ -868,9 +1200,6 @@ private:
     // Index of last-queried point - used as an aid to debugging
     ElementIndex mutable mLastQueriedPointIndex;
 
-    // Last-applied (interactive) wind field
-    std::optional<WindField> mWindField;
-
     // Counter of created bubble ephemeral particles
     std::uint64_t mAirBubblesCreatedCount;
 
@@ -894,12 +1223,52 @@ private:
         {}
     };
 
-    // Buffer of StaticPressureOnPoint structs, aiding static pressure calculations.
-    //
-    // Note: index in this buffer is _not_ point index, this is simply a container.
-    // Note: may be populated for the same point multiple times, once for each crossing of
-    // the frontier through that point.
-    Buffer<StaticPressureOnPoint> mStaticPressureBuffer;
+    // The state of a partition of external frontiers whose static pressure
+    // forces are calculated by the same task
+    struct StaticPressurePartition
+    {
+        // The StaticPressureOnPoint structs of all the frontiers of the partition,
+        // in frontier order.
+        //
+        // Note: index in this buffer is _not_ point index, this is simply a container.
+        // Note: may be populated for the same point multiple times, once for each crossing of
+        // the frontier through that point.
+        std::vector<StaticPressureOnPoint> Forces;
+
+        // For statistics
+        float NetForceMagnitudeSum;
+        float NetForceMagnitudeCount;
+        float IterationsPercentagesSum;
+        float IterationsCount;
+
+        StaticPressurePartition()
+            : Forces()
+            , NetForceMagnitudeSum(0.0f)
+            , NetForceMagnitudeCount(0.0f)
+            , IterationsPercentagesSum(0.0f)
+            , IterationsCount(0.0f)
+        {}
+
+        void Reset()
+        {
+            Forces.clear();
+            NetForceMagnitudeSum = 0.0f;
+            NetForceMagnitudeCount = 0.0f;
+            IterationsPercentagesSum = 0.0f;
+            IterationsCount = 0.0f;
+        }
+    };
+
+    // External frontiers are partitioned in ranges of at least this many frontiers
+    static size_t constexpr MinFrontiersPerStaticPressurePartition = 8;
+
+    // The external frontiers visited at the last static pressure calculation,
+    // kept across calculations to save allocations
+    std::vector<FrontierId> mStaticPressureExternalFrontierIds;
+
+    // The partitions of the external frontiers, kept across calculations to
+    // save allocations
+    std::vector<StaticPressurePartition> mStaticPressurePartitions;
 
     // For statistics
     float mStaticPressureNetForceMagnitudeSum;
@@ -907,6 +1276,236 @@ private:
     float mStaticPressureIterationsPercentagesSum;
     float mStaticPressureIterationsCount;
 
+    //
+    // Spring relaxation
+    //
+
+    // The number of spring partitions we relax in parallel; one partition
+    // means we relax all springs on the main thread
+    size_t mSpringRelaxationParallelism;
+
+    // The tasks - one for each partition - that relax springs in parallel;
+    // built once, as the spring partitions never change
+    std::vector<TaskThreadPool::Task> mSpringRelaxationTasks;
+
+    // The dynamic force buffers of all partitions except the first one,
+    // which writes directly into the points' dynamic force buffer.
+    // These are zero outside of spring relaxation, and they are reduced
+    // into the points' dynamic force buffer - always in the same order,
+    // so to guarantee determinism - at integration time
+    std::vector<Buffer<vec2f>> mSpringRelaxationDynamicForceBuffers;
+
+    // The number of points integrated - and collided with the sea floor - in one
+    // cache-resident pass; a multiple of the points' buffer alignment
+    static size_t constexpr IntegrationBlockSize = 1024;
+
+    // The max velocity delta measured by each integration block, kept across
+    // iterations to save allocations
+    std::vector<float> mIntegrationBlockMaxVelocityDeltas;
+
+    // The kernel that calculates spring forces, taken from the game
+    // parameters at each spring relaxation
+    SpringForcesKernelType mSpringForcesKernel;
+
+    //
+    // Concurrent water and pressure update
+    //
+
+    // The non-ephemeral points grouped by "colour", i.e. such that no two points of the
+    // same colour are closer than three springs among the factory springs - which are
+    // a superset of the springs at any moment; points of the same colour may hence
+    // be visited concurrently by algorithms that touch a point and its neighbors.
+    // Calculated on first use
+    std::vector<ElementIndex> mColouredPoints;
+
+    // The index in mColouredPoints of the first point of each colour; has
+    // one extra entry at the end
+    std::vector<size_t> mPointColourStarts;
+
+    // The outbound quantities of water and their velocities along each connected
+    // spring of each point, at MaxSpringsPerPoint slots per point
+    std::vector<float> mSpringOutboundQuantitiesOfWater;
+    std::vector<vec2f> mSpringOutboundWaterVelocities;
+
+    //
+    // Sparse water and heat propagation
+    //
+
+    // The neighborhood of a set of points, i.e. the points themselves together with
+    // all the points directly connected to them; member only to save allocations
+    std::vector<ElementIndex> mPointNeighborhood;
+    std::vector<bool> mIsPointInNeighborhood;
+
+    //
+    // Implicit heat propagation
+    //
+
+    // A spring connecting a point of the neighborhood to a point outside of it
+    struct HeatSolverBoundaryCoupling
+    {
+        ElementIndex LocalIndex; // Of the point in the neighborhood
+        ElementIndex PointIndex; // Of the point outside of the neighborhood
+        float Conductance;
+    };
+
+    // The position in the point neighborhood of each point, or NoneElementIndex when
+    // not in the neighborhood; all NoneElementIndex between propagations
+    std::vector<ElementIndex> mHeatSolverLocalIndices;
+
+    // The system, indexed by position in the point neighborhood - with the couplings
+    // among points of the neighborhood in compressed-sparse-row form; members only
+    // to save allocations
+    std::vector<float> mHeatSolverEnvironmentTemperatures;
+    std::vector<float> mHeatSolverEnvironmentCoefficients;
+    std::vector<float> mHeatSolverTemperatures;
+    std::vector<float> mHeatSolverRightHandSides;
+    std::vector<float> mHeatSolverDiagonalReciprocals;
+    std::vector<ElementIndex> mHeatSolverRowStarts;
+    std::vector<ElementIndex> mHeatSolverCouplingLocalIndices;
+    std::vector<float> mHeatSolverCouplingCoefficients;
+    std::vector<HeatSolverBoundaryCoupling> mHeatSolverBoundaryCouplings;
+
+    //
+    // Light diffusion
+    //
+
+    // A range of points to which we diffuse light on a separate thread
+    struct LightDiffusionPartition
+    {
+        ElementIndex StartPointIndex;
+        ElementIndex EndPointIndex; // Excluded
+
+        // Work buffers for the lamps reaching each tile of points
+        Buffer<vec2f> CulledLampPositions;
+        Buffer<PlaneId> CulledLampPlaneIds;
+        Buffer<float> CulledLampDistanceCoefficients;
+        Buffer<float> CulledLampSpreadMaxDistances;
+
+        LightDiffusionPartition(
+            ElementIndex startPointIndex,
+            ElementIndex endPointIndex,
+            ElementCount bufferLampCount)
+            : StartPointIndex(startPointIndex)
+            , EndPointIndex(endPointIndex)
+            , CulledLampPositions(bufferLampCount)
+            , CulledLampPlaneIds(bufferLampCount)
+            , CulledLampDistanceCoefficients(bufferLampCount)
+            , CulledLampSpreadMaxDistances(bufferLampCount)
+        {}
+    };
+
+    // Built once, as neither points nor lamps ever change in number
+    std::vector<LightDiffusionPartition> mLightDiffusionPartitions;
+
+    // The next point to be checked for having drifted away from the temperature
+    // of its environment
+    ElementIndex mNextHotPointsSweepPointIndex;
+
+    //
+    // Sleeping connected components
+    //
+
+    struct ConnectedComponentSleepState
+    {
+        bool IsAsleep;
+        std::uint32_t RestingStepCount; // Consecutive steps at which the component has been found at rest
+
+        // Accumulators, only valid while evaluating rest
+        float KineticEnergy;
+        float Mass;
+
+        ConnectedComponentSleepState()
+            : IsAsleep(false)
+            , RestingStepCount(0)
+            , KineticEnergy(0.0f)
+            , Mass(0.0f)
+        {}
+    };
+
+    // Indexed by connected component ID
+    std::vector<ConnectedComponentSleepState> mConnectedComponentSleepStates;
+    size_t mSleepingConnectedComponentCount;
+
+    // The position and static force of each sleeping point at the moment it fell
+    // asleep, against which we detect disturbances
+    std::vector<vec2f> mSleepingPointPositions;
+    std::vector<vec2f> mSleepingPointStaticForces;
+
+    // The ranges [start, end) of the springs of awake connected components; only
+    // valid while at least one connected component is asleep
+    std::vector<std::pair<ElementIndex, ElementIndex>> mAwakeSpringRanges;
+
+    //
+    // Spring compaction
+    //
+
+    // The number of springs destroyed since the last compaction
+    ElementCount mDestroyedSpringsSinceLastCompactionCount;
+
+    //
+    // Repair
+    //
+
+    // The points in the radius of the current repair step, kept across
+    // steps to save allocations
+    std::vector<ElementIndex> mRepairPointsInRadius;
+
+    // The points that would have been attractors at the last repair step,
+    // had that step not run out of its attractor budget
+    std::vector<ElementIndex> mRepairDeferredAttractors;
+    SequenceNumber mRepairDeferredAttractorsStepId;
+
+    // The deferred attractors being visited at the current repair step
+    std::vector<ElementIndex> mRepairCurrentDeferredAttractors;
+
+    //
+    // Bulk detach
+    //
+
+    struct BulkDetachDestroyEvent
+    {
+        StructuralMaterial const * Material;
+        bool IsUnderwater;
+        unsigned int Count;
+
+        BulkDetachDestroyEvent(
+            StructuralMaterial const * material,
+            bool isUnderwater,
+            unsigned int count)
+            : Material(material)
+            , IsUnderwater(isUnderwater)
+            , Count(count)
+        {}
+    };
+
+    // The max number of detached points that generate debris at the end of a bulk detach
+    static size_t constexpr MaxDebrisSourcePointsPerBulkDetach = 24;
+
+    bool mIsBulkDetaching;
+
+    // The points detached during the current bulk detach that would have generated debris
+    std::vector<ElementIndex> mBulkDetachDebrisSourcePoints;
+
+    // The destroy events of the current bulk detach, aggregated by material and underwater-ness
+    std::vector<BulkDetachDestroyEvent> mBulkDetachDestroyEvents;
+
+    //
+    // Bulk restore
+    //
+
+    bool mIsBulkRestoring;
+
+    // Whether the ship was damaged when the current bulk restore started
+    bool mWasDamagedAtBulkRestoreStart;
+
+    //
+    // Rope constraints
+    //
+
+    // The indices of all rope springs - deleted ones included - in spring order;
+    // recalculated whenever springs are renumbered
+    std::vector<ElementIndex> mRopeSpringIndices;
+
     //
     // Render members
     //
@@ -918,6 +1517,12 @@ private:
     // Initial indices of the triangles for each plane ID;
     // last extra element contains total number of triangles
     std::vector<size_t> mPlaneTriangleIndicesToRender;
+
+    // Set when the triangles need to be uploaded whole - i.e. when triangles have been
+    // restored or their planes have changed; otherwise, triangles destroyed since
+    // the last upload are just tombstoned in the render context
+    bool mIsTriangleLayoutDirty;
+    std::vector<ElementIndex> mTrianglesToTombstone;
 };
 
 }
\ No newline at end of file
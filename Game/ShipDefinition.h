@@ -32,4 +32,14 @@ struct ShipDefinition
         , PhysicsData(physicsData)
         , AutoTexturizationSettings(autoTexturizationSettings)
     {}
+
+    ShipDefinition Clone() const
+    {
+        return ShipDefinition(
+            Size,
+            Layers.Clone(),
+            Metadata,
+            PhysicsData,
+            AutoTexturizationSettings);
+    }
 };
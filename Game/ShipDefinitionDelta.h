@@ -0,0 +1,153 @@
+/***************************************************************************************
+ * Original Author:     Gabriele Giuseppini
+ * Created:             2026-10-14
+ * Copyright:           Gabriele Giuseppini  (https://github.com/GabrieleGiuseppini)
+ ***************************************************************************************/
+#pragma once
+
+#include "Layers.h"
+#include "ShipAutoTexturizationSettings.h"
+#include "ShipDefinition.h"
+#include "ShipMetadata.h"
+#include "ShipPhysicsData.h"
+
+#include <GameCore/GameTypes.h>
+
+#include <cassert>
+#include <optional>
+
+/*
+ * The changes made to a ship definition since an earlier state of it, as recorded
+ * in autosave journals.
+ *
+ * Layers' changes are the regions that changed - with the exception of ropes, which
+ * are whole - while the (small) properties are always whole. A delta never changes
+ * the shape of a ship - its size, its texture's size, and which layers it has.
+ */
+struct ShipDefinitionDelta
+{
+    template<typename TLayerData, typename TCoordinates>
+    struct LayerRegion
+    {
+        TCoordinates Origin;
+        TLayerData Data; // Just the region
+
+        LayerRegion(
+            TCoordinates const & origin,
+            TLayerData && data)
+            : Origin(origin)
+            , Data(std::move(data))
+        {}
+    };
+
+    ShipSpaceSize ShipSize; // Of the ship this delta applies to
+
+    std::optional<LayerRegion<StructuralLayerData, ShipSpaceCoordinates>> StructuralLayerRegion;
+    std::optional<LayerRegion<ElectricalLayerData, ShipSpaceCoordinates>> ElectricalLayerRegion; // Panel is whole
+    std::optional<RopesLayerData> RopesLayer;
+    std::optional<LayerRegion<TextureLayerData, ImageCoordinates>> TextureLayerRegion;
+
+    std::optional<ShipMetadata> Metadata;
+    std::optional<ShipPhysicsData> PhysicsData;
+    std::optional<std::optional<ShipAutoTexturizationSettings>> AutoTexturizationSettings;
+
+    explicit ShipDefinitionDelta(ShipSpaceSize const & shipSize)
+        : ShipSize(shipSize)
+        , StructuralLayerRegion()
+        , ElectricalLayerRegion()
+        , RopesLayer()
+        , TextureLayerRegion()
+        , Metadata()
+        , PhysicsData()
+        , AutoTexturizationSettings()
+    {}
+
+    bool IsEmpty() const
+    {
+        return !StructuralLayerRegion.has_value()
+            && !ElectricalLayerRegion.has_value()
+            && !RopesLayer.has_value()
+            && !TextureLayerRegion.has_value()
+            && !Metadata.has_value()
+            && !PhysicsData.has_value()
+            && !AutoTexturizationSettings.has_value();
+    }
+
+    /*
+     * Returns whether this delta may be applied to the specified ship definition,
+     * i.e. whether the ship's shape accommodates all of the changes.
+     */
+    bool IsApplicableTo(ShipDefinition const & shipDefinition) const
+    {
+        if (shipDefinition.Size != ShipSize)
+            return false;
+
+        if (StructuralLayerRegion.has_value()
+            && !ShipSpaceRect(StructuralLayerRegion->Origin, StructuralLayerRegion->Data.Buffer.Size).IsContainedInRect(ShipSpaceRect(ShipSize)))
+            return false;
+
+        if (ElectricalLayerRegion.has_value()
+            && (!shipDefinition.Layers.ElectricalLayer
+                || !ShipSpaceRect(ElectricalLayerRegion->Origin, ElectricalLayerRegion->Data.Buffer.Size).IsContainedInRect(ShipSpaceRect(ShipSize))))
+            return false;
+
+        if (RopesLayer.has_value() && !shipDefinition.Layers.RopesLayer)
+            return false;
+
+        if (TextureLayerRegion.has_value()
+            && (!shipDefinition.Layers.TextureLayer
+                || !ImageRect(TextureLayerRegion->Origin, TextureLayerRegion->Data.Buffer.Size).IsContainedInRect(ImageRect(shipDefinition.Layers.TextureLayer->Buffer.Size))))
+            return false;
+
+        return true;
+    }
+
+    /*
+     * Applies this delta to the specified ship definition, which must be applicable.
+     */
+    ShipDefinition ApplyTo(ShipDefinition && shipDefinition) const
+    {
+        assert(IsApplicableTo(shipDefinition));
+
+        ShipLayers & layers = shipDefinition.Layers;
+
+        if (StructuralLayerRegion.has_value())
+        {
+            layers.StructuralLayer.Buffer.BlitFromRegion(
+                StructuralLayerRegion->Data.Buffer,
+                ShipSpaceRect(StructuralLayerRegion->Data.Buffer.Size),
+                StructuralLayerRegion->Origin);
+        }
+
+        if (ElectricalLayerRegion.has_value())
+        {
+            layers.ElectricalLayer->Buffer.BlitFromRegion(
+                ElectricalLayerRegion->Data.Buffer,
+                ShipSpaceRect(ElectricalLayerRegion->Data.Buffer.Size),
+                ElectricalLayerRegion->Origin);
+
+            layers.ElectricalLayer->Panel = ElectricalLayerRegion->Data.Panel;
+        }
+
+        if (RopesLayer.has_value())
+        {
+            *layers.RopesLayer = RopesLayer->Clone();
+        }
+
+        if (TextureLayerRegion.has_value())
+        {
+            layers.TextureLayer->Buffer.BlitFromRegion(
+                TextureLayerRegion->Data.Buffer,
+                ImageRect(TextureLayerRegion->Data.Buffer.Size),
+                TextureLayerRegion->Origin);
+        }
+
+        // Rebuild, as the auto-texturization settings may not be assigned
+        return ShipDefinition(
+            shipDefinition.Size,
+            std::move(layers),
+            Metadata.has_value() ? *Metadata : shipDefinition.Metadata,
+            PhysicsData.has_value() ? *PhysicsData : shipDefinition.PhysicsData,
+            AutoTexturizationSettings.has_value() ? *AutoTexturizationSettings : shipDefinition.AutoTexturizationSettings);
+    }
+};
@@ -11,11 +11,14 @@
 #include <GameCore/GameException.h>
 #include <GameCore/GameTypes.h>
 #include <GameCore/Log.h>
+#include <GameCore/TaskThread.h>
 #include <GameCore/UserGameException.h>
 
 #include <algorithm>
 #include <cassert>
 #include <cstddef>
+#include <deque>
+#include <unordered_map>
 #include <utility>
 
 namespace {
@@ -24,6 +27,51 @@ unsigned char const HeaderTitle[] = "FLOATING SANDBOX SHIP\x1a\x00\x00";
 
 uint8_t constexpr CurrentFileFormatVersion = 1;
 
+/*
+ * Memoizes the material lookups of a layer decode, so that the material map
+ * is only searched once per distinct color key - rather than once per RLE run,
+ * which for a large ship means hundreds of thousands of tree walks for a few
+ * dozen materials.
+ */
+template<typename TMaterial>
+class MaterialLookupCache
+{
+public:
+
+    explicit MaterialLookupCache(MaterialDatabase::MaterialMap<TMaterial> const & materialMap)
+        : mMaterialMap(materialMap)
+        , mMaterials()
+    {}
+
+    /*
+     * Returns nullptr when the color key is not in the material map.
+     */
+    inline TMaterial const * Find(MaterialColorKey const & colorKey)
+    {
+        std::uint32_t const packedColorKey =
+            (static_cast<std::uint32_t>(colorKey.r) << 16)
+            | (static_cast<std::uint32_t>(colorKey.g) << 8)
+            | static_cast<std::uint32_t>(colorKey.b);
+
+        auto [it, isInserted] = mMaterials.try_emplace(packedColorKey, nullptr);
+        if (isInserted)
+        {
+            auto const materialIt = mMaterialMap.find(colorKey);
+            if (materialIt != mMaterialMap.cend())
+            {
+                it->second = &(materialIt->second);
+            }
+        }
+
+        return it->second;
+    }
+
+private:
+
+    MaterialDatabase::MaterialMap<TMaterial> const & mMaterialMap;
+    std::unordered_map<std::uint32_t, TMaterial const *> mMaterials;
+};
+
 }
 
 ShipDefinition ShipDefinitionFormatDeSerializer::Load(
@@ -46,8 +94,17 @@ ShipDefinition ShipDefinitionFormatDeSerializer::Load(
     std::unique_ptr<TextureLayerData> textureLayer;
     bool hasSeenTail = false;
 
+    // The texture - the most expensive section to decode - is decoded on its own
+    // thread, while we go on parsing the structure; the thread is declared after
+    // what it works on, so that it's joined before those go away
+    DeSerializationBuffer<BigEndianess> textureBuffer(256);
+    std::optional<RgbaImageData> textureImage;
+    std::unique_ptr<TaskThread> textureDecodingThread;
+    TaskThread::TaskCompletionIndicator textureDecodingCompletionIndicator;
+
     Parse(
         shipFilePath,
+        {}, // All sections
         [&](SectionHeader const & sectionHeader, std::ifstream & inputFile) -> bool
         {
             switch (sectionHeader.Tag)
@@ -140,11 +197,14 @@ ShipDefinition ShipDefinitionFormatDeSerializer::Load(
 
                 case static_cast<uint32_t>(MainSectionTagType::TextureLayer_PNG) :
                 {
-                    ReadIntoBuffer(inputFile, buffer, sectionHeader.SectionBodySize);
-                    RgbaImageData image = ReadPngImage(buffer);
+                    ReadIntoBuffer(inputFile, textureBuffer, sectionHeader.SectionBodySize);
 
-                    // Make texture out of this image
-                    textureLayer = std::make_unique<TextureLayerData>(std::move(image));
+                    textureDecodingThread = std::make_unique<TaskThread>();
+                    textureDecodingCompletionIndicator = textureDecodingThread->QueueTask(
+                        [&textureImage, &textureBuffer]()
+                        {
+                            textureImage.emplace(ReadPngImage(textureBuffer));
+                        });
 
                     break;
                 }
@@ -180,6 +240,20 @@ ShipDefinition ShipDefinitionFormatDeSerializer::Load(
             return false;
         });
 
+    //
+    // Wait for the texture
+    //
+
+    if (textureDecodingCompletionIndicator)
+    {
+        textureDecodingCompletionIndicator->Wait();
+
+        assert(textureImage.has_value());
+
+        // Make texture out of this image
+        textureLayer = std::make_unique<TextureLayerData>(std::move(*textureImage));
+    }
+
     //
     // Ensure all the required sections have been seen
     //
@@ -214,6 +288,7 @@ ShipPreviewData ShipDefinitionFormatDeSerializer::LoadPreviewData(std::filesyste
 
     Parse(
         shipFilePath,
+        { MainSectionTagType::ShipAttributes, MainSectionTagType::Metadata },
         [&](SectionHeader const & sectionHeader, std::ifstream & inputFile) -> bool
         {
             switch (sectionHeader.Tag)
@@ -277,6 +352,7 @@ RgbaImageData ShipDefinitionFormatDeSerializer::LoadPreviewImage(
 
     Parse(
         previewFilePath,
+        { MainSectionTagType::TextureLayer_PNG, MainSectionTagType::Preview_PNG },
         [&](SectionHeader const & sectionHeader, std::ifstream & inputFile) -> bool
         {
             switch (sectionHeader.Tag)
@@ -325,24 +401,39 @@ void ShipDefinitionFormatDeSerializer::Save(
     ShipDefinition const & shipDefinition,
     std::filesystem::path const & shipFilePath)
 {
-    DeSerializationBuffer<BigEndianess> buffer(256);
-
     //
-    // Open file
+    // Encode all sections - in file order - each one into its own buffer; the PNG
+    // image, by far the most expensive section to encode, is encoded on its own
+    // thread, while we go on encoding all the others
     //
 
-    std::ofstream outputFile = std::ofstream(
-        shipFilePath,
-        std::ios_base::out | std::ios_base::binary | std::ios_base::trunc);
+    struct EncodedSection
+    {
+        std::uint32_t Tag;
+        DeSerializationBuffer<BigEndianess> Buffer;
+        size_t BodySize;
 
-    //
-    // Write header
-    //
+        explicit EncodedSection(std::uint32_t tag)
+            : Tag(tag)
+            , Buffer(256)
+            , BodySize(0)
+        {}
+    };
+
+    // A deque, so that sections don't move while the image is being encoded; the
+    // thread is declared after what it works on, so that it's joined before those go away
+    std::deque<EncodedSection> sections;
+    std::unique_ptr<TaskThread> imageEncodingThread;
+    TaskThread::TaskCompletionIndicator imageEncodingCompletionIndicator;
 
-    AppendFileHeader(outputFile, buffer);
+    auto const encodeSection = [&sections](MainSectionTagType tag, auto const & sectionBodyAppender)
+    {
+        auto & section = sections.emplace_back(static_cast<std::uint32_t>(tag));
+        section.BodySize = EncodeSection(section.Tag, sectionBodyAppender, section.Buffer);
+    };
 
     //
-    // Write ship attributes
+    // Ship attributes
     //
 
     ShipAttributes const shipAttributes = ShipAttributes(
@@ -352,127 +443,281 @@ void ShipDefinitionFormatDeSerializer::Save(
         shipDefinition.Layers.HasElectricalLayer(),
         PortableTimepoint::Now());
 
-    AppendSection(
-        outputFile,
-        static_cast<std::uint32_t>(MainSectionTagType::ShipAttributes),
-        [&]() { return AppendShipAttributes(shipAttributes, buffer); },
-        buffer);
+    encodeSection(
+        MainSectionTagType::ShipAttributes,
+        [&](DeSerializationBuffer<BigEndianess> & buffer) { return AppendShipAttributes(shipAttributes, buffer); });
 
     //
-    // Write metadata
+    // Metadata
     //
 
-    AppendSection(
-        outputFile,
-        static_cast<std::uint32_t>(MainSectionTagType::Metadata),
-        [&]() { return AppendMetadata(shipDefinition.Metadata, buffer); },
-        buffer);
+    encodeSection(
+        MainSectionTagType::Metadata,
+        [&](DeSerializationBuffer<BigEndianess> & buffer) { return AppendMetadata(shipDefinition.Metadata, buffer); });
 
-    if (shipDefinition.Layers.TextureLayer)
-    {
-        //
-        // Write texture
-        //
+    //
+    // Texture, or else a preview image made out of the structure
+    //
 
-        AppendSection(
-            outputFile,
-            static_cast<std::uint32_t>(MainSectionTagType::TextureLayer_PNG),
-            [&]() { return AppendPngImage(shipDefinition.Layers.TextureLayer->Buffer, buffer); },
-            buffer);
-    }
-    else
     {
-        //
-        // Make and write a preview image
-        //
+        auto & imageSection = sections.emplace_back(static_cast<std::uint32_t>(
+            shipDefinition.Layers.TextureLayer
+            ? MainSectionTagType::TextureLayer_PNG
+            : MainSectionTagType::Preview_PNG));
 
-        AppendSection(
-            outputFile,
-            static_cast<std::uint32_t>(MainSectionTagType::Preview_PNG),
-            [&]() { return AppendPngPreview(shipDefinition.Layers.StructuralLayer, buffer); },
-            buffer);
+        imageEncodingThread = std::make_unique<TaskThread>();
+        imageEncodingCompletionIndicator = imageEncodingThread->QueueTask(
+            [&imageSection, &shipDefinition]()
+            {
+                imageSection.BodySize = EncodeSection(
+                    imageSection.Tag,
+                    [&](DeSerializationBuffer<BigEndianess> & buffer)
+                    {
+                        return shipDefinition.Layers.TextureLayer
+                            ? AppendPngImage(shipDefinition.Layers.TextureLayer->Buffer, buffer)
+                            : AppendPngPreview(shipDefinition.Layers.StructuralLayer, buffer);
+                    },
+                    imageSection.Buffer);
+            });
     }
 
     //
-    // Write structural layer
+    // Structural layer
     //
 
-    AppendSection(
-        outputFile,
-        static_cast<std::uint32_t>(MainSectionTagType::StructuralLayer),
-        [&]() { return AppendStructuralLayer(shipDefinition.Layers.StructuralLayer, buffer); },
-        buffer);
+    encodeSection(
+        MainSectionTagType::StructuralLayer,
+        [&](DeSerializationBuffer<BigEndianess> & buffer) { return AppendStructuralLayer(shipDefinition.Layers.StructuralLayer, buffer); });
 
     //
-    // Write electrical layer
+    // Electrical layer
     //
 
     if (shipDefinition.Layers.ElectricalLayer)
     {
-        AppendSection(
-            outputFile,
-            static_cast<std::uint32_t>(MainSectionTagType::ElectricalLayer),
-            [&]() { return AppendElectricalLayer(*shipDefinition.Layers.ElectricalLayer, buffer); },
-            buffer);
+        encodeSection(
+            MainSectionTagType::ElectricalLayer,
+            [&](DeSerializationBuffer<BigEndianess> & buffer) { return AppendElectricalLayer(*shipDefinition.Layers.ElectricalLayer, buffer); });
     }
 
     //
-    // Write ropes layer
+    // Ropes layer
     //
 
     if (shipDefinition.Layers.RopesLayer)
     {
-        AppendSection(
-            outputFile,
-            static_cast<std::uint32_t>(MainSectionTagType::RopesLayer),
-            [&]() { return AppendRopesLayer(*shipDefinition.Layers.RopesLayer, buffer); },
-            buffer);
+        encodeSection(
+            MainSectionTagType::RopesLayer,
+            [&](DeSerializationBuffer<BigEndianess> & buffer) { return AppendRopesLayer(*shipDefinition.Layers.RopesLayer, buffer); });
     }
 
     //
-    // Write physics data
+    // Physics data
     //
 
-    AppendSection(
-        outputFile,
-        static_cast<std::uint32_t>(MainSectionTagType::PhysicsData),
-        [&]() { return AppendPhysicsData(shipDefinition.PhysicsData, buffer); },
-        buffer);
+    encodeSection(
+        MainSectionTagType::PhysicsData,
+        [&](DeSerializationBuffer<BigEndianess> & buffer) { return AppendPhysicsData(shipDefinition.PhysicsData, buffer); });
 
     //
-    // Write auto-texturization settings
+    // Auto-texturization settings
     //
 
     if (shipDefinition.AutoTexturizationSettings.has_value())
     {
+        encodeSection(
+            MainSectionTagType::AutoTexturizationSettings,
+            [&](DeSerializationBuffer<BigEndianess> & buffer) { return AppendAutoTexturizationSettings(*shipDefinition.AutoTexturizationSettings, buffer); });
+    }
+
+    //
+    // Tail
+    //
+
+    encodeSection(
+        MainSectionTagType::Tail,
+        [](DeSerializationBuffer<BigEndianess> &) { return size_t(0); });
+
+    //
+    // Wait for the image
+    //
+
+    imageEncodingCompletionIndicator->Wait();
+
+    //
+    // Write all sections to a temporary file, which then replaces the ship file,
+    // so that a failed save never leaves a broken ship file behind
+    //
+
+    std::filesystem::path const tempShipFilePath = std::filesystem::path(shipFilePath).concat(".tmp");
+
+    {
+        DeSerializationBuffer<BigEndianess> buffer(256);
+
+        std::ofstream outputFile = std::ofstream(
+            tempShipFilePath,
+            std::ios_base::out | std::ios_base::binary | std::ios_base::trunc);
+
+        if (!outputFile.is_open())
+        {
+            throw GameException("Cannot open file \"" + tempShipFilePath.string() + "\" for writing");
+        }
+
+        //
+        // Write header
+        //
+
+        AppendFileHeader(outputFile, buffer);
+
+        //
+        // Write sections
+        //
+
+        std::vector<SectionIndexEntry> sectionIndex;
+
+        for (auto const & section : sections)
+        {
+            std::uint32_t const sectionOffset = static_cast<std::uint32_t>(outputFile.tellp());
+
+            outputFile.write(reinterpret_cast<char const *>(section.Buffer.GetData()), section.Buffer.GetSize());
+
+            sectionIndex.emplace_back(
+                section.Tag,
+                sectionOffset,
+                static_cast<std::uint32_t>(section.BodySize));
+        }
+
+        //
+        // Write section index and its footer
+        //
+
+        std::uint32_t const sectionIndexOffset = static_cast<std::uint32_t>(outputFile.tellp());
+
         AppendSection(
             outputFile,
-            static_cast<std::uint32_t>(MainSectionTagType::AutoTexturizationSettings),
-            [&]() { return AppendAutoTexturizationSettings(*shipDefinition.AutoTexturizationSettings, buffer); },
+            static_cast<std::uint32_t>(MainSectionTagType::SectionIndex),
+            [&](DeSerializationBuffer<BigEndianess> & buffer) { return AppendSectionIndex(sectionIndex, buffer); },
             buffer);
+
+        AppendSectionIndexFooter(outputFile, sectionIndexOffset, buffer);
+
+        //
+        // Close file
+        //
+
+        outputFile.flush();
+
+        bool const isSuccess = outputFile.good();
+
+        outputFile.close();
+
+        if (!isSuccess)
+        {
+            std::error_code ec;
+            std::filesystem::remove(tempShipFilePath, ec);
+
+            throw GameException("Error writing file \"" + tempShipFilePath.string() + "\"");
+        }
     }
 
+    std::filesystem::rename(tempShipFilePath, shipFilePath);
+}
+
+PasswordHash ShipDefinitionFormatDeSerializer::CalculatePasswordHash(std::string const & password)
+{
+    return static_cast<PasswordHash>(std::hash<std::string>{}(password + "fs_salt_0$%"));
+}
+
+void ShipDefinitionFormatDeSerializer::AppendToJournal(
+    ShipDefinitionDelta const & delta,
+    std::filesystem::path const & journalFilePath)
+{
     //
-    // Write tail
+    // Encode the whole record first, so that it's written out at once
     //
 
-    AppendSection(
-        outputFile,
-        static_cast<std::uint32_t>(MainSectionTagType::Tail),
-        [&]() { return 0; },
+    DeSerializationBuffer<BigEndianess> buffer(256);
+
+    EncodeSection(
+        static_cast<std::uint32_t>(MainSectionTagType::JournalRecord),
+        [&](DeSerializationBuffer<BigEndianess> & buffer) { return AppendJournalRecord(delta, buffer); },
         buffer);
 
     //
-    // Close file
+    // Append record
     //
 
+    std::ofstream outputFile = std::ofstream(
+        journalFilePath,
+        std::ios_base::out | std::ios_base::binary | std::ios_base::app);
+
+    if (!outputFile.is_open())
+    {
+        throw GameException("Cannot open file \"" + journalFilePath.string() + "\" for writing");
+    }
+
+    outputFile.write(reinterpret_cast<char const *>(buffer.GetData()), buffer.GetSize());
     outputFile.flush();
-    outputFile.close();
+
+    if (!outputFile.good())
+    {
+        throw GameException("Error writing file \"" + journalFilePath.string() + "\"");
+    }
 }
 
-PasswordHash ShipDefinitionFormatDeSerializer::CalculatePasswordHash(std::string const & password)
+ShipDefinition ShipDefinitionFormatDeSerializer::LoadWithJournal(
+    std::filesystem::path const & shipFilePath,
+    std::filesystem::path const & journalFilePath,
+    MaterialDatabase const & materialDatabase)
 {
-    return static_cast<PasswordHash>(std::hash<std::string>{}(password + "fs_salt_0$%"));
+    // Definition is re-built at each record, as it may not be assigned
+    std::optional<ShipDefinition> shipDefinition;
+    shipDefinition.emplace(Load(shipFilePath, materialDatabase));
+
+    std::ifstream inputFile = std::ifstream(journalFilePath, std::ios_base::in | std::ios_base::binary);
+    if (!inputFile.is_open())
+    {
+        // No journal
+        return std::move(*shipDefinition);
+    }
+
+    inputFile.seekg(0, std::ios_base::end);
+    size_t const fileSize = static_cast<size_t>(inputFile.tellg());
+    inputFile.seekg(0, std::ios_base::beg);
+
+    DeSerializationBuffer<BigEndianess> buffer(256);
+
+    size_t recordCount = 0;
+    for (size_t readOffset = 0; readOffset + sizeof(SectionHeader) <= fileSize; )
+    {
+        SectionHeader const sectionHeader = ReadSectionHeader(inputFile, buffer);
+        readOffset += sizeof(SectionHeader);
+
+        if (sectionHeader.Tag != static_cast<uint32_t>(MainSectionTagType::JournalRecord)
+            || readOffset + sectionHeader.SectionBodySize > fileSize)
+        {
+            LogMessage("WARNING: Torn journal record at offset ", readOffset - sizeof(SectionHeader), ", ignoring the rest of the journal");
+            break;
+        }
+
+        ReadIntoBuffer(inputFile, buffer, sectionHeader.SectionBodySize);
+        readOffset += sectionHeader.SectionBodySize;
+
+        ShipDefinitionDelta const delta = ReadJournalRecord(buffer, materialDatabase);
+        if (!delta.IsApplicableTo(*shipDefinition))
+        {
+            LogMessage("WARNING: Journal record #", recordCount, " does not apply to the ship, ignoring the rest of the journal");
+            break;
+        }
+
+        shipDefinition.emplace(delta.ApplyTo(std::move(*shipDefinition)));
+
+        ++recordCount;
+    }
+
+    LogMessage("ShipDefinitionFormatDeSerializer::LoadWithJournal(): replayed ", recordCount, " journal records");
+
+    return std::move(*shipDefinition);
 }
 
 //////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -480,11 +725,30 @@ PasswordHash ShipDefinitionFormatDeSerializer::CalculatePasswordHash(std::string
 // Write
 
 template<typename TSectionBodyAppender>
-void ShipDefinitionFormatDeSerializer::AppendSection(
+ShipDefinitionFormatDeSerializer::SectionIndexEntry ShipDefinitionFormatDeSerializer::AppendSection(
     std::ofstream & outputFile,
     std::uint32_t tag,
     TSectionBodyAppender const & sectionBodyAppender,
     DeSerializationBuffer<BigEndianess> & buffer)
+{
+    std::uint32_t const sectionOffset = static_cast<std::uint32_t>(outputFile.tellp());
+
+    size_t const sectionBodySize = EncodeSection(tag, sectionBodyAppender, buffer);
+
+    // Serialize
+    outputFile.write(reinterpret_cast<char const *>(buffer.GetData()), buffer.GetSize());
+
+    return SectionIndexEntry(
+        tag,
+        sectionOffset,
+        static_cast<std::uint32_t>(sectionBodySize));
+}
+
+template<typename TSectionBodyAppender>
+size_t ShipDefinitionFormatDeSerializer::EncodeSection(
+    std::uint32_t tag,
+    TSectionBodyAppender const & sectionBodyAppender,
+    DeSerializationBuffer<BigEndianess> & buffer)
 {
     buffer.Reset();
 
@@ -495,12 +759,44 @@ void ShipDefinitionFormatDeSerializer::AppendSection(
     size_t const sectionBodySizeIndex = buffer.ReserveAndAdvance<std::uint32_t>();
 
     // SectionBody
-    size_t const sectionBodySize = sectionBodyAppender();
+    size_t const sectionBodySize = sectionBodyAppender(buffer);
 
     // SectionBodySize, again
     buffer.WriteAt(static_cast<std::uint32_t>(sectionBodySize), sectionBodySizeIndex);
 
-    // Serialize
+    return sectionBodySize;
+}
+
+size_t ShipDefinitionFormatDeSerializer::AppendSectionIndex(
+    std::vector<SectionIndexEntry> const & sectionIndex,
+    DeSerializationBuffer<BigEndianess> & buffer)
+{
+    size_t sectionBodySize = 0;
+
+    sectionBodySize += buffer.Append(static_cast<std::uint32_t>(sectionIndex.size()));
+
+    for (auto const & entry : sectionIndex)
+    {
+        sectionBodySize += buffer.Append(entry.Tag);
+        sectionBodySize += buffer.Append(entry.SectionOffset);
+        sectionBodySize += buffer.Append(entry.SectionBodySize);
+    }
+
+    return sectionBodySize;
+}
+
+void ShipDefinitionFormatDeSerializer::AppendSectionIndexFooter(
+    std::ofstream & outputFile,
+    std::uint32_t sectionIndexOffset,
+    DeSerializationBuffer<BigEndianess> & buffer)
+{
+    buffer.Reset();
+
+    buffer.Append(sectionIndexOffset);
+    buffer.Append(static_cast<std::uint32_t>(MainSectionTagType::SectionIndex));
+
+    assert(buffer.GetSize() == SectionIndexFooterSize);
+
     outputFile.write(reinterpret_cast<char const *>(buffer.GetData()), buffer.GetSize());
 }
 
@@ -1262,11 +1558,150 @@ size_t ShipDefinitionFormatDeSerializer::AppendPngPreview(
         buffer);
 }
 
+size_t ShipDefinitionFormatDeSerializer::AppendJournalRecord(
+    ShipDefinitionDelta const & delta,
+    DeSerializationBuffer<BigEndianess> & buffer)
+{
+    size_t sectionBodySize = 0;
+
+    auto const appendSubSection = [&](JournalRecordTagType tag, auto const & subSectionBodyAppender)
+    {
+        buffer.Append(static_cast<std::uint32_t>(tag));
+        size_t const subSectionBodySizeIndex = buffer.ReserveAndAdvance<std::uint32_t>();
+
+        static_assert(sizeof(SectionHeader) == sizeof(std::uint32_t) + sizeof(std::uint32_t));
+        sectionBodySize += sizeof(SectionHeader);
+
+        // Body
+        size_t const subSectionBodySize = subSectionBodyAppender();
+
+        buffer.WriteAt(static_cast<std::uint32_t>(subSectionBodySize), subSectionBodySizeIndex);
+
+        sectionBodySize += subSectionBodySize;
+    };
+
+    // Regions start with their origin and - unless it's implied - their size
+    auto const appendRegionPrefix = [&buffer](auto const & origin, std::optional<ShipSpaceSize> const & size) -> size_t
+    {
+        size_t sz = buffer.Append(static_cast<std::int32_t>(origin.x));
+        sz += buffer.Append(static_cast<std::int32_t>(origin.y));
+
+        if (size.has_value())
+        {
+            sz += buffer.Append(static_cast<std::int32_t>(size->width));
+            sz += buffer.Append(static_cast<std::int32_t>(size->height));
+        }
+
+        return sz;
+    };
+
+    //
+    // Ship size - always first
+    //
+
+    appendSubSection(
+        JournalRecordTagType::ShipSize,
+        [&]()
+        {
+            return buffer.Append(static_cast<std::int32_t>(delta.ShipSize.width))
+                + buffer.Append(static_cast<std::int32_t>(delta.ShipSize.height));
+        });
+
+    //
+    // Layers
+    //
+
+    if (delta.StructuralLayerRegion.has_value())
+    {
+        appendSubSection(
+            JournalRecordTagType::StructuralLayerRegion,
+            [&]()
+            {
+                return appendRegionPrefix(delta.StructuralLayerRegion->Origin, delta.StructuralLayerRegion->Data.Buffer.Size)
+                    + AppendStructuralLayer(delta.StructuralLayerRegion->Data, buffer);
+            });
+    }
+
+    if (delta.ElectricalLayerRegion.has_value())
+    {
+        appendSubSection(
+            JournalRecordTagType::ElectricalLayerRegion,
+            [&]()
+            {
+                return appendRegionPrefix(delta.ElectricalLayerRegion->Origin, delta.ElectricalLayerRegion->Data.Buffer.Size)
+                    + AppendElectricalLayer(delta.ElectricalLayerRegion->Data, buffer);
+            });
+    }
+
+    if (delta.RopesLayer.has_value())
+    {
+        appendSubSection(
+            JournalRecordTagType::RopesLayer,
+            [&]() { return AppendRopesLayer(*delta.RopesLayer, buffer); });
+    }
+
+    if (delta.TextureLayerRegion.has_value())
+    {
+        appendSubSection(
+            JournalRecordTagType::TextureLayerRegion,
+            [&]()
+            {
+                return appendRegionPrefix(delta.TextureLayerRegion->Origin, std::nullopt)
+                    + AppendPngImage(delta.TextureLayerRegion->Data.Buffer, buffer);
+            });
+    }
+
+    //
+    // Properties
+    //
+
+    if (delta.Metadata.has_value())
+    {
+        appendSubSection(
+            JournalRecordTagType::Metadata,
+            [&]() { return AppendMetadata(*delta.Metadata, buffer); });
+    }
+
+    if (delta.PhysicsData.has_value())
+    {
+        appendSubSection(
+            JournalRecordTagType::PhysicsData,
+            [&]() { return AppendPhysicsData(*delta.PhysicsData, buffer); });
+    }
+
+    if (delta.AutoTexturizationSettings.has_value())
+    {
+        if (delta.AutoTexturizationSettings->has_value())
+        {
+            appendSubSection(
+                JournalRecordTagType::AutoTexturizationSettings,
+                [&]() { return AppendAutoTexturizationSettings(**delta.AutoTexturizationSettings, buffer); });
+        }
+        else
+        {
+            appendSubSection(
+                JournalRecordTagType::NoAutoTexturizationSettings,
+                []() { return size_t(0); });
+        }
+    }
+
+    //
+    // Tail
+    //
+
+    appendSubSection(
+        JournalRecordTagType::Tail,
+        []() { return size_t(0); });
+
+    return sectionBodySize;
+}
+
 // Read
 
 template<typename SectionHandler>
 void ShipDefinitionFormatDeSerializer::Parse(
     std::filesystem::path const & shipFilePath,
+    std::vector<MainSectionTagType> const & sectionsOfInterest,
     SectionHandler const & sectionHandler)
 {
     DeSerializationBuffer<BigEndianess> buffer(256);
@@ -1283,6 +1718,47 @@ void ShipDefinitionFormatDeSerializer::Parse(
 
     ReadFileHeader(inputFile, buffer);
 
+    //
+    // Jump to the sections of interest, if we've got an index
+    //
+
+    if (!sectionsOfInterest.empty())
+    {
+        auto const sectionIndex = ReadSectionIndex(inputFile, buffer);
+        if (sectionIndex.has_value())
+        {
+            for (auto const & entry : *sectionIndex)
+            {
+                if (std::find(sectionsOfInterest.cbegin(), sectionsOfInterest.cend(), static_cast<MainSectionTagType>(entry.Tag)) == sectionsOfInterest.cend())
+                {
+                    continue;
+                }
+
+                inputFile.seekg(entry.SectionOffset, std::ios_base::beg);
+
+                SectionHeader const sectionHeader = ReadSectionHeader(inputFile, buffer);
+                if (sectionHeader.Tag != entry.Tag || sectionHeader.SectionBodySize != entry.SectionBodySize)
+                {
+                    throw UserGameException(UserGameException::MessageIdType::InvalidShipFile);
+                }
+
+                if (sectionHandler(sectionHeader, inputFile))
+                {
+                    // We're done
+                    break;
+                }
+            }
+
+            inputFile.close();
+
+            return;
+        }
+
+        // No index - e.g. a file saved by an older version - hence go through all sections
+        inputFile.clear();
+        inputFile.seekg(sizeof(FileHeader), std::ios_base::beg);
+    }
+
     //
     // Read and process sections
     //
@@ -1375,6 +1851,102 @@ ShipDefinitionFormatDeSerializer::SectionHeader ShipDefinitionFormatDeSerializer
     };
 }
 
+std::optional<std::vector<ShipDefinitionFormatDeSerializer::SectionIndexEntry>> ShipDefinitionFormatDeSerializer::ReadSectionIndex(
+    std::ifstream & inputFile,
+    DeSerializationBuffer<BigEndianess> & buffer)
+{
+    inputFile.seekg(0, std::ios_base::end);
+    auto const fileSize = static_cast<size_t>(inputFile.tellg());
+    if (!inputFile || fileSize < sizeof(FileHeader) + sizeof(SectionHeader) + SectionIndexFooterSize)
+    {
+        inputFile.clear();
+        return std::nullopt;
+    }
+
+    size_t const footerOffset = fileSize - SectionIndexFooterSize;
+
+    //
+    // Footer
+    //
+
+    inputFile.seekg(footerOffset, std::ios_base::beg);
+    ReadIntoBuffer(inputFile, buffer, SectionIndexFooterSize);
+
+    std::uint32_t sectionIndexOffset;
+    size_t const sz = buffer.ReadAt<std::uint32_t>(0, sectionIndexOffset);
+
+    std::uint32_t footerTag;
+    buffer.ReadAt<std::uint32_t>(sz, footerTag);
+
+    if (footerTag != static_cast<std::uint32_t>(MainSectionTagType::SectionIndex)
+        || sectionIndexOffset < sizeof(FileHeader)
+        || sectionIndexOffset + sizeof(SectionHeader) > footerOffset)
+    {
+        // No index
+        return std::nullopt;
+    }
+
+    //
+    // Index
+    //
+
+    inputFile.seekg(sectionIndexOffset, std::ios_base::beg);
+
+    SectionHeader const sectionHeader = ReadSectionHeader(inputFile, buffer);
+    if (sectionHeader.Tag != static_cast<std::uint32_t>(MainSectionTagType::SectionIndex)
+        || sectionIndexOffset + sizeof(SectionHeader) + sectionHeader.SectionBodySize != footerOffset)
+    {
+        throw UserGameException(UserGameException::MessageIdType::InvalidShipFile);
+    }
+
+    ReadIntoBuffer(inputFile, buffer, sectionHeader.SectionBodySize);
+    auto sectionIndex = ReadSectionIndex(buffer);
+
+    for (auto const & entry : sectionIndex)
+    {
+        if (entry.SectionOffset < sizeof(FileHeader)
+            || static_cast<size_t>(entry.SectionOffset) + sizeof(SectionHeader) + entry.SectionBodySize > sectionIndexOffset)
+        {
+            throw UserGameException(UserGameException::MessageIdType::InvalidShipFile);
+        }
+    }
+
+    return sectionIndex;
+}
+
+std::vector<ShipDefinitionFormatDeSerializer::SectionIndexEntry> ShipDefinitionFormatDeSerializer::ReadSectionIndex(DeSerializationBuffer<BigEndianess> const & buffer)
+{
+    std::vector<SectionIndexEntry> sectionIndex;
+
+    size_t offset = 0;
+
+    std::uint32_t entryCount;
+    offset += buffer.ReadAt<std::uint32_t>(offset, entryCount);
+
+    if (sizeof(std::uint32_t) + static_cast<size_t>(entryCount) * 3 * sizeof(std::uint32_t) != buffer.GetSize())
+    {
+        throw UserGameException(UserGameException::MessageIdType::InvalidShipFile);
+    }
+
+    sectionIndex.reserve(entryCount);
+
+    for (std::uint32_t e = 0; e < entryCount; ++e)
+    {
+        std::uint32_t tag;
+        offset += buffer.ReadAt<std::uint32_t>(offset, tag);
+
+        std::uint32_t sectionOffset;
+        offset += buffer.ReadAt<std::uint32_t>(offset, sectionOffset);
+
+        std::uint32_t sectionBodySize;
+        offset += buffer.ReadAt<std::uint32_t>(offset, sectionBodySize);
+
+        sectionIndex.emplace_back(tag, sectionOffset, sectionBodySize);
+    }
+
+    return sectionIndex;
+}
+
 RgbaImageData ShipDefinitionFormatDeSerializer::ReadPngImage(DeSerializationBuffer<BigEndianess> & buffer)
 {
     return ImageFileTools::DecodePngImage(buffer);
@@ -1800,6 +2372,8 @@ void ShipDefinitionFormatDeSerializer::ReadStructuralLayer(
 {
     size_t readOffset = 0;
 
+    MaterialLookupCache<StructuralMaterial> materialLookupCache(materialMap);
+
     // Allocate buffer
     structuralLayer.reset(new StructuralLayerData(shipAttributes.ShipSize));
 
@@ -1834,13 +2408,11 @@ void ShipDefinitionFormatDeSerializer::ReadStructuralLayer(
                     }
                     else
                     {
-                        auto const materialIt = materialMap.find(colorKey);
-                        if (materialIt == materialMap.cend())
+                        material = materialLookupCache.Find(colorKey);
+                        if (material == nullptr)
                         {
                             ThrowMaterialNotFound(shipAttributes);
                         }
-
-                        material = &(materialIt->second);
                     }
 
                     // Fill material
@@ -1890,6 +2462,8 @@ void ShipDefinitionFormatDeSerializer::ReadElectricalLayer(
 {
     size_t readOffset = 0;
 
+    MaterialLookupCache<ElectricalMaterial> materialLookupCache(materialMap);
+
     // Allocate buffer
     electricalLayer.reset(new ElectricalLayerData(shipAttributes.ShipSize));
 
@@ -1924,13 +2498,11 @@ void ShipDefinitionFormatDeSerializer::ReadElectricalLayer(
                     }
                     else
                     {
-                        auto const materialIt = materialMap.find(colorKey);
-                        if (materialIt == materialMap.cend())
+                        material = materialLookupCache.Find(colorKey);
+                        if (material == nullptr)
                         {
                             ThrowMaterialNotFound(shipAttributes);
                         }
-
-                        material = &(materialIt->second);
                     }
 
                     // Deserialize instanceID - only if instanced
@@ -2133,4 +2705,188 @@ void ShipDefinitionFormatDeSerializer::ReadRopesLayer(
 
         readOffset += sectionHeader.SectionBodySize;
     }
-}
\ No newline at end of file
+}
+ShipDefinitionDelta ShipDefinitionFormatDeSerializer::ReadJournalRecord(
+    DeSerializationBuffer<BigEndianess> const & buffer,
+    MaterialDatabase const & materialDatabase)
+{
+    size_t readOffset = 0;
+
+    // Sub-section bodies are read from the start of their own buffer
+    DeSerializationBuffer<BigEndianess> subSectionBuffer(256);
+    auto const readSubSectionBody = [&](size_t bodyOffset, size_t bodySize) -> DeSerializationBuffer<BigEndianess> &
+    {
+        subSectionBuffer.Reset();
+        subSectionBuffer.Append(buffer.GetData() + bodyOffset, bodySize);
+        return subSectionBuffer;
+    };
+
+    auto const readRegionPrefix = [&buffer](size_t & offset, auto & origin, std::optional<ShipSpaceSize> * size)
+    {
+        std::int32_t x, y;
+        offset += buffer.ReadAt<std::int32_t>(offset, x);
+        offset += buffer.ReadAt<std::int32_t>(offset, y);
+        origin.x = x;
+        origin.y = y;
+
+        if (size != nullptr)
+        {
+            std::int32_t width, height;
+            offset += buffer.ReadAt<std::int32_t>(offset, width);
+            offset += buffer.ReadAt<std::int32_t>(offset, height);
+            size->emplace(width, height);
+        }
+    };
+
+    // Layers are read with the region's size as the ship size
+    auto const makeRegionShipAttributes = [](ShipSpaceSize const & regionSize)
+    {
+        return ShipAttributes(
+            Version::CurrentVersion(),
+            regionSize,
+            false,
+            false,
+            PortableTimepoint::Now());
+    };
+
+    // Ship size - always first
+    SectionHeader sectionHeader = ReadSectionHeader(buffer, readOffset);
+    readOffset += sizeof(SectionHeader);
+    if (sectionHeader.Tag != static_cast<uint32_t>(JournalRecordTagType::ShipSize))
+    {
+        throw UserGameException(UserGameException::MessageIdType::InvalidShipFile);
+    }
+
+    std::int32_t shipWidth, shipHeight;
+    buffer.ReadAt<std::int32_t>(readOffset, shipWidth);
+    buffer.ReadAt<std::int32_t>(readOffset + sizeof(std::int32_t), shipHeight);
+    readOffset += sectionHeader.SectionBodySize;
+
+    ShipDefinitionDelta delta(ShipSpaceSize(shipWidth, shipHeight));
+
+    // Read all other tags
+    while (true)
+    {
+        sectionHeader = ReadSectionHeader(buffer, readOffset);
+        readOffset += sizeof(SectionHeader);
+
+        switch (sectionHeader.Tag)
+        {
+            case static_cast<uint32_t>(JournalRecordTagType::StructuralLayerRegion) :
+            {
+                size_t bodyOffset = readOffset;
+                ShipSpaceCoordinates origin(0, 0);
+                std::optional<ShipSpaceSize> size;
+                readRegionPrefix(bodyOffset, origin, &size);
+
+                std::unique_ptr<StructuralLayerData> structuralLayer;
+                ReadStructuralLayer(
+                    readSubSectionBody(bodyOffset, sectionHeader.SectionBodySize - (bodyOffset - readOffset)),
+                    makeRegionShipAttributes(*size),
+                    materialDatabase.GetStructuralMaterialMap(),
+                    structuralLayer);
+
+                delta.StructuralLayerRegion.emplace(origin, std::move(*structuralLayer));
+
+                break;
+            }
+
+            case static_cast<uint32_t>(JournalRecordTagType::ElectricalLayerRegion) :
+            {
+                size_t bodyOffset = readOffset;
+                ShipSpaceCoordinates origin(0, 0);
+                std::optional<ShipSpaceSize> size;
+                readRegionPrefix(bodyOffset, origin, &size);
+
+                std::unique_ptr<ElectricalLayerData> electricalLayer;
+                ReadElectricalLayer(
+                    readSubSectionBody(bodyOffset, sectionHeader.SectionBodySize - (bodyOffset - readOffset)),
+                    makeRegionShipAttributes(*size),
+                    materialDatabase.GetElectricalMaterialMap(),
+                    electricalLayer);
+
+                delta.ElectricalLayerRegion.emplace(origin, std::move(*electricalLayer));
+
+                break;
+            }
+
+            case static_cast<uint32_t>(JournalRecordTagType::RopesLayer) :
+            {
+                std::unique_ptr<RopesLayerData> ropesLayer;
+                ReadRopesLayer(
+                    readSubSectionBody(readOffset, sectionHeader.SectionBodySize),
+                    makeRegionShipAttributes(delta.ShipSize),
+                    materialDatabase.GetStructuralMaterialMap(),
+                    ropesLayer);
+
+                delta.RopesLayer.emplace(std::move(*ropesLayer));
+
+                break;
+            }
+
+            case static_cast<uint32_t>(JournalRecordTagType::TextureLayerRegion) :
+            {
+                size_t bodyOffset = readOffset;
+                ImageCoordinates origin(0, 0);
+                readRegionPrefix(bodyOffset, origin, nullptr);
+
+                delta.TextureLayerRegion.emplace(
+                    origin,
+                    TextureLayerData(ReadPngImage(readSubSectionBody(bodyOffset, sectionHeader.SectionBodySize - (bodyOffset - readOffset)))));
+
+                break;
+            }
+
+            case static_cast<uint32_t>(JournalRecordTagType::Metadata) :
+            {
+                delta.Metadata.emplace(ReadMetadata(readSubSectionBody(readOffset, sectionHeader.SectionBodySize)));
+
+                break;
+            }
+
+            case static_cast<uint32_t>(JournalRecordTagType::PhysicsData) :
+            {
+                delta.PhysicsData.emplace(ReadPhysicsData(readSubSectionBody(readOffset, sectionHeader.SectionBodySize)));
+
+                break;
+            }
+
+            case static_cast<uint32_t>(JournalRecordTagType::AutoTexturizationSettings) :
+            {
+                delta.AutoTexturizationSettings.emplace(ReadAutoTexturizationSettings(readSubSectionBody(readOffset, sectionHeader.SectionBodySize)));
+
+                break;
+            }
+
+            case static_cast<uint32_t>(JournalRecordTagType::NoAutoTexturizationSettings) :
+            {
+                delta.AutoTexturizationSettings.emplace(std::nullopt);
+
+                break;
+            }
+
+            case static_cast<uint32_t>(JournalRecordTagType::Tail) :
+            {
+                // We're done
+                break;
+            }
+
+            default:
+            {
+                // Unrecognized tag
+                LogMessage("WARNING: Unrecognized journal record tag ", sectionHeader.Tag);
+                break;
+            }
+        }
+
+        if (sectionHeader.Tag == static_cast<uint32_t>(JournalRecordTagType::Tail))
+        {
+            // We're done
+            break;
+        }
+
+        readOffset += sectionHeader.SectionBodySize;
+    }
+
+    return delta;
+}
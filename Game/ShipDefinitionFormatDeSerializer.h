@@ -7,6 +7,7 @@
 
 #include "MaterialDatabase.h"
 #include "ShipDefinition.h"
+#include "ShipDefinitionDelta.h"
 #include "ShipPreviewData.h"
 
 #include <GameCore/DeSerializationBuffer.h>
@@ -21,7 +22,9 @@
 #include <functional>
 #include <map>
 #include <memory>
+#include <optional>
 #include <string>
+#include <vector>
 
 #define MAKE_TAG(ch1, ch2, ch3, ch4) \
     std::uint32_t( ((ch1 & 0xff) << 24) | ((ch2 & 0xff) << 16) | ((ch3 & 0xff) << 8) | (ch4 & 0xff) )
@@ -49,6 +52,23 @@ public:
 
     static PasswordHash CalculatePasswordHash(std::string const & password);
 
+    /*
+     * Appends a record to an autosave journal, creating it if it doesn't exist; each record
+     * is flushed as a whole, hence a crash may at most tear the last one.
+     */
+    static void AppendToJournal(
+        ShipDefinitionDelta const & delta,
+        std::filesystem::path const & journalFilePath);
+
+    /*
+     * Loads the ship, and replays on it the records of its autosave journal - if it exists;
+     * stops at the first record that is torn or that does not apply to the ship.
+     */
+    static ShipDefinition LoadWithJournal(
+        std::filesystem::path const & shipFilePath,
+        std::filesystem::path const & journalFilePath,
+        MaterialDatabase const & materialDatabase);
+
 private:
 
 #pragma pack(push, 1)
@@ -107,9 +127,36 @@ private:
         ShipAttributes = MAKE_TAG('A', 'T', 'T', '1'),
         Preview_PNG = MAKE_TAG('P', 'V', 'P', '1'),
 
-        Tail = 0xffffffff
+        Tail = 0xffffffff,
+
+        // Follows the tail, hence it's never seen by readers that stop at the tail;
+        // it's then followed by a SectionIndexFooter, which closes the file
+        SectionIndex = MAKE_TAG('I', 'D', 'X', '1'),
+
+        // Only in autosave journals, which consist of these sections alone
+        JournalRecord = MAKE_TAG('J', 'R', 'N', '1')
+    };
+
+    // One entry for each section preceding the section index
+    struct SectionIndexEntry
+    {
+        std::uint32_t Tag;
+        std::uint32_t SectionOffset; // Of the section's header, from the beginning of the file
+        std::uint32_t SectionBodySize;
+
+        SectionIndexEntry(
+            std::uint32_t tag,
+            std::uint32_t sectionOffset,
+            std::uint32_t sectionBodySize)
+            : Tag(tag)
+            , SectionOffset(sectionOffset)
+            , SectionBodySize(sectionBodySize)
+        {}
     };
 
+    // Serialized as the section index's offset followed by the SectionIndex tag
+    static size_t constexpr SectionIndexFooterSize = sizeof(std::uint32_t) + sizeof(std::uint32_t);
+
     enum class ShipAttributesTagType : std::uint32_t
     {
         // Numeric values are serialized in ship files, changing them will result
@@ -188,6 +235,24 @@ private:
         Tail = 0xffffffff
     };
 
+    enum class JournalRecordTagType : std::uint32_t
+    {
+        // Numeric values are serialized in journal files, changing them will result
+        // in journal files being un-deserializable!
+
+        ShipSize = MAKE_TAG('S', 'S', 'Z', '1'),
+        StructuralLayerRegion = MAKE_TAG('S', 'T', 'R', 'R'), // Origin, size, and structural layer section body
+        ElectricalLayerRegion = MAKE_TAG('E', 'L', 'C', 'R'), // Origin, size, and electrical layer section body
+        RopesLayer = MAKE_TAG('R', 'P', 'S', '1'),
+        TextureLayerRegion = MAKE_TAG('T', 'X', 'P', 'R'), // Origin, and PNG image
+        Metadata = MAKE_TAG('M', 'E', 'T', '1'),
+        PhysicsData = MAKE_TAG('P', 'H', 'S', '1'),
+        AutoTexturizationSettings = MAKE_TAG('A', 'T', 'X', '1'),
+        NoAutoTexturizationSettings = MAKE_TAG('A', 'T', 'X', '0'),
+
+        Tail = 0xffffffff
+    };
+
     enum class RopesLayerTagType : std::uint32_t
     {
         // Numeric values are serialized in ship files, changing them will result
@@ -203,12 +268,28 @@ private:
     // Write
 
     template<typename TSectionAppender>
-    static void AppendSection(
+    static SectionIndexEntry AppendSection(
         std::ofstream & outputFile,
         std::uint32_t tag,
         TSectionAppender const & sectionAppender,
         DeSerializationBuffer<BigEndianess> & buffer);
 
+    // Encodes a whole section - header and body - into the buffer, returning the body's size
+    template<typename TSectionAppender>
+    static size_t EncodeSection(
+        std::uint32_t tag,
+        TSectionAppender const & sectionAppender,
+        DeSerializationBuffer<BigEndianess> & buffer);
+
+    static size_t AppendSectionIndex(
+        std::vector<SectionIndexEntry> const & sectionIndex,
+        DeSerializationBuffer<BigEndianess> & buffer);
+
+    static void AppendSectionIndexFooter(
+        std::ofstream & outputFile,
+        std::uint32_t sectionIndexOffset,
+        DeSerializationBuffer<BigEndianess> & buffer);
+
     static size_t AppendPngImage(
         RgbaImageData const & rawImageData,
         DeSerializationBuffer<BigEndianess> & buffer);
@@ -291,11 +372,18 @@ private:
         StructuralLayerData const & structuralLayer,
         DeSerializationBuffer<BigEndianess> & buffer);
 
+    static size_t AppendJournalRecord(
+        ShipDefinitionDelta const & delta,
+        DeSerializationBuffer<BigEndianess> & buffer);
+
     // Read
 
+    // When sections of interest are specified and the file has a section index,
+    // only visits those sections, seeking directly to each of them
     template<typename SectionHandler>
     static void Parse(
         std::filesystem::path const & shipFilePath,
+        std::vector<MainSectionTagType> const & sectionsOfInterest,
         SectionHandler const & sectionHandler);
 
     static std::ifstream OpenFileForRead(std::filesystem::path const & shipFilePath);
@@ -315,6 +403,12 @@ private:
         DeSerializationBuffer<BigEndianess> const & buffer,
         size_t offset);
 
+    static std::optional<std::vector<SectionIndexEntry>> ReadSectionIndex(
+        std::ifstream & inputFile,
+        DeSerializationBuffer<BigEndianess> & buffer);
+
+    static std::vector<SectionIndexEntry> ReadSectionIndex(DeSerializationBuffer<BigEndianess> const & buffer);
+
     static RgbaImageData ReadPngImage(DeSerializationBuffer<BigEndianess> & buffer);
 
     static RgbaImageData ReadPngImageAndResize(
@@ -355,12 +449,17 @@ private:
         MaterialDatabase::MaterialMap<StructuralMaterial> const & materialMap,
         std::unique_ptr<RopesLayerData> & ropesLayer);
 
+    static ShipDefinitionDelta ReadJournalRecord(
+        DeSerializationBuffer<BigEndianess> const & buffer,
+        MaterialDatabase const & materialDatabase);
+
 private:
 
     friend class ShipDefinitionFormatDeSerializerTests_FileHeader_Test;
     friend class ShipDefinitionFormatDeSerializerTests_FileHeader_UnrecognizedHeader_Test;
     friend class ShipDefinitionFormatDeSerializerTests_FileHeader_UnsupportedFileFormatVersion_Test;
     friend class ShipDefinitionFormatDeSerializerTests_ShipAttributes_Test;
+    friend class ShipDefinitionFormatDeSerializerTests_SectionIndex_Test;
     friend class ShipDefinitionFormatDeSerializerTests_Metadata_Full_Test;
     friend class ShipDefinitionFormatDeSerializerTests_Metadata_Minimal_Test;
     friend class ShipDefinitionFormatDeSerializerTests_PhysicsData_Test;
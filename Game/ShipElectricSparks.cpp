@@ -21,6 +21,13 @@ ShipElectricSparks::ShipElectricSparks(
     , mIsSpringElectrifiedNew(springs.GetElementCount(), 0, false)
     , mPointElectrificationCounter(points.GetElementCount(), 0, std::numeric_limits<std::uint64_t>::max())
     , mAreSparksPopulatedBeforeNextUpdate(false)
+    , mIsPathReusable(false)
+    , mPathInitialPointIndex(NoneElementIndex)
+    , mPathCounter(0)
+    , mPathMaxEquivalentPathLength(0.0f)
+    , mPathReuseCount(0)
+    , mPathSprings()
+    , mElectrifiedPoints()
     , mSparksToRender()
 {
 }
@@ -54,14 +61,35 @@ bool ShipElectricSparks::ApplySparkAt(
 
     if (nearestPointIndex != NoneElementIndex)
     {
-        PropagateSparks(
-            nearestPointIndex,
-            counter,
-            lengthMultiplier,
-            currentSimulationTime,
-            points,
-            springs,
-            gameParameters);
+        float const maxEquivalentPathLength =
+            17.0f // Magic number: max length of arc without tool modifier and default settings
+            * lengthMultiplier
+            * (gameParameters.IsUltraViolentMode ? 2.0f : 1.0f);
+
+        // Calculate max equivalent path length (total of single-step costs) for this interaction:
+        // we won't create arcs longer than this at this interaction
+        float const maxEquivalentPathLengthForThisInteraction = std::min(
+            static_cast<float>(counter + 1),
+            maxEquivalentPathLength);
+
+        if (CanReusePath(nearestPointIndex, counter, maxEquivalentPathLengthForThisInteraction, springs))
+        {
+            ReusePath(
+                counter,
+                currentSimulationTime,
+                gameParameters);
+        }
+        else
+        {
+            PropagateSparks(
+                nearestPointIndex,
+                counter,
+                maxEquivalentPathLengthForThisInteraction,
+                currentSimulationTime,
+                points,
+                springs,
+                gameParameters);
+        }
 
         return true;
     }
@@ -77,11 +105,30 @@ void ShipElectricSparks::Update()
     if (!mAreSparksPopulatedBeforeNextUpdate)
     {
         mSparksToRender.clear();
+        mIsPathReusable = false;
     }
 
     mAreSparksPopulatedBeforeNextUpdate = false;
 }
 
+void ShipElectricSparks::RemapSpringIndices(std::vector<ElementIndex> const & newToOldSpringIndices)
+{
+    // Only the previous interaction's state survives across interactions
+    mIsSpringElectrifiedOld.permute(newToOldSpringIndices);
+
+    // The path refers to the old spring indices
+    mIsPathReusable = false;
+}
+
+void ShipElectricSparks::Reset()
+{
+    mIsSpringElectrifiedOld.fill(false);
+    mIsSpringElectrifiedNew.fill(false);
+    mAreSparksPopulatedBeforeNextUpdate = false;
+    mIsPathReusable = false;
+    mSparksToRender.clear();
+}
+
 void ShipElectricSparks::Upload(
     Points const & points,
     ShipId shipId,
@@ -91,21 +138,28 @@ void ShipElectricSparks::Upload(
 
     shipRenderContext.UploadElectricSparksStart(mSparksToRender.size());
 
+    auto const calculateDirection = [&](RenderableElectricSpark const & electricSpark)
+    {
+        return (points.GetPosition(electricSpark.EndPointIndex) - points.GetPosition(electricSpark.StartPointIndex)).normalise();
+    };
+
     for (auto const & electricSpark : mSparksToRender)
     {
+        vec2f const direction = calculateDirection(electricSpark);
+
         shipRenderContext.UploadElectricSpark(
             points.GetPlaneId(electricSpark.StartPointIndex),
-            electricSpark.StartPointPosition,
+            points.GetPosition(electricSpark.StartPointIndex),
             electricSpark.StartSize,
-            electricSpark.EndPointPosition,
+            points.GetPosition(electricSpark.EndPointIndex),
             electricSpark.EndSize,
-            electricSpark.Direction,
+            direction,
             electricSpark.PreviousSparkIndex.has_value()
-                ? mSparksToRender[*electricSpark.PreviousSparkIndex].Direction
-                : electricSpark.Direction,
+                ? calculateDirection(mSparksToRender[*electricSpark.PreviousSparkIndex])
+                : direction,
             electricSpark.NextSparkIndex.has_value()
-                ? mSparksToRender[*electricSpark.NextSparkIndex].Direction
-                : electricSpark.Direction);
+                ? calculateDirection(mSparksToRender[*electricSpark.NextSparkIndex])
+                : direction);
     }
 
     shipRenderContext.UploadElectricSparksEnd();
@@ -116,7 +170,7 @@ void ShipElectricSparks::Upload(
 void ShipElectricSparks::PropagateSparks(
     ElementIndex const initialPointIndex,
     std::uint64_t counter,
-    float lengthMultiplier,
+    float maxEquivalentPathLengthForThisInteraction,
     float currentSimulationTime,
     Points const & points,
     Springs const & springs,
@@ -135,10 +189,6 @@ void ShipElectricSparks::PropagateSparks(
     size_t constexpr InitialArcsMax = 6;
     float constexpr ForkSpacingMin = 5.0f;
     float constexpr ForkSpacingMax = 10.0f;
-    float const maxEquivalentPathLength =
-        17.0f // Magic number: max length of arc without tool modifier and default settings
-        * lengthMultiplier
-        * (gameParameters.IsUltraViolentMode ? 2.0f : 1.0f);
 
     // The information associated with a point that the next expansion will start from
     struct SparkPointToVisit
@@ -181,14 +231,10 @@ void ShipElectricSparks::PropagateSparks(
         mPointElectrificationCounter.fill(std::numeric_limits<std::uint64_t>::max());
     }
 
-    // Clear the sparks that have to be rendered after this step
+    // Clear the sparks that have to be rendered after this step, and the path
     mSparksToRender.clear();
-
-    // Calculate max equivalent path length (total of single-step costs) for this interaction:
-    // we won't create arcs longer than this at this interaction
-    float const maxEquivalentPathLengthForThisInteraction = std::min(
-        static_cast<float>(counter + 1),
-        maxEquivalentPathLength);
+    mPathSprings.clear();
+    mElectrifiedPoints.clear();
 
     // Functor that calculates size of a spark, given its current path length and the distance of that path
     // length from the maximum for this interaction:
@@ -205,7 +251,7 @@ void ShipElectricSparks::PropagateSparks(
 
     float const initialPointSize = calculateSparkSize(0.0f);
 
-    mShipPhysicsHandler.HandleElectricSpark(
+    ElectrifyPoint(
         initialPointIndex,
         initialPointSize, // strength
         currentSimulationTime,
@@ -277,6 +323,8 @@ void ShipElectricSparks::PropagateSparks(
 
         for (ElementIndex const s : initialSprings)
         {
+            mPathSprings.push_back(s);
+
             ElementIndex const targetEndpointIndex = springs.GetOtherEndpointIndex(s, initialPointIndex);
             vec2f const targetEndpointPosition = points.GetPosition(targetEndpointIndex);
             vec2f const direction = (targetEndpointPosition - initialPointPosition).normalise();
@@ -290,7 +338,7 @@ void ShipElectricSparks::PropagateSparks(
             // an N-way fork, which could even get compounded by being picked up at the next, and so on...
 
             // Electrify target point
-            mShipPhysicsHandler.HandleElectricSpark(
+            ElectrifyPoint(
                 targetEndpointIndex,
                 endSize, // strength
                 currentSimulationTime,
@@ -315,11 +363,9 @@ void ShipElectricSparks::PropagateSparks(
             // Render
             mSparksToRender.emplace_back(
                 initialPointIndex,
-                initialPointPosition,
                 initialPointSize,
-                targetEndpointPosition,
+                targetEndpointIndex,
                 endSize,
-                direction,
                 std::nullopt); // No previous spark
         }
     }
@@ -332,7 +378,8 @@ void ShipElectricSparks::PropagateSparks(
 
     std::vector<ElementIndex> nextSprings; // Allocated once for perf
 
-    while (!currentPointsToVisit.empty())
+    while (!currentPointsToVisit.empty()
+        && mSparksToRender.size() < MaxSparksPerInteraction) // Bound time taken by this interaction
     {
         assert(nextPointsToVisit.empty());
 
@@ -489,9 +536,15 @@ void ShipElectricSparks::PropagateSparks(
 
             for (auto const s : nextSprings)
             {
+                if (mSparksToRender.size() >= MaxSparksPerInteraction)
+                {
+                    // Truncate here
+                    break;
+                }
+
                 ElementIndex const targetEndpointIndex = springs.GetOtherEndpointIndex(s, pv.PointIndex);
-                vec2f const targetEndpointPosition = points.GetPosition(targetEndpointIndex);
-                vec2f const springDirection = (targetEndpointPosition - startingPointPosition).normalise();
+
+                mPathSprings.push_back(s);
 
                 float const startEquivalentPathLength = pv.EquivalentPathLength;
                 float const equivalentStepLength = 1.0f; // TODO: material-based
@@ -504,11 +557,9 @@ void ShipElectricSparks::PropagateSparks(
                 // Render
                 mSparksToRender.emplace_back(
                     startingPointIndex,
-                    startingPointPosition,
                     startSize,
-                    targetEndpointPosition,
+                    targetEndpointIndex,
                     calculateSparkSize(endEquivalentPathLength),
-                    springDirection,
                     pv.IncomingRenderableSparkIndex);
 
                 // Connect this renderable spark to its predecessor, if this is the first one
@@ -524,7 +575,7 @@ void ShipElectricSparks::PropagateSparks(
                     isSpringElectrifiedInThisInteraction[s] = true;
 
                     // Electrify point
-                    mShipPhysicsHandler.HandleElectricSpark(
+                    ElectrifyPoint(
                         targetEndpointIndex,
                         startSize, // strength
                         currentSimulationTime,
@@ -560,6 +611,60 @@ void ShipElectricSparks::PropagateSparks(
     // Swap IsElectrified buffers
     mIsSpringElectrifiedNew.swap(mIsSpringElectrifiedOld);
 
+    // Remember the path, for the next interactions to reuse
+    mIsPathReusable = true;
+    mPathInitialPointIndex = initialPointIndex;
+    mPathCounter = counter;
+    mPathMaxEquivalentPathLength = maxEquivalentPathLengthForThisInteraction;
+    mPathReuseCount = 0;
+
+    // Remember that we have populated electric sparks
+    mAreSparksPopulatedBeforeNextUpdate = true;
+}
+
+bool ShipElectricSparks::CanReusePath(
+    ElementIndex initialPointIndex,
+    std::uint64_t counter,
+    float maxEquivalentPathLengthForThisInteraction,
+    Springs const & springs) const
+{
+    if (!mIsPathReusable
+        || initialPointIndex != mPathInitialPointIndex
+        || counter != mPathCounter + 1 // Not a continuation of the same interaction
+        || maxEquivalentPathLengthForThisInteraction != mPathMaxEquivalentPathLength // Still growing, or length changed
+        || mPathReuseCount >= MaxPathReuseCount) // Time for a new shape
+    {
+        return false;
+    }
+
+    return std::none_of(
+        mPathSprings.cbegin(),
+        mPathSprings.cend(),
+        [&springs](ElementIndex s)
+        {
+            return springs.IsDeleted(s);
+        });
+}
+
+void ShipElectricSparks::ReusePath(
+    std::uint64_t counter,
+    float currentSimulationTime,
+    GameParameters const & gameParameters)
+{
+    // Electrify the same points again; the sparks to render and the
+    // electrified springs stay as they are
+    for (auto const & [pointIndex, strength] : mElectrifiedPoints)
+    {
+        mShipPhysicsHandler.HandleElectricSpark(
+            pointIndex,
+            strength,
+            currentSimulationTime,
+            gameParameters);
+    }
+
+    mPathCounter = counter;
+    ++mPathReuseCount;
+
     // Remember that we have populated electric sparks
     mAreSparksPopulatedBeforeNextUpdate = true;
 }
@@ -11,6 +11,8 @@
 #include <GameCore/BufferAllocator.h>
 #include <GameCore/Vectors.h>
 
+#include <optional>
+#include <utility>
 #include <vector>
 
 namespace Physics
@@ -36,6 +38,16 @@ public:
 
     void Update();
 
+    /*
+     * Makes the electrification state follow a renumbering of the springs.
+     */
+    void RemapSpringIndices(std::vector<ElementIndex> const & newToOldSpringIndices);
+
+    /*
+     * Forgets all sparks, e.g. after the state of the ship has been restored.
+     */
+    void Reset();
+
     void Upload(
         Points const & points,
         ShipId shipId,
@@ -46,14 +58,48 @@ private:
     void PropagateSparks(
         ElementIndex initialPointIndex,
         std::uint64_t counter,
-        float lengthMultiplier,
+        float maxEquivalentPathLengthForThisInteraction,
         float currentSimulationTime,
         Points const & points,
         Springs const & springs,
         GameParameters const & gameParameters);
 
+    bool CanReusePath(
+        ElementIndex initialPointIndex,
+        std::uint64_t counter,
+        float maxEquivalentPathLengthForThisInteraction,
+        Springs const & springs) const;
+
+    void ReusePath(
+        std::uint64_t counter,
+        float currentSimulationTime,
+        GameParameters const & gameParameters);
+
+    void ElectrifyPoint(
+        ElementIndex pointIndex,
+        float strength,
+        float currentSimulationTime,
+        GameParameters const & gameParameters)
+    {
+        mShipPhysicsHandler.HandleElectricSpark(
+            pointIndex,
+            strength,
+            currentSimulationTime,
+            gameParameters);
+
+        mElectrifiedPoints.emplace_back(pointIndex, strength);
+    }
+
 private:
 
+    // The maximum number of spark segments generated by an interaction, bounding
+    // the time taken by an interaction regardless of how branchy the structure is
+    static size_t constexpr MaxSparksPerInteraction = 2048;
+
+    // The number of consecutive interactions that may reuse the path generated by
+    // a preceding interaction, rather than generating a new one
+    static size_t constexpr MaxPathReuseCount = 3;
+
     // The handler to invoke for acting on the ship
     IShipPhysicsHandler & mShipPhysicsHandler;
 
@@ -69,18 +115,31 @@ private:
     // Flag remembering whether electric sparks have been populated prior to the next Update() step
     bool mAreSparksPopulatedBeforeNextUpdate;
 
+    //
+    // The path of the last interaction, which the next interaction may reuse as long
+    // as it starts at the same point, is as long, and none of its springs is gone
+    //
+
+    bool mIsPathReusable;
+    ElementIndex mPathInitialPointIndex;
+    std::uint64_t mPathCounter;
+    float mPathMaxEquivalentPathLength;
+    size_t mPathReuseCount;
+    std::vector<ElementIndex> mPathSprings;
+    std::vector<std::pair<ElementIndex, float>> mElectrifiedPoints; // Point, strength; in order of electrification
+
     //
     // Rendering
     //
 
+    // Positions and directions are taken at upload time, so that a path
+    // may be reused while the ship moves
     struct RenderableElectricSpark
     {
         ElementIndex StartPointIndex;
-        vec2f StartPointPosition;
         float StartSize;
-        vec2f EndPointPosition;
+        ElementIndex EndPointIndex;
         float EndSize;
-        vec2f Direction;
 
         // Index of the spark that preceded this one, or None if this the first spark
         std::optional<size_t> PreviousSparkIndex;
@@ -90,18 +149,14 @@ private:
 
         RenderableElectricSpark(
             ElementIndex startPointIndex,
-            vec2f startPointPosition,
             float startSize,
-            vec2f endPointPosition,
+            ElementIndex endPointIndex,
             float endSize,
-            vec2f direction,
             std::optional<size_t> previousSparkIndex)
             : StartPointIndex(startPointIndex)
-            , StartPointPosition(startPointPosition)
             , StartSize(startSize)
-            , EndPointPosition(endPointPosition)
+            , EndPointIndex(endPointIndex)
             , EndSize(endSize)
-            , Direction(direction)
             , PreviousSparkIndex(previousSparkIndex)
             , NextSparkIndex(std::nullopt) // Expected to be populated later
         {}
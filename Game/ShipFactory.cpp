@@ -17,6 +17,7 @@
 #include <algorithm>
 #include <cassert>
 #include <chrono>
+#include <exception>
 #include <set>
 #include <sstream>
 #include <unordered_map>
@@ -41,6 +42,60 @@ static int const TessellationCircularOrderDirections[8][2] = {
 
 //////////////////////////////////////////////////////////////////////////////
 
+namespace /* anonymous */ {
+
+    template<typename TAction>
+    std::chrono::microseconds MeasureStep(TAction && action)
+    {
+        auto const startTime = std::chrono::steady_clock::now();
+
+        action();
+
+        return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - startTime);
+    }
+
+    /*
+     * Runs independent steps of the ship creation in parallel, rethrowing
+     * the first error encountered by any of them - as the pool swallows them.
+     */
+    void RunStepsInParallel(
+        std::vector<TaskThreadPool::Task> const & steps,
+        TaskThreadPool & taskThreadPool)
+    {
+        std::vector<std::exception_ptr> stepErrors(steps.size());
+
+        std::vector<TaskThreadPool::Task> tasks;
+        tasks.reserve(steps.size());
+        for (size_t s = 0; s < steps.size(); ++s)
+        {
+            tasks.emplace_back(
+                [&steps, &stepErrors, s]()
+                {
+                    try
+                    {
+                        steps[s]();
+                    }
+                    catch (...)
+                    {
+                        stepErrors[s] = std::current_exception();
+                    }
+                });
+        }
+
+        taskThreadPool.Run(tasks);
+
+        for (auto const & stepError : stepErrors)
+        {
+            if (stepError)
+            {
+                std::rethrow_exception(stepError);
+            }
+        }
+    }
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
 std::tuple<std::unique_ptr<Physics::Ship>, RgbaImageData> ShipFactory::Create(
     ShipId shipId,
     World & parentWorld,
@@ -51,10 +106,16 @@ std::tuple<std::unique_ptr<Physics::Ship>, RgbaImageData> ShipFactory::Create(
     ShipStrengthRandomizer const & shipStrengthRandomizer,
     std::shared_ptr<GameEventDispatcher> gameEventDispatcher,
     std::shared_ptr<TaskThreadPool> taskThreadPool,
-    GameParameters const & gameParameters)
+    GameParameters const & gameParameters,
+    ShipFactoryCache const * shipFactoryCache,
+    TaskThreadPool * factoryTaskThreadPool)
 {
     auto const totalStartTime = std::chrono::steady_clock::now();
 
+    TaskThreadPool & buildTaskThreadPool = (factoryTaskThreadPool != nullptr)
+        ? *factoryTaskThreadPool
+        : *taskThreadPool;
+
     //
     // Process load options
     //
@@ -278,23 +339,132 @@ std::tuple<std::unique_ptr<Physics::Ship>, RgbaImageData> ShipFactory::Create(
         pointInfos1,
         triangleInfos);
 
+    auto const elementInfosEndTime = std::chrono::steady_clock::now();
+
     //
-    // Optimize order of ShipFactoryPoint's and ShipFactorySpring's to minimize cache misses
+    // Check whether we may reuse the outputs of a previous creation of this very same ship
     //
 
-    float originalSpringACMR = CalculateACMR(springInfos1);
+    std::optional<ShipAutoTexturizationSettings> const autoTexturizationSettings = shipDefinition.Layers.TextureLayer
+        ? std::nullopt
+        : std::optional<ShipAutoTexturizationSettings>(shipTexturizer.GetActualSettings(shipDefinition.AutoTexturizationSettings));
 
-    // Tiling algorithm
-    //auto [pointInfos2, pointIndexRemap2, springInfos2, springIndexRemap2] = ReorderPointsAndSpringsOptimally_Tiling<2>(
-    auto [pointInfos2, pointIndexRemap2, springInfos2, springIndexRemap2] = ReorderPointsAndSpringsOptimally_Stripes<4>(
-        pointInfos1,
-        springInfos1,
-        pointPairToSpringIndex1Map,
-        pointIndexMatrix);
+    std::optional<ShipFactoryCache::Key> cacheKey;
+    std::optional<ShipFactoryCache::Entry> cachedEntry;
 
-    float optimizedSpringACMR = CalculateACMR(springInfos2);
+    if (shipFactoryCache != nullptr)
+    {
+        cacheKey = ShipFactoryCache::CalculateKey(
+            shipDefinition.Layers.StructuralLayer,
+            shipDefinition.Layers.RopesLayer.get(),
+            autoTexturizationSettings);
 
-    LogMessage("ShipFactory: Spring ACMR: original=", originalSpringACMR, ", optimized=", optimizedSpringACMR);
+        cachedEntry = shipFactoryCache->TryLoad(
+            *cacheKey,
+            pointInfos1.size(),
+            springInfos1.size());
+
+        if (cachedEntry.has_value()
+            && cachedEntry->AutoTexture.has_value() != autoTexturizationSettings.has_value())
+        {
+            cachedEntry.reset();
+        }
+    }
+
+    //
+    // From now on, independent steps run in parallel:
+    //  - Optimize order of ShipFactoryPoint's and ShipFactorySpring's to minimize cache misses
+    //  - Calculate ACMR of the original springs, for logging
+    //  - Create texture, if needed - it only depends on the layers
+    //
+
+    float originalSpringACMR = 0.0f;
+    float optimizedSpringACMR = 0.0f;
+    ReorderingResults reorderingResults;
+    std::optional<RgbaImageData> textureImage;
+
+    std::chrono::microseconds reorderingDuration{ 0 };
+    std::chrono::microseconds textureDuration{ 0 };
+
+    if (shipDefinition.Layers.TextureLayer)
+    {
+        // Use provided texture
+        textureImage.emplace(std::move(shipDefinition.Layers.TextureLayer->Buffer));
+    }
+
+    if (cachedEntry.has_value())
+    {
+        reorderingDuration = MeasureStep(
+            [&]()
+            {
+                reorderingResults = ApplyReordering(
+                    pointInfos1,
+                    springInfos1,
+                    std::move(cachedEntry->PointIndexRemap),
+                    std::move(cachedEntry->SpringIndexRemap));
+            });
+
+        if (cachedEntry->AutoTexture.has_value())
+        {
+            textureImage.emplace(std::move(*(cachedEntry->AutoTexture)));
+        }
+    }
+    else
+    {
+        std::vector<TaskThreadPool::Task> steps;
+
+        steps.emplace_back(
+            [&]()
+            {
+                reorderingDuration = MeasureStep(
+                    [&]()
+                    {
+                        // Tiling algorithm
+                        //reorderingResults = ReorderPointsAndSpringsOptimally_Tiling<2>(
+                        reorderingResults = ReorderPointsAndSpringsOptimally_Stripes<4>(
+                            pointInfos1,
+                            springInfos1,
+                            pointPairToSpringIndex1Map,
+                            pointIndexMatrix);
+
+                        optimizedSpringACMR = CalculateACMR(std::get<2>(reorderingResults));
+                    });
+            });
+
+        steps.emplace_back(
+            [&]()
+            {
+                originalSpringACMR = CalculateACMR(springInfos1);
+            });
+
+        if (!textureImage)
+        {
+            steps.emplace_back(
+                [&]()
+                {
+                    textureDuration = MeasureStep(
+                        [&]()
+                        {
+                            // Auto-texturize
+                            textureImage.emplace(
+                                shipTexturizer.MakeAutoTexture(
+                                    shipDefinition.Layers.StructuralLayer,
+                                    shipDefinition.AutoTexturizationSettings));
+                        });
+                });
+        }
+
+        RunStepsInParallel(steps, buildTaskThreadPool);
+
+        LogMessage("ShipFactory: Spring ACMR: original=", originalSpringACMR, ", optimized=", optimizedSpringACMR);
+    }
+
+    assert(textureImage.has_value());
+
+    auto & pointInfos2 = std::get<0>(reorderingResults);
+    auto const & pointIndexRemap2 = std::get<1>(reorderingResults);
+    auto & springInfos2 = std::get<2>(reorderingResults);
+    auto const & springIndexRemap2 = std::get<3>(reorderingResults);
 
     //
     // Optimize order of Triangles
@@ -315,6 +485,8 @@ std::tuple<std::unique_ptr<Physics::Ship>, RgbaImageData> ShipFactory::Create(
     ////LogMessage("ShipFactory: Triangles ACMR: original=", originalACMR, ", optimized=", optimizedACMR);
     ////LogMessage("ShipFactory: Triangles VMR: original=", originalVMR, ", optimized=", optimizedVMR);
 
+    auto const reorderingEndTime = std::chrono::steady_clock::now();
+
     //
     // Associate all springs with the triangles that run through them (supertriangles)
     //
@@ -329,16 +501,35 @@ std::tuple<std::unique_ptr<Physics::Ship>, RgbaImageData> ShipFactory::Create(
 
     auto const frontiersStartTime = std::chrono::steady_clock::now();
 
-    std::vector<ShipFactoryFrontier> shipFactoryFrontiers = CreateShipFrontiers(
-        pointIndexMatrix,
-        pointIndexRemap2,
-        pointInfos2,
-        springInfos2,
-        pointPairToSpringIndex1Map,
-        springIndexRemap2);
+    // Note: depends on supertriangles
+    std::vector<ShipFactoryFrontier> shipFactoryFrontiers = cachedEntry.has_value()
+        ? std::move(cachedEntry->Frontiers)
+        : CreateShipFrontiers(
+            pointIndexMatrix,
+            pointIndexRemap2,
+            pointInfos2,
+            springInfos2,
+            pointPairToSpringIndex1Map,
+            springIndexRemap2);
 
     auto const frontiersEndTime = std::chrono::steady_clock::now();
 
+    //
+    // Remember what we've done for the next time
+    //
+
+    if (shipFactoryCache != nullptr && !cachedEntry.has_value())
+    {
+        assert(cacheKey.has_value());
+
+        shipFactoryCache->TryStore(
+            *cacheKey,
+            pointIndexRemap2,
+            springIndexRemap2,
+            shipFactoryFrontiers,
+            autoTexturizationSettings.has_value() ? &(*textureImage) : nullptr);
+    }
+
     //
     // Randomize strength
     //
@@ -379,48 +570,66 @@ std::tuple<std::unique_ptr<Physics::Ship>, RgbaImageData> ShipFactory::Create(
         gameEventDispatcher,
         gameParameters);
 
-    //
-    // Create Triangles for all ShipFactoryTriangle's
-    //
-
-    Triangles triangles = CreateTriangles(
-        triangleInfos,
-        points,
-        pointIndexRemap2);
+    auto const springsEndTime = std::chrono::steady_clock::now();
 
     //
-    // Create Electrical Elements
+    // Now run in parallel - as they touch disjoint state of the points:
+    //  - Create Triangles for all ShipFactoryTriangle's
+    //  - Create Electrical Elements
+    //  - Create frontiers
     //
 
-    ElectricalElements electricalElements = CreateElectricalElements(
-        points,
-        electricalElementInstanceIndices,
-        shipDefinition.Layers.ElectricalLayer
-            ? shipDefinition.Layers.ElectricalLayer->Panel
-            : ElectricalPanelMetadata(),
-        shipId,
-        parentWorld,
-        gameEventDispatcher,
-        gameParameters);
-
-    //
-    // Create frontiers
-    //
+    std::optional<Triangles> triangles;
+    std::optional<ElectricalElements> electricalElements;
+    std::optional<Frontiers> frontiers;
 
-    Frontiers frontiers = CreateFrontiers(
-        shipFactoryFrontiers,
-        points,
-        springs);
+    std::chrono::microseconds trianglesDuration{ 0 };
+    std::chrono::microseconds electricalElementsDuration{ 0 };
 
-    //
-    // Create texture, if needed
-    //
+    RunStepsInParallel(
+        {
+            [&]()
+            {
+                trianglesDuration = MeasureStep(
+                    [&]()
+                    {
+                        triangles.emplace(
+                            CreateTriangles(
+                                triangleInfos,
+                                points,
+                                pointIndexRemap2));
+                    });
+            },
+            [&]()
+            {
+                electricalElementsDuration = MeasureStep(
+                    [&]()
+                    {
+                        electricalElements.emplace(
+                            CreateElectricalElements(
+                                points,
+                                electricalElementInstanceIndices,
+                                shipDefinition.Layers.ElectricalLayer
+                                    ? shipDefinition.Layers.ElectricalLayer->Panel
+                                    : ElectricalPanelMetadata(),
+                                shipId,
+                                parentWorld,
+                                gameEventDispatcher,
+                                gameParameters));
+                    });
+            },
+            [&]()
+            {
+                frontiers.emplace(
+                    CreateFrontiers(
+                        shipFactoryFrontiers,
+                        points,
+                        springs));
+            }
+        },
+        buildTaskThreadPool);
 
-    RgbaImageData textureImage = shipDefinition.Layers.TextureLayer
-        ? std::move(shipDefinition.Layers.TextureLayer->Buffer) // Use provided texture
-        : shipTexturizer.MakeAutoTexture(
-            shipDefinition.Layers.StructuralLayer,
-            shipDefinition.AutoTexturizationSettings); // Auto-texturize
+    auto const elementsEndTime = std::chrono::steady_clock::now();
 
     //
     // We're done!
@@ -430,14 +639,14 @@ std::tuple<std::unique_ptr<Physics::Ship>, RgbaImageData> ShipFactory::Create(
     VerifyShipInvariants(
         points,
         springs,
-        triangles);
+        *triangles);
 #endif
 
     LogMessage("ShipFactory: Created ship: W=", shipSize.width, ", H=", shipSize.height, ", ",
         points.GetRawShipPointCount(), "/", points.GetBufferElementCount(), "buf points, ",
-        springs.GetElementCount(), " springs, ", triangles.GetElementCount(), " triangles, ",
-        electricalElements.GetElementCount(), " electrical elements, ",
-        frontiers.GetElementCount(), " frontiers.");
+        springs.GetElementCount(), " springs, ", triangles->GetElementCount(), " triangles, ",
+        electricalElements->GetElementCount(), " electrical elements, ",
+        frontiers->GetElementCount(), " frontiers.");
 
     auto ship = std::make_unique<Ship>(
         shipId,
@@ -447,17 +656,28 @@ std::tuple<std::unique_ptr<Physics::Ship>, RgbaImageData> ShipFactory::Create(
         std::move(taskThreadPool),
         std::move(points),
         std::move(springs),
-        std::move(triangles),
-        std::move(electricalElements),
-        std::move(frontiers));
+        std::move(*triangles),
+        std::move(*electricalElements),
+        std::move(*frontiers));
 
-    LogMessage("ShipFactory: Create() took ",
-        std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - totalStartTime).count(),
-        " us (frontiers: ", std::chrono::duration_cast<std::chrono::microseconds>(frontiersEndTime - frontiersStartTime).count(), " us)");
+    auto const toUs = [](auto duration)
+    {
+        return std::chrono::duration_cast<std::chrono::microseconds>(duration).count();
+    };
+
+    LogMessage("ShipFactory: Create() took ", toUs(std::chrono::steady_clock::now() - totalStartTime), " us (",
+        "element infos: ", toUs(elementInfosEndTime - totalStartTime), " us, ",
+        "reordering: ", toUs(reorderingDuration), " us, ",
+        "texture: ", toUs(textureDuration), " us, ",
+        "frontiers: ", toUs(frontiersEndTime - frontiersStartTime), " us, ",
+        "points and springs: ", toUs(springsEndTime - reorderingEndTime), " us, ",
+        "triangles: ", toUs(trianglesDuration), " us, ",
+        "electrical elements: ", toUs(electricalElementsDuration), " us, ",
+        "parallel elements: ", toUs(elementsEndTime - springsEndTime), " us)");
 
     return std::make_tuple(
         std::move(ship),
-        std::move(textureImage));
+        std::move(*textureImage));
 }
 
 //////////////////////////////////////////////////////////////////////////////////////////////////
@@ -1622,6 +1842,50 @@ void ShipFactory::VerifyShipInvariants(
 // Reordering
 //////////////////////////////////////////////////////////////////////////////////////////////////
 
+ShipFactory::ReorderingResults ShipFactory::ApplyReordering(
+    std::vector<ShipFactoryPoint> const & pointInfos1,
+    std::vector<ShipFactorySpring> const & springInfos1,
+    std::vector<ElementIndex> && pointIndexRemap,
+    std::vector<ElementIndex> && springIndexRemap)
+{
+    assert(pointIndexRemap.size() == pointInfos1.size());
+    assert(springIndexRemap.size() == springInfos1.size());
+
+    // Invert the remaps, so that we may build the new vectors in order
+
+    std::vector<ElementIndex> pointIndices1(pointInfos1.size(), NoneElementIndex);
+    for (ElementIndex pointIndex1 = 0; pointIndex1 < pointInfos1.size(); ++pointIndex1)
+    {
+        pointIndices1[pointIndexRemap[pointIndex1]] = pointIndex1;
+    }
+
+    std::vector<ShipFactoryPoint> pointInfos2;
+    pointInfos2.reserve(pointInfos1.size());
+    for (ElementIndex const pointIndex1 : pointIndices1)
+    {
+        pointInfos2.push_back(pointInfos1[pointIndex1]);
+    }
+
+    std::vector<ElementIndex> springIndices1(springInfos1.size(), NoneElementIndex);
+    for (ElementIndex springIndex1 = 0; springIndex1 < springInfos1.size(); ++springIndex1)
+    {
+        springIndices1[springIndexRemap[springIndex1]] = springIndex1;
+    }
+
+    std::vector<ShipFactorySpring> springInfos2;
+    springInfos2.reserve(springInfos1.size());
+    for (ElementIndex const springIndex1 : springIndices1)
+    {
+        springInfos2.push_back(springInfos1[springIndex1]);
+    }
+
+    return std::make_tuple(
+        std::move(pointInfos2),
+        std::move(pointIndexRemap),
+        std::move(springInfos2),
+        std::move(springIndexRemap));
+}
+
 template <int StripeLength>
 ShipFactory::ReorderingResults ShipFactory::ReorderPointsAndSpringsOptimally_Stripes(
     std::vector<ShipFactoryPoint> const & pointInfos1,
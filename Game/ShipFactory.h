@@ -9,6 +9,7 @@
 #include "MaterialDatabase.h"
 #include "Physics.h"
 #include "ShipDefinition.h"
+#include "ShipFactoryCache.h"
 #include "ShipFactoryTypes.h"
 #include "ShipLoadOptions.h"
 #include "ShipStrengthRandomizer.h"
@@ -45,7 +46,9 @@ public:
         ShipStrengthRandomizer const & shipStrengthRandomizer,
         std::shared_ptr<GameEventDispatcher> gameEventDispatcher,
         std::shared_ptr<TaskThreadPool> taskThreadPool,
-        GameParameters const & gameParameters);
+        GameParameters const & gameParameters,
+        ShipFactoryCache const * shipFactoryCache = nullptr,
+        TaskThreadPool * factoryTaskThreadPool = nullptr); // To build with, when not the ship's one
 
 private:
 
@@ -229,6 +232,12 @@ private:
     // Reordering
     //
 
+    static ReorderingResults ApplyReordering(
+        std::vector<ShipFactoryPoint> const & pointInfos1,
+        std::vector<ShipFactorySpring> const & springInfos1,
+        std::vector<ElementIndex> && pointIndexRemap,
+        std::vector<ElementIndex> && springIndexRemap);
+
     template <int StripeLength>
     static ReorderingResults ReorderPointsAndSpringsOptimally_Stripes(
         std::vector<ShipFactoryPoint> const & pointInfos1,
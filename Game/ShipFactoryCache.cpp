@@ -0,0 +1,407 @@
+/***************************************************************************************
+* Original Author:      Gabriele Giuseppini
+* Created:              2026-10-14
+* Copyright:            Gabriele Giuseppini  (https://github.com/GabrieleGiuseppini)
+***************************************************************************************/
+#include "ShipFactoryCache.h"
+
+#include <GameCore/GameException.h>
+#include <GameCore/Log.h>
+
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <system_error>
+#include <unordered_map>
+#include <utility>
+
+namespace /* anonymous */ {
+
+    // FNV-1a
+    class Hasher
+    {
+    public:
+
+        template<typename T>
+        void Add(T const & value)
+        {
+            AddBytes(&value, sizeof(T));
+        }
+
+        void Add(std::string const & value)
+        {
+            Add(static_cast<std::uint64_t>(value.size()));
+            AddBytes(value.data(), value.size());
+        }
+
+        void AddBytes(void const * bytes, size_t size)
+        {
+            for (size_t b = 0; b < size; ++b)
+            {
+                mHash ^= static_cast<std::uint64_t>(static_cast<unsigned char const *>(bytes)[b]);
+                mHash *= 1099511628211ull;
+            }
+        }
+
+        std::uint64_t GetHash() const
+        {
+            return mHash;
+        }
+
+    private:
+
+        std::uint64_t mHash{ 14695981039346656037ull };
+    };
+
+    /*
+     * Hashes materials by their properties - rather than by their addresses, which
+     * change across launches - giving each one a small ID the first time it's seen.
+     */
+    class MaterialHasher
+    {
+    public:
+
+        explicit MaterialHasher(Hasher & hasher)
+            : mHasher(hasher)
+            , mMaterialIds()
+        {}
+
+        void Add(StructuralMaterial const * material)
+        {
+            if (material == nullptr)
+            {
+                mHasher.Add(std::uint32_t(0));
+                return;
+            }
+
+            auto const [it, isNew] = mMaterialIds.emplace(material, static_cast<std::uint32_t>(mMaterialIds.size() + 1));
+            mHasher.Add(it->second);
+
+            if (isNew)
+            {
+                mHasher.Add(material->ColorKey);
+                mHasher.Add(material->Name);
+                mHasher.Add(material->RenderColor);
+                mHasher.Add(material->UniqueType.has_value() ? static_cast<std::int64_t>(*material->UniqueType) : std::int64_t(-1));
+                mHasher.Add(material->MaterialTextureName.value_or(std::string()));
+            }
+        }
+
+    private:
+
+        Hasher & mHasher;
+        std::unordered_map<StructuralMaterial const *, std::uint32_t> mMaterialIds;
+    };
+
+#pragma pack(push, 1)
+
+    struct EntryFileHeader
+    {
+        std::uint32_t Version;
+        std::uint64_t Key;
+        std::uint32_t PointCount;
+        std::uint32_t SpringCount;
+        std::uint32_t FrontierCount;
+        std::int32_t AutoTextureWidth; // Zero when there's no texture
+        std::int32_t AutoTextureHeight; // Zero when there's no texture
+    };
+
+#pragma pack(pop)
+
+    template<typename T>
+    void Read(std::istream & is, T * values, size_t count)
+    {
+        is.read(reinterpret_cast<char *>(values), count * sizeof(T));
+        if (!is)
+        {
+            throw GameException("Cache entry is truncated");
+        }
+    }
+
+    template<typename T>
+    void Write(std::ostream & os, T const * values, size_t count)
+    {
+        os.write(reinterpret_cast<char const *>(values), count * sizeof(T));
+    }
+
+    void VerifyPermutation(
+        std::vector<ElementIndex> const & remap,
+        size_t count)
+    {
+        std::vector<bool> isUsed(count, false);
+        for (ElementIndex const i : remap)
+        {
+            if (i >= count || isUsed[i])
+            {
+                throw GameException("Cache entry has an invalid ordering");
+            }
+
+            isUsed[i] = true;
+        }
+    }
+}
+
+ShipFactoryCache::ShipFactoryCache(
+    std::filesystem::path const & cacheFolderPath,
+    size_t maxEntryCount)
+    : mCacheFolderPath(cacheFolderPath)
+    , mMaxEntryCount(maxEntryCount)
+{
+}
+
+ShipFactoryCache::Key ShipFactoryCache::CalculateKey(
+    StructuralLayerData const & structuralLayer,
+    RopesLayerData const * ropesLayer,
+    std::optional<ShipAutoTexturizationSettings> const & autoTexturizationSettings)
+{
+    Hasher hasher;
+    MaterialHasher materialHasher(hasher);
+
+    hasher.Add(CacheVersion);
+
+    //
+    // Structure
+    //
+
+    ShipSpaceSize const & shipSize = structuralLayer.Buffer.Size;
+    hasher.Add(static_cast<std::int32_t>(shipSize.width));
+    hasher.Add(static_cast<std::int32_t>(shipSize.height));
+
+    for (size_t i = 0; i < shipSize.GetLinearSize(); ++i)
+    {
+        materialHasher.Add(structuralLayer.Buffer.Data[i].Material);
+    }
+
+    if (ropesLayer != nullptr)
+    {
+        hasher.Add(static_cast<std::uint64_t>(ropesLayer->Buffer.GetSize()));
+
+        for (auto const & rope : ropesLayer->Buffer)
+        {
+            hasher.Add(static_cast<std::int32_t>(rope.StartCoords.x));
+            hasher.Add(static_cast<std::int32_t>(rope.StartCoords.y));
+            hasher.Add(static_cast<std::int32_t>(rope.EndCoords.x));
+            hasher.Add(static_cast<std::int32_t>(rope.EndCoords.y));
+            materialHasher.Add(rope.Material);
+            hasher.Add(rope.RenderColor);
+        }
+    }
+    else
+    {
+        hasher.Add(std::uint64_t(0));
+    }
+
+    //
+    // Texture
+    //
+
+    if (autoTexturizationSettings.has_value())
+    {
+        hasher.Add(std::uint8_t(1));
+        hasher.Add(static_cast<std::int32_t>(autoTexturizationSettings->Mode));
+        hasher.Add(autoTexturizationSettings->MaterialTextureMagnification);
+        hasher.Add(autoTexturizationSettings->MaterialTextureTransparency);
+    }
+    else
+    {
+        hasher.Add(std::uint8_t(0));
+    }
+
+    return hasher.GetHash();
+}
+
+std::optional<ShipFactoryCache::Entry> ShipFactoryCache::TryLoad(
+    Key key,
+    size_t pointCount,
+    size_t springCount) const
+{
+    std::filesystem::path const entryFilePath = MakeEntryFilePath(key);
+
+    try
+    {
+        if (!std::filesystem::exists(entryFilePath))
+        {
+            LogMessage("ShipFactoryCache: no cached entry");
+            return std::nullopt;
+        }
+
+        std::ifstream entryFile(entryFilePath, std::ios::in | std::ios::binary);
+        if (!entryFile)
+        {
+            throw GameException("Cannot open cache entry");
+        }
+
+        EntryFileHeader header;
+        Read(entryFile, &header, 1);
+
+        if (header.Version != CacheVersion
+            || header.Key != key
+            || header.PointCount != pointCount
+            || header.SpringCount != springCount)
+        {
+            LogMessage("ShipFactoryCache: cached entry is stale");
+            return std::nullopt;
+        }
+
+        Entry entry;
+
+        entry.PointIndexRemap.resize(pointCount);
+        Read(entryFile, entry.PointIndexRemap.data(), pointCount);
+        VerifyPermutation(entry.PointIndexRemap, pointCount);
+
+        entry.SpringIndexRemap.resize(springCount);
+        Read(entryFile, entry.SpringIndexRemap.data(), springCount);
+        VerifyPermutation(entry.SpringIndexRemap, springCount);
+
+        entry.Frontiers.reserve(header.FrontierCount);
+        for (std::uint32_t f = 0; f < header.FrontierCount; ++f)
+        {
+            std::uint32_t frontierHeader[2]; // Type, EdgeCount
+            Read(entryFile, frontierHeader, 2);
+
+            if (frontierHeader[0] != static_cast<std::uint32_t>(FrontierType::External)
+                && frontierHeader[0] != static_cast<std::uint32_t>(FrontierType::Internal))
+            {
+                throw GameException("Cache entry has an invalid frontier");
+            }
+
+            std::vector<ElementIndex> edgeIndices2(frontierHeader[1]);
+            Read(entryFile, edgeIndices2.data(), edgeIndices2.size());
+
+            if (std::any_of(edgeIndices2.cbegin(), edgeIndices2.cend(), [springCount](ElementIndex e) { return e >= springCount; }))
+            {
+                throw GameException("Cache entry has an invalid frontier");
+            }
+
+            entry.Frontiers.emplace_back(
+                static_cast<FrontierType>(frontierHeader[0]),
+                std::move(edgeIndices2));
+        }
+
+        if (header.AutoTextureWidth > 0 && header.AutoTextureHeight > 0)
+        {
+            entry.AutoTexture.emplace(ImageSize(header.AutoTextureWidth, header.AutoTextureHeight));
+            Read(entryFile, entry.AutoTexture->Data.get(), entry.AutoTexture->Size.GetLinearSize());
+        }
+
+        entryFile.close();
+
+        // Keep it among the most recently used ones
+        std::filesystem::last_write_time(entryFilePath, std::filesystem::file_time_type::clock::now());
+
+        LogMessage("ShipFactoryCache: loaded cached entry");
+
+        return entry;
+    }
+    catch (std::exception const & ex)
+    {
+        LogMessage("ShipFactoryCache: error loading cached entry: ", ex.what());
+        return std::nullopt;
+    }
+}
+
+void ShipFactoryCache::TryStore(
+    Key key,
+    std::vector<ElementIndex> const & pointIndexRemap,
+    std::vector<ElementIndex> const & springIndexRemap,
+    std::vector<ShipFactoryFrontier> const & frontiers,
+    RgbaImageData const * autoTexture) const
+{
+    std::filesystem::path const entryFilePath = MakeEntryFilePath(key);
+
+    try
+    {
+        std::filesystem::create_directories(mCacheFolderPath);
+
+        {
+            std::ofstream entryFile(entryFilePath, std::ios::out | std::ios::binary | std::ios::trunc);
+            if (!entryFile)
+            {
+                throw GameException("Cannot create cache entry");
+            }
+
+            EntryFileHeader header;
+            header.Version = CacheVersion;
+            header.Key = key;
+            header.PointCount = static_cast<std::uint32_t>(pointIndexRemap.size());
+            header.SpringCount = static_cast<std::uint32_t>(springIndexRemap.size());
+            header.FrontierCount = static_cast<std::uint32_t>(frontiers.size());
+            header.AutoTextureWidth = (autoTexture != nullptr) ? autoTexture->Size.width : 0;
+            header.AutoTextureHeight = (autoTexture != nullptr) ? autoTexture->Size.height : 0;
+            Write(entryFile, &header, 1);
+
+            Write(entryFile, pointIndexRemap.data(), pointIndexRemap.size());
+            Write(entryFile, springIndexRemap.data(), springIndexRemap.size());
+
+            for (auto const & frontier : frontiers)
+            {
+                std::uint32_t const frontierHeader[2] = {
+                    static_cast<std::uint32_t>(frontier.Type),
+                    static_cast<std::uint32_t>(frontier.EdgeIndices2.size()) };
+                Write(entryFile, frontierHeader, 2);
+                Write(entryFile, frontier.EdgeIndices2.data(), frontier.EdgeIndices2.size());
+            }
+
+            if (autoTexture != nullptr)
+            {
+                Write(entryFile, autoTexture->Data.get(), autoTexture->Size.GetLinearSize());
+            }
+
+            if (!entryFile)
+            {
+                throw GameException("Cannot write cache entry");
+            }
+        }
+
+        LogMessage("ShipFactoryCache: stored entry");
+
+        EvictOldestEntries();
+    }
+    catch (std::exception const & ex)
+    {
+        LogMessage("ShipFactoryCache: error storing entry: ", ex.what());
+
+        // Don't leave a half-baked entry around
+        std::error_code ec;
+        std::filesystem::remove(entryFilePath, ec);
+    }
+}
+
+std::filesystem::path ShipFactoryCache::MakeEntryFilePath(Key key) const
+{
+    std::ostringstream ss;
+    ss << std::hex << std::setfill('0') << std::setw(16) << key << ".shipcache";
+    return mCacheFolderPath / ss.str();
+}
+
+void ShipFactoryCache::EvictOldestEntries() const
+{
+    std::vector<std::pair<std::filesystem::file_time_type, std::filesystem::path>> entryFiles;
+
+    for (auto const & directoryEntry : std::filesystem::directory_iterator(mCacheFolderPath))
+    {
+        if (directoryEntry.is_regular_file() && directoryEntry.path().extension() == ".shipcache")
+        {
+            entryFiles.emplace_back(directoryEntry.last_write_time(), directoryEntry.path());
+        }
+    }
+
+    if (entryFiles.size() <= mMaxEntryCount)
+        return;
+
+    // Oldest first
+    std::sort(
+        entryFiles.begin(),
+        entryFiles.end(),
+        [](auto const & lhs, auto const & rhs)
+        {
+            return lhs.first < rhs.first;
+        });
+
+    for (size_t i = 0; i < entryFiles.size() - mMaxEntryCount; ++i)
+    {
+        std::error_code ec;
+        std::filesystem::remove(entryFiles[i].second, ec);
+    }
+}
@@ -0,0 +1,93 @@
+/***************************************************************************************
+* Original Author:      Gabriele Giuseppini
+* Created:              2026-10-14
+* Copyright:            Gabriele Giuseppini  (https://github.com/GabrieleGiuseppini)
+***************************************************************************************/
+#pragma once
+
+#include "Layers.h"
+#include "ShipAutoTexturizationSettings.h"
+#include "ShipFactoryTypes.h"
+
+#include <GameCore/GameTypes.h>
+#include <GameCore/ImageData.h>
+
+#include <cstdint>
+#include <filesystem>
+#include <optional>
+#include <string>
+#include <vector>
+
+/*
+ * An on-disk cache of the costliest - and deterministic - outputs of the ship factory,
+ * so that re-loading the same ship over and over doesn't have to redo them each time.
+ *
+ * An entry holds the optimal order of the ship's points and springs, its frontiers,
+ * and its auto-generated texture - if any, all as flat arrays; it's keyed by the
+ * content of the (flipped/rotated) layers that make up the ship's structure, by the
+ * properties of the materials used in them, and by the auto-texturization settings
+ * in use. Entries whose key doesn't match are simply rebuilt and stored again.
+ *
+ * Failures in accessing the cache are never fatal.
+ */
+class ShipFactoryCache final
+{
+public:
+
+    using Key = std::uint64_t;
+
+    struct Entry
+    {
+        std::vector<ElementIndex> PointIndexRemap;
+        std::vector<ElementIndex> SpringIndexRemap;
+        std::vector<ShipFactoryFrontier> Frontiers;
+        std::optional<RgbaImageData> AutoTexture;
+    };
+
+    static size_t constexpr DefaultMaxEntryCount = 16;
+
+public:
+
+    explicit ShipFactoryCache(
+        std::filesystem::path const & cacheFolderPath,
+        size_t maxEntryCount = DefaultMaxEntryCount);
+
+    /*
+     * The auto-texturization settings are those the texture is made with, or none when
+     * the ship comes with its own texture.
+     */
+    static Key CalculateKey(
+        StructuralLayerData const & structuralLayer,
+        RopesLayerData const * ropesLayer,
+        std::optional<ShipAutoTexturizationSettings> const & autoTexturizationSettings);
+
+    /*
+     * Returns the entry for the specified key, as long as it's there and it fits a ship
+     * with the specified number of points and springs.
+     */
+    std::optional<Entry> TryLoad(
+        Key key,
+        size_t pointCount,
+        size_t springCount) const;
+
+    void TryStore(
+        Key key,
+        std::vector<ElementIndex> const & pointIndexRemap,
+        std::vector<ElementIndex> const & springIndexRemap,
+        std::vector<ShipFactoryFrontier> const & frontiers,
+        RgbaImageData const * autoTexture) const;
+
+private:
+
+    // Bump whenever the layout of the entries - or the factory's algorithms - change
+    static std::uint32_t constexpr CacheVersion = 1;
+
+    std::filesystem::path MakeEntryFilePath(Key key) const;
+
+    void EvictOldestEntries() const;
+
+private:
+
+    std::filesystem::path const mCacheFolderPath;
+    size_t const mMaxEntryCount;
+};
@@ -8,9 +8,12 @@
 
 #include <GameCore/GameException.h>
 #include <GameCore/ImageTools.h>
+#include <GameCore/TaskThreadPool.h>
 #include <GameCore/Utils.h>
 
+#include <algorithm>
 #include <memory>
+#include <mutex>
 
 ShipDefinition ShipLegacyFormatDeSerializer::LoadShipFromImageDefinition(
     std::filesystem::path const & shipFilePath,
@@ -408,87 +411,141 @@ ShipDefinition ShipLegacyFormatDeSerializer::LoadFromDefinitionImages(
 
     ropeFirstEndpointCoordsByColorKey.clear();
 
-    // Visit all columns
-    for (int x = 0; x < shipSize.width; ++x)
+    //
+    // 1a. Lookup materials, one band of rows at a time - in parallel for large ships; this is
+    //     where the bulk of the time goes, and it only writes to the band's own elements
+    //
+
+    std::vector<ShipSpaceCoordinates> legacyRopeEndpointCoords;
+    std::mutex resultsMutex;
+
+    auto const lookupRows = [&](size_t yStart, size_t yEnd)
     {
-        // From bottom to top
-        for (int y = 0; y < shipSize.height; ++y)
-        {
-            ImageCoordinates const imageCoords(x, y);
+        std::vector<ShipSpaceCoordinates> bandLegacyRopeEndpointCoords;
+        bool bandHasStructuralElements = false;
+        bool bandHasElectricalElements = false;
 
-            // Lookup structural material
-            MaterialColorKey const colorKey = structuralLayerImage[imageCoords];
-            StructuralMaterial const * structuralMaterial = materialDatabase.FindStructuralMaterial(colorKey);
-            if (nullptr != structuralMaterial)
+        for (int y = static_cast<int>(yStart); y < static_cast<int>(yEnd); ++y)
+        {
+            for (int x = 0; x < shipSize.width; ++x)
             {
-                ShipSpaceCoordinates const coords = ShipSpaceCoordinates(x, y);
+                // Lookup structural material
+                MaterialColorKey const colorKey = structuralLayerImage[ImageCoordinates(x, y)];
+                StructuralMaterial const * structuralMaterial = materialDatabase.FindStructuralMaterial(colorKey);
+                if (nullptr != structuralMaterial)
+                {
+                    ShipSpaceCoordinates const coords = ShipSpaceCoordinates(x, y);
 
-                // Store structural element
-                structuralLayer.Buffer[coords] = StructuralElement(structuralMaterial);
+                    // Store structural element
+                    structuralLayer.Buffer[coords] = StructuralElement(structuralMaterial);
 
-                //
-                // Check if it's also a legacy electrical element
-                //
+                    //
+                    // Check if it's also a legacy electrical element
+                    //
 
-                ElectricalMaterial const * const electricalMaterial = materialDatabase.FindElectricalMaterial(colorKey);
-                if (nullptr != electricalMaterial)
-                {
-                    // Cannot have instanced elements in legacy mode
-                    assert(!electricalMaterial->IsInstanced);
+                    ElectricalMaterial const * const electricalMaterial = materialDatabase.FindElectricalMaterial(colorKey);
+                    if (nullptr != electricalMaterial)
+                    {
+                        // Cannot have instanced elements in legacy mode
+                        assert(!electricalMaterial->IsInstanced);
 
-                    // Store electrical element
-                    electricalLayer.Buffer[coords] = ElectricalElement(
-                        electricalMaterial,
-                        NoneElectricalElementInstanceIndex);
+                        // Store electrical element
+                        electricalLayer.Buffer[coords] = ElectricalElement(
+                            electricalMaterial,
+                            NoneElectricalElementInstanceIndex);
 
-                    // Remember we have seen at least one electrical element
-                    hasElectricalElements = true;
-                }
+                        // Remember we have seen at least one electrical element
+                        bandHasElectricalElements = true;
+                    }
 
-                //
-                // Check if it's a legacy rope endpoint
-                //
+                    //
+                    // Check if it's a legacy rope endpoint
+                    //
 
-                if (structuralMaterial->IsUniqueType(StructuralMaterial::MaterialUniqueType::Rope)
-                    && !materialDatabase.IsUniqueStructuralMaterialColorKey(StructuralMaterial::MaterialUniqueType::Rope, colorKey))
-                {
-                    // Check if it's the first or the second endpoint for the rope
-                    auto searchIt = ropeFirstEndpointCoordsByColorKey.find(colorKey);
-                    if (searchIt == ropeFirstEndpointCoordsByColorKey.end())
+                    if (structuralMaterial->IsUniqueType(StructuralMaterial::MaterialUniqueType::Rope)
+                        && !materialDatabase.IsUniqueStructuralMaterialColorKey(StructuralMaterial::MaterialUniqueType::Rope, colorKey))
                     {
-                        // First time we see the rope color key
-                        ropeFirstEndpointCoordsByColorKey[colorKey] = coords;
+                        // Pair it up later
+                        bandLegacyRopeEndpointCoords.push_back(coords);
                     }
-                    else if (searchIt->second.has_value())
-                    {
-                        // Second time we see the rope color key
 
-                        // Store rope element
-                        rgbaColor const ropeColor = rgbaColor(colorKey, 255);
-                        ropesLayer.Buffer.EmplaceBack(
-                            *(searchIt->second),
-                            coords,
-                            structuralMaterial,
-                            ropeColor);
+                    // Remember we have seen at least one structural element
+                    bandHasStructuralElements = true;
+                }
+            }
+        }
 
-                        // Remember we have seen at least one rope element
-                        hasRopeElements = true;
+        std::lock_guard const lock(resultsMutex);
 
-                        // Mark as "complete"
-                        searchIt->second.reset();
-                    }
-                    else
-                    {
-                        // Too many rope endpoints for this color key
-                        throw GameException(
-                            "More than two rope endpoints for rope color \"" + colorKey.toString() + "\", detected at "
-                            + imageCoords.FlipY(shipSize.height).ToString());
-                    }
-                }
+        legacyRopeEndpointCoords.insert(legacyRopeEndpointCoords.end(), bandLegacyRopeEndpointCoords.cbegin(), bandLegacyRopeEndpointCoords.cend());
+        hasStructuralElements |= bandHasStructuralElements;
+        hasElectricalElements |= bandHasElectricalElements;
+    };
 
-                // Remember we have seen at least one structural element
-                hasStructuralElements = true;
-            }
+    if (shipSize.GetLinearSize() >= ParallelLookupMinPixels)
+    {
+        TaskThreadPool lookupTaskThreadPool;
+        lookupTaskThreadPool.ParallelFor(
+            0,
+            static_cast<size_t>(shipSize.height),
+            ParallelLookupRowsPerChunk,
+            lookupRows);
+    }
+    else
+    {
+        lookupRows(0, static_cast<size_t>(shipSize.height));
+    }
+
+    //
+    // 1b. Pair up legacy rope endpoints, visiting them in column order - bottom to top -
+    //     so that which endpoint comes first does not depend on how we've visited them
+    //
+
+    std::sort(
+        legacyRopeEndpointCoords.begin(),
+        legacyRopeEndpointCoords.end(),
+        [](ShipSpaceCoordinates const & lhs, ShipSpaceCoordinates const & rhs)
+        {
+            return lhs.x < rhs.x
+                || (lhs.x == rhs.x && lhs.y < rhs.y);
+        });
+
+    for (ShipSpaceCoordinates const & coords : legacyRopeEndpointCoords)
+    {
+        ImageCoordinates const imageCoords(coords.x, coords.y);
+        MaterialColorKey const colorKey = structuralLayerImage[imageCoords];
+
+        // Check if it's the first or the second endpoint for the rope
+        auto searchIt = ropeFirstEndpointCoordsByColorKey.find(colorKey);
+        if (searchIt == ropeFirstEndpointCoordsByColorKey.end())
+        {
+            // First time we see the rope color key
+            ropeFirstEndpointCoordsByColorKey[colorKey] = coords;
+        }
+        else if (searchIt->second.has_value())
+        {
+            // Second time we see the rope color key
+
+            // Store rope element
+            rgbaColor const ropeColor = rgbaColor(colorKey, 255);
+            ropesLayer.Buffer.EmplaceBack(
+                *(searchIt->second),
+                coords,
+                structuralLayer.Buffer[coords].Material,
+                ropeColor);
+
+            // Remember we have seen at least one rope element
+            hasRopeElements = true;
+
+            // Mark as "complete"
+            searchIt->second.reset();
+        }
+        else
+        {
+            // Too many rope endpoints for this color key
+            throw GameException(
+                "More than two rope endpoints for rope color \"" + colorKey.toString() + "\", detected at "
+                + imageCoords.FlipY(shipSize.height).ToString());
         }
     }
 
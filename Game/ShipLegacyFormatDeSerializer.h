@@ -40,6 +40,10 @@ public:
 
 private:
 
+    // Below this many pixels, spinning up threads for the material lookup costs more than it saves
+    static size_t constexpr ParallelLookupMinPixels = 256 * 256;
+    static size_t constexpr ParallelLookupRowsPerChunk = 16;
+
     struct JsonDefinition
     {
         std::filesystem::path StructuralLayerImageFilePath;
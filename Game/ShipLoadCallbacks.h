@@ -0,0 +1,34 @@
+/***************************************************************************************
+* Original Author:      Gabriele Giuseppini
+* Created:              2026-10-14
+* Copyright:            Gabriele Giuseppini  (https://github.com/GabrieleGiuseppini)
+***************************************************************************************/
+#pragma once
+
+#include "ShipMetadata.h"
+
+#include <GameCore/ProgressCallback.h>
+
+#include <exception>
+#include <functional>
+
+/*
+ * The callbacks via which an asynchronous ship load reports back.
+ *
+ * All of them are invoked on the thread running the game iterations, and none of them
+ * is invoked anymore once the load has been cancelled.
+ */
+struct ShipLoadCallbacks
+{
+    // Progress of the load, from 0.0 to 1.0
+    ProgressCallback OnProgress;
+
+    // The ship is ready and is about to replace the current world
+    std::function<void()> OnBeforeShipSwap;
+
+    // The ship has replaced the current world
+    std::function<void(ShipMetadata const & shipMetadata)> OnShipLoaded;
+
+    // The load has failed, and the current world is still in place
+    std::function<void(std::exception_ptr error)> OnShipLoadFailed;
+};
@@ -8,15 +8,24 @@
 #include "ShipLoadOptions.h"
 
 #include <filesystem>
+#include <memory>
+
+struct ShipDefinition;
 
 struct ShipLoadSpecifications
 {
 	std::filesystem::path DefinitionFilepath;
 	ShipLoadOptions LoadOptions;
 
+	// When set, the definition loaded from DefinitionFilepath - e.g. as handed
+	// over by the ship builder - so that the file needs not be loaded again;
+	// not persisted
+	std::shared_ptr<ShipDefinition const> Definition;
+
 	explicit ShipLoadSpecifications(std::filesystem::path const & definitionFilepath)
 		: DefinitionFilepath(definitionFilepath)
 		, LoadOptions()
+		, Definition()
 	{}
 
 	ShipLoadSpecifications(
@@ -24,6 +33,15 @@ struct ShipLoadSpecifications
 		ShipLoadOptions const & options)
 		: DefinitionFilepath(definitionFilepath)
 		, LoadOptions(options)
+		, Definition()
+	{}
+
+	ShipLoadSpecifications(
+		std::filesystem::path const & definitionFilepath,
+		std::shared_ptr<ShipDefinition const> definition)
+		: DefinitionFilepath(definitionFilepath)
+		, LoadOptions()
+		, Definition(std::move(definition))
 	{}
 
 	static ShipLoadSpecifications FromJson(picojson::object const & specsRoot)
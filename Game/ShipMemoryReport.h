@@ -0,0 +1,86 @@
+/***************************************************************************************
+* Original Author:      Gabriele Giuseppini
+* Created:              2026-10-14
+* Copyright:            Gabriele Giuseppini  (https://github.com/GabrieleGiuseppini)
+***************************************************************************************/
+#pragma once
+
+#include <GameCore/GameTypes.h>
+
+#include <iomanip>
+#include <sstream>
+#include <string>
+
+/*
+ * The memory occupied by the element buffers of a ship.
+ */
+struct ShipMemoryReport
+{
+    ShipId Ship;
+
+    ElementCount PointCount;
+    size_t PointsByteSize;
+
+    ElementCount SpringCount;
+    size_t SpringsByteSize;
+
+    ElementCount TriangleCount;
+    size_t TrianglesByteSize;
+
+    ElementCount ElectricalElementCount;
+    size_t ElectricalElementsByteSize;
+
+    ShipMemoryReport(
+        ShipId ship,
+        ElementCount pointCount,
+        size_t pointsByteSize,
+        ElementCount springCount,
+        size_t springsByteSize,
+        ElementCount triangleCount,
+        size_t trianglesByteSize,
+        ElementCount electricalElementCount,
+        size_t electricalElementsByteSize)
+        : Ship(ship)
+        , PointCount(pointCount)
+        , PointsByteSize(pointsByteSize)
+        , SpringCount(springCount)
+        , SpringsByteSize(springsByteSize)
+        , TriangleCount(triangleCount)
+        , TrianglesByteSize(trianglesByteSize)
+        , ElectricalElementCount(electricalElementCount)
+        , ElectricalElementsByteSize(electricalElementsByteSize)
+    {}
+
+    size_t GetTotalByteSize() const
+    {
+        return PointsByteSize + SpringsByteSize + TrianglesByteSize + ElectricalElementsByteSize;
+    }
+
+    std::string ToString() const
+    {
+        std::stringstream ss;
+
+        ss << std::fixed << std::setprecision(1)
+            << "Ship " << static_cast<int>(Ship) << ": " << ToKB(GetTotalByteSize()) << " KB"
+            << " - points: " << PointCount << " (" << ToKB(PointsByteSize) << " KB, " << PerElement(PointsByteSize, PointCount) << " B each)"
+            << ", springs: " << SpringCount << " (" << ToKB(SpringsByteSize) << " KB, " << PerElement(SpringsByteSize, SpringCount) << " B each)"
+            << ", triangles: " << TriangleCount << " (" << ToKB(TrianglesByteSize) << " KB, " << PerElement(TrianglesByteSize, TriangleCount) << " B each)"
+            << ", electricals: " << ElectricalElementCount << " (" << ToKB(ElectricalElementsByteSize) << " KB)";
+
+        return ss.str();
+    }
+
+private:
+
+    static float ToKB(size_t byteSize)
+    {
+        return static_cast<float>(byteSize) / 1024.0f;
+    }
+
+    static float PerElement(
+        size_t byteSize,
+        ElementCount elementCount)
+    {
+        return elementCount > 0 ? static_cast<float>(byteSize) / static_cast<float>(elementCount) : 0.0f;
+    }
+};
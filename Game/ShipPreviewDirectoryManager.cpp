@@ -14,21 +14,26 @@
 
 static std::filesystem::path const DatabaseFileName = ".floatingsandbox_shipdb";
 
-std::unique_ptr<ShipPreviewDirectoryManager> ShipPreviewDirectoryManager::Create(std::filesystem::path const & directoryPath)
+std::unique_ptr<ShipPreviewDirectoryManager> ShipPreviewDirectoryManager::Create(
+    std::filesystem::path const & directoryPath,
+    std::shared_ptr<ShipPreviewThumbnailStore> thumbnailStore)
 {
     return Create(
         directoryPath,
-        std::make_shared<FileSystem>());
+        std::make_shared<FileSystem>(),
+        std::move(thumbnailStore));
 }
 
 std::unique_ptr<ShipPreviewDirectoryManager> ShipPreviewDirectoryManager::Create(
     std::filesystem::path const & directoryPath,
-    std::shared_ptr<IFileSystem> fileSystem)
+    std::shared_ptr<IFileSystem> fileSystem,
+    std::shared_ptr<ShipPreviewThumbnailStore> thumbnailStore)
 {
     return std::unique_ptr<ShipPreviewDirectoryManager>(
         new ShipPreviewDirectoryManager(
             directoryPath,
             fileSystem,
+            std::move(thumbnailStore),
             PersistedShipPreviewImageDatabase::Load(directoryPath / DatabaseFileName, fileSystem)));
 }
 
@@ -43,6 +48,7 @@ RgbaImageData ShipPreviewDirectoryManager::LoadPreviewImage(
     auto const previewImageFileLastModified = mFileSystem->GetLastModifiedTime(previewData.PreviewFilePath);
 
     // See if this preview file may be served by old database
+    std::unique_lock databaseLock{ mDatabaseMutex };
     auto oldDbPreviewImage = mOldDatabase.TryGetPreviewImage(previewImageFilename, previewImageFileLastModified);
     if (oldDbPreviewImage.has_value())
     {
@@ -64,17 +70,54 @@ RgbaImageData ShipPreviewDirectoryManager::LoadPreviewImage(
         // Not served by DB
         //
 
+        // From now on we may run concurrently with other loads
+        databaseLock.unlock();
+
+        // See if this preview may be served by the thumbnail store, which knows
+        // previews by content rather than by filename and timestamp
+        std::optional<ShipPreviewThumbnailStore::ContentHash> contentHash;
+        if (mThumbnailStore)
+        {
+            auto previewFileStream = mFileSystem->OpenInputStream(previewData.PreviewFilePath);
+            if (previewFileStream)
+            {
+                contentHash = ShipPreviewThumbnailStore::CalculateContentHash(*previewFileStream, maxImageSize);
+
+                auto storedPreviewImage = mThumbnailStore->TryGet(*contentHash);
+                if (storedPreviewImage.has_value())
+                {
+                    // Add to new DB
+                    std::lock_guard const lock{ mDatabaseMutex };
+                    mNewDatabase.Add(
+                        previewImageFilename,
+                        previewImageFileLastModified,
+                        std::make_unique<RgbaImageData>(storedPreviewImage->Clone()));
+
+                    return std::move(*storedPreviewImage);
+                }
+            }
+        }
+
         // Needs to be loaded from scratch
         LogMessage("ShipPreviewDirectoryManager::LoadPreviewImage(): can't serve '", previewImageFilename.string(), "' from persisted DB; loading...");
 
         // Load preview image
         RgbaImageData previewImage = ShipDeSerializer::LoadShipPreviewImage(previewData, maxImageSize);
 
+        // Add to thumbnail store
+        if (contentHash.has_value())
+        {
+            mThumbnailStore->Put(*contentHash, previewImage);
+        }
+
         // Add to new DB
-        mNewDatabase.Add(
-            previewImageFilename,
-            previewImageFileLastModified,
-            std::make_unique<RgbaImageData>(previewImage.Clone()));
+        {
+            std::lock_guard const lock{ mDatabaseMutex };
+            mNewDatabase.Add(
+                previewImageFilename,
+                previewImageFileLastModified,
+                std::make_unique<RgbaImageData>(previewImage.Clone()));
+        }
 
         return previewImage;
     }
@@ -98,6 +141,12 @@ void ShipPreviewDirectoryManager::Commit(bool isVisitCompleted)
     // Close old database
     mOldDatabase.Close();
 
+    // Persist thumbnails
+    if (mThumbnailStore)
+    {
+        mThumbnailStore->Flush();
+    }
+
     if (hasFileBeenCreated)
     {
         // Swap temp file
@@ -8,6 +8,7 @@
 #include "ShipDefinition.h"
 #include "ShipPreviewData.h"
 #include "ShipPreviewImageDatabase.h"
+#include "ShipPreviewThumbnailStore.h"
 
 #include <GameCore/FileSystem.h>
 #include <GameCore/ImageData.h>
@@ -15,19 +16,29 @@
 #include <filesystem>
 #include <map>
 #include <memory>
+#include <mutex>
 #include <vector>
 
 class ShipPreviewDirectoryManager final
 {
 public:
 
+    /*
+     * The thumbnail store, when specified, serves the previews that are not in this
+     * directory's database.
+     */
     static std::unique_ptr<ShipPreviewDirectoryManager> Create(
-        std::filesystem::path const & directoryPath);
+        std::filesystem::path const & directoryPath,
+        std::shared_ptr<ShipPreviewThumbnailStore> thumbnailStore = nullptr);
 
     static std::unique_ptr<ShipPreviewDirectoryManager> Create(
         std::filesystem::path const & directoryPath,
-        std::shared_ptr<IFileSystem> fileSystem);
+        std::shared_ptr<IFileSystem> fileSystem,
+        std::shared_ptr<ShipPreviewThumbnailStore> thumbnailStore = nullptr);
 
+    /*
+     * May be invoked concurrently from multiple threads.
+     */
     RgbaImageData LoadPreviewImage(
         ShipPreviewData const & shipPreview,
         ImageSize const & maxImageSize);
@@ -39,11 +50,14 @@ private:
     ShipPreviewDirectoryManager(
         std::filesystem::path const & directoryPath,
         std::shared_ptr<IFileSystem> fileSystem,
+        std::shared_ptr<ShipPreviewThumbnailStore> thumbnailStore,
         PersistedShipPreviewImageDatabase && oldDatabase)
         : mDirectoryPath(directoryPath)
         , mFileSystem(fileSystem)
+        , mThumbnailStore(std::move(thumbnailStore))
         , mOldDatabase(std::move(oldDatabase))
         , mNewDatabase(fileSystem)
+        , mDatabaseMutex()
     {}
 
 private:
@@ -52,6 +66,11 @@ private:
 
     std::shared_ptr<IFileSystem> mFileSystem;
 
+    std::shared_ptr<ShipPreviewThumbnailStore> mThumbnailStore; // Optional
+
     PersistedShipPreviewImageDatabase mOldDatabase;
     NewShipPreviewImageDatabase mNewDatabase;
+
+    // Guards the databases, which previews are loaded concurrently against
+    std::mutex mDatabaseMutex;
 };
\ No newline at end of file
@@ -0,0 +1,492 @@
+/***************************************************************************************
+* Original Author:      Gabriele Giuseppini
+* Created:              2026-10-14
+* Copyright:            Gabriele Giuseppini  (https://github.com/GabrieleGiuseppini)
+***************************************************************************************/
+#include "ShipPreviewThumbnailStore.h"
+
+#include <GameCore/Log.h>
+
+#include <algorithm>
+#include <cassert>
+#include <system_error>
+#include <utility>
+#include <vector>
+
+std::shared_ptr<ShipPreviewThumbnailStore> ShipPreviewThumbnailStore::GetShared(std::filesystem::path const & packFilePath)
+{
+    static std::mutex sharedStoreMutex;
+    static std::weak_ptr<ShipPreviewThumbnailStore> sharedStore;
+
+    std::lock_guard const lock{ sharedStoreMutex };
+
+    auto store = sharedStore.lock();
+    if (!store || store->mPackFilePath != packFilePath)
+    {
+        store = std::make_shared<ShipPreviewThumbnailStore>(packFilePath);
+        sharedStore = store;
+    }
+
+    return store;
+}
+
+ShipPreviewThumbnailStore::ShipPreviewThumbnailStore(
+    std::filesystem::path const & packFilePath,
+    size_t capacity)
+    : mPackFilePath(packFilePath)
+    , mCapacity(capacity)
+    , mMutex()
+    , mPackFile()
+    , mIsPackFileOk(false)
+    , mIndex()
+    , mDataEnd(sizeof(PackFileHeader))
+    , mLiveBytes(0)
+    , mUseCounter(0)
+    , mIsDirty(false)
+{
+    try
+    {
+        std::filesystem::create_directories(mPackFilePath.parent_path());
+
+        if (!Open())
+        {
+            LogMessage("ShipPreviewThumbnailStore: cannot use pack file \"", mPackFilePath.string(), "\", starting from scratch");
+
+            Reset();
+        }
+
+        mIsPackFileOk = mPackFile.is_open() && mPackFile.good();
+
+        LogMessage("ShipPreviewThumbnailStore: opened with ", mIndex.size(), " thumbnails");
+    }
+    catch (std::exception const & ex)
+    {
+        LogMessage("ShipPreviewThumbnailStore: error opening pack file: ", ex.what());
+
+        mIsPackFileOk = false;
+    }
+}
+
+ShipPreviewThumbnailStore::~ShipPreviewThumbnailStore()
+{
+    try
+    {
+        Flush();
+    }
+    catch (...)
+    {
+        // Ignore, it's a cache
+    }
+}
+
+ShipPreviewThumbnailStore::ContentHash ShipPreviewThumbnailStore::CalculateContentHash(
+    std::istream & previewFileStream,
+    ImageSize const & maxImageSize)
+{
+    std::uint64_t hash = CalculateChecksum(&maxImageSize.width, sizeof(maxImageSize.width));
+    hash = CalculateChecksum(&maxImageSize.height, sizeof(maxImageSize.height), hash);
+
+    std::vector<char> buffer(64 * 1024);
+    while (previewFileStream)
+    {
+        previewFileStream.read(buffer.data(), buffer.size());
+        hash = CalculateChecksum(buffer.data(), static_cast<size_t>(previewFileStream.gcount()), hash);
+    }
+
+    return hash;
+}
+
+size_t ShipPreviewThumbnailStore::GetThumbnailCount() const
+{
+    std::lock_guard const lock{ mMutex };
+
+    return mIndex.size();
+}
+
+std::optional<RgbaImageData> ShipPreviewThumbnailStore::TryGet(ContentHash contentHash)
+{
+    std::lock_guard const lock{ mMutex };
+
+    if (!mIsPackFileOk)
+    {
+        return std::nullopt;
+    }
+
+    auto it = mIndex.find(contentHash);
+    if (it == mIndex.end())
+    {
+        return std::nullopt;
+    }
+
+    auto imageData = std::make_unique<rgbaColor[]>(it->second.Dimensions.GetLinearSize());
+
+    mPackFile.clear();
+    mPackFile.seekg(it->second.Offset);
+    if (!mPackFile.read(reinterpret_cast<char *>(imageData.get()), it->second.GetByteSize()))
+    {
+        LogMessage("ShipPreviewThumbnailStore::TryGet(): error reading thumbnail, dropping it");
+
+        mPackFile.clear();
+
+        mLiveBytes -= it->second.GetByteSize();
+        mIndex.erase(it);
+        mIsDirty = true;
+
+        return std::nullopt;
+    }
+
+    it->second.LastUse = ++mUseCounter;
+    mIsDirty = true;
+
+    return RgbaImageData(
+        it->second.Dimensions,
+        std::move(imageData));
+}
+
+void ShipPreviewThumbnailStore::Put(
+    ContentHash contentHash,
+    RgbaImageData const & thumbnail)
+{
+    std::lock_guard const lock{ mMutex };
+
+    if (!mIsPackFileOk)
+    {
+        return;
+    }
+
+    if (auto it = mIndex.find(contentHash); it != mIndex.end())
+    {
+        // Already have it
+        it->second.LastUse = ++mUseCounter;
+        mIsDirty = true;
+
+        return;
+    }
+
+    std::uint64_t const thumbnailByteSize = static_cast<std::uint64_t>(thumbnail.Size.GetLinearSize()) * sizeof(rgbaColor);
+    if (thumbnailByteSize == 0 || thumbnailByteSize > mCapacity)
+    {
+        return;
+    }
+
+    // Append, over the index
+    mPackFile.clear();
+    mPackFile.seekp(mDataEnd);
+    if (!mPackFile.write(reinterpret_cast<char const *>(thumbnail.Data.get()), thumbnailByteSize))
+    {
+        LogMessage("ShipPreviewThumbnailStore::Put(): error writing thumbnail");
+
+        mPackFile.clear();
+
+        return;
+    }
+
+    mIndex.emplace(
+        contentHash,
+        ThumbnailInfo(mDataEnd, thumbnail.Size, ++mUseCounter));
+
+    mDataEnd += thumbnailByteSize;
+    mLiveBytes += thumbnailByteSize;
+    mIsDirty = true;
+
+    if (mLiveBytes > mCapacity)
+    {
+        EvictLeastRecentlyUsed();
+    }
+}
+
+void ShipPreviewThumbnailStore::Flush()
+{
+    std::lock_guard const lock{ mMutex };
+
+    if (!mIsPackFileOk || !mIsDirty)
+    {
+        return;
+    }
+
+    // Compact once evicted thumbnails take up most of the file
+    std::uint64_t const evictedBytes = (mDataEnd - sizeof(PackFileHeader)) - mLiveBytes;
+    if (evictedBytes > mLiveBytes)
+    {
+        Compact();
+    }
+    else
+    {
+        WriteIndex();
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////
+
+bool ShipPreviewThumbnailStore::Open()
+{
+    std::error_code errorCode;
+    auto const fileSize = std::filesystem::file_size(mPackFilePath, errorCode);
+    if (errorCode)
+    {
+        return false;
+    }
+
+    mPackFile.open(mPackFilePath, std::ios_base::in | std::ios_base::out | std::ios_base::binary);
+    if (!mPackFile.is_open())
+    {
+        return false;
+    }
+
+    //
+    // Header
+    //
+
+    PackFileHeader header;
+    if (!mPackFile.read(reinterpret_cast<char *>(&header), sizeof(PackFileHeader))
+        || header.Title != PackFileHeader::StockTitle
+        || header.Version != PackFileHeader::CurrentVersion
+        || header.IndexOffset < sizeof(PackFileHeader)
+        || header.IndexOffset + static_cast<std::uint64_t>(header.IndexEntryCount) * sizeof(PackFileIndexEntry) > fileSize)
+    {
+        return false;
+    }
+
+    //
+    // Index
+    //
+
+    std::vector<PackFileIndexEntry> entries(header.IndexEntryCount);
+
+    mPackFile.seekg(header.IndexOffset);
+    if (!mPackFile.read(reinterpret_cast<char *>(entries.data()), entries.size() * sizeof(PackFileIndexEntry))
+        || CalculateChecksum(entries.data(), entries.size() * sizeof(PackFileIndexEntry)) != header.IndexChecksum)
+    {
+        // The index has been overwritten by thumbnails appended after the last flush
+        return false;
+    }
+
+    mIndex.clear();
+    mLiveBytes = 0;
+
+    for (auto const & entry : entries)
+    {
+        ThumbnailInfo thumbnailInfo(
+            entry.Offset,
+            ImageSize(static_cast<int>(entry.Width), static_cast<int>(entry.Height)),
+            entry.LastUse);
+
+        if (thumbnailInfo.Offset >= sizeof(PackFileHeader)
+            && thumbnailInfo.Offset + thumbnailInfo.GetByteSize() <= header.IndexOffset)
+        {
+            mLiveBytes += thumbnailInfo.GetByteSize();
+            mIndex.emplace(entry.ContentHash, thumbnailInfo);
+        }
+    }
+
+    mDataEnd = header.IndexOffset;
+    mUseCounter = header.UseCounter;
+    mIsDirty = false;
+
+    return true;
+}
+
+void ShipPreviewThumbnailStore::Reset()
+{
+    if (mPackFile.is_open())
+    {
+        mPackFile.close();
+    }
+
+    mPackFile.clear();
+    mPackFile.open(mPackFilePath, std::ios_base::in | std::ios_base::out | std::ios_base::binary | std::ios_base::trunc);
+
+    mIndex.clear();
+    mDataEnd = sizeof(PackFileHeader);
+    mLiveBytes = 0;
+    mUseCounter = 0;
+
+    if (mPackFile.is_open())
+    {
+        WriteIndex();
+    }
+}
+
+void ShipPreviewThumbnailStore::EvictLeastRecentlyUsed()
+{
+    // Evict a bit more than needed, so that we don't have to evict again at the very next thumbnail
+    std::uint64_t const targetLiveBytes = mCapacity - mCapacity / 10;
+
+    std::vector<std::pair<std::uint64_t, ContentHash>> thumbnailsByUse;
+    thumbnailsByUse.reserve(mIndex.size());
+    for (auto const & [contentHash, thumbnailInfo] : mIndex)
+    {
+        thumbnailsByUse.emplace_back(thumbnailInfo.LastUse, contentHash);
+    }
+
+    std::sort(thumbnailsByUse.begin(), thumbnailsByUse.end());
+
+    for (auto const & [lastUse, contentHash] : thumbnailsByUse)
+    {
+        if (mLiveBytes <= targetLiveBytes)
+        {
+            break;
+        }
+
+        auto const it = mIndex.find(contentHash);
+        assert(it != mIndex.end());
+
+        mLiveBytes -= it->second.GetByteSize();
+        mIndex.erase(it);
+    }
+
+    mIsDirty = true;
+}
+
+void ShipPreviewThumbnailStore::WriteIndex()
+{
+    std::vector<PackFileIndexEntry> entries;
+    entries.reserve(mIndex.size());
+    for (auto const & [contentHash, thumbnailInfo] : mIndex)
+    {
+        entries.push_back({
+            contentHash,
+            thumbnailInfo.Offset,
+            static_cast<std::uint32_t>(thumbnailInfo.Dimensions.width),
+            static_cast<std::uint32_t>(thumbnailInfo.Dimensions.height),
+            thumbnailInfo.LastUse });
+    }
+
+    PackFileHeader header;
+    header.IndexEntryCount = static_cast<std::uint32_t>(entries.size());
+    header.IndexOffset = mDataEnd;
+    header.IndexChecksum = CalculateChecksum(entries.data(), entries.size() * sizeof(PackFileIndexEntry));
+    header.UseCounter = mUseCounter;
+
+    // Index first, and header last, so that the header only points to a complete index
+    mPackFile.clear();
+    mPackFile.seekp(mDataEnd);
+    mPackFile.write(reinterpret_cast<char const *>(entries.data()), entries.size() * sizeof(PackFileIndexEntry));
+    mPackFile.flush();
+    mPackFile.seekp(0);
+    mPackFile.write(reinterpret_cast<char const *>(&header), sizeof(PackFileHeader));
+    mPackFile.flush();
+
+    if (!mPackFile)
+    {
+        LogMessage("ShipPreviewThumbnailStore::WriteIndex(): error writing index");
+
+        mPackFile.clear();
+    }
+    else
+    {
+        mIsDirty = false;
+    }
+}
+
+void ShipPreviewThumbnailStore::Compact()
+{
+    LogMessage("ShipPreviewThumbnailStore::Compact(): compacting ", mIndex.size(), " thumbnails...");
+
+    auto const temporaryPackFilePath = std::filesystem::path(mPackFilePath).replace_extension("tmp");
+
+    //
+    // Copy live thumbnails to a new pack file
+    //
+
+    Index newIndex;
+    std::uint64_t newDataEnd = sizeof(PackFileHeader);
+    std::uint64_t newLiveBytes = 0;
+
+    {
+        std::ofstream newPackFile(temporaryPackFilePath, std::ios_base::out | std::ios_base::binary | std::ios_base::trunc);
+
+        // Placeholder, we'll write the real one after swapping files
+        PackFileHeader const header;
+        newPackFile.write(reinterpret_cast<char const *>(&header), sizeof(PackFileHeader));
+
+        std::vector<char> buffer;
+        for (auto const & [contentHash, thumbnailInfo] : mIndex)
+        {
+            buffer.resize(thumbnailInfo.GetByteSize());
+
+            mPackFile.clear();
+            mPackFile.seekg(thumbnailInfo.Offset);
+            if (!mPackFile.read(buffer.data(), buffer.size()))
+            {
+                // Lost this thumbnail
+                continue;
+            }
+
+            newPackFile.write(buffer.data(), buffer.size());
+
+            newIndex.emplace(
+                contentHash,
+                ThumbnailInfo(newDataEnd, thumbnailInfo.Dimensions, thumbnailInfo.LastUse));
+
+            newDataEnd += thumbnailInfo.GetByteSize();
+            newLiveBytes += thumbnailInfo.GetByteSize();
+        }
+
+        newPackFile.flush();
+
+        if (!newPackFile)
+        {
+            LogMessage("ShipPreviewThumbnailStore::Compact(): error writing new pack file");
+
+            newPackFile.close();
+
+            std::error_code errorCode;
+            std::filesystem::remove(temporaryPackFilePath, errorCode);
+
+            // Keep the old pack
+            mPackFile.clear();
+            WriteIndex();
+
+            return;
+        }
+    }
+
+    //
+    // Swap pack files
+    //
+
+    mPackFile.close();
+
+    std::error_code errorCode;
+    std::filesystem::rename(temporaryPackFilePath, mPackFilePath, errorCode);
+    if (errorCode)
+    {
+        LogMessage("ShipPreviewThumbnailStore::Compact(): error swapping pack files: ", errorCode.message());
+
+        std::filesystem::remove(temporaryPackFilePath, errorCode);
+    }
+    else
+    {
+        mIndex = std::move(newIndex);
+        mDataEnd = newDataEnd;
+        mLiveBytes = newLiveBytes;
+    }
+
+    mPackFile.clear();
+    mPackFile.open(mPackFilePath, std::ios_base::in | std::ios_base::out | std::ios_base::binary);
+    mIsPackFileOk = mPackFile.is_open();
+
+    if (mIsPackFileOk)
+    {
+        WriteIndex();
+    }
+
+    LogMessage("ShipPreviewThumbnailStore::Compact(): ...completed");
+}
+
+std::uint64_t ShipPreviewThumbnailStore::CalculateChecksum(
+    void const * data,
+    size_t size,
+    std::uint64_t checksum)
+{
+    // FNV-1a
+    auto const * const bytes = reinterpret_cast<unsigned char const *>(data);
+    for (size_t i = 0; i < size; ++i)
+    {
+        checksum ^= static_cast<std::uint64_t>(bytes[i]);
+        checksum *= 0x100000001b3ull;
+    }
+
+    return checksum;
+}
@@ -0,0 +1,181 @@
+/***************************************************************************************
+* Original Author:      Gabriele Giuseppini
+* Created:              2026-10-14
+* Copyright:            Gabriele Giuseppini  (https://github.com/GabrieleGiuseppini)
+***************************************************************************************/
+#pragma once
+
+#include <GameCore/ImageData.h>
+
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <istream>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <unordered_map>
+
+/*
+ * A store of ship preview thumbnails that is shared by all the ship load dialogs, and
+ * that survives across launches.
+ *
+ * Thumbnails are keyed by a hash of the content of the file they come from, so that
+ * they keep being served after files are touched, renamed, or copied to other folders.
+ *
+ * All thumbnails live in a single pack file, made of:
+ *  - A header, pointing to the index;
+ *  - The thumbnails, as raw RGBA pixels at fixed offsets, so that they may be read -
+ *    or mapped - without any decoding;
+ *  - The index, with one entry per thumbnail.
+ *
+ * Thumbnails are added lazily, by appending them over the index, which is then rewritten
+ * after them at each flush. When the thumbnails exceed the capacity of the store, the
+ * least-recently-used ones are evicted; once evicted thumbnails take up most of the file,
+ * the pack is compacted.
+ *
+ * As it's a cache, any problem with the pack file just makes for an empty store.
+ *
+ * Thread-safe.
+ */
+class ShipPreviewThumbnailStore final
+{
+public:
+
+    using ContentHash = std::uint64_t;
+
+    static size_t constexpr DefaultCapacity = 256 * 1024 * 1024; // Bytes of thumbnails
+
+public:
+
+    /*
+     * Returns the store for the specified pack file, shared with whoever else is
+     * using it at this moment.
+     */
+    static std::shared_ptr<ShipPreviewThumbnailStore> GetShared(std::filesystem::path const & packFilePath);
+
+    explicit ShipPreviewThumbnailStore(
+        std::filesystem::path const & packFilePath,
+        size_t capacity = DefaultCapacity);
+
+    ~ShipPreviewThumbnailStore();
+
+    ShipPreviewThumbnailStore(ShipPreviewThumbnailStore const & other) = delete;
+    ShipPreviewThumbnailStore & operator=(ShipPreviewThumbnailStore const & other) = delete;
+
+    /*
+     * Hashes the content of a preview file, together with the size the thumbnail
+     * is made for.
+     */
+    static ContentHash CalculateContentHash(
+        std::istream & previewFileStream,
+        ImageSize const & maxImageSize);
+
+    size_t GetThumbnailCount() const;
+
+    std::optional<RgbaImageData> TryGet(ContentHash contentHash);
+
+    void Put(
+        ContentHash contentHash,
+        RgbaImageData const & thumbnail);
+
+    /*
+     * Makes the current content of the store persistent.
+     */
+    void Flush();
+
+private:
+
+#pragma pack(push, 1)
+
+    struct PackFileHeader
+    {
+        static std::array<char, 32> constexpr StockTitle{ 'F', 'L', 'O', 'A', 'T', 'I', 'N', 'G', ' ', 'S', 'A', 'N', 'D', 'B', 'O', 'X', ' ', 'T', 'H', 'U', 'M', 'B', 'N', 'A', 'I', 'L', ' ', 'P', 'A', 'C', 'K', '\0' };
+        static std::uint32_t constexpr CurrentVersion = 1;
+
+        std::array<char, 32> Title;
+        std::uint32_t Version;
+        std::uint32_t IndexEntryCount;
+        std::uint64_t IndexOffset;
+        std::uint64_t IndexChecksum;
+        std::uint64_t UseCounter;
+
+        PackFileHeader()
+            : Version(CurrentVersion)
+            , IndexEntryCount(0)
+            , IndexOffset(sizeof(PackFileHeader))
+            , IndexChecksum(0)
+            , UseCounter(0)
+        {
+            std::memcpy(Title.data(), StockTitle.data(), Title.size());
+        }
+    };
+
+    struct PackFileIndexEntry
+    {
+        std::uint64_t ContentHash;
+        std::uint64_t Offset;
+        std::uint32_t Width;
+        std::uint32_t Height;
+        std::uint64_t LastUse;
+    };
+
+#pragma pack(pop)
+
+    struct ThumbnailInfo
+    {
+        std::uint64_t Offset;
+        ImageSize Dimensions;
+        std::uint64_t LastUse;
+
+        ThumbnailInfo(
+            std::uint64_t offset,
+            ImageSize dimensions,
+            std::uint64_t lastUse)
+            : Offset(offset)
+            , Dimensions(dimensions)
+            , LastUse(lastUse)
+        {}
+
+        std::uint64_t GetByteSize() const
+        {
+            return static_cast<std::uint64_t>(Dimensions.GetLinearSize()) * sizeof(rgbaColor);
+        }
+    };
+
+    using Index = std::unordered_map<ContentHash, ThumbnailInfo>;
+
+    bool Open();
+
+    void Reset();
+
+    void EvictLeastRecentlyUsed();
+
+    void WriteIndex();
+
+    void Compact();
+
+    static std::uint64_t CalculateChecksum(
+        void const * data,
+        size_t size,
+        std::uint64_t checksum = 0xcbf29ce484222325ull);
+
+private:
+
+    std::filesystem::path const mPackFilePath;
+    size_t const mCapacity;
+
+    mutable std::mutex mMutex;
+
+    std::fstream mPackFile;
+    bool mIsPackFileOk;
+
+    Index mIndex;
+
+    std::uint64_t mDataEnd; // Where the next thumbnail goes - and where the index is written at
+    std::uint64_t mLiveBytes; // Total size of the thumbnails in the index
+    std::uint64_t mUseCounter;
+    bool mIsDirty;
+};
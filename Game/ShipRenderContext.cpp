@@ -7,6 +7,7 @@
 
 #include "GameParameters.h"
 
+#include <GameCore/Algorithms.h>
 #include <GameCore/GameException.h>
 #include <GameCore/GameMath.h>
 #include <GameCore/GameWallClock.h>
@@ -17,11 +18,47 @@
 
 namespace Render {
 
+// Ship textures at least this large get compressed, as smaller ones don't weigh on GPU memory
+size_t constexpr MinCompressedShipTexturePixels = 1024 * 1024;
+
+// Ship textures at least this large get uploaded over multiple frames, a chunk of rows at a time
+size_t constexpr MinChunkedShipTextureUploadPixels = 2048 * 2048;
+size_t constexpr ShipTextureUploadChunkPixels = 4 * 1024 * 1024;
+
+// The larger dimension of the placeholder rendered while a ship texture is being uploaded
+int constexpr ShipTexturePlaceholderMaxDimension = 256;
+
+static RgbaImageData MakeShipTexturePlaceholder(RgbaImageData const & shipTexture)
+{
+    // We sample the nearest pixels rather than filtering, as the placeholder only lasts for
+    // a few frames, while filtering would visit all the pixels of the texture
+    float const scale = static_cast<float>(ShipTexturePlaceholderMaxDimension) / static_cast<float>(std::max(shipTexture.Size.width, shipTexture.Size.height));
+    ImageSize const placeholderSize(
+        std::max(1, static_cast<int>(static_cast<float>(shipTexture.Size.width) * scale)),
+        std::max(1, static_cast<int>(static_cast<float>(shipTexture.Size.height) * scale)));
+
+    auto placeholderData = std::make_unique<rgbaColor[]>(placeholderSize.GetLinearSize());
+    for (int y = 0; y < placeholderSize.height; ++y)
+    {
+        int const sourceY = (y * shipTexture.Size.height + shipTexture.Size.height / 2) / placeholderSize.height;
+        rgbaColor const * const sourceRow = shipTexture.Data.get() + static_cast<size_t>(sourceY) * static_cast<size_t>(shipTexture.Size.width);
+
+        for (int x = 0; x < placeholderSize.width; ++x)
+        {
+            int const sourceX = (x * shipTexture.Size.width + shipTexture.Size.width / 2) / placeholderSize.width;
+            placeholderData[static_cast<size_t>(y) * static_cast<size_t>(placeholderSize.width) + x] = sourceRow[sourceX];
+        }
+    }
+
+    return RgbaImageData(placeholderSize, std::move(placeholderData));
+}
+
 ShipRenderContext::ShipRenderContext(
     ShipId shipId,
     size_t pointCount,
     size_t shipCount,
     RgbaImageData shipTexture,
+    TaskThread & textureCompressionThread,
     ShaderManager<ShaderManagerTraits> & shaderManager,
     GlobalRenderContext const & globalRenderContext,
     RenderParameters const & renderParameters,
@@ -33,12 +70,22 @@ ShipRenderContext::ShipRenderContext(
     , mMaxMaxPlaneId(0)
     , mIsViewModelDirty(false)
     // Buffers
-    , mPointAttributeGroup1Buffer()
+    , mPointAttributeGroup1Buffers()
     , mPointAttributeGroup1VBO()
-    , mPointAttributeGroup2Buffer()
+    , mPointAttributeGroup2Buffers()
     , mPointAttributeGroup2VBO()
+    , mPointAttributeUploadBufferIndex(0)
+    , mPointAttributeRenderBufferIndex(1)
+    , mArePointMutableAttributesUploaded(false)
+    , mDoStreamPointAttributes(GameOpenGL::SupportsPersistentMappedBuffers)
+    , mPointAttributeGroup1StreamBuffer()
+    , mPointAttributeGroup2StreamBuffer()
+    , mPointAttributeStreamBoundByteOffset(0)
     , mPointColorVBO()
+    , mPointColorUploadBuffer()
+    , mDoStorePointTemperatureAsHalfFloat(GameOpenGL::SupportsHalfFloatVertexAttributes)
     , mPointTemperatureVBO()
+    , mPointTemperatureUploadBuffer()
     , mPointStressVBO()
     , mPointAuxiliaryDataVBO()
     , mPointFrontierColorVBO()
@@ -55,6 +102,8 @@ ShipRenderContext::ShipRenderContext(
     , mElectricSparkVertexBuffer()
     , mElectricSparkVBO()
     , mElectricSparkVBOAllocatedVertexSize(0u)
+    , mQuadElementVBO()
+    , mQuadElementVBOAllocatedQuadSize(0u)
     //
     , mFlameVertexBuffer()
     , mFlameBackgroundCount(0u)
@@ -105,15 +154,37 @@ ShipRenderContext::ShipRenderContext(
     , mEphemeralPointElementBuffer()
     , mSpringElementBuffer()
     , mRopeElementBuffer()
+    , mDecimatedRopeElementBuffer()
     , mTriangleElementBuffer()
     , mAreElementBuffersDirty(true)
     , mElementVBO()
     , mElementVBOAllocatedIndexSize(0u)
+    , mTriangleElementIdBuffer()
+    , mTriangleElementSlots()
+    , mIsTriangleElementBufferDirty(true)
+    , mTriangleElementTombstoneSlots()
     , mPointElementVBOStartIndex(0)
     , mEphemeralPointElementVBOStartIndex(0)
     , mSpringElementVBOStartIndex(0)
     , mRopeElementVBOStartIndex(0)
+    , mDecimatedRopeElementVBOStartIndex(0)
     , mTriangleElementVBOStartIndex(0)
+    // Element culling
+    , mPointTextureCullingTileIndices(pointCount, 0)
+    , mPointCullingTileIndices(pointCount, NoneCullingTileIndex)
+    , mCullingTileAABBs()
+    , mIsCullingTileVisible()
+    , mAreAllCullingTilesVisible(true)
+    , mTriangleElementBuckets()
+    , mSpringElementBuckets()
+    , mTriangleElementBucketingBuffer()
+    , mSpringElementBucketingBuffer()
+    , mElementIdBucketingBuffer()
+    , mCulledDrawCounts()
+    , mCulledDrawIndices()
+    , mCulledDrawCommands()
+    , mCulledDrawCommandVBO()
+    , mCulledDrawCommandVBOAllocatedSize(0)
     // VAOs
     , mShipVAO()
     , mElectricSparkVAO()
@@ -133,6 +204,9 @@ ShipRenderContext::ShipRenderContext(
     // Textures
     , mShipTextureOpenGLHandle()
     , mStressedSpringTextureOpenGLHandle()
+    , mShipTextureCompressionCompletionIndicator()
+    , mCompressedShipTextureLevels()
+    , mShipTextureUpload()
     , mExplosionTextureAtlasMetadata(globalRenderContext.GetExplosionTextureAtlasMetadata())
     , mGenericLinearTextureAtlasMetadata(globalRenderContext.GetGenericLinearTextureAtlasMetadata())
     , mGenericMipMappedTextureAtlasMetadata(globalRenderContext.GetGenericMipMappedTextureAtlasMetadata())
@@ -153,35 +227,64 @@ ShipRenderContext::ShipRenderContext(
     // Initialize buffers
     //
 
-    GLuint vbos[19];
-    glGenBuffers(19, vbos);
+    GLuint vbos[20];
+    glGenBuffers(20, vbos);
     CheckOpenGLError();
 
     mPointAttributeGroup1VBO = vbos[0];
-    glBindBuffer(GL_ARRAY_BUFFER, *mPointAttributeGroup1VBO);
-    glBufferData(GL_ARRAY_BUFFER, pointCount * sizeof(vec4f), nullptr, GL_STREAM_DRAW);
-    mPointAttributeGroup1Buffer.reset(new vec4f[pointCount]);
-    std::fill(
-        mPointAttributeGroup1Buffer.get(),
-        mPointAttributeGroup1Buffer.get() + pointCount,
-        vec4f::zero());
+    if (mDoStreamPointAttributes)
+    {
+        mPointAttributeGroup1StreamBuffer.Allocate(pointCount, vec4f::zero());
+    }
+    else
+    {
+        glBindBuffer(GL_ARRAY_BUFFER, *mPointAttributeGroup1VBO);
+        glBufferData(GL_ARRAY_BUFFER, pointCount * sizeof(vec4f), nullptr, GL_STREAM_DRAW);
+    }
+    for (auto & buffer : mPointAttributeGroup1Buffers)
+    {
+        buffer.reset(new vec4f[pointCount]);
+        std::fill(
+            buffer.get(),
+            buffer.get() + pointCount,
+            vec4f::zero());
+    }
 
     mPointAttributeGroup2VBO = vbos[1];
-    glBindBuffer(GL_ARRAY_BUFFER, *mPointAttributeGroup2VBO);
-    glBufferData(GL_ARRAY_BUFFER, pointCount * sizeof(vec4f), nullptr, GL_STREAM_DRAW);
-    mPointAttributeGroup2Buffer.reset(new vec4f[pointCount]);
-    std::fill(
-        mPointAttributeGroup2Buffer.get(),
-        mPointAttributeGroup2Buffer.get() + pointCount,
-        vec4f::zero());
+    if (mDoStreamPointAttributes)
+    {
+        mPointAttributeGroup2StreamBuffer.Allocate(pointCount, vec4f::zero());
+    }
+    else
+    {
+        glBindBuffer(GL_ARRAY_BUFFER, *mPointAttributeGroup2VBO);
+        glBufferData(GL_ARRAY_BUFFER, pointCount * sizeof(vec4f), nullptr, GL_STREAM_DRAW);
+    }
+    for (auto & buffer : mPointAttributeGroup2Buffers)
+    {
+        buffer.reset(new vec4f[pointCount]);
+        std::fill(
+            buffer.get(),
+            buffer.get() + pointCount,
+            vec4f::zero());
+    }
 
     mPointColorVBO = vbos[2];
     glBindBuffer(GL_ARRAY_BUFFER, *mPointColorVBO);
-    glBufferData(GL_ARRAY_BUFFER, pointCount * sizeof(vec4f), nullptr, GL_STATIC_DRAW);
+    glBufferData(GL_ARRAY_BUFFER, pointCount * sizeof(rgbaColor), nullptr, GL_STATIC_DRAW);
+    mPointColorUploadBuffer.reset(new rgbaColor[pointCount]);
 
     mPointTemperatureVBO = vbos[3];
     glBindBuffer(GL_ARRAY_BUFFER, *mPointTemperatureVBO);
-    glBufferData(GL_ARRAY_BUFFER, pointCount * sizeof(float), nullptr, GL_STREAM_DRAW);
+    if (mDoStorePointTemperatureAsHalfFloat)
+    {
+        glBufferData(GL_ARRAY_BUFFER, pointCount * sizeof(std::uint16_t), nullptr, GL_STREAM_DRAW);
+        mPointTemperatureUploadBuffer.reset(new std::uint16_t[pointCount]);
+    }
+    else
+    {
+        glBufferData(GL_ARRAY_BUFFER, pointCount * sizeof(float), nullptr, GL_STREAM_DRAW);
+    }
 
     mPointStressVBO = vbos[4];
     glBindBuffer(GL_ARRAY_BUFFER, *mPointStressVBO);
@@ -221,6 +324,8 @@ ShipRenderContext::ShipRenderContext(
 
     mPointToPointArrowVBO = vbos[18];
 
+    mQuadElementVBO = vbos[19];
+
     glBindBuffer(GL_ARRAY_BUFFER, 0);
 
     //
@@ -234,7 +339,15 @@ ShipRenderContext::ShipRenderContext(
     mEphemeralPointElementBuffer.reserve(GameParameters::MaxEphemeralParticles);
     mSpringElementBuffer.reserve(pointCount * GameParameters::MaxSpringsPerPoint);
     mRopeElementBuffer.reserve(pointCount); // Arbitrary
+    mDecimatedRopeElementBuffer.reserve(pointCount); // Arbitrary
     mTriangleElementBuffer.reserve(pointCount * GameParameters::MaxTrianglesPerPoint);
+    mTriangleElementIdBuffer.reserve(pointCount * GameParameters::MaxTrianglesPerPoint);
+
+    if (GameOpenGL::SupportsMultiDrawIndirect)
+    {
+        glGenBuffers(1, &tmpGLuint);
+        mCulledDrawCommandVBO = tmpGLuint;
+    }
 
 
     //
@@ -252,24 +365,49 @@ ShipRenderContext::ShipRenderContext(
         // Describe vertex attributes
         //
 
-        glBindBuffer(GL_ARRAY_BUFFER, *mPointAttributeGroup1VBO);
+        if (mDoStreamPointAttributes)
+        {
+            mPointAttributeStreamBoundByteOffset = mPointAttributeGroup1StreamBuffer.GetRenderSegmentByteOffset();
+            assert(mPointAttributeGroup2StreamBuffer.GetRenderSegmentByteOffset() == mPointAttributeStreamBoundByteOffset);
+
+            glBindBuffer(GL_ARRAY_BUFFER, mPointAttributeGroup1StreamBuffer.GetVBO());
+        }
+        else
+        {
+            glBindBuffer(GL_ARRAY_BUFFER, *mPointAttributeGroup1VBO);
+        }
         glEnableVertexAttribArray(static_cast<GLuint>(VertexAttributeType::ShipPointAttributeGroup1));
-        glVertexAttribPointer(static_cast<GLuint>(VertexAttributeType::ShipPointAttributeGroup1), 4, GL_FLOAT, GL_FALSE, sizeof(vec4f), (void*)(0));
+        glVertexAttribPointer(static_cast<GLuint>(VertexAttributeType::ShipPointAttributeGroup1), 4, GL_FLOAT, GL_FALSE, sizeof(vec4f), (void*)(mPointAttributeStreamBoundByteOffset));
         CheckOpenGLError();
 
-        glBindBuffer(GL_ARRAY_BUFFER, *mPointAttributeGroup2VBO);
+        if (mDoStreamPointAttributes)
+        {
+            glBindBuffer(GL_ARRAY_BUFFER, mPointAttributeGroup2StreamBuffer.GetVBO());
+        }
+        else
+        {
+            glBindBuffer(GL_ARRAY_BUFFER, *mPointAttributeGroup2VBO);
+        }
         glEnableVertexAttribArray(static_cast<GLuint>(VertexAttributeType::ShipPointAttributeGroup2));
-        glVertexAttribPointer(static_cast<GLuint>(VertexAttributeType::ShipPointAttributeGroup2), 4, GL_FLOAT, GL_FALSE, sizeof(vec4f), (void*)(0));
+        glVertexAttribPointer(static_cast<GLuint>(VertexAttributeType::ShipPointAttributeGroup2), 4, GL_FLOAT, GL_FALSE, sizeof(vec4f), (void*)(mPointAttributeStreamBoundByteOffset));
         CheckOpenGLError();
 
         glBindBuffer(GL_ARRAY_BUFFER, *mPointColorVBO);
         glEnableVertexAttribArray(static_cast<GLuint>(VertexAttributeType::ShipPointColor));
-        glVertexAttribPointer(static_cast<GLuint>(VertexAttributeType::ShipPointColor), 4, GL_FLOAT, GL_FALSE, sizeof(vec4f), (void*)(0));
+        static_assert(sizeof(rgbaColor) == 4 * sizeof(std::uint8_t));
+        glVertexAttribPointer(static_cast<GLuint>(VertexAttributeType::ShipPointColor), 4, GL_UNSIGNED_BYTE, GL_TRUE, sizeof(rgbaColor), (void*)(0));
         CheckOpenGLError();
 
         glBindBuffer(GL_ARRAY_BUFFER, *mPointTemperatureVBO);
         glEnableVertexAttribArray(static_cast<GLuint>(VertexAttributeType::ShipPointTemperature));
-        glVertexAttribPointer(static_cast<GLuint>(VertexAttributeType::ShipPointTemperature), 1, GL_FLOAT, GL_FALSE, sizeof(float), (void*)(0));
+        if (mDoStorePointTemperatureAsHalfFloat)
+        {
+            glVertexAttribPointer(static_cast<GLuint>(VertexAttributeType::ShipPointTemperature), 1, GL_HALF_FLOAT, GL_FALSE, sizeof(std::uint16_t), (void*)(0));
+        }
+        else
+        {
+            glVertexAttribPointer(static_cast<GLuint>(VertexAttributeType::ShipPointTemperature), 1, GL_FLOAT, GL_FALSE, sizeof(float), (void*)(0));
+        }
         CheckOpenGLError();
 
         glBindBuffer(GL_ARRAY_BUFFER, *mPointStressVBO);
@@ -321,6 +459,10 @@ ShipRenderContext::ShipRenderContext(
         glVertexAttribPointer(static_cast<GLuint>(VertexAttributeType::ElectricSpark1), 4, GL_FLOAT, GL_FALSE, sizeof(ElectricSparkVertex), (void *)(0));
         CheckOpenGLError();
 
+        // Associate quad element VBO
+        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, *mQuadElementVBO);
+        CheckOpenGLError();
+
         glBindVertexArray(0);
     }
 
@@ -344,6 +486,10 @@ ShipRenderContext::ShipRenderContext(
         glVertexAttribPointer(static_cast<GLuint>(VertexAttributeType::Flame2), 3, GL_FLOAT, GL_FALSE, sizeof(FlameVertex), (void*)((4) * sizeof(float)));
         CheckOpenGLError();
 
+        // Associate quad element VBO
+        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, *mQuadElementVBO);
+        CheckOpenGLError();
+
         glBindVertexArray(0);
     }
 
@@ -550,43 +696,101 @@ ShipRenderContext::ShipRenderContext(
     glBindTexture(GL_TEXTURE_2D, *mShipTextureOpenGLHandle);
     CheckOpenGLError();
 
-    // Upload texture
-    GameOpenGL::UploadMipmappedTexture(std::move(shipTexture));
+    // Compress large textures in the background, rendering with the uncompressed one meanwhile
+    if (GameOpenGL::SupportsBC3TextureCompression
+        && shipTexture.Size.GetLinearSize() >= MinCompressedShipTexturePixels)
+    {
+        auto sourceTexture = std::make_shared<RgbaImageData const>(shipTexture.Clone());
+        auto compressedLevels = std::make_shared<std::vector<TextureCompression::CompressedImage>>();
 
-    // Set repeat mode
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
-    CheckOpenGLError();
+        mShipTextureCompressionCompletionIndicator = textureCompressionThread.QueueTask(
+            [sourceTexture, compressedLevels]()
+            {
+                *compressedLevels = TextureCompression::CompressMipmappedBC3(*sourceTexture);
+            });
 
-    // Set filtering
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_NEAREST);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-    CheckOpenGLError();
+        mCompressedShipTextureLevels = std::move(compressedLevels);
+    }
+
+    auto const setShipTextureParameters = []()
+    {
+        // Set repeat mode
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
+        CheckOpenGLError();
+
+        // Set filtering
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_NEAREST);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+        CheckOpenGLError();
+    };
+
+    if (shipTexture.Size.GetLinearSize() >= MinChunkedShipTextureUploadPixels)
+    {
+        // Upload a placeholder, rendered until the texture is uploaded over the next frames
+        GameOpenGL::UploadMipmappedTexture(MakeShipTexturePlaceholder(shipTexture));
+        setShipTextureParameters();
+
+        glGenTextures(1, &tmpGLuint);
+        GameOpenGLTexture uploadTextureOpenGLHandle(tmpGLuint);
+
+        glBindTexture(GL_TEXTURE_2D, *uploadTextureOpenGLHandle);
+        CheckOpenGLError();
+
+        // Allocate the base level only, the GPU generates the others once it's uploaded
+        glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, shipTexture.Size.width, shipTexture.Size.height, 0, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+        CheckOpenGLError();
+
+        setShipTextureParameters();
+
+        GameOpenGLVBO pixelUnpackBuffer;
+        if (GameOpenGL::SupportsPixelBufferObjects)
+        {
+            glGenBuffers(1, &tmpGLuint);
+            pixelUnpackBuffer = tmpGLuint;
+        }
+
+        mShipTextureUpload = std::make_unique<ShipTextureUpload>(
+            ShipTextureUpload{
+                std::move(shipTexture),
+                std::move(uploadTextureOpenGLHandle),
+                std::move(pixelUnpackBuffer),
+                0 });
+
+        glBindTexture(GL_TEXTURE_2D, *mShipTextureOpenGLHandle);
+        CheckOpenGLError();
+    }
+    else
+    {
+        // Upload texture
+        GameOpenGL::UploadMipmappedTexture(std::move(shipTexture));
+        setShipTextureParameters();
+    }
 
     // Set texture parameter
-    mShaderManager.ActivateProgram<ProgramType::ShipSpringsTexture>();
+    mShaderManager.ActivateProgramForParameters<ProgramType::ShipSpringsTexture>();
     mShaderManager.SetTextureParameters<ProgramType::ShipSpringsTexture>();
-    mShaderManager.ActivateProgram<ProgramType::ShipSpringsTextureStress>();
+    mShaderManager.ActivateProgramForParameters<ProgramType::ShipSpringsTextureStress>();
     mShaderManager.SetTextureParameters<ProgramType::ShipSpringsTextureStress>();
-    mShaderManager.ActivateProgram<ProgramType::ShipSpringsTextureHeatOverlay>();
+    mShaderManager.ActivateProgramForParameters<ProgramType::ShipSpringsTextureHeatOverlay>();
     mShaderManager.SetTextureParameters<ProgramType::ShipSpringsTextureHeatOverlay>();
-    mShaderManager.ActivateProgram<ProgramType::ShipSpringsTextureHeatOverlayStress>();
+    mShaderManager.ActivateProgramForParameters<ProgramType::ShipSpringsTextureHeatOverlayStress>();
     mShaderManager.SetTextureParameters<ProgramType::ShipSpringsTextureHeatOverlayStress>();
-    mShaderManager.ActivateProgram<ProgramType::ShipSpringsTextureIncandescence>();
+    mShaderManager.ActivateProgramForParameters<ProgramType::ShipSpringsTextureIncandescence>();
     mShaderManager.SetTextureParameters<ProgramType::ShipSpringsTextureIncandescence>();
-    mShaderManager.ActivateProgram<ProgramType::ShipSpringsTextureIncandescenceStress>();
+    mShaderManager.ActivateProgramForParameters<ProgramType::ShipSpringsTextureIncandescenceStress>();
     mShaderManager.SetTextureParameters<ProgramType::ShipSpringsTextureIncandescenceStress>();
-    mShaderManager.ActivateProgram<ProgramType::ShipTrianglesTexture>();
+    mShaderManager.ActivateProgramForParameters<ProgramType::ShipTrianglesTexture>();
     mShaderManager.SetTextureParameters<ProgramType::ShipTrianglesTexture>();
-    mShaderManager.ActivateProgram<ProgramType::ShipTrianglesTextureStress>();
+    mShaderManager.ActivateProgramForParameters<ProgramType::ShipTrianglesTextureStress>();
     mShaderManager.SetTextureParameters<ProgramType::ShipTrianglesTextureStress>();
-    mShaderManager.ActivateProgram<ProgramType::ShipTrianglesTextureHeatOverlay>();
+    mShaderManager.ActivateProgramForParameters<ProgramType::ShipTrianglesTextureHeatOverlay>();
     mShaderManager.SetTextureParameters<ProgramType::ShipTrianglesTextureHeatOverlay>();
-    mShaderManager.ActivateProgram<ProgramType::ShipTrianglesTextureHeatOverlayStress>();
+    mShaderManager.ActivateProgramForParameters<ProgramType::ShipTrianglesTextureHeatOverlayStress>();
     mShaderManager.SetTextureParameters<ProgramType::ShipTrianglesTextureHeatOverlayStress>();
-    mShaderManager.ActivateProgram<ProgramType::ShipTrianglesTextureIncandescence>();
+    mShaderManager.ActivateProgramForParameters<ProgramType::ShipTrianglesTextureIncandescence>();
     mShaderManager.SetTextureParameters<ProgramType::ShipTrianglesTextureIncandescence>();
-    mShaderManager.ActivateProgram<ProgramType::ShipTrianglesTextureIncandescenceStress>();
+    mShaderManager.ActivateProgramForParameters<ProgramType::ShipTrianglesTextureIncandescenceStress>();
     mShaderManager.SetTextureParameters<ProgramType::ShipTrianglesTextureIncandescenceStress>();
 
     // Unbind texture
@@ -656,6 +860,7 @@ ShipRenderContext::ShipRenderContext(
 
 ShipRenderContext::~ShipRenderContext()
 {
+    // A compression still in progress owns its data, hence we may just forget about it
 }
 
 //////////////////////////////////////////////////////////////////////////////////
@@ -725,13 +930,24 @@ void ShipRenderContext::UploadPointImmutableAttributes(vec2f const * textureCoor
     // Uploaded only once, but we treat them as if they could
     // be uploaded any time
 
-    // Interleave texture coordinates into AttributeGroup1 buffer
-    vec4f * restrict pDst = mPointAttributeGroup1Buffer.get();
-    vec2f const * restrict pSrc = textureCoordinates;
+    // Interleave texture coordinates into AttributeGroup1 buffers
+    for (auto & buffer : mPointAttributeGroup1Buffers)
+    {
+        vec4f * restrict pDst = buffer.get();
+        vec2f const * restrict pSrc = textureCoordinates;
+        for (size_t i = 0; i < mPointCount; ++i)
+        {
+            pDst[i].z = pSrc[i].x;
+            pDst[i].w = pSrc[i].y;
+        }
+    }
+
+    // Assign each point to the culling tile of its texture coordinates
     for (size_t i = 0; i < mPointCount; ++i)
     {
-        pDst[i].z = pSrc[i].x;
-        pDst[i].w = pSrc[i].y;
+        auto const tileX = std::clamp(static_cast<int>(textureCoordinates[i].x * static_cast<float>(CullingTileGridSize)), 0, static_cast<int>(CullingTileGridSize) - 1);
+        auto const tileY = std::clamp(static_cast<int>(textureCoordinates[i].y * static_cast<float>(CullingTileGridSize)), 0, static_cast<int>(CullingTileGridSize) - 1);
+        mPointTextureCullingTileIndices[i] = static_cast<std::uint8_t>(tileY * CullingTileGridSize + tileX);
     }
 }
 
@@ -747,21 +963,51 @@ void ShipRenderContext::UploadPointMutableAttributes(
 {
     // Uploaded at each cycle
 
-    // Interleave positions into AttributeGroup1 buffer, and
-    // light and water into AttributeGroup2 buffer
+    // Interleave positions into AttributeGroup1 upload buffer, and
+    // light and water into AttributeGroup2 upload buffer
     vec2f const * const restrict pSrc1 = position;
     float const * const restrict pSrc2 = light;
     float const * const restrict pSrc3 = water;
-    vec4f * restrict const pDst1 = mPointAttributeGroup1Buffer.get();
-    vec4f * restrict const pDst2 = mPointAttributeGroup2Buffer.get();
-    for (size_t i = 0; i < mPointCount; ++i)
+    std::uint8_t const * const restrict pCullingTiles = mPointCullingTileIndices.data();
+
+    // We also calculate the culling tiles' bounding boxes while we're at it
+    mCullingTileAABBs.fill(Geometry::AABB());
+
+    if (mDoStreamPointAttributes)
+    {
+        // Write whole vertices straight into the GPU-visible segments, taking the
+        // sparse attributes from the upload buffers
+        vec4f const * const restrict pSparse1 = mPointAttributeGroup1Buffers[mPointAttributeUploadBufferIndex].get();
+        vec4f const * const restrict pSparse2 = mPointAttributeGroup2Buffers[mPointAttributeUploadBufferIndex].get();
+        vec4f * restrict const pDst1 = mPointAttributeGroup1StreamBuffer.GetWriteSegment();
+        vec4f * restrict const pDst2 = mPointAttributeGroup2StreamBuffer.GetWriteSegment();
+        for (size_t i = 0; i < mPointCount; ++i)
+        {
+            pDst1[i] = vec4f(pSrc1[i].x, pSrc1[i].y, pSparse1[i].z, pSparse1[i].w);
+            pDst2[i] = vec4f(pSrc2[i], pSrc3[i], pSparse2[i].z, pSparse2[i].w);
+
+            if (pCullingTiles[i] != NoneCullingTileIndex)
+                mCullingTileAABBs[pCullingTiles[i]].ExtendTo(pSrc1[i]);
+        }
+    }
+    else
     {
-        pDst1[i].x = pSrc1[i].x;
-        pDst1[i].y = pSrc1[i].y;
+        vec4f * restrict const pDst1 = mPointAttributeGroup1Buffers[mPointAttributeUploadBufferIndex].get();
+        vec4f * restrict const pDst2 = mPointAttributeGroup2Buffers[mPointAttributeUploadBufferIndex].get();
+        for (size_t i = 0; i < mPointCount; ++i)
+        {
+            pDst1[i].x = pSrc1[i].x;
+            pDst1[i].y = pSrc1[i].y;
 
-        pDst2[i].x = pSrc2[i];
-        pDst2[i].y = pSrc3[i];
+            pDst2[i].x = pSrc2[i];
+            pDst2[i].y = pSrc3[i];
+
+            if (pCullingTiles[i] != NoneCullingTileIndex)
+                mCullingTileAABBs[pCullingTiles[i]].ExtendTo(pSrc1[i]);
+        }
     }
+
+    mArePointMutableAttributesUploaded = true;
 }
 
 void ShipRenderContext::UploadPointMutableAttributesPlaneId(
@@ -772,12 +1018,24 @@ void ShipRenderContext::UploadPointMutableAttributesPlaneId(
     // Uploaded sparingly, but we treat them as if they could
     // be uploaded at any time
 
-    // Interleave plane ID into AttributeGroup2 buffer
+    // Interleave plane ID into AttributeGroup2 buffers
     assert(startDst + count <= mPointCount);
-    vec4f * restrict pDst = &(mPointAttributeGroup2Buffer.get()[startDst]);
-    float const * restrict pSrc = planeId;
-    for (size_t i = 0; i < count; ++i)
-        pDst[i].z = pSrc[i];
+    for (auto & buffer : mPointAttributeGroup2Buffers)
+    {
+        vec4f * restrict pDst = &(buffer.get()[startDst]);
+        float const * restrict pSrc = planeId;
+        for (size_t i = 0; i < count; ++i)
+            pDst[i].z = pSrc[i];
+    }
+
+    if (mDoStreamPointAttributes && mArePointMutableAttributesUploaded)
+    {
+        // The write segment has been completed already
+        vec4f * restrict pDst = &(mPointAttributeGroup2StreamBuffer.GetWriteSegment()[startDst]);
+        float const * restrict pSrc = planeId;
+        for (size_t i = 0; i < count; ++i)
+            pDst[i].z = pSrc[i];
+    }
 }
 
 void ShipRenderContext::UploadPointMutableAttributesDecay(
@@ -788,12 +1046,24 @@ void ShipRenderContext::UploadPointMutableAttributesDecay(
     // Uploaded sparingly, but we treat them as if they could
     // be uploaded at any time
 
-    // Interleave decay into AttributeGroup2 buffer
+    // Interleave decay into AttributeGroup2 buffers
     assert(startDst + count <= mPointCount);
-    vec4f * restrict pDst = &(mPointAttributeGroup2Buffer.get()[startDst]);
-    float const * restrict pSrc = decay;
-    for (size_t i = 0; i < count; ++i)
-        pDst[i].w = pSrc[i];
+    for (auto & buffer : mPointAttributeGroup2Buffers)
+    {
+        vec4f * restrict pDst = &(buffer.get()[startDst]);
+        float const * restrict pSrc = decay;
+        for (size_t i = 0; i < count; ++i)
+            pDst[i].w = pSrc[i];
+    }
+
+    if (mDoStreamPointAttributes && mArePointMutableAttributesUploaded)
+    {
+        // The write segment has been completed already
+        vec4f * restrict pDst = &(mPointAttributeGroup2StreamBuffer.GetWriteSegment()[startDst]);
+        float const * restrict pSrc = decay;
+        for (size_t i = 0; i < count; ++i)
+            pDst[i].w = pSrc[i];
+    }
 }
 
 void ShipRenderContext::UploadPointMutableAttributesEnd()
@@ -816,12 +1086,9 @@ void ShipRenderContext::UploadPointColors(
 
     assert(startDst + count <= mPointCount);
 
-    glBindBuffer(GL_ARRAY_BUFFER, *mPointColorVBO);
-
-    glBufferSubData(GL_ARRAY_BUFFER, startDst * sizeof(vec4f), count * sizeof(vec4f), color);
-    CheckOpenGLError();
+    Algorithms::PackColorsToRgba8(color, mPointColorUploadBuffer.get(), count);
 
-    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    GameOpenGL::UploadBufferSubData(GL_ARRAY_BUFFER, *mPointColorVBO, startDst * sizeof(rgbaColor), count * sizeof(rgbaColor), mPointColorUploadBuffer.get());
 }
 
 void ShipRenderContext::UploadPointTemperature(
@@ -837,12 +1104,17 @@ void ShipRenderContext::UploadPointTemperature(
 
     assert(startDst + count <= mPointCount);
 
-    glBindBuffer(GL_ARRAY_BUFFER, *mPointTemperatureVBO);
-
-    glBufferSubData(GL_ARRAY_BUFFER, startDst * sizeof(float), count * sizeof(float), temperature);
-    CheckOpenGLError();
+    if (mDoStorePointTemperatureAsHalfFloat)
+    {
+        // Plenty of precision for incandescence
+        Algorithms::PackFloatsToHalfFloats(temperature, mPointTemperatureUploadBuffer.get(), count);
 
-    glBindBuffer(GL_ARRAY_BUFFER, 0);
+        GameOpenGL::UploadBufferSubData(GL_ARRAY_BUFFER, *mPointTemperatureVBO, startDst * sizeof(std::uint16_t), count * sizeof(std::uint16_t), mPointTemperatureUploadBuffer.get());
+    }
+    else
+    {
+        GameOpenGL::UploadBufferSubData(GL_ARRAY_BUFFER, *mPointTemperatureVBO, startDst * sizeof(float), count * sizeof(float), temperature);
+    }
 }
 
 void ShipRenderContext::UploadPointStress(
@@ -858,12 +1130,7 @@ void ShipRenderContext::UploadPointStress(
 
     assert(startDst + count <= mPointCount);
 
-    glBindBuffer(GL_ARRAY_BUFFER, *mPointStressVBO);
-
-    glBufferSubData(GL_ARRAY_BUFFER, startDst * sizeof(float), count * sizeof(float), stress);
-    CheckOpenGLError();
-
-    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    GameOpenGL::UploadBufferSubData(GL_ARRAY_BUFFER, *mPointStressVBO, startDst * sizeof(float), count * sizeof(float), stress);
 }
 
 void ShipRenderContext::UploadPointAuxiliaryData(
@@ -877,26 +1144,21 @@ void ShipRenderContext::UploadPointAuxiliaryData(
     // Upload aux data
     //
 
-    glBindBuffer(GL_ARRAY_BUFFER, *mPointAuxiliaryDataVBO);
-
-    glBufferSubData(GL_ARRAY_BUFFER, startDst * sizeof(float), count * sizeof(float), auxiliaryData);
-    CheckOpenGLError();
-
-    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    GameOpenGL::UploadBufferSubData(GL_ARRAY_BUFFER, *mPointAuxiliaryDataVBO, startDst * sizeof(float), count * sizeof(float), auxiliaryData);
 }
 
-void ShipRenderContext::UploadPointFrontierColors(FrontierColor const * colors)
+void ShipRenderContext::UploadPointFrontierColors(
+    FrontierColor const * colors,
+    size_t startDst,
+    size_t count)
 {
     // Uploaded sparingly
 
     // We've been invoked on the render thread
 
-    glBindBuffer(GL_ARRAY_BUFFER, *mPointFrontierColorVBO);
-
-    glBufferSubData(GL_ARRAY_BUFFER, 0, mPointCount * sizeof(FrontierColor), colors);
-    CheckOpenGLError();
+    assert(startDst + count <= mPointCount);
 
-    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    GameOpenGL::UploadBufferSubData(GL_ARRAY_BUFFER, *mPointFrontierColorVBO, startDst * sizeof(FrontierColor), count * sizeof(FrontierColor), colors);
 }
 
 void ShipRenderContext::UploadElementsStart()
@@ -921,16 +1183,83 @@ void ShipRenderContext::UploadElementTrianglesStart(size_t trianglesCount)
     // No need to clear, we'll repopulate everything
 
     mTriangleElementBuffer.resize(trianglesCount);
+    mTriangleElementIdBuffer.resize(trianglesCount);
 }
 
 void ShipRenderContext::UploadElementTrianglesEnd()
 {
-    // Nop
+    //
+    // Bucket triangles by culling tile, separately within each run of triangles
+    // of the same plane - so to maintain their plane order
+    //
+    // Note: plane IDs have been uploaded already in this same upload
+    //
+
+    vec4f const * const pointAttributeGroup2 = mPointAttributeGroup2Buffers[mPointAttributeUploadBufferIndex].get();
+
+    mTriangleElementBuckets.clear();
+
+    size_t planeStartElement = 0;
+    while (planeStartElement < mTriangleElementBuffer.size())
+    {
+        float const planeId = pointAttributeGroup2[mTriangleElementBuffer[planeStartElement].pointIndex1].z;
+
+        size_t planeEndElement = planeStartElement + 1;
+        while (planeEndElement < mTriangleElementBuffer.size()
+            && pointAttributeGroup2[mTriangleElementBuffer[planeEndElement].pointIndex1].z == planeId)
+        {
+            ++planeEndElement;
+        }
+
+        BucketElementsByCullingTile(
+            mTriangleElementBuffer,
+            planeStartElement,
+            planeEndElement,
+            mTriangleElementBucketingBuffer,
+            mTriangleElementBuckets,
+            &mTriangleElementIdBuffer);
+
+        planeStartElement = planeEndElement;
+    }
+
+    //
+    // Remember where each triangle ended up, for tombstoning it later
+    //
+
+    mTriangleElementSlots.clear();
+
+    for (size_t t = 0; t < mTriangleElementIdBuffer.size(); ++t)
+    {
+        ElementIndex const triangleElementIndex = mTriangleElementIdBuffer[t];
+        if (triangleElementIndex >= mTriangleElementSlots.size())
+        {
+            mTriangleElementSlots.resize(triangleElementIndex + 1, std::numeric_limits<size_t>::max());
+        }
+
+        mTriangleElementSlots[triangleElementIndex] = t;
+    }
+
+    mIsTriangleElementBufferDirty = true;
+    mTriangleElementTombstoneSlots.clear();
+    mAreElementBuffersDirty = true;
 }
 
 void ShipRenderContext::UploadElementsEnd()
 {
-    // Nop
+    //
+    // Bucket springs by culling tile
+    //
+
+    mSpringElementBuckets.clear();
+
+    BucketElementsByCullingTile(
+        mSpringElementBuffer,
+        0,
+        mSpringElementBuffer.size(),
+        mSpringElementBucketingBuffer,
+        mSpringElementBuckets);
+
+    RecalculatePointCullingTiles();
 }
 
 void ShipRenderContext::UploadElementStressedSpringsStart()
@@ -971,7 +1300,7 @@ void ShipRenderContext::UploadElectricSparksStart(size_t count)
     // Electric sparks are not sticky: we upload them at each frame
     //
 
-    mElectricSparkVertexBuffer.reset(6 * count);
+    mElectricSparkVertexBuffer.reset(4 * count);
 }
 
 void ShipRenderContext::UploadElectricSparksEnd()
@@ -986,7 +1315,7 @@ void ShipRenderContext::UploadFlamesStart(size_t count)
     // though they will be empty most of the time
     //
 
-    mFlameVertexBuffer.reset(6 * count);
+    mFlameVertexBuffer.reset(4 * count);
 
     mFlameBackgroundCount = 0;
     mFlameForegroundCount = 0;
@@ -994,7 +1323,7 @@ void ShipRenderContext::UploadFlamesStart(size_t count)
 
 void ShipRenderContext::UploadFlamesEnd()
 {
-    assert((mFlameBackgroundCount + mFlameForegroundCount) * 6u == mFlameVertexBuffer.size());
+    assert((mFlameBackgroundCount + mFlameForegroundCount) * 4u == mFlameVertexBuffer.size());
 
     // Nop
 }
@@ -1085,7 +1414,22 @@ void ShipRenderContext::UploadPointToPointArrowsEnd()
 
 void ShipRenderContext::UploadEnd()
 {
-    // Nop
+    // Swap point attribute buffers, if we've uploaded into the upload buffer;
+    // the render thread is not reading the render buffer at this moment
+    if (mArePointMutableAttributesUploaded)
+    {
+        if (mDoStreamPointAttributes)
+        {
+            mPointAttributeGroup1StreamBuffer.CommitWriteSegment();
+            mPointAttributeGroup2StreamBuffer.CommitWriteSegment();
+        }
+        else
+        {
+            std::swap(mPointAttributeUploadBufferIndex, mPointAttributeRenderBufferIndex);
+        }
+
+        mArePointMutableAttributesUploaded = false;
+    }
 }
 
 void ShipRenderContext::ProcessParameterChanges(RenderParameters const & renderParameters)
@@ -1150,25 +1494,69 @@ void ShipRenderContext::RenderPrepare(RenderParameters const & renderParameters)
 {
     // We've been invoked on the render thread
 
-    //
-    // Upload Point AttributeGroup1 buffer
-    //
+    if (mShipTextureUpload)
+    {
+        UploadShipTextureChunk();
+    }
 
-    glBindBuffer(GL_ARRAY_BUFFER, *mPointAttributeGroup1VBO);
+    if (mShipTextureCompressionCompletionIndicator
+        && mShipTextureCompressionCompletionIndicator->IsCompleted())
+    {
+        SwapInCompressedShipTexture();
+    }
 
-    glBufferSubData(GL_ARRAY_BUFFER, 0, mPointCount * sizeof(vec4f), mPointAttributeGroup1Buffer.get());
-    CheckOpenGLError();
+    if (mDoStreamPointAttributes)
+    {
+        //
+        // Point attributes are already in GPU-visible memory; just point the VAO
+        // at the segments to be rendered, if they've changed
+        //
 
-    //
-    // Upload Point AttributeGroup2 buffer
-    //
+        size_t const renderSegmentByteOffset = mPointAttributeGroup1StreamBuffer.GetRenderSegmentByteOffset();
+        assert(mPointAttributeGroup2StreamBuffer.GetRenderSegmentByteOffset() == renderSegmentByteOffset);
 
-    glBindBuffer(GL_ARRAY_BUFFER, *mPointAttributeGroup2VBO);
+        if (renderSegmentByteOffset != mPointAttributeStreamBoundByteOffset)
+        {
+            glBindVertexArray(*mShipVAO);
 
-    glBufferSubData(GL_ARRAY_BUFFER, 0, mPointCount * sizeof(vec4f), mPointAttributeGroup2Buffer.get());
-    CheckOpenGLError();
+            glBindBuffer(GL_ARRAY_BUFFER, mPointAttributeGroup1StreamBuffer.GetVBO());
+            glVertexAttribPointer(static_cast<GLuint>(VertexAttributeType::ShipPointAttributeGroup1), 4, GL_FLOAT, GL_FALSE, sizeof(vec4f), (void *)(renderSegmentByteOffset));
 
-    glBindBuffer(GL_ARRAY_BUFFER, 0);
+            glBindBuffer(GL_ARRAY_BUFFER, mPointAttributeGroup2StreamBuffer.GetVBO());
+            glVertexAttribPointer(static_cast<GLuint>(VertexAttributeType::ShipPointAttributeGroup2), 4, GL_FLOAT, GL_FALSE, sizeof(vec4f), (void *)(renderSegmentByteOffset));
+            CheckOpenGLError();
+
+            glBindVertexArray(0);
+
+            glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+            mPointAttributeStreamBoundByteOffset = renderSegmentByteOffset;
+        }
+    }
+    else
+    {
+        //
+        // Upload Point AttributeGroup1 buffer
+        //
+
+        GameOpenGL::UploadBufferSubData(
+            GL_ARRAY_BUFFER,
+            *mPointAttributeGroup1VBO,
+            0,
+            mPointCount * sizeof(vec4f),
+            mPointAttributeGroup1Buffers[mPointAttributeRenderBufferIndex].get());
+
+        //
+        // Upload Point AttributeGroup2 buffer
+        //
+
+        GameOpenGL::UploadBufferSubData(
+            GL_ARRAY_BUFFER,
+            *mPointAttributeGroup2VBO,
+            0,
+            mPointCount * sizeof(vec4f),
+            mPointAttributeGroup2Buffers[mPointAttributeRenderBufferIndex].get());
+    }
 
     //
     // Upload element buffers, if needed
@@ -1181,31 +1569,46 @@ void ShipRenderContext::RenderPrepare(RenderParameters const & renderParameters)
         // of each element type which we'll need at primitives' render time
         //
 
+        DecimateRopeElements();
+
         // Note: byte-granularity indices
         mTriangleElementVBOStartIndex = 0;
         mRopeElementVBOStartIndex = mTriangleElementVBOStartIndex + mTriangleElementBuffer.size() * sizeof(TriangleElement);
-        mSpringElementVBOStartIndex = mRopeElementVBOStartIndex + mRopeElementBuffer.size() * sizeof(LineElement);
+        mDecimatedRopeElementVBOStartIndex = mRopeElementVBOStartIndex + mRopeElementBuffer.size() * sizeof(LineElement);
+        mSpringElementVBOStartIndex = mDecimatedRopeElementVBOStartIndex + mDecimatedRopeElementBuffer.size() * sizeof(LineElement);
         mPointElementVBOStartIndex = mSpringElementVBOStartIndex + mSpringElementBuffer.size() * sizeof(LineElement);
         mEphemeralPointElementVBOStartIndex = mPointElementVBOStartIndex + mPointElementBuffer.size() * sizeof(PointElement);
         size_t requiredIndexSize = mEphemeralPointElementVBOStartIndex + mEphemeralPointElementBuffer.size() * sizeof(PointElement);
 
         glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, *mElementVBO);
 
-        if (mElementVBOAllocatedIndexSize != requiredIndexSize)
+        if (mElementVBOAllocatedIndexSize < requiredIndexSize)
         {
-            // Re-allocate VBO buffer
-            glBufferData(GL_ELEMENT_ARRAY_BUFFER, requiredIndexSize, nullptr, GL_STATIC_DRAW);
+            // Re-allocate VBO buffer, with some slack so that we don't re-allocate
+            // at each change in the number of (ephemeral) elements
+            size_t const newIndexSize = requiredIndexSize + requiredIndexSize / 4;
+            glBufferData(GL_ELEMENT_ARRAY_BUFFER, newIndexSize, nullptr, GL_STATIC_DRAW);
             CheckOpenGLError();
 
-            mElementVBOAllocatedIndexSize = requiredIndexSize;
+            mElementVBOAllocatedIndexSize = newIndexSize;
+
+            // Triangles are gone as well
+            mIsTriangleElementBufferDirty = true;
         }
 
-        // Upload triangles
-        glBufferSubData(
-            GL_ELEMENT_ARRAY_BUFFER,
-            mTriangleElementVBOStartIndex,
-            mTriangleElementBuffer.size() * sizeof(TriangleElement),
-            mTriangleElementBuffer.data());
+        // Upload triangles, but only if they have changed wholesale;
+        // tombstones are taken care of below
+        if (mIsTriangleElementBufferDirty)
+        {
+            glBufferSubData(
+                GL_ELEMENT_ARRAY_BUFFER,
+                mTriangleElementVBOStartIndex,
+                mTriangleElementBuffer.size() * sizeof(TriangleElement),
+                mTriangleElementBuffer.data());
+
+            mIsTriangleElementBufferDirty = false;
+            mTriangleElementTombstoneSlots.clear();
+        }
 
         // Upload ropes
         glBufferSubData(
@@ -1214,6 +1617,13 @@ void ShipRenderContext::RenderPrepare(RenderParameters const & renderParameters)
             mRopeElementBuffer.size() * sizeof(LineElement),
             mRopeElementBuffer.data());
 
+        // Upload decimated ropes
+        glBufferSubData(
+            GL_ELEMENT_ARRAY_BUFFER,
+            mDecimatedRopeElementVBOStartIndex,
+            mDecimatedRopeElementBuffer.size() * sizeof(LineElement),
+            mDecimatedRopeElementBuffer.data());
+
         // Upload springs
         glBufferSubData(
             GL_ELEMENT_ARRAY_BUFFER,
@@ -1242,6 +1652,41 @@ void ShipRenderContext::RenderPrepare(RenderParameters const & renderParameters)
         mAreElementBuffersDirty = false;
     }
 
+    if (!mTriangleElementTombstoneSlots.empty())
+    {
+        //
+        // Upload tombstoned triangles, coalescing adjacent slots
+        //
+
+        std::sort(
+            mTriangleElementTombstoneSlots.begin(),
+            mTriangleElementTombstoneSlots.end());
+
+        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, *mElementVBO);
+
+        for (size_t s = 0; s < mTriangleElementTombstoneSlots.size(); )
+        {
+            size_t const startSlot = mTriangleElementTombstoneSlots[s];
+            size_t endSlot = startSlot + 1;
+            for (++s; s < mTriangleElementTombstoneSlots.size() && mTriangleElementTombstoneSlots[s] <= endSlot; ++s)
+            {
+                endSlot = mTriangleElementTombstoneSlots[s] + 1;
+            }
+
+            glBufferSubData(
+                GL_ELEMENT_ARRAY_BUFFER,
+                mTriangleElementVBOStartIndex + startSlot * sizeof(TriangleElement),
+                (endSlot - startSlot) * sizeof(TriangleElement),
+                mTriangleElementBuffer.data() + startSlot);
+        }
+
+        CheckOpenGLError();
+
+        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+
+        mTriangleElementTombstoneSlots.clear();
+    }
+
     //
     // Prepare flames
     //
@@ -1382,6 +1827,13 @@ void ShipRenderContext::RenderDraw(
 {
     // We've been invoked on the render thread
 
+    RecalculateVisibleCullingTiles(renderParameters);
+
+    // Check whether we're zoomed out so much that we may draw at a lower level of detail
+    bool const isLowDetail =
+        renderParameters.DebugShipRenderMode == DebugShipRenderModeType::None
+        && renderParameters.View.GetCanvasToVisibleWorldHeightRatio() < LowDetailCanvasToWorldRatio;
+
     //
     // Render background flames
     //
@@ -1458,14 +1910,15 @@ void ShipRenderContext::RenderDraw(
                 glLineWidth(0.1f);
 
             // Draw!
-            glDrawElements(
+            size_t const drawnTriangles = DrawCulledElements(
                 GL_TRIANGLES,
-                static_cast<GLsizei>(3 * mTriangleElementBuffer.size()),
-                GL_UNSIGNED_INT,
-                (GLvoid *)mTriangleElementVBOStartIndex);
+                3,
+                mTriangleElementVBOStartIndex,
+                mTriangleElementBuckets,
+                mTriangleElementBuffer.size());
 
             // Update stats
-            renderStats.LastRenderedShipTriangles += mTriangleElementBuffer.size();
+            renderStats.LastRenderedShipTriangles += drawnTriangles;
         }
 
         //
@@ -1486,14 +1939,16 @@ void ShipRenderContext::RenderDraw(
         {
             mShaderManager.ActivateProgram(mShipRopesProgram);
 
+            auto const & ropeElementBuffer = isLowDetail ? mDecimatedRopeElementBuffer : mRopeElementBuffer;
+
             glDrawElements(
                 GL_LINES,
-                static_cast<GLsizei>(2 * mRopeElementBuffer.size()),
+                static_cast<GLsizei>(2 * ropeElementBuffer.size()),
                 GL_UNSIGNED_INT,
-                (GLvoid *)mRopeElementVBOStartIndex);
+                (GLvoid *)(isLowDetail ? mDecimatedRopeElementVBOStartIndex : mRopeElementVBOStartIndex));
 
             // Update stats
-            renderStats.LastRenderedShipRopes += mRopeElementBuffer.size();
+            renderStats.LastRenderedShipRopes += ropeElementBuffer.size();
         }
 
         //
@@ -1506,16 +1961,19 @@ void ShipRenderContext::RenderDraw(
         // - DebugRenderMode is none, in which case we use texture - so to draw 1D chains and edge springs
         // - DebugRenderMode is decay|internalPressure|strength, in which case we use the special rendering
         //
+        // ...unless we're rendering at low detail, in which case springs would be smaller than a pixel.
+        //
         // Note: when DebugRenderMode is springs|edgeSprings, ropes would all be here.
         //
 
-        if (renderParameters.DebugShipRenderMode == DebugShipRenderModeType::Springs
+        if (!isLowDetail &&
+            (renderParameters.DebugShipRenderMode == DebugShipRenderModeType::Springs
             || renderParameters.DebugShipRenderMode == DebugShipRenderModeType::EdgeSprings
             || renderParameters.DebugShipRenderMode == DebugShipRenderModeType::Structure
             || renderParameters.DebugShipRenderMode == DebugShipRenderModeType::None
             || renderParameters.DebugShipRenderMode == DebugShipRenderModeType::Decay
             || renderParameters.DebugShipRenderMode == DebugShipRenderModeType::InternalPressure
-            || renderParameters.DebugShipRenderMode == DebugShipRenderModeType::Strength)
+            || renderParameters.DebugShipRenderMode == DebugShipRenderModeType::Strength))
         {
             if (renderParameters.DebugShipRenderMode == DebugShipRenderModeType::Decay)
             {
@@ -1534,14 +1992,15 @@ void ShipRenderContext::RenderDraw(
                 mShaderManager.ActivateProgram(mShipSpringsProgram);
             }
 
-            glDrawElements(
+            size_t const drawnSprings = DrawCulledElements(
                 GL_LINES,
-                static_cast<GLsizei>(2 * mSpringElementBuffer.size()),
-                GL_UNSIGNED_INT,
-                (GLvoid *)mSpringElementVBOStartIndex);
+                2,
+                mSpringElementVBOStartIndex,
+                mSpringElementBuckets,
+                mSpringElementBuffer.size());
 
             // Update stats
-            renderStats.LastRenderedShipSprings += mSpringElementBuffer.size();
+            renderStats.LastRenderedShipSprings += drawnSprings;
         }
 
         //
@@ -1598,14 +2057,17 @@ void ShipRenderContext::RenderDraw(
         }
 
         //
-        // Draw points (orphaned/all non-ephemerals, and ephemerals)
+        // Draw points (orphaned/all non-ephemerals, and ephemerals - unless we're rendering
+        // at low detail, in which case ephemerals would be smaller than a pixel)
         //
 
         if (renderParameters.DebugShipRenderMode == DebugShipRenderModeType::Points
             || renderParameters.DebugShipRenderMode == DebugShipRenderModeType::Structure
             || renderParameters.DebugShipRenderMode == DebugShipRenderModeType::None)
         {
-            size_t const totalPoints = mPointElementBuffer.size() + mEphemeralPointElementBuffer.size();
+            size_t const totalPoints = isLowDetail
+                ? mPointElementBuffer.size()
+                : mPointElementBuffer.size() + mEphemeralPointElementBuffer.size();
 
             if (totalPoints > 0)
             {
@@ -1697,6 +2159,17 @@ void ShipRenderContext::RenderDraw(
 
     RenderDrawPointToPointArrows(renderParameters);
 
+    //
+    // Fence streamed point attributes
+    //
+
+    if (mDoStreamPointAttributes)
+    {
+        // All draw calls reading the render segments have been issued
+        mPointAttributeGroup1StreamBuffer.FenceRenderSegmentAndWaitForWriteSegment();
+        mPointAttributeGroup2StreamBuffer.FenceRenderSegmentAndWaitForWriteSegment();
+    }
+
     //
     // Update stats
     //
@@ -1706,6 +2179,84 @@ void ShipRenderContext::RenderDraw(
 
 /////////////////////////////////////////////////////////////////////////////////////////////
 
+void ShipRenderContext::SwapInCompressedShipTexture()
+{
+    auto const completionIndicator = std::move(mShipTextureCompressionCompletionIndicator);
+    auto const compressedLevels = std::move(mCompressedShipTextureLevels);
+
+    try
+    {
+        completionIndicator->Wait();
+
+        GLuint tmpGLuint;
+        glGenTextures(1, &tmpGLuint);
+        GameOpenGLTexture compressedTextureOpenGLHandle(tmpGLuint);
+
+        mShaderManager.ActivateTexture<ProgramParameterType::SharedTexture>();
+        glBindTexture(GL_TEXTURE_2D, *compressedTextureOpenGLHandle);
+        CheckOpenGLError();
+
+        GameOpenGL::UploadCompressedMipmappedBC3Texture(*compressedLevels);
+
+        // Same parameters as the uncompressed texture
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_NEAREST);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+        CheckOpenGLError();
+
+        glBindTexture(GL_TEXTURE_2D, 0);
+
+        // Swap it in, releasing the uncompressed texture - or its placeholder, superseding its upload
+        mShipTextureOpenGLHandle = std::move(compressedTextureOpenGLHandle);
+        mShipTextureUpload.reset();
+    }
+    catch (std::exception const & ex)
+    {
+        // Not fatal, we just keep the uncompressed texture
+        LogMessage("ShipRenderContext: error compressing ship texture: ", ex.what());
+    }
+}
+
+void ShipRenderContext::UploadShipTextureChunk()
+{
+    assert(mShipTextureUpload);
+    auto & upload = *mShipTextureUpload;
+
+    ImageSize const & textureSize = upload.Source.Size;
+
+    int const chunkRowCount = std::min(
+        std::max(static_cast<int>(ShipTextureUploadChunkPixels / static_cast<size_t>(textureSize.width)), 1),
+        textureSize.height - upload.NextRow);
+
+    mShaderManager.ActivateTexture<ProgramParameterType::SharedTexture>();
+
+    GameOpenGL::UploadTextureRegion(
+        *upload.Texture,
+        upload.Source,
+        ImageRect(ImageCoordinates(0, upload.NextRow), ImageSize(textureSize.width, chunkRowCount)),
+        ImageCoordinates(0, upload.NextRow),
+        !!upload.PixelUnpackBuffer ? *upload.PixelUnpackBuffer : 0);
+
+    upload.NextRow += chunkRowCount;
+
+    if (upload.NextRow == textureSize.height)
+    {
+        //
+        // Done: have the GPU generate the mipmaps, and swap the texture in instead of the placeholder
+        //
+
+        glBindTexture(GL_TEXTURE_2D, *upload.Texture);
+        glGenerateMipmap(GL_TEXTURE_2D);
+        CheckOpenGLError();
+
+        glBindTexture(GL_TEXTURE_2D, 0);
+
+        mShipTextureOpenGLHandle = std::move(upload.Texture);
+        mShipTextureUpload.reset();
+    }
+}
+
 void ShipRenderContext::RenderPrepareElectricSparks(RenderParameters const & /*renderParameters*/)
 {
     if (!mElectricSparkVertexBuffer.empty())
@@ -1728,6 +2279,8 @@ void ShipRenderContext::RenderPrepareElectricSparks(RenderParameters const & /*r
         }
 
         glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+        EnsureQuadElementVBOSize(mElectricSparkVertexBuffer.size() / 4);
     }
 }
 
@@ -1742,13 +2295,47 @@ void ShipRenderContext::RenderDrawElectricSparks(RenderParameters const & render
         if (renderParameters.DebugShipRenderMode == DebugShipRenderModeType::Wireframe)
             glLineWidth(0.1f);
 
-        assert(0 == (mElectricSparkVertexBuffer.size() % 6));
-        glDrawArrays(GL_TRIANGLES, 0, static_cast<GLsizei>(mElectricSparkVertexBuffer.size()));
+        // All sparks in one draw
+        assert(0 == (mElectricSparkVertexBuffer.size() % 4));
+        glDrawElements(GL_TRIANGLES, static_cast<GLsizei>(mElectricSparkVertexBuffer.size() / 4 * 6), GL_UNSIGNED_INT, (GLvoid *)0);
 
         glBindVertexArray(0);
     }
 }
 
+void ShipRenderContext::EnsureQuadElementVBOSize(size_t quadCount)
+{
+    if (quadCount > mQuadElementVBOAllocatedQuadSize)
+    {
+        // Grow generously, as spark and flame counts keep changing
+        size_t const newQuadSize = std::max(quadCount, mQuadElementVBOAllocatedQuadSize * 2);
+
+        std::vector<GLuint> quadElements;
+        quadElements.reserve(newQuadSize * 6);
+        for (GLuint q = 0; q < static_cast<GLuint>(newQuadSize); ++q)
+        {
+            // top-left, bottom-left, top-right
+            quadElements.push_back(q * 4 + 0);
+            quadElements.push_back(q * 4 + 1);
+            quadElements.push_back(q * 4 + 2);
+
+            // bottom-left, top-right, bottom-right
+            quadElements.push_back(q * 4 + 1);
+            quadElements.push_back(q * 4 + 2);
+            quadElements.push_back(q * 4 + 3);
+        }
+
+        // Upload via the array target, so not to disturb the element binding of
+        // whichever VAO is currently bound
+        glBindBuffer(GL_ARRAY_BUFFER, *mQuadElementVBO);
+        glBufferData(GL_ARRAY_BUFFER, quadElements.size() * sizeof(GLuint), quadElements.data(), GL_STATIC_DRAW);
+        CheckOpenGLError();
+        glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+        mQuadElementVBOAllocatedQuadSize = newQuadSize;
+    }
+}
+
 void ShipRenderContext::RenderPrepareFlames()
 {
     //
@@ -1775,6 +2362,8 @@ void ShipRenderContext::RenderPrepareFlames()
         }
 
         glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+        EnsureQuadElementVBOSize(mFlameVertexBuffer.size() / 4);
     }
 
     //
@@ -1805,10 +2394,12 @@ void ShipRenderContext::RenderDrawFlames(
 
         mShaderManager.ActivateProgram<FlameShaderType>();
 
-        glDrawArrays(
+        // Flames are quads of four vertices each, drawn via the quad element buffer
+        glDrawElements(
             GL_TRIANGLES,
-            static_cast<GLint>(startFlameIndex * 6u),
-            static_cast<GLint>(flameCount * 6u));
+            static_cast<GLsizei>(flameCount * 6u),
+            GL_UNSIGNED_INT,
+            (GLvoid *)(startFlameIndex * 6u * sizeof(GLuint)));
 
         glBindVertexArray(0);
 
@@ -2324,7 +2915,7 @@ void ShipRenderContext::ApplyViewModelChanges(RenderParameters const & renderPar
         NLayers,
         shipOrthoMatrix);
 
-    mShaderManager.ActivateProgram(mShipRopesProgram);
+    mShaderManager.ActivateProgramForParameters(mShipRopesProgram);
     mShaderManager.SetProgramParameter<ProgramParameterType::OrthoMatrix>(
         mShipRopesProgram,
         shipOrthoMatrix);
@@ -2343,7 +2934,7 @@ void ShipRenderContext::ApplyViewModelChanges(RenderParameters const & renderPar
         NLayers,
         shipOrthoMatrix);
 
-    mShaderManager.ActivateProgram<ProgramType::ShipFlamesBackground>();
+    mShaderManager.ActivateProgramForParameters<ProgramType::ShipFlamesBackground>();
     mShaderManager.SetProgramParameter<ProgramType::ShipFlamesBackground, ProgramParameterType::OrthoMatrix>(
         shipOrthoMatrix);
 
@@ -2361,20 +2952,20 @@ void ShipRenderContext::ApplyViewModelChanges(RenderParameters const & renderPar
         NLayers,
         shipOrthoMatrix);
 
-    mShaderManager.ActivateProgram(mShipSpringsProgram);
+    mShaderManager.ActivateProgramForParameters(mShipSpringsProgram);
     mShaderManager.SetProgramParameter<ProgramParameterType::OrthoMatrix>(
         mShipSpringsProgram,
         shipOrthoMatrix);
 
-    mShaderManager.ActivateProgram<ProgramType::ShipSpringsDecay>();
+    mShaderManager.ActivateProgramForParameters<ProgramType::ShipSpringsDecay>();
     mShaderManager.SetProgramParameter<ProgramType::ShipSpringsDecay, ProgramParameterType::OrthoMatrix>(
         shipOrthoMatrix);
 
-    mShaderManager.ActivateProgram<ProgramType::ShipSpringsInternalPressure>();
+    mShaderManager.ActivateProgramForParameters<ProgramType::ShipSpringsInternalPressure>();
     mShaderManager.SetProgramParameter<ProgramType::ShipSpringsInternalPressure, ProgramParameterType::OrthoMatrix>(
         shipOrthoMatrix);
 
-    mShaderManager.ActivateProgram<ProgramType::ShipSpringsStrength>();
+    mShaderManager.ActivateProgramForParameters<ProgramType::ShipSpringsStrength>();
     mShaderManager.SetProgramParameter<ProgramType::ShipSpringsStrength, ProgramParameterType::OrthoMatrix>(
         shipOrthoMatrix);
 
@@ -2392,20 +2983,20 @@ void ShipRenderContext::ApplyViewModelChanges(RenderParameters const & renderPar
         NLayers,
         shipOrthoMatrix);
 
-    mShaderManager.ActivateProgram(mShipTrianglesProgram);
+    mShaderManager.ActivateProgramForParameters(mShipTrianglesProgram);
     mShaderManager.SetProgramParameter<ProgramParameterType::OrthoMatrix>(
         mShipTrianglesProgram,
         shipOrthoMatrix);
 
-    mShaderManager.ActivateProgram<ProgramType::ShipTrianglesDecay>();
+    mShaderManager.ActivateProgramForParameters<ProgramType::ShipTrianglesDecay>();
     mShaderManager.SetProgramParameter<ProgramType::ShipTrianglesDecay, ProgramParameterType::OrthoMatrix>(
         shipOrthoMatrix);
 
-    mShaderManager.ActivateProgram<ProgramType::ShipTrianglesInternalPressure>();
+    mShaderManager.ActivateProgramForParameters<ProgramType::ShipTrianglesInternalPressure>();
     mShaderManager.SetProgramParameter<ProgramType::ShipTrianglesInternalPressure, ProgramParameterType::OrthoMatrix>(
         shipOrthoMatrix);
 
-    mShaderManager.ActivateProgram<ProgramType::ShipTrianglesStrength>();
+    mShaderManager.ActivateProgramForParameters<ProgramType::ShipTrianglesStrength>();
     mShaderManager.SetProgramParameter<ProgramType::ShipTrianglesStrength, ProgramParameterType::OrthoMatrix>(
         shipOrthoMatrix);
 
@@ -2423,11 +3014,11 @@ void ShipRenderContext::ApplyViewModelChanges(RenderParameters const & renderPar
         NLayers,
         shipOrthoMatrix);
 
-    mShaderManager.ActivateProgram<ProgramType::ShipStressedSprings>();
+    mShaderManager.ActivateProgramForParameters<ProgramType::ShipStressedSprings>();
     mShaderManager.SetProgramParameter<ProgramType::ShipStressedSprings, ProgramParameterType::OrthoMatrix>(
         shipOrthoMatrix);
 
-    mShaderManager.ActivateProgram<ProgramType::ShipFrontierEdges>();
+    mShaderManager.ActivateProgramForParameters<ProgramType::ShipFrontierEdges>();
     mShaderManager.SetProgramParameter<ProgramType::ShipFrontierEdges, ProgramParameterType::OrthoMatrix>(
         shipOrthoMatrix);
 
@@ -2445,7 +3036,7 @@ void ShipRenderContext::ApplyViewModelChanges(RenderParameters const & renderPar
         NLayers,
         shipOrthoMatrix);
 
-    mShaderManager.ActivateProgram(mShipPointsProgram);
+    mShaderManager.ActivateProgramForParameters(mShipPointsProgram);
     mShaderManager.SetProgramParameter<ProgramParameterType::OrthoMatrix>(
         mShipPointsProgram,
         shipOrthoMatrix);
@@ -2464,15 +3055,15 @@ void ShipRenderContext::ApplyViewModelChanges(RenderParameters const & renderPar
         NLayers,
         shipOrthoMatrix);
 
-    mShaderManager.ActivateProgram<ProgramType::ShipElectricSparks>();
+    mShaderManager.ActivateProgramForParameters<ProgramType::ShipElectricSparks>();
     mShaderManager.SetProgramParameter<ProgramType::ShipElectricSparks, ProgramParameterType::OrthoMatrix>(
         shipOrthoMatrix);
 
-    mShaderManager.ActivateProgram<ProgramType::ShipFlamesForeground>();
+    mShaderManager.ActivateProgramForParameters<ProgramType::ShipFlamesForeground>();
     mShaderManager.SetProgramParameter<ProgramType::ShipFlamesForeground, ProgramParameterType::OrthoMatrix>(
         shipOrthoMatrix);
 
-    mShaderManager.ActivateProgram<ProgramType::ShipJetEngineFlames>();
+    mShaderManager.ActivateProgramForParameters<ProgramType::ShipJetEngineFlames>();
     mShaderManager.SetProgramParameter<ProgramType::ShipJetEngineFlames, ProgramParameterType::OrthoMatrix>(
         shipOrthoMatrix);
 
@@ -2490,7 +3081,7 @@ void ShipRenderContext::ApplyViewModelChanges(RenderParameters const & renderPar
         NLayers,
         shipOrthoMatrix);
 
-    mShaderManager.ActivateProgram<ProgramType::ShipSparkles>();
+    mShaderManager.ActivateProgramForParameters<ProgramType::ShipSparkles>();
     mShaderManager.SetProgramParameter<ProgramType::ShipSparkles, ProgramParameterType::OrthoMatrix>(
         shipOrthoMatrix);
 
@@ -2508,7 +3099,7 @@ void ShipRenderContext::ApplyViewModelChanges(RenderParameters const & renderPar
         NLayers,
         shipOrthoMatrix);
 
-    mShaderManager.ActivateProgram<ProgramType::ShipGenericMipMappedTextures>();
+    mShaderManager.ActivateProgramForParameters<ProgramType::ShipGenericMipMappedTextures>();
     mShaderManager.SetProgramParameter<ProgramType::ShipGenericMipMappedTextures, ProgramParameterType::OrthoMatrix>(
         shipOrthoMatrix);
 
@@ -2526,7 +3117,7 @@ void ShipRenderContext::ApplyViewModelChanges(RenderParameters const & renderPar
         NLayers,
         shipOrthoMatrix);
 
-    mShaderManager.ActivateProgram<ProgramType::ShipExplosions>();
+    mShaderManager.ActivateProgramForParameters<ProgramType::ShipExplosions>();
     mShaderManager.SetProgramParameter<ProgramType::ShipExplosions, ProgramParameterType::OrthoMatrix>(
         shipOrthoMatrix);
 
@@ -2544,15 +3135,15 @@ void ShipRenderContext::ApplyViewModelChanges(RenderParameters const & renderPar
         NLayers,
         shipOrthoMatrix);
 
-    mShaderManager.ActivateProgram<ProgramType::ShipElectricalElementHighlights>();
+    mShaderManager.ActivateProgramForParameters<ProgramType::ShipElectricalElementHighlights>();
     mShaderManager.SetProgramParameter<ProgramType::ShipElectricalElementHighlights, ProgramParameterType::OrthoMatrix>(
         shipOrthoMatrix);
 
-    mShaderManager.ActivateProgram<ProgramType::ShipCircleHighlights>();
+    mShaderManager.ActivateProgramForParameters<ProgramType::ShipCircleHighlights>();
     mShaderManager.SetProgramParameter<ProgramType::ShipCircleHighlights, ProgramParameterType::OrthoMatrix>(
         shipOrthoMatrix);
 
-    mShaderManager.ActivateProgram<ProgramType::ShipCenters>();
+    mShaderManager.ActivateProgramForParameters<ProgramType::ShipCenters>();
     mShaderManager.SetProgramParameter<ProgramType::ShipCenters, ProgramParameterType::OrthoMatrix>(
         shipOrthoMatrix);
 
@@ -2570,11 +3161,11 @@ void ShipRenderContext::ApplyViewModelChanges(RenderParameters const & renderPar
         NLayers,
         shipOrthoMatrix);
 
-    mShaderManager.ActivateProgram<ProgramType::ShipVectors>();
+    mShaderManager.ActivateProgramForParameters<ProgramType::ShipVectors>();
     mShaderManager.SetProgramParameter<ProgramType::ShipVectors, ProgramParameterType::OrthoMatrix>(
         shipOrthoMatrix);
 
-    mShaderManager.ActivateProgram<ProgramType::ShipPointToPointArrows>();
+    mShaderManager.ActivateProgramForParameters<ProgramType::ShipPointToPointArrows>();
     mShaderManager.SetProgramParameter<ProgramType::ShipPointToPointArrows, ProgramParameterType::OrthoMatrix>(
         shipOrthoMatrix);
 }
@@ -2591,52 +3182,52 @@ void ShipRenderContext::ApplyEffectiveAmbientLightIntensityChanges(RenderParamet
 
     if (renderParameters.HeatRenderMode != HeatRenderModeType::HeatOverlay)
     {
-        mShaderManager.ActivateProgram(mShipPointsProgram);
+        mShaderManager.ActivateProgramForParameters(mShipPointsProgram);
         mShaderManager.SetProgramParameter<ProgramParameterType::EffectiveAmbientLightIntensity>(
             mShipPointsProgram,
             effectiveAmbientLightIntensityParamValue);
 
-        mShaderManager.ActivateProgram(mShipRopesProgram);
+        mShaderManager.ActivateProgramForParameters(mShipRopesProgram);
         mShaderManager.SetProgramParameter<ProgramParameterType::EffectiveAmbientLightIntensity>(
             mShipRopesProgram,
             effectiveAmbientLightIntensityParamValue);
 
-        mShaderManager.ActivateProgram(mShipSpringsProgram);
+        mShaderManager.ActivateProgramForParameters(mShipSpringsProgram);
         mShaderManager.SetProgramParameter<ProgramParameterType::EffectiveAmbientLightIntensity>(
             mShipSpringsProgram,
             effectiveAmbientLightIntensityParamValue);
 
-        mShaderManager.ActivateProgram(mShipTrianglesProgram);
+        mShaderManager.ActivateProgramForParameters(mShipTrianglesProgram);
         mShaderManager.SetProgramParameter<ProgramParameterType::EffectiveAmbientLightIntensity>(
             mShipTrianglesProgram,
             effectiveAmbientLightIntensityParamValue);
     }
 
-    mShaderManager.ActivateProgram<ProgramType::ShipSpringsDecay>();
+    mShaderManager.ActivateProgramForParameters<ProgramType::ShipSpringsDecay>();
     mShaderManager.SetProgramParameter<ProgramType::ShipSpringsDecay, ProgramParameterType::EffectiveAmbientLightIntensity>(
         effectiveAmbientLightIntensityParamValue);
 
-    mShaderManager.ActivateProgram<ProgramType::ShipSpringsInternalPressure>();
+    mShaderManager.ActivateProgramForParameters<ProgramType::ShipSpringsInternalPressure>();
     mShaderManager.SetProgramParameter<ProgramType::ShipSpringsInternalPressure, ProgramParameterType::EffectiveAmbientLightIntensity>(
         effectiveAmbientLightIntensityParamValue);
 
-    mShaderManager.ActivateProgram<ProgramType::ShipSpringsStrength>();
+    mShaderManager.ActivateProgramForParameters<ProgramType::ShipSpringsStrength>();
     mShaderManager.SetProgramParameter<ProgramType::ShipSpringsStrength, ProgramParameterType::EffectiveAmbientLightIntensity>(
         effectiveAmbientLightIntensityParamValue);
 
-    mShaderManager.ActivateProgram<ProgramType::ShipTrianglesDecay>();
+    mShaderManager.ActivateProgramForParameters<ProgramType::ShipTrianglesDecay>();
     mShaderManager.SetProgramParameter<ProgramType::ShipTrianglesDecay, ProgramParameterType::EffectiveAmbientLightIntensity>(
         effectiveAmbientLightIntensityParamValue);
 
-    mShaderManager.ActivateProgram<ProgramType::ShipTrianglesInternalPressure>();
+    mShaderManager.ActivateProgramForParameters<ProgramType::ShipTrianglesInternalPressure>();
     mShaderManager.SetProgramParameter<ProgramType::ShipTrianglesInternalPressure, ProgramParameterType::EffectiveAmbientLightIntensity>(
         effectiveAmbientLightIntensityParamValue);
 
-    mShaderManager.ActivateProgram<ProgramType::ShipTrianglesStrength>();
+    mShaderManager.ActivateProgramForParameters<ProgramType::ShipTrianglesStrength>();
     mShaderManager.SetProgramParameter<ProgramType::ShipTrianglesStrength, ProgramParameterType::EffectiveAmbientLightIntensity>(
         effectiveAmbientLightIntensityParamValue);
 
-    mShaderManager.ActivateProgram<ProgramType::ShipGenericMipMappedTextures>();
+    mShaderManager.ActivateProgramForParameters<ProgramType::ShipGenericMipMappedTextures>();
     mShaderManager.SetProgramParameter<ProgramType::ShipGenericMipMappedTextures, ProgramParameterType::EffectiveAmbientLightIntensity>(
         effectiveAmbientLightIntensityParamValue);
 }
@@ -2649,22 +3240,22 @@ void ShipRenderContext::ApplyFlatLampLightColorChanges(RenderParameters const &
 
     vec3f const lampLightColor = renderParameters.FlatLampLightColor.toVec3f();
 
-    mShaderManager.ActivateProgram(mShipPointsProgram);
+    mShaderManager.ActivateProgramForParameters(mShipPointsProgram);
     mShaderManager.SetProgramParameter<ProgramParameterType::LampLightColor>(
         mShipPointsProgram,
         lampLightColor);
 
-    mShaderManager.ActivateProgram(mShipRopesProgram);
+    mShaderManager.ActivateProgramForParameters(mShipRopesProgram);
     mShaderManager.SetProgramParameter<ProgramParameterType::LampLightColor>(
         mShipRopesProgram,
         lampLightColor);
 
-    mShaderManager.ActivateProgram(mShipSpringsProgram);
+    mShaderManager.ActivateProgramForParameters(mShipSpringsProgram);
     mShaderManager.SetProgramParameter<ProgramParameterType::LampLightColor>(
         mShipSpringsProgram,
         lampLightColor);
 
-    mShaderManager.ActivateProgram(mShipTrianglesProgram);
+    mShaderManager.ActivateProgramForParameters(mShipTrianglesProgram);
     mShaderManager.SetProgramParameter<ProgramParameterType::LampLightColor>(
         mShipTrianglesProgram,
         lampLightColor);
@@ -2680,22 +3271,22 @@ void ShipRenderContext::ApplyWaterColorChanges(RenderParameters const & renderPa
 
     if (renderParameters.HeatRenderMode != HeatRenderModeType::HeatOverlay)
     {
-        mShaderManager.ActivateProgram(mShipPointsProgram);
+        mShaderManager.ActivateProgramForParameters(mShipPointsProgram);
         mShaderManager.SetProgramParameter<ProgramParameterType::WaterColor>(
             mShipPointsProgram,
             waterColor);
 
-        mShaderManager.ActivateProgram(mShipRopesProgram);
+        mShaderManager.ActivateProgramForParameters(mShipRopesProgram);
         mShaderManager.SetProgramParameter<ProgramParameterType::WaterColor>(
             mShipRopesProgram,
             waterColor);
 
-        mShaderManager.ActivateProgram(mShipSpringsProgram);
+        mShaderManager.ActivateProgramForParameters(mShipSpringsProgram);
         mShaderManager.SetProgramParameter<ProgramParameterType::WaterColor>(
             mShipSpringsProgram,
             waterColor);
 
-        mShaderManager.ActivateProgram(mShipTrianglesProgram);
+        mShaderManager.ActivateProgramForParameters(mShipTrianglesProgram);
         mShaderManager.SetProgramParameter<ProgramParameterType::WaterColor>(
             mShipTrianglesProgram,
             waterColor);
@@ -2710,22 +3301,22 @@ void ShipRenderContext::ApplyWaterContrastChanges(RenderParameters const & rende
 
     if (renderParameters.HeatRenderMode != HeatRenderModeType::HeatOverlay)
     {
-        mShaderManager.ActivateProgram(mShipPointsProgram);
+        mShaderManager.ActivateProgramForParameters(mShipPointsProgram);
         mShaderManager.SetProgramParameter<ProgramParameterType::WaterContrast>(
             mShipPointsProgram,
             renderParameters.ShipWaterContrast);
 
-        mShaderManager.ActivateProgram(mShipRopesProgram);
+        mShaderManager.ActivateProgramForParameters(mShipRopesProgram);
         mShaderManager.SetProgramParameter<ProgramParameterType::WaterContrast>(
             mShipRopesProgram,
             renderParameters.ShipWaterContrast);
 
-        mShaderManager.ActivateProgram(mShipSpringsProgram);
+        mShaderManager.ActivateProgramForParameters(mShipSpringsProgram);
         mShaderManager.SetProgramParameter<ProgramParameterType::WaterContrast>(
             mShipSpringsProgram,
             renderParameters.ShipWaterContrast);
 
-        mShaderManager.ActivateProgram(mShipTrianglesProgram);
+        mShaderManager.ActivateProgramForParameters(mShipTrianglesProgram);
         mShaderManager.SetProgramParameter<ProgramParameterType::WaterContrast>(
             mShipTrianglesProgram,
             renderParameters.ShipWaterContrast);
@@ -2743,22 +3334,22 @@ void ShipRenderContext::ApplyWaterLevelOfDetailChanges(RenderParameters const &
 
     if (renderParameters.HeatRenderMode != HeatRenderModeType::HeatOverlay)
     {
-        mShaderManager.ActivateProgram(mShipPointsProgram);
+        mShaderManager.ActivateProgramForParameters(mShipPointsProgram);
         mShaderManager.SetProgramParameter<ProgramParameterType::WaterLevelThreshold>(
             mShipPointsProgram,
             waterLevelThreshold);
 
-        mShaderManager.ActivateProgram(mShipRopesProgram);
+        mShaderManager.ActivateProgramForParameters(mShipRopesProgram);
         mShaderManager.SetProgramParameter<ProgramParameterType::WaterLevelThreshold>(
             mShipRopesProgram,
             waterLevelThreshold);
 
-        mShaderManager.ActivateProgram(mShipSpringsProgram);
+        mShaderManager.ActivateProgramForParameters(mShipSpringsProgram);
         mShaderManager.SetProgramParameter<ProgramParameterType::WaterLevelThreshold>(
             mShipSpringsProgram,
             waterLevelThreshold);
 
-        mShaderManager.ActivateProgram(mShipTrianglesProgram);
+        mShaderManager.ActivateProgramForParameters(mShipTrianglesProgram);
         mShaderManager.SetProgramParameter<ProgramParameterType::WaterLevelThreshold>(
             mShipTrianglesProgram,
             waterLevelThreshold);
@@ -2777,22 +3368,22 @@ void ShipRenderContext::ApplyHeatSensitivityChanges(RenderParameters const & ren
 
     if (renderParameters.HeatRenderMode != HeatRenderModeType::None)
     {
-        mShaderManager.ActivateProgram(mShipPointsProgram);
+        mShaderManager.ActivateProgramForParameters(mShipPointsProgram);
         mShaderManager.SetProgramParameter<ProgramParameterType::HeatShift>(
             mShipPointsProgram,
             heatShift);
 
-        mShaderManager.ActivateProgram(mShipRopesProgram);
+        mShaderManager.ActivateProgramForParameters(mShipRopesProgram);
         mShaderManager.SetProgramParameter<ProgramParameterType::HeatShift>(
             mShipRopesProgram,
             heatShift);
 
-        mShaderManager.ActivateProgram(mShipSpringsProgram);
+        mShaderManager.ActivateProgramForParameters(mShipSpringsProgram);
         mShaderManager.SetProgramParameter<ProgramParameterType::HeatShift>(
             mShipSpringsProgram,
             heatShift);
 
-        mShaderManager.ActivateProgram(mShipTrianglesProgram);
+        mShaderManager.ActivateProgramForParameters(mShipTrianglesProgram);
         mShaderManager.SetProgramParameter<ProgramParameterType::HeatShift>(
             mShipTrianglesProgram,
             heatShift);
@@ -2891,7 +3482,7 @@ void ShipRenderContext::ApplyStressRenderModeChanges(RenderParameters const & re
 
     for (auto program : StressColorMapPrograms)
     {
-        mShaderManager.ActivateProgram(program);
+        mShaderManager.ActivateProgramForParameters(program);
         mShaderManager.SetProgramParameterVec4fArray<ProgramParameterType::StressColorMap>(
             program,
             stressColorMap,
@@ -3042,4 +3633,263 @@ void ShipRenderContext::SelectShipPrograms(RenderParameters const & renderParame
     }
 }
 
+template<typename TElement>
+void ShipRenderContext::BucketElementsByCullingTile(
+    std::vector<TElement> & elements,
+    size_t startElement,
+    size_t endElement,
+    std::vector<TElement> & bucketingBuffer,
+    std::vector<ElementBucket> & buckets,
+    std::vector<ElementIndex> * elementIds)
+{
+    //
+    // Counting sort of the elements in the range by the culling tile of their first endpoint
+    //
+
+    std::array<size_t, CullingTileCount> tileStarts;
+    tileStarts.fill(0);
+
+    for (size_t e = startElement; e < endElement; ++e)
+    {
+        ++tileStarts[mPointTextureCullingTileIndices[elements[e].pointIndex1]];
+    }
+
+    size_t bucketStartElement = startElement;
+    for (size_t t = 0; t < CullingTileCount; ++t)
+    {
+        size_t const tileElementCount = tileStarts[t];
+        if (tileElementCount > 0)
+        {
+            buckets.emplace_back(
+                static_cast<std::uint8_t>(t),
+                bucketStartElement,
+                tileElementCount);
+        }
+
+        tileStarts[t] = bucketStartElement - startElement;
+        bucketStartElement += tileElementCount;
+    }
+
+    bucketingBuffer.assign(
+        elements.cbegin() + startElement,
+        elements.cbegin() + endElement);
+
+    if (elementIds == nullptr)
+    {
+        for (auto const & element : bucketingBuffer)
+        {
+            elements[startElement + tileStarts[mPointTextureCullingTileIndices[element.pointIndex1]]++] = element;
+        }
+    }
+    else
+    {
+        mElementIdBucketingBuffer.assign(
+            elementIds->cbegin() + startElement,
+            elementIds->cbegin() + endElement);
+
+        for (size_t e = 0; e < bucketingBuffer.size(); ++e)
+        {
+            size_t const targetElement = startElement + tileStarts[mPointTextureCullingTileIndices[bucketingBuffer[e].pointIndex1]]++;
+            elements[targetElement] = bucketingBuffer[e];
+            (*elementIds)[targetElement] = mElementIdBucketingBuffer[e];
+        }
+    }
+}
+
+void ShipRenderContext::RecalculatePointCullingTiles()
+{
+    //
+    // Only points referenced by culled elements contribute to the tiles' bounding boxes
+    //
+
+    std::fill(
+        mPointCullingTileIndices.begin(),
+        mPointCullingTileIndices.end(),
+        NoneCullingTileIndex);
+
+    for (auto const & triangleElement : mTriangleElementBuffer)
+    {
+        mPointCullingTileIndices[triangleElement.pointIndex1] = mPointTextureCullingTileIndices[triangleElement.pointIndex1];
+        mPointCullingTileIndices[triangleElement.pointIndex2] = mPointTextureCullingTileIndices[triangleElement.pointIndex2];
+        mPointCullingTileIndices[triangleElement.pointIndex3] = mPointTextureCullingTileIndices[triangleElement.pointIndex3];
+    }
+
+    for (auto const & springElement : mSpringElementBuffer)
+    {
+        mPointCullingTileIndices[springElement.pointIndex1] = mPointTextureCullingTileIndices[springElement.pointIndex1];
+        mPointCullingTileIndices[springElement.pointIndex2] = mPointTextureCullingTileIndices[springElement.pointIndex2];
+    }
+}
+
+void ShipRenderContext::RecalculateVisibleCullingTiles(RenderParameters const & renderParameters)
+{
+    auto const & visibleWorld = renderParameters.View.GetVisibleWorld();
+
+    float const visibleLeft = visibleWorld.TopLeft.x - CullingMarginWorld;
+    float const visibleRight = visibleWorld.BottomRight.x + CullingMarginWorld;
+    float const visibleTop = visibleWorld.TopLeft.y + CullingMarginWorld;
+    float const visibleBottom = visibleWorld.BottomRight.y - CullingMarginWorld;
+
+    mAreAllCullingTilesVisible = true;
+
+    for (size_t t = 0; t < CullingTileCount; ++t)
+    {
+        auto const & tileAABB = mCullingTileAABBs[t];
+
+        // Tiles whose bounding box has not been calculated yet - i.e. whose points
+        // have just started being referenced - are visible
+        mIsCullingTileVisible[t] =
+            tileAABB.BottomLeft.x > tileAABB.TopRight.x
+            || (tileAABB.BottomLeft.x <= visibleRight
+                && tileAABB.TopRight.x >= visibleLeft
+                && tileAABB.BottomLeft.y <= visibleTop
+                && tileAABB.TopRight.y >= visibleBottom);
+
+        mAreAllCullingTilesVisible &= mIsCullingTileVisible[t];
+    }
+}
+
+size_t ShipRenderContext::DrawCulledElements(
+    GLenum mode,
+    size_t indicesPerElement,
+    size_t vboStartIndex,
+    std::vector<ElementBucket> const & buckets,
+    size_t elementCount)
+{
+    if (mAreAllCullingTilesVisible)
+    {
+        glDrawElements(
+            mode,
+            static_cast<GLsizei>(indicesPerElement * elementCount),
+            GL_UNSIGNED_INT,
+            (GLvoid *)vboStartIndex);
+
+        return elementCount;
+    }
+
+    //
+    // Draw the visible buckets, merging adjacent ones into single draws
+    //
+
+    size_t drawnElementCount = 0;
+    size_t lastDrawEndElement = std::numeric_limits<size_t>::max();
+
+    if (GameOpenGL::SupportsMultiDrawIndirect)
+    {
+        mCulledDrawCommands.clear();
+
+        for (auto const & bucket : buckets)
+        {
+            if (mIsCullingTileVisible[bucket.CullingTileIndex])
+            {
+                if (bucket.StartElement == lastDrawEndElement)
+                {
+                    mCulledDrawCommands.back().Count += static_cast<GLuint>(indicesPerElement * bucket.ElementCount);
+                }
+                else
+                {
+                    mCulledDrawCommands.emplace_back(
+                        static_cast<GLuint>(indicesPerElement * bucket.ElementCount),
+                        static_cast<GLuint>(vboStartIndex / sizeof(GLuint) + bucket.StartElement * indicesPerElement));
+                }
+
+                lastDrawEndElement = bucket.StartElement + bucket.ElementCount;
+                drawnElementCount += bucket.ElementCount;
+            }
+        }
+
+        if (!mCulledDrawCommands.empty())
+        {
+            glBindBuffer(GL_DRAW_INDIRECT_BUFFER, *mCulledDrawCommandVBO);
+
+            // Orphan the buffer whenever it grows, otherwise just replace its head
+            if (mCulledDrawCommands.size() > mCulledDrawCommandVBOAllocatedSize)
+            {
+                mCulledDrawCommandVBOAllocatedSize = buckets.size();
+                glBufferData(GL_DRAW_INDIRECT_BUFFER, mCulledDrawCommandVBOAllocatedSize * sizeof(DrawElementsIndirectCommand), nullptr, GL_STREAM_DRAW);
+                CheckOpenGLError();
+            }
+
+            glBufferSubData(GL_DRAW_INDIRECT_BUFFER, 0, mCulledDrawCommands.size() * sizeof(DrawElementsIndirectCommand), mCulledDrawCommands.data());
+            CheckOpenGLError();
+
+            glMultiDrawElementsIndirect(
+                mode,
+                GL_UNSIGNED_INT,
+                (GLvoid const *)0,
+                static_cast<GLsizei>(mCulledDrawCommands.size()),
+                0); // Tightly-packed
+
+            glBindBuffer(GL_DRAW_INDIRECT_BUFFER, 0);
+        }
+    }
+    else
+    {
+        mCulledDrawCounts.clear();
+        mCulledDrawIndices.clear();
+
+        for (auto const & bucket : buckets)
+        {
+            if (mIsCullingTileVisible[bucket.CullingTileIndex])
+            {
+                if (bucket.StartElement == lastDrawEndElement)
+                {
+                    mCulledDrawCounts.back() += static_cast<GLsizei>(indicesPerElement * bucket.ElementCount);
+                }
+                else
+                {
+                    mCulledDrawCounts.push_back(static_cast<GLsizei>(indicesPerElement * bucket.ElementCount));
+                    mCulledDrawIndices.push_back((GLvoid const *)(vboStartIndex + bucket.StartElement * indicesPerElement * sizeof(GLuint)));
+                }
+
+                lastDrawEndElement = bucket.StartElement + bucket.ElementCount;
+                drawnElementCount += bucket.ElementCount;
+            }
+        }
+
+        if (!mCulledDrawCounts.empty())
+        {
+            glMultiDrawElements(
+                mode,
+                mCulledDrawCounts.data(),
+                GL_UNSIGNED_INT,
+                mCulledDrawIndices.data(),
+                static_cast<GLsizei>(mCulledDrawCounts.size()));
+        }
+    }
+
+    return drawnElementCount;
+}
+
+void ShipRenderContext::DecimateRopeElements()
+{
+    //
+    // Rope segments are uploaded in chains - each segment beginning where the previous
+    // one ends; we merge up to RopeDecimationFactor chained segments into a single one
+    //
+
+    mDecimatedRopeElementBuffer.clear();
+
+    size_t chainLength = 0;
+    for (auto const & ropeElement : mRopeElementBuffer)
+    {
+        if (chainLength > 0
+            && chainLength < RopeDecimationFactor
+            && mDecimatedRopeElementBuffer.back().pointIndex2 == ropeElement.pointIndex1)
+        {
+            // Extend current decimated segment
+            mDecimatedRopeElementBuffer.back().pointIndex2 = ropeElement.pointIndex2;
+            ++chainLength;
+        }
+        else
+        {
+            // Start new decimated segment
+            mDecimatedRopeElementBuffer.emplace_back(
+                ropeElement.pointIndex1,
+                ropeElement.pointIndex2);
+            chainLength = 1;
+        }
+    }
+}
+
 }
\ No newline at end of file
@@ -15,18 +15,24 @@
 
 #include <GameOpenGL/GameOpenGL.h>
 #include <GameOpenGL/GameOpenGLMappedBuffer.h>
+#include <GameOpenGL/GameOpenGLPersistentStreamBuffer.h>
 #include <GameOpenGL/ShaderManager.h>
 
+#include <GameCore/AABB.h>
 #include <GameCore/BoundedVector.h>
 #include <GameCore/GameTypes.h>
 #include <GameCore/ImageData.h>
 #include <GameCore/SysSpecifics.h>
+#include <GameCore/TaskThread.h>
+#include <GameCore/TextureCompression.h>
 #include <GameCore/Vectors.h>
 
 #include <algorithm>
 #include <array>
 #include <cassert>
 #include <cmath>
+#include <cstdint>
+#include <limits>
 #include <memory>
 #include <optional>
 #include <string>
@@ -49,6 +55,7 @@ public:
         size_t pointCount,
         size_t shipCount,
         RgbaImageData shipTexture,
+        TaskThread & textureCompressionThread,
         ShaderManager<ShaderManagerTraits> & shaderManager,
         GlobalRenderContext const & globalRenderContext,
         RenderParameters const & renderParameters,
@@ -94,6 +101,14 @@ public:
         float const * light,
         float const * water);
 
+    /*
+     * Whether the per-cycle mutable attributes have been uploaded already in this upload cycle.
+     */
+    bool ArePointMutableAttributesUploaded() const
+    {
+        return mArePointMutableAttributesUploaded;
+    }
+
     void UploadPointMutableAttributesPlaneId(
         float const * planeId,
         size_t startDst,
@@ -126,7 +141,10 @@ public:
         size_t startDst,
         size_t count);
 
-    void UploadPointFrontierColors(FrontierColor const * colors);
+    void UploadPointFrontierColors(
+        FrontierColor const * colors,
+        size_t startDst,
+        size_t count);
 
     //
     // Elements
@@ -165,6 +183,7 @@ public:
 
     inline void UploadElementTriangle(
         size_t triangleIndex,
+        ElementIndex triangleElementIndex,
         int pointIndex1,
         int pointIndex2,
         int pointIndex3)
@@ -176,10 +195,32 @@ public:
         triangleElement.pointIndex1 = pointIndex1;
         triangleElement.pointIndex2 = pointIndex2;
         triangleElement.pointIndex3 = pointIndex3;
+
+        mTriangleElementIdBuffer[triangleIndex] = triangleElementIndex;
     }
 
     void UploadElementTrianglesEnd();
 
+    /*
+     * Removes a triangle from the last uploaded set of triangles, without touching
+     * the others; the triangle's slot is made into a degenerate triangle, which
+     * the GPU discards.
+     */
+    inline void UploadElementTriangleTombstone(ElementIndex triangleElementIndex)
+    {
+        assert(triangleElementIndex < mTriangleElementSlots.size());
+
+        size_t const triangleIndex = mTriangleElementSlots[triangleElementIndex];
+        assert(triangleIndex < mTriangleElementBuffer.size());
+
+        TriangleElement & triangleElement = mTriangleElementBuffer[triangleIndex];
+
+        triangleElement.pointIndex2 = triangleElement.pointIndex1;
+        triangleElement.pointIndex3 = triangleElement.pointIndex1;
+
+        mTriangleElementTombstoneSlots.push_back(triangleIndex);
+    }
+
     void UploadElementsEnd();
 
     //
@@ -281,43 +322,27 @@ public:
         vec2f const B = endPosition + endJ;
 
         //
-        // Append vertices - two triangles
+        // Append vertices - one quad, drawn as two triangles via the quad element buffer
         //
 
-        // Triangle 1
-
         // Top-left
         mElectricSparkVertexBuffer.emplace_back(
             C,
             fPlaneId,
             0.0f);
 
-        // Top-Right
-        mElectricSparkVertexBuffer.emplace_back(
-            D,
-            fPlaneId,
-            1.0f);
-
         // Bottom-left
         mElectricSparkVertexBuffer.emplace_back(
             A,
             fPlaneId,
             0.0f);
 
-        // Triangle 2
-
         // Top-Right
         mElectricSparkVertexBuffer.emplace_back(
             D,
             fPlaneId,
             1.0f);
 
-        // Bottom-left
-        mElectricSparkVertexBuffer.emplace_back(
-            A,
-            fPlaneId,
-            0.0f);
-
         // Bottom-right
         mElectricSparkVertexBuffer.emplace_back(
             B,
@@ -1078,6 +1103,10 @@ public:
 
 private:
 
+    void SwapInCompressedShipTexture();
+
+    void UploadShipTextureChunk();
+
     inline void StoreFlameQuad(
         PlaneId planeId,
         vec2f const & baseCenterPosition,
@@ -1128,11 +1157,9 @@ private:
         vec2f const D = Ppp - Qhw;
 
         //
-        // Store quad vertices
+        // Store quad vertices, in the order expected by the quad element buffer
         //
 
-        // Triangle 1
-
         // Top-left
         mFlameVertexBuffer.emplace_back(
             vec2f(C.x, C.y),
@@ -1141,14 +1168,6 @@ private:
             flameWindRotationAngle,
             vec2f(-1.0f, 1.0f));
 
-        // Top-right
-        mFlameVertexBuffer.emplace_back(
-            vec2f(D.x, D.y),
-            static_cast<float>(planeId),
-            flamePersonalitySeed,
-            flameWindRotationAngle,
-            vec2f(1.0f, 1.0f));
-
         // Bottom-left
         mFlameVertexBuffer.emplace_back(
             vec2f(A.x, A.y),
@@ -1157,9 +1176,7 @@ private:
             flameWindRotationAngle,
             vec2f(-1.0f, 0.0f));
 
-        // Triangle 2
-
-        // Top-Right
+        // Top-right
         mFlameVertexBuffer.emplace_back(
             vec2f(D.x, D.y),
             static_cast<float>(planeId),
@@ -1167,14 +1184,6 @@ private:
             flameWindRotationAngle,
             vec2f(1.0f, 1.0f));
 
-        // Bottom-left
-        mFlameVertexBuffer.emplace_back(
-            vec2f(A.x, A.y),
-            static_cast<float>(planeId),
-            flamePersonalitySeed,
-            flameWindRotationAngle,
-            vec2f(-1.0f, 0.0f));
-
         // Bottom-right
         mFlameVertexBuffer.emplace_back(
             vec2f(B.x, B.y),
@@ -1287,6 +1296,10 @@ private:
     void RenderPrepareElectricSparks(RenderParameters const & renderParameters);
     void RenderDrawElectricSparks(RenderParameters const & renderParameters);
 
+    // Grows the element buffer shared by all quad-based VAOs - sparks and flames - so that
+    // it covers the specified number of quads, each made of four consecutive vertices
+    void EnsureQuadElementVBOSize(size_t quadCount);
+
     void RenderPrepareFlames();
     template<ProgramType FlameShaderType>
     void RenderDrawFlames(
@@ -1572,6 +1585,66 @@ private:
 
 #pragma pack(pop)
 
+    struct ElementBucket
+    {
+        std::uint8_t CullingTileIndex;
+        size_t StartElement;
+        size_t ElementCount;
+
+        ElementBucket(
+            std::uint8_t cullingTileIndex,
+            size_t startElement,
+            size_t elementCount)
+            : CullingTileIndex(cullingTileIndex)
+            , StartElement(startElement)
+            , ElementCount(elementCount)
+        {}
+    };
+
+    // Layout mandated by glMultiDrawElementsIndirect
+    struct DrawElementsIndirectCommand
+    {
+        GLuint Count;
+        GLuint InstanceCount;
+        GLuint FirstIndex;
+        GLint BaseVertex;
+        GLuint BaseInstance;
+
+        DrawElementsIndirectCommand(
+            GLuint count,
+            GLuint firstIndex)
+            : Count(count)
+            , InstanceCount(1)
+            , FirstIndex(firstIndex)
+            , BaseVertex(0)
+            , BaseInstance(0)
+        {}
+    };
+
+private:
+
+    template<typename TElement>
+    void BucketElementsByCullingTile(
+        std::vector<TElement> & elements,
+        size_t startElement,
+        size_t endElement,
+        std::vector<TElement> & bucketingBuffer,
+        std::vector<ElementBucket> & buckets,
+        std::vector<ElementIndex> * elementIds = nullptr); // When specified, permuted together with the elements
+
+    void RecalculatePointCullingTiles();
+
+    void RecalculateVisibleCullingTiles(RenderParameters const & renderParameters);
+
+    size_t DrawCulledElements(
+        GLenum mode,
+        size_t indicesPerElement,
+        size_t vboStartIndex,
+        std::vector<ElementBucket> const & buckets,
+        size_t elementCount);
+
+    void DecimateRopeElements();
+
     struct ExplosionPlaneData
     {
         std::vector<ExplosionVertex> vertexBuffer;
@@ -1586,15 +1659,40 @@ private:
     // Buffers
     //
 
-    std::unique_ptr<vec4f> mPointAttributeGroup1Buffer; // Position, TextureCoordinates
+    // The point attribute buffers are double-buffered: the per-cycle attributes
+    // (position, light, water) are uploaded into the upload buffer, which might happen
+    // while the render thread is still reading the render buffer; the two are swapped
+    // at UploadEnd(). Sparse attributes are uploaded into both buffers.
+
+    std::unique_ptr<vec4f> mPointAttributeGroup1Buffers[2]; // Position, TextureCoordinates
     GameOpenGLVBO mPointAttributeGroup1VBO;
 
-    std::unique_ptr<vec4f> mPointAttributeGroup2Buffer; // Light, Water, PlaneId, Decay
+    std::unique_ptr<vec4f> mPointAttributeGroup2Buffers[2]; // Light, Water, PlaneId, Decay
     GameOpenGLVBO mPointAttributeGroup2VBO;
 
+    size_t mPointAttributeUploadBufferIndex;
+    size_t mPointAttributeRenderBufferIndex;
+    bool mArePointMutableAttributesUploaded; // Since last UploadEnd()
+
+    // When persistently-mapped buffers are supported, the per-cycle attributes are
+    // instead written straight into a ring of GPU-visible segments, while the two
+    // buffers above only hold the sparse attributes, from which each segment is
+    // completed
+
+    bool const mDoStreamPointAttributes;
+    GameOpenGLPersistentStreamBuffer<vec4f, GL_ARRAY_BUFFER> mPointAttributeGroup1StreamBuffer;
+    GameOpenGLPersistentStreamBuffer<vec4f, GL_ARRAY_BUFFER> mPointAttributeGroup2StreamBuffer;
+    size_t mPointAttributeStreamBoundByteOffset; // Offset currently bound in the VAO
+
+    // Colors are stored as normalized bytes, and - when supported - temperatures
+    // as half floats; they are converted at upload, via these buffers
+
     GameOpenGLVBO mPointColorVBO;
+    std::unique_ptr<rgbaColor[]> mPointColorUploadBuffer;
 
+    bool const mDoStorePointTemperatureAsHalfFloat;
     GameOpenGLVBO mPointTemperatureVBO;
+    std::unique_ptr<std::uint16_t[]> mPointTemperatureUploadBuffer;
 
     GameOpenGLVBO mPointStressVBO;
 
@@ -1615,6 +1713,10 @@ private:
     GameOpenGLVBO mElectricSparkVBO;
     size_t mElectricSparkVBOAllocatedVertexSize;
 
+    // Indices of the quads of sparks and flames
+    GameOpenGLVBO mQuadElementVBO;
+    size_t mQuadElementVBOAllocatedQuadSize;
+
     BoundedVector<FlameVertex> mFlameVertexBuffer;
     size_t mFlameBackgroundCount;
     size_t mFlameForegroundCount;
@@ -1670,10 +1772,18 @@ private:
     std::vector<PointElement> mEphemeralPointElementBuffer;
     std::vector<LineElement> mSpringElementBuffer;
     std::vector<LineElement> mRopeElementBuffer;
+    std::vector<LineElement> mDecimatedRopeElementBuffer; // Ropes for low-detail rendering
     std::vector<TriangleElement> mTriangleElementBuffer;
     bool mAreElementBuffersDirty;
     GameOpenGLVBO mElementVBO;
-    size_t mElementVBOAllocatedIndexSize;
+    size_t mElementVBOAllocatedIndexSize; // Only grows, so that triangles - which come first - stay put
+
+    // Triangles are only uploaded whole when their set is re-populated; in between,
+    // deleted triangles are tombstoned in place and only their slots are uploaded
+    std::vector<ElementIndex> mTriangleElementIdBuffer; // Triangle element index of each slot of mTriangleElementBuffer
+    std::vector<size_t> mTriangleElementSlots; // Slot in mTriangleElementBuffer of each triangle element index
+    bool mIsTriangleElementBufferDirty; // The whole of mTriangleElementBuffer needs to be uploaded
+    std::vector<size_t> mTriangleElementTombstoneSlots; // Slots tombstoned since the last upload
 
     // Indices at which these elements begin in the VBO; populated
     // when we upload element indices to the VBO
@@ -1681,8 +1791,62 @@ private:
     size_t mEphemeralPointElementVBOStartIndex;
     size_t mSpringElementVBOStartIndex;
     size_t mRopeElementVBOStartIndex;
+    size_t mDecimatedRopeElementVBOStartIndex;
     size_t mTriangleElementVBOStartIndex;
 
+    //
+    // Level-of-detail
+    //
+    // When the ship is zoomed out so much that springs and points shrink below a pixel,
+    // we only draw the ship's triangles, skipping springs and ephemeral points, and we draw
+    // ropes from their decimated version, in which chains of rope segments are merged into
+    // single segments.
+    //
+
+    // Below this number of canvas pixels per world meter we switch to low-detail rendering
+    static float constexpr LowDetailCanvasToWorldRatio = 2.0f;
+
+    // Max number of chained rope segments merged into a single decimated rope segment
+    static size_t constexpr RopeDecimationFactor = 4;
+
+    //
+    // Element culling
+    //
+    // Triangles and springs are bucketed by the culling tile - a cell of a grid laid over the
+    // ship's texture space - of their first endpoint; triangles are bucketed within each run
+    // of triangles of the same plane, so to maintain their plane order. At each frame we
+    // calculate the bounding box of each tile, and only draw the buckets whose tile
+    // intersects the visible world.
+    //
+
+    static size_t constexpr CullingTileGridSize = 8; // Tiles per side
+    static size_t constexpr CullingTileCount = CullingTileGridSize * CullingTileGridSize;
+    static std::uint8_t constexpr NoneCullingTileIndex = std::numeric_limits<std::uint8_t>::max();
+    static_assert(CullingTileCount < NoneCullingTileIndex);
+
+    // Allowance for the elements' endpoints that lie outside of the tile of their first endpoint
+    static float constexpr CullingMarginWorld = 5.0f;
+
+    std::vector<std::uint8_t> mPointTextureCullingTileIndices; // From texture coordinates, hence immutable
+    std::vector<std::uint8_t> mPointCullingTileIndices; // NoneCullingTileIndex for points not referenced by culled elements
+    std::array<Geometry::AABB, CullingTileCount> mCullingTileAABBs;
+    std::array<bool, CullingTileCount> mIsCullingTileVisible;
+    bool mAreAllCullingTilesVisible;
+
+    std::vector<ElementBucket> mTriangleElementBuckets;
+    std::vector<ElementBucket> mSpringElementBuckets;
+    std::vector<TriangleElement> mTriangleElementBucketingBuffer;
+    std::vector<LineElement> mSpringElementBucketingBuffer;
+    std::vector<ElementIndex> mElementIdBucketingBuffer;
+    std::vector<GLsizei> mCulledDrawCounts;
+    std::vector<GLvoid const *> mCulledDrawIndices;
+
+    // Used instead of the above when we support indirect multi-draws,
+    // so that the draw commands are sourced by the GPU from a buffer
+    std::vector<DrawElementsIndirectCommand> mCulledDrawCommands;
+    GameOpenGLVBO mCulledDrawCommandVBO;
+    size_t mCulledDrawCommandVBOAllocatedSize;
+
     //
     // VAOs
     //
@@ -1715,6 +1879,25 @@ private:
     GameOpenGLTexture mShipTextureOpenGLHandle;
     GameOpenGLTexture mStressedSpringTextureOpenGLHandle;
 
+    // The compression of the ship texture in progress, if any; the compressed texture
+    // replaces the uncompressed one once it's ready
+    TaskThread::TaskCompletionIndicator mShipTextureCompressionCompletionIndicator;
+    std::shared_ptr<std::vector<TextureCompression::CompressedImage>> mCompressedShipTextureLevels;
+
+    // The upload of a large ship texture in progress, if any, which proceeds a chunk of rows
+    // at each frame - through a pixel unpack buffer, when supported - while a low-resolution
+    // placeholder is rendered; the uploaded texture replaces the placeholder once all of its
+    // rows are uploaded and the GPU has generated its mipmaps
+    struct ShipTextureUpload
+    {
+        RgbaImageData Source;
+        GameOpenGLTexture Texture;
+        GameOpenGLVBO PixelUnpackBuffer;
+        int NextRow;
+    };
+
+    std::unique_ptr<ShipTextureUpload> mShipTextureUpload;
+
     TextureAtlasMetadata<ExplosionTextureGroups> const & mExplosionTextureAtlasMetadata;
     [[maybe_unused]]
     TextureAtlasMetadata<GenericLinearTextureGroups> const & mGenericLinearTextureAtlasMetadata;
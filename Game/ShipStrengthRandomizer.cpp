@@ -216,14 +216,28 @@ void ShipStrengthRandomizer::RandomizeStrength_Batik(
         * mDensityAdjustment
         * 0.803); // Magic number
 
-    for (int iCrack = 0; iCrack < numberOfCracks; ++iCrack)
+    //
+    // Calculate initial distances, from all the points at distance zero; from now on,
+    // distances are only updated incrementally from the points of each new crack
+    //
+
+    std::vector<vec2i> newZeroDistancePoints;
+
+    for (int x = 0; x < distanceMatrix.width; ++x)
     {
-        //
-        // Update distances
-        //
+        for (int y = 0; y < distanceMatrix.height; ++y)
+        {
+            if (distanceMatrix[{x, y}].Distance == 0.0f)
+            {
+                newZeroDistancePoints.emplace_back(x, y);
+            }
+        }
+    }
 
-        UpdateBatikDistances(distanceMatrix);
+    UpdateBatikDistances(newZeroDistancePoints, distanceMatrix);
 
+    for (int iCrack = 0; iCrack < numberOfCracks; ++iCrack)
+    {
         //
         // Choose a starting point among all triangle vertices
         //
@@ -293,6 +307,7 @@ void ShipStrengthRandomizer::RandomizeStrength_Batik(
             PropagateBatikCrack(
                 startingPointCoords + OctantDirections[*bestNextPointOctant],
                 distanceMatrix,
+                newZeroDistancePoints,
                 randomEngine);
 
             //
@@ -313,6 +328,7 @@ void ShipStrengthRandomizer::RandomizeStrength_Batik(
                 PropagateBatikCrack(
                     startingPointCoords + OctantDirections[*oppositeOctant],
                     distanceMatrix,
+                    newZeroDistancePoints,
                     randomEngine);
             }
         }
@@ -320,6 +336,13 @@ void ShipStrengthRandomizer::RandomizeStrength_Batik(
         // Set crack at starting point
         distanceMatrix[startingPointCoords].Distance = 0.0f;
         distanceMatrix[startingPointCoords].IsCrack = true;
+        newZeroDistancePoints.emplace_back(startingPointCoords);
+
+        //
+        // Update distances
+        //
+
+        UpdateBatikDistances(newZeroDistancePoints, distanceMatrix);
     }
 
     //
@@ -390,6 +413,7 @@ template<typename TRandomEngine>
 void ShipStrengthRandomizer::PropagateBatikCrack(
     vec2i const & startingPoint,
     BatikDistanceMatrix & distanceMatrix,
+    std::vector<vec2i> & newZeroDistancePoints,
     TRandomEngine & randomEngine) const
 {
     auto directionPerturbationDistribution = std::uniform_int_distribution(-1, 1);
@@ -470,53 +494,42 @@ void ShipStrengthRandomizer::PropagateBatikCrack(
         distanceMatrix[p].Distance = 0.0f;
         distanceMatrix[p].IsCrack = true;
     }
+
+    newZeroDistancePoints.insert(
+        newZeroDistancePoints.end(),
+        crackPointCoords.cbegin(),
+        crackPointCoords.cend());
 }
 
-void ShipStrengthRandomizer::UpdateBatikDistances(BatikDistanceMatrix & distanceMatrix) const
+void ShipStrengthRandomizer::UpdateBatikDistances(
+    std::vector<vec2i> & newZeroDistancePoints,
+    BatikDistanceMatrix & distanceMatrix) const
 {
     //
-    // Jain's algorithm (1989, Fundamentals of Digital Image Processing, Chapter 2)
+    // Breadth-first visit from the new zero-distance points, in the 8-neighborhood;
+    // as all sources are at distance zero and all steps cost one, points are visited
+    // in order of distance, hence each point is finalized the first time it is improved,
+    // and the visit stops where the existing distances are already lower
     //
 
-    auto const updateDistanceFromOctant = [&distanceMatrix](vec2i const & idx, Octant const & octant)
+    for (size_t q = 0; q < newZeroDistancePoints.size(); ++q)
     {
-        vec2i const nidx = idx + OctantDirections[octant];
-        if (nidx.IsInSize(distanceMatrix)
-            && distanceMatrix[nidx].Distance + 1.0f < distanceMatrix[idx].Distance)
-        {
-            distanceMatrix[idx].Distance = distanceMatrix[nidx].Distance + 1.0f;
-        }
-    };
+        vec2i const idx = newZeroDistancePoints[q];
+        float const neighborDistance = distanceMatrix[idx].Distance + 1.0f;
 
-    // Top-Left -> Bottom-Right
-    for (int x = 0; x < distanceMatrix.width; ++x)
-    {
-        for (int y = distanceMatrix.height - 1; y >= 0; --y)
+        for (Octant octant = 0; octant < 8; ++octant)
         {
-            vec2i const idx(x, y);
-
-            // Upper left half of 8-neighborhood of (x, y)
-            for (Octant t = 4; t <= 7; ++t)
+            vec2i const nidx = idx + OctantDirections[octant];
+            if (nidx.IsInSize(distanceMatrix)
+                && neighborDistance < distanceMatrix[nidx].Distance)
             {
-                updateDistanceFromOctant(idx, t);
+                distanceMatrix[nidx].Distance = neighborDistance;
+                newZeroDistancePoints.emplace_back(nidx);
             }
         }
     }
 
-    // Bottom-Right -> Top-Left
-    for (int x = distanceMatrix.width - 1; x >= 0; --x)
-    {
-        for (int y = 0; y < distanceMatrix.height; ++y)
-        {
-            vec2i const idx(x, y);
-
-            // Lower right half of 8-neighborhood of (x, y)
-            for (int t = 0; t <= 3; ++t)
-            {
-                updateDistanceFromOctant(idx, t);
-            }
-        }
-    }
+    newZeroDistancePoints.clear();
 }
 
 template <typename TAcceptor>
@@ -86,9 +86,14 @@ private:
     void PropagateBatikCrack(
         vec2i const & startingPoint,
         BatikDistanceMatrix & distanceMatrix,
+        std::vector<vec2i> & newZeroDistancePoints,
         TRandomEngine & randomEngine) const;
 
-    void UpdateBatikDistances(BatikDistanceMatrix & distanceMatrix) const;
+    // Lowers the distances around the specified zero-distance points, visiting only
+    // the points whose distance improves; consumes the points
+    void UpdateBatikDistances(
+        std::vector<vec2i> & newZeroDistancePoints,
+        BatikDistanceMatrix & distanceMatrix) const;
 
     template <typename TAcceptor>
     std::optional<Octant> FindClosestOctant(
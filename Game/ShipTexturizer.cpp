@@ -10,6 +10,7 @@
 #include <GameCore/GameException.h>
 #include <GameCore/GameMath.h>
 #include <GameCore/Log.h>
+#include <GameCore/SysSpecifics.h>
 
 #include <algorithm>
 #include <chrono>
@@ -17,27 +18,31 @@
 size_t constexpr MaterialTextureCacheSizeHighWatermark = 40;
 size_t constexpr MaterialTextureCacheSizeLowWatermark = 25;
 
+// Min number of target pixels for rows to be processed in parallel, and number of rows per parallel chunk
+size_t constexpr ParallelMinTargetPixels = 512 * 512;
+size_t constexpr ParallelRowsPerChunk = 4;
+
 std::string const MaterialTextureNameNone = "none";
 
 namespace /*anonymous*/ {
 
     inline vec3f BidirMultiplyBlend(
         vec3f const & inputColor,
-        vec2f const & bumpMapSample)
+        float bumpMapSample)
     {
-        if (bumpMapSample.x <= 0.5f)
+        if (bumpMapSample <= 0.5f)
         {
             // Damper: x1 * [0.0, 1.0]
-            return inputColor * 2.0f * bumpMapSample.x;
+            return inputColor * 2.0f * bumpMapSample;
         }
         else
         {
             // Amplifier: x1 + (x2 - x1) * [0.0, 1.0]
-            float const factor = 2.0f * (bumpMapSample.x - 0.5f);
+            float const factor = 2.0f * (bumpMapSample - 0.5f);
             return vec3f(
-                inputColor.x + (bumpMapSample.x - inputColor.x) * factor,
-                inputColor.y + (bumpMapSample.x - inputColor.y) * factor,
-                inputColor.z + (bumpMapSample.x - inputColor.z) * factor);
+                inputColor.x + (bumpMapSample - inputColor.x) * factor,
+                inputColor.y + (bumpMapSample - inputColor.y) * factor,
+                inputColor.z + (bumpMapSample - inputColor.z) * factor);
         }
     }
 }
@@ -50,6 +55,16 @@ ShipTexturizer::ShipTexturizer(
     , mMaterialTextureNameToTextureFilePathMap(
         MakeMaterialTextureNameToTextureFilePathMap(materialDatabase, resourceLocator))
     , mMaterialTextureCache()
+    , mTaskThreadPool()
+{
+}
+
+ShipTexturizer::ShipTexturizer(ShipTexturizer const & other)
+    : mSharedSettings(other.mSharedSettings)
+    , mDoForceSharedSettingsOntoShipSettings(other.mDoForceSharedSettingsOntoShipSettings)
+    , mMaterialTextureNameToTextureFilePathMap(other.mMaterialTextureNameToTextureFilePathMap)
+    , mMaterialTextureCache()
+    , mTaskThreadPool()
 {
 }
 
@@ -89,9 +104,7 @@ RgbaImageData ShipTexturizer::MakeAutoTexture(
     RgbaImageData texture = RgbaImageData(textureSize);
 
     // Nail down settings
-    ShipAutoTexturizationSettings const & actualSettings = (mDoForceSharedSettingsOntoShipSettings || !settings.has_value())
-        ? mSharedSettings
-        : *settings;
+    ShipAutoTexturizationSettings const & actualSettings = GetActualSettings(settings);
 
     // Texturize
     AutoTexturizeInto(
@@ -133,20 +146,6 @@ void ShipTexturizer::AutoTexturizeInto(
 
     float const materialTextureAlpha = 1.0f - settings.MaterialTextureTransparency;
 
-    struct XInterpolationData
-    {
-        register_int pixelXI;
-        float pixelDx;
-        register_int nextPixelXI;
-    };
-
-    std::vector<XInterpolationData> xInterpolationData;
-    xInterpolationData.resize(magnificationFactor);
-
-    //
-    // Populate texture
-    //
-
     auto targetImageData = targetTextureImage.Data.get();
     auto const & structuralBuffer = structuralLayer.Buffer;
 
@@ -156,170 +155,298 @@ void ShipTexturizer::AutoTexturizeInto(
     int const startX = structuralLayerRegion.origin.x;
     int const endX = structuralLayerRegion.origin.x + structuralLayerRegion.size.width;
 
-    for (int y = startY; y < endY; ++y)
-    {
-        for (int x = startX; x < endX; ++x)
-        {
-            ShipSpaceCoordinates const coords = ShipSpaceCoordinates(x, y);
+    //
+    // Resolve material textures upfront, as the cache may only be
+    // accessed by this thread
+    //
 
-            // Get structure pixel color
-            StructuralMaterial const * const structuralMaterial = structuralBuffer[coords].Material;
-            rgbaColor const structurePixelColor = structuralMaterial != nullptr
-                ? structuralMaterial->RenderColor
-                : rgbaColor::zero(); // Fully transparent
+    std::unordered_map<StructuralMaterial const *, std::shared_ptr<MaterialTexture const>> materialTextures;
 
-            if (settings.Mode == ShipAutoTexturizationModeType::FlatStructure
-                || structuralMaterial == nullptr)
+    if (settings.Mode == ShipAutoTexturizationModeType::MaterialTextures)
+    {
+        StructuralMaterial const * lastStructuralMaterial = nullptr;
+        for (int y = startY; y < endY; ++y)
+        {
+            for (int x = startX; x < endX; ++x)
             {
-                //
-                // Flat structure/transparent
-                //
-
-                // Fill quad with color
-                for (int yy = 0; yy < magnificationFactor; ++yy)
+                StructuralMaterial const * const structuralMaterial = structuralBuffer[{x, y}].Material;
+                if (structuralMaterial != nullptr
+                    && structuralMaterial != lastStructuralMaterial
+                    && materialTextures.count(structuralMaterial) == 0)
                 {
-                    int const quadOffset =
-                        x * magnificationFactor
-                        + (y * magnificationFactor + yy) * targetTextureWidth;
-
-                    for (int xx = 0; xx < magnificationFactor; ++xx)
-                    {
-                        targetImageData[quadOffset + xx] = structurePixelColor;
-                    }
+                    materialTextures.emplace(
+                        structuralMaterial,
+                        GetMaterialTexture(structuralMaterial->MaterialTextureName));
                 }
-            }
-            else
-            {
-                //
-                // Material textures
-                //
 
-                assert(settings.Mode == ShipAutoTexturizationModeType::MaterialTextures);
+                lastStructuralMaterial = structuralMaterial;
+            }
+        }
+    }
 
-                vec3f const structurePixelColorF = structurePixelColor.toVec3f();
+    //
+    // Populate texture
+    //
 
-                // Get bump map texture
-                assert(structuralMaterial != nullptr);
-                Vec2fImageData const & materialTexture = GetMaterialTexture(structuralMaterial->MaterialTextureName);
+    auto const texturizeRows = [&](int chunkStartY, int chunkEndY)
+    {
+        // Bilinear interpolation data along X, for each target pixel of a quad's row;
+        // padded for vectorized access
+        std::vector<int> pixelXIs(make_aligned_float_element_count(magnificationFactor));
+        std::vector<float> pixelDxs(make_aligned_float_element_count(magnificationFactor));
 
-                //
-                // Prepare bilinear interpolation along X
-                //
+        StructuralMaterial const * lastStructuralMaterial = nullptr;
+        MaterialTexture const * materialTexture = nullptr;
 
-                float pixelX = static_cast<float>(x) * worldToMaterialTexturePixelConversionFactor;
-                for (int xx = 0; xx < magnificationFactor; ++xx, pixelX += magnificationFactorInvF * worldToMaterialTexturePixelConversionFactor)
-                {
-                    // Integral part
-                    xInterpolationData[xx].pixelXI = FastTruncateToArchInt(pixelX);
+        for (int y = chunkStartY; y < chunkEndY; ++y)
+        {
+            for (int x = startX; x < endX; ++x)
+            {
+                ShipSpaceCoordinates const coords = ShipSpaceCoordinates(x, y);
 
-                    // Fractional part between index and next index
-                    xInterpolationData[xx].pixelDx = pixelX - xInterpolationData[xx].pixelXI;
+                // Get structure pixel color
+                StructuralMaterial const * const structuralMaterial = structuralBuffer[coords].Material;
+                rgbaColor const structurePixelColor = structuralMaterial != nullptr
+                    ? structuralMaterial->RenderColor
+                    : rgbaColor::zero(); // Fully transparent
 
-                    // Wrap integral coordinates
-                    xInterpolationData[xx].pixelXI %= static_cast<register_int>(materialTexture.Size.width);
+                if (settings.Mode == ShipAutoTexturizationModeType::FlatStructure
+                    || structuralMaterial == nullptr)
+                {
+                    //
+                    // Flat structure/transparent
+                    //
 
-                    // Next X
-                    xInterpolationData[xx].nextPixelXI = (xInterpolationData[xx].pixelXI + 1) % static_cast<register_int>(materialTexture.Size.width);
+                    // Fill quad with color
+                    for (int yy = 0; yy < magnificationFactor; ++yy)
+                    {
+                        int const quadOffset =
+                            x * magnificationFactor
+                            + (y * magnificationFactor + yy) * targetTextureWidth;
 
-                    assert(xInterpolationData[xx].pixelXI >= 0 && xInterpolationData[xx].pixelXI < materialTexture.Size.width);
-                    assert(xInterpolationData[xx].pixelDx >= 0.0f && xInterpolationData[xx].pixelDx < 1.0f);
-                    assert(xInterpolationData[xx].nextPixelXI >= 0 && xInterpolationData[xx].nextPixelXI < materialTexture.Size.width);
+                        for (int xx = 0; xx < magnificationFactor; ++xx)
+                        {
+                            targetImageData[quadOffset + xx] = structurePixelColor;
+                        }
+                    }
                 }
+                else
+                {
+                    //
+                    // Material textures
+                    //
 
-                //
-                // Fill quad with color multiply-blended with "bump map" texture
-                //
+                    assert(settings.Mode == ShipAutoTexturizationModeType::MaterialTextures);
 
-                int const baseTargetQuadOffset = (x + y * targetTextureWidth) * magnificationFactor;
+                    vec3f const structurePixelColorF = structurePixelColor.toVec3f();
 
-                float worldY = static_cast<float>(y);
-                for (int yy = 0; yy < magnificationFactor; ++yy, worldY += magnificationFactorInvF)
-                {
-                    int const targetQuadOffset = baseTargetQuadOffset + yy * targetTextureWidth;
+                    // Get bump map texture
+                    assert(structuralMaterial != nullptr);
+                    if (structuralMaterial != lastStructuralMaterial)
+                    {
+                        assert(materialTextures.count(structuralMaterial) == 1);
+                        materialTexture = materialTextures.at(structuralMaterial).get();
+                        lastStructuralMaterial = structuralMaterial;
+                    }
+
+                    assert(materialTexture != nullptr);
+                    int const materialTextureStride = materialTexture->GetStride();
 
                     //
-                    // Prepare bilinear interpolation for Y
+                    // Prepare bilinear interpolation along X
                     //
 
-                    float const pixelY = worldY * worldToMaterialTexturePixelConversionFactor;
-
-                    // Integral part
-                    auto pixelYI = FastTruncateToArchInt(pixelY);
-
-                    // Fractional part between index and next index
-                    float const pixelDy = pixelY - pixelYI;
+                    float pixelX = static_cast<float>(x) * worldToMaterialTexturePixelConversionFactor;
+                    for (int xx = 0; xx < magnificationFactor; ++xx, pixelX += magnificationFactorInvF * worldToMaterialTexturePixelConversionFactor)
+                    {
+                        // Integral part
+                        register_int pixelXI = FastTruncateToArchInt(pixelX);
 
-                    // Wrap integral coordinates
-                    pixelYI %= static_cast<decltype(pixelYI)>(materialTexture.Size.height);
-                    auto const pixelYIOffset = pixelYI * materialTexture.Size.width;
+                        // Fractional part between index and next index
+                        pixelDxs[xx] = pixelX - pixelXI;
 
-                    // Next Y
-                    auto const nextPixelYI = (pixelYI + 1) % static_cast<decltype(pixelYI)>(materialTexture.Size.height);
-                    auto const nextPixelYIOffset = nextPixelYI * materialTexture.Size.width;;
+                        // Wrap integral coordinates; the next index is always after this one, thanks to the repeated column
+                        pixelXIs[xx] = static_cast<int>(pixelXI % static_cast<register_int>(materialTexture->Size.width));
 
-                    assert(pixelYI >= 0 && pixelYI < materialTexture.Size.height);
-                    assert(pixelDy >= 0.0f && pixelDy < 1.0f);
-                    assert(nextPixelYI >= 0 && nextPixelYI < materialTexture.Size.height);
+                        assert(pixelXIs[xx] >= 0 && pixelXIs[xx] < materialTexture->Size.width);
+                        assert(pixelDxs[xx] >= 0.0f && pixelDxs[xx] < 1.0f);
+                    }
 
                     //
-                    // Loop for all Xs
+                    // Fill quad with color multiply-blended with "bump map" texture
                     //
 
-                    for (int xx = 0; xx < magnificationFactor; ++xx)
+                    int const baseTargetQuadOffset = (x + y * targetTextureWidth) * magnificationFactor;
+
+                    float worldY = static_cast<float>(y);
+                    for (int yy = 0; yy < magnificationFactor; ++yy, worldY += magnificationFactorInvF)
                     {
+                        rgbaColor * const targetRow = targetImageData + baseTargetQuadOffset + yy * targetTextureWidth;
+
                         //
-                        // Bilinear interpolation for X
+                        // Prepare bilinear interpolation for Y
                         //
 
-                        // Linear interpolation between x samples at bottom
-                        vec2f const interpolatedXColorBottom = Mix(
-                            materialTexture.Data[xInterpolationData[xx].pixelXI + pixelYIOffset],
-                            materialTexture.Data[xInterpolationData[xx].nextPixelXI + pixelYIOffset],
-                            xInterpolationData[xx].pixelDx);
+                        float const pixelY = worldY * worldToMaterialTexturePixelConversionFactor;
+
+                        // Integral part
+                        auto pixelYI = FastTruncateToArchInt(pixelY);
+
+                        // Fractional part between index and next index
+                        float const pixelDy = pixelY - pixelYI;
+
+                        // Wrap integral coordinates; the next row is always after this one, thanks to the repeated row
+                        pixelYI %= static_cast<decltype(pixelYI)>(materialTexture->Size.height);
+
+                        assert(pixelYI >= 0 && pixelYI < materialTexture->Size.height);
+                        assert(pixelDy >= 0.0f && pixelDy < 1.0f);
 
-                        // Linear interpolation between x samples at top
-                        vec2f const interpolatedXColorTop = Mix(
-                            materialTexture.Data[xInterpolationData[xx].pixelXI + nextPixelYIOffset],
-                            materialTexture.Data[xInterpolationData[xx].nextPixelXI + nextPixelYIOffset],
-                            xInterpolationData[xx].pixelDx);
+                        float const * const bottomRow = materialTexture->Data.get() + pixelYI * materialTextureStride;
+                        float const * const topRow = bottomRow + materialTextureStride;
 
-                        // Linear interpolation between two vertical samples
-                        vec2f const bumpMapSample = Mix(
-                            interpolatedXColorBottom,
-                            interpolatedXColorTop,
-                            pixelDy);
+                        int xx = 0;
+
+#if FS_IS_ARCHITECTURE_X86_64() || FS_IS_ARCHITECTURE_X86_32()
 
                         //
-                        // Bi-directional multiply blending between structural color and bumpmap sample "value" (just r),
-                        // blended again with structural color via material transparency
+                        // Four target pixels at a time
                         //
 
-                        float const whateverFactor = (2.0f * bumpMapSample.x - 1.0f) * materialTextureAlpha;
-
-                        vec3f resultantColor;
-                        if (bumpMapSample.x <= 0.5f)
+                        __m128 const pixelDy_4 = _mm_set1_ps(pixelDy);
+                        __m128 const half_4 = _mm_set1_ps(0.5f);
+                        __m128 const one_4 = _mm_set1_ps(1.0f);
+                        __m128 const two_4 = _mm_set1_ps(2.0f);
+                        __m128 const materialTextureAlpha_4 = _mm_set1_ps(materialTextureAlpha);
+                        __m128 const colorR_4 = _mm_set1_ps(structurePixelColorF.x);
+                        __m128 const colorG_4 = _mm_set1_ps(structurePixelColorF.y);
+                        __m128 const colorB_4 = _mm_set1_ps(structurePixelColorF.z);
+                        __m128 const scale255_4 = _mm_set1_ps(255.0f);
+                        __m128 const rounding_4 = _mm_set1_ps(0.5f);
+                        __m128i const alpha_4 = _mm_set1_epi32(static_cast<int>(static_cast<std::uint32_t>(structurePixelColor.a) << 24));
+
+                        for (; xx + 4 <= magnificationFactor; xx += 4)
                         {
-                            // Damper: input * [0.0, 1.0]
-                            // Then: mix of input and of result of multiply-blend, via materialTextureAlpha
-                            resultantColor = structurePixelColorF * (1.0f + whateverFactor);
+                            int const * const xi = pixelXIs.data() + xx;
+
+                            //
+                            // Bilinear interpolation
+                            //
+
+                            __m128 const bottomLeft_4 = _mm_setr_ps(bottomRow[xi[0]], bottomRow[xi[1]], bottomRow[xi[2]], bottomRow[xi[3]]);
+                            __m128 const bottomRight_4 = _mm_setr_ps(bottomRow[xi[0] + 1], bottomRow[xi[1] + 1], bottomRow[xi[2] + 1], bottomRow[xi[3] + 1]);
+                            __m128 const topLeft_4 = _mm_setr_ps(topRow[xi[0]], topRow[xi[1]], topRow[xi[2]], topRow[xi[3]]);
+                            __m128 const topRight_4 = _mm_setr_ps(topRow[xi[0] + 1], topRow[xi[1] + 1], topRow[xi[2] + 1], topRow[xi[3] + 1]);
+
+                            __m128 const pixelDx_4 = _mm_loadu_ps(pixelDxs.data() + xx);
+
+                            __m128 const bottom_4 = _mm_add_ps(bottomLeft_4, _mm_mul_ps(_mm_sub_ps(bottomRight_4, bottomLeft_4), pixelDx_4));
+                            __m128 const top_4 = _mm_add_ps(topLeft_4, _mm_mul_ps(_mm_sub_ps(topRight_4, topLeft_4), pixelDx_4));
+                            __m128 const bumpMapSample_4 = _mm_add_ps(bottom_4, _mm_mul_ps(_mm_sub_ps(top_4, bottom_4), pixelDy_4));
+
+                            //
+                            // Bi-directional multiply blending - see scalar version below
+                            //
+                            // resultantColor = structurePixelColor * scale + add, where:
+                            //  - Damper:    scale = 1 + whateverFactor, add = 0
+                            //  - Amplifier: scale = 1 - whateverFactor, add = bumpMapSample * whateverFactor
+                            //
+
+                            __m128 const whateverFactor_4 = _mm_mul_ps(
+                                _mm_sub_ps(_mm_mul_ps(two_4, bumpMapSample_4), one_4),
+                                materialTextureAlpha_4);
+
+                            __m128 const isDamper_4 = _mm_cmple_ps(bumpMapSample_4, half_4);
+
+                            __m128 const scale_4 = _mm_or_ps(
+                                _mm_and_ps(isDamper_4, _mm_add_ps(one_4, whateverFactor_4)),
+                                _mm_andnot_ps(isDamper_4, _mm_sub_ps(one_4, whateverFactor_4)));
+
+                            __m128 const add_4 = _mm_andnot_ps(
+                                isDamper_4,
+                                _mm_mul_ps(bumpMapSample_4, whateverFactor_4));
+
+                            //
+                            // Store resultant colors, using structure's alpha channel value as the final alpha;
+                            // conversion is as in rgbaColor(vec3f, alpha)
+                            //
+
+                            __m128i const r_4 = _mm_cvttps_epi32(_mm_add_ps(_mm_mul_ps(_mm_add_ps(_mm_mul_ps(colorR_4, scale_4), add_4), scale255_4), rounding_4));
+                            __m128i const g_4 = _mm_cvttps_epi32(_mm_add_ps(_mm_mul_ps(_mm_add_ps(_mm_mul_ps(colorG_4, scale_4), add_4), scale255_4), rounding_4));
+                            __m128i const b_4 = _mm_cvttps_epi32(_mm_add_ps(_mm_mul_ps(_mm_add_ps(_mm_mul_ps(colorB_4, scale_4), add_4), scale255_4), rounding_4));
+
+                            __m128i const rgba_4 = _mm_or_si128(
+                                _mm_or_si128(r_4, _mm_slli_epi32(g_4, 8)),
+                                _mm_or_si128(_mm_slli_epi32(b_4, 16), alpha_4));
+
+                            _mm_storeu_si128(reinterpret_cast<__m128i *>(targetRow + xx), rgba_4);
                         }
-                        else
+
+#endif
+
+                        for (; xx < magnificationFactor; ++xx)
                         {
-                            // Amplifier: input + (bump - input) * [0.0, 1.0]
-                            // Then: mix of input and of result of multiply-blend, via materialTextureAlpha
-                            float const bFactor = bumpMapSample.x * whateverFactor;
-                            resultantColor = structurePixelColorF * (1.0f - whateverFactor) + vec3f(bFactor, bFactor, bFactor);
+                            //
+                            // Bilinear interpolation
+                            //
+
+                            int const pixelXI = pixelXIs[xx];
+
+                            // Linear interpolation between x samples at bottom
+                            float const interpolatedXColorBottom = Mix(
+                                bottomRow[pixelXI],
+                                bottomRow[pixelXI + 1],
+                                pixelDxs[xx]);
+
+                            // Linear interpolation between x samples at top
+                            float const interpolatedXColorTop = Mix(
+                                topRow[pixelXI],
+                                topRow[pixelXI + 1],
+                                pixelDxs[xx]);
+
+                            // Linear interpolation between two vertical samples
+                            float const bumpMapSample = Mix(
+                                interpolatedXColorBottom,
+                                interpolatedXColorTop,
+                                pixelDy);
+
+                            //
+                            // Bi-directional multiply blending between structural color and bumpmap sample "value",
+                            // blended again with structural color via material transparency
+                            //
+
+                            float const whateverFactor = (2.0f * bumpMapSample - 1.0f) * materialTextureAlpha;
+
+                            vec3f resultantColor;
+                            if (bumpMapSample <= 0.5f)
+                            {
+                                // Damper: input * [0.0, 1.0]
+                                // Then: mix of input and of result of multiply-blend, via materialTextureAlpha
+                                resultantColor = structurePixelColorF * (1.0f + whateverFactor);
+                            }
+                            else
+                            {
+                                // Amplifier: input + (bump - input) * [0.0, 1.0]
+                                // Then: mix of input and of result of multiply-blend, via materialTextureAlpha
+                                float const bFactor = bumpMapSample * whateverFactor;
+                                resultantColor = structurePixelColorF * (1.0f - whateverFactor) + vec3f(bFactor, bFactor, bFactor);
+                            }
+
+                            // Store resultant color, using structure's alpha channel value as the final alpha
+                            targetRow[xx] = rgbaColor(
+                                resultantColor,
+                                structurePixelColor.a);
                         }
-
-                        // Store resultant color, using structure's alpha channel value as the final alpha
-                        targetImageData[targetQuadOffset + xx] = rgbaColor(
-                            resultantColor,
-                            structurePixelColor.a);
                     }
                 }
             }
         }
-    }
+    };
+
+    ForEachRowChunk(
+        startY,
+        endY,
+        static_cast<size_t>(structuralLayerRegion.size.width) * static_cast<size_t>(magnificationFactor * magnificationFactor),
+        texturizeRows);
 }
 
 void ShipTexturizer::RenderShipInto(
@@ -398,146 +525,155 @@ void ShipTexturizer::RenderShipInto(
     int const startX = structuralLayerRegion.origin.x;
     int const endX = structuralLayerRegion.origin.x + structuralLayerRegion.size.width;
 
-    for (int y = startY; y < endY; ++y)
+    auto const renderRows = [&](int chunkStartY, int chunkEndY)
     {
-        for (int x = startX; x < endX; ++x)
+        for (int y = chunkStartY; y < chunkEndY; ++y)
         {
-            //
-            // We now populate the target texture in the quad whose corners lie at these coordinates (in the target texture):
-            //
-            // 3:(x * magnificationFactor, (y + 1) * magnificationFactor) ... 4:((x + 1) * magnificationFactor, (y + 1) * magnificationFactor)
-            // ...
-            // ...
-            // ...
-            // 1:[x * magnificationFactor, y * magnificationFactor] ... 2:((x + 1) * magnificationFactor, y * magnificationFactor)
-            //
-            // We actually populate quads or triangles (with |side|==magnificationFactor), depending on the presence of the four corners. We do so by:
-            //  - Looping for all target YY's in the quad
-            //  - For each YY:
-            //      - Fill-in the XX segment between xxStart and xxEnd, and transparent outside (prefix and suffix)
-            //      - Change xxStart and xxEnd depending on Y
-            //
-
-            //
-            // Determine quad vertices
-            //
-
-            // Init with no quad - prefix only
-            int xxStart = magnificationFactor, xxStartIncr = 0;
-            int xxEnd = magnificationFactor, xxEndIncr = 0;
-
-            bool const hasVertex1 = structuralBuffer[{x, y}].Material != nullptr;
-
-            ShipSpaceCoordinates const coords2 = ShipSpaceCoordinates(x + 1, y);
-            bool const hasVertex2 = coords2.IsInSize(structuralSize) && structuralBuffer[coords2].Material != nullptr;
-
-            ShipSpaceCoordinates const coords3 = ShipSpaceCoordinates(x, y + 1);
-            bool const hasVertex3 = coords3.IsInSize(structuralSize) && structuralBuffer[coords3].Material != nullptr;
-
-            ShipSpaceCoordinates const coords4 = ShipSpaceCoordinates(x + 1, y + 1);
-            bool const hasVertex4 = coords4.IsInSize(structuralSize) && structuralBuffer[coords4].Material != nullptr;
-
-            if (hasVertex1)
+            for (int x = startX; x < endX; ++x)
             {
-                if (hasVertex2)
+                //
+                // We now populate the target texture in the quad whose corners lie at these coordinates (in the target texture):
+                //
+                // 3:(x * magnificationFactor, (y + 1) * magnificationFactor) ... 4:((x + 1) * magnificationFactor, (y + 1) * magnificationFactor)
+                // ...
+                // ...
+                // ...
+                // 1:[x * magnificationFactor, y * magnificationFactor] ... 2:((x + 1) * magnificationFactor, y * magnificationFactor)
+                //
+                // We actually populate quads or triangles (with |side|==magnificationFactor), depending on the presence of the four corners. We do so by:
+                //  - Looping for all target YY's in the quad
+                //  - For each YY:
+                //      - Fill-in the XX segment between xxStart and xxEnd, and transparent outside (prefix and suffix)
+                //      - Change xxStart and xxEnd depending on Y
+                //
+
+                //
+                // Determine quad vertices
+                //
+
+                // Init with no quad - prefix only
+                int xxStart = magnificationFactor, xxStartIncr = 0;
+                int xxEnd = magnificationFactor, xxEndIncr = 0;
+
+                bool const hasVertex1 = structuralBuffer[{x, y}].Material != nullptr;
+
+                ShipSpaceCoordinates const coords2 = ShipSpaceCoordinates(x + 1, y);
+                bool const hasVertex2 = coords2.IsInSize(structuralSize) && structuralBuffer[coords2].Material != nullptr;
+
+                ShipSpaceCoordinates const coords3 = ShipSpaceCoordinates(x, y + 1);
+                bool const hasVertex3 = coords3.IsInSize(structuralSize) && structuralBuffer[coords3].Material != nullptr;
+
+                ShipSpaceCoordinates const coords4 = ShipSpaceCoordinates(x + 1, y + 1);
+                bool const hasVertex4 = coords4.IsInSize(structuralSize) && structuralBuffer[coords4].Material != nullptr;
+
+                if (hasVertex1)
                 {
-                    if (hasVertex3)
+                    if (hasVertex2)
                     {
-                        if (hasVertex4)
+                        if (hasVertex3)
                         {
-                            // Whole quad
-                            xxStart = 0; xxStartIncr = 0;
-                            xxEnd = magnificationFactor; xxEndIncr = 0;
+                            if (hasVertex4)
+                            {
+                                // Whole quad
+                                xxStart = 0; xxStartIncr = 0;
+                                xxEnd = magnificationFactor; xxEndIncr = 0;
+                            }
+                            else
+                            {
+                                // 3
+                                // |
+                                // 1---2
+
+                                xxStart = 0; xxStartIncr = 0;
+                                xxEnd = magnificationFactor; xxEndIncr = -1;
+                            }
                         }
-                        else
+                        else if (hasVertex4)
                         {
-                            // 3
-                            // |
+                            //     4
+                            //     |
                             // 1---2
 
-                            xxStart = 0; xxStartIncr = 0;
-                            xxEnd = magnificationFactor; xxEndIncr = -1;
+                            xxStart = 0; xxStartIncr = 1;
+                            xxEnd = magnificationFactor; xxEndIncr = 0;
                         }
                     }
-                    else if (hasVertex4)
+                    else
                     {
-                        //     4
-                        //     |
-                        // 1---2
+                        // No vertex 2
 
-                        xxStart = 0; xxStartIncr = 1;
-                        xxEnd = magnificationFactor; xxEndIncr = 0;
+                        if (hasVertex3 && hasVertex4)
+                        {
+                            // 3---4
+                            // |
+                            // 1
+
+                            xxStart = 0; xxStartIncr = 0;
+                            xxEnd = 1; xxEndIncr = 1;
+                        }
                     }
                 }
                 else
                 {
-                    // No vertex 2
+                    // No vertex 1
 
-                    if (hasVertex3 && hasVertex4)
+                    if (hasVertex2 && hasVertex3 && hasVertex4)
                     {
                         // 3---4
-                        // |
-                        // 1
+                        //     |
+                        //     2
 
-                        xxStart = 0; xxStartIncr = 0;
-                        xxEnd = 1; xxEndIncr = 1;
+                        xxStart = magnificationFactor - 1; xxStartIncr = -1;
+                        xxEnd = magnificationFactor; xxEndIncr = 0;
                     }
                 }
-            }
-            else
-            {
-                // No vertex 1
 
-                if (hasVertex2 && hasVertex3 && hasVertex4)
-                {
-                    // 3---4
-                    //     |
-                    //     2
-
-                    xxStart = magnificationFactor - 1; xxStartIncr = -1;
-                    xxEnd = magnificationFactor; xxEndIncr = 0;
-                }
-            }
-
-            //
-            // Fill-in quad
-            //
+                //
+                // Fill-in quad
+                //
 
-            int targetQuadOffset =
-                (y * magnificationFactor) * targetTextureWidth
-                + x * magnificationFactor;
+                int targetQuadOffset =
+                    (y * magnificationFactor) * targetTextureWidth
+                    + x * magnificationFactor;
 
-            for (int yy = 0;
-                yy < magnificationFactor;
-                ++yy, xxStart += xxStartIncr, xxEnd += xxEndIncr, targetQuadOffset += targetTextureWidth)
-            {
-                // Prefix - fill with empty
-                assert(0 <= xxStart && xxStart <= magnificationFactor);
-                for (int xx = 0; xx < xxStart; ++xx)
+                for (int yy = 0;
+                    yy < magnificationFactor;
+                    ++yy, xxStart += xxStartIncr, xxEnd += xxEndIncr, targetQuadOffset += targetTextureWidth)
                 {
-                    targetImageData[targetQuadOffset + xx] = TransparentColor;
-                }
+                    // Prefix - fill with empty
+                    assert(0 <= xxStart && xxStart <= magnificationFactor);
+                    for (int xx = 0; xx < xxStart; ++xx)
+                    {
+                        targetImageData[targetQuadOffset + xx] = TransparentColor;
+                    }
 
-                // Body - fill with source texture
-                for (int xx = xxStart; xx < xxEnd; ++xx)
-                {
-                    rgbaColor const textureSample = SampleTextureBilinearConstrained(
-                        sourceTextureImage,
-                        sampleOffsetX + targetTextureSpaceToSourceTextureSpaceX * (x * magnificationFactor + xx),
-                        sampleOffsetY + targetTextureSpaceToSourceTextureSpaceY * (y * magnificationFactor + yy));
+                    // Body - fill with source texture
+                    for (int xx = xxStart; xx < xxEnd; ++xx)
+                    {
+                        rgbaColor const textureSample = SampleTextureBilinearConstrained(
+                            sourceTextureImage,
+                            sampleOffsetX + targetTextureSpaceToSourceTextureSpaceX * (x * magnificationFactor + xx),
+                            sampleOffsetY + targetTextureSpaceToSourceTextureSpaceY * (y * magnificationFactor + yy));
 
-                    targetImageData[targetQuadOffset + xx] = textureSample;
-                }
+                        targetImageData[targetQuadOffset + xx] = textureSample;
+                    }
 
-                // Suffix - fill with empty
-                assert(0 <= xxEnd && xxEnd <= magnificationFactor);
-                for (int xx = xxEnd; xx < magnificationFactor; ++xx)
-                {
-                    targetImageData[targetQuadOffset + xx] = TransparentColor;
+                    // Suffix - fill with empty
+                    assert(0 <= xxEnd && xxEnd <= magnificationFactor);
+                    for (int xx = xxEnd; xx < magnificationFactor; ++xx)
+                    {
+                        targetImageData[targetQuadOffset + xx] = TransparentColor;
+                    }
                 }
             }
         }
-    }
+    };
+
+    ForEachRowChunk(
+        startY,
+        endY,
+        static_cast<size_t>(structuralLayerRegion.size.width) * static_cast<size_t>(magnificationFactor * magnificationFactor),
+        renderRows);
 }
 
 ///////////////////////////////////////////////////////////////////////////////////
@@ -621,7 +757,7 @@ RgbaImageData ShipTexturizer::MakeTextureSample(
     auto sampleData = std::make_unique<rgbaColor[]>(sampleSize.GetLinearSize());
 
     // Get bump map texture and render color
-    Vec2fImageData const & materialTexture = GetMaterialTexture(textureName);
+    auto const materialTexture = GetMaterialTexture(textureName);
     vec3f const renderPixelColorF = renderColor.toVec3f();
 
     // Calculate constants
@@ -638,8 +774,8 @@ RgbaImageData ShipTexturizer::MakeTextureSample(
 
         for (int x = 0; x < sampleSize.width / 2; ++x)
         {
-            vec2f const bumpMapSample = SampleTextureBilinearRepeated(
-                materialTexture,
+            float const bumpMapSample = SampleTextureBilinearRepeated(
+                *materialTexture,
                 static_cast<float>(x) * sampleToMaterialTexturePixelConversionFactor,
                 static_cast<float>(y) * sampleToMaterialTexturePixelConversionFactor);
 
@@ -662,7 +798,7 @@ RgbaImageData ShipTexturizer::MakeTextureSample(
     return RgbaImageData(sampleSize, std::move(sampleData));
 }
 
-ShipTexturizer::Vec2fImageData const & ShipTexturizer::GetMaterialTexture(std::optional<std::string> const & textureName) const
+std::shared_ptr<ShipTexturizer::MaterialTexture const> ShipTexturizer::GetMaterialTexture(std::optional<std::string> const & textureName) const
 {
     std::string const actualTextureName = textureName.value_or(MaterialTextureNameNone);
 
@@ -687,23 +823,31 @@ ShipTexturizer::Vec2fImageData const & ShipTexturizer::GetMaterialTexture(std::o
         assert(mMaterialTextureNameToTextureFilePathMap.count(actualTextureName) > 0);
         RgbImageData texture = ImageFileTools::LoadImageRgb(mMaterialTextureNameToTextureFilePathMap.at(actualTextureName));
 
-        // Convert to vec2f
-        auto const pixelCount = texture.Size.GetLinearSize();
-        std::unique_ptr<vec2f[]> vec2fTexture = std::make_unique<vec2f[]>(pixelCount);
-        for (size_t p = 0; p < pixelCount; ++p)
+        // Convert to value, repeating the first column and the first row at the end
+        int const width = texture.Size.width;
+        int const height = texture.Size.height;
+        int const stride = width + 1;
+        std::unique_ptr<float[]> valueTexture = std::make_unique<float[]>(static_cast<size_t>(stride) * static_cast<size_t>(height + 1));
+        for (int y = 0; y <= height; ++y)
         {
-            assert(texture.Data[p].r == texture.Data[p].g);
-            assert(texture.Data[p].r == texture.Data[p].b);
+            rgbColor const * const sourceRow = texture.Data.get() + (y % height) * width;
+            float * const targetRow = valueTexture.get() + y * stride;
+
+            for (int x = 0; x < width; ++x)
+            {
+                assert(sourceRow[x].r == sourceRow[x].g);
+                assert(sourceRow[x].r == sourceRow[x].b);
+
+                targetRow[x] = static_cast<float>(sourceRow[x].r) / 255.0f;
+            }
 
-            vec2fTexture[p] = vec2f(
-                static_cast<float>(texture.Data[p].r) / 255.0f,
-                1.0f); // Alpha: at this moment we hardcode it as opaque, we'll think whether we want to make transparent chains
+            targetRow[width] = targetRow[0];
         }
 
         // Insert texture into cache
         auto const inserted = mMaterialTextureCache.emplace(
             actualTextureName,
-            Vec2fImageData(texture.Size, std::move(vec2fTexture)));
+            std::make_shared<MaterialTexture const>(texture.Size, std::move(valueTexture)));
 
         assert(inserted.second);
 
@@ -711,6 +855,38 @@ ShipTexturizer::Vec2fImageData const & ShipTexturizer::GetMaterialTexture(std::o
     }
 }
 
+template<typename TFunc>
+void ShipTexturizer::ForEachRowChunk(
+    int startY,
+    int endY,
+    size_t targetPixelsPerRow,
+    TFunc const & func) const
+{
+    if (startY >= endY)
+        return;
+
+    if (static_cast<size_t>(endY - startY) * targetPixelsPerRow >= ParallelMinTargetPixels)
+    {
+        if (!mTaskThreadPool)
+        {
+            mTaskThreadPool = std::make_unique<TaskThreadPool>();
+        }
+
+        mTaskThreadPool->ParallelFor(
+            static_cast<size_t>(startY),
+            static_cast<size_t>(endY),
+            ParallelRowsPerChunk,
+            [&func](size_t chunkStartY, size_t chunkEndY)
+            {
+                func(static_cast<int>(chunkStartY), static_cast<int>(chunkEndY));
+            });
+    }
+    else
+    {
+        func(startY, endY);
+    }
+}
+
 void ShipTexturizer::ResetMaterialTextureCacheUseCounts() const
 {
     std::for_each(
@@ -801,8 +977,8 @@ rgbaColor ShipTexturizer::SampleTextureBilinearConstrained(
             pixelDy));
 }
 
-vec2f ShipTexturizer::SampleTextureBilinearRepeated(
-    Vec2fImageData const & texture,
+float ShipTexturizer::SampleTextureBilinearRepeated(
+    MaterialTexture const & texture,
     float pixelX,
     float pixelY) const
 {
@@ -824,22 +1000,22 @@ vec2f ShipTexturizer::SampleTextureBilinearRepeated(
     assert(pixelDy >= 0.0f && pixelDy < 1.0f);
 
     //
-    // Bilinear
+    // Bilinear - no need to wrap next coordinates, thanks to the repeated column and row
     //
 
-    int const nextPixelXI = (pixelXI + 1) % static_cast<decltype(pixelXI)>(texture.Size.width);
-    int const nextPixelYI = (pixelYI + 1) % static_cast<decltype(pixelYI)>(texture.Size.height);
+    float const * const bottomRow = texture.Data.get() + pixelYI * texture.GetStride();
+    float const * const topRow = bottomRow + texture.GetStride();
 
     // Linear interpolation between x samples at bottom
-    vec2f const interpolatedXColorBottom = Mix(
-        texture.Data[pixelXI + pixelYI * texture.Size.width],
-        texture.Data[nextPixelXI + pixelYI * texture.Size.width],
+    float const interpolatedXColorBottom = Mix(
+        bottomRow[pixelXI],
+        bottomRow[pixelXI + 1],
         pixelDx);
 
     // Linear interpolation between x samples at top
-    vec2f const interpolatedXColorTop = Mix(
-        texture.Data[pixelXI + nextPixelYI * texture.Size.width],
-        texture.Data[nextPixelXI + nextPixelYI * texture.Size.width],
+    float const interpolatedXColorTop = Mix(
+        topRow[pixelXI],
+        topRow[pixelXI + 1],
         pixelDx);
 
     // Linear interpolation between two vertical samples
@@ -12,10 +12,12 @@
 
 #include <GameCore/GameTypes.h>
 #include <GameCore/ImageData.h>
+#include <GameCore/TaskThreadPool.h>
 #include <GameCore/Vectors.h>
 
 #include <cassert>
 #include <filesystem>
+#include <memory>
 #include <optional>
 #include <unordered_map>
 
@@ -27,6 +29,13 @@ public:
         MaterialDatabase const & materialDatabase,
         ResourceLocator const & resourceLocator);
 
+    /*
+     * Copies the settings and the material textures, but not the material texture cache;
+     * as the cache is mutated while texturizing, each thread texturizing concurrently
+     * needs a texturizer of its own.
+     */
+    ShipTexturizer(ShipTexturizer const & other);
+
     static int CalculateHighDefinitionTextureMagnificationFactor(ShipSpaceSize const & shipSize);
 
     RgbaImageData MakeAutoTexture(
@@ -89,9 +98,40 @@ public:
         mDoForceSharedSettingsOntoShipSettings = value;
     }
 
+    /*
+     * The settings that an auto-texture made with the specified ship settings would be made with.
+     */
+    ShipAutoTexturizationSettings const & GetActualSettings(std::optional<ShipAutoTexturizationSettings> const & settings) const
+    {
+        return (mDoForceSharedSettingsOntoShipSettings || !settings.has_value())
+            ? mSharedSettings
+            : *settings;
+    }
+
 private:
 
-    using Vec2fImageData = ImageData<vec2f>;
+    /*
+     * A material texture, pre-converted for bilinear sampling with repeat: only its value
+     * is kept, and its first column and first row are repeated after its last column and
+     * last row, so that the next sample along either direction never needs wrapping.
+     */
+    struct MaterialTexture
+    {
+        ImageSize Size; // Excluding the repeated column and row
+        std::unique_ptr<float[]> Data; // (Size.width + 1) x (Size.height + 1)
+
+        MaterialTexture(
+            ImageSize const & size,
+            std::unique_ptr<float[]> data)
+            : Size(size)
+            , Data(std::move(data))
+        {}
+
+        int GetStride() const
+        {
+            return Size.width + 1;
+        }
+    };
 
 private:
 
@@ -107,7 +147,16 @@ private:
         rgbaColor const & renderColor,
         std::optional<std::string> const & textureName) const;
 
-    inline Vec2fImageData const & GetMaterialTexture(std::optional<std::string> const & textureName) const;
+    // Returned textures remain valid even after they're purged from the cache
+    inline std::shared_ptr<MaterialTexture const> GetMaterialTexture(std::optional<std::string> const & textureName) const;
+
+    // Runs func(startY, endY) over the specified rows, in parallel when the target area is large enough
+    template<typename TFunc>
+    void ForEachRowChunk(
+        int startY,
+        int endY,
+        size_t targetPixelsPerRow,
+        TFunc const & func) const;
 
     void ResetMaterialTextureCacheUseCounts() const;
 
@@ -118,8 +167,8 @@ private:
         float pixelX,
         float pixelY) const;
 
-    inline vec2f SampleTextureBilinearRepeated(
-        Vec2fImageData const & texture,
+    inline float SampleTextureBilinearRepeated(
+        MaterialTexture const & texture,
         float pixelX,
         float pixelY) const;
 
@@ -140,14 +189,21 @@ private:
 
     struct CachedTexture
     {
-        Vec2fImageData Texture;
+        std::shared_ptr<MaterialTexture const> Texture;
         size_t UseCount;
 
-        CachedTexture(Vec2fImageData && texture)
+        CachedTexture(std::shared_ptr<MaterialTexture const> && texture)
             : Texture(std::move(texture))
             , UseCount(0)
         {}
     };
 
     mutable std::unordered_map<std::string, CachedTexture> mMaterialTextureCache;
+
+    //
+    // Threading
+    //
+
+    // Created at first need; texturizers are not to be used by multiple threads at the same time anyway
+    mutable std::unique_ptr<TaskThreadPool> mTaskThreadPool;
 };
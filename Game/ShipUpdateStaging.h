@@ -0,0 +1,179 @@
+/***************************************************************************************
+* Original Author:      Gabriele Giuseppini
+* Created:              2026-10-14
+* Copyright:            Gabriele Giuseppini  (https://github.com/GabrieleGiuseppini)
+***************************************************************************************/
+#pragma once
+
+#include "AggregatedGameEvents.h"
+
+#include <GameCore/AABBSet.h>
+#include <GameCore/GameRandomEngine.h>
+
+#include <cassert>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+/*
+ * The staging area for the side effects of the update of a single ship which
+ * target state shared among all ships - AABBs, game events, ocean surface
+ * displacements, fish disturbances.
+ *
+ * When ships are updated concurrently, each ship is updated with its own
+ * staging area installed on the thread that runs the update; while installed,
+ * the owners of shared state record deferred actions into the staging area
+ * rather than applying them. The staging areas are then merged - in ship order -
+ * on the main thread, after all ships have completed their update.
+ *
+ * Each staging area also has a random engine of its own, which is installed on the
+ * thread together with the staging area, so that ships being updated concurrently
+ * never draw from the same engine.
+ */
+class ShipUpdateStaging final
+{
+public:
+
+    using DeferredAction = std::function<void()>;
+
+    struct OceanSurfaceDisplacement
+    {
+        float X;
+        float YOffset;
+
+        OceanSurfaceDisplacement(
+            float x,
+            float yOffset)
+            : X(x)
+            , YOffset(yOffset)
+        {}
+    };
+
+    /*
+     * Installs a staging area - and its random engine - on the current thread for the
+     * lifetime of the scope.
+     */
+    class Scope final
+    {
+    public:
+
+        explicit Scope(ShipUpdateStaging & staging)
+            : mPrevious(CurrentStaging)
+            , mRandomEngineScope(staging.mRandomEngine)
+        {
+            CurrentStaging = &staging;
+        }
+
+        ~Scope()
+        {
+            CurrentStaging = mPrevious;
+        }
+
+        Scope(Scope const &) = delete;
+        Scope & operator=(Scope const &) = delete;
+
+    private:
+
+        ShipUpdateStaging * const mPrevious;
+        GameRandomEngine::Scope const mRandomEngineScope;
+    };
+
+public:
+
+    /*
+     * The random stream ID identifies the sequence drawn by the random engine
+     * of this staging area.
+     */
+    explicit ShipUpdateStaging(std::uint32_t randomStreamId)
+        : mAABBs()
+        , mAggregatedGameEvents()
+        , mDeferredActions()
+        , mOceanSurfaceDisplacements()
+        , mRandomEngine(randomStreamId)
+    {}
+
+    /*
+     * Returns the staging area installed on the current thread, if any.
+     */
+    static ShipUpdateStaging * GetCurrent()
+    {
+        return CurrentStaging;
+    }
+
+    Geometry::AABBSet & GetAABBs()
+    {
+        return mAABBs;
+    }
+
+    AggregatedGameEvents & GetAggregatedGameEvents()
+    {
+        return mAggregatedGameEvents;
+    }
+
+    /*
+     * Ocean surface displacements are many - up to one per point per simulation step -
+     * hence we stage them as plain values rather than as deferred actions.
+     */
+    void AddOceanSurfaceDisplacement(
+        float x,
+        float yOffset)
+    {
+        mOceanSurfaceDisplacements.emplace_back(x, yOffset);
+    }
+
+    std::vector<OceanSurfaceDisplacement> const & GetOceanSurfaceDisplacements() const
+    {
+        return mOceanSurfaceDisplacements;
+    }
+
+    template<typename TAction>
+    void Defer(TAction && action)
+    {
+        mDeferredActions.emplace_back(std::forward<TAction>(action));
+    }
+
+    /*
+     * Merges the AABBs into the specified set and runs all deferred actions,
+     * in the order in which they were recorded; leaves the staging area empty.
+     * Ocean surface displacements are discarded, and must have been applied by
+     * the caller already.
+     *
+     * Must be invoked on the main thread, with no staging area installed.
+     */
+    void MergeInto(Geometry::AABBSet & aabbSet)
+    {
+        assert(GetCurrent() == nullptr);
+
+        for (auto const & aabb : mAABBs.GetItems())
+        {
+            aabbSet.Add(aabb);
+        }
+
+        mAABBs.Clear();
+
+        for (auto const & action : mDeferredActions)
+        {
+            action();
+        }
+
+        mDeferredActions.clear();
+
+        mOceanSurfaceDisplacements.clear();
+    }
+
+private:
+
+    Geometry::AABBSet mAABBs;
+
+    AggregatedGameEvents mAggregatedGameEvents; // Merged by the game event dispatcher
+
+    std::vector<DeferredAction> mDeferredActions;
+
+    // Applied by the world, before merging
+    std::vector<OceanSurfaceDisplacement> mOceanSurfaceDisplacements;
+
+    // Keeps its sequence across updates
+    GameRandomEngine mRandomEngine;
+
+    static inline thread_local ShipUpdateStaging * CurrentStaging = nullptr;
+};
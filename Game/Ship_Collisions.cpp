@@ -0,0 +1,184 @@
+/***************************************************************************************
+* Original Author:      Gabriele Giuseppini
+* Created:              2026-10-14
+* Copyright:            Gabriele Giuseppini  (https://github.com/GabrieleGiuseppini)
+***************************************************************************************/
+#include "Physics.h"
+
+#include <GameCore/Profiler.h>
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+
+namespace Physics {
+
+// Two points of different ships are in contact when closer than this
+static float constexpr ShipContactDistance = 0.5f; // m
+
+// Fraction of the normal approach velocity that is restituted at a contact
+static float constexpr ShipContactElasticity = 0.1f;
+
+// Fraction of the penetration that is resolved at each step, to avoid jitter
+static float constexpr ShipContactPositionCorrection = 0.5f;
+
+// The narrow phase is run in partitions of at least this many candidate points
+static size_t constexpr MinShipCollisionPointsPerPartition = 512;
+
+void Ship::HandleCollisionsWithShip(
+    Ship & otherShip,
+    Geometry::AABB const & overlapBox,
+    GameParameters const & /*gameParameters*/)
+{
+    FS_PROFILE_SCOPE("Ship::HandleCollisionsWithShip");
+
+    assert(&otherShip != this);
+
+    //
+    // 1) Find our points in the overlap region
+    //
+
+    Geometry::AABB const contactBox(
+        overlapBox.BottomLeft.x - ShipContactDistance,
+        overlapBox.TopRight.x + ShipContactDistance,
+        overlapBox.TopRight.y + ShipContactDistance,
+        overlapBox.BottomLeft.y - ShipContactDistance);
+
+    mPoints.PrepareSpatialIndex();
+    mPoints.QueryPointsInBox(contactBox, false, mShipCollisionCandidatePoints);
+
+    if (mShipCollisionCandidatePoints.empty())
+    {
+        return;
+    }
+
+    //
+    // 2) Narrow phase: find, concurrently, the points of the other ship that are in contact
+    //    with our candidate points; this only reads positions
+    //
+
+    otherShip.mPoints.PrepareSpatialIndex();
+
+    size_t const candidateCount = mShipCollisionCandidatePoints.size();
+
+    size_t const partitionCount = std::max(
+        std::min(
+            mTaskThreadPool->GetParallelism(),
+            candidateCount / MinShipCollisionPointsPerPartition),
+        size_t(1));
+
+    if (mShipContactPartitions.size() < partitionCount)
+    {
+        mShipContactPartitions.resize(partitionCount);
+    }
+
+    size_t const partitionSize = (candidateCount + partitionCount - 1) / partitionCount;
+
+    float constexpr SquareShipContactDistance = ShipContactDistance * ShipContactDistance;
+
+    mTaskThreadPool->ParallelFor(
+        0,
+        partitionCount,
+        1,
+        [&](size_t start, size_t end)
+        {
+            for (size_t p = start; p < end; ++p)
+            {
+                auto & partition = mShipContactPartitions[p];
+                partition.Contacts.clear();
+
+                size_t const partitionEnd = std::min((p + 1) * partitionSize, candidateCount);
+                for (size_t c = p * partitionSize; c < partitionEnd; ++c)
+                {
+                    ElementIndex const pointIndex = mShipCollisionCandidatePoints[c];
+                    vec2f const & pointPosition = mPoints.GetPosition(pointIndex);
+
+                    otherShip.mPoints.QueryPointsInBox(
+                        Geometry::AABB(
+                            pointPosition.x - ShipContactDistance,
+                            pointPosition.x + ShipContactDistance,
+                            pointPosition.y + ShipContactDistance,
+                            pointPosition.y - ShipContactDistance),
+                        false,
+                        partition.QueryResult);
+
+                    for (auto const otherPointIndex : partition.QueryResult)
+                    {
+                        vec2f const separation = pointPosition - otherShip.mPoints.GetPosition(otherPointIndex);
+                        float const squareDistance = separation.squareLength();
+                        if (squareDistance < SquareShipContactDistance && squareDistance > 0.0f)
+                        {
+                            float const distance = std::sqrt(squareDistance);
+
+                            partition.Contacts.emplace_back(
+                                pointIndex,
+                                otherPointIndex,
+                                separation / distance,
+                                ShipContactDistance - distance);
+                        }
+                    }
+                }
+            }
+        });
+
+    //
+    // 3) Resolve the contacts serially, in partition order - hence in the same
+    //    order as if they had been found by a serial visit
+    //
+
+    for (size_t p = 0; p < partitionCount; ++p)
+    {
+        for (auto const & contact : mShipContactPartitions[p].Contacts)
+        {
+            float const inverseMass = mPoints.IsPinned(contact.PointIndex)
+                ? 0.0f
+                : 1.0f / mPoints.GetMass(contact.PointIndex);
+
+            float const otherInverseMass = otherShip.mPoints.IsPinned(contact.OtherPointIndex)
+                ? 0.0f
+                : 1.0f / otherShip.mPoints.GetMass(contact.OtherPointIndex);
+
+            float const totalInverseMass = inverseMass + otherInverseMass;
+            if (totalInverseMass == 0.0f)
+            {
+                continue;
+            }
+
+            float const share = inverseMass / totalInverseMass;
+            float const otherShare = otherInverseMass / totalInverseMass;
+
+            // Separate the points along the contact normal
+
+            vec2f const correction = contact.Normal * (contact.Penetration * ShipContactPositionCorrection);
+
+            mPoints.SetPosition(
+                contact.PointIndex,
+                mPoints.GetPosition(contact.PointIndex) + correction * share);
+
+            otherShip.mPoints.SetPosition(
+                contact.OtherPointIndex,
+                otherShip.mPoints.GetPosition(contact.OtherPointIndex) - correction * otherShare);
+
+            // Exchange the impulse that cancels the approach velocity, if the points are approaching
+
+            vec2f const velocity = mPoints.GetVelocity(contact.PointIndex);
+            vec2f const otherVelocity = otherShip.mPoints.GetVelocity(contact.OtherPointIndex);
+
+            float const approachVelocity = (velocity - otherVelocity).dot(contact.Normal);
+            if (approachVelocity < 0.0f)
+            {
+                vec2f const velocityDelta = contact.Normal * (-(1.0f + ShipContactElasticity) * approachVelocity);
+
+                mPoints.SetVelocity(
+                    contact.PointIndex,
+                    velocity + velocityDelta * share);
+
+                otherShip.mPoints.SetVelocity(
+                    contact.OtherPointIndex,
+                    otherVelocity - velocityDelta * otherShare);
+            }
+        }
+    }
+}
+
+}
@@ -11,13 +11,18 @@
 
 namespace Physics {
 
+// Force fields only ever touch the static force of each point, hence
+// points may be visited concurrently
+static size_t constexpr ForceFieldPointGrain = 4096;
+
 void Ship::ApplyRadialSpaceWarpForceField(
     vec2f const & centerPosition,
     float radius,
     float radiusThickness,
     float strength)
 {
-    for (auto pointIndex : mPoints)
+    // Only points within the outer edge of the ring are affected
+    for (auto const pointIndex : mPoints.QueryPointsInRadius(centerPosition, radius + radiusThickness, true))
     {
         vec2f const pointRadius = mPoints.GetPosition(pointIndex) - centerPosition;
         float const pointDistanceFromRadius = pointRadius.length() - radius;
@@ -39,32 +44,39 @@ void Ship::ApplyImplosionForceField(
     vec2f const & centerPosition,
     float strength)
 {
-    for (auto pointIndex : mPoints)
-    {
-        vec2f displacement = (centerPosition - mPoints.GetPosition(pointIndex));
-        float const displacementLength = displacement.length();
-        vec2f normalizedDisplacement = displacement.normalise(displacementLength);
+    mTaskThreadPool->ParallelFor(
+        0,
+        mPoints.GetElementCount(),
+        ForceFieldPointGrain,
+        [&](size_t start, size_t end)
+        {
+            for (ElementIndex pointIndex = static_cast<ElementIndex>(start); pointIndex < end; ++pointIndex)
+            {
+                vec2f displacement = (centerPosition - mPoints.GetPosition(pointIndex));
+                float const displacementLength = displacement.length();
+                vec2f normalizedDisplacement = displacement.normalise(displacementLength);
 
-        // Make final acceleration somewhat independent from mass
-        float const massNormalization = mPoints.GetMass(pointIndex) / 50.0f;
+                // Make final acceleration somewhat independent from mass
+                float const massNormalization = mPoints.GetMass(pointIndex) / 50.0f;
 
-        // Angular (constant)
-        mPoints.AddStaticForce(
-            pointIndex,
-            vec2f(-normalizedDisplacement.y, normalizedDisplacement.x)
-                * strength
-                * massNormalization
-                / 10.0f); // Magic number
+                // Angular (constant)
+                mPoints.AddStaticForce(
+                    pointIndex,
+                    vec2f(-normalizedDisplacement.y, normalizedDisplacement.x)
+                        * strength
+                        * massNormalization
+                        / 10.0f); // Magic number
 
-        // Radial (stronger when closer)
-        mPoints.AddStaticForce(
-            pointIndex,
-            normalizedDisplacement
-                * strength
-                / (0.2f + sqrt(displacementLength))
-                * massNormalization
-                * 10.0f); // Magic number
-    }
+                // Radial (stronger when closer)
+                mPoints.AddStaticForce(
+                    pointIndex,
+                    normalizedDisplacement
+                        * strength
+                        / (0.2f + sqrt(displacementLength))
+                        * massNormalization
+                        * 10.0f); // Magic number
+            }
+        });
 }
 
 void Ship::ApplyRadialExplosionForceField(
@@ -75,15 +87,22 @@ void Ship::ApplyRadialExplosionForceField(
     // F = ForceStrength/sqrt(distance), along radius
     //
 
-    for (auto pointIndex : mPoints)
-    {
-        vec2f displacement = (mPoints.GetPosition(pointIndex) - centerPosition);
-        float forceMagnitude = strength / sqrtf(0.1f + displacement.length());
+    mTaskThreadPool->ParallelFor(
+        0,
+        mPoints.GetElementCount(),
+        ForceFieldPointGrain,
+        [&](size_t start, size_t end)
+        {
+            for (ElementIndex pointIndex = static_cast<ElementIndex>(start); pointIndex < end; ++pointIndex)
+            {
+                vec2f displacement = (mPoints.GetPosition(pointIndex) - centerPosition);
+                float forceMagnitude = strength / sqrtf(0.1f + displacement.length());
 
-        mPoints.AddStaticForce(
-            pointIndex,
-            displacement.normalise() * forceMagnitude);
-    }
+                mPoints.AddStaticForce(
+                    pointIndex,
+                    displacement.normalise() * forceMagnitude);
+            }
+        });
 }
 
 }
\ No newline at end of file
@@ -47,7 +47,7 @@ std::optional<ElementIndex> Ship::PickPointToMove(
     float bestOrphanedSquareDistance = std::numeric_limits<float>::max();
     ElementIndex bestOrphanedPoint = NoneElementIndex;
 
-    for (auto p : mPoints.RawShipPoints())
+    for (auto p : mPoints.QueryPointsInRadius(pickPosition, gameParameters.ToolSearchRadius, false))
     {
         float const squareDistance = (mPoints.GetPosition(p) - pickPosition).squareLength();
         if (squareDistance < squareSearchRadius)
@@ -239,7 +239,7 @@ std::optional<ElementIndex> Ship::PickObjectForPickAndPull(
     float bestSquareDistance = std::numeric_limits<float>::max();
     ElementIndex bestPoint = NoneElementIndex;
 
-    for (auto p : mPoints)
+    for (auto p : mPoints.QueryPointsInRadius(pickPosition, SearchRadius, true))
     {
         float const squareDistance = (mPoints.GetPosition(p) - pickPosition).squareLength();
         if (squareDistance < SquareSearchRadius
@@ -400,8 +400,10 @@ bool Ship::DestroyAt(
 
     float const largerSearchSquareRadius = std::max(squareRadius, FallbackSquareRadius);
 
+    BeginBulkDetach();
+
     // Detach/destroy all active, attached points within the radius
-    for (auto const pointIndex : mPoints)
+    for (auto const pointIndex : mPoints.QueryPointsInRadius(targetPos, std::sqrt(largerSearchSquareRadius), true))
     {
         float const pointSquareDistance = (mPoints.GetPosition(pointIndex) - targetPos).squareLength();
 
@@ -461,6 +463,8 @@ bool Ship::DestroyAt(
         hasDestroyed = true;
     }
 
+    EndBulkDetach(currentSimulationTime, gameParameters);
+
     return hasDestroyed;
 }
 
@@ -482,7 +486,7 @@ bool Ship::SawThrough(
     unsigned int metalsSawed = 0;
     unsigned int nonMetalsSawed = 0;
 
-    for (auto springIndex : mSprings)
+    for (auto const springIndex : mSprings.QuerySpringsAlongSegment(adjustedStartPos, endPos, mPoints))
     {
         if (!mSprings.IsDeleted(springIndex))
         {
@@ -549,7 +553,7 @@ bool Ship::ApplyHeatBlasterAt(
     //
     // We also do ephemeral points in order to change buoyancy of air bubbles
     bool atLeastOnePointFound = false;
-    for (auto const pointIndex : mPoints)
+    for (auto const pointIndex : mPoints.QueryPointsInRadius(targetPos, radius, true))
     {
         float const pointSquareDistance = (mPoints.GetPosition(pointIndex) - targetPos).squareLength();
         if (pointSquareDistance < squareRadius
@@ -600,7 +604,7 @@ bool Ship::ExtinguishFireAt(
     // No real reason to ignore ephemeral points, other than they're currently
     // not expected to burn
     bool atLeastOnePointFound = false;
-    for (auto const pointIndex : mPoints.RawShipPoints())
+    for (auto const pointIndex : mPoints.QueryPointsInRadius(targetPos, radius, false))
     {
         float const pointSquareDistance = (mPoints.GetPosition(pointIndex) - targetPos).squareLength();
         if (pointSquareDistance < squareRadius)
@@ -662,8 +666,8 @@ void Ship::ApplyBlastAt(Interaction::ArgumentsUnion::BlastArguments const & args
 {
     float const squareRadius = args.Radius * args.Radius;
 
-    // Visit all points
-    for (auto pointIndex : mPoints)
+    // Visit all points in the radius
+    for (auto pointIndex : mPoints.QueryPointsInRadius(args.CenterPos, args.Radius, true))
     {
         vec2f const pointRadius = mPoints.GetPosition(pointIndex) - args.CenterPos;
         float const squarePointDistance = pointRadius.squareLength();
@@ -747,17 +751,17 @@ bool Ship::ApplyLaserCannonThrough(
     //
 
     int cutCount = 0;
-    
-    for (auto springIndex : mSprings)
+
+    for (auto const springIndex : mSprings.QuerySpringsAlongSegment(startPos, endPos, mPoints))
     {
         if (!mSprings.IsDeleted(springIndex)
-            && GameRandomEngine::GetInstance().GenerateUniformBoolean(10.0f * strength / mSprings.GetBaseStructuralMaterial(springIndex).GetMass()))
-        {
-            if (Segment::ProperIntersectionTest(
+            && Segment::ProperIntersectionTest(
                 startPos,
                 endPos,
                 mSprings.GetEndpointAPosition(springIndex, mPoints),
                 mSprings.GetEndpointBPosition(springIndex, mPoints)))
+        {
+            if (GameRandomEngine::GetInstance().GenerateUniformBoolean(10.0f * strength / mSprings.GetBaseStructuralMaterial(springIndex).GetMass()))
             {
                 //
                 // Destroy spring
@@ -788,7 +792,13 @@ bool Ship::ApplyLaserCannonThrough(
 
     float constexpr SearchRadius = 0.75f; // Magic number
 
-    for (auto p : mPoints)
+    Geometry::AABB const searchBox(
+        std::min(startPos.x, endPos.x) - SearchRadius,   // Left
+        std::max(startPos.x, endPos.x) + SearchRadius,   // Right
+        std::max(startPos.y, endPos.y) + SearchRadius,   // Top
+        std::min(startPos.y, endPos.y) - SearchRadius);  // Bottom
+
+    for (auto p : mPoints.QueryPointsInBox(searchBox, true))
     {
         float const distance = Segment::DistanceToPoint(startPos, endPos, mPoints.GetPosition(p));
         if (distance < SearchRadius)
@@ -815,44 +825,6 @@ bool Ship::ApplyLaserCannonThrough(
     return cutCount > 0;
 }
 
-void Ship::ApplyRadialWindFrom(Interaction::ArgumentsUnion::RadialWindArguments const & args)
-{
-    // Visit all points, including ephemerals
-    for (auto const pointIndex : mPoints)
-    {
-        vec2f const pointPosition = mPoints.GetPosition(pointIndex);
-        if (!mParentWorld.GetOceanSurface().IsUnderwater(pointPosition))
-        {
-            vec2f const displacement = pointPosition - args.SourcePos;
-            float const radius = displacement.length();
-            if (radius < args.PreFrontRadius) // Within sphere
-            {
-                // Calculate force magnitude
-                float windForceMagnitude;
-                if (radius < args.MainFrontRadius)
-                {
-                    windForceMagnitude = args.MainFrontWindForceMagnitude;
-                }
-                else
-                {
-                    windForceMagnitude = args.PreFrontWindForceMagnitude;
-                }
-
-                // Apply force
-                mPoints.AddStaticForce(
-                    pointIndex,
-                    displacement.normalise(radius) * windForceMagnitude * mPoints.GetMaterialWindReceptivity(pointIndex));
-            }
-        }
-    }
-
-    // Remember wind field
-    mWindField.emplace(
-        args.SourcePos,
-        args.PreFrontRadius,
-        args.PreFrontWindForceMagnitude);
-}
-
 void Ship::DrawTo(
     vec2f const & targetPos,
     float strengthFraction,
@@ -871,23 +843,6 @@ void Ship::DrawTo(
             strength));
 }
 
-void Ship::DrawTo(Interaction::ArgumentsUnion::DrawArguments const & args)
-{
-    //
-    // F = ForceStrength/sqrt(distance), along radius
-    //
-
-    for (auto pointIndex : mPoints)
-    {
-        vec2f displacement = (args.CenterPos - mPoints.GetPosition(pointIndex));
-        float forceMagnitude = args.Strength / sqrtf(0.1f + displacement.length());
-
-        mPoints.AddStaticForce(
-            pointIndex,
-            displacement.normalise() * forceMagnitude);
-    }
-}
-
 void Ship::SwirlAt(
     vec2f const & targetPos,
     float strengthFraction,
@@ -906,22 +861,71 @@ void Ship::SwirlAt(
             strength));
 }
 
-void Ship::SwirlAt(Interaction::ArgumentsUnion::SwirlArguments const & args)
+void Ship::ApplyCoalescedInteractions()
 {
     //
-    // F = ForceStrength*radius/sqrt(distance), perpendicular to radius
+    // Draw: F = ForceStrength/sqrt(distance), along radius
+    // Swirl: F = ForceStrength*radius/sqrt(distance), perpendicular to radius
+    // Radial wind: F = WindForce*receptivity, along radius, within the fronts and above water only
+    //
+    // Each point only depends on itself, hence we may split points among threads
     //
 
-    for (auto pointIndex : mPoints)
-    {
-        vec2f displacement = (args.CenterPos - mPoints.GetPosition(pointIndex));
-        float const displacementLength = displacement.length();
-        float forceMagnitude = args.Strength / sqrtf(0.1f + displacementLength);
+    size_t constexpr PointGrain = 2048;
 
-        mPoints.AddStaticForce(
-            pointIndex,
-            vec2f(-displacement.y, displacement.x) * forceMagnitude);
-    }
+    OceanSurface const & oceanSurface = mParentWorld.GetOceanSurface();
+    vec2f const * const restrict positionBuffer = mPoints.GetPositionBufferAsVec2();
+    vec2f * const restrict staticForceBuffer = mPoints.GetStaticForceBufferAsVec2();
+
+    // Visit all points, including ephemerals
+    mTaskThreadPool->ParallelFor(
+        0,
+        mPoints.GetElementCount(),
+        PointGrain,
+        [&](size_t start, size_t end)
+        {
+            for (ElementIndex pointIndex = static_cast<ElementIndex>(start); pointIndex < end; ++pointIndex)
+            {
+                vec2f const pointPosition = positionBuffer[pointIndex];
+                vec2f staticForce = vec2f::zero();
+
+                for (auto const & args : mCoalescedDrawInteractions)
+                {
+                    vec2f const displacement = (args.CenterPos - pointPosition);
+                    float const forceMagnitude = args.Strength / sqrtf(0.1f + displacement.length());
+
+                    staticForce += displacement.normalise() * forceMagnitude;
+                }
+
+                for (auto const & args : mCoalescedSwirlInteractions)
+                {
+                    vec2f const displacement = (args.CenterPos - pointPosition);
+                    float const forceMagnitude = args.Strength / sqrtf(0.1f + displacement.length());
+
+                    staticForce += vec2f(-displacement.y, displacement.x) * forceMagnitude;
+                }
+
+                if (!mCoalescedRadialWindInteractions.empty()
+                    && !oceanSurface.IsUnderwater(pointPosition))
+                {
+                    for (auto const & args : mCoalescedRadialWindInteractions)
+                    {
+                        vec2f const displacement = pointPosition - args.SourcePos;
+                        float const radius = displacement.length();
+                        if (radius < args.PreFrontRadius) // Within sphere
+                        {
+                            float const windForceMagnitude = (radius < args.MainFrontRadius)
+                                ? args.MainFrontWindForceMagnitude
+                                : args.PreFrontWindForceMagnitude;
+
+                            staticForce += displacement.normalise(radius) * windForceMagnitude * mPoints.GetMaterialWindReceptivity(pointIndex);
+                        }
+                    }
+                }
+
+                staticForceBuffer[pointIndex] += staticForce;
+            }
+        });
 }
 
 bool Ship::TogglePinAt(
@@ -938,6 +942,27 @@ void Ship::RemoveAllPins()
     mPinnedPoints.RemoveAll();
 }
 
+bool Ship::SpawnNPCAt(vec2f const & targetPos)
+{
+    auto const triangleIndex = NPCs::FindTriangleAt(
+        targetPos,
+        mPoints.GetPositionBufferAsVec2(),
+        mTriangles);
+
+    if (!triangleIndex.has_value())
+    {
+        return false;
+    }
+
+    mNPCs.Add(
+        targetPos,
+        *triangleIndex,
+        mPoints.GetPositionBufferAsVec2(),
+        mTriangles);
+
+    return true;
+}
+
 std::optional<ToolApplicationLocus> Ship::InjectBubblesAt(
     vec2f const & targetPos,
     float currentSimulationTime,
@@ -986,7 +1011,7 @@ std::optional<ToolApplicationLocus> Ship::InjectPressureAt(
     float bestSquareDistance = 1.2F;
     ElementIndex bestPointIndex = NoneElementIndex;
 
-    for (auto const pointIndex : mPoints.RawShipPoints())
+    for (auto const pointIndex : mPoints.QueryPointsInRadius(targetPos, std::sqrt(bestSquareDistance), false))
     {
         float const squareDistance = (mPoints.GetPosition(pointIndex) - targetPos).squareLength();
         if (squareDistance < bestSquareDistance
@@ -1098,7 +1123,7 @@ bool Ship::FloodAt(
     float const searchSquareRadius = searchRadius * searchRadius;
 
     bool anyWasApplied = false;
-    for (auto const pointIndex : mPoints.RawShipPoints())
+    for (auto const pointIndex : mPoints.QueryPointsInRadius(targetPos, searchRadius, false))
     {
         if (!mPoints.GetIsHull(pointIndex))
         {
@@ -1219,7 +1244,7 @@ bool Ship::ScrubThrough(
     // Visit all points (excluding ephemerals, they don't rot and
     // thus we don't need to scrub them!)
     bool hasScrubbed = false;
-    for (auto const pointIndex : mPoints.RawShipPoints())
+    for (auto const pointIndex : mPoints.QueryPointsInBox(boundingBox, false))
     {
         auto const & pointPosition = mPoints.GetPosition(pointIndex);
 
@@ -1248,12 +1273,6 @@ bool Ship::ScrubThrough(
         }
     }
 
-    if (hasScrubbed)
-    {
-        // Make sure the decay buffer gets uploaded again
-        mPoints.MarkDecayBufferAsDirty();
-    }
-
     return hasScrubbed;
 }
 
@@ -1286,7 +1305,7 @@ bool Ship::RotThrough(
     // Visit all points (excluding ephemerals, they don't rot and
     // thus we don't need to rot them!)
     bool hasRotted = false;
-    for (auto const pointIndex : mPoints.RawShipPoints())
+    for (auto const pointIndex : mPoints.QueryPointsInBox(boundingBox, false))
     {
         auto const & pointPosition = mPoints.GetPosition(pointIndex);
 
@@ -1320,12 +1339,6 @@ bool Ship::RotThrough(
         }
     }
 
-    if (hasRotted)
-    {
-        // Make sure the decay buffer gets uploaded again
-        mPoints.MarkDecayBufferAsDirty();
-    }
-
     return hasRotted;
 }
 
@@ -1359,8 +1372,9 @@ void Ship::ApplyThanosSnap(
         direction = 1.0f;
     }
 
+    BeginBulkDetach();
+
     // Visit all points (excluding ephemerals, there's nothing to detach there)
-    bool atLeastOneDetached = false;
     for (auto const pointIndex : mPoints.RawShipPoints())
     {
         auto const x = mPoints.GetPosition(pointIndex).x;
@@ -1387,41 +1401,17 @@ void Ship::ApplyThanosSnap(
 
             // Set decay to min, so that debris gets darkened
             mPoints.SetDecay(pointIndex, 0.0f);
-
-            atLeastOneDetached = true;
         }
     }
 
-    if (atLeastOneDetached)
-    {
-        // We've changed the decay buffer, need to upload it next then!
-        mPoints.MarkDecayBufferAsDirty();
-    }
+    EndBulkDetach(currentSimulationTime, gameParameters);
 }
 
 ElementIndex Ship::GetNearestPointAt(
     vec2f const & targetPos,
     float radius) const
 {
-    float const squareRadius = radius * radius;
-
-    ElementIndex bestPointIndex = NoneElementIndex;
-    float bestSquareDistance = std::numeric_limits<float>::max();
-
-    for (auto const pointIndex : mPoints)
-    {
-        if (mPoints.IsActive(pointIndex))
-        {
-            float squareDistance = (mPoints.GetPosition(pointIndex) - targetPos).squareLength();
-            if (squareDistance < squareRadius && squareDistance < bestSquareDistance)
-            {
-                bestPointIndex = pointIndex;
-                bestSquareDistance = squareDistance;
-            }
-        }
-    }
-
-    return bestPointIndex;
+    return mPoints.FindNearestActivePointInRadius(targetPos, radius);
 }
 
 bool Ship::QueryNearestPointAt(
@@ -1434,23 +1424,7 @@ bool Ship::QueryNearestPointAt(
 
     bool pointWasFound = false;
 
-    float const squareRadius = radius * radius;
-
-    ElementIndex bestPointIndex = NoneElementIndex;
-    float bestSquareDistance = std::numeric_limits<float>::max();
-
-    for (auto const pointIndex : mPoints)
-    {
-        if (mPoints.IsActive(pointIndex))
-        {
-            float squareDistance = (mPoints.GetPosition(pointIndex) - targetPos).squareLength();
-            if (squareDistance < squareRadius && squareDistance < bestSquareDistance)
-            {
-                bestPointIndex = pointIndex;
-                bestSquareDistance = squareDistance;
-            }
-        }
-    }
+    ElementIndex const bestPointIndex = mPoints.FindNearestActivePointInRadius(targetPos, radius);
 
     if (NoneElementIndex != bestPointIndex)
     {
@@ -1580,7 +1554,9 @@ void Ship::ApplyLightning(
     float const searchSquareRadiusBlast = searchSquareRadius / 2.0f;
     float const searchSquareRadiusHeat = searchSquareRadius;
 
-    for (auto const pointIndex : mPoints.RawShipPoints())
+    BeginBulkDetach();
+
+    for (auto const pointIndex : mPoints.QueryPointsInRadius(targetPos, searchRadius, false))
     {
         float squareDistance = (mPoints.GetPosition(pointIndex) - targetPos).squareLength();
 
@@ -1655,6 +1631,8 @@ void Ship::ApplyLightning(
                 std::max(mPoints.GetTemperature(pointIndex) + deltaT, 0.1f)); // 3rd principle of thermodynamics
         }
     }
+
+    EndBulkDetach(currentSimulationTime, gameParameters);
 }
 
 void Ship::HighlightElectricalElement(ElectricalElementId electricalElementId)
@@ -13,6 +13,11 @@
 
 namespace Physics {
 
+// The max number of points that may act as attractors in a single repair step;
+// the attractors beyond this budget are deferred to the next step, so that a big
+// repair converges over several frames rather than stalling one
+static size_t constexpr MaxRepairAttractorsPerStep = 256;
+
 void Ship::RepairAt(
     vec2f const & targetPos,
     float radiusMultiplier,
@@ -26,14 +31,18 @@ void Ship::RepairAt(
 
     float const squareSearchRadius = searchRadius * searchRadius;
 
+    // Batch the restores of this step
+    BeginBulkRestore();
+
     //
     // Pass 1: straighten one-spring and two-spring naked springs
     //
 
     // We store points in radius here in order to speedup subsequent passes
-    std::vector<ElementIndex> pointsInRadius;
+    std::vector<ElementIndex> & pointsInRadius = mRepairPointsInRadius;
+    pointsInRadius.clear();
 
-    for (auto const pointIndex : mPoints.RawShipPoints())
+    for (auto const pointIndex : mPoints.QueryPointsInRadius(targetPos, searchRadius, false))
     {
         if (float const squareRadius = (mPoints.GetPosition(pointIndex) - targetPos).squareLength();
             squareRadius <= squareSearchRadius)
@@ -53,6 +62,12 @@ void Ship::RepairAt(
     // an attractor will continue to be an attractor until it needs reparation
     //
 
+    size_t attractorBudget = MaxRepairAttractorsPerStep;
+
+    // The attractors deferred at this step go to the back of the queue
+    mRepairDeferredAttractors.swap(mRepairCurrentDeferredAttractors);
+    mRepairDeferredAttractors.clear();
+
     auto const previousStep = repairStepId.Previous();
     auto const previousPreviousStep = previousStep.Previous();
     for (auto const pointIndex : pointsInRadius)
@@ -65,12 +80,36 @@ void Ship::RepairAt(
                 targetPos,
                 squareSearchRadius,
                 repairStepId,
+                attractorBudget,
                 gameParameters);
         }
     }
 
     //
-    // Pass 3: visit all other points now, to give a chance to everyone else to be
+    // Pass 3: visit the (in-radius) points that would have been attractors at the
+    // previous step, had that step not run out of budget
+    //
+
+    if (mRepairDeferredAttractorsStepId == previousStep)
+    {
+        for (auto const pointIndex : mRepairCurrentDeferredAttractors)
+        {
+            if (float const squareRadius = (mPoints.GetPosition(pointIndex) - targetPos).squareLength();
+                squareRadius <= squareSearchRadius)
+            {
+                TryRepairAndPropagateFromPoint(
+                    pointIndex,
+                    targetPos,
+                    squareSearchRadius,
+                    repairStepId,
+                    attractorBudget,
+                    gameParameters);
+            }
+        }
+    }
+
+    //
+    // Pass 4: visit all other points now, to give a chance to everyone else to be
     // an attractor
     //
 
@@ -82,11 +121,14 @@ void Ship::RepairAt(
             targetPos,
             squareSearchRadius,
             repairStepId,
+            attractorBudget,
             gameParameters);
     }
 
+    mRepairDeferredAttractorsStepId = repairStepId;
+
     //
-    // Pass 4:
+    // Pass 5:
     //
     // a) Restore deleted _eligible_ triangles that were connected to each (in-radius) point
     //     at factory time
@@ -167,7 +209,7 @@ void Ship::RepairAt(
     }
 
     //
-    // Pass 5: make sure we don't destroy what we've repaired right away
+    // Pass 6: make sure we don't destroy what we've repaired right away
     //
 
     // Reset dynamic forces
@@ -175,6 +217,8 @@ void Ship::RepairAt(
 
     // Reset grace period
     mRepairGracePeriodMultiplier = 0.0f;
+
+    EndBulkRestore();
 }
 
 void Ship::StraightenOneSpringChains(ElementIndex pointIndex)
@@ -353,6 +397,7 @@ bool Ship::TryRepairAndPropagateFromPoint(
     vec2f const & targetPos,
     float squareSearchRadius,
     SequenceNumber repairStepId,
+    size_t & attractorBudget,
     GameParameters const & gameParameters)
 {
     bool hasRepairedAnything = false;
@@ -365,6 +410,9 @@ bool Ship::TryRepairAndPropagateFromPoint(
     //  - and needs reparation
     //  - and is not orphaned (we rely on existing springs in order to repair)
     //
+    // A point that meets the conditions once the step's attractor budget is
+    // exhausted is deferred to the next step.
+    //
     // After being an attractor, do a breadth-first visit from the point propagating
     // repair from directly-connected in-radius particles
 
@@ -386,24 +434,33 @@ bool Ship::TryRepairAndPropagateFromPoint(
                 && mPoints.GetFactoryConnectedSprings(pointIndex).ConnectedSprings.size() > mPoints.GetConnectedSprings(pointIndex).ConnectedSprings.size() // Needs reparation
                 && mPoints.GetConnectedSprings(pointIndex).ConnectedSprings.size() > 0) // Not orphaned
             {
-                //
-                // This point has now taken the role of an attractor
-                //
+                if (attractorBudget == 0)
+                {
+                    mRepairDeferredAttractors.push_back(pointIndex);
+                }
+                else
+                {
+                    --attractorBudget;
 
-                // Calculate repair strength (1.0 at center and zero at border, fourth power)
-                float const squareRadius = (mPoints.GetPosition(pointIndex) - targetPos).squareLength();
-                float const repairStrength =
-                    (1.0f - (squareRadius / squareSearchRadius) * (squareRadius / squareSearchRadius))
-                    * (gameParameters.IsUltraViolentMode ? 10.0f : 1.0f);
+                    //
+                    // This point has now taken the role of an attractor
+                    //
 
-                // Repair from this point
-                bool const hasRepaired = RepairFromAttractor(
-                    pointIndex,
-                    repairStrength,
-                    repairStepId,
-                    gameParameters);
+                    // Calculate repair strength (1.0 at center and zero at border, fourth power)
+                    float const squareRadius = (mPoints.GetPosition(pointIndex) - targetPos).squareLength();
+                    float const repairStrength =
+                        (1.0f - (squareRadius / squareSearchRadius) * (squareRadius / squareSearchRadius))
+                        * (gameParameters.IsUltraViolentMode ? 10.0f : 1.0f);
 
-                hasRepairedAnything |= hasRepaired;
+                    // Repair from this point
+                    bool const hasRepaired = RepairFromAttractor(
+                        pointIndex,
+                        repairStrength,
+                        repairStepId,
+                        gameParameters);
+
+                    hasRepairedAnything |= hasRepaired;
+                }
             }
 
             //
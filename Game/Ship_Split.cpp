@@ -0,0 +1,276 @@
+/***************************************************************************************
+* Original Author:      Gabriele Giuseppini
+* Created:              2026-10-14
+* Copyright:            Gabriele Giuseppini  (https://github.com/GabrieleGiuseppini)
+***************************************************************************************/
+#include "Physics.h"
+
+#include <GameCore/Log.h>
+
+#include <algorithm>
+#include <cassert>
+
+namespace Physics {
+
+std::vector<std::unique_ptr<Ship>> Ship::SplitDetachedFragments(
+    ShipId firstNewShipId,
+    ElementCount minFragmentPointCount,
+    GameParameters const & gameParameters)
+{
+    std::vector<std::unique_ptr<Ship>> fragmentShips;
+
+    if (!HasDetachedFragments(minFragmentPointCount))
+    {
+        return fragmentShips;
+    }
+
+    //
+    // Assign connected components to fragments: the largest component goes
+    // to the main fragment - together with all of the components that are too
+    // small to be worth a ship of their own - and each of the other large
+    // components makes a fragment of its own
+    //
+
+    ConnectedComponentId const largestConnectedComponentId = FindLargestConnectedComponent();
+
+    std::vector<size_t> connectedComponentFragments(mConnectedComponentSizes.size(), 0);
+    size_t fragmentCount = 1;
+    for (ConnectedComponentId c = 0; c < mConnectedComponentSizes.size(); ++c)
+    {
+        if (c != largestConnectedComponentId
+            && mConnectedComponentSizes[c] >= static_cast<size_t>(minFragmentPointCount))
+        {
+            connectedComponentFragments[c] = fragmentCount++;
+        }
+    }
+
+    assert(fragmentCount >= 2);
+
+    LogMessage("Ship::SplitDetachedFragments(): splitting ship ", mId, " into ", fragmentCount, " ships");
+
+    //
+    // Map the elements to their fragments: an element belongs to a fragment if
+    // all of its points do, and is dropped otherwise - springs and triangles
+    // across fragments are broken already
+    //
+
+    std::vector<ShipFragmentMap> fragmentMaps;
+    fragmentMaps.reserve(fragmentCount);
+    for (size_t f = 0; f < fragmentCount; ++f)
+    {
+        fragmentMaps.emplace_back(
+            mPoints.GetRawShipPointCount(),
+            mSprings.GetElementCount(),
+            mTriangles.GetElementCount(),
+            mElectricalElements.GetElementCount());
+    }
+
+    auto const getPointFragment = [&](ElementIndex pointIndex)
+    {
+        assert(mPoints.GetConnectedComponentId(pointIndex) < connectedComponentFragments.size());
+        return connectedComponentFragments[mPoints.GetConnectedComponentId(pointIndex)];
+    };
+
+    for (auto const pointIndex : mPoints.RawShipPoints())
+    {
+        fragmentMaps[getPointFragment(pointIndex)].PointIndices.Add(pointIndex);
+    }
+
+    for (auto const springIndex : mSprings)
+    {
+        size_t const fragment = getPointFragment(mSprings.GetEndpointAIndex(springIndex));
+        if (fragment == getPointFragment(mSprings.GetEndpointBIndex(springIndex)))
+        {
+            fragmentMaps[fragment].SpringIndices.Add(springIndex);
+        }
+    }
+
+    for (auto const triangleIndex : mTriangles)
+    {
+        size_t const fragment = getPointFragment(mTriangles.GetPointAIndex(triangleIndex));
+        if (fragment == getPointFragment(mTriangles.GetPointBIndex(triangleIndex))
+            && fragment == getPointFragment(mTriangles.GetPointCIndex(triangleIndex)))
+        {
+            fragmentMaps[fragment].TriangleIndices.Add(triangleIndex);
+        }
+    }
+
+    for (auto const electricalElementIndex : mElectricalElements)
+    {
+        fragmentMaps[getPointFragment(mElectricalElements.GetPointIndex(electricalElementIndex))]
+            .ElectricalElementIndices.Add(electricalElementIndex);
+    }
+
+    //
+    // Make the fragments
+    //
+
+    // The elements that make noise or move things are about to be re-announced
+    // as parts of their new ships
+    mElectricalElements.PublishFragmentationSilencing();
+
+    for (size_t f = 0; f < fragmentCount; ++f)
+    {
+        fragmentShips.emplace_back(
+            MakeFragment(
+                f == 0 ? mId : static_cast<ShipId>(firstNewShipId + f - 1),
+                fragmentMaps[f],
+                f == 0,
+                gameParameters));
+    }
+
+    return fragmentShips;
+}
+
+bool Ship::HasDetachedFragments(ElementCount minFragmentPointCount) const
+{
+    // Connected components are only reliable right after a connectivity visit
+    if (mIsStructureDirty || mConnectedComponentSizes.size() < 2)
+    {
+        return false;
+    }
+
+    ConnectedComponentId const largestConnectedComponentId = FindLargestConnectedComponent();
+
+    for (ConnectedComponentId c = 0; c < mConnectedComponentSizes.size(); ++c)
+    {
+        if (c != largestConnectedComponentId
+            && mConnectedComponentSizes[c] >= static_cast<size_t>(minFragmentPointCount))
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+ConnectedComponentId Ship::FindLargestConnectedComponent() const
+{
+    assert(!mConnectedComponentSizes.empty());
+
+    ConnectedComponentId largestConnectedComponentId = 0;
+    for (ConnectedComponentId c = 1; c < mConnectedComponentSizes.size(); ++c)
+    {
+        if (mConnectedComponentSizes[c] > mConnectedComponentSizes[largestConnectedComponentId])
+        {
+            largestConnectedComponentId = c;
+        }
+    }
+
+    return largestConnectedComponentId;
+}
+
+std::unique_ptr<Ship> Ship::MakeFragment(
+    ShipId shipId,
+    ShipFragmentMap const & fragmentMap,
+    bool isMainFragment,
+    GameParameters const & gameParameters)
+{
+    //
+    // Make the elements
+    //
+
+    Points points(
+        fragmentMap.PointIndices.GetNewElementCount(),
+        mParentWorld,
+        mMaterialDatabase,
+        mGameEventHandler,
+        gameParameters);
+
+    points.AddFragment(mPoints, fragmentMap);
+
+    Springs springs(
+        fragmentMap.SpringIndices.GetNewElementCount(),
+        mParentWorld,
+        mGameEventHandler,
+        gameParameters);
+
+    springs.AddFragment(mSprings, mTriangles, fragmentMap);
+
+    Triangles triangles(fragmentMap.TriangleIndices.GetNewElementCount());
+
+    triangles.AddFragment(mTriangles, fragmentMap);
+
+    ElementCount const lampCount = static_cast<ElementCount>(std::count_if(
+        fragmentMap.ElectricalElementIndices.NewToOld.cbegin(),
+        fragmentMap.ElectricalElementIndices.NewToOld.cend(),
+        [this](ElementIndex electricalElementIndex)
+        {
+            return mElectricalElements.GetMaterialType(electricalElementIndex) == ElectricalMaterial::ElectricalElementType::Lamp;
+        }));
+
+    ElectricalElements electricalElements(
+        fragmentMap.ElectricalElementIndices.GetNewElementCount(),
+        lampCount,
+        shipId,
+        mParentWorld,
+        mGameEventHandler,
+        gameParameters);
+
+    electricalElements.AddFragment(mElectricalElements, fragmentMap, points);
+
+    Frontiers frontiers(
+        fragmentMap.PointIndices.GetNewElementCount(),
+        fragmentMap.SpringIndices.GetNewElementCount());
+
+    frontiers.AddFragment(mFrontiers, fragmentMap, springs);
+
+    //
+    // Make the ship
+    //
+
+    auto ship = std::make_unique<Ship>(
+        shipId,
+        mParentWorld,
+        mMaterialDatabase,
+        mGameEventHandler,
+        mTaskThreadPool,
+        std::move(points),
+        std::move(springs),
+        std::move(triangles),
+        std::move(electricalElements),
+        std::move(frontiers));
+
+    ship->mPinnedPoints.AddFragment(mPinnedPoints, fragmentMap);
+    ship->mGadgets.AddFragment(mGadgets, fragmentMap);
+    ship->mNPCs.AddFragment(mNPCs, fragmentMap, isMainFragment);
+
+    ship->mEventRecorder = mEventRecorder;
+    ship->mCurrentSimulationSequenceNumber = mCurrentSimulationSequenceNumber;
+    ship->mRepairGracePeriodMultiplier = mRepairGracePeriodMultiplier;
+
+    if (isMainFragment)
+    {
+        // Explosions are not tied to any element, hence we leave them
+        // with the ship that keeps our identity
+        ship->mStateMachines = std::move(mStateMachines);
+        ship->mIsSinking = mIsSinking;
+        ship->mWaterSplashedRunningAverage.Fill(mWaterSplashedRunningAverage.GetCurrentAverage());
+    }
+
+    //
+    // Re-count damage, as broken elements across fragments are gone
+    //
+
+    for (auto const pointIndex : ship->mPoints.RawShipPoints())
+    {
+        if (ship->mPoints.IsDamaged(pointIndex))
+            ++ship->mDamagedPointsCount;
+    }
+
+    for (auto const springIndex : ship->mSprings)
+    {
+        if (ship->mSprings.IsDeleted(springIndex))
+            ++ship->mBrokenSpringsCount;
+    }
+
+    for (auto const triangleIndex : ship->mTriangles)
+    {
+        if (ship->mTriangles.IsDeleted(triangleIndex))
+            ++ship->mBrokenTrianglesCount;
+    }
+
+    return ship;
+}
+
+}
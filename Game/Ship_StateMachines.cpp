@@ -8,6 +8,7 @@
 #include "Ship_StateMachines.h"
 
 #include <GameCore/GameRandomEngine.h>
+#include <GameCore/Profiler.h>
 
 #include <cassert>
 
@@ -55,7 +56,7 @@ bool Ship::UpdateExplosionStateMachine(
         //
         // Blast force and heat
         //
-        // Go through all points and, for each point in radius:
+        // Go through all points in radius and, for each of them:
         //  - Apply blast force
         //  - Apply blast heat
         // - Keep non-ephemeral point that is closest to blast position; we'll Detach() it later
@@ -72,8 +73,8 @@ bool Ship::UpdateExplosionStateMachine(
         float closestPointSquareDistance = std::numeric_limits<float>::max();
         ElementIndex closestPointIndex = NoneElementIndex;
 
-        // Visit all points
-        for (auto const pointIndex : mPoints)
+        // Visit all points that might be in radius - in the same order as we would visit all points
+        for (auto const pointIndex : mPoints.QueryPointsInRadius(centerPosition, blastRadius, true))
         {
             vec2f const pointRadius = mPoints.GetPosition(pointIndex) - centerPosition;
             float const squarePointDistance = pointRadius.squareLength();
@@ -236,6 +237,8 @@ void Ship::UpdateStateMachines(
     float currentSimulationTime,
     GameParameters const & gameParameters)
 {
+    FS_PROFILE_SCOPE("Ship::UpdateStateMachines");
+
     for (auto smIt = mStateMachines.begin(); smIt != mStateMachines.end(); /* incremented in loop */)
     {
         bool isExpired = false;
@@ -0,0 +1,86 @@
+/***************************************************************************************
+ * Original Author:		Gabriele Giuseppini
+ * Created:				2026-10-14
+ * Copyright:			Gabriele Giuseppini  (https://github.com/GabrieleGiuseppini)
+ ***************************************************************************************/
+#include "SimulationGovernor.h"
+
+#include "GameParameters.h"
+
+#include <GameCore/Log.h>
+
+#include <chrono>
+
+SimulationGovernor::SimulationGovernor()
+    : mDegradationLevel(0)
+    , mWindowIterationCount(0)
+    , mWindowStartPerfStats()
+{
+}
+
+bool SimulationGovernor::Update(PerfStats const & totalPerfStats)
+{
+    if (mWindowIterationCount == 0)
+    {
+        // Start first window
+        mWindowStartPerfStats = totalPerfStats;
+        mWindowIterationCount = 1;
+        return false;
+    }
+
+    ++mWindowIterationCount;
+    if (mWindowIterationCount <= WindowIterations)
+    {
+        return false;
+    }
+
+    //
+    // Window is complete, measure the average cost of a simulation step in it
+    //
+
+    PerfStats const windowPerfStats = totalPerfStats - mWindowStartPerfStats;
+
+    // Start next window
+    mWindowStartPerfStats = totalPerfStats;
+    mWindowIterationCount = 1;
+
+    float const updateDuration = windowPerfStats.TotalNetUpdateDuration.ToRatio<std::chrono::seconds>();
+    if (updateDuration == 0.0f)
+    {
+        // No updates in this window (e.g. paused), nothing to judge
+        return false;
+    }
+
+    float const stepCost = updateDuration + windowPerfStats.TotalNetRenderUploadDuration.ToRatio<std::chrono::seconds>();
+
+    float constexpr StepBudget = GameParameters::SimulationStepTimeDuration<float>;
+
+    unsigned int newDegradationLevel = mDegradationLevel;
+    if (stepCost > StepBudget * OverrunBudgetFraction)
+    {
+        if (mDegradationLevel < MaxDegradationLevel)
+            ++newDegradationLevel;
+    }
+    else if (stepCost < StepBudget * HeadroomBudgetFraction)
+    {
+        if (mDegradationLevel > 0)
+            --newDegradationLevel;
+    }
+
+    if (newDegradationLevel == mDegradationLevel)
+    {
+        return false;
+    }
+
+    LogMessage("SimulationGovernor: step cost=", stepCost * 1000.0f, "ms; degradation level: ", mDegradationLevel, " -> ", newDegradationLevel);
+
+    mDegradationLevel = newDegradationLevel;
+
+    return true;
+}
+
+void SimulationGovernor::Reset()
+{
+    mDegradationLevel = 0;
+    mWindowIterationCount = 0;
+}
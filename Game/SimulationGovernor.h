@@ -0,0 +1,58 @@
+/***************************************************************************************
+ * Original Author:		Gabriele Giuseppini
+ * Created:				2026-10-14
+ * Copyright:			Gabriele Giuseppini  (https://github.com/GabrieleGiuseppini)
+ ***************************************************************************************/
+#pragma once
+
+#include "PerfStats.h"
+
+#include <cstdint>
+
+/*
+ * Watches the cost of the simulation over windows of game iterations, and degrades
+ * the simulation - by scaling back optional work - when the cost exceeds the
+ * time budget of a simulation step, restoring it as soon as there is headroom again.
+ *
+ * Degradation levels are cumulative:
+ *  1: Fishes and clouds are only updated at every other simulation step
+ *  2: Ephemeral particles are capped at a fraction of their maximum
+ *  3: Mechanical dynamics iterations stop as soon as ships have converged
+ */
+class SimulationGovernor
+{
+public:
+
+    static unsigned int constexpr MaxDegradationLevel = 3;
+
+public:
+
+    SimulationGovernor();
+
+    unsigned int GetDegradationLevel() const
+    {
+        return mDegradationLevel;
+    }
+
+    /*
+     * Invoked at each game iteration with the perf stats accumulated so far;
+     * returns true when the degradation level has changed.
+     */
+    bool Update(PerfStats const & totalPerfStats);
+
+    void Reset();
+
+private:
+
+    // The number of game iterations over which we measure costs
+    static std::uint32_t constexpr WindowIterations = 32;
+
+    // Fractions of a simulation step's duration
+    static float constexpr OverrunBudgetFraction = 0.8f;
+    static float constexpr HeadroomBudgetFraction = 0.4f;
+
+    unsigned int mDegradationLevel;
+
+    std::uint32_t mWindowIterationCount;
+    PerfStats mWindowStartPerfStats;
+};
@@ -5,7 +5,24 @@
  ***************************************************************************************/
 #include "Physics.h"
 
+#include <GameCore/BatchMath.h>
+#include <GameCore/GameException.h>
+#include <GameCore/Profiler.h>
+
+#include <algorithm>
 #include <cmath>
+#include <unordered_map>
+
+// The minimum number of springs that make it worth to calculate the strains of
+// a partition of springs on a separate thread
+static size_t constexpr MinSpringsPerStrainUpdatePartition = 8192;
+
+// The minimum number of springs that make it worth to re-calculate the coefficients of
+// a partition of springs on a separate thread
+static size_t constexpr MinSpringsPerCoefficientsUpdatePartition = 4096;
+
+// The number of springs whose lengths are calculated together, with the batched math
+static ElementCount constexpr SpringLengthBatchSize = 64;
 
 namespace Physics {
 
@@ -21,8 +38,11 @@ void Springs::Add(
     ElementIndex const springIndex = static_cast<ElementIndex>(mIsDeletedBuffer.GetCurrentPopulatedSize());
 
     mIsDeletedBuffer.emplace_back(false);
+    mLiveSprings.Set(springIndex);
 
     mEndpointsBuffer.emplace_back(pointAIndex, pointBIndex);
+    mEndpointAIndexBuffer.emplace_back(pointAIndex);
+    mEndpointBIndexBuffer.emplace_back(pointBIndex);
 
     mFactoryEndpointOctantsBuffer.emplace_back(factoryPointAOctant, factoryPointBOctant);
 
@@ -43,11 +63,15 @@ void Springs::Add(
         strainThreshold,
         false);
 
+    mStressBuffer.emplace_back(0.0f);
+
     mFactoryRestLengthBuffer.emplace_back((points.GetPosition(pointAIndex) - points.GetPosition(pointBIndex)).length());
     mRestLengthBuffer.emplace_back((points.GetPosition(pointAIndex) - points.GetPosition(pointBIndex)).length());
 
     // Dynamics coefficients recalculated later, but stiffness grows slowly and shrinks fast, hence we want to start high
     mDynamicsCoefficientsBuffer.emplace_back(std::numeric_limits<float>::max(), 0.0f);
+    mStiffnessCoefficientBuffer.emplace_back(std::numeric_limits<float>::max());
+    mDampingCoefficientBuffer.emplace_back(0.0f);
 
     // Stiffness is average
     float const averageStiffness =
@@ -81,6 +105,8 @@ void Springs::Add(
     // (non-rope <-> rope springs are "connections" and not to be treated as ropes)
     mIsRopeBuffer.emplace_back(points.IsRope(pointAIndex) && points.IsRope(pointBIndex));
 
+    mRopeConstraintCorrectionBuffer.emplace_back(0.0f);
+
     // Spring is permeable by default - will be changed later
     mWaterPermeabilityBuffer.emplace_back(1.0f);
 
@@ -129,11 +155,14 @@ void Springs::Destroy(
     // Zero out our dynamics coefficients, so that we can still calculate Hooke's
     // and damping forces for this spring without running the risk of
     // affecting non-deleted points
-    mDynamicsCoefficientsBuffer[springElementIndex].StiffnessCoefficient = 0.0f;
-    mDynamicsCoefficientsBuffer[springElementIndex].DampingCoefficient = 0.0f;
+    SetDynamicsCoefficients(springElementIndex, 0.0f, 0.0f);
+
+    // Forget the rope constraint history, which would be stale at restore
+    mRopeConstraintCorrectionBuffer[springElementIndex] = 0.0f;
 
     // Flag ourselves as deleted
     mIsDeletedBuffer[springElementIndex] = true;
+    mLiveSprings.Clear(springElementIndex);
 }
 
 void Springs::Restore(
@@ -145,17 +174,28 @@ void Springs::Restore(
 
     // Clear the deleted flag
     mIsDeletedBuffer[springElementIndex] = false;
+    mLiveSprings.Set(springElementIndex);
 
-    // Recalculate coefficients for this spring
-    UpdateCoefficients(
-        springElementIndex,
-        mCurrentNumMechanicalDynamicsIterations,
-        mCurrentSpringStiffnessAdjustment,
-        mCurrentSpringDampingAdjustment,
-        mCurrentSpringStrengthAdjustment,
-        CalculateSpringStrengthIterationsAdjustment(mCurrentNumMechanicalDynamicsIterationsAdjustment),
-        mCurrentMeltingTemperatureAdjustment,
-        points);
+    // Make sure we're simulated again
+    mSimulatedElementCount = std::max(mSimulatedElementCount, springElementIndex + 1);
+
+    // Recalculate coefficients for this spring - now or at the end of the batch
+    if (mIsBatchingCoefficientsUpdates)
+    {
+        mBatchedCoefficientsUpdateSprings.push_back(springElementIndex);
+    }
+    else
+    {
+        UpdateCoefficients(
+            springElementIndex,
+            mCurrentNumMechanicalDynamicsIterations,
+            mCurrentSpringStiffnessAdjustment,
+            mCurrentSpringDampingAdjustment,
+            mCurrentSpringStrengthAdjustment,
+            CalculateSpringStrengthIterationsAdjustment(mCurrentNumMechanicalDynamicsIterationsAdjustment),
+            mCurrentMeltingTemperatureAdjustment,
+            points);
+    }
 
     // Invoke restore handler
     assert(nullptr != mShipPhysicsHandler);
@@ -164,38 +204,258 @@ void Springs::Restore(
         gameParameters);
 }
 
+void Springs::EndCoefficientsUpdateBatch(Points const & points)
+{
+    assert(mIsBatchingCoefficientsUpdates);
+
+    mIsBatchingCoefficientsUpdates = false;
+
+    // Visit each spring once, in spring order
+    std::sort(mBatchedCoefficientsUpdateSprings.begin(), mBatchedCoefficientsUpdateSprings.end());
+    auto const batchEnd = std::unique(mBatchedCoefficientsUpdateSprings.begin(), mBatchedCoefficientsUpdateSprings.end());
+
+    float const strengthIterationsAdjustment = CalculateSpringStrengthIterationsAdjustment(mCurrentNumMechanicalDynamicsIterationsAdjustment);
+
+    for (auto it = mBatchedCoefficientsUpdateSprings.begin(); it != batchEnd; ++it)
+    {
+        // Springs destroyed after joining the batch keep their zero coefficients
+        if (!mIsDeletedBuffer[*it])
+        {
+            inline_UpdateCoefficients(
+                *it,
+                mCurrentNumMechanicalDynamicsIterations,
+                mCurrentSpringStiffnessAdjustment,
+                mCurrentSpringDampingAdjustment,
+                mCurrentSpringStrengthAdjustment,
+                strengthIterationsAdjustment,
+                mCurrentMeltingTemperatureAdjustment,
+                points);
+        }
+    }
+
+    mBatchedCoefficientsUpdateSprings.clear();
+}
+
 void Springs::UpdateForGameParameters(
     GameParameters const & gameParameters,
-    Points const & points)
+    Points const & points,
+    TaskThreadPool & taskThreadPool)
 {
-    if (gameParameters.NumMechanicalDynamicsIterations<float>() != mCurrentNumMechanicalDynamicsIterations
-        || gameParameters.NumMechanicalDynamicsIterationsAdjustment != mCurrentNumMechanicalDynamicsIterationsAdjustment
-        || gameParameters.SpringStiffnessAdjustment != mCurrentSpringStiffnessAdjustment
-        || gameParameters.SpringDampingAdjustment != mCurrentSpringDampingAdjustment
-        || gameParameters.SpringStrengthAdjustment != mCurrentSpringStrengthAdjustment
-        || gameParameters.MeltingTemperatureAdjustment != mCurrentMeltingTemperatureAdjustment)
+    FS_PROFILE_SCOPE("Springs::UpdateForGameParameters");
+
+    if (gameParameters.Generation != mCurrentGameParametersGeneration)
     {
-        // Update our version of the parameters
-        mCurrentNumMechanicalDynamicsIterations = gameParameters.NumMechanicalDynamicsIterations<float>();
-        mCurrentNumMechanicalDynamicsIterationsAdjustment = gameParameters.NumMechanicalDynamicsIterationsAdjustment;
-        mCurrentSpringStiffnessAdjustment = gameParameters.SpringStiffnessAdjustment;
-        mCurrentSpringDampingAdjustment = gameParameters.SpringDampingAdjustment;
-        mCurrentSpringStrengthAdjustment = gameParameters.SpringStrengthAdjustment;
-        mCurrentMeltingTemperatureAdjustment = gameParameters.MeltingTemperatureAdjustment;
-
-        // Recalc whole
-        UpdateCoefficientsForPartition(
-            0, 1,
-            mCurrentNumMechanicalDynamicsIterations,
-            mCurrentSpringStiffnessAdjustment,
-            mCurrentSpringDampingAdjustment,
-            mCurrentSpringStrengthAdjustment,
-            CalculateSpringStrengthIterationsAdjustment(mCurrentNumMechanicalDynamicsIterationsAdjustment),
-            mCurrentMeltingTemperatureAdjustment,
-            points);
+        mCurrentGameParametersGeneration = gameParameters.Generation;
+
+        if (gameParameters.NumMechanicalDynamicsIterations<float>() != mCurrentNumMechanicalDynamicsIterations
+            || gameParameters.NumMechanicalDynamicsIterationsAdjustment != mCurrentNumMechanicalDynamicsIterationsAdjustment
+            || gameParameters.SpringStiffnessAdjustment != mCurrentSpringStiffnessAdjustment
+            || gameParameters.SpringDampingAdjustment != mCurrentSpringDampingAdjustment
+            || gameParameters.SpringStrengthAdjustment != mCurrentSpringStrengthAdjustment
+            || gameParameters.MeltingTemperatureAdjustment != mCurrentMeltingTemperatureAdjustment)
+        {
+            // The coefficients depend on the dt, and the points' integration factors
+            // are updated right away; hence a change in the number of iterations
+            // has to be applied to all springs right away, too
+            bool const isDtChanged =
+                gameParameters.NumMechanicalDynamicsIterations<float>() != mCurrentNumMechanicalDynamicsIterations;
+
+            // Update our version of the parameters
+            mCurrentNumMechanicalDynamicsIterations = gameParameters.NumMechanicalDynamicsIterations<float>();
+            mCurrentNumMechanicalDynamicsIterationsAdjustment = gameParameters.NumMechanicalDynamicsIterationsAdjustment;
+            mCurrentSpringStiffnessAdjustment = gameParameters.SpringStiffnessAdjustment;
+            mCurrentSpringDampingAdjustment = gameParameters.SpringDampingAdjustment;
+            mCurrentSpringStrengthAdjustment = gameParameters.SpringStrengthAdjustment;
+            mCurrentMeltingTemperatureAdjustment = gameParameters.MeltingTemperatureAdjustment;
+
+            // (Re)start a re-calculation of the whole; frames that were already
+            // done for an earlier change are stale now
+            mPendingCoefficientsUpdateSubPartitionCount = std::max(
+                std::min(
+                    taskThreadPool.GetParallelism(),
+                    static_cast<size_t>(mSimulatedElementCount) / (PendingCoefficientsUpdateFrameCount * MinSpringsPerCoefficientsUpdatePartition)),
+                size_t(1));
+
+            mNextPendingCoefficientsUpdateFrame = 0;
+
+            if (isDtChanged)
+            {
+                UpdateCoefficientsForFrames(0, PendingCoefficientsUpdateFrameCount, points, taskThreadPool);
+                mNextPendingCoefficientsUpdateFrame = PendingCoefficientsUpdateFrameCount;
+            }
+        }
+    }
+
+    if (mNextPendingCoefficientsUpdateFrame < PendingCoefficientsUpdateFrameCount)
+    {
+        // Do one more frame of the pending re-calculation
+        UpdateCoefficientsForFrames(mNextPendingCoefficientsUpdateFrame, mNextPendingCoefficientsUpdateFrame + 1, points, taskThreadPool);
+        ++mNextPendingCoefficientsUpdateFrame;
     }
 }
 
+void Springs::AddFragment(
+    Springs const & other,
+    Triangles const & otherTriangles,
+    ShipFragmentMap const & fragmentMap)
+{
+    assert(mIsDeletedBuffer.GetCurrentPopulatedSize() == 0);
+
+    auto const & pointMap = fragmentMap.PointIndices;
+    auto const & springMap = fragmentMap.SpringIndices;
+    auto const & triangleMap = fragmentMap.TriangleIndices;
+
+    assert(springMap.GetNewElementCount() == GetElementCount());
+
+    auto const & oldIndices = springMap.NewToOld;
+
+    mIsDeletedBuffer.emplace_back_from(other.mIsDeletedBuffer, oldIndices);
+    mFactoryEndpointOctantsBuffer.emplace_back_from(other.mFactoryEndpointOctantsBuffer, oldIndices);
+    mCoveringTrianglesCountBuffer.emplace_back_from(other.mCoveringTrianglesCountBuffer, oldIndices);
+    mStrainStateBuffer.emplace_back_from(other.mStrainStateBuffer, oldIndices);
+    mStressBuffer.emplace_back_from(other.mStressBuffer, oldIndices);
+    mFactoryRestLengthBuffer.emplace_back_from(other.mFactoryRestLengthBuffer, oldIndices);
+    mRestLengthBuffer.emplace_back_from(other.mRestLengthBuffer, oldIndices);
+    mDynamicsCoefficientsBuffer.emplace_back_from(other.mDynamicsCoefficientsBuffer, oldIndices);
+    mStiffnessCoefficientBuffer.emplace_back_from(other.mStiffnessCoefficientBuffer, oldIndices);
+    mDampingCoefficientBuffer.emplace_back_from(other.mDampingCoefficientBuffer, oldIndices);
+    mMaterialPropertiesBuffer.emplace_back_from(other.mMaterialPropertiesBuffer, oldIndices);
+    mBaseStructuralMaterialBuffer.emplace_back_from(other.mBaseStructuralMaterialBuffer, oldIndices);
+    mIsRopeBuffer.emplace_back_from(other.mIsRopeBuffer, oldIndices);
+    mRopeConstraintCorrectionBuffer.emplace_back_from(other.mRopeConstraintCorrectionBuffer, oldIndices);
+    mWaterPermeabilityBuffer.emplace_back_from(other.mWaterPermeabilityBuffer, oldIndices);
+    mMaterialThermalConductivityBuffer.emplace_back_from(other.mMaterialThermalConductivityBuffer, oldIndices);
+
+    auto const remapSuperTriangles = [&triangleMap](SuperTrianglesVector const & otherSuperTriangles)
+    {
+        SuperTrianglesVector superTriangles;
+        for (auto const otherTriangleIndex : otherSuperTriangles)
+        {
+            if (triangleMap.Contains(otherTriangleIndex))
+                superTriangles.push_back(triangleMap.OldToNew[otherTriangleIndex]);
+        }
+
+        return superTriangles;
+    };
+
+    for (ElementIndex springIndex = 0; springIndex < GetElementCount(); ++springIndex)
+    {
+        ElementIndex const otherSpringIndex = oldIndices[springIndex];
+
+        ElementIndex const pointAIndex = pointMap.OldToNew[other.mEndpointsBuffer[otherSpringIndex].PointAIndex];
+        ElementIndex const pointBIndex = pointMap.OldToNew[other.mEndpointsBuffer[otherSpringIndex].PointBIndex];
+        assert(pointAIndex != NoneElementIndex && pointBIndex != NoneElementIndex);
+
+        mEndpointsBuffer.emplace_back(pointAIndex, pointBIndex);
+        mEndpointAIndexBuffer.emplace_back(pointAIndex);
+        mEndpointBIndexBuffer.emplace_back(pointBIndex);
+
+        mSuperTrianglesBuffer.emplace_back(remapSuperTriangles(other.mSuperTrianglesBuffer[otherSpringIndex]));
+        mFactorySuperTrianglesBuffer.emplace_back(remapSuperTriangles(other.mFactorySuperTrianglesBuffer[otherSpringIndex]));
+    }
+
+    // Live triangles left behind no longer cover our springs
+    for (ElementIndex otherTriangleIndex : otherTriangles)
+    {
+        if (!triangleMap.Contains(otherTriangleIndex) && !otherTriangles.IsDeleted(otherTriangleIndex))
+        {
+            for (auto const otherCoveredSpringIndex : otherTriangles.GetCoveredSprings(otherTriangleIndex))
+            {
+                if (springMap.Contains(otherCoveredSpringIndex))
+                    RemoveCoveringTriangle(springMap.OldToNew[otherCoveredSpringIndex]);
+            }
+        }
+    }
+
+    // Rebuild live springs
+    for (ElementIndex s : *this)
+    {
+        if (!mIsDeletedBuffer[s])
+            mLiveSprings.Set(s);
+    }
+
+    // Only simulate up to the last live spring
+    mSimulatedElementCount = GetElementCount();
+    while (mSimulatedElementCount > 0 && mIsDeletedBuffer[mSimulatedElementCount - 1])
+    {
+        --mSimulatedElementCount;
+    }
+}
+
+void Springs::Permute(std::vector<ElementIndex> const & newToOldSpringIndices)
+{
+    assert(newToOldSpringIndices.size() == GetElementCount());
+
+    mIsDeletedBuffer.permute(newToOldSpringIndices);
+    mEndpointsBuffer.permute(newToOldSpringIndices);
+    mEndpointAIndexBuffer.permute(newToOldSpringIndices);
+    mEndpointBIndexBuffer.permute(newToOldSpringIndices);
+    mFactoryEndpointOctantsBuffer.permute(newToOldSpringIndices);
+    mSuperTrianglesBuffer.permute(newToOldSpringIndices);
+    mFactorySuperTrianglesBuffer.permute(newToOldSpringIndices);
+    mCoveringTrianglesCountBuffer.permute(newToOldSpringIndices);
+    mStrainStateBuffer.permute(newToOldSpringIndices);
+    mStressBuffer.permute(newToOldSpringIndices);
+    mFactoryRestLengthBuffer.permute(newToOldSpringIndices);
+    mRestLengthBuffer.permute(newToOldSpringIndices);
+    mDynamicsCoefficientsBuffer.permute(newToOldSpringIndices);
+    mStiffnessCoefficientBuffer.permute(newToOldSpringIndices);
+    mDampingCoefficientBuffer.permute(newToOldSpringIndices);
+    mMaterialPropertiesBuffer.permute(newToOldSpringIndices);
+    mBaseStructuralMaterialBuffer.permute(newToOldSpringIndices);
+    mIsRopeBuffer.permute(newToOldSpringIndices);
+    mRopeConstraintCorrectionBuffer.permute(newToOldSpringIndices);
+    mWaterPermeabilityBuffer.permute(newToOldSpringIndices);
+    mMaterialThermalConductivityBuffer.permute(newToOldSpringIndices);
+
+    // Rebuild live springs
+    mLiveSprings.ClearAll();
+    for (ElementIndex s : *this)
+    {
+        if (!mIsDeletedBuffer[s])
+            mLiveSprings.Set(s);
+    }
+
+    // Only simulate up to the last live spring
+    mSimulatedElementCount = GetElementCount();
+    while (mSimulatedElementCount > 0 && mIsDeletedBuffer[mSimulatedElementCount - 1])
+    {
+        --mSimulatedElementCount;
+    }
+
+    // Springs have been renumbered, hence the spatial index is stale
+    mSpatialIndexPointsVersion.reset();
+
+    // Springs have moved across the frames of a pending coefficients re-calculation,
+    // hence start it over
+    if (mNextPendingCoefficientsUpdateFrame < PendingCoefficientsUpdateFrameCount)
+    {
+        mNextPendingCoefficientsUpdateFrame = 0;
+    }
+}
+
+std::vector<ElementIndex> const & Springs::QuerySpringsAlongSegment(
+    vec2f const & startPos,
+    vec2f const & endPos,
+    Points const & points) const
+{
+    std::uint64_t const pointsVersion = points.GetSpatialIndexVersion();
+    if (mSpatialIndexPointsVersion != pointsVersion)
+    {
+        mSpatialIndex.RebuildForSegments(
+            mEndpointAIndexBuffer.data(),
+            mEndpointBIndexBuffer.data(),
+            points.GetPositionBufferAsVec2(),
+            GetElementCount());
+
+        mSpatialIndexPointsVersion = pointsVersion;
+    }
+
+    mSpatialIndex.QuerySegment(startPos, endPos, mSpatialQueryResult);
+
+    return mSpatialQueryResult;
+}
+
 void Springs::UploadElements(
     ShipId shipId,
     Render::RenderContext & renderContext) const
@@ -211,11 +471,10 @@ void Springs::UploadElements(
 
     auto & shipRenderContext = renderContext.GetShipRenderContext(shipId);
 
-    for (ElementIndex i : *this)
-    {
-        // Only upload non-deleted springs that are not covered by two super-triangles, unless
-        // we are in springs render mode
-        if (!mIsDeletedBuffer[i])
+    // Only upload non-deleted springs that are not covered by two super-triangles, unless
+    // we are in springs render mode
+    mLiveSprings.ForEachSet(
+        [&](ElementIndex i)
         {
             if (IsRope(i) && !doUploadRopesAsSprings)
             {
@@ -232,8 +491,7 @@ void Springs::UploadElements(
                     GetEndpointAIndex(i),
                     GetEndpointBIndex(i));
             }
-        }
-    }
+        });
 }
 
 void Springs::UploadStressedSpringElements(
@@ -242,9 +500,8 @@ void Springs::UploadStressedSpringElements(
 {
     auto & shipRenderContext = renderContext.GetShipRenderContext(shipId);
 
-    for (ElementIndex i : *this)
-    {
-        if (!mIsDeletedBuffer[i])
+    mLiveSprings.ForEachSet(
+        [&](ElementIndex i)
         {
             if (mStrainStateBuffer[i].IsStressed)
             {
@@ -252,61 +509,221 @@ void Springs::UploadStressedSpringElements(
                     GetEndpointAIndex(i),
                     GetEndpointBIndex(i));
             }
-        }
-    }
+        });
 }
 
 void Springs::UpdateForStrains(
     GameParameters const & gameParameters,
     Points & points,
-    StressRenderModeType stressRenderMode)
+    StressRenderModeType stressRenderMode,
+    TaskThreadPool & taskThreadPool)
 {
+    FS_PROFILE_SCOPE("Springs::UpdateForStrains");
+
     if (stressRenderMode == StressRenderModeType::None)
     {
-        InternalUpdateForStrains<false>(gameParameters, points);
+        InternalUpdateForStrains<false>(gameParameters, points, taskThreadPool);
     }
     else
     {
-        InternalUpdateForStrains<true>(gameParameters, points);
+        InternalUpdateForStrains<true>(gameParameters, points, taskThreadPool);
     }
 }
 
 ////////////////////////////////////////////////////////////////////
 
+template<typename TFunc>
+inline void Springs::ForEachLiveSpringLength(
+    ElementIndex startSpringIndex,
+    ElementIndex endSpringIndex,
+    Points const & points,
+    TFunc && func) const
+{
+    mLiveSprings.ForEachSetRun(
+        startSpringIndex,
+        endSpringIndex,
+        [&](ElementIndex runStart, ElementIndex runEnd)
+        {
+            vec2f springVectors[SpringLengthBatchSize];
+            float springLengths[SpringLengthBatchSize];
+
+            for (ElementIndex batchStart = runStart; batchStart < runEnd; batchStart += SpringLengthBatchSize)
+            {
+                ElementIndex const batchEnd = std::min(batchStart + SpringLengthBatchSize, runEnd);
+
+                for (ElementIndex s = batchStart; s < batchEnd; ++s)
+                {
+                    springVectors[s - batchStart] = points.GetPosition(GetEndpointAIndex(s)) - points.GetPosition(GetEndpointBIndex(s));
+                }
+
+                BatchMath::Length(springVectors, springLengths, batchEnd - batchStart);
+
+                for (ElementIndex s = batchStart; s < batchEnd; ++s)
+                {
+                    func(s, springLengths[s - batchStart]);
+                }
+            }
+        });
+}
+
 template<bool DoUpdateStress>
 void Springs::InternalUpdateForStrains(
     GameParameters const & gameParameters,
-    Points & points)
+    Points & points,
+    TaskThreadPool & taskThreadPool)
 {
-    float constexpr StrainLowWatermark = 0.08f; // Less than this multiplier to become non-stressed
-
     OceanSurface const & oceanSurface = mParentWorld.GetOceanSurface();
 
-    // Visit all springs
-    for (ElementIndex s : *this)
+    //
+    // 1) Calculate strains concurrently, collecting - in spring order - the
+    //    springs that break and those that become stressed
+    //
+
+    // Springs past the simulated ones are all deleted
+    ElementCount const springCount = mSimulatedElementCount;
+
+    size_t const partitionCount = std::max(
+        std::min(
+            taskThreadPool.GetParallelism(),
+            static_cast<size_t>(springCount) / MinSpringsPerStrainUpdatePartition),
+        size_t(1));
+
+    if (mStrainEventsByPartition.size() < partitionCount)
     {
-        // Avoid breaking deleted springs
-        if (!mIsDeletedBuffer[s])
+        mStrainEventsByPartition.resize(partitionCount);
+    }
+
+    ElementCount const partitionSize = static_cast<ElementCount>((springCount + partitionCount - 1) / partitionCount);
+
+    taskThreadPool.ParallelFor(
+        0,
+        partitionCount,
+        1,
+        [&](size_t start, size_t end)
+        {
+            for (size_t p = start; p < end; ++p)
+            {
+                ElementIndex const startSpringIndex = static_cast<ElementIndex>(p) * partitionSize;
+
+                CalculateStrainsForPartition<DoUpdateStress>(
+                    startSpringIndex,
+                    std::min(startSpringIndex + partitionSize, springCount),
+                    points,
+                    mStrainEventsByPartition[p]);
+            }
+        });
+
+    //
+    // 2) Act on the events serially, in the same order as if they had been
+    //    produced by a serial visit of all springs
+    //
+
+    for (size_t p = 0; p < partitionCount; ++p)
+    {
+        for (auto const & strainEvent : mStrainEventsByPartition[p])
+        {
+            ElementIndex const s = strainEvent.SpringIndex;
+
+            if (strainEvent.Type == StrainEvent::EventType::Break)
+            {
+                // Avoid breaking deleted springs
+                if (!mIsDeletedBuffer[s])
+                {
+                    // Destroy this spring
+                    this->Destroy(
+                        s,
+                        DestroyOptions::FireBreakEvent // Notify Break
+                        | DestroyOptions::DestroyAllTriangles,
+                        gameParameters,
+                        points);
+                }
+            }
+            else
+            {
+                assert(strainEvent.Type == StrainEvent::EventType::Stress);
+
+                // Notify stress
+                mGameEventHandler->OnStress(
+                    GetBaseStructuralMaterial(s),
+                    oceanSurface.IsUnderwater(GetEndpointAPosition(s, points)), // Arbitrary
+                    1);
+            }
+        }
+    }
+
+    // Note: the stress of the points is only pooled from the springs' stress
+    // at render time (see CalculatePointStress())
+}
+
+void Springs::CalculatePointStress(Points & points) const
+{
+    //
+    // The stress of a point is the stress with the greatest magnitude among its springs
+    //
+
+    points.ResetStress();
+
+    mLiveSprings.ForEachSet(
+        [&](ElementIndex s)
+        {
+            float const stress = mStressBuffer[s];
+
+            if (std::abs(stress) > std::abs(points.GetStress(GetEndpointAIndex(s))))
+            {
+                points.SetStress(
+                    GetEndpointAIndex(s),
+                    stress);
+            }
+
+            if (std::abs(stress) > std::abs(points.GetStress(GetEndpointBIndex(s))))
+            {
+                points.SetStress(
+                    GetEndpointBIndex(s),
+                    stress);
+            }
+        });
+}
+
+template<bool DoUpdateStress>
+inline void Springs::CalculateStrainsForPartition(
+    ElementIndex startSpringIndex,
+    ElementIndex endSpringIndex,
+    Points const & points,
+    std::vector<StrainEvent> & strainEvents)
+{
+    //
+    // Only touches the strain state of the springs in the partition
+    //
+
+    float constexpr StrainLowWatermark = 0.08f; // Less than this multiplier to become non-stressed
+
+    strainEvents.clear();
+
+    // Avoid breaking deleted springs
+    ForEachLiveSpringLength(
+        startSpringIndex,
+        endSpringIndex,
+        points,
+        [&](ElementIndex s, float springLength)
         {
             auto & strainState = mStrainStateBuffer[s];
 
             // Calculate strain
-            float const strain = GetLength(s, points) - mRestLengthBuffer[s];
+            float const strain = springLength - mRestLengthBuffer[s];
             float const absStrain = std::abs(strain);
 
             // Check against breaking elongation
             float const breakingElongation = strainState.BreakingElongation;
+
+            if constexpr (DoUpdateStress)
+            {
+                // Piggyback on the length we've got here, for rendering stress
+                mStressBuffer[s] = strain / breakingElongation; // Between -1.0 and +1.0 for non-broken springs
+            }
             if (absStrain > breakingElongation)
             {
                 // It's broken!
-
-                // Destroy this spring
-                this->Destroy(
-                    s,
-                    DestroyOptions::FireBreakEvent // Notify Break
-                    | DestroyOptions::DestroyAllTriangles,
-                    gameParameters,
-                    points);
+                strainEvents.emplace_back(s, StrainEvent::EventType::Break);
             }
             else
             {
@@ -331,36 +748,45 @@ void Springs::InternalUpdateForStrains(
                         // It's stressed!
                         strainState.IsStressed = true;
 
-                        // Notify stress
-                        mGameEventHandler->OnStress(
-                            GetBaseStructuralMaterial(s),
-                            oceanSurface.IsUnderwater(GetEndpointAPosition(s, points)), // Arbitrary
-                            1);
+                        strainEvents.emplace_back(s, StrainEvent::EventType::Stress);
                     }
                 }
+            }
+        });
+}
 
-                // Update stress
-                if constexpr (DoUpdateStress)
-                {
-                    float const stress = strain / breakingElongation; // Between -1.0 and +1.0
-                    
-                    if (std::abs(stress) > std::abs(points.GetStress(GetEndpointAIndex(s))))
-                    {
-                        points.SetStress(
-                            GetEndpointAIndex(s),
-                            stress);
-                    }
-
-                    if (std::abs(stress) > std::abs(points.GetStress(GetEndpointBIndex(s))))
-                    {
-                        points.SetStress(
-                            GetEndpointBIndex(s),
-                            stress);
-                    }
-                }
+void Springs::UpdateCoefficientsForFrames(
+    size_t startFrame,
+    size_t endFrame,
+    Points const & points,
+    TaskThreadPool & taskThreadPool)
+{
+    // Each frame consists of mPendingCoefficientsUpdateSubPartitionCount consecutive partitions,
+    // which are independent of each other
+    size_t const subPartitionCount = mPendingCoefficientsUpdateSubPartitionCount;
+    size_t const partitionCount = PendingCoefficientsUpdateFrameCount * subPartitionCount;
+    float const strengthIterationsAdjustment = CalculateSpringStrengthIterationsAdjustment(mCurrentNumMechanicalDynamicsIterationsAdjustment);
+
+    taskThreadPool.ParallelFor(
+        startFrame * subPartitionCount,
+        endFrame * subPartitionCount,
+        1,
+        [&](size_t start, size_t end)
+        {
+            for (size_t p = start; p < end; ++p)
+            {
+                UpdateCoefficientsForPartition(
+                    static_cast<ElementIndex>(p),
+                    static_cast<ElementIndex>(partitionCount),
+                    mCurrentNumMechanicalDynamicsIterations,
+                    mCurrentSpringStiffnessAdjustment,
+                    mCurrentSpringDampingAdjustment,
+                    mCurrentSpringStrengthAdjustment,
+                    strengthIterationsAdjustment,
+                    mCurrentMeltingTemperatureAdjustment,
+                    points);
             }
-        }
-    }
+        });
 }
 
 void Springs::UpdateCoefficientsForPartition(
@@ -374,13 +800,15 @@ void Springs::UpdateCoefficientsForPartition(
     float meltingTemperatureAdjustment,
     Points const & points)
 {
-    // Recalc all parameters
-    ElementCount const partitionSize = (GetElementCount() / partitionCount) + ((GetElementCount() % partitionCount) ? 1 : 0);
+    // Recalc all parameters; springs past the simulated ones are all deleted
+    ElementCount const springCount = mSimulatedElementCount;
+    ElementCount const partitionSize = (springCount / partitionCount) + ((springCount % partitionCount) ? 1 : 0);
     ElementCount const startSpringIndex = partition * partitionSize;
-    ElementCount const endSpringIndex = std::min(startSpringIndex + partitionSize, GetElementCount());
-    for (ElementIndex s = startSpringIndex; s < endSpringIndex; ++s)
-    {
-        if (!IsDeleted(s))
+    ElementCount const endSpringIndex = std::min(startSpringIndex + partitionSize, springCount);
+    mLiveSprings.ForEachSet(
+        startSpringIndex,
+        endSpringIndex,
+        [&](ElementIndex s)
         {
             inline_UpdateCoefficients(
                 s,
@@ -391,8 +819,7 @@ void Springs::UpdateCoefficientsForPartition(
                 strengthIterationsAdjustment,
                 meltingTemperatureAdjustment,
                 points);
-        }
-    }
+        });
 }
 
 void Springs::UpdateCoefficients(
@@ -496,16 +923,17 @@ void Springs::inline_UpdateCoefficients(
     // If the coefficient is growing (spring is becoming more stiff), then
     // approach the desired stiffness coefficient slowly,
     // or else we have too much discontinuity and might explode
-    if (desiredStiffnessCoefficient > mDynamicsCoefficientsBuffer[springIndex].StiffnessCoefficient)
+    float stiffnessCoefficient = mDynamicsCoefficientsBuffer[springIndex].StiffnessCoefficient;
+    if (desiredStiffnessCoefficient > stiffnessCoefficient)
     {
-        mDynamicsCoefficientsBuffer[springIndex].StiffnessCoefficient +=
+        stiffnessCoefficient +=
             0.03f // 0.03: ~76 steps to 1/10th off target
-            * (desiredStiffnessCoefficient - mDynamicsCoefficientsBuffer[springIndex].StiffnessCoefficient);
+            * (desiredStiffnessCoefficient - stiffnessCoefficient);
     }
     else
     {
         // Sudden decrease
-        mDynamicsCoefficientsBuffer[springIndex].StiffnessCoefficient = desiredStiffnessCoefficient;
+        stiffnessCoefficient = desiredStiffnessCoefficient;
     }
 
     //
@@ -514,12 +942,17 @@ void Springs::inline_UpdateCoefficients(
     // Magnitude of the drag force on the relative velocity component along the spring.
     //
 
-    mDynamicsCoefficientsBuffer[springIndex].DampingCoefficient =
+    float const dampingCoefficient =
         GameParameters::SpringDampingCoefficient
         * dampingAdjustment
         * massFactor
         / dt;
 
+    SetDynamicsCoefficients(
+        springIndex,
+        stiffnessCoefficient,
+        dampingCoefficient);
+
     //
     // Breaking elongation
     //
@@ -563,4 +996,113 @@ void Springs::inline_UpdateCoefficients(
         * (1.0f + GetExtraMeltingInducedTolerance(springIndex) * meltDepthFraction); // When melting, springs are more tolerant to elongation
 }
 
+size_t Springs::GetByteSize() const
+{
+    return
+        mIsDeletedBuffer.GetByteSize()
+        + mLiveSprings.GetByteSize()
+        + mEndpointsBuffer.GetByteSize()
+        + mEndpointAIndexBuffer.GetByteSize()
+        + mEndpointBIndexBuffer.GetByteSize()
+        + mFactoryEndpointOctantsBuffer.GetByteSize()
+        + mSuperTrianglesBuffer.GetByteSize()
+        + mFactorySuperTrianglesBuffer.GetByteSize()
+        + mCoveringTrianglesCountBuffer.GetByteSize()
+        + mStrainStateBuffer.GetByteSize()
+        + mStressBuffer.GetByteSize()
+        + mFactoryRestLengthBuffer.GetByteSize()
+        + mRestLengthBuffer.GetByteSize()
+        + mDynamicsCoefficientsBuffer.GetByteSize()
+        + mStiffnessCoefficientBuffer.GetByteSize()
+        + mDampingCoefficientBuffer.GetByteSize()
+        + mMaterialPropertiesBuffer.GetByteSize()
+        + mBaseStructuralMaterialBuffer.GetByteSize()
+        + mIsRopeBuffer.GetByteSize()
+        + mRopeConstraintCorrectionBuffer.GetByteSize()
+        + mWaterPermeabilityBuffer.GetByteSize()
+        + mMaterialThermalConductivityBuffer.GetByteSize();
+}
+
+static std::uint32_t constexpr StateSectionTag = 0x53475053; // SPGS
+
+void Springs::SaveState(StateSnapshotWriter & writer) const
+{
+    writer.BeginSection(StateSectionTag);
+
+    ArchiveState(*this, writer);
+}
+
+void Springs::LoadState(StateSnapshotReader & reader)
+{
+    reader.BeginSection(StateSectionTag);
+
+    //
+    // Materials are not archived, as they are pointers into the material database;
+    // since springs may have been renumbered since the snapshot was taken, we
+    // re-associate them to the springs via their endpoints
+    //
+
+    auto const makeKey = [](Endpoints const & endpoints)
+    {
+        return (static_cast<std::uint64_t>(endpoints.PointAIndex) << 32) | static_cast<std::uint64_t>(endpoints.PointBIndex);
+    };
+
+    std::unordered_map<std::uint64_t, StructuralMaterial const *> materialsByEndpoints;
+    materialsByEndpoints.reserve(GetElementCount());
+    for (ElementIndex s : *this)
+    {
+        materialsByEndpoints.emplace(makeKey(mEndpointsBuffer[s]), mBaseStructuralMaterialBuffer[s]);
+    }
+
+    ArchiveState(*this, reader);
+
+    for (ElementIndex s : *this)
+    {
+        auto const it = materialsByEndpoints.find(makeKey(mEndpointsBuffer[s]));
+        if (it == materialsByEndpoints.end())
+        {
+            throw GameException("The snapshot does not match the world being restored");
+        }
+
+        mBaseStructuralMaterialBuffer[s] = it->second;
+    }
+
+    // The spatial index is stale
+    mSpatialIndexPointsVersion.reset();
+
+    // Start over any pending coefficients re-calculation
+    if (mNextPendingCoefficientsUpdateFrame < PendingCoefficientsUpdateFrameCount)
+    {
+        mNextPendingCoefficientsUpdateFrame = 0;
+    }
+}
+
+template<typename TSelf, typename TArchive>
+void Springs::ArchiveState(
+    TSelf & self,
+    TArchive & archive)
+{
+    archive.Archive(self.mIsDeletedBuffer);
+    archive.Archive(self.mLiveSprings);
+    archive.Archive(self.mEndpointsBuffer);
+    archive.Archive(self.mEndpointAIndexBuffer);
+    archive.Archive(self.mEndpointBIndexBuffer);
+    archive.Archive(self.mFactoryEndpointOctantsBuffer);
+    archive.Archive(self.mSuperTrianglesBuffer);
+    archive.Archive(self.mFactorySuperTrianglesBuffer);
+    archive.Archive(self.mCoveringTrianglesCountBuffer);
+    archive.Archive(self.mStrainStateBuffer);
+    archive.Archive(self.mFactoryRestLengthBuffer);
+    archive.Archive(self.mRestLengthBuffer);
+    archive.Archive(self.mDynamicsCoefficientsBuffer);
+    archive.Archive(self.mStiffnessCoefficientBuffer);
+    archive.Archive(self.mDampingCoefficientBuffer);
+    archive.Archive(self.mMaterialPropertiesBuffer);
+    archive.Archive(self.mIsRopeBuffer);
+    archive.Archive(self.mRopeConstraintCorrectionBuffer);
+    archive.Archive(self.mWaterPermeabilityBuffer);
+    archive.Archive(self.mMaterialThermalConductivityBuffer);
+    archive.Archive(self.mSimulatedElementCount);
+}
+
 }
\ No newline at end of file
@@ -12,13 +12,20 @@
 
 #include <GameCore/Buffer.h>
 #include <GameCore/BufferAllocator.h>
+#include <GameCore/ElementBitmap.h>
 #include <GameCore/ElementContainer.h>
 #include <GameCore/EnumFlags.h>
 #include <GameCore/FixedSizeVector.h>
+#include <GameCore/SpatialHashGrid.h>
+#include <GameCore/StateSnapshot.h>
+#include <GameCore/TaskThreadPool.h>
 
 #include <cassert>
+#include <cstdint>
 #include <functional>
 #include <limits>
+#include <optional>
+#include <vector>
 
 namespace Physics
 {
@@ -144,8 +151,11 @@ public:
         // Buffers
         //////////////////////////////////
         , mIsDeletedBuffer(mBufferElementCount, mElementCount, true)
+        , mLiveSprings(mElementCount)
         // Endpoints
         , mEndpointsBuffer(mBufferElementCount, mElementCount, Endpoints(NoneElementIndex, NoneElementIndex))
+        , mEndpointAIndexBuffer(mBufferElementCount, mElementCount, NoneElementIndex)
+        , mEndpointBIndexBuffer(mBufferElementCount, mElementCount, NoneElementIndex)
         // Factory endpoint octants
         , mFactoryEndpointOctantsBuffer(mBufferElementCount, mElementCount, EndpointOctants(0, 4))
         // Super triangles
@@ -155,12 +165,16 @@ public:
         , mCoveringTrianglesCountBuffer(mBufferElementCount, mElementCount, 0)
         // Physical
         , mStrainStateBuffer(mBufferElementCount, mElementCount, StrainState(0.0f, 0.0f, false))
+        , mStressBuffer(mBufferElementCount, mElementCount, 0.0f)
         , mFactoryRestLengthBuffer(mBufferElementCount, mElementCount, 1.0f)
         , mRestLengthBuffer(mBufferElementCount, mElementCount, 1.0f)
         , mDynamicsCoefficientsBuffer(mBufferElementCount, mElementCount, DynamicsCoefficients(0.0f, 0.0f))
+        , mStiffnessCoefficientBuffer(mBufferElementCount, mElementCount, 0.0f)
+        , mDampingCoefficientBuffer(mBufferElementCount, mElementCount, 0.0f)
         , mMaterialPropertiesBuffer(mBufferElementCount, mElementCount, MaterialProperties(0.0f, 0.0f, 0.0f, 0.0f))
         , mBaseStructuralMaterialBuffer(mBufferElementCount, mElementCount, nullptr)
         , mIsRopeBuffer(mBufferElementCount, mElementCount, false)
+        , mRopeConstraintCorrectionBuffer(mBufferElementCount, mElementCount, 0.0f)
         // Water
         , mWaterPermeabilityBuffer(mBufferElementCount, mElementCount, 0.0f)
         // Heat
@@ -171,6 +185,8 @@ public:
         , mParentWorld(parentWorld)
         , mGameEventHandler(std::move(gameEventDispatcher))
         , mShipPhysicsHandler(nullptr)
+        , mSimulatedElementCount(mElementCount)
+        , mCurrentGameParametersGeneration(gameParameters.Generation)
         , mCurrentNumMechanicalDynamicsIterations(gameParameters.NumMechanicalDynamicsIterations<float>())
         , mCurrentNumMechanicalDynamicsIterationsAdjustment(gameParameters.NumMechanicalDynamicsIterationsAdjustment)
         , mCurrentSpringStiffnessAdjustment(gameParameters.SpringStiffnessAdjustment)
@@ -179,6 +195,14 @@ public:
         , mCurrentMeltingTemperatureAdjustment(gameParameters.MeltingTemperatureAdjustment)
         , mFloatBufferAllocator(mBufferElementCount)
         , mVec2fBufferAllocator(mBufferElementCount)
+        , mStrainEventsByPartition()
+        , mPendingCoefficientsUpdateSubPartitionCount(1)
+        , mNextPendingCoefficientsUpdateFrame(PendingCoefficientsUpdateFrameCount)
+        , mSpatialIndex(SpatialIndexCellSize)
+        , mSpatialIndexPointsVersion()
+        , mSpatialQueryResult()
+        , mIsBatchingCoefficientsUpdates(false)
+        , mBatchedCoefficientsUpdateSprings()
     {
     }
 
@@ -198,6 +222,16 @@ public:
         ElementCount coveringTrianglesCount,
         Points const & points);
 
+    /*
+     * Populates this container - which must be empty - with the springs of a fragment
+     * of another ship, in their current state; point and triangle indices are remapped
+     * to the fragment's.
+     */
+    void AddFragment(
+        Springs const & other,
+        Triangles const & otherTriangles,
+        ShipFragmentMap const & fragmentMap);
+
     void Destroy(
         ElementIndex springElementIndex,
         DestroyOptions destroyOptions,
@@ -209,9 +243,41 @@ public:
         GameParameters const & gameParameters,
         Points const & points);
 
+    /*
+     * Starts a batch of coefficient updates: until the matching EndCoefficientsUpdateBatch(),
+     * the springs whose coefficients would be recalculated because of a restore or of a change
+     * in rest length are only recorded; at the end, their coefficients are recalculated once,
+     * in spring order.
+     */
+    void BeginCoefficientsUpdateBatch()
+    {
+        assert(!mIsBatchingCoefficientsUpdates);
+
+        mIsBatchingCoefficientsUpdates = true;
+        mBatchedCoefficientsUpdateSprings.clear();
+    }
+
+    void EndCoefficientsUpdateBatch(Points const & points);
+
+    /*
+     * Catches up with changes in the game parameters.
+     *
+     * Changes that would not be numerically safe to apply gradually - i.e. changes in the number
+     * of mechanical iterations - are applied to all springs at once; all other changes are applied
+     * to a slice of the springs at each invocation, until all springs are current.
+     */
     void UpdateForGameParameters(
         GameParameters const & gameParameters,
-        Points const & points);
+        Points const & points,
+        TaskThreadPool & taskThreadPool);
+
+    /*
+     * Moves the springs into the specified order - e.g. so to pack deleted springs at the end; the
+     * element at new index i is the spring that was at index newToOldSpringIndices[i].
+     *
+     * The caller is responsible for remapping all spring indices held elsewhere.
+     */
+    void Permute(std::vector<ElementIndex> const & newToOldSpringIndices);
 
     void UpdateForDecayAndTemperature(
         ElementIndex partition,
@@ -235,6 +301,12 @@ public:
         ElementIndex springElementIndex,
         Points const & points)
     {
+        if (mIsBatchingCoefficientsUpdates)
+        {
+            mBatchedCoefficientsUpdateSprings.push_back(springElementIndex);
+            return;
+        }
+
         // Recalculate coefficients for this spring
         UpdateCoefficients(
             springElementIndex,
@@ -266,11 +338,15 @@ public:
     /*
      * Calculates the current strain - due to tension or compression - and acts depending on it,
      * eventually breaking springs.
+     *
+     * Strains are calculated concurrently, while springs are broken afterwards on the calling
+     * thread, in spring order.
      */
     void UpdateForStrains(
         GameParameters const & gameParameters,
         Points & points,
-        StressRenderModeType stressRenderMode);
+        StressRenderModeType stressRenderMode,
+        TaskThreadPool & taskThreadPool);
 
     //
     // Render
@@ -284,6 +360,26 @@ public:
         ShipId shipId,
         Render::RenderContext & renderContext) const;
 
+    /*
+     * Sets the stress of each point to the stress with the greatest magnitude among its
+     * springs, as calculated by the last strain update; only needed when rendering stress,
+     * hence done once per rendered frame rather than at each simulation step.
+     */
+    void CalculatePointStress(Points & points) const;
+
+    /*
+     * Gets the number of bytes occupied by all of our buffers; for diagnostics only.
+     */
+    size_t GetByteSize() const;
+
+    /*
+     * Saves and restores the whole simulation state of the springs; the springs
+     * are expected to be the same as the ones the state has been saved from, though
+     * possibly renumbered by Permute().
+     */
+    void SaveState(StateSnapshotWriter & writer) const;
+    void LoadState(StateSnapshotReader & reader);
+
 public:
 
     //
@@ -295,6 +391,23 @@ public:
         return mIsDeletedBuffer[springElementIndex];
     }
 
+    /*
+     * The non-deleted springs, for iterating them without visiting deleted ones.
+     */
+    ElementBitmap const & GetLiveSprings() const
+    {
+        return mLiveSprings;
+    }
+
+    /*
+     * Gets the number of springs - starting from the first one - that need to be
+     * simulated; all springs at or past this index are deleted.
+     */
+    ElementCount GetSimulatedElementCount() const noexcept
+    {
+        return mSimulatedElementCount;
+    }
+
     //
     // Endpoints
     //
@@ -327,8 +440,32 @@ public:
         return mEndpointsBuffer.data();
     }
 
+    // Structure-of-arrays copies of the endpoints, for vectorized algorithms
+
+    ElementIndex const * GetEndpointAIndexBuffer() const noexcept
+    {
+        return mEndpointAIndexBuffer.data();
+    }
+
+    ElementIndex const * GetEndpointBIndexBuffer() const noexcept
+    {
+        return mEndpointBIndexBuffer.data();
+    }
+
     // Returns +1.0 if the spring is directed outward from the specified point;
     // otherwise, -1.0.
+    /*
+     * Returns the indices of the springs - deleted ones included - that might intersect
+     * the specified segment, in ascending order. Callers are responsible for checking the
+     * actual intersection, as well as whether each spring is deleted.
+     *
+     * The returned vector is only valid until the next query.
+     */
+    std::vector<ElementIndex> const & QuerySpringsAlongSegment(
+        vec2f const & startPos,
+        vec2f const & endPos,
+        Points const & points) const;
+
     float GetSpringDirectionFrom(
         ElementIndex springElementIndex,
         ElementIndex pointIndex) const
@@ -534,6 +671,18 @@ public:
         return mDynamicsCoefficientsBuffer.data();
     }
 
+    // Structure-of-arrays copies of the dynamics coefficients, for vectorized algorithms
+
+    float const * GetStiffnessCoefficientBuffer() const noexcept
+    {
+        return mStiffnessCoefficientBuffer.data();
+    }
+
+    float const * GetDampingCoefficientBuffer() const noexcept
+    {
+        return mDampingCoefficientBuffer.data();
+    }
+
     float GetMaterialStrength(ElementIndex springElementIndex) const
     {
         return mMaterialPropertiesBuffer[springElementIndex].MaterialStrength;
@@ -566,6 +715,18 @@ public:
         return mIsRopeBuffer[springElementIndex];
     }
 
+    float GetRopeConstraintCorrection(ElementIndex springElementIndex) const
+    {
+        return mRopeConstraintCorrectionBuffer[springElementIndex];
+    }
+
+    void SetRopeConstraintCorrection(
+        ElementIndex springElementIndex,
+        float value)
+    {
+        mRopeConstraintCorrectionBuffer[springElementIndex] = value;
+    }
+
     //
     // Water
     //
@@ -607,10 +768,54 @@ public:
 
 private:
 
+    template<typename TSelf, typename TArchive>
+    static void ArchiveState(
+        TSelf & self,
+        TArchive & archive);
+
+    /*
+     * An outcome of a strain calculation that requires actions with side effects.
+     */
+    struct StrainEvent
+    {
+        enum class EventType
+        {
+            Break,
+            Stress
+        };
+
+        ElementIndex SpringIndex;
+        EventType Type;
+
+        StrainEvent(
+            ElementIndex springIndex,
+            EventType type)
+            : SpringIndex(springIndex)
+            , Type(type)
+        {}
+    };
+
     template<bool DoUpdateStress>
     inline void InternalUpdateForStrains(
         GameParameters const & gameParameters,
-        Points & points);
+        Points & points,
+        TaskThreadPool & taskThreadPool);
+
+    template<bool DoUpdateStress>
+    inline void CalculateStrainsForPartition(
+        ElementIndex startSpringIndex,
+        ElementIndex endSpringIndex,
+        Points const & points,
+        std::vector<StrainEvent> & strainEvents);
+
+    // Invokes the function with each live spring in [start, end), in index order,
+    // together with its current length - calculated in batches
+    template<typename TFunc>
+    inline void ForEachLiveSpringLength(
+        ElementIndex startSpringIndex,
+        ElementIndex endSpringIndex,
+        Points const & points,
+        TFunc && func) const; // void(ElementIndex, float)
 
     static float CalculateSpringStrengthIterationsAdjustment(float numMechanicalDynamicsIterationsAdjustment)
     {
@@ -651,6 +856,12 @@ private:
             * (Clamp(strength, StartStrength, EndStrength) - StartStrength);
     }
 
+    void UpdateCoefficientsForFrames(
+        size_t startFrame,
+        size_t endFrame,
+        Points const & points,
+        TaskThreadPool & taskThreadPool);
+
     void UpdateCoefficientsForPartition(
         ElementIndex partition,
         ElementIndex partitionCount,
@@ -672,6 +883,18 @@ private:
         float meltingTemperatureAdjustment,
         Points const & points);
 
+    inline void SetDynamicsCoefficients(
+        ElementIndex springIndex,
+        float stiffnessCoefficient,
+        float dampingCoefficient)
+    {
+        // Keep structure-of-arrays copies in sync
+        mDynamicsCoefficientsBuffer[springIndex].StiffnessCoefficient = stiffnessCoefficient;
+        mStiffnessCoefficientBuffer[springIndex] = stiffnessCoefficient;
+        mDynamicsCoefficientsBuffer[springIndex].DampingCoefficient = dampingCoefficient;
+        mDampingCoefficientBuffer[springIndex] = dampingCoefficient;
+    }
+
     inline void inline_UpdateCoefficients(
         ElementIndex springIndex,
         float numMechanicalDynamicsIterations,
@@ -690,9 +913,12 @@ private:
 
     // Deletion
     Buffer<bool> mIsDeletedBuffer;
+    ElementBitmap mLiveSprings; // Complement of mIsDeletedBuffer
 
     // Endpoints
     Buffer<Endpoints> mEndpointsBuffer;
+    Buffer<ElementIndex> mEndpointAIndexBuffer; // SoA copy
+    Buffer<ElementIndex> mEndpointBIndexBuffer; // SoA copy
 
     // Factory-time endpoint octants
     Buffer<EndpointOctants> mFactoryEndpointOctantsBuffer;
@@ -714,13 +940,20 @@ private:
     //
 
     Buffer<StrainState> mStrainStateBuffer;
+    Buffer<float> mStressBuffer; // -1.0 -> 1.0, only calculated if rendering it; not part of the state
     Buffer<float> mFactoryRestLengthBuffer;
     Buffer<float> mRestLengthBuffer;
     Buffer<DynamicsCoefficients> mDynamicsCoefficientsBuffer;
+    Buffer<float> mStiffnessCoefficientBuffer; // SoA copy
+    Buffer<float> mDampingCoefficientBuffer; // SoA copy
     Buffer<MaterialProperties> mMaterialPropertiesBuffer;
     Buffer<StructuralMaterial const *> mBaseStructuralMaterialBuffer;
     Buffer<bool> mIsRopeBuffer;
 
+    // The total shortening applied by the rope constraint solver to this
+    // (rope) spring at the last step; used to warm-start the solver
+    Buffer<float> mRopeConstraintCorrectionBuffer;
+
     //
     // Water
     //
@@ -745,9 +978,13 @@ private:
     std::shared_ptr<GameEventDispatcher> const mGameEventHandler;
     IShipPhysicsHandler * mShipPhysicsHandler;
 
+    // All springs at or past this index are deleted
+    ElementCount mSimulatedElementCount;
+
     // The game parameter values that we are current with; changes
     // in the values of these parameters will trigger a re-calculation
     // of pre-calculated coefficients
+    std::uint64_t mCurrentGameParametersGeneration;
     float mCurrentNumMechanicalDynamicsIterations;
     float mCurrentNumMechanicalDynamicsIterationsAdjustment;
     float mCurrentSpringStiffnessAdjustment;
@@ -758,6 +995,36 @@ private:
     // Allocators for work buffers
     BufferAllocator<float> mFloatBufferAllocator;
     BufferAllocator<vec2f> mVec2fBufferAllocator;
+
+    // The strain events of each partition of springs, in spring order;
+    // member only to save allocations at use time
+    std::vector<std::vector<StrainEvent>> mStrainEventsByPartition;
+
+    // The coefficients re-calculation that follows a game parameter change
+    // is spread over this many frames
+    static size_t constexpr PendingCoefficientsUpdateFrameCount = 4;
+
+    // The number of partitions - run concurrently - in which the springs of
+    // each frame of the pending re-calculation are updated
+    size_t mPendingCoefficientsUpdateSubPartitionCount;
+
+    // The next frame of the pending re-calculation;
+    // PendingCoefficientsUpdateFrameCount when there's none pending
+    size_t mNextPendingCoefficientsUpdateFrame;
+
+    // The spatial index of all springs, rebuilt lazily at the first query after
+    // point positions have changed, or after springs have been renumbered
+    static float constexpr SpatialIndexCellSize = 2.0f;
+    SpatialHashGrid mutable mSpatialIndex;
+    std::optional<std::uint64_t> mutable mSpatialIndexPointsVersion; // None when stale
+
+    // The result of the last spatial query; member only to save allocations
+    std::vector<ElementIndex> mutable mSpatialQueryResult;
+
+    // The springs whose coefficients are to be recalculated at the end of the
+    // current batch of coefficient updates, possibly with duplicates
+    bool mIsBatchingCoefficientsUpdates;
+    std::vector<ElementIndex> mBatchedCoefficientsUpdateSprings;
 };
 
 }
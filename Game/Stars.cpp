@@ -14,7 +14,8 @@ namespace Physics {
 
 Stars::Stars()
     : mStars()
-    , mStarCountDirtyForRendering()
+    , mAreStarsDirtyForRendering(false)
+    , mMovingStar()
     // Moving stars state machine
     , mCurrentMovingStarState()
     , mNextMovingStarSimulationTime(std::numeric_limits<float>::max()) // Will be recalculated
@@ -35,6 +36,7 @@ void Stars::Update(
 
         // Clear state machine
         mCurrentMovingStarState.reset();
+        mMovingStar.reset();
 
         if (!mStars.empty())
         {
@@ -59,11 +61,11 @@ void Stars::Update(
         // Update current state machine
         if (!UpdateMovingStarStateMachine(
             *mCurrentMovingStarState,
-            currentSimulationTime,
-            mStars[0]))
+            currentSimulationTime))
         {
             // Done
             mCurrentMovingStarState.reset();
+            mMovingStar.reset();
 
             // Schedule next state machine
             mNextMovingStarSimulationTime = currentSimulationTime + CalculateNextMovingStarInterval();
@@ -81,13 +83,11 @@ void Stars::Update(
 
 void Stars::Upload(Render::RenderContext & renderContext) const
 {
-    if (mStarCountDirtyForRendering.has_value())
+    if (mAreStarsDirtyForRendering)
     {
-        assert(*mStarCountDirtyForRendering <= mStars.size());
+        renderContext.UploadStarsStart(mStars.size());
 
-        renderContext.UploadStarsStart(*mStarCountDirtyForRendering, mStars.size());
-
-        for (size_t s = 0; s < *mStarCountDirtyForRendering; ++s)
+        for (size_t s = 0; s < mStars.size(); ++s)
         {
             auto const & star = mStars[s];
             renderContext.UploadStar(s, star.PositionNdc, star.Brightness);
@@ -95,7 +95,12 @@ void Stars::Upload(Render::RenderContext & renderContext) const
 
         renderContext.UploadStarsEnd();
 
-        mStarCountDirtyForRendering.reset();
+        mAreStarsDirtyForRendering = false;
+    }
+
+    if (mMovingStar.has_value())
+    {
+        renderContext.UploadMovingStar(mMovingStar->PositionNdc, mMovingStar->Brightness);
     }
 }
 
@@ -106,23 +111,16 @@ void Stars::RegenerateStars(unsigned int numberOfStars)
     mStars.clear();
     mStars.reserve(numberOfStars);
 
-    if (numberOfStars > 0)
+    for (unsigned int s = 0; s < numberOfStars; ++s)
     {
-        // Park first star here, which will be the moving star
-        mStars.emplace_back(vec2f(-1.0f, -1.0f), 0.0f);
-
-        // Do other stars
-        for (unsigned int s = 1; s < numberOfStars; ++s)
-        {
-            mStars.emplace_back(
-                vec2f(
-                    GameRandomEngine::GetInstance().GenerateUniformReal(-1.0f, +1.0f),
-                    GameRandomEngine::GetInstance().GenerateUniformReal(-1.0f, +1.0f)),
-                GameRandomEngine::GetInstance().GenerateUniformReal(0.25f, +1.0f));
-        }
+        mStars.emplace_back(
+            vec2f(
+                GameRandomEngine::GetInstance().GenerateUniformReal(-1.0f, +1.0f),
+                GameRandomEngine::GetInstance().GenerateUniformReal(-1.0f, +1.0f)),
+            GameRandomEngine::GetInstance().GenerateUniformReal(0.25f, +1.0f));
     }
 
-    mStarCountDirtyForRendering = numberOfStars;
+    mAreStarsDirtyForRendering = true;
 }
 
 Stars::MovingStarState Stars::MakeMovingStarStateMachine(float currentSimulationTime)
@@ -164,9 +162,15 @@ Stars::MovingStarState Stars::MakeMovingStarStateMachine(float currentSimulation
 
 bool Stars::UpdateMovingStarStateMachine(
     MovingStarState & state,
-    float currentSimulationTime,
-    Star & movingStar)
+    float currentSimulationTime)
 {
+    if (!mMovingStar.has_value())
+    {
+        mMovingStar.emplace(state.StartPosition, 0.0f);
+    }
+
+    Star & movingStar = *mMovingStar;
+
     bool doContinue = true;
 
     switch (state.Type)
@@ -212,19 +216,6 @@ bool Stars::UpdateMovingStarStateMachine(
         }
     }
 
-    if (!doContinue)
-    {
-        // Park the star
-        movingStar.PositionNdc = vec2f(-1.0f, -1.0f);
-        movingStar.Brightness = 0.0f;
-    }
-
-    // Remember to refresh the moving star
-    assert(mStars.size() > 0);
-    mStarCountDirtyForRendering = std::max(
-        size_t(1),
-        mStarCountDirtyForRendering.value_or(0));
-
     return doContinue;
 }
 
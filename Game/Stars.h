@@ -37,8 +37,7 @@ private:
 
     bool UpdateMovingStarStateMachine(
         MovingStarState & state,
-        float currentSimulationTime,
-        Star & movingStar);
+        float currentSimulationTime);
 
     static float CalculateNextMovingStarInterval();
 
@@ -57,9 +56,12 @@ private:
         {}
     };
 
+    // The static star field, only uploaded when it changes
     std::vector<Star> mStars;
+    mutable bool mAreStarsDirtyForRendering;
 
-    mutable std::optional<size_t> mStarCountDirtyForRendering;
+    // The star currently moving across the sky, if any; uploaded at each frame
+    std::optional<Star> mMovingStar;
 
     //
     // Moving stars state machine
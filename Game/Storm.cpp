@@ -23,6 +23,9 @@ float constexpr PoissonSampleRate = 4.0f;
 GameWallClock::duration constexpr PoissonSampleDeltaT = std::chrono::duration_cast<GameWallClock::duration>(
 	std::chrono::duration<float>(1.0f / PoissonSampleRate));
 
+// The duration of a lightning, in seconds
+float constexpr LightningDuration = 0.6f;
+
 Storm::Storm(
 	World & parentWorld,
 	std::shared_ptr<GameEventDispatcher> gameEventDispatcher)
@@ -44,6 +47,7 @@ Storm::Storm(
 	, mNextBackgroundLightningPoissonSampleTimestamp(GameWallClock::GetInstance().Now())
 	, mNextForegroundLightningPoissonSampleTimestamp(GameWallClock::GetInstance().Now())
 	, mLightnings()
+	, mAreLightningsDirty(true)
 	, mCurrentStormRate(std::chrono::minutes::max())
 	, mCurrentStormStrengthAdjustment(std::numeric_limits<float>::max())
 	, mCurrentLightningBlastProbability(std::numeric_limits<float>::max())
@@ -336,10 +340,15 @@ void Storm::Upload(Render::RenderContext & renderContext) const
 	renderContext.UploadRain(mParameters.RainDensity);
 
 	//
-	// Upload lightnings
+	// Upload lightnings, only when they come and go; the render
+	// context animates them on its own
 	//
 
-	UploadLightnings(renderContext);
+	if (mAreLightningsDirty)
+	{
+		UploadLightnings(renderContext);
+		mAreLightningsDirty = false;
+	}
 }
 
 void Storm::TriggerStorm()
@@ -524,6 +533,8 @@ void Storm::DoTriggerBackgroundLightning(GameWallClock::time_point now)
 		ndcX,
 		std::nullopt);
 
+	mAreLightningsDirty = true;
+
 	// Notify
 	mGameEventHandler->OnLightning();
 }
@@ -540,6 +551,8 @@ void Storm::DoTriggerForegroundLightning(
 		std::nullopt,
 		targetWorldPosition);
 
+	mAreLightningsDirty = true;
+
 	// Notify
 	mGameEventHandler->OnLightning();
 }
@@ -555,8 +568,6 @@ void Storm::UpdateLightnings(
 		// Calculate progress of lightning: 0.0f = beginning, 1.0f = end
 		//
 
-		float constexpr LightningDuration = 0.6f;
-
 		it->Progress = std::min(1.0f,
 			std::chrono::duration_cast<std::chrono::duration<float, std::ratio<1>>>(now - it->StartTimestamp).count()
 			/ LightningDuration);
@@ -584,6 +595,7 @@ void Storm::UpdateLightnings(
 		{
 			// This lightning is complete
 			it = mLightnings.erase(it);
+			mAreLightningsDirty = true;
 		}
 		else
 		{
@@ -606,8 +618,8 @@ void Storm::UploadLightnings(Render::RenderContext & renderContext) const
 
 				renderContext.UploadBackgroundLightning(
 					*(l.NdcX),
-					l.Progress,
-					l.RenderProgress,
+					GameWallClock::GetInstance().AsFloat(l.StartTimestamp),
+					LightningDuration,
 					l.PersonalitySeed);
 
 				break;
@@ -619,8 +631,8 @@ void Storm::UploadLightnings(Render::RenderContext & renderContext) const
 
 				renderContext.UploadForegroundLightning(
 					*(l.TargetWorldPosition),
-					l.Progress,
-					l.RenderProgress,
+					GameWallClock::GetInstance().AsFloat(l.StartTimestamp),
+					LightningDuration,
 					l.PersonalitySeed);
 
 				break;
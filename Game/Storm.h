@@ -178,6 +178,9 @@ private:
 	// The current lightnings' state machines
 	std::list<LightningStateMachine> mLightnings;
 
+	// Set when lightnings have come or gone since the last upload
+	bool mutable mAreLightningsDirty;
+
 	// Parameters that the calculated values are current with
 	std::chrono::minutes mCurrentStormRate;
 	float mCurrentStormStrengthAdjustment;
@@ -0,0 +1,386 @@
+/***************************************************************************************
+ * Original Author:     Gabriele Giuseppini
+ * Created:             2026-10-14
+ * Copyright:           Gabriele Giuseppini  (https://github.com/GabrieleGiuseppini)
+ ***************************************************************************************/
+#include "TelemetrySink.h"
+
+#include <GameCore/GameException.h>
+#include <GameCore/Profiler.h>
+
+#include <algorithm>
+#include <cassert>
+#include <chrono>
+#include <cstdio>
+#include <map>
+
+TelemetrySink::TelemetrySink()
+    : mOutputStream()
+    , mBuffer()
+    , mIsFirstFieldOfLine(true)
+    , mLastProfilerZoneEndTicks(0)
+    , mWriterThread(std::make_unique<TaskThread>())
+{
+}
+
+TelemetrySink::~TelemetrySink()
+{
+    Stop();
+}
+
+void TelemetrySink::Start(std::filesystem::path const & outputFilePath)
+{
+    Stop();
+
+    auto outputStream = std::make_shared<std::ofstream>(outputFilePath, std::ios_base::out | std::ios_base::trunc | std::ios_base::binary);
+    if (!outputStream->is_open())
+    {
+        throw GameException("Cannot open telemetry file \"" + outputFilePath.string() + "\"");
+    }
+
+    mOutputStream = std::move(outputStream);
+    mBuffer.clear();
+
+    // Only zones completed from now on
+    mLastProfilerZoneEndTicks = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+void TelemetrySink::Stop()
+{
+    if (!IsStarted())
+        return;
+
+    Flush();
+
+    // Wait for the writer to be done with the stream
+    mWriterThread->QueueSynchronizationPoint()->Wait();
+
+    mOutputStream.reset();
+}
+
+void TelemetrySink::RecordPerfStats(PerfStats const & lastDeltaPerfStats)
+{
+    if (!IsStarted())
+        return;
+
+    BeginLine("perf");
+    AppendField("update_ms", lastDeltaPerfStats.TotalUpdateDuration.ToRatio<std::chrono::milliseconds>());
+    AppendField("net_update_ms", lastDeltaPerfStats.TotalNetUpdateDuration.ToRatio<std::chrono::milliseconds>());
+    AppendField("fish_update_ms", lastDeltaPerfStats.TotalFishUpdateDuration.ToRatio<std::chrono::milliseconds>());
+    AppendField("ocean_surface_update_ms", lastDeltaPerfStats.TotalOceanSurfaceUpdateDuration.ToRatio<std::chrono::milliseconds>());
+    AppendField("ships_update_ms", lastDeltaPerfStats.TotalShipsUpdateDuration.ToRatio<std::chrono::milliseconds>());
+    AppendField("ships_springs_update_ms", lastDeltaPerfStats.TotalShipsSpringsUpdateDuration.ToRatio<std::chrono::milliseconds>());
+    AppendField("render_upload_ms", lastDeltaPerfStats.TotalNetRenderUploadDuration.ToRatio<std::chrono::milliseconds>());
+    AppendField("wait_for_render_draw_ms", lastDeltaPerfStats.TotalWaitForRenderDrawDuration.ToRatio<std::chrono::milliseconds>());
+    AppendField("render_draw_ms", lastDeltaPerfStats.TotalRenderDrawDuration.ToRatio<std::chrono::milliseconds>());
+    AppendField("mechanical_iterations", lastDeltaPerfStats.TotalShipsMechanicalDynamicsIterations.ToAverage());
+    AppendField("ephemeral_particle_exhaustions", lastDeltaPerfStats.TotalShipsEphemeralParticleExhaustions.ToAverage());
+    AppendField("air_bubble_particles", lastDeltaPerfStats.TotalShipsAirBubbleParticles.ToAverage());
+    AppendField("debris_particles", lastDeltaPerfStats.TotalShipsDebrisParticles.ToAverage());
+    AppendField("smoke_particles", lastDeltaPerfStats.TotalShipsSmokeParticles.ToAverage());
+    AppendField("sparkle_particles", lastDeltaPerfStats.TotalShipsSparkleParticles.ToAverage());
+    AppendField("wake_bubble_particles", lastDeltaPerfStats.TotalShipsWakeBubbleParticles.ToAverage());
+    EndLine();
+
+    for (size_t s = 0; s < lastDeltaPerfStats.Ships.size(); ++s)
+    {
+        auto const & shipPerfStats = lastDeltaPerfStats.Ships[s];
+        if (shipPerfStats.UpdateDuration.GetCount() == 0)
+        {
+            // Not updated in this period
+            continue;
+        }
+
+        std::string const shipTag = "ship=" + std::to_string(s);
+
+        BeginLine(("ship_perf," + shipTag).c_str());
+        AppendField("update_ms", shipPerfStats.UpdateDuration.ToRatio<std::chrono::milliseconds>());
+        AppendField("live_points", shipPerfStats.LivePoints.ToAverage());
+        AppendField("live_springs", shipPerfStats.LiveSprings.ToAverage());
+        AppendField("ephemeral_particles", shipPerfStats.EphemeralParticles.ToAverage());
+        AppendField("frontiers", shipPerfStats.Frontiers.ToAverage());
+        EndLine();
+
+        for (size_t st = 0; st < PerfStats::ShipUpdateStageCount; ++st)
+        {
+            auto const & stageDuration = shipPerfStats.StageDurations[st];
+            if (stageDuration.GetCount() == 0)
+            {
+                // Not run in this period
+                continue;
+            }
+
+            BeginLine(("ship_stage," + shipTag + ",stage=" + PerfStats::GetShipUpdateStageName(static_cast<PerfStats::ShipUpdateStageType>(st))).c_str());
+            AppendField("ms", stageDuration.ToRatio<std::chrono::milliseconds>());
+            AppendIntegerField("count", static_cast<std::int64_t>(stageDuration.GetCount()));
+            EndLine();
+        }
+    }
+}
+
+void TelemetrySink::RecordProfilerZones()
+{
+    if (!IsStarted() || !Profiler::GetInstance().IsEnabled())
+        return;
+
+    struct ZoneTotal
+    {
+        std::int64_t TotalTicks;
+        std::int64_t Count;
+    };
+
+    // Aggregate by name, across all threads; zones overwritten in the ring buffers
+    // before we got here are lost
+    std::map<std::string, ZoneTotal> zoneTotals;
+    std::int64_t lastEndTicks = mLastProfilerZoneEndTicks;
+    for (auto const & sample : Profiler::GetInstance().GetSamples())
+    {
+        if (sample.EndTicks > mLastProfilerZoneEndTicks)
+        {
+            auto & zoneTotal = zoneTotals[sample.Name];
+            zoneTotal.TotalTicks += sample.EndTicks - sample.StartTicks;
+            zoneTotal.Count += 1;
+
+            lastEndTicks = std::max(lastEndTicks, sample.EndTicks);
+        }
+    }
+
+    mLastProfilerZoneEndTicks = lastEndTicks;
+
+    for (auto const & [name, zoneTotal] : zoneTotals)
+    {
+        BeginLine(("zone,name=" + EscapeTagValue(name)).c_str());
+        AppendField("total_ms", static_cast<float>(static_cast<double>(zoneTotal.TotalTicks) / 1000000.0));
+        AppendIntegerField("count", zoneTotal.Count);
+        EndLine();
+    }
+}
+
+void TelemetrySink::Flush()
+{
+    if (!IsStarted() || mBuffer.empty())
+        return;
+
+    mWriterThread->QueueTask(
+        [outputStream = mOutputStream, buffer = std::move(mBuffer)]()
+        {
+            outputStream->write(buffer.data(), buffer.size());
+            outputStream->flush();
+        });
+
+    mBuffer = std::string();
+}
+
+void TelemetrySink::OnShipLoaded(
+    ShipId id,
+    ShipMetadata const & shipMetadata)
+{
+    if (!IsStarted())
+        return;
+
+    BeginLine(("event,type=ship_loaded,ship=" + std::to_string(id)).c_str());
+    AppendStringField("name", shipMetadata.ShipName);
+    EndLine();
+}
+
+void TelemetrySink::OnSinkingBegin(ShipId shipId)
+{
+    RecordShipEvent("sinking_begin", shipId);
+}
+
+void TelemetrySink::OnSinkingEnd(ShipId shipId)
+{
+    RecordShipEvent("sinking_end", shipId);
+}
+
+void TelemetrySink::OnShipRepaired(ShipId shipId)
+{
+    RecordShipEvent("ship_repaired", shipId);
+}
+
+void TelemetrySink::OnTsunami(float x)
+{
+    if (!IsStarted())
+        return;
+
+    BeginLine("event,type=tsunami");
+    AppendField("x", x);
+    EndLine();
+}
+
+void TelemetrySink::OnFrameRateUpdated(
+    float immediateFps,
+    float averageFps)
+{
+    if (!IsStarted())
+        return;
+
+    BeginLine("frame_rate");
+    AppendField("immediate", immediateFps);
+    AppendField("average", averageFps);
+    EndLine();
+}
+
+void TelemetrySink::OnCurrentUpdateDurationUpdated(float currentUpdateDuration)
+{
+    if (!IsStarted())
+        return;
+
+    BeginLine("update_duration");
+    AppendField("ms", currentUpdateDuration);
+    EndLine();
+}
+
+void TelemetrySink::OnStaticPressureUpdated(
+    float netForce,
+    float complexity)
+{
+    if (!IsStarted())
+        return;
+
+    BeginLine("static_pressure");
+    AppendField("net_force", netForce);
+    AppendField("complexity", complexity);
+    EndLine();
+}
+
+void TelemetrySink::OnStormBegin()
+{
+    RecordWorldEvent("storm_begin");
+}
+
+void TelemetrySink::OnStormEnd()
+{
+    RecordWorldEvent("storm_end");
+}
+
+void TelemetrySink::OnLightning()
+{
+    RecordWorldEvent("lightning");
+}
+
+std::string TelemetrySink::EscapeTagValue(std::string const & value)
+{
+    std::string escapedValue;
+    escapedValue.reserve(value.size());
+
+    for (char const ch : value)
+    {
+        if (ch == ',' || ch == ' ' || ch == '=')
+        {
+            escapedValue.push_back('\\');
+        }
+
+        escapedValue.push_back(ch);
+    }
+
+    return escapedValue;
+}
+
+std::string TelemetrySink::QuoteFieldValue(std::string const & value)
+{
+    std::string quotedValue;
+    quotedValue.reserve(value.size() + 2);
+
+    quotedValue.push_back('"');
+
+    for (char const ch : value)
+    {
+        if (ch == '"' || ch == '\\')
+        {
+            quotedValue.push_back('\\');
+        }
+
+        quotedValue.push_back(ch);
+    }
+
+    quotedValue.push_back('"');
+
+    return quotedValue;
+}
+
+void TelemetrySink::BeginLine(char const * measurementAndTags)
+{
+    mBuffer.append(measurementAndTags);
+    mBuffer.push_back(' ');
+    mIsFirstFieldOfLine = true;
+}
+
+void TelemetrySink::AppendField(
+    char const * name,
+    float value)
+{
+    char valueBuffer[32];
+    std::snprintf(valueBuffer, sizeof(valueBuffer), "%.6g", static_cast<double>(value));
+
+    if (!mIsFirstFieldOfLine)
+        mBuffer.push_back(',');
+
+    mBuffer.append(name);
+    mBuffer.push_back('=');
+    mBuffer.append(valueBuffer);
+    mIsFirstFieldOfLine = false;
+}
+
+void TelemetrySink::AppendIntegerField(
+    char const * name,
+    std::int64_t value)
+{
+    if (!mIsFirstFieldOfLine)
+        mBuffer.push_back(',');
+
+    mBuffer.append(name);
+    mBuffer.push_back('=');
+    mBuffer.append(std::to_string(value));
+    mBuffer.push_back('i');
+    mIsFirstFieldOfLine = false;
+}
+
+void TelemetrySink::AppendStringField(
+    char const * name,
+    std::string const & value)
+{
+    if (!mIsFirstFieldOfLine)
+        mBuffer.push_back(',');
+
+    mBuffer.append(name);
+    mBuffer.push_back('=');
+    mBuffer.append(QuoteFieldValue(value));
+    mIsFirstFieldOfLine = false;
+}
+
+void TelemetrySink::EndLine()
+{
+    assert(!mIsFirstFieldOfLine); // The protocol requires at least one field
+
+    // Wall-clock timestamp, in nanoseconds since the epoch
+    auto const timestamp = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+
+    mBuffer.push_back(' ');
+    mBuffer.append(std::to_string(static_cast<std::int64_t>(timestamp)));
+    mBuffer.push_back('\n');
+}
+
+void TelemetrySink::RecordShipEvent(
+    char const * type,
+    ShipId shipId)
+{
+    if (!IsStarted())
+        return;
+
+    BeginLine((std::string("event,type=") + type + ",ship=" + std::to_string(shipId)).c_str());
+    AppendIntegerField("count", 1);
+    EndLine();
+}
+
+void TelemetrySink::RecordWorldEvent(char const * type)
+{
+    if (!IsStarted())
+        return;
+
+    BeginLine((std::string("event,type=") + type).c_str());
+    AppendIntegerField("count", 1);
+    EndLine();
+}
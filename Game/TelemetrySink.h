@@ -0,0 +1,164 @@
+/***************************************************************************************
+ * Original Author:     Gabriele Giuseppini
+ * Created:             2026-10-14
+ * Copyright:           Gabriele Giuseppini  (https://github.com/GabrieleGiuseppini)
+ ***************************************************************************************/
+#pragma once
+
+#include "IGameEventHandlers.h"
+#include "PerfStats.h"
+
+#include <GameCore/TaskThread.h>
+
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <string>
+
+/*
+ * Streams statistics, perf stats, profiler zone totals, and ship and world events, as
+ * InfluxDB line protocol, for recording performance across long unattended runs and
+ * correlating it with what happened in the game.
+ *
+ * Lines are formatted into a buffer on the calling thread, and the buffer is written
+ * out on a background thread at each Flush(); while the sink is not started, every
+ * callback costs a single check. The output may be a plain file or - on systems
+ * supporting them - a named pipe read by a collector.
+ */
+class TelemetrySink final
+    : public ILifecycleGameEventHandler
+    , public IWavePhenomenaGameEventHandler
+    , public IStatisticsGameEventHandler
+    , public IAtmosphereGameEventHandler
+{
+public:
+
+    TelemetrySink();
+
+    ~TelemetrySink();
+
+    bool IsStarted() const
+    {
+        return !!mOutputStream;
+    }
+
+    /*
+     * Starts streaming to the specified file, truncating it; throws when the
+     * file cannot be opened.
+     */
+    void Start(std::filesystem::path const & outputFilePath);
+
+    /*
+     * Flushes all lines and closes the output.
+     */
+    void Stop();
+
+    /*
+     * Records the perf stats accumulated since the last invocation, including - for
+     * each ship updated since then - the ship's costs and the durations of its stages.
+     */
+    void RecordPerfStats(PerfStats const & lastDeltaPerfStats);
+
+    /*
+     * Records the total duration and count, by name, of the profiler zones completed
+     * since the last invocation; does nothing while the profiler is not enabled.
+     */
+    void RecordProfilerZones();
+
+    /*
+     * Hands the lines formatted so far to the background writer.
+     */
+    void Flush();
+
+    //
+    // ILifecycleGameEventHandler
+    //
+
+    void OnShipLoaded(
+        ShipId id,
+        ShipMetadata const & shipMetadata) override;
+
+    void OnSinkingBegin(ShipId shipId) override;
+
+    void OnSinkingEnd(ShipId shipId) override;
+
+    void OnShipRepaired(ShipId shipId) override;
+
+    //
+    // IWavePhenomenaGameEventHandler
+    //
+
+    void OnTsunami(float x) override;
+
+    //
+    // IStatisticsGameEventHandler
+    //
+
+    void OnFrameRateUpdated(
+        float immediateFps,
+        float averageFps) override;
+
+    void OnCurrentUpdateDurationUpdated(float currentUpdateDuration) override;
+
+    void OnStaticPressureUpdated(
+        float netForce,
+        float complexity) override;
+
+    //
+    // IAtmosphereGameEventHandler
+    //
+
+    void OnStormBegin() override;
+
+    void OnStormEnd() override;
+
+    void OnLightning() override;
+
+    //
+    // Formatting; exposed for testing
+    //
+
+    // Escapes commas, spaces, and equal signs, as required by measurement names and tags
+    static std::string EscapeTagValue(std::string const & value);
+
+    // Quotes, escaping quotes and backslashes, as required by string field values
+    static std::string QuoteFieldValue(std::string const & value);
+
+private:
+
+    // Begins a line with its measurement; the measurement and tags must be escaped already
+    void BeginLine(char const * measurementAndTags);
+
+    void AppendField(
+        char const * name,
+        float value);
+
+    void AppendIntegerField(
+        char const * name,
+        std::int64_t value);
+
+    void AppendStringField(
+        char const * name,
+        std::string const & value);
+
+    void EndLine();
+
+    void RecordShipEvent(
+        char const * type,
+        ShipId shipId);
+
+    void RecordWorldEvent(char const * type);
+
+private:
+
+    std::shared_ptr<std::ofstream> mOutputStream; // Set while started; shared with the writer's tasks
+
+    std::string mBuffer; // The lines not yet handed to the writer
+    bool mIsFirstFieldOfLine;
+
+    std::int64_t mLastProfilerZoneEndTicks;
+
+    // Last, so that it's joined before the stream goes away
+    std::unique_ptr<TaskThread> mWriterThread;
+};
@@ -9,11 +9,21 @@
 
 #include <GameCore/GameException.h>
 #include <GameCore/ImageTools.h>
+#include <GameCore/Log.h>
 #include <GameCore/SysSpecifics.h>
 #include <GameCore/Utils.h>
 
+#include <array>
 #include <cmath>
 #include <cstring>
+#include <exception>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <limits>
+#include <mutex>
+#include <sstream>
+#include <tuple>
 
 namespace Render {
 
@@ -254,7 +264,8 @@ TextureAtlas<TextureGroups> TextureAtlasBuilder<TextureGroups>::BuildAtlas(
         {
             return group.LoadFrame(frameId.FrameIndex);
         },
-        progressCallback);
+        progressCallback,
+        nullptr);
 }
 
 template <typename TextureGroups>
@@ -282,7 +293,8 @@ TextureAtlas<TextureGroups> TextureAtlasBuilder<TextureGroups>::BuildAtlas(
         {
             return this->mTextureFrameSpecifications.at(frameId).LoadFrame();
         },
-        progressCallback);
+        progressCallback,
+        nullptr);
 }
 
 /////////////////////////////////////////////////////////////////////////////////////
@@ -290,127 +302,186 @@ TextureAtlas<TextureGroups> TextureAtlasBuilder<TextureGroups>::BuildAtlas(
 template <typename TextureGroups>
 typename TextureAtlasBuilder<TextureGroups>::AtlasSpecification TextureAtlasBuilder<TextureGroups>::BuildAtlasSpecification(std::vector<TextureInfo> const & inputTextureInfos)
 {
+    int maxFrameWidth = 1;
+    int totalFrameWidth = 0;
+    for (auto const & ti : inputTextureInfos)
+    {
+        maxFrameWidth = std::max(maxFrameWidth, ti.Size.width);
+        totalFrameWidth += ti.Size.width;
+    }
+
     //
-    // Sort input texture info's by height, from tallest to shortest,
-    // and then by width
+    // Pack with a skyline at each power-of-two atlas width - from the narrowest that
+    // fits the widest frame, to the one that fits all frames side by side - and with
+    // a few orderings of the frames, keeping the packing with the smallest (power-of-two)
+    // area; on ties, the squarest one, and then the widest one
     //
 
-    std::vector<TextureInfo> sortedTextureInfos = inputTextureInfos;
-    std::sort(
-        sortedTextureInfos.begin(),
-        sortedTextureInfos.end(),
-        [](TextureInfo const & a, TextureInfo const & b)
-        {
-            return a.Size.height > b.Size.height
-                || (a.Size.height == b.Size.height && a.Size.width > b.Size.width);
-        });
-
+    using SortKey = std::tuple<int, int>;
+    std::array<std::function<SortKey(ImageSize const &)>, 3> const sortKeys{
+        [](ImageSize const & size) { return SortKey(size.height, size.width); }, // Tallest first
+        [](ImageSize const & size) { return SortKey(std::max(size.width, size.height), std::min(size.width, size.height)); }, // Longest side first
+        [](ImageSize const & size) { return SortKey(size.width * size.height, size.height); } // Largest first
+    };
 
-    //
-    // Calculate size of atlas
-    //
+    std::optional<AtlasSpecification> bestSpecification;
 
-    uint64_t totalArea = 0;
-    for (auto const & ti : sortedTextureInfos)
+    for (auto const & sortKey : sortKeys)
     {
-        totalArea += static_cast<uint64_t>(ti.Size.width * ti.Size.height);
-    }
+        std::vector<TextureInfo> sortedTextureInfos = inputTextureInfos;
+        std::stable_sort(
+            sortedTextureInfos.begin(),
+            sortedTextureInfos.end(),
+            [&sortKey](TextureInfo const & a, TextureInfo const & b)
+            {
+                return sortKey(a.Size) > sortKey(b.Size);
+            });
 
-    // Square root of area, floor'd to next power of two, minimized
-    int const atlasSide = ceil_power_of_two(static_cast<int>(std::floor(std::sqrt(static_cast<float>(totalArea))))) / 2;
-    int atlasWidth = atlasSide;
-    int atlasHeight = atlasSide;
+        for (int atlasWidth = ceil_power_of_two(maxFrameWidth); ; atlasWidth *= 2)
+        {
+            auto specification = PackSkyline(sortedTextureInfos, atlasWidth);
+
+            if (!bestSpecification.has_value()
+                || specification.AtlasSize.GetLinearSize() < bestSpecification->AtlasSize.GetLinearSize()
+                || (specification.AtlasSize.GetLinearSize() == bestSpecification->AtlasSize.GetLinearSize()
+                    && (std::max(specification.AtlasSize.width, specification.AtlasSize.height) < std::max(bestSpecification->AtlasSize.width, bestSpecification->AtlasSize.height)
+                        || (std::max(specification.AtlasSize.width, specification.AtlasSize.height) == std::max(bestSpecification->AtlasSize.width, bestSpecification->AtlasSize.height)
+                            && specification.AtlasSize.width > bestSpecification->AtlasSize.width))))
+            {
+                bestSpecification.emplace(std::move(specification));
+            }
 
+            if (atlasWidth >= totalFrameWidth)
+            {
+                // Wider atlases would only add empty space
+                break;
+            }
+        }
+    }
+
+    assert(bestSpecification.has_value());
+    return std::move(*bestSpecification);
+}
 
+template <typename TextureGroups>
+typename TextureAtlasBuilder<TextureGroups>::AtlasSpecification TextureAtlasBuilder<TextureGroups>::PackSkyline(
+    std::vector<TextureInfo> const & sortedTextureInfos,
+    int atlasWidth)
+{
     //
-    // Place tiles
+    // The skyline is the top edge of the frames placed so far, as a sequence of horizontal
+    // segments from left to right; each frame goes where its top would be lowest (and then
+    // leftmost), resting on the highest segment beneath it
     //
 
-    std::vector<typename AtlasSpecification::TexturePosition> texturePositions;
-    texturePositions.reserve(inputTextureInfos.size());
-
-    struct Position
+    struct Segment
     {
         int x;
         int y;
+        int width;
 
-        Position(
+        Segment(
             int _x,
-            int _y)
+            int _y,
+            int _width)
             : x(_x)
             , y(_y)
+            , width(_width)
         {}
     };
 
-    std::vector<Position> positionStack;
-    positionStack.emplace_back(0, 0);
+    std::vector<Segment> skyline;
+    skyline.emplace_back(0, 0, atlasWidth);
+
+    std::vector<typename AtlasSpecification::TexturePosition> texturePositions;
+    texturePositions.reserve(sortedTextureInfos.size());
+
+    int atlasHeight = 1;
 
     for (TextureInfo const & t : sortedTextureInfos)
     {
-        while (true)
+        assert(t.Size.width <= atlasWidth);
+
+        //
+        // Find best position
+        //
+
+        size_t bestSegment = 0;
+        int bestX = 0;
+        int bestY = std::numeric_limits<int>::max();
+
+        for (size_t s = 0; s < skyline.size(); ++s)
         {
-            Position const currentPosition = positionStack.back();
+            int const x = skyline[s].x;
+            if (x + t.Size.width > atlasWidth)
+                break;
 
-            if (currentPosition.x + t.Size.width < atlasWidth   // Fits at current position
-                || positionStack.size() == 1                    // We can't backtrack
-                || (ceil_power_of_two(currentPosition.x + t.Size.width) - atlasWidth) <= (ceil_power_of_two(positionStack.front().y + t.Size.height) - atlasHeight)) // Extra W <= Extra H
+            // Rest on the highest segment under the frame
+            int y = 0;
+            for (size_t s2 = s; s2 < skyline.size() && skyline[s2].x < x + t.Size.width; ++s2)
             {
-                // Put it at the current location
-                texturePositions.emplace_back(
-                    t.FrameId,
-                    currentPosition.x,
-                    currentPosition.y);
+                y = std::max(y, skyline[s2].y);
+            }
 
-                if (positionStack.size() == 1
-                    || currentPosition.y + t.Size.height < std::next(positionStack.rbegin())->y)
-                {
-                    // Move current location up to top
-                    positionStack.back().y += t.Size.height;
-                }
-                else
-                {
-                    // Current location is completed
-                    assert(currentPosition.y + t.Size.height == std::next(positionStack.rbegin())->y);
+            if (y < bestY) // Leftmost wins ties, as we go left to right
+            {
+                bestSegment = s;
+                bestX = x;
+                bestY = y;
+            }
+        }
 
-                    // Pop it from stack
-                    positionStack.pop_back();
-                }
+        assert(bestY != std::numeric_limits<int>::max());
 
-                // Add new location to the right of this tile
-                positionStack.emplace_back(currentPosition.x + t.Size.width, currentPosition.y);
+        texturePositions.emplace_back(
+            t.FrameId,
+            bestX,
+            bestY);
 
-                // Adjust atlas dimensions
-                atlasWidth = ceil_power_of_two(std::max(atlasWidth, currentPosition.x + t.Size.width));
-                atlasHeight = ceil_power_of_two(std::max(atlasHeight, currentPosition.y + t.Size.height));
+        atlasHeight = std::max(atlasHeight, bestY + t.Size.height);
 
-                // We are done with this tile
-                break;
+        //
+        // Update skyline: the new segment replaces - entirely or partially - the
+        // segments under the frame
+        //
+
+        int const frameRightX = bestX + t.Size.width;
+
+        size_t s = bestSegment;
+        while (s < skyline.size() && skyline[s].x < frameRightX)
+        {
+            int const segmentRightX = skyline[s].x + skyline[s].width;
+            if (segmentRightX <= frameRightX)
+            {
+                skyline.erase(skyline.begin() + s);
             }
             else
             {
-                // Backtrack
-                positionStack.pop_back();
-                assert(!positionStack.empty());
+                skyline[s].width = segmentRightX - frameRightX;
+                skyline[s].x = frameRightX;
+                break;
             }
         }
-    }
-
 
-    //
-    // Round final size
-    //
-
-    atlasWidth = ceil_power_of_two(atlasWidth);
-    atlasHeight = ceil_power_of_two(atlasHeight);
+        skyline.emplace(skyline.begin() + bestSegment, bestX, bestY + t.Size.height, t.Size.width);
 
+        // Merge with neighbors at the same height
+        if (bestSegment + 1 < skyline.size() && skyline[bestSegment + 1].y == skyline[bestSegment].y)
+        {
+            skyline[bestSegment].width += skyline[bestSegment + 1].width;
+            skyline.erase(skyline.begin() + bestSegment + 1);
+        }
 
-    //
-    // Return atlas
-    //
+        if (bestSegment > 0 && skyline[bestSegment - 1].y == skyline[bestSegment].y)
+        {
+            skyline[bestSegment - 1].width += skyline[bestSegment].width;
+            skyline.erase(skyline.begin() + bestSegment);
+        }
+    }
 
     return AtlasSpecification(
         std::move(texturePositions),
-        ImageSize(atlasWidth, atlasHeight));
+        ImageSize(atlasWidth, ceil_power_of_two(atlasHeight)));
 }
 
 template <typename TextureGroups>
@@ -616,7 +687,8 @@ TextureAtlas<TextureGroups> TextureAtlasBuilder<TextureGroups>::BuildAtlas(
     AtlasSpecification const & specification,
     AtlasOptions options,
     std::function<TextureFrame<TextureGroups>(TextureFrameId<TextureGroups> const &)> frameLoader,
-    ProgressCallback const & progressCallback)
+    ProgressCallback const & progressCallback,
+    TaskThreadPool * taskThreadPool)
 {
     float const dx = 0.5f / static_cast<float>(specification.AtlasSize.width);
     float const dy = 0.5f / static_cast<float>(specification.AtlasSize.height);
@@ -628,29 +700,86 @@ TextureAtlas<TextureGroups> TextureAtlasBuilder<TextureGroups>::BuildAtlas(
     // Fill image - transparent black
     std::fill_n(atlasImage.get(), imagePoints, rgbaColor::zero());
 
-    // Copy all textures into image, building metadata at the same time
-    std::vector<TextureAtlasFrameMetadata<TextureGroups>> frameMetadata;
-    for (auto const & texturePosition : specification.TexturePositions)
+    //
+    // Load all frames and copy them into the image; frames occupy disjoint rectangles,
+    // hence with a thread pool we do so in parallel, in batches so that we may
+    // report progress from this thread
+    //
+
+    size_t const frameCount = specification.TexturePositions.size();
+
+    std::vector<std::optional<TextureFrameMetadata<TextureGroups>>> loadedFrameMetadata(frameCount);
+    std::vector<ImageSize> loadedFrameSizes(frameCount, ImageSize(0, 0));
+
+    std::mutex exceptionMutex;
+    std::exception_ptr firstException;
+
+    auto const loadAndCopyFrames = [&](size_t frameStart, size_t frameEnd)
+    {
+        for (size_t f = frameStart; f < frameEnd; ++f)
+        {
+            try
+            {
+                auto const & texturePosition = specification.TexturePositions[f];
+
+                // Load frame
+                TextureFrame<TextureGroups> textureFrame = frameLoader(texturePosition.FrameId);
+
+                loadedFrameSizes[f] = textureFrame.TextureData.Size;
+                loadedFrameMetadata[f].emplace(textureFrame.Metadata);
+
+                // Copy frame
+                CopyImage(
+                    std::move(textureFrame.TextureData.Data),
+                    textureFrame.TextureData.Size,
+                    atlasImage.get(),
+                    specification.AtlasSize,
+                    texturePosition.FrameLeftX,
+                    texturePosition.FrameBottomY);
+            }
+            catch (...)
+            {
+                // The pool swallows exceptions, hence we rethrow it ourselves
+                std::lock_guard const lock{ exceptionMutex };
+                if (!firstException)
+                    firstException = std::current_exception();
+            }
+        }
+    };
+
+    size_t const batchSize = (taskThreadPool != nullptr)
+        ? taskThreadPool->GetParallelism() * 4
+        : 1;
+
+    for (size_t batchStart = 0; batchStart < frameCount; batchStart += batchSize)
     {
         progressCallback(
-            static_cast<float>(frameMetadata.size()) / static_cast<float>(specification.TexturePositions.size()),
+            static_cast<float>(batchStart) / static_cast<float>(frameCount),
             ProgressMessageType::None);
 
-        // Load frame
-        TextureFrame<TextureGroups> textureFrame = frameLoader(texturePosition.FrameId);
+        size_t const batchEnd = std::min(batchStart + batchSize, frameCount);
 
-        // Copy frame
-        CopyImage(
-            std::move(textureFrame.TextureData.Data),
-            textureFrame.TextureData.Size,
-            atlasImage.get(),
-            specification.AtlasSize,
-            texturePosition.FrameLeftX,
-            texturePosition.FrameBottomY);
+        if (taskThreadPool != nullptr)
+            taskThreadPool->ParallelFor(batchStart, batchEnd, 1, loadAndCopyFrames);
+        else
+            loadAndCopyFrames(batchStart, batchEnd);
+
+        if (firstException)
+            std::rethrow_exception(firstException);
+    }
+
+    // Build metadata
+    std::vector<TextureAtlasFrameMetadata<TextureGroups>> frameMetadata;
+    frameMetadata.reserve(frameCount);
+    for (size_t f = 0; f < frameCount; ++f)
+    {
+        auto const & texturePosition = specification.TexturePositions[f];
+        ImageSize const & frameSize = loadedFrameSizes[f];
+        TextureFrameMetadata<TextureGroups> const & loadedMetadata = *loadedFrameMetadata[f];
 
         // Calculate frame dimensions in texture space - the whole thing, ignoring dx/dy
-        float const textureSpaceFrameWidth = static_cast<float>(textureFrame.TextureData.Size.width) / static_cast<float>(specification.AtlasSize.width);
-        float const textureSpaceFrameHeight = static_cast<float>(textureFrame.TextureData.Size.height) / static_cast<float>(specification.AtlasSize.height);
+        float const textureSpaceFrameWidth = static_cast<float>(frameSize.width) / static_cast<float>(specification.AtlasSize.width);
+        float const textureSpaceFrameHeight = static_cast<float>(frameSize.height) / static_cast<float>(specification.AtlasSize.height);
 
         // Store texture metadata
         frameMetadata.emplace_back(
@@ -662,15 +791,15 @@ TextureAtlas<TextureGroups> TextureAtlasBuilder<TextureGroups>::BuildAtlas(
                 dy + static_cast<float>(texturePosition.FrameBottomY) / static_cast<float>(specification.AtlasSize.height)),
             // Anchor center
             vec2f(
-                dx + static_cast<float>(texturePosition.FrameLeftX + textureFrame.Metadata.AnchorCenter.x) / static_cast<float>(specification.AtlasSize.width),
-                dy + static_cast<float>(texturePosition.FrameBottomY + textureFrame.Metadata.AnchorCenter.y) / static_cast<float>(specification.AtlasSize.height)),
+                dx + static_cast<float>(texturePosition.FrameLeftX + loadedMetadata.AnchorCenter.x) / static_cast<float>(specification.AtlasSize.width),
+                dy + static_cast<float>(texturePosition.FrameBottomY + loadedMetadata.AnchorCenter.y) / static_cast<float>(specification.AtlasSize.height)),
             // Top-right
             vec2f(
-                static_cast<float>(texturePosition.FrameLeftX + textureFrame.TextureData.Size.width) / static_cast<float>(specification.AtlasSize.width) - dx,
-                static_cast<float>(texturePosition.FrameBottomY + textureFrame.TextureData.Size.height) / static_cast<float>(specification.AtlasSize.height) - dy),
+                static_cast<float>(texturePosition.FrameLeftX + frameSize.width) / static_cast<float>(specification.AtlasSize.width) - dx,
+                static_cast<float>(texturePosition.FrameBottomY + frameSize.height) / static_cast<float>(specification.AtlasSize.height) - dy),
             texturePosition.FrameLeftX,
             texturePosition.FrameBottomY,
-            textureFrame.Metadata);
+            loadedMetadata);
     }
 
     RgbaImageData atlasImageData(
@@ -680,7 +809,7 @@ TextureAtlas<TextureGroups> TextureAtlasBuilder<TextureGroups>::BuildAtlas(
     // Pre-multiply alpha, if requested
     if (!!(options & AtlasOptions::AlphaPremultiply))
     {
-        ImageTools::AlphaPreMultiply(atlasImageData);
+        ImageTools::AlphaPreMultiply(atlasImageData, taskThreadPool);
     }
 
     progressCallback(1.0f, ProgressMessageType::None);
@@ -716,4 +845,190 @@ void TextureAtlasBuilder<TextureGroups>::CopyImage(
     }
 }
 
+////////////////////////////////////////////////////////////////////////////////
+// Cache
+////////////////////////////////////////////////////////////////////////////////
+
+template <typename TextureDatabaseTraits>
+std::string TextureAtlasCache<TextureDatabaseTraits>::CalculateCacheKey(
+    TextureDatabase<TextureDatabaseTraits> const & database,
+    AtlasOptions options)
+{
+    // FNV-1a over everything that makes up the atlas
+    std::uint64_t hash = 14695981039346656037ull;
+    auto const hashBytes = [&hash](void const * bytes, size_t size)
+    {
+        for (size_t b = 0; b < size; ++b)
+        {
+            hash ^= static_cast<std::uint64_t>(static_cast<unsigned char const *>(bytes)[b]);
+            hash *= 1099511628211ull;
+        }
+    };
+
+    hashBytes(&CacheVersion, sizeof(CacheVersion));
+
+    auto const optionsValue = static_cast<std::uint32_t>(options);
+    hashBytes(&optionsValue, sizeof(optionsValue));
+
+    for (auto const & group : database.GetGroups())
+    {
+        for (auto const & frameSpecification : group.GetFrameSpecifications())
+        {
+            std::string const filePath = frameSpecification.FilePath.string();
+            hashBytes(filePath.data(), filePath.size());
+
+            std::uint64_t const fileSize = static_cast<std::uint64_t>(std::filesystem::file_size(frameSpecification.FilePath));
+            hashBytes(&fileSize, sizeof(fileSize));
+
+            auto const lastWriteTime = std::filesystem::last_write_time(frameSpecification.FilePath).time_since_epoch().count();
+            hashBytes(&lastWriteTime, sizeof(lastWriteTime));
+
+            // Frame metadata (e.g. anchors) comes from the database's json rather than from the image
+            picojson::object frameMetadataJson;
+            frameSpecification.Metadata.Serialize(frameMetadataJson);
+            std::string const frameMetadata = picojson::value(frameMetadataJson).serialize();
+            hashBytes(frameMetadata.data(), frameMetadata.size());
+        }
+    }
+
+    std::ostringstream ss;
+    ss << std::hex << std::setfill('0') << std::setw(16) << hash;
+    return ss.str();
+}
+
+template <typename TextureDatabaseTraits>
+std::optional<TextureAtlas<typename TextureDatabaseTraits::TextureGroups>> TextureAtlasCache<TextureDatabaseTraits>::TryLoad(
+    std::string const & cacheKey,
+    std::filesystem::path const & cacheFolderPath)
+{
+    std::filesystem::path const metadataFilePath = cacheFolderPath / MakeMetadataFilename();
+    std::filesystem::path const imageFilePath = cacheFolderPath / MakeImageFilename();
+
+    if (!std::filesystem::exists(metadataFilePath) || !std::filesystem::exists(imageFilePath))
+    {
+        LogMessage("TextureAtlasCache: no cached atlas for ", TextureDatabaseTraits::DatabaseName);
+        return std::nullopt;
+    }
+
+    try
+    {
+        //
+        // Metadata
+        //
+
+        picojson::value const rootJsonValue = Utils::ParseJSONFile(metadataFilePath);
+        if (!rootJsonValue.is<picojson::object>())
+        {
+            throw GameException("Cached atlas metadata json is not an object");
+        }
+
+        picojson::object const & rootJson = rootJsonValue.get<picojson::object>();
+        if (rootJson.at("cache_key").get<std::string>() != cacheKey)
+        {
+            LogMessage("TextureAtlasCache: cached atlas for ", TextureDatabaseTraits::DatabaseName, " is stale");
+            return std::nullopt;
+        }
+
+        TextureAtlasMetadata<TextureGroups> metadata = TextureAtlasMetadata<TextureGroups>::Deserialize(
+            rootJson.at("metadata").get<picojson::object>());
+
+        //
+        // Image
+        //
+
+        std::ifstream imageFile(imageFilePath, std::ios::in | std::ios::binary);
+        if (!imageFile)
+        {
+            throw GameException("Cannot open cached atlas image");
+        }
+
+        std::uint32_t version;
+        std::int32_t width;
+        std::int32_t height;
+        imageFile.read(reinterpret_cast<char *>(&version), sizeof(version));
+        imageFile.read(reinterpret_cast<char *>(&width), sizeof(width));
+        imageFile.read(reinterpret_cast<char *>(&height), sizeof(height));
+        if (!imageFile
+            || version != CacheVersion
+            || width != metadata.GetSize().width
+            || height != metadata.GetSize().height)
+        {
+            throw GameException("Cached atlas image header does not match metadata");
+        }
+
+        RgbaImageData atlasData(ImageSize(width, height));
+        imageFile.read(reinterpret_cast<char *>(atlasData.Data.get()), atlasData.Size.GetLinearSize() * sizeof(rgbaColor));
+        if (!imageFile)
+        {
+            throw GameException("Cached atlas image is truncated");
+        }
+
+        LogMessage("TextureAtlasCache: loaded cached atlas for ", TextureDatabaseTraits::DatabaseName);
+
+        return TextureAtlas<TextureGroups>(std::move(metadata), std::move(atlasData));
+    }
+    catch (std::exception const & ex)
+    {
+        LogMessage("TextureAtlasCache: error loading cached atlas for ", TextureDatabaseTraits::DatabaseName, ": ", ex.what());
+        return std::nullopt;
+    }
+}
+
+template <typename TextureDatabaseTraits>
+void TextureAtlasCache<TextureDatabaseTraits>::TryStore(
+    TextureAtlas<TextureGroups> const & textureAtlas,
+    std::string const & cacheKey,
+    std::filesystem::path const & cacheFolderPath)
+{
+    try
+    {
+        std::filesystem::create_directories(cacheFolderPath);
+
+        //
+        // Image - first, as the metadata is what makes the cached atlas valid
+        //
+
+        {
+            std::ofstream imageFile(cacheFolderPath / MakeImageFilename(), std::ios::out | std::ios::binary | std::ios::trunc);
+            if (!imageFile)
+            {
+                throw GameException("Cannot create cached atlas image");
+            }
+
+            std::uint32_t const version = CacheVersion;
+            std::int32_t const width = textureAtlas.AtlasData.Size.width;
+            std::int32_t const height = textureAtlas.AtlasData.Size.height;
+            imageFile.write(reinterpret_cast<char const *>(&version), sizeof(version));
+            imageFile.write(reinterpret_cast<char const *>(&width), sizeof(width));
+            imageFile.write(reinterpret_cast<char const *>(&height), sizeof(height));
+            imageFile.write(
+                reinterpret_cast<char const *>(textureAtlas.AtlasData.Data.get()),
+                textureAtlas.AtlasData.Size.GetLinearSize() * sizeof(rgbaColor));
+            if (!imageFile)
+            {
+                throw GameException("Cannot write cached atlas image");
+            }
+        }
+
+        //
+        // Metadata
+        //
+
+        picojson::object metadataJson;
+        textureAtlas.Metadata.Serialize(metadataJson);
+
+        picojson::object rootJson;
+        rootJson["cache_key"] = picojson::value(cacheKey);
+        rootJson["metadata"] = picojson::value(metadataJson);
+
+        Utils::SaveJSONFile(picojson::value(rootJson), cacheFolderPath / MakeMetadataFilename());
+
+        LogMessage("TextureAtlasCache: stored atlas for ", TextureDatabaseTraits::DatabaseName);
+    }
+    catch (std::exception const & ex)
+    {
+        LogMessage("TextureAtlasCache: error storing atlas for ", TextureDatabaseTraits::DatabaseName, ": ", ex.what());
+    }
+}
+
 }
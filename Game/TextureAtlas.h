@@ -10,15 +10,19 @@
 #include <GameCore/EnumFlags.h>
 #include <GameCore/ImageData.h>
 #include <GameCore/ProgressCallback.h>
+#include <GameCore/TaskThreadPool.h>
 #include <GameCore/Vectors.h>
 
 #include <picojson.h>
 
 #include <algorithm>
 #include <cassert>
+#include <cstdint>
 #include <filesystem>
 #include <memory>
 #include <numeric>
+#include <optional>
+#include <string>
 #include <type_traits>
 #include <unordered_map>
 #include <vector>
@@ -211,7 +215,8 @@ public:
     static TextureAtlas<TextureGroups> BuildRegularAtlas(
         TextureDatabase<TextureDatabaseTraits> const & database,
         AtlasOptions options,
-        ProgressCallback const & progressCallback)
+        ProgressCallback const & progressCallback,
+        TaskThreadPool * taskThreadPool = nullptr)
     {
         static_assert(std::is_same<TextureGroups, typename TextureDatabaseTraits::TextureGroups>::value);
 
@@ -233,17 +238,20 @@ public:
             {
                 return database.GetGroup(frameId.Group).LoadFrame(frameId.FrameIndex);
             },
-            progressCallback);
+            progressCallback,
+            taskThreadPool);
     }
 
     /*
-     * Builds an atlas with the entire content of the specified database.
+     * Builds an atlas with the entire content of the specified database; frames are loaded
+     * in parallel when a thread pool is specified.
      */
     template<typename TextureDatabaseTraits>
     static TextureAtlas<TextureGroups> BuildAtlas(
         TextureDatabase<TextureDatabaseTraits> const & database,
         AtlasOptions options,
-        ProgressCallback const & progressCallback)
+        ProgressCallback const & progressCallback,
+        TaskThreadPool * taskThreadPool = nullptr)
     {
         static_assert(std::is_same<TextureGroups, typename TextureDatabaseTraits::TextureGroups>::value);
 
@@ -265,7 +273,8 @@ public:
             {
                 return database.GetGroup(frameId.Group).LoadFrame(frameId.FrameIndex);
             },
-            progressCallback);
+            progressCallback,
+            taskThreadPool);
     }
 
     /*
@@ -302,7 +311,8 @@ public:
                 assert(false);
                 throw GameException("Cannot find texture frame");
             },
-            [](float, ProgressMessageType) {});
+            [](float, ProgressMessageType) {},
+            nullptr);
     }
 
     /*
@@ -313,7 +323,8 @@ public:
     static TextureAtlas<TextureGroups> BuildMipMappableAtlas(
         TextureDatabase<TextureDatabaseTraits> const & database,
         AtlasOptions options,
-        ProgressCallback const & progressCallback)
+        ProgressCallback const & progressCallback,
+        TaskThreadPool * taskThreadPool = nullptr)
     {
         static_assert(std::is_same<TextureGroups, typename TextureDatabaseTraits::TextureGroups>::value);
 
@@ -335,7 +346,8 @@ public:
             {
                 return database.GetGroup(frameId.Group).LoadFrame(frameId.FrameIndex);
             },
-            progressCallback);
+            progressCallback,
+            taskThreadPool);
     }
 
 public:
@@ -401,6 +413,10 @@ private:
     // Unit-tested
     static AtlasSpecification BuildAtlasSpecification(std::vector<TextureInfo> const & inputTextureInfos);
 
+    static AtlasSpecification PackSkyline(
+        std::vector<TextureInfo> const & sortedTextureInfos,
+        int atlasWidth);
+
     // Unit-tested
     static AtlasSpecification BuildMipMappableAtlasSpecification(std::vector<TextureInfo> const & inputTextureInfos);
 
@@ -410,8 +426,9 @@ private:
     static TextureAtlas<TextureGroups> BuildAtlas(
         AtlasSpecification const & specification,
         AtlasOptions options,
-        std::function<TextureFrame<TextureGroups>(TextureFrameId<TextureGroups> const &)> frameLoader,
-        ProgressCallback const & progressCallback);
+        std::function<TextureFrame<TextureGroups>(TextureFrameId<TextureGroups> const &)> frameLoader, // Invoked concurrently when there's a thread pool
+        ProgressCallback const & progressCallback,
+        TaskThreadPool * taskThreadPool);
 
     static void CopyImage(
         std::unique_ptr<rgbaColor const []> sourceImage,
@@ -444,12 +461,85 @@ private:
     friend class TextureAtlasTests_Placement1_NonMipMappable_Test;
     friend class TextureAtlasTests_RoundsAtlasSize_MipMappable_Test;
     friend class TextureAtlasTests_RegularAtlas_Test;
+    friend class TextureAtlasTests_Packing_NonMipMappable_IdenticalFramesFillAtlas_Test;
+    friend class TextureAtlasTests_Packing_NonMipMappable_MixedFrames_Test;
 
 private:
 
     std::unordered_map<TextureFrameId<TextureGroups>, TextureFrameSpecification<TextureGroups>> mTextureFrameSpecifications;
 };
 
+/*
+ * An on-disk cache of the atlases built out of entire texture databases, so that
+ * we don't have to decode and pack all of the database's images at each launch.
+ *
+ * Each cached atlas is stored as its metadata and its raw image, and is keyed by
+ * the options and by the names, sizes, and timestamps of the database's files; a
+ * cached atlas whose key doesn't match is simply rebuilt and stored again.
+ */
+template <typename TextureDatabaseTraits>
+class TextureAtlasCache
+{
+public:
+
+    using TextureGroups = typename TextureDatabaseTraits::TextureGroups;
+
+    /*
+     * Loads the atlas from the cache if it's up-to-date, otherwise builds it with
+     * the specified builder and stores it in the cache. Failures to access the cache
+     * are not fatal.
+     */
+    template<typename TBuildAtlas>
+    static TextureAtlas<TextureGroups> LoadOrBuild(
+        TextureDatabase<TextureDatabaseTraits> const & database,
+        AtlasOptions options,
+        std::filesystem::path const & cacheFolderPath,
+        TBuildAtlas && buildAtlas)
+    {
+        std::string const cacheKey = CalculateCacheKey(database, options);
+
+        auto cachedAtlas = TryLoad(cacheKey, cacheFolderPath);
+        if (cachedAtlas.has_value())
+        {
+            return std::move(*cachedAtlas);
+        }
+
+        auto textureAtlas = buildAtlas(database, options);
+
+        TryStore(textureAtlas, cacheKey, cacheFolderPath);
+
+        return textureAtlas;
+    }
+
+private:
+
+    // Bump whenever the layout of the cache - or of the atlases - changes
+    static std::uint32_t constexpr CacheVersion = 2;
+
+    static std::string CalculateCacheKey(
+        TextureDatabase<TextureDatabaseTraits> const & database,
+        AtlasOptions options);
+
+    static std::optional<TextureAtlas<TextureGroups>> TryLoad(
+        std::string const & cacheKey,
+        std::filesystem::path const & cacheFolderPath);
+
+    static void TryStore(
+        TextureAtlas<TextureGroups> const & textureAtlas,
+        std::string const & cacheKey,
+        std::filesystem::path const & cacheFolderPath);
+
+    static std::filesystem::path MakeMetadataFilename()
+    {
+        return TextureDatabaseTraits::DatabaseName + ".atlas-cache.json";
+    }
+
+    static std::filesystem::path MakeImageFilename()
+    {
+        return TextureDatabaseTraits::DatabaseName + ".atlas-cache.bin";
+    }
+};
+
 }
 
 template <> struct is_flag<Render::AtlasOptions> : std::true_type {};
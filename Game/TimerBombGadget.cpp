@@ -42,6 +42,30 @@ TimerBombGadget::TimerBombGadget(
         false);
 }
 
+TimerBombGadget::TimerBombGadget(
+    TimerBombGadget const & other,
+    ShipFragmentMap const & fragmentMap,
+    IShipPhysicsHandler & shipPhysicsHandler,
+    Points & shipPoints,
+    Springs & shipSprings)
+    : Gadget(
+        other,
+        fragmentMap,
+        shipPhysicsHandler,
+        shipPoints,
+        shipSprings)
+    , mState(other.mState)
+    , mNextStateTransitionTimePoint(other.mNextStateTransitionTimePoint)
+    , mFuseFlameFrameIndex(other.mFuseFlameFrameIndex)
+    , mFuseStepCounter(other.mFuseStepCounter)
+    , mDefuseStepCounter(other.mDefuseStepCounter)
+    , mDetonationLeadInShapeFrameCounter(other.mDetonationLeadInShapeFrameCounter)
+    , mExplosionFadeoutCounter(other.mExplosionFadeoutCounter)
+    , mExplosionPosition(other.mExplosionPosition)
+    , mExplosionPlaneId(other.mExplosionPlaneId)
+{
+}
+
 bool TimerBombGadget::Update(
     GameWallClock::time_point currentWallClockTime,
     float currentSimulationTime,
@@ -16,6 +16,7 @@ void Triangles::Add(
     ElementIndex subSpringCIndex,
     std::optional<ElementIndex> coveredTraverseSpringIndex)
 {
+    mLiveTriangles.Set(static_cast<ElementIndex>(mIsDeletedBuffer.GetCurrentPopulatedSize()));
     mIsDeletedBuffer.emplace_back(false);
 
     mEndpointsBuffer.emplace_back(pointAIndex, pointBIndex, pointCIndex);
@@ -31,6 +32,50 @@ void Triangles::Add(
     mCoveredSpringsBuffer.emplace_back(coveredSprings);
 }
 
+void Triangles::AddFragment(
+    Triangles const & other,
+    ShipFragmentMap const & fragmentMap)
+{
+    assert(mIsDeletedBuffer.GetCurrentPopulatedSize() == 0);
+
+    auto const & pointMap = fragmentMap.PointIndices;
+    auto const & springMap = fragmentMap.SpringIndices;
+
+    assert(fragmentMap.TriangleIndices.GetNewElementCount() == GetElementCount());
+
+    for (auto const otherTriangleIndex : fragmentMap.TriangleIndices.NewToOld)
+    {
+        if (!other.mIsDeletedBuffer[otherTriangleIndex])
+            mLiveTriangles.Set(static_cast<ElementIndex>(mIsDeletedBuffer.GetCurrentPopulatedSize()));
+        mIsDeletedBuffer.emplace_back(other.mIsDeletedBuffer[otherTriangleIndex]);
+
+        auto const & otherPointIndices = other.mEndpointsBuffer[otherTriangleIndex].PointIndices;
+        mEndpointsBuffer.emplace_back(
+            pointMap.OldToNew[otherPointIndices[0]],
+            pointMap.OldToNew[otherPointIndices[1]],
+            pointMap.OldToNew[otherPointIndices[2]]);
+
+        // The sub springs of a triangle join its endpoints, hence they are all in the fragment
+        auto const & otherSubSpringIndices = other.mSubSpringsBuffer[otherTriangleIndex].SpringIndices;
+        assert(springMap.Contains(otherSubSpringIndices[0]) && springMap.Contains(otherSubSpringIndices[1]) && springMap.Contains(otherSubSpringIndices[2]));
+        mSubSpringsBuffer.emplace_back(
+            springMap.OldToNew[otherSubSpringIndices[0]],
+            springMap.OldToNew[otherSubSpringIndices[1]],
+            springMap.OldToNew[otherSubSpringIndices[2]]);
+
+        // A covered traverse spring might reach outside of the fragment, in which case
+        // it has been left behind
+        CoveredSpringsVector coveredSprings;
+        for (auto const otherCoveredSpringIndex : other.mCoveredSpringsBuffer[otherTriangleIndex])
+        {
+            if (springMap.Contains(otherCoveredSpringIndex))
+                coveredSprings.push_back(springMap.OldToNew[otherCoveredSpringIndex]);
+        }
+
+        mCoveredSpringsBuffer.emplace_back(coveredSprings);
+    }
+}
+
 void Triangles::Destroy(ElementIndex triangleElementIndex)
 {
     assert(triangleElementIndex < mElementCount);
@@ -42,6 +87,7 @@ void Triangles::Destroy(ElementIndex triangleElementIndex)
 
     // Flag ourselves as deleted
     mIsDeletedBuffer[triangleElementIndex] = true;
+    mLiveTriangles.Clear(triangleElementIndex);
 }
 
 void Triangles::Restore(ElementIndex triangleElementIndex)
@@ -51,10 +97,67 @@ void Triangles::Restore(ElementIndex triangleElementIndex)
 
     // Clear ourselves as not deleted
     mIsDeletedBuffer[triangleElementIndex] = false;
+    mLiveTriangles.Set(triangleElementIndex);
 
     // Invoke restore handler
     assert(nullptr != mShipPhysicsHandler);
     mShipPhysicsHandler->HandleTriangleRestore(triangleElementIndex);
 }
 
+void Triangles::RemapSpringIndices(std::vector<ElementIndex> const & oldToNewSpringIndices)
+{
+    for (ElementIndex t : *this)
+    {
+        for (auto & springIndex : mSubSpringsBuffer[t].SpringIndices)
+        {
+            springIndex = oldToNewSpringIndices[springIndex];
+        }
+
+        for (auto & springIndex : mCoveredSpringsBuffer[t])
+        {
+            springIndex = oldToNewSpringIndices[springIndex];
+        }
+    }
+}
+
+size_t Triangles::GetByteSize() const
+{
+    return
+        mIsDeletedBuffer.GetByteSize()
+        + mLiveTriangles.GetByteSize()
+        + mEndpointsBuffer.GetByteSize()
+        + mSubSpringsBuffer.GetByteSize()
+        + mCoveredSpringsBuffer.GetByteSize();
+}
+
+static std::uint32_t constexpr StateSectionTag = 0x53495254; // TRIS
+
+void Triangles::SaveState(StateSnapshotWriter & writer) const
+{
+    writer.BeginSection(StateSectionTag);
+
+    ArchiveState(*this, writer);
+}
+
+void Triangles::LoadState(StateSnapshotReader & reader)
+{
+    reader.BeginSection(StateSectionTag);
+
+    ArchiveState(*this, reader);
+}
+
+template<typename TSelf, typename TArchive>
+void Triangles::ArchiveState(
+    TSelf & self,
+    TArchive & archive)
+{
+    // Sub-springs and covered springs are archived too, as they follow
+    // the renumbering of springs
+    archive.Archive(self.mIsDeletedBuffer);
+    archive.Archive(self.mLiveTriangles);
+    archive.Archive(self.mEndpointsBuffer);
+    archive.Archive(self.mSubSpringsBuffer);
+    archive.Archive(self.mCoveredSpringsBuffer);
+}
+
 }
\ No newline at end of file
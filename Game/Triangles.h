@@ -9,14 +9,17 @@
 #include "RenderContext.h"
 
 #include <GameCore/Buffer.h>
+#include <GameCore/ElementBitmap.h>
 #include <GameCore/ElementContainer.h>
 #include <GameCore/FixedSizeVector.h>
+#include <GameCore/StateSnapshot.h>
 
 #include <algorithm>
 #include <array>
 #include <cassert>
 #include <functional>
 #include <optional>
+#include <vector>
 
 namespace Physics
 {
@@ -70,6 +73,7 @@ public:
         // Buffers
         //////////////////////////////////
         , mIsDeletedBuffer(mBufferElementCount, mElementCount, true)
+        , mLiveTriangles(mElementCount)
         // Endpoints
         , mEndpointsBuffer(mBufferElementCount, mElementCount, Endpoints(NoneElementIndex, NoneElementIndex, NoneElementIndex))
         // Sub springs
@@ -99,10 +103,25 @@ public:
         ElementIndex subSpringCIndex,
         std::optional<ElementIndex> coveredTraverseSpringIndex);
 
+    /*
+     * Populates this container - which must be empty - with the triangles of a fragment
+     * of another ship, in their current state; point and spring indices are remapped
+     * to the fragment's.
+     */
+    void AddFragment(
+        Triangles const & other,
+        ShipFragmentMap const & fragmentMap);
+
     void Destroy(ElementIndex triangleElementIndex);
 
     void Restore(ElementIndex triangleElementIndex);
 
+    /*
+     * Replaces the indices of all sub-springs and covered springs after springs
+     * have been permuted.
+     */
+    void RemapSpringIndices(std::vector<ElementIndex> const & oldToNewSpringIndices);
+
     //
     // Render
     //
@@ -124,9 +143,8 @@ public:
     {
         auto & shipRenderContext = renderContext.GetShipRenderContext(shipId);
 
-        for (ElementIndex i : *this)
-        {
-            if (!mIsDeletedBuffer[i])
+        mLiveTriangles.ForEachSet(
+            [&](ElementIndex i)
             {
                 // Get the plane of this triangle (== plane of point A)
                 PlaneId planeId = points.GetPlaneId(GetPointAIndex(i));
@@ -135,16 +153,27 @@ public:
                 assert(planeId < planeIndices.size());
                 shipRenderContext.UploadElementTriangle(
                     planeIndices[planeId],
+                    i,
                     GetPointAIndex(i),
                     GetPointBIndex(i),
                     GetPointCIndex(i));
 
                 // Remember that the next triangle for this plane goes to the next element
                 planeIndices[planeId]++;
-            }
-        }
+            });
     }
 
+    /*
+     * Gets the number of bytes occupied by all of our buffers; for diagnostics only.
+     */
+    size_t GetByteSize() const;
+
+    /*
+     * Saves and restores the whole simulation state of the triangles.
+     */
+    void SaveState(StateSnapshotWriter & writer) const;
+    void LoadState(StateSnapshotReader & reader);
+
 public:
 
     //
@@ -156,6 +185,14 @@ public:
         return mIsDeletedBuffer[triangleElementIndex];
     }
 
+    /*
+     * The non-deleted triangles, for iterating them without visiting deleted ones.
+     */
+    inline ElementBitmap const & GetLiveTriangles() const
+    {
+        return mLiveTriangles;
+    }
+
     //
     // Endpoints
     //
@@ -223,6 +260,13 @@ public:
         return mCoveredSpringsBuffer[triangleElementIndex];
     }
 
+private:
+
+    template<typename TSelf, typename TArchive>
+    static void ArchiveState(
+        TSelf & self,
+        TArchive & archive);
+
 private:
 
     //////////////////////////////////////////////////////////
@@ -231,6 +275,7 @@ private:
 
     // Deletion
     Buffer<bool> mIsDeletedBuffer;
+    ElementBitmap mLiveTriangles; // Complement of mIsDeletedBuffer
 
     // Endpoints
     Buffer<Endpoints> mEndpointsBuffer;
@@ -134,4 +134,110 @@ void UploadedTextureManager<TextureGroups>::UploadMipmappedGroup(
     }
 }
 
-}
\ No newline at end of file
+template <typename TextureGroups>
+GLuint UploadedTextureManager<TextureGroups>::EnsureMipmappedFrameResident(
+    TextureFrameSpecification<TextureGroups> const & frameSpecification,
+    GLint internalFormat,
+    GLint minFilter)
+{
+    size_t const group = static_cast<size_t>(frameSpecification.Metadata.FrameId.Group);
+    TextureFrameIndex const frameIndex = frameSpecification.Metadata.FrameId.FrameIndex;
+
+    // Make sure we have room for this frame
+    if (mResidentFrameData.size() < group + 1)
+    {
+        mResidentFrameData.resize(group + 1);
+        mMostRecentlyUsedResidentFrames.resize(group + 1);
+    }
+
+    if (mResidentFrameData[group].size() < static_cast<size_t>(frameIndex) + 1)
+        mResidentFrameData[group].resize(static_cast<size_t>(frameIndex) + 1);
+
+    ResidentFrameData & frameData = mResidentFrameData[group][frameIndex];
+
+    // This frame is now the most recently used one
+    frameData.LastUseSequence = ++mCurrentUseSequence;
+    mMostRecentlyUsedResidentFrames[group] = frameIndex;
+
+    if (!!frameData.OpenGLHandle)
+    {
+        // Already resident
+        return *frameData.OpenGLHandle;
+    }
+
+    //
+    // Upload frame, making room for it first
+    //
+
+    size_t const byteSize = CalculateMipmappedByteSize(frameSpecification.Metadata.Size);
+
+    EvictResidentFrames(byteSize);
+
+    // Load frame
+    auto frame = frameSpecification.LoadFrame();
+
+    // Create OpenGL handle
+    GLuint openGLHandle;
+    glGenTextures(1, &openGLHandle);
+    frameData.OpenGLHandle = openGLHandle;
+
+    // Bind texture
+    glBindTexture(GL_TEXTURE_2D, openGLHandle);
+    CheckOpenGLError();
+
+    // Upload texture
+    GameOpenGL::UploadMipmappedTexture(
+        std::move(frame.TextureData),
+        internalFormat);
+
+    // Set repeat mode
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
+    CheckOpenGLError();
+
+    // Set texture filtering parameters
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, minFilter);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    CheckOpenGLError();
+
+    frameData.ByteSize = byteSize;
+    mResidentFramesByteSize += byteSize;
+
+    return openGLHandle;
+}
+
+template <typename TextureGroups>
+void UploadedTextureManager<TextureGroups>::EvictResidentFrames(size_t requiredByteSize)
+{
+    while (mResidentFramesByteSize + requiredByteSize > mResidentFramesByteSizeBudget)
+    {
+        // Find the least recently used frame that is not its group's most recently used one
+        ResidentFrameData * lruFrameData = nullptr;
+        for (size_t g = 0; g < mResidentFrameData.size(); ++g)
+        {
+            for (size_t f = 0; f < mResidentFrameData[g].size(); ++f)
+            {
+                ResidentFrameData & frameData = mResidentFrameData[g][f];
+                if (!!frameData.OpenGLHandle
+                    && mMostRecentlyUsedResidentFrames[g] != static_cast<TextureFrameIndex>(f)
+                    && (lruFrameData == nullptr || frameData.LastUseSequence < lruFrameData->LastUseSequence))
+                {
+                    lruFrameData = &frameData;
+                }
+            }
+        }
+
+        if (lruFrameData == nullptr)
+        {
+            // Nothing else may be evicted
+            break;
+        }
+
+        assert(mResidentFramesByteSize >= lruFrameData->ByteSize);
+        mResidentFramesByteSize -= lruFrameData->ByteSize;
+        lruFrameData->ByteSize = 0;
+        lruFrameData->OpenGLHandle.reset();
+    }
+}
+
+}
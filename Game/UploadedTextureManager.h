@@ -14,6 +14,8 @@
 #include <GameCore/Vectors.h>
 
 #include <cassert>
+#include <cstdint>
+#include <limits>
 #include <optional>
 #include <vector>
 
@@ -21,12 +23,25 @@ namespace Render {
 
 /*
  * This class maintains metadata about a number of textures uploaded to the GPU.
+ *
+ * Besides groups uploaded in their entirety, the manager may keep frames resident on demand:
+ * such frames are uploaded the first time they're needed, and are kept resident within a
+ * budget by evicting the least recently used ones.
  */
 template <typename TextureGroups>
 class UploadedTextureManager
 {
 public:
 
+    explicit UploadedTextureManager(size_t residentFramesByteSizeBudget = std::numeric_limits<size_t>::max())
+        : mFrameData()
+        , mResidentFrameData()
+        , mMostRecentlyUsedResidentFrames()
+        , mResidentFramesByteSize(0)
+        , mResidentFramesByteSizeBudget(residentFramesByteSizeBudget)
+        , mCurrentUseSequence(0)
+    {}
+
     // Assumption: all previous frames have been uploaded already
     void UploadNextFrame(
         TextureGroup<TextureGroups> const & group,
@@ -86,6 +101,36 @@ public:
         return *(mFrameData[static_cast<size_t>(group)][frameIndex].OpenGLHandle);
     }
 
+    /*
+     * Makes the specified frame resident - uploading it together with its mipmaps if it's not -
+     * and returns its OpenGL handle, which is valid until the next frame of any group is made
+     * resident.
+     *
+     * The most recently used frame of each group is never evicted, as it's the one being
+     * rendered; hence the budget may be exceeded when it can only fit fewer frames than there
+     * are groups.
+     */
+    GLuint EnsureMipmappedFrameResident(
+        TextureFrameSpecification<TextureGroups> const & frameSpecification,
+        GLint internalFormat,
+        GLint minFilter);
+
+    size_t GetResidentFramesByteSize() const
+    {
+        return mResidentFramesByteSize;
+    }
+
+private:
+
+    // Evicts least recently used frames until the specified number of bytes fits within the budget
+    void EvictResidentFrames(size_t requiredByteSize);
+
+    static size_t CalculateMipmappedByteSize(ImageSize const & size)
+    {
+        // Four bytes per texel, as drivers usually pad RGB; mipmaps add a third
+        return static_cast<size_t>(size.width) * static_cast<size_t>(size.height) * 4 * 4 / 3;
+    }
+
 private:
 
     struct FrameData
@@ -102,6 +147,30 @@ private:
     };
 
     std::vector<std::vector<FrameData>> mFrameData;
+
+    //
+    // Frames resident on demand
+    //
+
+    struct ResidentFrameData
+    {
+        GameOpenGLTexture OpenGLHandle; // Empty when not resident
+        size_t ByteSize;
+        std::uint64_t LastUseSequence;
+
+        ResidentFrameData()
+            : OpenGLHandle()
+            , ByteSize(0)
+            , LastUseSequence(0)
+        {}
+    };
+
+    std::vector<std::vector<ResidentFrameData>> mResidentFrameData; // Group -> frame index
+    std::vector<std::optional<TextureFrameIndex>> mMostRecentlyUsedResidentFrames; // Group -> frame index
+
+    size_t mResidentFramesByteSize;
+    size_t const mResidentFramesByteSizeBudget;
+    std::uint64_t mCurrentUseSequence;
 };
 
 }
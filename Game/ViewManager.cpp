@@ -7,10 +7,16 @@
 
 #include <GameCore/GameMath.h>
 
+#include <algorithm>
 #include <cassert>
+#include <cmath>
 
 float constexpr NdcFractionZoomTarget = 0.7f; // Fraction of the [0, 2] NDC space that needs to be occupied by AABB
 float constexpr MaxZoom = 2.0f; // Arbitrary max zoom, to avoid getting to atomic scale with e.g. Thanos
+float constexpr AllShipsAABBSmoothingFactor = 0.3f; // Fraction of the distance to the new AABB covered at each frame
+float constexpr SteadyAABBTolerance = 0.01f; // Fraction of the AABB's size within which the AABB is considered steady
+float constexpr ConvergedPanNdcTolerance = 0.001f; // NDC pan offset below which the auto-focus pan is considered converged
+int constexpr SteadyAutoFocusFramePeriod = 8; // Frames between auto-focus calculations while the camera is steady
 
 ViewManager::ViewManager(
     Render::RenderContext & renderContext,
@@ -116,11 +122,11 @@ void ViewManager::OnViewModelUpdated()
     mCameraWorldPositionParameterSmoother->ReClamp();
 }
 
-void ViewManager::OnNewShip(Geometry::AABBSet const & allAABBs)
+void ViewManager::OnNewShip(std::optional<Geometry::AABB> const & allShipsAABB)
 {
     if (mDoAutoFocusOnShipLoad)
     {
-        FocusOnShip(allAABBs);
+        FocusOnShip(allShipsAABB);
     }
 }
 
@@ -170,13 +176,13 @@ void ViewManager::AdjustZoom(float amount)
     }
 }
 
-void ViewManager::ResetView(Geometry::AABBSet const & allAABBs)
+void ViewManager::ResetView(std::optional<Geometry::AABB> const & allShipsAABB)
 {
     // When continuous auto-focus is off, "view reset" focuses on ship;
     // When continuous auto-focus is on, "view reset" zeroes-out user offsets
     if (!mAutoFocus.has_value())
     {
-        InternalFocusOnShip(allAABBs);
+        InternalFocusOnShip(allShipsAABB);
     }
     else
     {
@@ -184,11 +190,11 @@ void ViewManager::ResetView(Geometry::AABBSet const & allAABBs)
     }
 }
 
-void ViewManager::FocusOnShip(Geometry::AABBSet const & allAABBs)
+void ViewManager::FocusOnShip(std::optional<Geometry::AABB> const & allShipsAABB)
 {
     if (!mAutoFocus.has_value())
     {
-        InternalFocusOnShip(allAABBs);
+        InternalFocusOnShip(allShipsAABB);
     }
     else
     {
@@ -196,13 +202,63 @@ void ViewManager::FocusOnShip(Geometry::AABBSet const & allAABBs)
     }
 }
 
-void ViewManager::Update(Geometry::AABBSet const & allAABBs)
+void ViewManager::Update(std::optional<Geometry::AABB> const & allShipsAABB)
 {
     if (mAutoFocus.has_value())
     {
-        auto const unionAABB = allAABBs.MakeUnion();
-        if (unionAABB.has_value())
+        //
+        // Smooth the AABB
+        //
+
+        if (!allShipsAABB.has_value())
+        {
+            mAutoFocus->SmoothedAllShipsAABB.reset();
+        }
+        else if (!mAutoFocus->SmoothedAllShipsAABB.has_value())
+        {
+            mAutoFocus->SmoothedAllShipsAABB = *allShipsAABB;
+            mAutoFocus->IsAutoFocusPanConverged = false;
+        }
+        else
+        {
+            auto & smoothedAABB = *(mAutoFocus->SmoothedAllShipsAABB);
+            smoothedAABB.TopRight += (allShipsAABB->TopRight - smoothedAABB.TopRight) * AllShipsAABBSmoothingFactor;
+            smoothedAABB.BottomLeft += (allShipsAABB->BottomLeft - smoothedAABB.BottomLeft) * AllShipsAABBSmoothingFactor;
+        }
+
+        //
+        // Decide whether to recalculate auto-focus: always while the AABB moves
+        // or the pan converges, and at a lower rate while the camera is steady
+        //
+
+        bool doCalculateAutoFocus = false;
+        if (mAutoFocus->SmoothedAllShipsAABB.has_value())
+        {
+            auto const & smoothedAABB = *(mAutoFocus->SmoothedAllShipsAABB);
+            auto const & autoFocusAABB = mAutoFocus->AutoFocusAABB;
+
+            float const tolerance = SteadyAABBTolerance * std::max(autoFocusAABB.GetWidth(), autoFocusAABB.GetHeight());
+            bool const isAABBSteady =
+                std::abs(smoothedAABB.TopRight.x - autoFocusAABB.TopRight.x) <= tolerance
+                && std::abs(smoothedAABB.TopRight.y - autoFocusAABB.TopRight.y) <= tolerance
+                && std::abs(smoothedAABB.BottomLeft.x - autoFocusAABB.BottomLeft.x) <= tolerance
+                && std::abs(smoothedAABB.BottomLeft.y - autoFocusAABB.BottomLeft.y) <= tolerance;
+
+            ++(mAutoFocus->FramesSinceAutoFocusCalculation);
+
+            doCalculateAutoFocus =
+                !isAABBSteady
+                || !mAutoFocus->IsAutoFocusPanConverged
+                || mAutoFocus->FramesSinceAutoFocusCalculation >= SteadyAutoFocusFramePeriod;
+        }
+
+        if (doCalculateAutoFocus)
         {
+            auto const & unionAABB = mAutoFocus->SmoothedAllShipsAABB;
+
+            mAutoFocus->AutoFocusAABB = *unionAABB;
+            mAutoFocus->FramesSinceAutoFocusCalculation = 0;
+
             //
             // Auto-focus algorithm:
             // - Zoom:
@@ -231,11 +287,17 @@ void ViewManager::Update(Geometry::AABBSet const & allAABBs)
             vec2f const aabbCenterNdc = mRenderContext.WorldToNdc(unionAABB->CalculateCenter(), mAutoFocus->CurrentAutoFocusZoom, mAutoFocus->CurrentAutoFocusCameraWorldPosition);
             vec2f const newAutoFocusCameraPositionNdcOffset = aabbCenterNdc / 2.0f;
 
+            vec2f const compressedAutoFocusCameraPositionNdcOffset = vec2f(
+                newAutoFocusCameraPositionNdcOffset.x * SmoothStep(0.04f, 0.1f, std::abs(newAutoFocusCameraPositionNdcOffset.x)),    // Compress X displacement to reduce small oscillations
+                newAutoFocusCameraPositionNdcOffset.y * SmoothStep(0.04f, 0.4f, std::abs(newAutoFocusCameraPositionNdcOffset.y)));   // Compress Y displacement to reduce effect of waves
+
+            mAutoFocus->IsAutoFocusPanConverged =
+                std::abs(compressedAutoFocusCameraPositionNdcOffset.x) <= ConvergedPanNdcTolerance
+                && std::abs(compressedAutoFocusCameraPositionNdcOffset.y) <= ConvergedPanNdcTolerance;
+
             // Convert back into world offset
             vec2f const newAutoFocusCameraWorldPositionOffset = mRenderContext.NdcOffsetToWorldOffset(
-                vec2f(
-                    newAutoFocusCameraPositionNdcOffset.x * SmoothStep(0.04f, 0.1f, std::abs(newAutoFocusCameraPositionNdcOffset.x)),    // Compress X displacement to reduce small oscillations
-                    newAutoFocusCameraPositionNdcOffset.y * SmoothStep(0.04f, 0.4f, std::abs(newAutoFocusCameraPositionNdcOffset.y))),   // Compress Y displacement to reduce effect of waves
+                compressedAutoFocusCameraPositionNdcOffset,
                 mAutoFocus->CurrentAutoFocusZoom);
 
             mAutoFocus->CurrentAutoFocusCameraWorldPosition = mAutoFocus->CurrentAutoFocusCameraWorldPosition + newAutoFocusCameraWorldPositionOffset;
@@ -331,17 +393,16 @@ float ViewManager::CalculateParameterSmootherConvergenceFactor(
     }
 }
 
-void ViewManager::InternalFocusOnShip(Geometry::AABBSet const & allAABBs)
+void ViewManager::InternalFocusOnShip(std::optional<Geometry::AABB> const & allShipsAABB)
 {
-    auto const unionAABB = allAABBs.MakeUnion();
-    if (unionAABB.has_value())
+    if (allShipsAABB.has_value())
     {
         // Zoom
-        float const newAutoFocusZoom = InternalCalculateZoom(*unionAABB);
+        float const newAutoFocusZoom = InternalCalculateZoom(*allShipsAABB);
         mZoomParameterSmoother->SetValue(newAutoFocusZoom);
 
         // Pan
-        vec2f const newWorldCenter = unionAABB->CalculateCenter();
+        vec2f const newWorldCenter = allShipsAABB->CalculateCenter();
         mCameraWorldPositionParameterSmoother->SetValue(newWorldCenter);
     }
 }
@@ -8,7 +8,7 @@
 #include "NotificationLayer.h"
 #include "RenderContext.h"
 
-#include <GameCore/AABBSet.h>
+#include <GameCore/AABB.h>
 #include <GameCore/ParameterSmoother.h>
 #include <GameCore/Vectors.h>
 
@@ -35,14 +35,14 @@ public:
     void SetDoContinuousAutoFocus(bool value);
 
     void OnViewModelUpdated();
-    void OnNewShip(Geometry::AABBSet const & allAABBs);
+    void OnNewShip(std::optional<Geometry::AABB> const & allShipsAABB);
     void Pan(vec2f const & worldOffset);
     void PanToWorldX(float worldX);
     void AdjustZoom(float amount);
-    void ResetView(Geometry::AABBSet const & allAABBs);
-    void FocusOnShip(Geometry::AABBSet const & allAABBs);
+    void ResetView(std::optional<Geometry::AABB> const & allShipsAABB);
+    void FocusOnShip(std::optional<Geometry::AABB> const & allShipsAABB);
 
-    void Update(Geometry::AABBSet const & allAABBs);
+    void Update(std::optional<Geometry::AABB> const & allShipsAABB);
 
 private:
 
@@ -54,7 +54,7 @@ private:
         float mid,
         float max);
 
-    void InternalFocusOnShip(Geometry::AABBSet const & allAABBs);
+    void InternalFocusOnShip(std::optional<Geometry::AABB> const & allShipsAABB);
 
     float InternalCalculateZoom(Geometry::AABB const & aabb);
 
@@ -78,11 +78,26 @@ private:
         float UserZoomOffset;
         vec2f UserCameraWorldPositionOffset;
 
+        // The ships' AABB smoothed across frames, so that waves and
+        // debris don't make the camera twitch
+        std::optional<Geometry::AABB> SmoothedAllShipsAABB;
+
+        // The smoothed AABB the current auto-focus zoom and pan were calculated
+        // for; while the AABB stays close to it and the pan has converged, we
+        // recalculate them only every few frames
+        Geometry::AABB AutoFocusAABB;
+        bool IsAutoFocusPanConverged;
+        int FramesSinceAutoFocusCalculation;
+
         AutoFocusSessionData(
             float currentAutoFocusZoom,
             vec2f const & currentAutoFocusCameraWorldPosition)
             : CurrentAutoFocusZoom(currentAutoFocusZoom)
             , CurrentAutoFocusCameraWorldPosition(currentAutoFocusCameraWorldPosition)
+            , SmoothedAllShipsAABB()
+            , AutoFocusAABB()
+            , IsAutoFocusPanConverged(false)
+            , FramesSinceAutoFocusCalculation(0)
         {
             Reset();
         }
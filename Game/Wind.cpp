@@ -41,6 +41,11 @@ Wind::Wind(std::shared_ptr<GameEventDispatcher> gameEventDispatcher)
     , mCurrentRawWindSpeedMagnitude(0.0f)
     , mCurrentWindSpeedMagnitudeRunningAverage()
     , mCurrentWindSpeed(vec2f::zero())
+    // Speed grid
+    , mHasSpeedGrid(false)
+    , mSpeedGridOrigin(vec2f::zero())
+    , mSpeedGridCellSize(1.0f)
+    , mSpeedGrid(SpeedGridSize * SpeedGridSize, vec2f::zero())
 {
 }
 
@@ -305,6 +310,41 @@ void Wind::Update(
         mCurrentWindSpeed);
 }
 
+void Wind::UpdateSpeedGrid(std::optional<WindField> const & interactiveWindField)
+{
+    if (!interactiveWindField.has_value())
+    {
+        mHasSpeedGrid = false;
+        return;
+    }
+
+    // Cover the field's square, with one cell of margin on each side so that
+    // the field fades out over the last cell
+    mSpeedGridCellSize = 2.0f * interactiveWindField->FieldRadius / static_cast<float>(SpeedGridSize - 3);
+    mSpeedGridOrigin =
+        interactiveWindField->FieldCenterPos
+        - vec2f(1.0f, 1.0f) * (interactiveWindField->FieldRadius + mSpeedGridCellSize);
+
+    for (size_t y = 0; y < SpeedGridSize; ++y)
+    {
+        for (size_t x = 0; x < SpeedGridSize; ++x)
+        {
+            vec2f const displacement =
+                mSpeedGridOrigin
+                + vec2f(static_cast<float>(x), static_cast<float>(y)) * mSpeedGridCellSize
+                - interactiveWindField->FieldCenterPos;
+
+            float const radius = displacement.length();
+
+            mSpeedGrid[y * SpeedGridSize + x] = (radius < interactiveWindField->FieldRadius && radius > 0.0f)
+                ? displacement.normalise(radius) * interactiveWindField->WindSpeed
+                : vec2f::zero();
+        }
+    }
+
+    mHasSpeedGrid = true;
+}
+
 void Wind::Upload(Render::RenderContext & renderContext) const
 {
     renderContext.UploadWind(mCurrentWindSpeed);
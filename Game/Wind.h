@@ -13,6 +13,10 @@
 #include <GameCore/GameMath.h>
 #include <GameCore/GameWallClock.h>
 #include <GameCore/RunningAverage.h>
+#include <GameCore/Vectors.h>
+
+#include <optional>
+#include <vector>
 
 namespace Physics
 {
@@ -62,6 +66,46 @@ public:
         return mCurrentWindSpeed;
     }
 
+    /*
+     * Re-calculates, once per step, the grid of the wind speeds that are added to the
+     * current wind speed by the interactive wind field, if any.
+     */
+    void UpdateSpeedGrid(std::optional<WindField> const & interactiveWindField);
+
+    /*
+     * Returns the current modulated wind speed at the specified position, including the
+     * interactive wind field; this is a bilinear sample of the speed grid, and cheap enough
+     * to be taken for each particle.
+     *
+     * Km/h.
+     */
+    inline vec2f GetCurrentWindSpeedAt(vec2f const & position) const
+    {
+        if (!mHasSpeedGrid)
+        {
+            return mCurrentWindSpeed;
+        }
+
+        vec2f const gridPosition = (position - mSpeedGridOrigin) / mSpeedGridCellSize;
+        if (gridPosition.x < 0.0f || gridPosition.x >= static_cast<float>(SpeedGridSize - 1)
+            || gridPosition.y < 0.0f || gridPosition.y >= static_cast<float>(SpeedGridSize - 1))
+        {
+            return mCurrentWindSpeed;
+        }
+
+        size_t const x = static_cast<size_t>(gridPosition.x);
+        size_t const y = static_cast<size_t>(gridPosition.y);
+        float const dx = gridPosition.x - static_cast<float>(x);
+        float const dy = gridPosition.y - static_cast<float>(y);
+
+        vec2f const * const bottomRow = &(mSpeedGrid[y * SpeedGridSize + x]);
+        vec2f const * const topRow = bottomRow + SpeedGridSize;
+
+        return mCurrentWindSpeed
+            + (bottomRow[0] * (1.0f - dx) + bottomRow[1] * dx) * (1.0f - dy)
+            + (topRow[0] * (1.0f - dx) + topRow[1] * dx) * dy;
+    }
+
 private:
 
     static GameWallClock::duration ChooseDuration(float minSeconds, float maxSeconds);
@@ -147,6 +191,20 @@ private:
 
     // The current wind speed
     vec2f mCurrentWindSpeed;
+
+    //
+    // Speed grid
+    //
+    // Covers the square around the interactive wind field; elsewhere - and when there's
+    // no interactive wind field - the wind speed is just the current wind speed
+    //
+
+    static size_t constexpr SpeedGridSize = 33; // Samples per side
+
+    bool mHasSpeedGrid;
+    vec2f mSpeedGridOrigin; // World coordinates of sample (0, 0)
+    float mSpeedGridCellSize;
+    std::vector<vec2f> mSpeedGrid; // Row-major, from bottom
 };
 
 }
@@ -6,6 +6,7 @@
 #include "Physics.h"
 
 #include <GameCore/GameRandomEngine.h>
+#include <GameCore/Profiler.h>
 
 #include <algorithm>
 #include <cassert>
@@ -20,6 +21,7 @@ World::World(
     GameParameters const & gameParameters,
     VisibleWorld const & /*visibleWorld*/)
     : mCurrentSimulationTime(0.0f)
+    , mCurrentSimulationSequenceNumber()
     //
     , mGameEventHandler(std::move(gameEventDispatcher))
     , mEventRecorder(nullptr)
@@ -30,11 +32,15 @@ World::World(
     , mStorm(*this, mGameEventHandler)
     , mWind(mGameEventHandler)
     , mClouds()
-    , mOceanSurface(*this, mGameEventHandler)
+    , mOceanSurface(*this, mGameEventHandler, mTaskThreadPool)
     , mOceanFloor(std::move(oceanFloorTerrain))
-    , mFishes(fishSpeciesDatabase, mGameEventHandler)
+    , mFishes(fishSpeciesDatabase, mGameEventHandler, mTaskThreadPool)
+    , mInteractiveWindField()
     //
     , mAllAABBs()
+    , mShipAABBs()
+    , mShipUpdateStagingAreas()
+    , mRenderUploadTasks()
 {
     // Initialize world pieces that need to be initialized now
     mStars.Update(mCurrentSimulationTime, gameParameters);
@@ -57,21 +63,90 @@ void World::AddShip(std::unique_ptr<Ship> ship)
     assert(ship->GetId() == static_cast<ShipId>(mAllShips.size()));
     mAllShips.push_back(std::move(ship));
 
-    // Update AABBSet
+    // Update AABBSets
     for (auto const & aabb : shipAABBs.GetItems())
     {
         mAllAABBs.Add(aabb);
     }
+
+    mAllAABBs.UpdateBroadPhase();
+
+    mShipAABBs.Add(shipAABBs.MakeUnion().value_or(Geometry::AABB()));
+}
+
+std::vector<ShipId> World::SplitDetachedFragments(
+    ShipId shipId,
+    ElementCount minFragmentPointCount,
+    GameParameters const & gameParameters)
+{
+    assert(shipId >= 0 && shipId < mAllShips.size());
+
+    auto fragmentShips = mAllShips[shipId]->SplitDetachedFragments(
+        GetNextShipId(),
+        minFragmentPointCount,
+        gameParameters);
+
+    std::vector<ShipId> newShipIds;
+
+    if (fragmentShips.empty())
+    {
+        return newShipIds;
+    }
+
+    // The first fragment takes the place of the ship
+    assert(fragmentShips[0]->GetId() == shipId);
+    mAllShips[shipId] = std::move(fragmentShips[0]);
+
+    for (size_t f = 1; f < fragmentShips.size(); ++f)
+    {
+        newShipIds.push_back(fragmentShips[f]->GetId());
+
+        assert(fragmentShips[f]->GetId() == static_cast<ShipId>(mAllShips.size()));
+        mAllShips.push_back(std::move(fragmentShips[f]));
+    }
+
+    // Re-build AABBSets, as the ship's own AABBs are now spread across its fragments
+    mAllAABBs.Clear();
+    mShipAABBs.Clear();
+
+    for (auto const & ship : mAllShips)
+    {
+        auto const shipAABBs = ship->CalculateAABBs();
+
+        for (auto const & aabb : shipAABBs.GetItems())
+        {
+            mAllAABBs.Add(aabb);
+        }
+
+        mShipAABBs.Add(shipAABBs.MakeUnion().value_or(Geometry::AABB()));
+    }
+
+    mAllAABBs.UpdateBroadPhase();
+
+    return newShipIds;
+}
+
+bool World::HasDetachedFragments(
+    ShipId shipId,
+    ElementCount minFragmentPointCount) const
+{
+    assert(shipId >= 0 && shipId < mAllShips.size());
+
+    return mAllShips[shipId]->HasDetachedFragments(minFragmentPointCount);
 }
 
 void World::Announce()
 {
     // Nothing to announce in non-ship stuff...
     // ...ask all ships to announce
+    mGameEventHandler->OnElectricalElementAnnouncementsBegin();
+
     for (auto & ship : mAllShips)
     {
         ship->Announce();
     }
+
+    mGameEventHandler->OnElectricalElementAnnouncementsEnd();
 }
 
 void World::SetEventRecorder(EventRecorder * eventRecorder)
@@ -110,6 +185,76 @@ size_t World::GetShipPointCount(ShipId shipId) const
     return mAllShips[shipId]->GetPointCount();
 }
 
+std::optional<Geometry::AABB> World::GetAllShipsAABB() const
+{
+    // Ships without AABBs contribute an empty AABB, which extends nothing
+    auto const unionAABB = mShipAABBs.MakeUnion();
+    if (!unionAABB.has_value() || unionAABB->GetWidth() < 0.0f)
+    {
+        return std::nullopt;
+    }
+
+    return unionAABB;
+}
+
+std::vector<ShipMemoryReport> World::GetShipMemoryReports() const
+{
+    std::vector<ShipMemoryReport> reports;
+
+    for (auto const & ship : mAllShips)
+    {
+        reports.emplace_back(ship->GetMemoryReport());
+    }
+
+    return reports;
+}
+
+static std::uint32_t constexpr StateSectionTag = 0x53444C57; // WLDS
+
+StateSnapshot World::TakeSnapshot() const
+{
+    StateSnapshotWriter writer;
+
+    writer.BeginSection(StateSectionTag);
+    writer.Archive(mCurrentSimulationTime);
+    writer.Archive(mCurrentSimulationSequenceNumber);
+    writer.Archive(static_cast<std::uint32_t>(mAllShips.size()));
+
+    writer.ArchiveContainer(mOceanSurface);
+
+    for (auto const & ship : mAllShips)
+    {
+        writer.ArchiveContainer(*ship);
+    }
+
+    return writer.Finish();
+}
+
+void World::RestoreSnapshot(StateSnapshot const & snapshot)
+{
+    StateSnapshotReader reader(snapshot);
+
+    reader.BeginSection(StateSectionTag);
+    reader.Archive(mCurrentSimulationTime);
+    reader.Archive(mCurrentSimulationSequenceNumber);
+
+    std::uint32_t shipCount;
+    reader.Archive(shipCount);
+    if (shipCount != mAllShips.size())
+    {
+        throw GameException("The snapshot does not match the world being restored");
+    }
+
+    reader.ArchiveContainer(mOceanSurface);
+
+    for (auto & ship : mAllShips)
+    {
+        reader.ArchiveContainer(*ship);
+    }
+
+    reader.Finish();
+}
+
 bool World::IsUnderwater(ElementId elementId) const
 {
     auto const shipId = elementId.GetShipId();
@@ -440,6 +585,12 @@ void World::ApplyRadialWindFrom(
     float mainFrontWindSpeed,
     GameParameters const & gameParameters)
 {
+    // Remember wind field, for the wind speed grid of the next step
+    mInteractiveWindField.emplace(
+        sourcePos,
+        preFrontRadius,
+        preFrontWindSpeed);
+
     // Apply to ships
     for (auto & ship : mAllShips)
     {
@@ -994,11 +1145,21 @@ void World::Update(
     StressRenderModeType stressRenderMode,
     PerfStats & perfStats)
 {
+    FS_PROFILE_SCOPE("World::Update");
+
     // Update current time
     mCurrentSimulationTime += GameParameters::SimulationStepTimeDuration<float>;
 
+    ++mCurrentSimulationSequenceNumber;
+
+    // When the simulation is degraded, we only update optional subsystems every other step
+    bool const doUpdateOptionalSubsystems =
+        gameParameters.SimulationDegradationLevel < 1
+        || mCurrentSimulationSequenceNumber.IsStepOf(0, 2);
+
     // Prepare all AABBs
     mAllAABBs.Clear();
+    mShipAABBs.Clear();
 
     //
     // Update all subsystems
@@ -1010,23 +1171,104 @@ void World::Update(
 
     mWind.Update(mStorm.GetParameters(), gameParameters);
 
-    mClouds.Update(mCurrentSimulationTime, mWind.GetBaseAndStormSpeedMagnitude(), mStorm.GetParameters(), gameParameters);
+    // Calculate the wind speed grid once, for all of the subsystems below
+    mWind.UpdateSpeedGrid(mInteractiveWindField);
+    mInteractiveWindField.reset();
+
+    if (doUpdateOptionalSubsystems)
+    {
+        mClouds.Update(mCurrentSimulationTime, mWind.GetBaseAndStormSpeedMagnitude(), mStorm.GetParameters(), gameParameters);
+    }
 
     mOceanSurface.Update(mCurrentSimulationTime, mWind, gameParameters);
 
     mOceanFloor.Update(gameParameters);
 
-    for (auto & ship : mAllShips)
+    // Make room for the perf stats of all ships, before they're updated concurrently
+    perfStats.EnsureShipCount(mAllShips.size());
+
+    if (gameParameters.DoUpdateShipsConcurrently
+        && mAllShips.size() > 1
+        && mTaskThreadPool->GetParallelism() > 1)
     {
-        ship->Update(
-            mCurrentSimulationTime,
-            mStorm.GetParameters(),
-            gameParameters,
-            stressRenderMode,
-            mAllAABBs,
-            perfStats);
+        //
+        // Update ships concurrently, each one staging its shared side effects
+        // into its own staging area, and drawing random numbers from the
+        // staging area's engine - one stream per ship
+        //
+
+        while (mShipUpdateStagingAreas.size() < mAllShips.size())
+        {
+            mShipUpdateStagingAreas.emplace_back(static_cast<std::uint32_t>(mShipUpdateStagingAreas.size()));
+        }
+
+        mTaskThreadPool->ParallelFor(
+            0,
+            mAllShips.size(),
+            1,
+            [&](size_t startShip, size_t endShip)
+            {
+                for (size_t s = startShip; s < endShip; ++s)
+                {
+                    ShipUpdateStaging::Scope const stagingScope(mShipUpdateStagingAreas[s]);
+
+                    mAllShips[s]->Update(
+                        mCurrentSimulationTime,
+                        mStorm.GetParameters(),
+                        gameParameters,
+                        stressRenderMode,
+                        visibleWorld,
+                        mShipUpdateStagingAreas[s].GetAABBs(),
+                        perfStats);
+                }
+            });
+
+        // Merge staging areas, in ship order
+        for (auto & staging : mShipUpdateStagingAreas)
+        {
+            mShipAABBs.Add(staging.GetAABBs().MakeUnion().value_or(Geometry::AABB()));
+
+            for (auto const & displacement : staging.GetOceanSurfaceDisplacements())
+            {
+                mOceanSurface.DisplaceAt(displacement.X, displacement.YOffset);
+            }
+
+            staging.MergeInto(mAllAABBs);
+            mGameEventHandler->MergeAggregatedEvents(staging);
+        }
     }
+    else
+    {
+        for (auto & ship : mAllShips)
+        {
+            size_t const firstShipAABBIndex = mAllAABBs.GetCount();
+
+            ship->Update(
+                mCurrentSimulationTime,
+                mStorm.GetParameters(),
+                gameParameters,
+                stressRenderMode,
+                visibleWorld,
+                mAllAABBs,
+                perfStats);
+
+            Geometry::AABB shipAABB;
+            for (size_t a = firstShipAABBIndex; a < mAllAABBs.GetCount(); ++a)
+            {
+                shipAABB.ExtendTo(mAllAABBs.GetItems()[a]);
+            }
+
+            mShipAABBs.Add(shipAABB);
+        }
+    }
+
+    // Let ships collide with each other
+    HandleShipToShipCollisions(gameParameters);
 
+    // Sort AABBs for the queries of the subsystems below
+    mAllAABBs.UpdateBroadPhase();
+
+    if (doUpdateOptionalSubsystems)
     {
         auto const startTime = std::chrono::steady_clock::now();
 
@@ -1036,36 +1278,85 @@ void World::Update(
     }
 }
 
+void World::UpdateStructureHeadless()
+{
+    for (auto const & ship : mAllShips)
+    {
+        ship->UpdateStructureHeadless();
+    }
+}
+
+void World::RenderUploadAhead(Render::RenderContext & renderContext)
+{
+    for (auto const & ship : mAllShips)
+    {
+        ship->RenderUploadAhead(renderContext);
+    }
+}
+
 void World::RenderUpload(
     GameParameters const & gameParameters,
     Render::RenderContext & renderContext,
     PerfStats & /*perfStats*/)
 {
-    mStars.Upload(renderContext);
+    FS_PROFILE_SCOPE("World::RenderUpload");
 
-    mWind.Upload(renderContext);
+    //
+    // Uploads only stage data in the render context's buffers - the actual
+    // GL submission happens later on the render thread - and each subsystem
+    // stages into its own buffers, hence we may run them concurrently.
+    //
+    // Ships are uploaded serially among themselves, as they may stage into
+    // shared world buffers (e.g. anti-matter bombs); we upload them on the
+    // main thread, as the first task.
+    //
 
-    mStorm.Upload(renderContext);
+    assert(mRenderUploadTasks.empty());
 
-    mClouds.Upload(renderContext);
+    mRenderUploadTasks.emplace_back(
+        [&]()
+        {
+            renderContext.UploadShipsStart();
 
-    mOceanFloor.Upload(gameParameters, renderContext);
+            for (auto const & ship : mAllShips)
+            {
+                ship->RenderUpload(renderContext);
+            }
 
-    mOceanSurface.Upload(renderContext);
+            renderContext.UploadShipsEnd();
+        });
 
-    mFishes.Upload(renderContext);
+    mRenderUploadTasks.emplace_back(
+        [&]()
+        {
+            mStars.Upload(renderContext);
 
-    // Ships
-    {
-        renderContext.UploadShipsStart();
+            mWind.Upload(renderContext);
+
+            mStorm.Upload(renderContext);
+
+            mClouds.Upload(renderContext);
+        });
 
-        for (auto const & ship : mAllShips)
+    mRenderUploadTasks.emplace_back(
+        [&]()
         {
-            ship->RenderUpload(renderContext);
-        }
+            mOceanFloor.Upload(gameParameters, renderContext);
+        });
 
-        renderContext.UploadShipsEnd();
-    }
+    mRenderUploadTasks.emplace_back(
+        [&]()
+        {
+            mOceanSurface.Upload(renderContext);
+        });
+
+    mRenderUploadTasks.emplace_back(
+        [&]()
+        {
+            mFishes.Upload(renderContext);
+        });
+
+    mTaskThreadPool->RunAndClear(mRenderUploadTasks);
 
     // AABBs
     if (renderContext.GetShowAABBs())
@@ -1085,4 +1376,40 @@ void World::RenderUpload(
     }
 }
 
+//////////////////////////////////////////////////////////////////////////////
+// Private
+//////////////////////////////////////////////////////////////////////////////
+
+void World::HandleShipToShipCollisions(GameParameters const & gameParameters)
+{
+    if (mAllShips.size() < 2)
+    {
+        return;
+    }
+
+    FS_PROFILE_SCOPE("World::HandleShipToShipCollisions");
+
+    // Broad phase: only ships whose AABBs intersect may be in contact
+    mShipAABBs.UpdateBroadPhase();
+
+    mShipAABBs.ForEachOverlappingPair(
+        [&](size_t ship1, size_t ship2)
+        {
+            auto const & aabb1 = mShipAABBs.GetItems()[ship1];
+            auto const & aabb2 = mShipAABBs.GetItems()[ship2];
+
+            Geometry::AABB const overlapBox(
+                std::max(aabb1.BottomLeft.x, aabb2.BottomLeft.x),
+                std::min(aabb1.TopRight.x, aabb2.TopRight.x),
+                std::min(aabb1.TopRight.y, aabb2.TopRight.y),
+                std::max(aabb1.BottomLeft.y, aabb2.BottomLeft.y));
+
+            // Narrow phase
+            mAllShips[ship1]->HandleCollisionsWithShip(
+                *mAllShips[ship2],
+                overlapBox,
+                gameParameters);
+        });
+}
+
 }
\ No newline at end of file
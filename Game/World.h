@@ -15,12 +15,15 @@
 #include "RenderContext.h"
 #include "ResourceLocator.h"
 #include "ShipDefinition.h"
+#include "ShipMemoryReport.h"
+#include "ShipUpdateStaging.h"
 #include "VisibleWorld.h"
 
 #include <GameCore/AABBSet.h>
 #include <GameCore/GameChronometer.h>
 #include <GameCore/GameTypes.h>
 #include <GameCore/ImageData.h>
+#include <GameCore/StateSnapshot.h>
 #include <GameCore/TaskThreadPool.h>
 #include <GameCore/Vectors.h>
 
@@ -50,6 +53,19 @@ public:
 
     void AddShip(std::unique_ptr<Ship> ship);
 
+    /*
+     * Splits off the large detached fragments of the specified ship into ships of
+     * their own, which are appended to the world; returns the IDs of the new ships.
+     */
+    std::vector<ShipId> SplitDetachedFragments(
+        ShipId shipId,
+        ElementCount minFragmentPointCount,
+        GameParameters const & gameParameters);
+
+    bool HasDetachedFragments(
+        ShipId shipId,
+        ElementCount minFragmentPointCount) const;
+
     void Announce();
 
     void SetEventRecorder(EventRecorder * eventRecorder);
@@ -67,16 +83,44 @@ public:
 
     size_t GetShipPointCount(ShipId shipId) const;
 
-    Geometry::AABBSet GetAllAABBs() const
+    std::vector<ShipMemoryReport> GetShipMemoryReports() const;
+
+    /*
+     * Takes a snapshot of the simulation state of the ocean surface and of all ships.
+     *
+     * The snapshot may only be restored into a world with the same ships, created from
+     * the same definitions; weather, fishes, and gadgets are not captured.
+     */
+    StateSnapshot TakeSnapshot() const;
+
+    /*
+     * Throws a GameException - leaving the world in an undefined state - if the
+     * snapshot does not match this world.
+     */
+    void RestoreSnapshot(StateSnapshot const & snapshot);
+
+    Geometry::AABBSet const & GetAllAABBs() const
     {
         return mAllAABBs;
     }
 
+    /*
+     * The union of the AABBs of all ships, as of the last simulation step
+     * or ship addition; cheap, as it only visits one AABB per ship.
+     */
+    std::optional<Geometry::AABB> GetAllShipsAABB() const;
+
     inline void DisturbOceanAt(
         vec2f const & position,
         float fishScareRadius,
         std::chrono::milliseconds delay)
     {
+        if (auto * const staging = ShipUpdateStaging::GetCurrent(); staging != nullptr)
+        {
+            staging->Defer([=]() { DisturbOceanAt(position, fishScareRadius, delay); });
+            return;
+        }
+
         mFishes.DisturbAt(
             position,
             fishScareRadius,
@@ -85,6 +129,12 @@ public:
 
     inline void DisturbOcean(std::chrono::milliseconds delay)
     {
+        if (auto * const staging = ShipUpdateStaging::GetCurrent(); staging != nullptr)
+        {
+            staging->Defer([=]() { DisturbOcean(delay); });
+            return;
+        }
+
         mFishes.TriggerWidespreadPanic(delay);
     }
 
@@ -99,6 +149,12 @@ public:
         float x,
         float yOffset)
     {
+        if (auto * const staging = ShipUpdateStaging::GetCurrent(); staging != nullptr)
+        {
+            staging->AddOceanSurfaceDisplacement(x, yOffset);
+            return;
+        }
+
         mOceanSurface.DisplaceAt(x, yOffset);
     }
 
@@ -122,6 +178,11 @@ public:
         return mWind.GetCurrentWindSpeed();
     }
 
+    inline Wind const & GetWind() const
+    {
+        return mWind;
+    }
+
     //
     // Interactions
     //
@@ -361,11 +422,30 @@ public:
         Render::RenderContext & renderContext,
         PerfStats & perfStats);
 
+    /*
+     * Uploads the subset of render data that may be uploaded while
+     * the previous frame is still being drawn; to be followed by RenderUpload().
+     */
+    void RenderUploadAhead(Render::RenderContext & renderContext);
+
+    /*
+     * To be invoked after each Update() in lieu of the render uploads, when
+     * running without rendering.
+     */
+    void UpdateStructureHeadless();
+
+private:
+
+    void HandleShipToShipCollisions(GameParameters const & gameParameters);
+
 private:
 
     // The current simulation time
     float mCurrentSimulationTime;
 
+    // The current simulation sequence number
+    SequenceNumber mCurrentSimulationSequenceNumber;
+
     // The game event handler
     std::shared_ptr<GameEventDispatcher> mGameEventHandler;
 
@@ -385,9 +465,23 @@ private:
     OceanFloor mOceanFloor;
     Fishes mFishes;
 
+    // The interactive wind field applied in the current step, if any
+    std::optional<WindField> mInteractiveWindField;
+
     // The set of all AABB's in the world, updated at each
     // simulation cycle and at each ship addition
     Geometry::AABBSet mAllAABBs;
+
+    // One AABB per ship - in ship order - enclosing all of the ship's AABBs,
+    // updated at each simulation cycle and at each ship addition
+    Geometry::AABBSet mShipAABBs;
+
+    // The staging areas - one per ship - used when updating ships concurrently
+    std::vector<ShipUpdateStaging> mShipUpdateStagingAreas;
+
+    // The tasks used when uploading concurrently, kept across
+    // uploads to save allocations
+    std::vector<TaskThreadPool::Task> mRenderUploadTasks;
 };
 
 }
@@ -13,20 +13,27 @@
 #include <GameCore/ImageTools.h>
 #include <GameCore/Log.h>
 
+#include <algorithm>
 #include <cstring>
+#include <vector>
 
 namespace Render {
 
 ImageSize constexpr ThumbnailSize(32, 32);
 
+// The GPU memory we're willing to spend on ocean and land textures that are not in use
+size_t constexpr WorldTexturesResidencyBudget = 48 * 1024 * 1024;
+
 WorldRenderContext::WorldRenderContext(
     ShaderManager<ShaderManagerTraits> & shaderManager,
     GlobalRenderContext const & globalRenderContext)
     // Buffers
     : mStarVertexBuffer()
-    , mDirtyStarsCount(0)
+    , mIsStarVertexBufferDirty(false)
     , mStarVBO()
-    , mStarVBOAllocatedVertexSize(0u)
+    , mMovingStarVertex()
+    , mMovingStarVBO()
+    , mLightnings()
     , mLightningVertexBuffer()
     , mBackgroundLightningVertexCount(0)
     , mForegroundLightningVertexCount(0)
@@ -37,6 +44,7 @@ WorldRenderContext::WorldRenderContext(
     , mCloudVBOAllocatedVertexSize(0u)
     , mCloudNormalizedViewCamY(0.0f)
     , mLandSegmentBuffer()
+    , mLandSegmentBufferDirtyRange()
     , mLandSegmentVBO()
     , mLandSegmentVBOAllocatedVertexSize(0u)
     , mOceanBasicSegmentBuffer()
@@ -45,9 +53,13 @@ WorldRenderContext::WorldRenderContext(
     , mOceanDetailedSegmentBuffer()
     , mOceanDetailedSegmentVBO()
     , mOceanDetailedSegmentVBOAllocatedVertexSize(0u)
+    , mOceanUploadVisibleWorldBottomY(0.0f)
+    , mOceanUploadIsTextureMode(false)
     , mFishVertexBuffer()
     , mFishVBO()
     , mFishVBOAllocatedVertexSize(0u)
+    , mQuadElementVBO()
+    , mQuadElementVBOAllocatedQuadSize(0u)
     , mAMBombPreImplosionVertexBuffer()
     , mAMBombPreImplosionVBO()
     , mAMBombPreImplosionVBOAllocatedVertexSize(0u)
@@ -67,6 +79,7 @@ WorldRenderContext::WorldRenderContext(
     , mWorldBorderVBO()
     // VAOs
     , mStarVAO()
+    , mMovingStarVAO()
     , mLightningVAO()
     , mCloudVAO()
     , mLandVAO()
@@ -81,11 +94,9 @@ WorldRenderContext::WorldRenderContext(
     // Textures
     , mCloudTextureAtlasMetadata()
     , mCloudTextureAtlasOpenGLHandle()
-    , mUploadedWorldTextureManager()
+    , mUploadedWorldTextureManager(WorldTexturesResidencyBudget)
     , mOceanTextureFrameSpecifications()
-    , mOceanTextureOpenGLHandle()
     , mLandTextureFrameSpecifications()
-    , mLandTextureOpenGLHandle()
     , mFishTextureAtlasMetadata()
     , mFishTextureAtlasOpenGLHandle()
     , mGenericLinearTextureAtlasMetadata(globalRenderContext.GetGenericLinearTextureAtlasMetadata())
@@ -102,8 +113,8 @@ WorldRenderContext::WorldRenderContext(
     // Initialize buffers
     //
 
-    GLuint vbos[12];
-    glGenBuffers(12, vbos);
+    GLuint vbos[14];
+    glGenBuffers(14, vbos);
     mStarVBO = vbos[0];
     mLightningVBO = vbos[1];
     mCloudVBO = vbos[2];
@@ -116,6 +127,8 @@ WorldRenderContext::WorldRenderContext(
     mAABBVBO = vbos[9];
     mRainVBO = vbos[10];
     mWorldBorderVBO = vbos[11];
+    mQuadElementVBO = vbos[12];
+    mMovingStarVBO = vbos[13];
 
 
     //
@@ -137,6 +150,29 @@ WorldRenderContext::WorldRenderContext(
     glBindVertexArray(0);
 
 
+    //
+    // Initialize Moving Star VAO
+    //
+
+    glGenVertexArrays(1, &tmpGLuint);
+    mMovingStarVAO = tmpGLuint;
+
+    glBindVertexArray(*mMovingStarVAO);
+    CheckOpenGLError();
+
+    // Allocate buffer for the one vertex, which is never re-allocated
+    glBindBuffer(GL_ARRAY_BUFFER, *mMovingStarVBO);
+    glBufferData(GL_ARRAY_BUFFER, sizeof(StarVertex), nullptr, GL_STREAM_DRAW);
+    CheckOpenGLError();
+
+    // Describe vertex attributes
+    glEnableVertexAttribArray(static_cast<GLuint>(VertexAttributeType::Star));
+    glVertexAttribPointer(static_cast<GLuint>(VertexAttributeType::Star), 3, GL_FLOAT, GL_FALSE, sizeof(StarVertex), (void *)0);
+    CheckOpenGLError();
+
+    glBindVertexArray(0);
+
+
     //
     // Initialize Lightning VAO
     //
@@ -177,6 +213,10 @@ WorldRenderContext::WorldRenderContext(
     glVertexAttribPointer(static_cast<GLuint>(VertexAttributeType::Cloud2), 4, GL_FLOAT, GL_FALSE, sizeof(CloudVertex), (void *)(4 * sizeof(float)));
     CheckOpenGLError();
 
+    // Associate element VBO
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, *mQuadElementVBO);
+    CheckOpenGLError();
+
     glBindVertexArray(0);
 
 
@@ -264,6 +304,10 @@ WorldRenderContext::WorldRenderContext(
     glVertexAttribPointer(static_cast<GLuint>(VertexAttributeType::Fish4), 2, GL_FLOAT, GL_FALSE, sizeof(FishVertex), (void *)(12 * sizeof(float)));
     CheckOpenGLError();
 
+    // Associate element VBO
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, *mQuadElementVBO);
+    CheckOpenGLError();
+
     glBindVertexArray(0);
 
 
@@ -395,7 +439,7 @@ WorldRenderContext::WorldRenderContext(
 
     auto const & worldBorderAtlasFrameMetadata = mGenericLinearTextureAtlasMetadata.GetFrameMetadata(GenericLinearTextureGroups::WorldBorder, 0);
 
-    mShaderManager.ActivateProgram<ProgramType::WorldBorder>();
+    mShaderManager.ActivateProgramForParameters<ProgramType::WorldBorder>();
     mShaderManager.SetTextureParameters<ProgramType::WorldBorder>();
     mShaderManager.SetProgramParameter<ProgramType::WorldBorder, ProgramParameterType::AtlasTile1Dx>(
         1.0f / static_cast<float>(worldBorderAtlasFrameMetadata.FrameMetadata.Size.width),
@@ -418,7 +462,7 @@ WorldRenderContext::WorldRenderContext(
     glBindTexture(GL_TEXTURE_2D, globalRenderContext.GetNoiseTextureOpenGLHandle(1));
     CheckOpenGLError();
 
-    mShaderManager.ActivateProgram<ProgramType::Lightning>();
+    mShaderManager.ActivateProgramForParameters<ProgramType::Lightning>();
     mShaderManager.SetTextureParameters<ProgramType::Lightning>();
 
 
@@ -432,17 +476,27 @@ WorldRenderContext::~WorldRenderContext()
 {
 }
 
-void WorldRenderContext::InitializeCloudTextures(ResourceLocator const & resourceLocator)
+void WorldRenderContext::InitializeCloudTextures(
+    ResourceLocator const & resourceLocator,
+    TaskThreadPool & taskThreadPool)
 {
     // Load texture database
     auto cloudTextureDatabase = TextureDatabase<Render::CloudTextureDatabaseTraits>::Load(
         resourceLocator.GetTexturesRootFolderPath());
 
     // Create atlas
-    auto cloudTextureAtlas = TextureAtlasBuilder<CloudTextureGroups>::BuildAtlas(
+    auto cloudTextureAtlas = TextureAtlasCache<Render::CloudTextureDatabaseTraits>::LoadOrBuild(
         cloudTextureDatabase,
         AtlasOptions::None,
-        [](float, ProgressMessageType) {});
+        resourceLocator.GetTextureAtlasCacheFolderPath(),
+        [&taskThreadPool](auto const & database, AtlasOptions options)
+        {
+            return TextureAtlasBuilder<CloudTextureGroups>::BuildAtlas(
+                database,
+                options,
+                [](float, ProgressMessageType) {},
+                &taskThreadPool);
+        });
 
     LogMessage("Cloud texture atlas size: ", cloudTextureAtlas.AtlasData.Size);
 
@@ -525,17 +579,27 @@ void WorldRenderContext::InitializeWorldTextures(ResourceLocator const & resourc
     }
 }
 
-void WorldRenderContext::InitializeFishTextures(ResourceLocator const & resourceLocator)
+void WorldRenderContext::InitializeFishTextures(
+    ResourceLocator const & resourceLocator,
+    TaskThreadPool & taskThreadPool)
 {
     // Load texture database
     auto fishTextureDatabase = TextureDatabase<Render::FishTextureDatabaseTraits>::Load(
         resourceLocator.GetTexturesRootFolderPath());
 
     // Create atlas
-    auto fishTextureAtlas = TextureAtlasBuilder<FishTextureGroups>::BuildAtlas(
+    auto fishTextureAtlas = TextureAtlasCache<Render::FishTextureDatabaseTraits>::LoadOrBuild(
         fishTextureDatabase,
         AtlasOptions::None,
-        [](float, ProgressMessageType) {});
+        resourceLocator.GetTextureAtlasCacheFolderPath(),
+        [&taskThreadPool](auto const & database, AtlasOptions options)
+        {
+            return TextureAtlasBuilder<FishTextureGroups>::BuildAtlas(
+                database,
+                options,
+                [](float, ProgressMessageType) {},
+                &taskThreadPool);
+        });
 
     LogMessage("Fish texture atlas size: ", fishTextureAtlas.AtlasData.Size);
 
@@ -553,7 +617,8 @@ void WorldRenderContext::InitializeFishTextures(ResourceLocator const & resource
     // Upload atlas texture
     GameOpenGL::UploadMipmappedPowerOfTwoTexture(
         std::move(fishTextureAtlas.AtlasData),
-        fishTextureAtlas.Metadata.GetMaxDimension());
+        fishTextureAtlas.Metadata.GetMaxDimension(),
+        &taskThreadPool);
 
     // Set repeat mode
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
@@ -580,6 +645,9 @@ void WorldRenderContext::UploadStart()
     // At this moment we know there are no pending draw's,
     // so GPU buffers are free to be used
 
+    // Reset moving star, it's uploaded as needed
+    mMovingStarVertex.reset();
+
     // Reset AM bomb pre-implosions, they are uploaded as needed
     mAMBombPreImplosionVertexBuffer.clear();
 
@@ -590,18 +658,17 @@ void WorldRenderContext::UploadStart()
     mAABBVertexBuffer.clear();
 }
 
-void WorldRenderContext::UploadStarsStart(
-    size_t uploadCount,
-    size_t totalCount)
+void WorldRenderContext::UploadStarsStart(size_t starCount)
 {
     //
-    // Stars are sticky: we upload them once in a while and
-    // continue drawing the same buffer, eventually updating
-    // a prefix of it
+    // Stars are sticky: we upload them only when the star field
+    // changes, and continue drawing the same buffer; the moving
+    // star lives in its own buffer, so that this one is never
+    // written to while being drawn
     //
 
-    mStarVertexBuffer.ensure_size_fill(totalCount);
-    mDirtyStarsCount = uploadCount;
+    mStarVertexBuffer.ensure_size_fill(starCount);
+    mIsStarVertexBufferDirty = true;
 }
 
 void WorldRenderContext::UploadStarsEnd()
@@ -612,14 +679,12 @@ void WorldRenderContext::UploadStarsEnd()
 void WorldRenderContext::UploadLightningsStart(size_t lightningCount)
 {
     //
-    // Lightnings are not sticky: we upload them at each frame,
-    // though they will be empty most of the time
+    // Lightnings are sticky: we only get them when they come and go,
+    // and we animate them ourselves at each frame
     //
 
-    mLightningVertexBuffer.reset_fill(6 * lightningCount);
-
-    mBackgroundLightningVertexCount = 0;
-    mForegroundLightningVertexCount = 0;
+    mLightnings.clear();
+    mLightnings.reserve(lightningCount);
 }
 
 void WorldRenderContext::UploadLightningsEnd()
@@ -633,7 +698,7 @@ void WorldRenderContext::UploadCloudsStart(size_t cloudCount)
     // Clouds are not sticky: we upload them at each frame
     //
 
-    mCloudVertexBuffer.reset(6 * cloudCount);
+    mCloudVertexBuffer.reset(4 * cloudCount);
 }
 
 void WorldRenderContext::UploadCloudsEnd()
@@ -644,7 +709,8 @@ void WorldRenderContext::UploadCloudsEnd()
 void WorldRenderContext::UploadLandStart(size_t slices)
 {
     //
-    // Last segments are not sticky: we upload them at each frame
+    // Land segments are sticky: we get them all only when the visible
+    // world changes, and in-between we get updates of single slices
     //
 
     mLandSegmentBuffer.reset(slices + 1);
@@ -652,16 +718,21 @@ void WorldRenderContext::UploadLandStart(size_t slices)
 
 void WorldRenderContext::UploadLandEnd()
 {
-    // Nop
+    mLandSegmentBufferDirtyRange.Add(0, static_cast<ElementIndex>(mLandSegmentBuffer.size()));
 }
 
-void WorldRenderContext::UploadOceanBasicStart(size_t slices)
+void WorldRenderContext::UploadOceanBasicStart(
+    size_t slices,
+    RenderParameters const & renderParameters)
 {
     //
     // Ocean segments are not sticky: we upload them at each frame
     //
 
     mOceanBasicSegmentBuffer.reset(slices + 1);
+
+    mOceanUploadVisibleWorldBottomY = renderParameters.View.GetVisibleWorld().BottomRight.y;
+    mOceanUploadIsTextureMode = (renderParameters.OceanRenderMode == OceanRenderModeType::Texture);
 }
 
 void WorldRenderContext::UploadOceanBasicEnd()
@@ -669,13 +740,18 @@ void WorldRenderContext::UploadOceanBasicEnd()
     // Nop
 }
 
-void WorldRenderContext::UploadOceanDetailedStart(size_t slices)
+void WorldRenderContext::UploadOceanDetailedStart(
+    size_t slices,
+    RenderParameters const & renderParameters)
 {
     //
     // Ocean segments are not sticky: we upload them at each frame
     //
 
     mOceanDetailedSegmentBuffer.reset(slices + 1);
+
+    mOceanUploadVisibleWorldBottomY = renderParameters.View.GetVisibleWorld().BottomRight.y;
+    mOceanUploadIsTextureMode = (renderParameters.OceanRenderMode == OceanRenderModeType::Texture);
 }
 
 void WorldRenderContext::UploadOceanDetailedEnd()
@@ -689,7 +765,7 @@ void WorldRenderContext::UploadFishesStart(size_t fishCount)
     // Fishes are not sticky: we upload them at each frame
     //
 
-    mFishVertexBuffer.reset(6 * fishCount);
+    mFishVertexBuffer.reset(4 * fishCount);
 }
 
 void WorldRenderContext::UploadFishesEnd()
@@ -761,28 +837,27 @@ void WorldRenderContext::ProcessParameterChanges(RenderParameters const & render
 
 void WorldRenderContext::RenderPrepareStars(RenderParameters const & /*renderParameters*/)
 {
-    if (mDirtyStarsCount > 0)
+    if (mIsStarVertexBufferDirty)
     {
         glBindBuffer(GL_ARRAY_BUFFER, *mStarVBO);
 
-        if (mStarVBOAllocatedVertexSize != mStarVertexBuffer.size())
-        {
-            // Re-allocate VBO buffer and upload entire buffer
-            glBufferData(GL_ARRAY_BUFFER, mStarVertexBuffer.size() * sizeof(StarVertex), mStarVertexBuffer.data(), GL_STATIC_DRAW);
-            CheckOpenGLError();
-
-            mStarVBOAllocatedVertexSize = mStarVertexBuffer.size();
-        }
-        else
-        {
-            // No size change, just upload VBO buffer prefix
-            glBufferSubData(GL_ARRAY_BUFFER, 0, mDirtyStarsCount * sizeof(StarVertex), mStarVertexBuffer.data());
-            CheckOpenGLError();
-        }
+        // Re-allocate VBO buffer and upload entire buffer
+        glBufferData(GL_ARRAY_BUFFER, mStarVertexBuffer.size() * sizeof(StarVertex), mStarVertexBuffer.data(), GL_STATIC_DRAW);
+        CheckOpenGLError();
 
         glBindBuffer(GL_ARRAY_BUFFER, 0);
 
-        mDirtyStarsCount = 0;
+        mIsStarVertexBufferDirty = false;
+    }
+
+    if (mMovingStarVertex.has_value())
+    {
+        glBindBuffer(GL_ARRAY_BUFFER, *mMovingStarVBO);
+
+        glBufferSubData(GL_ARRAY_BUFFER, 0, sizeof(StarVertex), &(*mMovingStarVertex));
+        CheckOpenGLError();
+
+        glBindBuffer(GL_ARRAY_BUFFER, 0);
     }
 }
 
@@ -801,12 +876,86 @@ void WorldRenderContext::RenderDrawStars(RenderParameters const & /*renderParame
 
         glBindVertexArray(0);
     }
+
+    if (mMovingStarVertex.has_value())
+    {
+        glBindVertexArray(*mMovingStarVAO);
+
+        mShaderManager.ActivateProgram<ProgramType::Stars>();
+
+        glPointSize(0.5f);
+
+        glDrawArrays(GL_POINTS, 0, 1);
+        CheckOpenGLError();
+
+        glBindVertexArray(0);
+    }
 }
 
-void WorldRenderContext::RenderPrepareLightnings(RenderParameters const & /*renderParameters*/)
+void WorldRenderContext::RenderPrepareLightnings(RenderParameters const & renderParameters)
 {
-    if (!mLightningVertexBuffer.empty())
+    mBackgroundLightningVertexCount = 0;
+    mForegroundLightningVertexCount = 0;
+
+    if (!mLightnings.empty())
     {
+        //
+        // Build vertices, with background lightnings at the front of the buffer
+        // and foreground lightnings at its back
+        //
+
+        mLightningVertexBuffer.reset_fill(6 * mLightnings.size());
+
+        float const now = GameWallClock::GetInstance().NowAsFloat();
+
+        // Get NDC coordinates of world y=0 (i.e. sea level)
+        float const ndcSeaLevel = renderParameters.View.WorldToNdc(vec2f::zero()).y;
+
+        for (auto const & lightning : mLightnings)
+        {
+            float const progress = Clamp((now - lightning.StartTime) / lightning.Duration, 0.0f, 1.0f);
+
+            // Complete vertical development at t=0.3
+            float const renderProgress = SmoothStep(-0.1f, 0.3f, progress);
+
+            if (lightning.IsForeground)
+            {
+                // Get NDC coordinates of tip point, a few metres down,
+                // to make sure tip touches visually the point
+                vec2f const ndcTip = renderParameters.View.WorldToNdc(
+                    lightning.Position
+                    + vec2f(0.0f, -3.0f));
+
+                if (StoreLightningVertices(
+                    ndcTip.x,
+                    ndcTip.y,
+                    progress,
+                    renderProgress,
+                    lightning.PersonalitySeed,
+                    mLightningVertexBuffer.max_size() - (mForegroundLightningVertexCount + 6)))
+                {
+                    mForegroundLightningVertexCount += 6;
+                }
+            }
+            else
+            {
+                if (StoreLightningVertices(
+                    lightning.Position.x,
+                    ndcSeaLevel,
+                    progress,
+                    renderProgress,
+                    lightning.PersonalitySeed,
+                    mBackgroundLightningVertexCount))
+                {
+                    mBackgroundLightningVertexCount += 6;
+                }
+            }
+        }
+
+        //
+        // Upload
+        //
+
         glBindBuffer(GL_ARRAY_BUFFER, *mLightningVBO);
 
         if (mLightningVertexBuffer.max_size() > mLightningVBOAllocatedVertexSize)
@@ -830,6 +979,8 @@ void WorldRenderContext::RenderPrepareLightnings(RenderParameters const & /*rend
 
 void WorldRenderContext::RenderPrepareClouds(RenderParameters const & /*renderParameters*/)
 {
+    EnsureQuadElementVBOSize(mCloudVertexBuffer.size() / 4);
+
     glBindBuffer(GL_ARRAY_BUFFER, *mCloudVBO);
 
     if (mCloudVertexBuffer.size() > mCloudVBOAllocatedVertexSize)
@@ -859,10 +1010,11 @@ void WorldRenderContext::RenderDrawCloudsAndBackgroundLightnings(RenderParameter
     // The number of clouds we want to draw *over* background
     // lightnings
     size_t constexpr CloudsOverLightnings = 5;
-    GLsizei cloudsOverLightningVertexStart = 0;
+    size_t const cloudCount = mCloudVertexBuffer.size() / 4;
+    size_t cloudsOverLightningStart = 0;
 
     if (mBackgroundLightningVertexCount > 0
-        && mCloudVertexBuffer.size() > 6 * CloudsOverLightnings)
+        && cloudCount > CloudsOverLightnings)
     {
         glBindVertexArray(*mCloudVAO);
 
@@ -871,9 +1023,13 @@ void WorldRenderContext::RenderDrawCloudsAndBackgroundLightnings(RenderParameter
         if (renderParameters.DebugShipRenderMode == DebugShipRenderModeType::Wireframe)
             glLineWidth(0.1f);
 
-        cloudsOverLightningVertexStart = static_cast<GLsizei>(mCloudVertexBuffer.size()) - (6 * CloudsOverLightnings);
+        cloudsOverLightningStart = cloudCount - CloudsOverLightnings;
 
-        glDrawArrays(GL_TRIANGLES, 0, cloudsOverLightningVertexStart);
+        glDrawElements(
+            GL_TRIANGLES,
+            static_cast<GLsizei>(6 * cloudsOverLightningStart),
+            GL_UNSIGNED_INT,
+            (GLvoid *)0);
         CheckOpenGLError();
     }
 
@@ -897,7 +1053,7 @@ void WorldRenderContext::RenderDrawCloudsAndBackgroundLightnings(RenderParameter
     // Draw foreground clouds
     ////////////////////////////////////////////////////
 
-    if (mCloudVertexBuffer.size() > static_cast<size_t>(cloudsOverLightningVertexStart))
+    if (cloudCount > cloudsOverLightningStart)
     {
         glBindVertexArray(*mCloudVAO);
 
@@ -906,7 +1062,11 @@ void WorldRenderContext::RenderDrawCloudsAndBackgroundLightnings(RenderParameter
         if (renderParameters.DebugShipRenderMode == DebugShipRenderModeType::Wireframe)
             glLineWidth(0.1f);
 
-        glDrawArrays(GL_TRIANGLES, cloudsOverLightningVertexStart, static_cast<GLsizei>(mCloudVertexBuffer.size()) - cloudsOverLightningVertexStart);
+        glDrawElements(
+            GL_TRIANGLES,
+            static_cast<GLsizei>(6 * (cloudCount - cloudsOverLightningStart)),
+            GL_UNSIGNED_INT,
+            (GLvoid *)(6 * cloudsOverLightningStart * sizeof(GLuint)));
         CheckOpenGLError();
     }
 
@@ -1075,6 +1235,12 @@ void WorldRenderContext::RenderDrawOcean(bool opaquely, RenderParameters const &
 
 void WorldRenderContext::RenderPrepareOceanFloor(RenderParameters const & /*renderParameters*/)
 {
+    if (mLandSegmentBufferDirtyRange.IsEmpty())
+    {
+        // Nothing changed since last time
+        return;
+    }
+
     glBindBuffer(GL_ARRAY_BUFFER, *mLandSegmentVBO);
 
     if (mLandSegmentVBOAllocatedVertexSize != mLandSegmentBuffer.size())
@@ -1087,12 +1253,18 @@ void WorldRenderContext::RenderPrepareOceanFloor(RenderParameters const & /*rend
     }
     else
     {
-        // No size change, just upload VBO buffer
-        glBufferSubData(GL_ARRAY_BUFFER, 0, mLandSegmentBuffer.size() * sizeof(LandSegment), mLandSegmentBuffer.data());
+        // No size change, just upload the dirty portion of the VBO buffer
+        glBufferSubData(
+            GL_ARRAY_BUFFER,
+            mLandSegmentBufferDirtyRange.GetStart() * sizeof(LandSegment),
+            mLandSegmentBufferDirtyRange.GetSize() * sizeof(LandSegment),
+            mLandSegmentBuffer.data() + mLandSegmentBufferDirtyRange.GetStart());
         CheckOpenGLError();
     }
 
     glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+    mLandSegmentBufferDirtyRange.Clear();
 }
 
 void WorldRenderContext::RenderDrawOceanFloor(RenderParameters const & renderParameters)
@@ -1124,6 +1296,8 @@ void WorldRenderContext::RenderDrawOceanFloor(RenderParameters const & renderPar
 
 void WorldRenderContext::RenderPrepareFishes(RenderParameters const & /*renderParameters*/)
 {
+    EnsureQuadElementVBOSize(mFishVertexBuffer.size() / 4);
+
     glBindBuffer(GL_ARRAY_BUFFER, *mFishVBO);
 
     if (mFishVertexBuffer.size() > mFishVBOAllocatedVertexSize)
@@ -1152,7 +1326,11 @@ void WorldRenderContext::RenderDrawFishes(RenderParameters const & /*renderParam
 
         mShaderManager.ActivateProgram<ProgramType::Fishes>();
 
-        glDrawArrays(GL_TRIANGLES, 0, static_cast<GLsizei>(mFishVertexBuffer.size()));
+        glDrawElements(
+            GL_TRIANGLES,
+            static_cast<GLsizei>(6 * (mFishVertexBuffer.size() / 4)),
+            GL_UNSIGNED_INT,
+            (GLvoid *)0);
         CheckOpenGLError();
 
         glBindVertexArray(0);
@@ -1389,67 +1567,67 @@ void WorldRenderContext::ApplyViewModelChanges(RenderParameters const & renderPa
     ViewModel::ProjectionMatrix globalOrthoMatrix;
     renderParameters.View.CalculateGlobalOrthoMatrix(ZFar, ZNear, globalOrthoMatrix);
 
-    mShaderManager.ActivateProgram<ProgramType::LandFlat>();
+    mShaderManager.ActivateProgramForParameters<ProgramType::LandFlat>();
     mShaderManager.SetProgramParameter<ProgramType::LandFlat, ProgramParameterType::OrthoMatrix>(
         globalOrthoMatrix);
 
-    mShaderManager.ActivateProgram<ProgramType::LandTexture>();
+    mShaderManager.ActivateProgramForParameters<ProgramType::LandTexture>();
     mShaderManager.SetProgramParameter<ProgramType::LandTexture, ProgramParameterType::OrthoMatrix>(
         globalOrthoMatrix);
 
-    mShaderManager.ActivateProgram<ProgramType::OceanDepthBasic>();
+    mShaderManager.ActivateProgramForParameters<ProgramType::OceanDepthBasic>();
     mShaderManager.SetProgramParameter<ProgramType::OceanDepthBasic, ProgramParameterType::OrthoMatrix>(
         globalOrthoMatrix);
 
-    mShaderManager.ActivateProgram<ProgramType::OceanDepthDetailedBackground>();
+    mShaderManager.ActivateProgramForParameters<ProgramType::OceanDepthDetailedBackground>();
     mShaderManager.SetProgramParameter<ProgramType::OceanDepthDetailedBackground, ProgramParameterType::OrthoMatrix>(
         globalOrthoMatrix);
 
-    mShaderManager.ActivateProgram<ProgramType::OceanDepthDetailedForeground>();
+    mShaderManager.ActivateProgramForParameters<ProgramType::OceanDepthDetailedForeground>();
     mShaderManager.SetProgramParameter<ProgramType::OceanDepthDetailedForeground, ProgramParameterType::OrthoMatrix>(
         globalOrthoMatrix);
 
-    mShaderManager.ActivateProgram<ProgramType::OceanFlatBasic>();
+    mShaderManager.ActivateProgramForParameters<ProgramType::OceanFlatBasic>();
     mShaderManager.SetProgramParameter<ProgramType::OceanFlatBasic, ProgramParameterType::OrthoMatrix>(
         globalOrthoMatrix);
 
-    mShaderManager.ActivateProgram<ProgramType::OceanFlatDetailedBackground>();
+    mShaderManager.ActivateProgramForParameters<ProgramType::OceanFlatDetailedBackground>();
     mShaderManager.SetProgramParameter<ProgramType::OceanFlatDetailedBackground, ProgramParameterType::OrthoMatrix>(
         globalOrthoMatrix);
 
-    mShaderManager.ActivateProgram<ProgramType::OceanFlatDetailedForeground>();
+    mShaderManager.ActivateProgramForParameters<ProgramType::OceanFlatDetailedForeground>();
     mShaderManager.SetProgramParameter<ProgramType::OceanFlatDetailedForeground, ProgramParameterType::OrthoMatrix>(
         globalOrthoMatrix);
 
-    mShaderManager.ActivateProgram<ProgramType::OceanTextureBasic>();
+    mShaderManager.ActivateProgramForParameters<ProgramType::OceanTextureBasic>();
     mShaderManager.SetProgramParameter<ProgramType::OceanTextureBasic, ProgramParameterType::OrthoMatrix>(
         globalOrthoMatrix);
 
-    mShaderManager.ActivateProgram<ProgramType::OceanTextureDetailedBackground>();
+    mShaderManager.ActivateProgramForParameters<ProgramType::OceanTextureDetailedBackground>();
     mShaderManager.SetProgramParameter<ProgramType::OceanTextureDetailedBackground, ProgramParameterType::OrthoMatrix>(
         globalOrthoMatrix);
 
-    mShaderManager.ActivateProgram<ProgramType::OceanTextureDetailedForeground>();
+    mShaderManager.ActivateProgramForParameters<ProgramType::OceanTextureDetailedForeground>();
     mShaderManager.SetProgramParameter<ProgramType::OceanTextureDetailedForeground, ProgramParameterType::OrthoMatrix>(
         globalOrthoMatrix);
 
-    mShaderManager.ActivateProgram<ProgramType::Fishes>();
+    mShaderManager.ActivateProgramForParameters<ProgramType::Fishes>();
     mShaderManager.SetProgramParameter<ProgramType::Fishes, ProgramParameterType::OrthoMatrix>(
         globalOrthoMatrix);
 
-    mShaderManager.ActivateProgram<ProgramType::AMBombPreImplosion>();
+    mShaderManager.ActivateProgramForParameters<ProgramType::AMBombPreImplosion>();
     mShaderManager.SetProgramParameter<ProgramType::AMBombPreImplosion, ProgramParameterType::OrthoMatrix>(
         globalOrthoMatrix);
 
-    mShaderManager.ActivateProgram<ProgramType::CrossOfLight>();
+    mShaderManager.ActivateProgramForParameters<ProgramType::CrossOfLight>();
     mShaderManager.SetProgramParameter<ProgramType::CrossOfLight, ProgramParameterType::OrthoMatrix>(
         globalOrthoMatrix);
 
-    mShaderManager.ActivateProgram<ProgramType::AABBs>();
+    mShaderManager.ActivateProgramForParameters<ProgramType::AABBs>();
     mShaderManager.SetProgramParameter<ProgramType::AABBs, ProgramParameterType::OrthoMatrix>(
         globalOrthoMatrix);
 
-    mShaderManager.ActivateProgram<ProgramType::WorldBorder>();
+    mShaderManager.ActivateProgramForParameters<ProgramType::WorldBorder>();
     mShaderManager.SetProgramParameter<ProgramType::WorldBorder, ProgramParameterType::OrthoMatrix>(
         globalOrthoMatrix);
 
@@ -1477,10 +1655,10 @@ void WorldRenderContext::ApplyCanvasSizeChanges(RenderParameters const & renderP
         static_cast<float>(view.GetCanvasPhysicalSize().width),
         static_cast<float>(view.GetCanvasPhysicalSize().height));
 
-    mShaderManager.ActivateProgram<ProgramType::CrossOfLight>();
+    mShaderManager.ActivateProgramForParameters<ProgramType::CrossOfLight>();
     mShaderManager.SetProgramParameter<ProgramType::CrossOfLight, ProgramParameterType::ViewportSize>(viewportSize);
 
-    mShaderManager.ActivateProgram<ProgramType::Rain>();
+    mShaderManager.ActivateProgramForParameters<ProgramType::Rain>();
     mShaderManager.SetProgramParameter<ProgramType::Rain, ProgramParameterType::ViewportSize>(viewportSize);
 }
 
@@ -1488,71 +1666,71 @@ void WorldRenderContext::ApplyEffectiveAmbientLightIntensityChanges(RenderParame
 {
     // Set parameters in all programs
 
-    mShaderManager.ActivateProgram<ProgramType::Stars>();
+    mShaderManager.ActivateProgramForParameters<ProgramType::Stars>();
     mShaderManager.SetProgramParameter<ProgramType::Stars, ProgramParameterType::StarTransparency>(
         pow(std::max(0.0f, 1.0f - renderParameters.EffectiveAmbientLightIntensity), 3.0f));
 
-    mShaderManager.ActivateProgram<ProgramType::Clouds>();
+    mShaderManager.ActivateProgramForParameters<ProgramType::Clouds>();
     mShaderManager.SetProgramParameter<ProgramType::Clouds, ProgramParameterType::EffectiveAmbientLightIntensity>(
         renderParameters.EffectiveAmbientLightIntensity);
 
-    mShaderManager.ActivateProgram<ProgramType::Lightning>();
+    mShaderManager.ActivateProgramForParameters<ProgramType::Lightning>();
     mShaderManager.SetProgramParameter<ProgramType::Lightning, ProgramParameterType::EffectiveAmbientLightIntensity>(
         renderParameters.EffectiveAmbientLightIntensity);
 
-    mShaderManager.ActivateProgram<ProgramType::LandFlat>();
+    mShaderManager.ActivateProgramForParameters<ProgramType::LandFlat>();
     mShaderManager.SetProgramParameter<ProgramType::LandFlat, ProgramParameterType::EffectiveAmbientLightIntensity>(
         renderParameters.EffectiveAmbientLightIntensity);
 
-    mShaderManager.ActivateProgram<ProgramType::LandTexture>();
+    mShaderManager.ActivateProgramForParameters<ProgramType::LandTexture>();
     mShaderManager.SetProgramParameter<ProgramType::LandTexture, ProgramParameterType::EffectiveAmbientLightIntensity>(
         renderParameters.EffectiveAmbientLightIntensity);
 
-    mShaderManager.ActivateProgram<ProgramType::OceanDepthBasic>();
+    mShaderManager.ActivateProgramForParameters<ProgramType::OceanDepthBasic>();
     mShaderManager.SetProgramParameter<ProgramType::OceanDepthBasic, ProgramParameterType::EffectiveAmbientLightIntensity>(
         renderParameters.EffectiveAmbientLightIntensity);
 
-    mShaderManager.ActivateProgram<ProgramType::OceanDepthDetailedBackground>();
+    mShaderManager.ActivateProgramForParameters<ProgramType::OceanDepthDetailedBackground>();
     mShaderManager.SetProgramParameter<ProgramType::OceanDepthDetailedBackground, ProgramParameterType::EffectiveAmbientLightIntensity>(
         renderParameters.EffectiveAmbientLightIntensity);
 
-    mShaderManager.ActivateProgram<ProgramType::OceanDepthDetailedForeground>();
+    mShaderManager.ActivateProgramForParameters<ProgramType::OceanDepthDetailedForeground>();
     mShaderManager.SetProgramParameter<ProgramType::OceanDepthDetailedForeground, ProgramParameterType::EffectiveAmbientLightIntensity>(
         renderParameters.EffectiveAmbientLightIntensity);
 
-    mShaderManager.ActivateProgram<ProgramType::OceanFlatBasic>();
+    mShaderManager.ActivateProgramForParameters<ProgramType::OceanFlatBasic>();
     mShaderManager.SetProgramParameter<ProgramType::OceanFlatBasic, ProgramParameterType::EffectiveAmbientLightIntensity>(
         renderParameters.EffectiveAmbientLightIntensity);
 
-    mShaderManager.ActivateProgram<ProgramType::OceanFlatDetailedBackground>();
+    mShaderManager.ActivateProgramForParameters<ProgramType::OceanFlatDetailedBackground>();
     mShaderManager.SetProgramParameter<ProgramType::OceanFlatDetailedBackground, ProgramParameterType::EffectiveAmbientLightIntensity>(
         renderParameters.EffectiveAmbientLightIntensity);
 
-    mShaderManager.ActivateProgram<ProgramType::OceanFlatDetailedForeground>();
+    mShaderManager.ActivateProgramForParameters<ProgramType::OceanFlatDetailedForeground>();
     mShaderManager.SetProgramParameter<ProgramType::OceanFlatDetailedForeground, ProgramParameterType::EffectiveAmbientLightIntensity>(
         renderParameters.EffectiveAmbientLightIntensity);
 
-    mShaderManager.ActivateProgram<ProgramType::OceanTextureBasic>();
+    mShaderManager.ActivateProgramForParameters<ProgramType::OceanTextureBasic>();
     mShaderManager.SetProgramParameter<ProgramType::OceanTextureBasic, ProgramParameterType::EffectiveAmbientLightIntensity>(
         renderParameters.EffectiveAmbientLightIntensity);
 
-    mShaderManager.ActivateProgram<ProgramType::OceanTextureDetailedBackground>();
+    mShaderManager.ActivateProgramForParameters<ProgramType::OceanTextureDetailedBackground>();
     mShaderManager.SetProgramParameter<ProgramType::OceanTextureDetailedBackground, ProgramParameterType::EffectiveAmbientLightIntensity>(
         renderParameters.EffectiveAmbientLightIntensity);
 
-    mShaderManager.ActivateProgram<ProgramType::OceanTextureDetailedForeground>();
+    mShaderManager.ActivateProgramForParameters<ProgramType::OceanTextureDetailedForeground>();
     mShaderManager.SetProgramParameter<ProgramType::OceanTextureDetailedForeground, ProgramParameterType::EffectiveAmbientLightIntensity>(
         renderParameters.EffectiveAmbientLightIntensity);
 
-    mShaderManager.ActivateProgram<ProgramType::Fishes>();
+    mShaderManager.ActivateProgramForParameters<ProgramType::Fishes>();
     mShaderManager.SetProgramParameter<ProgramType::Fishes, ProgramParameterType::EffectiveAmbientLightIntensity>(
         renderParameters.EffectiveAmbientLightIntensity);
 
-    mShaderManager.ActivateProgram<ProgramType::Rain>();
+    mShaderManager.ActivateProgramForParameters<ProgramType::Rain>();
     mShaderManager.SetProgramParameter<ProgramType::Rain, ProgramParameterType::EffectiveAmbientLightIntensity>(
         renderParameters.EffectiveAmbientLightIntensity);
 
-    mShaderManager.ActivateProgram<ProgramType::WorldBorder>();
+    mShaderManager.ActivateProgramForParameters<ProgramType::WorldBorder>();
     mShaderManager.SetProgramParameter<ProgramType::WorldBorder, ProgramParameterType::EffectiveAmbientLightIntensity>(
         renderParameters.EffectiveAmbientLightIntensity);
 }
@@ -1563,35 +1741,35 @@ void WorldRenderContext::ApplyOceanDarkeningRateChanges(RenderParameters const &
 
     float const rate = renderParameters.OceanDarkeningRate / 50.0f;
 
-    mShaderManager.ActivateProgram<ProgramType::LandTexture>();
+    mShaderManager.ActivateProgramForParameters<ProgramType::LandTexture>();
     mShaderManager.SetProgramParameter<ProgramType::LandTexture, ProgramParameterType::OceanDarkeningRate>(
         rate);
 
-    mShaderManager.ActivateProgram<ProgramType::OceanDepthBasic>();
+    mShaderManager.ActivateProgramForParameters<ProgramType::OceanDepthBasic>();
     mShaderManager.SetProgramParameter<ProgramType::OceanDepthBasic, ProgramParameterType::OceanDarkeningRate>(
         rate);
 
-    mShaderManager.ActivateProgram<ProgramType::OceanDepthDetailedBackground>();
+    mShaderManager.ActivateProgramForParameters<ProgramType::OceanDepthDetailedBackground>();
     mShaderManager.SetProgramParameter<ProgramType::OceanDepthDetailedBackground, ProgramParameterType::OceanDarkeningRate>(
         rate);
 
-    mShaderManager.ActivateProgram<ProgramType::OceanDepthDetailedForeground>();
+    mShaderManager.ActivateProgramForParameters<ProgramType::OceanDepthDetailedForeground>();
     mShaderManager.SetProgramParameter<ProgramType::OceanDepthDetailedForeground, ProgramParameterType::OceanDarkeningRate>(
         rate);
 
-    mShaderManager.ActivateProgram<ProgramType::OceanTextureBasic>();
+    mShaderManager.ActivateProgramForParameters<ProgramType::OceanTextureBasic>();
     mShaderManager.SetProgramParameter<ProgramType::OceanTextureBasic, ProgramParameterType::OceanDarkeningRate>(
         rate);
 
-    mShaderManager.ActivateProgram<ProgramType::OceanTextureDetailedBackground>();
+    mShaderManager.ActivateProgramForParameters<ProgramType::OceanTextureDetailedBackground>();
     mShaderManager.SetProgramParameter<ProgramType::OceanTextureDetailedBackground, ProgramParameterType::OceanDarkeningRate>(
         rate);
 
-    mShaderManager.ActivateProgram<ProgramType::OceanTextureDetailedForeground>();
+    mShaderManager.ActivateProgramForParameters<ProgramType::OceanTextureDetailedForeground>();
     mShaderManager.SetProgramParameter<ProgramType::OceanTextureDetailedForeground, ProgramParameterType::OceanDarkeningRate>(
         rate);
 
-    mShaderManager.ActivateProgram<ProgramType::Fishes>();
+    mShaderManager.ActivateProgramForParameters<ProgramType::Fishes>();
     mShaderManager.SetProgramParameter<ProgramType::Fishes, ProgramParameterType::OceanDarkeningRate>(
         rate);
 }
@@ -1602,98 +1780,80 @@ void WorldRenderContext::ApplyOceanRenderModeParametersChanges(RenderParameters
 
     vec3f const depthColorStart = renderParameters.DepthOceanColorStart.toVec3f();
 
-    mShaderManager.ActivateProgram<ProgramType::OceanDepthBasic>();
+    mShaderManager.ActivateProgramForParameters<ProgramType::OceanDepthBasic>();
     mShaderManager.SetProgramParameter<ProgramType::OceanDepthBasic, ProgramParameterType::OceanDepthColorStart>(depthColorStart);
     
-    mShaderManager.ActivateProgram<ProgramType::OceanDepthDetailedBackground>();
+    mShaderManager.ActivateProgramForParameters<ProgramType::OceanDepthDetailedBackground>();
     mShaderManager.SetProgramParameter<ProgramType::OceanDepthDetailedBackground, ProgramParameterType::OceanDepthColorStart>(depthColorStart);
 
-    mShaderManager.ActivateProgram<ProgramType::OceanDepthDetailedForeground>();
+    mShaderManager.ActivateProgramForParameters<ProgramType::OceanDepthDetailedForeground>();
     mShaderManager.SetProgramParameter<ProgramType::OceanDepthDetailedForeground, ProgramParameterType::OceanDepthColorStart>(depthColorStart);
 
     vec3f const depthColorEnd = renderParameters.DepthOceanColorEnd.toVec3f();
 
-    mShaderManager.ActivateProgram<ProgramType::OceanDepthBasic>();
+    mShaderManager.ActivateProgramForParameters<ProgramType::OceanDepthBasic>();
     mShaderManager.SetProgramParameter<ProgramType::OceanDepthBasic, ProgramParameterType::OceanDepthColorEnd>(depthColorEnd);
 
-    mShaderManager.ActivateProgram<ProgramType::OceanDepthDetailedBackground>();
+    mShaderManager.ActivateProgramForParameters<ProgramType::OceanDepthDetailedBackground>();
     mShaderManager.SetProgramParameter<ProgramType::OceanDepthDetailedBackground, ProgramParameterType::OceanDepthColorEnd>(depthColorEnd);
 
-    mShaderManager.ActivateProgram<ProgramType::OceanDepthDetailedForeground>();
+    mShaderManager.ActivateProgramForParameters<ProgramType::OceanDepthDetailedForeground>();
     mShaderManager.SetProgramParameter<ProgramType::OceanDepthDetailedForeground, ProgramParameterType::OceanDepthColorEnd>(depthColorEnd);
 
     vec3f const flatColor = renderParameters.FlatOceanColor.toVec3f();
 
-    mShaderManager.ActivateProgram<ProgramType::OceanFlatBasic>();
+    mShaderManager.ActivateProgramForParameters<ProgramType::OceanFlatBasic>();
     mShaderManager.SetProgramParameter<ProgramType::OceanFlatBasic, ProgramParameterType::OceanFlatColor>(flatColor);
 
-    mShaderManager.ActivateProgram<ProgramType::OceanFlatDetailedBackground>();
+    mShaderManager.ActivateProgramForParameters<ProgramType::OceanFlatDetailedBackground>();
     mShaderManager.SetProgramParameter<ProgramType::OceanFlatDetailedBackground, ProgramParameterType::OceanFlatColor>(flatColor);
 
-    mShaderManager.ActivateProgram<ProgramType::OceanFlatDetailedForeground>();
+    mShaderManager.ActivateProgramForParameters<ProgramType::OceanFlatDetailedForeground>();
     mShaderManager.SetProgramParameter<ProgramType::OceanFlatDetailedForeground, ProgramParameterType::OceanFlatColor>(flatColor);
 }
 
 void WorldRenderContext::ApplyOceanTextureIndexChanges(RenderParameters const & renderParameters)
 {
     //
-    // Reload the ocean texture
+    // Switch the ocean texture, uploading it if it's not resident
     //
 
-    // Destroy previous texture
-    mOceanTextureOpenGLHandle.reset();
-
     // Clamp the texture index
     auto clampedOceanTextureIndex = std::min(renderParameters.OceanTextureIndex, mOceanTextureFrameSpecifications.size() - 1);
 
-    // Load texture image
-    auto oceanTextureFrame = mOceanTextureFrameSpecifications[clampedOceanTextureIndex].LoadFrame();
+    auto const & oceanTextureFrameSpecification = mOceanTextureFrameSpecifications[clampedOceanTextureIndex];
 
     // Activate texture
     mShaderManager.ActivateTexture<ProgramParameterType::OceanTexture>();
 
-    // Create texture
-    GLuint tmpGLuint;
-    glGenTextures(1, &tmpGLuint);
-    mOceanTextureOpenGLHandle = tmpGLuint;
+    // Make texture resident
+    GLuint const oceanTextureOpenGLHandle = mUploadedWorldTextureManager.EnsureMipmappedFrameResident(
+        oceanTextureFrameSpecification,
+        GL_RGB8,
+        GL_LINEAR_MIPMAP_NEAREST);
 
     // Bind texture
-    glBindTexture(GL_TEXTURE_2D, *mOceanTextureOpenGLHandle);
-    CheckOpenGLError();
-
-    // Upload texture
-    GameOpenGL::UploadMipmappedTexture(
-        std::move(oceanTextureFrame.TextureData),
-        GL_RGB8);
-
-    // Set repeat mode
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
-    CheckOpenGLError();
-
-    // Set filtering
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_NEAREST);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    glBindTexture(GL_TEXTURE_2D, oceanTextureOpenGLHandle);
     CheckOpenGLError();
 
     // Set texture and texture parameters in shaders
 
-    mShaderManager.ActivateProgram<ProgramType::OceanTextureBasic>();
+    mShaderManager.ActivateProgramForParameters<ProgramType::OceanTextureBasic>();
     mShaderManager.SetProgramParameter<ProgramType::OceanTextureBasic, ProgramParameterType::TextureScaling>(
-        1.0f / oceanTextureFrame.Metadata.WorldWidth,
-        1.0f / oceanTextureFrame.Metadata.WorldHeight);
+        1.0f / oceanTextureFrameSpecification.Metadata.WorldWidth,
+        1.0f / oceanTextureFrameSpecification.Metadata.WorldHeight);
     mShaderManager.SetTextureParameters<ProgramType::OceanTextureBasic>();
 
-    mShaderManager.ActivateProgram<ProgramType::OceanTextureDetailedBackground>();
+    mShaderManager.ActivateProgramForParameters<ProgramType::OceanTextureDetailedBackground>();
     mShaderManager.SetProgramParameter<ProgramType::OceanTextureDetailedBackground, ProgramParameterType::TextureScaling>(
-        1.0f / oceanTextureFrame.Metadata.WorldWidth,
-        1.0f / oceanTextureFrame.Metadata.WorldHeight);
+        1.0f / oceanTextureFrameSpecification.Metadata.WorldWidth,
+        1.0f / oceanTextureFrameSpecification.Metadata.WorldHeight);
     mShaderManager.SetTextureParameters<ProgramType::OceanTextureDetailedBackground>();
 
-    mShaderManager.ActivateProgram<ProgramType::OceanTextureDetailedForeground>();
+    mShaderManager.ActivateProgramForParameters<ProgramType::OceanTextureDetailedForeground>();
     mShaderManager.SetProgramParameter<ProgramType::OceanTextureDetailedForeground, ProgramParameterType::TextureScaling>(
-        1.0f / oceanTextureFrame.Metadata.WorldWidth,
-        1.0f / oceanTextureFrame.Metadata.WorldHeight);
+        1.0f / oceanTextureFrameSpecification.Metadata.WorldWidth,
+        1.0f / oceanTextureFrameSpecification.Metadata.WorldHeight);
     mShaderManager.SetTextureParameters<ProgramType::OceanTextureDetailedForeground>();
 }
 
@@ -1703,57 +1863,39 @@ void WorldRenderContext::ApplyLandRenderParametersChanges(RenderParameters const
 
     vec3f const flatColor = renderParameters.FlatLandColor.toVec3f();
 
-    mShaderManager.ActivateProgram<ProgramType::LandFlat>();
+    mShaderManager.ActivateProgramForParameters<ProgramType::LandFlat>();
     mShaderManager.SetProgramParameter<ProgramType::LandFlat, ProgramParameterType::LandFlatColor>(flatColor);
 }
 
 void WorldRenderContext::ApplyLandTextureIndexChanges(RenderParameters const & renderParameters)
 {
     //
-    // Reload the land texture
+    // Switch the land texture, uploading it if it's not resident
     //
 
-    // Destroy previous texture
-    mLandTextureOpenGLHandle.reset();
-
     // Clamp the texture index
     auto clampedLandTextureIndex = std::min(renderParameters.LandTextureIndex, mLandTextureFrameSpecifications.size() - 1);
 
-    // Load texture image
-    auto landTextureFrame = mLandTextureFrameSpecifications[clampedLandTextureIndex].LoadFrame();
+    auto const & landTextureFrameSpecification = mLandTextureFrameSpecifications[clampedLandTextureIndex];
 
     // Activate texture
     mShaderManager.ActivateTexture<ProgramParameterType::LandTexture>();
 
-    // Create texture
-    GLuint tmpGLuint;
-    glGenTextures(1, &tmpGLuint);
-    mLandTextureOpenGLHandle = tmpGLuint;
+    // Make texture resident
+    GLuint const landTextureOpenGLHandle = mUploadedWorldTextureManager.EnsureMipmappedFrameResident(
+        landTextureFrameSpecification,
+        GL_RGB8,
+        GL_LINEAR_MIPMAP_NEAREST);
 
     // Bind texture
-    glBindTexture(GL_TEXTURE_2D, *mLandTextureOpenGLHandle);
-    CheckOpenGLError();
-
-    // Upload texture
-    GameOpenGL::UploadMipmappedTexture(
-        std::move(landTextureFrame.TextureData),
-        GL_RGB8);
-
-    // Set repeat mode
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
-    CheckOpenGLError();
-
-    // Set filtering
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_NEAREST);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    glBindTexture(GL_TEXTURE_2D, landTextureOpenGLHandle);
     CheckOpenGLError();
 
     // Set texture and texture parameters in shader
-    mShaderManager.ActivateProgram<ProgramType::LandTexture>();
+    mShaderManager.ActivateProgramForParameters<ProgramType::LandTexture>();
     mShaderManager.SetProgramParameter<ProgramType::LandTexture, ProgramParameterType::TextureScaling>(
-        1.0f / landTextureFrame.Metadata.WorldWidth,
-        1.0f / landTextureFrame.Metadata.WorldHeight);
+        1.0f / landTextureFrameSpecification.Metadata.WorldWidth,
+        1.0f / landTextureFrameSpecification.Metadata.WorldHeight);
     mShaderManager.SetTextureParameters<ProgramType::LandTexture>();
 }
 
@@ -1891,4 +2033,37 @@ void WorldRenderContext::RecalculateWorldBorder(RenderParameters const & renderP
     }
 }
 
+void WorldRenderContext::EnsureQuadElementVBOSize(size_t quadCount)
+{
+    if (quadCount > mQuadElementVBOAllocatedQuadSize)
+    {
+        // Grow generously, as the quad counts keep changing
+        size_t const newQuadSize = std::max(quadCount, mQuadElementVBOAllocatedQuadSize * 2);
+
+        std::vector<GLuint> quadElements;
+        quadElements.reserve(newQuadSize * 6);
+        for (GLuint q = 0; q < static_cast<GLuint>(newQuadSize); ++q)
+        {
+            // top-left, bottom-left, top-right
+            quadElements.push_back(q * 4 + 0);
+            quadElements.push_back(q * 4 + 1);
+            quadElements.push_back(q * 4 + 2);
+
+            // bottom-left, top-right, bottom-right
+            quadElements.push_back(q * 4 + 1);
+            quadElements.push_back(q * 4 + 2);
+            quadElements.push_back(q * 4 + 3);
+        }
+
+        // Upload via the array target, so not to disturb the element binding of
+        // whichever VAO is currently bound
+        glBindBuffer(GL_ARRAY_BUFFER, *mQuadElementVBO);
+        glBufferData(GL_ARRAY_BUFFER, quadElements.size() * sizeof(GLuint), quadElements.data(), GL_STATIC_DRAW);
+        CheckOpenGLError();
+        glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+        mQuadElementVBOAllocatedQuadSize = newQuadSize;
+    }
+}
+
 }
\ No newline at end of file
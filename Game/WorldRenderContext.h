@@ -21,8 +21,10 @@
 #include <GameCore/AABB.h>
 #include <GameCore/BoundedVector.h>
 #include <GameCore/Colors.h>
+#include <GameCore/DirtyRange.h>
 #include <GameCore/GameTypes.h>
 #include <GameCore/ImageData.h>
+#include <GameCore/TaskThreadPool.h>
 #include <GameCore/Vectors.h>
 
 #include <array>
@@ -45,11 +47,15 @@ public:
 
     ~WorldRenderContext();
 
-    void InitializeCloudTextures(ResourceLocator const & resourceLocator);
+    void InitializeCloudTextures(
+        ResourceLocator const & resourceLocator,
+        TaskThreadPool & taskThreadPool);
 
     void InitializeWorldTextures(ResourceLocator const & resourceLocator);
 
-    void InitializeFishTextures(ResourceLocator const & resourceLocator);
+    void InitializeFishTextures(
+        ResourceLocator const & resourceLocator,
+        TaskThreadPool & taskThreadPool);
 
     inline std::vector<std::pair<std::string, RgbaImageData>> const & GetTextureOceanAvailableThumbnails() const
     {
@@ -75,9 +81,7 @@ public:
 
     void UploadStart();
 
-    void UploadStarsStart(
-        size_t uploadCount,
-        size_t totalCount);
+    void UploadStarsStart(size_t starCount);
 
     inline void UploadStar(
         size_t starIndex,
@@ -95,6 +99,13 @@ public:
 
     void UploadStarsEnd();
 
+    inline void UploadMovingStar(
+        vec2f const & positionNdc,
+        float brightness)
+    {
+        mMovingStarVertex.emplace(positionNdc, brightness);
+    }
+
     inline void UploadWind(float smoothedWindSpeedMagnitude)
     {
         mRainWindSpeedMagnitude = smoothedWindSpeedMagnitude;
@@ -129,49 +140,30 @@ public:
 
     inline void UploadBackgroundLightning(
         float ndcX,
-        float progress,
-        float renderProgress,
-        float personalitySeed,
-        RenderParameters const & renderParameters)
+        float startTime,
+        float duration,
+        float personalitySeed)
     {
-        // Get NDC coordinates of world y=0 (i.e. sea level)
-        float const ndcSeaLevel = renderParameters.View.WorldToNdc(vec2f::zero()).y;
-
-        // Store vertices
-        StoreLightningVertices(
-            ndcX,
-            ndcSeaLevel,
-            progress,
-            renderProgress,
-            personalitySeed,
-            mBackgroundLightningVertexCount);
-
-        mBackgroundLightningVertexCount += 6;
+        mLightnings.emplace_back(
+            false,
+            vec2f(ndcX, 0.0f),
+            startTime,
+            duration,
+            personalitySeed);
     }
 
     inline void UploadForegroundLightning(
         vec2f tipWorldCoordinates,
-        float progress,
-        float renderProgress,
-        float personalitySeed,
-        RenderParameters const & renderParameters)
+        float startTime,
+        float duration,
+        float personalitySeed)
     {
-        // Get NDC coordinates of tip point, a few metres down,
-        // to make sure tip touches visually the point
-        vec2f const ndcTip = renderParameters.View.WorldToNdc(
-            tipWorldCoordinates
-            + vec2f(0.0f, -3.0f));
-
-        // Store vertices
-        StoreLightningVertices(
-            ndcTip.x,
-            ndcTip.y,
-            progress,
-            renderProgress,
-            personalitySeed,
-            mLightningVertexBuffer.max_size() - (mForegroundLightningVertexCount + 6));
-
-        mForegroundLightningVertexCount += 6;
+        mLightnings.emplace_back(
+            true,
+            tipWorldCoordinates,
+            startTime,
+            duration,
+            personalitySeed);
     }
 
     void UploadLightningsEnd();
@@ -201,7 +193,7 @@ public:
         float const ndcY = (virtualY - mCloudNormalizedViewCamY) / (ZMin + virtualZ * (ZMax - ZMin));
 
         //
-        // Populate quad in buffer
+        // Populate quad in buffer - the triangles are made via the shared quad elements
         //
 
         size_t const cloudTextureIndex = static_cast<size_t>(cloudId) % mCloudTextureAtlasMetadata->GetFrameMetadata().size();
@@ -241,22 +233,6 @@ public:
             darkening,
             growthProgress);
 
-        // bottom-left
-        mCloudVertexBuffer.emplace_back(
-            vec2f(leftX, bottomY),
-            vec2f(cloudAtlasFrameMetadata.TextureCoordinatesBottomLeft.x, cloudAtlasFrameMetadata.TextureCoordinatesBottomLeft.y),
-            cloudAtlasFrameMetadata.TextureCoordinatesAnchorCenter,
-            darkening,
-            growthProgress);
-
-        // top-right
-        mCloudVertexBuffer.emplace_back(
-            vec2f(rightX, topY),
-            vec2f(cloudAtlasFrameMetadata.TextureCoordinatesTopRight.x, cloudAtlasFrameMetadata.TextureCoordinatesTopRight.y),
-            cloudAtlasFrameMetadata.TextureCoordinatesAnchorCenter,
-            darkening,
-            growthProgress);
-
         // bottom-right
         mCloudVertexBuffer.emplace_back(
             vec2f(rightX, bottomY),
@@ -275,36 +251,45 @@ public:
         float yLand,
         RenderParameters const & renderParameters)
     {
-        float const yVisibleWorldBottom = renderParameters.View.GetVisibleWorld().BottomRight.y;
-
         //
         // Store Land element
         //
 
-        LandSegment & landSegment = mLandSegmentBuffer.emplace_back();
-
-        landSegment.x1 = x;
-        landSegment.y1 = yLand;
-        landSegment.depth1 = 0.0f;
-        landSegment.x2 = x;
-        // If land is invisible (below), then keep both points at same height, or else interpolated lines
-        // will have a slope varying with the y of the visible world bottom
-        float yBottom = yLand >= yVisibleWorldBottom ? yVisibleWorldBottom : yLand;
-        landSegment.y2 = yBottom;
-        landSegment.depth2 = -(yBottom - yLand); // Height of land
+        StoreLandSegment(
+            mLandSegmentBuffer.emplace_back(),
+            x,
+            yLand,
+            renderParameters);
     }
 
     void UploadLandEnd();
 
-    void UploadOceanBasicStart(size_t slices);
+    inline void UploadLandUpdate(
+        size_t sliceIndex,
+        float yLand,
+        RenderParameters const & renderParameters)
+    {
+        assert(sliceIndex < mLandSegmentBuffer.size());
+
+        LandSegment & landSegment = mLandSegmentBuffer[sliceIndex];
+
+        StoreLandSegment(
+            landSegment,
+            landSegment.x1,
+            yLand,
+            renderParameters);
+
+        mLandSegmentBufferDirtyRange.Add(static_cast<ElementIndex>(sliceIndex));
+    }
+
+    void UploadOceanBasicStart(
+        size_t slices,
+        RenderParameters const & renderParameters);
 
     inline void UploadOceanBasic(
         float x,
-        float yOcean,
-        RenderParameters const & renderParameters)
+        float yOcean)
     {
-        float const yVisibleWorldBottom = renderParameters.View.GetVisibleWorld().BottomRight.y;
-
         //
         // Store ocean element
         //
@@ -315,54 +300,31 @@ public:
         oceanSegment.y1 = yOcean;
 
         oceanSegment.x2 = x;
-        oceanSegment.y2 = yVisibleWorldBottom;
-
-        switch (renderParameters.OceanRenderMode)
-        {
-            case OceanRenderModeType::Texture:
-            {
-                // Texture sample Y levels: anchor texture at top of wave,
-                // and set bottom at total visible height (after all, ocean texture repeats)
-                oceanSegment.yWater1 = 0.0f; // This is at yOcean
-                oceanSegment.yWater2 = yOcean - yVisibleWorldBottom; // Negative if yOcean invisible, but then who cares
-
-                break;
-            }
-
-            case OceanRenderModeType::Depth:
-            {
-                // Nop, but be nice
-                oceanSegment.yWater1 = 0.0f;
-                oceanSegment.yWater2 = 0.0f;
-
-                break;
-            }
-
-            case OceanRenderModeType::Flat:
-            {
-                // Nop, but be nice
-                oceanSegment.yWater1 = 0.0f;
-                oceanSegment.yWater2 = 0.0f;
-
-                break;
-            }
-        }
+        oceanSegment.y2 = mOceanUploadVisibleWorldBottomY;
+
+        // Texture sample Y levels: anchor texture at top of wave,
+        // and set bottom at total visible height (after all, ocean texture repeats);
+        // for all other modes these are unused - but we're nice and zero them
+        oceanSegment.yWater1 = 0.0f; // This is at yOcean
+        oceanSegment.yWater2 = mOceanUploadIsTextureMode
+            ? yOcean - mOceanUploadVisibleWorldBottomY // Negative if yOcean invisible, but then who cares
+            : 0.0f;
     }
 
     void UploadOceanBasicEnd();
 
-    void UploadOceanDetailedStart(size_t slices);
+    void UploadOceanDetailedStart(
+        size_t slices,
+        RenderParameters const & renderParameters);
 
     inline void UploadOceanDetailed(
         float x,
         float yBack,
         float yMid,
         float yFront,
-        float d2YFront,
-        RenderParameters const & renderParameters)
+        float d2YFront)
     {
         float const yTop = std::max(yBack, std::max(yMid, yFront)) + 10.0f; // Magic offset to allow shader to anti-alias close to the boundary
-        float const yVisibleWorldBottom = renderParameters.View.GetVisibleWorld().BottomRight.y;
 
         //
         // Store ocean element
@@ -378,41 +340,18 @@ public:
         oceanSegment.d2YFront1 = d2YFront;
 
         oceanSegment.x2 = x;
-        oceanSegment.y2 = yVisibleWorldBottom;
+        oceanSegment.y2 = mOceanUploadVisibleWorldBottomY;
         oceanSegment.yBack2 = yBack;
         oceanSegment.yMid2 = yMid;
         oceanSegment.yFront2 = yFront;
         oceanSegment.d2YFront2 = d2YFront;
 
-        switch (renderParameters.OceanRenderMode)
-        {
-            case OceanRenderModeType::Texture:
-            {
-                // Anchor textureY at 0.0 at top
-                oceanSegment.yTexture1 = 0.0f;
-                oceanSegment.yTexture2 = yTop - yVisibleWorldBottom; // Negative if yTop invisible, but then who cares
-
-                break;
-            }
-
-            case OceanRenderModeType::Depth:
-            {
-                // Nop, but be nice
-                oceanSegment.yTexture1 = 0.0f;
-                oceanSegment.yTexture2 = 0.0f;
-
-                break;
-            }
-
-            case OceanRenderModeType::Flat:
-            {
-                // Nop, but be nice
-                oceanSegment.yTexture1 = 0.0f;
-                oceanSegment.yTexture2 = 0.0f;
-
-                break;
-            }
-        }
+        // Anchor textureY at 0.0 at top; for all other modes these are unused -
+        // but we're nice and zero them
+        oceanSegment.yTexture1 = 0.0f;
+        oceanSegment.yTexture2 = mOceanUploadIsTextureMode
+            ? yTop - mOceanUploadVisibleWorldBottomY // Negative if yTop invisible, but then who cares
+            : 0.0f;
     }
 
     void UploadOceanDetailedEnd();
@@ -435,6 +374,8 @@ public:
         float const offsetX = worldSize.x / 2.0f * horizontalScale;
         float const offsetY = worldSize.y / 2.0f;
 
+        // Populate quad in buffer - the triangles are made via the shared quad elements
+
         // top-left
         mFishVertexBuffer.emplace_back(
             position,
@@ -471,30 +412,6 @@ public:
             tailSwing,
             tailProgress);
 
-        // bottom-left
-        mFishVertexBuffer.emplace_back(
-            position,
-            vec2f(-offsetX, -offsetY),
-            frame.TextureCoordinatesBottomLeft,
-            frame.TextureCoordinatesTopRight,
-            vec2f(frame.TextureCoordinatesBottomLeft.x, frame.TextureCoordinatesBottomLeft.y),
-            angleCw,
-            tailX,
-            tailSwing,
-            tailProgress);
-
-        // top-right
-        mFishVertexBuffer.emplace_back(
-            position,
-            vec2f(offsetX, offsetY),
-            frame.TextureCoordinatesBottomLeft,
-            frame.TextureCoordinatesTopRight,
-            vec2f(frame.TextureCoordinatesTopRight.x, frame.TextureCoordinatesTopRight.y),
-            angleCw,
-            tailX,
-            tailSwing,
-            tailProgress);
-
         // bottom-right
         mFishVertexBuffer.emplace_back(
             position,
@@ -688,7 +605,28 @@ public:
 
 private:
 
-    inline void StoreLightningVertices(
+    struct LandSegment;
+
+    static inline void StoreLandSegment(
+        LandSegment & landSegment,
+        float x,
+        float yLand,
+        RenderParameters const & renderParameters)
+    {
+        float const yVisibleWorldBottom = renderParameters.View.GetVisibleWorld().BottomRight.y;
+
+        landSegment.x1 = x;
+        landSegment.y1 = yLand;
+        landSegment.depth1 = 0.0f;
+        landSegment.x2 = x;
+        // If land is invisible (below), then keep both points at same height, or else interpolated lines
+        // will have a slope varying with the y of the visible world bottom
+        float yBottom = yLand >= yVisibleWorldBottom ? yVisibleWorldBottom : yLand;
+        landSegment.y2 = yBottom;
+        landSegment.depth2 = -(yBottom - yLand); // Height of land
+    }
+
+    inline bool StoreLightningVertices(
         float ndcX,
         float ndcBottomY,
         float progress,
@@ -697,7 +635,7 @@ private:
         size_t vertexBufferIndex)
     {
         if (ndcBottomY > 1.0)
-            return; // Above top, discard
+            return false; // Above top, discard
 
         float constexpr LightningQuadWidth = 0.5f;
 
@@ -771,6 +709,8 @@ private:
             progress,
             renderProgress,
             personalitySeed);
+
+        return true;
     }
 
 private:
@@ -786,12 +726,36 @@ private:
 
     void RecalculateWorldBorder(RenderParameters const & renderParameters);
 
+    void EnsureQuadElementVBOSize(size_t quadCount);
+
 private:
 
     //
     // Types
     //
 
+    struct Lightning
+    {
+        bool IsForeground;
+        vec2f Position; // Foreground: world coordinates of tip; background: NDC X
+        float StartTime;
+        float Duration;
+        float PersonalitySeed;
+
+        Lightning(
+            bool isForeground,
+            vec2f const & position,
+            float startTime,
+            float duration,
+            float personalitySeed)
+            : IsForeground(isForeground)
+            , Position(position)
+            , StartTime(startTime)
+            , Duration(duration)
+            , PersonalitySeed(personalitySeed)
+        {}
+    };
+
 #pragma pack(push, 1)
 
     struct StarVertex
@@ -1017,12 +981,15 @@ private:
     // VBOs and uploaded buffers and params
     //
 
-    BoundedVector<StarVertex> mStarVertexBuffer;
-    size_t mDirtyStarsCount;
+    BoundedVector<StarVertex> mStarVertexBuffer; // Sticky, only uploaded when the star field changes
+    bool mIsStarVertexBufferDirty;
     GameOpenGLVBO mStarVBO;
-    size_t mStarVBOAllocatedVertexSize;
 
-    BoundedVector<LightningVertex> mLightningVertexBuffer;
+    std::optional<StarVertex> mMovingStarVertex; // Uploaded at each frame, when there's a moving star
+    GameOpenGLVBO mMovingStarVBO;
+
+    std::vector<Lightning> mLightnings; // Sticky, only uploaded when lightnings come and go
+    BoundedVector<LightningVertex> mLightningVertexBuffer; // Re-built at each frame
     size_t mBackgroundLightningVertexCount;
     size_t mForegroundLightningVertexCount;
     GameOpenGLVBO mLightningVBO;
@@ -1033,7 +1000,8 @@ private:
     size_t mCloudVBOAllocatedVertexSize;
     float mCloudNormalizedViewCamY;
 
-    BoundedVector<LandSegment> mLandSegmentBuffer;
+    BoundedVector<LandSegment> mLandSegmentBuffer; // Sticky, changed in place by land updates
+    DirtyRange mLandSegmentBufferDirtyRange;
     GameOpenGLVBO mLandSegmentVBO;
     size_t mLandSegmentVBOAllocatedVertexSize;
 
@@ -1045,10 +1013,20 @@ private:
     GameOpenGLVBO mOceanDetailedSegmentVBO;
     size_t mOceanDetailedSegmentVBOAllocatedVertexSize;
 
+    // Constant for the whole duration of an ocean upload, hence
+    // captured once at its start
+    float mOceanUploadVisibleWorldBottomY;
+    bool mOceanUploadIsTextureMode;
+
     BoundedVector<FishVertex> mFishVertexBuffer;
     GameOpenGLVBO mFishVBO;
     size_t mFishVBOAllocatedVertexSize;
 
+    // Element indices making the two triangles of each quad out of its four vertices
+    // (top-left, bottom-left, top-right, bottom-right); shared by all quad-based VAOs
+    GameOpenGLVBO mQuadElementVBO;
+    size_t mQuadElementVBOAllocatedQuadSize;
+
     std::vector<AMBombPreImplosionVertex> mAMBombPreImplosionVertexBuffer;
     GameOpenGLVBO mAMBombPreImplosionVBO;
     size_t mAMBombPreImplosionVBOAllocatedVertexSize;
@@ -1077,6 +1055,7 @@ private:
     //
 
     GameOpenGLVAO mStarVAO;
+    GameOpenGLVAO mMovingStarVAO;
     GameOpenGLVAO mLightningVAO;
     GameOpenGLVAO mCloudVAO;
     GameOpenGLVAO mLandVAO;
@@ -1096,13 +1075,11 @@ private:
     std::unique_ptr<TextureAtlasMetadata<CloudTextureGroups>> mCloudTextureAtlasMetadata;
     GameOpenGLTexture mCloudTextureAtlasOpenGLHandle;
 
+    // Ocean and land textures, kept resident on demand so that switching back to one is free
     UploadedTextureManager<WorldTextureGroups> mUploadedWorldTextureManager;
 
     std::vector<TextureFrameSpecification<WorldTextureGroups>> mOceanTextureFrameSpecifications;
-    GameOpenGLTexture mOceanTextureOpenGLHandle;
-
     std::vector<TextureFrameSpecification<WorldTextureGroups>> mLandTextureFrameSpecifications;
-    GameOpenGLTexture mLandTextureOpenGLHandle;
 
     std::unique_ptr<TextureAtlasMetadata<FishTextureGroups>> mFishTextureAtlasMetadata;
     GameOpenGLTexture mFishTextureAtlasOpenGLHandle;
@@ -108,6 +108,14 @@ public:
             && point.y >= BottomLeft.y - margin
             && point.y <= TopRight.y + margin;
     }
+
+    inline bool Intersects(AABB const & other) const noexcept
+    {
+        return BottomLeft.x <= other.TopRight.x
+            && TopRight.x >= other.BottomLeft.x
+            && BottomLeft.y <= other.TopRight.y
+            && TopRight.y >= other.BottomLeft.y;
+    }
 };
 
 }
\ No newline at end of file
@@ -9,16 +9,33 @@
 #include "Vectors.h"
 
 #include <algorithm>
+#include <cassert>
+#include <iterator>
 #include <optional>
 #include <vector>
 
 namespace Geometry {
 
-// Set of AABBs
+/*
+ * Set of AABBs.
+ *
+ * Besides a plain list, the set maintains a sweep-and-prune broad phase - the AABBs
+ * sorted by their left edge - for overlap, point, and pair queries. The broad phase is
+ * only rebuilt when UpdateBroadPhase() is invoked; since AABBs move little between
+ * updates, the ordering from the previous update is re-sorted with an insertion sort,
+ * which costs close to linear time. Until then, queries fall back to linear scans.
+ */
 class AABBSet
 {
 public:
 
+    AABBSet()
+        : mAABBs()
+        , mSortedIndices()
+        , mSortedLefts()
+        , mIsBroadPhaseDirty(false)
+    {}
+
     inline size_t GetCount() const noexcept
     {
         return mAABBs.size();
@@ -31,28 +48,103 @@ public:
 
     inline bool Contains(vec2f const & point) const noexcept
     {
-        return std::any_of(
-            mAABBs.cbegin(),
-            mAABBs.cend(),
-            [&point](auto const & aabb)
-            {
-                return aabb.Contains(point);
-            });
+        return Contains(point, 0.0f);
     }
 
     inline bool Contains(
         vec2f const & point,
         float margin) const noexcept
     {
-        return std::any_of(
-            mAABBs.cbegin(),
-            mAABBs.cend(),
-            [&point, &margin](auto const & aabb)
+        bool result = false;
+        VisitCandidates(
+            point.x + margin,
+            [&](size_t i)
             {
-                return aabb.Contains(point, margin);
+                result = mAABBs[i].Contains(point, margin);
+                return !result;
+            });
+
+        return result;
+    }
+
+    /*
+     * Invokes the function with each AABB that contains the point, within the margin.
+     *
+     * Once the broad phase is up-to-date, AABBs are visited in order of their left edge.
+     */
+    template<typename TFunc>
+    inline void ForEachContaining(
+        vec2f const & point,
+        float margin,
+        TFunc && func) const // void(AABB const &)
+    {
+        VisitCandidates(
+            point.x + margin,
+            [&](size_t i)
+            {
+                if (mAABBs[i].Contains(point, margin))
+                    func(mAABBs[i]);
+
+                return true;
+            });
+    }
+
+    /*
+     * Invokes the function with the index of each AABB that intersects the specified one.
+     *
+     * Once the broad phase is up-to-date, AABBs are visited in order of their left edge.
+     */
+    template<typename TFunc>
+    inline void ForEachOverlapping(
+        AABB const & aabb,
+        TFunc && func) const // void(size_t)
+    {
+        VisitCandidates(
+            aabb.TopRight.x,
+            [&](size_t i)
+            {
+                if (mAABBs[i].Intersects(aabb))
+                    func(i);
+
+                return true;
             });
     }
 
+    /*
+     * Invokes the function with the indices - lower first - of each pair of intersecting AABBs.
+     */
+    template<typename TFunc>
+    inline void ForEachOverlappingPair(TFunc && func) const // void(size_t, size_t)
+    {
+        if (mIsBroadPhaseDirty)
+        {
+            for (size_t i = 0; i < mAABBs.size(); ++i)
+            {
+                for (size_t j = i + 1; j < mAABBs.size(); ++j)
+                {
+                    if (mAABBs[i].Intersects(mAABBs[j]))
+                        func(i, j);
+                }
+            }
+        }
+        else
+        {
+            // Sweep: only AABBs starting before the current one ends may overlap it
+            for (size_t si = 0; si < mSortedIndices.size(); ++si)
+            {
+                size_t const i = mSortedIndices[si];
+                float const right = mAABBs[i].TopRight.x;
+
+                for (size_t sj = si + 1; sj < mSortedIndices.size() && mSortedLefts[sj] <= right; ++sj)
+                {
+                    size_t const j = mSortedIndices[sj];
+                    if (mAABBs[i].Intersects(mAABBs[j]))
+                        func(std::min(i, j), std::max(i, j));
+                }
+            }
+        }
+    }
+
     inline std::optional<AABB> MakeUnion() const
     {
         if (mAABBs.empty())
@@ -81,16 +173,111 @@ public:
     inline void Add(AABB const & aabb) noexcept
     {
         mAABBs.emplace_back(aabb);
+        mIsBroadPhaseDirty = true;
     }
 
+    /*
+     * Clears the AABBs; the broad phase ordering is retained as the starting
+     * point for the next update.
+     */
     void Clear()
     {
         mAABBs.clear();
+        mIsBroadPhaseDirty = true;
+    }
+
+    void UpdateBroadPhase()
+    {
+        size_t const count = mAABBs.size();
+
+        // Make the previous ordering a permutation of the current AABBs
+        if (mSortedIndices.size() > count)
+        {
+            mSortedIndices.erase(
+                std::remove_if(
+                    mSortedIndices.begin(),
+                    mSortedIndices.end(),
+                    [count](size_t i)
+                    {
+                        return i >= count;
+                    }),
+                mSortedIndices.end());
+        }
+        else
+        {
+            for (size_t i = mSortedIndices.size(); i < count; ++i)
+            {
+                mSortedIndices.push_back(i);
+            }
+        }
+
+        assert(mSortedIndices.size() == count);
+
+        // Insertion sort by left edge
+        for (size_t si = 1; si < count; ++si)
+        {
+            size_t const i = mSortedIndices[si];
+            float const left = mAABBs[i].BottomLeft.x;
+
+            size_t sj = si;
+            for (; sj > 0 && mAABBs[mSortedIndices[sj - 1]].BottomLeft.x > left; --sj)
+            {
+                mSortedIndices[sj] = mSortedIndices[sj - 1];
+            }
+
+            mSortedIndices[sj] = i;
+        }
+
+        mSortedLefts.resize(count);
+        for (size_t si = 0; si < count; ++si)
+        {
+            mSortedLefts[si] = mAABBs[mSortedIndices[si]].BottomLeft.x;
+        }
+
+        mIsBroadPhaseDirty = false;
+    }
+
+private:
+
+    /*
+     * Invokes the visitor with the index of each AABB whose left edge is not
+     * past the specified x, until the visitor returns false.
+     */
+    template<typename TVisitor>
+    inline void VisitCandidates(
+        float maxLeft,
+        TVisitor && visitor) const // bool(size_t)
+    {
+        if (mIsBroadPhaseDirty)
+        {
+            for (size_t i = 0; i < mAABBs.size(); ++i)
+            {
+                if (!visitor(i))
+                    return;
+            }
+        }
+        else
+        {
+            size_t const candidateCount = static_cast<size_t>(std::distance(
+                mSortedLefts.cbegin(),
+                std::upper_bound(mSortedLefts.cbegin(), mSortedLefts.cend(), maxLeft)));
+
+            for (size_t si = 0; si < candidateCount; ++si)
+            {
+                if (!visitor(mSortedIndices[si]))
+                    return;
+            }
+        }
     }
 
 private:
 
     std::vector<AABB> mAABBs;
+
+    // Broad phase
+    std::vector<size_t> mSortedIndices; // Indices of AABBs, by increasing left edge
+    std::vector<float> mSortedLefts; // Left edges, in sorted order
+    bool mIsBroadPhaseDirty; // When set, broad phase does not reflect the AABBs
 };
 
 }
\ No newline at end of file
@@ -0,0 +1,173 @@
+/***************************************************************************************
+* Original Author:      Gabriele Giuseppini
+* Created:              2026-10-14
+* Copyright:            Gabriele Giuseppini  (https://github.com/GabrieleGiuseppini)
+***************************************************************************************/
+#pragma once
+
+#include "GameTypes.h"
+#include "StateSnapshot.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+/*
+ * This class implements a set of element indices, optimized for visiting - in
+ * ascending order - a subset of the elements that is expected to be small
+ * compared to the whole population of elements.
+ *
+ * Removal happens with hysteresis: an element leaves the set only after it has
+ * been found inactive at a number of consecutive updates, so that elements
+ * hovering around the threshold of activity do not flap in and out of the set.
+ */
+class ActiveElementSet
+{
+public:
+
+    ActiveElementSet(
+        ElementCount elementCount,
+        std::uint32_t inactiveUpdatesBeforeRemoval)
+        : mMemberStates(elementCount, NotAMember)
+        , mMembers()
+        , mSortedMemberCount(0)
+        , mInactiveUpdatesBeforeRemoval(inactiveUpdatesBeforeRemoval)
+    {
+        mMembers.reserve(elementCount);
+    }
+
+    ActiveElementSet(ActiveElementSet && other) = default;
+
+    inline size_t GetSize() const noexcept
+    {
+        return mMembers.size();
+    }
+
+    inline bool IsEmpty() const noexcept
+    {
+        return mMembers.empty();
+    }
+
+    inline bool Contains(ElementIndex element) const noexcept
+    {
+        assert(element < mMemberStates.size());
+
+        return mMemberStates[element] != NotAMember;
+    }
+
+    /*
+     * Adds the element to the set - if it's not a member yet - and marks it as active.
+     */
+    inline void Add(ElementIndex element) noexcept
+    {
+        assert(element < mMemberStates.size());
+
+        if (mMemberStates[element] == NotAMember)
+        {
+            mMembers.push_back(element);
+        }
+
+        mMemberStates[element] = 0;
+    }
+
+    /*
+     * Returns the members of the set, sorted in ascending order.
+     */
+    inline std::vector<ElementIndex> const & GetMembers() noexcept
+    {
+        EnsureSorted();
+
+        return mMembers;
+    }
+
+    /*
+     * Visits all members, counting the consecutive updates at which each member
+     * is found inactive by the predicate, and removing those members that have been
+     * inactive for longer than the hysteresis allows.
+     */
+    template<typename TIsInactive>
+    void Update(TIsInactive && isInactive)
+    {
+        EnsureSorted();
+
+        auto writeIt = mMembers.begin();
+        for (auto const element : mMembers)
+        {
+            if (isInactive(element))
+            {
+                if (mMemberStates[element] >= mInactiveUpdatesBeforeRemoval)
+                {
+                    // Time to go
+                    mMemberStates[element] = NotAMember;
+                    continue;
+                }
+
+                ++(mMemberStates[element]);
+            }
+            else
+            {
+                mMemberStates[element] = 0;
+            }
+
+            *(writeIt++) = element;
+        }
+
+        mMembers.erase(writeIt, mMembers.end());
+        mSortedMemberCount = mMembers.size();
+    }
+
+    void Clear()
+    {
+        for (auto const element : mMembers)
+        {
+            mMemberStates[element] = NotAMember;
+        }
+
+        mMembers.clear();
+        mSortedMemberCount = 0;
+    }
+
+    void SaveState(StateSnapshotWriter & writer) const
+    {
+        writer.Archive(mMemberStates);
+        writer.Archive(mMembers);
+        writer.Archive(mSortedMemberCount);
+    }
+
+    void LoadState(StateSnapshotReader & reader)
+    {
+        reader.Archive(mMemberStates);
+        reader.Archive(mMembers);
+        reader.Archive(mSortedMemberCount);
+    }
+
+private:
+
+    inline void EnsureSorted()
+    {
+        if (mSortedMemberCount != mMembers.size())
+        {
+            // Only the members added since the last sort are out of place
+            std::sort(mMembers.begin() + mSortedMemberCount, mMembers.end());
+            std::inplace_merge(mMembers.begin(), mMembers.begin() + mSortedMemberCount, mMembers.end());
+
+            mSortedMemberCount = mMembers.size();
+        }
+    }
+
+private:
+
+    static std::uint32_t constexpr NotAMember = std::numeric_limits<std::uint32_t>::max();
+
+    // For each element: either NotAMember, or the number of consecutive
+    // updates at which the member has been found inactive
+    std::vector<std::uint32_t> mMemberStates;
+
+    // The members; the first mSortedMemberCount are sorted
+    std::vector<ElementIndex> mMembers;
+    size_t mSortedMemberCount;
+
+    std::uint32_t const mInactiveUpdatesBeforeRemoval;
+};
@@ -0,0 +1,265 @@
+/***************************************************************************************
+* Original Author:      Gabriele Giuseppini
+* Created:              2026-10-14
+* Copyright:            Gabriele Giuseppini  (https://github.com/GabrieleGiuseppini)
+***************************************************************************************/
+#pragma once
+
+#include "GameTypes.h"
+#include "StateSnapshot.h"
+
+#include <cassert>
+#include <cstdint>
+#include <vector>
+
+/*
+ * This class implements a pool of a fixed range of element indices, which
+ * allocates and frees elements in constant time.
+ *
+ * Free elements are kept in a free list, while allocated elements are kept
+ * in a list ordered by age - i.e. by time of allocation - so that, when the
+ * pool is exhausted, the oldest element may be recycled in constant time.
+ */
+class AgeOrderedElementPool
+{
+public:
+
+    struct Statistics
+    {
+        std::uint64_t AllocationCount; // Including recycles
+        std::uint64_t RecycleCount; // Allocations that had to evict the oldest element
+        std::uint64_t FailureCount; // Allocations that found the pool exhausted, and were not allowed to recycle
+
+        Statistics()
+            : AllocationCount(0)
+            , RecycleCount(0)
+            , FailureCount(0)
+        {}
+    };
+
+public:
+
+    AgeOrderedElementPool(
+        ElementIndex startElement,
+        ElementCount elementCount)
+        : mStartElement(startElement)
+        , mNext(elementCount)
+        , mPrevious(elementCount)
+        , mIsAllocated(elementCount, false)
+        , mFreeHead(elementCount > 0 ? 0 : NoneElementIndex)
+        , mOldest(NoneElementIndex)
+        , mNewest(NoneElementIndex)
+        , mAllocatedCount(0)
+        , mCapacity(elementCount)
+        , mStatistics()
+    {
+        // All elements start free, in ascending order
+        for (ElementIndex e = 0; e < elementCount; ++e)
+        {
+            mNext[e] = (e + 1 < elementCount) ? e + 1 : NoneElementIndex;
+            mPrevious[e] = NoneElementIndex;
+        }
+    }
+
+    AgeOrderedElementPool(AgeOrderedElementPool && other) = default;
+
+    inline ElementCount GetAllocatedCount() const noexcept
+    {
+        return mAllocatedCount;
+    }
+
+    inline ElementCount GetCapacity() const noexcept
+    {
+        return mCapacity;
+    }
+
+    /*
+     * Limits the number of elements that may be allocated at the same time; elements
+     * already allocated beyond the new capacity stay allocated, but allocations will
+     * behave as if the pool were exhausted until the allocated count drops below the
+     * capacity.
+     */
+    inline void SetCapacity(ElementCount capacity) noexcept
+    {
+        assert(capacity > 0 && capacity <= mIsAllocated.size());
+
+        mCapacity = capacity;
+    }
+
+    /*
+     * Whether an allocation would find a free element.
+     */
+    inline bool CanAllocate() const noexcept
+    {
+        return mFreeHead != NoneElementIndex && mAllocatedCount < mCapacity;
+    }
+
+    /*
+     * Returns the oldest allocated element, or NoneElementIndex if no elements are allocated.
+     */
+    inline ElementIndex GetOldest() const noexcept
+    {
+        return mOldest != NoneElementIndex ? mStartElement + mOldest : NoneElementIndex;
+    }
+
+    inline bool IsAllocated(ElementIndex element) const noexcept
+    {
+        assert(element >= mStartElement && element - mStartElement < mIsAllocated.size());
+
+        return mIsAllocated[element - mStartElement];
+    }
+
+    /*
+     * Allocates a free element, making it the newest; returns NoneElementIndex if the
+     * pool is exhausted.
+     */
+    inline ElementIndex Allocate() noexcept
+    {
+        if (!CanAllocate())
+        {
+            ++(mStatistics.FailureCount);
+            return NoneElementIndex;
+        }
+
+        ElementIndex const e = mFreeHead;
+        mFreeHead = mNext[e];
+
+        mIsAllocated[e] = true;
+        ++mAllocatedCount;
+        LinkAsNewest(e);
+
+        ++(mStatistics.AllocationCount);
+
+        return mStartElement + e;
+    }
+
+    /*
+     * Allocates a free element - or, if the pool is exhausted, the oldest allocated
+     * element - making it the newest.
+     */
+    inline ElementIndex AllocateOrRecycleOldest() noexcept
+    {
+        if (CanAllocate())
+        {
+            return Allocate();
+        }
+
+        return RecycleOldest();
+    }
+
+    /*
+     * Re-allocates the oldest allocated element, making it the newest.
+     */
+    inline ElementIndex RecycleOldest() noexcept
+    {
+        assert(mOldest != NoneElementIndex);
+
+        ElementIndex const e = mOldest;
+        Unlink(e);
+        LinkAsNewest(e);
+
+        ++(mStatistics.AllocationCount);
+        ++(mStatistics.RecycleCount);
+
+        return mStartElement + e;
+    }
+
+    inline void Free(ElementIndex element) noexcept
+    {
+        assert(IsAllocated(element));
+
+        ElementIndex const e = element - mStartElement;
+
+        Unlink(e);
+
+        mIsAllocated[e] = false;
+        --mAllocatedCount;
+
+        mNext[e] = mFreeHead;
+        mPrevious[e] = NoneElementIndex;
+        mFreeHead = e;
+    }
+
+    inline Statistics const & GetStatistics() const noexcept
+    {
+        return mStatistics;
+    }
+
+    inline void ResetStatistics() noexcept
+    {
+        mStatistics = Statistics();
+    }
+
+    void SaveState(StateSnapshotWriter & writer) const
+    {
+        ArchiveState(*this, writer);
+    }
+
+    void LoadState(StateSnapshotReader & reader)
+    {
+        ArchiveState(*this, reader);
+    }
+
+private:
+
+    template<typename TSelf, typename TArchive>
+    static void ArchiveState(
+        TSelf & self,
+        TArchive & archive)
+    {
+        archive.Archive(self.mNext);
+        archive.Archive(self.mPrevious);
+        archive.Archive(self.mIsAllocated);
+        archive.Archive(self.mFreeHead);
+        archive.Archive(self.mOldest);
+        archive.Archive(self.mNewest);
+        archive.Archive(self.mAllocatedCount);
+        archive.Archive(self.mCapacity);
+    }
+
+    inline void LinkAsNewest(ElementIndex e) noexcept
+    {
+        mPrevious[e] = mNewest;
+        mNext[e] = NoneElementIndex;
+
+        if (mNewest != NoneElementIndex)
+            mNext[mNewest] = e;
+        else
+            mOldest = e;
+
+        mNewest = e;
+    }
+
+    inline void Unlink(ElementIndex e) noexcept
+    {
+        if (mPrevious[e] != NoneElementIndex)
+            mNext[mPrevious[e]] = mNext[e];
+        else
+            mOldest = mNext[e];
+
+        if (mNext[e] != NoneElementIndex)
+            mPrevious[mNext[e]] = mPrevious[e];
+        else
+            mNewest = mPrevious[e];
+    }
+
+private:
+
+    ElementIndex const mStartElement;
+
+    // The links of each element, relative to mStartElement; free elements
+    // are singly-linked via mNext, while allocated elements are doubly-linked
+    // from the oldest to the newest
+    std::vector<ElementIndex> mNext;
+    std::vector<ElementIndex> mPrevious;
+    std::vector<bool> mIsAllocated;
+
+    ElementIndex mFreeHead;
+    ElementIndex mOldest;
+    ElementIndex mNewest;
+
+    ElementCount mAllocatedCount;
+    ElementCount mCapacity;
+
+    Statistics mStatistics;
+};
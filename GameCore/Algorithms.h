@@ -5,13 +5,22 @@
  ***************************************************************************************/
 #pragma once
 
+#include "Colors.h"
 #include "GameTypes.h"
 #include "SysSpecifics.h"
 
 #include <algorithm>
 #include <array>
+#include <cassert>
 #include <cmath>
+#include <cstdint>
+#include <cstring>
 #include <iterator>
+#include <limits>
+
+#if FS_IS_ARCHITECTURE_X86_32() || FS_IS_ARCHITECTURE_X86_64()
+#include <immintrin.h>
+#endif
 
 namespace Algorithms {
 
@@ -506,6 +515,460 @@ inline void DiffuseLight(
 #endif
 }
 
+/*
+ * Diffuses light - as DiffuseLight() does - to the points in the specified range,
+ * visiting the points in tiles of consecutive indices and, for each tile, only
+ * considering the lamps whose light may reach the tile's bounding box and planes.
+ *
+ * Tiles are effective as a ship's point indices are spatially coherent; the results
+ * are the same as DiffuseLight()'s.
+ *
+ * The culled lamp buffers are work buffers, which must have room for lampCount
+ * lamps aligned to the vectorization float count.
+ */
+template<typename TVector>
+inline void DiffuseLight_Culled(
+    TVector const * restrict pointPositions,
+    PlaneId const * restrict pointPlaneIds,
+    ElementIndex const startPointIndex,
+    ElementIndex const endPointIndex, // Excluded
+    TVector const * restrict lampPositions,
+    PlaneId const * restrict lampPlaneIds,
+    float const * restrict lampDistanceCoeffs,
+    float const * restrict lampSpreadMaxDistances,
+    ElementIndex const lampCount,
+    TVector * restrict culledLampPositions,
+    PlaneId * restrict culledLampPlaneIds,
+    float * restrict culledLampDistanceCoeffs,
+    float * restrict culledLampSpreadMaxDistances,
+    float * restrict outLightBuffer) noexcept
+{
+    ElementIndex constexpr TileSize = 64; // Must be aligned to the vectorization float count
+
+    static_assert(is_aligned_to_float_element_count(TileSize));
+    assert(is_aligned_to_float_element_count(startPointIndex));
+    assert(is_aligned_to_float_element_count(endPointIndex));
+
+    for (ElementIndex tileStartPointIndex = startPointIndex; tileStartPointIndex < endPointIndex; tileStartPointIndex += TileSize)
+    {
+        ElementIndex const tileEndPointIndex = std::min(tileStartPointIndex + TileSize, endPointIndex);
+
+        //
+        // Calculate tile's bounding box and lowest plane
+        //
+
+        float minX = std::numeric_limits<float>::max();
+        float maxX = std::numeric_limits<float>::lowest();
+        float minY = std::numeric_limits<float>::max();
+        float maxY = std::numeric_limits<float>::lowest();
+        PlaneId minPlaneId = std::numeric_limits<PlaneId>::max();
+
+        for (ElementIndex p = tileStartPointIndex; p < tileEndPointIndex; ++p)
+        {
+            minX = std::min(minX, pointPositions[p].x);
+            maxX = std::max(maxX, pointPositions[p].x);
+            minY = std::min(minY, pointPositions[p].y);
+            maxY = std::max(maxY, pointPositions[p].y);
+            minPlaneId = std::min(minPlaneId, pointPlaneIds[p]);
+        }
+
+        //
+        // Cull lamps: a lamp only lights points on its plane or lower planes, and
+        // within its spread
+        //
+
+        ElementIndex culledLampCount = 0;
+
+        for (ElementIndex l = 0; l < lampCount; ++l)
+        {
+            if (lampDistanceCoeffs[l] > 0.0f && lampPlaneIds[l] >= minPlaneId)
+            {
+                float const dx = std::max(std::max(minX - lampPositions[l].x, lampPositions[l].x - maxX), 0.0f);
+                float const dy = std::max(std::max(minY - lampPositions[l].y, lampPositions[l].y - maxY), 0.0f);
+                if (dx * dx + dy * dy < lampSpreadMaxDistances[l] * lampSpreadMaxDistances[l])
+                {
+                    culledLampPositions[culledLampCount] = lampPositions[l];
+                    culledLampPlaneIds[culledLampCount] = lampPlaneIds[l];
+                    culledLampDistanceCoeffs[culledLampCount] = lampDistanceCoeffs[l];
+                    culledLampSpreadMaxDistances[culledLampCount] = lampSpreadMaxDistances[l];
+                    ++culledLampCount;
+                }
+            }
+        }
+
+        if (culledLampCount == 0)
+        {
+            std::fill(
+                outLightBuffer + tileStartPointIndex,
+                outLightBuffer + tileEndPointIndex,
+                0.0f);
+
+            continue;
+        }
+
+        // Pad with copies of the last lamp, which don't change maxima
+        for (ElementIndex const lastCulledLampIndex = culledLampCount - 1; !is_aligned_to_float_element_count(culledLampCount); ++culledLampCount)
+        {
+            culledLampPositions[culledLampCount] = culledLampPositions[lastCulledLampIndex];
+            culledLampPlaneIds[culledLampCount] = culledLampPlaneIds[lastCulledLampIndex];
+            culledLampDistanceCoeffs[culledLampCount] = culledLampDistanceCoeffs[lastCulledLampIndex];
+            culledLampSpreadMaxDistances[culledLampCount] = culledLampSpreadMaxDistances[lastCulledLampIndex];
+        }
+
+        //
+        // Diffuse light from culled lamps
+        //
+
+        DiffuseLight(
+            pointPositions + tileStartPointIndex,
+            pointPlaneIds + tileStartPointIndex,
+            tileEndPointIndex - tileStartPointIndex,
+            culledLampPositions,
+            culledLampPlaneIds,
+            culledLampDistanceCoeffs,
+            culledLampSpreadMaxDistances,
+            culledLampCount,
+            outLightBuffer + tileStartPointIndex);
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////
+// Spring forces
+///////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/*
+ * Calculates Hooke's and damping forces for the springs in the specified range,
+ * adding them to the forces of the spring endpoints.
+ *
+ * Springs are in structure-of-arrays layout; deleted springs are expected to
+ * have zero coefficients.
+ */
+template<typename TVector>
+inline void ApplySpringsForces_Naive(
+    TVector const * restrict pointPositions,
+    TVector const * restrict pointVelocities,
+    ElementIndex const * restrict springEndpointAIndices,
+    ElementIndex const * restrict springEndpointBIndices,
+    float const * restrict springRestLengths,
+    float const * restrict springStiffnessCoefficients,
+    float const * restrict springDampingCoefficients,
+    ElementIndex startSpringIndex,
+    ElementIndex endSpringIndex, // Excluded
+    TVector * restrict outPointForces) noexcept
+{
+    for (ElementIndex s = startSpringIndex; s < endSpringIndex; ++s)
+    {
+        auto const pointAIndex = springEndpointAIndices[s];
+        auto const pointBIndex = springEndpointBIndices[s];
+
+        TVector const displacement = pointPositions[pointBIndex] - pointPositions[pointAIndex];
+        float const displacementLength = displacement.length();
+        TVector const springDir = displacement.normalise(displacementLength);
+
+        // Hooke's law
+        float const fSpring =
+            (displacementLength - springRestLengths[s])
+            * springStiffnessCoefficients[s];
+
+        // Damper forces
+        TVector const relVelocity = pointVelocities[pointBIndex] - pointVelocities[pointAIndex];
+        float const fDamp =
+            relVelocity.dot(springDir)
+            * springDampingCoefficients[s];
+
+        TVector const forceA = springDir * (fSpring + fDamp);
+        outPointForces[pointAIndex] += forceA;
+        outPointForces[pointBIndex] -= forceA;
+    }
+}
+
+#if FS_IS_ARCHITECTURE_X86_32() || FS_IS_ARCHITECTURE_X86_64()
+template<typename TVector>
+FS_TARGET_AVX2 inline void ApplySpringsForces_AVX2(
+    TVector const * restrict pointPositions,
+    TVector const * restrict pointVelocities,
+    ElementIndex const * restrict springEndpointAIndices,
+    ElementIndex const * restrict springEndpointBIndices,
+    float const * restrict springRestLengths,
+    float const * restrict springStiffnessCoefficients,
+    float const * restrict springDampingCoefficients,
+    ElementIndex startSpringIndex,
+    ElementIndex endSpringIndex, // Excluded
+    TVector * restrict outPointForces) noexcept
+{
+    static_assert(sizeof(TVector) == 2 * sizeof(float));
+
+    float const * const restrict pointPositionsFloat = reinterpret_cast<float const *>(pointPositions);
+    float const * const restrict pointVelocitiesFloat = reinterpret_cast<float const *>(pointVelocities);
+
+    __m256i const One_8 = _mm256_set1_epi32(1);
+    __m256 const Zero_8 = _mm256_setzero_ps();
+
+    alignas(32) float forceX[8];
+    alignas(32) float forceY[8];
+
+    //
+    // Visit springs in groups of 8
+    //
+
+    ElementIndex s = startSpringIndex;
+    for (; s + 8 <= endSpringIndex; s += 8)
+    {
+        // Float indices of x and y components of endpoint vectors
+        __m256i const pointAXIndex_8 = _mm256_slli_epi32(_mm256_loadu_si256(reinterpret_cast<__m256i const *>(springEndpointAIndices + s)), 1);
+        __m256i const pointAYIndex_8 = _mm256_add_epi32(pointAXIndex_8, One_8);
+        __m256i const pointBXIndex_8 = _mm256_slli_epi32(_mm256_loadu_si256(reinterpret_cast<__m256i const *>(springEndpointBIndices + s)), 1);
+        __m256i const pointBYIndex_8 = _mm256_add_epi32(pointBXIndex_8, One_8);
+
+        // Displacement
+        __m256 const displacementX_8 = _mm256_sub_ps(
+            _mm256_i32gather_ps(pointPositionsFloat, pointBXIndex_8, 4),
+            _mm256_i32gather_ps(pointPositionsFloat, pointAXIndex_8, 4));
+        __m256 const displacementY_8 = _mm256_sub_ps(
+            _mm256_i32gather_ps(pointPositionsFloat, pointBYIndex_8, 4),
+            _mm256_i32gather_ps(pointPositionsFloat, pointAYIndex_8, 4));
+
+        __m256 const displacementLength_8 = _mm256_sqrt_ps(
+            _mm256_add_ps(
+                _mm256_mul_ps(displacementX_8, displacementX_8),
+                _mm256_mul_ps(displacementY_8, displacementY_8)));
+
+        // Spring direction - zero when length is zero
+        __m256 const validMask_8 = _mm256_cmp_ps(displacementLength_8, Zero_8, _CMP_NEQ_OQ);
+        __m256 const springDirX_8 = _mm256_and_ps(_mm256_div_ps(displacementX_8, displacementLength_8), validMask_8);
+        __m256 const springDirY_8 = _mm256_and_ps(_mm256_div_ps(displacementY_8, displacementLength_8), validMask_8);
+
+        //
+        // 1. Hooke's law
+        //
+
+        __m256 const fSpring_8 = _mm256_mul_ps(
+            _mm256_sub_ps(displacementLength_8, _mm256_loadu_ps(springRestLengths + s)),
+            _mm256_loadu_ps(springStiffnessCoefficients + s));
+
+        //
+        // 2. Damper forces
+        //
+
+        __m256 const relVelocityX_8 = _mm256_sub_ps(
+            _mm256_i32gather_ps(pointVelocitiesFloat, pointBXIndex_8, 4),
+            _mm256_i32gather_ps(pointVelocitiesFloat, pointAXIndex_8, 4));
+        __m256 const relVelocityY_8 = _mm256_sub_ps(
+            _mm256_i32gather_ps(pointVelocitiesFloat, pointBYIndex_8, 4),
+            _mm256_i32gather_ps(pointVelocitiesFloat, pointAYIndex_8, 4));
+
+        __m256 const fDamp_8 = _mm256_mul_ps(
+            _mm256_add_ps(
+                _mm256_mul_ps(relVelocityX_8, springDirX_8),
+                _mm256_mul_ps(relVelocityY_8, springDirY_8)),
+            _mm256_loadu_ps(springDampingCoefficients + s));
+
+        //
+        // Apply forces - one spring at a time and in spring order, as springs
+        // in the same group might share endpoints
+        //
+
+        __m256 const f_8 = _mm256_add_ps(fSpring_8, fDamp_8);
+
+        _mm256_store_ps(forceX, _mm256_mul_ps(springDirX_8, f_8));
+        _mm256_store_ps(forceY, _mm256_mul_ps(springDirY_8, f_8));
+
+        for (ElementIndex l = 0; l < 8; ++l)
+        {
+            TVector const forceA(forceX[l], forceY[l]);
+            outPointForces[springEndpointAIndices[s + l]] += forceA;
+            outPointForces[springEndpointBIndices[s + l]] -= forceA;
+        }
+    }
+
+    //
+    // Remainder
+    //
+
+    ApplySpringsForces_Naive(
+        pointPositions,
+        pointVelocities,
+        springEndpointAIndices,
+        springEndpointBIndices,
+        springRestLengths,
+        springStiffnessCoefficients,
+        springDampingCoefficients,
+        s,
+        endSpringIndex,
+        outPointForces);
+}
+#endif
+
+#if FS_IS_ARCHITECTURE_ARM_64()
+template<typename TVector>
+inline void ApplySpringsForces_NEON(
+    TVector const * restrict pointPositions,
+    TVector const * restrict pointVelocities,
+    ElementIndex const * restrict springEndpointAIndices,
+    ElementIndex const * restrict springEndpointBIndices,
+    float const * restrict springRestLengths,
+    float const * restrict springStiffnessCoefficients,
+    float const * restrict springDampingCoefficients,
+    ElementIndex startSpringIndex,
+    ElementIndex endSpringIndex, // Excluded
+    TVector * restrict outPointForces) noexcept
+{
+    static_assert(sizeof(TVector) == 2 * sizeof(float));
+
+    float32x4_t const Zero_4 = vdupq_n_f32(0.0f);
+
+    alignas(16) float tmpAX[4];
+    alignas(16) float tmpAY[4];
+    alignas(16) float tmpBX[4];
+    alignas(16) float tmpBY[4];
+
+    //
+    // Visit springs in groups of 4
+    //
+
+    ElementIndex s = startSpringIndex;
+    for (; s + 4 <= endSpringIndex; s += 4)
+    {
+        // Displacement - NEON has no gather, hence we load lanes from memory
+        for (ElementIndex l = 0; l < 4; ++l)
+        {
+            tmpAX[l] = pointPositions[springEndpointAIndices[s + l]].x;
+            tmpAY[l] = pointPositions[springEndpointAIndices[s + l]].y;
+            tmpBX[l] = pointPositions[springEndpointBIndices[s + l]].x;
+            tmpBY[l] = pointPositions[springEndpointBIndices[s + l]].y;
+        }
+
+        float32x4_t const displacementX_4 = vsubq_f32(vld1q_f32(tmpBX), vld1q_f32(tmpAX));
+        float32x4_t const displacementY_4 = vsubq_f32(vld1q_f32(tmpBY), vld1q_f32(tmpAY));
+
+        float32x4_t const displacementLength_4 = vsqrtq_f32(
+            vaddq_f32(
+                vmulq_f32(displacementX_4, displacementX_4),
+                vmulq_f32(displacementY_4, displacementY_4)));
+
+        // Spring direction - zero when length is zero
+        uint32x4_t const invalidMask_4 = vceqq_f32(displacementLength_4, Zero_4);
+        float32x4_t const springDirX_4 = vbslq_f32(invalidMask_4, Zero_4, vdivq_f32(displacementX_4, displacementLength_4));
+        float32x4_t const springDirY_4 = vbslq_f32(invalidMask_4, Zero_4, vdivq_f32(displacementY_4, displacementLength_4));
+
+        // Hooke's law
+        float32x4_t const fSpring_4 = vmulq_f32(
+            vsubq_f32(displacementLength_4, vld1q_f32(springRestLengths + s)),
+            vld1q_f32(springStiffnessCoefficients + s));
+
+        // Damper forces
+        for (ElementIndex l = 0; l < 4; ++l)
+        {
+            tmpAX[l] = pointVelocities[springEndpointAIndices[s + l]].x;
+            tmpAY[l] = pointVelocities[springEndpointAIndices[s + l]].y;
+            tmpBX[l] = pointVelocities[springEndpointBIndices[s + l]].x;
+            tmpBY[l] = pointVelocities[springEndpointBIndices[s + l]].y;
+        }
+
+        float32x4_t const relVelocityX_4 = vsubq_f32(vld1q_f32(tmpBX), vld1q_f32(tmpAX));
+        float32x4_t const relVelocityY_4 = vsubq_f32(vld1q_f32(tmpBY), vld1q_f32(tmpAY));
+
+        float32x4_t const fDamp_4 = vmulq_f32(
+            vaddq_f32(
+                vmulq_f32(relVelocityX_4, springDirX_4),
+                vmulq_f32(relVelocityY_4, springDirY_4)),
+            vld1q_f32(springDampingCoefficients + s));
+
+        // Apply forces - one spring at a time and in spring order, as springs
+        // in the same group might share endpoints
+        float32x4_t const f_4 = vaddq_f32(fSpring_4, fDamp_4);
+        vst1q_f32(tmpAX, vmulq_f32(springDirX_4, f_4));
+        vst1q_f32(tmpAY, vmulq_f32(springDirY_4, f_4));
+
+        for (ElementIndex l = 0; l < 4; ++l)
+        {
+            TVector const forceA(tmpAX[l], tmpAY[l]);
+            outPointForces[springEndpointAIndices[s + l]] += forceA;
+            outPointForces[springEndpointBIndices[s + l]] -= forceA;
+        }
+    }
+
+    //
+    // Remainder
+    //
+
+    ApplySpringsForces_Naive(
+        pointPositions,
+        pointVelocities,
+        springEndpointAIndices,
+        springEndpointBIndices,
+        springRestLengths,
+        springStiffnessCoefficients,
+        springDampingCoefficients,
+        s,
+        endSpringIndex,
+        outPointForces);
+}
+#endif
+
+/*
+ * Calculates spring forces with the widest implementation supported by the CPU
+ * we're running on.
+ */
+template<typename TVector>
+inline void ApplySpringsForces(
+    TVector const * restrict pointPositions,
+    TVector const * restrict pointVelocities,
+    ElementIndex const * restrict springEndpointAIndices,
+    ElementIndex const * restrict springEndpointBIndices,
+    float const * restrict springRestLengths,
+    float const * restrict springStiffnessCoefficients,
+    float const * restrict springDampingCoefficients,
+    ElementIndex startSpringIndex,
+    ElementIndex endSpringIndex, // Excluded
+    TVector * restrict outPointForces) noexcept
+{
+#if FS_IS_ARCHITECTURE_X86_32() || FS_IS_ARCHITECTURE_X86_64()
+    if (IsAVX2Supported())
+    {
+        ApplySpringsForces_AVX2(pointPositions, pointVelocities, springEndpointAIndices, springEndpointBIndices,
+            springRestLengths, springStiffnessCoefficients, springDampingCoefficients, startSpringIndex, endSpringIndex, outPointForces);
+    }
+    else
+    {
+        ApplySpringsForces_Naive(pointPositions, pointVelocities, springEndpointAIndices, springEndpointBIndices,
+            springRestLengths, springStiffnessCoefficients, springDampingCoefficients, startSpringIndex, endSpringIndex, outPointForces);
+    }
+#elif FS_IS_ARCHITECTURE_ARM_64()
+    ApplySpringsForces_NEON(pointPositions, pointVelocities, springEndpointAIndices, springEndpointBIndices,
+        springRestLengths, springStiffnessCoefficients, springDampingCoefficients, startSpringIndex, endSpringIndex, outPointForces);
+#else
+    ApplySpringsForces_Naive(pointPositions, pointVelocities, springEndpointAIndices, springEndpointBIndices,
+        springRestLengths, springStiffnessCoefficients, springDampingCoefficients, startSpringIndex, endSpringIndex, outPointForces);
+#endif
+}
+
+template<typename TVector>
+inline void ApplySpringsForces(
+    SpringForcesKernelType kernel,
+    TVector const * restrict pointPositions,
+    TVector const * restrict pointVelocities,
+    ElementIndex const * restrict springEndpointAIndices,
+    ElementIndex const * restrict springEndpointBIndices,
+    float const * restrict springRestLengths,
+    float const * restrict springStiffnessCoefficients,
+    float const * restrict springDampingCoefficients,
+    ElementIndex startSpringIndex,
+    ElementIndex endSpringIndex, // Excluded
+    TVector * restrict outPointForces) noexcept
+{
+    if (kernel == SpringForcesKernelType::Scalar)
+    {
+        ApplySpringsForces_Naive(pointPositions, pointVelocities, springEndpointAIndices, springEndpointBIndices,
+            springRestLengths, springStiffnessCoefficients, springDampingCoefficients, startSpringIndex, endSpringIndex, outPointForces);
+    }
+    else
+    {
+        ApplySpringsForces(pointPositions, pointVelocities, springEndpointAIndices, springEndpointBIndices,
+            springRestLengths, springStiffnessCoefficients, springDampingCoefficients, startSpringIndex, endSpringIndex, outPointForces);
+    }
+}
+
 ///////////////////////////////////////////////////////////////////////////////////////////////////////
 // BufferSmoothing
 ///////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -609,4 +1072,440 @@ inline void SmoothBufferAndAdd(
 #endif
 }
 
+///////////////////////////////////////////////////////////////////////////////////////////////////////
+// Rotting
+///////////////////////////////////////////////////////////////////////////////////////////////////////
+
+inline void RotPoints_Naive(
+    float const * restrict cachedDepthBuffer,
+    float const * restrict waterBuffer,
+    float const * restrict leakingSourcesBuffer,
+    float const * restrict rustReceptivityBuffer,
+    float * restrict decayBuffer,
+    size_t startPointIndex,
+    size_t endPointIndex,
+    float x_uw,
+    float beta) noexcept
+{
+    for (size_t p = startPointIndex; p < endPointIndex; ++p)
+    {
+        float x =
+            (cachedDepthBuffer[p] > 0.0f ? x_uw : 0.0f) // x_uw
+            + std::min(waterBuffer[p], 1.0f); // x_fl
+
+        // Adjust with leaking: if leaking and subject to rusting, then rusts faster
+        x += leakingSourcesBuffer[p * 2] * x * x_uw;
+
+        // Adjust with material's rust receptivity
+        x *= rustReceptivityBuffer[p];
+
+        // Calculate alpha and decay
+        decayBuffer[p] *= std::max(1.0f - beta * x, 0.0f);
+    }
+}
+
+#if FS_IS_ARCHITECTURE_X86_32() || FS_IS_ARCHITECTURE_X86_64()
+inline void RotPoints_SSEVectorized(
+    float const * restrict cachedDepthBuffer,
+    float const * restrict waterBuffer,
+    float const * restrict leakingSourcesBuffer,
+    float const * restrict rustReceptivityBuffer,
+    float * restrict decayBuffer,
+    size_t startPointIndex,
+    size_t endPointIndex,
+    float x_uw,
+    float beta) noexcept
+{
+    // Partition boundaries are not necessarily aligned, hence we use unaligned loads and stores,
+    // and take care of the remainder with the naive loop
+
+    __m128 const Zero = _mm_setzero_ps();
+    __m128 const One = _mm_set_ps1(1.0f);
+    __m128 const x_uw_4 = _mm_set_ps1(x_uw);
+    __m128 const beta_4 = _mm_set_ps1(beta);
+
+    size_t p = startPointIndex;
+    for (; p + 4 <= endPointIndex; p += 4)
+    {
+        // x_uw where underwater, and x_fl
+        __m128 x = _mm_add_ps(
+            _mm_and_ps(
+                _mm_cmpgt_ps(_mm_loadu_ps(cachedDepthBuffer + p), Zero),
+                x_uw_4),
+            _mm_min_ps(_mm_loadu_ps(waterBuffer + p), One));
+
+        // De-interleave the structural leaks out of the (StructuralLeak, WaterPumpForce) pairs
+        __m128 const structuralLeak = _mm_shuffle_ps(
+            _mm_loadu_ps(leakingSourcesBuffer + p * 2),
+            _mm_loadu_ps(leakingSourcesBuffer + p * 2 + 4),
+            _MM_SHUFFLE(2, 0, 2, 0));
+
+        // Adjust with leaking
+        x = _mm_add_ps(
+            x,
+            _mm_mul_ps(_mm_mul_ps(structuralLeak, x), x_uw_4));
+
+        // Adjust with material's rust receptivity
+        x = _mm_mul_ps(x, _mm_loadu_ps(rustReceptivityBuffer + p));
+
+        // Calculate alpha and decay
+        __m128 const alpha = _mm_max_ps(
+            _mm_sub_ps(One, _mm_mul_ps(beta_4, x)),
+            Zero);
+
+        _mm_storeu_ps(
+            decayBuffer + p,
+            _mm_mul_ps(_mm_loadu_ps(decayBuffer + p), alpha));
+    }
+
+    RotPoints_Naive(
+        cachedDepthBuffer,
+        waterBuffer,
+        leakingSourcesBuffer,
+        rustReceptivityBuffer,
+        decayBuffer,
+        p,
+        endPointIndex,
+        x_uw,
+        beta);
+}
+#endif
+
+/*
+ * Multiplies the decay of each point in the range with its rot alpha, i.e. 1 - beta * x,
+ * with x depending on whether the point is underwater, on its water, on whether it is
+ * structurally leaking, and on its material's rust receptivity.
+ *
+ * The leaking sources buffer consists of (StructuralLeak, WaterPumpForce) pairs.
+ */
+inline void RotPoints(
+    float const * restrict cachedDepthBuffer,
+    float const * restrict waterBuffer,
+    float const * restrict leakingSourcesBuffer,
+    float const * restrict rustReceptivityBuffer,
+    float * restrict decayBuffer,
+    size_t startPointIndex,
+    size_t endPointIndex,
+    float x_uw,
+    float beta) noexcept
+{
+#if FS_IS_ARCHITECTURE_X86_32() || FS_IS_ARCHITECTURE_X86_64()
+    RotPoints_SSEVectorized(cachedDepthBuffer, waterBuffer, leakingSourcesBuffer, rustReceptivityBuffer, decayBuffer, startPointIndex, endPointIndex, x_uw, beta);
+#else
+    RotPoints_Naive(cachedDepthBuffer, waterBuffer, leakingSourcesBuffer, rustReceptivityBuffer, decayBuffer, startPointIndex, endPointIndex, x_uw, beta);
+#endif
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////
+// Vertex attribute packing
+///////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/*
+ * Packs [0.0, 1.0] colors into 8-bit normalized colors, clamping; rounds to nearest,
+ * like rgbaColor(vec4f).
+ */
+inline void PackColorsToRgba8_Naive(
+    vec4f const * restrict inColors,
+    rgbaColor * restrict outColors,
+    size_t count) noexcept
+{
+    // NaNs get clamped to zero
+    auto const clamp01 = [](float value)
+    {
+        value = (value > 0.0f) ? value : 0.0f;
+        return (value < 1.0f) ? value : 1.0f;
+    };
+
+    for (size_t i = 0; i < count; ++i)
+    {
+        outColors[i] = rgbaColor(
+            vec4f(
+                clamp01(inColors[i].x),
+                clamp01(inColors[i].y),
+                clamp01(inColors[i].z),
+                clamp01(inColors[i].w)));
+    }
+}
+
+#if FS_IS_ARCHITECTURE_X86_32() || FS_IS_ARCHITECTURE_X86_64()
+inline void PackColorsToRgba8_SSEVectorized(
+    vec4f const * restrict inColors,
+    rgbaColor * restrict outColors,
+    size_t count) noexcept
+{
+    static_assert(sizeof(vec4f) == 4 * sizeof(float));
+    static_assert(sizeof(rgbaColor) == 4 * sizeof(std::uint8_t));
+
+    __m128 const zero = _mm_setzero_ps();
+    __m128 const one = _mm_set1_ps(1.0f);
+    __m128 const scale = _mm_set1_ps(255.0f);
+    __m128 const half = _mm_set1_ps(0.5f);
+
+    auto const toInt = [&](float const * src)
+    {
+        __m128 const c = _mm_min_ps(_mm_max_ps(_mm_loadu_ps(src), zero), one); // NaNs get clamped to zero
+        return _mm_cvttps_epi32(_mm_add_ps(_mm_mul_ps(c, scale), half));
+    };
+
+    // Four colors at a time
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4)
+    {
+        float const * src = reinterpret_cast<float const *>(inColors + i);
+
+        __m128i const c01 = _mm_packs_epi32(toInt(src), toInt(src + 4));
+        __m128i const c23 = _mm_packs_epi32(toInt(src + 8), toInt(src + 12));
+
+        _mm_storeu_si128(
+            reinterpret_cast<__m128i *>(outColors + i),
+            _mm_packus_epi16(c01, c23));
+    }
+
+    PackColorsToRgba8_Naive(inColors + i, outColors + i, count - i);
+}
+#endif
+
+inline void PackColorsToRgba8(
+    vec4f const * restrict inColors,
+    rgbaColor * restrict outColors,
+    size_t count) noexcept
+{
+#if FS_IS_ARCHITECTURE_X86_32() || FS_IS_ARCHITECTURE_X86_64()
+    PackColorsToRgba8_SSEVectorized(inColors, outColors, count);
+#else
+    PackColorsToRgba8_Naive(inColors, outColors, count);
+#endif
+}
+
+/*
+ * Packs floats into IEEE 754 half floats, rounding half up; magnitudes beyond the
+ * largest half (65504) - including infinities and NaNs - are clamped to it, and
+ * half denormals are only produced when float denormals are not flushed to zero.
+ *
+ * Re-biasing the exponent is a multiplication by 2^-112, after which the half is
+ * in the top bits of the float.
+ */
+inline void PackFloatsToHalfFloats_Naive(
+    float const * restrict inValues,
+    std::uint16_t * restrict outValues,
+    size_t count) noexcept
+{
+    float constexpr MaxHalf = 65504.0f;
+    float constexpr Rebias = 0x1p-112f;
+
+    for (size_t i = 0; i < count; ++i)
+    {
+        std::uint32_t valueBits;
+        std::memcpy(&valueBits, &(inValues[i]), sizeof(std::uint32_t));
+
+        float absValue = std::abs(inValues[i]);
+        absValue = (absValue < MaxHalf) ? absValue : MaxHalf; // NaNs get clamped too
+        float const scaled = absValue * Rebias;
+
+        std::uint32_t scaledBits;
+        std::memcpy(&scaledBits, &scaled, sizeof(std::uint32_t));
+
+        outValues[i] = static_cast<std::uint16_t>(
+            ((valueBits & 0x80000000u) >> 16)
+            | ((scaledBits + 0x1000u) >> 13));
+    }
+}
+
+#if FS_IS_ARCHITECTURE_X86_32() || FS_IS_ARCHITECTURE_X86_64()
+inline void PackFloatsToHalfFloats_SSEVectorized(
+    float const * restrict inValues,
+    std::uint16_t * restrict outValues,
+    size_t count) noexcept
+{
+    __m128 const signMask = _mm_castsi128_ps(_mm_set1_epi32(static_cast<int>(0x80000000u)));
+    __m128 const maxHalf = _mm_set1_ps(65504.0f);
+    __m128 const rebias = _mm_castsi128_ps(_mm_set1_epi32(0x07800000)); // 2^-112
+    __m128i const roundingBias = _mm_set1_epi32(0x1000);
+
+    auto const toHalf = [&](float const * src)
+    {
+        __m128 const value = _mm_loadu_ps(src);
+        __m128 const absValue = _mm_min_ps(_mm_andnot_ps(signMask, value), maxHalf); // NaNs get clamped too
+
+        __m128i const half = _mm_or_si128(
+            _mm_srli_epi32(_mm_castps_si128(_mm_and_ps(value, signMask)), 16),
+            _mm_srli_epi32(_mm_add_epi32(_mm_castps_si128(_mm_mul_ps(absValue, rebias)), roundingBias), 13));
+
+        // Sign-extend, so that the signed saturation of the pack leaves it alone
+        return _mm_srai_epi32(_mm_slli_epi32(half, 16), 16);
+    };
+
+    // Eight values at a time
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8)
+    {
+        _mm_storeu_si128(
+            reinterpret_cast<__m128i *>(outValues + i),
+            _mm_packs_epi32(toHalf(inValues + i), toHalf(inValues + i + 4)));
+    }
+
+    PackFloatsToHalfFloats_Naive(inValues + i, outValues + i, count - i);
+}
+#endif
+
+inline void PackFloatsToHalfFloats(
+    float const * restrict inValues,
+    std::uint16_t * restrict outValues,
+    size_t count) noexcept
+{
+#if FS_IS_ARCHITECTURE_X86_32() || FS_IS_ARCHITECTURE_X86_64()
+    PackFloatsToHalfFloats_SSEVectorized(inValues, outValues, count);
+#else
+    PackFloatsToHalfFloats_Naive(inValues, outValues, count);
+#endif
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////
+// Shallow water equations
+///////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/*
+ * Advances the fields of a 1-D shallow water simulation on a staggered grid, in place.
+ *
+ * "q-Upwind Numerical Scheme" from "Improving the stability of a simple formulation of the shallow water equations for 2-D flood modeling",
+ *      de Almeida, Bates, Freer, Souvignet (2012), https://agupubs.onlinelibrary.wiley.com/doi/full/10.1029/2011WR011570
+ *
+ * Height field  : from 0 to sampleCount
+ * Velocity field: from 1 to sampleCount (i.e. at boundaries it's inner only)
+ *                 H[i] has V[i] at its left and V[i+1] at its right
+ *
+ * Velocities are updated left-to-right, each one using the already-updated velocity at its left.
+ */
+inline void UpdateSWEFields(
+    float * restrict heightField,
+    float * restrict velocityField,
+    size_t sampleCount,
+    float dtOverDx,
+    float gDtOverDx,
+    float previousVWeight1,
+    float previousVWeight2) noexcept // Includes /2 for average
+{
+    // Update first height field value
+    heightField[0] *=
+        1.0f + dtOverDx * (velocityField[0] - velocityField[0 + 1]);
+
+    for (size_t i = 1; i < sampleCount; ++i)
+    {
+        // Update height field
+        heightField[i] *=
+            1.0f + dtOverDx * (velocityField[i] - velocityField[i + 1]);
+
+        // V @ t-1: mix of V[i] and of avg(V[i-1], V[i+1])
+        float const previousV =
+            previousVWeight1 * velocityField[i]
+            + previousVWeight2 * (velocityField[i - 1] + velocityField[i + 1]);
+
+        // Update velocity field
+        velocityField[i] = previousV - gDtOverDx * (heightField[i] - heightField[i - 1]);
+    }
+}
+
+/*
+ * Same scheme as UpdateSWEFields(), but with input and output fields in separate buffers,
+ * so that it may run concurrently on disjoint slabs [startSample, endSample) of the fields.
+ *
+ * Heights only depend on the previous step and are updated in a loop without dependencies.
+ * Velocities depend on the already-updated velocity at their left, hence each slab starts
+ * its velocity pass within a halo of samples at its left, using the previous step's velocity
+ * at the start of the halo; the error of this guess decays by a factor of previousVWeight2
+ * (at most 1/2) at each sample, and thus it has vanished - below float resolution - by the
+ * time the pass reaches the slab.
+ *
+ * Slabs only read the input fields outside of their own ranges, hence they never read each
+ * other's output. The output velocity field also receives the velocities at both boundaries -
+ * which are not updated by the scheme - from the slabs containing the first and last samples.
+ */
+inline void UpdateSWEFieldsSlab(
+    float const * restrict inHeightField,
+    float const * restrict inVelocityField,
+    float * restrict outHeightField,
+    float * restrict outVelocityField,
+    size_t sampleCount,
+    size_t startSample,
+    size_t endSample,
+    float dtOverDx,
+    float gDtOverDx,
+    float previousVWeight1,
+    float previousVWeight2) noexcept // Includes /2 for average
+{
+    assert(startSample < endSample && endSample <= sampleCount);
+
+    size_t constexpr VelocityHaloSize = 32;
+
+    //
+    // Height field
+    //
+
+    for (size_t i = startSample; i < endSample; ++i)
+    {
+        outHeightField[i] =
+            inHeightField[i]
+            * (1.0f + dtOverDx * (inVelocityField[i] - inVelocityField[i + 1]));
+    }
+
+    //
+    // Velocity field
+    //
+
+    size_t firstVelocitySample;
+    float previousNewV;
+    if (startSample <= VelocityHaloSize)
+    {
+        // Start from the boundary, which is not updated
+        firstVelocitySample = 1;
+        previousNewV = inVelocityField[0];
+    }
+    else
+    {
+        // Start from the halo, guessing the updated velocity at its left
+        firstVelocitySample = startSample - VelocityHaloSize;
+        previousNewV = inVelocityField[firstVelocitySample - 1];
+    }
+
+    float previousNewH =
+        inHeightField[firstVelocitySample - 1]
+        * (1.0f + dtOverDx * (inVelocityField[firstVelocitySample - 1] - inVelocityField[firstVelocitySample]));
+
+    for (size_t i = firstVelocitySample; i < endSample; ++i)
+    {
+        float const newH = (i < startSample)
+            ? inHeightField[i] * (1.0f + dtOverDx * (inVelocityField[i] - inVelocityField[i + 1])) // Halo
+            : outHeightField[i];
+
+        // V @ t-1: mix of V[i] and of avg(V[i-1], V[i+1])
+        float const previousV =
+            previousVWeight1 * inVelocityField[i]
+            + previousVWeight2 * (previousNewV + inVelocityField[i + 1]);
+
+        float const newV = previousV - gDtOverDx * (newH - previousNewH);
+
+        if (i >= startSample)
+        {
+            outVelocityField[i] = newV;
+        }
+
+        previousNewV = newV;
+        previousNewH = newH;
+    }
+
+    //
+    // Boundaries, which are not updated
+    //
+
+    if (startSample == 0)
+    {
+        outVelocityField[0] = inVelocityField[0];
+    }
+
+    if (endSample == sampleCount)
+    {
+        outVelocityField[sampleCount] = inVelocityField[sampleCount];
+    }
+}
+
 }
\ No newline at end of file
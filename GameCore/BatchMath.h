@@ -0,0 +1,737 @@
+/***************************************************************************************
+* Original Author:      Gabriele Giuseppini
+* Created:              2026-10-14
+* Copyright:            Gabriele Giuseppini  (https://github.com/GabrieleGiuseppini)
+***************************************************************************************/
+#pragma once
+
+#include "GameMath.h"
+#include "SysSpecifics.h"
+#include "Vectors.h"
+
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+
+#if FS_IS_ARCHITECTURE_X86_32() || FS_IS_ARCHITECTURE_X86_64()
+#include <immintrin.h>
+#endif
+
+/*
+ * Batched versions of the fast approximations in GameMath.h, operating on spans
+ * of elements - a pointer to the first element and a count.
+ *
+ * Each function has a scalar back end (_Naive), which defines its results, and
+ * SSE2, AVX2, and NEON back ends, which calculate the same operations in the same
+ * order, and thus (modulo the rounding of the platform) the same results; the
+ * unsuffixed function dispatches to the widest back end supported by the CPU
+ * we're running on.
+ *
+ * Input and output spans may be unaligned, but may not overlap - unless they are
+ * the same span.
+ */
+namespace BatchMath {
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////
+// Naive
+///////////////////////////////////////////////////////////////////////////////////////////////////////
+
+inline void FastLog_Naive(
+    float const * x,
+    float * out,
+    size_t count) noexcept
+{
+    for (size_t i = 0; i < count; ++i)
+    {
+        out[i] = FastLog(x[i]);
+    }
+}
+
+inline void FastExp_Naive(
+    float const * x,
+    float * out,
+    size_t count) noexcept
+{
+    for (size_t i = 0; i < count; ++i)
+    {
+        out[i] = FastExp(x[i]);
+    }
+}
+
+inline void FastPow_Naive(
+    float const * x,
+    float p,
+    float * out,
+    size_t count) noexcept
+{
+    for (size_t i = 0; i < count; ++i)
+    {
+        out[i] = FastPow(x[i], p);
+    }
+}
+
+inline void Step_Naive(
+    float lEdge,
+    float const * x,
+    float * out,
+    size_t count) noexcept
+{
+    for (size_t i = 0; i < count; ++i)
+    {
+        out[i] = Step(lEdge, x[i]);
+    }
+}
+
+inline void Normalize_Naive(
+    vec2f const * vectors,
+    vec2f * outNormalized,
+    size_t count) noexcept
+{
+    for (size_t i = 0; i < count; ++i)
+    {
+        outNormalized[i] = vectors[i].normalise();
+    }
+}
+
+inline void Length_Naive(
+    vec2f const * vectors,
+    float * outLengths,
+    size_t count) noexcept
+{
+    for (size_t i = 0; i < count; ++i)
+    {
+        outLengths[i] = vectors[i].length();
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////
+// SSE2
+///////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#if FS_IS_ARCHITECTURE_X86_32() || FS_IS_ARCHITECTURE_X86_64()
+
+namespace detail {
+
+    inline __m128 FastLog2_4(__m128 x) noexcept
+    {
+        __m128i const vx = _mm_castps_si128(x);
+        __m128 const mx = _mm_castsi128_ps(
+            _mm_or_si128(
+                _mm_and_si128(vx, _mm_set1_epi32(0x007FFFFF)),
+                _mm_set1_epi32(0x3f000000)));
+
+        __m128 const y = _mm_mul_ps(_mm_cvtepi32_ps(vx), _mm_set1_ps(1.1920928955078125e-7f));
+
+        return _mm_sub_ps(
+            _mm_sub_ps(
+                _mm_sub_ps(y, _mm_set1_ps(124.22551499f)),
+                _mm_mul_ps(_mm_set1_ps(1.498030302f), mx)),
+            _mm_div_ps(
+                _mm_set1_ps(1.72587999f),
+                _mm_add_ps(_mm_set1_ps(0.3520887068f), mx)));
+    }
+
+    inline __m128 FastPow2_4(__m128 p) noexcept
+    {
+        __m128 const offset = _mm_and_ps(_mm_cmplt_ps(p, _mm_setzero_ps()), _mm_set1_ps(1.0f));
+        __m128 const clipp = _mm_max_ps(p, _mm_set1_ps(-126.0f));
+        __m128 const w = _mm_cvtepi32_ps(_mm_cvttps_epi32(clipp));
+        __m128 const z = _mm_add_ps(_mm_sub_ps(clipp, w), offset);
+
+        __m128 const v = _mm_mul_ps(
+            _mm_set1_ps(static_cast<float>(1 << 23)),
+            _mm_sub_ps(
+                _mm_add_ps(
+                    _mm_add_ps(clipp, _mm_set1_ps(121.2740575f)),
+                    _mm_div_ps(_mm_set1_ps(27.7280233f), _mm_sub_ps(_mm_set1_ps(4.84252568f), z))),
+                _mm_mul_ps(_mm_set1_ps(1.49012907f), z)));
+
+        return _mm_castsi128_ps(_mm_cvttps_epi32(v));
+    }
+}
+
+inline void FastLog_SSE2(
+    float const * x,
+    float * out,
+    size_t count) noexcept
+{
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4)
+    {
+        _mm_storeu_ps(out + i, _mm_mul_ps(_mm_set1_ps(0.69314718f), detail::FastLog2_4(_mm_loadu_ps(x + i))));
+    }
+
+    FastLog_Naive(x + i, out + i, count - i);
+}
+
+inline void FastExp_SSE2(
+    float const * x,
+    float * out,
+    size_t count) noexcept
+{
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4)
+    {
+        _mm_storeu_ps(out + i, detail::FastPow2_4(_mm_mul_ps(_mm_set1_ps(1.442695040f), _mm_loadu_ps(x + i))));
+    }
+
+    FastExp_Naive(x + i, out + i, count - i);
+}
+
+inline void FastPow_SSE2(
+    float const * x,
+    float p,
+    float * out,
+    size_t count) noexcept
+{
+    __m128 const p_4 = _mm_set1_ps(p);
+
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4)
+    {
+        _mm_storeu_ps(out + i, detail::FastPow2_4(_mm_mul_ps(p_4, detail::FastLog2_4(_mm_loadu_ps(x + i)))));
+    }
+
+    FastPow_Naive(x + i, p, out + i, count - i);
+}
+
+inline void Step_SSE2(
+    float lEdge,
+    float const * x,
+    float * out,
+    size_t count) noexcept
+{
+    __m128 const lEdge_4 = _mm_set1_ps(lEdge);
+    __m128 const One_4 = _mm_set1_ps(1.0f);
+
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4)
+    {
+        _mm_storeu_ps(out + i, _mm_and_ps(_mm_cmpnlt_ps(_mm_loadu_ps(x + i), lEdge_4), One_4));
+    }
+
+    Step_Naive(lEdge, x + i, out + i, count - i);
+}
+
+inline void Normalize_SSE2(
+    vec2f const * vectors,
+    vec2f * outNormalized,
+    size_t count) noexcept
+{
+    static_assert(sizeof(vec2f) == 2 * sizeof(float));
+
+    float const * const vectorsFloat = reinterpret_cast<float const *>(vectors);
+    float * const outNormalizedFloat = reinterpret_cast<float *>(outNormalized);
+
+    __m128 const Zero_4 = _mm_setzero_ps();
+
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4)
+    {
+        __m128 const v01 = _mm_loadu_ps(vectorsFloat + 2 * i); // x0,y0,x1,y1
+        __m128 const v23 = _mm_loadu_ps(vectorsFloat + 2 * i + 4); // x2,y2,x3,y3
+
+        __m128 const x_4 = _mm_shuffle_ps(v01, v23, 0x88); // x0,x1,x2,x3
+        __m128 const y_4 = _mm_shuffle_ps(v01, v23, 0xDD); // y0,y1,y2,y3
+
+        __m128 const squareLength_4 = _mm_add_ps(_mm_mul_ps(x_4, x_4), _mm_mul_ps(y_4, y_4));
+        __m128 const length_4 = _mm_sqrt_ps(squareLength_4);
+
+        // Zero vectors normalize to zero, as in vec2f
+        __m128 const validMask_4 = _mm_cmpneq_ps(squareLength_4, Zero_4);
+        __m128 const nx_4 = _mm_and_ps(_mm_div_ps(x_4, length_4), validMask_4);
+        __m128 const ny_4 = _mm_and_ps(_mm_div_ps(y_4, length_4), validMask_4);
+
+        _mm_storeu_ps(outNormalizedFloat + 2 * i, _mm_unpacklo_ps(nx_4, ny_4));
+        _mm_storeu_ps(outNormalizedFloat + 2 * i + 4, _mm_unpackhi_ps(nx_4, ny_4));
+    }
+
+    Normalize_Naive(vectors + i, outNormalized + i, count - i);
+}
+
+inline void Length_SSE2(
+    vec2f const * vectors,
+    float * outLengths,
+    size_t count) noexcept
+{
+    static_assert(sizeof(vec2f) == 2 * sizeof(float));
+
+    float const * const vectorsFloat = reinterpret_cast<float const *>(vectors);
+
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4)
+    {
+        __m128 const v01 = _mm_loadu_ps(vectorsFloat + 2 * i); // x0,y0,x1,y1
+        __m128 const v23 = _mm_loadu_ps(vectorsFloat + 2 * i + 4); // x2,y2,x3,y3
+
+        __m128 const x_4 = _mm_shuffle_ps(v01, v23, 0x88); // x0,x1,x2,x3
+        __m128 const y_4 = _mm_shuffle_ps(v01, v23, 0xDD); // y0,y1,y2,y3
+
+        _mm_storeu_ps(outLengths + i, _mm_sqrt_ps(_mm_add_ps(_mm_mul_ps(x_4, x_4), _mm_mul_ps(y_4, y_4))));
+    }
+
+    Length_Naive(vectors + i, outLengths + i, count - i);
+}
+
+#endif
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////
+// AVX2
+///////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#if FS_IS_ARCHITECTURE_X86_32() || FS_IS_ARCHITECTURE_X86_64()
+
+namespace detail {
+
+    FS_TARGET_AVX2 inline __m256 FastLog2_8(__m256 x) noexcept
+    {
+        __m256i const vx = _mm256_castps_si256(x);
+        __m256 const mx = _mm256_castsi256_ps(
+            _mm256_or_si256(
+                _mm256_and_si256(vx, _mm256_set1_epi32(0x007FFFFF)),
+                _mm256_set1_epi32(0x3f000000)));
+
+        __m256 const y = _mm256_mul_ps(_mm256_cvtepi32_ps(vx), _mm256_set1_ps(1.1920928955078125e-7f));
+
+        return _mm256_sub_ps(
+            _mm256_sub_ps(
+                _mm256_sub_ps(y, _mm256_set1_ps(124.22551499f)),
+                _mm256_mul_ps(_mm256_set1_ps(1.498030302f), mx)),
+            _mm256_div_ps(
+                _mm256_set1_ps(1.72587999f),
+                _mm256_add_ps(_mm256_set1_ps(0.3520887068f), mx)));
+    }
+
+    FS_TARGET_AVX2 inline __m256 FastPow2_8(__m256 p) noexcept
+    {
+        __m256 const offset = _mm256_and_ps(_mm256_cmp_ps(p, _mm256_setzero_ps(), _CMP_LT_OQ), _mm256_set1_ps(1.0f));
+        __m256 const clipp = _mm256_max_ps(p, _mm256_set1_ps(-126.0f));
+        __m256 const w = _mm256_cvtepi32_ps(_mm256_cvttps_epi32(clipp));
+        __m256 const z = _mm256_add_ps(_mm256_sub_ps(clipp, w), offset);
+
+        __m256 const v = _mm256_mul_ps(
+            _mm256_set1_ps(static_cast<float>(1 << 23)),
+            _mm256_sub_ps(
+                _mm256_add_ps(
+                    _mm256_add_ps(clipp, _mm256_set1_ps(121.2740575f)),
+                    _mm256_div_ps(_mm256_set1_ps(27.7280233f), _mm256_sub_ps(_mm256_set1_ps(4.84252568f), z))),
+                _mm256_mul_ps(_mm256_set1_ps(1.49012907f), z)));
+
+        return _mm256_castsi256_ps(_mm256_cvttps_epi32(v));
+    }
+}
+
+FS_TARGET_AVX2 inline void FastLog_AVX2(
+    float const * x,
+    float * out,
+    size_t count) noexcept
+{
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8)
+    {
+        _mm256_storeu_ps(out + i, _mm256_mul_ps(_mm256_set1_ps(0.69314718f), detail::FastLog2_8(_mm256_loadu_ps(x + i))));
+    }
+
+    FastLog_SSE2(x + i, out + i, count - i);
+}
+
+FS_TARGET_AVX2 inline void FastExp_AVX2(
+    float const * x,
+    float * out,
+    size_t count) noexcept
+{
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8)
+    {
+        _mm256_storeu_ps(out + i, detail::FastPow2_8(_mm256_mul_ps(_mm256_set1_ps(1.442695040f), _mm256_loadu_ps(x + i))));
+    }
+
+    FastExp_SSE2(x + i, out + i, count - i);
+}
+
+FS_TARGET_AVX2 inline void FastPow_AVX2(
+    float const * x,
+    float p,
+    float * out,
+    size_t count) noexcept
+{
+    __m256 const p_8 = _mm256_set1_ps(p);
+
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8)
+    {
+        _mm256_storeu_ps(out + i, detail::FastPow2_8(_mm256_mul_ps(p_8, detail::FastLog2_8(_mm256_loadu_ps(x + i)))));
+    }
+
+    FastPow_SSE2(x + i, p, out + i, count - i);
+}
+
+FS_TARGET_AVX2 inline void Step_AVX2(
+    float lEdge,
+    float const * x,
+    float * out,
+    size_t count) noexcept
+{
+    __m256 const lEdge_8 = _mm256_set1_ps(lEdge);
+    __m256 const One_8 = _mm256_set1_ps(1.0f);
+
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8)
+    {
+        _mm256_storeu_ps(out + i, _mm256_and_ps(_mm256_cmp_ps(_mm256_loadu_ps(x + i), lEdge_8, _CMP_NLT_UQ), One_8));
+    }
+
+    Step_SSE2(lEdge, x + i, out + i, count - i);
+}
+
+FS_TARGET_AVX2 inline void Normalize_AVX2(
+    vec2f const * vectors,
+    vec2f * outNormalized,
+    size_t count) noexcept
+{
+    static_assert(sizeof(vec2f) == 2 * sizeof(float));
+
+    float const * const vectorsFloat = reinterpret_cast<float const *>(vectors);
+    float * const outNormalizedFloat = reinterpret_cast<float *>(outNormalized);
+
+    __m256 const Zero_8 = _mm256_setzero_ps();
+
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8)
+    {
+        // Shuffles work within 128-bit lanes, hence xs and ys come out as (0,1,4,5,2,3,6,7) -
+        // which is fine, as unpacking puts them back in the same order
+        __m256 const v0123 = _mm256_loadu_ps(vectorsFloat + 2 * i); // x0,y0,x1,y1 | x2,y2,x3,y3
+        __m256 const v4567 = _mm256_loadu_ps(vectorsFloat + 2 * i + 8); // x4,y4,x5,y5 | x6,y6,x7,y7
+
+        __m256 const x_8 = _mm256_shuffle_ps(v0123, v4567, 0x88);
+        __m256 const y_8 = _mm256_shuffle_ps(v0123, v4567, 0xDD);
+
+        __m256 const squareLength_8 = _mm256_add_ps(_mm256_mul_ps(x_8, x_8), _mm256_mul_ps(y_8, y_8));
+        __m256 const length_8 = _mm256_sqrt_ps(squareLength_8);
+
+        // Zero vectors normalize to zero, as in vec2f
+        __m256 const validMask_8 = _mm256_cmp_ps(squareLength_8, Zero_8, _CMP_NEQ_OQ);
+        __m256 const nx_8 = _mm256_and_ps(_mm256_div_ps(x_8, length_8), validMask_8);
+        __m256 const ny_8 = _mm256_and_ps(_mm256_div_ps(y_8, length_8), validMask_8);
+
+        _mm256_storeu_ps(outNormalizedFloat + 2 * i, _mm256_unpacklo_ps(nx_8, ny_8));
+        _mm256_storeu_ps(outNormalizedFloat + 2 * i + 8, _mm256_unpackhi_ps(nx_8, ny_8));
+    }
+
+    Normalize_SSE2(vectors + i, outNormalized + i, count - i);
+}
+
+FS_TARGET_AVX2 inline void Length_AVX2(
+    vec2f const * vectors,
+    float * outLengths,
+    size_t count) noexcept
+{
+    static_assert(sizeof(vec2f) == 2 * sizeof(float));
+
+    float const * const vectorsFloat = reinterpret_cast<float const *>(vectors);
+
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8)
+    {
+        __m256 const v0123 = _mm256_loadu_ps(vectorsFloat + 2 * i); // x0,y0,x1,y1 | x2,y2,x3,y3
+        __m256 const v4567 = _mm256_loadu_ps(vectorsFloat + 2 * i + 8); // x4,y4,x5,y5 | x6,y6,x7,y7
+
+        __m256 const x_8 = _mm256_shuffle_ps(v0123, v4567, 0x88); // x0,x1,x4,x5 | x2,x3,x6,x7
+        __m256 const y_8 = _mm256_shuffle_ps(v0123, v4567, 0xDD);
+
+        __m256 const length_8 = _mm256_sqrt_ps(_mm256_add_ps(_mm256_mul_ps(x_8, x_8), _mm256_mul_ps(y_8, y_8)));
+
+        // Restore element order: 0,1,4,5,2,3,6,7 -> 0,1,2,3,4,5,6,7
+        _mm256_storeu_ps(
+            outLengths + i,
+            _mm256_castpd_ps(_mm256_permute4x64_pd(_mm256_castps_pd(length_8), 0xD8)));
+    }
+
+    Length_SSE2(vectors + i, outLengths + i, count - i);
+}
+
+#endif
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////
+// NEON
+///////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#if FS_IS_ARCHITECTURE_ARM_64()
+
+namespace detail {
+
+    inline float32x4_t FastLog2_4(float32x4_t x) noexcept
+    {
+        uint32x4_t const vx = vreinterpretq_u32_f32(x);
+        float32x4_t const mx = vreinterpretq_f32_u32(
+            vorrq_u32(
+                vandq_u32(vx, vdupq_n_u32(0x007FFFFF)),
+                vdupq_n_u32(0x3f000000)));
+
+        float32x4_t const y = vmulq_f32(vcvtq_f32_u32(vx), vdupq_n_f32(1.1920928955078125e-7f));
+
+        return vsubq_f32(
+            vsubq_f32(
+                vsubq_f32(y, vdupq_n_f32(124.22551499f)),
+                vmulq_f32(vdupq_n_f32(1.498030302f), mx)),
+            vdivq_f32(
+                vdupq_n_f32(1.72587999f),
+                vaddq_f32(vdupq_n_f32(0.3520887068f), mx)));
+    }
+
+    inline float32x4_t FastPow2_4(float32x4_t p) noexcept
+    {
+        float32x4_t const offset = vreinterpretq_f32_u32(
+            vandq_u32(
+                vcltq_f32(p, vdupq_n_f32(0.0f)),
+                vreinterpretq_u32_f32(vdupq_n_f32(1.0f))));
+        float32x4_t const clipp = vmaxq_f32(p, vdupq_n_f32(-126.0f));
+        float32x4_t const w = vcvtq_f32_s32(vcvtq_s32_f32(clipp));
+        float32x4_t const z = vaddq_f32(vsubq_f32(clipp, w), offset);
+
+        float32x4_t const v = vmulq_f32(
+            vdupq_n_f32(static_cast<float>(1 << 23)),
+            vsubq_f32(
+                vaddq_f32(
+                    vaddq_f32(clipp, vdupq_n_f32(121.2740575f)),
+                    vdivq_f32(vdupq_n_f32(27.7280233f), vsubq_f32(vdupq_n_f32(4.84252568f), z))),
+                vmulq_f32(vdupq_n_f32(1.49012907f), z)));
+
+        return vreinterpretq_f32_u32(vcvtq_u32_f32(v));
+    }
+}
+
+inline void FastLog_NEON(
+    float const * x,
+    float * out,
+    size_t count) noexcept
+{
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4)
+    {
+        vst1q_f32(out + i, vmulq_f32(vdupq_n_f32(0.69314718f), detail::FastLog2_4(vld1q_f32(x + i))));
+    }
+
+    FastLog_Naive(x + i, out + i, count - i);
+}
+
+inline void FastExp_NEON(
+    float const * x,
+    float * out,
+    size_t count) noexcept
+{
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4)
+    {
+        vst1q_f32(out + i, detail::FastPow2_4(vmulq_f32(vdupq_n_f32(1.442695040f), vld1q_f32(x + i))));
+    }
+
+    FastExp_Naive(x + i, out + i, count - i);
+}
+
+inline void FastPow_NEON(
+    float const * x,
+    float p,
+    float * out,
+    size_t count) noexcept
+{
+    float32x4_t const p_4 = vdupq_n_f32(p);
+
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4)
+    {
+        vst1q_f32(out + i, detail::FastPow2_4(vmulq_f32(p_4, detail::FastLog2_4(vld1q_f32(x + i)))));
+    }
+
+    FastPow_Naive(x + i, p, out + i, count - i);
+}
+
+inline void Step_NEON(
+    float lEdge,
+    float const * x,
+    float * out,
+    size_t count) noexcept
+{
+    float32x4_t const lEdge_4 = vdupq_n_f32(lEdge);
+    float32x4_t const Zero_4 = vdupq_n_f32(0.0f);
+    float32x4_t const One_4 = vdupq_n_f32(1.0f);
+
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4)
+    {
+        vst1q_f32(out + i, vbslq_f32(vcltq_f32(vld1q_f32(x + i), lEdge_4), Zero_4, One_4));
+    }
+
+    Step_Naive(lEdge, x + i, out + i, count - i);
+}
+
+inline void Normalize_NEON(
+    vec2f const * vectors,
+    vec2f * outNormalized,
+    size_t count) noexcept
+{
+    static_assert(sizeof(vec2f) == 2 * sizeof(float));
+
+    float const * const vectorsFloat = reinterpret_cast<float const *>(vectors);
+    float * const outNormalizedFloat = reinterpret_cast<float *>(outNormalized);
+
+    float32x4_t const Zero_4 = vdupq_n_f32(0.0f);
+
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4)
+    {
+        // De-interleaving load: val[0] = xs, val[1] = ys
+        float32x4x2_t const v_4 = vld2q_f32(vectorsFloat + 2 * i);
+
+        float32x4_t const squareLength_4 = vaddq_f32(vmulq_f32(v_4.val[0], v_4.val[0]), vmulq_f32(v_4.val[1], v_4.val[1]));
+        float32x4_t const length_4 = vsqrtq_f32(squareLength_4);
+
+        // Zero vectors normalize to zero, as in vec2f
+        uint32x4_t const invalidMask_4 = vceqq_f32(squareLength_4, Zero_4);
+
+        float32x4x2_t n_4;
+        n_4.val[0] = vbslq_f32(invalidMask_4, Zero_4, vdivq_f32(v_4.val[0], length_4));
+        n_4.val[1] = vbslq_f32(invalidMask_4, Zero_4, vdivq_f32(v_4.val[1], length_4));
+
+        vst2q_f32(outNormalizedFloat + 2 * i, n_4);
+    }
+
+    Normalize_Naive(vectors + i, outNormalized + i, count - i);
+}
+
+inline void Length_NEON(
+    vec2f const * vectors,
+    float * outLengths,
+    size_t count) noexcept
+{
+    static_assert(sizeof(vec2f) == 2 * sizeof(float));
+
+    float const * const vectorsFloat = reinterpret_cast<float const *>(vectors);
+
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4)
+    {
+        float32x4x2_t const v_4 = vld2q_f32(vectorsFloat + 2 * i);
+
+        vst1q_f32(outLengths + i, vsqrtq_f32(vaddq_f32(vmulq_f32(v_4.val[0], v_4.val[0]), vmulq_f32(v_4.val[1], v_4.val[1]))));
+    }
+
+    Length_Naive(vectors + i, outLengths + i, count - i);
+}
+
+#endif
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////
+// Dispatchers
+///////////////////////////////////////////////////////////////////////////////////////////////////////
+
+inline void FastLog(
+    float const * x,
+    float * out,
+    size_t count) noexcept
+{
+#if FS_IS_ARCHITECTURE_X86_32() || FS_IS_ARCHITECTURE_X86_64()
+    if (IsAVX2Supported())
+        FastLog_AVX2(x, out, count);
+    else
+        FastLog_SSE2(x, out, count);
+#elif FS_IS_ARCHITECTURE_ARM_64()
+    FastLog_NEON(x, out, count);
+#else
+    FastLog_Naive(x, out, count);
+#endif
+}
+
+inline void FastExp(
+    float const * x,
+    float * out,
+    size_t count) noexcept
+{
+#if FS_IS_ARCHITECTURE_X86_32() || FS_IS_ARCHITECTURE_X86_64()
+    if (IsAVX2Supported())
+        FastExp_AVX2(x, out, count);
+    else
+        FastExp_SSE2(x, out, count);
+#elif FS_IS_ARCHITECTURE_ARM_64()
+    FastExp_NEON(x, out, count);
+#else
+    FastExp_Naive(x, out, count);
+#endif
+}
+
+inline void FastPow(
+    float const * x,
+    float p,
+    float * out,
+    size_t count) noexcept
+{
+#if FS_IS_ARCHITECTURE_X86_32() || FS_IS_ARCHITECTURE_X86_64()
+    if (IsAVX2Supported())
+        FastPow_AVX2(x, p, out, count);
+    else
+        FastPow_SSE2(x, p, out, count);
+#elif FS_IS_ARCHITECTURE_ARM_64()
+    FastPow_NEON(x, p, out, count);
+#else
+    FastPow_Naive(x, p, out, count);
+#endif
+}
+
+inline void Step(
+    float lEdge,
+    float const * x,
+    float * out,
+    size_t count) noexcept
+{
+#if FS_IS_ARCHITECTURE_X86_32() || FS_IS_ARCHITECTURE_X86_64()
+    if (IsAVX2Supported())
+        Step_AVX2(lEdge, x, out, count);
+    else
+        Step_SSE2(lEdge, x, out, count);
+#elif FS_IS_ARCHITECTURE_ARM_64()
+    Step_NEON(lEdge, x, out, count);
+#else
+    Step_Naive(lEdge, x, out, count);
+#endif
+}
+
+/*
+ * Zero vectors are normalized to zero, as in vec2f::normalise().
+ */
+inline void Normalize(
+    vec2f const * vectors,
+    vec2f * outNormalized,
+    size_t count) noexcept
+{
+#if FS_IS_ARCHITECTURE_X86_32() || FS_IS_ARCHITECTURE_X86_64()
+    if (IsAVX2Supported())
+        Normalize_AVX2(vectors, outNormalized, count);
+    else
+        Normalize_SSE2(vectors, outNormalized, count);
+#elif FS_IS_ARCHITECTURE_ARM_64()
+    Normalize_NEON(vectors, outNormalized, count);
+#else
+    Normalize_Naive(vectors, outNormalized, count);
+#endif
+}
+
+inline void Length(
+    vec2f const * vectors,
+    float * outLengths,
+    size_t count) noexcept
+{
+#if FS_IS_ARCHITECTURE_X86_32() || FS_IS_ARCHITECTURE_X86_64()
+    if (IsAVX2Supported())
+        Length_AVX2(vectors, outLengths, count);
+    else
+        Length_SSE2(vectors, outLengths, count);
+#elif FS_IS_ARCHITECTURE_ARM_64()
+    Length_NEON(vectors, outLengths, count);
+#else
+    Length_Naive(vectors, outLengths, count);
+#endif
+}
+
+}
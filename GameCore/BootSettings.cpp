@@ -24,6 +24,10 @@ BootSettings BootSettings::Load(std::filesystem::path const & filePath)
             {
                 settings.DoForceNoGlFinish = Utils::GetOptionalJsonMember<bool>(rootObject, "force_no_glfinish");
                 settings.DoForceNoMultithreadedRendering = Utils::GetOptionalJsonMember<bool>(rootObject, "force_no_multithreaded_rendering");
+                settings.DoUseHugePages = Utils::GetOptionalJsonMember<bool>(rootObject, "use_huge_pages");
+                settings.DoPreferPerformanceCores = Utils::GetOptionalJsonMember<bool>(rootObject, "prefer_performance_cores");
+                settings.DoSeparateRenderThread = Utils::GetOptionalJsonMember<bool>(rootObject, "separate_render_thread");
+                settings.DoElevateMainThreadPriority = Utils::GetOptionalJsonMember<bool>(rootObject, "elevate_main_thread_priority");
             }
         }
     }
@@ -49,6 +53,18 @@ void BootSettings::Save(
     if (settings.DoForceNoMultithreadedRendering.has_value())
         rootObject["force_no_multithreaded_rendering"] = picojson::value(*(settings.DoForceNoMultithreadedRendering));
 
+    if (settings.DoUseHugePages.has_value())
+        rootObject["use_huge_pages"] = picojson::value(*(settings.DoUseHugePages));
+
+    if (settings.DoPreferPerformanceCores.has_value())
+        rootObject["prefer_performance_cores"] = picojson::value(*(settings.DoPreferPerformanceCores));
+
+    if (settings.DoSeparateRenderThread.has_value())
+        rootObject["separate_render_thread"] = picojson::value(*(settings.DoSeparateRenderThread));
+
+    if (settings.DoElevateMainThreadPriority.has_value())
+        rootObject["elevate_main_thread_priority"] = picojson::value(*(settings.DoElevateMainThreadPriority));
+
     // Save
     Utils::SaveJSONFile(
         picojson::value(rootObject),
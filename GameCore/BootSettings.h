@@ -14,23 +14,43 @@ public:
 
     std::optional<bool> DoForceNoGlFinish;
     std::optional<bool> DoForceNoMultithreadedRendering;
+    std::optional<bool> DoUseHugePages;
+    std::optional<bool> DoPreferPerformanceCores;
+    std::optional<bool> DoSeparateRenderThread;
+    std::optional<bool> DoElevateMainThreadPriority;
 
     BootSettings()
         : DoForceNoGlFinish()
         , DoForceNoMultithreadedRendering()
+        , DoUseHugePages()
+        , DoPreferPerformanceCores()
+        , DoSeparateRenderThread()
+        , DoElevateMainThreadPriority()
     {}
 
     BootSettings(
         std::optional<bool> doForceNoGlFinish,
-        std::optional<bool> doForceNoMultithreadedRendering)
+        std::optional<bool> doForceNoMultithreadedRendering,
+        std::optional<bool> doUseHugePages,
+        std::optional<bool> doPreferPerformanceCores,
+        std::optional<bool> doSeparateRenderThread,
+        std::optional<bool> doElevateMainThreadPriority)
         : DoForceNoGlFinish(doForceNoGlFinish)
         , DoForceNoMultithreadedRendering(doForceNoMultithreadedRendering)
+        , DoUseHugePages(doUseHugePages)
+        , DoPreferPerformanceCores(doPreferPerformanceCores)
+        , DoSeparateRenderThread(doSeparateRenderThread)
+        , DoElevateMainThreadPriority(doElevateMainThreadPriority)
     {}
 
     bool operator==(BootSettings const & rhs) const
     {
         return this->DoForceNoGlFinish == rhs.DoForceNoGlFinish
-            && this->DoForceNoMultithreadedRendering == rhs.DoForceNoMultithreadedRendering;
+            && this->DoForceNoMultithreadedRendering == rhs.DoForceNoMultithreadedRendering
+            && this->DoUseHugePages == rhs.DoUseHugePages
+            && this->DoPreferPerformanceCores == rhs.DoPreferPerformanceCores
+            && this->DoSeparateRenderThread == rhs.DoSeparateRenderThread
+            && this->DoElevateMainThreadPriority == rhs.DoElevateMainThreadPriority;
     }
 
 public:
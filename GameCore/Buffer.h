@@ -15,6 +15,7 @@
 #include <functional>
 #include <memory>
 #include <stdexcept>
+#include <vector>
 
 /*
  * This class is the base of a hierarchy implementing a simple buffer of "things".
@@ -45,6 +46,14 @@ public:
         return mSize;
     }
 
+    /*
+     * Gets the number of bytes occupied by the elements of the buffer, including the extra room.
+     */
+    size_t GetByteSize() const
+    {
+        return CalculateByteSize(mSize);
+    }
+
     /*
      * Gets the current number of elements populated in the buffer via emplace_back();
      * less than or equal the declared buffer size.
@@ -106,6 +115,39 @@ public:
         mCurrentPopulatedSize = other.mCurrentPopulatedSize;
     }
 
+    /*
+     * Adds the elements of another buffer at the specified indices, in order.
+     * Assumed to be invoked only at initialization time.
+     */
+    template<typename TIndex>
+    void emplace_back_from(
+        BaseBuffer<TElement> const & other,
+        std::vector<TIndex> const & otherIndices)
+    {
+        for (auto const otherIndex : otherIndices)
+        {
+            assert(static_cast<size_t>(otherIndex) < other.mSize);
+            emplace_back(other.mBuffer[otherIndex]);
+        }
+    }
+
+    /*
+     * Permutes the first elements of the buffer, so that the element at new index i
+     * is the element that was at index newToOldIndices[i].
+     */
+    template<typename TIndex>
+    void permute(std::vector<TIndex> const & newToOldIndices)
+    {
+        assert(newToOldIndices.size() <= mSize);
+
+        std::vector<TElement> const oldElements(mBuffer, mBuffer + newToOldIndices.size());
+        for (size_t i = 0; i < newToOldIndices.size(); ++i)
+        {
+            assert(static_cast<size_t>(newToOldIndices[i]) < oldElements.size());
+            mBuffer[i] = oldElements[newToOldIndices[i]];
+        }
+    }
+
     /*
      * Gets an element.
      */
@@ -5,9 +5,11 @@
 ***************************************************************************************/
 #pragma once
 
+#include "Buffer2DView.h"
 #include "GameTypes.h"
 
 #include <algorithm>
+#include <cstring>
 #include <memory>
 
 template <typename TElement, typename TIntegralTag>
@@ -18,6 +20,8 @@ public:
     using element_type = TElement;
     using coordinates_type = _IntegralCoordinates<TIntegralTag>;
     using size_type = _IntegralSize<TIntegralTag>;
+    using view_type = Buffer2DView<TElement, TIntegralTag>;
+    using const_view_type = Buffer2DView<TElement const, TIntegralTag>;
 
 public:
 
@@ -120,6 +124,26 @@ public:
         return Data[linearIndex];
     }
 
+    view_type MakeView()
+    {
+        return view_type(Data.get(), Size, Size.width);
+    }
+
+    const_view_type MakeView() const
+    {
+        return const_view_type(Data.get(), Size, Size.width);
+    }
+
+    view_type MakeView(_IntegralRect<TIntegralTag> const & region)
+    {
+        return MakeView().GetRegion(region);
+    }
+
+    const_view_type MakeView(_IntegralRect<TIntegralTag> const & region) const
+    {
+        return MakeView().GetRegion(region);
+    }
+
     Buffer2D Clone() const
     {
         auto newData = std::make_unique<TElement[]>(mLinearSize);
@@ -133,22 +157,11 @@ public:
 
     Buffer2D CloneRegion(_IntegralRect<TIntegralTag> const & regionRect) const
     {
-        auto newData = std::make_unique<TElement[]>(regionRect.size.width * regionRect.size.height);
-
-        for (int targetY = 0; targetY < regionRect.size.height; ++targetY)
-        {
-            int const sourceLinearIndex = (targetY + regionRect.origin.y) * Size.width + regionRect.origin.x;
-            int const targetLinearIndex = targetY * regionRect.size.width;
+        Buffer2D newBuffer(regionRect.size);
 
-            std::memcpy(
-                newData.get() + targetLinearIndex,
-                Data.get() + sourceLinearIndex,
-                regionRect.size.width * sizeof(TElement));
-        }
+        newBuffer.MakeView().BlitFrom(MakeView(regionRect));
 
-        return Buffer2D(
-            regionRect.size,
-            std::move(newData));
+        return newBuffer;
     }
 
     void Trim(_IntegralRect<TIntegralTag> const & rect)
@@ -187,16 +200,7 @@ public:
         // The target origin plus the region size are within this buffer
         assert(_IntegralRect<TIntegralTag>(targetOrigin, sourceRegion.size).IsContainedInRect({ {0, 0}, Size }));
 
-        for (int sourceRegionY = 0; sourceRegionY < sourceRegion.size.height; ++sourceRegionY)
-        {
-            int const sourceLinearIndex = (sourceRegion.origin.y + sourceRegionY) * source.Size.width + sourceRegion.origin.x;
-            int const targetLinearIndex = (targetOrigin.y + sourceRegionY) * Size.width + targetOrigin.x;
-
-            std::memcpy(
-                Data.get() + targetLinearIndex,
-                source.Data.get() + sourceLinearIndex,
-                sourceRegion.size.width * sizeof(TElement));
-        }
+        MakeView(_IntegralRect<TIntegralTag>(targetOrigin, sourceRegion.size)).BlitFrom(source.MakeView(sourceRegion));
     }
 
     Buffer2D MakeReframed(
@@ -206,29 +210,33 @@ public:
     {
         auto newData = std::make_unique<TElement[]>(newSize.width * newSize.height);
 
-        int const leftFillerWRange = originOffset.x;
-        int const rightFillerWRange = std::min(originOffset.x + Size.width, newSize.width);
-
-        int const leftFillerHRange = originOffset.y;
-        int const rightFillerHRange = std::min(originOffset.y + Size.height, newSize.height);
+        // Range of new coordinates that land on old buffer
+        int const newStartX = std::clamp(originOffset.x, 0, newSize.width);
+        int const newEndX = std::clamp(originOffset.x + Size.width, newStartX, newSize.width);
+        int const newStartY = std::clamp(originOffset.y, 0, newSize.height);
+        int const newEndY = std::clamp(originOffset.y + Size.height, newStartY, newSize.height);
 
+        // Work by rows, filling and copying spans
         for (int ny = 0; ny < newSize.height; ++ny)
         {
-            int const oldYOffset = (ny - leftFillerHRange) * Size.width;
-            int const newYOffset = ny * newSize.width;
+            TElement * const newRow = newData.get() + ny * newSize.width;
 
-            for (int nx = 0; nx < newSize.width; ++nx)
+            if (ny < newStartY || ny >= newEndY || newStartX == newEndX)
             {
-                _IntegralCoordinates<TIntegralTag> const coords(nx, ny);
-                if (nx < leftFillerWRange || nx >= rightFillerWRange
-                    || ny < leftFillerHRange || ny >= rightFillerHRange)
-                {
-                    newData[newYOffset + nx] = fillerValue;
-                }
-                else
-                {
-                    newData[newYOffset + nx] = Data[oldYOffset + nx - leftFillerWRange];
-                }
+                std::fill(newRow, newRow + newSize.width, fillerValue);
+            }
+            else
+            {
+                TElement const * const oldRow = Data.get() + (ny - originOffset.y) * Size.width;
+
+                std::fill(newRow, newRow + newStartX, fillerValue);
+
+                std::memcpy(
+                    newRow + newStartX,
+                    oldRow + (newStartX - originOffset.x),
+                    (newEndX - newStartX) * sizeof(TElement));
+
+                std::fill(newRow + newEndX, newRow + newSize.width, fillerValue);
             }
         }
 
@@ -239,18 +247,7 @@ public:
 
     void Flip(DirectionType direction)
     {
-        if (direction == DirectionType::Horizontal)
-        {
-            Flip<true, false>();
-        }
-        else if (direction == DirectionType::Vertical)
-        {
-            Flip<false, true>();
-        }
-        else if (direction == (DirectionType::Vertical | DirectionType::Horizontal))
-        {
-            Flip<true, true>();
-        }
+        MakeView().Flip(direction);
     }
 
     void Rotate90(RotationDirectionType direction)
@@ -289,29 +286,6 @@ public:
 
 private:
 
-    template<bool H, bool V>
-    void Flip()
-    {
-        int const xMax = (H && !V) ? Size.width / 2 : Size.width;
-        int const yMax = V ? Size.height / 2 : Size.height;
-
-        for (int y = 0; y < yMax; ++y)
-        {
-            for (int x = 0; x < xMax; ++x)
-            {
-                auto const srcCoords = coordinates_type(x, y);
-
-                auto dstCoords = srcCoords;
-                if constexpr (H)
-                    dstCoords = dstCoords.FlipX(Size.width);
-                if constexpr (V)
-                    dstCoords = dstCoords.FlipY(Size.height);
-
-                std::swap(this->operator[](srcCoords), this->operator[](dstCoords));
-            }
-        }
-    }
-
     template<RotationDirectionType TDirection>
     void Rotate90()
     {
@@ -319,13 +293,26 @@ private:
 
         auto newData = std::make_unique<TElement[]>(mLinearSize);
 
-        for (int srcY = 0; srcY < Size.height; ++srcY)
+        // Work by square blocks, so that both reads and writes stay within few cache lines
+        int constexpr BlockSize = 32;
+
+        for (int blockY = 0; blockY < Size.height; blockY += BlockSize)
         {
-            int const srcYOffset = srcY * Size.width;
-            for (int srcX = 0; srcX < Size.width; ++srcX)
+            int const blockEndY = std::min(blockY + BlockSize, Size.height);
+
+            for (int blockX = 0; blockX < Size.width; blockX += BlockSize)
             {
-                auto const dstCoords = coordinates_type(srcX, srcY).template Rotate90<TDirection>(Size);
-                newData[dstCoords.y * newSize.width + dstCoords.x] = Data[srcYOffset + srcX];
+                int const blockEndX = std::min(blockX + BlockSize, Size.width);
+
+                for (int srcY = blockY; srcY < blockEndY; ++srcY)
+                {
+                    int const srcYOffset = srcY * Size.width;
+                    for (int srcX = blockX; srcX < blockEndX; ++srcX)
+                    {
+                        auto const dstCoords = coordinates_type(srcX, srcY).template Rotate90<TDirection>(Size);
+                        newData[dstCoords.y * newSize.width + dstCoords.x] = Data[srcYOffset + srcX];
+                    }
+                }
             }
         }
 
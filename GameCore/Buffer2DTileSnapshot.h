@@ -0,0 +1,246 @@
+/***************************************************************************************
+* Original Author:      Gabriele Giuseppini
+* Created:              2026-10-14
+* Copyright:            Gabriele Giuseppini  (https://github.com/GabrieleGiuseppini)
+***************************************************************************************/
+#pragma once
+
+#include "Buffer2D.h"
+#include "GameTypes.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+#include <memory>
+#include <optional>
+#include <utility>
+#include <vector>
+
+/*
+ * A snapshot of a Buffer2D, kept as fixed-size, immutable, reference-counted tiles.
+ *
+ * The snapshot follows its buffer by way of dirty tiles: edits to the buffer mark the
+ * tiles they touch as dirty, and updating the snapshot re-takes only those tiles, handing
+ * out the tiles they replace. These are nothing but the content of the buffer before the
+ * edits, but only where the edits took place; copying them around costs nothing, as tiles
+ * are shared among whoever holds them.
+ */
+template <typename TElement, typename TIntegralTag>
+class Buffer2DTileSnapshot
+{
+public:
+
+    using buffer_type = Buffer2D<TElement, TIntegralTag>;
+    using coordinates_type = _IntegralCoordinates<TIntegralTag>;
+    using size_type = _IntegralSize<TIntegralTag>;
+    using rect_type = _IntegralRect<TIntegralTag>;
+
+    static int constexpr TileSize = 64;
+
+    struct Tile
+    {
+        rect_type Rect; // In buffer coordinates; clipped at the buffer edges
+        std::unique_ptr<TElement[]> Data;
+
+        size_t GetByteSize() const
+        {
+            return static_cast<size_t>(Rect.size.width) * static_cast<size_t>(Rect.size.height) * sizeof(TElement);
+        }
+    };
+
+    /*
+     * A set of tiles, which may be blitted back onto a buffer of the snapshot's size.
+     */
+    struct TileSet
+    {
+        std::vector<std::shared_ptr<Tile const>> Tiles;
+
+        bool IsEmpty() const
+        {
+            return Tiles.empty();
+        }
+
+        size_t GetByteSize() const
+        {
+            size_t byteSize = 0;
+            for (auto const & tile : Tiles)
+            {
+                byteSize += tile->GetByteSize();
+            }
+
+            return byteSize;
+        }
+
+        // The rect enclosing all tiles, if any
+        std::optional<rect_type> GetRect() const
+        {
+            std::optional<rect_type> rect;
+            for (auto const & tile : Tiles)
+            {
+                if (!rect)
+                    rect = tile->Rect;
+                else
+                    rect->UnionWith(tile->Rect);
+            }
+
+            return rect;
+        }
+
+        void BlitOnto(buffer_type & target) const
+        {
+            for (auto const & tile : Tiles)
+            {
+                assert(tile->Rect.IsContainedInRect(rect_type(target.Size)));
+
+                for (int y = 0; y < tile->Rect.size.height; ++y)
+                {
+                    std::memcpy(
+                        target.Data.get() + (tile->Rect.origin.y + y) * target.Size.width + tile->Rect.origin.x,
+                        tile->Data.get() + y * tile->Rect.size.width,
+                        tile->Rect.size.width * sizeof(TElement));
+                }
+            }
+        }
+    };
+
+public:
+
+    explicit Buffer2DTileSnapshot(buffer_type const & buffer)
+        : mSize(buffer.Size)
+        , mTileCountX((buffer.Size.width + TileSize - 1) / TileSize)
+        , mTileCountY((buffer.Size.height + TileSize - 1) / TileSize)
+        , mTiles()
+        , mDirtyTiles()
+    {
+        mTiles.reserve(static_cast<size_t>(mTileCountX) * static_cast<size_t>(mTileCountY));
+        for (int ty = 0; ty < mTileCountY; ++ty)
+        {
+            for (int tx = 0; tx < mTileCountX; ++tx)
+            {
+                mTiles.emplace_back(MakeTile(buffer, tx, ty));
+            }
+        }
+
+        mDirtyTiles.resize(mTiles.size(), false);
+    }
+
+    size_type const & GetSize() const
+    {
+        return mSize;
+    }
+
+    /*
+     * Marks the tiles touched by the specified region as to be re-taken at the next update.
+     */
+    void MarkDirty(rect_type const & region)
+    {
+        auto const clippedRegion = region.MakeIntersectionWith(rect_type(mSize));
+        if (!clippedRegion)
+            return;
+
+        for (int ty = clippedRegion->origin.y / TileSize; ty <= (clippedRegion->origin.y + clippedRegion->size.height - 1) / TileSize; ++ty)
+        {
+            for (int tx = clippedRegion->origin.x / TileSize; tx <= (clippedRegion->origin.x + clippedRegion->size.width - 1) / TileSize; ++tx)
+            {
+                mDirtyTiles[ty * mTileCountX + tx] = true;
+            }
+        }
+    }
+
+    /*
+     * Re-takes the dirty tiles from the buffer, which must have the snapshot's size,
+     * and returns the tiles that were replaced.
+     */
+    TileSet Update(buffer_type const & buffer)
+    {
+        assert(buffer.Size == mSize);
+
+        TileSet replacedTiles;
+
+        for (int ty = 0; ty < mTileCountY; ++ty)
+        {
+            for (int tx = 0; tx < mTileCountX; ++tx)
+            {
+                size_t const t = ty * mTileCountX + tx;
+                if (mDirtyTiles[t])
+                {
+                    replacedTiles.Tiles.emplace_back(std::move(mTiles[t]));
+                    mTiles[t] = MakeTile(buffer, tx, ty);
+                    mDirtyTiles[t] = false;
+                }
+            }
+        }
+
+        return replacedTiles;
+    }
+
+    /*
+     * Blits a region of the snapshot onto the same region of a buffer of the snapshot's size.
+     */
+    void BlitRegionOnto(
+        rect_type const & region,
+        buffer_type & target) const
+    {
+        assert(target.Size == mSize);
+        assert(region.IsContainedInRect(rect_type(mSize)));
+
+        if (region.IsEmpty())
+            return;
+
+        for (int ty = region.origin.y / TileSize; ty <= (region.origin.y + region.size.height - 1) / TileSize; ++ty)
+        {
+            for (int tx = region.origin.x / TileSize; tx <= (region.origin.x + region.size.width - 1) / TileSize; ++tx)
+            {
+                Tile const & tile = *mTiles[ty * mTileCountX + tx];
+
+                auto const tileRegion = tile.Rect.MakeIntersectionWith(region);
+                assert(tileRegion.has_value());
+
+                for (int y = tileRegion->origin.y; y < tileRegion->origin.y + tileRegion->size.height; ++y)
+                {
+                    std::memcpy(
+                        target.Data.get() + y * target.Size.width + tileRegion->origin.x,
+                        tile.Data.get() + (y - tile.Rect.origin.y) * tile.Rect.size.width + (tileRegion->origin.x - tile.Rect.origin.x),
+                        tileRegion->size.width * sizeof(TElement));
+                }
+            }
+        }
+    }
+
+private:
+
+    std::shared_ptr<Tile const> MakeTile(
+        buffer_type const & buffer,
+        int tx,
+        int ty) const
+    {
+        auto tile = std::make_shared<Tile>();
+
+        tile->Rect = rect_type(
+            coordinates_type(tx * TileSize, ty * TileSize),
+            size_type(
+                std::min(TileSize, mSize.width - tx * TileSize),
+                std::min(TileSize, mSize.height - ty * TileSize)));
+
+        tile->Data = std::make_unique<TElement[]>(static_cast<size_t>(tile->Rect.size.width) * static_cast<size_t>(tile->Rect.size.height));
+
+        for (int y = 0; y < tile->Rect.size.height; ++y)
+        {
+            std::memcpy(
+                tile->Data.get() + y * tile->Rect.size.width,
+                buffer.Data.get() + (tile->Rect.origin.y + y) * buffer.Size.width + tile->Rect.origin.x,
+                tile->Rect.size.width * sizeof(TElement));
+        }
+
+        return tile;
+    }
+
+private:
+
+    size_type mSize;
+    int mTileCountX;
+    int mTileCountY;
+
+    std::vector<std::shared_ptr<Tile const>> mTiles;
+    std::vector<bool> mDirtyTiles;
+};
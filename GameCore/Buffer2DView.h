@@ -0,0 +1,193 @@
+/***************************************************************************************
+* Original Author:		Gabriele Giuseppini
+* Created:				2026-10-14
+* Copyright:			Gabriele Giuseppini  (https://github.com/GabrieleGiuseppini)
+***************************************************************************************/
+#pragma once
+
+#include "GameTypes.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+#include <type_traits>
+
+/*
+ * A non-owning view of a rectangular region of a row-major buffer - typically a
+ * Buffer2D - whose rows lie Stride elements apart. Read-only views have a const
+ * element type.
+ *
+ * Views allow for working on regions of buffers - e.g. for ephemeral visualizations,
+ * analyses, and blits - without first copying them into buffers of their own.
+ * Blits, fills and flips work by rows, each being a contiguous span that memcpy and
+ * the standard algorithms vectorize; views covering whole rows are treated as a single
+ * span.
+ */
+template <typename TElement, typename TIntegralTag>
+struct Buffer2DView
+{
+public:
+
+    using element_type = TElement;
+    using coordinates_type = _IntegralCoordinates<TIntegralTag>;
+    using size_type = _IntegralSize<TIntegralTag>;
+    using rect_type = _IntegralRect<TIntegralTag>;
+
+public:
+
+    TElement * Data;
+    size_type Size;
+    int Stride; // In elements
+
+    Buffer2DView(
+        TElement * data,
+        size_type const & size,
+        int stride)
+        : Data(data)
+        , Size(size)
+        , Stride(stride)
+    {
+        assert(stride >= size.width);
+    }
+
+    // Mutable view -> read-only view
+    template<typename TOtherElement, typename = std::enable_if_t<std::is_same_v<TElement, TOtherElement const>>>
+    Buffer2DView(Buffer2DView<TOtherElement, TIntegralTag> const & other)
+        : Data(other.Data)
+        , Size(other.Size)
+        , Stride(other.Stride)
+    {}
+
+    inline TElement & operator[](coordinates_type const & index) const
+    {
+        assert(index.IsInSize(Size));
+
+        return Data[index.y * Stride + index.x];
+    }
+
+    inline TElement * GetRow(int y) const
+    {
+        assert(y >= 0 && y < Size.height);
+
+        return Data + y * Stride;
+    }
+
+    /*
+     * Whether all elements of the view are one contiguous span.
+     */
+    inline bool IsContiguous() const
+    {
+        return Stride == Size.width || Size.height <= 1;
+    }
+
+    /*
+     * A view of a region of this view.
+     */
+    Buffer2DView GetRegion(rect_type const & region) const
+    {
+        assert(region.IsContainedInRect(rect_type(Size)));
+
+        return Buffer2DView(
+            Data + region.origin.y * Stride + region.origin.x,
+            region.size,
+            Stride);
+    }
+
+    /*
+     * Copies the elements of the specified - equally-sized, and not overlapping - view
+     * onto this view.
+     */
+    template<typename TSourceElement>
+    void BlitFrom(Buffer2DView<TSourceElement, TIntegralTag> const & source) const
+    {
+        static_assert(std::is_same_v<std::remove_const_t<TSourceElement>, std::remove_const_t<TElement>>);
+        static_assert(!std::is_const_v<TElement>);
+
+        assert(source.Size == Size);
+
+        if (IsContiguous() && source.IsContiguous())
+        {
+            CopySpan(source.Data, Data, static_cast<size_t>(Size.width) * static_cast<size_t>(Size.height));
+        }
+        else
+        {
+            for (int y = 0; y < Size.height; ++y)
+            {
+                CopySpan(source.GetRow(y), GetRow(y), static_cast<size_t>(Size.width));
+            }
+        }
+    }
+
+    void Fill(std::remove_const_t<TElement> const & value) const
+    {
+        static_assert(!std::is_const_v<TElement>);
+
+        if (IsContiguous())
+        {
+            std::fill_n(Data, static_cast<size_t>(Size.width) * static_cast<size_t>(Size.height), value);
+        }
+        else
+        {
+            for (int y = 0; y < Size.height; ++y)
+            {
+                std::fill_n(GetRow(y), Size.width, value);
+            }
+        }
+    }
+
+    void Flip(DirectionType direction) const
+    {
+        static_assert(!std::is_const_v<TElement>);
+
+        bool const isHorizontal = (direction & DirectionType::Horizontal) == DirectionType::Horizontal;
+        bool const isVertical = (direction & DirectionType::Vertical) == DirectionType::Vertical;
+
+        if (isHorizontal && isVertical && IsContiguous())
+        {
+            // Both flips amount to reversing the whole span
+            std::reverse(Data, Data + static_cast<size_t>(Size.width) * static_cast<size_t>(Size.height));
+            return;
+        }
+
+        // A vertical flip swaps rows, while a horizontal flip reverses them
+
+        if (isVertical)
+        {
+            for (int y = 0; y < Size.height / 2; ++y)
+            {
+                std::swap_ranges(
+                    GetRow(y),
+                    GetRow(y) + Size.width,
+                    GetRow(Size.height - 1 - y));
+            }
+        }
+
+        if (isHorizontal)
+        {
+            for (int y = 0; y < Size.height; ++y)
+            {
+                std::reverse(
+                    GetRow(y),
+                    GetRow(y) + Size.width);
+            }
+        }
+    }
+
+private:
+
+    template<typename TSourceElement>
+    static inline void CopySpan(
+        TSourceElement * source,
+        TElement * target,
+        size_t count)
+    {
+        if constexpr (std::is_trivially_copyable_v<std::remove_const_t<TElement>>)
+        {
+            std::memcpy(target, source, count * sizeof(TElement));
+        }
+        else
+        {
+            std::copy_n(source, count, target);
+        }
+    }
+};
@@ -7,6 +7,8 @@
 
 #include "Buffer.h"
 
+#include <algorithm>
+#include <atomic>
 #include <cassert>
 #include <memory>
 #include <mutex>
@@ -31,41 +33,57 @@ public:
     {
     }
 
+    /*
+     * Returns a buffer that is not in use by anyone else; buffers are recycled once
+     * all of their references are gone.
+     *
+     * After the pool has warmed up, no heap allocations take place.
+     */
     std::shared_ptr<Buffer<TElement>> Allocate()
     {
-        Buffer<TElement> * buffer;
+        std::lock_guard lock{ mLock };
 
-        if (std::lock_guard lock{ mLock }; !mPool.empty())
-        {
-            buffer = mPool.back().release();
-            mPool.pop_back();
-        }
-        else
+        for (auto const & buffer : mPool)
         {
-            buffer = new Buffer<TElement>(mBufferSize);
-        }
+            // A buffer is free when the pool is its only owner; references are only
+            // handed out under the lock, hence the count can't concurrently grow from one
+            if (buffer.use_count() == 1)
+            {
+                // Make sure we see all the accesses made by the last owner before releasing it
+                std::atomic_thread_fence(std::memory_order_acquire);
 
-        assert(nullptr != buffer);
+                return buffer;
+            }
+        }
 
-        return std::shared_ptr<Buffer<TElement>>(
-            buffer,
-            [this](auto p)
-            {
-                this->Release(p);
-            });
+        return mPool.emplace_back(std::make_shared<Buffer<TElement>>(mBufferSize));
     }
 
-private:
-
-    void Release(Buffer<TElement> * buffer)
+    /*
+     * Allocates a buffer holding a snapshot of the specified range of the source,
+     * at the same indices; the rest of the buffer is undefined.
+     */
+    std::shared_ptr<Buffer<TElement>> AllocateSnapshot(
+        TElement const * source,
+        size_t start,
+        size_t count)
     {
-        std::lock_guard lock{ mLock };
+        assert(start + count <= mBufferSize);
+
+        auto buffer = Allocate();
 
-        mPool.push_back(std::unique_ptr<Buffer<TElement>>(buffer));
+        std::copy(
+            source + start,
+            source + start + count,
+            buffer->data() + start);
+
+        return buffer;
     }
 
+private:
+
     size_t const mBufferSize;
-    std::vector<std::unique_ptr<Buffer<TElement>>> mPool;
+    std::vector<std::shared_ptr<Buffer<TElement>>> mPool;
 
     // The mutex guarding concurrency-sensitive operations
     std::mutex mLock;
@@ -0,0 +1,121 @@
+/***************************************************************************************
+* Original Author:      Gabriele Giuseppini
+* Created:              2026-10-14
+* Copyright:            Gabriele Giuseppini  (https://github.com/GabrieleGiuseppini)
+***************************************************************************************/
+#include "ColorKdTree.h"
+
+#include <algorithm>
+#include <cassert>
+#include <limits>
+#include <numeric>
+
+namespace /* anonymous */ {
+
+    inline float Component(
+        vec3f const & v,
+        std::uint32_t axis)
+    {
+        return axis == 0 ? v.x : (axis == 1 ? v.y : v.z);
+    }
+}
+
+ColorKdTree::ColorKdTree(std::vector<vec3f> const & palette)
+    : mNodes()
+    , mRoot(NoNode)
+{
+    assert(palette.size() < static_cast<size_t>(std::numeric_limits<std::int32_t>::max()));
+
+    mNodes.reserve(palette.size());
+
+    std::vector<std::uint32_t> paletteIndices(palette.size());
+    std::iota(paletteIndices.begin(), paletteIndices.end(), 0);
+
+    mRoot = Build(paletteIndices.begin(), paletteIndices.end(), palette, 0);
+}
+
+size_t ColorKdTree::FindNearest(vec3f const & color) const
+{
+    assert(mRoot != NoNode);
+
+    size_t bestPaletteIndex = std::numeric_limits<size_t>::max();
+    float bestSquareDistance = std::numeric_limits<float>::max();
+
+    FindNearest(mRoot, color, bestPaletteIndex, bestSquareDistance);
+
+    return bestPaletteIndex;
+}
+
+std::int32_t ColorKdTree::Build(
+    std::vector<std::uint32_t>::iterator first,
+    std::vector<std::uint32_t>::iterator last,
+    std::vector<vec3f> const & palette,
+    size_t depth)
+{
+    if (first == last)
+        return NoNode;
+
+    std::uint32_t const axis = static_cast<std::uint32_t>(depth % 3);
+
+    // Split at the median along this depth's axis
+    auto const median = first + (last - first) / 2;
+    std::nth_element(
+        first,
+        median,
+        last,
+        [&palette, axis](std::uint32_t a, std::uint32_t b)
+        {
+            return Component(palette[a], axis) < Component(palette[b], axis);
+        });
+
+    std::int32_t const nodeIndex = static_cast<std::int32_t>(mNodes.size());
+    mNodes.push_back(
+        Node{
+            palette[*median],
+            *median,
+            axis,
+            NoNode,
+            NoNode });
+
+    std::int32_t const left = Build(first, median, palette, depth + 1);
+    std::int32_t const right = Build(median + 1, last, palette, depth + 1);
+
+    mNodes[nodeIndex].Left = left;
+    mNodes[nodeIndex].Right = right;
+
+    return nodeIndex;
+}
+
+void ColorKdTree::FindNearest(
+    std::int32_t nodeIndex,
+    vec3f const & color,
+    size_t & bestPaletteIndex,
+    float & bestSquareDistance) const
+{
+    if (nodeIndex == NoNode)
+        return;
+
+    Node const & node = mNodes[nodeIndex];
+
+    float const squareDistance = (color - node.Color).squareLength();
+    if (squareDistance < bestSquareDistance
+        || (squareDistance == bestSquareDistance && node.PaletteIndex < bestPaletteIndex))
+    {
+        bestPaletteIndex = node.PaletteIndex;
+        bestSquareDistance = squareDistance;
+    }
+
+    float const axisDistance = Component(color, node.Axis) - Component(node.Color, node.Axis);
+
+    // Visit the side of the split containing the color first, and then the other side
+    // only if it might contain a color that is as near - including one that ties
+    std::int32_t const nearSide = (axisDistance < 0.0f) ? node.Left : node.Right;
+    std::int32_t const farSide = (axisDistance < 0.0f) ? node.Right : node.Left;
+
+    FindNearest(nearSide, color, bestPaletteIndex, bestSquareDistance);
+
+    if (axisDistance * axisDistance <= bestSquareDistance)
+    {
+        FindNearest(farSide, color, bestPaletteIndex, bestSquareDistance);
+    }
+}
@@ -0,0 +1,66 @@
+/***************************************************************************************
+* Original Author:      Gabriele Giuseppini
+* Created:              2026-10-14
+* Copyright:            Gabriele Giuseppini  (https://github.com/GabrieleGiuseppini)
+***************************************************************************************/
+#pragma once
+
+#include "Vectors.h"
+
+#include <cstdint>
+#include <vector>
+
+/*
+ * A k-d tree over a palette of colors, for finding the palette color that is nearest
+ * to any given color in logarithmic - rather than linear - time.
+ *
+ * Results are the same as those of a linear scan of the palette: the nearest color
+ * is the one with the smallest square distance, and ties go to the color that comes
+ * first in the palette.
+ */
+class ColorKdTree final
+{
+public:
+
+    explicit ColorKdTree(std::vector<vec3f> const & palette);
+
+    size_t GetPaletteSize() const
+    {
+        return mNodes.size();
+    }
+
+    /*
+     * Returns the index in the palette of the color nearest to the specified one.
+     */
+    size_t FindNearest(vec3f const & color) const;
+
+private:
+
+    static std::int32_t constexpr NoNode = -1;
+
+    struct Node
+    {
+        vec3f Color;
+        std::uint32_t PaletteIndex;
+        std::uint32_t Axis;
+        std::int32_t Left;
+        std::int32_t Right;
+    };
+
+    std::int32_t Build(
+        std::vector<std::uint32_t>::iterator first,
+        std::vector<std::uint32_t>::iterator last,
+        std::vector<vec3f> const & palette,
+        size_t depth);
+
+    void FindNearest(
+        std::int32_t nodeIndex,
+        vec3f const & color,
+        size_t & bestPaletteIndex,
+        float & bestSquareDistance) const;
+
+private:
+
+    std::vector<Node> mNodes;
+    std::int32_t mRoot;
+};
@@ -0,0 +1,253 @@
+/***************************************************************************************
+* Original Author:		Gabriele Giuseppini
+* Created:				2026-10-14
+* Copyright:			Gabriele Giuseppini  (https://github.com/GabrieleGiuseppini)
+***************************************************************************************/
+#include "CommandRingThread.h"
+
+#include "Log.h"
+#include "Profiler.h"
+#include "SystemThreadManager.h"
+
+#include <algorithm>
+
+CommandRingThread::CommandRingThread()
+    : CommandRingThread(false)
+{}
+
+CommandRingThread::CommandRingThread(bool doForceNoMultiThreading)
+    : CommandRingThread(doForceNoMultiThreading, SystemThreadManager::ThreadRole::Other)
+{}
+
+CommandRingThread::CommandRingThread(
+    bool doForceNoMultiThreading,
+    SystemThreadManager::ThreadRole role)
+    : mRole(role)
+    , mSlots()
+    , mHead(0)
+    , mTail(0)
+    , mIsThreadSleeping(false)
+    , mIsMainThreadSleeping(false)
+    , mIsStop(false)
+    , mExceptions()
+    , mHasExceptions(false)
+{
+    // Only use a real thread on multi-core boxes; on single-core
+    // boxes, we'll just emulate multi-threading by running all
+    // tasks directly - and synchronously - on the caller's thread
+    mHasThread = SystemThreadManager::GetInstance().GetNumberOfProcessors() > 1;
+
+    if (doForceNoMultiThreading)
+        mHasThread = false;
+
+    if (mHasThread)
+    {
+        LogMessage("CommandRingThread::CommandRingThread(): starting thread...");
+
+        // Start thread
+        mThread = std::thread(&CommandRingThread::ThreadLoop, this);
+    }
+    else
+    {
+        LogMessage("CommandRingThread::CommandRingThread(): not starting thread - will be simulating multi-threading");
+    }
+}
+
+CommandRingThread::~CommandRingThread()
+{
+    if (mHasThread)
+    {
+        assert(mThread.joinable());
+
+        // Notify stop
+        {
+            std::unique_lock const lock{ mThreadLock };
+
+            mIsStop.store(true, std::memory_order_seq_cst);
+            mThreadSignal.notify_one();
+        }
+
+        LogMessage("CommandRingThread::~CommandRingThread(): signaled stop; waiting for thread now...");
+
+        // Wait for thread
+        mThread.join();
+
+        LogMessage("CommandRingThread::~CommandRingThread(): ...thread stopped.");
+
+        // Release the tasks that have not been run
+        for (Ticket t = mTail.load(); t < mHead.load(); ++t)
+        {
+            mSlots[t & (Capacity - 1)].Reset();
+        }
+    }
+}
+
+void CommandRingThread::Wait(Ticket ticket)
+{
+    assert(ticket <= mHead.load(std::memory_order_relaxed));
+
+    WaitForTail(ticket);
+
+    // Check if an exception was thrown
+    if (mHasExceptions.load(std::memory_order_acquire))
+    {
+        std::string exceptionMessage;
+
+        {
+            std::lock_guard const lock{ mExceptionsLock };
+
+            auto const it = std::find_if(
+                mExceptions.cbegin(),
+                mExceptions.cend(),
+                [ticket](auto const & e)
+                {
+                    return e.first == ticket;
+                });
+
+            if (it != mExceptions.cend())
+            {
+                exceptionMessage = it->second;
+            }
+
+            // Forget this exception and those of earlier tasks
+            mExceptions.erase(
+                std::remove_if(
+                    mExceptions.begin(),
+                    mExceptions.end(),
+                    [ticket](auto const & e)
+                    {
+                        return e.first <= ticket;
+                    }),
+                mExceptions.end());
+
+            mHasExceptions.store(!mExceptions.empty(), std::memory_order_release);
+        }
+
+        if (!exceptionMessage.empty())
+        {
+            throw std::runtime_error(exceptionMessage);
+        }
+    }
+}
+
+void CommandRingThread::WaitForTail(Ticket ticket)
+{
+    if (mTail.load(std::memory_order_acquire) >= ticket)
+        return;
+
+    for (int i = 0; i < SpinCountBeforeSleeping; ++i)
+    {
+        std::this_thread::yield();
+
+        if (mTail.load(std::memory_order_acquire) >= ticket)
+            return;
+    }
+
+    std::unique_lock lock{ mThreadLock };
+
+    mIsMainThreadSleeping.store(true, std::memory_order_seq_cst);
+
+    mThreadSignal.wait(
+        lock,
+        [this, ticket]
+        {
+            return mTail.load(std::memory_order_seq_cst) >= ticket;
+        });
+
+    mIsMainThreadSleeping.store(false, std::memory_order_relaxed);
+}
+
+void CommandRingThread::RegisterException(
+    Ticket ticket,
+    std::string const & exceptionMessage)
+{
+    std::lock_guard const lock{ mExceptionsLock };
+
+    mExceptions.emplace_back(ticket, exceptionMessage);
+    mHasExceptions.store(true, std::memory_order_release);
+}
+
+void CommandRingThread::ThreadLoop()
+{
+    assert(mHasThread); // This method only runs if we're truly multi-threaded
+
+    //
+    // Initialize thread
+    //
+
+    SystemThreadManager::GetInstance().InitializeThisThread(mRole);
+
+    Profiler::GetInstance().SetCurrentThreadName("Command Ring Thread");
+
+    //
+    // Run loop
+    //
+
+    while (true)
+    {
+        Ticket const tail = mTail.load(std::memory_order_relaxed); // Only written by us
+
+        //
+        // Wait for a task
+        //
+
+        for (int i = 0; i < SpinCountBeforeSleeping && mHead.load(std::memory_order_acquire) == tail && !mIsStop.load(std::memory_order_relaxed); ++i)
+        {
+            std::this_thread::yield();
+        }
+
+        if (mHead.load(std::memory_order_acquire) == tail)
+        {
+            std::unique_lock lock{ mThreadLock };
+
+            mIsThreadSleeping.store(true, std::memory_order_seq_cst);
+
+            mThreadSignal.wait(
+                lock,
+                [this, tail]
+                {
+                    return mIsStop.load(std::memory_order_seq_cst) || mHead.load(std::memory_order_seq_cst) != tail;
+                });
+
+            mIsThreadSleeping.store(false, std::memory_order_relaxed);
+        }
+
+        if (mIsStop.load(std::memory_order_acquire))
+        {
+            // We're done!
+            break;
+        }
+
+        //
+        // Run task
+        //
+
+        Slot & slot = mSlots[tail & (Capacity - 1)];
+
+        try
+        {
+            slot.Run();
+        }
+        catch (std::runtime_error const & exc)
+        {
+            RegisterException(tail + 1, exc.what());
+        }
+
+        // Release the task's captures before its slot may be reused
+        slot.Reset();
+
+        //
+        // Signal task completion
+        //
+
+        mTail.store(tail + 1, std::memory_order_seq_cst);
+
+        if (mIsMainThreadSleeping.load(std::memory_order_seq_cst))
+        {
+            std::lock_guard const lock{ mThreadLock };
+            mThreadSignal.notify_one();
+        }
+    }
+
+    LogMessage("CommandRingThread::ThreadLoop(): exiting");
+}
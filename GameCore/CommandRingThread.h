@@ -0,0 +1,277 @@
+/***************************************************************************************
+* Original Author:		Gabriele Giuseppini
+* Created:				2026-10-14
+* Copyright:			Gabriele Giuseppini  (https://github.com/GabrieleGiuseppini)
+***************************************************************************************/
+#pragma once
+
+#include "SystemThreadManager.h"
+
+#include <array>
+#include <atomic>
+#include <cassert>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+/*
+ * A thread that serially runs tasks provided by the main thread, like TaskThread,
+ * but which receives its tasks via a fixed-capacity, lock-free, single-producer/
+ * single-consumer ring.
+ *
+ * Tasks are stored inline in the slots of the ring - falling back on the heap only
+ * for tasks too big to fit - and their completion is tracked by sequence number,
+ * hence in the steady state queueing a task and checking on its completion requires
+ * neither allocations nor locks; the lock is only taken to put to sleep - and to wake
+ * up - a thread waiting for the other one.
+ *
+ * As with TaskThread, the implementation assumes that there is only one thread
+ * "using" this class (the main thread), and that thread is responsible for the
+ * lifetime of this class (cctor and dctor).
+ */
+class CommandRingThread
+{
+public:
+
+    // The sequence number of a queued task: the n-th task queued gets ticket n
+    using Ticket = std::uint64_t;
+
+    static std::size_t constexpr Capacity = 256; // Power of two
+    static std::size_t constexpr InlineTaskSize = 96; // Bytes
+
+public:
+
+    CommandRingThread();
+    explicit CommandRingThread(bool doForceNoMultiThreading);
+
+    CommandRingThread(
+        bool doForceNoMultiThreading,
+        SystemThreadManager::ThreadRole role);
+
+    ~CommandRingThread();
+
+    CommandRingThread(CommandRingThread const & other) = delete;
+    CommandRingThread(CommandRingThread && other) = delete;
+    CommandRingThread & operator=(CommandRingThread const & other) = delete;
+    CommandRingThread & operator=(CommandRingThread && other) = delete;
+
+    /*
+     * Whether tasks run on a real thread, rather than synchronously on the caller's thread.
+     */
+    inline bool HasThread() const noexcept
+    {
+        return mHasThread;
+    }
+
+    /*
+     * Invoked on the main thread to queue a task that will run
+     * on the task thread; waits for room when the ring is full.
+     */
+    template<typename TTask>
+    Ticket QueueTask(TTask && task)
+    {
+        Ticket const head = mHead.load(std::memory_order_relaxed); // Only written by us
+        Ticket const ticket = head + 1;
+
+        if (mHasThread)
+        {
+            //
+            // Queue task
+            //
+
+            if (head - mTail.load(std::memory_order_acquire) >= Capacity)
+            {
+                // Wait for the slot we need to be freed
+                WaitForTail(ticket - Capacity);
+            }
+
+            mSlots[head & (Capacity - 1)].Emplace(std::forward<TTask>(task));
+
+            mHead.store(ticket, std::memory_order_seq_cst);
+
+            if (mIsThreadSleeping.load(std::memory_order_seq_cst))
+            {
+                std::lock_guard const lock{ mThreadLock };
+                mThreadSignal.notify_one();
+            }
+        }
+        else
+        {
+            //
+            // Run task
+            //
+
+            try
+            {
+                task();
+            }
+            catch (std::runtime_error const & exc)
+            {
+                RegisterException(ticket, exc.what());
+            }
+
+            mHead.store(ticket, std::memory_order_relaxed);
+            mTail.store(ticket, std::memory_order_relaxed);
+        }
+
+        return ticket;
+    }
+
+    /*
+     * Invoked on the main thread to check, without waiting, whether the task with
+     * the specified ticket - and thus all tasks queued before it - is completed.
+     */
+    inline bool IsCompleted(Ticket ticket) const noexcept
+    {
+        return mTail.load(std::memory_order_acquire) >= ticket;
+    }
+
+    /*
+     * Invoked on the main thread to wait until the task with the specified ticket
+     * is completed.
+     *
+     * Throws an exception if the task threw an exception; the exceptions of the tasks
+     * queued earlier - and not waited for - are forgotten.
+     */
+    void Wait(Ticket ticket);
+
+    /*
+     * Invoked on the main thread to run a task on the task thread
+     * and wait until it returns.
+     */
+    template<typename TTask>
+    void RunSynchronously(TTask && task)
+    {
+        Wait(QueueTask(std::forward<TTask>(task)));
+    }
+
+    /*
+     * Invoked on the main thread to place a synchronization point in the queue,
+     * which may then be waited for to indicate that the queue has reached that point.
+     */
+    Ticket QueueSynchronizationPoint()
+    {
+        return QueueTask([]() {});
+    }
+
+private:
+
+    void ThreadLoop();
+
+    // Waits until the task thread has completed the task with the specified ticket
+    void WaitForTail(Ticket ticket);
+
+    void RegisterException(
+        Ticket ticket,
+        std::string const & exceptionMessage);
+
+private:
+
+    /*
+     * A type-erased task, stored in-place.
+     */
+    class Slot
+    {
+    public:
+
+        Slot()
+            : mStorage()
+            , mRun(nullptr)
+            , mDestroy(nullptr)
+        {}
+
+        ~Slot()
+        {
+            Reset();
+        }
+
+        Slot(Slot const & other) = delete;
+        Slot & operator=(Slot const & other) = delete;
+
+        template<typename TTask>
+        void Emplace(TTask && task)
+        {
+            using StoredTask = std::decay_t<TTask>;
+
+            assert(mRun == nullptr);
+
+            if constexpr (sizeof(StoredTask) <= InlineTaskSize && alignof(StoredTask) <= alignof(std::max_align_t))
+            {
+                new (mStorage) StoredTask(std::forward<TTask>(task));
+                mRun = [](void * storage) { (*static_cast<StoredTask *>(storage))(); };
+                mDestroy = [](void * storage) { static_cast<StoredTask *>(storage)->~StoredTask(); };
+            }
+            else
+            {
+                // Too big, box it
+                using BoxedTask = std::unique_ptr<StoredTask>;
+                new (mStorage) BoxedTask(std::make_unique<StoredTask>(std::forward<TTask>(task)));
+                mRun = [](void * storage) { (**static_cast<BoxedTask *>(storage))(); };
+                mDestroy = [](void * storage) { static_cast<BoxedTask *>(storage)->~BoxedTask(); };
+            }
+        }
+
+        inline void Run()
+        {
+            assert(mRun != nullptr);
+            mRun(mStorage);
+        }
+
+        inline void Reset()
+        {
+            if (mDestroy != nullptr)
+            {
+                mDestroy(mStorage);
+                mRun = nullptr;
+                mDestroy = nullptr;
+            }
+        }
+
+    private:
+
+        alignas(std::max_align_t) unsigned char mStorage[InlineTaskSize];
+        void (*mRun)(void *);
+        void (*mDestroy)(void *);
+    };
+
+    // How many times a waiting thread yields before going to sleep, as most tasks are short
+    static int constexpr SpinCountBeforeSleeping = 64;
+
+private:
+
+    SystemThreadManager::ThreadRole const mRole;
+
+    std::thread mThread;
+    bool mHasThread; // Invariant: mHasThread==true <=> mThread.joinable()
+
+    std::array<Slot, Capacity> mSlots;
+
+    // The ticket of the last task queued; only written by the main thread
+    alignas(64) std::atomic<Ticket> mHead;
+
+    // The ticket of the last task completed; only written by the task thread
+    alignas(64) std::atomic<Ticket> mTail;
+
+    // Sleeping - either thread may only sleep while the other one can't, as the
+    // task thread only sleeps when the ring is empty, and the main thread only when it's not
+    std::mutex mThreadLock;
+    std::condition_variable mThreadSignal;
+    std::atomic<bool> mIsThreadSleeping;
+    std::atomic<bool> mIsMainThreadSleeping;
+
+    std::atomic<bool> mIsStop;
+
+    // The exceptions thrown by tasks that have not been waited for yet
+    std::mutex mExceptionsLock;
+    std::vector<std::pair<Ticket, std::string>> mExceptions;
+    std::atomic<bool> mHasExceptions;
+};
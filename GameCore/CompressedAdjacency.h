@@ -0,0 +1,136 @@
+/***************************************************************************************
+* Original Author:      Gabriele Giuseppini
+* Created:              2026-10-14
+* Copyright:            Gabriele Giuseppini  (https://github.com/GabrieleGiuseppini)
+***************************************************************************************/
+#pragma once
+
+#include "GameTypes.h"
+
+#include <cassert>
+#include <vector>
+
+/*
+ * This class implements the adjacency of a graph in compressed-sparse-row form: for
+ * each vertex, a row of (edge, neighbor) pairs, with the rows of all vertices packed
+ * back-to-back in two arrays - one of edges and one of neighbors.
+ *
+ * The room of each row is fixed when the layout is built - from the maximum number of
+ * entries of the row - and the entries of a row may be changed in-place afterwards, as
+ * long as they fit; this way the adjacency of a graph whose edges come and go, but never
+ * exceed those it started with, may be patched rather than rebuilt.
+ */
+class CompressedAdjacency
+{
+public:
+
+    /*
+     * The entries of a row, valid until the row is changed.
+     */
+    struct Row
+    {
+        ElementIndex const * EdgeIndices;
+        ElementIndex const * NeighborIndices;
+        ElementCount Count;
+
+        inline ElementCount size() const noexcept
+        {
+            return Count;
+        }
+
+        inline bool empty() const noexcept
+        {
+            return Count == 0;
+        }
+    };
+
+public:
+
+    CompressedAdjacency()
+        : mOffsets(1, 0)
+        , mCounts()
+        , mEdgeIndices()
+        , mNeighborIndices()
+    {}
+
+    CompressedAdjacency(CompressedAdjacency && other) = default;
+    CompressedAdjacency & operator=(CompressedAdjacency && other) = default;
+
+    inline ElementCount GetVertexCount() const noexcept
+    {
+        return static_cast<ElementCount>(mCounts.size());
+    }
+
+    /*
+     * Lays out rows for the specified number of vertices, with the room of each
+     * row as reported by the specified functor; all rows are empty afterwards.
+     */
+    template<typename TRowCapacityGetter>
+    void BuildLayout(
+        ElementCount vertexCount,
+        TRowCapacityGetter && rowCapacityGetter)
+    {
+        mOffsets.resize(vertexCount + 1);
+        mCounts.assign(vertexCount, 0);
+
+        ElementIndex offset = 0;
+        for (ElementIndex v = 0; v < vertexCount; ++v)
+        {
+            mOffsets[v] = offset;
+            offset += static_cast<ElementIndex>(rowCapacityGetter(v));
+        }
+
+        mOffsets[vertexCount] = offset;
+
+        mEdgeIndices.assign(offset, NoneElementIndex);
+        mNeighborIndices.assign(offset, NoneElementIndex);
+    }
+
+    inline Row GetRow(ElementIndex vertex) const noexcept
+    {
+        assert(vertex < mCounts.size());
+
+        ElementIndex const offset = mOffsets[vertex];
+
+        return Row{
+            mEdgeIndices.data() + offset,
+            mNeighborIndices.data() + offset,
+            mCounts[vertex] };
+    }
+
+    inline ElementCount GetRowCapacity(ElementIndex vertex) const noexcept
+    {
+        assert(vertex < mCounts.size());
+
+        return mOffsets[vertex + 1] - mOffsets[vertex];
+    }
+
+    inline void ClearRow(ElementIndex vertex) noexcept
+    {
+        assert(vertex < mCounts.size());
+
+        mCounts[vertex] = 0;
+    }
+
+    inline void AppendToRow(
+        ElementIndex vertex,
+        ElementIndex edgeIndex,
+        ElementIndex neighborIndex) noexcept
+    {
+        assert(vertex < mCounts.size());
+        assert(mCounts[vertex] < GetRowCapacity(vertex));
+
+        ElementIndex const entry = mOffsets[vertex] + mCounts[vertex];
+        mEdgeIndices[entry] = edgeIndex;
+        mNeighborIndices[entry] = neighborIndex;
+
+        ++mCounts[vertex];
+    }
+
+private:
+
+    std::vector<ElementIndex> mOffsets; // One more than vertices, the last one being the total room
+    std::vector<ElementCount> mCounts;
+    std::vector<ElementIndex> mEdgeIndices;
+    std::vector<ElementIndex> mNeighborIndices;
+};
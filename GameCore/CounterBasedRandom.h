@@ -0,0 +1,124 @@
+/***************************************************************************************
+* Original Author:      Gabriele Giuseppini
+* Created:              2026-10-14
+* Copyright:            Gabriele Giuseppini  (https://github.com/GabrieleGiuseppini)
+***************************************************************************************/
+#pragma once
+
+#include "GameMath.h"
+#include "Vectors.h"
+
+#include <cassert>
+#include <cstdint>
+
+/*
+ * A counter-based random generator: each random value is a pure function of the seed
+ * and of a (step, element, draw) key, rather than the next value of a sequence.
+ *
+ * There is no state other than the seed, hence any number of threads may draw values
+ * concurrently, and the values drawn for an element at a step do not depend on the order
+ * in which elements are visited - nor on how they are split among threads. Callers
+ * drawing multiple values for the same element at the same step distinguish them via
+ * the draw index.
+ *
+ * Values are calculated by cascading the SplitMix64 finalizer over the key.
+ */
+class CounterBasedRandom
+{
+public:
+
+    explicit constexpr CounterBasedRandom(std::uint64_t seed) noexcept
+        : mMixedSeed(Mix(seed))
+    {}
+
+    inline std::uint64_t GenerateRaw(
+        std::uint64_t step,
+        std::uint64_t element,
+        std::uint32_t draw = 0) const noexcept
+    {
+        return Mix(Mix(Mix(mMixedSeed ^ step) ^ element) ^ draw);
+    }
+
+    /*
+     * Returns a value in [0.0, 1.0).
+     */
+    inline float GenerateNormalizedUniformReal(
+        std::uint64_t step,
+        std::uint64_t element,
+        std::uint32_t draw = 0) const noexcept
+    {
+        // Top 24 bits, i.e. the mantissa of a float
+        return static_cast<float>(GenerateRaw(step, element, draw) >> 40) * (1.0f / static_cast<float>(1 << 24));
+    }
+
+    inline float GenerateUniformReal(
+        float minValue,
+        float maxValue,
+        std::uint64_t step,
+        std::uint64_t element,
+        std::uint32_t draw = 0) const noexcept
+    {
+        return minValue + GenerateNormalizedUniformReal(step, element, draw) * (maxValue - minValue);
+    }
+
+    /*
+     * Returns a value between minValue and maxValue, included.
+     */
+    template <typename T>
+    inline T GenerateUniformInteger(
+        T minValue,
+        T maxValue,
+        std::uint64_t step,
+        std::uint64_t element,
+        std::uint32_t draw = 0) const noexcept
+    {
+        assert(minValue <= maxValue);
+
+        // Multiply-shift on the top 32 bits; the bias is negligible for the ranges we use
+        std::uint64_t const range = static_cast<std::uint64_t>(maxValue - minValue) + 1;
+        std::uint64_t const r32 = GenerateRaw(step, element, draw) >> 32;
+        return static_cast<T>(minValue + static_cast<T>((r32 * range) >> 32));
+    }
+
+    /*
+     * Returns true with the specified probability. A probability of zero implies
+     * that true is never returned.
+     */
+    inline bool GenerateUniformBoolean(
+        float trueProbability,
+        std::uint64_t step,
+        std::uint64_t element,
+        std::uint32_t draw = 0) const noexcept
+    {
+        return GenerateNormalizedUniformReal(step, element, draw) < trueProbability;
+    }
+
+    /*
+     * Consumes two draws: draw and draw + 1.
+     */
+    inline vec2f GenerateUniformRadialVector(
+        float minMagnitude,
+        float maxMagnitude,
+        std::uint64_t step,
+        std::uint64_t element,
+        std::uint32_t draw = 0) const noexcept
+    {
+        float const magnitude = GenerateUniformReal(minMagnitude, maxMagnitude, step, element, draw);
+        float const angle = GenerateUniformReal(0.0f, 2.0f * Pi<float>, step, element, draw + 1);
+
+        return vec2f::fromPolar(magnitude, angle);
+    }
+
+private:
+
+    static constexpr std::uint64_t Mix(std::uint64_t z) noexcept
+    {
+        z += 0x9e3779b97f4a7c15ull;
+        z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+        z = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+        return z ^ (z >> 31);
+    }
+
+    // Mixed, so that keys of different seeds don't overlap
+    std::uint64_t const mMixedSeed;
+};
@@ -0,0 +1,70 @@
+/***************************************************************************************
+* Original Author:      Gabriele Giuseppini
+* Created:              2026-10-14
+* Copyright:            Gabriele Giuseppini  (https://github.com/GabrieleGiuseppini)
+***************************************************************************************/
+#pragma once
+
+#include "GameTypes.h"
+
+#include <algorithm>
+#include <cassert>
+#include <limits>
+
+/*
+ * The smallest range of element indices [start, end) that covers all the elements
+ * that have been changed since the range was last cleared.
+ */
+class DirtyRange
+{
+public:
+
+    DirtyRange()
+        : mStart(std::numeric_limits<ElementIndex>::max())
+        , mEnd(0)
+    {}
+
+    inline bool IsEmpty() const noexcept
+    {
+        return mStart >= mEnd;
+    }
+
+    inline ElementIndex GetStart() const noexcept
+    {
+        assert(!IsEmpty());
+        return mStart;
+    }
+
+    inline ElementCount GetSize() const noexcept
+    {
+        return IsEmpty() ? 0 : mEnd - mStart;
+    }
+
+    inline void Add(ElementIndex element) noexcept
+    {
+        mStart = std::min(mStart, element);
+        mEnd = std::max(mEnd, element + 1);
+    }
+
+    inline void Add(
+        ElementIndex start,
+        ElementIndex end) noexcept // Excluded
+    {
+        if (start < end)
+        {
+            mStart = std::min(mStart, start);
+            mEnd = std::max(mEnd, end);
+        }
+    }
+
+    inline void Clear() noexcept
+    {
+        mStart = std::numeric_limits<ElementIndex>::max();
+        mEnd = 0;
+    }
+
+private:
+
+    ElementIndex mStart;
+    ElementIndex mEnd;
+};
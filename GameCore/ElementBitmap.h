@@ -0,0 +1,256 @@
+/***************************************************************************************
+* Original Author:      Gabriele Giuseppini
+* Created:              2026-10-14
+* Copyright:            Gabriele Giuseppini  (https://github.com/GabrieleGiuseppini)
+***************************************************************************************/
+#pragma once
+
+#include "GameTypes.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+/*
+ * A bitmap with one bit per element of an element container, e.g. to flag
+ * the elements that are live.
+ *
+ * Iterating the bitmap visits the set elements only, looking at 64 elements at a time;
+ * elements are visited in index order, either one by one or as runs of consecutive
+ * set elements.
+ */
+class ElementBitmap final
+{
+public:
+
+    using word_type = std::uint64_t;
+
+    static size_t constexpr BitsPerWord = sizeof(word_type) * 8;
+
+public:
+
+    /*
+     * Creates a bitmap with all elements clear.
+     */
+    explicit ElementBitmap(ElementCount elementCount)
+        : mElementCount(elementCount)
+        , mWords((elementCount + BitsPerWord - 1) / BitsPerWord, 0)
+    {
+    }
+
+    ElementBitmap(ElementBitmap && other) = default;
+    ElementBitmap & operator=(ElementBitmap && other) = default;
+
+    ElementCount GetElementCount() const
+    {
+        return mElementCount;
+    }
+
+    inline bool Test(ElementIndex i) const
+    {
+        assert(i < mElementCount);
+        return (mWords[i / BitsPerWord] & (word_type(1) << (i % BitsPerWord))) != 0;
+    }
+
+    inline void Set(ElementIndex i)
+    {
+        assert(i < mElementCount);
+        mWords[i / BitsPerWord] |= (word_type(1) << (i % BitsPerWord));
+    }
+
+    inline void Clear(ElementIndex i)
+    {
+        assert(i < mElementCount);
+        mWords[i / BitsPerWord] &= ~(word_type(1) << (i % BitsPerWord));
+    }
+
+    inline void Assign(ElementIndex i, bool value)
+    {
+        if (value)
+            Set(i);
+        else
+            Clear(i);
+    }
+
+    size_t GetByteSize() const
+    {
+        return mWords.size() * sizeof(word_type);
+    }
+
+    word_type const * GetWords() const
+    {
+        return mWords.data();
+    }
+
+    word_type * GetWords()
+    {
+        return mWords.data();
+    }
+
+    void ClearAll()
+    {
+        std::fill(mWords.begin(), mWords.end(), word_type(0));
+    }
+
+    ElementCount CountSet() const
+    {
+        ElementCount count = 0;
+        for (word_type word : mWords)
+        {
+            for (; word != 0; word &= (word - 1))
+            {
+                ++count;
+            }
+        }
+
+        return count;
+    }
+
+    /*
+     * Invokes the function with the index of each set element in [start, end), in index order.
+     */
+    template<typename TFunc>
+    inline void ForEachSet(
+        ElementIndex start,
+        ElementIndex end,
+        TFunc && func) const // void(ElementIndex)
+    {
+        VisitWords(
+            start,
+            end,
+            [&](ElementIndex wordStart, word_type word)
+            {
+                for (; word != 0; word &= (word - 1))
+                {
+                    func(static_cast<ElementIndex>(wordStart + CountTrailingZeros(word)));
+                }
+            });
+    }
+
+    template<typename TFunc>
+    inline void ForEachSet(TFunc && func) const // void(ElementIndex)
+    {
+        ForEachSet(0, mElementCount, std::forward<TFunc>(func));
+    }
+
+    /*
+     * Invokes the function with each maximal run [runStart, runEnd) of consecutive set elements
+     * in [start, end), in index order.
+     */
+    template<typename TFunc>
+    inline void ForEachSetRun(
+        ElementIndex start,
+        ElementIndex end,
+        TFunc && func) const // void(ElementIndex runStart, ElementIndex runEnd)
+    {
+        ElementIndex runStart = NoneElementIndex;
+        ElementIndex runEnd = NoneElementIndex;
+
+        VisitWords(
+            start,
+            end,
+            [&](ElementIndex wordStart, word_type word)
+            {
+                while (word != 0)
+                {
+                    // First set bit, and first clear bit after it
+                    size_t const firstSet = CountTrailingZeros(word);
+                    word_type const fromFirstSet = ~(word >> firstSet);
+                    size_t const runLength = (fromFirstSet == 0)
+                        ? BitsPerWord - firstSet
+                        : std::min(CountTrailingZeros(fromFirstSet), BitsPerWord - firstSet);
+
+                    ElementIndex const thisStart = static_cast<ElementIndex>(wordStart + firstSet);
+                    ElementIndex const thisEnd = static_cast<ElementIndex>(thisStart + runLength);
+
+                    if (runEnd == thisStart)
+                    {
+                        // Continues the current run across words
+                        runEnd = thisEnd;
+                    }
+                    else
+                    {
+                        if (runStart != NoneElementIndex)
+                            func(runStart, runEnd);
+
+                        runStart = thisStart;
+                        runEnd = thisEnd;
+                    }
+
+                    // Clear the run's bits
+                    if (firstSet + runLength == BitsPerWord)
+                        word = 0;
+                    else
+                        word &= ~((word_type(1) << (firstSet + runLength)) - 1);
+                }
+            });
+
+        if (runStart != NoneElementIndex)
+            func(runStart, runEnd);
+    }
+
+    template<typename TFunc>
+    inline void ForEachSetRun(TFunc && func) const // void(ElementIndex runStart, ElementIndex runEnd)
+    {
+        ForEachSetRun(0, mElementCount, std::forward<TFunc>(func));
+    }
+
+private:
+
+    /*
+     * Invokes the function with each non-empty word overlapping [start, end), masked
+     * to the range, together with the index of the word's first element.
+     */
+    template<typename TFunc>
+    inline void VisitWords(
+        ElementIndex start,
+        ElementIndex end,
+        TFunc && func) const // void(ElementIndex wordStart, word_type word)
+    {
+        assert(start <= end && end <= mElementCount);
+
+        if (start >= end)
+            return;
+
+        size_t const firstWord = start / BitsPerWord;
+        size_t const lastWord = (end - 1) / BitsPerWord;
+
+        for (size_t w = firstWord; w <= lastWord; ++w)
+        {
+            word_type word = mWords[w];
+
+            if (w == firstWord)
+                word &= ~word_type(0) << (start % BitsPerWord);
+
+            if (w == lastWord && (end % BitsPerWord) != 0)
+                word &= (word_type(1) << (end % BitsPerWord)) - 1;
+
+            if (word != 0)
+                func(static_cast<ElementIndex>(w * BitsPerWord), word);
+        }
+    }
+
+    static inline size_t CountTrailingZeros(word_type word)
+    {
+        assert(word != 0);
+
+#if defined(_MSC_VER)
+        unsigned long index;
+        _BitScanForward64(&index, word);
+        return static_cast<size_t>(index);
+#else
+        return static_cast<size_t>(__builtin_ctzll(word));
+#endif
+    }
+
+private:
+
+    ElementCount mElementCount;
+    std::vector<word_type> mWords;
+};
@@ -8,6 +8,7 @@
 #include "GameMath.h"
 #include "Vectors.h"
 
+#include <cstdint>
 #include <random>
 
 /*
@@ -16,7 +17,10 @@
  * Not so random - always uses the same seed. On purpose! We want two instances
  * of the game to be identical to each other.
  *
- * Singleton.
+ * Singleton; however, a thread may redirect the singleton to an engine of its own -
+ * a stream, with a seed of its own - for the lifetime of a Scope, so that code running
+ * concurrently on different threads - e.g. ships updated concurrently - never draws
+ * from the same engine. The engine itself is not thread-safe.
  */
 class GameRandomEngine
 {
@@ -24,11 +28,53 @@ public:
 
     static GameRandomEngine & GetInstance()
     {
+        if (CurrentThreadEngine != nullptr)
+        {
+            return *CurrentThreadEngine;
+        }
+
         static GameRandomEngine * instance = new GameRandomEngine();
 
         return *instance;
     }
 
+    /*
+     * Makes GetInstance() return the specified engine on the current thread, for the
+     * lifetime of the scope.
+     */
+    class Scope final
+    {
+    public:
+
+        explicit Scope(GameRandomEngine & engine)
+            : mPrevious(CurrentThreadEngine)
+        {
+            CurrentThreadEngine = &engine;
+        }
+
+        ~Scope()
+        {
+            CurrentThreadEngine = mPrevious;
+        }
+
+        Scope(Scope const &) = delete;
+        Scope & operator=(Scope const &) = delete;
+
+    private:
+
+        GameRandomEngine * const mPrevious;
+    };
+
+    /*
+     * Creates an engine for a stream other than the singleton's; different
+     * streams have different seeds.
+     */
+    explicit GameRandomEngine(std::uint32_t streamId)
+        : mStreamId(streamId)
+    {
+        Reset();
+    }
+
     /*
      * Returns a value between 0 and count - 1, included.
      */
@@ -156,17 +202,65 @@ public:
         return mean + mNormalDistribution(mRandomEngine) * stdev;
     }
 
-private:
-
-    GameRandomEngine()
+    /*
+     * Restarts the random sequence from its initial seed, so that runs may be
+     * reproduced within the same process.
+     */
+    void Reset()
     {
-        std::seed_seq seed_seq({ 1, 242, 19730528 });
+        std::seed_seq seed_seq = (mStreamId == SingletonStreamId)
+            ? std::seed_seq({ 1, 242, 19730528 })
+            : std::seed_seq({ 1u, 242u, 19730528u, mStreamId });
         mRandomEngine = std::ranlux48_base(seed_seq);
         mRandomUniformDistribution = std::uniform_real_distribution<float>(0.0f, 1.0f);
         mNormalDistribution = std::normal_distribution<float>(0.0f, 1.0f);
     }
 
+    /*
+     * The position in the random sequence, which may be saved and restored - e.g. so
+     * that two simulations run, one after the other, off the same random sequence.
+     */
+    struct State
+    {
+        std::ranlux48_base Engine;
+        std::uniform_real_distribution<float> UniformDistribution;
+        std::normal_distribution<float> NormalDistribution;
+
+        bool operator==(State const & other) const
+        {
+            return Engine == other.Engine
+                && UniformDistribution == other.UniformDistribution
+                && NormalDistribution == other.NormalDistribution;
+        }
+    };
+
+    State GetState() const
+    {
+        return State{ mRandomEngine, mRandomUniformDistribution, mNormalDistribution };
+    }
+
+    void SetState(State const & state)
+    {
+        mRandomEngine = state.Engine;
+        mRandomUniformDistribution = state.UniformDistribution;
+        mNormalDistribution = state.NormalDistribution;
+    }
+
+private:
+
+    static std::uint32_t constexpr SingletonStreamId = 0xffffffff;
+
+    GameRandomEngine()
+        : mStreamId(SingletonStreamId)
+    {
+        Reset();
+    }
+
+    std::uint32_t mStreamId;
+
     std::ranlux48_base mRandomEngine;
     std::uniform_real_distribution<float> mRandomUniformDistribution;
     std::normal_distribution<float> mNormalDistribution;
+
+    static inline thread_local GameRandomEngine * CurrentThreadEngine = nullptr;
 };
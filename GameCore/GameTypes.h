@@ -233,6 +233,11 @@ public:
         return step == (mValue % period);
     }
 
+    inline std::uint32_t GetStepOf(std::uint32_t period) const
+    {
+        return mValue % period;
+    }
+
 private:
 
     friend std::basic_ostream<char> & operator<<(std::basic_ostream<char> & os, SequenceNumber const & s);
@@ -1045,6 +1050,15 @@ enum class ToolApplicationLocus
 
 template <> struct is_flag<ToolApplicationLocus> : std::true_type {};
 
+/*
+ * The kernels that may calculate spring forces.
+ */
+enum class SpringForcesKernelType
+{
+    Scalar,
+    Vectorized  // The widest vectorized kernel supported by the CPU
+};
+
 ////////////////////////////////////////////////////////////////////////////////////////////////
 // Rendering
 ////////////////////////////////////////////////////////////////////////////////////////////////
@@ -5,50 +5,531 @@
 ***************************************************************************************/
 #include "ImageTools.h"
 
-void ImageTools::BlendWithColor(
-    RgbaImageData & imageData,
+#include "SysSpecifics.h"
+#include "TaskThreadPool.h"
+
+#include <cmath>
+#include <vector>
+
+namespace {
+
+struct DownsampleContribution
+{
+    int SourceIndex;
+    float Weight;
+};
+
+/*
+ * Calculates, for each target pixel along one dimension, the source pixels it covers,
+ * each with the fraction of the target pixel it covers.
+ */
+void CalculateDownsampleContributions(
+    int sourceSize,
+    int targetSize,
+    std::vector<DownsampleContribution> & contributions,
+    std::vector<size_t> & contributionStarts)
+{
+    assert(targetSize > 0 && targetSize <= sourceSize);
+
+    float const scale = static_cast<float>(sourceSize) / static_cast<float>(targetSize);
+
+    for (int t = 0; t < targetSize; ++t)
+    {
+        contributionStarts.push_back(contributions.size());
+
+        float const start = static_cast<float>(t) * scale;
+        float const end = std::min(static_cast<float>(t + 1) * scale, static_cast<float>(sourceSize));
+
+        float totalCoverage = 0.0f;
+        for (int s = static_cast<int>(start); s < sourceSize && static_cast<float>(s) < end; ++s)
+        {
+            float const coverage = std::min(static_cast<float>(s + 1), end) - std::max(static_cast<float>(s), start);
+            if (coverage > 0.0f)
+            {
+                contributions.push_back({ s, coverage });
+                totalCoverage += coverage;
+            }
+        }
+
+        // Normalize
+        for (size_t c = contributionStarts.back(); c < contributions.size(); ++c)
+        {
+            contributions[c].Weight /= totalCoverage;
+        }
+    }
+
+    contributionStarts.push_back(contributions.size());
+}
+
+/*
+ * accumulator[x] += sourceRow[x] * weight, for each of the four channels.
+ */
+inline void AccumulateDownsampleRow(
+    rgbaColor const * restrict sourceRow,
+    float weight,
+    float * restrict accumulator,
+    int width)
+{
+    int x = 0;
+
+#if FS_IS_ARCHITECTURE_X86_64() || FS_IS_ARCHITECTURE_X86_32()
+    __m128 const weight_4 = _mm_set1_ps(weight);
+    __m128i const zero = _mm_setzero_si128();
+
+    for (; x + 4 <= width; x += 4)
+    {
+        // Four pixels, i.e. sixteen 8-bit channels, expanded to 16 and then to 32 bits
+        __m128i const pixels = _mm_loadu_si128(reinterpret_cast<__m128i const *>(sourceRow + x));
+        __m128i const pixels01 = _mm_unpacklo_epi8(pixels, zero);
+        __m128i const pixels23 = _mm_unpackhi_epi8(pixels, zero);
+
+        float * const acc = accumulator + x * 4;
+
+        _mm_storeu_ps(acc, _mm_add_ps(_mm_loadu_ps(acc), _mm_mul_ps(_mm_cvtepi32_ps(_mm_unpacklo_epi16(pixels01, zero)), weight_4)));
+        _mm_storeu_ps(acc + 4, _mm_add_ps(_mm_loadu_ps(acc + 4), _mm_mul_ps(_mm_cvtepi32_ps(_mm_unpackhi_epi16(pixels01, zero)), weight_4)));
+        _mm_storeu_ps(acc + 8, _mm_add_ps(_mm_loadu_ps(acc + 8), _mm_mul_ps(_mm_cvtepi32_ps(_mm_unpacklo_epi16(pixels23, zero)), weight_4)));
+        _mm_storeu_ps(acc + 12, _mm_add_ps(_mm_loadu_ps(acc + 12), _mm_mul_ps(_mm_cvtepi32_ps(_mm_unpackhi_epi16(pixels23, zero)), weight_4)));
+    }
+#endif
+
+    for (; x < width; ++x)
+    {
+        accumulator[x * 4 + 0] += static_cast<float>(sourceRow[x].r) * weight;
+        accumulator[x * 4 + 1] += static_cast<float>(sourceRow[x].g) * weight;
+        accumulator[x * 4 + 2] += static_cast<float>(sourceRow[x].b) * weight;
+        accumulator[x * 4 + 3] += static_cast<float>(sourceRow[x].a) * weight;
+    }
+}
+
+inline rgbaColor DownsamplePixel(
+    float const * restrict accumulator,
+    DownsampleContribution const * contributions,
+    size_t contributionCount)
+{
+#if FS_IS_ARCHITECTURE_X86_64() || FS_IS_ARCHITECTURE_X86_32()
+    __m128 sum = _mm_setzero_ps();
+    for (size_t c = 0; c < contributionCount; ++c)
+    {
+        sum = _mm_add_ps(
+            sum,
+            _mm_mul_ps(
+                _mm_loadu_ps(accumulator + contributions[c].SourceIndex * 4),
+                _mm_set1_ps(contributions[c].Weight)));
+    }
+
+    // Round and pack back to 8 bits, with saturation
+    __m128i const sum32 = _mm_cvtps_epi32(sum);
+    __m128i const sum16 = _mm_packs_epi32(sum32, sum32);
+    __m128i const sum8 = _mm_packus_epi16(sum16, sum16);
+
+    std::uint32_t const packed = static_cast<std::uint32_t>(_mm_cvtsi128_si32(sum8));
+
+    // Lanes are r, g, b, a, from the lowest byte up
+    return rgbaColor(
+        static_cast<rgbaColor::data_type>(packed & 0xff),
+        static_cast<rgbaColor::data_type>((packed >> 8) & 0xff),
+        static_cast<rgbaColor::data_type>((packed >> 16) & 0xff),
+        static_cast<rgbaColor::data_type>((packed >> 24) & 0xff));
+#else
+    float sum[4] = { 0.0f, 0.0f, 0.0f, 0.0f };
+    for (size_t c = 0; c < contributionCount; ++c)
+    {
+        for (int ch = 0; ch < 4; ++ch)
+        {
+            sum[ch] += accumulator[contributions[c].SourceIndex * 4 + ch] * contributions[c].Weight;
+        }
+    }
+
+    auto const toChannel = [](float value)
+    {
+        return static_cast<rgbaColor::data_type>(Clamp(std::round(value), 0.0f, static_cast<float>(rgbaColor::data_type_max)));
+    };
+
+    return rgbaColor(toChannel(sum[0]), toChannel(sum[1]), toChannel(sum[2]), toChannel(sum[3]));
+#endif
+}
+
+/*
+ * Invokes func(rowStart, rowEnd) over all rows, in parallel tiles of rows when
+ * a thread pool is specified.
+ */
+template<typename TFunc>
+void ForEachRowTile(
+    ImageSize const & size,
+    TaskThreadPool * taskThreadPool,
+    TFunc const & func)
+{
+    if (taskThreadPool == nullptr || size.height <= 1)
+    {
+        func(0, size.height);
+    }
+    else
+    {
+        // Tiles large enough to amortize their scheduling
+        size_t constexpr MinPixelsPerTile = 64 * 1024;
+        size_t const grain = std::max(MinPixelsPerTile / static_cast<size_t>(std::max(size.width, 1)), size_t(1));
+
+        taskThreadPool->ParallelFor(
+            0,
+            static_cast<size_t>(size.height),
+            grain,
+            [&func](size_t rowStart, size_t rowEnd)
+            {
+                func(static_cast<int>(rowStart), static_cast<int>(rowEnd));
+            });
+    }
+}
+
+//
+// Per-pixel kernels; the SIMD ones process four pixels at a time, with the same
+// operations - in the same order - as the rgbaColor methods they replace, and
+// thus with the same rounding
+//
+
+#if FS_IS_ARCHITECTURE_X86_64() || FS_IS_ARCHITECTURE_X86_32()
+
+/*
+ * Loads four pixels, as one (r, g, b, a) vector each, in the 0-255 range.
+ */
+inline void LoadPixels_SSE2(
+    rgbaColor const * pixels,
+    __m128 (&p)[4])
+{
+    __m128i const zero = _mm_setzero_si128();
+    __m128i const pixels8 = _mm_loadu_si128(reinterpret_cast<__m128i const *>(pixels));
+    __m128i const pixels01 = _mm_unpacklo_epi8(pixels8, zero);
+    __m128i const pixels23 = _mm_unpackhi_epi8(pixels8, zero);
+
+    p[0] = _mm_cvtepi32_ps(_mm_unpacklo_epi16(pixels01, zero));
+    p[1] = _mm_cvtepi32_ps(_mm_unpackhi_epi16(pixels01, zero));
+    p[2] = _mm_cvtepi32_ps(_mm_unpacklo_epi16(pixels23, zero));
+    p[3] = _mm_cvtepi32_ps(_mm_unpackhi_epi16(pixels23, zero));
+}
+
+/*
+ * Stores four pixels, truncating their channels as static_cast<uint8_t> does.
+ */
+inline void StorePixels_SSE2(
+    __m128 const (&p)[4],
+    rgbaColor * pixels)
+{
+    __m128i const pixels01 = _mm_packs_epi32(_mm_cvttps_epi32(p[0]), _mm_cvttps_epi32(p[1]));
+    __m128i const pixels23 = _mm_packs_epi32(_mm_cvttps_epi32(p[2]), _mm_cvttps_epi32(p[3]));
+
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(pixels), _mm_packus_epi16(pixels01, pixels23));
+}
+
+inline __m128 SplatAlpha_SSE2(__m128 p)
+{
+    return _mm_shuffle_ps(p, p, _MM_SHUFFLE(3, 3, 3, 3));
+}
+
+// Takes the alpha channel from a, and the others from rgb
+inline __m128 SelectAlpha_SSE2(
+    __m128 a,
+    __m128 rgb)
+{
+    __m128 const alphaMask = _mm_castsi128_ps(_mm_set_epi32(-1, 0, 0, 0));
+    return _mm_or_ps(_mm_and_ps(alphaMask, a), _mm_andnot_ps(alphaMask, rgb));
+}
+
+#endif
+
+#if FS_IS_ARCHITECTURE_ARM_64()
+
+inline void LoadPixels_NEON(
+    rgbaColor const * pixels,
+    float32x4_t (&p)[4])
+{
+    uint8x16_t const pixels8 = vld1q_u8(reinterpret_cast<std::uint8_t const *>(pixels));
+    uint16x8_t const pixels01 = vmovl_u8(vget_low_u8(pixels8));
+    uint16x8_t const pixels23 = vmovl_u8(vget_high_u8(pixels8));
+
+    p[0] = vcvtq_f32_u32(vmovl_u16(vget_low_u16(pixels01)));
+    p[1] = vcvtq_f32_u32(vmovl_u16(vget_high_u16(pixels01)));
+    p[2] = vcvtq_f32_u32(vmovl_u16(vget_low_u16(pixels23)));
+    p[3] = vcvtq_f32_u32(vmovl_u16(vget_high_u16(pixels23)));
+}
+
+inline void StorePixels_NEON(
+    float32x4_t const (&p)[4],
+    rgbaColor * pixels)
+{
+    uint16x8_t const pixels01 = vcombine_u16(vqmovn_u32(vcvtq_u32_f32(p[0])), vqmovn_u32(vcvtq_u32_f32(p[1])));
+    uint16x8_t const pixels23 = vcombine_u16(vqmovn_u32(vcvtq_u32_f32(p[2])), vqmovn_u32(vcvtq_u32_f32(p[3])));
+
+    vst1q_u8(reinterpret_cast<std::uint8_t *>(pixels), vcombine_u8(vqmovn_u16(pixels01), vqmovn_u16(pixels23)));
+}
+
+inline float32x4_t SplatAlpha_NEON(float32x4_t p)
+{
+    return vdupq_laneq_f32(p, 3);
+}
+
+inline float32x4_t SelectAlpha_NEON(
+    float32x4_t a,
+    float32x4_t rgb)
+{
+    uint32x4_t const alphaMask = vsetq_lane_u32(0xffffffff, vdupq_n_u32(0), 3);
+    return vbslq_f32(alphaMask, a, rgb);
+}
+
+#endif
+
+void BlendWithColorRow(
+    rgbaColor * restrict pixels,
+    int count,
     rgbColor const & color,
     float alpha)
 {
-    size_t const pixelCount = imageData.Size.GetLinearSize();
-    for (size_t i = 0; i < pixelCount; ++i)
+    int i = 0;
+
+#if FS_IS_ARCHITECTURE_X86_64() || FS_IS_ARCHITECTURE_X86_32()
+    __m128 const _255 = _mm_set1_ps(255.0f);
+    __m128 const half = _mm_set1_ps(0.5f);
+    __m128 const alpha_4 = _mm_set1_ps(alpha);
+    __m128 const color_4 = _mm_div_ps(_mm_setr_ps(color.r, color.g, color.b, 0.0f), _255);
+
+    for (; i + 4 <= count; i += 4)
+    {
+        __m128 p[4];
+        LoadPixels_SSE2(pixels + i, p);
+
+        for (auto & v : p)
+        {
+            __m128 const f = _mm_div_ps(v, _255);
+            __m128 const result = _mm_add_ps(f, _mm_mul_ps(_mm_sub_ps(color_4, f), alpha_4));
+            v = SelectAlpha_SSE2(v, _mm_add_ps(_mm_mul_ps(result, _255), half));
+        }
+
+        StorePixels_SSE2(p, pixels + i);
+    }
+#elif FS_IS_ARCHITECTURE_ARM_64()
+    float32x4_t const _255 = vdupq_n_f32(255.0f);
+    float32x4_t const half = vdupq_n_f32(0.5f);
+    float32x4_t const alpha_4 = vdupq_n_f32(alpha);
+    float const colorChannels[4] = { static_cast<float>(color.r), static_cast<float>(color.g), static_cast<float>(color.b), 0.0f };
+    float32x4_t const color_4 = vdivq_f32(vld1q_f32(colorChannels), _255);
+
+    for (; i + 4 <= count; i += 4)
+    {
+        float32x4_t p[4];
+        LoadPixels_NEON(pixels + i, p);
+
+        for (auto & v : p)
+        {
+            float32x4_t const f = vdivq_f32(v, _255);
+            float32x4_t const result = vaddq_f32(f, vmulq_f32(vsubq_f32(color_4, f), alpha_4));
+            v = SelectAlpha_NEON(v, vaddq_f32(vmulq_f32(result, _255), half));
+        }
+
+        StorePixels_NEON(p, pixels + i);
+    }
+#endif
+
+    for (; i < count; ++i)
+    {
+        pixels[i] = pixels[i].mix(color, alpha);
+    }
+}
+
+void OverlayRow(
+    rgbaColor * restrict basePixels,
+    rgbaColor const * restrict overlayPixels,
+    int count)
+{
+    int i = 0;
+
+#if FS_IS_ARCHITECTURE_X86_64() || FS_IS_ARCHITECTURE_X86_32()
+    __m128 const _255 = _mm_set1_ps(255.0f);
+    __m128 const half = _mm_set1_ps(0.5f);
+    __m128 const one = _mm_set1_ps(1.0f);
+
+    for (; i + 4 <= count; i += 4)
+    {
+        __m128 b[4];
+        LoadPixels_SSE2(basePixels + i, b);
+
+        __m128 o[4];
+        LoadPixels_SSE2(overlayPixels + i, o);
+
+        for (int p = 0; p < 4; ++p)
+        {
+            __m128 const thisF = _mm_div_ps(b[p], _255);
+            __m128 const otherF = _mm_div_ps(o[p], _255);
+            __m128 const thisAlpha = SplatAlpha_SSE2(thisF);
+            __m128 const otherAlpha = SplatAlpha_SSE2(otherF);
+
+            __m128 const rgb = _mm_add_ps(thisF, _mm_mul_ps(_mm_sub_ps(otherF, thisF), otherAlpha));
+            __m128 const finalAlpha = _mm_add_ps(thisAlpha, _mm_mul_ps(otherAlpha, _mm_sub_ps(one, thisAlpha)));
+
+            b[p] = _mm_add_ps(_mm_mul_ps(SelectAlpha_SSE2(finalAlpha, rgb), _255), half);
+        }
+
+        StorePixels_SSE2(b, basePixels + i);
+    }
+#elif FS_IS_ARCHITECTURE_ARM_64()
+    float32x4_t const _255 = vdupq_n_f32(255.0f);
+    float32x4_t const half = vdupq_n_f32(0.5f);
+    float32x4_t const one = vdupq_n_f32(1.0f);
+
+    for (; i + 4 <= count; i += 4)
+    {
+        float32x4_t b[4];
+        LoadPixels_NEON(basePixels + i, b);
+
+        float32x4_t o[4];
+        LoadPixels_NEON(overlayPixels + i, o);
+
+        for (int p = 0; p < 4; ++p)
+        {
+            float32x4_t const thisF = vdivq_f32(b[p], _255);
+            float32x4_t const otherF = vdivq_f32(o[p], _255);
+            float32x4_t const thisAlpha = SplatAlpha_NEON(thisF);
+            float32x4_t const otherAlpha = SplatAlpha_NEON(otherF);
+
+            float32x4_t const rgb = vaddq_f32(thisF, vmulq_f32(vsubq_f32(otherF, thisF), otherAlpha));
+            float32x4_t const finalAlpha = vaddq_f32(thisAlpha, vmulq_f32(otherAlpha, vsubq_f32(one, thisAlpha)));
+
+            b[p] = vaddq_f32(vmulq_f32(SelectAlpha_NEON(finalAlpha, rgb), _255), half);
+        }
+
+        StorePixels_NEON(b, basePixels + i);
+    }
+#endif
+
+    for (; i < count; ++i)
+    {
+        basePixels[i] = basePixels[i].blend(overlayPixels[i]);
+    }
+}
+
+void AlphaPreMultiplyRow(
+    rgbaColor * restrict pixels,
+    int count)
+{
+    int i = 0;
+
+#if FS_IS_ARCHITECTURE_X86_64() || FS_IS_ARCHITECTURE_X86_32()
+    __m128 const _255 = _mm_set1_ps(255.0f);
+    __m128 const half = _mm_set1_ps(0.5f);
+
+    for (; i + 4 <= count; i += 4)
+    {
+        __m128 p[4];
+        LoadPixels_SSE2(pixels + i, p);
+
+        for (auto & v : p)
+        {
+            __m128 const alpha = _mm_div_ps(SplatAlpha_SSE2(v), _255);
+            v = SelectAlpha_SSE2(v, _mm_add_ps(_mm_mul_ps(v, alpha), half));
+        }
+
+        StorePixels_SSE2(p, pixels + i);
+    }
+#elif FS_IS_ARCHITECTURE_ARM_64()
+    float32x4_t const _255 = vdupq_n_f32(255.0f);
+    float32x4_t const half = vdupq_n_f32(0.5f);
+
+    for (; i + 4 <= count; i += 4)
     {
-        imageData.Data[i] = imageData.Data[i].mix(color, alpha);
+        float32x4_t p[4];
+        LoadPixels_NEON(pixels + i, p);
+
+        for (auto & v : p)
+        {
+            float32x4_t const alpha = vdivq_f32(SplatAlpha_NEON(v), _255);
+            v = SelectAlpha_NEON(v, vaddq_f32(vmulq_f32(v, alpha), half));
+        }
+
+        StorePixels_NEON(p, pixels + i);
+    }
+#endif
+
+    for (; i < count; ++i)
+    {
+        pixels[i].alpha_multiply();
     }
 }
 
+}
+
+void ImageTools::BlendWithColor(
+    RgbaImageData & imageData,
+    rgbColor const & color,
+    float alpha,
+    TaskThreadPool * taskThreadPool)
+{
+    int const width = imageData.Size.width;
+    rgbaColor * const buffer = imageData.Data.get();
+
+    ForEachRowTile(
+        imageData.Size,
+        taskThreadPool,
+        [&](int rowStart, int rowEnd)
+        {
+            BlendWithColorRow(
+                buffer + rowStart * width,
+                (rowEnd - rowStart) * width,
+                color,
+                alpha);
+        });
+}
+
 void ImageTools::Overlay(
     RgbaImageData & baseImageData,
     RgbaImageData const & overlayImageData,
     int x,
-    int y)
+    int y,
+    TaskThreadPool * taskThreadPool)
 {
+    assert(x >= 0 && y >= 0);
+
     auto const baseSize = baseImageData.Size;
     auto const overlaySize = overlayImageData.Size;
 
-    rgbaColor * const restrict baseBuffer = baseImageData.Data.get();
-    rgbaColor const * const restrict overlayBuffer = overlayImageData.Data.get();
+    // The region of the overlay that falls within the base
+    ImageSize const overlapSize(
+        std::max(std::min(overlaySize.width, baseSize.width - x), 0),
+        std::max(std::min(overlaySize.height, baseSize.height - y), 0));
 
-    for (int baseR = y, overlayR = 0; baseR < baseSize.height && overlayR < overlaySize.width; ++baseR, ++overlayR)
-    {
-        auto const baseRowStartIndex = baseR * baseSize.width;
-        auto const overlayRowStartIndex = overlayR * overlaySize.width;
+    if (overlapSize.width == 0)
+        return;
 
-        for (int baseC = x, overlayC = 0; baseC < baseSize.width && overlayC < overlaySize.width; ++baseC, ++overlayC)
+    rgbaColor * const baseBuffer = baseImageData.Data.get();
+    rgbaColor const * const overlayBuffer = overlayImageData.Data.get();
+
+    ForEachRowTile(
+        overlapSize,
+        taskThreadPool,
+        [&](int rowStart, int rowEnd)
         {
-            baseBuffer[baseRowStartIndex + baseC] =
-                baseBuffer[baseRowStartIndex + baseC].blend(overlayBuffer[overlayRowStartIndex + overlayC]);
-        }
-    }
+            for (int overlayR = rowStart; overlayR < rowEnd; ++overlayR)
+            {
+                OverlayRow(
+                    baseBuffer + (y + overlayR) * baseSize.width + x,
+                    overlayBuffer + overlayR * overlaySize.width,
+                    overlapSize.width);
+            }
+        });
 }
 
-void ImageTools::AlphaPreMultiply(RgbaImageData & imageData)
+void ImageTools::AlphaPreMultiply(
+    RgbaImageData & imageData,
+    TaskThreadPool * taskThreadPool)
 {
-    size_t const pixelCount = imageData.Size.GetLinearSize();
-    for (size_t i = 0; i < pixelCount; ++i)
-    {
-        imageData.Data[i].alpha_multiply();
-    }
+    int const width = imageData.Size.width;
+    rgbaColor * const buffer = imageData.Data.get();
+
+    ForEachRowTile(
+        imageData.Size,
+        taskThreadPool,
+        [&](int rowStart, int rowEnd)
+        {
+            AlphaPreMultiplyRow(
+                buffer + rowStart * width,
+                (rowEnd - rowStart) * width);
+        });
 }
 
 RgbaImageData ImageTools::Truncate(
@@ -72,36 +553,99 @@ RgbaImageData ImageTools::Truncate(
     return RgbaImageData(finalImageSize, std::move(newImageData));
 }
 
-RgbImageData ImageTools::ToRgb(RgbaImageData const & imageData)
+RgbImageData ImageTools::ToRgb(
+    RgbaImageData const & imageData,
+    TaskThreadPool * taskThreadPool)
 {
     std::unique_ptr<rgbColor[]> newImageData = std::make_unique<rgbColor[]>(imageData.Size.GetLinearSize());
 
-    for (int r = 0; r < imageData.Size.height; ++r)
-    {
-        auto const rowStartIndex = r * imageData.Size.width;
-        for (int c = 0; c < imageData.Size.width; ++c)
+    rgbaColor const * const restrict readBuffer = imageData.Data.get();
+    rgbColor * const restrict writeBuffer = newImageData.get();
+    int const width = imageData.Size.width;
+
+    ForEachRowTile(
+        imageData.Size,
+        taskThreadPool,
+        [&](int rowStart, int rowEnd)
         {
-            newImageData[rowStartIndex + c] = imageData.Data[rowStartIndex + c].toRgbColor();
-        }
-    }
+            for (int i = rowStart * width; i < rowEnd * width; ++i)
+            {
+                writeBuffer[i] = readBuffer[i].toRgbColor();
+            }
+        });
 
     return RgbImageData(imageData.Size, std::move(newImageData));
 }
 
-RgbImageData ImageTools::ToAlpha(RgbaImageData const & imageData)
+RgbImageData ImageTools::ToAlpha(
+    RgbaImageData const & imageData,
+    TaskThreadPool * taskThreadPool)
 {
     std::unique_ptr<rgbColor[]> newImageData = std::make_unique<rgbColor[]>(imageData.Size.GetLinearSize());
 
-    for (int r = 0; r < imageData.Size.height; ++r)
+    rgbaColor const * const restrict readBuffer = imageData.Data.get();
+    rgbColor * const restrict writeBuffer = newImageData.get();
+    int const width = imageData.Size.width;
+
+    ForEachRowTile(
+        imageData.Size,
+        taskThreadPool,
+        [&](int rowStart, int rowEnd)
+        {
+            for (int i = rowStart * width; i < rowEnd * width; ++i)
+            {
+                auto const a = readBuffer[i].a;
+                writeBuffer[i] = rgbColor(a, a, a);
+            }
+        });
+
+    return RgbImageData(imageData.Size, std::move(newImageData));
+}
+
+RgbaImageData ImageTools::Downsample(
+    RgbaImageData const & imageData,
+    ImageSize const & newSize)
+{
+    static_assert(sizeof(rgbaColor) == 4);
+
+    assert(newSize.width > 0 && newSize.width <= imageData.Size.width);
+    assert(newSize.height > 0 && newSize.height <= imageData.Size.height);
+
+    std::vector<DownsampleContribution> xContributions;
+    std::vector<size_t> xContributionStarts;
+    CalculateDownsampleContributions(imageData.Size.width, newSize.width, xContributions, xContributionStarts);
+
+    std::vector<DownsampleContribution> yContributions;
+    std::vector<size_t> yContributionStarts;
+    CalculateDownsampleContributions(imageData.Size.height, newSize.height, yContributions, yContributionStarts);
+
+    std::unique_ptr<rgbaColor[]> newImageData = std::make_unique<rgbaColor[]>(newSize.GetLinearSize());
+
+    // The source rows covered by one target row, blended together
+    std::vector<float> rowAccumulator(imageData.Size.width * 4);
+
+    for (int r = 0; r < newSize.height; ++r)
     {
-        auto const rowStartIndex = r * imageData.Size.width;
-        for (int c = 0; c < imageData.Size.width; ++c)
+        std::fill(rowAccumulator.begin(), rowAccumulator.end(), 0.0f);
+
+        for (size_t c = yContributionStarts[r]; c < yContributionStarts[r + 1]; ++c)
+        {
+            AccumulateDownsampleRow(
+                imageData.Data.get() + yContributions[c].SourceIndex * imageData.Size.width,
+                yContributions[c].Weight,
+                rowAccumulator.data(),
+                imageData.Size.width);
+        }
+
+        auto const rowStartIndex = r * newSize.width;
+        for (int c = 0; c < newSize.width; ++c)
         {
-            auto const a = imageData.Data[rowStartIndex + c].a;
-            rgbColor c2(a, a, a);
-            newImageData[rowStartIndex + c] = c2;
+            newImageData[rowStartIndex + c] = DownsamplePixel(
+                rowAccumulator.data(),
+                xContributions.data() + xContributionStarts[c],
+                xContributionStarts[c + 1] - xContributionStarts[c]);
         }
     }
 
-    return RgbImageData(imageData.Size, std::move(newImageData));
+    return RgbaImageData(newSize, std::move(newImageData));
 }
@@ -14,6 +14,12 @@
 #include <cassert>
 #include <functional>
 
+class TaskThreadPool;
+
+/*
+ * The per-pixel operations take an optional thread pool, which - when specified - processes
+ * tiles of rows in parallel; results are the same with and without it.
+ */
 class ImageTools
 {
 public:
@@ -21,18 +27,22 @@ public:
     static void BlendWithColor(
         RgbaImageData & imageData,
         rgbColor const & color,
-        float alpha);
+        float alpha,
+        TaskThreadPool * taskThreadPool = nullptr);
 
     static void Overlay(
         RgbaImageData & baseImageData,
         RgbaImageData const & overlayImageData,
         int x,
-        int y);
+        int y,
+        TaskThreadPool * taskThreadPool = nullptr);
 
     /*
      * Multiplies the r, g, and b channels by the alpha channel.
      */
-    static void AlphaPreMultiply(RgbaImageData & imageData);
+    static void AlphaPreMultiply(
+        RgbaImageData & imageData,
+        TaskThreadPool * taskThreadPool = nullptr);
 
     static inline vec4f SamplePixel(
         RgbaImageData const & imageData,
@@ -93,9 +103,22 @@ public:
         RgbaImageData imageData,
         ImageSize imageSize);
 
-    static RgbImageData ToRgb(RgbaImageData const & imageData);
+    static RgbImageData ToRgb(
+        RgbaImageData const & imageData,
+        TaskThreadPool * taskThreadPool = nullptr);
+
+    static RgbImageData ToAlpha(
+        RgbaImageData const & imageData,
+        TaskThreadPool * taskThreadPool = nullptr);
 
-    static RgbImageData ToAlpha(RgbaImageData const & imageData);
+    /*
+     * Shrinks the image to the specified size - which may not be larger than the image
+     * in either dimension - by averaging all the pixels that each pixel of the new image
+     * covers (box filter).
+     */
+    static RgbaImageData Downsample(
+        RgbaImageData const & imageData,
+        ImageSize const & newSize);
 
 private:
 
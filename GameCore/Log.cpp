@@ -5,12 +5,106 @@
 ***************************************************************************************/
 #include "Log.h"
 
-Logger Logger::Instance;
-
 #if FS_IS_OS_WINDOWS()
 #include "windows.h"
 #endif
 
+Logger Logger::Instance;
+
+Logger::Logger()
+	: mCurrentListener()
+	, mStoredMessages()
+    , mDeliveryMutex()
+    , mPendingMessages()
+    , mDeliveringMessages()
+    , mPendingMessagesMutex()
+    , mPendingMessagesAvailable()
+    , mIsStopping(false)
+    , mDeliveryThread()
+{
+    mDeliveryThread = std::thread(&Logger::DeliveryThreadLoop, this);
+
+    // Log full app name, current build info, and today's date
+    Log(std::string(APPLICATION_NAME_WITH_LONG_VERSION), " ", BuildInfo::GetBuildInfo().ToString(), " @ ", Utils::MakeTodayDateString());
+}
+
+Logger::~Logger()
+{
+    {
+        std::scoped_lock lock(mPendingMessagesMutex);
+
+        mIsStopping = true;
+    }
+
+    mPendingMessagesAvailable.notify_one();
+
+    mDeliveryThread.join();
+}
+
+void Logger::DeliveryThreadLoop()
+{
+    while (true)
+    {
+        {
+            std::unique_lock lock(mPendingMessagesMutex);
+
+            mPendingMessagesAvailable.wait(
+                lock,
+                [this]()
+                {
+                    return !mPendingMessages.empty() || mIsStopping;
+                });
+
+            if (mPendingMessages.empty() && mIsStopping)
+            {
+                // All delivered, we're done
+                break;
+            }
+        }
+
+        std::scoped_lock lock(mDeliveryMutex);
+
+        DeliverPendingMessages();
+    }
+}
+
+void Logger::DeliverPendingMessages()
+{
+    {
+        std::scoped_lock lock(mPendingMessagesMutex);
+
+        assert(mDeliveringMessages.empty());
+        std::swap(mPendingMessages, mDeliveringMessages);
+    }
+
+    for (std::string & message : mDeliveringMessages)
+    {
+        // Publish
+        if (!!mCurrentListener)
+        {
+            mCurrentListener(message);
+        }
+
+        // Output to stdout
+        std::cout << message << '\n';
+
+#ifdef _DEBUG
+        LogToDebugStream(message);
+#endif
+
+        // Store
+        mStoredMessages.push_back(std::move(message));
+        if (mStoredMessages.size() > MaxStoredMessages)
+        {
+            mStoredMessages.pop_front();
+        }
+    }
+
+    std::cout.flush();
+
+    mDeliveringMessages.clear();
+}
+
 void Logger::LogToDebugStream(std::string const & message)
 {
 #if FS_IS_OS_WINDOWS()
@@ -11,6 +11,7 @@
 
 #include <cassert>
 #include <chrono>
+#include <condition_variable>
 #include <ctime>
 #include <deque>
 #include <filesystem>
@@ -21,6 +22,8 @@
 #include <mutex>
 #include <sstream>
 #include <string>
+#include <thread>
+#include <vector>
 
 namespace /* anonymous */ {
 
@@ -51,18 +54,20 @@ namespace /* anonymous */ {
 
 }
 
+/*
+ * The logger.
+ *
+ * Messages are formatted on the logging thread, but they are stored, published to the
+ * listener, and written to stdout by a delivery thread; this way logging from hot paths
+ * only costs formatting and a queue push under a short-lived lock.
+ */
 class Logger
 {
 public:
 
-	Logger()
-		: mCurrentListener()
-		, mStoredMessages()
-        , mMutex()
-	{
-        // Log full app name, current build info, and today's date
-        Log(std::string(APPLICATION_NAME_WITH_LONG_VERSION), " ", BuildInfo::GetBuildInfo().ToString(), " @ ", Utils::MakeTodayDateString());
-	}
+	Logger();
+
+	~Logger();
 
 	Logger(Logger const &) = delete;
 	Logger(Logger &&) = delete;
@@ -75,7 +80,10 @@ public:
         // any given moment in time, so we're catching ill-conceived attempts here
 		assert(!mCurrentListener);
 
-        std::scoped_lock lock(mMutex);
+        std::scoped_lock lock(mDeliveryMutex);
+
+        // Flush whatever is still in flight, so that the listener sees everything in order
+        DeliverPendingMessages();
 
         // Register listener
         mCurrentListener = std::move(listener);
@@ -89,12 +97,10 @@ public:
 
 	void UnregisterListener()
 	{
-        if (!!mCurrentListener)
-        {
-            std::scoped_lock lock(mMutex);
+        // Once we hold the lock, the delivery thread can't be invoking the listener
+        std::scoped_lock lock(mDeliveryMutex);
 
-            mCurrentListener = {};
-        }
+        mCurrentListener = {};
 	}
 
 	template<typename...TArgs>
@@ -112,31 +118,14 @@ public:
 
 		_LogToStream(ss, std::forward<TArgs>(args)...);
 
-		std::string const & message = ss.str();
-
-		// Store and publish
+		// Queue for delivery
         {
-            std::scoped_lock lock(mMutex);
+            std::scoped_lock lock(mPendingMessagesMutex);
 
-            mStoredMessages.push_back(message);
-            if (mStoredMessages.size() > MaxStoredMessages)
-            {
-                mStoredMessages.pop_front();
-            }
-
-            // Publish
-            if (!!mCurrentListener)
-            {
-                mCurrentListener(message);
-            }
+            mPendingMessages.emplace_back(ss.str());
         }
 
-        // Output to stdout
-        std::cout << message << std::endl;
-
-#ifdef _DEBUG
-        LogToDebugStream(message);
-#endif
+        mPendingMessagesAvailable.notify_one();
 	}
 
     template<typename...TArgs>
@@ -154,7 +143,10 @@ public:
         std::ofstream outputFile(logFilePath, std::ios_base::out | std::ios_base::trunc);
 
         {
-            std::scoped_lock lock(mMutex);
+            std::scoped_lock lock(mDeliveryMutex);
+
+            // Make sure we also get the messages that are still in flight
+            DeliverPendingMessages();
 
             for (auto const & s : mStoredMessages)
             {
@@ -168,6 +160,11 @@ public:
 
 private:
 
+    void DeliveryThreadLoop();
+
+    // Must be invoked while holding the delivery mutex
+    void DeliverPendingMessages();
+
     void LogToDebugStream(std::string const & message);
 
 public:
@@ -183,8 +180,19 @@ private:
 	std::deque<std::string> mStoredMessages;
 	static constexpr size_t MaxStoredMessages = 1000;
 
-    // The mutex for multi-threaded access
-    std::mutex mMutex;
+    // Guards the listener and the stored messages, and serializes delivery
+    std::mutex mDeliveryMutex;
+
+    // The messages logged and not yet delivered, and those being delivered
+    std::vector<std::string> mPendingMessages;
+    std::vector<std::string> mDeliveringMessages;
+
+    // Guards the pending messages and the delivery thread's lifecycle
+    std::mutex mPendingMessagesMutex;
+    std::condition_variable mPendingMessagesAvailable;
+    bool mIsStopping;
+
+    std::thread mDeliveryThread;
 };
 
 //
@@ -6,6 +6,7 @@
 #pragma once
 
 #include "GameMath.h"
+#include "SysSpecifics.h"
 
 #include <array>
 #include <cassert>
@@ -139,6 +140,24 @@ public:
             + mSamples[sampleIndexI].SampleValuePlusOneMinusSampleValue * sampleIndexDx;
     }
 
+    /*
+     * Batch version of GetLinearlyInterpolatedPeriodic(): evaluates each of the count
+     * specified values, yielding exactly the same results as the scalar version.
+     *
+     * Keeping the lookups in a tight loop of their own lets the compiler vectorize
+     * the index arithmetic, leaving the gathers as the only scalar part.
+     */
+    inline void GetLinearlyInterpolatedPeriodic(
+        float const * restrict x,
+        float * restrict out,
+        size_t count) const
+    {
+        for (size_t i = 0; i < count; ++i)
+        {
+            out[i] = GetLinearlyInterpolatedPeriodic(x[i]);
+        }
+    }
+
 private:
 
     void PopulateSamples(std::function<float(float)> calculator)
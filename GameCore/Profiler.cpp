@@ -0,0 +1,147 @@
+/***************************************************************************************
+* Original Author:      Gabriele Giuseppini
+* Created:              2026-10-14
+* Copyright:            Gabriele Giuseppini  (https://github.com/GabrieleGiuseppini)
+***************************************************************************************/
+#include "Profiler.h"
+
+#include "Utils.h"
+
+#include <picojson.h>
+
+#include <algorithm>
+#include <limits>
+
+void Profiler::SetCurrentThreadName(std::string name)
+{
+    ThreadProfile & threadProfile = GetThisThreadProfile();
+
+    std::lock_guard<std::mutex> lock(mThreadProfilesLock);
+
+    threadProfile.Name = std::move(name);
+}
+
+void Profiler::Clear()
+{
+    std::lock_guard<std::mutex> lock(mThreadProfilesLock);
+
+    for (auto const & threadProfile : mThreadProfiles)
+    {
+        threadProfile->ClearCount.store(
+            threadProfile->WriteCount.load(std::memory_order_acquire),
+            std::memory_order_relaxed);
+    }
+}
+
+std::vector<Profiler::ZoneSample> Profiler::GetSamples() const
+{
+    std::vector<ZoneSample> samples;
+
+    std::lock_guard<std::mutex> lock(mThreadProfilesLock);
+
+    for (auto const & threadProfile : mThreadProfiles)
+    {
+        std::uint64_t const writeCount = threadProfile->WriteCount.load(std::memory_order_acquire);
+        std::uint64_t const startCount = std::max(
+            threadProfile->ClearCount.load(std::memory_order_relaxed),
+            writeCount > RingBufferSize ? writeCount - RingBufferSize : 0);
+
+        size_t const firstSampleIndex = samples.size();
+
+        for (std::uint64_t i = startCount; i < writeCount; ++i)
+        {
+            auto const & e = (*threadProfile->Events)[i & (RingBufferSize - 1)];
+            samples.push_back({
+                e.Name.load(std::memory_order_relaxed),
+                e.StartTicks.load(std::memory_order_relaxed),
+                e.EndTicks.load(std::memory_order_relaxed),
+                e.Depth.load(std::memory_order_relaxed),
+                threadProfile->ThreadId });
+        }
+
+        // The writer might have lapped us while we were copying; discard the
+        // events that might have been overwritten meanwhile
+        std::atomic_thread_fence(std::memory_order_acquire);
+        std::uint64_t const newWriteCount = threadProfile->WriteCount.load(std::memory_order_relaxed);
+        if (newWriteCount > RingBufferSize + startCount)
+        {
+            std::uint64_t const overwrittenCount = std::min(
+                newWriteCount - RingBufferSize - startCount,
+                writeCount - startCount);
+
+            samples.erase(
+                samples.begin() + firstSampleIndex,
+                samples.begin() + firstSampleIndex + static_cast<size_t>(overwrittenCount));
+        }
+    }
+
+    return samples;
+}
+
+void Profiler::ExportChromeTrace(
+    std::vector<ZoneSample> const & samples,
+    std::filesystem::path const & filePath) const
+{
+    // Timestamps are exported relative to the earliest zone
+    std::int64_t originTicks = std::numeric_limits<std::int64_t>::max();
+    for (auto const & sample : samples)
+    {
+        originTicks = std::min(originTicks, sample.StartTicks);
+    }
+
+    picojson::array traceEvents;
+
+    {
+        std::lock_guard<std::mutex> lock(mThreadProfilesLock);
+
+        for (auto const & threadProfile : mThreadProfiles)
+        {
+            picojson::object args;
+            args["name"] = picojson::value(threadProfile->Name);
+
+            picojson::object traceEvent;
+            traceEvent["name"] = picojson::value("thread_name");
+            traceEvent["ph"] = picojson::value("M");
+            traceEvent["pid"] = picojson::value(1.0);
+            traceEvent["tid"] = picojson::value(static_cast<double>(threadProfile->ThreadId));
+            traceEvent["args"] = picojson::value(args);
+
+            traceEvents.emplace_back(traceEvent);
+        }
+    }
+
+    for (auto const & sample : samples)
+    {
+        picojson::object traceEvent;
+        traceEvent["name"] = picojson::value(sample.Name);
+        traceEvent["ph"] = picojson::value("X");
+        traceEvent["ts"] = picojson::value(static_cast<double>(sample.StartTicks - originTicks) / 1000.0);
+        traceEvent["dur"] = picojson::value(static_cast<double>(sample.EndTicks - sample.StartTicks) / 1000.0);
+        traceEvent["pid"] = picojson::value(1.0);
+        traceEvent["tid"] = picojson::value(static_cast<double>(sample.ThreadId));
+
+        traceEvents.emplace_back(traceEvent);
+    }
+
+    picojson::object root;
+    root["traceEvents"] = picojson::value(traceEvents);
+    root["displayTimeUnit"] = picojson::value("ms");
+
+    Utils::SaveJSONFile(
+        picojson::value(root),
+        filePath);
+}
+
+Profiler::ThreadProfile & Profiler::RegisterThisThread()
+{
+    std::lock_guard<std::mutex> lock(mThreadProfilesLock);
+
+    std::uint32_t const threadId = static_cast<std::uint32_t>(mThreadProfiles.size());
+
+    mThreadProfiles.emplace_back(
+        std::make_unique<ThreadProfile>(
+            threadId,
+            "Thread " + std::to_string(threadId)));
+
+    return *(mThreadProfiles.back());
+}
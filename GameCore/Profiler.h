@@ -0,0 +1,238 @@
+/***************************************************************************************
+* Original Author:      Gabriele Giuseppini
+* Created:              2026-10-14
+* Copyright:            Gabriele Giuseppini  (https://github.com/GabrieleGiuseppini)
+***************************************************************************************/
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+/*
+ * A hierarchical profiler of scoped zones.
+ *
+ * Each thread - including the task thread pool's workers - records the zones it
+ * completes into its own lock-free ring buffer, which only that thread writes to;
+ * when the buffer is full, the oldest zones are overwritten. Zones nest naturally
+ * following the scopes in which they are opened.
+ *
+ * Recording is off by default, and when off a zone costs a single relaxed load.
+ * The recorded zones may be exported at any moment - from any thread - as a
+ * Chrome trace JSON file, which may be loaded in chrome://tracing or in Perfetto.
+ */
+class Profiler final
+{
+private:
+
+    struct ThreadProfile;
+
+public:
+
+    /*
+     * The zone of a scope; the name must be a string with static storage
+     * duration, e.g. a string literal.
+     */
+    class Scope final
+    {
+    public:
+
+        explicit Scope(char const * name) noexcept;
+
+        ~Scope();
+
+        Scope(Scope const &) = delete;
+        Scope & operator=(Scope const &) = delete;
+
+    private:
+
+        ThreadProfile * mThreadProfile;
+        char const * mName;
+        std::int64_t mStartTicks;
+        std::uint32_t mDepth;
+    };
+
+    struct ZoneSample
+    {
+        char const * Name;
+        std::int64_t StartTicks; // Nanoseconds
+        std::int64_t EndTicks; // Nanoseconds
+        std::uint32_t Depth;
+        std::uint32_t ThreadId;
+    };
+
+public:
+
+    static Profiler & GetInstance()
+    {
+        static Profiler * instance = new Profiler();
+
+        return *instance;
+    }
+
+    bool IsEnabled() const noexcept
+    {
+        return mIsEnabled.load(std::memory_order_relaxed);
+    }
+
+    void SetEnabled(bool isEnabled) noexcept
+    {
+        mIsEnabled.store(isEnabled, std::memory_order_relaxed);
+    }
+
+    /*
+     * Sets the name under which the zones of the current thread are exported.
+     */
+    void SetCurrentThreadName(std::string name);
+
+    /*
+     * Discards all zones recorded so far.
+     */
+    void Clear();
+
+    /*
+     * Returns all zones currently held in the buffers, grouped by thread and,
+     * for each thread, in order of completion.
+     */
+    std::vector<ZoneSample> GetSamples() const;
+
+    void ExportChromeTrace(std::filesystem::path const & filePath) const
+    {
+        ExportChromeTrace(GetSamples(), filePath);
+    }
+
+    /*
+     * Exports the specified zones, e.g. zones accumulated over multiple GetSamples()
+     * invocations.
+     */
+    void ExportChromeTrace(
+        std::vector<ZoneSample> const & samples,
+        std::filesystem::path const & filePath) const;
+
+private:
+
+    // The number of zones retained for each thread
+    static size_t constexpr RingBufferSize = 65536; // Must be a power of two
+
+    struct ThreadProfile
+    {
+        // Written using relaxed atomics, so that readers may copy them concurrently
+        // with the writer and discard those that have been overwritten meanwhile
+        struct Event
+        {
+            std::atomic<char const *> Name;
+            std::atomic<std::int64_t> StartTicks;
+            std::atomic<std::int64_t> EndTicks;
+            std::atomic<std::uint32_t> Depth;
+        };
+
+        std::uint32_t const ThreadId;
+        std::string Name; // Protected by the profiler's lock
+
+        std::uint32_t CurrentDepth; // Owner only
+
+        std::atomic<std::uint64_t> WriteCount;
+        std::atomic<std::uint64_t> ClearCount; // WriteCount at the moment of the last Clear()
+
+        std::unique_ptr<std::array<Event, RingBufferSize>> Events;
+
+        ThreadProfile(
+            std::uint32_t threadId,
+            std::string name)
+            : ThreadId(threadId)
+            , Name(std::move(name))
+            , CurrentDepth(0)
+            , WriteCount(0)
+            , ClearCount(0)
+            , Events(std::make_unique<std::array<Event, RingBufferSize>>())
+        {}
+
+        inline void Record(
+            char const * name,
+            std::int64_t startTicks,
+            std::int64_t endTicks,
+            std::uint32_t depth) noexcept
+        {
+            std::uint64_t const writeCount = WriteCount.load(std::memory_order_relaxed);
+
+            Event & e = (*Events)[writeCount & (RingBufferSize - 1)];
+            e.Name.store(name, std::memory_order_relaxed);
+            e.StartTicks.store(startTicks, std::memory_order_relaxed);
+            e.EndTicks.store(endTicks, std::memory_order_relaxed);
+            e.Depth.store(depth, std::memory_order_relaxed);
+
+            WriteCount.store(writeCount + 1, std::memory_order_release);
+        }
+    };
+
+private:
+
+    Profiler()
+        : mIsEnabled(false)
+        , mThreadProfiles()
+        , mThreadProfilesLock()
+    {}
+
+    static ThreadProfile & GetThisThreadProfile()
+    {
+        if (ThisThreadProfile == nullptr)
+        {
+            ThisThreadProfile = &(GetInstance().RegisterThisThread());
+        }
+
+        return *ThisThreadProfile;
+    }
+
+    ThreadProfile & RegisterThisThread();
+
+    static inline std::int64_t Now() noexcept
+    {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+
+private:
+
+    std::atomic<bool> mIsEnabled;
+
+    // Never shrinks, so that threads may keep pointers to their profiles
+    std::vector<std::unique_ptr<ThreadProfile>> mThreadProfiles;
+    mutable std::mutex mThreadProfilesLock;
+
+    static inline thread_local ThreadProfile * ThisThreadProfile = nullptr;
+};
+
+inline Profiler::Scope::Scope(char const * name) noexcept
+    : mThreadProfile(nullptr)
+{
+    if (Profiler::GetInstance().IsEnabled())
+    {
+        mThreadProfile = &GetThisThreadProfile();
+        mName = name;
+        mDepth = mThreadProfile->CurrentDepth++;
+        mStartTicks = Now();
+    }
+}
+
+inline Profiler::Scope::~Scope()
+{
+    if (mThreadProfile != nullptr)
+    {
+        mThreadProfile->Record(mName, mStartTicks, Now(), mDepth);
+        --(mThreadProfile->CurrentDepth);
+    }
+}
+
+#define FS_PROFILE_SCOPE_CONCAT_INNER(a, b) a##b
+#define FS_PROFILE_SCOPE_CONCAT(a, b) FS_PROFILE_SCOPE_CONCAT_INNER(a, b)
+
+/*
+ * Profiles the rest of the enclosing scope under the specified zone name.
+ */
+#define FS_PROFILE_SCOPE(name) Profiler::Scope FS_PROFILE_SCOPE_CONCAT(_profilerScope, __LINE__)(name)
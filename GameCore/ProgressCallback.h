@@ -28,6 +28,8 @@ enum class ProgressMessageType : std::size_t
 	LoadingShipBuilder,				// "Loading ShipBuilder..."
 	LoadingMaterialPalette,			// "Loading materials palette..."
 	Calibrating,					// "Calibrating game on the computer..."
+	LoadingShip,					// "Loading ship..."
+	BuildingShip,					// "Building ship..."
 	Ready,							// "Ready!"
 
 	_Last = Ready
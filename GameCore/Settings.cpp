@@ -6,13 +6,234 @@
 #include "Settings.h"
 
 #include "Colors.h"
+#include "DeSerializationBuffer.h"
 
+#include <cstring>
+#include <iterator>
 #include <regex>
 
 ///////////////////////////////////////////////////////////////////////////////////////
 
 static std::string const SettingsStreamName = "settings";
 static std::string const SettingsExtension = "json";
+static std::string const BinarySettingsExtension = "fsbin";
+
+namespace /* anonymous */ {
+
+    //
+    // Binary format:
+    //  - Magic (4 bytes)
+    //  - Format version (uint16)
+    //  - Header size (uint32)
+    //  - Header: game version (string), description (string)
+    //  - Settings JSON (string)
+    //  - Named stream count (uint32), then for each stream:
+    //      - Stream name (string), extension (string)
+    //      - Encoding (uint8), decoded size (uint32), encoded data (string)
+    //
+
+    char constexpr BinarySettingsMagic[4] = { 'F', 'S', 'S', 'B' };
+
+    std::uint16_t constexpr CurrentBinarySettingsFormatVersion = 1;
+
+    size_t constexpr BinarySettingsPreambleSize = sizeof(BinarySettingsMagic) + sizeof(std::uint16_t) + sizeof(std::uint32_t);
+
+    enum class NamedStreamEncoding : std::uint8_t
+    {
+        Raw = 0,
+        Compressed = 1
+    };
+
+    template<typename T>
+    size_t ReadChecked(
+        DeSerializationBuffer<BigEndianess> const & buffer,
+        size_t index,
+        T & value)
+    {
+        if constexpr (std::is_same_v<T, std::string>)
+        {
+            std::uint32_t length;
+            ReadChecked(buffer, index, length);
+            if (index + sizeof(std::uint32_t) + length > buffer.GetSize())
+            {
+                throw GameException("Binary settings file is truncated");
+            }
+        }
+        else
+        {
+            if (index + sizeof(T) > buffer.GetSize())
+            {
+                throw GameException("Binary settings file is truncated");
+            }
+        }
+
+        return buffer.ReadAt<T>(index, value);
+    }
+
+    DeSerializationBuffer<BigEndianess> ReadFromStream(
+        std::istream & is,
+        size_t size)
+    {
+        DeSerializationBuffer<BigEndianess> buffer(size + 1);
+        is.read(reinterpret_cast<char *>(buffer.Receive(size)), size);
+        if (static_cast<size_t>(is.gcount()) != size)
+        {
+            throw GameException("Binary settings file is truncated");
+        }
+
+        return buffer;
+    }
+
+    /*
+     * Returns the size of the header, after checking the preamble.
+     */
+    std::uint32_t ReadBinarySettingsPreamble(DeSerializationBuffer<BigEndianess> const & buffer)
+    {
+        if (buffer.GetSize() < BinarySettingsPreambleSize
+            || std::memcmp(buffer.GetData(), BinarySettingsMagic, sizeof(BinarySettingsMagic)) != 0)
+        {
+            throw GameException("File is not a binary settings file");
+        }
+
+        size_t readOffset = sizeof(BinarySettingsMagic);
+
+        std::uint16_t formatVersion;
+        readOffset += ReadChecked(buffer, readOffset, formatVersion);
+        if (formatVersion > CurrentBinarySettingsFormatVersion)
+        {
+            throw GameException("Binary settings file has been created with a newer version of the game");
+        }
+
+        std::uint32_t headerSize;
+        ReadChecked(buffer, readOffset, headerSize);
+
+        return headerSize;
+    }
+
+    /*
+     * Compresses a named stream.
+     *
+     * Each byte is first XOR'ed with the byte one four-byte word earlier, and bytes are
+     * regrouped by their position in the word; for slowly-varying numeric data - such as
+     * the ocean floor terrain - this leaves long runs of zeroes, which are then
+     * run-length encoded.
+     */
+    std::string CompressNamedStream(std::string const & data)
+    {
+        size_t constexpr WordSize = 4;
+        size_t const wordCount = data.size() / WordSize;
+
+        std::string planes(data.size(), '\0');
+        for (size_t b = 0; b < WordSize; ++b)
+        {
+            char previous = 0;
+            for (size_t w = 0; w < wordCount; ++w)
+            {
+                char const current = data[w * WordSize + b];
+                planes[b * wordCount + w] = static_cast<char>(current ^ previous);
+                previous = current;
+            }
+        }
+
+        std::copy(data.cbegin() + wordCount * WordSize, data.cend(), planes.begin() + wordCount * WordSize);
+
+        //
+        // Run-length encode: a control byte c <= 127 is followed by c + 1 literal bytes,
+        // while a control byte c >= 129 is followed by a byte to be repeated 257 - c times
+        //
+
+        std::string encoded;
+        encoded.reserve(planes.size() / 2);
+
+        size_t i = 0;
+        while (i < planes.size())
+        {
+            size_t runLength = 1;
+            while (i + runLength < planes.size() && runLength < 128 && planes[i + runLength] == planes[i])
+            {
+                ++runLength;
+            }
+
+            if (runLength >= 3)
+            {
+                encoded.push_back(static_cast<char>(257 - runLength));
+                encoded.push_back(planes[i]);
+                i += runLength;
+            }
+            else
+            {
+                // Literal, until the next run of at least three bytes
+                size_t const literalStart = i;
+                while (i < planes.size() && i - literalStart < 128)
+                {
+                    if (i + 2 < planes.size() && planes[i] == planes[i + 1] && planes[i] == planes[i + 2])
+                        break;
+
+                    ++i;
+                }
+
+                encoded.push_back(static_cast<char>(i - literalStart - 1));
+                encoded.append(planes, literalStart, i - literalStart);
+            }
+        }
+
+        return encoded;
+    }
+
+    std::string DecompressNamedStream(
+        std::string const & encoded,
+        size_t decodedSize)
+    {
+        std::string planes;
+        planes.reserve(decodedSize);
+
+        for (size_t i = 0; i < encoded.size(); )
+        {
+            std::uint8_t const control = static_cast<std::uint8_t>(encoded[i++]);
+            if (control <= 127)
+            {
+                size_t const literalLength = static_cast<size_t>(control) + 1;
+                if (i + literalLength > encoded.size())
+                    throw GameException("Binary settings file contains a corrupted stream");
+
+                planes.append(encoded, i, literalLength);
+                i += literalLength;
+            }
+            else
+            {
+                if (control == 128 || i >= encoded.size())
+                    throw GameException("Binary settings file contains a corrupted stream");
+
+                planes.append(257 - static_cast<size_t>(control), encoded[i++]);
+            }
+
+            if (planes.size() > decodedSize)
+                throw GameException("Binary settings file contains a corrupted stream");
+        }
+
+        if (planes.size() != decodedSize)
+            throw GameException("Binary settings file contains a corrupted stream");
+
+        size_t constexpr WordSize = 4;
+        size_t const wordCount = decodedSize / WordSize;
+
+        std::string data(decodedSize, '\0');
+        for (size_t b = 0; b < WordSize; ++b)
+        {
+            char previous = 0;
+            for (size_t w = 0; w < wordCount; ++w)
+            {
+                char const current = static_cast<char>(planes[b * wordCount + w] ^ previous);
+                data[w * WordSize + b] = current;
+                previous = current;
+            }
+        }
+
+        std::copy(planes.cbegin() + wordCount * WordSize, planes.cend(), data.begin() + wordCount * WordSize);
+
+        return data;
+    }
+}
 
 SettingsStorage::SettingsStorage(
     std::filesystem::path const & rootSystemSettingsDirectoryPath,
@@ -45,12 +266,8 @@ std::vector<PersistedSettingsMetadata> SettingsStorage::ListSettings() const
 
 bool SettingsStorage::HasSettings(PersistedSettingsKey const & settingsKey) const
 {
-    auto const settingsFilePath = MakeFilePath(
-        settingsKey,
-        SettingsStreamName,
-        SettingsExtension);
-
-    return mFileSystem->Exists(settingsFilePath);
+    return mFileSystem->Exists(MakeFilePath(settingsKey, SettingsStreamName, SettingsExtension))
+        || mFileSystem->Exists(MakeFilePath(settingsKey, SettingsStreamName, BinarySettingsExtension));
 }
 
 void SettingsStorage::Delete(PersistedSettingsKey const & settingsKey)
@@ -94,7 +311,8 @@ void SettingsStorage::ListSettings(
 	PersistedSettingsStorageTypes storageType,
     std::vector<PersistedSettingsMetadata> & outPersistedSettingsMetadata) const
 {
-    static std::regex const SettingsFilenameRegex("^([^\\.]+)\\." + SettingsStreamName + "\\." + SettingsExtension + "$");
+    static std::regex const SettingsFilenameRegex(
+        "^([^\\.]+)\\." + SettingsStreamName + "\\.(" + SettingsExtension + "|" + BinarySettingsExtension + ")$");
 
     std::smatch filenameMatch;
     for (auto const & filepath : mFileSystem->ListFiles(directoryPath))
@@ -109,26 +327,18 @@ void SettingsStorage::ListSettings(
                 //
 
                 // Extract name
-                assert(filenameMatch.size() == 2);
+                assert(filenameMatch.size() == 3);
                 std::string settingsName = filenameMatch[1].str();
 
                 // Extract description
-
-                auto is = mFileSystem->OpenInputStream(filepath);
-                auto settingsValue = Utils::ParseJSONStream(*is);
-                if (!settingsValue.is<picojson::object>())
-                {
-                    throw GameException("JSON settings could not be loaded: root value is not an object");
-                }
-
-                auto const & description = Utils::GetMandatoryJsonMember<std::string>(
-                    settingsValue.get<picojson::object>(),
-                    "description");
+                std::string description = (filenameMatch[2].str() == BinarySettingsExtension)
+                    ? ReadBinarySettingsDescription(filepath)
+                    : ReadJsonSettingsDescription(filepath);
 
                 // Store entry
                 outPersistedSettingsMetadata.emplace_back(
                     PersistedSettingsKey(settingsName, storageType),
-                    description);
+                    std::move(description));
             }
         }
         catch (std::exception const & exc)
@@ -139,6 +349,40 @@ void SettingsStorage::ListSettings(
     }
 }
 
+std::string SettingsStorage::ReadJsonSettingsDescription(std::filesystem::path const & filePath) const
+{
+    auto is = mFileSystem->OpenInputStream(filePath);
+    auto settingsValue = Utils::ParseJSONStream(*is);
+    if (!settingsValue.is<picojson::object>())
+    {
+        throw GameException("JSON settings could not be loaded: root value is not an object");
+    }
+
+    return Utils::GetMandatoryJsonMember<std::string>(
+        settingsValue.get<picojson::object>(),
+        "description");
+}
+
+std::string SettingsStorage::ReadBinarySettingsDescription(std::filesystem::path const & filePath) const
+{
+    // Only read the header
+    auto is = mFileSystem->OpenInputStream(filePath);
+
+    std::uint32_t const headerSize = ReadBinarySettingsPreamble(ReadFromStream(*is, BinarySettingsPreambleSize));
+
+    auto const headerBuffer = ReadFromStream(*is, headerSize);
+
+    size_t readOffset = 0;
+
+    std::string version;
+    readOffset += ReadChecked(headerBuffer, readOffset, version);
+
+    std::string description;
+    ReadChecked(headerBuffer, readOffset, description);
+
+    return description;
+}
+
 std::filesystem::path SettingsStorage::MakeFilePath(
     PersistedSettingsKey const & settingsKey,
     std::string const & streamName,
@@ -167,10 +411,13 @@ std::filesystem::path SettingsStorage::GetRootPath(PersistedSettingsStorageTypes
 SettingsSerializationContext::SettingsSerializationContext(
     PersistedSettingsKey const & settingsKey,
     std::string const & description,
-    SettingsStorage & storage)
+    SettingsStorage & storage,
+    PersistedSettingsFormats format)
     : mSettingsKey(settingsKey)
     , mStorage(storage)
+    , mFormat(format)
     , mSettingsJson()
+    , mNamedStreams()
 {
     // Delete all files for this settings name
     mStorage.Delete(mSettingsKey);
@@ -186,9 +433,44 @@ SettingsSerializationContext::SettingsSerializationContext(
 SettingsSerializationContext::~SettingsSerializationContext()
 {
     //
-    // Complete serialization: serialize json settings
+    // Complete serialization
     //
 
+    switch (mFormat)
+    {
+        case PersistedSettingsFormats::Json:
+        {
+            SerializeJson();
+            break;
+        }
+
+        case PersistedSettingsFormats::Binary:
+        {
+            SerializeBinary();
+            break;
+        }
+    }
+}
+
+std::shared_ptr<std::ostream> SettingsSerializationContext::GetNamedStream(
+    std::string const & streamName,
+    std::string const & extension)
+{
+    if (mFormat == PersistedSettingsFormats::Json)
+    {
+        return mStorage.OpenOutputStream(mSettingsKey, streamName, extension);
+    }
+    else
+    {
+        // Buffer it, it will be embedded in the settings file
+        auto stream = std::make_shared<std::stringstream>(std::ios_base::in | std::ios_base::out | std::ios_base::binary);
+        mNamedStreams.push_back({ streamName, extension, stream });
+        return stream;
+    }
+}
+
+void SettingsSerializationContext::SerializeJson()
+{
     std::string const settingsJson = picojson::value(mSettingsJson).serialize(true);
 
     auto os = mStorage.OpenOutputStream(
@@ -199,6 +481,48 @@ SettingsSerializationContext::~SettingsSerializationContext()
     *os << settingsJson;
 }
 
+void SettingsSerializationContext::SerializeBinary()
+{
+    DeSerializationBuffer<BigEndianess> buffer(4096);
+
+    // Preamble
+    buffer.Append(reinterpret_cast<unsigned char const *>(BinarySettingsMagic), sizeof(BinarySettingsMagic));
+    buffer.Append(CurrentBinarySettingsFormatVersion);
+    size_t const headerSizeIndex = buffer.ReserveAndAdvance<std::uint32_t>();
+
+    // Header
+    size_t const headerStart = buffer.GetSize();
+    buffer.Append(mSettingsJson["version"].get<std::string>());
+    buffer.Append(mSettingsJson["description"].get<std::string>());
+    buffer.WriteAt(static_cast<std::uint32_t>(buffer.GetSize() - headerStart), headerSizeIndex);
+
+    // Settings
+    buffer.Append(picojson::value(*mSettingsRoot).serialize(false));
+
+    // Named streams
+    buffer.Append(static_cast<std::uint32_t>(mNamedStreams.size()));
+    for (auto const & namedStream : mNamedStreams)
+    {
+        buffer.Append(namedStream.StreamName);
+        buffer.Append(namedStream.Extension);
+
+        std::string const data = namedStream.Stream->str();
+        std::string compressedData = CompressNamedStream(data);
+        bool const isCompressed = (compressedData.size() < data.size());
+
+        buffer.Append(static_cast<std::uint8_t>(isCompressed ? NamedStreamEncoding::Compressed : NamedStreamEncoding::Raw));
+        buffer.Append(static_cast<std::uint32_t>(data.size()));
+        buffer.Append(isCompressed ? compressedData : data);
+    }
+
+    auto os = mStorage.OpenOutputStream(
+        mSettingsKey,
+        SettingsStreamName,
+        BinarySettingsExtension);
+
+    os->write(reinterpret_cast<char const *>(buffer.GetData()), buffer.GetSize());
+}
+
 SettingsDeserializationContext::SettingsDeserializationContext(
     PersistedSettingsKey const & settingsKey,
     SettingsStorage const & storage)
@@ -206,6 +530,43 @@ SettingsDeserializationContext::SettingsDeserializationContext(
     , mStorage(storage)
     , mSettingsRoot()
     , mSettingsVersion(Version::CurrentVersion())
+    , mBinaryNamedStreams()
+{
+    // Prefer the binary format
+    if (auto is = mStorage.OpenInputStream(mSettingsKey, SettingsStreamName, BinarySettingsExtension);
+        !!is)
+    {
+        DeserializeBinary(*is);
+    }
+    else
+    {
+        DeserializeJson();
+    }
+}
+
+std::shared_ptr<std::istream> SettingsDeserializationContext::GetNamedStream(
+    std::string const & streamName,
+    std::string const & extension) const
+{
+    if (!mBinaryNamedStreams.has_value())
+    {
+        return mStorage.OpenInputStream(mSettingsKey, streamName, extension);
+    }
+    else
+    {
+        auto const it = mBinaryNamedStreams->find(streamName + "." + extension);
+        if (it == mBinaryNamedStreams->cend())
+        {
+            return std::shared_ptr<std::istream>();
+        }
+
+        return std::make_shared<std::istringstream>(
+            it->second,
+            std::ios_base::in | std::ios_base::binary);
+    }
+}
+
+void SettingsDeserializationContext::DeserializeJson()
 {
     //
     // Load JSON
@@ -249,6 +610,90 @@ SettingsDeserializationContext::SettingsDeserializationContext(
     mSettingsRoot = settingsObject["settings"].get<picojson::object>();
 }
 
+void SettingsDeserializationContext::DeserializeBinary(std::istream & is)
+{
+    std::string const fileContent{ std::istreambuf_iterator<char>(is), std::istreambuf_iterator<char>() };
+
+    DeSerializationBuffer<BigEndianess> buffer(fileContent.size() + 1);
+    buffer.Append(reinterpret_cast<unsigned char const *>(fileContent.data()), fileContent.size());
+
+    //
+    // Header
+    //
+
+    size_t readOffset = BinarySettingsPreambleSize;
+    std::uint32_t const headerSize = ReadBinarySettingsPreamble(buffer);
+
+    std::string version;
+    ReadChecked(buffer, readOffset, version);
+    mSettingsVersion = Version::FromString(version);
+
+    readOffset += headerSize;
+
+    //
+    // Settings
+    //
+
+    std::string settingsJson;
+    readOffset += ReadChecked(buffer, readOffset, settingsJson);
+
+    auto settingsValue = Utils::ParseJSONString(settingsJson);
+    if (!settingsValue.is<picojson::object>())
+    {
+        throw GameException("Binary settings could not be loaded: settings are not an object");
+    }
+
+    mSettingsRoot = settingsValue.get<picojson::object>();
+
+    //
+    // Named streams
+    //
+
+    mBinaryNamedStreams.emplace();
+
+    std::uint32_t streamCount;
+    readOffset += ReadChecked(buffer, readOffset, streamCount);
+
+    for (std::uint32_t s = 0; s < streamCount; ++s)
+    {
+        std::string streamName;
+        readOffset += ReadChecked(buffer, readOffset, streamName);
+
+        std::string extension;
+        readOffset += ReadChecked(buffer, readOffset, extension);
+
+        std::uint8_t encoding;
+        readOffset += ReadChecked(buffer, readOffset, encoding);
+
+        std::uint32_t decodedSize;
+        readOffset += ReadChecked(buffer, readOffset, decodedSize);
+
+        std::string data;
+        readOffset += ReadChecked(buffer, readOffset, data);
+
+        switch (static_cast<NamedStreamEncoding>(encoding))
+        {
+            case NamedStreamEncoding::Raw:
+            {
+                break;
+            }
+
+            case NamedStreamEncoding::Compressed:
+            {
+                data = DecompressNamedStream(data, decodedSize);
+                break;
+            }
+
+            default:
+            {
+                throw GameException("Binary settings file contains a stream with an unrecognized encoding");
+            }
+        }
+
+        (*mBinaryNamedStreams)[streamName + "." + extension] = std::move(data);
+    }
+}
+
 ///////////////////////////////////////////////////////////////////////////////////////
 // Specializations for common types
 ///////////////////////////////////////////////////////////////////////////////////////
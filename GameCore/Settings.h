@@ -17,8 +17,10 @@
 #include <chrono>
 #include <functional>
 #include <iostream>
+#include <map>
 #include <memory>
 #include <optional>
+#include <sstream>
 #include <typeinfo>
 #include <type_traits>
 #include <utility>
@@ -32,10 +34,14 @@
 //
 // De/Serialization: interface between settings and the de/serialization storage.
 //
-// For each persisted setting, we have the following files:
+// For each persisted setting, we have - in the JSON format - the following files:
 // - "<Name>.settings.json", one and only one
 // - "<Name>.<StreamName>.<Extension>", zero or more
 //
+// or - in the binary format - a single "<Name>.settings.fsbin" file, whose header
+// may be read without reading the rest of the file, and which embeds the named
+// streams, compressed.
+//
 ///////////////////////////////////////////////////////////////////////////////////////
 
 enum class PersistedSettingsStorageTypes
@@ -44,6 +50,12 @@ enum class PersistedSettingsStorageTypes
     User
 };
 
+enum class PersistedSettingsFormats
+{
+    Json,
+    Binary
+};
+
 /*
  * The identifier of settings that have been/are going to be persisted.
  */
@@ -147,6 +159,10 @@ private:
 		PersistedSettingsStorageTypes storageType,
         std::vector<PersistedSettingsMetadata> & outPersistedSettingsMetadata) const;
 
+    std::string ReadJsonSettingsDescription(std::filesystem::path const & filePath) const;
+
+    std::string ReadBinarySettingsDescription(std::filesystem::path const & filePath) const;
+
     std::filesystem::path MakeFilePath(
         PersistedSettingsKey const & settingsKey,
         std::string const & streamName,
@@ -165,17 +181,20 @@ public:
 
     SettingsSerializationContext(
         PersistedSettingsMetadata const & settingsMetadata,
-        SettingsStorage & storage)
+        SettingsStorage & storage,
+        PersistedSettingsFormats format = PersistedSettingsFormats::Json)
         : SettingsSerializationContext(
             settingsMetadata.Key,
             settingsMetadata.Description,
-            storage)
+            storage,
+            format)
     {}
 
     SettingsSerializationContext(
         PersistedSettingsKey const & settingsKey,
         std::string const & description,
-        SettingsStorage & storage);
+        SettingsStorage & storage,
+        PersistedSettingsFormats format = PersistedSettingsFormats::Json);
 
     ~SettingsSerializationContext();
 
@@ -186,18 +205,32 @@ public:
 
     std::shared_ptr<std::ostream> GetNamedStream(
         std::string const & streamName,
-        std::string const & extension)
-    {
-        return mStorage.OpenOutputStream(mSettingsKey, streamName, extension);
-    }
+        std::string const & extension);
+
+private:
+
+    void SerializeJson();
+
+    void SerializeBinary();
 
 private:
 
     PersistedSettingsKey const mSettingsKey;
     SettingsStorage & mStorage;
+    PersistedSettingsFormats const mFormat;
 
     picojson::object mSettingsJson;
     picojson::object * mSettingsRoot;
+
+    // Binary format only: the named streams, buffered until the end of serialization
+    struct NamedStream
+    {
+        std::string StreamName;
+        std::string Extension;
+        std::shared_ptr<std::stringstream> Stream;
+    };
+
+    std::vector<NamedStream> mNamedStreams;
 };
 
 class SettingsDeserializationContext final
@@ -218,12 +251,18 @@ public:
         return mSettingsVersion;
     }
 
+    /*
+     * Returns an empty pointer if the stream does not exist.
+     */
     std::shared_ptr<std::istream> GetNamedStream(
         std::string const & streamName,
-        std::string const & extension) const
-    {
-        return mStorage.OpenInputStream(mSettingsKey, streamName, extension);
-    }
+        std::string const & extension) const;
+
+private:
+
+    void DeserializeJson();
+
+    void DeserializeBinary(std::istream & is);
 
 private:
 
@@ -232,6 +271,9 @@ private:
 
     picojson::object mSettingsRoot;
     Version mSettingsVersion;
+
+    // Binary format only: the decoded named streams, keyed by "<StreamName>.<Extension>"
+    std::optional<std::map<std::string, std::string>> mBinaryNamedStreams;
 };
 
 /*
@@ -932,6 +974,15 @@ public:
     // Storage
     //
 
+    /*
+     * Sets the format in which settings are saved from now on; settings
+     * are loaded from whichever format they have been saved in.
+     */
+    void SetPersistedSettingsFormat(PersistedSettingsFormats format)
+    {
+        mPersistedSettingsFormat = format;
+    }
+
     auto ListPersistedSettings() const
     {
         return mStorage.ListSettings();
@@ -964,7 +1015,8 @@ public:
                 name,
 				PersistedSettingsStorageTypes::User),
             description,
-            mStorage);
+            mStorage,
+            mPersistedSettingsFormat);
 
         settings.SerializeDirty(ctx);
     }
@@ -1037,7 +1089,8 @@ public:
 			{
 				SettingsSerializationContext ctx(
 					PersistedSettingsMetadata::MakeLastModifiedSettingsMetadata(),
-					mStorage);
+					mStorage,
+					mPersistedSettingsFormat);
 
 				settings.SerializeDirty(ctx);
 			}
@@ -1089,6 +1142,7 @@ protected:
             rootSystemSettingsDirectoryPath,
             rootUserSettingsDirectoryPath,
             std::move(fileSystem))
+        , mPersistedSettingsFormat(PersistedSettingsFormats::Json)
         , mTemplateSettings(std::move(factory.mSettings))
         , mEnforcers(std::move(factory.mEnforcers))
         , mDefaultSettings(mTemplateSettings)
@@ -1104,6 +1158,7 @@ private:
 
     // Storage
     SettingsStorage mStorage;
+    PersistedSettingsFormats mPersistedSettingsFormat;
 
     // Templates
     Settings<TEnum> mTemplateSettings;
@@ -0,0 +1,365 @@
+/***************************************************************************************
+* Original Author:      Gabriele Giuseppini
+* Created:              2026-10-14
+* Copyright:            Gabriele Giuseppini  (https://github.com/GabrieleGiuseppini)
+***************************************************************************************/
+#include "SnapshotHistory.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+#include <limits>
+
+// The maximum number of snapshots waiting to be encoded, after which snapshots are dropped;
+// bounds the memory used by snapshots in flight
+static size_t constexpr MaxPendingPushCount = 2;
+
+// Runs of zeroes shorter than this are left within literals, as a token costs this much
+static size_t constexpr MinZeroRunLength = 2 * sizeof(std::uint32_t);
+
+SnapshotHistory::SnapshotHistory(
+    size_t maxByteSize,
+    size_t keyframeInterval)
+    : mKeyframeInterval(std::max(keyframeInterval, size_t(1)))
+    , mMutex()
+    , mFrames()
+    , mMaxByteSize(maxByteSize)
+    , mEncodedByteSize(0)
+    , mReferenceByteSize(0)
+    , mPendingPushCount(0)
+    , mDroppedSnapshotCount(0)
+    , mReferenceData()
+    , mFramesSinceKeyframe(0)
+    , mEncodingThread(std::make_unique<TaskThread>())
+{
+}
+
+void SnapshotHistory::Push(
+    float simulationTime,
+    StateSnapshot && snapshot)
+{
+    {
+        std::lock_guard const lock{ mMutex };
+
+        if (mPendingPushCount >= MaxPendingPushCount)
+        {
+            ++mDroppedSnapshotCount;
+            return;
+        }
+
+        ++mPendingPushCount;
+    }
+
+    mEncodingThread->QueueTask(
+        [this, simulationTime, snapshot = std::make_shared<StateSnapshot const>(std::move(snapshot))]()
+        {
+            EncodeAndStore(simulationTime, *snapshot);
+
+            std::lock_guard const lock{ mMutex };
+
+            assert(mPendingPushCount > 0);
+            --mPendingPushCount;
+        });
+}
+
+size_t SnapshotHistory::GetFrameCount() const
+{
+    std::lock_guard const lock{ mMutex };
+
+    return mFrames.size();
+}
+
+float SnapshotHistory::GetFrameSimulationTime(size_t frameIndex) const
+{
+    std::lock_guard const lock{ mMutex };
+
+    assert(frameIndex < mFrames.size());
+    return mFrames[frameIndex].SimulationTime;
+}
+
+StateSnapshot SnapshotHistory::DecodeFrame(size_t frameIndex) const
+{
+    //
+    // Collect the frames from the closest keyframe, so that we may
+    // decode them without holding the lock
+    //
+
+    std::vector<std::shared_ptr<std::vector<std::uint8_t> const>> encodedFrames;
+    size_t decodedByteSize;
+
+    {
+        std::lock_guard const lock{ mMutex };
+
+        assert(frameIndex < mFrames.size());
+
+        size_t keyframeIndex = frameIndex;
+        while (!mFrames[keyframeIndex].IsKeyframe)
+        {
+            assert(keyframeIndex > 0); // The oldest frame is always a keyframe
+            --keyframeIndex;
+        }
+
+        for (size_t f = keyframeIndex; f <= frameIndex; ++f)
+        {
+            encodedFrames.push_back(mFrames[f].EncodedData);
+        }
+
+        decodedByteSize = mFrames[frameIndex].DecodedByteSize;
+    }
+
+    std::vector<std::uint8_t> data(decodedByteSize, 0);
+    for (auto const & encodedFrame : encodedFrames)
+    {
+        DecodeInto(*encodedFrame, data);
+    }
+
+    return StateSnapshot(std::move(data));
+}
+
+void SnapshotHistory::TruncateAfter(size_t frameIndex)
+{
+    WaitForPendingPushes();
+
+    std::lock_guard const lock{ mMutex };
+
+    while (mFrames.size() > frameIndex + 1)
+    {
+        mEncodedByteSize -= mFrames.back().EncodedData->size();
+        mFrames.pop_back();
+    }
+
+    // We don't keep the decoded data of the new last frame, hence the next frame is a keyframe
+    mReferenceData.clear();
+    mReferenceByteSize = 0;
+    mFramesSinceKeyframe = 0;
+}
+
+void SnapshotHistory::Clear()
+{
+    WaitForPendingPushes();
+
+    std::lock_guard const lock{ mMutex };
+
+    mFrames.clear();
+    mEncodedByteSize = 0;
+
+    mReferenceData.clear();
+    mReferenceByteSize = 0;
+    mFramesSinceKeyframe = 0;
+}
+
+size_t SnapshotHistory::GetByteSize() const
+{
+    std::lock_guard const lock{ mMutex };
+
+    return CalculateByteSize();
+}
+
+void SnapshotHistory::SetMaxByteSize(size_t maxByteSize)
+{
+    std::lock_guard const lock{ mMutex };
+
+    mMaxByteSize = maxByteSize;
+
+    EnforceMaxByteSize();
+}
+
+size_t SnapshotHistory::GetDroppedSnapshotCount() const
+{
+    std::lock_guard const lock{ mMutex };
+
+    return mDroppedSnapshotCount;
+}
+
+std::vector<std::uint8_t> SnapshotHistory::Encode(
+    std::vector<std::uint8_t> const & data,
+    std::vector<std::uint8_t> const * reference)
+{
+    assert(reference == nullptr || reference->size() == data.size());
+    assert(data.size() <= std::numeric_limits<std::uint32_t>::max());
+
+    std::uint8_t const * const d = data.data();
+    std::uint8_t const * const r = (reference != nullptr) ? reference->data() : nullptr;
+    size_t const n = data.size();
+
+    auto const xorAt = [d, r](size_t i) -> std::uint8_t
+    {
+        return (r != nullptr) ? (d[i] ^ r[i]) : d[i];
+    };
+
+    auto const isZeroWordAt = [d, r](size_t i) -> bool
+    {
+        std::uint64_t dWord;
+        std::memcpy(&dWord, d + i, sizeof(std::uint64_t));
+
+        if (r == nullptr)
+            return dWord == 0;
+
+        std::uint64_t rWord;
+        std::memcpy(&rWord, r + i, sizeof(std::uint64_t));
+        return dWord == rWord;
+    };
+
+    std::vector<std::uint8_t> encodedData;
+
+    auto const appendToken = [&encodedData](std::uint32_t value)
+    {
+        size_t const start = encodedData.size();
+        encodedData.resize(start + sizeof(std::uint32_t));
+        std::memcpy(encodedData.data() + start, &value, sizeof(std::uint32_t));
+    };
+
+    size_t pos = 0;
+    while (pos < n)
+    {
+        //
+        // Zero run
+        //
+
+        size_t const zeroStart = pos;
+
+        while (pos + sizeof(std::uint64_t) <= n && isZeroWordAt(pos))
+            pos += sizeof(std::uint64_t);
+
+        while (pos < n && xorAt(pos) == 0)
+            ++pos;
+
+        size_t const zeroRunLength = pos - zeroStart;
+
+        //
+        // Literal, up to the next zero run that is worth a token
+        //
+
+        size_t const literalStart = pos;
+
+        while (pos < n)
+        {
+            if (xorAt(pos) != 0)
+            {
+                ++pos;
+            }
+            else
+            {
+                size_t z = pos;
+                while (z < n && xorAt(z) == 0 && z - pos < MinZeroRunLength)
+                    ++z;
+
+                if (z - pos >= MinZeroRunLength || z == n)
+                    break;
+
+                pos = z;
+            }
+        }
+
+        size_t const literalLength = pos - literalStart;
+
+        appendToken(static_cast<std::uint32_t>(zeroRunLength));
+        appendToken(static_cast<std::uint32_t>(literalLength));
+
+        size_t const start = encodedData.size();
+        encodedData.resize(start + literalLength);
+        for (size_t i = 0; i < literalLength; ++i)
+        {
+            encodedData[start + i] = xorAt(literalStart + i);
+        }
+    }
+
+    return encodedData;
+}
+
+void SnapshotHistory::DecodeInto(
+    std::vector<std::uint8_t> const & encodedData,
+    std::vector<std::uint8_t> & buffer)
+{
+    size_t inPos = 0;
+    size_t outPos = 0;
+    while (inPos < encodedData.size())
+    {
+        assert(inPos + 2 * sizeof(std::uint32_t) <= encodedData.size());
+
+        std::uint32_t zeroRunLength;
+        std::memcpy(&zeroRunLength, encodedData.data() + inPos, sizeof(std::uint32_t));
+        inPos += sizeof(std::uint32_t);
+
+        std::uint32_t literalLength;
+        std::memcpy(&literalLength, encodedData.data() + inPos, sizeof(std::uint32_t));
+        inPos += sizeof(std::uint32_t);
+
+        outPos += zeroRunLength;
+
+        assert(inPos + literalLength <= encodedData.size());
+        assert(outPos + literalLength <= buffer.size());
+
+        for (size_t i = 0; i < literalLength; ++i)
+        {
+            buffer[outPos + i] ^= encodedData[inPos + i];
+        }
+
+        inPos += literalLength;
+        outPos += literalLength;
+    }
+}
+
+void SnapshotHistory::EncodeAndStore(
+    float simulationTime,
+    StateSnapshot const & snapshot)
+{
+    auto const & data = snapshot.GetData();
+
+    bool const isKeyframe =
+        mReferenceData.size() != data.size() // Includes no reference at all
+        || mFramesSinceKeyframe + 1 >= mKeyframeInterval;
+
+    auto encodedData = std::make_shared<std::vector<std::uint8_t> const>(
+        Encode(data, isKeyframe ? nullptr : &mReferenceData));
+
+    mReferenceData = data;
+    mFramesSinceKeyframe = isKeyframe ? 0 : mFramesSinceKeyframe + 1;
+
+    std::lock_guard const lock{ mMutex };
+
+    mEncodedByteSize += encodedData->size();
+    mReferenceByteSize = mReferenceData.size();
+
+    mFrames.push_back(
+        Frame{
+            simulationTime,
+            isKeyframe,
+            data.size(),
+            std::move(encodedData) });
+
+    EnforceMaxByteSize();
+}
+
+void SnapshotHistory::EnforceMaxByteSize()
+{
+    while (CalculateByteSize() > mMaxByteSize)
+    {
+        // Find the next keyframe, so that we evict the oldest one together with its deltas;
+        // never evict the frames that the newest frame depends on
+        assert(mFrames.empty() || mFrames.front().IsKeyframe);
+
+        size_t nextKeyframeIndex = 1;
+        while (nextKeyframeIndex < mFrames.size() && !mFrames[nextKeyframeIndex].IsKeyframe)
+            ++nextKeyframeIndex;
+
+        if (nextKeyframeIndex >= mFrames.size())
+            break;
+
+        for (size_t f = 0; f < nextKeyframeIndex; ++f)
+        {
+            mEncodedByteSize -= mFrames.front().EncodedData->size();
+            mFrames.pop_front();
+        }
+    }
+}
+
+size_t SnapshotHistory::CalculateByteSize() const
+{
+    return mEncodedByteSize + mReferenceByteSize;
+}
+
+void SnapshotHistory::WaitForPendingPushes() const
+{
+    mEncodingThread->QueueSynchronizationPoint()->Wait();
+}
@@ -0,0 +1,138 @@
+/***************************************************************************************
+* Original Author:      Gabriele Giuseppini
+* Created:              2026-10-14
+* Copyright:            Gabriele Giuseppini  (https://github.com/GabrieleGiuseppini)
+***************************************************************************************/
+#pragma once
+
+#include "StateSnapshot.h"
+#include "TaskThread.h"
+
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+/*
+ * A rolling, memory-bounded history of state snapshots, for scrubbing back in time.
+ *
+ * Every keyframe-interval-th snapshot is stored whole (a keyframe); all the others
+ * are stored as XOR deltas against their predecessor. Both are compressed by
+ * collapsing runs of zero bytes - which is what the bulk of a delta is made of -
+ * on a background thread, hence pushing a snapshot only costs a move.
+ *
+ * When the history exceeds its memory budget, the oldest keyframe is evicted together
+ * with all of its deltas.
+ */
+class SnapshotHistory final
+{
+public:
+
+    SnapshotHistory(
+        size_t maxByteSize,
+        size_t keyframeInterval);
+
+    /*
+     * Queues the snapshot for encoding; the snapshot is dropped if the background thread
+     * is still busy with too many previous snapshots.
+     */
+    void Push(
+        float simulationTime,
+        StateSnapshot && snapshot);
+
+    /*
+     * Frame indices are valid until the next Push(), as frames might be evicted.
+     */
+    size_t GetFrameCount() const;
+
+    float GetFrameSimulationTime(size_t frameIndex) const;
+
+    StateSnapshot DecodeFrame(size_t frameIndex) const;
+
+    /*
+     * Forgets all frames after the specified one, e.g. once the simulation
+     * has been rewound to it.
+     */
+    void TruncateAfter(size_t frameIndex);
+
+    void Clear();
+
+    /*
+     * The number of bytes currently held by the history, including the
+     * reference snapshot kept for encoding the next delta.
+     */
+    size_t GetByteSize() const;
+
+    void SetMaxByteSize(size_t maxByteSize);
+
+    size_t GetDroppedSnapshotCount() const;
+
+    /*
+     * Waits until all the snapshots pushed so far have been stored.
+     */
+    void WaitForPendingPushes() const;
+
+    //
+    // The codec; exposed for testing
+    //
+
+    static std::vector<std::uint8_t> Encode(
+        std::vector<std::uint8_t> const & data,
+        std::vector<std::uint8_t> const * reference); // XOR'd with the data, when specified
+
+    // XOR's the decoded data into the specified buffer; a keyframe is decoded
+    // into a zero-filled buffer
+    static void DecodeInto(
+        std::vector<std::uint8_t> const & encodedData,
+        std::vector<std::uint8_t> & buffer);
+
+private:
+
+    struct Frame
+    {
+        float SimulationTime;
+        bool IsKeyframe;
+        size_t DecodedByteSize;
+        std::shared_ptr<std::vector<std::uint8_t> const> EncodedData;
+    };
+
+    // Runs on the background thread
+    void EncodeAndStore(
+        float simulationTime,
+        StateSnapshot const & snapshot);
+
+    // Must be invoked with the lock held
+    void EnforceMaxByteSize();
+
+    // Must be invoked with the lock held
+    size_t CalculateByteSize() const;
+
+private:
+
+    size_t const mKeyframeInterval;
+
+    std::mutex mutable mMutex;
+
+    //
+    // Guarded by the mutex
+    //
+
+    std::deque<Frame> mFrames;
+    size_t mMaxByteSize;
+    size_t mEncodedByteSize;
+    size_t mReferenceByteSize;
+    size_t mPendingPushCount;
+    size_t mDroppedSnapshotCount;
+
+    //
+    // Only touched by the background thread, or by the main thread after
+    // it has waited for the background thread
+    //
+
+    std::vector<std::uint8_t> mReferenceData; // Decoded data of the last frame; empty when the next frame must be a keyframe
+    size_t mFramesSinceKeyframe;
+
+    // Last, so that it's joined before anything it uses goes away
+    std::unique_ptr<TaskThread> mEncodingThread;
+};
@@ -0,0 +1,146 @@
+/***************************************************************************************
+* Original Author:      Gabriele Giuseppini
+* Created:              2026-10-14
+* Copyright:            Gabriele Giuseppini  (https://github.com/GabrieleGiuseppini)
+***************************************************************************************/
+#pragma once
+
+#include "Buffer2D.h"
+#include "GameTypes.h"
+
+#include <algorithm>
+#include <cassert>
+#include <vector>
+
+/*
+ * A Buffer2D in run-length-encoded form, for buffers that are mostly empty - i.e. whose
+ * elements are mostly equal to the default-constructed element.
+ *
+ * Each row is stored as its runs of non-empty elements, hence the cost of the buffer is
+ * proportional to its occupied elements rather than to its size; iterating it visits the
+ * occupied elements only. The buffer is immutable, and converts to and from its dense
+ * counterpart.
+ */
+template <typename TElement, typename TIntegralTag>
+class SparseBuffer2D
+{
+public:
+
+    using buffer_type = Buffer2D<TElement, TIntegralTag>;
+    using element_type = TElement;
+    using coordinates_type = _IntegralCoordinates<TIntegralTag>;
+    using size_type = _IntegralSize<TIntegralTag>;
+
+public:
+
+    size_type Size;
+
+    explicit SparseBuffer2D(buffer_type const & denseBuffer)
+        : Size(denseBuffer.Size)
+        , mRowFirstRunIndices()
+        , mRuns()
+        , mElements()
+    {
+        TElement const emptyElement = TElement();
+
+        mRowFirstRunIndices.reserve(static_cast<size_t>(Size.height) + 1);
+
+        TElement const * const denseData = denseBuffer.Data.get();
+        for (int y = 0; y < Size.height; ++y)
+        {
+            mRowFirstRunIndices.push_back(mRuns.size());
+
+            TElement const * const denseRow = denseData + static_cast<size_t>(y) * static_cast<size_t>(Size.width);
+            for (int x = 0; x < Size.width; )
+            {
+                if (denseRow[x] == emptyElement)
+                {
+                    ++x;
+                    continue;
+                }
+
+                int const startX = x;
+                for (; x < Size.width && !(denseRow[x] == emptyElement); ++x)
+                {
+                    mElements.push_back(denseRow[x]);
+                }
+
+                mRuns.push_back({ startX, x - startX });
+            }
+        }
+
+        mRowFirstRunIndices.push_back(mRuns.size());
+
+        mRuns.shrink_to_fit();
+        mElements.shrink_to_fit();
+    }
+
+    SparseBuffer2D(SparseBuffer2D && other) = default;
+
+    buffer_type MakeDense() const
+    {
+        buffer_type denseBuffer(Size, TElement());
+
+        TElement * const denseData = denseBuffer.Data.get();
+        TElement const * sourceElement = mElements.data();
+        for (int y = 0; y < Size.height; ++y)
+        {
+            TElement * const denseRow = denseData + static_cast<size_t>(y) * static_cast<size_t>(Size.width);
+            for (size_t r = mRowFirstRunIndices[y]; r < mRowFirstRunIndices[y + 1]; ++r)
+            {
+                Run const & run = mRuns[r];
+                std::copy(sourceElement, sourceElement + run.Length, denseRow + run.StartX);
+                sourceElement += run.Length;
+            }
+        }
+
+        assert(sourceElement == mElements.data() + mElements.size());
+
+        return denseBuffer;
+    }
+
+    size_t GetOccupiedCount() const
+    {
+        return mElements.size();
+    }
+
+    size_t GetByteSize() const
+    {
+        return mRowFirstRunIndices.size() * sizeof(size_t)
+            + mRuns.size() * sizeof(Run)
+            + mElements.size() * sizeof(TElement);
+    }
+
+    /*
+     * Invokes the function with the coordinates and the value of each occupied element,
+     * in row-major order.
+     */
+    template<typename TFunc>
+    void ForEachOccupied(TFunc && func) const // void(coordinates_type const &, TElement const &)
+    {
+        TElement const * sourceElement = mElements.data();
+        for (int y = 0; y < Size.height; ++y)
+        {
+            for (size_t r = mRowFirstRunIndices[y]; r < mRowFirstRunIndices[y + 1]; ++r)
+            {
+                Run const & run = mRuns[r];
+                for (int x = run.StartX; x < run.StartX + run.Length; ++x, ++sourceElement)
+                {
+                    func(coordinates_type(x, y), *sourceElement);
+                }
+            }
+        }
+    }
+
+private:
+
+    struct Run
+    {
+        int StartX;
+        int Length;
+    };
+
+    std::vector<size_t> mRowFirstRunIndices; // One per row, plus sentinel
+    std::vector<Run> mRuns;
+    std::vector<TElement> mElements; // Elements of all runs, in run order
+};
@@ -0,0 +1,426 @@
+/***************************************************************************************
+* Original Author:      Gabriele Giuseppini
+* Created:              2026-10-14
+* Copyright:            Gabriele Giuseppini  (https://github.com/GabrieleGiuseppini)
+***************************************************************************************/
+#pragma once
+
+#include "AABB.h"
+#include "GameTypes.h"
+#include "Vectors.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <limits>
+#include <vector>
+
+/*
+ * This class implements a spatial hash over a uniform grid of square cells,
+ * indexing a set of ElementIndex elements by their positions - or, for segments,
+ * by the cells their bounding boxes overlap.
+ *
+ * The index is a snapshot of the positions at the moment of the last Rebuild();
+ * queries return supersets of the elements within the queried area, hence
+ * callers are expected to check the actual positions of the returned elements.
+ */
+class SpatialHashGrid
+{
+public:
+
+    explicit SpatialHashGrid(float cellSize)
+        : mCellSize(cellSize)
+        , mInverseCellSize(1.0f / cellSize)
+        , mElementCount(0)
+        , mBucketCountMask(0)
+        , mBucketStarts()
+        , mBucketElements()
+        , mElementBuckets()
+        , mOversizedElements()
+        , mRebuildScratch()
+    {
+        assert(cellSize > 0.0f);
+    }
+
+    float GetCellSize() const noexcept
+    {
+        return mCellSize;
+    }
+
+    ElementCount GetElementCount() const noexcept
+    {
+        return mElementCount;
+    }
+
+    /*
+     * Re-indexes the elements [0, elementCount) at the specified positions.
+     */
+    void Rebuild(
+        vec2f const * positions,
+        ElementCount elementCount)
+    {
+        mElementCount = elementCount;
+
+        size_t const bucketCount = PrepareBuckets(elementCount);
+
+        mBucketElements.resize(elementCount);
+        mElementBuckets.resize(elementCount);
+        mOversizedElements.clear();
+
+        //
+        // Counting sort of elements by bucket
+        //
+
+        for (ElementIndex e = 0; e < elementCount; ++e)
+        {
+            size_t const bucket = GetBucket(
+                ToCellCoordinate(positions[e].x),
+                ToCellCoordinate(positions[e].y));
+
+            mElementBuckets[e] = static_cast<std::uint32_t>(bucket);
+            ++mBucketStarts[bucket + 1];
+        }
+
+        for (size_t b = 1; b <= bucketCount; ++b)
+        {
+            mBucketStarts[b] += mBucketStarts[b - 1];
+        }
+
+        // Elements are visited in ascending order, hence each bucket is sorted
+
+        std::vector<ElementIndex> & bucketInsertionPoints = mRebuildScratch;
+        bucketInsertionPoints.assign(mBucketStarts.cbegin(), mBucketStarts.cend() - 1);
+
+        for (ElementIndex e = 0; e < elementCount; ++e)
+        {
+            mBucketElements[bucketInsertionPoints[mElementBuckets[e]]++] = e;
+        }
+    }
+
+    /*
+     * Re-indexes the segments [0, segmentCount), whose endpoints are the positions at the
+     * specified indices; each segment is indexed in all the cells its bounding box overlaps,
+     * and segments overlapping too many cells are returned by all queries.
+     */
+    void RebuildForSegments(
+        ElementIndex const * endpointAIndices,
+        ElementIndex const * endpointBIndices,
+        vec2f const * positions,
+        ElementCount segmentCount)
+    {
+        mElementCount = segmentCount;
+
+        size_t const bucketCount = PrepareBuckets(segmentCount);
+
+        mElementBuckets.clear();
+        mOversizedElements.clear();
+
+        //
+        // Counting sort of segments by bucket, in two passes over their cells
+        //
+
+        auto const visitCells = [&](ElementIndex s, auto && cellVisitor)
+        {
+            vec2f const & a = positions[endpointAIndices[s]];
+            vec2f const & b = positions[endpointBIndices[s]];
+
+            std::int32_t const minCellX = std::min(ToCellCoordinate(a.x), ToCellCoordinate(b.x));
+            std::int32_t const maxCellX = std::max(ToCellCoordinate(a.x), ToCellCoordinate(b.x));
+            std::int32_t const minCellY = std::min(ToCellCoordinate(a.y), ToCellCoordinate(b.y));
+            std::int32_t const maxCellY = std::max(ToCellCoordinate(a.y), ToCellCoordinate(b.y));
+
+            if (maxCellX - minCellX >= MaxSegmentCellSpan
+                || maxCellY - minCellY >= MaxSegmentCellSpan)
+            {
+                return false;
+            }
+
+            for (std::int32_t cellY = minCellY; cellY <= maxCellY; ++cellY)
+            {
+                for (std::int32_t cellX = minCellX; cellX <= maxCellX; ++cellX)
+                {
+                    cellVisitor(GetBucket(cellX, cellY));
+                }
+            }
+
+            return true;
+        };
+
+        for (ElementIndex s = 0; s < segmentCount; ++s)
+        {
+            bool const isIndexed = visitCells(
+                s,
+                [this](size_t bucket)
+                {
+                    ++mBucketStarts[bucket + 1];
+                });
+
+            if (!isIndexed)
+            {
+                mOversizedElements.push_back(s);
+            }
+        }
+
+        for (size_t b = 1; b <= bucketCount; ++b)
+        {
+            mBucketStarts[b] += mBucketStarts[b - 1];
+        }
+
+        mBucketElements.resize(mBucketStarts[bucketCount]);
+
+        // Segments are visited in ascending order, hence each bucket is sorted
+
+        std::vector<ElementIndex> & bucketInsertionPoints = mRebuildScratch;
+        bucketInsertionPoints.assign(mBucketStarts.cbegin(), mBucketStarts.cend() - 1);
+
+        for (ElementIndex s = 0; s < segmentCount; ++s)
+        {
+            visitCells(
+                s,
+                [this, s, &bucketInsertionPoints](size_t bucket)
+                {
+                    mBucketElements[bucketInsertionPoints[bucket]++] = s;
+                });
+        }
+    }
+
+    /*
+     * Populates the specified vector with the indices of all indexed elements that might be
+     * within the specified box, sorted in ascending order and without duplicates.
+     */
+    void Query(
+        Geometry::AABB const & box,
+        std::vector<ElementIndex> & elementIndices) const
+    {
+        elementIndices.clear();
+
+        std::int32_t const minCellX = ToCellCoordinate(box.BottomLeft.x);
+        std::int32_t const maxCellX = ToCellCoordinate(box.TopRight.x);
+        std::int32_t const minCellY = ToCellCoordinate(box.BottomLeft.y);
+        std::int32_t const maxCellY = ToCellCoordinate(box.TopRight.y);
+
+        if (minCellX > maxCellX || minCellY > maxCellY)
+        {
+            // Empty box
+            return;
+        }
+
+        std::uint64_t const cellCount =
+            (static_cast<std::uint64_t>(maxCellX - minCellX) + 1)
+            * (static_cast<std::uint64_t>(maxCellY - minCellY) + 1);
+
+        if (cellCount > static_cast<std::uint64_t>(mBucketCountMask))
+        {
+            // The box covers too many cells to make the index worth it; return all elements
+            elementIndices.reserve(mElementCount);
+            for (ElementIndex e = 0; e < mElementCount; ++e)
+            {
+                elementIndices.push_back(e);
+            }
+
+            return;
+        }
+
+        for (std::int32_t cellY = minCellY; cellY <= maxCellY; ++cellY)
+        {
+            for (std::int32_t cellX = minCellX; cellX <= maxCellX; ++cellX)
+            {
+                size_t const bucket = GetBucket(cellX, cellY);
+
+                elementIndices.insert(
+                    elementIndices.end(),
+                    mBucketElements.cbegin() + mBucketStarts[bucket],
+                    mBucketElements.cbegin() + mBucketStarts[bucket + 1]);
+            }
+        }
+
+        elementIndices.insert(
+            elementIndices.end(),
+            mOversizedElements.cbegin(),
+            mOversizedElements.cend());
+
+        SortAndDeduplicate(elementIndices);
+    }
+
+    /*
+     * Populates the specified vector with the indices of all indexed elements that might be
+     * in the cells crossed by the specified segment, sorted in ascending order and without
+     * duplicates.
+     */
+    void QuerySegment(
+        vec2f const & start,
+        vec2f const & end,
+        std::vector<ElementIndex> & elementIndices) const
+    {
+        elementIndices.clear();
+
+        std::int32_t cellX = ToCellCoordinate(start.x);
+        std::int32_t cellY = ToCellCoordinate(start.y);
+        std::int32_t const endCellX = ToCellCoordinate(end.x);
+        std::int32_t const endCellY = ToCellCoordinate(end.y);
+
+        // A segment crosses exactly this many cells
+        std::uint64_t const cellCount =
+            static_cast<std::uint64_t>(std::abs(static_cast<std::int64_t>(endCellX) - cellX))
+            + static_cast<std::uint64_t>(std::abs(static_cast<std::int64_t>(endCellY) - cellY))
+            + 1;
+
+        if (cellCount > static_cast<std::uint64_t>(mBucketCountMask))
+        {
+            // The segment crosses too many cells to make the index worth it; return all elements
+            elementIndices.reserve(mElementCount);
+            for (ElementIndex e = 0; e < mElementCount; ++e)
+            {
+                elementIndices.push_back(e);
+            }
+
+            return;
+        }
+
+        //
+        // Walk the cells crossed by the segment, one cell boundary at a time
+        //
+
+        vec2f const direction = end - start;
+
+        std::int32_t const stepX = (direction.x >= 0.0f) ? 1 : -1;
+        std::int32_t const stepY = (direction.y >= 0.0f) ? 1 : -1;
+
+        float constexpr Infinity = std::numeric_limits<float>::infinity();
+
+        // The segment parameter at which we cross the next vertical (horizontal) cell
+        // boundary, and the parameter delta between two such boundaries
+        float tMaxX = Infinity;
+        float tDeltaX = Infinity;
+        if (direction.x != 0.0f)
+        {
+            float const nextBoundaryX = static_cast<float>(cellX + (stepX > 0 ? 1 : 0)) * mCellSize;
+            tMaxX = (nextBoundaryX - start.x) / direction.x;
+            tDeltaX = mCellSize / std::abs(direction.x);
+        }
+
+        float tMaxY = Infinity;
+        float tDeltaY = Infinity;
+        if (direction.y != 0.0f)
+        {
+            float const nextBoundaryY = static_cast<float>(cellY + (stepY > 0 ? 1 : 0)) * mCellSize;
+            tMaxY = (nextBoundaryY - start.y) / direction.y;
+            tDeltaY = mCellSize / std::abs(direction.y);
+        }
+
+        for (std::uint64_t c = 0; c < cellCount; ++c)
+        {
+            size_t const bucket = GetBucket(cellX, cellY);
+
+            elementIndices.insert(
+                elementIndices.end(),
+                mBucketElements.cbegin() + mBucketStarts[bucket],
+                mBucketElements.cbegin() + mBucketStarts[bucket + 1]);
+
+            if (cellX == endCellX && cellY == endCellY)
+                break;
+
+            if ((tMaxX < tMaxY && cellX != endCellX) || cellY == endCellY)
+            {
+                cellX += stepX;
+                tMaxX += tDeltaX;
+            }
+            else
+            {
+                cellY += stepY;
+                tMaxY += tDeltaY;
+            }
+        }
+
+        elementIndices.insert(
+            elementIndices.end(),
+            mOversizedElements.cbegin(),
+            mOversizedElements.cend());
+
+        SortAndDeduplicate(elementIndices);
+    }
+
+private:
+
+    size_t PrepareBuckets(ElementCount elementCount)
+    {
+        // Make sure we have at least twice as many buckets as elements,
+        // so to keep collisions low
+        size_t bucketCount = MinBucketCount;
+        while (bucketCount < 2 * static_cast<size_t>(elementCount))
+            bucketCount *= 2;
+
+        mBucketCountMask = bucketCount - 1;
+
+        mBucketStarts.assign(bucketCount + 1, 0);
+
+        return bucketCount;
+    }
+
+    static void SortAndDeduplicate(std::vector<ElementIndex> & elementIndices)
+    {
+        // Different cells might map to the same bucket
+        std::sort(elementIndices.begin(), elementIndices.end());
+        elementIndices.erase(
+            std::unique(elementIndices.begin(), elementIndices.end()),
+            elementIndices.end());
+    }
+
+    inline std::int32_t ToCellCoordinate(float coordinate) const noexcept
+    {
+        // Clamp to a range that can't overflow in our arithmetic; this also takes care of NaN's
+        float constexpr MaxCellCoordinate = static_cast<float>(1 << 24);
+
+        float const cellCoordinate = std::floor(coordinate * mInverseCellSize);
+        if (cellCoordinate >= -MaxCellCoordinate && cellCoordinate <= MaxCellCoordinate)
+            return static_cast<std::int32_t>(cellCoordinate);
+        else if (cellCoordinate > 0.0f)
+            return static_cast<std::int32_t>(MaxCellCoordinate);
+        else
+            return -static_cast<std::int32_t>(MaxCellCoordinate);
+    }
+
+    inline size_t GetBucket(
+        std::int32_t cellX,
+        std::int32_t cellY) const noexcept
+    {
+        std::uint32_t const hash =
+            (static_cast<std::uint32_t>(cellX) * 73856093u)
+            ^ (static_cast<std::uint32_t>(cellY) * 19349663u);
+
+        return static_cast<size_t>(hash) & mBucketCountMask;
+    }
+
+private:
+
+    static size_t constexpr MinBucketCount = 64; // Must be a power of two
+
+    // Segments whose bounding boxes span this many cells - along either axis - are
+    // not indexed in cells
+    static std::int32_t constexpr MaxSegmentCellSpan = 8;
+
+    float const mCellSize;
+    float const mInverseCellSize;
+
+    ElementCount mElementCount;
+
+    size_t mBucketCountMask;
+
+    // For each bucket, the index in mBucketElements of its first element;
+    // has one extra entry at the end
+    std::vector<ElementIndex> mBucketStarts;
+
+    // The elements, grouped by bucket
+    std::vector<ElementIndex> mBucketElements;
+
+    // The bucket of each element; only populated for point elements
+    std::vector<std::uint32_t> mElementBuckets;
+
+    // The segment elements that are not indexed in cells, as they span too many
+    std::vector<ElementIndex> mOversizedElements;
+
+    // Scratch buffer used while rebuilding
+    std::vector<ElementIndex> mRebuildScratch;
+};
@@ -0,0 +1,126 @@
+/***************************************************************************************
+* Original Author:      Gabriele Giuseppini
+* Created:              2026-10-14
+* Copyright:            Gabriele Giuseppini  (https://github.com/GabrieleGiuseppini)
+***************************************************************************************/
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <initializer_list>
+#include <limits>
+#include <optional>
+#include <vector>
+
+/*
+ * Spreads the partitions of a set of low-frequency stages across the steps of a period,
+ * so that each partition of each stage runs exactly once per period, at most one partition
+ * runs at any given step, and the steps are as evenly spaced as possible.
+ *
+ * Partitions are interleaved among stages - i.e. all stages' first partitions come before
+ * all stages' second partitions - so that the partitions of each stage are spread evenly, too.
+ */
+class StaggeredScheduler
+{
+public:
+
+    StaggeredScheduler(
+        std::uint32_t period,
+        std::initializer_list<std::uint32_t> stagePartitionCounts)
+        : mStagePartitionCounts(stagePartitionCounts)
+        , mSlotsByStep(period, Slot())
+    {
+        // Interleave partitions among stages
+
+        std::vector<Slot> slots;
+
+        std::uint32_t maxPartitionCount = 0;
+        for (auto const partitionCount : mStagePartitionCounts)
+        {
+            maxPartitionCount = std::max(maxPartitionCount, partitionCount);
+        }
+
+        for (std::uint32_t partition = 0; partition < maxPartitionCount; ++partition)
+        {
+            for (size_t stage = 0; stage < mStagePartitionCounts.size(); ++stage)
+            {
+                if (partition < mStagePartitionCounts[stage])
+                {
+                    slots.emplace_back(stage, partition);
+                }
+            }
+        }
+
+        // Place each slot at the center of its share of the period
+
+        size_t const slotCount = slots.size();
+        assert(slotCount <= period);
+
+        for (size_t s = 0; s < slotCount; ++s)
+        {
+            size_t const step = ((2 * s + 1) * period) / (2 * slotCount);
+            assert(step < period);
+            assert(mSlotsByStep[step].Stage == NoStage);
+
+            mSlotsByStep[step] = slots[s];
+        }
+    }
+
+    std::uint32_t GetPeriod() const
+    {
+        return static_cast<std::uint32_t>(mSlotsByStep.size());
+    }
+
+    std::uint32_t GetPartitionCount(size_t stage) const
+    {
+        assert(stage < mStagePartitionCounts.size());
+        return mStagePartitionCounts[stage];
+    }
+
+    /*
+     * Returns the partition of the specified stage that is scheduled at the specified step
+     * (within the period), if any.
+     */
+    std::optional<std::uint32_t> GetScheduledPartition(
+        size_t stage,
+        std::uint32_t step) const
+    {
+        assert(step < mSlotsByStep.size());
+
+        Slot const & slot = mSlotsByStep[step];
+        if (slot.Stage == stage)
+        {
+            return slot.Partition;
+        }
+        else
+        {
+            return std::nullopt;
+        }
+    }
+
+private:
+
+    static size_t constexpr NoStage = std::numeric_limits<size_t>::max();
+
+    struct Slot
+    {
+        size_t Stage;
+        std::uint32_t Partition;
+
+        Slot()
+            : Stage(NoStage)
+            , Partition(0)
+        {}
+
+        Slot(
+            size_t stage,
+            std::uint32_t partition)
+            : Stage(stage)
+            , Partition(partition)
+        {}
+    };
+
+    std::vector<std::uint32_t> const mStagePartitionCounts;
+    std::vector<Slot> mSlotsByStep;
+};
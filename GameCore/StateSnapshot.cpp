@@ -0,0 +1,62 @@
+/***************************************************************************************
+* Original Author:      Gabriele Giuseppini
+* Created:              2026-10-14
+* Copyright:            Gabriele Giuseppini  (https://github.com/GabrieleGiuseppini)
+***************************************************************************************/
+#include "StateSnapshot.h"
+
+#include <fstream>
+
+void StateSnapshot::SaveToFile(std::filesystem::path const & filePath) const
+{
+    auto const directoryPath = filePath.parent_path();
+
+    if (!directoryPath.empty() && !std::filesystem::exists(directoryPath))
+        std::filesystem::create_directories(directoryPath);
+
+    // Write to a temporary file first, so that a crash while writing does not
+    // leave a truncated snapshot behind
+    auto tempFilePath = filePath;
+    tempFilePath += ".tmp";
+
+    {
+        std::ofstream file(tempFilePath, std::ios::out | std::ios::binary | std::ios::trunc);
+        if (!file.is_open())
+        {
+            throw GameException("Cannot open file \"" + tempFilePath.string() + "\"");
+        }
+
+        file.write(reinterpret_cast<char const *>(mData.data()), static_cast<std::streamsize>(mData.size()));
+        file.flush();
+
+        if (!file.good())
+        {
+            throw GameException("Cannot write file \"" + tempFilePath.string() + "\"");
+        }
+    }
+
+    std::filesystem::rename(tempFilePath, filePath);
+}
+
+StateSnapshot StateSnapshot::LoadFromFile(std::filesystem::path const & filePath)
+{
+    std::ifstream file(filePath, std::ios::in | std::ios::binary);
+    if (!file.is_open())
+    {
+        throw GameException("Cannot open file \"" + filePath.string() + "\"");
+    }
+
+    file.seekg(0, std::ios::end);
+    auto const fileSize = static_cast<size_t>(file.tellg());
+    file.seekg(0, std::ios::beg);
+
+    std::vector<std::uint8_t> data(fileSize);
+    file.read(reinterpret_cast<char *>(data.data()), static_cast<std::streamsize>(fileSize));
+
+    if (!file.good())
+    {
+        throw GameException("Cannot read file \"" + filePath.string() + "\"");
+    }
+
+    return StateSnapshot(std::move(data));
+}
@@ -0,0 +1,300 @@
+/***************************************************************************************
+* Original Author:      Gabriele Giuseppini
+* Created:              2026-10-14
+* Copyright:            Gabriele Giuseppini  (https://github.com/GabrieleGiuseppini)
+***************************************************************************************/
+#pragma once
+
+#include "Buffer.h"
+#include "ElementBitmap.h"
+#include "GameException.h"
+
+#include <cassert>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+/*
+ * A flat, versioned blob with the state of a set of element containers, made of
+ * byte-wise copies of their buffers.
+ *
+ * A snapshot is only meaningful for the same containers it has been taken from -
+ * or for containers created identically, e.g. from the same ship definition - and
+ * it is not portable across platforms.
+ */
+class StateSnapshot final
+{
+public:
+
+    // Incremented whenever the layout of any archived state changes
+    static std::uint32_t constexpr FormatVersion = 1;
+
+    explicit StateSnapshot(std::vector<std::uint8_t> && data)
+        : mData(std::move(data))
+    {}
+
+    StateSnapshot(StateSnapshot && other) = default;
+    StateSnapshot & operator=(StateSnapshot && other) = default;
+
+    std::vector<std::uint8_t> const & GetData() const noexcept
+    {
+        return mData;
+    }
+
+    size_t GetByteSize() const noexcept
+    {
+        return mData.size();
+    }
+
+    /*
+     * Safe to be invoked on a thread other than the one that owns the snapshot,
+     * as long as the snapshot is not modified or destroyed in the meantime.
+     */
+    void SaveToFile(std::filesystem::path const & filePath) const;
+
+    static StateSnapshot LoadFromFile(std::filesystem::path const & filePath);
+
+private:
+
+    std::vector<std::uint8_t> mData;
+};
+
+/*
+ * Builds a snapshot. Each Archive() appends a copy of the specified state.
+ *
+ * Containers typically archive their state with a single template function that is
+ * invoked with either a writer or a reader, so that saving and loading may not diverge.
+ */
+class StateSnapshotWriter final
+{
+public:
+
+    StateSnapshotWriter()
+        : mData()
+    {
+        Archive(MagicNumber);
+        Archive(StateSnapshot::FormatVersion);
+    }
+
+    /*
+     * Writes a tag, which is verified when reading; marks the beginning of the
+     * state of a container, so that mismatching snapshots are detected early.
+     */
+    void BeginSection(std::uint32_t tag)
+    {
+        Archive(tag);
+    }
+
+    template<typename T>
+    void Archive(T const & value)
+    {
+        static_assert(std::is_trivially_copyable_v<T>);
+
+        Append(&value, sizeof(T));
+    }
+
+    template<typename T>
+    void Archive(Buffer<T> const & buffer)
+    {
+        static_assert(std::is_trivially_copyable_v<T>);
+
+        Archive(static_cast<std::uint64_t>(buffer.GetSize()));
+        Append(buffer.data(), buffer.GetByteSize());
+    }
+
+    void Archive(ElementBitmap const & bitmap)
+    {
+        Archive(static_cast<std::uint64_t>(bitmap.GetElementCount()));
+        Append(bitmap.GetWords(), bitmap.GetByteSize());
+    }
+
+    template<typename T>
+    void Archive(std::vector<T> const & vector)
+    {
+        static_assert(std::is_trivially_copyable_v<T>);
+
+        Archive(static_cast<std::uint64_t>(vector.size()));
+        Append(vector.data(), vector.size() * sizeof(T));
+    }
+
+    void Archive(std::vector<bool> const & vector)
+    {
+        Archive(static_cast<std::uint64_t>(vector.size()));
+        for (bool const value : vector)
+        {
+            Archive(static_cast<std::uint8_t>(value ? 1 : 0));
+        }
+    }
+
+    /*
+     * Archives a container that knows how to save its own state.
+     */
+    template<typename TContainer>
+    void ArchiveContainer(TContainer const & container)
+    {
+        container.SaveState(*this);
+    }
+
+    StateSnapshot Finish()
+    {
+        return StateSnapshot(std::move(mData));
+    }
+
+private:
+
+    friend class StateSnapshotReader;
+
+    static std::uint32_t constexpr MagicNumber = 0x53534653; // FSSS
+
+    void Append(
+        void const * data,
+        size_t byteSize)
+    {
+        size_t const start = mData.size();
+        mData.resize(start + byteSize);
+        if (byteSize > 0)
+        {
+            std::memcpy(mData.data() + start, data, byteSize);
+        }
+    }
+
+    std::vector<std::uint8_t> mData;
+};
+
+/*
+ * Restores state from a snapshot, in the same order as it has been written.
+ *
+ * Throws a GameException when the snapshot does not match the containers being restored.
+ */
+class StateSnapshotReader final
+{
+public:
+
+    explicit StateSnapshotReader(StateSnapshot const & snapshot)
+        : mData(snapshot.GetData())
+        , mOffset(0)
+    {
+        std::uint32_t magicNumber;
+        Archive(magicNumber);
+        if (magicNumber != StateSnapshotWriter::MagicNumber)
+        {
+            throw GameException("The file is not a snapshot");
+        }
+
+        std::uint32_t formatVersion;
+        Archive(formatVersion);
+        if (formatVersion != StateSnapshot::FormatVersion)
+        {
+            throw GameException("The snapshot has been taken with a different version of the game");
+        }
+    }
+
+    void BeginSection(std::uint32_t tag)
+    {
+        std::uint32_t actualTag;
+        Archive(actualTag);
+        if (actualTag != tag)
+        {
+            throw GameException("The snapshot does not match the world being restored");
+        }
+    }
+
+    template<typename T>
+    void Archive(T & value)
+    {
+        static_assert(std::is_trivially_copyable_v<T>);
+
+        Consume(&value, sizeof(T));
+    }
+
+    template<typename T>
+    void Archive(Buffer<T> & buffer)
+    {
+        static_assert(std::is_trivially_copyable_v<T>);
+
+        CheckCount(buffer.GetSize());
+        Consume(buffer.data(), buffer.GetByteSize());
+    }
+
+    void Archive(ElementBitmap & bitmap)
+    {
+        CheckCount(bitmap.GetElementCount());
+        Consume(bitmap.GetWords(), bitmap.GetByteSize());
+    }
+
+    template<typename T>
+    void Archive(std::vector<T> & vector)
+    {
+        static_assert(std::is_trivially_copyable_v<T>);
+
+        std::uint64_t size;
+        Archive(size);
+        vector.resize(static_cast<size_t>(size));
+        Consume(vector.data(), vector.size() * sizeof(T));
+    }
+
+    void Archive(std::vector<bool> & vector)
+    {
+        std::uint64_t size;
+        Archive(size);
+        vector.resize(static_cast<size_t>(size));
+        for (size_t i = 0; i < vector.size(); ++i)
+        {
+            std::uint8_t value;
+            Archive(value);
+            vector[i] = (value != 0);
+        }
+    }
+
+    template<typename TContainer>
+    void ArchiveContainer(TContainer & container)
+    {
+        container.LoadState(*this);
+    }
+
+    /*
+     * Verifies that the whole snapshot has been consumed.
+     */
+    void Finish() const
+    {
+        if (mOffset != mData.size())
+        {
+            throw GameException("The snapshot does not match the world being restored");
+        }
+    }
+
+private:
+
+    void CheckCount(size_t expectedCount)
+    {
+        std::uint64_t count;
+        Archive(count);
+        if (count != static_cast<std::uint64_t>(expectedCount))
+        {
+            throw GameException("The snapshot does not match the world being restored");
+        }
+    }
+
+    void Consume(
+        void * data,
+        size_t byteSize)
+    {
+        if (mOffset + byteSize > mData.size())
+        {
+            throw GameException("The snapshot is truncated");
+        }
+
+        if (byteSize > 0)
+        {
+            std::memcpy(data, mData.data() + mOffset, byteSize);
+        }
+
+        mOffset += byteSize;
+    }
+
+    std::vector<std::uint8_t> const & mData;
+    size_t mOffset;
+};
@@ -5,6 +5,16 @@
 ***************************************************************************************/
 #include "SysSpecifics.h"
 
+#if (FS_IS_ARCHITECTURE_X86_64() || FS_IS_ARCHITECTURE_X86_32()) && defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+#if FS_IS_OS_LINUX()
+#include <sys/mman.h>
+#endif
+
+#include <atomic>
+
 #if FS_IS_ARCHITECTURE_ARM_32()
 #pragma message ("ARCHITECTURE:FS_ARCHITECTURE_ARM_32")
 #elif FS_IS_ARCHITECTURE_ARM_64()
@@ -25,4 +35,75 @@
 #pragma message ("OS:FS_OS_WINDOWS")
 #else
 #pragma message ("OS:<UNKNOWN>")
-#endif
\ No newline at end of file
+#endif
+
+static bool CalculateIsAVX2Supported() noexcept
+{
+#if FS_IS_ARCHITECTURE_X86_64() || FS_IS_ARCHITECTURE_X86_32()
+#if defined(_MSC_VER)
+    int cpuInfo[4];
+
+    __cpuid(cpuInfo, 0);
+    if (cpuInfo[0] < 7)
+        return false;
+
+    // OSXSAVE and AVX
+    __cpuid(cpuInfo, 1);
+    if ((cpuInfo[2] & (1 << 27)) == 0 || (cpuInfo[2] & (1 << 28)) == 0)
+        return false;
+
+    // OS saves YMM registers
+    if ((_xgetbv(0) & 0x6) != 0x6)
+        return false;
+
+    // AVX2
+    __cpuidex(cpuInfo, 7, 0);
+    return (cpuInfo[1] & (1 << 5)) != 0;
+#else
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx2");
+#endif
+#else
+    return false;
+#endif
+}
+
+bool IsAVX2Supported() noexcept
+{
+    static bool const isSupported = CalculateIsAVX2Supported();
+    return isSupported;
+}
+
+static std::atomic<bool> DoUseHugePagesForLargeBuffers(false);
+
+void SetUseHugePagesForLargeBuffers(bool doUseHugePages) noexcept
+{
+    DoUseHugePagesForLargeBuffers.store(doUseHugePages, std::memory_order_relaxed);
+}
+
+bool GetUseHugePagesForLargeBuffers() noexcept
+{
+    return DoUseHugePagesForLargeBuffers.load(std::memory_order_relaxed);
+}
+
+void * alloc_aligned_to_huge_page(size_t byte_size)
+{
+    // Round up to whole huge pages, or else the tail would not be eligible
+    size_t const aligned_byte_size = (byte_size + HugePageByteSize - 1) / HugePageByteSize * HugePageByteSize;
+
+#ifdef _MSC_VER
+    return _aligned_malloc(aligned_byte_size, HugePageByteSize);
+#else
+    void * const ptr = aligned_alloc(HugePageByteSize, aligned_byte_size);
+
+#if FS_IS_OS_LINUX() && defined(MADV_HUGEPAGE)
+    if (ptr != nullptr)
+    {
+        // Just advise; the kernel might not have transparent huge pages enabled, in which case we get normal pages
+        madvise(ptr, aligned_byte_size, MADV_HUGEPAGE);
+    }
+#endif
+
+    return ptr;
+#endif
+}
@@ -38,7 +38,7 @@
 #undef FS_IS_ARCHITECTURE_ARM_64
 #define FS_IS_ARCHITECTURE_ARM_64() 1
 #undef FS_IS_REGISTER_WIDTH_64
-#undef FS_IS_REGISTER_WIDTH_64() 1
+#define FS_IS_REGISTER_WIDTH_64() 1
 #elif defined(__amd64__) || defined(__amd64) || defined(__x86_64__) || defined(__x86_64) || defined(_M_X64) || defined (_M_AMD64)
 #undef FS_IS_ARCHITECTURE_X86_64
 #define FS_IS_ARCHITECTURE_X86_64() 1
@@ -147,6 +147,30 @@ inline constexpr T ceil_square_power_of_two(T value)
 #include <pmmintrin.h>
 #endif
 
+#if FS_IS_ARCHITECTURE_ARM_64()
+#include <arm_neon.h>
+#endif
+
+/*
+ * Marks a function as being compiled for AVX2, regardless of the target
+ * architecture level of the rest of the code; such functions may only be
+ * invoked after having checked IsAVX2Supported().
+ */
+
+#if FS_IS_ARCHITECTURE_X86_64() || FS_IS_ARCHITECTURE_X86_32()
+#if defined(__GNUC__) || defined(__clang__)
+#define FS_TARGET_AVX2 __attribute__((target("avx2")))
+#else
+#define FS_TARGET_AVX2
+#endif
+#endif
+
+/*
+ * Runtime check of whether the CPU we're running on supports AVX2
+ * instructions. The result is calculated once and cached.
+ */
+bool IsAVX2Supported() noexcept;
+
 ////////////////////////////////////////////////////////////////////////////////////////
 // Alignment
 ////////////////////////////////////////////////////////////////////////////////////////
@@ -207,6 +231,23 @@ inline constexpr bool is_aligned_to_float_element_count(T element_count) noexcep
 
 #define aligned_to_vword alignas(vectorization_byte_count<size_t>)
 
+/*
+ * Large buffers - those spanning at least one huge page - may be backed by huge pages,
+ * so to reduce TLB misses when sweeping them; this is only supported on Linux, via
+ * transparent huge pages. Meant to be set once at startup, before large buffers are
+ * allocated.
+ */
+void SetUseHugePagesForLargeBuffers(bool doUseHugePages) noexcept;
+bool GetUseHugePagesForLargeBuffers() noexcept;
+
+static size_t constexpr HugePageByteSize = 2 * 1024 * 1024;
+
+/*
+ * Allocates a buffer of bytes aligned to the huge page size, advising the OS to
+ * back it with huge pages; the buffer may be freed with free_aligned().
+ */
+void * alloc_aligned_to_huge_page(size_t byte_size);
+
 /*
  * Allocates a buffer of bytes aligned to the vectorization float
  * byte count.
@@ -220,6 +261,13 @@ inline void * alloc_aligned_to_vectorization_word(size_t byte_size)
         ? byte_size
         : byte_size + vectorization_byte_count<size_t> - (byte_size % vectorization_byte_count<size_t>);
 
+#if FS_IS_OS_LINUX()
+    if (aligned_byte_size >= HugePageByteSize && GetUseHugePagesForLargeBuffers())
+    {
+        return alloc_aligned_to_huge_page(aligned_byte_size);
+    }
+#endif
+
 #ifdef _MSC_VER
     return _aligned_malloc(aligned_byte_size, vectorization_byte_count<size_t>);
 #else
@@ -10,12 +10,96 @@
 #include "SysSpecifics.h"
 
 #include <algorithm>
+#include <cassert>
+#include <fstream>
 #include <limits>
+#include <map>
+#include <string>
 #include <thread>
+#include <tuple>
 
 #if FS_IS_OS_WINDOWS()
 #define NOMINMAX
 #include <Windows.h>
+#elif FS_IS_OS_LINUX()
+#include <pthread.h>
+#include <sched.h>
+#include <sys/resource.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#elif FS_IS_OS_MACOS()
+#include <pthread.h>
+#endif
+
+#if FS_IS_OS_LINUX()
+
+static std::optional<std::string> ReadSysFsLine(std::string const & path)
+{
+    std::ifstream file(path);
+    std::string line;
+    if (!file.is_open() || !std::getline(file, line))
+        return std::nullopt;
+
+    return line;
+}
+
+static std::optional<int> ReadSysFsInt(std::string const & path)
+{
+    auto const line = ReadSysFsLine(path);
+    if (!line.has_value())
+        return std::nullopt;
+
+    try
+    {
+        return std::stoi(*line);
+    }
+    catch (...)
+    {
+        return std::nullopt;
+    }
+}
+
+// Parses lists such as "0-7,16,18-19"
+static std::set<int> ParseSysFsCpuList(std::string const & cpuList)
+{
+    std::set<int> cpus;
+
+    size_t start = 0;
+    while (start < cpuList.size())
+    {
+        size_t end = cpuList.find(',', start);
+        if (end == std::string::npos)
+            end = cpuList.size();
+
+        std::string const range = cpuList.substr(start, end - start);
+
+        try
+        {
+            size_t const dash = range.find('-');
+            if (dash == std::string::npos)
+            {
+                cpus.insert(std::stoi(range));
+            }
+            else
+            {
+                int const last = std::stoi(range.substr(dash + 1));
+                for (int c = std::stoi(range.substr(0, dash)); c <= last; ++c)
+                {
+                    cpus.insert(c);
+                }
+            }
+        }
+        catch (...)
+        {
+            // Ignore
+        }
+
+        start = end + 1;
+    }
+
+    return cpus;
+}
+
 #endif
 
 size_t SystemThreadManager::GetNumberOfProcessors() const
@@ -25,13 +109,50 @@ size_t SystemThreadManager::GetNumberOfProcessors() const
         static_cast<size_t>(std::thread::hardware_concurrency()));
 }
 
-void SystemThreadManager::InitializeThisThread()
+void SystemThreadManager::SetPolicies(ThreadPolicies const & policies)
+{
+    LogMessage("SystemThreadManager::SetPolicies: preferPerformanceCoresForSimulation=", policies.DoPreferPerformanceCoresForSimulation,
+        " separateRenderThreadFromSimulation=", policies.DoSeparateRenderThreadFromSimulation,
+        " elevateMainThreadPriority=", policies.DoElevateMainThreadPriority);
+
+    {
+        std::lock_guard const lock{ mMutex };
+
+        mPolicies = policies;
+
+        // Start over, the main thread included
+        mAllocatedProcessors.clear();
+    }
+
+    InitializeThisThread(ThreadRole::Main);
+}
+
+void SystemThreadManager::InitializeThisThread(ThreadRole role)
 {
     //
     // Affinitize thread
     //
 
-    AffinitizeThisThread();
+    AffinitizeThisThread(role);
+
+    //
+    // Set priority
+    //
+
+    if (role == ThreadRole::Main)
+    {
+        bool doElevatePriority;
+
+        {
+            std::lock_guard const lock{ mMutex };
+            doElevatePriority = mPolicies.DoElevateMainThreadPriority;
+        }
+
+        if (doElevatePriority)
+        {
+            ElevateThisThreadPriority();
+        }
+    }
 
     //
     // Initialize floating point handling
@@ -45,63 +166,410 @@ void SystemThreadManager::InitializeThisThread()
 #endif
 }
 
-void SystemThreadManager::AffinitizeThisThread()
+std::optional<std::vector<SystemThreadManager::CpuIdType>> SystemThreadManager::ChooseProcessors(
+    std::vector<LogicalProcessor> const & topology,
+    ThreadRole role,
+    ThreadPolicies const & policies,
+    std::set<CpuIdType> const & allocatedProcessors)
 {
-    if (GetNumberOfProcessors() > 1)
+    if (topology.empty()
+        || (!policies.DoPreferPerformanceCoresForSimulation && !policies.DoSeparateRenderThreadFromSimulation))
     {
-#if FS_IS_OS_WINDOWS()
+        return std::nullopt;
+    }
+
+    std::uint8_t maxEfficiencyClass = 0;
+    for (auto const & lp : topology)
+    {
+        maxEfficiencyClass = std::max(maxEfficiencyClass, lp.EfficiencyClass);
+    }
+
+    auto const isPerformanceProcessor = [maxEfficiencyClass](LogicalProcessor const & lp)
+    {
+        return lp.EfficiencyClass == maxEfficiencyClass;
+    };
+
+    bool const isHybrid = std::any_of(
+        topology.cbegin(),
+        topology.cend(),
+        [&](LogicalProcessor const & lp)
+        {
+            return !isPerformanceProcessor(lp);
+        });
+
+    std::vector<CpuIdType> efficiencyProcessors;
+    for (auto const & lp : topology)
+    {
+        if (!isPerformanceProcessor(lp))
+            efficiencyProcessors.push_back(lp.CpuId);
+    }
+
+    //
+    // The processors reserved for the render thread: the efficiency cores when any,
+    // otherwise the last physical core - when there's more than one
+    //
+
+    std::vector<CpuIdType> renderProcessors;
+    if (policies.DoSeparateRenderThreadFromSimulation)
+    {
+        if (isHybrid)
+        {
+            renderProcessors = efficiencyProcessors;
+        }
+        else if (topology.front().CoreId != topology.back().CoreId)
+        {
+            for (auto const & lp : topology)
+            {
+                if (lp.CoreId == topology.back().CoreId)
+                    renderProcessors.push_back(lp.CpuId);
+            }
+        }
+    }
+
+    auto const isRenderProcessor = [&renderProcessors](CpuIdType cpuId)
+    {
+        return std::find(renderProcessors.cbegin(), renderProcessors.cend(), cpuId) != renderProcessors.cend();
+    };
+
+    switch (role)
+    {
+        case ThreadRole::Render:
+        {
+            if (renderProcessors.empty())
+                return std::nullopt;
+
+            return renderProcessors;
+        }
+
+        case ThreadRole::Other:
+        {
+            // Keep background threads off the performance cores
+            if (policies.DoPreferPerformanceCoresForSimulation && isHybrid)
+                return efficiencyProcessors;
+
+            return std::nullopt;
+        }
+
+        case ThreadRole::Main:
+        case ThreadRole::Simulation:
+        {
+            //
+            // Pick the first free processor, in order of preference
+            //
+
+            auto const makeKey = [&](LogicalProcessor const & lp)
+            {
+                bool const doPrefer = policies.DoPreferPerformanceCoresForSimulation;
+
+                return std::make_tuple(
+                    isRenderProcessor(lp.CpuId),
+                    doPrefer ? maxEfficiencyClass - lp.EfficiencyClass : 0,
+                    doPrefer && lp.IsSmtSibling,
+                    lp.CpuId);
+            };
+
+            std::vector<LogicalProcessor> candidates = topology;
+            std::sort(
+                candidates.begin(),
+                candidates.end(),
+                [&makeKey](LogicalProcessor const & l, LogicalProcessor const & r)
+                {
+                    return makeKey(l) < makeKey(r);
+                });
+
+            for (auto const & lp : candidates)
+            {
+                if (allocatedProcessors.count(lp.CpuId) == 0)
+                    return std::vector<CpuIdType>({ lp.CpuId });
+            }
+
+            // All taken; float on all but the render processors
+            std::vector<CpuIdType> cpuIds;
+            for (auto const & lp : topology)
+            {
+                if (!isRenderProcessor(lp.CpuId))
+                    cpuIds.push_back(lp.CpuId);
+            }
+
+            if (cpuIds.empty())
+                return std::nullopt;
+
+            return cpuIds;
+        }
+    }
+
+    assert(false);
+    return std::nullopt;
+}
+
+void SystemThreadManager::AffinitizeThisThread(ThreadRole role)
+{
+    if (GetNumberOfProcessors() <= 1)
+    {
+        return;
+    }
+
+    std::lock_guard const lock{ mMutex };
 
-        // Pick a processor that we haven't already assigned, among those 
-        // allowed by GetProcessAffinityMask()
+    if (mPolicies.DoPreferPerformanceCoresForSimulation || mPolicies.DoSeparateRenderThreadFromSimulation)
+    {
+        if (!mTopology.has_value())
+        {
+            mTopology = DetectTopology();
 
-        HANDLE const hThisProcess = GetCurrentProcess();
-        assert(hThisProcess != NULL);
+            for (auto const & lp : *mTopology)
+            {
+                LogMessage("SystemThreadManager: CPU ", size_t(lp.CpuId), ": core=", lp.CoreId, " efficiencyClass=", size_t(lp.EfficiencyClass),
+                    " isSmtSibling=", lp.IsSmtSibling);
+            }
+        }
 
-        DWORD_PTR dwProcessAffinityMask = 0;
-        DWORD_PTR dwSystemAffinityMask = 0;
-        BOOL res = ::GetProcessAffinityMask(hThisProcess, &dwProcessAffinityMask, &dwSystemAffinityMask);
-        if (!res)
+        auto const cpuIds = ChooseProcessors(*mTopology, role, mPolicies, mAllocatedProcessors);
+        if (cpuIds.has_value())
         {
-            DWORD const dwLastError = ::GetLastError();
-            LogMessage("Error invoking GetProcessAffinityMask: ", dwLastError);
+            if (SetThisThreadAffinity(*cpuIds) && cpuIds->size() == 1)
+            {
+                // Allocate this CPU
+                mAllocatedProcessors.insert(cpuIds->front());
+            }
+
             return;
         }
+    }
 
-        LogMessage("GetProcessAffinityMask: proc=", dwProcessAffinityMask, " system=", dwSystemAffinityMask);
+    //
+    // Default policy
+    //
+
+#if FS_IS_OS_WINDOWS()
 
-        // Visit all CPU/bits until one is found
-        DWORD dwCpuId = 0;
-        DWORD dwCpuMask = 1;
-        for (; dwCpuId < sizeof(dwProcessAffinityMask) * 8 && dwCpuId < std::numeric_limits<CpuIdType>::max(); ++dwCpuId, dwCpuMask = (dwCpuMask << 1))
+    // Pick a processor that we haven't already assigned, among those 
+    // allowed by GetProcessAffinityMask()
+
+    HANDLE const hThisProcess = GetCurrentProcess();
+    assert(hThisProcess != NULL);
+
+    DWORD_PTR dwProcessAffinityMask = 0;
+    DWORD_PTR dwSystemAffinityMask = 0;
+    BOOL res = ::GetProcessAffinityMask(hThisProcess, &dwProcessAffinityMask, &dwSystemAffinityMask);
+    if (!res)
+    {
+        DWORD const dwLastError = ::GetLastError();
+        LogMessage("Error invoking GetProcessAffinityMask: ", dwLastError);
+        return;
+    }
+
+    LogMessage("GetProcessAffinityMask: proc=", dwProcessAffinityMask, " system=", dwSystemAffinityMask);
+
+    // Visit all CPU/bits until one is found
+    DWORD dwCpuId = 0;
+    DWORD dwCpuMask = 1;
+    for (; dwCpuId < sizeof(dwProcessAffinityMask) * 8 && dwCpuId < std::numeric_limits<CpuIdType>::max(); ++dwCpuId, dwCpuMask = (dwCpuMask << 1))
+    {
+        CpuIdType const cpuId = static_cast<CpuIdType>(dwCpuId);
+        if (dwProcessAffinityMask & dwCpuMask // Allowed by process affinity mask
+            && mAllocatedProcessors.count(cpuId) == 0) // Not used already
         {
-            CpuIdType const cpuId = static_cast<CpuIdType>(dwCpuId);
-            if (dwProcessAffinityMask & dwCpuMask // Allowed by process affinity mask
-                && mAllocatedProcessors.count(cpuId) == 0) // Not used already
+            //
+            // Found!
+            //
+
+            // Set thread affinity mask
+            DWORD_PTR const dwNewThreadAffinityMask = dwCpuMask;
+            DWORD_PTR dwOldThreadAffinityMask = ::SetThreadAffinityMask(GetCurrentThread(), dwNewThreadAffinityMask);
+
+            LogMessage("SetThreadAffinityMask(", dwNewThreadAffinityMask, " for CPU ", size_t(cpuId), ") returned ", dwOldThreadAffinityMask);
+
+            if (dwOldThreadAffinityMask != 0)
             {
-                //
-                // Found!
-                //
+                // We're done
 
-                // Set thread affinity mask
-                DWORD_PTR const dwNewThreadAffinityMask = dwCpuMask;
-                DWORD_PTR dwOldThreadAffinityMask = ::SetThreadAffinityMask(GetCurrentThread(), dwNewThreadAffinityMask);
+                // Allocate this CPU
+                mAllocatedProcessors.insert(cpuId);
 
-                LogMessage("SetThreadAffinityMask(", dwNewThreadAffinityMask, " for CPU ", size_t(cpuId), ") returned ", dwOldThreadAffinityMask);
+                return;
+            }
+        }
+    }
 
-                if (dwOldThreadAffinityMask != 0)
-                {
-                    // We're done
+    // If we're here, no luck
+    LogMessage("WARNING: couldn't find a CPU to affinitize this thread on");
+#endif
+}
+
+std::vector<SystemThreadManager::LogicalProcessor> SystemThreadManager::DetectTopology()
+{
+    std::vector<LogicalProcessor> topology;
+
+#if FS_IS_OS_WINDOWS()
+
+    DWORD_PTR dwProcessAffinityMask = 0;
+    DWORD_PTR dwSystemAffinityMask = 0;
+    if (!::GetProcessAffinityMask(GetCurrentProcess(), &dwProcessAffinityMask, &dwSystemAffinityMask))
+    {
+        LogMessage("Error invoking GetProcessAffinityMask: ", ::GetLastError());
+        return topology;
+    }
 
-                    // Allocate this CPU
-                    mAllocatedProcessors.insert(cpuId);
+    DWORD dwLength = 0;
+    ::GetLogicalProcessorInformationEx(RelationProcessorCore, nullptr, &dwLength);
+    if (dwLength == 0)
+    {
+        LogMessage("Error invoking GetLogicalProcessorInformationEx: ", ::GetLastError());
+        return topology;
+    }
+
+    std::vector<std::uint8_t> buffer(dwLength);
+    if (!::GetLogicalProcessorInformationEx(RelationProcessorCore, reinterpret_cast<PSYSTEM_LOGICAL_PROCESSOR_INFORMATION_EX>(buffer.data()), &dwLength))
+    {
+        LogMessage("Error invoking GetLogicalProcessorInformationEx: ", ::GetLastError());
+        return topology;
+    }
 
-                    return;
+    size_t coreId = 0;
+    for (DWORD offset = 0; offset < dwLength; )
+    {
+        auto const * info = reinterpret_cast<SYSTEM_LOGICAL_PROCESSOR_INFORMATION_EX const *>(buffer.data() + offset);
+        if (info->Relationship == RelationProcessorCore
+            && info->Processor.GroupMask[0].Group == 0) // Thread affinity masks only cover the first group
+        {
+            bool isFirst = true;
+            for (DWORD dwCpuId = 0; dwCpuId < sizeof(KAFFINITY) * 8 && dwCpuId < std::numeric_limits<CpuIdType>::max(); ++dwCpuId)
+            {
+                KAFFINITY const cpuMask = KAFFINITY(1) << dwCpuId;
+                if ((info->Processor.GroupMask[0].Mask & cpuMask) && (dwProcessAffinityMask & cpuMask))
+                {
+                    topology.push_back({ static_cast<CpuIdType>(dwCpuId), coreId, info->Processor.EfficiencyClass, !isFirst });
+                    isFirst = false;
                 }
             }
+
+            ++coreId;
         }
 
-        // If we're here, no luck
-        LogMessage("WARNING: couldn't find a CPU to affinitize this thread on");
+        offset += info->Size;
+    }
+
+#elif FS_IS_OS_LINUX()
+
+    cpu_set_t allowedCpus;
+    CPU_ZERO(&allowedCpus);
+    if (sched_getaffinity(0, sizeof(allowedCpus), &allowedCpus) != 0)
+    {
+        LogMessage("Error invoking sched_getaffinity");
+        return topology;
+    }
+
+    // Hybrid Intel CPUs list their performance cores here
+    std::set<int> performanceCpus;
+    if (auto const cpuList = ReadSysFsLine("/sys/devices/cpu_core/cpus"); cpuList.has_value())
+    {
+        performanceCpus = ParseSysFsCpuList(*cpuList);
+    }
+
+    std::map<std::tuple<int, int>, size_t> coreIds;
+
+    for (int cpu = 0; cpu < CPU_SETSIZE && cpu < std::numeric_limits<CpuIdType>::max(); ++cpu)
+    {
+        if (!CPU_ISSET(cpu, &allowedCpus))
+            continue;
+
+        std::string const cpuPath = "/sys/devices/system/cpu/cpu" + std::to_string(cpu);
+
+        auto const packageId = ReadSysFsInt(cpuPath + "/topology/physical_package_id").value_or(0);
+        auto const physicalCoreId = ReadSysFsInt(cpuPath + "/topology/core_id").value_or(cpu);
+
+        std::uint8_t efficiencyClass = 0;
+        if (!performanceCpus.empty())
+        {
+            efficiencyClass = performanceCpus.count(cpu) > 0 ? 1 : 0;
+        }
+        else if (auto const capacity = ReadSysFsInt(cpuPath + "/cpu_capacity"); capacity.has_value())
+        {
+            // Big.LITTLE; capacities go up to 1024
+            efficiencyClass = static_cast<std::uint8_t>(std::clamp(*capacity / 4, 0, 255));
+        }
+
+        auto const coreKey = std::make_tuple(packageId, physicalCoreId);
+        bool const isSmtSibling = coreIds.count(coreKey) > 0;
+        if (!isSmtSibling)
+        {
+            coreIds.emplace(coreKey, coreIds.size());
+        }
+
+        topology.push_back({ static_cast<CpuIdType>(cpu), coreIds.at(coreKey), efficiencyClass, isSmtSibling });
+    }
+
+#endif
+
+    return topology;
+}
+
+bool SystemThreadManager::SetThisThreadAffinity(std::vector<CpuIdType> const & cpuIds)
+{
+#if FS_IS_OS_WINDOWS()
+
+    DWORD_PTR dwNewThreadAffinityMask = 0;
+    for (auto const cpuId : cpuIds)
+    {
+        dwNewThreadAffinityMask |= DWORD_PTR(1) << cpuId;
+    }
+
+    DWORD_PTR const dwOldThreadAffinityMask = ::SetThreadAffinityMask(GetCurrentThread(), dwNewThreadAffinityMask);
+
+    LogMessage("SetThreadAffinityMask(", dwNewThreadAffinityMask, ") returned ", dwOldThreadAffinityMask);
+
+    return dwOldThreadAffinityMask != 0;
+
+#elif FS_IS_OS_LINUX()
+
+    cpu_set_t cpuSet;
+    CPU_ZERO(&cpuSet);
+    for (auto const cpuId : cpuIds)
+    {
+        CPU_SET(cpuId, &cpuSet);
+    }
+
+    int const res = pthread_setaffinity_np(pthread_self(), sizeof(cpuSet), &cpuSet);
+
+    LogMessage("pthread_setaffinity_np(", cpuIds.size(), " CPUs starting at ", cpuIds.empty() ? 0 : size_t(cpuIds.front()), ") returned ", res);
+
+    return res == 0;
+
+#else
+
+    (void)cpuIds;
+
+    LogMessage("WARNING: thread affinity is not supported on this platform");
+
+    return false;
+
 #endif
+}
+
+void SystemThreadManager::ElevateThisThreadPriority()
+{
+#if FS_IS_OS_WINDOWS()
+
+    if (!::SetThreadPriority(GetCurrentThread(), THREAD_PRIORITY_ABOVE_NORMAL))
+    {
+        LogMessage("Error invoking SetThreadPriority: ", ::GetLastError());
+    }
+
+#elif FS_IS_OS_LINUX()
+
+    // Threads have their own nice value; lowering it usually requires CAP_SYS_NICE
+    if (setpriority(PRIO_PROCESS, static_cast<id_t>(syscall(SYS_gettid)), -5) != 0)
+    {
+        LogMessage("WARNING: couldn't elevate the priority of this thread");
     }
-}
\ No newline at end of file
+
+#elif FS_IS_OS_MACOS()
+
+    if (pthread_set_qos_class_self_np(QOS_CLASS_USER_INTERACTIVE, 0) != 0)
+    {
+        LogMessage("WARNING: couldn't elevate the priority of this thread");
+    }
+
+#endif
+}
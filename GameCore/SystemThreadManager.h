@@ -6,10 +6,61 @@
 #pragma once
 
 #include <cstdint>
+#include <mutex>
+#include <optional>
 #include <set>
+#include <vector>
 
 class SystemThreadManager final
 {
+public:
+
+    using CpuIdType = std::uint8_t;
+
+    enum class ThreadRole
+    {
+        Main,
+        Simulation, // Thread pool workers
+        Render,
+        Other
+    };
+
+    struct ThreadPolicies
+    {
+        // Simulation and main threads go to physical cores of the highest performance
+        // class first, rather than to SMT siblings or efficiency cores
+        bool DoPreferPerformanceCoresForSimulation;
+
+        // The render thread goes to efficiency cores - or to the last physical core -
+        // which simulation threads then avoid
+        bool DoSeparateRenderThreadFromSimulation;
+
+        bool DoElevateMainThreadPriority;
+
+        ThreadPolicies()
+            : DoPreferPerformanceCoresForSimulation(false)
+            , DoSeparateRenderThreadFromSimulation(false)
+            , DoElevateMainThreadPriority(false)
+        {}
+
+        ThreadPolicies(
+            bool doPreferPerformanceCoresForSimulation,
+            bool doSeparateRenderThreadFromSimulation,
+            bool doElevateMainThreadPriority)
+            : DoPreferPerformanceCoresForSimulation(doPreferPerformanceCoresForSimulation)
+            , DoSeparateRenderThreadFromSimulation(doSeparateRenderThreadFromSimulation)
+            , DoElevateMainThreadPriority(doElevateMainThreadPriority)
+        {}
+    };
+
+    struct LogicalProcessor
+    {
+        CpuIdType CpuId;
+        size_t CoreId; // Shared by SMT siblings
+        std::uint8_t EfficiencyClass; // Higher is more performant
+        bool IsSmtSibling; // Whether it's not the first logical processor of its core
+    };
+
 public:
 
     static SystemThreadManager & GetInstance()
@@ -21,16 +72,48 @@ public:
 
     size_t GetNumberOfProcessors() const;
 
-    void InitializeThisThread();
+    /*
+     * Sets the policies for the threads initialized from now on, and re-initializes
+     * the calling thread - which is assumed to be the main thread - with them.
+     *
+     * Must be invoked before any other thread is initialized.
+     */
+    void SetPolicies(ThreadPolicies const & policies);
 
-private:
+    void InitializeThisThread(ThreadRole role = ThreadRole::Other);
 
-    using CpuIdType = std::uint8_t;
+    /*
+     * Returns the logical processors that a thread with the specified role should
+     * run on, or none when the role is not subject to any policy; exposed for testing.
+     */
+    static std::optional<std::vector<CpuIdType>> ChooseProcessors(
+        std::vector<LogicalProcessor> const & topology,
+        ThreadRole role,
+        ThreadPolicies const & policies,
+        std::set<CpuIdType> const & allocatedProcessors);
+
+private:
 
     SystemThreadManager()
+        : mMutex()
+        , mPolicies()
+        , mTopology()
+        , mAllocatedProcessors()
     {}
 
-    void AffinitizeThisThread();
+    void AffinitizeThisThread(ThreadRole role);
+
+    static std::vector<LogicalProcessor> DetectTopology();
+
+    static bool SetThisThreadAffinity(std::vector<CpuIdType> const & cpuIds);
+
+    static void ElevateThisThreadPriority();
+
+private:
+
+    std::mutex mMutex;
 
+    ThreadPolicies mPolicies;
+    std::optional<std::vector<LogicalProcessor>> mTopology; // Detected lazily
     std::set<CpuIdType> mAllocatedProcessors;
 };
@@ -0,0 +1,296 @@
+/***************************************************************************************
+* Original Author:      Gabriele Giuseppini
+* Created:              2026-10-14
+* Copyright:            Gabriele Giuseppini  (https://github.com/GabrieleGiuseppini)
+***************************************************************************************/
+#include "TaskGraph.h"
+
+#include "GameException.h"
+#include "Log.h"
+
+#include <algorithm>
+#include <chrono>
+#include <string_view>
+
+static size_t HashMemory(
+    void const * data,
+    size_t byteSize)
+{
+    return std::hash<std::string_view>()(std::string_view(static_cast<char const *>(data), byteSize));
+}
+
+TaskGraph::TaskId TaskGraph::AddStage(
+    std::string const & name,
+    std::vector<Task> && partitions,
+    ResourceAccess const & access,
+    bool isMainThreadOnly)
+{
+    assert(!partitions.empty());
+    assert(!isMainThreadOnly || partitions.size() == 1);
+
+    //
+    // Derive dependencies
+    //
+
+    std::vector<TaskId> dependencies;
+
+    for (auto const resourceId : access.Reads)
+    {
+        assert(resourceId < mResources.size());
+        auto const & resource = mResources[resourceId];
+        dependencies.insert(dependencies.end(), resource.LastWriters.cbegin(), resource.LastWriters.cend());
+    }
+
+    for (auto const resourceId : access.Writes)
+    {
+        assert(resourceId < mResources.size());
+        auto const & resource = mResources[resourceId];
+        dependencies.insert(dependencies.end(), resource.LastWriters.cbegin(), resource.LastWriters.cend());
+        dependencies.insert(dependencies.end(), resource.ReadersSinceLastWrite.cbegin(), resource.ReadersSinceLastWrite.cend());
+    }
+
+    std::sort(dependencies.begin(), dependencies.end());
+    dependencies.erase(std::unique(dependencies.begin(), dependencies.end()), dependencies.end());
+
+    //
+    // Add partitions
+    //
+
+    TaskId const firstTaskId = mTasks.size();
+
+    for (size_t p = 0; p < partitions.size(); ++p)
+    {
+        mTasks.push_back({
+            partitions.size() == 1 ? name : name + " #" + std::to_string(p),
+            std::move(partitions[p]),
+            dependencies,
+            isMainThreadOnly,
+            true,
+            access.Writes });
+    }
+
+    TaskId const endTaskId = mTasks.size();
+
+    mAreWavesValid = false;
+
+    //
+    // Update accessors
+    //
+
+    for (auto const resourceId : access.Reads)
+    {
+        auto & readers = mResources[resourceId].ReadersSinceLastWrite;
+        for (TaskId t = firstTaskId; t < endTaskId; ++t)
+        {
+            readers.push_back(t);
+        }
+    }
+
+    for (auto const resourceId : access.Writes)
+    {
+        auto & resource = mResources[resourceId];
+
+        resource.LastWriters.clear();
+        for (TaskId t = firstTaskId; t < endTaskId; ++t)
+        {
+            resource.LastWriters.push_back(t);
+        }
+
+        resource.ReadersSinceLastWrite.clear();
+    }
+
+    return firstTaskId;
+}
+
+std::vector<std::vector<TaskGraph::TaskId>> TaskGraph::CalculateWaves() const
+{
+    // The wave of a task is one past the latest wave of its dependencies;
+    // dependencies precede their dependents, hence a single visit suffices
+
+    std::vector<size_t> taskWaves(mTasks.size(), 0);
+    std::vector<std::vector<TaskId>> waves;
+    std::vector<bool> waveHasMainThreadTask;
+
+    for (TaskId t = 0; t < mTasks.size(); ++t)
+    {
+        size_t wave = 0;
+        for (auto const dependency : mTasks[t].Dependencies)
+        {
+            wave = std::max(wave, taskWaves[dependency] + 1);
+        }
+
+        if (mTasks[t].IsMainThreadOnly)
+        {
+            // Only one main thread task per wave
+            while (wave < waveHasMainThreadTask.size() && waveHasMainThreadTask[wave])
+            {
+                ++wave;
+            }
+        }
+
+        taskWaves[t] = wave;
+
+        if (wave >= waves.size())
+        {
+            waves.resize(wave + 1);
+            waveHasMainThreadTask.resize(wave + 1, false);
+        }
+
+        if (mTasks[t].IsMainThreadOnly)
+        {
+            // The pool runs the first task of a wave on the main thread
+            waves[wave].insert(waves[wave].begin(), t);
+            waveHasMainThreadTask[wave] = true;
+        }
+        else
+        {
+            waves[wave].push_back(t);
+        }
+    }
+
+    return waves;
+}
+
+void TaskGraph::Run(
+    TaskThreadPool & threadPool,
+    bool doLogTimings)
+{
+    auto const startTimestamp = std::chrono::steady_clock::now();
+
+    if (!mAreWavesValid)
+    {
+        PrepareWaves();
+    }
+
+    for (auto & taskError : mTaskErrors)
+    {
+        taskError.clear(); // Keeps capacity
+    }
+
+    mDoLogTimings = doLogTimings;
+
+    for (size_t w = 0; w < mWaves.size(); ++w)
+    {
+        auto const & wave = mWaves[w];
+
+        if (mIsAccessVerificationEnabled || mTaskObserver)
+        {
+            for (auto const taskId : wave)
+            {
+                if (mIsAccessVerificationEnabled)
+                {
+                    RunTaskVerifyingAccesses(taskId);
+                }
+                else
+                {
+                    RunTask(taskId, doLogTimings);
+                }
+
+                if (mTaskObserver && mTaskErrors[taskId].empty())
+                {
+                    mTaskObserver(mTasks[taskId].Name);
+                }
+            }
+        }
+        else
+        {
+            threadPool.Run(mWavePoolTasks[w]);
+        }
+
+        // Stop at the first wave with errors
+        for (auto const taskId : wave)
+        {
+            if (!mTaskErrors[taskId].empty())
+            {
+                throw GameException("Error running \"" + mTasks[taskId].Name + "\": " + mTaskErrors[taskId]);
+            }
+        }
+    }
+
+    if (doLogTimings)
+    {
+        auto const elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - startTimestamp);
+        LogMessage("TaskGraph: ", mTasks.size(), " tasks took ", elapsed.count(), "ms");
+    }
+}
+
+void TaskGraph::PrepareWaves()
+{
+    mWaves = CalculateWaves();
+
+    mWavePoolTasks.clear();
+    for (auto const & wave : mWaves)
+    {
+        auto & poolTasks = mWavePoolTasks.emplace_back();
+        for (auto const taskId : wave)
+        {
+            poolTasks.emplace_back(
+                [this, taskId]()
+                {
+                    RunTask(taskId, mDoLogTimings);
+                });
+        }
+    }
+
+    mTaskErrors.resize(mTasks.size());
+
+    mAreWavesValid = true;
+}
+
+void TaskGraph::RunTask(
+    TaskId taskId,
+    bool doLogTimings)
+{
+    auto const taskStartTimestamp = std::chrono::steady_clock::now();
+
+    try
+    {
+        mTasks[taskId].Body();
+    }
+    catch (std::exception const & ex)
+    {
+        mTaskErrors[taskId] = ex.what();
+        if (mTaskErrors[taskId].empty())
+        {
+            mTaskErrors[taskId] = "Unknown error";
+        }
+    }
+
+    if (doLogTimings)
+    {
+        auto const elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - taskStartTimestamp);
+        LogMessage("TaskGraph: \"", mTasks[taskId].Name, "\" took ", elapsed.count(), "ms");
+    }
+}
+
+void TaskGraph::RunTaskVerifyingAccesses(TaskId taskId)
+{
+    auto const & task = mTasks[taskId];
+
+    std::vector<size_t> resourceHashes(mResources.size(), 0);
+    for (ResourceId r = 0; r < mResources.size(); ++r)
+    {
+        if (mResources[r].Data != nullptr)
+        {
+            resourceHashes[r] = HashMemory(mResources[r].Data, mResources[r].ByteSize);
+        }
+    }
+
+    RunTask(taskId, false);
+
+    if (!task.HasDeclaredAccesses || !mTaskErrors[taskId].empty())
+    {
+        return;
+    }
+
+    for (ResourceId r = 0; r < mResources.size(); ++r)
+    {
+        if (mResources[r].Data != nullptr
+            && std::find(task.Writes.cbegin(), task.Writes.cend(), r) == task.Writes.cend()
+            && HashMemory(mResources[r].Data, mResources[r].ByteSize) != resourceHashes[r])
+        {
+            mTaskErrors[taskId] = "wrote undeclared resource \"" + mResources[r].Name + "\"";
+            return;
+        }
+    }
+}
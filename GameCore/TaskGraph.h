@@ -0,0 +1,218 @@
+/***************************************************************************************
+* Original Author:      Gabriele Giuseppini
+* Created:              2026-10-14
+* Copyright:            Gabriele Giuseppini  (https://github.com/GabrieleGiuseppini)
+***************************************************************************************/
+#pragma once
+
+#include "TaskThreadPool.h"
+
+#include <cassert>
+#include <functional>
+#include <string>
+#include <utility>
+#include <vector>
+
+/*
+ * A set of named tasks and of the dependencies among them, which are run on a
+ * thread pool so that independent tasks run concurrently.
+ *
+ * Tasks run in waves: each wave consists of all the tasks whose dependencies have
+ * all run in earlier waves. A task may only depend on tasks added before it, which
+ * rules out cycles by construction.
+ *
+ * Alternatively, dependencies may be derived from the resources (e.g. buffers) that
+ * tasks declare to read and write: a task depends on the latest earlier writers of
+ * all the resources it accesses, and - for the resources it writes - on all the
+ * earlier readers since then. The graph thus yields the same results as running the
+ * tasks one after the other in the order they were added.
+ */
+class TaskGraph
+{
+public:
+
+    using Task = std::function<void()>;
+    using TaskObserver = std::function<void(std::string const & taskName)>;
+    using TaskId = size_t;
+    using ResourceId = size_t;
+
+    struct ResourceAccess
+    {
+        std::vector<ResourceId> Reads;
+        std::vector<ResourceId> Writes;
+    };
+
+public:
+
+    TaskId AddTask(
+        std::string const & name,
+        Task && task,
+        std::vector<TaskId> const & dependencies = {})
+    {
+        TaskId const taskId = mTasks.size();
+
+        for (auto const dependency : dependencies)
+        {
+            assert(dependency < taskId);
+            (void)dependency;
+        }
+
+        mTasks.push_back({ name, std::move(task), dependencies, false, false, {} });
+        mAreWavesValid = false;
+
+        return taskId;
+    }
+
+    /*
+     * Declares a resource; when the resource's memory is specified, it is
+     * checked while verifying accesses.
+     */
+    ResourceId AddResource(
+        std::string const & name,
+        void const * data = nullptr,
+        size_t byteSize = 0)
+    {
+        ResourceId const resourceId = mResources.size();
+        mResources.push_back({ name, data, byteSize, {}, {} });
+
+        return resourceId;
+    }
+
+    /*
+     * Adds a task whose dependencies are derived from the resources it accesses.
+     *
+     * Main thread tasks run on the thread invoking Run(), hence at most one of them
+     * runs in each wave.
+     */
+    TaskId AddStage(
+        std::string const & name,
+        Task && task,
+        ResourceAccess const & access,
+        bool isMainThreadOnly = false)
+    {
+        std::vector<Task> partitions;
+        partitions.emplace_back(std::move(task));
+
+        return AddStage(name, std::move(partitions), access, isMainThreadOnly);
+    }
+
+    /*
+     * Adds a stage made of partitions that run concurrently with each other, e.g. each
+     * working on a disjoint portion of the resources written by the stage; returns the
+     * ID of the first partition.
+     */
+    TaskId AddStage(
+        std::string const & name,
+        std::vector<Task> && partitions,
+        ResourceAccess const & access,
+        bool isMainThreadOnly = false);
+
+    size_t GetResourceCount() const
+    {
+        return mResources.size();
+    }
+
+    size_t GetTaskCount() const
+    {
+        return mTasks.size();
+    }
+
+    /*
+     * Returns the waves the tasks would run in, in order.
+     */
+    std::vector<std::vector<TaskId>> CalculateWaves() const;
+
+    /*
+     * Runs all tasks, optionally logging the time each one takes.
+     *
+     * The waves are calculated at the first run after the graph changes, hence
+     * a graph that is run repeatedly, re-binding only the data its tasks read,
+     * does not allocate after its first run.
+     *
+     * When tasks throw, the remaining tasks of their wave complete but no further
+     * waves run, and the error of the first failed task is re-thrown.
+     */
+    void Run(
+        TaskThreadPool & threadPool,
+        bool doLogTimings = true);
+
+    /*
+     * When enabled, Run() runs all tasks one at a time on the calling thread, and
+     * fails when a stage modifies the memory of a resource it has not declared to
+     * write; undeclared reads go undetected. Meant for debugging declarations.
+     */
+    void SetAccessVerification(bool isEnabled)
+    {
+        mIsAccessVerificationEnabled = isEnabled;
+    }
+
+    /*
+     * When set, Run() runs all tasks one at a time on the calling thread - in an
+     * order compatible with their dependencies - and invokes the observer after
+     * each task that completes, e.g. for inspecting the state each task leaves
+     * behind. Survives Clear().
+     */
+    void SetTaskObserver(TaskObserver observer)
+    {
+        mTaskObserver = std::move(observer);
+    }
+
+    /*
+     * Forgets all tasks and resources, keeping the allocated capacity, so that the
+     * graph may be re-populated.
+     */
+    void Clear()
+    {
+        mTasks.clear();
+        mResources.clear();
+        mAreWavesValid = false;
+    }
+
+private:
+
+    struct TaskInfo
+    {
+        std::string Name;
+        Task Body;
+        std::vector<TaskId> Dependencies;
+        bool IsMainThreadOnly;
+        bool HasDeclaredAccesses;
+        std::vector<ResourceId> Writes;
+    };
+
+    struct ResourceInfo
+    {
+        std::string Name;
+        void const * Data;
+        size_t ByteSize;
+
+        // While adding stages
+        std::vector<TaskId> LastWriters;
+        std::vector<TaskId> ReadersSinceLastWrite;
+    };
+
+    void PrepareWaves();
+
+    void RunTask(
+        TaskId taskId,
+        bool doLogTimings);
+
+    void RunTaskVerifyingAccesses(TaskId taskId);
+
+private:
+
+    std::vector<TaskInfo> mTasks;
+    std::vector<ResourceInfo> mResources;
+
+    // Calculated at the first run after the graph changes
+    std::vector<std::vector<TaskId>> mWaves;
+    std::vector<std::vector<TaskThreadPool::Task>> mWavePoolTasks;
+    bool mAreWavesValid = false;
+
+    // While running: one error message per task, written only by the task itself
+    std::vector<std::string> mTaskErrors;
+    bool mDoLogTimings = false;
+
+    bool mIsAccessVerificationEnabled = false;
+    TaskObserver mTaskObserver;
+};
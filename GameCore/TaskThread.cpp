@@ -6,6 +6,7 @@
 #include "TaskThread.h"
 
 #include "Log.h"
+#include "Profiler.h"
 #include "SystemThreadManager.h"
 
 TaskThread::TaskThread()
@@ -13,7 +14,14 @@ TaskThread::TaskThread()
 {}
 
 TaskThread::TaskThread(bool doForceNoMultiThreading)
-    : mIsStop(false)
+    : TaskThread(doForceNoMultiThreading, SystemThreadManager::ThreadRole::Other)
+{}
+
+TaskThread::TaskThread(
+    bool doForceNoMultiThreading,
+    SystemThreadManager::ThreadRole role)
+    : mRole(role)
+    , mIsStop(false)
 {
     // Only use a real thread on multi-core boxes; on single-core
     // boxes, we'll just emulate multi-threading by running all
@@ -67,7 +75,9 @@ void TaskThread::ThreadLoop()
     // Initialize thread
     //
 
-    SystemThreadManager::GetInstance().InitializeThisThread();
+    SystemThreadManager::GetInstance().InitializeThisThread(mRole);
+
+    Profiler::GetInstance().SetCurrentThreadName("Task Thread");
 
     //
     // Run loop
@@ -5,6 +5,8 @@
 ***************************************************************************************/
 #pragma once
 
+#include "SystemThreadManager.h"
+
 #include <condition_variable>
 #include <deque>
 #include <functional>
@@ -66,6 +68,16 @@ public:
             }
         }
 
+        /*
+         * Invoked by main thread to check, without waiting, whether the task is completed;
+         * once it is, Wait() returns immediately.
+         */
+        bool IsCompleted()
+        {
+            std::unique_lock<std::mutex> lock(mThreadLock);
+            return mIsTaskCompleted;
+        }
+
     private:
 
         _TaskCompletionIndicatorImpl(
@@ -105,6 +117,10 @@ public:
     TaskThread();
     explicit TaskThread(bool doForceNoMultiThreading);
 
+    TaskThread(
+        bool doForceNoMultiThreading,
+        SystemThreadManager::ThreadRole role);
+
     ~TaskThread();
 
     TaskThread(TaskThread const & other) = delete;
@@ -112,6 +128,14 @@ public:
     TaskThread & operator=(TaskThread const & other) = delete;
     TaskThread & operator=(TaskThread && other) = delete;
 
+    /*
+     * Whether tasks run on a real thread, rather than synchronously on the caller's thread.
+     */
+    inline bool HasThread() const noexcept
+    {
+        return mHasThread;
+    }
+
     /*
      * Invoked on the main thread to queue a task that will run
      * on the task thread.
@@ -205,6 +229,8 @@ private:
 
 private:
 
+    SystemThreadManager::ThreadRole const mRole;
+
     std::thread mThread;
     bool mHasThread; // Invariant: mHasThread==true <=> mThread.joinable(); we only use the flag as the perf impact of checking is_joinable() is unknown
 
@@ -6,22 +6,33 @@
 #include "TaskThreadPool.h"
 
 #include "Log.h"
+#include "Profiler.h"
 #include "SystemThreadManager.h"
 
 #include <algorithm>
 
+// The number of times an idle worker thread looks for work before parking
+static size_t constexpr SpinCount = 256;
+
+// Set while the current thread is executing a work item
+static thread_local bool IsInWorkItem = false;
+
 TaskThreadPool::TaskThreadPool()
     : TaskThreadPool(SystemThreadManager::GetInstance().GetNumberOfProcessors())
 {
 }
 
 TaskThreadPool::TaskThreadPool(size_t numberOfProcessors)
-    : mLock()
-    , mThreads()
-    , mWorkerThreadSignal()
-    , mMainThreadSignal()
-    , mRemainingTasks()
-    , mTasksToComplete(0)
+    : mThreads()
+    , mDeques()
+    , mPendingElementCount(0)
+    , mHasException(false)
+    , mExceptionLock()
+    , mException()
+    , mWorkEpoch(0)
+    , mParkedThreadCount(0)
+    , mParkLock()
+    , mParkSignal()
     , mIsStop(false)
 {
     assert(numberOfProcessors > 0);
@@ -32,10 +43,16 @@ TaskThreadPool::TaskThreadPool(size_t numberOfProcessors)
     LogMessage("TaskThreadPool: number of processors: ", numberOfProcessors,
         " number of threads in pool: ", threadCount);
 
+    // Create deques - one for the main thread plus one for each thread
+    for (size_t i = 0; i < threadCount + 1; ++i)
+    {
+        mDeques.emplace_back(std::make_unique<WorkStealingDeque>());
+    }
+
     // Start threads
     for (size_t i = 0; i < threadCount; ++i)
     {
-        mThreads.emplace_back(&TaskThreadPool::ThreadLoop, this);
+        mThreads.emplace_back(&TaskThreadPool::ThreadLoop, this, i + 1);
     }
 }
 
@@ -43,13 +60,14 @@ TaskThreadPool::~TaskThreadPool()
 {
     // Tell all threads to stop
     {
-        std::unique_lock const lock{ mLock };
+        std::unique_lock const lock{ mParkLock };
 
         mIsStop = true;
+        ++mWorkEpoch;
     }
 
     // Signal threads
-    mWorkerThreadSignal.notify_all();
+    mParkSignal.notify_all();
 
     // Wait for all threads to exit
     for (auto & t : mThreads)
@@ -60,157 +78,251 @@ TaskThreadPool::~TaskThreadPool()
 
 void TaskThreadPool::Run(std::vector<Task> const & tasks)
 {
-    assert(mRemainingTasks.empty());
-    assert(0 == mTasksToComplete);
+    if (tasks.empty())
+        return;
 
-    // Queue all the tasks except the first one,
-    // which we're gonna run immediately now to guarantee
-    // that the first task always runs on the main thread
+    WorkItem::InvokeFunction const invoke =
+        [](void const * context, size_t chunkStart, size_t chunkEnd)
+        {
+            auto const & tasks = *reinterpret_cast<std::vector<Task> const *>(context);
+            for (size_t t = chunkStart; t < chunkEnd; ++t)
+            {
+                RunTask(tasks[t]);
+            }
+        };
+
+    // Run the first task on the main thread, and make all the
+    // others available to everyone, one task at a time
+    WorkItem const mainThreadItem(invoke, &tasks, 0, 1, 1);
+
+    RunRange(
+        WorkItem(invoke, &tasks, 1, tasks.size(), 1),
+        &mainThreadItem);
+}
+
+void TaskThreadPool::RunRange(
+    WorkItem const & rangeItem,
+    WorkItem const * mainThreadItem)
+{
+    if (IsInWorkItem)
     {
-        std::unique_lock const lock{ mLock };
+        // Nested invocation - run everything inline
+        if (nullptr != mainThreadItem)
+        {
+            mainThreadItem->Invoke(mainThreadItem->Context, mainThreadItem->Start, mainThreadItem->End);
+        }
 
-        for (size_t t = 1; t < tasks.size(); ++t)
+        if (rangeItem.Start < rangeItem.End)
         {
-            mRemainingTasks.push_back(tasks[t]);
+            rangeItem.Invoke(rangeItem.Context, rangeItem.Start, rangeItem.End);
         }
 
-        mTasksToComplete = mRemainingTasks.size();
+        return;
     }
 
-    // Signal threads
-    mWorkerThreadSignal.notify_all();
+    assert(0 == mPendingElementCount.load());
+
+    size_t const rangeElementCount = rangeItem.End - rangeItem.Start;
+    size_t const mainThreadElementCount = (nullptr != mainThreadItem)
+        ? mainThreadItem->End - mainThreadItem->Start
+        : 0;
 
-    // Run the first task on the main thread
-    if (!tasks.empty())
+    mPendingElementCount.store(rangeElementCount + mainThreadElementCount);
+
+    // Make the range available to the other threads
+    if (rangeElementCount > 0)
     {
-        RunTask(tasks.front());
+        bool const isPushed = mDeques[0]->Push(rangeItem);
+        assert(isPushed); // Our deque is empty at this moment
+        (void)isPushed;
+
+        WakeUpWorkers();
     }
 
-    // Run the remaining tasks on own thread, if needed
-    RunRemainingTasksLoop();
+    // Run the main thread's item, if any
+    if (nullptr != mainThreadItem)
+    {
+        ExecuteWorkItem(0, *mainThreadItem);
+    }
 
-    // Only returns when there are no more tasks
-    assert(mRemainingTasks.empty());
+    // Participate in the work until all elements have completed
+    while (mPendingElementCount.load(std::memory_order_acquire) != 0)
+    {
+        WorkItem item;
+        if (TryGetWork(0, item))
+        {
+            ExecuteWorkItem(0, item);
+        }
+        else
+        {
+            // Remaining work is being executed by other threads
+            std::this_thread::yield();
+        }
+    }
 
-    // Wait until all tasks are completed
+    // Rethrow the first exception thrown by the work items, if any
+    if (mHasException.load(std::memory_order_acquire))
     {
-        std::unique_lock lock{ mLock };
+        std::exception_ptr exception;
 
-        if (0 != mTasksToComplete)
         {
-            // Wait for signal
-            mMainThreadSignal.wait(
-                lock,
-                [this]
-                {
-                    return 0 == mTasksToComplete;
-                });
+            std::unique_lock const lock{ mExceptionLock };
 
-            assert(0 == mTasksToComplete);
+            exception = std::move(mException);
+            mException = nullptr;
+            mHasException = false;
         }
+
+        std::rethrow_exception(exception);
     }
 }
 
-void TaskThreadPool::ThreadLoop()
+void TaskThreadPool::ThreadLoop(size_t dequeIndex)
 {
     //
     // Initialize thread
     //
 
-    SystemThreadManager::GetInstance().InitializeThisThread();
+    SystemThreadManager::GetInstance().InitializeThisThread(SystemThreadManager::ThreadRole::Simulation);
+
+    Profiler::GetInstance().SetCurrentThreadName("Pool Worker " + std::to_string(dequeIndex));
 
     //
     // Run thread loop until thread pool is destroyed
     //
 
-    while (true)
+    while (!mIsStop.load(std::memory_order_relaxed))
     {
-        {
-            std::unique_lock lock{ mLock };
+        // Remember the epoch at which we start looking for work,
+        // so that we don't park if work has been made available since
+        std::uint64_t const workEpoch = mWorkEpoch.load();
 
-            if (mIsStop)
+        // Spin for a while looking for work
+        bool hasRunWork = false;
+        for (size_t s = 0; s < SpinCount && !mIsStop.load(std::memory_order_relaxed); ++s)
+        {
+            WorkItem item;
+            if (TryGetWork(dequeIndex, item))
             {
-                // We're done!
+                ExecuteWorkItem(dequeIndex, item);
+                hasRunWork = true;
                 break;
             }
 
-            // Wait for signal
-            mWorkerThreadSignal.wait(
+            std::this_thread::yield();
+        }
+
+        if (hasRunWork)
+            continue;
+
+        // Park
+        {
+            std::unique_lock lock{ mParkLock };
+
+            ++mParkedThreadCount;
+
+            mParkSignal.wait(
                 lock,
-                [this]
+                [this, workEpoch]
                 {
-                    return mIsStop || !mRemainingTasks.empty();
+                    return mIsStop || mWorkEpoch.load() != workEpoch;
                 });
 
-            if (mIsStop)
-            {
-                // We're done!
-                break;
-            }
+            --mParkedThreadCount;
         }
-
-        // Tasks have been queued...
-
-        // ...run the remaining tasks
-        RunRemainingTasksLoop();
     }
 
     LogMessage("Thread exiting");
 }
 
-void TaskThreadPool::RunRemainingTasksLoop()
+bool TaskThreadPool::TryGetWork(
+    size_t dequeIndex,
+    WorkItem & item)
 {
-    //
-    // Run tasks until queue is empty
-    //
+    // Own deque first...
+    if (mDeques[dequeIndex]->Pop(item))
+        return true;
 
-    while (true)
+    // ...then steal from the others
+    for (size_t d = 1; d < mDeques.size(); ++d)
     {
-        //
-        // De-queue a task
-        //
+        if (mDeques[(dequeIndex + d) % mDeques.size()]->Steal(item))
+            return true;
+    }
 
-        Task task;
-        {
-            std::unique_lock const lock{ mLock };
+    return false;
+}
 
-            if (!mRemainingTasks.empty())
-            {
-                task = std::move(mRemainingTasks.front());
-                mRemainingTasks.pop_front();
-            }
-        }
+void TaskThreadPool::ExecuteWorkItem(
+    size_t dequeIndex,
+    WorkItem item)
+{
+    // Split the item until it's small enough, making the upper
+    // halves available to the other threads
+    while (item.End - item.Start > item.Grain)
+    {
+        WorkItem upperHalf = item;
+        upperHalf.Start = item.Start + (item.End - item.Start) / 2;
 
-        if (!task)
+        if (!mDeques[dequeIndex]->Push(upperHalf))
         {
-            // No more tasks
-            return;
+            // Deque is full, run what we have
+            break;
         }
 
-        //
-        // Run the task
-        //
+        item.End = upperHalf.Start;
 
-        RunTask(task);
+        WakeUpWorkers();
+    }
 
-        //
-        // Signal task completion
-        //
+    IsInWorkItem = true;
 
-        {
-            std::unique_lock const lock{ mLock };
+    try
+    {
+        item.Invoke(item.Context, item.Start, item.End);
+    }
+    catch (std::exception const & e)
+    {
+        LogMessage("Error running work item: " + std::string(e.what()));
 
-            assert(mTasksToComplete > 0);
+        RecordException(std::current_exception());
+    }
+    catch (...)
+    {
+        LogMessage("Error running work item");
 
-            --mTasksToComplete;
-            if (0 == mTasksToComplete)
-            {
-                // All tasks completed...
+        RecordException(std::current_exception());
+    }
 
-                // ...signal main thread
-                mMainThreadSignal.notify_all();
-            }
+    IsInWorkItem = false;
+
+    // Regardless of the outcome, so that the invoker doesn't wait forever
+    mPendingElementCount.fetch_sub(item.End - item.Start, std::memory_order_acq_rel);
+}
+
+void TaskThreadPool::WakeUpWorkers()
+{
+    ++mWorkEpoch;
+
+    if (mParkedThreadCount.load() > 0)
+    {
+        {
+            // Serialize with threads about to park
+            std::unique_lock const lock{ mParkLock };
         }
+
+        mParkSignal.notify_all();
+    }
+}
+
+void TaskThreadPool::RecordException(std::exception_ptr exception)
+{
+    std::unique_lock const lock{ mExceptionLock };
+
+    if (!mException)
+    {
+        mException = std::move(exception);
+        mHasException = true;
     }
 }
 
@@ -228,4 +340,84 @@ void TaskThreadPool::RunTask(Task const & task)
 
         // Keep going...
     }
-}
\ No newline at end of file
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////
+
+bool TaskThreadPool::WorkStealingDeque::Push(WorkItem const & item)
+{
+    std::int64_t const bottom = mBottom.load(std::memory_order_relaxed);
+    std::int64_t const top = mTop.load(std::memory_order_acquire);
+
+    if (bottom - top >= static_cast<std::int64_t>(Capacity))
+    {
+        // Full
+        return false;
+    }
+
+    mItems[static_cast<size_t>(bottom) & (Capacity - 1)] = item;
+
+    std::atomic_thread_fence(std::memory_order_release);
+
+    mBottom.store(bottom + 1, std::memory_order_relaxed);
+
+    return true;
+}
+
+bool TaskThreadPool::WorkStealingDeque::Pop(WorkItem & item)
+{
+    std::int64_t const bottom = mBottom.load(std::memory_order_relaxed) - 1;
+    mBottom.store(bottom, std::memory_order_relaxed);
+
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+
+    std::int64_t top = mTop.load(std::memory_order_relaxed);
+
+    if (top > bottom)
+    {
+        // Empty
+        mBottom.store(bottom + 1, std::memory_order_relaxed);
+        return false;
+    }
+
+    item = mItems[static_cast<size_t>(bottom) & (Capacity - 1)];
+
+    if (top == bottom)
+    {
+        // Last item, race against thieves
+        bool const isWon = mTop.compare_exchange_strong(
+            top,
+            top + 1,
+            std::memory_order_seq_cst,
+            std::memory_order_relaxed);
+
+        mBottom.store(bottom + 1, std::memory_order_relaxed);
+
+        return isWon;
+    }
+
+    return true;
+}
+
+bool TaskThreadPool::WorkStealingDeque::Steal(WorkItem & item)
+{
+    std::int64_t top = mTop.load(std::memory_order_acquire);
+
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+
+    std::int64_t const bottom = mBottom.load(std::memory_order_acquire);
+
+    if (top >= bottom)
+    {
+        // Empty
+        return false;
+    }
+
+    item = mItems[static_cast<size_t>(top) & (Capacity - 1)];
+
+    return mTop.compare_exchange_strong(
+        top,
+        top + 1,
+        std::memory_order_seq_cst,
+        std::memory_order_relaxed);
+}
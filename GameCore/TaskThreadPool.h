@@ -5,17 +5,30 @@
 ***************************************************************************************/
 #pragma once
 
+#include <algorithm>
+#include <atomic>
 #include <cassert>
 #include <condition_variable>
+#include <cstdint>
+#include <exception>
 #include <functional>
+#include <memory>
 #include <mutex>
-#include <deque>
 #include <thread>
 #include <vector>
 
 /*
- * This class implements a thread pool that executes batches of tasks.
+ * This class implements a work-stealing thread pool that executes batches of tasks
+ * and parallel loops.
  *
+ * Each thread - including the thread invoking the pool, which always participates
+ * in the work - owns a lock-free deque of work items. Threads split large work items
+ * in halves, pushing one half in their own deque and continuing with the other, while
+ * idle threads steal from the other end of the other threads' deques. Idle worker
+ * threads spin for a short while before parking.
+ *
+ * The pool is meant to be invoked from one thread at a time; work items that
+ * invoke the pool themselves have their nested work run inline on their own thread.
  */
 class TaskThreadPool
 {
@@ -31,6 +44,14 @@ public:
 
     ~TaskThreadPool();
 
+    /*
+     * Returns the number of tasks that may run concurrently, including the main thread.
+     */
+    size_t GetParallelism() const
+    {
+        return mThreads.size() + 1;
+    }
+
     /*
      * The first task is guaranteed to run on the main thread.
      */
@@ -45,35 +66,149 @@ public:
         tasks.clear();
     }
 
+    /*
+     * Invokes func(chunkStart, chunkEnd) over [start, end), in chunks of at
+     * least grain elements, and returns when all chunks have completed.
+     *
+     * The function is invoked by reference and never copied, hence there are no
+     * allocations.
+     *
+     * If chunks throw, the other chunks still run to completion, and then the
+     * first exception is rethrown to the caller.
+     */
+    template<typename TFunc>
+    void ParallelFor(
+        size_t start,
+        size_t end,
+        size_t grain,
+        TFunc const & func)
+    {
+        if (start >= end)
+            return;
+
+        RunRange(
+            WorkItem(
+                [](void const * context, size_t chunkStart, size_t chunkEnd)
+                {
+                    (*reinterpret_cast<TFunc const *>(context))(chunkStart, chunkEnd);
+                },
+                reinterpret_cast<void const *>(&func),
+                start,
+                end,
+                std::max(grain, size_t(1))),
+            nullptr);
+    }
+
 private:
 
-    void ThreadLoop();
+    struct WorkItem
+    {
+        using InvokeFunction = void(*)(void const * context, size_t chunkStart, size_t chunkEnd);
+
+        InvokeFunction Invoke;
+        void const * Context;
+        size_t Start;
+        size_t End; // Excluded
+        size_t Grain;
+
+        WorkItem() = default;
+
+        WorkItem(
+            InvokeFunction invoke,
+            void const * context,
+            size_t start,
+            size_t end,
+            size_t grain)
+            : Invoke(invoke)
+            , Context(context)
+            , Start(start)
+            , End(end)
+            , Grain(grain)
+        {}
+    };
+
+    /*
+     * Bounded Chase-Lev deque; the owner pushes and pops at the bottom,
+     * thieves steal from the top.
+     */
+    class WorkStealingDeque
+    {
+    public:
 
-    void RunRemainingTasksLoop();
+        WorkStealingDeque()
+            : mTop(0)
+            , mBottom(0)
+            , mItems()
+        {}
 
-    void RunTask(Task const & task);
+        // Owner only; returns false when full
+        bool Push(WorkItem const & item);
+
+        // Owner only
+        bool Pop(WorkItem & item);
+
+        // Any thread
+        bool Steal(WorkItem & item);
+
+    private:
+
+        static size_t constexpr Capacity = 256; // Must be a power of two
+
+        alignas(64) std::atomic<std::int64_t> mTop;
+        alignas(64) std::atomic<std::int64_t> mBottom;
+        WorkItem mItems[Capacity];
+    };
 
 private:
 
-    // Our thread lock
-    std::mutex mLock;
+    void RunRange(
+        WorkItem const & rangeItem,
+        WorkItem const * mainThreadItem);
+
+    void ThreadLoop(size_t dequeIndex);
+
+    bool TryGetWork(
+        size_t dequeIndex,
+        WorkItem & item);
+
+    void ExecuteWorkItem(
+        size_t dequeIndex,
+        WorkItem item);
+
+    void WakeUpWorkers();
+
+    void RecordException(std::exception_ptr exception);
+
+    static void RunTask(Task const & task);
+
+private:
 
     // Our threads
     std::vector<std::thread> mThreads;
 
-    // The condition variable to wake up threads
-    std::condition_variable mWorkerThreadSignal;
+    // The deques - one for each thread; the first one is
+    // the main thread's
+    std::vector<std::unique_ptr<WorkStealingDeque>> mDeques;
+
+    // The number of elements still awaiting for completion
+    std::atomic<size_t> mPendingElementCount;
+
+    // The first exception thrown by a work item of the current range, rethrown
+    // to the invoker once the range has completed
+    std::atomic<bool> mHasException;
+    std::mutex mExceptionLock;
+    std::exception_ptr mException;
 
-    // The condition variable to wake up the main thread
-    std::condition_variable mMainThreadSignal;
+    // Incremented each time new work is made available, to wake up parked threads
+    std::atomic<std::uint64_t> mWorkEpoch;
 
-    // The tasks currently awaiting to be picked up;
-    // expected to be empty at each Run invocation
-    std::deque<Task> mRemainingTasks;
+    // The number of threads currently parked
+    std::atomic<size_t> mParkedThreadCount;
 
-    // The number of tasks awaiting for completion
-    size_t mTasksToComplete;
+    // The lock and condition variable for parking threads
+    std::mutex mParkLock;
+    std::condition_variable mParkSignal;
 
     // Set to true when have to stop
-    bool mIsStop;
+    std::atomic<bool> mIsStop;
 };
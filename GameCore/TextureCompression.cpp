@@ -0,0 +1,377 @@
+/***************************************************************************************
+* Original Author:      Gabriele Giuseppini
+* Created:              2026-10-14
+* Copyright:            Gabriele Giuseppini  (https://github.com/GabrieleGiuseppini)
+***************************************************************************************/
+#include "TextureCompression.h"
+
+#include "ImageTools.h"
+#include "TaskThreadPool.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <limits>
+
+namespace {
+
+inline std::uint16_t ToRgb565(vec3f const & color)
+{
+    int const r = std::clamp(static_cast<int>(color.x * 31.0f / 255.0f + 0.5f), 0, 31);
+    int const g = std::clamp(static_cast<int>(color.y * 63.0f / 255.0f + 0.5f), 0, 63);
+    int const b = std::clamp(static_cast<int>(color.z * 31.0f / 255.0f + 0.5f), 0, 31);
+
+    return static_cast<std::uint16_t>((r << 11) | (g << 5) | b);
+}
+
+inline vec3f FromRgb565(std::uint16_t color)
+{
+    int const r = (color >> 11) & 0x1f;
+    int const g = (color >> 5) & 0x3f;
+    int const b = color & 0x1f;
+
+    return vec3f(
+        static_cast<float>((r << 3) | (r >> 2)),
+        static_cast<float>((g << 2) | (g >> 4)),
+        static_cast<float>((b << 3) | (b >> 2)));
+}
+
+// The four colors of a color block, in index order
+inline void MakeColorPalette(
+    std::uint16_t color0,
+    std::uint16_t color1,
+    vec3f (&palette)[4])
+{
+    palette[0] = FromRgb565(color0);
+    palette[1] = FromRgb565(color1);
+    palette[2] = (palette[0] * 2.0f + palette[1]) / 3.0f;
+    palette[3] = (palette[0] + palette[1] * 2.0f) / 3.0f;
+}
+
+// The eight alphas of an alpha block, in index order, with alpha0 > alpha1
+inline void MakeAlphaPalette(
+    std::uint8_t alpha0,
+    std::uint8_t alpha1,
+    int (&palette)[8])
+{
+    palette[0] = alpha0;
+    palette[1] = alpha1;
+
+    if (alpha0 > alpha1)
+    {
+        for (int i = 2; i < 8; ++i)
+            palette[i] = ((8 - i) * alpha0 + (i - 1) * alpha1) / 7;
+    }
+    else
+    {
+        for (int i = 2; i < 6; ++i)
+            palette[i] = ((6 - i) * alpha0 + (i - 1) * alpha1) / 5;
+
+        palette[6] = 0;
+        palette[7] = 255;
+    }
+}
+
+inline void WriteUInt16(std::uint16_t value, std::uint8_t * data)
+{
+    data[0] = static_cast<std::uint8_t>(value & 0xff);
+    data[1] = static_cast<std::uint8_t>(value >> 8);
+}
+
+inline std::uint16_t ReadUInt16(std::uint8_t const * data)
+{
+    return static_cast<std::uint16_t>(data[0] | (data[1] << 8));
+}
+
+}
+
+TextureCompression::CompressedImage TextureCompression::CompressBC3(
+    RgbaImageData const & image,
+    TaskThreadPool * taskThreadPool)
+{
+    int const blocksWidth = (image.Size.width + 3) / 4;
+    int const blocksHeight = (image.Size.height + 3) / 4;
+
+    std::vector<std::uint8_t> data(static_cast<size_t>(blocksWidth) * static_cast<size_t>(blocksHeight) * BC3BlockByteSize);
+
+    auto const compressBlockRows = [&](size_t blockRowStart, size_t blockRowEnd)
+    {
+        rgbaColor block[16];
+
+        for (int by = static_cast<int>(blockRowStart); by < static_cast<int>(blockRowEnd); ++by)
+        {
+            for (int bx = 0; bx < blocksWidth; ++bx)
+            {
+                // Gather block, replicating the edges
+                for (int y = 0; y < 4; ++y)
+                {
+                    int const imageY = std::min(by * 4 + y, image.Size.height - 1);
+                    for (int x = 0; x < 4; ++x)
+                    {
+                        int const imageX = std::min(bx * 4 + x, image.Size.width - 1);
+                        block[y * 4 + x] = image.Data[imageY * image.Size.width + imageX];
+                    }
+                }
+
+                CompressBC3Block(
+                    block,
+                    data.data() + (static_cast<size_t>(by) * blocksWidth + bx) * BC3BlockByteSize);
+            }
+        }
+    };
+
+    if (taskThreadPool != nullptr)
+    {
+        // Enough blocks per task to amortize their scheduling
+        size_t constexpr MinBlocksPerTask = 1024;
+
+        taskThreadPool->ParallelFor(
+            0,
+            static_cast<size_t>(blocksHeight),
+            std::max(MinBlocksPerTask / static_cast<size_t>(std::max(blocksWidth, 1)), size_t(1)),
+            compressBlockRows);
+    }
+    else
+    {
+        compressBlockRows(0, static_cast<size_t>(blocksHeight));
+    }
+
+    return CompressedImage(image.Size, std::move(data));
+}
+
+std::vector<TextureCompression::CompressedImage> TextureCompression::CompressMipmappedBC3(
+    RgbaImageData const & image,
+    TaskThreadPool * taskThreadPool)
+{
+    std::vector<CompressedImage> levels;
+
+    levels.emplace_back(CompressBC3(image, taskThreadPool));
+
+    RgbaImageData previousLevel = image.Clone();
+    while (previousLevel.Size.width > 1 || previousLevel.Size.height > 1)
+    {
+        RgbaImageData level = ImageTools::Downsample(
+            previousLevel,
+            ImageSize(
+                std::max(1, previousLevel.Size.width / 2),
+                std::max(1, previousLevel.Size.height / 2)));
+
+        levels.emplace_back(CompressBC3(level, taskThreadPool));
+
+        previousLevel = std::move(level);
+    }
+
+    return levels;
+}
+
+RgbaImageData TextureCompression::DecompressBC3(CompressedImage const & compressedImage)
+{
+    ImageSize const & size = compressedImage.Size;
+    int const blocksWidth = (size.width + 3) / 4;
+
+    RgbaImageData image(size);
+
+    for (int y = 0; y < size.height; ++y)
+    {
+        for (int x = 0; x < size.width; ++x)
+        {
+            std::uint8_t const * const blockData =
+                compressedImage.Data.data()
+                + (static_cast<size_t>(y / 4) * blocksWidth + x / 4) * BC3BlockByteSize;
+
+            int const texel = (y % 4) * 4 + (x % 4);
+
+            // Alpha
+            int alphaPalette[8];
+            MakeAlphaPalette(blockData[0], blockData[1], alphaPalette);
+
+            std::uint64_t alphaIndices = 0;
+            for (int b = 0; b < 6; ++b)
+                alphaIndices |= static_cast<std::uint64_t>(blockData[2 + b]) << (8 * b);
+
+            int const alpha = alphaPalette[(alphaIndices >> (3 * texel)) & 0x7];
+
+            // Color
+            vec3f colorPalette[4];
+            MakeColorPalette(ReadUInt16(blockData + 8), ReadUInt16(blockData + 10), colorPalette);
+
+            std::uint32_t const colorIndices =
+                static_cast<std::uint32_t>(blockData[12])
+                | (static_cast<std::uint32_t>(blockData[13]) << 8)
+                | (static_cast<std::uint32_t>(blockData[14]) << 16)
+                | (static_cast<std::uint32_t>(blockData[15]) << 24);
+
+            vec3f const & color = colorPalette[(colorIndices >> (2 * texel)) & 0x3];
+
+            image.Data[y * size.width + x] = rgbaColor(
+                static_cast<rgbaColor::data_type>(color.x + 0.5f),
+                static_cast<rgbaColor::data_type>(color.y + 0.5f),
+                static_cast<rgbaColor::data_type>(color.z + 0.5f),
+                static_cast<rgbaColor::data_type>(alpha));
+        }
+    }
+
+    return image;
+}
+
+void TextureCompression::CompressBC3Block(
+    rgbaColor const (&block)[16],
+    std::uint8_t * blockData)
+{
+    //
+    // Alpha block: the extremes of the block's alpha, with eight levels in between
+    //
+
+    std::uint8_t minAlpha = 255;
+    std::uint8_t maxAlpha = 0;
+    for (auto const & c : block)
+    {
+        minAlpha = std::min(minAlpha, c.a);
+        maxAlpha = std::max(maxAlpha, c.a);
+    }
+
+    blockData[0] = maxAlpha;
+    blockData[1] = minAlpha;
+
+    std::uint64_t alphaIndices = 0;
+    if (maxAlpha > minAlpha)
+    {
+        float const alphaRange = static_cast<float>(maxAlpha - minAlpha);
+        for (int t = 0; t < 16; ++t)
+        {
+            // Position in [0 = min, 7 = max]...
+            int const level = static_cast<int>(static_cast<float>(block[t].a - minAlpha) * 7.0f / alphaRange + 0.5f);
+
+            // ...to index: 0 is max, 1 is min, and 2-7 go from max to min
+            std::uint64_t const index = (level == 7) ? 0 : ((level == 0) ? 1 : static_cast<std::uint64_t>(8 - level));
+
+            alphaIndices |= index << (3 * t);
+        }
+    }
+
+    for (int b = 0; b < 6; ++b)
+        blockData[2 + b] = static_cast<std::uint8_t>((alphaIndices >> (8 * b)) & 0xff);
+
+    //
+    // Color block: the extremes along the principal axis of the block's colors,
+    // ignoring the fully-transparent texels as their colors are never seen
+    //
+
+    bool const hasVisibleTexels = std::any_of(
+        std::cbegin(block),
+        std::cend(block),
+        [](rgbaColor const & c) { return c.a > 0; });
+
+    auto const isFittedTexel = [&](int t)
+    {
+        return !hasVisibleTexels || block[t].a > 0;
+    };
+
+    vec3f mean = vec3f::zero();
+    float fittedCount = 0.0f;
+    for (int t = 0; t < 16; ++t)
+    {
+        if (isFittedTexel(t))
+        {
+            mean += block[t].toVec3f() * 255.0f;
+            fittedCount += 1.0f;
+        }
+    }
+
+    mean = mean / fittedCount;
+
+    // Covariance
+    float cov[6] = { 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f }; // rr, rg, rb, gg, gb, bb
+    for (int t = 0; t < 16; ++t)
+    {
+        if (isFittedTexel(t))
+        {
+            vec3f const d = block[t].toVec3f() * 255.0f - mean;
+            cov[0] += d.x * d.x;
+            cov[1] += d.x * d.y;
+            cov[2] += d.x * d.z;
+            cov[3] += d.y * d.y;
+            cov[4] += d.y * d.z;
+            cov[5] += d.z * d.z;
+        }
+    }
+
+    // Principal axis, via a few power iterations starting from the covariance's column
+    // with the largest variance, which is never orthogonal to it
+    vec3f axis;
+    if (cov[0] >= cov[3] && cov[0] >= cov[5] && cov[0] > 0.0f)
+        axis = vec3f(cov[0], cov[1], cov[2]).normalise();
+    else if (cov[3] >= cov[5] && cov[3] > 0.0f)
+        axis = vec3f(cov[1], cov[3], cov[4]).normalise();
+    else if (cov[5] > 0.0f)
+        axis = vec3f(cov[2], cov[4], cov[5]).normalise();
+    else
+        axis = vec3f(1.0f, 1.0f, 1.0f).normalise(); // All the same color
+
+    for (int i = 0; i < 4; ++i)
+    {
+        vec3f const next(
+            cov[0] * axis.x + cov[1] * axis.y + cov[2] * axis.z,
+            cov[1] * axis.x + cov[3] * axis.y + cov[4] * axis.z,
+            cov[2] * axis.x + cov[4] * axis.y + cov[5] * axis.z);
+
+        float const length = next.length();
+        if (length < 1e-6f)
+            break;
+
+        axis = next / length;
+    }
+
+    float minProjection = std::numeric_limits<float>::max();
+    float maxProjection = std::numeric_limits<float>::lowest();
+    for (int t = 0; t < 16; ++t)
+    {
+        if (isFittedTexel(t))
+        {
+            float const projection = (block[t].toVec3f() * 255.0f - mean).dot(axis);
+            minProjection = std::min(minProjection, projection);
+            maxProjection = std::max(maxProjection, projection);
+        }
+    }
+
+    std::uint16_t color0 = ToRgb565(mean + axis * maxProjection);
+    std::uint16_t color1 = ToRgb565(mean + axis * minProjection);
+
+    // Four-color mode requires color0 > color1
+    if (color0 < color1)
+        std::swap(color0, color1);
+
+    WriteUInt16(color0, blockData + 8);
+    WriteUInt16(color1, blockData + 10);
+
+    std::uint32_t colorIndices = 0;
+    if (color0 != color1)
+    {
+        vec3f palette[4];
+        MakeColorPalette(color0, color1, palette);
+
+        for (int t = 0; t < 16; ++t)
+        {
+            vec3f const color = block[t].toVec3f() * 255.0f;
+
+            std::uint32_t bestIndex = 0;
+            float bestDistance = std::numeric_limits<float>::max();
+            for (std::uint32_t i = 0; i < 4; ++i)
+            {
+                float const distance = (color - palette[i]).squareLength();
+                if (distance < bestDistance)
+                {
+                    bestDistance = distance;
+                    bestIndex = i;
+                }
+            }
+
+            colorIndices |= bestIndex << (2 * t);
+        }
+    }
+
+    blockData[12] = static_cast<std::uint8_t>(colorIndices & 0xff);
+    blockData[13] = static_cast<std::uint8_t>((colorIndices >> 8) & 0xff);
+    blockData[14] = static_cast<std::uint8_t>((colorIndices >> 16) & 0xff);
+    blockData[15] = static_cast<std::uint8_t>((colorIndices >> 24) & 0xff);
+}
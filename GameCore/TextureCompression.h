@@ -0,0 +1,66 @@
+/***************************************************************************************
+* Original Author:      Gabriele Giuseppini
+* Created:              2026-10-14
+* Copyright:            Gabriele Giuseppini  (https://github.com/GabrieleGiuseppini)
+***************************************************************************************/
+#pragma once
+
+#include "GameTypes.h"
+#include "ImageData.h"
+
+#include <cstdint>
+#include <vector>
+
+class TaskThreadPool;
+
+/*
+ * Real-time compression of images into GPU block-compressed formats.
+ *
+ * We only do BC3 (a.k.a. DXT5): it keeps a full alpha channel, and - differently from BC7 -
+ * a good-quality BC3 block may be found with a closed-form fit rather than a search over
+ * partitionings, which makes it cheap enough to compress large textures at load time.
+ *
+ * Each 4x4 block takes 16 bytes, i.e. a quarter of its uncompressed RGBA size; blocks are
+ * laid out in the same row order as the image, with the image edges replicated into the
+ * blocks that straddle them.
+ */
+class TextureCompression
+{
+public:
+
+    struct CompressedImage
+    {
+        ImageSize Size; // In pixels
+        std::vector<std::uint8_t> Data;
+
+        CompressedImage(
+            ImageSize size,
+            std::vector<std::uint8_t> && data)
+            : Size(size)
+            , Data(std::move(data))
+        {}
+    };
+
+    static size_t constexpr BC3BlockByteSize = 16;
+
+    static CompressedImage CompressBC3(
+        RgbaImageData const & image,
+        TaskThreadPool * taskThreadPool = nullptr);
+
+    /*
+     * Compresses the image together with all of its mipmaps, down to 1x1, each minified
+     * from the previous one with a box filter.
+     */
+    static std::vector<CompressedImage> CompressMipmappedBC3(
+        RgbaImageData const & image,
+        TaskThreadPool * taskThreadPool = nullptr);
+
+    // Unit-tested
+    static RgbaImageData DecompressBC3(CompressedImage const & compressedImage);
+
+private:
+
+    static void CompressBC3Block(
+        rgbaColor const (&block)[16],
+        std::uint8_t * blockData);
+};
@@ -6,8 +6,11 @@
 #include "GameOpenGL.h"
 
 #include <GameCore/SysSpecifics.h>
+#include <GameCore/TaskThreadPool.h>
 
 #include <algorithm>
+#include <cstdint>
+#include <cstring>
 #include <memory>
 #include <numeric>
 
@@ -22,6 +25,14 @@ int GameOpenGL::MaxSupportedOpenGLVersionMinor = 0;
 
 bool GameOpenGL::AvoidGlFinish = false;
 
+bool GameOpenGL::SupportsPersistentMappedBuffers = false;
+bool GameOpenGL::SupportsMultiDrawIndirect = false;
+bool GameOpenGL::SupportsTimerQueries = false;
+bool GameOpenGL::SupportsPixelBufferObjects = false;
+bool GameOpenGL::SupportsBC3TextureCompression = false;
+bool GameOpenGL::SupportsHalfFloatVertexAttributes = false;
+bool GameOpenGL::SupportsDirectStateAccess = false;
+
 #ifdef _DEBUG
 
 static void APIENTRY OpenGLDebugCallback(
@@ -144,6 +155,58 @@ void GameOpenGL::InitOpenGL()
 
     LogMessage("AvoidGlFinish=", AvoidGlFinish);
 
+    // Use persistently-mapped buffers when we've got both buffer storage and fences
+
+    SupportsPersistentMappedBuffers =
+        glBufferStorage != nullptr
+        && glMapBufferRange != nullptr
+        && glFenceSync != nullptr;
+
+    LogMessage("SupportsPersistentMappedBuffers=", SupportsPersistentMappedBuffers);
+
+    // Use indirect multi-draws when available
+
+    SupportsMultiDrawIndirect = glMultiDrawElementsIndirect != nullptr;
+
+    LogMessage("SupportsMultiDrawIndirect=", SupportsMultiDrawIndirect);
+
+    // Measure GPU time when we've got timer queries
+
+    SupportsTimerQueries = glGetQueryObjectui64v != nullptr;
+
+    LogMessage("SupportsTimerQueries=", SupportsTimerQueries);
+
+    // Stage texture uploads when we've got pixel buffer objects and buffer mapping
+
+    SupportsPixelBufferObjects =
+        HasPixelBufferObject
+        && glMapBuffer != nullptr
+        && glUnmapBuffer != nullptr;
+
+    LogMessage("SupportsPixelBufferObjects=", SupportsPixelBufferObjects);
+
+    // Compress large textures when we've got S3TC
+
+    SupportsBC3TextureCompression =
+        HasTextureCompressionS3tc
+        && glCompressedTexImage2D != nullptr;
+
+    LogMessage("SupportsBC3TextureCompression=", SupportsBC3TextureCompression);
+
+    // Halve the size of low-precision vertex attributes when we've got half floats
+
+    SupportsHalfFloatVertexAttributes = HasHalfFloatVertex;
+
+    LogMessage("SupportsHalfFloatVertexAttributes=", SupportsHalfFloatVertexAttributes);
+
+    // Update buffers and textures without binding them when we've got direct state access
+
+    SupportsDirectStateAccess =
+        glNamedBufferSubData != nullptr
+        && glTextureSubImage2D != nullptr;
+
+    LogMessage("SupportsDirectStateAccess=", SupportsDirectStateAccess);
+
 
     //
     // Initialize debugging
@@ -276,9 +339,170 @@ void GameOpenGL::UploadTextureRegion(
     }
 }
 
+void GameOpenGL::UploadTextureRegion(
+    RgbaImageData const & texture,
+    ImageRect const & region,
+    ImageCoordinates const & targetOrigin,
+    GLuint pixelUnpackBuffer)
+{
+    UploadTextureRegionImpl(
+        0,
+        texture,
+        region,
+        targetOrigin,
+        pixelUnpackBuffer);
+}
+
+void GameOpenGL::UploadTextureRegion(
+    GLuint textureHandle,
+    RgbaImageData const & texture,
+    ImageRect const & region,
+    ImageCoordinates const & targetOrigin,
+    GLuint pixelUnpackBuffer)
+{
+    assert(textureHandle != 0);
+
+    if (!SupportsDirectStateAccess)
+    {
+        glBindTexture(GL_TEXTURE_2D, textureHandle);
+        CheckOpenGLError();
+
+        textureHandle = 0;
+    }
+
+    UploadTextureRegionImpl(
+        textureHandle,
+        texture,
+        region,
+        targetOrigin,
+        pixelUnpackBuffer);
+}
+
+void GameOpenGL::UploadBufferSubData(
+    GLenum target,
+    GLuint bufferHandle,
+    GLintptr offset,
+    GLsizeiptr size,
+    void const * data)
+{
+    assert(target != GL_ELEMENT_ARRAY_BUFFER);
+
+    if (SupportsDirectStateAccess)
+    {
+        glNamedBufferSubData(bufferHandle, offset, size, data);
+    }
+    else
+    {
+        glBindBuffer(target, bufferHandle);
+        glBufferSubData(target, offset, size, data);
+        glBindBuffer(target, 0);
+    }
+
+    CheckOpenGLError();
+}
+
+void GameOpenGL::UploadTextureRegionImpl(
+    GLuint textureHandle,
+    RgbaImageData const & texture,
+    ImageRect const & region,
+    ImageCoordinates const & targetOrigin,
+    GLuint pixelUnpackBuffer)
+{
+    assert(region.IsContainedInRect(ImageRect(texture.Size)));
+
+    if (region.size.width == 0 || region.size.height == 0)
+    {
+        return;
+    }
+
+    // Update the specified texture with DSA, or else the bound one
+    auto const texSubImage2D = [textureHandle](GLint xOffset, GLint yOffset, GLsizei width, GLsizei height, void const * pixels)
+    {
+        if (textureHandle != 0)
+            glTextureSubImage2D(textureHandle, 0, xOffset, yOffset, width, height, GL_RGBA, GL_UNSIGNED_BYTE, pixels);
+        else
+            glTexSubImage2D(GL_TEXTURE_2D, 0, xOffset, yOffset, width, height, GL_RGBA, GL_UNSIGNED_BYTE, pixels);
+    };
+
+    size_t const sourceOffset = static_cast<size_t>(region.origin.y) * static_cast<size_t>(texture.Size.width) + static_cast<size_t>(region.origin.x);
+
+    if (pixelUnpackBuffer != 0)
+    {
+        assert(SupportsPixelBufferObjects);
+
+        size_t const rowByteSize = static_cast<size_t>(region.size.width) * sizeof(rgbaColor);
+
+        glBindBuffer(GL_PIXEL_UNPACK_BUFFER, pixelUnpackBuffer);
+        glBufferData(GL_PIXEL_UNPACK_BUFFER, static_cast<GLsizeiptr>(rowByteSize * region.size.height), nullptr, GL_STREAM_DRAW);
+
+        void * const mappedBuffer = glMapBuffer(GL_PIXEL_UNPACK_BUFFER, GL_WRITE_ONLY);
+        if (nullptr == mappedBuffer)
+        {
+            glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+            throw GameException("Error mapping pixel unpack buffer: " + std::to_string(glGetError()));
+        }
+
+        // Pack region rows
+        for (int y = 0; y < region.size.height; ++y)
+        {
+            std::memcpy(
+                reinterpret_cast<std::uint8_t *>(mappedBuffer) + y * rowByteSize,
+                texture.Data.get() + sourceOffset + static_cast<size_t>(y) * static_cast<size_t>(texture.Size.width),
+                rowByteSize);
+        }
+
+        glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER);
+
+        texSubImage2D(targetOrigin.x, targetOrigin.y, region.size.width, region.size.height, nullptr);
+
+        glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+    }
+    else
+    {
+        // Upload straight out of the texture, skipping the rest of each row
+        glPixelStorei(GL_UNPACK_ROW_LENGTH, texture.Size.width);
+        texSubImage2D(targetOrigin.x, targetOrigin.y, region.size.width, region.size.height, texture.Data.get() + sourceOffset);
+        glPixelStorei(GL_UNPACK_ROW_LENGTH, 0);
+    }
+
+    GLenum glError = glGetError();
+    if (GL_NO_ERROR != glError)
+    {
+        throw GameException("Error uploading texture region onto GPU: " + std::to_string(glError));
+    }
+}
+
+// The minimum number of pixels minified by each task, below which the parallelism is not worth it
+static size_t constexpr MinMipmapPixelsPerTask = 16384;
+
+template<typename TFunc>
+static void MinifyRows(
+    int height,
+    int width,
+    TaskThreadPool * taskThreadPool,
+    TFunc const & minifyRows)
+{
+    if (taskThreadPool != nullptr && static_cast<size_t>(width) * static_cast<size_t>(height) > MinMipmapPixelsPerTask)
+    {
+        taskThreadPool->ParallelFor(
+            0,
+            static_cast<size_t>(height),
+            std::max(MinMipmapPixelsPerTask / static_cast<size_t>(width), size_t(1)),
+            [&minifyRows](size_t rowStart, size_t rowEnd)
+            {
+                minifyRows(static_cast<int>(rowStart), static_cast<int>(rowEnd));
+            });
+    }
+    else
+    {
+        minifyRows(0, height);
+    }
+}
+
 void GameOpenGL::UploadMipmappedTexture(
     RgbaImageData baseTexture,
-    GLint internalFormat)
+    GLint internalFormat,
+    TaskThreadPool * taskThreadPool)
 {
     //
     // Upload base image
@@ -319,36 +543,43 @@ void GameOpenGL::UploadMipmappedTexture(
         // Create new buffer
         rgbaColor const * rp = readBuffer.get();
         rgbaColor * wp = writeBuffer.get();
-        for (int h = 0; h < height; ++h)
-        {
-            int const baseWriteIndex = h * width;
-            int const baseReadIndex = (h * 2) * readImageSize.width;
-            int const baseReadIndexNextLine = (h * 2 + 1) * readImageSize.width;
-            for (int w = 0; w < width; ++w)
+        MinifyRows(
+            height,
+            width,
+            taskThreadPool,
+            [rp, wp, width, readImageSize](int rowStart, int rowEnd)
             {
-                //
-                // Apply box filter
-                //
+                for (int h = rowStart; h < rowEnd; ++h)
+                {
+                    int const baseWriteIndex = h * width;
+                    int const baseReadIndex = (h * 2) * readImageSize.width;
+                    int const baseReadIndexNextLine = (h * 2 + 1) * readImageSize.width;
+                    for (int w = 0; w < width; ++w)
+                    {
+                        //
+                        // Apply box filter
+                        //
 
-                int const rIndex = baseReadIndex + (w * 2);
-                int const rIndexNextLine = baseReadIndexNextLine + (w * 2);
+                        int const rIndex = baseReadIndex + (w * 2);
+                        int const rIndexNextLine = baseReadIndexNextLine + (w * 2);
 
-                rgbaColorAccumulation sum(rp[rIndex]);
+                        rgbaColorAccumulation sum(rp[rIndex]);
 
-                if (readImageSize.width > 1)
-                    sum += rp[rIndex + 1];
+                        if (readImageSize.width > 1)
+                            sum += rp[rIndex + 1];
 
-                if (readImageSize.height > 1)
-                {
-                    sum += rp[rIndexNextLine];
+                        if (readImageSize.height > 1)
+                        {
+                            sum += rp[rIndexNextLine];
 
-                    if (readImageSize.width > 1)
-                        sum += rp[rIndexNextLine + 1];
-                }
+                            if (readImageSize.width > 1)
+                                sum += rp[rIndexNextLine + 1];
+                        }
 
-                wp[baseWriteIndex + w] = sum.toRgbaColor();
-            }
-        }
+                        wp[baseWriteIndex + w] = sum.toRgbaColor();
+                    }
+                }
+            });
 
         // Upload write buffer
         glTexImage2D(GL_TEXTURE_2D, textureLevel, internalFormat, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, writeBuffer.get());
@@ -366,7 +597,8 @@ void GameOpenGL::UploadMipmappedTexture(
 
 void GameOpenGL::UploadMipmappedPowerOfTwoTexture(
     RgbaImageData baseTexture,
-    int maxDimension)
+    int maxDimension,
+    TaskThreadPool * taskThreadPool)
 {
     assert(baseTexture.Size.width == ceil_power_of_two(baseTexture.Size.width));
     assert(baseTexture.Size.height == ceil_power_of_two(baseTexture.Size.height));
@@ -410,27 +642,34 @@ void GameOpenGL::UploadMipmappedPowerOfTwoTexture(
         // Populate write buffer
         rgbaColor const * rp = readBuffer.get();
         rgbaColor * wp = writeBuffer.get();
-        for (int h = 0; h < newHeight; ++h)
-        {
-            size_t frameIndexInReadBuffer = (h * 2) * (newWidth * 2);
-            size_t frameIndexInWriteBuffer = (h) * (newWidth);
-
-            for (int w = 0; w < newWidth; ++w)
+        MinifyRows(
+            newHeight,
+            newWidth,
+            taskThreadPool,
+            [rp, wp, newWidth](int rowStart, int rowEnd)
             {
-                //
-                // Calculate and store average of the four neighboring pixels whose bottom-left corner is at (w*2, h*2)
-                //
+                for (int h = rowStart; h < rowEnd; ++h)
+                {
+                    size_t frameIndexInReadBuffer = (h * 2) * (newWidth * 2);
+                    size_t frameIndexInWriteBuffer = (h) * (newWidth);
 
-                rgbaColorAccumulation sum;
+                    for (int w = 0; w < newWidth; ++w)
+                    {
+                        //
+                        // Calculate and store average of the four neighboring pixels whose bottom-left corner is at (w*2, h*2)
+                        //
 
-                sum += rp[frameIndexInReadBuffer + w * 2];
-                sum += rp[frameIndexInReadBuffer + w * 2 + 1];
-                sum += rp[frameIndexInReadBuffer + newWidth * 2 + w * 2];
-                sum += rp[frameIndexInReadBuffer + newWidth * 2 + w * 2 + 1];
+                        rgbaColorAccumulation sum;
 
-                wp[frameIndexInWriteBuffer + w] = sum.toRgbaColor();
-            }
-        }
+                        sum += rp[frameIndexInReadBuffer + w * 2];
+                        sum += rp[frameIndexInReadBuffer + w * 2 + 1];
+                        sum += rp[frameIndexInReadBuffer + newWidth * 2 + w * 2];
+                        sum += rp[frameIndexInReadBuffer + newWidth * 2 + w * 2 + 1];
+
+                        wp[frameIndexInWriteBuffer + w] = sum.toRgbaColor();
+                    }
+                }
+            });
 
         // Upload write buffer
         ++lastUploadedTextureLevel;
@@ -446,6 +685,30 @@ void GameOpenGL::UploadMipmappedPowerOfTwoTexture(
     CheckOpenGLError();
 }
 
+void GameOpenGL::UploadCompressedMipmappedBC3Texture(std::vector<TextureCompression::CompressedImage> const & levels)
+{
+    assert(SupportsBC3TextureCompression);
+
+    for (size_t l = 0; l < levels.size(); ++l)
+    {
+        glCompressedTexImage2D(
+            GL_TEXTURE_2D,
+            static_cast<GLint>(l),
+            GL_COMPRESSED_RGBA_S3TC_DXT5_EXT,
+            levels[l].Size.width,
+            levels[l].Size.height,
+            0,
+            static_cast<GLsizei>(levels[l].Data.size()),
+            levels[l].Data.data());
+
+        GLenum const glError = glGetError();
+        if (GL_NO_ERROR != glError)
+        {
+            throw GameException("Error uploading compressed texture onto GPU: " + std::to_string(glError));
+        }
+    }
+}
+
 void GameOpenGL::Flush()
 {
     // We do it here to have this call in the stack, helping
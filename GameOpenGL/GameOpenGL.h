@@ -10,10 +10,14 @@
 #include <GameCore/GameException.h>
 #include <GameCore/ImageData.h>
 #include <GameCore/Log.h>
+#include <GameCore/TextureCompression.h>
 
 #include <cassert>
 #include <cstdio>
 #include <string>
+#include <vector>
+
+class TaskThreadPool;
 
 /////////////////////////////////////////////////////////////////////////////////////////
 // Types
@@ -208,6 +212,27 @@ public:
 
     static bool AvoidGlFinish;
 
+    // Whether we may stream vertex attributes via persistently-mapped buffers
+    static bool SupportsPersistentMappedBuffers;
+
+    // Whether we may batch draws via glMultiDrawElementsIndirect
+    static bool SupportsMultiDrawIndirect;
+
+    // Whether we may measure GPU time via GL_TIME_ELAPSED queries
+    static bool SupportsTimerQueries;
+
+    // Whether we may stage texture uploads via pixel unpack buffers
+    static bool SupportsPixelBufferObjects;
+
+    // Whether we may upload BC3 (DXT5) block-compressed textures
+    static bool SupportsBC3TextureCompression;
+
+    // Whether we may store vertex attributes as half floats
+    static bool SupportsHalfFloatVertexAttributes;
+
+    // Whether we may update buffers and textures without binding them
+    static bool SupportsDirectStateAccess;
+
 public:
 
     static void InitOpenGL();
@@ -240,15 +265,76 @@ public:
         int width,
         int height);
 
+    /*
+     * Uploads the specified region of the texture onto the currently-bound texture, at the
+     * specified offset, without copying the region out of the texture first.
+     *
+     * When a pixel unpack buffer is specified, the region is staged through it - orphaning
+     * its previous storage - so that the upload does not stall on the GPU still reading it.
+     */
+    static void UploadTextureRegion(
+        RgbaImageData const & texture,
+        ImageRect const & region,
+        ImageCoordinates const & targetOrigin,
+        GLuint pixelUnpackBuffer = 0);
+
+    /*
+     * As above, but onto the specified texture; the texture is updated in-place with
+     * direct state access when supported, and else it is bound - and left bound - first.
+     */
+    static void UploadTextureRegion(
+        GLuint textureHandle,
+        RgbaImageData const & texture,
+        ImageRect const & region,
+        ImageCoordinates const & targetOrigin,
+        GLuint pixelUnpackBuffer = 0);
+
+    /*
+     * Uploads the specified data onto the specified range of the specified buffer,
+     * with direct state access when supported, and else by binding the buffer to the
+     * specified target for the duration of the upload; in both cases no buffer is left
+     * bound to the target.
+     *
+     * Not for element array buffers, whose binding is part of the vertex array state.
+     */
+    static void UploadBufferSubData(
+        GLenum target,
+        GLuint bufferHandle,
+        GLintptr offset,
+        GLsizeiptr size,
+        void const * data);
+
+    /*
+     * Mip levels are minified in parallel when a thread pool is specified; they are
+     * uploaded from the calling thread.
+     */
     static void UploadMipmappedTexture(
         RgbaImageData baseTexture,
-        GLint internalFormat = GL_RGBA);
+        GLint internalFormat = GL_RGBA,
+        TaskThreadPool * taskThreadPool = nullptr);
 
     static void UploadMipmappedPowerOfTwoTexture(
         RgbaImageData baseTexture,
-        int maxDimension);
+        int maxDimension,
+        TaskThreadPool * taskThreadPool = nullptr);
+
+    /*
+     * Uploads the specified BC3-compressed levels - the base level first, followed by
+     * all of its mipmaps - onto the currently-bound texture.
+     */
+    static void UploadCompressedMipmappedBC3Texture(std::vector<TextureCompression::CompressedImage> const & levels);
 
     static void Flush();
+
+private:
+
+    // Texture handle zero stands for the currently-bound texture
+    static void UploadTextureRegionImpl(
+        GLuint textureHandle,
+        RgbaImageData const & texture,
+        ImageRect const & region,
+        ImageCoordinates const & targetOrigin,
+        GLuint pixelUnpackBuffer);
 };
 
 inline void _CheckOpenGLError(char const * file, int line)
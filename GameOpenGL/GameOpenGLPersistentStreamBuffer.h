@@ -0,0 +1,184 @@
+/***************************************************************************************
+* Original Author:      Gabriele Giuseppini
+* Created:              2026-10-14
+* Copyright:            Gabriele Giuseppini  (https://github.com/GabrieleGiuseppini)
+***************************************************************************************/
+#pragma once
+
+#include "GameOpenGL.h"
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cstdint>
+
+/*
+ * This class is an OpenGL buffer that is persistently and coherently mapped, and
+ * that is split into a ring of segments, each holding a whole stream of vertex
+ * attributes.
+ *
+ * The producer - which may run on any thread - writes directly into the "write"
+ * segment, and then commits it; the render thread renders the last committed
+ * segment, and fences it once its draw calls have been issued. Before the producer
+ * gets to write again into a segment, the render thread waits for the segment's
+ * fence, so that we never overwrite a segment that the GPU is still reading.
+ *
+ * Requires GameOpenGL::SupportsPersistentMappedBuffers.
+ */
+template<typename TElement, GLenum TTarget, size_t TSegmentCount = 3>
+class GameOpenGLPersistentStreamBuffer
+{
+    static_assert(TSegmentCount >= 2);
+
+public:
+
+    GameOpenGLPersistentStreamBuffer()
+        : mVBO()
+        , mMappedBuffer(nullptr)
+        , mSegmentSize(0)
+        , mFences()
+        , mWriteSegment(0)
+        , mRenderSegment(TSegmentCount - 1)
+    {
+        mFences.fill(nullptr);
+    }
+
+    ~GameOpenGLPersistentStreamBuffer()
+    {
+        for (auto & fence : mFences)
+        {
+            if (fence != nullptr)
+            {
+                glDeleteSync(fence);
+            }
+        }
+
+        if (nullptr != mMappedBuffer)
+        {
+            glBindBuffer(TTarget, *mVBO);
+            glUnmapBuffer(TTarget);
+            glBindBuffer(TTarget, 0);
+        }
+    }
+
+    GameOpenGLPersistentStreamBuffer(GameOpenGLPersistentStreamBuffer const & other) = delete;
+    GameOpenGLPersistentStreamBuffer & operator=(GameOpenGLPersistentStreamBuffer const & other) = delete;
+
+    /*
+     * Creates the buffer - with all segments filled with the specified value - leaving
+     * it bound to the target.
+     *
+     * To be invoked on the render thread.
+     */
+    void Allocate(
+        size_t segmentSize,
+        TElement const & initialValue)
+    {
+        assert(GameOpenGL::SupportsPersistentMappedBuffers);
+        assert(!mVBO);
+
+        GLuint tmpGLuint;
+        glGenBuffers(1, &tmpGLuint);
+        mVBO = tmpGLuint;
+
+        GLsizeiptr const bufferSize = static_cast<GLsizeiptr>(segmentSize * TSegmentCount * sizeof(TElement));
+        GLbitfield const flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+
+        glBindBuffer(TTarget, *mVBO);
+        glBufferStorage(TTarget, bufferSize, nullptr, flags);
+        CheckOpenGLError();
+
+        mMappedBuffer = reinterpret_cast<TElement *>(glMapBufferRange(TTarget, 0, bufferSize, flags));
+        CheckOpenGLError();
+
+        if (nullptr == mMappedBuffer)
+        {
+            throw GameException("glMapBufferRange returned null pointer");
+        }
+
+        std::fill(
+            mMappedBuffer,
+            mMappedBuffer + segmentSize * TSegmentCount,
+            initialValue);
+
+        mSegmentSize = segmentSize;
+    }
+
+    inline GLuint GetVBO() const noexcept
+    {
+        return *mVBO;
+    }
+
+    /*
+     * The segment that the producer may write into.
+     */
+    inline TElement * GetWriteSegment() noexcept
+    {
+        assert(nullptr != mMappedBuffer);
+        return mMappedBuffer + mWriteSegment * mSegmentSize;
+    }
+
+    /*
+     * Makes the write segment the one to be rendered next, and advances the
+     * write segment.
+     *
+     * To be invoked by the producer, while the render thread is not rendering.
+     */
+    inline void CommitWriteSegment() noexcept
+    {
+        mRenderSegment = mWriteSegment;
+        mWriteSegment = (mWriteSegment + 1) % TSegmentCount;
+    }
+
+    /*
+     * The offset - in bytes from the beginning of the buffer - of the segment
+     * to be rendered.
+     */
+    inline size_t GetRenderSegmentByteOffset() const noexcept
+    {
+        return mRenderSegment * mSegmentSize * sizeof(TElement);
+    }
+
+    /*
+     * Fences the render segment, after all draw calls using it have been issued, and
+     * waits until the GPU is done with the write segment.
+     *
+     * To be invoked on the render thread.
+     */
+    void FenceRenderSegmentAndWaitForWriteSegment()
+    {
+        if (mFences[mRenderSegment] != nullptr)
+        {
+            glDeleteSync(mFences[mRenderSegment]);
+        }
+
+        mFences[mRenderSegment] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+
+        if (mWriteSegment != mRenderSegment
+            && mFences[mWriteSegment] != nullptr)
+        {
+            // Typically signaled already, as we've got a ring of segments
+            std::uint64_t constexpr TimeoutNs = 1000000000ull;
+
+            GLenum const waitResult = glClientWaitSync(mFences[mWriteSegment], GL_SYNC_FLUSH_COMMANDS_BIT, TimeoutNs);
+            if (waitResult == GL_WAIT_FAILED)
+            {
+                CheckOpenGLError();
+            }
+
+            glDeleteSync(mFences[mWriteSegment]);
+            mFences[mWriteSegment] = nullptr;
+        }
+    }
+
+private:
+
+    GameOpenGLVBO mVBO;
+    TElement * mMappedBuffer;
+    size_t mSegmentSize; // In elements
+
+    std::array<GLsync, TSegmentCount> mFences;
+
+    size_t mWriteSegment;
+    size_t mRenderSegment;
+};
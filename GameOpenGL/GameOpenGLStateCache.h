@@ -0,0 +1,78 @@
+/***************************************************************************************
+* Original Author:      Gabriele Giuseppini
+* Created:              2026-10-14
+* Copyright:            Gabriele Giuseppini  (https://github.com/GabrieleGiuseppini)
+***************************************************************************************/
+#pragma once
+
+#include "GameOpenGL.h"
+
+#include <limits>
+
+/*
+ * A shadow of a few bits of the state of an OpenGL context, used to filter out
+ * calls that would set state to the value it already has - e.g. render stages
+ * activating the same program or texture unit, one after the other, for each ship.
+ *
+ * The cache assumes that it sees all changes to the state it shadows; whoever
+ * changes that state behind its back must invalidate it.
+ */
+class GameOpenGLStateCache final
+{
+public:
+
+    GameOpenGLStateCache()
+    {
+        Invalidate();
+    }
+
+    /*
+     * Makes the specified program current; returns whether the call was
+     * actually made, and thus whether it needs checking for errors.
+     */
+    inline bool UseProgram(GLuint program)
+    {
+        if (program == mCurrentProgram)
+        {
+            return false;
+        }
+
+        glUseProgram(program);
+        mCurrentProgram = program;
+
+        return true;
+    }
+
+    /*
+     * Makes the specified texture unit (zero-based) active; returns whether the
+     * call was actually made, and thus whether it needs checking for errors.
+     */
+    inline bool ActiveTexture(GLuint textureUnit)
+    {
+        if (textureUnit == mActiveTextureUnit)
+        {
+            return false;
+        }
+
+        glActiveTexture(GL_TEXTURE0 + textureUnit);
+        mActiveTextureUnit = textureUnit;
+
+        return true;
+    }
+
+    /*
+     * Forgets all state, so that the next calls are made regardless.
+     */
+    void Invalidate()
+    {
+        mCurrentProgram = Unknown;
+        mActiveTextureUnit = Unknown;
+    }
+
+private:
+
+    static GLuint constexpr Unknown = std::numeric_limits<GLuint>::max();
+
+    GLuint mCurrentProgram;
+    GLuint mActiveTextureUnit;
+};
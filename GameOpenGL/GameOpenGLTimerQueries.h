@@ -0,0 +1,145 @@
+/***************************************************************************************
+* Original Author:      Gabriele Giuseppini
+* Created:              2026-10-14
+* Copyright:            Gabriele Giuseppini  (https://github.com/GabrieleGiuseppini)
+***************************************************************************************/
+#pragma once
+
+#include "GameOpenGL.h"
+
+#include <array>
+#include <cassert>
+#include <chrono>
+#include <cstdint>
+#include <optional>
+
+/*
+ * This class measures the GPU time taken by a fixed sequence of segments of a frame,
+ * via GL_TIME_ELAPSED queries.
+ *
+ * The queries are organized in a ring of frames, so that the results of a frame are
+ * only read back when the ring comes back to it - i.e. a few frames later, when the
+ * GPU is normally done with it - and thus without stalling the pipeline. Results that
+ * are still not available at that moment are dropped.
+ *
+ * Only one segment may be measured at any given moment, as GL_TIME_ELAPSED queries
+ * may not be nested.
+ *
+ * Requires GameOpenGL::SupportsTimerQueries.
+ */
+template<size_t TSegmentCount, size_t TFrameCount = 3>
+class GameOpenGLTimerQueries
+{
+    static_assert(TSegmentCount >= 1);
+    static_assert(TFrameCount >= 2);
+
+public:
+
+    using SegmentDurations = std::array<std::chrono::nanoseconds, TSegmentCount>;
+
+public:
+
+    /*
+     * To be invoked on the render thread.
+     */
+    GameOpenGLTimerQueries()
+        : mQueries()
+        , mIsFrameIssued()
+        , mCurrentFrame(0)
+        , mCurrentSegment(std::nullopt)
+    {
+        assert(GameOpenGL::SupportsTimerQueries);
+
+        glGenQueries(static_cast<GLsizei>(TSegmentCount * TFrameCount), mQueries.data());
+        CheckOpenGLError();
+
+        mIsFrameIssued.fill(false);
+    }
+
+    ~GameOpenGLTimerQueries()
+    {
+        glDeleteQueries(static_cast<GLsizei>(TSegmentCount * TFrameCount), mQueries.data());
+    }
+
+    GameOpenGLTimerQueries(GameOpenGLTimerQueries const & other) = delete;
+    GameOpenGLTimerQueries & operator=(GameOpenGLTimerQueries const & other) = delete;
+
+    /*
+     * Moves on to the next frame of the ring, returning the durations measured when
+     * that frame was last issued - if they're available by now.
+     *
+     * To be invoked on the render thread, before any segment of the frame.
+     */
+    std::optional<SegmentDurations> BeginFrame()
+    {
+        assert(!mCurrentSegment.has_value());
+
+        mCurrentFrame = (mCurrentFrame + 1) % TFrameCount;
+
+        std::optional<SegmentDurations> result;
+
+        if (mIsFrameIssued[mCurrentFrame])
+        {
+            // Queries complete in order, hence the last one tells for all of them
+            GLint isAvailable = GL_FALSE;
+            glGetQueryObjectiv(GetQuery(mCurrentFrame, TSegmentCount - 1), GL_QUERY_RESULT_AVAILABLE, &isAvailable);
+
+            if (isAvailable == GL_TRUE)
+            {
+                result.emplace();
+
+                for (size_t s = 0; s < TSegmentCount; ++s)
+                {
+                    GLuint64 elapsedNs = 0;
+                    glGetQueryObjectui64v(GetQuery(mCurrentFrame, s), GL_QUERY_RESULT, &elapsedNs);
+
+                    (*result)[s] = std::chrono::nanoseconds(static_cast<std::int64_t>(elapsedNs));
+                }
+            }
+        }
+
+        // We're going to re-issue this frame now
+        mIsFrameIssued[mCurrentFrame] = true;
+
+        return result;
+    }
+
+    /*
+     * Segments must be measured once per frame, each one only after the previous one has ended.
+     */
+    inline void BeginSegment(size_t segment)
+    {
+        assert(segment < TSegmentCount);
+        assert(!mCurrentSegment.has_value());
+
+        glBeginQuery(GL_TIME_ELAPSED, GetQuery(mCurrentFrame, segment));
+
+        mCurrentSegment = segment;
+    }
+
+    inline void EndSegment()
+    {
+        assert(mCurrentSegment.has_value());
+
+        glEndQuery(GL_TIME_ELAPSED);
+
+        mCurrentSegment.reset();
+    }
+
+private:
+
+    inline GLuint GetQuery(
+        size_t frame,
+        size_t segment) const noexcept
+    {
+        return mQueries[frame * TSegmentCount + segment];
+    }
+
+private:
+
+    std::array<GLuint, TSegmentCount * TFrameCount> mQueries;
+    std::array<bool, TFrameCount> mIsFrameIssued;
+
+    size_t mCurrentFrame;
+    std::optional<size_t> mCurrentSegment;
+};
@@ -47,6 +47,7 @@ PFNGLFRAMEBUFFERTEXTURE2DPROC glFramebufferTexture2D = NULL;
 PFNGLFRAMEBUFFERTEXTURE3DPROC glFramebufferTexture3D = NULL;
 PFNGLFRAMEBUFFERRENDERBUFFERPROC glFramebufferRenderbuffer = NULL;
 PFNGLGETFRAMEBUFFERATTACHMENTPARAMETERIVPROC glGetFramebufferAttachmentParameteriv = NULL;
+PFNGLGENERATEMIPMAPPROC glGenerateMipmap = NULL;
 
 void InitOpenGLExt_Framebuffer(GLADloadproc load)
 {
@@ -71,6 +72,7 @@ void InitOpenGLExt_Framebuffer(GLADloadproc load)
         LoadAndVerify("glFramebufferTexture3D", glFramebufferTexture3D, load);
         LoadAndVerify("glFramebufferRenderbuffer", glFramebufferRenderbuffer, load);
         LoadAndVerify("glGetFramebufferAttachmentParameteriv", glGetFramebufferAttachmentParameteriv, load);
+        LoadAndVerify("glGenerateMipmap", glGenerateMipmap, load);
     }
     else if (HasExt("GL_EXT_framebuffer_object"))
     {
@@ -93,6 +95,7 @@ void InitOpenGLExt_Framebuffer(GLADloadproc load)
         LoadAndVerify("glFramebufferTexture3DEXT", glFramebufferTexture3D, load);
         LoadAndVerify("glFramebufferRenderbufferEXT", glFramebufferRenderbuffer, load);
         LoadAndVerify("glGetFramebufferAttachmentParameterivEXT", glGetFramebufferAttachmentParameteriv, load);
+        LoadAndVerify("glGenerateMipmapEXT", glGenerateMipmap, load);
     }
     else
     {
@@ -184,11 +187,198 @@ void InitOpenGLExt_TextureFloat(GLADloadproc /*load*/)
     }
 }
 
+//////////////////////////////////////////////////////////////////////////
+// Buffer Storage
+//////////////////////////////////////////////////////////////////////////
+
+PFNGLBUFFERSTORAGEPROC glBufferStorage = NULL;
+PFNGLMAPBUFFERRANGEPROC glMapBufferRange = NULL;
+
+void InitOpenGLExt_BufferStorage(GLADloadproc load)
+{
+    // Optional: when not supported, we stream vertex attributes via glBufferSubData
+
+    if (GLVersion.major > 4 // Core in 4.4
+        || (GLVersion.major == 4 && GLVersion.minor >= 4)
+        || HasExt("GL_ARB_buffer_storage"))
+    {
+        // Core or ARB - maintains name
+
+        LoadAndVerify("glBufferStorage", glBufferStorage, load);
+    }
+    else
+    {
+        // Ignore
+        return;
+    }
+
+    if (GLVersion.major >= 3 // Core in 3.0
+        || HasExt("GL_ARB_map_buffer_range"))
+    {
+        // Core or ARB - maintains name
+
+        LoadAndVerify("glMapBufferRange", glMapBufferRange, load);
+    }
+    else
+    {
+        // Can't use buffer storage without mapping it
+        glBufferStorage = NULL;
+    }
+}
+
+//////////////////////////////////////////////////////////////////////////
+// Pixel Buffer Object
+//////////////////////////////////////////////////////////////////////////
+
+bool HasPixelBufferObject = false;
+
+void InitOpenGLExt_PixelBufferObject()
+{
+    // Optional: when not supported, we upload texture regions from client memory
+
+    HasPixelBufferObject =
+        GLVersion.major > 2 // Core in 2.1
+        || (GLVersion.major == 2 && GLVersion.minor >= 1)
+        || HasExt("GL_ARB_pixel_buffer_object");
+}
+
+//////////////////////////////////////////////////////////////////////////
+// S3TC Texture Compression
+//////////////////////////////////////////////////////////////////////////
+
+bool HasTextureCompressionS3tc = false;
+
+void InitOpenGLExt_TextureCompressionS3tc()
+{
+    // Optional: when not supported, we keep textures uncompressed
+
+    HasTextureCompressionS3tc = HasExt("GL_EXT_texture_compression_s3tc");
+}
+
+//////////////////////////////////////////////////////////////////////////
+// Half-Float Vertex
+//////////////////////////////////////////////////////////////////////////
+
+bool HasHalfFloatVertex = false;
+
+void InitOpenGLExt_HalfFloatVertex()
+{
+    // Optional: when not supported, we keep vertex attributes as floats
+
+    HasHalfFloatVertex =
+        GLVersion.major >= 3 // Core in 3.0
+        || HasExt("GL_ARB_half_float_vertex");
+}
+
+//////////////////////////////////////////////////////////////////////////
+// Sync
+//////////////////////////////////////////////////////////////////////////
+
+PFNGLFENCESYNCPROC glFenceSync = NULL;
+PFNGLDELETESYNCPROC glDeleteSync = NULL;
+PFNGLCLIENTWAITSYNCPROC glClientWaitSync = NULL;
+
+void InitOpenGLExt_Sync(GLADloadproc load)
+{
+    // Optional: only required together with buffer storage
+
+    if (GLVersion.major > 3 // Core in 3.2
+        || (GLVersion.major == 3 && GLVersion.minor >= 2)
+        || HasExt("GL_ARB_sync"))
+    {
+        // Core or ARB - maintains name
+
+        LoadAndVerify("glFenceSync", glFenceSync, load);
+        LoadAndVerify("glDeleteSync", glDeleteSync, load);
+        LoadAndVerify("glClientWaitSync", glClientWaitSync, load);
+    }
+    else
+    {
+        // Ignore
+    }
+}
+
+//////////////////////////////////////////////////////////////////////////
+// Multi Draw Indirect
+//////////////////////////////////////////////////////////////////////////
+
+PFNGLMULTIDRAWELEMENTSINDIRECTPROC glMultiDrawElementsIndirect = NULL;
+
+void InitOpenGLExt_MultiDrawIndirect(GLADloadproc load)
+{
+    // Optional: we fall back on glMultiDrawElements
+
+    if (GLVersion.major > 4 // Core in 4.3
+        || (GLVersion.major == 4 && GLVersion.minor >= 3)
+        || (HasExt("GL_ARB_multi_draw_indirect") && HasExt("GL_ARB_draw_indirect")))
+    {
+        // Core or ARB - maintains name
+
+        LoadAndVerify("glMultiDrawElementsIndirect", glMultiDrawElementsIndirect, load);
+    }
+    else
+    {
+        // Ignore
+    }
+}
+
+//////////////////////////////////////////////////////////////////////////
+// Timer Query
+//////////////////////////////////////////////////////////////////////////
+
+PFNGLGETQUERYOBJECTUI64VPROC glGetQueryObjectui64v = NULL;
+
+void InitOpenGLExt_TimerQuery(GLADloadproc load)
+{
+    // Optional: only required for GPU statistics
+
+    if (GLVersion.major > 3 // Core in 3.3
+        || (GLVersion.major == 3 && GLVersion.minor >= 3)
+        || HasExt("GL_ARB_timer_query"))
+    {
+        // Core or ARB - maintains name
+
+        LoadAndVerify("glGetQueryObjectui64v", glGetQueryObjectui64v, load);
+    }
+    else
+    {
+        // Ignore
+    }
+}
+
+//////////////////////////////////////////////////////////////////////////
+// Direct State Access
+//////////////////////////////////////////////////////////////////////////
+
+PFNGLNAMEDBUFFERSUBDATAPROC glNamedBufferSubData = NULL;
+PFNGLTEXTURESUBIMAGE2DPROC glTextureSubImage2D = NULL;
+
+void InitOpenGLExt_DirectStateAccess(GLADloadproc load)
+{
+    // Optional: we fall back on binding objects to update them
+
+    if (GLVersion.major > 4 // Core in 4.5
+        || (GLVersion.major == 4 && GLVersion.minor >= 5)
+        || HasExt("GL_ARB_direct_state_access"))
+    {
+        // Core or ARB - maintains name
+
+        LoadAndVerify("glNamedBufferSubData", glNamedBufferSubData, load);
+        LoadAndVerify("glTextureSubImage2D", glTextureSubImage2D, load);
+    }
+    else
+    {
+        // Ignore
+    }
+}
+
 //////////////////////////////////////////////////////////////////////////
 // Misc
 //////////////////////////////////////////////////////////////////////////
 
 PFNGLGETPROGRAMBINARYPROC glGetProgramBinary = NULL;
+PFNGLPROGRAMBINARYPROC glProgramBinary = NULL;
+PFNGLPROGRAMPARAMETERIPROC glProgramParameteri = NULL;
 PFNGLDEBUGMESSAGECALLBACKARB glDebugMessageCallback = NULL;
 
 void InitOpenGLExt_Misc(GLADloadproc load)
@@ -199,10 +389,14 @@ void InitOpenGLExt_Misc(GLADloadproc load)
         // Core
 
         LoadAndVerify("glGetProgramBinary", glGetProgramBinary, load);
+        LoadAndVerify("glProgramBinary", glProgramBinary, load);
+        LoadAndVerify("glProgramParameteri", glProgramParameteri, load);
     }
     else if (HasExt("GL_ARB_get_program_binary"))
     {
         LoadAndVerify("glGetProgramBinary", glGetProgramBinary, load);
+        LoadAndVerify("glProgramBinary", glProgramBinary, load);
+        LoadAndVerify("glProgramParameteri", glProgramParameteri, load);
     }
     else
     {
@@ -235,6 +429,22 @@ void InitOpenGLExt()
 
                 InitOpenGLExt_TextureFloat(&get_proc);
 
+                InitOpenGLExt_BufferStorage(&get_proc);
+
+                InitOpenGLExt_PixelBufferObject();
+
+                InitOpenGLExt_TextureCompressionS3tc();
+
+                InitOpenGLExt_HalfFloatVertex();
+
+                InitOpenGLExt_Sync(&get_proc);
+
+                InitOpenGLExt_MultiDrawIndirect(&get_proc);
+
+                InitOpenGLExt_TimerQuery(&get_proc);
+
+                InitOpenGLExt_DirectStateAccess(&get_proc);
+
                 InitOpenGLExt_Misc(&get_proc);
 
                 free_exts();
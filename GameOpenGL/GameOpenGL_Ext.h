@@ -74,6 +74,9 @@ GLAPI PFNGLFRAMEBUFFERRENDERBUFFERPROC glFramebufferRenderbuffer;
 typedef void (APIENTRYP PFNGLGETFRAMEBUFFERATTACHMENTPARAMETERIVPROC)(GLenum target, GLenum attachment, GLenum pname, GLint *params);
 GLAPI PFNGLGETFRAMEBUFFERATTACHMENTPARAMETERIVPROC glGetFramebufferAttachmentParameteriv;
 
+typedef void (APIENTRYP PFNGLGENERATEMIPMAPPROC)(GLenum target);
+GLAPI PFNGLGENERATEMIPMAPPROC glGenerateMipmap;
+
 //
 // Enumerants
 //
@@ -184,6 +187,155 @@ GLAPI PFNGLISVERTEXARRAYPROC glIsVertexArray;
 #define GL_RGBA16F 0x881a
 #define GL_RGB16F 0x881b
 
+//////////////////////////////////////////////////////////////////////////
+// Buffer Storage
+//////////////////////////////////////////////////////////////////////////
+
+//
+// Functions
+//
+
+typedef void (APIENTRYP PFNGLBUFFERSTORAGEPROC)(GLenum target, GLsizeiptr size, const void * data, GLbitfield flags);
+GLAPI PFNGLBUFFERSTORAGEPROC glBufferStorage;
+
+typedef void * (APIENTRYP PFNGLMAPBUFFERRANGEPROC)(GLenum target, GLintptr offset, GLsizeiptr length, GLbitfield access);
+GLAPI PFNGLMAPBUFFERRANGEPROC glMapBufferRange;
+
+//
+// Enumerants
+//
+
+#define GL_MAP_READ_BIT 0x0001
+#define GL_MAP_WRITE_BIT 0x0002
+#define GL_MAP_PERSISTENT_BIT 0x0040
+#define GL_MAP_COHERENT_BIT 0x0080
+#define GL_DYNAMIC_STORAGE_BIT 0x0100
+#define GL_CLIENT_STORAGE_BIT 0x0200
+
+//////////////////////////////////////////////////////////////////////////
+// Pixel Buffer Object
+//////////////////////////////////////////////////////////////////////////
+
+//
+// Availability (no functions of its own)
+//
+
+extern bool HasPixelBufferObject;
+
+//
+// Enumerants
+//
+
+#define GL_PIXEL_UNPACK_BUFFER 0x88EC
+
+//////////////////////////////////////////////////////////////////////////
+// S3TC Texture Compression
+//////////////////////////////////////////////////////////////////////////
+
+//
+// Availability (no functions of its own - glCompressedTexImage2D is core in 1.3)
+//
+
+extern bool HasTextureCompressionS3tc;
+
+//
+// Enumerants
+//
+
+#define GL_COMPRESSED_RGBA_S3TC_DXT5_EXT 0x83F3
+
+//////////////////////////////////////////////////////////////////////////
+// Half-Float Vertex
+//////////////////////////////////////////////////////////////////////////
+
+//
+// Availability (no functions of its own)
+//
+
+extern bool HasHalfFloatVertex;
+
+//
+// Enumerants
+//
+
+#define GL_HALF_FLOAT 0x140B
+
+//////////////////////////////////////////////////////////////////////////
+// Sync
+//////////////////////////////////////////////////////////////////////////
+
+//
+// Functions
+//
+
+typedef GLsync (APIENTRYP PFNGLFENCESYNCPROC)(GLenum condition, GLbitfield flags);
+GLAPI PFNGLFENCESYNCPROC glFenceSync;
+
+typedef void (APIENTRYP PFNGLDELETESYNCPROC)(GLsync sync);
+GLAPI PFNGLDELETESYNCPROC glDeleteSync;
+
+typedef GLenum (APIENTRYP PFNGLCLIENTWAITSYNCPROC)(GLsync sync, GLbitfield flags, GLuint64 timeout);
+GLAPI PFNGLCLIENTWAITSYNCPROC glClientWaitSync;
+
+//
+// Enumerants
+//
+
+#define GL_SYNC_FLUSH_COMMANDS_BIT 0x00000001
+#define GL_SYNC_GPU_COMMANDS_COMPLETE 0x9117
+#define GL_ALREADY_SIGNALED 0x911A
+#define GL_TIMEOUT_EXPIRED 0x911B
+#define GL_CONDITION_SATISFIED 0x911C
+#define GL_WAIT_FAILED 0x911D
+
+//////////////////////////////////////////////////////////////////////////
+// Multi Draw Indirect
+//////////////////////////////////////////////////////////////////////////
+
+//
+// Functions
+//
+
+typedef void (APIENTRYP PFNGLMULTIDRAWELEMENTSINDIRECTPROC)(GLenum mode, GLenum type, const void * indirect, GLsizei drawcount, GLsizei stride);
+GLAPI PFNGLMULTIDRAWELEMENTSINDIRECTPROC glMultiDrawElementsIndirect;
+
+//
+// Enumerants
+//
+
+#define GL_DRAW_INDIRECT_BUFFER 0x8F3F
+
+//////////////////////////////////////////////////////////////////////////
+// Timer Query
+//////////////////////////////////////////////////////////////////////////
+
+//
+// Functions
+//
+
+typedef void (APIENTRYP PFNGLGETQUERYOBJECTUI64VPROC)(GLuint id, GLenum pname, GLuint64 * params);
+GLAPI PFNGLGETQUERYOBJECTUI64VPROC glGetQueryObjectui64v;
+
+//
+// Enumerants
+//
+
+#define GL_TIME_ELAPSED 0x88BF
+
+//////////////////////////////////////////////////////////////////////////
+// Direct State Access
+//////////////////////////////////////////////////////////////////////////
+
+//
+// Functions
+//
+
+typedef void (APIENTRYP PFNGLNAMEDBUFFERSUBDATAPROC)(GLuint buffer, GLintptr offset, GLsizeiptr size, const void * data);
+GLAPI PFNGLNAMEDBUFFERSUBDATAPROC glNamedBufferSubData;
+
+typedef void (APIENTRYP PFNGLTEXTURESUBIMAGE2DPROC)(GLuint texture, GLint level, GLint xoffset, GLint yoffset, GLsizei width, GLsizei height, GLenum format, GLenum type, const void * pixels);
+GLAPI PFNGLTEXTURESUBIMAGE2DPROC glTextureSubImage2D;
+
 //////////////////////////////////////////////////////////////////////////
 // Misc
 //////////////////////////////////////////////////////////////////////////
@@ -195,6 +347,12 @@ GLAPI PFNGLISVERTEXARRAYPROC glIsVertexArray;
 typedef void (APIENTRYP PFNGLGETPROGRAMBINARYPROC)(GLuint program, GLsizei bufSize, GLsizei * length, GLenum * binaryFormat, void * binary);
 GLAPI PFNGLGETPROGRAMBINARYPROC glGetProgramBinary;
 
+typedef void (APIENTRYP PFNGLPROGRAMBINARYPROC)(GLuint program, GLenum binaryFormat, const void * binary, GLsizei length);
+GLAPI PFNGLPROGRAMBINARYPROC glProgramBinary;
+
+typedef void (APIENTRYP PFNGLPROGRAMPARAMETERIPROC)(GLuint program, GLenum pname, GLint value);
+GLAPI PFNGLPROGRAMPARAMETERIPROC glProgramParameteri;
+
 typedef void (APIENTRY * DEBUGPROCARB)(GLenum source, GLenum type, GLuint id, GLenum severity, GLsizei length, const GLchar * message, const void * userParam);
 typedef void (APIENTRYP PFNGLDEBUGMESSAGECALLBACKARB)(DEBUGPROCARB callback, const void * userParam);
 GLAPI PFNGLDEBUGMESSAGECALLBACKARB glDebugMessageCallback;
@@ -203,6 +361,10 @@ GLAPI PFNGLDEBUGMESSAGECALLBACKARB glDebugMessageCallback;
 // Enumerants
 //
 
+#define GL_PROGRAM_BINARY_RETRIEVABLE_HINT 0x8257
+#define GL_PROGRAM_BINARY_LENGTH 0x8741
+#define GL_NUM_PROGRAM_BINARY_FORMATS 0x87FE
+
 #define GL_DEBUG_OUTPUT_SYNCHRONOUS 0x8242
 #define GL_DEBUG_SEVERITY_HIGH_ARB 0x9146
 #define GL_DEBUG_SEVERITY_MEDIUM_ARB 0x9147
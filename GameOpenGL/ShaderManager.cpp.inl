@@ -8,6 +8,7 @@
 #include <GameCore/GameException.h>
 #include <GameCore/Utils.h>
 
+#include <fstream>
 #include <regex>
 #include <unordered_map>
 #include <unordered_set>
@@ -15,7 +16,9 @@
 static const std::string StaticParametersFilenameStem = "static_parameters";
 
 template<typename Traits>
-ShaderManager<Traits>::ShaderManager(std::filesystem::path const & shadersRoot)
+ShaderManager<Traits>::ShaderManager(
+    std::filesystem::path const & shadersRoot,
+    std::optional<std::filesystem::path> const & programBinaryCacheRoot)
 {
     if (!std::filesystem::exists(shadersRoot))
         throw GameException("Shaders root path \"" + shadersRoot.string() + "\" does not exist");
@@ -65,14 +68,14 @@ ShaderManager<Traits>::ShaderManager(std::filesystem::path const & shadersRoot)
 
 
     //
-    // Compile all shader files
+    // Preprocess all shader files
     //
 
     for (auto const & entryIt : shaderSources)
     {
         if (entryIt.second.first)
         {
-            CompileShader(
+            PrepareProgram(
                 entryIt.first,
                 entryIt.second.second,
                 shaderSources,
@@ -87,15 +90,60 @@ ShaderManager<Traits>::ShaderManager(std::filesystem::path const & shadersRoot)
 
     for (uint32_t i = 0; i <= static_cast<uint32_t>(Traits::ProgramType::_Last); ++i)
     {
-        if (i >= mPrograms.size() || !(mPrograms[i].OpenGLHandle))
+        if (i >= mPrograms.size() || !mPrograms[i].Source.has_value())
         {
             throw GameException("Cannot find GLSL source file for program \"" + Traits::ProgramTypeToStr(static_cast<typename Traits::ProgramType>(i)) + "\"");
         }
     }
+
+
+    //
+    // Setup binary cache - only if the driver supports program binaries
+    //
+
+    if (programBinaryCacheRoot.has_value())
+    {
+        GLint binaryFormatCount = 0;
+        if (glGetProgramBinary != nullptr && glProgramBinary != nullptr && glProgramParameteri != nullptr)
+        {
+            glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &binaryFormatCount);
+        }
+
+        if (binaryFormatCount > 0)
+        {
+            mProgramBinaryCacheRoot = programBinaryCacheRoot;
+
+            // Binaries are only valid for the driver that made them
+            auto const getString = [](GLenum name)
+            {
+                auto const * str = glGetString(name);
+                return std::string(str != nullptr ? reinterpret_cast<char const *>(str) : "");
+            };
+
+            mDriverIdentifier = getString(GL_VENDOR) + "|" + getString(GL_RENDERER) + "|" + getString(GL_VERSION);
+        }
+        else
+        {
+            LogMessage("Program binaries are not supported by the driver; not caching programs");
+        }
+    }
+
+
+    //
+    // Compile all programs that are not compiled on first use
+    //
+
+    for (size_t i = 0; i < mPrograms.size(); ++i)
+    {
+        if (!Traits::IsLazilyCompiledProgram(static_cast<typename Traits::ProgramType>(i)))
+        {
+            CompileProgram(i);
+        }
+    }
 }
 
 template<typename Traits>
-void ShaderManager<Traits>::CompileShader(
+void ShaderManager<Traits>::PrepareProgram(
     std::string const & shaderFilename,
     std::string const & shaderSource,
     std::unordered_map<std::string, std::pair<bool, std::string>> const & allShaderSources,
@@ -106,7 +154,6 @@ void ShaderManager<Traits>::CompileShader(
         // Get the program type
         std::filesystem::path shaderFilenamePath(shaderFilename);
         typename Traits::ProgramType const program = Traits::ShaderFilenameToProgramType(shaderFilenamePath.stem().string());
-        std::string const programName = Traits::ProgramTypeToStr(program);
 
         // Make sure we have room for it
         size_t programIndex = static_cast<size_t>(program);
@@ -116,7 +163,7 @@ void ShaderManager<Traits>::CompileShader(
         }
 
         // First time we see it (guaranteed by file system)
-        assert(!(mPrograms[programIndex].OpenGLHandle));
+        assert(!mPrograms[programIndex].Source.has_value());
 
         // Resolve includes
         std::string preprocessedShaderSource = ResolveIncludes(
@@ -126,78 +173,44 @@ void ShaderManager<Traits>::CompileShader(
         // Split the source file
         auto [vertexShaderSource, fragmentShaderSource] = SplitSource(preprocessedShaderSource);
 
+        // Substitute static parameters
+        mPrograms[programIndex].Source = ProgramSource{
+            shaderFilename,
+            SubstituteStaticParameters(vertexShaderSource, staticParameters),
+            SubstituteStaticParameters(fragmentShaderSource, staticParameters) };
+    }
+    catch (GameException const & ex)
+    {
+        throw GameException("Error compiling shader file \"" + shaderFilename + "\": " + ex.what());
+    }
+}
 
-        //
-        // Create program
-        //
-
-        mPrograms[programIndex].OpenGLHandle = glCreateProgram();
-        CheckOpenGLError();
-
-
-        //
-        // Compile vertex shader
-        //
-
-        vertexShaderSource = SubstituteStaticParameters(vertexShaderSource, staticParameters);
-
-        GameOpenGL::CompileShader(
-            vertexShaderSource,
-            GL_VERTEX_SHADER,
-            mPrograms[programIndex].OpenGLHandle,
-            programName);
-
-
-        //
-        // Compile fragment shader
-        //
-
-        fragmentShaderSource = SubstituteStaticParameters(fragmentShaderSource, staticParameters);
-
-        GameOpenGL::CompileShader(
-            fragmentShaderSource,
-            GL_FRAGMENT_SHADER,
-            mPrograms[programIndex].OpenGLHandle,
-            programName);
-
-
-        //
-        // Link a first time, to enable extraction of attributes and uniforms
-        //
-
-        GameOpenGL::LinkShaderProgram(mPrograms[programIndex].OpenGLHandle, programName);
+template<typename Traits>
+void ShaderManager<Traits>::CompileProgram(size_t programIndex)
+{
+    assert(mPrograms[programIndex].Source.has_value());
+    assert(!(mPrograms[programIndex].OpenGLHandle));
 
+    auto const & programSource = *(mPrograms[programIndex].Source);
 
+    try
+    {
         //
-        // Extract attribute names from vertex shader and bind them
+        // Create program, either from the binary cache or from source
         //
 
-        std::set<std::string> vertexAttributeNames = ExtractVertexAttributeNames(mPrograms[programIndex].OpenGLHandle);
-
-        for (auto const & vertexAttributeName : vertexAttributeNames)
+        if (!TryLoadProgramBinary(programIndex))
         {
-            auto vertexAttribute = Traits::StrToVertexAttributeType(vertexAttributeName);
+            BuildProgramFromSource(programIndex);
 
-            GameOpenGL::BindAttributeLocation(
-                mPrograms[programIndex].OpenGLHandle,
-                static_cast<GLuint>(vertexAttribute),
-                "in" + vertexAttributeName);
+            SaveProgramBinary(programIndex);
         }
 
 
-        //
-        // Link a second time, to freeze vertex attribute binding
-        //
-
-        GameOpenGL::LinkShaderProgram(mPrograms[programIndex].OpenGLHandle, programName);
-
-
         //
         // Extract uniform locations
         //
 
-        std::vector<GLint> uniformLocations;
-
         std::set<std::string> parameterNames = ExtractParameterNames(mPrograms[programIndex].OpenGLHandle);
 
         for (auto const & parameterName : parameterNames)
@@ -219,8 +232,279 @@ void ShaderManager<Traits>::CompileShader(
     }
     catch (GameException const & ex)
     {
-        throw GameException("Error compiling shader file \"" + shaderFilename + "\": " + ex.what());
+        throw GameException("Error compiling shader file \"" + programSource.ShaderFilename + "\": " + ex.what());
+    }
+
+
+    //
+    // Apply the parameters received while the program was not compiled yet,
+    // preserving the current program
+    //
+
+    if (!mPrograms[programIndex].DeferredParameterSetters.empty())
+    {
+        GLint currentProgram;
+        glGetIntegerv(GL_CURRENT_PROGRAM, &currentProgram);
+
+        mStateCache.UseProgram(*(mPrograms[programIndex].OpenGLHandle));
+        CheckOpenGLError();
+
+        auto deferredParameterSetters = std::move(mPrograms[programIndex].DeferredParameterSetters);
+        mPrograms[programIndex].DeferredParameterSetters.clear();
+
+        for (auto const & setter : deferredParameterSetters)
+        {
+            setter.second();
+        }
+
+        mStateCache.UseProgram(static_cast<GLuint>(currentProgram));
+        CheckOpenGLError();
+    }
+}
+
+template<typename Traits>
+void ShaderManager<Traits>::BuildProgramFromSource(size_t programIndex)
+{
+    auto const & programSource = *(mPrograms[programIndex].Source);
+    std::string const programName = Traits::ProgramTypeToStr(static_cast<typename Traits::ProgramType>(programIndex));
+
+    //
+    // Create program
+    //
+
+    mPrograms[programIndex].OpenGLHandle = GameOpenGLShaderProgram(glCreateProgram());
+    CheckOpenGLError();
+
+
+    //
+    // Compile vertex shader
+    //
+
+    GameOpenGL::CompileShader(
+        programSource.VertexShaderSource,
+        GL_VERTEX_SHADER,
+        mPrograms[programIndex].OpenGLHandle,
+        programName);
+
+
+    //
+    // Compile fragment shader
+    //
+
+    GameOpenGL::CompileShader(
+        programSource.FragmentShaderSource,
+        GL_FRAGMENT_SHADER,
+        mPrograms[programIndex].OpenGLHandle,
+        programName);
+
+
+    //
+    // Link a first time, to enable extraction of attributes and uniforms
+    //
+
+    GameOpenGL::LinkShaderProgram(mPrograms[programIndex].OpenGLHandle, programName);
+
+
+    //
+    // Extract attribute names from vertex shader and bind them
+    //
+
+    std::set<std::string> vertexAttributeNames = ExtractVertexAttributeNames(mPrograms[programIndex].OpenGLHandle);
+
+    for (auto const & vertexAttributeName : vertexAttributeNames)
+    {
+        auto vertexAttribute = Traits::StrToVertexAttributeType(vertexAttributeName);
+
+        GameOpenGL::BindAttributeLocation(
+            mPrograms[programIndex].OpenGLHandle,
+            static_cast<GLuint>(vertexAttribute),
+            "in" + vertexAttributeName);
+    }
+
+
+    //
+    // Link a second time, to freeze vertex attribute binding - and to
+    // get a binary that we may cache
+    //
+
+    if (mProgramBinaryCacheRoot.has_value())
+    {
+        glProgramParameteri(*(mPrograms[programIndex].OpenGLHandle), GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+    }
+
+    GameOpenGL::LinkShaderProgram(mPrograms[programIndex].OpenGLHandle, programName);
+}
+
+template<typename Traits>
+bool ShaderManager<Traits>::TryLoadProgramBinary(size_t programIndex)
+{
+    if (!mProgramBinaryCacheRoot.has_value())
+    {
+        return false;
+    }
+
+    auto const & programSource = *(mPrograms[programIndex].Source);
+    std::filesystem::path const programBinaryFilePath = GetProgramBinaryFilePath(programIndex);
+
+    //
+    // Read binary file: key, format, length, binary
+    //
+
+    std::ifstream file(programBinaryFilePath, std::ios::in | std::ios::binary);
+    if (!file.is_open())
+    {
+        return false;
+    }
+
+    uint64_t key;
+    uint32_t binaryFormat;
+    uint32_t binaryLength;
+    file.read(reinterpret_cast<char *>(&key), sizeof(key));
+    file.read(reinterpret_cast<char *>(&binaryFormat), sizeof(binaryFormat));
+    file.read(reinterpret_cast<char *>(&binaryLength), sizeof(binaryLength));
+    if (!file
+        || key != CalculateProgramBinaryCacheKey(programSource.VertexShaderSource, programSource.FragmentShaderSource, mDriverIdentifier))
+    {
+        // Stale
+        return false;
+    }
+
+    std::vector<char> binary(binaryLength);
+    file.read(binary.data(), binaryLength);
+    if (!file)
+    {
+        return false;
+    }
+
+    //
+    // Create program from binary
+    //
+
+    mPrograms[programIndex].OpenGLHandle = GameOpenGLShaderProgram(glCreateProgram());
+    CheckOpenGLError();
+
+    glProgramBinary(
+        *(mPrograms[programIndex].OpenGLHandle),
+        static_cast<GLenum>(binaryFormat),
+        binary.data(),
+        static_cast<GLsizei>(binaryLength));
+
+    GLint success;
+    glGetProgramiv(*(mPrograms[programIndex].OpenGLHandle), GL_LINK_STATUS, &success);
+    if (glGetError() != GL_NO_ERROR || !success)
+    {
+        // Rejected by the driver; we'll rebuild it from source
+        LogMessage("WARNING: program binary \"" + programBinaryFilePath.string() + "\" rejected by driver");
+
+        mPrograms[programIndex].OpenGLHandle = GameOpenGLShaderProgram();
+        return false;
+    }
+
+    return true;
+}
+
+template<typename Traits>
+void ShaderManager<Traits>::SaveProgramBinary(size_t programIndex)
+{
+    if (!mProgramBinaryCacheRoot.has_value())
+    {
+        return;
+    }
+
+    auto const & programSource = *(mPrograms[programIndex].Source);
+    std::filesystem::path const programBinaryFilePath = GetProgramBinaryFilePath(programIndex);
+
+    //
+    // Get binary
+    //
+
+    GLint binaryLength = 0;
+    glGetProgramiv(*(mPrograms[programIndex].OpenGLHandle), GL_PROGRAM_BINARY_LENGTH, &binaryLength);
+    if (glGetError() != GL_NO_ERROR || binaryLength <= 0)
+    {
+        return;
+    }
+
+    std::vector<char> binary(static_cast<size_t>(binaryLength));
+    GLenum binaryFormat;
+    GLsizei actualBinaryLength = 0;
+    glGetProgramBinary(
+        *(mPrograms[programIndex].OpenGLHandle),
+        binaryLength,
+        &actualBinaryLength,
+        &binaryFormat,
+        binary.data());
+    if (glGetError() != GL_NO_ERROR || actualBinaryLength <= 0)
+    {
+        return;
+    }
+
+    //
+    // Write binary file: key, format, length, binary
+    //
+
+    try
+    {
+        std::filesystem::create_directories(*mProgramBinaryCacheRoot);
+
+        std::ofstream file(programBinaryFilePath, std::ios::out | std::ios::binary | std::ios::trunc);
+        if (!file.is_open())
+        {
+            LogMessage("WARNING: cannot create program binary \"" + programBinaryFilePath.string() + "\"");
+            return;
+        }
+
+        uint64_t const key = CalculateProgramBinaryCacheKey(programSource.VertexShaderSource, programSource.FragmentShaderSource, mDriverIdentifier);
+        uint32_t const binaryFormat32 = static_cast<uint32_t>(binaryFormat);
+        uint32_t const binaryLength32 = static_cast<uint32_t>(actualBinaryLength);
+        file.write(reinterpret_cast<char const *>(&key), sizeof(key));
+        file.write(reinterpret_cast<char const *>(&binaryFormat32), sizeof(binaryFormat32));
+        file.write(reinterpret_cast<char const *>(&binaryLength32), sizeof(binaryLength32));
+        file.write(binary.data(), actualBinaryLength);
     }
+    catch (std::exception const & ex)
+    {
+        // Caching is best-effort
+        LogMessage("WARNING: cannot save program binary \"" + programBinaryFilePath.string() + "\": " + ex.what());
+    }
+}
+
+template<typename Traits>
+std::filesystem::path ShaderManager<Traits>::GetProgramBinaryFilePath(size_t programIndex) const
+{
+    assert(mProgramBinaryCacheRoot.has_value());
+
+    return *mProgramBinaryCacheRoot / (Traits::ProgramTypeToStr(static_cast<typename Traits::ProgramType>(programIndex)) + ".bin");
+}
+
+template<typename Traits>
+uint64_t ShaderManager<Traits>::CalculateProgramBinaryCacheKey(
+    std::string const & vertexShaderSource,
+    std::string const & fragmentShaderSource,
+    std::string const & driverIdentifier)
+{
+    // FNV-1a, which - unlike std::hash - is stable across runs and builds
+
+    uint64_t hash = 14695981039346656037ull;
+
+    auto const hashString = [&hash](std::string const & str)
+    {
+        for (char const c : str)
+        {
+            hash ^= static_cast<uint8_t>(c);
+            hash *= 1099511628211ull;
+        }
+
+        // Separator, so that moving text between strings changes the key
+        hash ^= 0xffu;
+        hash *= 1099511628211ull;
+    };
+
+    hashString(vertexShaderSource);
+    hashString(fragmentShaderSource);
+    hashString(driverIdentifier);
+
+    return hash;
 }
 
 template<typename Traits>
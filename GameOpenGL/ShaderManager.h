@@ -6,16 +6,21 @@
 #pragma once
 
 #include "GameOpenGL.h"
+#include "GameOpenGLStateCache.h"
 
 #include <GameCore/Vectors.h>
 
+#include <algorithm>
+#include <array>
 #include <cassert>
 #include <cstdint>
 #include <filesystem>
+#include <functional>
 #include <iomanip>
 #include <limits>
 #include <map>
 #include <memory>
+#include <optional>
 #include <set>
 #include <sstream>
 #include <unordered_map>
@@ -28,6 +33,9 @@ private:
 
     static constexpr GLint NoParameterLocation = std::numeric_limits<GLint>::min();
 
+    // The deferral slot of texture parameters, past all parameter slots
+    static constexpr uint32_t TextureParametersDeferralIndex = std::numeric_limits<uint32_t>::max();
+
     template <typename T>
     static std::string ToString(T const & v)
     {
@@ -43,10 +51,22 @@ private:
 
 public:
 
-    static std::unique_ptr<ShaderManager> CreateInstance(std::filesystem::path const & shadersRoot)
+    /*
+     * Loads and compiles all programs found under the specified root.
+     *
+     * When a program binary cache folder is specified, linked program binaries are
+     * persisted there and re-used by later instances as long as the program sources
+     * and the OpenGL driver do not change.
+     *
+     * Programs that the traits deem as lazily-compiled are only compiled the first
+     * time they are used.
+     */
+    static std::unique_ptr<ShaderManager> CreateInstance(
+        std::filesystem::path const & shadersRoot,
+        std::optional<std::filesystem::path> const & programBinaryCacheRoot = std::nullopt)
     {
         return std::unique_ptr<ShaderManager>(
-            new ShaderManager(shadersRoot));
+            new ShaderManager(shadersRoot, programBinaryCacheRoot));
     }
 
     template <typename Traits::ProgramType Program>
@@ -54,6 +74,8 @@ public:
     {
         uint32_t constexpr programIndex = static_cast<uint32_t>(Program);
 
+        EnsureProgramCompiled(programIndex);
+
         return *(mPrograms[programIndex].OpenGLHandle);
     }
 
@@ -62,6 +84,12 @@ public:
     {
         size_t programIndex = static_cast<size_t>(Program);
 
+        if (!(mPrograms[programIndex].OpenGLHandle))
+        {
+            DeferProgramParameter(programIndex, TextureParametersDeferralIndex, [this]() { SetTextureParameters<Program>(); });
+            return;
+        }
+
         // Find all texture parameters
         for (size_t parameterIndex = 0; parameterIndex < mPrograms[programIndex].UniformLocations.size(); ++parameterIndex)
         {
@@ -105,6 +133,12 @@ public:
         uint32_t const programIndex = static_cast<uint32_t>(program);
         uint32_t constexpr ParameterIndex = static_cast<uint32_t>(Parameter);
 
+        if (!(mPrograms[programIndex].OpenGLHandle))
+        {
+            DeferProgramParameter(programIndex, ParameterIndex, [this, program, value]() { SetProgramParameter<Parameter>(program, value); });
+            return;
+        }
+
         assert(mPrograms[programIndex].UniformLocations[ParameterIndex] != NoParameterLocation);
 
         glUniform1f(
@@ -126,6 +160,12 @@ public:
         constexpr uint32_t programIndex = static_cast<uint32_t>(Program);
         constexpr uint32_t parameterIndex = static_cast<uint32_t>(Parameter);
 
+        if (!(mPrograms[programIndex].OpenGLHandle))
+        {
+            DeferProgramParameter(programIndex, parameterIndex, [this, val1, val2]() { SetProgramParameter<Program, Parameter>(val1, val2); });
+            return;
+        }
+
         assert(mPrograms[programIndex].UniformLocations[parameterIndex] != NoParameterLocation);
 
         glUniform2f(
@@ -150,6 +190,12 @@ public:
         uint32_t const programIndex = static_cast<uint32_t>(program);
         uint32_t constexpr ParameterIndex = static_cast<uint32_t>(Parameter);
 
+        if (!(mPrograms[programIndex].OpenGLHandle))
+        {
+            DeferProgramParameter(programIndex, ParameterIndex, [this, program, val]() { SetProgramParameter<Parameter>(program, val); });
+            return;
+        }
+
         assert(mPrograms[programIndex].UniformLocations[ParameterIndex] != NoParameterLocation);
 
         glUniform3f(
@@ -167,6 +213,12 @@ public:
         constexpr uint32_t programIndex = static_cast<uint32_t>(Program);
         constexpr uint32_t parameterIndex = static_cast<uint32_t>(Parameter);
 
+        if (!(mPrograms[programIndex].OpenGLHandle))
+        {
+            DeferProgramParameter(programIndex, parameterIndex, [this, val]() { SetProgramParameter<Program, Parameter>(val); });
+            return;
+        }
+
         assert(mPrograms[programIndex].UniformLocations[parameterIndex] != NoParameterLocation);
 
         glUniform4f(
@@ -193,6 +245,19 @@ public:
         uint32_t const programIndex = static_cast<uint32_t>(program);
         uint32_t constexpr ParameterIndex = static_cast<uint32_t>(Parameter);
 
+        if (!(mPrograms[programIndex].OpenGLHandle))
+        {
+            std::array<float, 16> matrix;
+            std::copy(&(value[0][0]), &(value[0][0]) + 16, matrix.data());
+
+            DeferProgramParameter(programIndex, ParameterIndex, [this, program, matrix]()
+                {
+                    SetProgramParameter<Parameter>(program, reinterpret_cast<float const (*)[4]>(matrix.data()));
+                });
+
+            return;
+        }
+
         assert(mPrograms[programIndex].UniformLocations[ParameterIndex] != NoParameterLocation);
 
         glUniformMatrix4fv(
@@ -213,6 +278,18 @@ public:
         uint32_t const programIndex = static_cast<uint32_t>(program);
         uint32_t constexpr ParameterIndex = static_cast<uint32_t>(Parameter);
 
+        if (!(mPrograms[programIndex].OpenGLHandle))
+        {
+            std::vector<vec4f> vectors(array, array + vectorCount);
+
+            DeferProgramParameter(programIndex, ParameterIndex, [this, program, vectors]()
+                {
+                    SetProgramParameterVec4fArray<Parameter>(program, vectors.data(), vectors.size());
+                });
+
+            return;
+        }
+
         assert(mPrograms[programIndex].UniformLocations[ParameterIndex] != NoParameterLocation);
 
         glUniform4fv(
@@ -230,14 +307,43 @@ public:
         ActivateProgram(Program);
     }
 
+    /*
+     * Activates the specified program for the sole purpose of setting its parameters.
+     *
+     * Programs that have not been compiled yet are not compiled by this call; instead,
+     * the parameters set on them are remembered and applied when they are compiled,
+     * the first time they are actually activated.
+     */
+    template <typename Traits::ProgramType Program>
+    inline void ActivateProgramForParameters()
+    {
+        ActivateProgramForParameters(Program);
+    }
+
+    inline void ActivateProgramForParameters(typename Traits::ProgramType program)
+    {
+        uint32_t const programIndex = static_cast<uint32_t>(program);
+
+        if (!!(mPrograms[programIndex].OpenGLHandle))
+        {
+            if (mStateCache.UseProgram(*(mPrograms[programIndex].OpenGLHandle)))
+            {
+                CheckOpenGLError();
+            }
+        }
+    }
+
     // At any given moment, only one program may be active
     inline void ActivateProgram(typename Traits::ProgramType program)
     {
         uint32_t const programIndex = static_cast<uint32_t>(program);
 
-        glUseProgram(*(mPrograms[programIndex].OpenGLHandle));
+        EnsureProgramCompiled(programIndex);
 
-        CheckOpenGLError();
+        if (mStateCache.UseProgram(*(mPrograms[programIndex].OpenGLHandle)))
+        {
+            CheckOpenGLError();
+        }
     }
 
     // At any given moment, only one texture (unit) may be active
@@ -246,15 +352,25 @@ public:
     {
         GLenum const textureUnit = static_cast<GLenum>(Parameter) - static_cast<GLenum>(Traits::ProgramParameterType::_FirstTexture);
 
-        glActiveTexture(GL_TEXTURE0 + textureUnit);
-
-        GLenum const glError = glGetError();
-        if (GL_NO_ERROR != glError)
+        if (mStateCache.ActiveTexture(textureUnit))
         {
-            throw GameException("Error activating texture " + std::to_string(textureUnit) + ": " + std::to_string(glError));
+            GLenum const glError = glGetError();
+            if (GL_NO_ERROR != glError)
+            {
+                throw GameException("Error activating texture " + std::to_string(textureUnit) + ": " + std::to_string(glError));
+            }
         }
     }
 
+    /*
+     * To be invoked after the current program or the active texture unit have been
+     * changed without going through this class.
+     */
+    inline void InvalidateStateCache()
+    {
+        mStateCache.Invalidate();
+    }
+
 private:
 
     template <typename Traits::ProgramType Program, typename Traits::ProgramParameterType Parameter>
@@ -277,14 +393,47 @@ private:
 private:
 
     ShaderManager(
-        std::filesystem::path const & shadersRoot);
+        std::filesystem::path const & shadersRoot,
+        std::optional<std::filesystem::path> const & programBinaryCacheRoot);
 
-    void CompileShader(
+    void PrepareProgram(
         std::string const & shaderFilename,
         std::string const & shaderSource,
         std::unordered_map<std::string, std::pair<bool, std::string>> const & shaderSources,
         std::map<std::string, std::string> const & staticParameters);
 
+    inline void EnsureProgramCompiled(size_t programIndex)
+    {
+        if (!(mPrograms[programIndex].OpenGLHandle))
+        {
+            CompileProgram(programIndex);
+        }
+    }
+
+    void CompileProgram(size_t programIndex);
+
+    inline void DeferProgramParameter(
+        size_t programIndex,
+        uint32_t parameterIndex,
+        std::function<void()> && setter)
+    {
+        // Later settings of the same parameter replace earlier ones
+        mPrograms[programIndex].DeferredParameterSetters[parameterIndex] = std::move(setter);
+    }
+
+    void BuildProgramFromSource(size_t programIndex);
+
+    bool TryLoadProgramBinary(size_t programIndex);
+
+    void SaveProgramBinary(size_t programIndex);
+
+    std::filesystem::path GetProgramBinaryFilePath(size_t programIndex) const;
+
+    static uint64_t CalculateProgramBinaryCacheKey(
+        std::string const & vertexShaderSource,
+        std::string const & fragmentShaderSource,
+        std::string const & driverIdentifier);
+
     static std::string ResolveIncludes(
         std::string const & shaderSource,
         std::unordered_map<std::string, std::pair<bool, std::string>> const & shaderSources);
@@ -305,19 +454,45 @@ private:
 
 private:
 
+    struct ProgramSource
+    {
+        std::string ShaderFilename;
+        std::string VertexShaderSource;
+        std::string FragmentShaderSource;
+    };
+
     struct ProgramInfo
     {
-        // The OpenGL handle to the program
+        // The preprocessed sources of the program; only set once the
+        // program's shader file has been found
+        std::optional<ProgramSource> Source;
+
+        // The OpenGL handle to the program; only set once the program
+        // has been compiled
         GameOpenGLShaderProgram OpenGLHandle;
 
         // The uniform locations, indexed by shader parameter type;
         // set to NoLocation when not specified in the shader
         std::vector<GLint> UniformLocations;
+
+        // The parameter settings received before the program was compiled,
+        // indexed by shader parameter type
+        std::map<uint32_t, std::function<void()>> DeferredParameterSetters;
     };
 
     // All programs, indexed by program type
     std::vector<ProgramInfo> mPrograms;
 
+    // Where we persist program binaries; not set when caching is disabled
+    // or not supported by the driver
+    std::optional<std::filesystem::path> mProgramBinaryCacheRoot;
+
+    // Identifies the driver that program binaries are built for
+    std::string mDriverIdentifier;
+
+    // Filters redundant program and texture unit activations
+    GameOpenGLStateCache mStateCache;
+
 private:
 
     friend class ShaderManagerTests_ProcessesIncludes_OneLevel_Test;
@@ -354,6 +529,10 @@ private:
     friend class ShaderManagerTests_ExtractsVertexAttributeNames_Multiple_Test;
     friend class ShaderManagerTests_ExtractsVertexAttributeNames_ErrorsOnUnrecognizedAttribute_Test;
     friend class ShaderManagerTests_ExtractsVertexAttributeNames_ErrorsOnRedeclaredAttribute_Test;
+
+    friend class ShaderManagerTests_ProgramBinaryCacheKey_IsStable_Test;
+    friend class ShaderManagerTests_ProgramBinaryCacheKey_ChangesWithSources_Test;
+    friend class ShaderManagerTests_ProgramBinaryCacheKey_ChangesWithDriver_Test;
 };
 
 #include "ShaderManager.cpp.inl"
@@ -0,0 +1,141 @@
+/***************************************************************************************
+* Original Author:      Gabriele Giuseppini
+* Created:              2026-10-14
+* Copyright:            Gabriele Giuseppini  (https://github.com/GabrieleGiuseppini)
+***************************************************************************************/
+#include "AllocationCounter.h"
+
+#include <cstdlib>
+#include <new>
+
+//
+// Replacements of the global allocation functions, which count allocations
+// and otherwise behave as the default ones
+//
+
+static thread_local size_t ThreadAllocationCount = 0;
+
+size_t AllocationCounter::GetThreadAllocationCount() noexcept
+{
+    return ThreadAllocationCount;
+}
+
+static void * CountedAllocate(size_t size) noexcept
+{
+    ++ThreadAllocationCount;
+    return std::malloc(size == 0 ? 1 : size);
+}
+
+static void * CountedAllocateAligned(
+    size_t size,
+    std::align_val_t alignment) noexcept
+{
+    ++ThreadAllocationCount;
+
+    size_t const align = static_cast<size_t>(alignment);
+
+#if defined(_MSC_VER)
+    return _aligned_malloc(size == 0 ? 1 : size, align);
+#else
+    void * ptr = nullptr;
+    if (posix_memalign(&ptr, align < sizeof(void *) ? sizeof(void *) : align, size == 0 ? 1 : size) != 0)
+        return nullptr;
+
+    return ptr;
+#endif
+}
+
+static void FreeAligned(void * ptr) noexcept
+{
+#if defined(_MSC_VER)
+    _aligned_free(ptr);
+#else
+    std::free(ptr);
+#endif
+}
+
+void * operator new(size_t size)
+{
+    void * const ptr = CountedAllocate(size);
+    if (ptr == nullptr)
+        throw std::bad_alloc();
+
+    return ptr;
+}
+
+void * operator new[](size_t size)
+{
+    void * const ptr = CountedAllocate(size);
+    if (ptr == nullptr)
+        throw std::bad_alloc();
+
+    return ptr;
+}
+
+void * operator new(size_t size, std::nothrow_t const &) noexcept
+{
+    return CountedAllocate(size);
+}
+
+void * operator new[](size_t size, std::nothrow_t const &) noexcept
+{
+    return CountedAllocate(size);
+}
+
+void * operator new(size_t size, std::align_val_t alignment)
+{
+    void * const ptr = CountedAllocateAligned(size, alignment);
+    if (ptr == nullptr)
+        throw std::bad_alloc();
+
+    return ptr;
+}
+
+void * operator new[](size_t size, std::align_val_t alignment)
+{
+    void * const ptr = CountedAllocateAligned(size, alignment);
+    if (ptr == nullptr)
+        throw std::bad_alloc();
+
+    return ptr;
+}
+
+void operator delete(void * ptr) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete[](void * ptr) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete(void * ptr, size_t) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete[](void * ptr, size_t) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete(void * ptr, std::align_val_t) noexcept
+{
+    FreeAligned(ptr);
+}
+
+void operator delete[](void * ptr, std::align_val_t) noexcept
+{
+    FreeAligned(ptr);
+}
+
+void operator delete(void * ptr, size_t, std::align_val_t) noexcept
+{
+    FreeAligned(ptr);
+}
+
+void operator delete[](void * ptr, size_t, std::align_val_t) noexcept
+{
+    FreeAligned(ptr);
+}
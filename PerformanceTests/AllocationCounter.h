@@ -0,0 +1,35 @@
+/***************************************************************************************
+* Original Author:      Gabriele Giuseppini
+* Created:              2026-10-14
+* Copyright:            Gabriele Giuseppini  (https://github.com/GabrieleGiuseppini)
+***************************************************************************************/
+#pragma once
+
+#include <cstddef>
+
+/*
+ * Counts the heap allocations - i.e. the invocations of any flavor of the global
+ * operator new - made by the current thread during the lifetime of the counter.
+ *
+ * Allocations made with malloc & co. are not seen, hence containers that use
+ * them are better checked for stable data pointers.
+ */
+class AllocationCounter final
+{
+public:
+
+    AllocationCounter()
+        : mStartCount(GetThreadAllocationCount())
+    {}
+
+    size_t GetCount() const noexcept
+    {
+        return GetThreadAllocationCount() - mStartCount;
+    }
+
+    static size_t GetThreadAllocationCount() noexcept;
+
+private:
+
+    size_t const mStartCount;
+};
@@ -0,0 +1,277 @@
+#include "AllocationCounter.h"
+
+#include <GameCore/BoundedVector.h>
+#include <GameCore/Buffer2D.h>
+#include <GameCore/CircularList.h>
+#include <GameCore/FixedSizeVector.h>
+#include <GameCore/GameTypes.h>
+#include <GameCore/TemporallyCoherentPriorityQueue.h>
+#include <GameCore/TruncatedPriorityQueue.h>
+
+#include "gtest/gtest.h"
+
+#include <cmath>
+#include <cstdint>
+
+//
+// These tests guard the complexity - rather than the correctness - of the core
+// containers: each hot-path operation is checked for the heap allocations it makes,
+// and for the number of elementary operations it takes as the container grows.
+//
+
+namespace /* anonymous */ {
+
+    // Counts the comparisons made by the priority queues
+    struct CountingLessEqual
+    {
+        static inline size_t Count = 0;
+
+        bool operator()(float a, float b) const noexcept
+        {
+            ++Count;
+            return a <= b;
+        }
+    };
+
+    // Deterministic, non-monotonic priorities
+    float MakePriority(size_t i)
+    {
+        return static_cast<float>((i * 2654435761u) % 100003u);
+    }
+
+    size_t CeilLog2(size_t n)
+    {
+        return static_cast<size_t>(std::ceil(std::log2(static_cast<double>(n))));
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////
+// TruncatedPriorityQueue
+///////////////////////////////////////////////////////////////////////////////////////////////////////
+
+TEST(ContainersPerformanceTests, TruncatedPriorityQueue_Emplace_DoesNotAllocate)
+{
+    TruncatedPriorityQueue<float> q(256);
+
+    AllocationCounter counter;
+
+    for (int round = 0; round < 3; ++round)
+    {
+        for (size_t i = 0; i < 10000; ++i)
+        {
+            q.emplace(static_cast<ElementIndex>(i), MakePriority(i));
+        }
+
+        q.clear(128);
+    }
+
+    EXPECT_EQ(0u, counter.GetCount());
+}
+
+TEST(ContainersPerformanceTests, TruncatedPriorityQueue_Emplace_IsLogarithmicInMaxSize)
+{
+    for (size_t const maxSize : { 16u, 256u, 4096u })
+    {
+        TruncatedPriorityQueue<float, CountingLessEqual> q(maxSize);
+
+        size_t constexpr EmplaceCount = 100000;
+
+        CountingLessEqual::Count = 0;
+
+        for (size_t i = 0; i < EmplaceCount; ++i)
+        {
+            q.emplace(static_cast<ElementIndex>(i), MakePriority(i));
+        }
+
+        // One comparison with the root, plus two per level on the way down
+        size_t const maxComparisons = EmplaceCount * (1 + 2 * CeilLog2(maxSize + 1));
+
+        EXPECT_LE(CountingLessEqual::Count, maxComparisons) << "max size: " << maxSize;
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////
+// TemporallyCoherentPriorityQueue
+///////////////////////////////////////////////////////////////////////////////////////////////////////
+
+TEST(ContainersPerformanceTests, TemporallyCoherentPriorityQueue_AddUpdatePop_DoesNotAllocate)
+{
+    size_t constexpr Size = 1000;
+
+    TemporallyCoherentPriorityQueue<float> q(Size);
+
+    AllocationCounter counter;
+
+    for (int round = 0; round < 3; ++round)
+    {
+        for (size_t i = 0; i < Size; ++i)
+        {
+            q.add_or_update(static_cast<ElementIndex>(i), MakePriority(i));
+        }
+
+        for (size_t i = 0; i < Size; i += 2)
+        {
+            q.add_or_update(static_cast<ElementIndex>(i), MakePriority(i + 7));
+        }
+
+        for (size_t i = 1; i < Size; i += 4)
+        {
+            q.remove_if_in(static_cast<ElementIndex>(i));
+        }
+
+        while (!q.empty())
+        {
+            q.pop();
+        }
+
+        q.clear();
+    }
+
+    EXPECT_EQ(0u, counter.GetCount());
+}
+
+TEST(ContainersPerformanceTests, TemporallyCoherentPriorityQueue_Operations_AreLogarithmicInSize)
+{
+    for (size_t const size : { 64u, 1024u, 16384u })
+    {
+        TemporallyCoherentPriorityQueue<float, CountingLessEqual> q(size);
+
+        CountingLessEqual::Count = 0;
+
+        for (size_t i = 0; i < size; ++i)
+        {
+            q.add_or_update(static_cast<ElementIndex>(i), MakePriority(i));
+        }
+
+        for (size_t i = 0; i < size; ++i)
+        {
+            q.add_or_update(static_cast<ElementIndex>(i), MakePriority(i + 13));
+        }
+
+        while (!q.empty())
+        {
+            q.pop();
+        }
+
+        // Three passes over all elements, each one taking - at most - one comparison
+        // to decide the direction, plus two per level
+        size_t const maxComparisons = 3 * size * (1 + 2 * CeilLog2(size + 1));
+
+        EXPECT_LE(CountingLessEqual::Count, maxComparisons) << "size: " << size;
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////
+// CircularList
+///////////////////////////////////////////////////////////////////////////////////////////////////////
+
+TEST(ContainersPerformanceTests, CircularList_EmplaceAndErase_DoNotAllocate)
+{
+    CircularList<std::uint64_t, 64> cl;
+
+    AllocationCounter counter;
+
+    size_t purgedCount = 0;
+    for (std::uint64_t i = 0; i < 1000; ++i)
+    {
+        cl.emplace(
+            [&purgedCount](std::uint64_t)
+            {
+                ++purgedCount;
+            },
+            i);
+    }
+
+    cl.erase(cl.begin());
+    cl.clear();
+
+    EXPECT_EQ(0u, counter.GetCount());
+    EXPECT_EQ(1000u - 64u, purgedCount);
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////
+// FixedSizeVector
+///////////////////////////////////////////////////////////////////////////////////////////////////////
+
+TEST(ContainersPerformanceTests, FixedSizeVector_PushAndErase_DoNotAllocate)
+{
+    FixedSizeVector<std::uint64_t, 128> v;
+
+    AllocationCounter counter;
+
+    for (int round = 0; round < 10; ++round)
+    {
+        for (std::uint64_t i = 0; i < 128; ++i)
+        {
+            v.push_back(i);
+        }
+
+        v.clear();
+    }
+
+    EXPECT_EQ(0u, counter.GetCount());
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////
+// BoundedVector
+///////////////////////////////////////////////////////////////////////////////////////////////////////
+
+TEST(ContainersPerformanceTests, BoundedVector_EmplaceBack_DoesNotReallocateAfterReset)
+{
+    BoundedVector<std::uint64_t> v;
+    v.reset(1000);
+
+    // BoundedVector allocates with malloc, hence we check that its buffer stays put
+    std::uint64_t const * const buffer = v.data();
+
+    AllocationCounter counter;
+
+    for (int round = 0; round < 3; ++round)
+    {
+        for (std::uint64_t i = 0; i < 1000; ++i)
+        {
+            v.emplace_back(i);
+        }
+
+        v.ensure_size(1000);
+        v.reset(500);
+    }
+
+    EXPECT_EQ(0u, counter.GetCount());
+    EXPECT_EQ(buffer, v.data());
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////
+// Buffer2D
+///////////////////////////////////////////////////////////////////////////////////////////////////////
+
+TEST(ContainersPerformanceTests, Buffer2D_ConstructionAndClone_AllocateOnce)
+{
+    using TestBuffer2D = Buffer2D<int, struct IntegralTag>;
+
+    {
+        AllocationCounter counter;
+
+        TestBuffer2D buffer(100, 200, 242);
+
+        EXPECT_EQ(1u, counter.GetCount());
+    }
+
+    TestBuffer2D buffer(100, 200, 242);
+
+    {
+        AllocationCounter counter;
+
+        auto clone = buffer.Clone();
+
+        EXPECT_EQ(1u, counter.GetCount());
+    }
+
+    {
+        AllocationCounter counter;
+
+        TestBuffer2D moved(std::move(buffer));
+
+        EXPECT_EQ(0u, counter.GetCount());
+    }
+}
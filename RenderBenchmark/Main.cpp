@@ -0,0 +1,559 @@
+/***************************************************************************************
+ * Original Author:     Gabriele Giuseppini
+ * Created:             2026-10-14
+ * Copyright:           Gabriele Giuseppini  (https://github.com/GabrieleGiuseppini)
+ ***************************************************************************************/
+
+#include <Game/FishSpeciesDatabase.h>
+#include <Game/GameEventDispatcher.h>
+#include <Game/GameParameters.h>
+#include <Game/MaterialDatabase.h>
+#include <Game/PerfStats.h>
+#include <Game/Physics.h>
+#include <Game/RenderContext.h>
+#include <Game/RenderDeviceProperties.h>
+#include <Game/ResourceLocator.h>
+#include <Game/ShipDeSerializer.h>
+#include <Game/ShipFactory.h>
+#include <Game/ShipStrengthRandomizer.h>
+#include <Game/ShipTexturizer.h>
+
+#include <GameOpenGL/GameOpenGL.h>
+
+#include <GameCore/GameChronometer.h>
+#include <GameCore/GameException.h>
+#include <GameCore/GameRandomEngine.h>
+#include <GameCore/Profiler.h>
+#include <GameCore/TaskThreadPool.h>
+
+#include <wx/app.h>
+#include <wx/frame.h>
+#include <wx/glcanvas.h>
+
+#include <algorithm>
+#include <cassert>
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#define SEPARATOR "------------------------------------------------------"
+
+/*
+ * Renders one or more ships for a fixed number of frames into an offscreen
+ * framebuffer, and reports the CPU time taken by uploads and draws, and the
+ * GPU time taken by each render segment.
+ *
+ * The frames are a fixed workload: the simulation is single-threaded and its
+ * random sequence is reset at each run, hence - for a given ship and options -
+ * each frame uploads the very same buffers at each run. The simulation steps
+ * in between frames are not measured.
+ */
+
+struct BenchmarkOptions
+{
+    size_t FrameCount;
+    size_t WarmUpFrameCount;
+    size_t StepsPerFrame;
+    DisplayLogicalSize CanvasSize;
+
+    BenchmarkOptions()
+        : FrameCount(600)
+        , WarmUpFrameCount(60)
+        , StepsPerFrame(1)
+        , CanvasSize(1920, 1080)
+    {}
+};
+
+/*
+ * The OpenGL context the benchmark renders with: the context of a small, dummy
+ * canvas, whose default framebuffer is replaced by a framebuffer of the size
+ * of the benchmark canvas.
+ */
+class OffscreenOpenGLContext
+{
+public:
+
+    OffscreenOpenGLContext()
+    {
+        mFrame = std::make_unique<wxFrame>(
+            nullptr, // No parent
+            wxID_ANY,
+            "RenderBenchmark Dummy Frame",
+            wxDefaultPosition,
+            wxSize(100, 100),
+            wxSTAY_ON_TOP);
+
+        // Note: Using the wxWidgets 3.1 style does not work on OpenGL 4 drivers; it forces a 1.1.0 context
+
+        int glCanvasAttributes[] =
+        {
+            WX_GL_RGBA,
+            WX_GL_DOUBLEBUFFER,
+            WX_GL_DEPTH_SIZE,      16,
+            WX_GL_STENCIL_SIZE,    1,
+            0, 0
+        };
+
+        mGLCanvas = std::make_unique<wxGLCanvas>(
+            mFrame.get(),
+            wxID_ANY,
+            glCanvasAttributes,
+            wxDefaultPosition,
+            wxSize(100, 100),
+            0L);
+
+        mGLContext = std::make_unique<wxGLContext>(mGLCanvas.get());
+
+        // Some platforms only make contexts current on canvases that are shown
+        mFrame->Show();
+    }
+
+    ~OffscreenOpenGLContext()
+    {
+        assert(!!mFrame);
+        mFrame->Destroy();
+    }
+
+    void MakeCurrent()
+    {
+        mGLContext->SetCurrent(*mGLCanvas);
+
+        if (!!mFramebuffer)
+        {
+            glBindFramebuffer(GL_FRAMEBUFFER, *mFramebuffer);
+        }
+    }
+
+    /*
+     * Creates the framebuffer and binds it, from now on and whenever the context
+     * is made current; requires OpenGL to be initialized.
+     */
+    void CreateFramebuffer(DisplayPhysicalSize const & size)
+    {
+        // Replace the framebuffer of an earlier run, if any
+        mDepthRenderbuffer.reset();
+        mColorRenderbuffer.reset();
+        mFramebuffer.reset();
+
+        GLuint tmpGLuint;
+
+        glGenFramebuffers(1, &tmpGLuint);
+        mFramebuffer = tmpGLuint;
+
+        glBindFramebuffer(GL_FRAMEBUFFER, *mFramebuffer);
+        CheckOpenGLError();
+
+        glGenRenderbuffers(1, &tmpGLuint);
+        mColorRenderbuffer = tmpGLuint;
+
+        glBindRenderbuffer(GL_RENDERBUFFER, *mColorRenderbuffer);
+        glRenderbufferStorage(GL_RENDERBUFFER, GL_RGBA8, size.width, size.height);
+        glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_RENDERBUFFER, *mColorRenderbuffer);
+        CheckOpenGLError();
+
+        // Ships are drawn with depth test
+        glGenRenderbuffers(1, &tmpGLuint);
+        mDepthRenderbuffer = tmpGLuint;
+
+        glBindRenderbuffer(GL_RENDERBUFFER, *mDepthRenderbuffer);
+        glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH_COMPONENT16, size.width, size.height);
+        glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_RENDERBUFFER, *mDepthRenderbuffer);
+        CheckOpenGLError();
+
+        glBindRenderbuffer(GL_RENDERBUFFER, 0);
+
+        if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE)
+        {
+            throw GameException("Framebuffer is not complete");
+        }
+    }
+
+private:
+
+    std::unique_ptr<wxFrame> mFrame;
+    std::unique_ptr<wxGLCanvas> mGLCanvas;
+    std::unique_ptr<wxGLContext> mGLContext;
+
+    GameOpenGLFramebuffer mFramebuffer;
+    GameOpenGLRenderbuffer mColorRenderbuffer;
+    GameOpenGLRenderbuffer mDepthRenderbuffer;
+};
+
+void RunBenchmark(
+    std::filesystem::path const & shipFilePath,
+    BenchmarkOptions const & options,
+    ResourceLocator const & resourceLocator,
+    MaterialDatabase const & materialDatabase,
+    FishSpeciesDatabase const & fishSpeciesDatabase,
+    ShipTexturizer const & shipTexturizer,
+    OffscreenOpenGLContext & openGLContext);
+
+void PrintStageTimings(
+    std::vector<Profiler::ZoneSample> const & samples,
+    size_t frameCount);
+
+void PrintUsage();
+
+class RenderBenchmarkApp : public wxApp
+{
+public:
+
+    // Runs the benchmark without ever entering the event loop
+    virtual int OnRun() override;
+};
+
+IMPLEMENT_APP(RenderBenchmarkApp);
+
+int RenderBenchmarkApp::OnRun()
+{
+    BenchmarkOptions options;
+    std::vector<std::filesystem::path> shipFilePaths;
+
+    try
+    {
+        for (int i = 1; i < argc; ++i)
+        {
+            std::string option(argv[i].ToStdString());
+            if (option == "-n" || option == "-w" || option == "-s")
+            {
+                ++i;
+                if (i == argc)
+                {
+                    throw std::runtime_error(option + " option specified without a number");
+                }
+
+                size_t const value = static_cast<size_t>(std::stoul(argv[i].ToStdString()));
+                if (option == "-n")
+                    options.FrameCount = value;
+                else if (option == "-w")
+                    options.WarmUpFrameCount = value;
+                else
+                    options.StepsPerFrame = value;
+            }
+            else if (option == "-r")
+            {
+                ++i;
+                if (i == argc)
+                {
+                    throw std::runtime_error("-r option specified without a resolution");
+                }
+
+                std::string const resolution(argv[i].ToStdString());
+                auto const xPos = resolution.find('x');
+                if (xPos == std::string::npos)
+                {
+                    throw std::runtime_error("Resolution '" + resolution + "' is not in the <width>x<height> format");
+                }
+
+                options.CanvasSize = DisplayLogicalSize(
+                    std::stoi(resolution.substr(0, xPos)),
+                    std::stoi(resolution.substr(xPos + 1)));
+            }
+            else if (option == "-h" || option == "--help")
+            {
+                PrintUsage();
+                return 0;
+            }
+            else if (!option.empty() && option[0] == '-')
+            {
+                throw std::runtime_error("Unrecognized option '" + option + "'");
+            }
+            else
+            {
+                shipFilePaths.emplace_back(option);
+            }
+        }
+
+        ResourceLocator const resourceLocator(argv[0].ToStdString());
+
+        if (shipFilePaths.empty())
+        {
+            shipFilePaths.emplace_back(resourceLocator.GetDefaultShipDefinitionFilePath());
+        }
+
+        auto const materialDatabase = MaterialDatabase::Load(resourceLocator);
+        auto const fishSpeciesDatabase = FishSpeciesDatabase::Load(resourceLocator);
+        ShipTexturizer const shipTexturizer(materialDatabase, resourceLocator);
+
+        OffscreenOpenGLContext openGLContext;
+
+        for (auto const & shipFilePath : shipFilePaths)
+        {
+            RunBenchmark(
+                shipFilePath,
+                options,
+                resourceLocator,
+                materialDatabase,
+                fishSpeciesDatabase,
+                shipTexturizer,
+                openGLContext);
+        }
+    }
+    catch (std::exception & ex)
+    {
+        std::cout << "ERROR: " << ex.what() << std::endl;
+        return -1;
+    }
+
+    return 0;
+}
+
+void RunBenchmark(
+    std::filesystem::path const & shipFilePath,
+    BenchmarkOptions const & options,
+    ResourceLocator const & resourceLocator,
+    MaterialDatabase const & materialDatabase,
+    FishSpeciesDatabase const & fishSpeciesDatabase,
+    ShipTexturizer const & shipTexturizer,
+    OffscreenOpenGLContext & openGLContext)
+{
+    std::cout << SEPARATOR << std::endl;
+    std::cout << "Running render benchmark:" << std::endl;
+    std::cout << "  ship       : " << shipFilePath << std::endl;
+    std::cout << "  frames     : " << options.FrameCount << " (+" << options.WarmUpFrameCount << " warm-up)" << std::endl;
+    std::cout << "  steps      : " << options.StepsPerFrame << " per frame" << std::endl;
+    std::cout << "  canvas     : " << options.CanvasSize.width << "x" << options.CanvasSize.height << std::endl;
+
+    // Make sure each run sees the same random sequence - and thus the same frames
+    GameRandomEngine::GetInstance().Reset();
+
+    GameParameters gameParameters;
+    gameParameters.DoUpdateShipsConcurrently = false;
+    gameParameters.DoUpdateOceanSurfaceConcurrently = false;
+
+    PerfStats perfStats;
+
+    //
+    // Create render context
+    //
+    // Rendering happens on this thread, so that the framebuffer we bind is the one
+    // the render context draws to, and so that draws do not overlap uploads
+    //
+
+    Render::RenderContext renderContext(
+        RenderDeviceProperties(
+            options.CanvasSize,
+            1, // Logical to physical display factor
+            std::nullopt,
+            true, // Force no multithreaded rendering
+            [&openGLContext]()
+            {
+                openGLContext.MakeCurrent();
+            },
+            []()
+            {
+                // Nop: nobody looks at the framebuffer
+            }),
+        perfStats,
+        resourceLocator,
+        [](float, ProgressMessageType) {});
+
+    openGLContext.CreateFramebuffer(renderContext.GetCanvasPhysicalSize());
+
+    auto gameEventDispatcher = std::make_shared<GameEventDispatcher>();
+    auto taskThreadPool = std::make_shared<TaskThreadPool>();
+    ShipStrengthRandomizer const shipStrengthRandomizer;
+
+    //
+    // Create world and ship
+    //
+
+    Physics::World world(
+        OceanFloorTerrain::LoadFromImage(resourceLocator.GetDefaultOceanFloorTerrainFilePath()),
+        fishSpeciesDatabase,
+        gameEventDispatcher,
+        taskThreadPool,
+        gameParameters,
+        renderContext.GetVisibleWorld());
+
+    auto shipDefinition = ShipDeSerializer::LoadShip(shipFilePath, materialDatabase);
+
+    auto [ship, textureImage] = ShipFactory::Create(
+        world.GetNextShipId(),
+        world,
+        std::move(shipDefinition),
+        ShipLoadOptions(),
+        materialDatabase,
+        shipTexturizer,
+        shipStrengthRandomizer,
+        gameEventDispatcher,
+        taskThreadPool,
+        gameParameters);
+
+    ShipId const shipId = ship->GetId();
+    world.AddShip(std::move(ship));
+
+    renderContext.AddShip(
+        shipId,
+        world.GetShipPointCount(shipId),
+        std::move(textureImage));
+
+    auto const shipsAABB = world.GetAllShipsAABB();
+    if (shipsAABB.has_value())
+    {
+        renderContext.SetCameraWorldPosition(shipsAABB->CalculateCenter());
+    }
+
+    std::cout << "  points     : " << world.GetShipPointCount(shipId) << std::endl;
+
+    //
+    // Run
+    //
+
+    auto const runFrame = [&](GameChronometer::duration & uploadDuration)
+    {
+        // Simulate - not measured
+        for (size_t s = 0; s < options.StepsPerFrame; ++s)
+        {
+            world.Update(
+                gameParameters,
+                renderContext.GetVisibleWorld(),
+                renderContext.GetStressRenderMode(),
+                perfStats);
+
+            gameEventDispatcher->Flush();
+        }
+
+        renderContext.RenderStart();
+
+        renderContext.SetPointPositionInterpolationFactor(0.0f);
+
+        auto const uploadStartTime = GameChronometer::now();
+
+        {
+            FS_PROFILE_SCOPE("Upload");
+
+            renderContext.UploadStart();
+
+            world.RenderUpload(
+                gameParameters,
+                renderContext,
+                perfStats);
+
+            renderContext.UploadEnd();
+        }
+
+        uploadDuration += GameChronometer::now() - uploadStartTime;
+
+        renderContext.Draw();
+
+        renderContext.RenderEnd();
+
+        // Complete this frame's draw before the next frame's simulation
+        renderContext.WaitForPendingTasks();
+    };
+
+    GameChronometer::duration uploadDuration = GameChronometer::duration::zero();
+
+    for (size_t f = 0; f < options.WarmUpFrameCount; ++f)
+    {
+        runFrame(uploadDuration);
+    }
+
+    uploadDuration = GameChronometer::duration::zero();
+    perfStats.Reset();
+
+    // The profiler's buffers only retain the most recent zones, hence we
+    // drain them at each frame
+    std::vector<Profiler::ZoneSample> samples;
+
+    Profiler::GetInstance().Clear();
+    Profiler::GetInstance().SetEnabled(true);
+
+    for (size_t f = 0; f < options.FrameCount; ++f)
+    {
+        runFrame(uploadDuration);
+
+        auto const frameSamples = Profiler::GetInstance().GetSamples();
+        samples.insert(samples.end(), frameSamples.cbegin(), frameSamples.cend());
+        Profiler::GetInstance().Clear();
+    }
+
+    Profiler::GetInstance().SetEnabled(false);
+
+    //
+    // Report
+    //
+
+    auto const uploadMs = std::chrono::duration<double, std::milli>(uploadDuration).count();
+
+    std::cout << std::fixed << std::setprecision(3);
+    std::cout << "  CPU upload : " << (options.FrameCount > 0 ? uploadMs / static_cast<double>(options.FrameCount) : 0.0) << " ms per frame" << std::endl;
+    std::cout << "  CPU prepare: " << perfStats.TotalUploadRenderDrawDuration.ToRatio<std::chrono::milliseconds>() << " ms per frame" << std::endl;
+    std::cout << "  CPU draw   : " << perfStats.TotalRenderDrawDuration.ToRatio<std::chrono::milliseconds>() << " ms per frame" << std::endl;
+
+    if (GameOpenGL::SupportsTimerQueries)
+    {
+        std::cout << "  GPU world  : " << perfStats.TotalWorldGpuRenderDrawDuration.ToRatio<std::chrono::milliseconds>() << " ms per frame" << std::endl;
+        std::cout << "  GPU ships  : " << perfStats.TotalShipsGpuRenderDrawDuration.ToRatio<std::chrono::milliseconds>() << " ms per frame" << std::endl;
+        std::cout << "  GPU notif. : " << perfStats.TotalNotificationsGpuRenderDrawDuration.ToRatio<std::chrono::milliseconds>() << " ms per frame" << std::endl;
+    }
+    else
+    {
+        std::cout << "  GPU        : n/a (no timer queries)" << std::endl;
+    }
+
+    PrintStageTimings(samples, options.FrameCount);
+}
+
+void PrintStageTimings(
+    std::vector<Profiler::ZoneSample> const & samples,
+    size_t frameCount)
+{
+    struct StageTiming
+    {
+        std::int64_t TotalTicks;
+        size_t Count;
+    };
+
+    // Aggregate all zones by name, across all threads
+    std::map<std::string, StageTiming> stageTimings;
+    for (auto const & sample : samples)
+    {
+        auto & stageTiming = stageTimings[sample.Name];
+        stageTiming.TotalTicks += sample.EndTicks - sample.StartTicks;
+        stageTiming.Count += 1;
+    }
+
+    std::vector<std::pair<std::string, StageTiming>> sortedStageTimings(stageTimings.cbegin(), stageTimings.cend());
+    std::sort(
+        sortedStageTimings.begin(),
+        sortedStageTimings.end(),
+        [](auto const & a, auto const & b)
+        {
+            return a.second.TotalTicks > b.second.TotalTicks;
+        });
+
+    std::cout << std::endl;
+    std::cout << "  " << std::left << std::setw(48) << "Stage" << std::right << std::setw(12) << "Calls" << std::setw(16) << "us/frame" << std::endl;
+
+    for (auto const & [name, stageTiming] : sortedStageTimings)
+    {
+        double const microsecondsPerFrame = frameCount > 0
+            ? static_cast<double>(stageTiming.TotalTicks) / 1000.0 / static_cast<double>(frameCount)
+            : 0.0;
+
+        std::cout << "  " << std::left << std::setw(48) << name << std::right << std::setw(12) << stageTiming.Count << std::setw(16) << microsecondsPerFrame << std::endl;
+    }
+
+    std::cout << std::endl;
+}
+
+void PrintUsage()
+{
+    std::cout << std::endl;
+    std::cout << "Usage:" << std::endl;
+    std::cout << " RenderBenchmark [<ship_file>...] [-n <frames>] [-w <warm_up_frames>] [-s <steps_per_frame>] [-r <width>x<height>]" << std::endl;
+    std::cout << std::endl;
+    std::cout << " Renders each ship - the default ship if none is specified - into an offscreen framebuffer," << std::endl;
+    std::cout << " and reports the CPU and GPU time spent uploading and drawing each frame; with no steps per" << std::endl;
+    std::cout << " frame, the same frame is rendered over and over." << std::endl;
+}
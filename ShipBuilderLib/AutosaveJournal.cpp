@@ -0,0 +1,276 @@
+/***************************************************************************************
+ * Original Author:     Gabriele Giuseppini
+ * Created:             2026-10-14
+ * Copyright:           Gabriele Giuseppini  (https://github.com/GabrieleGiuseppini)
+ ***************************************************************************************/
+#include "AutosaveJournal.h"
+
+#include <Game/ShipDefinitionFormatDeSerializer.h>
+
+#include <GameCore/GameException.h>
+#include <GameCore/Log.h>
+
+#include <cassert>
+#include <string>
+
+namespace ShipBuilder {
+
+static std::string const FileNamePrefix = "autosave.";
+static std::string const SnapshotFileNameSuffix = ".shp2";
+static std::string const JournalFileNameSuffix = ".journal";
+
+AutosaveJournal::AutosaveJournal(std::filesystem::path const & folderPath)
+    : mFolderPath(folderPath)
+    , mGeneration(0)
+    , mSnapshotShape()
+    , mJournaledLayerFraction(0.0f)
+    , mWriterThread(std::make_unique<TaskThread>())
+{
+    // Never clobber files left behind by earlier sessions
+    auto const latestGeneration = FindLatestGeneration(mFolderPath);
+    if (latestGeneration.has_value())
+    {
+        mGeneration = *latestGeneration + 1;
+    }
+}
+
+AutosaveJournal::~AutosaveJournal()
+{
+    // Don't lose any write still pending
+    mWriterThread->QueueSynchronizationPoint()->Wait();
+}
+
+bool AutosaveJournal::HasRecoverableShip() const
+{
+    // Let pending writes - and removals - land first
+    mWriterThread->QueueSynchronizationPoint()->Wait();
+
+    return FindLatestGeneration(mFolderPath).has_value();
+}
+
+ShipDefinition AutosaveJournal::RecoverShip(MaterialDatabase const & materialDatabase) const
+{
+    // Let pending writes - and removals - land first
+    mWriterThread->QueueSynchronizationPoint()->Wait();
+
+    auto const latestGeneration = FindLatestGeneration(mFolderPath);
+    if (!latestGeneration.has_value())
+    {
+        throw GameException("There is no ship to recover");
+    }
+
+    return ShipDefinitionFormatDeSerializer::LoadWithJournal(
+        MakeSnapshotFilePath(mFolderPath, *latestGeneration),
+        MakeJournalFilePath(mFolderPath, *latestGeneration),
+        materialDatabase);
+}
+
+void AutosaveJournal::Reset()
+{
+    mSnapshotShape.reset();
+    mJournaledLayerFraction = 0.0f;
+
+    mWriterThread->QueueTask(
+        [folderPath = mFolderPath]()
+        {
+            RemoveGenerations(folderPath, std::nullopt);
+        });
+}
+
+void AutosaveJournal::Update(ModelController & modelController)
+{
+    if (modelController.IsInEphemeralVisualization())
+    {
+        // Try again later, as the model now contains the ephemeral visualization
+        return;
+    }
+
+    if (!mSnapshotShape.has_value())
+    {
+        if (modelController.IsDirty())
+        {
+            // Time for the first snapshot
+            Compact(modelController);
+        }
+        else
+        {
+            // Nothing worth recovering so far
+            modelController.ClearJournalChanges();
+        }
+
+        return;
+    }
+
+    if (GetShipShape(modelController) != *mSnapshotShape
+        || mJournaledLayerFraction > CompactionJournaledLayerFraction)
+    {
+        Compact(modelController);
+        return;
+    }
+
+    //
+    // Journal changes
+    //
+
+    auto delta = std::make_shared<ShipDefinitionDelta const>(modelController.MakeJournalDelta());
+    if (delta->IsEmpty())
+    {
+        return;
+    }
+
+    float const wholeShipArea = static_cast<float>(delta->ShipSize.GetLinearSize());
+
+    if (delta->StructuralLayerRegion.has_value())
+        mJournaledLayerFraction += static_cast<float>(delta->StructuralLayerRegion->Data.Buffer.Size.GetLinearSize()) / wholeShipArea;
+
+    if (delta->ElectricalLayerRegion.has_value())
+        mJournaledLayerFraction += static_cast<float>(delta->ElectricalLayerRegion->Data.Buffer.Size.GetLinearSize()) / wholeShipArea;
+
+    if (delta->RopesLayer.has_value())
+        mJournaledLayerFraction += 1.0f;
+
+    if (delta->TextureLayerRegion.has_value())
+    {
+        assert(mSnapshotShape->TextureSize.has_value());
+        mJournaledLayerFraction += static_cast<float>(delta->TextureLayerRegion->Data.Buffer.Size.GetLinearSize())
+            / static_cast<float>(mSnapshotShape->TextureSize->GetLinearSize());
+    }
+
+    mWriterThread->QueueTask(
+        [delta, journalFilePath = MakeJournalFilePath(mFolderPath, mGeneration)]()
+        {
+            try
+            {
+                ShipDefinitionFormatDeSerializer::AppendToJournal(*delta, journalFilePath);
+            }
+            catch (std::exception const & exc)
+            {
+                LogMessage("ERROR: Cannot append to autosave journal: ", exc.what());
+            }
+        });
+}
+
+AutosaveJournal::ShipShape AutosaveJournal::GetShipShape(ModelController const & modelController)
+{
+    return ShipShape{
+        modelController.GetShipSize(),
+        modelController.HasLayer(LayerType::Texture) ? modelController.GetTextureSize() : std::optional<ImageSize>(),
+        modelController.HasLayer(LayerType::Electrical),
+        modelController.HasLayer(LayerType::Ropes)
+    };
+}
+
+void AutosaveJournal::Compact(ModelController & modelController)
+{
+    // Snapshot of the model, which may go on changing while we save
+    auto shipDefinition = std::make_shared<ShipDefinition const>(modelController.MakeShipDefinition());
+
+    // The journal of the new generation starts from here
+    modelController.ClearJournalChanges();
+
+    ++mGeneration;
+    mSnapshotShape = GetShipShape(modelController);
+    mJournaledLayerFraction = 0.0f;
+
+    mWriterThread->QueueTask(
+        [shipDefinition, folderPath = mFolderPath, generation = mGeneration]()
+        {
+            try
+            {
+                std::filesystem::create_directories(folderPath);
+
+                ShipDefinitionFormatDeSerializer::Save(
+                    *shipDefinition,
+                    MakeSnapshotFilePath(folderPath, generation));
+
+                // Earlier generations are obsolete now
+                RemoveGenerations(folderPath, generation);
+            }
+            catch (std::exception const & exc)
+            {
+                LogMessage("ERROR: Cannot save autosave snapshot: ", exc.what());
+            }
+        });
+}
+
+std::optional<std::uint32_t> AutosaveJournal::FindLatestGeneration(std::filesystem::path const & folderPath)
+{
+    std::optional<std::uint32_t> latestGeneration;
+
+    std::error_code ec;
+    for (auto const & entry : std::filesystem::directory_iterator(folderPath, ec))
+    {
+        auto const generation = ParseSnapshotGeneration(entry.path());
+        if (generation.has_value()
+            && (!latestGeneration.has_value() || *generation > *latestGeneration))
+        {
+            latestGeneration = generation;
+        }
+    }
+
+    return latestGeneration;
+}
+
+std::optional<std::uint32_t> AutosaveJournal::ParseSnapshotGeneration(std::filesystem::path const & filePath)
+{
+    std::string const fileName = filePath.filename().string();
+
+    if (fileName.size() <= FileNamePrefix.size() + SnapshotFileNameSuffix.size()
+        || fileName.compare(0, FileNamePrefix.size(), FileNamePrefix) != 0
+        || fileName.compare(fileName.size() - SnapshotFileNameSuffix.size(), SnapshotFileNameSuffix.size(), SnapshotFileNameSuffix) != 0)
+    {
+        return std::nullopt;
+    }
+
+    std::string const generationStr = fileName.substr(
+        FileNamePrefix.size(),
+        fileName.size() - FileNamePrefix.size() - SnapshotFileNameSuffix.size());
+
+    if (generationStr.find_first_not_of("0123456789") != std::string::npos)
+    {
+        return std::nullopt;
+    }
+
+    return static_cast<std::uint32_t>(std::stoul(generationStr));
+}
+
+void AutosaveJournal::RemoveGenerations(
+    std::filesystem::path const & folderPath,
+    std::optional<std::uint32_t> generationToKeep)
+{
+    std::error_code ec;
+    for (auto const & entry : std::filesystem::directory_iterator(folderPath, ec))
+    {
+        std::string const fileName = entry.path().filename().string();
+        if (fileName.compare(0, FileNamePrefix.size(), FileNamePrefix) != 0)
+        {
+            continue;
+        }
+
+        if (generationToKeep.has_value()
+            && (entry.path() == MakeSnapshotFilePath(folderPath, *generationToKeep)
+                || entry.path() == MakeJournalFilePath(folderPath, *generationToKeep)))
+        {
+            continue;
+        }
+
+        std::error_code removeEc;
+        std::filesystem::remove(entry.path(), removeEc);
+    }
+}
+
+std::filesystem::path AutosaveJournal::MakeSnapshotFilePath(
+    std::filesystem::path const & folderPath,
+    std::uint32_t generation)
+{
+    return folderPath / (FileNamePrefix + std::to_string(generation) + SnapshotFileNameSuffix);
+}
+
+std::filesystem::path AutosaveJournal::MakeJournalFilePath(
+    std::filesystem::path const & folderPath,
+    std::uint32_t generation)
+{
+    return folderPath / (FileNamePrefix + std::to_string(generation) + JournalFileNameSuffix);
+}
+
+}
@@ -0,0 +1,132 @@
+/***************************************************************************************
+ * Original Author:     Gabriele Giuseppini
+ * Created:             2026-10-14
+ * Copyright:           Gabriele Giuseppini  (https://github.com/GabrieleGiuseppini)
+ ***************************************************************************************/
+#pragma once
+
+#include "ModelController.h"
+
+#include <Game/MaterialDatabase.h>
+#include <Game/ShipDefinition.h>
+
+#include <GameCore/GameTypes.h>
+#include <GameCore/TaskThread.h>
+
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <optional>
+
+namespace ShipBuilder {
+
+/*
+ * Autosaves the ship being edited, so that it may be recovered after a crash.
+ *
+ * A full snapshot of the ship is saved only now and then; in between, the changes
+ * made to the model are appended - as compressed dirty regions - to a journal that
+ * goes together with the snapshot. Snapshots and journal records are all written on
+ * a background thread. The journal is compacted into a new snapshot when the ship's
+ * shape changes, and when the journal has grown too large.
+ *
+ * Each snapshot starts a new "generation" of files, and earlier generations are only
+ * removed after the snapshot has been saved; hence, at any moment the latest
+ * generation with a snapshot is a consistent autosave.
+ */
+class AutosaveJournal final
+{
+public:
+
+    explicit AutosaveJournal(std::filesystem::path const & folderPath);
+
+    ~AutosaveJournal();
+
+    /*
+     * Returns whether the folder contains the autosave of an editing session that
+     * did not end cleanly.
+     */
+    bool HasRecoverableShip() const;
+
+    /*
+     * Loads the latest autosave in the folder, replaying its journal; throws on errors.
+     */
+    ShipDefinition RecoverShip(MaterialDatabase const & materialDatabase) const;
+
+    /*
+     * Starts over, discarding the autosave - on new editing sessions, and after the
+     * ship has been saved or its changes have been discarded.
+     */
+    void Reset();
+
+    /*
+     * Autosaves the changes made to the model since the last invocation; invoked
+     * periodically. Does nothing while the model is in an ephemeral visualization,
+     * and - until a snapshot exists - while the model is not dirty.
+     */
+    void Update(ModelController & modelController);
+
+private:
+
+    struct ShipShape
+    {
+        ShipSpaceSize ShipSize;
+        std::optional<ImageSize> TextureSize;
+        bool HasElectricalLayer;
+        bool HasRopesLayer;
+
+        bool operator==(ShipShape const & other) const
+        {
+            return ShipSize == other.ShipSize
+                && TextureSize == other.TextureSize
+                && HasElectricalLayer == other.HasElectricalLayer
+                && HasRopesLayer == other.HasRopesLayer;
+        }
+
+        bool operator!=(ShipShape const & other) const
+        {
+            return !(*this == other);
+        }
+    };
+
+    static ShipShape GetShipShape(ModelController const & modelController);
+
+    void Compact(ModelController & modelController);
+
+    static std::optional<std::uint32_t> FindLatestGeneration(std::filesystem::path const & folderPath);
+
+    // Returns the generation of the file, if it's a snapshot
+    static std::optional<std::uint32_t> ParseSnapshotGeneration(std::filesystem::path const & filePath);
+
+    // Removes the files of all generations other than the specified one, if any
+    static void RemoveGenerations(
+        std::filesystem::path const & folderPath,
+        std::optional<std::uint32_t> generationToKeep);
+
+    static std::filesystem::path MakeSnapshotFilePath(
+        std::filesystem::path const & folderPath,
+        std::uint32_t generation);
+
+    static std::filesystem::path MakeJournalFilePath(
+        std::filesystem::path const & folderPath,
+        std::uint32_t generation);
+
+private:
+
+    std::filesystem::path const mFolderPath;
+
+    std::uint32_t mGeneration; // Of the current snapshot
+
+    // Set while a snapshot exists for the current session
+    std::optional<ShipShape> mSnapshotShape;
+
+    // Sum, over all layers, of the fraction of the layer journaled since the snapshot
+    float mJournaledLayerFraction;
+
+    // When the journaled fraction exceeds this, it's time to compact
+    static float constexpr CompactionJournaledLayerFraction = 4.0f;
+
+    // Last, so that it's joined before the rest goes away
+    std::unique_ptr<TaskThread> mWriterThread;
+};
+
+}
@@ -85,6 +85,9 @@ Controller::Controller(
     // State
     , mCurrentTool()
     , mLastToolTypePerLayer({ToolType::StructuralPencil, ToolType::ElectricalPencil, ToolType::RopePencil, std::nullopt})
+    , mHasPendingLayerChanges(false)
+    , mHasPendingElectricalLayerChanges(false)
+    , mHasPendingModelMacroPropertiesChanges(false)
 {
     // We assume we start with at least a structural layer
     assert(mModelController->HasLayer(LayerType::Structural));
@@ -434,14 +437,17 @@ void Controller::RestoreElectricalLayerRegionForUndo(
     mUserInterface.RefreshView();
 }
 
-void Controller::RestoreElectricalLayerForUndo(std::unique_ptr<ElectricalLayerData> electricalLayer)
+void Controller::RestoreElectricalLayerForUndo(std::unique_ptr<SparseElectricalLayerData> electricalLayer)
 {
     auto const scopedToolResumeState = SuspendTool();
 
     WrapLikelyLayerPresenceChangingOperation<LayerType::Electrical>(
-        [this, electricalLayer = std::move(electricalLayer)]() mutable
+        [this, electricalLayer = std::move(electricalLayer)]()
         {
-            mModelController->RestoreElectricalLayer(std::move(electricalLayer));
+            mModelController->RestoreElectricalLayer(
+                electricalLayer
+                ? std::make_unique<ElectricalLayerData>(electricalLayer->MakeDense())
+                : nullptr);
         });
 
     // No need to update dirtyness, this is for undo
@@ -579,6 +585,22 @@ void Controller::RestoreTextureLayerRegionForUndo(
     mUserInterface.RefreshView();
 }
 
+void Controller::RestoreTextureLayerTilesForUndo(TextureLayerSnapshot::TileSet && tiles)
+{
+    auto const scopedToolResumeState = SuspendTool();
+
+    mModelController->RestoreTextureLayerTiles(tiles);
+
+    // No need to update dirtyness, this is for undo
+
+    // Notify macro properties
+    NotifyModelMacroPropertiesUpdated();
+
+    // Refresh model visualizations
+    mModelController->UpdateVisualizations(*mView);
+    mUserInterface.RefreshView();
+}
+
 void Controller::RestoreTextureLayerForUndo(
     std::unique_ptr<TextureLayerData> textureLayer,
     std::optional<std::string> originalTextureArtCredits)
@@ -606,7 +628,7 @@ void Controller::RestoreTextureLayerForUndo(
 void Controller::RestoreAllLayersForUndo(
     ShipSpaceSize const & shipSize,
     StructuralLayerData && structuralLayer,
-    std::unique_ptr<ElectricalLayerData> electricalLayer,
+    std::unique_ptr<SparseElectricalLayerData> electricalLayer,
     std::unique_ptr<RopesLayerData> ropesLayer,
     std::unique_ptr<TextureLayerData> textureLayer,
     std::optional<std::string> originalTextureArtCredits)
@@ -622,9 +644,12 @@ void Controller::RestoreAllLayersForUndo(
     mModelController->RestoreStructuralLayer(std::move(structuralLayer));
 
     WrapLikelyLayerPresenceChangingOperation<LayerType::Electrical>(
-        [this, electricalLayer = std::move(electricalLayer)]() mutable
+        [this, electricalLayer = std::move(electricalLayer)]()
         {
-            mModelController->RestoreElectricalLayer(std::move(electricalLayer));
+            mModelController->RestoreElectricalLayer(
+                electricalLayer
+                ? std::make_unique<ElectricalLayerData>(electricalLayer->MakeDense())
+                : nullptr);
         });
 
     WrapLikelyLayerPresenceChangingOperation<LayerType::Ropes>(
@@ -724,6 +749,13 @@ void Controller::ResizeShip(
 
 void Controller::LayerChangeEpilog(std::optional<LayerType> dirtyLayer)
 {
+    //
+    // Tools may invoke this at each mouse move, i.e. many times per frame; we thus
+    // coalesce all changes received within a frame into one update, which we do at
+    // the next frame. Changes accumulate meanwhile in the model controller's dirty
+    // visualization regions.
+    //
+
     if (dirtyLayer.has_value())
     {
         // Mark layer as dirty
@@ -732,18 +764,14 @@ void Controller::LayerChangeEpilog(std::optional<LayerType> dirtyLayer)
 
         if (*dirtyLayer == LayerType::Electrical)
         {
-            // Notify of (possible) change in electrical panel
-            mUserInterface.OnElectricalLayerInstancedElementSetChanged(mModelController->GetInstancedElectricalElementSet());
+            mHasPendingElectricalLayerChanges = true;
         }
 
-        // Notify macro properties
-        NotifyModelMacroPropertiesUpdated();
+        mHasPendingModelMacroPropertiesChanges = true;
     }
 
-    // Refresh visualization
-    assert(mView);
-    mModelController->UpdateVisualizations(*mView);
-    mUserInterface.RefreshView();
+    // Refresh visualization at next frame
+    mHasPendingLayerChanges = true;
 }
 
 void Controller::SelectAll()
@@ -793,6 +821,19 @@ void Controller::Deselect()
     GetCurrentToolAs<SelectionTool>(ToolClass::Selection).Deselect();
 }
 
+void Controller::Copy()
+{
+    auto const & selection = mSelectionManager.GetSelection();
+    if (!selection.has_value())
+    {
+        return;
+    }
+
+    auto const scopedToolResumeState = SuspendTool();
+
+    mWorkbenchState.GetClipboardManager().SetContent(mModelController->Copy(*selection));
+}
+
 void Controller::SelectPrimaryVisualization(VisualizationType primaryVisualization)
 {
     if (primaryVisualization != mWorkbenchState.GetPrimaryVisualization())
@@ -966,6 +1007,29 @@ void Controller::Render()
     mView->Render();
 }
 
+void Controller::UpdatePendingVisualizations()
+{
+    if (mHasPendingElectricalLayerChanges)
+    {
+        // Notify of (possible) change in electrical panel
+        mUserInterface.OnElectricalLayerInstancedElementSetChanged(mModelController->GetInstancedElectricalElementSet());
+        mHasPendingElectricalLayerChanges = false;
+    }
+
+    if (mHasPendingModelMacroPropertiesChanges)
+    {
+        NotifyModelMacroPropertiesUpdated();
+        mHasPendingModelMacroPropertiesChanges = false;
+    }
+
+    if (mHasPendingLayerChanges || mModelController->HasPendingVisualizationUpdates())
+    {
+        mModelController->UpdateVisualizations(*mView);
+        mUserInterface.RefreshView();
+        mHasPendingLayerChanges = false;
+    }
+}
+
 void Controller::AddZoom(int deltaZoom)
 {
     mView->SetZoom(mView->GetZoom() + deltaZoom);
@@ -1384,8 +1448,9 @@ void Controller::InternalPushUndoForWholeLayer(wxString const & title)
     // Create undo action
     if constexpr (TLayerType == LayerType::Electrical)
     {
-        auto originalLayerClone = mModelController->CloneElectricalLayer();
-        auto const cloneByteSize = originalLayerClone ? originalLayerClone->Buffer.GetByteSize() : 0;
+        // Electrical layers are mostly empty, hence we keep them sparse
+        auto originalLayerClone = mModelController->CloneSparseElectricalLayer();
+        auto const cloneByteSize = originalLayerClone ? originalLayerClone->GetByteSize() : 0;
 
         mUndoStack.Push(
             title,
@@ -1883,7 +1948,7 @@ void Controller::InternalResizeShip(
 
         // Clone all layers
         auto structuralLayerClone = mModelController->CloneStructuralLayer();
-        auto electricalLayerClone = mModelController->CloneElectricalLayer();
+        auto electricalLayerClone = mModelController->CloneSparseElectricalLayer(); // Electrical layers are mostly empty
         auto ropesLayerClone = mModelController->CloneRopesLayer();
         auto textureLayerClone = mModelController->CloneTextureLayer();
         auto textureArtCreditsClone = mModelController->GetShipMetadata().ArtCredits;
@@ -1891,7 +1956,7 @@ void Controller::InternalResizeShip(
         // Calculate cost
         size_t const totalCost =
             structuralLayerClone.Buffer.GetByteSize()
-            + (electricalLayerClone ? electricalLayerClone->Buffer.GetByteSize() : 0)
+            + (electricalLayerClone ? electricalLayerClone->GetByteSize() : 0)
             + (ropesLayerClone ? ropesLayerClone->Buffer.GetSize() * sizeof(RopeElement) : 0)
             + (textureLayerClone ? textureLayerClone->Buffer.GetByteSize() : 0);
 
@@ -144,7 +144,7 @@ public:
     void RestoreElectricalLayerRegionForUndo(
         ElectricalLayerData && layerRegion,
         ShipSpaceCoordinates const & origin);
-    void RestoreElectricalLayerForUndo(std::unique_ptr<ElectricalLayerData> electricalLayer);
+    void RestoreElectricalLayerForUndo(std::unique_ptr<SparseElectricalLayerData> electricalLayer);
     void TrimElectricalParticlesWithoutSubstratum();
 
     // Ropes layer
@@ -166,6 +166,7 @@ public:
     void RestoreTextureLayerRegionForUndo(
         TextureLayerData && layerRegion,
         ImageCoordinates const & origin);
+    void RestoreTextureLayerTilesForUndo(TextureLayerSnapshot::TileSet && tiles);
     void RestoreTextureLayerForUndo(
         std::unique_ptr<TextureLayerData> textureLayer,
         std::optional<std::string> originalTextureArtCredits);
@@ -177,7 +178,7 @@ public:
     void RestoreAllLayersForUndo(
         ShipSpaceSize const & shipSize,
         StructuralLayerData && structuralLayer,
-        std::unique_ptr<ElectricalLayerData> electricalLayer,
+        std::unique_ptr<SparseElectricalLayerData> electricalLayer,
         std::unique_ptr<RopesLayerData> ropesLayer,
         std::unique_ptr<TextureLayerData> textureLayer,
         std::optional<std::string> originalTextureArtCredits);
@@ -195,13 +196,15 @@ public:
         ShipSpaceCoordinates const & originOffset);
 
     // Invoked for changes to any layer, including ephemeral viz changes (in which case
-    // no layer gets dirty)
+    // no layer gets dirty); visualizations are updated - once for all changes - at the next frame
     void LayerChangeEpilog(std::optional<LayerType> dirtyLayer = std::nullopt);
 
     void SelectAll();
 
     void Deselect();
 
+    void Copy();
+
     //
     // Visualization management
     //
@@ -241,6 +244,13 @@ public:
 
     void Render();
 
+    /*
+     * Paces the view at frame rate: updates visualizations with the layer changes received
+     * since the previous frame, and uploads visualizations that have been built asynchronously,
+     * if any is ready; invoked once per frame.
+     */
+    void UpdatePendingVisualizations();
+
     void AddZoom(int deltaZoom);
     void SetCamera(int camX, int camY);
     void ResetView();
@@ -392,6 +402,11 @@ private:
 
     // The last tool that was used for each layer
     std::array<std::optional<ToolType>, LayerCount> mLastToolTypePerLayer;
+
+    // Layer changes received since the last frame, whose epilog is pending
+    bool mHasPendingLayerChanges;
+    bool mHasPendingElectricalLayerChanges;
+    bool mHasPendingModelMacroPropertiesChanges;
 };
 
 }
\ No newline at end of file
@@ -0,0 +1,103 @@
+/***************************************************************************************
+ * Original Author:     Gabriele Giuseppini
+ * Created:             2026-10-14
+ * Copyright:           Gabriele Giuseppini  (https://github.com/GabrieleGiuseppini)
+ ***************************************************************************************/
+#include "FloodFill.h"
+
+#include <GameCore/SysSpecifics.h>
+
+#include <cstdlib>
+
+namespace ShipBuilder {
+
+Buffer2D<bool, ImageTag> FloodFill::MakeColorToleranceMask(
+    Buffer2D<rgbaColor, ImageTag> const & image,
+    rgbaColor const & seedColor,
+    unsigned int tolerance)
+{
+    assert(tolerance <= 100);
+
+    // Max distance (included), in 0-255 units
+    int const maxDistance = static_cast<int>(tolerance * 255 / 100);
+
+    Buffer2D<bool, ImageTag> mask(image.Size);
+
+    size_t const pixelCount = static_cast<size_t>(image.Size.width) * static_cast<size_t>(image.Size.height);
+    rgbaColor const * const pixels = image.Data.get();
+    bool * const result = mask.Data.get();
+
+    size_t p = 0;
+
+#if FS_IS_ARCHITECTURE_X86_64() || FS_IS_ARCHITECTURE_X86_32()
+
+    //
+    // Four pixels at a time; in each 32-bit lane, r is the low byte
+    //
+
+    __m128i const seed_4 = _mm_set1_epi32(
+        static_cast<int>(
+            static_cast<std::uint32_t>(seedColor.r)
+            | (static_cast<std::uint32_t>(seedColor.g) << 8)
+            | (static_cast<std::uint32_t>(seedColor.b) << 16)));
+    __m128i const rgbMask_4 = _mm_set1_epi32(0x00ffffff);
+    __m128i const lowByteMask_4 = _mm_set1_epi32(0x000000ff);
+    __m128i const maxDistance_4 = _mm_set1_epi32(maxDistance);
+    __m128i const zero = _mm_setzero_si128();
+
+    auto const absDiff = [](__m128i a, __m128i b) -> __m128i
+    {
+        return _mm_or_si128(_mm_subs_epu8(a, b), _mm_subs_epu8(b, a));
+    };
+
+    for (; p + 4 <= pixelCount; p += 4)
+    {
+        __m128i const pixels_4 = _mm_loadu_si128(reinterpret_cast<__m128i const *>(pixels + p));
+
+        // Channel deltas, with the delta of r, g, and b respectively in the low byte
+        __m128i const deltaR = absDiff(_mm_and_si128(pixels_4, rgbMask_4), seed_4);
+        __m128i const deltaG = _mm_srli_epi32(deltaR, 8);
+        __m128i const deltaB = _mm_srli_epi32(deltaR, 16);
+
+        __m128i distance = _mm_max_epu8(deltaR, _mm_max_epu8(deltaG, deltaB));
+        distance = _mm_max_epu8(distance, absDiff(deltaR, deltaG));
+        distance = _mm_max_epu8(distance, absDiff(deltaG, deltaB));
+        distance = _mm_max_epu8(distance, absDiff(deltaB, deltaR));
+        distance = _mm_and_si128(distance, lowByteMask_4);
+
+        __m128i const isBeyondTolerance = _mm_cmpgt_epi32(distance, maxDistance_4);
+        __m128i const isTransparent = _mm_cmpeq_epi32(_mm_srli_epi32(pixels_4, 24), zero);
+
+        int const rejectedBits = _mm_movemask_ps(_mm_castsi128_ps(_mm_or_si128(isBeyondTolerance, isTransparent)));
+
+        result[p] = (rejectedBits & 1) == 0;
+        result[p + 1] = (rejectedBits & 2) == 0;
+        result[p + 2] = (rejectedBits & 4) == 0;
+        result[p + 3] = (rejectedBits & 8) == 0;
+    }
+
+#endif
+
+    for (; p < pixelCount; ++p)
+    {
+        rgbaColor const & pixel = pixels[p];
+
+        int const deltaR = std::abs(static_cast<int>(pixel.r) - static_cast<int>(seedColor.r));
+        int const deltaG = std::abs(static_cast<int>(pixel.g) - static_cast<int>(seedColor.g));
+        int const deltaB = std::abs(static_cast<int>(pixel.b) - static_cast<int>(seedColor.b));
+
+        int const distance = std::max({
+            deltaR,
+            deltaG,
+            deltaB,
+            std::abs(deltaR - deltaG),
+            std::abs(deltaG - deltaB),
+            std::abs(deltaB - deltaR) });
+
+        result[p] = pixel.a != 0 && distance <= maxDistance;
+    }
+
+    return mask;
+}
+
+}
@@ -0,0 +1,155 @@
+/***************************************************************************************
+ * Original Author:     Gabriele Giuseppini
+ * Created:             2026-10-14
+ * Copyright:           Gabriele Giuseppini  (https://github.com/GabrieleGiuseppini)
+ ***************************************************************************************/
+#pragma once
+
+#include <GameCore/Buffer2D.h>
+#include <GameCore/Colors.h>
+#include <GameCore/GameTypes.h>
+
+#include <algorithm>
+#include <cassert>
+#include <initializer_list>
+#include <optional>
+#include <vector>
+
+namespace ShipBuilder {
+
+/*
+ * Flood-fill primitives shared by the flood tool and the magic wand.
+ *
+ * Fills proceed by horizontal spans: each span is grown left and right in one go,
+ * and the rows above and below it are scanned for the spans to continue from, so
+ * that the work queue holds one entry per span rather than one per pixel.
+ */
+class FloodFill final
+{
+public:
+
+    /*
+     * Fills the region of pixels that are connected to the start pixel and for which
+     * the predicate holds, marking them in the region mask; the mask must have been
+     * cleared by the caller, and it doubles as the visited bitmap.
+     *
+     * Returns the rect enclosing the region, or nothing when the predicate does not
+     * hold for the start pixel.
+     */
+    template<typename TIntegralTag, typename TIsInside>
+    static std::optional<_IntegralRect<TIntegralTag>> FillContiguous(
+        _IntegralCoordinates<TIntegralTag> const & start,
+        bool isEightConnected,
+        TIsInside const & isInside, // bool(int x, int y)
+        Buffer2D<bool, TIntegralTag> & regionMask)
+    {
+        using coordinates_type = _IntegralCoordinates<TIntegralTag>;
+
+        int const width = regionMask.Size.width;
+        int const height = regionMask.Size.height;
+
+        assert(start.IsInSize(regionMask.Size));
+
+        if (!isInside(start.x, start.y))
+        {
+            return std::nullopt;
+        }
+
+        bool * const mask = regionMask.Data.get();
+
+        auto const isFillable = [&](int x, int y) -> bool
+        {
+            return !mask[y * width + x] && isInside(x, y);
+        };
+
+        int minX = start.x;
+        int maxX = start.x;
+        int minY = start.y;
+        int maxY = start.y;
+
+        std::vector<coordinates_type> seeds;
+        seeds.emplace_back(start);
+
+        while (!seeds.empty())
+        {
+            coordinates_type const seed = seeds.back();
+            seeds.pop_back();
+
+            if (!isFillable(seed.x, seed.y))
+            {
+                // Filled already via another span
+                continue;
+            }
+
+            // Grow span
+            int left = seed.x;
+            while (left > 0 && isFillable(left - 1, seed.y))
+            {
+                --left;
+            }
+
+            int right = seed.x;
+            while (right < width - 1 && isFillable(right + 1, seed.y))
+            {
+                ++right;
+            }
+
+            // Fill span
+            for (int x = left; x <= right; ++x)
+            {
+                mask[seed.y * width + x] = true;
+            }
+
+            minX = std::min(minX, left);
+            maxX = std::max(maxX, right);
+            minY = std::min(minY, seed.y);
+            maxY = std::max(maxY, seed.y);
+
+            // Seed one pixel per run of fillable pixels touching the span from above and from below
+            int const scanLeft = isEightConnected ? std::max(left - 1, 0) : left;
+            int const scanRight = isEightConnected ? std::min(right + 1, width - 1) : right;
+            for (int const y : { seed.y - 1, seed.y + 1 })
+            {
+                if (y < 0 || y >= height)
+                    continue;
+
+                bool isInRun = false;
+                for (int x = scanLeft; x <= scanRight; ++x)
+                {
+                    if (isFillable(x, y))
+                    {
+                        if (!isInRun)
+                        {
+                            seeds.emplace_back(x, y);
+                            isInRun = true;
+                        }
+                    }
+                    else
+                    {
+                        isInRun = false;
+                    }
+                }
+            }
+        }
+
+        return _IntegralRect<TIntegralTag>(
+            coordinates_type(minX, minY),
+            _IntegralSize<TIntegralTag>(maxX - minX + 1, maxY - minY + 1));
+    }
+
+    /*
+     * Marks the pixels that exist - i.e. whose alpha is not zero - and whose color is
+     * within the specified tolerance (0-100) from the seed color.
+     *
+     * The distance between two colors is the largest of their channel deltas and of the
+     * differences among these deltas - once expressed in 0-255 units, a pixel is within
+     * tolerance when 100 * distance <= 255 * tolerance.
+     * From https://www.photoshopgurus.com/forum/threads/tolerance.52555/page-2
+     */
+    static Buffer2D<bool, ImageTag> MakeColorToleranceMask(
+        Buffer2D<rgbaColor, ImageTag> const & image,
+        rgbaColor const & seedColor,
+        unsigned int tolerance);
+};
+
+}
@@ -0,0 +1,287 @@
+/***************************************************************************************
+ * Original Author:     Gabriele Giuseppini
+ * Created:             2026-10-14
+ * Copyright:           Gabriele Giuseppini  (https://github.com/GabrieleGiuseppini)
+ ***************************************************************************************/
+#include "GameVisualizationBuilder.h"
+
+#include <GameCore/Log.h>
+
+#include <cassert>
+#include <stdexcept>
+
+namespace ShipBuilder {
+
+GameVisualizationBuilder::GameVisualizationBuilder(ShipTexturizer const & shipTexturizer)
+    : mShipTexturizer(shipTexturizer)
+    , mStructuralLayer()
+    , mTextureLayer()
+    , mMode(GameVisualizationModeType::None)
+    , mAutoTexturizationSettings()
+    , mMagnificationFactor(0)
+    , mVisualizationTexture()
+    , mAutoTexturizationTexture()
+    , mBuildOutput()
+    , mBuildCompletionIndicator()
+    , mIsBuildDiscarded(false)
+    , mBuildThread()
+{
+}
+
+GameVisualizationBuilder::~GameVisualizationBuilder()
+{
+    if (mBuildCompletionIndicator)
+    {
+        try
+        {
+            mBuildCompletionIndicator->Wait();
+        }
+        catch (std::exception const & exc)
+        {
+            LogMessage("GameVisualizationBuilder::~GameVisualizationBuilder(): build in flight failed: ", exc.what());
+        }
+    }
+}
+
+void GameVisualizationBuilder::Reset()
+{
+    if (IsBuilding())
+    {
+        // We'll reset at collection
+        mIsBuildDiscarded = true;
+    }
+    else
+    {
+        DoReset();
+    }
+}
+
+void GameVisualizationBuilder::StartBuild(
+    Model const & model,
+    GameVisualizationModeType mode,
+    ShipSpaceRect const & region)
+{
+    assert(!IsBuilding());
+    assert(mode != GameVisualizationModeType::None);
+    assert(model.HasLayer(LayerType::Structural));
+
+    ShipSpaceSize const shipSize = model.GetShipSize();
+    ShipSpaceRect const wholeShipRect(shipSize);
+
+    ShipSpaceRect buildRegion = region;
+
+    //
+    // Initialize visualization, if needed
+    //
+
+    if (mode != mMode
+        || !mVisualizationTexture
+        || !mStructuralLayer
+        || mStructuralLayer->Buffer.Size != shipSize)
+    {
+        DoReset();
+
+        mMode = mode;
+
+        mMagnificationFactor = ShipTexturizer::CalculateHighDefinitionTextureMagnificationFactor(shipSize);
+        mVisualizationTexture = std::make_unique<RgbaImageData>(
+            ImageSize(
+                shipSize.width * mMagnificationFactor,
+                shipSize.height * mMagnificationFactor));
+
+        if (mode == GameVisualizationModeType::AutoTexturizationMode)
+        {
+            mAutoTexturizationTexture = std::make_unique<RgbaImageData>(mVisualizationTexture->Size);
+        }
+
+        // Build from scratch
+        buildRegion = wholeShipRect;
+    }
+
+    //
+    // Bring our copy of the model up-to-date with the region
+    //
+
+    if (!mStructuralLayer)
+    {
+        mStructuralLayer.emplace(model.GetStructuralLayer().Clone());
+    }
+    else
+    {
+        // All changes since the previous build lie in the region
+        mStructuralLayer->Buffer.BlitFromRegion(
+            model.GetStructuralLayer().Buffer,
+            buildRegion,
+            buildRegion.origin);
+    }
+
+    if (mode == GameVisualizationModeType::TextureMode)
+    {
+        assert(model.HasLayer(LayerType::Texture));
+
+        // Changes to the texture always invalidate the whole visualization
+        if (!mTextureLayer || buildRegion == wholeShipRect)
+        {
+            mTextureLayer.emplace(model.GetTextureLayer().Clone());
+        }
+    }
+    else
+    {
+        mTextureLayer.reset();
+    }
+
+    mAutoTexturizationSettings = model.GetShipAutoTexturizationSettings().value_or(ShipAutoTexturizationSettings());
+
+    //
+    // Start build
+    //
+
+    mIsBuildDiscarded = false;
+
+    mBuildCompletionIndicator = mBuildThread.QueueTask(
+        [this, buildRegion]()
+        {
+            Build(buildRegion);
+        });
+}
+
+std::optional<GameVisualizationBuilder::Update> GameVisualizationBuilder::TryCollectBuild()
+{
+    if (!IsBuildCompleted())
+    {
+        return std::nullopt;
+    }
+
+    auto const buildCompletionIndicator = std::move(mBuildCompletionIndicator);
+    assert(!mBuildCompletionIndicator);
+
+    if (mIsBuildDiscarded)
+    {
+        DoReset();
+        mIsBuildDiscarded = false;
+
+        return std::nullopt;
+    }
+
+    try
+    {
+        // Rethrows the build's exception, if any
+        buildCompletionIndicator->Wait();
+    }
+    catch (...)
+    {
+        // Our visualization may be half-built
+        DoReset();
+        throw;
+    }
+
+    assert(mBuildOutput.has_value());
+
+    std::optional<Update> update = std::move(mBuildOutput);
+    mBuildOutput.reset();
+
+    return update;
+}
+
+void GameVisualizationBuilder::Build(ShipSpaceRect const & region)
+{
+    assert(mStructuralLayer);
+    assert(mVisualizationTexture);
+
+    //
+    // 1. Prepare source of triangularized rendering
+    //
+
+    RgbaImageData const * sourceTexture = nullptr;
+
+    if (mMode == GameVisualizationModeType::AutoTexturizationMode)
+    {
+        assert(mAutoTexturizationTexture);
+
+        mShipTexturizer.AutoTexturizeInto(
+            *mStructuralLayer,
+            region,
+            *mAutoTexturizationTexture,
+            mMagnificationFactor,
+            mAutoTexturizationSettings);
+
+        sourceTexture = mAutoTexturizationTexture.get();
+    }
+    else
+    {
+        assert(mMode == GameVisualizationModeType::TextureMode);
+        assert(mTextureLayer);
+
+        sourceTexture = &mTextureLayer->Buffer;
+    }
+
+    assert(sourceTexture != nullptr);
+
+    //
+    // 2. Do triangularized rendering
+    //
+
+    // Given that texturization looks at x+1 and y+1, we enlarge the region down and to the left
+    ShipSpaceRect effectiveRegion = region;
+    if (effectiveRegion.origin.x > 0)
+    {
+        effectiveRegion.origin.x -= 1;
+        effectiveRegion.size.width += 1;
+    }
+
+    if (effectiveRegion.origin.y > 0)
+    {
+        effectiveRegion.origin.y -= 1;
+        effectiveRegion.size.height += 1;
+    }
+
+    mShipTexturizer.RenderShipInto(
+        *mStructuralLayer,
+        effectiveRegion,
+        *sourceTexture,
+        *mVisualizationTexture,
+        mMagnificationFactor);
+
+    //
+    // 3. Produce update
+    //
+
+    ImageRect const dirtyTextureRegion(
+        ImageCoordinates(
+            effectiveRegion.origin.x * mMagnificationFactor,
+            effectiveRegion.origin.y * mMagnificationFactor),
+        ImageSize(
+            effectiveRegion.size.width * mMagnificationFactor,
+            effectiveRegion.size.height * mMagnificationFactor));
+
+    if (dirtyTextureRegion != mVisualizationTexture->Size)
+    {
+        // For better performance, we only hand out the dirty sub-texture
+        mBuildOutput.emplace(
+            mVisualizationTexture->CloneRegion(dirtyTextureRegion),
+            dirtyTextureRegion.origin,
+            false);
+    }
+    else
+    {
+        mBuildOutput.emplace(
+            mVisualizationTexture->Clone(),
+            ImageCoordinates(0, 0),
+            true);
+    }
+}
+
+void GameVisualizationBuilder::DoReset()
+{
+    assert(!IsBuilding());
+
+    mStructuralLayer.reset();
+    mTextureLayer.reset();
+    mMode = GameVisualizationModeType::None;
+    mMagnificationFactor = 0;
+    mVisualizationTexture.reset();
+    mAutoTexturizationTexture.reset();
+    mBuildOutput.reset();
+}
+
+}
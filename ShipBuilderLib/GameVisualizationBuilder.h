@@ -0,0 +1,130 @@
+/***************************************************************************************
+ * Original Author:     Gabriele Giuseppini
+ * Created:             2026-10-14
+ * Copyright:           Gabriele Giuseppini  (https://github.com/GabrieleGiuseppini)
+ ***************************************************************************************/
+#pragma once
+
+#include "Model.h"
+#include "ShipBuilderTypes.h"
+
+#include <Game/Layers.h>
+#include <Game/ShipAutoTexturizationSettings.h>
+#include <Game/ShipTexturizer.h>
+
+#include <GameCore/GameTypes.h>
+#include <GameCore/ImageData.h>
+#include <GameCore/TaskThread.h>
+
+#include <memory>
+#include <optional>
+
+namespace ShipBuilder {
+
+/*
+ * Builds the game visualization - the auto-texturized or textured rendering of the ship -
+ * on a thread of its own, so that edits are not slowed down by its rebuilds.
+ *
+ * The builder works off a private copy of the model's layers, which it brings up-to-date
+ * with the region to rebuild when a build is started; as that copy and the visualization
+ * are only touched by the build thread while a build is in progress, one build at a time
+ * is in flight, and dirty regions accumulate in the meantime at the caller.
+ *
+ * Each build hands out the rebuilt portion of the visualization, ready to be uploaded,
+ * while the builder keeps the whole visualization for building further portions onto.
+ */
+class GameVisualizationBuilder final
+{
+public:
+
+    struct Update
+    {
+        RgbaImageData Texture;
+        ImageCoordinates Origin; // In the whole visualization
+        bool IsWholeVisualization;
+
+        Update(
+            RgbaImageData && texture,
+            ImageCoordinates const & origin,
+            bool isWholeVisualization)
+            : Texture(std::move(texture))
+            , Origin(origin)
+            , IsWholeVisualization(isWholeVisualization)
+        {}
+    };
+
+public:
+
+    // The builder uses its own copy of the texturizer, as texturizers cache material textures
+    explicit GameVisualizationBuilder(ShipTexturizer const & shipTexturizer);
+
+    ~GameVisualizationBuilder();
+
+    /*
+     * Discards the visualization built so far, together with the outcome of the build in
+     * flight, if any; the next build is made from scratch.
+     */
+    void Reset();
+
+    bool IsBuilding() const
+    {
+        return !!mBuildCompletionIndicator;
+    }
+
+    bool IsBuildCompleted() const
+    {
+        return mBuildCompletionIndicator && mBuildCompletionIndicator->IsCompleted();
+    }
+
+    /*
+     * Starts building the specified region of the visualization, out of the current state
+     * of the model; may only be invoked while not building.
+     */
+    void StartBuild(
+        Model const & model,
+        GameVisualizationModeType mode,
+        ShipSpaceRect const & region);
+
+    /*
+     * Returns the update produced by the build in flight, if it has completed and it has
+     * not been discarded in the meanwhile.
+     */
+    std::optional<Update> TryCollectBuild();
+
+private:
+
+    void Build(ShipSpaceRect const & region);
+
+    void DoReset();
+
+private:
+
+    ShipTexturizer const mShipTexturizer;
+
+    //
+    // Build state, only accessed by the build thread while a build is in flight
+    //
+
+    std::optional<StructuralLayerData> mStructuralLayer;
+    std::optional<TextureLayerData> mTextureLayer;
+    GameVisualizationModeType mMode;
+    ShipAutoTexturizationSettings mAutoTexturizationSettings;
+
+    int mMagnificationFactor;
+    std::unique_ptr<RgbaImageData> mVisualizationTexture;
+    std::unique_ptr<RgbaImageData> mAutoTexturizationTexture;
+
+    std::optional<Update> mBuildOutput;
+
+    //
+    // Build control
+    //
+
+    TaskThread::TaskCompletionIndicator mBuildCompletionIndicator;
+    bool mIsBuildDiscarded;
+
+    // Last, so that it's destroyed - and joined - first
+    TaskThread mBuildThread;
+};
+
+}
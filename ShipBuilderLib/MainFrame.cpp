@@ -13,6 +13,7 @@
 
 #include <UILib/ImageLoadDialog.h>
 #include <UILib/ImageSaveDialog.h>
+#include <UILib/StandardSystemPaths.h>
 #include <UILib/UnderConstructionDialog.h>
 #include <UILib/WxHelpers.h>
 
@@ -57,13 +58,15 @@ MainFrame::MainFrame(
     LocalizationManager const & localizationManager,
     MaterialDatabase const & materialDatabase,
     ShipTexturizer const & shipTexturizer,
-    std::function<void(std::optional<std::filesystem::path>)> returnToGameFunctor,
+    std::function<void(std::optional<std::filesystem::path>, std::shared_ptr<ShipDefinition const>)> returnToGameFunctor,
     ProgressCallback const & progressCallback)
     : mMainApp(mainApp)
     , mReturnToGameFunctor(std::move(returnToGameFunctor))
     , mOpenGLManager()
     , mShipNameNormalizer(new ShipNameNormalizer(resourceLocator))
     , mController()
+    , mShipSaveThread(std::make_unique<TaskThread>())
+    , mAutosaveJournal(std::make_unique<AutosaveJournal>(StandardSystemPaths::GetInstance().GetUserGameRootFolderPath() / "ShipBuilderAutosave"))
     , mResourceLocator(resourceLocator)
     , mLocalizationManager(localizationManager)
     , mMaterialDatabase(materialDatabase)
@@ -380,11 +383,29 @@ MainFrame::MainFrame(
         this,
         mResourceLocator);
 
+    //
+    // Start visualization timer - it paces visualization updates at frame rate
+    //
+
+    mVisualizationTimer = std::make_unique<wxTimer>(this, wxID_ANY);
+    Connect(mVisualizationTimer->GetId(), wxEVT_TIMER, (wxObjectEventFunction)&MainFrame::OnVisualizationTimer);
+    mVisualizationTimer->Start(16, false);
+
+    //
+    // Start autosave timer
+    //
+
+    mAutosaveTimer = std::make_unique<wxTimer>(this, wxID_ANY);
+    Connect(mAutosaveTimer->GetId(), wxEVT_TIMER, (wxObjectEventFunction)&MainFrame::OnAutosaveTimer);
+    mAutosaveTimer->Start(5000, false);
+
     progressCallback(1.0f, ProgressMessageType::LoadingShipBuilder);
 }
 
 MainFrame::~MainFrame()
 {
+    // Don't lose any ship still being saved
+    WaitForPendingShipSaves();
 }
 
 void MainFrame::OpenForNewShip(std::optional<UnitsSystem> displayUnitsSystem)
@@ -436,6 +457,40 @@ void MainFrame::OpenForLoadShip(
     Open();
 }
 
+void MainFrame::OpenForLoadShip(
+    ShipDefinition && shipDefinition,
+    std::filesystem::path const & shipFilePath,
+    std::optional<UnitsSystem> displayUnitsSystem)
+{
+    // Set units system
+    if (displayUnitsSystem.has_value())
+    {
+        mWorkbenchState.SetDisplayUnitsSystem(*displayUnitsSystem);
+        ReconciliateUIWithDisplayUnitsSystem(*displayUnitsSystem);
+    }
+
+    // Enqueue deferred action: Open ship; the action has to be copyable,
+    // hence the shared pointer
+    assert(!mInitialAction.has_value());
+    mInitialAction.emplace(
+        [this, shipDefinitionPtr = std::make_shared<ShipDefinition>(std::move(shipDefinition)), shipFilePath]()
+        {
+            if (AskPasswordDialog::CheckPasswordProtectedEdit(*shipDefinitionPtr, this, mResourceLocator))
+            {
+                DoOpenShip(std::move(*shipDefinitionPtr), shipFilePath);
+            }
+            else
+            {
+                // Not allowed to edit this ship...
+                // ...just create a new ship
+                DoNewShip();
+            }
+        });
+
+    // Open ourselves
+    Open();
+}
+
 //
 // IUserInterface
 //
@@ -4334,6 +4389,22 @@ void MainFrame::OnWorkCanvasKeyUp(wxKeyEvent & event)
     }
 }
 
+void MainFrame::OnVisualizationTimer(wxTimerEvent & /*event*/)
+{
+    if (mController)
+    {
+        mController->UpdatePendingVisualizations();
+    }
+}
+
+void MainFrame::OnAutosaveTimer(wxTimerEvent & /*event*/)
+{
+    if (mController)
+    {
+        mAutosaveJournal->Update(mController->GetModelController());
+    }
+}
+
 void MainFrame::OnClose(wxCloseEvent & event)
 {
     if (event.CanVeto() && !IsStandAlone())
@@ -4368,6 +4439,12 @@ void MainFrame::OnClose(wxCloseEvent & event)
             }
         }
 
+        // Keep the autosave when we're being closed without asking the user
+        if (event.CanVeto() || !mController->GetModelController().IsDirty())
+        {
+            mAutosaveJournal->Reset();
+        }
+
         // Nuke controller, now that all dependencies are still alive
         mController.reset();
     }
@@ -4390,6 +4467,19 @@ void MainFrame::Open()
 
     // Make ourselves the topmost frame
     mMainApp->SetTopWindow(this);
+
+    // Recovering an interrupted session takes precedence over the initial action
+    if (mInitialAction.has_value())
+    {
+        mInitialAction.emplace(
+            [this, initialAction = std::move(*mInitialAction)]()
+            {
+                if (!DoRecoverShip())
+                {
+                    initialAction();
+                }
+            });
+    }
 }
 
 void MainFrame::NewShip()
@@ -4487,7 +4577,12 @@ void MainFrame::SaveAndSwitchBackToGame()
         // Return
         assert(mCurrentShipFilePath.has_value());
         assert(ShipDeSerializer::IsShipDefinitionFile(*mCurrentShipFilePath));
-        SwitchBackToGame(*mCurrentShipFilePath);
+
+        // Hand the ship over in memory, so that the game doesn't need to load it again
+        assert(mController);
+        SwitchBackToGame(
+            *mCurrentShipFilePath,
+            std::make_shared<ShipDefinition const>(mController->MakeShipDefinition()));
     }
 }
 
@@ -4513,7 +4608,7 @@ void MainFrame::QuitAndSwitchBackToGame()
         }
     }
 
-    SwitchBackToGame(std::nullopt);
+    SwitchBackToGame(std::nullopt, nullptr);
 }
 
 void MainFrame::Quit()
@@ -4522,7 +4617,9 @@ void MainFrame::Quit()
     Close();
 }
 
-void MainFrame::SwitchBackToGame(std::optional<std::filesystem::path> shipFilePath)
+void MainFrame::SwitchBackToGame(
+    std::optional<std::filesystem::path> shipFilePath,
+    std::shared_ptr<ShipDefinition const> shipDefinition)
 {
     // Hide self
     Show(false);
@@ -4530,9 +4627,12 @@ void MainFrame::SwitchBackToGame(std::optional<std::filesystem::path> shipFilePa
     // Let go of controller
     mController.reset();
 
+    // The user has either saved or discarded the changes
+    mAutosaveJournal->Reset();
+
     // Invoke functor to go back
     assert(mReturnToGameFunctor);
-    mReturnToGameFunctor(std::move(shipFilePath));
+    mReturnToGameFunctor(std::move(shipFilePath), std::move(shipDefinition));
 }
 
 void MainFrame::ImportLayerFromShip(LayerType layer)
@@ -4778,7 +4878,7 @@ void MainFrame::OnElectricalPanelEdit()
 void MainFrame::Copy()
 {
     assert(mController);
-    // TODO: invoke Controller::Copy()
+    mController->Copy();
 }
 
 void MainFrame::Cut()
@@ -4909,9 +5009,59 @@ void MainFrame::DoNewShip()
         mShipTexturizer,
         mResourceLocator);
 
+    // New editing session
+    mAutosaveJournal->Reset();
+
     ReconciliateUIWithShipFilename();
 }
 
+bool MainFrame::DoRecoverShip()
+{
+    if (!mAutosaveJournal->HasRecoverableShip())
+    {
+        return false;
+    }
+
+    int const result = wxMessageBox(
+        _("The ship builder was not closed properly, and the ship being edited has been autosaved. Would you like to recover it?"),
+        ApplicationName,
+        wxICON_QUESTION | wxYES_NO | wxCENTRE);
+
+    if (result != wxYES)
+    {
+        // Forget about it
+        mAutosaveJournal->Reset();
+        return false;
+    }
+
+    std::optional<ShipDefinition> shipDefinition;
+    try
+    {
+        shipDefinition.emplace(mAutosaveJournal->RecoverShip(mMaterialDatabase));
+    }
+    catch (UserGameException const & exc)
+    {
+        ShowError(mLocalizationManager.MakeErrorMessage(exc));
+        return false;
+    }
+    catch (std::runtime_error const & exc)
+    {
+        ShowError(exc.what());
+        return false;
+    }
+
+    DoOpenShip(std::move(*shipDefinition), std::filesystem::path());
+
+    // The recovered ship has no file yet, and it's dirty...
+    mController->GetModelController().SetAllPresentLayersDirty();
+    OnModelDirtyChanged(mController->GetModelController());
+
+    // ...hence it's autosaved again right away
+    mAutosaveJournal->Update(mController->GetModelController());
+
+    return true;
+}
+
 bool MainFrame::DoLoadShip(std::filesystem::path const & shipFilePath)
 {
     //
@@ -4925,6 +5075,16 @@ bool MainFrame::DoLoadShip(std::filesystem::path const & shipFilePath)
         return false;
     }
 
+    DoOpenShip(std::move(*shipDefinition), shipFilePath);
+
+    // Success
+    return true;
+}
+
+void MainFrame::DoOpenShip(
+    ShipDefinition && shipDefinition,
+    std::filesystem::path const & shipFilePath)
+{
     //
     // Recreate controller
     //
@@ -4937,13 +5097,16 @@ bool MainFrame::DoLoadShip(std::filesystem::path const & shipFilePath)
 
     // Create new controller with ship
     mController = Controller::CreateForShip(
-        std::move(*shipDefinition),
+        std::move(shipDefinition),
         *mOpenGLManager,
         mWorkbenchState,
         *this,
         mShipTexturizer,
         mResourceLocator);
 
+    // New editing session
+    mAutosaveJournal->Reset();
+
     // Remember file path - but only if it's a definition file in the "official" format (not a legacy one),
     // and only if it's not a stock ship (otherwise users could overwrite game ships unknowingly)
     if (ShipDeSerializer::IsShipDefinitionFile(shipFilePath)
@@ -4957,9 +5120,6 @@ bool MainFrame::DoLoadShip(std::filesystem::path const & shipFilePath)
     }
 
     ReconciliateUIWithShipFilename();
-
-    // Success
-    return true;
 }
 
 std::optional<ShipDefinition> MainFrame::DoLoadShipDefinitionAndCheckPassword(std::filesystem::path const & shipFilePath)
@@ -4968,6 +5128,9 @@ std::optional<ShipDefinition> MainFrame::DoLoadShipDefinitionAndCheckPassword(st
     // Load definition
     //
 
+    // We might be loading a ship we're still saving
+    WaitForPendingShipSaves();
+
     std::optional<ShipDefinition> shipDefinition;
     try
     {
@@ -5068,19 +5231,43 @@ void MainFrame::DoSaveShipWithoutValidation(std::filesystem::path const & shipFi
 
     // Clear dirtyness
     mController->ClearModelDirty();
+
+    // No need to recover what's been saved
+    mAutosaveJournal->Reset();
 }
 
 void MainFrame::DoSaveShipDefinition(Controller const & controller, std::filesystem::path const & shipFilePath)
 {
-    // Get ship definition
-    auto shipDefinition = controller.MakeShipDefinition();
+    // Get ship definition - a snapshot of the model, which may go on changing while we save
+    auto shipDefinition = std::make_shared<ShipDefinition const>(controller.MakeShipDefinition());
 
     assert(ShipDeSerializer::IsShipDefinitionFile(shipFilePath));
 
-    // Save ship
-    ShipDeSerializer::SaveShip(
-        shipDefinition,
-        shipFilePath);
+    // Save ship, in the background
+    mShipSaveThread->QueueTask(
+        [this, shipDefinition, shipFilePath]()
+        {
+            try
+            {
+                ShipDeSerializer::SaveShip(
+                    *shipDefinition,
+                    shipFilePath);
+            }
+            catch (std::exception const & exc)
+            {
+                // Errors may only be shown on the main thread
+                CallAfter(
+                    [this, message = std::string(exc.what())]()
+                    {
+                        ShowError(wxString::Format(_("Could not save the ship: %s"), message));
+                    });
+            }
+        });
+}
+
+void MainFrame::WaitForPendingShipSaves()
+{
+    mShipSaveThread->QueueSynchronizationPoint()->Wait();
 }
 
 bool MainFrame::DoPreSaveShipValidation()
@@ -5105,7 +5292,7 @@ void MainFrame::BailOut()
     }
     else
     {
-        SwitchBackToGame(std::nullopt);
+        SwitchBackToGame(std::nullopt, nullptr);
     }
 }
 
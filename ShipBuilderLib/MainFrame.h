@@ -5,6 +5,7 @@
  ***************************************************************************************/
 #pragma once
 
+#include "AutosaveJournal.h"
 #include "Controller.h"
 #include "IUserInterface.h"
 #include "OpenGLManager.h"
@@ -34,6 +35,7 @@
 
 #include <GameCore/GameTypes.h>
 #include <GameCore/ProgressCallback.h>
+#include <GameCore/TaskThread.h>
 
 #include <wx/accel.h>
 #include <wx/app.h>
@@ -48,6 +50,7 @@
 #include <wx/scrolwin.h>
 #include <wx/slider.h>
 #include <wx/statbmp.h>
+#include <wx/timer.h>
 
 #include <array>
 #include <filesystem>
@@ -78,7 +81,7 @@ public:
         LocalizationManager const & localizationManager,
         MaterialDatabase const & materialDatabase,
         ShipTexturizer const & shipTexturizer,
-        std::function<void(std::optional<std::filesystem::path>)> returnToGameFunctor,
+        std::function<void(std::optional<std::filesystem::path>, std::shared_ptr<ShipDefinition const>)> returnToGameFunctor,
         ProgressCallback const & progressCallback);
 
     ~MainFrame();
@@ -89,6 +92,15 @@ public:
         std::filesystem::path const & shipFilePath,
         std::optional<UnitsSystem> displayUnitsSystem);
 
+    /*
+     * Opens a ship already in memory - e.g. the one being played - skipping
+     * all of the decoding of the ship file it comes from.
+     */
+    void OpenForLoadShip(
+        ShipDefinition && shipDefinition,
+        std::filesystem::path const & shipFilePath,
+        std::optional<UnitsSystem> displayUnitsSystem);
+
 public:
 
     //
@@ -202,6 +214,8 @@ private:
     void OnWorkCanvasMouseEnteredWindow(wxMouseEvent & event);
     void OnWorkCanvasKeyDown(wxKeyEvent & event);
     void OnWorkCanvasKeyUp(wxKeyEvent & event);
+    void OnVisualizationTimer(wxTimerEvent & event);
+    void OnAutosaveTimer(wxTimerEvent & event);
 
     void OnClose(wxCloseEvent & event);
 
@@ -230,7 +244,9 @@ private:
 
     void Quit();
 
-    void SwitchBackToGame(std::optional<std::filesystem::path> shipFilePath);
+    void SwitchBackToGame(
+        std::optional<std::filesystem::path> shipFilePath,
+        std::shared_ptr<ShipDefinition const> shipDefinition);
 
     void ImportLayerFromShip(LayerType layer);
 
@@ -273,8 +289,16 @@ private:
 
     void DoNewShip();
 
+    // Offers to recover the ship left behind by a session that did not end cleanly; returns
+    // whether a ship has been recovered
+    bool DoRecoverShip();
+
     bool DoLoadShip(std::filesystem::path const & shipFilePath);
 
+    void DoOpenShip(
+        ShipDefinition && shipDefinition,
+        std::filesystem::path const & shipFilePath);
+
     std::optional<ShipDefinition> DoLoadShipDefinitionAndCheckPassword(std::filesystem::path const & shipFilePath);
 
     bool DoSaveShipOrSaveShipAsWithValidation();
@@ -285,7 +309,10 @@ private:
 
     void DoSaveShipWithoutValidation(std::filesystem::path const & shipFilePath);
 
-    static void DoSaveShipDefinition(Controller const & controller, std::filesystem::path const & shipFilePath);
+    // Saves a snapshot of the ship in the background, while editing goes on
+    void DoSaveShipDefinition(Controller const & controller, std::filesystem::path const & shipFilePath);
+
+    void WaitForPendingShipSaves();
 
     bool DoPreSaveShipValidation();
 
@@ -370,7 +397,7 @@ private:
 
     wxApp * const mMainApp;
 
-    std::function<void(std::optional<std::filesystem::path>)> const mReturnToGameFunctor;
+    std::function<void(std::optional<std::filesystem::path>, std::shared_ptr<ShipDefinition const>)> const mReturnToGameFunctor;
 
     //
     // Owned members
@@ -381,6 +408,10 @@ private:
 
     std::unique_ptr<Controller> mController; // Comes and goes as we are opened/close
 
+    std::unique_ptr<TaskThread> mShipSaveThread; // Saves ships in the background, in the order they're saved
+
+    std::unique_ptr<AutosaveJournal> mAutosaveJournal;
+
     //
     // Helpers
     //
@@ -487,6 +518,12 @@ private:
     bool mutable mIsMouseCapturedByWorkCanvas;
     bool mutable mIsShiftKeyDown;
 
+    // Picks up visualizations built asynchronously
+    std::unique_ptr<wxTimer> mVisualizationTimer;
+
+    // Paces autosaves
+    std::unique_ptr<wxTimer> mAutosaveTimer;
+
     //
     // Open action
     //
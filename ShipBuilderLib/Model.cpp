@@ -98,6 +98,18 @@ std::unique_ptr<ElectricalLayerData> Model::CloneElectricalLayer() const
     return clonedLayer;
 }
 
+std::unique_ptr<SparseElectricalLayerData> Model::CloneSparseElectricalLayer() const
+{
+    std::unique_ptr<SparseElectricalLayerData> clonedLayer;
+
+    if (mLayers.ElectricalLayer)
+    {
+        clonedLayer.reset(new SparseElectricalLayerData(*mLayers.ElectricalLayer));
+    }
+
+    return clonedLayer;
+}
+
 void Model::RestoreElectricalLayer(std::unique_ptr<ElectricalLayerData> electricalLayer)
 {
     // Replace layer
@@ -226,6 +226,7 @@ public:
     void RemoveElectricalLayer();
 
     std::unique_ptr<ElectricalLayerData> CloneElectricalLayer() const;
+    std::unique_ptr<SparseElectricalLayerData> CloneSparseElectricalLayer() const;
     void RestoreElectricalLayer(std::unique_ptr<ElectricalLayerData> electricalLayer);
 
     RopesLayerData const & GetRopesLayer() const
@@ -5,10 +5,11 @@
 ***************************************************************************************/
 #include "ModelController.h"
 
+#include "FloodFill.h"
 #include "ModelValidator.h"
 
+#include <algorithm>
 #include <cassert>
-#include <queue>
 
 namespace ShipBuilder {
 
@@ -41,17 +42,15 @@ ModelController::ModelController(
     Model && model,
     ShipTexturizer const & shipTexturizer)
     : mModel(std::move(model))
-    , mShipTexturizer(shipTexturizer)
     , mMassParticleCount(0)
     , mTotalMass(0.0f)
     , mCenterOfMassSum(vec2f::zero())
     , mInstancedElectricalElementSet()
     , mElectricalParticleCount(0)
+    , mModelValidator()
     /////
     , mGameVisualizationMode(GameVisualizationModeType::None)
-    , mGameVisualizationAutoTexturizationTexture()
-    , mGameVisualizationTexture()
-    , mGameVisualizationTextureMagnificationFactor(0)
+    , mGameVisualizationBuilder(shipTexturizer)
     , mStructuralLayerVisualizationMode(StructuralLayerVisualizationModeType::None)
     , mStructuralLayerVisualizationTexture()
     , mElectricalLayerVisualizationMode(ElectricalLayerVisualizationModeType::None)
@@ -59,6 +58,12 @@ ModelController::ModelController(
     , mRopesLayerVisualizationMode(RopesLayerVisualizationModeType::None)
     , mTextureLayerVisualizationMode(TextureLayerVisualizationModeType::None)
     /////
+    , mJournalDirtyStructuralLayerRegion()
+    , mJournalDirtyElectricalLayerRegion()
+    , mIsJournalRopesLayerDirty(false)
+    , mJournalDirtyTextureLayerRegion()
+    , mAreJournalPropertiesDirty(false)
+    /////
     , mIsStructuralLayerInEphemeralVisualization(false)
     , mIsElectricalLayerInEphemeralVisualization(false)
     , mIsRopesLayerInEphemeralVisualization(false)
@@ -78,6 +83,76 @@ ShipDefinition ModelController::MakeShipDefinition() const
     return mModel.MakeShipDefinition();
 }
 
+ShipDefinitionDelta ModelController::MakeJournalDelta()
+{
+    assert(!IsInEphemeralVisualization());
+
+    ShipDefinitionDelta delta(mModel.GetShipSize());
+
+    if (mJournalDirtyStructuralLayerRegion.has_value())
+    {
+        auto const region = mJournalDirtyStructuralLayerRegion->MakeIntersectionWith(GetWholeShipRect());
+        if (region.has_value())
+        {
+            delta.StructuralLayerRegion.emplace(
+                region->origin,
+                mModel.GetStructuralLayer().Clone(*region));
+        }
+    }
+
+    if (mJournalDirtyElectricalLayerRegion.has_value() && mModel.HasLayer(LayerType::Electrical))
+    {
+        auto const region = mJournalDirtyElectricalLayerRegion->MakeIntersectionWith(GetWholeShipRect());
+        if (region.has_value())
+        {
+            // Whole panel
+            ElectricalPanelMetadata panel = mModel.GetElectricalLayer().Panel;
+
+            delta.ElectricalLayerRegion.emplace(
+                region->origin,
+                ElectricalLayerData(
+                    mModel.GetElectricalLayer().Buffer.CloneRegion(*region),
+                    std::move(panel)));
+        }
+    }
+
+    if (mIsJournalRopesLayerDirty && mModel.HasLayer(LayerType::Ropes))
+    {
+        delta.RopesLayer.emplace(mModel.GetRopesLayer().Clone());
+    }
+
+    if (mJournalDirtyTextureLayerRegion.has_value() && mModel.HasLayer(LayerType::Texture))
+    {
+        auto const region = mJournalDirtyTextureLayerRegion->MakeIntersectionWith(GetWholeTextureRect());
+        if (region.has_value())
+        {
+            delta.TextureLayerRegion.emplace(
+                region->origin,
+                mModel.GetTextureLayer().Clone(*region));
+        }
+    }
+
+    if (mAreJournalPropertiesDirty)
+    {
+        delta.Metadata.emplace(mModel.GetShipMetadata());
+        delta.PhysicsData.emplace(mModel.GetShipPhysicsData());
+        delta.AutoTexturizationSettings.emplace(mModel.GetShipAutoTexturizationSettings());
+    }
+
+    ClearJournalChanges();
+
+    return delta;
+}
+
+void ModelController::ClearJournalChanges()
+{
+    mJournalDirtyStructuralLayerRegion.reset();
+    mJournalDirtyElectricalLayerRegion.reset();
+    mIsJournalRopesLayerDirty = false;
+    mJournalDirtyTextureLayerRegion.reset();
+    mAreJournalPropertiesDirty = false;
+}
+
 std::unique_ptr<RgbaImageData> ModelController::MakePreview() const
 {
     assert(mModel.HasLayer(LayerType::Structural));
@@ -91,6 +166,52 @@ std::unique_ptr<RgbaImageData> ModelController::MakePreview() const
     return previewTexture;
 }
 
+ShipLayers ModelController::Copy(ShipSpaceRect const & region) const
+{
+    assert(!IsInEphemeralVisualization());
+    assert(region.IsContainedInRect(GetWholeShipRect()));
+
+    // Regions are copied one row at a time
+
+    std::unique_ptr<ElectricalLayerData> electricalLayer;
+    if (mModel.HasLayer(LayerType::Electrical))
+    {
+        electricalLayer = std::make_unique<ElectricalLayerData>(mModel.GetElectricalLayer().Clone(region));
+    }
+
+    std::unique_ptr<RopesLayerData> ropesLayer;
+    if (mModel.HasLayer(LayerType::Ropes))
+    {
+        ropesLayer = std::make_unique<RopesLayerData>(mModel.GetRopesLayer().Clone());
+        ropesLayer->Trim(region);
+    }
+
+    std::unique_ptr<TextureLayerData> textureLayer;
+    if (mModel.HasLayer(LayerType::Texture))
+    {
+        // The texture covers the whole ship; take all the pixels touched by the region
+        ShipSpaceSize const & shipSize = mModel.GetShipSize();
+        ImageSize const & textureSize = mModel.GetTextureLayer().Buffer.Size;
+
+        int const left = region.origin.x * textureSize.width / shipSize.width;
+        int const bottom = region.origin.y * textureSize.height / shipSize.height;
+        int const right = ((region.origin.x + region.size.width) * textureSize.width + shipSize.width - 1) / shipSize.width;
+        int const top = ((region.origin.y + region.size.height) * textureSize.height + shipSize.height - 1) / shipSize.height;
+
+        textureLayer = std::make_unique<TextureLayerData>(
+            mModel.GetTextureLayer().Clone(
+                ImageRect(
+                    ImageCoordinates(left, bottom),
+                    ImageSize(right - left, top - bottom))));
+    }
+
+    return ShipLayers(
+        mModel.GetStructuralLayer().Clone(region),
+        std::move(electricalLayer),
+        std::move(ropesLayer),
+        std::move(textureLayer));
+}
+
 std::optional<ShipSpaceRect> ModelController::CalculateBoundingBox() const
 {
     std::optional<ShipSpaceRect> boundingBox;
@@ -139,9 +260,9 @@ std::optional<ShipSpaceRect> ModelController::CalculateBoundingBox() const
     return boundingBox;
 }
 
-ModelValidationResults ModelController::ValidateModel() const
+ModelValidationResults ModelController::ValidateModel()
 {
-    return ModelValidator::ValidateModel(mModel);
+    return mModelValidator.Validate(mModel);
 }
 
 std::optional<SampledInformation> ModelController::SampleInformationAt(ShipSpaceCoordinates const & coordinates, LayerType layer) const
@@ -324,8 +445,7 @@ void ModelController::Rotate90(RotationDirectionType direction)
     }
 
     //...and Game we do regardless, as there's always a structural layer at least
-    mGameVisualizationTexture.reset();
-    mGameVisualizationAutoTexturizationTexture.reset();
+    mGameVisualizationBuilder.Reset();
     RegisterDirtyVisualization<VisualizationType::Game>(GetWholeShipRect());
 }
 
@@ -414,8 +534,7 @@ void ModelController::ResizeShip(
 
     // Initialize game visualizations
     {
-        mGameVisualizationTexture.reset();
-        mGameVisualizationAutoTexturizationTexture.reset();
+        mGameVisualizationBuilder.Reset();
         RegisterDirtyVisualization<VisualizationType::Game>(newWholeShipRect);
     }
 
@@ -575,8 +694,7 @@ void ModelController::RestoreStructuralLayer(StructuralLayerData && sourceLayer)
     // Update visualization
     //
 
-    mGameVisualizationTexture.reset();
-    mGameVisualizationAutoTexturizationTexture.reset();
+    mGameVisualizationBuilder.Reset();
     RegisterDirtyVisualization<VisualizationType::Game>(GetWholeShipRect());
     mStructuralLayerVisualizationTexture.reset();
     RegisterDirtyVisualization<VisualizationType::StructuralLayer>(GetWholeShipRect());
@@ -592,15 +710,7 @@ void ModelController::StructuralRegionFillForEphemeralVisualization(
     // Update model with just material - no analyses
     //
 
-    auto & structuralLayerBuffer = mModel.GetStructuralLayer().Buffer;
-
-    for (int y = region.origin.y; y < region.origin.y + region.size.height; ++y)
-    {
-        for (int x = region.origin.x; x < region.origin.x + region.size.width; ++x)
-        {
-            structuralLayerBuffer[ShipSpaceCoordinates(x, y)].Material = material;
-        }
-    }
+    mModel.GetStructuralLayer().Buffer.MakeView(region).Fill(StructuralElement(material));
 
     //
     // Update visualization
@@ -682,6 +792,11 @@ std::unique_ptr<ElectricalLayerData> ModelController::CloneElectricalLayer() con
     return mModel.CloneElectricalLayer();
 }
 
+std::unique_ptr<SparseElectricalLayerData> ModelController::CloneSparseElectricalLayer() const
+{
+    return mModel.CloneSparseElectricalLayer();
+}
+
 ElectricalMaterial const * ModelController::SampleElectricalMaterialAt(ShipSpaceCoordinates const & coords) const
 {
     assert(mModel.HasLayer(LayerType::Electrical));
@@ -847,13 +962,14 @@ void ModelController::ElectricalRegionFillForEphemeralVisualization(
     // Update model just with material - no instance ID, no analyses, no panel
     //
 
-    auto & electricalLayerBuffer = mModel.GetElectricalLayer().Buffer;
+    auto const electricalLayerRegion = mModel.GetElectricalLayer().Buffer.MakeView(region);
 
-    for (int y = region.origin.y; y < region.origin.y + region.size.height; ++y)
+    for (int y = 0; y < electricalLayerRegion.Size.height; ++y)
     {
-        for (int x = region.origin.x; x < region.origin.x + region.size.width; ++x)
+        ElectricalElement * const row = electricalLayerRegion.GetRow(y);
+        for (int x = 0; x < electricalLayerRegion.Size.width; ++x)
         {
-            electricalLayerBuffer[ShipSpaceCoordinates(x, y)].Material = material;
+            row[x].Material = material;
         }
     }
 
@@ -1267,7 +1383,30 @@ void ModelController::RestoreTextureLayerRegion(
     // Update visualization
     //
 
-    RegisterDirtyVisualization<VisualizationType::TextureLayer>(GetWholeTextureRect());
+    RegisterDirtyVisualization<VisualizationType::TextureLayer>(ImageRect(targetOrigin, sourceRegion.size));
+}
+
+void ModelController::RestoreTextureLayerTiles(TextureLayerSnapshot::TileSet const & tiles)
+{
+    assert(mModel.HasLayer(LayerType::Texture));
+
+    assert(!mIsTextureLayerInEphemeralVisualization);
+
+    //
+    // Restore model
+    //
+
+    tiles.BlitOnto(mModel.GetTextureLayer().Buffer);
+
+    //
+    // Update visualization
+    //
+
+    auto const tilesRect = tiles.GetRect();
+    if (tilesRect.has_value())
+    {
+        RegisterDirtyVisualization<VisualizationType::TextureLayer>(*tilesRect);
+    }
 }
 
 void ModelController::RestoreTextureLayer(
@@ -1287,8 +1426,7 @@ void ModelController::RestoreTextureLayer(
     // Update visualization
     //
 
-    mGameVisualizationTexture.reset();
-    mGameVisualizationAutoTexturizationTexture.release();
+    mGameVisualizationBuilder.Reset();
     RegisterDirtyVisualization<VisualizationType::Game>(GetWholeShipRect());
     if (mModel.HasLayer(LayerType::Texture))
     {
@@ -1309,13 +1447,14 @@ void ModelController::TextureRegionEraseForEphemeralVisualization(ImageRect cons
     // Update model
     //
 
-    auto & textureLayerBuffer = mModel.GetTextureLayer().Buffer;
+    auto const textureLayerRegion = mModel.GetTextureLayer().Buffer.MakeView(region);
 
-    for (int y = region.origin.y; y < region.origin.y + region.size.height; ++y)
+    for (int y = 0; y < textureLayerRegion.Size.height; ++y)
     {
-        for (int x = region.origin.x; x < region.origin.x + region.size.width; ++x)
+        rgbaColor * const row = textureLayerRegion.GetRow(y);
+        for (int x = 0; x < textureLayerRegion.Size.width; ++x)
         {
-            textureLayerBuffer[{x, y}].a = 0;
+            row[x].a = 0;
         }
     }
 
@@ -1357,6 +1496,32 @@ void ModelController::RestoreTextureLayerRegionForEphemeralVisualization(
     mIsTextureLayerInEphemeralVisualization = false;
 }
 
+void ModelController::RestoreTextureLayerRegionForEphemeralVisualization(
+    TextureLayerSnapshot const & sourceLayerSnapshot,
+    ImageRect const & region)
+{
+    assert(mModel.HasLayer(LayerType::Texture));
+
+    assert(mIsTextureLayerInEphemeralVisualization);
+
+    //
+    // Restore model, and nothing else
+    //
+
+    sourceLayerSnapshot.BlitRegionOnto(
+        region,
+        mModel.GetTextureLayer().Buffer);
+
+    //
+    // Update visualization
+    //
+
+    RegisterDirtyVisualization<VisualizationType::TextureLayer>(region);
+
+    // Remember we are not anymore in temp visualization
+    mIsTextureLayerInEphemeralVisualization = false;
+}
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 // Visualizations
 ////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -1369,13 +1534,11 @@ void ModelController::SetGameVisualizationMode(GameVisualizationModeType mode)
         return;
     }
 
+    // Whatever is being built is for the old mode
+    mGameVisualizationBuilder.Reset();
+
     if (mode != GameVisualizationModeType::None)
     {
-        if (mode != GameVisualizationModeType::AutoTexturizationMode)
-        {
-            mGameVisualizationAutoTexturizationTexture.reset();
-        }
-
         mGameVisualizationMode = mode;
 
         RegisterDirtyVisualization<VisualizationType::Game>(GetWholeShipRect());
@@ -1384,8 +1547,6 @@ void ModelController::SetGameVisualizationMode(GameVisualizationModeType mode)
     {
         // Shutdown game visualization
         mGameVisualizationMode = GameVisualizationModeType::None;
-        mGameVisualizationAutoTexturizationTexture.reset();
-        mGameVisualizationTexture.reset();
     }
 }
 
@@ -1496,63 +1657,49 @@ void ModelController::UpdateVisualizations(View & view)
 
     if (mGameVisualizationMode != GameVisualizationModeType::None)
     {
-        if (!mGameVisualizationTexture)
-        {
-            // Initialize game visualization texture
-            mGameVisualizationTextureMagnificationFactor = ShipTexturizer::CalculateHighDefinitionTextureMagnificationFactor(mModel.GetShipSize());
-            ImageSize const textureSize = ImageSize(
-                mModel.GetShipSize().width * mGameVisualizationTextureMagnificationFactor,
-                mModel.GetShipSize().height * mGameVisualizationTextureMagnificationFactor);
-
-            mGameVisualizationTexture = std::make_unique<RgbaImageData>(textureSize);
-        }
-
-        if (mGameVisualizationMode == GameVisualizationModeType::AutoTexturizationMode && !mGameVisualizationAutoTexturizationTexture)
-        {
-            // Initialize auto-texturization texture
-            mGameVisualizationAutoTexturizationTexture = std::make_unique<RgbaImageData>(mGameVisualizationTexture->Size);
-        }
+        //
+        // The game visualization is built asynchronously: we upload the outcome of the
+        // build in flight, if it's completed, and start a build of the dirty region
+        // unless a build is still in flight - in which case the dirty region keeps
+        // growing until that build completes
+        //
 
-        if (mDirtyGameVisualizationRegion.has_value())
+        std::optional<GameVisualizationBuilder::Update> const update = mGameVisualizationBuilder.TryCollectBuild();
+        if (update.has_value())
         {
-            // Update visualization
-            ImageRect const dirtyTextureRegion = UpdateGameVisualization(*mDirtyGameVisualizationRegion);
-
-            // Upload visualization
-            if (dirtyTextureRegion != mGameVisualizationTexture->Size)
+            if (!update->IsWholeVisualization)
             {
-                //
-                // For better performance, we only upload the dirty sub-texture
-                //
-
-                auto subTexture = RgbaImageData(dirtyTextureRegion.size);
-                subTexture.BlitFromRegion(
-                    *mGameVisualizationTexture,
-                    dirtyTextureRegion,
-                    { 0, 0 });
-
                 view.UpdateGameVisualization(
-                    subTexture,
-                    dirtyTextureRegion.origin);
+                    update->Texture,
+                    update->Origin);
             }
             else
             {
-                // Upload whole texture
-                view.UploadGameVisualization(*mGameVisualizationTexture);
+                view.UploadGameVisualization(update->Texture);
             }
         }
+
+        if (mDirtyGameVisualizationRegion.has_value() && !mGameVisualizationBuilder.IsBuilding())
+        {
+            mGameVisualizationBuilder.StartBuild(
+                mModel,
+                mGameVisualizationMode,
+                *mDirtyGameVisualizationRegion);
+
+            mDirtyGameVisualizationRegion.reset();
+        }
     }
     else
     {
-        assert(!mGameVisualizationTexture);
+        mGameVisualizationBuilder.Reset();
 
         if (view.HasGameVisualization())
         {
             view.RemoveGameVisualization();
         }
-    }
 
-    mDirtyGameVisualizationRegion.reset();
+        mDirtyGameVisualizationRegion.reset();
+    }
 
     // Structural
 
@@ -1581,21 +1728,13 @@ void ModelController::UpdateVisualizations(View & view)
             ImageRect const dirtyTextureRegion = UpdateStructuralLayerVisualization(*mDirtyStructuralLayerVisualizationRegion);
 
             // Upload visualization
-            if (dirtyTextureRegion != mStructuralLayerVisualizationTexture->Size)
+            if (dirtyTextureRegion != mStructuralLayerVisualizationTexture->Size
+                && view.HasStructuralLayerVisualization())
             {
-                //
-                // For better performance, we only upload the dirty sub-texture
-                //
-
-                auto subTexture = RgbaImageData(dirtyTextureRegion.size);
-                subTexture.BlitFromRegion(
-                    *mStructuralLayerVisualizationTexture,
-                    dirtyTextureRegion,
-                    { 0, 0 });
-
+                // For better performance, we only upload the dirty region
                 view.UpdateStructuralLayerVisualization(
-                    subTexture,
-                    dirtyTextureRegion.origin);
+                    *mStructuralLayerVisualizationTexture,
+                    dirtyTextureRegion);
             }
             else
             {
@@ -1629,10 +1768,22 @@ void ModelController::UpdateVisualizations(View & view)
         if (mDirtyElectricalLayerVisualizationRegion.has_value())
         {
             // Update visualization
-            UpdateElectricalLayerVisualization(*mDirtyElectricalLayerVisualizationRegion);
+            ImageRect const dirtyTextureRegion = UpdateElectricalLayerVisualization(*mDirtyElectricalLayerVisualizationRegion);
 
             // Upload visualization
-            view.UploadElectricalLayerVisualization(*mElectricalLayerVisualizationTexture);
+            if (dirtyTextureRegion != mElectricalLayerVisualizationTexture->Size
+                && view.HasElectricalLayerVisualization())
+            {
+                // For better performance, we only upload the dirty region
+                view.UpdateElectricalLayerVisualization(
+                    *mElectricalLayerVisualizationTexture,
+                    dirtyTextureRegion);
+            }
+            else
+            {
+                // Upload whole texture
+                view.UploadElectricalLayerVisualization(*mElectricalLayerVisualizationTexture);
+            }
         }
     }
     else
@@ -1684,21 +1835,13 @@ void ModelController::UpdateVisualizations(View & view)
             UpdateTextureLayerVisualization(); // Dirty region not needed for updating viz in this implementation
 
             // Upload visualization
-            if (*mDirtyTextureLayerVisualizationRegion != mModel.GetTextureLayer().Buffer.Size)
+            if (*mDirtyTextureLayerVisualizationRegion != mModel.GetTextureLayer().Buffer.Size
+                && view.HasTextureLayerVisualization())
             {
-                //
-                // For better performance, we only upload the dirty sub-texture
-                //
-
-                auto subTexture = RgbaImageData(mDirtyTextureLayerVisualizationRegion->size);
-                subTexture.BlitFromRegion(
-                    mModel.GetTextureLayer().Buffer,
-                    *mDirtyTextureLayerVisualizationRegion,
-                    { 0, 0 });
-
+                // For better performance, we only upload the dirty region
                 view.UpdateTextureLayerVisualization(
-                    subTexture,
-                    mDirtyTextureLayerVisualizationRegion->origin);
+                    mModel.GetTextureLayer().Buffer,
+                    *mDirtyTextureLayerVisualizationRegion);
             }
             else
             {
@@ -1970,44 +2113,33 @@ std::optional<ShipSpaceRect> ModelController::DoFlood(
         // Flood from point
         //
 
-        //
-        // Init visit from this point
-        //
+        Buffer2D<bool, ShipSpaceTag> regionMask(shipSize, false);
 
-        WriteParticle(start, material);
-        ShipSpaceRect affectedRect(start);
+        std::optional<ShipSpaceRect> const affectedRect = FloodFill::FillContiguous(
+            start,
+            false, // Four-connected
+            [&](int x, int y) -> bool
+            {
+                return layer.Buffer[ShipSpaceCoordinates(x, y)].Material == startMaterial;
+            },
+            regionMask);
 
-        std::queue<ShipSpaceCoordinates> pointsToPropagateFrom;
-        pointsToPropagateFrom.push(start);
+        assert(affectedRect.has_value());
 
         //
-        // Propagate
+        // Write region
         //
 
-        auto const checkPropagateToNeighbor = [&](ShipSpaceCoordinates neighborCoords)
+        for (int y = affectedRect->origin.y; y < affectedRect->origin.y + affectedRect->size.height; ++y)
         {
-            if (neighborCoords.IsInSize(shipSize) && layer.Buffer[neighborCoords].Material == startMaterial)
+            for (int x = affectedRect->origin.x; x < affectedRect->origin.x + affectedRect->size.width; ++x)
             {
-                // Visit point
-                WriteParticle(neighborCoords, material);
-                affectedRect.UnionWith(neighborCoords);
-
-                // Propagate from point
-                pointsToPropagateFrom.push(neighborCoords);
+                ShipSpaceCoordinates const coords(x, y);
+                if (regionMask[coords])
+                {
+                    WriteParticle(coords, material);
+                }
             }
-        };
-
-        while (!pointsToPropagateFrom.empty())
-        {
-            // Pop point that we have to propagate from
-            auto const currentPoint = pointsToPropagateFrom.front();
-            pointsToPropagateFrom.pop();
-
-            // Push neighbors
-            checkPropagateToNeighbor({ currentPoint.x - 1, currentPoint.y });
-            checkPropagateToNeighbor({ currentPoint.x + 1, currentPoint.y });
-            checkPropagateToNeighbor({ currentPoint.x, currentPoint.y - 1 });
-            checkPropagateToNeighbor({ currentPoint.x, currentPoint.y + 1 });
         }
 
         return affectedRect;
@@ -2070,131 +2202,122 @@ std::optional<ImageRect> ModelController::DoTextureMagicWandEraseBackground(
         return std::nullopt;
     }
 
-    vec3f const seedColor = seedColorRgb.toVec3f();
+    // Mark pixels that are within tolerance
+    Buffer2D<bool, ImageTag> const toleranceMask = FloodFill::MakeColorToleranceMask(
+        layer.Buffer,
+        seedColorRgb,
+        tolerance);
 
-    // Our distance function - from https://www.photoshopgurus.com/forum/threads/tolerance.52555/page-2
-    auto const distanceFromSeed = [seedColor](vec3f const & sampleColor) -> float
-    {
-        vec3f const deltaColor = (sampleColor - seedColor).abs();
-
-        return std::max({
-            deltaColor.x,
-            deltaColor.y,
-            deltaColor.z,
-            std::abs(deltaColor.x - deltaColor.y),
-            std::abs(deltaColor.y - deltaColor.z),
-            std::abs(deltaColor.z - deltaColor.x) });
-    };
-
-    // Transform tolerance into max distance (included)
-    float const maxColorDistance = static_cast<float>(tolerance) / 100.0f;
-
-    // Save original alpha mask for neighbors
-    Buffer2D<typename rgbaColor::data_type, ImageTag> originalAlphaMask = layer.Buffer.Transform<typename rgbaColor::data_type>(
-        [](rgbaColor const & color) -> typename rgbaColor::data_type
-        {
-            return color.a;
-        });
-
-    // Initialize affected region
-    ImageRect affectedRegion(start); // We're sure we'll erase the start pixel
-
-    // Anti-alias functor
-    auto const doAntiAliasNeighbor = [&](ImageCoordinates const & neighborCoordinates) -> void
-    {
-        layer.Buffer[neighborCoordinates].a = originalAlphaMask[neighborCoordinates] / 3;
-        affectedRegion.UnionWith(neighborCoordinates);
-    };
+    assert(toleranceMask[start]); // We're sure we'll erase the start pixel
 
+    // Mark pixels to erase
+    std::optional<Buffer2D<bool, ImageTag>> contiguousRegionMask;
+    std::optional<ImageRect> eraseRegion;
     if (doContiguousOnly)
     {
         //
         // Flood from starting point
         //
 
-        std::queue<ImageCoordinates> pixelsToPropagateFrom;
+        contiguousRegionMask.emplace(textureSize, false);
 
-        // Erase this pixel
-        layer.Buffer[start].a = 0;
-        affectedRegion.UnionWith(start);
-
-        // Visit from here
-        pixelsToPropagateFrom.push(start);
+        eraseRegion = FloodFill::FillContiguous(
+            start,
+            true, // Eight-connected
+            [&toleranceMask](int x, int y) -> bool
+            {
+                return toleranceMask[ImageCoordinates(x, y)];
+            },
+            *contiguousRegionMask);
+    }
+    else
+    {
+        //
+        // Color substitution
+        //
 
-        while (!pixelsToPropagateFrom.empty())
+        for (int y = 0; y < textureSize.height; ++y)
         {
-            auto const sourceCoords = pixelsToPropagateFrom.front();
-            pixelsToPropagateFrom.pop();
-
-            // Check neighbors
-            for (int yn = sourceCoords.y - 1; yn <= sourceCoords.y + 1; ++yn)
+            for (int x = 0; x < textureSize.width; ++x)
             {
-                for (int xn = sourceCoords.x - 1; xn <= sourceCoords.x + 1; ++xn)
+                ImageCoordinates const sampleCoordinates{ x, y };
+                if (toleranceMask[sampleCoordinates])
                 {
-                    ImageCoordinates const neighborCoordinates{ xn, yn };
-                    if (neighborCoordinates.IsInSize(textureSize)
-                        && layer.Buffer[neighborCoordinates].a != 0)
+                    if (!eraseRegion.has_value())
                     {
-                        // Check distance
-                        if (distanceFromSeed(layer.Buffer[neighborCoordinates].toVec3f()) <= maxColorDistance)
-                        {
-                            // Erase this pixel
-                            layer.Buffer[neighborCoordinates].a = 0;
-                            affectedRegion.UnionWith(neighborCoordinates);
-
-                            // Continue visit from here
-                            pixelsToPropagateFrom.push(neighborCoordinates);
-                        }
-                        else if (isAntiAlias)
-                        {
-                            // Anti-alias this neighbor
-                            doAntiAliasNeighbor(neighborCoordinates);
-                        }
+                        eraseRegion = ImageRect(sampleCoordinates);
+                    }
+                    else
+                    {
+                        eraseRegion->UnionWith(sampleCoordinates);
                     }
                 }
             }
         }
     }
-    else
+
+    assert(eraseRegion.has_value());
+
+    Buffer2D<bool, ImageTag> const & eraseMask = contiguousRegionMask.has_value() ? *contiguousRegionMask : toleranceMask;
+
+    ImageRect affectedRegion = *eraseRegion;
+
+    if (isAntiAlias)
     {
         //
-        // Color substitution
+        // Do anti-aliasing on existing, too-distant pixels neighboring the pixels to erase;
+        // done before erasing, so that each pixel is visited once and its alpha is still
+        // the original one
         //
 
-        for (int y = 0; y < textureSize.height; ++y)
+        ImageRect const antiAliasRegion = *ImageRect(
+            ImageCoordinates(eraseRegion->origin.x - 1, eraseRegion->origin.y - 1),
+            ImageSize(eraseRegion->size.width + 2, eraseRegion->size.height + 2)).MakeIntersectionWith(ImageRect(textureSize));
+
+        for (int y = antiAliasRegion.origin.y; y < antiAliasRegion.origin.y + antiAliasRegion.size.height; ++y)
         {
-            for (int x = 0; x < textureSize.width; ++x)
+            for (int x = antiAliasRegion.origin.x; x < antiAliasRegion.origin.x + antiAliasRegion.size.width; ++x)
             {
                 ImageCoordinates const sampleCoordinates{ x, y };
-
-                if (layer.Buffer[sampleCoordinates].a != 0
-                    && distanceFromSeed(layer.Buffer[sampleCoordinates].toVec3f()) <= maxColorDistance)
+                if (layer.Buffer[sampleCoordinates].a == 0 || toleranceMask[sampleCoordinates])
                 {
-                    // Erase
-                    layer.Buffer[sampleCoordinates].a = 0;
-                    affectedRegion.UnionWith(sampleCoordinates);
+                    continue;
+                }
 
-                    if (isAntiAlias)
+                bool hasErasedNeighbor = false;
+                for (int yn = std::max(y - 1, 0); yn <= std::min(y + 1, textureSize.height - 1) && !hasErasedNeighbor; ++yn)
+                {
+                    for (int xn = std::max(x - 1, 0); xn <= std::min(x + 1, textureSize.width - 1); ++xn)
                     {
-                        //
-                        // Do anti-aliasing on neighboring, too-distant pixels
-                        //
-
-                        for (int yn = y - 1; yn <= y + 1; ++yn)
+                        if (eraseMask[{ xn, yn }])
                         {
-                            for (int xn = x - 1; xn <= x + 1; ++xn)
-                            {
-                                ImageCoordinates const neighborCoordinates{ xn, yn };
-                                if (neighborCoordinates.IsInSize(textureSize)
-                                    && layer.Buffer[neighborCoordinates].a != 0
-                                    && distanceFromSeed(layer.Buffer[neighborCoordinates].toVec3f()) > maxColorDistance)
-                                {
-                                    doAntiAliasNeighbor(neighborCoordinates);
-                                }
-                            }
+                            hasErasedNeighbor = true;
+                            break;
                         }
                     }
                 }
+
+                if (hasErasedNeighbor)
+                {
+                    layer.Buffer[sampleCoordinates].a /= 3;
+                    affectedRegion.UnionWith(sampleCoordinates);
+                }
+            }
+        }
+    }
+
+    //
+    // Erase
+    //
+
+    for (int y = eraseRegion->origin.y; y < eraseRegion->origin.y + eraseRegion->size.height; ++y)
+    {
+        for (int x = eraseRegion->origin.x; x < eraseRegion->origin.x + eraseRegion->size.width; ++x)
+        {
+            ImageCoordinates const sampleCoordinates{ x, y };
+            if (eraseMask[sampleCoordinates])
+            {
+                layer.Buffer[sampleCoordinates].a = 0;
             }
         }
     }
@@ -2220,6 +2343,11 @@ void ModelController::RegisterDirtyVisualization(TRect const & region)
     }
     else if constexpr (TVisualization == VisualizationType::StructuralLayer)
     {
+        // Layer changes are always reported via their visualizations, hence this
+        // is also where the validator and the autosave journal learn about them
+        mModelValidator.RegisterDirtyStructuralLayerRegion(region);
+        RegisterJournalDirtyRegion(mJournalDirtyStructuralLayerRegion, region);
+
         if (!mDirtyStructuralLayerVisualizationRegion.has_value())
         {
             mDirtyStructuralLayerVisualizationRegion = region;
@@ -2231,6 +2359,9 @@ void ModelController::RegisterDirtyVisualization(TRect const & region)
     }
     else if constexpr (TVisualization == VisualizationType::ElectricalLayer)
     {
+        mModelValidator.RegisterDirtyElectricalLayerRegion(region);
+        RegisterJournalDirtyRegion(mJournalDirtyElectricalLayerRegion, region);
+
         if (!mDirtyElectricalLayerVisualizationRegion.has_value())
         {
             mDirtyElectricalLayerVisualizationRegion = region;
@@ -2242,6 +2373,8 @@ void ModelController::RegisterDirtyVisualization(TRect const & region)
     }
     else if constexpr (TVisualization == VisualizationType::RopesLayer)
     {
+        mIsJournalRopesLayerDirty = true;
+
         if (!mDirtyRopesLayerVisualizationRegion.has_value())
         {
             mDirtyRopesLayerVisualizationRegion = region;
@@ -2255,6 +2388,8 @@ void ModelController::RegisterDirtyVisualization(TRect const & region)
     {
         static_assert(TVisualization == VisualizationType::TextureLayer);
 
+        RegisterJournalDirtyRegion(mJournalDirtyTextureLayerRegion, region);
+
         if (!mDirtyTextureLayerVisualizationRegion.has_value())
         {
             mDirtyTextureLayerVisualizationRegion = region;
@@ -2266,82 +2401,6 @@ void ModelController::RegisterDirtyVisualization(TRect const & region)
     }
 }
 
-ImageRect ModelController::UpdateGameVisualization(ShipSpaceRect const & region)
-{
-    //
-    // 1. Prepare source of triangularized rendering
-    //
-
-    RgbaImageData const * sourceTexture = nullptr;
-
-    if (mGameVisualizationMode == GameVisualizationModeType::AutoTexturizationMode)
-    {
-        assert(mModel.HasLayer(LayerType::Structural));
-        assert(mGameVisualizationAutoTexturizationTexture);
-
-        ShipAutoTexturizationSettings settings = mModel.GetShipAutoTexturizationSettings().value_or(ShipAutoTexturizationSettings());
-
-        mShipTexturizer.AutoTexturizeInto(
-            mModel.GetStructuralLayer(),
-            region,
-            *mGameVisualizationAutoTexturizationTexture,
-            mGameVisualizationTextureMagnificationFactor,
-            settings);
-
-        sourceTexture = mGameVisualizationAutoTexturizationTexture.get();
-    }
-    else
-    {
-        assert(mGameVisualizationMode == GameVisualizationModeType::TextureMode);
-
-        assert(mModel.HasLayer(LayerType::Structural));
-        assert(mModel.HasLayer(LayerType::Texture));
-
-        sourceTexture = &mModel.GetTextureLayer().Buffer;
-    }
-
-    assert(sourceTexture != nullptr);
-
-    //
-    // 2. Do triangularized rendering
-    //
-
-    // Given that texturization looks at x+1 and y+1, we enlarge the region down and to the left
-    ShipSpaceRect effectiveRegion = region;
-    if (effectiveRegion.origin.x > 0)
-    {
-        effectiveRegion.origin.x -= 1;
-        effectiveRegion.size.width += 1;
-    }
-
-    if (effectiveRegion.origin.y > 0)
-    {
-        effectiveRegion.origin.y -= 1;
-        effectiveRegion.size.height += 1;
-    }
-
-    assert(mGameVisualizationTexture);
-
-    mShipTexturizer.RenderShipInto(
-        mModel.GetStructuralLayer(),
-        effectiveRegion,
-        *sourceTexture,
-        *mGameVisualizationTexture,
-        mGameVisualizationTextureMagnificationFactor);
-
-    //
-    // 3. Return dirty image region
-    //
-
-    return ImageRect(
-        ImageCoordinates(
-            effectiveRegion.origin.x * mGameVisualizationTextureMagnificationFactor, 
-            effectiveRegion.origin.y * mGameVisualizationTextureMagnificationFactor),
-        ImageSize(
-            effectiveRegion.size.width * mGameVisualizationTextureMagnificationFactor, 
-            effectiveRegion.size.height * mGameVisualizationTextureMagnificationFactor));
-}
-
 ImageRect ModelController::UpdateStructuralLayerVisualization(ShipSpaceRect const & region)
 {
     switch (mStructuralLayerVisualizationMode)
@@ -2400,7 +2459,7 @@ void ModelController::RenderStructureInto(
     }
 }
 
-void ModelController::UpdateElectricalLayerVisualization(ShipSpaceRect const & region)
+ImageRect ModelController::UpdateElectricalLayerVisualization(ShipSpaceRect const & region)
 {
     switch (mElectricalLayerVisualizationMode)
     {
@@ -2434,9 +2493,18 @@ void ModelController::UpdateElectricalLayerVisualization(ShipSpaceRect const & r
 
         case ElectricalLayerVisualizationModeType::None:
         {
-            return;
+            // Nop
+            break;
         }
     }
+
+    return ImageRect(
+        ImageCoordinates(
+            region.origin.x,
+            region.origin.y),
+        ImageSize(
+            region.size.width,
+            region.size.height));
 }
 
 void ModelController::UpdateRopesLayerVisualization()
@@ -5,16 +5,19 @@
 ***************************************************************************************/
 #pragma once
 
+#include "GameVisualizationBuilder.h"
 #include "IModelObservable.h"
 #include "InstancedElectricalElementSet.h"
 #include "Model.h"
 #include "ModelValidationResults.h"
+#include "ModelValidator.h"
 #include "ShipBuilderTypes.h"
 #include "View.h"
 
 #include <Game/Layers.h>
 #include <Game/Materials.h>
 #include <Game/ShipDefinition.h>
+#include <Game/ShipDefinitionDelta.h>
 #include <Game/ShipTexturizer.h>
 
 #include <GameCore/GameTypes.h>
@@ -71,6 +74,12 @@ public:
 
     std::optional<ShipSpaceRect> CalculateBoundingBox() const;
 
+    /*
+     * Makes a copy of the specified region of all layers, with the region's origin at {0, 0};
+     * the texture layer's region is the one covering the specified ship region.
+     */
+    ShipLayers Copy(ShipSpaceRect const & region) const;
+
     bool HasLayer(LayerType layer) const override
     {
         return mModel.HasLayer(layer);
@@ -111,9 +120,8 @@ public:
         mModel.ClearIsDirty();
     }
 
-    ModelValidationResults ValidateModel() const;
+    ModelValidationResults ValidateModel();
 
-#ifdef _DEBUG
     bool IsInEphemeralVisualization() const
     {
         return mIsStructuralLayerInEphemeralVisualization
@@ -121,7 +129,15 @@ public:
             || mIsRopesLayerInEphemeralVisualization
             || mIsTextureLayerInEphemeralVisualization;
     }
-#endif
+
+    /*
+     * Returns the changes made to the model since the last invocation - or since the
+     * last clear - for the autosave journal; the model must not be in an ephemeral
+     * visualization, and its shape must not have changed in the meanwhile.
+     */
+    ShipDefinitionDelta MakeJournalDelta();
+
+    void ClearJournalChanges();
 
     ShipMetadata const & GetShipMetadata() const override
     {
@@ -131,6 +147,7 @@ public:
     void SetShipMetadata(ShipMetadata && shipMetadata)
     {
         mModel.SetShipMetadata(std::move(shipMetadata));
+        mAreJournalPropertiesDirty = true;
     }
 
     ShipPhysicsData const & GetShipPhysicsData() const override
@@ -141,6 +158,7 @@ public:
     void SetShipPhysicsData(ShipPhysicsData && shipPhysicsData)
     {
         mModel.SetShipPhysicsData(std::move(shipPhysicsData));
+        mAreJournalPropertiesDirty = true;
     }
 
     std::optional<ShipAutoTexturizationSettings> const & GetShipAutoTexturizationSettings() const override
@@ -151,6 +169,7 @@ public:
     void SetShipAutoTexturizationSettings(std::optional<ShipAutoTexturizationSettings> && shipAutoTexturizationSettings)
     {
         mModel.SetShipAutoTexturizationSettings(std::move(shipAutoTexturizationSettings));
+        mAreJournalPropertiesDirty = true;
     }
 
     InstancedElectricalElementSet const & GetInstancedElectricalElementSet() const
@@ -161,6 +180,9 @@ public:
     void SetElectricalPanelMetadata(ElectricalPanelMetadata && panelMetadata)
     {
         mModel.SetElectricalPanelMetadata(std::move(panelMetadata));
+
+        // The panel travels with the electrical layer
+        RegisterJournalDirtyRegion(mJournalDirtyElectricalLayerRegion, GetWholeShipRect());
     }
 
     std::optional<SampledInformation> SampleInformationAt(ShipSpaceCoordinates const & coordinates, LayerType layer) const;
@@ -255,6 +277,8 @@ public:
 
     std::unique_ptr<ElectricalLayerData> CloneElectricalLayer() const;
 
+    std::unique_ptr<SparseElectricalLayerData> CloneSparseElectricalLayer() const;
+
     ElectricalMaterial const * SampleElectricalMaterialAt(ShipSpaceCoordinates const & coords) const;
 
     bool IsElectricalParticleAllowedAt(ShipSpaceCoordinates const & coords) const;
@@ -354,6 +378,8 @@ public:
         ImageRect const & sourceRegion,
         ImageCoordinates const & targetOrigin);
 
+    void RestoreTextureLayerTiles(TextureLayerSnapshot::TileSet const & tiles);
+
     void RestoreTextureLayer(
         std::unique_ptr<TextureLayerData> textureLayer,
         std::optional<std::string> originalTextureArtCredits);
@@ -365,6 +391,10 @@ public:
         ImageRect const & sourceRegion,
         ImageCoordinates const & targetOrigin);
 
+    void RestoreTextureLayerRegionForEphemeralVisualization(
+        TextureLayerSnapshot const & sourceLayerSnapshot,
+        ImageRect const & region);
+
 
     //
     // Visualizations
@@ -383,6 +413,15 @@ public:
 
     void UpdateVisualizations(View & view);
 
+    /*
+     * Whether visualizations being built asynchronously are ready to be picked up
+     * by UpdateVisualizations().
+     */
+    bool HasPendingVisualizationUpdates() const
+    {
+        return mGameVisualizationBuilder.IsBuildCompleted();
+    }
+
 private:
 
     ModelController(
@@ -401,6 +440,21 @@ private:
         return ImageRect(GetTextureSize());
     }
 
+    template<typename TRect>
+    static void RegisterJournalDirtyRegion(
+        std::optional<TRect> & journalDirtyRegion,
+        TRect const & region)
+    {
+        if (!journalDirtyRegion.has_value())
+        {
+            journalDirtyRegion = region;
+        }
+        else
+        {
+            journalDirtyRegion->UnionWith(region);
+        }
+    }
+
     void InitializeStructuralLayerAnalysis();
 
     void InitializeElectricalLayerAnalysis();
@@ -446,15 +500,13 @@ private:
     template<VisualizationType TVisualization, typename TRect>
     void RegisterDirtyVisualization(TRect const & region);
 
-    ImageRect UpdateGameVisualization(ShipSpaceRect const & region);
-
     ImageRect UpdateStructuralLayerVisualization(ShipSpaceRect const & region);
 
     void RenderStructureInto(
         ShipSpaceRect const & structureRegion,
         RgbaImageData & texture) const;
 
-    void UpdateElectricalLayerVisualization(ShipSpaceRect const & region);
+    ImageRect UpdateElectricalLayerVisualization(ShipSpaceRect const & region);
 
     void UpdateRopesLayerVisualization();
 
@@ -464,8 +516,6 @@ private:
 
     Model mModel;
 
-    ShipTexturizer const & mShipTexturizer;
-
     //
     // Auxiliary layers' members
     //
@@ -477,14 +527,15 @@ private:
     InstancedElectricalElementSet mInstancedElectricalElementSet;
     size_t mElectricalParticleCount;
 
+    // Kept up-to-date with the dirty regions of the structural and electrical layers
+    ModelValidator mModelValidator;
+
     //
     // Visualizations
     //
 
     GameVisualizationModeType mGameVisualizationMode;
-    std::unique_ptr<RgbaImageData> mGameVisualizationAutoTexturizationTexture;
-    std::unique_ptr<RgbaImageData> mGameVisualizationTexture;
-    int mGameVisualizationTextureMagnificationFactor;
+    GameVisualizationBuilder mGameVisualizationBuilder;
 
     StructuralLayerVisualizationModeType mStructuralLayerVisualizationMode;
     std::unique_ptr<RgbaImageData> mStructuralLayerVisualizationTexture;
@@ -503,6 +554,17 @@ private:
     std::optional<ShipSpaceRect> mDirtyRopesLayerVisualizationRegion;
     std::optional<ImageRect> mDirtyTextureLayerVisualizationRegion;
 
+    //
+    // Autosave journal
+    //
+
+    // Regions - and properties - changed since the last journal delta
+    std::optional<ShipSpaceRect> mJournalDirtyStructuralLayerRegion;
+    std::optional<ShipSpaceRect> mJournalDirtyElectricalLayerRegion;
+    bool mIsJournalRopesLayerDirty;
+    std::optional<ImageRect> mJournalDirtyTextureLayerRegion;
+    bool mAreJournalPropertiesDirty;
+
     //
     // Debugging
     //
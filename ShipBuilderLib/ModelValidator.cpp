@@ -5,44 +5,100 @@
 ***************************************************************************************/
 #include "ModelValidator.h"
 
+#include <cassert>
 #include <queue>
 
 namespace ShipBuilder {
 
 ModelValidationResults ModelValidator::ValidateModel(Model const & model)
 {
-    std::vector<ModelValidationIssue> issues;
+    ModelValidator validator;
+    return validator.Validate(model);
+}
+
+ModelValidator::ModelValidator()
+    : mParticleFacts()
+    , mHasElectricalLayer(false)
+    , mTotals()
+    , mInstancedElementParticleCounts()
+    , mElectricalConnectivityIssues()
+    , mDirtyRegion()
+    , mIsElectricalConnectivityDirty(false)
+{
+}
+
+void ModelValidator::Reset()
+{
+    mParticleFacts.reset();
+}
+
+ModelValidationResults ModelValidator::Validate(Model const & model)
+{
+    assert(model.HasLayer(LayerType::Structural));
+
+    ShipSpaceSize const shipSize = model.GetShipSize();
+    bool const hasElectricalLayer = model.HasLayer(LayerType::Electrical);
 
     //
-    // Visit structural layer
+    // Start from scratch, if needed
     //
 
-    assert(model.HasLayer(LayerType::Structural));
+    if (!mParticleFacts
+        || mParticleFacts->Size != shipSize
+        || mHasElectricalLayer != hasElectricalLayer)
+    {
+        mParticleFacts = std::make_unique<Buffer2D<ParticleFacts, ShipSpaceTag>>(shipSize);
+        mHasElectricalLayer = hasElectricalLayer;
 
-    StructuralLayerData const & structuralLayer = model.GetStructuralLayer();
+        mTotals = Totals();
+        mInstancedElementParticleCounts.clear();
+
+        mDirtyRegion = ShipSpaceRect(shipSize);
+        mIsElectricalConnectivityDirty = true;
+    }
 
-    size_t structuralParticlesCount = 0;
+    //
+    // Bring facts up-to-date with the dirty region
+    //
 
-    for (int y = 0; y < structuralLayer.Buffer.Size.height; ++y)
+    if (mDirtyRegion.has_value())
     {
-        for (int x = 0; x < structuralLayer.Buffer.Size.width; ++x)
+        auto const effectiveDirtyRegion = mDirtyRegion->MakeIntersectionWith(ShipSpaceRect(shipSize));
+        if (effectiveDirtyRegion.has_value())
         {
-            if (structuralLayer.Buffer[{x, y}].Material != nullptr)
-            {
-                ++structuralParticlesCount;
-            }
+            UpdateParticleFacts(model, *effectiveDirtyRegion);
+        }
+
+        mDirtyRegion.reset();
+    }
+
+    if (mIsElectricalConnectivityDirty)
+    {
+        mElectricalConnectivityIssues.clear();
+
+        if (hasElectricalLayer)
+        {
+            ValidateElectricalConnectivity();
         }
+
+        mIsElectricalConnectivityDirty = false;
     }
 
+    //
+    // Do checks
+    //
+
+    std::vector<ModelValidationIssue> issues;
+
     //
     // Check: empty structural layer
     //
 
     issues.emplace_back(
         ModelValidationIssue::CheckClassType::EmptyStructuralLayer,
-        (structuralParticlesCount == 0) ? ModelValidationIssue::SeverityType::Error : ModelValidationIssue::SeverityType::Success);
+        (mTotals.StructuralParticlesCount == 0) ? ModelValidationIssue::SeverityType::Error : ModelValidationIssue::SeverityType::Success);
 
-    if (structuralParticlesCount != 0)
+    if (mTotals.StructuralParticlesCount != 0)
     {
         //
         // Check: structure too large
@@ -52,58 +108,19 @@ ModelValidationResults ModelValidator::ValidateModel(Model const & model)
 
         issues.emplace_back(
             ModelValidationIssue::CheckClassType::StructureTooLarge,
-            (structuralParticlesCount > MaxStructuralParticles) ? ModelValidationIssue::SeverityType::Warning : ModelValidationIssue::SeverityType::Success);
+            (mTotals.StructuralParticlesCount > MaxStructuralParticles) ? ModelValidationIssue::SeverityType::Warning : ModelValidationIssue::SeverityType::Success);
     }
 
-    if (model.HasLayer(LayerType::Electrical))
+    if (hasElectricalLayer)
     {
-        //
-        // Visit electrical layer
-        //
-
-        ElectricalLayerData const & electricalLayer = model.GetElectricalLayer();
-
-        size_t electricalParticlesWithNoStructuralSubstratumCount = 0;
-        size_t lightEmittingParticlesCount = 0;
-        size_t visibleElectricalPanelElementsCount = 0;
-
-        assert(structuralLayer.Buffer.Size == electricalLayer.Buffer.Size);
-        for (int y = 0; y < structuralLayer.Buffer.Size.height; ++y)
-        {
-            for (int x = 0; x < structuralLayer.Buffer.Size.width; ++x)
-            {
-                auto const coords = ShipSpaceCoordinates(x, y);
-                auto const electricalMaterial = electricalLayer.Buffer[coords].Material;
-                if (electricalMaterial != nullptr)
-                {
-                    if (structuralLayer.Buffer[coords].Material == nullptr)
-                    {
-                        ++electricalParticlesWithNoStructuralSubstratumCount;
-                    }
-
-                    if (electricalMaterial->Luminiscence != 0.0f)
-                    {
-                        ++lightEmittingParticlesCount;
-                    }
-
-                    if (electricalMaterial->IsInstanced)
-                    {
-                        assert(electricalLayer.Buffer[coords].InstanceIndex != NoneElectricalElementInstanceIndex);
-                        if (auto const searchIt = electricalLayer.Panel.find(electricalLayer.Buffer[coords].InstanceIndex);
-                            searchIt == electricalLayer.Panel.end() || !searchIt->second.IsHidden)
-                        {
-                            ++visibleElectricalPanelElementsCount;
-                        }
-                    }
-                }
-            }
-        }
-
         //
         // Check: connectivity
         //
 
-        ValidateElectricalConnectivity(electricalLayer, issues);
+        issues.insert(
+            issues.end(),
+            mElectricalConnectivityIssues.cbegin(),
+            mElectricalConnectivityIssues.cend());
 
         //
         // Check: electrical substratum
@@ -111,7 +128,7 @@ ModelValidationResults ModelValidator::ValidateModel(Model const & model)
 
         issues.emplace_back(
             ModelValidationIssue::CheckClassType::MissingElectricalSubstratum,
-            (electricalParticlesWithNoStructuralSubstratumCount > 0) ? ModelValidationIssue::SeverityType::Error : ModelValidationIssue::SeverityType::Success);
+            (mTotals.ElectricalParticlesWithNoStructuralSubstratumCount > 0) ? ModelValidationIssue::SeverityType::Error : ModelValidationIssue::SeverityType::Success);
 
         //
         // Check: too many lights
@@ -121,12 +138,24 @@ ModelValidationResults ModelValidator::ValidateModel(Model const & model)
 
         issues.emplace_back(
             ModelValidationIssue::CheckClassType::TooManyLights,
-            (lightEmittingParticlesCount > MaxLightEmittingParticles) ? ModelValidationIssue::SeverityType::Warning : ModelValidationIssue::SeverityType::Success);
+            (mTotals.LightEmittingParticlesCount > MaxLightEmittingParticles) ? ModelValidationIssue::SeverityType::Warning : ModelValidationIssue::SeverityType::Success);
 
         //
         // Check: too many elements in electrical panel
         //
 
+        // Panel visibility is not tracked by dirty regions, hence we look it up at each validation
+        ElectricalPanelMetadata const & electricalPanel = model.GetElectricalLayer().Panel;
+        size_t visibleElectricalPanelElementsCount = 0;
+        for (auto const & entry : mInstancedElementParticleCounts)
+        {
+            if (auto const searchIt = electricalPanel.find(entry.first);
+                searchIt == electricalPanel.end() || !searchIt->second.IsHidden)
+            {
+                visibleElectricalPanelElementsCount += entry.second;
+            }
+        }
+
         size_t constexpr MaxVisibleElectricalPanelElements = 22;
 
         issues.emplace_back(
@@ -137,199 +166,286 @@ ModelValidationResults ModelValidator::ValidateModel(Model const & model)
     return ModelValidationResults(std::move(issues));
 }
 
-void ModelValidator::ValidateElectricalConnectivity(
-    ElectricalLayerData const & electricalLayer,
-    std::vector<ModelValidationIssue> & issues)
+void ModelValidator::RegisterDirtyRegion(ShipSpaceRect const & region)
 {
-    //
-    // Pass 1: create collections of categories, and connectivity visit buffers
-    //
+    if (!mDirtyRegion.has_value())
+    {
+        mDirtyRegion = region;
+    }
+    else
+    {
+        mDirtyRegion->UnionWith(region);
+    }
+}
 
-    Buffer2D<CVElement, ShipSpaceTag> electricalConnectivityVisitBuffer(electricalLayer.Buffer.Size);
-    Buffer2D<CVElement, ShipSpaceTag> engineConnectivityVisitBuffer(electricalLayer.Buffer.Size);
+void ModelValidator::UpdateParticleFacts(
+    Model const & model,
+    ShipSpaceRect const & region)
+{
+    assert(mParticleFacts);
 
-    std::vector<ShipSpaceCoordinates> electricalSources;
-    std::vector<ShipSpaceCoordinates> electricalComponents; // Anything that needs to be connected to a source; includes all consumers
-    std::vector<ShipSpaceCoordinates> electricalConsumers;
-    std::vector<ShipSpaceCoordinates> engineSources;
-    std::vector<ShipSpaceCoordinates> engineComponents; // Anything that needs to be connected to a source; incldues all consumers
-    std::vector<ShipSpaceCoordinates> engineConsumers;
+    StructuralLayerData const & structuralLayer = model.GetStructuralLayer();
+    ElectricalLayerData const * const electricalLayer = mHasElectricalLayer ? &model.GetElectricalLayer() : nullptr;
 
-    bool hasElectricals = false;
-    bool hasEngines = false;
+    assert(structuralLayer.Buffer.Size == mParticleFacts->Size);
+    assert(electricalLayer == nullptr || electricalLayer->Buffer.Size == mParticleFacts->Size);
 
-    for (int y = 0; y < electricalLayer.Buffer.Size.height; ++y)
+    for (int y = region.origin.y; y < region.origin.y + region.size.height; ++y)
     {
-        for (int x = 0; x < electricalLayer.Buffer.Size.width; ++x)
+        for (int x = region.origin.x; x < region.origin.x + region.size.width; ++x)
         {
-            ShipSpaceCoordinates coords{ x, y };
+            auto const coords = ShipSpaceCoordinates(x, y);
 
-            // Initialize flags
-            electricalConnectivityVisitBuffer[coords].wholeElement = 0;
-            engineConnectivityVisitBuffer[coords].wholeElement = 0;
+            ParticleFacts const newFacts = MakeParticleFacts(
+                structuralLayer.Buffer[coords],
+                electricalLayer != nullptr ? &(electricalLayer->Buffer[coords]) : nullptr);
 
-            // Inspect material
-            auto const electricalMaterial = electricalLayer.Buffer[coords].Material;
-            if (electricalMaterial)
-            {
-                switch (electricalMaterial->ElectricalType)
-                {
-                    case ElectricalMaterial::ElectricalElementType::Cable:
-                    {
-                        electricalConnectivityVisitBuffer[coords].flags.isConductive = electricalMaterial->ConductsElectricity;
-                        engineConnectivityVisitBuffer[coords].flags.isConductive = false;
-                        electricalComponents.push_back(coords);
+            ParticleFacts & facts = (*mParticleFacts)[coords];
 
-                        hasElectricals = true;
-                        break;
-                    }
+            AccountParticleFacts(facts, false);
+            facts = newFacts;
+            AccountParticleFacts(facts, true);
+        }
+    }
+}
 
-                    case ElectricalMaterial::ElectricalElementType::Engine:
-                    {
-                        electricalConnectivityVisitBuffer[coords].flags.isConductive = true; // Engines may be electrically conductive when they're working
-                        engineConnectivityVisitBuffer[coords].flags.isConductive = true;
-                        engineComponents.push_back(coords);
-                        engineConsumers.push_back(coords);
+void ModelValidator::AccountParticleFacts(
+    ParticleFacts const & facts,
+    bool isAdding)
+{
+    auto const account = [isAdding](size_t & count)
+    {
+        if (isAdding)
+        {
+            ++count;
+        }
+        else
+        {
+            assert(count > 0);
+            --count;
+        }
+    };
 
-                        hasEngines = true;
-                        break;
-                    }
+    if (facts.Flags & ParticleFlags::HasStructure)
+    {
+        account(mTotals.StructuralParticlesCount);
+    }
 
-                    case ElectricalMaterial::ElectricalElementType::EngineController:
-                    {
-                        electricalConnectivityVisitBuffer[coords].flags.isConductive = electricalMaterial->ConductsElectricity;
-                        engineConnectivityVisitBuffer[coords].flags.isConductive = true;
-                        electricalComponents.push_back(coords);
-                        electricalConsumers.push_back(coords); // Controllers need electricity
-                        engineSources.push_back(coords);
-
-                        hasElectricals = true;
-                        hasEngines = true;
-                        break;
-                    }
+    if (facts.Flags & ParticleFlags::HasElectrical)
+    {
+        if (!(facts.Flags & ParticleFlags::HasStructure))
+        {
+            account(mTotals.ElectricalParticlesWithNoStructuralSubstratumCount);
+        }
 
-                    case ElectricalMaterial::ElectricalElementType::EngineTransmission:
-                    {
-                        electricalConnectivityVisitBuffer[coords].flags.isConductive = electricalMaterial->ConductsElectricity;
-                        engineConnectivityVisitBuffer[coords].flags.isConductive = true;
-                        engineComponents.push_back(coords);
+        if (facts.Flags & ParticleFlags::IsLightEmitting)
+        {
+            account(mTotals.LightEmittingParticlesCount);
+        }
 
-                        hasEngines = true;
-                        break;
-                    }
+        if (facts.Flags & ParticleFlags::IsElectricalSystem)
+        {
+            account(mTotals.ElectricalSystemParticlesCount);
+        }
 
-                    case ElectricalMaterial::ElectricalElementType::Generator:
-                    {
-                        electricalConnectivityVisitBuffer[coords].flags.isConductive = electricalMaterial->ConductsElectricity;
-                        engineConnectivityVisitBuffer[coords].flags.isConductive = false;
-                        electricalSources.push_back(coords);
+        if (facts.Flags & ParticleFlags::IsEngineSystem)
+        {
+            account(mTotals.EngineSystemParticlesCount);
+        }
 
-                        hasElectricals = true;
-                        break;
-                    }
+        if (facts.InstanceIndex != NoneElectricalElementInstanceIndex)
+        {
+            if (isAdding)
+            {
+                ++mInstancedElementParticleCounts[facts.InstanceIndex];
+            }
+            else
+            {
+                auto const searchIt = mInstancedElementParticleCounts.find(facts.InstanceIndex);
+                assert(searchIt != mInstancedElementParticleCounts.end() && searchIt->second > 0);
+                if (--(searchIt->second) == 0)
+                {
+                    mInstancedElementParticleCounts.erase(searchIt);
+                }
+            }
+        }
+    }
+}
 
-                    case ElectricalMaterial::ElectricalElementType::InteractiveSwitch:
-                    {
-                        electricalConnectivityVisitBuffer[coords].flags.isConductive = true;
-                        engineConnectivityVisitBuffer[coords].flags.isConductive = false;
-                        electricalComponents.push_back(coords);
+ModelValidator::ParticleFacts ModelValidator::MakeParticleFacts(
+    StructuralElement const & structuralElement,
+    ElectricalElement const * electricalElement)
+{
+    ParticleFacts facts;
 
-                        hasElectricals = true;
-                        break;
-                    }
+    if (structuralElement.Material != nullptr)
+    {
+        facts.Flags |= ParticleFlags::HasStructure;
+    }
 
-                    case ElectricalMaterial::ElectricalElementType::Lamp:
-                    {
-                        electricalConnectivityVisitBuffer[coords].flags.isConductive = electricalMaterial->ConductsElectricity;
-                        engineConnectivityVisitBuffer[coords].flags.isConductive = false;
+    if (electricalElement != nullptr && electricalElement->Material != nullptr)
+    {
+        auto const & electricalMaterial = *(electricalElement->Material);
 
-                        if (!electricalMaterial->IsSelfPowered)
-                        {
-                            electricalComponents.push_back(coords);
-                            electricalConsumers.push_back(coords);
-                        }
+        facts.Flags |= ParticleFlags::HasElectrical;
 
-                        hasElectricals = true;
-                        break;
-                    }
+        if (electricalMaterial.Luminiscence != 0.0f)
+        {
+            facts.Flags |= ParticleFlags::IsLightEmitting;
+        }
 
-                    case ElectricalMaterial::ElectricalElementType::OtherSink:
-                    {
-                        electricalConnectivityVisitBuffer[coords].flags.isConductive = electricalMaterial->ConductsElectricity;
-                        engineConnectivityVisitBuffer[coords].flags.isConductive = false;
-                        electricalComponents.push_back(coords);
-                        electricalConsumers.push_back(coords);
+        if (electricalMaterial.IsInstanced)
+        {
+            assert(electricalElement->InstanceIndex != NoneElectricalElementInstanceIndex);
+            facts.InstanceIndex = electricalElement->InstanceIndex;
+        }
 
-                        hasElectricals = true;
-                        break;
-                    }
+        std::uint8_t const conductsElectricity = electricalMaterial.ConductsElectricity ? ConnectivityFlags::IsElectricallyConductive : 0;
 
-                    case ElectricalMaterial::ElectricalElementType::PowerMonitor:
-                    {
-                        electricalConnectivityVisitBuffer[coords].flags.isConductive = electricalMaterial->ConductsElectricity;
-                        engineConnectivityVisitBuffer[coords].flags.isConductive = false;
-                        electricalComponents.push_back(coords);
-                        electricalConsumers.push_back(coords);
+        switch (electricalMaterial.ElectricalType)
+        {
+            case ElectricalMaterial::ElectricalElementType::Cable:
+            {
+                facts.Connectivity = conductsElectricity | ConnectivityFlags::IsElectricalComponent;
+                facts.Flags |= ParticleFlags::IsElectricalSystem;
+                break;
+            }
 
-                        hasElectricals = true;
-                        break;
-                    }
+            case ElectricalMaterial::ElectricalElementType::Engine:
+            {
+                facts.Connectivity =
+                    ConnectivityFlags::IsElectricallyConductive // Engines may be electrically conductive when they're working
+                    | ConnectivityFlags::IsEngineConductive
+                    | ConnectivityFlags::IsEngineComponent
+                    | ConnectivityFlags::IsEngineConsumer;
+                facts.Flags |= ParticleFlags::IsEngineSystem;
+                break;
+            }
 
-                    case ElectricalMaterial::ElectricalElementType::ShipSound:
-                    {
-                        electricalConnectivityVisitBuffer[coords].flags.isConductive = true; // Acts as a switch
-                        engineConnectivityVisitBuffer[coords].flags.isConductive = false;
-                        electricalComponents.push_back(coords);
-                        electricalConsumers.push_back(coords);
+            case ElectricalMaterial::ElectricalElementType::EngineController:
+            {
+                facts.Connectivity =
+                    conductsElectricity
+                    | ConnectivityFlags::IsEngineConductive
+                    | ConnectivityFlags::IsElectricalComponent
+                    | ConnectivityFlags::IsElectricalConsumer // Controllers need electricity
+                    | ConnectivityFlags::IsEngineSource;
+                facts.Flags |= ParticleFlags::IsElectricalSystem | ParticleFlags::IsEngineSystem;
+                break;
+            }
 
-                        hasElectricals = true;
-                        break;
-                    }
+            case ElectricalMaterial::ElectricalElementType::EngineTransmission:
+            {
+                facts.Connectivity =
+                    conductsElectricity
+                    | ConnectivityFlags::IsEngineConductive
+                    | ConnectivityFlags::IsEngineComponent;
+                facts.Flags |= ParticleFlags::IsEngineSystem;
+                break;
+            }
 
-                    case ElectricalMaterial::ElectricalElementType::SmokeEmitter:
-                    {
-                        electricalConnectivityVisitBuffer[coords].flags.isConductive = electricalMaterial->ConductsElectricity;
-                        engineConnectivityVisitBuffer[coords].flags.isConductive = false;
-                        electricalComponents.push_back(coords);
-                        electricalConsumers.push_back(coords);
+            case ElectricalMaterial::ElectricalElementType::Generator:
+            {
+                facts.Connectivity = conductsElectricity | ConnectivityFlags::IsElectricalSource;
+                facts.Flags |= ParticleFlags::IsElectricalSystem;
+                break;
+            }
 
-                        hasElectricals = true;
-                        break;
-                    }
+            case ElectricalMaterial::ElectricalElementType::InteractiveSwitch:
+            case ElectricalMaterial::ElectricalElementType::WaterSensingSwitch:
+            {
+                facts.Connectivity =
+                    ConnectivityFlags::IsElectricallyConductive // Acts as a switch
+                    | ConnectivityFlags::IsElectricalComponent;
+                facts.Flags |= ParticleFlags::IsElectricalSystem;
+                break;
+            }
 
-                    case ElectricalMaterial::ElectricalElementType::WaterPump:
-                    {
-                        electricalConnectivityVisitBuffer[coords].flags.isConductive = electricalMaterial->ConductsElectricity;
-                        engineConnectivityVisitBuffer[coords].flags.isConductive = false;
-                        electricalComponents.push_back(coords);
-                        electricalConsumers.push_back(coords);
+            case ElectricalMaterial::ElectricalElementType::Lamp:
+            {
+                facts.Connectivity = conductsElectricity;
+                if (!electricalMaterial.IsSelfPowered)
+                {
+                    facts.Connectivity |= ConnectivityFlags::IsElectricalComponent | ConnectivityFlags::IsElectricalConsumer;
+                }
 
-                        hasElectricals = true;
-                        break;
-                    }
+                facts.Flags |= ParticleFlags::IsElectricalSystem;
+                break;
+            }
 
-                    case ElectricalMaterial::ElectricalElementType::WaterSensingSwitch:
-                    {
-                        electricalConnectivityVisitBuffer[coords].flags.isConductive = true; // Acts as a switch
-                        engineConnectivityVisitBuffer[coords].flags.isConductive = false;
-                        electricalComponents.push_back(coords);
+            case ElectricalMaterial::ElectricalElementType::ShipSound:
+            {
+                facts.Connectivity =
+                    ConnectivityFlags::IsElectricallyConductive // Acts as a switch
+                    | ConnectivityFlags::IsElectricalComponent
+                    | ConnectivityFlags::IsElectricalConsumer;
+                facts.Flags |= ParticleFlags::IsElectricalSystem;
+                break;
+            }
 
-                        hasElectricals = true;
-                        break;
-                    }
+            case ElectricalMaterial::ElectricalElementType::OtherSink:
+            case ElectricalMaterial::ElectricalElementType::PowerMonitor:
+            case ElectricalMaterial::ElectricalElementType::SmokeEmitter:
+            case ElectricalMaterial::ElectricalElementType::WaterPump:
+            case ElectricalMaterial::ElectricalElementType::WatertightDoor:
+            {
+                facts.Connectivity =
+                    conductsElectricity
+                    | ConnectivityFlags::IsElectricalComponent
+                    | ConnectivityFlags::IsElectricalConsumer;
+                facts.Flags |= ParticleFlags::IsElectricalSystem;
+                break;
+            }
+        }
+    }
 
-                    case ElectricalMaterial::ElectricalElementType::WatertightDoor:
-                    {
-                        electricalConnectivityVisitBuffer[coords].flags.isConductive = electricalMaterial->ConductsElectricity;
-                        engineConnectivityVisitBuffer[coords].flags.isConductive = false;
-                        electricalComponents.push_back(coords);
-                        electricalConsumers.push_back(coords);
+    return facts;
+}
 
-                        hasElectricals = true;
-                        break;
-                    }
-                }
-            }
+void ModelValidator::ValidateElectricalConnectivity()
+{
+    assert(mParticleFacts);
+    assert(mElectricalConnectivityIssues.empty());
+
+    bool const hasElectricals = mTotals.ElectricalSystemParticlesCount > 0;
+    bool const hasEngines = mTotals.EngineSystemParticlesCount > 0;
+
+    if (!hasElectricals && !hasEngines)
+    {
+        return;
+    }
+
+    //
+    // Pass 1: create collections of categories
+    //
+
+    std::vector<ShipSpaceCoordinates> electricalSources;
+    std::vector<ShipSpaceCoordinates> electricalComponents; // Anything that needs to be connected to a source; includes all consumers
+    std::vector<ShipSpaceCoordinates> electricalConsumers;
+    std::vector<ShipSpaceCoordinates> engineSources;
+    std::vector<ShipSpaceCoordinates> engineComponents; // Anything that needs to be connected to a source; incldues all consumers
+    std::vector<ShipSpaceCoordinates> engineConsumers;
+
+    for (int y = 0; y < mParticleFacts->Size.height; ++y)
+    {
+        for (int x = 0; x < mParticleFacts->Size.width; ++x)
+        {
+            ShipSpaceCoordinates const coords{ x, y };
+
+            std::uint8_t const connectivity = (*mParticleFacts)[coords].Connectivity;
+
+            if (connectivity & ConnectivityFlags::IsElectricalSource)
+                electricalSources.push_back(coords);
+            if (connectivity & ConnectivityFlags::IsElectricalComponent)
+                electricalComponents.push_back(coords);
+            if (connectivity & ConnectivityFlags::IsElectricalConsumer)
+                electricalConsumers.push_back(coords);
+            if (connectivity & ConnectivityFlags::IsEngineSource)
+                engineSources.push_back(coords);
+            if (connectivity & ConnectivityFlags::IsEngineComponent)
+                engineComponents.push_back(coords);
+            if (connectivity & ConnectivityFlags::IsEngineConsumer)
+                engineConsumers.push_back(coords);
         }
     }
 
@@ -337,6 +453,8 @@ void ModelValidator::ValidateElectricalConnectivity(
     // Pass 2: do checks
     //
 
+    Buffer2D<bool, ShipSpaceTag> visitBuffer(mParticleFacts->Size);
+
     if (hasElectricals)
     {
         // Electrical components not connected to sources
@@ -344,21 +462,25 @@ void ModelValidator::ValidateElectricalConnectivity(
             size_t unpoweredElectricalComponentCount = CountElectricallyUnconnected(
                 electricalSources,
                 electricalComponents,
-                electricalConnectivityVisitBuffer);
+                *mParticleFacts,
+                ConnectivityFlags::IsElectricallyConductive,
+                visitBuffer);
 
-            issues.emplace_back(
+            mElectricalConnectivityIssues.emplace_back(
                 ModelValidationIssue::CheckClassType::UnpoweredElectricalComponent,
                 (unpoweredElectricalComponentCount > 0) ? ModelValidationIssue::SeverityType::Warning : ModelValidationIssue::SeverityType::Success);
         }
 
-        // Electrical sources not connected to any consumers 
+        // Electrical sources not connected to any consumers
         {
             size_t unconsumedElectricalSourceCount = CountElectricallyUnconnected(
                 electricalConsumers,
                 electricalSources,
-                electricalConnectivityVisitBuffer);
+                *mParticleFacts,
+                ConnectivityFlags::IsElectricallyConductive,
+                visitBuffer);
 
-            issues.emplace_back(
+            mElectricalConnectivityIssues.emplace_back(
                 ModelValidationIssue::CheckClassType::UnconsumedElectricalSource,
                 (unconsumedElectricalSourceCount > 0) ? ModelValidationIssue::SeverityType::Warning : ModelValidationIssue::SeverityType::Success);
         }
@@ -371,21 +493,25 @@ void ModelValidator::ValidateElectricalConnectivity(
             size_t unpoweredEngineComponentCount = CountElectricallyUnconnected(
                 engineSources,
                 engineComponents,
-                engineConnectivityVisitBuffer);
+                *mParticleFacts,
+                ConnectivityFlags::IsEngineConductive,
+                visitBuffer);
 
-            issues.emplace_back(
+            mElectricalConnectivityIssues.emplace_back(
                 ModelValidationIssue::CheckClassType::UnpoweredEngineComponent,
                 (unpoweredEngineComponentCount > 0) ? ModelValidationIssue::SeverityType::Warning : ModelValidationIssue::SeverityType::Success);
         }
 
-        // Engine sources not connected to any consumers 
+        // Engine sources not connected to any consumers
         {
             size_t unconsumedEngineSourceCount = CountElectricallyUnconnected(
                 engineConsumers,
                 engineSources,
-                engineConnectivityVisitBuffer);
+                *mParticleFacts,
+                ConnectivityFlags::IsEngineConductive,
+                visitBuffer);
 
-            issues.emplace_back(
+            mElectricalConnectivityIssues.emplace_back(
                 ModelValidationIssue::CheckClassType::UnconsumedEngineSource,
                 (unconsumedEngineSourceCount > 0) ? ModelValidationIssue::SeverityType::Warning : ModelValidationIssue::SeverityType::Success);
         }
@@ -395,30 +521,31 @@ void ModelValidator::ValidateElectricalConnectivity(
 size_t ModelValidator::CountElectricallyUnconnected(
     std::vector<ShipSpaceCoordinates> const & propagationSources,
     std::vector<ShipSpaceCoordinates> const & propagationTargets,
-    Buffer2D<CVElement, ShipSpaceTag> & connectivityVisitBuffer)
+    Buffer2D<ParticleFacts, ShipSpaceTag> const & particleFacts,
+    std::uint8_t conductivityFlag,
+    Buffer2D<bool, ShipSpaceTag> & visitBuffer)
 {
+    assert(visitBuffer.Size == particleFacts.Size);
+
     // Clear visit
-    for (int y = 0; y < connectivityVisitBuffer.Size.height; ++y)
-    {
-        for (int x = 0; x < connectivityVisitBuffer.Size.width; ++x)
-        {
-            connectivityVisitBuffer[{x, y}].flags.isVisited = false;
-        }
-    }
+    std::fill(
+        visitBuffer.Data.get(),
+        visitBuffer.Data.get() + visitBuffer.Size.GetLinearSize(),
+        false);
 
     // Do visit
     std::queue<ShipSpaceCoordinates> coordsToVisit;
     for (auto const & sourceCoords : propagationSources)
     {
         // Make sure we haven't visited it already
-        if (!connectivityVisitBuffer[sourceCoords].flags.isVisited)
+        if (!visitBuffer[sourceCoords])
         {
             //
             // Flood graph
             //
 
             // Mark starting point as visited
-            connectivityVisitBuffer[sourceCoords].flags.isVisited = true;
+            visitBuffer[sourceCoords] = true;
 
             // Add source to queue
             assert(coordsToVisit.empty());
@@ -431,7 +558,7 @@ size_t ModelValidator::CountElectricallyUnconnected(
                 coordsToVisit.pop();
 
                 // Already marked as visited
-                assert(connectivityVisitBuffer[coords].flags.isVisited == true);
+                assert(visitBuffer[coords] == true);
 
                 // Visit neighbors
                 for (int yn = coords.y - 1; yn <= coords.y + 1; ++yn)
@@ -439,12 +566,12 @@ size_t ModelValidator::CountElectricallyUnconnected(
                     for (int xn = coords.x - 1; xn <= coords.x + 1; ++xn)
                     {
                         ShipSpaceCoordinates const neighborCoordinates{ xn, yn };
-                        if (neighborCoordinates.IsInSize(connectivityVisitBuffer.Size)
-                            && connectivityVisitBuffer[neighborCoordinates].flags.isConductive
-                            && !connectivityVisitBuffer[neighborCoordinates].flags.isVisited)
+                        if (neighborCoordinates.IsInSize(visitBuffer.Size)
+                            && (particleFacts[neighborCoordinates].Connectivity & conductivityFlag) != 0
+                            && !visitBuffer[neighborCoordinates])
                         {
                             // Mark it as visited
-                            connectivityVisitBuffer[neighborCoordinates].flags.isVisited = true;
+                            visitBuffer[neighborCoordinates] = true;
 
                             // Add to queue
                             coordsToVisit.push(neighborCoordinates);
@@ -459,7 +586,7 @@ size_t ModelValidator::CountElectricallyUnconnected(
     size_t unconnectedComponentsCount = 0;
     for (auto const & targetCoords : propagationTargets)
     {
-        if (!connectivityVisitBuffer[targetCoords].flags.isVisited)
+        if (!visitBuffer[targetCoords])
         {
             ++unconnectedComponentsCount;
         }
@@ -468,4 +595,4 @@ size_t ModelValidator::CountElectricallyUnconnected(
     return unconnectedComponentsCount;
 }
 
-}
\ No newline at end of file
+}
@@ -11,40 +11,145 @@
 #include <GameCore/Buffer2D.h>
 #include <GameCore/GameTypes.h>
 
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <unordered_map>
 #include <vector>
 
 namespace ShipBuilder {
 
+/*
+ * Validates models incrementally.
+ *
+ * The validator keeps the per-particle facts its checks are made of, together with
+ * their running totals, and at each validation it only re-examines the particles in
+ * the regions that have been reported as dirty since the previous validation.
+ *
+ * Electrical connectivity is a property of the whole electrical network, hence it is
+ * re-calculated - out of the per-particle facts - only when the electrical layer has
+ * been touched.
+ */
 class ModelValidator final
 {
 public:
 
-	static ModelValidationResults ValidateModel(Model const & model);
+    // Validates the whole model from scratch
+    static ModelValidationResults ValidateModel(Model const & model);
+
+public:
+
+    ModelValidator();
+
+    /*
+     * Makes the next validation start from scratch.
+     */
+    void Reset();
+
+    void RegisterDirtyStructuralLayerRegion(ShipSpaceRect const & region)
+    {
+        RegisterDirtyRegion(region);
+    }
+
+    void RegisterDirtyElectricalLayerRegion(ShipSpaceRect const & region)
+    {
+        RegisterDirtyRegion(region);
+        mIsElectricalConnectivityDirty = true;
+    }
+
+    ModelValidationResults Validate(Model const & model);
 
 private:
 
-    struct ConnectivityFlags
+    enum ParticleFlags : std::uint8_t
     {
-        unsigned isConductive : 1;
-        unsigned isVisited : 1;
+        HasStructure = 1 << 0,
+        HasElectrical = 1 << 1,
+        IsLightEmitting = 1 << 2,
+        IsElectricalSystem = 1 << 3,
+        IsEngineSystem = 1 << 4
     };
 
-    union CVElement
+    enum ConnectivityFlags : std::uint8_t
     {
-        std::uint8_t wholeElement;
-        ConnectivityFlags flags;
+        IsElectricallyConductive = 1 << 0,
+        IsEngineConductive = 1 << 1,
+        IsElectricalSource = 1 << 2,
+        IsElectricalComponent = 1 << 3, // Anything that needs to be connected to a source; includes all consumers
+        IsElectricalConsumer = 1 << 4,
+        IsEngineSource = 1 << 5,
+        IsEngineComponent = 1 << 6, // Anything that needs to be connected to a source; includes all consumers
+        IsEngineConsumer = 1 << 7
+    };
+
+    struct ParticleFacts
+    {
+        std::uint8_t Flags; // ParticleFlags
+        std::uint8_t Connectivity; // ConnectivityFlags
+        ElectricalElementInstanceIndex InstanceIndex; // None when not instanced
+
+        ParticleFacts()
+            : Flags(0)
+            , Connectivity(0)
+            , InstanceIndex(NoneElectricalElementInstanceIndex)
+        {}
+    };
+
+    struct Totals
+    {
+        size_t StructuralParticlesCount;
+        size_t ElectricalParticlesWithNoStructuralSubstratumCount;
+        size_t LightEmittingParticlesCount;
+        size_t ElectricalSystemParticlesCount;
+        size_t EngineSystemParticlesCount;
+
+        Totals()
+            : StructuralParticlesCount(0)
+            , ElectricalParticlesWithNoStructuralSubstratumCount(0)
+            , LightEmittingParticlesCount(0)
+            , ElectricalSystemParticlesCount(0)
+            , EngineSystemParticlesCount(0)
+        {}
     };
 
 private:
 
-	static void ValidateElectricalConnectivity(
-		ElectricalLayerData const & electricalLayer,
-		std::vector<ModelValidationIssue> & issues);
+    void RegisterDirtyRegion(ShipSpaceRect const & region);
+
+    void UpdateParticleFacts(
+        Model const & model,
+        ShipSpaceRect const & region);
+
+    void AccountParticleFacts(
+        ParticleFacts const & facts,
+        bool isAdding);
+
+    static ParticleFacts MakeParticleFacts(
+        StructuralElement const & structuralElement,
+        ElectricalElement const * electricalElement);
+
+    void ValidateElectricalConnectivity();
 
     static size_t CountElectricallyUnconnected(
         std::vector<ShipSpaceCoordinates> const & propagationSources,
         std::vector<ShipSpaceCoordinates> const & propagationTargets,
-        Buffer2D<CVElement, ShipSpaceTag> & connectivityVisitBuffer);
+        Buffer2D<ParticleFacts, ShipSpaceTag> const & particleFacts,
+        std::uint8_t conductivityFlag,
+        Buffer2D<bool, ShipSpaceTag> & visitBuffer);
+
+private:
+
+    std::unique_ptr<Buffer2D<ParticleFacts, ShipSpaceTag>> mParticleFacts; // Also works as indicator of validation history
+    bool mHasElectricalLayer;
+
+    Totals mTotals;
+    std::unordered_map<ElectricalElementInstanceIndex, size_t> mInstancedElementParticleCounts;
+
+    std::vector<ModelValidationIssue> mElectricalConnectivityIssues;
+
+    // Dirtiness since last validation
+    std::optional<ShipSpaceRect> mDirtyRegion;
+    bool mIsElectricalConnectivityDirty;
 };
 
-}
\ No newline at end of file
+}
@@ -73,6 +73,12 @@ std::string ProgramTypeToStr(ProgramType program)
     throw GameException("Unsupported ProgramType");
 }
 
+bool IsLazilyCompiledProgram(ProgramType /*program*/)
+{
+    // All of our programs are used as soon as the canvas is drawn
+    return false;
+}
+
 ProgramParameterType StrToProgramParameterType(std::string const & str)
 {
     if (str == "CanvasBackgroundColor")
@@ -37,6 +37,9 @@ ProgramType ShaderFilenameToProgramType(std::string const & str);
 
 std::string ProgramTypeToStr(ProgramType program);
 
+// Rarely-used programs, which are only compiled the first time they are used
+bool IsLazilyCompiledProgram(ProgramType program);
+
 enum class ProgramParameterType : uint8_t
 {
     CanvasBackgroundColor = 0,
@@ -100,6 +103,7 @@ struct ShaderManagerTraits
 
     static constexpr auto ShaderFilenameToProgramType = ShipBuilder::ShaderFilenameToProgramType;
     static constexpr auto ProgramTypeToStr = ShipBuilder::ProgramTypeToStr;
+    static constexpr auto IsLazilyCompiledProgram = ShipBuilder::IsLazilyCompiledProgram;
     static constexpr auto StrToProgramParameterType = ShipBuilder::StrToProgramParameterType;
     static constexpr auto ProgramParameterTypeToStr = ShipBuilder::ProgramParameterTypeToStr;
     static constexpr auto StrToVertexAttributeType = ShipBuilder::StrToVertexAttributeType;
@@ -21,7 +21,7 @@ TextureEraserTool::TextureEraserTool(
     : Tool(
         ToolType::TextureEraser,
         controller)
-    , mOriginalLayerClone(mController.GetModelController().CloneExistingLayer<LayerType::Texture>())
+    , mOriginalLayerSnapshot(mController.GetModelController().GetTextureLayer().Buffer)
     , mTempVisualizationDirtyTextureRegion()
     , mEngagementData()
     , mIsShiftDown(false)
@@ -242,7 +242,8 @@ void TextureEraserTool::DoEdit(ImageCoordinates const & mouseCoordinates)
             if (applicableRect)
             {
                 mController.GetModelController().TextureRegionErase(*applicableRect);
-                
+                mOriginalLayerSnapshot.MarkDirty(*applicableRect);
+
                 // Update edit region
                 if (!mEngagementData->EditRegion)
                 {
@@ -274,16 +275,17 @@ void TextureEraserTool::EndEngagement()
         // Create undo action
         //
 
-        auto clippedLayerClone = mOriginalLayerClone.Clone(*mEngagementData->EditRegion);
-        auto const clipByteSize = clippedLayerClone.Buffer.GetByteSize();
+        // Only keeps the tiles we've touched, and moves the snapshot forward
+        auto originalTiles = mOriginalLayerSnapshot.Update(mController.GetModelController().GetTextureLayer().Buffer);
+        auto const tilesByteSize = originalTiles.GetByteSize();
 
         mController.StoreUndoAction(
             _("Eraser Texture"),
-            clipByteSize,
+            tilesByteSize,
             mEngagementData->OriginalDirtyState,
-            [clippedLayerClone = std::move(clippedLayerClone), origin = mEngagementData->EditRegion->origin](Controller & controller) mutable
+            [originalTiles = std::move(originalTiles)](Controller & controller) mutable
             {
-                controller.RestoreTextureLayerRegionForUndo(std::move(clippedLayerClone), origin);
+                controller.RestoreTextureLayerTilesForUndo(std::move(originalTiles));
             });
     }
 
@@ -298,9 +300,6 @@ void TextureEraserTool::EndEngagement()
     //
 
     assert(!mTempVisualizationDirtyTextureRegion);
-
-    // Re-take original layer clone
-    mOriginalLayerClone = mController.GetModelController().CloneExistingLayer<LayerType::Texture>();
 }
 
 void TextureEraserTool::DoTempVisualization(ImageRect const & affectedRect)
@@ -319,9 +318,8 @@ void TextureEraserTool::MendTempVisualization()
     assert(mTempVisualizationDirtyTextureRegion);
 
     mController.GetModelController().RestoreTextureLayerRegionForEphemeralVisualization(
-        mOriginalLayerClone,
-        *mTempVisualizationDirtyTextureRegion,
-        mTempVisualizationDirtyTextureRegion->origin);
+        mOriginalLayerSnapshot,
+        *mTempVisualizationDirtyTextureRegion);
 
     mController.GetView().RemoveRectOverlay();
 
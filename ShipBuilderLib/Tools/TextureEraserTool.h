@@ -55,8 +55,8 @@ private:
 
 private:
 
-    // Original layer
-    TextureLayerData mOriginalLayerClone;
+    // Original layer, following the edits we make at the end of each engagement
+    TextureLayerSnapshot mOriginalLayerSnapshot;
 
     // Texture region dirtied so far with temporary visualization
     std::optional<ImageRect> mTempVisualizationDirtyTextureRegion;
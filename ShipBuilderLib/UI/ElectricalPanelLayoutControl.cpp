@@ -210,7 +210,8 @@ void ElectricalPanelLayoutControl::OnLeftMouseUp(wxMouseEvent & /*event*/)
             mSessionData->ElectricalPanel.at(mCurrentlyMovableElement->InstanceIndex).PanelCoordinates = *mCurrentDropCandidateSlotCoordinates;
             mLayoutSlotsByLayoutCoordinates.at(*mCurrentDropCandidateSlotCoordinates).OccupyingInstanceIndex = mCurrentlyMovableElement->InstanceIndex;
 
-            RecalculateLayout();
+            // No need to re-layout: only these two slots have changed, and since all
+            // slots are within the current extent, so is the new layout
 
             // Remember we're dirty
             mSessionData->IsDirty = true;
@@ -628,16 +629,14 @@ std::optional<IntegralCoordinates> ElectricalPanelLayoutControl::GetSlotCoordina
 
 IntegralCoordinates const & ElectricalPanelLayoutControl::GetLayoutCoordinatesOf(ElectricalElementInstanceIndex instanceIndex) const
 {
-    auto const srchIt = std::find_if(
-        mLayoutSlotsByLayoutCoordinates.cbegin(),
-        mLayoutSlotsByLayoutCoordinates.cend(),
-        [instanceIndex](auto const & entry) -> bool
-        {
-            return entry.second.OccupyingInstanceIndex == instanceIndex;
-        });
-
-    assert(srchIt != mLayoutSlotsByLayoutCoordinates.cend());
-    return srchIt->first;
+    // The panel has the coordinates of all laid-out elements
+    assert(mSessionData->ElectricalPanel.count(instanceIndex) == 1);
+    auto const & panelCoordinates = mSessionData->ElectricalPanel.at(instanceIndex).PanelCoordinates;
+
+    assert(panelCoordinates.has_value());
+    assert(mLayoutSlotsByLayoutCoordinates.count(*panelCoordinates) == 1);
+    assert(mLayoutSlotsByLayoutCoordinates.at(*panelCoordinates).OccupyingInstanceIndex == instanceIndex);
+    return *panelCoordinates;
 }
 
 }
\ No newline at end of file
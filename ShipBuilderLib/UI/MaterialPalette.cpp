@@ -6,6 +6,7 @@
 #include "MaterialPalette.h"
 
 #include <GameCore/Log.h>
+#include <GameCore/Version.h>
 
 #include <UILib/WxHelpers.h>
 
@@ -14,8 +15,11 @@
 #include <wx/wupdlock.h>
 
 #include <cassert>
+#include <cstdint>
 #include <iomanip>
 #include <sstream>
+#include <string>
+#include <tuple>
 
 namespace ShipBuilder {
 
@@ -25,6 +29,42 @@ wxDEFINE_EVENT(fsEVT_ELECTRICAL_MATERIAL_SELECTED, fsElectricalMaterialSelectedE
 int constexpr MinCategoryPanelsContainerHeight = 400; // Min height of the scrollable panel that contains the swaths; without a min height, a palette that only has a few categories would be too short
 ImageSize constexpr CategoryButtonSize(80, 60);
 ImageSize constexpr PaletteButtonSize(80, 60);
+float constexpr ThumbnailMaterialTextureMagnification = 0.5f;
+
+namespace /* anonymous */ {
+
+    /*
+     * Hashes everything a thumbnail is made of; textures are only identified by their name,
+     * hence the version of the game - with which they're shipped - is part of the hash, too.
+     */
+    ShipPreviewThumbnailStore::ContentHash CalculateThumbnailHash(
+        StructuralMaterial const & material,
+        ImageSize const & size)
+    {
+        // FNV-1a
+        std::uint64_t hash = 14695981039346656037ull;
+        auto const addBytes = [&hash](void const * bytes, size_t size)
+        {
+            for (size_t b = 0; b < size; ++b)
+            {
+                hash ^= static_cast<std::uint64_t>(static_cast<unsigned char const *>(bytes)[b]);
+                hash *= 1099511628211ull;
+            }
+        };
+
+        std::string const version = "MaterialThumbnail " APPLICATION_VERSION_LONG_STR;
+        addBytes(version.data(), version.size());
+        addBytes(material.Name.data(), material.Name.size());
+        addBytes(&material.RenderColor, sizeof(material.RenderColor));
+        std::string const textureName = material.MaterialTextureName.value_or(std::string());
+        addBytes(textureName.data(), textureName.size());
+        addBytes(&size.width, sizeof(size.width));
+        addBytes(&size.height, sizeof(size.height));
+        addBytes(&ThumbnailMaterialTextureMagnification, sizeof(ThumbnailMaterialTextureMagnification));
+
+        return hash;
+    }
+}
 
 template<LayerType TLayer>
 MaterialPalette<TLayer>::MaterialPalette(
@@ -37,6 +77,11 @@ MaterialPalette<TLayer>::MaterialPalette(
     , mMaterialPalette(materialPalette)
     , mCurrentMaterialInPropertyGrid(nullptr)
     , mCurrentPlane()
+    , mThumbnailTexturizer(shipTexturizer)
+    , mThumbnailStore(ShipPreviewThumbnailStore::GetShared(resourceLocator.GetMaterialThumbnailStoreFilePath()))
+    , mHasCategoryButtonThumbnails(false)
+    , mHasCategoryPanelThumbnails(materialPalette.Categories.size(), false)
+    , mThumbnailThread(std::make_unique<TaskThread>())
 {
     SetBackgroundColour(wxColour("WHITE"));
 
@@ -78,7 +123,7 @@ MaterialPalette<TLayer>::MaterialPalette(
 
                 // Create category button
                 {
-                    wxToggleButton * categoryButton = CreateMaterialButton(mCategoryListPanel, CategoryButtonSize, categoryHeadMaterial, shipTexturizer);
+                    wxToggleButton * categoryButton = CreateMaterialButton(mCategoryListPanel, CategoryButtonSize, categoryHeadMaterial);
 
                     categoryButton->Bind(
                         wxEVT_LEFT_DOWN,
@@ -183,8 +228,7 @@ MaterialPalette<TLayer>::MaterialPalette(
 
                 wxPanel * categoryPanel = CreateCategoryPanel(
                     mCategoryPanelsContainer,
-                    category,
-                    shipTexturizer);
+                    category);
 
                 mCategoryPanelsContainerSizer->Add(
                     categoryPanel,
@@ -265,6 +309,13 @@ void MaterialPalette<TLayer>::Open(
     // Clear material properties
     PopulateMaterialProperties(nullptr);
 
+    // The category list is all visible
+    if (!mHasCategoryButtonThumbnails)
+    {
+        EnsureThumbnails(mCategoryButtons, CategoryButtonSize);
+        mHasCategoryButtonThumbnails = true;
+    }
+
     // Select material - showing its category panel
     SetMaterialSelected(initialMaterial);
 
@@ -320,8 +371,7 @@ private:
 template<LayerType TLayer>
 wxPanel * MaterialPalette<TLayer>::CreateCategoryPanel(
     wxWindow * parent,
-    typename MaterialDatabase::Palette<TMaterial>::Category const & materialCategory,
-    ShipTexturizer const & shipTexturizer)
+    typename MaterialDatabase::Palette<TMaterial>::Category const & materialCategory)
 {
     // Make sure we have room for this category in the list of material buttons
     mMaterialButtons.resize(mMaterialButtons.size() + 1);
@@ -376,7 +426,7 @@ wxPanel * MaterialPalette<TLayer>::CreateCategoryPanel(
 
                 // Button
                 {
-                    wxToggleButton * materialButton = CreateMaterialButton(categoryPanel, PaletteButtonSize, *material, shipTexturizer);
+                    wxToggleButton * materialButton = CreateMaterialButton(categoryPanel, PaletteButtonSize, *material);
 
                     // Bind mouse click
                     materialButton->Bind(
@@ -415,7 +465,6 @@ wxPanel * MaterialPalette<TLayer>::CreateCategoryPanel(
                         0);
 
                     // Remember button
-                    materialButton->SetClientData(const_cast<void *>(reinterpret_cast<void const *>(material)));
                     mMaterialButtons.back().push_back(materialButton);
                 }
 
@@ -475,22 +524,17 @@ template<LayerType TLayer>
 wxToggleButton * MaterialPalette<TLayer>::CreateMaterialButton(
     wxWindow * parent,
     ImageSize const & size,
-    TMaterial const & material,
-    ShipTexturizer const & shipTexturizer)
+    TMaterial const & material)
 {
     wxToggleButton * categoryButton = new wxToggleButton(parent, wxID_ANY, wxEmptyString, wxDefaultPosition, wxDefaultSize, wxBU_EXACTFIT);
 
     if constexpr (TMaterial::MaterialLayer == MaterialLayerType::Structural)
     {
-        ShipAutoTexturizationSettings texturizationSettings;
-        texturizationSettings.MaterialTextureMagnification = 0.5f;
-
+        // Placeholder, until the thumbnail is made
         categoryButton->SetBitmap(
-            WxHelpers::MakeBitmap(
-                shipTexturizer.MakeTextureSample(
-                    texturizationSettings,
-                    size,
-                    material)));
+            WxHelpers::MakeMatteBitmap(
+                rgbaColor(material.RenderColor.toRgbColor(), 255),
+                size));
     }
     else
     {
@@ -502,9 +546,78 @@ wxToggleButton * MaterialPalette<TLayer>::CreateMaterialButton(
                 size));
     }
 
+    // Remember material
+    categoryButton->SetClientData(const_cast<void *>(reinterpret_cast<void const *>(&material)));
+
     return categoryButton;
 }
 
+template<LayerType TLayer>
+void MaterialPalette<TLayer>::EnsureThumbnails(
+    std::vector<wxToggleButton *> const & materialButtons,
+    ImageSize const & size)
+{
+    if constexpr (TMaterial::MaterialLayer == MaterialLayerType::Structural)
+    {
+        //
+        // Use the thumbnails we already have, and queue the others
+        //
+
+        std::vector<std::tuple<wxToggleButton *, TMaterial const *, ShipPreviewThumbnailStore::ContentHash>> thumbnailsToMake;
+
+        for (wxToggleButton * button : materialButtons)
+        {
+            TMaterial const * const material = reinterpret_cast<TMaterial const *>(button->GetClientData());
+            if (material == nullptr)
+            {
+                // Not a material button (e.g. "Clear")
+                continue;
+            }
+
+            auto const thumbnailHash = CalculateThumbnailHash(*material, size);
+            if (auto const thumbnail = mThumbnailStore->TryGet(thumbnailHash); thumbnail.has_value())
+            {
+                button->SetBitmap(WxHelpers::MakeBitmap(*thumbnail));
+            }
+            else
+            {
+                thumbnailsToMake.emplace_back(button, material, thumbnailHash);
+            }
+        }
+
+        if (!thumbnailsToMake.empty())
+        {
+            mThumbnailThread->QueueTask(
+                [this, thumbnailsToMake = std::move(thumbnailsToMake), size]()
+                {
+                    ShipAutoTexturizationSettings texturizationSettings;
+                    texturizationSettings.MaterialTextureMagnification = ThumbnailMaterialTextureMagnification;
+
+                    for (auto const & [button, material, thumbnailHash] : thumbnailsToMake)
+                    {
+                        auto thumbnail = std::make_shared<RgbaImageData>(
+                            mThumbnailTexturizer.MakeTextureSample(
+                                texturizationSettings,
+                                size,
+                                *material));
+
+                        mThumbnailStore->Put(thumbnailHash, *thumbnail);
+
+                        // Bitmaps may only be made on the main thread; the call is dropped
+                        // if we're gone in the meantime
+                        CallAfter(
+                            [button = button, thumbnail]()
+                            {
+                                button->SetBitmap(WxHelpers::MakeBitmap(*thumbnail));
+                            });
+                    }
+
+                    mThumbnailStore->Flush();
+                });
+        }
+    }
+}
+
 namespace /* anonymous */ {
 
 class MaterialPropertyGrid : public wxPropertyGrid
@@ -966,6 +1079,12 @@ void MaterialPalette<TLayer>::SetMaterialSelected(TMaterial const * material)
             // Make it visible
             mCategoryPanelsContainerSizer->Show(selectedCategoryPanel, true);
 
+            if (!mHasCategoryPanelThumbnails[i])
+            {
+                EnsureThumbnails(mMaterialButtons[i], PaletteButtonSize);
+                mHasCategoryPanelThumbnails[i] = true;
+            }
+
             // Deselect all the material buttons of this panel, except
             // for the selected material's
             for (auto * button : mMaterialButtons[iCategorySelected])
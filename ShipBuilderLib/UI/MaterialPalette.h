@@ -11,10 +11,12 @@
 #include <Game/Materials.h>
 #include <Game/MaterialDatabase.h>
 #include <Game/ResourceLocator.h>
+#include <Game/ShipPreviewThumbnailStore.h>
 #include <Game/ShipTexturizer.h>
 
 #include <GameCore/GameTypes.h>
 #include <GameCore/ProgressCallback.h>
+#include <GameCore/TaskThread.h>
 
 #include <wx/wx.h>
 #include <wx/popupwin.h>
@@ -24,6 +26,7 @@
 #include <wx/tglbtn.h>
 
 #include <array>
+#include <memory>
 #include <optional>
 #include <vector>
 
@@ -127,14 +130,16 @@ private:
 
     wxPanel * CreateCategoryPanel(
         wxWindow * parent,
-        typename MaterialDatabase::Palette<TMaterial>::Category const & materialCategory,
-        ShipTexturizer const & shipTexturizer);
+        typename MaterialDatabase::Palette<TMaterial>::Category const & materialCategory);
 
     wxToggleButton * CreateMaterialButton(
         wxWindow * parent,
         ImageSize const & size,
-        TMaterial const & material,
-        ShipTexturizer const & shipTexturizer);
+        TMaterial const & material);
+
+    void EnsureThumbnails(
+        std::vector<wxToggleButton *> const & materialButtons,
+        ImageSize const & size);
 
     std::array<wxPropertyGrid *, 2> CreateStructuralMaterialPropertyGrids(wxWindow * parent);
 
@@ -191,6 +196,22 @@ private:
     //
 
     std::optional<MaterialPlaneType> mCurrentPlane;
+
+    //
+    // Thumbnails
+    //
+    // Texture samples are costly to make, hence material buttons start with a flat
+    // placeholder, and get their sample only once they're about to be seen; samples
+    // are made on a background thread, and kept in a store that survives across launches
+    //
+
+    ShipTexturizer const mThumbnailTexturizer; // Our own copy, as it's used on the thumbnail thread
+    std::shared_ptr<ShipPreviewThumbnailStore> mThumbnailStore;
+    bool mHasCategoryButtonThumbnails;
+    std::vector<bool> mHasCategoryPanelThumbnails; // One for each category
+
+    // Last, so that it's joined before anything it uses goes away
+    std::unique_ptr<TaskThread> mThumbnailThread;
 };
 
 }
\ No newline at end of file
@@ -15,6 +15,7 @@
 #include <wx/statline.h>
 
 #include <cassert>
+#include <chrono>
 #include <sstream>
 
 namespace ShipBuilder {
@@ -262,8 +263,26 @@ WaterlineAnalyzerDialog::WaterlineAnalyzerDialog(
 void WaterlineAnalyzerDialog::OnRefreshTimer(wxTimerEvent & /*event*/)
 {
     assert(mCurrentState == StateType::Playing);
+    assert(mWaterlineAnalyzer);
+
+    // Run as many steps as fit in a fraction of a tick; steps are cheap enough
+    // that most ships converge within the first tick
+    auto const endTime = std::chrono::steady_clock::now() + std::chrono::milliseconds(15);
+
+    bool isCompleted;
+    do
+    {
+        isCompleted = mWaterlineAnalyzer->Update();
+    } while (!isCompleted && std::chrono::steady_clock::now() < endTime);
+
+    // Check if we need to change state
+    if (isCompleted)
+    {
+        // We're done
+        mCurrentState = StateType::Completed;
+    }
 
-    DoStep();
+    ReconcileUIWithState();
 }
 
 void WaterlineAnalyzerDialog::OnClose(wxCloseEvent & event)
@@ -54,6 +54,7 @@ View::View(
     , mHasWaterline(false)
     //////////////////////////////////
     , mMipMappedTextureAtlasOpenGLHandle()
+    , mTextureUploadPBO()
     , mMipMappedTextureAtlasMetadata()
     //////////////////////////////////
     , mPrimaryVisualization(primaryVisualization)
@@ -88,7 +89,9 @@ View::View(
     // Load shader manager
     //
 
-    mShaderManager = ShaderManager<ShaderManagerTraits>::CreateInstance(resourceLocator.GetShipBuilderShadersRootPath());
+    mShaderManager = ShaderManager<ShaderManagerTraits>::CreateInstance(
+        resourceLocator.GetShipBuilderShadersRootPath(),
+        resourceLocator.GetShaderProgramBinaryCacheFolderPath("ShipBuilder"));
 
     // Set texture samplers in programs
     mShaderManager->ActivateProgram<ProgramType::MipMappedTextureQuad>();
@@ -100,6 +103,17 @@ View::View(
     mShaderManager->ActivateProgram<ProgramType::TextureNdc>();
     mShaderManager->SetTextureParameters<ProgramType::TextureNdc>();
 
+    //
+    // Create texture upload buffer
+    //
+
+    if (GameOpenGL::SupportsPixelBufferObjects)
+    {
+        GLuint tmpGLuint;
+        glGenBuffers(1, &tmpGLuint);
+        mTextureUploadPBO = tmpGLuint;
+    }
+
     //
     // Create mipmapped texture atlas
     //
@@ -747,17 +761,13 @@ void View::UpdateGameVisualization(
 {
     assert(mHasGameVisualization);
 
-    // Bind texture
-    glBindTexture(GL_TEXTURE_2D, *mGameVisualizationTexture);
-    CheckOpenGLError();
-
     // Upload texture region
     GameOpenGL::UploadTextureRegion(
-        subTexture.Data.get(),
-        origin.x,
-        origin.y,
-        subTexture.Size.width,
-        subTexture.Size.height);
+        *mGameVisualizationTexture,
+        subTexture,
+        ImageRect(subTexture.Size),
+        origin,
+        *mTextureUploadPBO);
 }
 
 void View::RemoveGameVisualization()
@@ -818,22 +828,18 @@ void View::UploadStructuralLayerVisualization(RgbaImageData const & texture)
 }
 
 void View::UpdateStructuralLayerVisualization(
-    RgbaImageData const & subTexture,
-    ImageCoordinates const & origin)
+    RgbaImageData const & texture,
+    ImageRect const & region)
 {
     assert(mHasStructuralLayerVisualization);
 
-    // Bind texture
-    glBindTexture(GL_TEXTURE_2D, *mStructuralLayerVisualizationTexture);
-    CheckOpenGLError();
-
     // Upload texture region
     GameOpenGL::UploadTextureRegion(
-        subTexture.Data.get(),
-        origin.x,
-        origin.y,
-        subTexture.Size.width,
-        subTexture.Size.height);
+        *mStructuralLayerVisualizationTexture,
+        texture,
+        region,
+        region.origin,
+        *mTextureUploadPBO);
 }
 
 void View::RemoveStructuralLayerVisualization()
@@ -875,6 +881,21 @@ void View::UploadElectricalLayerVisualization(RgbaImageData const & texture)
     mHasElectricalLayerVisualization = true;
 }
 
+void View::UpdateElectricalLayerVisualization(
+    RgbaImageData const & texture,
+    ImageRect const & region)
+{
+    assert(mHasElectricalLayerVisualization);
+
+    // Upload texture region
+    GameOpenGL::UploadTextureRegion(
+        *mElectricalLayerVisualizationTexture,
+        texture,
+        region,
+        region.origin,
+        *mTextureUploadPBO);
+}
+
 void View::RemoveElectricalLayerVisualization()
 {
     mHasElectricalLayerVisualization = false;
@@ -979,22 +1000,18 @@ void View::UploadTextureLayerVisualization(RgbaImageData const & texture)
 }
 
 void View::UpdateTextureLayerVisualization(
-    RgbaImageData const & subTexture,
-    ImageCoordinates const & origin)
+    RgbaImageData const & texture,
+    ImageRect const & region)
 {
     assert(mHasTextureLayerVisualization);
 
-    // Bind texture
-    glBindTexture(GL_TEXTURE_2D, *mTextureLayerVisualizationTexture);
-    CheckOpenGLError();
-
     // Upload texture region
     GameOpenGL::UploadTextureRegion(
-        subTexture.Data.get(),
-        origin.x,
-        origin.y,
-        subTexture.Size.width,
-        subTexture.Size.height);
+        *mTextureLayerVisualizationTexture,
+        texture,
+        region,
+        region.origin,
+        *mTextureUploadPBO);
 }
 
 void View::RemoveTextureLayerVisualization()
@@ -1554,10 +1571,16 @@ void View::OnViewModelUpdated()
         UpdateSelectionOverlay();
     }
 
-    //
-    // Ortho matrix
-    //
+    UpdateOrthoMatrix();
+}
 
+void View::OnViewModelCameraUpdated()
+{
+    UpdateOrthoMatrix();
+}
+
+void View::UpdateOrthoMatrix()
+{
     auto const orthoMatrix = mViewModel.GetOrthoMatrix();
 
     mShaderManager->ActivateProgram<ProgramType::Canvas>();
@@ -85,7 +85,7 @@ public:
     {
         auto const newPos = mViewModel.SetCameraShipSpacePosition(pos);
 
-        OnViewModelUpdated();
+        OnViewModelCameraUpdated();
 
         return newPos;
     }
@@ -164,6 +164,7 @@ public:
 
     void UploadGameVisualization(RgbaImageData const & texture);
 
+    // Uploads a portion of the visualization, located at origin
     void UpdateGameVisualization(
         RgbaImageData const & subTexture,
         ImageCoordinates const & origin);
@@ -189,9 +190,10 @@ public:
 
     void UploadStructuralLayerVisualization(RgbaImageData const & texture);
 
+    // Uploads the specified region of the whole visualization
     void UpdateStructuralLayerVisualization(
-        RgbaImageData const & subTexture,
-        ImageCoordinates const & origin);
+        RgbaImageData const & texture,
+        ImageRect const & region);
 
     void RemoveStructuralLayerVisualization();
 
@@ -206,6 +208,11 @@ public:
 
     void UploadElectricalLayerVisualization(RgbaImageData const & texture);
 
+    // Uploads the specified region of the whole visualization
+    void UpdateElectricalLayerVisualization(
+        RgbaImageData const & texture,
+        ImageRect const & region);
+
     void RemoveElectricalLayerVisualization();
 
     bool HasElectricalLayerVisualization() const
@@ -232,9 +239,10 @@ public:
 
     void UploadTextureLayerVisualization(RgbaImageData const & texture);
 
+    // Uploads the specified region of the whole visualization
     void UpdateTextureLayerVisualization(
-        RgbaImageData const & subTexture,
-        ImageCoordinates const & origin);
+        RgbaImageData const & texture,
+        ImageRect const & region);
 
     void RemoveTextureLayerVisualization();
 
@@ -314,6 +322,12 @@ private:
 
     void OnViewModelUpdated();
 
+    // Panning only moves the camera, and everything else is in ship space - or
+    // depends on the zoom alone - hence only the ortho matrix needs to change
+    void OnViewModelCameraUpdated();
+
+    void UpdateOrthoMatrix();
+
     void UpdateStructuralLayerVisualizationParameters();
 
     void UpdateBackgroundTexture(ImageSize const & textureSize);
@@ -594,6 +608,9 @@ private:
     //
 
     GameOpenGLTexture mMipMappedTextureAtlasOpenGLHandle;
+
+    // Staging buffer for texture region uploads; only when supported
+    GameOpenGLVBO mTextureUploadPBO;
     std::unique_ptr<Render::TextureAtlasMetadata<MipMappedTextureGroups>> mMipMappedTextureAtlasMetadata;
 
     //
@@ -7,7 +7,9 @@
 
 #include <GameCore/GameMath.h>
 
+#include <algorithm>
 #include <cassert>
+#include <cmath>
 #include <limits>
 
 namespace ShipBuilder {
@@ -18,7 +20,44 @@ vec2f constexpr Vertical2f = vec2f(0.0f, -1.0f); // Vertical down
 WaterlineAnalyzer::WaterlineAnalyzer(IModelObservable const & model)
     : mModel(model)
     , mModelMacroProperties(mModel.GetModelMacroProperties())
+    , mBuoyantForcePrefixSums()
+    , mBuoyantForceXMomentPrefixSums()
 {
+    //
+    // Integrate structure
+    //
+
+    auto const & structuralLayerBuffer = mModel.GetStructuralLayer().Buffer;
+    size_t const stride = static_cast<size_t>(structuralLayerBuffer.Size.width) + 1;
+
+    mBuoyantForcePrefixSums.resize(stride * structuralLayerBuffer.Size.height);
+    mBuoyantForceXMomentPrefixSums.resize(stride * structuralLayerBuffer.Size.height);
+
+    for (int y = 0; y < structuralLayerBuffer.Size.height; ++y)
+    {
+        size_t const rowStart = y * stride;
+
+        float buoyantForceSum = 0.0f;
+        float buoyantForceXMomentSum = 0.0f;
+
+        mBuoyantForcePrefixSums[rowStart] = 0.0f;
+        mBuoyantForceXMomentPrefixSums[rowStart] = 0.0f;
+
+        for (int x = 0; x < structuralLayerBuffer.Size.width; ++x)
+        {
+            auto const * material = structuralLayerBuffer[ShipSpaceCoordinates(x, y)].Material;
+            if (material != nullptr)
+            {
+                // Note: here we do the same as the simulator currently does wrt "buoyancy volume fill"
+                float const buoyantForce = WaterDensity * material->BuoyancyVolumeFill;
+                buoyantForceSum += buoyantForce;
+                buoyantForceXMomentSum += static_cast<float>(x) * buoyantForce;
+            }
+
+            mBuoyantForcePrefixSums[rowStart + x + 1] = buoyantForceSum;
+            mBuoyantForceXMomentPrefixSums[rowStart + x + 1] = buoyantForceXMomentSum;
+        }
+    }
 }
 
 bool WaterlineAnalyzer::Update()
@@ -288,30 +327,74 @@ std::tuple<float, vec2f> WaterlineAnalyzer::CalculateBuoyancyWithWaterline(
     float totalBuoyantForce = 0.0f;
     vec2f centerOfBuoyancySum = vec2f::zero();
 
-    auto const & structuralLayerBuffer = mModel.GetStructuralLayer().Buffer;
-    for (int y = 0; y < structuralLayerBuffer.Size.height; ++y)
+    int const width = mModel.GetShipSize().width;
+    int const height = mModel.GetShipSize().height;
+    size_t const stride = static_cast<size_t>(width) + 1;
+
+    for (int y = 0; y < height; ++y)
     {
-        for (int x = 0; x < structuralLayerBuffer.Size.width; ++x)
+        // A particle is on the "underwater" side of the center, along the direction, when
+        // the alignment of its bottom-left corner with the direction is non-negative; on
+        // each row, these particles make up a single range of columns
+
+        float const yAlignment = (static_cast<float>(y) - waterlineCenter.y) * waterlineDirection.y;
+
+        auto const isUnderwater = [&](int x)
         {
-            auto const coords = ShipSpaceCoordinates(x, y);
-            auto const * material = structuralLayerBuffer[coords].Material;
-            if (material != nullptr)
+            return (static_cast<float>(x) - waterlineCenter.x) * waterlineDirection.x + yAlignment >= 0.0f;
+        };
+
+        int xStart; // Included
+        int xEnd; // Excluded
+        if (waterlineDirection.x != 0.0f)
+        {
+            // Where alignment crosses zero, clamped so that it's safe to make it an int
+            float const xCrossing = Clamp(
+                waterlineCenter.x - yAlignment / waterlineDirection.x,
+                -1.0f,
+                static_cast<float>(width) + 1.0f);
+
+            if (waterlineDirection.x > 0.0f)
             {
-                // Check alignment with direction
-                //
-                // Note: here we take a particle's bottom-left corner as the point for which
-                // we check its direction
-                auto const coordsF = coords.ToFloat();
-                float const alignment = (coordsF - waterlineCenter).dot(waterlineDirection);
-                if (alignment >= 0.0f)
-                {
-                    // This point is on the "underwater" side of the center, along the direction
-
-                    // Note: here we do the same as the simulator currently does wrt "buoyancy volume fill"
-                    totalBuoyantForce += WaterDensity * material->BuoyancyVolumeFill;
-                    centerOfBuoyancySum += coordsF * WaterDensity * material->BuoyancyVolumeFill;
-                }
+                // Underwater on the right of the crossing
+                xStart = std::clamp(static_cast<int>(std::ceil(xCrossing)), 0, width);
+                xEnd = width;
+
+                // Settle rounding errors of the crossing
+                while (xStart > 0 && isUnderwater(xStart - 1))
+                    --xStart;
+                while (xStart < width && !isUnderwater(xStart))
+                    ++xStart;
             }
+            else
+            {
+                // Underwater on the left of the crossing
+                xStart = 0;
+                xEnd = std::clamp(static_cast<int>(std::floor(xCrossing)) + 1, 0, width);
+
+                // Settle rounding errors of the crossing
+                while (xEnd < width && isUnderwater(xEnd))
+                    ++xEnd;
+                while (xEnd > 0 && !isUnderwater(xEnd - 1))
+                    --xEnd;
+            }
+        }
+        else
+        {
+            // Either the whole row or nothing
+            xStart = 0;
+            xEnd = (yAlignment >= 0.0f) ? width : 0;
+        }
+
+        if (xStart < xEnd)
+        {
+            size_t const rowStart = y * stride;
+
+            float const rowBuoyantForce = mBuoyantForcePrefixSums[rowStart + xEnd] - mBuoyantForcePrefixSums[rowStart + xStart];
+            float const rowBuoyantForceXMoment = mBuoyantForceXMomentPrefixSums[rowStart + xEnd] - mBuoyantForceXMomentPrefixSums[rowStart + xStart];
+
+            totalBuoyantForce += rowBuoyantForce;
+            centerOfBuoyancySum += vec2f(rowBuoyantForceXMoment, static_cast<float>(y) * rowBuoyantForce);
         }
     }
 
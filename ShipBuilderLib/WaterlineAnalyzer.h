@@ -10,6 +10,7 @@
 #include <GameCore/Vectors.h>
 
 #include <optional>
+#include <vector>
 
 namespace ShipBuilder {
 
@@ -93,6 +94,15 @@ private:
     IModelObservable const & mModel;
     ModelMacroProperties const mModelMacroProperties;
 
+    //
+    // Integrals of the structure, for evaluating buoyancy in O(height):
+    // for each row, prefix sums over the row's columns of buoyant force
+    // and of its moment along x; width + 1 entries per row
+    //
+
+    std::vector<float> mBuoyantForcePrefixSums;
+    std::vector<float> mBuoyantForceXMomentPrefixSums;
+
     //
     // Search state
     //
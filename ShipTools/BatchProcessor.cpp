@@ -0,0 +1,402 @@
+/***************************************************************************************
+ * Original Author:		Gabriele Giuseppini
+ * Created:				2026-10-14
+ * Copyright:			Gabriele Giuseppini  (https://github.com/GabrieleGiuseppini)
+ ***************************************************************************************/
+#include "BatchProcessor.h"
+
+#include <Game/FishSpeciesDatabase.h>
+#include <Game/GameEventDispatcher.h>
+#include <Game/GameParameters.h>
+#include <Game/MaterialDatabase.h>
+#include <Game/OceanFloorTerrain.h>
+#include <Game/Physics.h>
+#include <Game/ResourceLocator.h>
+#include <Game/ShipDeSerializer.h>
+#include <Game/ShipFactory.h>
+#include <Game/ShipStrengthRandomizer.h>
+#include <Game/ShipTexturizer.h>
+#include <Game/VisibleWorld.h>
+
+#include <GameCore/TaskThreadPool.h>
+#include <GameCore/Utils.h>
+
+#include <picojson.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+
+void BatchProcessor::Process(
+    std::filesystem::path const & gameRootDirectoryPath,
+    std::filesystem::path const & inputDirectoryPath,
+    std::filesystem::path const & summaryFilePath,
+    std::optional<std::filesystem::path> const & resaveDirectoryPath)
+{
+    //
+    // Load everything that is shared among ships
+    //
+
+    ResourceLocator const resourceLocator(gameRootDirectoryPath);
+    MaterialDatabase const materialDatabase = MaterialDatabase::Load(resourceLocator);
+    FishSpeciesDatabase const fishSpeciesDatabase = FishSpeciesDatabase::Load(resourceLocator);
+    OceanFloorTerrain const oceanFloorTerrain = OceanFloorTerrain::LoadFromImage(resourceLocator.GetDefaultOceanFloorTerrainFilePath());
+    ShipStrengthRandomizer const shipStrengthRandomizer;
+    GameParameters const gameParameters;
+
+    VisibleWorld visibleWorld;
+    visibleWorld.Center = vec2f::zero();
+    visibleWorld.Width = 200.0f;
+    visibleWorld.Height = 100.0f;
+    visibleWorld.TopLeft = vec2f(-100.0f, 50.0f);
+    visibleWorld.BottomRight = vec2f(100.0f, -50.0f);
+
+    //
+    // Find ships
+    //
+
+    std::vector<ShipOutcome> outcomes;
+    for (auto const & entry : std::filesystem::recursive_directory_iterator(inputDirectoryPath))
+    {
+        if (entry.is_regular_file()
+            && ShipDeSerializer::IsAnyShipDefinitionFile(entry.path()))
+        {
+            outcomes.emplace_back(std::filesystem::relative(entry.path(), inputDirectoryPath));
+        }
+    }
+
+    // Process them in a stable order
+    std::sort(
+        outcomes.begin(),
+        outcomes.end(),
+        [](ShipOutcome const & lhs, ShipOutcome const & rhs)
+        {
+            return lhs.RelativeFilePath < rhs.RelativeFilePath;
+        });
+
+    size_t const threadCount = std::max(size_t(1), std::min(outcomes.size(), static_cast<size_t>(std::thread::hardware_concurrency())));
+
+    std::cout << "  Found " << outcomes.size() << " ships, processing them on " << threadCount << " threads..." << std::endl;
+
+    //
+    // Process ships
+    //
+    // Each ship is built into its own world, with its own event dispatcher and task
+    // pool, as none of them may be shared among concurrent builds; texturizers carry
+    // a cache, hence there's one per thread
+    //
+
+    std::atomic<size_t> nextOutcomeIndex(0);
+    std::mutex consoleMutex;
+
+    auto const processShips = [&]()
+    {
+        ShipTexturizer const shipTexturizer(materialDatabase, resourceLocator);
+
+        for (size_t o = nextOutcomeIndex++; o < outcomes.size(); o = nextOutcomeIndex++)
+        {
+            ShipOutcome & outcome = outcomes[o];
+
+            try
+            {
+                // Load
+                auto const loadStartTime = std::chrono::steady_clock::now();
+                ShipDefinition shipDefinition = ShipDeSerializer::LoadShip(inputDirectoryPath / outcome.RelativeFilePath, materialDatabase);
+                outcome.LoadMs = std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - loadStartTime).count();
+
+                outcome.Size = shipDefinition.Size;
+
+                // Analyze
+                outcome.Analysis = ShipAnalyzer::Analyze(shipDefinition.Layers.StructuralLayer);
+
+                // Validate
+                outcome.Issues = Validate(shipDefinition);
+
+                // Re-save
+                if (resaveDirectoryPath.has_value())
+                {
+                    std::filesystem::path resaveFilePath = *resaveDirectoryPath / outcome.RelativeFilePath;
+                    resaveFilePath.replace_extension(ShipDeSerializer::GetShipDefinitionFileExtension());
+                    std::filesystem::create_directories(resaveFilePath.parent_path());
+
+                    ShipDeSerializer::SaveShip(shipDefinition, resaveFilePath);
+                }
+
+                // Build
+                auto gameEventDispatcher = std::make_shared<GameEventDispatcher>();
+                auto taskThreadPool = std::make_shared<TaskThreadPool>();
+                Physics::World world(
+                    OceanFloorTerrain(oceanFloorTerrain),
+                    fishSpeciesDatabase,
+                    gameEventDispatcher,
+                    taskThreadPool,
+                    gameParameters,
+                    visibleWorld);
+
+                auto const factoryStartTime = std::chrono::steady_clock::now();
+                auto [ship, textureImage] = ShipFactory::Create(
+                    world.GetNextShipId(),
+                    world,
+                    std::move(shipDefinition),
+                    ShipLoadOptions(),
+                    materialDatabase,
+                    shipTexturizer,
+                    shipStrengthRandomizer,
+                    gameEventDispatcher,
+                    taskThreadPool,
+                    gameParameters);
+                outcome.FactoryMs = std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - factoryStartTime).count();
+
+                outcome.PointCount = ship->GetPointCount();
+
+                outcome.IsSuccess = true;
+            }
+            catch (std::exception const & ex)
+            {
+                outcome.ErrorMessage = ex.what();
+            }
+
+            {
+                std::lock_guard const lock(consoleMutex);
+
+                std::cout << "  " << (outcome.IsSuccess ? "OK   " : "ERROR") << " " << outcome.RelativeFilePath.string();
+                if (!outcome.IsSuccess)
+                    std::cout << ": " << outcome.ErrorMessage;
+                std::cout << std::endl;
+            }
+        }
+    };
+
+    std::vector<std::thread> threads;
+    for (size_t t = 1; t < threadCount; ++t)
+    {
+        threads.emplace_back(processShips);
+    }
+
+    processShips();
+
+    for (auto & thread : threads)
+    {
+        thread.join();
+    }
+
+    //
+    // Write summary
+    //
+
+    if (Utils::CaseInsensitiveEquals(summaryFilePath.extension().string(), ".csv"))
+    {
+        SaveCsvSummary(outcomes, summaryFilePath);
+    }
+    else
+    {
+        SaveJsonSummary(outcomes, summaryFilePath);
+    }
+
+    size_t const failureCount = std::count_if(
+        outcomes.cbegin(),
+        outcomes.cend(),
+        [](ShipOutcome const & outcome)
+        {
+            return !outcome.IsSuccess;
+        });
+
+    std::cout << "  " << (outcomes.size() - failureCount) << " ships succeeded, " << failureCount << " failed." << std::endl;
+}
+
+std::vector<std::string> BatchProcessor::Validate(ShipDefinition const & shipDefinition)
+{
+    std::vector<std::string> issues;
+
+    //
+    // Structure
+    //
+
+    StructuralLayerData const & structuralLayer = shipDefinition.Layers.StructuralLayer;
+
+    size_t structuralParticlesCount = 0;
+
+    for (int y = 0; y < structuralLayer.Buffer.Size.height; ++y)
+    {
+        for (int x = 0; x < structuralLayer.Buffer.Size.width; ++x)
+        {
+            if (structuralLayer.Buffer[{x, y}].Material != nullptr)
+            {
+                ++structuralParticlesCount;
+            }
+        }
+    }
+
+    size_t constexpr MaxStructuralParticles = 100000;
+
+    if (structuralParticlesCount == 0)
+    {
+        issues.emplace_back("Error:EmptyStructuralLayer");
+    }
+    else if (structuralParticlesCount > MaxStructuralParticles)
+    {
+        issues.emplace_back("Warning:StructureTooLarge");
+    }
+
+    //
+    // Electricals
+    //
+
+    if (shipDefinition.Layers.ElectricalLayer)
+    {
+        ElectricalLayerData const & electricalLayer = *shipDefinition.Layers.ElectricalLayer;
+
+        size_t electricalParticlesWithNoStructuralSubstratumCount = 0;
+        size_t lightEmittingParticlesCount = 0;
+        size_t visibleElectricalPanelElementsCount = 0;
+
+        for (int y = 0; y < electricalLayer.Buffer.Size.height; ++y)
+        {
+            for (int x = 0; x < electricalLayer.Buffer.Size.width; ++x)
+            {
+                auto const coords = ShipSpaceCoordinates(x, y);
+                auto const electricalMaterial = electricalLayer.Buffer[coords].Material;
+                if (electricalMaterial != nullptr)
+                {
+                    if (structuralLayer.Buffer[coords].Material == nullptr)
+                    {
+                        ++electricalParticlesWithNoStructuralSubstratumCount;
+                    }
+
+                    if (electricalMaterial->Luminiscence != 0.0f)
+                    {
+                        ++lightEmittingParticlesCount;
+                    }
+
+                    if (electricalMaterial->IsInstanced)
+                    {
+                        if (auto const searchIt = electricalLayer.Panel.find(electricalLayer.Buffer[coords].InstanceIndex);
+                            searchIt == electricalLayer.Panel.end() || !searchIt->second.IsHidden)
+                        {
+                            ++visibleElectricalPanelElementsCount;
+                        }
+                    }
+                }
+            }
+        }
+
+        size_t constexpr MaxLightEmittingParticles = 5000;
+        size_t constexpr MaxVisibleElectricalPanelElements = 22;
+
+        if (electricalParticlesWithNoStructuralSubstratumCount > 0)
+        {
+            issues.emplace_back("Error:MissingElectricalSubstratum");
+        }
+
+        if (lightEmittingParticlesCount > MaxLightEmittingParticles)
+        {
+            issues.emplace_back("Warning:TooManyLights");
+        }
+
+        if (visibleElectricalPanelElementsCount > MaxVisibleElectricalPanelElements)
+        {
+            issues.emplace_back("Warning:TooManyVisibleElectricalPanelElements");
+        }
+    }
+
+    return issues;
+}
+
+void BatchProcessor::SaveCsvSummary(
+    std::vector<ShipOutcome> const & outcomes,
+    std::filesystem::path const & summaryFilePath)
+{
+    std::ofstream file(summaryFilePath, std::ios_base::out | std::ios_base::trunc);
+    if (!file.is_open())
+    {
+        throw std::runtime_error("Cannot open file \"" + summaryFilePath.string() + "\" for writing");
+    }
+
+    auto const quote = [](std::string const & str)
+    {
+        std::string quoted = "\"";
+        for (char const ch : str)
+        {
+            if (ch == '"')
+                quoted += '"';
+            quoted += ch;
+        }
+
+        return quoted + "\"";
+    };
+
+    file << "file,status,error,load_ms,factory_ms,width,height,points,total_mass,center_of_mass_x,center_of_mass_y,equilibrium_momentum,issues" << std::endl;
+
+    for (auto const & outcome : outcomes)
+    {
+        std::string issues;
+        for (auto const & issue : outcome.Issues)
+        {
+            if (!issues.empty())
+                issues += ";";
+            issues += issue;
+        }
+
+        file << quote(outcome.RelativeFilePath.generic_string())
+            << "," << (outcome.IsSuccess ? "ok" : "error")
+            << "," << quote(outcome.ErrorMessage)
+            << "," << outcome.LoadMs
+            << "," << outcome.FactoryMs
+            << "," << outcome.Size.width
+            << "," << outcome.Size.height
+            << "," << outcome.PointCount
+            << "," << outcome.Analysis.TotalMass
+            << "," << outcome.Analysis.CenterOfMass.x
+            << "," << outcome.Analysis.CenterOfMass.y
+            << "," << outcome.Analysis.EquilibriumMomentum
+            << "," << quote(issues)
+            << std::endl;
+    }
+}
+
+void BatchProcessor::SaveJsonSummary(
+    std::vector<ShipOutcome> const & outcomes,
+    std::filesystem::path const & summaryFilePath)
+{
+    picojson::array shipsJson;
+
+    for (auto const & outcome : outcomes)
+    {
+        picojson::object shipJson;
+
+        shipJson["file"] = picojson::value(outcome.RelativeFilePath.generic_string());
+        shipJson["status"] = picojson::value(outcome.IsSuccess ? "ok" : "error");
+        if (!outcome.IsSuccess)
+            shipJson["error"] = picojson::value(outcome.ErrorMessage);
+        shipJson["load_ms"] = picojson::value(static_cast<double>(outcome.LoadMs));
+        shipJson["factory_ms"] = picojson::value(static_cast<double>(outcome.FactoryMs));
+        shipJson["width"] = picojson::value(static_cast<std::int64_t>(outcome.Size.width));
+        shipJson["height"] = picojson::value(static_cast<std::int64_t>(outcome.Size.height));
+        shipJson["points"] = picojson::value(static_cast<std::int64_t>(outcome.PointCount));
+        shipJson["total_mass"] = picojson::value(static_cast<double>(outcome.Analysis.TotalMass));
+        shipJson["center_of_mass_x"] = picojson::value(static_cast<double>(outcome.Analysis.CenterOfMass.x));
+        shipJson["center_of_mass_y"] = picojson::value(static_cast<double>(outcome.Analysis.CenterOfMass.y));
+        shipJson["equilibrium_momentum"] = picojson::value(static_cast<double>(outcome.Analysis.EquilibriumMomentum));
+
+        picojson::array issuesJson;
+        for (auto const & issue : outcome.Issues)
+        {
+            issuesJson.emplace_back(issue);
+        }
+
+        shipJson["issues"] = picojson::value(issuesJson);
+
+        shipsJson.emplace_back(shipJson);
+    }
+
+    picojson::object rootJson;
+    rootJson["ships"] = picojson::value(shipsJson);
+
+    Utils::SaveJSONFile(picojson::value(rootJson), summaryFilePath);
+}
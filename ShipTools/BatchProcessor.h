@@ -0,0 +1,74 @@
+/***************************************************************************************
+ * Original Author:		Gabriele Giuseppini
+ * Created:				2026-10-14
+ * Copyright:			Gabriele Giuseppini  (https://github.com/GabrieleGiuseppini)
+ ***************************************************************************************/
+#pragma once
+
+#include "ShipAnalyzer.h"
+
+#include <Game/ShipDefinition.h>
+
+#include <filesystem>
+#include <optional>
+#include <string>
+#include <vector>
+
+/*
+ * Loads, analyzes, validates, builds - and optionally re-saves - all the ships found in
+ * a directory tree, using all cores, and writes a per-ship summary of the outcomes and
+ * of the timings.
+ *
+ * The summary is a CSV file when its extension is .csv, and a JSON file otherwise.
+ */
+class BatchProcessor
+{
+public:
+
+    static void Process(
+        std::filesystem::path const & gameRootDirectoryPath,
+        std::filesystem::path const & inputDirectoryPath,
+        std::filesystem::path const & summaryFilePath,
+        std::optional<std::filesystem::path> const & resaveDirectoryPath);
+
+private:
+
+    struct ShipOutcome
+    {
+        std::filesystem::path RelativeFilePath;
+
+        bool IsSuccess;
+        std::string ErrorMessage;
+
+        float LoadMs;
+        float FactoryMs;
+
+        ShipSpaceSize Size;
+        size_t PointCount;
+        ShipAnalyzer::AnalysisInfo Analysis;
+        std::vector<std::string> Issues;
+
+        ShipOutcome(std::filesystem::path const & relativeFilePath)
+            : RelativeFilePath(relativeFilePath)
+            , IsSuccess(false)
+            , ErrorMessage()
+            , LoadMs(0.0f)
+            , FactoryMs(0.0f)
+            , Size(0, 0)
+            , PointCount(0)
+            , Analysis()
+            , Issues()
+        {}
+    };
+
+    // Mirrors the checks of the ship builder's model validator, save for electrical connectivity
+    static std::vector<std::string> Validate(ShipDefinition const & shipDefinition);
+
+    static void SaveCsvSummary(
+        std::vector<ShipOutcome> const & outcomes,
+        std::filesystem::path const & summaryFilePath);
+
+    static void SaveJsonSummary(
+        std::vector<ShipOutcome> const & outcomes,
+        std::filesystem::path const & summaryFilePath);
+};
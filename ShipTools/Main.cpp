@@ -5,6 +5,7 @@
  ***************************************************************************************/
 
 #include "Baker.h"
+#include "BatchProcessor.h"
 #include "Quantizer.h"
 #include "Resizer.h"
 #include "ShipAnalyzer.h"
@@ -15,6 +16,7 @@
 #include <IL/ilu.h>
 
 #include <cassert>
+#include <chrono>
 #include <iostream>
 #include <stdexcept>
 #include <string>
@@ -23,6 +25,7 @@
 
 int DoAnalyzeShip(int argc, char ** argv);
 int DoBakeRegularAtlas(int argc, char ** argv);
+int DoBatch(int argc, char ** argv);
 int DoQuantize(int argc, char ** argv);
 int DoResize(int argc, char ** argv);
 
@@ -51,6 +54,10 @@ int main(int argc, char ** argv)
         {
             return DoBakeRegularAtlas(argc, argv);
         }
+        else if (verb == "batch")
+        {
+            return DoBatch(argc, argv);
+        }
         else if (verb == "quantize")
         {
             return DoQuantize(argc, argv);
@@ -147,6 +154,59 @@ int DoBakeRegularAtlas(int argc, char ** argv)
     return 0;
 }
 
+int DoBatch(int argc, char ** argv)
+{
+    if (argc < 5)
+    {
+        PrintUsage();
+        return 0;
+    }
+
+    std::filesystem::path gameRootDirectoryPath(argv[2]);
+    std::filesystem::path inputDirectoryPath(argv[3]);
+    std::filesystem::path summaryFilePath(argv[4]);
+
+    std::optional<std::filesystem::path> resaveDirectoryPath;
+    for (int i = 5; i < argc; ++i)
+    {
+        std::string option(argv[i]);
+        if (option == "-s" || option == "--resave")
+        {
+            ++i;
+            if (i == argc)
+            {
+                throw std::runtime_error("-s option specified without a directory");
+            }
+
+            resaveDirectoryPath = std::filesystem::path(argv[i]);
+        }
+        else
+        {
+            throw std::runtime_error("Unrecognized option '" + option + "'");
+        }
+    }
+
+    std::cout << SEPARATOR << std::endl;
+    std::cout << "Running batch:" << std::endl;
+    std::cout << "  game root directory : " << gameRootDirectoryPath << std::endl;
+    std::cout << "  input directory     : " << inputDirectoryPath << std::endl;
+    std::cout << "  summary file        : " << summaryFilePath << std::endl;
+    if (resaveDirectoryPath.has_value())
+        std::cout << "  resave directory    : " << *resaveDirectoryPath << std::endl;
+
+    auto const startTime = std::chrono::steady_clock::now();
+
+    BatchProcessor::Process(
+        gameRootDirectoryPath,
+        inputDirectoryPath,
+        summaryFilePath,
+        resaveDirectoryPath);
+
+    std::cout << "Batch completed in " << std::chrono::duration_cast<std::chrono::seconds>(std::chrono::steady_clock::now() - startTime).count() << "s." << std::endl;
+
+    return 0;
+}
+
 int DoQuantize(int argc, char ** argv)
 {
     if (argc < 5)
@@ -245,6 +305,7 @@ void PrintUsage()
     std::cout << "Usage:" << std::endl;
     std::cout << " analyze <materials_dir> <in_file>" << std::endl;
     std::cout << " bake_regular_atlas Explosion <database_dir> <out_dir> [-a]" << std::endl;
+    std::cout << " batch <game_root_dir> <in_dir> <out_summary.csv|.json> [-s, --resave <shp2_out_dir>]" << std::endl;
     std::cout << " quantize <materials_dir> <in_file> <out_png> [-c <target_fixed_color>]" << std::endl;
     std::cout << "          -r, --keep_ropes] [-g, --keep_glass]" << std::endl;
     std::cout << " resize <in_file> <out_png> <width>" << std::endl;
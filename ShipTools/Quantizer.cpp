@@ -7,12 +7,17 @@
 
 #include <Game/MaterialDatabase.h>
 
+#include <GameCore/ColorKdTree.h>
+#include <GameCore/TaskThreadPool.h>
 #include <GameCore/Vectors.h>
 
 #include <IL/il.h>
 #include <IL/ilu.h>
 
+#include <atomic>
+#include <cstdint>
 #include <limits>
+#include <memory>
 #include <stdexcept>
 #include <vector>
 
@@ -84,67 +89,99 @@ void Quantizer::Quantize(
 
 
     //
-    // Quantize image
+    // Prepare the nearest-color search: a k-d tree over the game colors, and a
+    // cache of its results for each of the 2^24 possible image colors, filled
+    // lazily - images typically use a tiny fraction of them
     //
 
-    for (int r = 0; r < height; ++r)
+    std::vector<vec3f> gameColorVectors;
+    for (auto const & gameColor : gameColors)
     {
-        size_t index = r * width * 4;
+        gameColorVectors.push_back(gameColor.first);
+    }
 
-        for (int c = 0; c < width; ++c, index += 4)
-        {
-            vec3f imgColor = vec3f(
-                static_cast<float>(imageData[index]) / 255.0f,
-                static_cast<float>(imageData[index + 1]) / 255.0f,
-                static_cast<float>(imageData[index + 2]) / 255.0f);
+    ColorKdTree const gameColorTree(gameColorVectors);
+
+    // Game color index + 1, or zero when not yet calculated; threads racing on the same
+    // entry calculate and store the same value
+    static_assert(sizeof(std::atomic<std::uint16_t>) == sizeof(std::uint16_t));
+    assert(gameColors.size() < std::numeric_limits<std::uint16_t>::max());
+    std::unique_ptr<std::atomic<std::uint16_t>[]> nearestGameColorCache;
+    if (!targetFixedColor)
+    {
+        nearestGameColorCache = std::make_unique<std::atomic<std::uint16_t>[]>(1 << 24);
+    }
+
+    //
+    // Quantize image, in parallel over rows
+    //
 
-            std::optional<rgbColor> bestColor;
+    TaskThreadPool taskThreadPool;
 
-            if (!targetFixedColor)
+    taskThreadPool.ParallelFor(
+        0,
+        static_cast<size_t>(height),
+        1,
+        [&](size_t rowStart, size_t rowEnd)
+        {
+            for (size_t r = rowStart; r < rowEnd; ++r)
             {
-                // Find closest color
-                std::optional<size_t> bestGameColorIndex;
-                float bestColorSquareDistance = std::numeric_limits<float>::max();
-                for (size_t gameColor = 0; gameColor < gameColors.size(); ++gameColor)
+                size_t index = r * width * 4;
+
+                for (int c = 0; c < width; ++c, index += 4)
                 {
-                    float colorSquareDistance = (imgColor - gameColors[gameColor].first).squareLength();
-                    if (colorSquareDistance < bestColorSquareDistance)
+                    std::optional<rgbColor> bestColor;
+
+                    if (!targetFixedColor)
                     {
-                        bestGameColorIndex = gameColor;
-                        bestColorSquareDistance = colorSquareDistance;
+                        // Find closest color
+                        size_t const cacheIndex =
+                            (static_cast<size_t>(imageData[index]) << 16)
+                            | (static_cast<size_t>(imageData[index + 1]) << 8)
+                            | static_cast<size_t>(imageData[index + 2]);
+
+                        std::uint16_t cachedGameColor = nearestGameColorCache[cacheIndex].load(std::memory_order_relaxed);
+                        if (cachedGameColor == 0)
+                        {
+                            vec3f const imgColor = vec3f(
+                                static_cast<float>(imageData[index]) / 255.0f,
+                                static_cast<float>(imageData[index + 1]) / 255.0f,
+                                static_cast<float>(imageData[index + 2]) / 255.0f);
+
+                            cachedGameColor = static_cast<std::uint16_t>(gameColorTree.FindNearest(imgColor) + 1);
+                            nearestGameColorCache[cacheIndex].store(cachedGameColor, std::memory_order_relaxed);
+                        }
+
+                        // Store color
+                        bestColor = gameColors[cachedGameColor - 1].second;
+                    }
+                    else
+                    {
+                        // Assign a color only if not transparent
+                        if (imageData[index + 3] != 0)
+                        {
+                            bestColor = *targetFixedColor;
+                        }
                     }
-                }
 
-                // Store color
-                assert(!!bestGameColorIndex);
-                bestColor = gameColors[*bestGameColorIndex].second;
-            }
-            else
-            {
-                // Assign a color only if not transparent
-                if (imageData[index + 3] != 0)
-                {
-                    bestColor = *targetFixedColor;
+                    if (!!bestColor)
+                    {
+                        imageData[index] = bestColor->r;
+                        imageData[index + 1] = bestColor->g;
+                        imageData[index + 2] = bestColor->b;
+                        imageData[index + 3] = 255;
+                    }
+                    else
+                    {
+                        // Full white
+                        imageData[index] = PureWhite.r;
+                        imageData[index + 1] = PureWhite.g;
+                        imageData[index + 2] = PureWhite.b;
+                        imageData[index + 3] = 255;
+                    }
                 }
             }
-
-            if (!!bestColor)
-            {
-                imageData[index] = bestColor->r;
-                imageData[index + 1] = bestColor->g;
-                imageData[index + 2] = bestColor->b;
-                imageData[index + 3] = 255;
-            }
-            else
-            {
-                // Full white
-                imageData[index] = PureWhite.r;
-                imageData[index + 1] = PureWhite.g;
-                imageData[index + 2] = PureWhite.b;
-                imageData[index + 3] = 255;
-            }
-        }
-    }
+        });
 
 
     //
@@ -25,27 +25,53 @@ ShipAnalyzer::AnalysisInfo ShipAnalyzer::Analyze(
     // Load image
     auto image = ImageFileTools::LoadImageRgb(std::filesystem::path(inputFile));
 
-    float const halfWidth = static_cast<float>(image.Size.width) / 2.0f;
-
     // Load materials
     auto materials = MaterialDatabase::Load(materialsDir);
 
+    return Analyze(
+        image.Size.width,
+        image.Size.height,
+        [&](int x, int y)
+        {
+            auto const pixelIndex = (x + y * image.Size.width);
+            return materials.FindStructuralMaterial(image.Data[pixelIndex]);
+        });
+}
+
+ShipAnalyzer::AnalysisInfo ShipAnalyzer::Analyze(StructuralLayerData const & structuralLayer)
+{
+    return Analyze(
+        structuralLayer.Buffer.Size.width,
+        structuralLayer.Buffer.Size.height,
+        [&](int x, int y)
+        {
+            return structuralLayer.Buffer[ShipSpaceCoordinates(x, y)].Material;
+        });
+}
+
+template<typename TGetMaterial>
+ShipAnalyzer::AnalysisInfo ShipAnalyzer::Analyze(
+    int width,
+    int height,
+    TGetMaterial && getMaterial)
+{
+    float const halfWidth = static_cast<float>(width) / 2.0f;
+
     // Visit all points
     ShipAnalyzer::AnalysisInfo analysisInfo;
     float totalMass = 0.0f;
     float totalDisplacedDensity = 0.0f; // Assuming fully submersed
     float numPoints = 0.0f;
-    for (int x = 0; x < image.Size.width; ++x)
+    for (int x = 0; x < width; ++x)
     {
         float const worldX = static_cast<float>(x) - halfWidth;
 
         // From bottom to top
-        for (int y = 0; y < image.Size.height; ++y)
+        for (int y = 0; y < height; ++y)
         {
             vec2f const worldPosition(worldX, static_cast<float>(y));
 
-            auto const pixelIndex = (x + y * image.Size.width);
-            StructuralMaterial const * const structuralMaterial = materials.FindStructuralMaterial(image.Data[pixelIndex]);
+            StructuralMaterial const * const structuralMaterial = getMaterial(x, y);
             if (nullptr != structuralMaterial)
             {
                 // Update total masses
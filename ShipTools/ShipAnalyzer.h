@@ -3,6 +3,9 @@
  * Created:				2018-06-30
  * Copyright:			Gabriele Giuseppini  (https://github.com/GabrieleGiuseppini)
  ***************************************************************************************/
+#pragma once
+
+#include <Game/Layers.h>
 
 #include <GameCore/Vectors.h>
 
@@ -38,4 +41,14 @@ public:
     static AnalysisInfo Analyze(
         std::string const & inputFile,
         std::string const & materialsDir);
+
+    static AnalysisInfo Analyze(StructuralLayerData const & structuralLayer);
+
+private:
+
+    template<typename TGetMaterial>
+    static AnalysisInfo Analyze(
+        int width,
+        int height,
+        TGetMaterial && getMaterial);
 };
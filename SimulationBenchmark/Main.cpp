@@ -0,0 +1,364 @@
+/***************************************************************************************
+ * Original Author:     Gabriele Giuseppini
+ * Created:             2026-10-14
+ * Copyright:           Gabriele Giuseppini  (https://github.com/GabrieleGiuseppini)
+ ***************************************************************************************/
+
+#include <Game/FishSpeciesDatabase.h>
+#include <Game/GameEventDispatcher.h>
+#include <Game/GameParameters.h>
+#include <Game/MaterialDatabase.h>
+#include <Game/PerfStats.h>
+#include <Game/Physics.h>
+#include <Game/ResourceLocator.h>
+#include <Game/ShipDeSerializer.h>
+#include <Game/ShipFactory.h>
+#include <Game/ShipStrengthRandomizer.h>
+#include <Game/ShipTexturizer.h>
+#include <Game/VisibleWorld.h>
+
+#include <GameCore/GameChronometer.h>
+#include <GameCore/GameRandomEngine.h>
+#include <GameCore/Profiler.h>
+#include <GameCore/TaskThreadPool.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#define SEPARATOR "------------------------------------------------------"
+
+/*
+ * Runs the full simulation of one or more ships for a fixed number of steps,
+ * without any rendering, and reports the time taken by each stage.
+ */
+
+struct BenchmarkOptions
+{
+    size_t StepCount;
+    size_t WarmUpStepCount;
+    bool DoUpdateConcurrently;
+    bool DoAdaptMechanicalDynamicsIterations;
+    std::optional<std::filesystem::path> TraceFilePath;
+
+    BenchmarkOptions()
+        : StepCount(1000)
+        , WarmUpStepCount(60)
+        , DoUpdateConcurrently(false)
+        , DoAdaptMechanicalDynamicsIterations(false)
+        , TraceFilePath()
+    {}
+};
+
+void RunBenchmark(
+    std::filesystem::path const & shipFilePath,
+    BenchmarkOptions const & options,
+    ResourceLocator const & resourceLocator,
+    MaterialDatabase const & materialDatabase,
+    FishSpeciesDatabase const & fishSpeciesDatabase,
+    ShipTexturizer const & shipTexturizer);
+
+void PrintStageTimings(
+    std::vector<Profiler::ZoneSample> const & samples,
+    size_t stepCount);
+
+void PrintUsage();
+
+int main(int argc, char ** argv)
+{
+    BenchmarkOptions options;
+    std::vector<std::filesystem::path> shipFilePaths;
+
+    try
+    {
+        for (int i = 1; i < argc; ++i)
+        {
+            std::string option(argv[i]);
+            if (option == "-n" || option == "-w")
+            {
+                ++i;
+                if (i == argc)
+                {
+                    throw std::runtime_error(option + " option specified without a number of steps");
+                }
+
+                size_t const value = static_cast<size_t>(std::stoul(argv[i]));
+                if (option == "-n")
+                    options.StepCount = value;
+                else
+                    options.WarmUpStepCount = value;
+            }
+            else if (option == "-c" || option == "--concurrent")
+            {
+                options.DoUpdateConcurrently = true;
+            }
+            else if (option == "-a" || option == "--adaptive")
+            {
+                options.DoAdaptMechanicalDynamicsIterations = true;
+            }
+            else if (option == "-t")
+            {
+                ++i;
+                if (i == argc)
+                {
+                    throw std::runtime_error("-t option specified without a file");
+                }
+
+                options.TraceFilePath = std::filesystem::path(argv[i]);
+            }
+            else if (option == "-h" || option == "--help")
+            {
+                PrintUsage();
+                return 0;
+            }
+            else if (!option.empty() && option[0] == '-')
+            {
+                throw std::runtime_error("Unrecognized option '" + option + "'");
+            }
+            else
+            {
+                shipFilePaths.emplace_back(option);
+            }
+        }
+
+        ResourceLocator const resourceLocator = ResourceLocator(std::string(argv[0]));
+
+        if (shipFilePaths.empty())
+        {
+            shipFilePaths.emplace_back(resourceLocator.GetDefaultShipDefinitionFilePath());
+        }
+
+        auto const materialDatabase = MaterialDatabase::Load(resourceLocator);
+        auto const fishSpeciesDatabase = FishSpeciesDatabase::Load(resourceLocator);
+        ShipTexturizer const shipTexturizer(materialDatabase, resourceLocator);
+
+        for (auto const & shipFilePath : shipFilePaths)
+        {
+            RunBenchmark(
+                shipFilePath,
+                options,
+                resourceLocator,
+                materialDatabase,
+                fishSpeciesDatabase,
+                shipTexturizer);
+        }
+    }
+    catch (std::exception & ex)
+    {
+        std::cout << "ERROR: " << ex.what() << std::endl;
+        return -1;
+    }
+
+    return 0;
+}
+
+void RunBenchmark(
+    std::filesystem::path const & shipFilePath,
+    BenchmarkOptions const & options,
+    ResourceLocator const & resourceLocator,
+    MaterialDatabase const & materialDatabase,
+    FishSpeciesDatabase const & fishSpeciesDatabase,
+    ShipTexturizer const & shipTexturizer)
+{
+    std::cout << SEPARATOR << std::endl;
+    std::cout << "Running simulation benchmark:" << std::endl;
+    std::cout << "  ship       : " << shipFilePath << std::endl;
+    std::cout << "  steps      : " << options.StepCount << " (+" << options.WarmUpStepCount << " warm-up)" << std::endl;
+    std::cout << "  concurrent : " << options.DoUpdateConcurrently << std::endl;
+    std::cout << "  adaptive   : " << options.DoAdaptMechanicalDynamicsIterations << std::endl;
+
+    // Make sure each run sees the same random sequence
+    GameRandomEngine::GetInstance().Reset();
+
+    GameParameters gameParameters;
+    gameParameters.DoUpdateShipsConcurrently = options.DoUpdateConcurrently;
+    gameParameters.DoUpdateOceanSurfaceConcurrently = options.DoUpdateConcurrently;
+    gameParameters.DoAdaptMechanicalDynamicsIterations = options.DoAdaptMechanicalDynamicsIterations;
+
+    // A view of the default zoom, centered on the ship
+    VisibleWorld visibleWorld;
+    visibleWorld.Center = vec2f::zero();
+    visibleWorld.Width = 200.0f;
+    visibleWorld.Height = 100.0f;
+    visibleWorld.TopLeft = vec2f(-visibleWorld.Width / 2.0f, visibleWorld.Height / 2.0f);
+    visibleWorld.BottomRight = vec2f(visibleWorld.Width / 2.0f, -visibleWorld.Height / 2.0f);
+
+    auto gameEventDispatcher = std::make_shared<GameEventDispatcher>();
+    auto taskThreadPool = std::make_shared<TaskThreadPool>();
+    ShipStrengthRandomizer const shipStrengthRandomizer;
+
+    //
+    // Create world and ship
+    //
+
+    Physics::World world(
+        OceanFloorTerrain::LoadFromImage(resourceLocator.GetDefaultOceanFloorTerrainFilePath()),
+        fishSpeciesDatabase,
+        gameEventDispatcher,
+        taskThreadPool,
+        gameParameters,
+        visibleWorld);
+
+    auto shipDefinition = ShipDeSerializer::LoadShip(shipFilePath, materialDatabase);
+
+    auto [ship, textureImage] = ShipFactory::Create(
+        world.GetNextShipId(),
+        world,
+        std::move(shipDefinition),
+        ShipLoadOptions(),
+        materialDatabase,
+        shipTexturizer,
+        shipStrengthRandomizer,
+        gameEventDispatcher,
+        taskThreadPool,
+        gameParameters);
+
+    ShipId const shipId = ship->GetId();
+    world.AddShip(std::move(ship));
+
+    std::cout << "  points     : " << world.GetShipPointCount(shipId) << std::endl;
+
+    //
+    // Run
+    //
+
+    PerfStats perfStats;
+
+    auto const runStep = [&]()
+    {
+        world.Update(
+            gameParameters,
+            visibleWorld,
+            StressRenderModeType::None,
+            perfStats);
+
+        gameEventDispatcher->Flush();
+
+        world.UpdateStructureHeadless();
+    };
+
+    for (size_t s = 0; s < options.WarmUpStepCount; ++s)
+    {
+        runStep();
+    }
+
+    perfStats.Reset();
+
+    // The profiler's buffers only retain the most recent zones, hence we
+    // drain them at each step
+    std::vector<Profiler::ZoneSample> samples;
+
+    Profiler::GetInstance().Clear();
+    Profiler::GetInstance().SetEnabled(true);
+
+    GameChronometer::duration elapsed = GameChronometer::duration::zero();
+
+    for (size_t s = 0; s < options.StepCount; ++s)
+    {
+        auto const startTime = GameChronometer::now();
+
+        {
+            FS_PROFILE_SCOPE("Step");
+
+            runStep();
+        }
+
+        elapsed += GameChronometer::now() - startTime;
+
+        auto const stepSamples = Profiler::GetInstance().GetSamples();
+        samples.insert(samples.end(), stepSamples.cbegin(), stepSamples.cend());
+        Profiler::GetInstance().Clear();
+    }
+
+    Profiler::GetInstance().SetEnabled(false);
+
+    //
+    // Report
+    //
+
+    auto const elapsedMs = std::chrono::duration<double, std::milli>(elapsed).count();
+
+    std::cout << std::fixed << std::setprecision(3);
+    std::cout << "  total      : " << elapsedMs << " ms" << std::endl;
+    std::cout << "  per step   : " << (options.StepCount > 0 ? elapsedMs / static_cast<double>(options.StepCount) : 0.0) << " ms" << std::endl;
+
+    std::cout << "  iterations : " << perfStats.TotalShipsMechanicalDynamicsIterations.ToAverage() << " per ship per step" << std::endl;
+    std::cout << "  exhaustions: " << perfStats.TotalShipsEphemeralParticleExhaustions.ToAverage() << " ephemeral particle allocations per ship per step" << std::endl;
+    std::cout << "  LOD skips  : " << perfStats.TotalShipsEphemeralParticleLevelOfDetailSkips.ToAverage() << " ephemeral particles per ship per step" << std::endl;
+    std::cout << "  particles  : "
+        << perfStats.TotalShipsAirBubbleParticles.ToAverage() << " air bubbles, "
+        << perfStats.TotalShipsDebrisParticles.ToAverage() << " debris, "
+        << perfStats.TotalShipsSmokeParticles.ToAverage() << " smoke, "
+        << perfStats.TotalShipsSparkleParticles.ToAverage() << " sparkles, "
+        << perfStats.TotalShipsWakeBubbleParticles.ToAverage() << " wake bubbles per ship" << std::endl;
+
+    PrintStageTimings(samples, options.StepCount);
+
+    if (options.TraceFilePath)
+    {
+        Profiler::GetInstance().ExportChromeTrace(samples, *options.TraceFilePath);
+        std::cout << "  trace saved to " << *options.TraceFilePath << std::endl;
+    }
+}
+
+void PrintStageTimings(
+    std::vector<Profiler::ZoneSample> const & samples,
+    size_t stepCount)
+{
+    struct StageTiming
+    {
+        std::int64_t TotalTicks;
+        size_t Count;
+    };
+
+    // Aggregate all zones by name, across all threads
+    std::map<std::string, StageTiming> stageTimings;
+    for (auto const & sample : samples)
+    {
+        auto & stageTiming = stageTimings[sample.Name];
+        stageTiming.TotalTicks += sample.EndTicks - sample.StartTicks;
+        stageTiming.Count += 1;
+    }
+
+    std::vector<std::pair<std::string, StageTiming>> sortedStageTimings(stageTimings.cbegin(), stageTimings.cend());
+    std::sort(
+        sortedStageTimings.begin(),
+        sortedStageTimings.end(),
+        [](auto const & a, auto const & b)
+        {
+            return a.second.TotalTicks > b.second.TotalTicks;
+        });
+
+    std::cout << std::endl;
+    std::cout << "  " << std::left << std::setw(48) << "Stage" << std::right << std::setw(12) << "Calls" << std::setw(16) << "us/step" << std::endl;
+
+    for (auto const & [name, stageTiming] : sortedStageTimings)
+    {
+        double const microsecondsPerStep = stepCount > 0
+            ? static_cast<double>(stageTiming.TotalTicks) / 1000.0 / static_cast<double>(stepCount)
+            : 0.0;
+
+        std::cout << "  " << std::left << std::setw(48) << name << std::right << std::setw(12) << stageTiming.Count << std::setw(16) << microsecondsPerStep << std::endl;
+    }
+
+    std::cout << std::endl;
+}
+
+void PrintUsage()
+{
+    std::cout << std::endl;
+    std::cout << "Usage:" << std::endl;
+    std::cout << " SimulationBenchmark [<ship_file>...] [-n <steps>] [-w <warm_up_steps>] [-c|--concurrent] [-a|--adaptive] [-t <trace_file.json>]" << std::endl;
+    std::cout << std::endl;
+    std::cout << " Runs the simulation of each ship - the default ship if none is specified - without rendering," << std::endl;
+    std::cout << " and reports the time spent in each stage; the stages are aggregated across all threads." << std::endl;
+}
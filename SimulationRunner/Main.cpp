@@ -0,0 +1,879 @@
+/***************************************************************************************
+ * Original Author:     Gabriele Giuseppini
+ * Created:             2026-10-14
+ * Copyright:           Gabriele Giuseppini  (https://github.com/GabrieleGiuseppini)
+ ***************************************************************************************/
+
+#include "Scenario.h"
+#include "ShipStateValidator.h"
+
+#include <Game/FishSpeciesDatabase.h>
+#include <Game/GameEventDispatcher.h>
+#include <Game/GameParameters.h>
+#include <Game/IGameEventHandlers.h>
+#include <Game/MaterialDatabase.h>
+#include <Game/PerfStats.h>
+#include <Game/Physics.h>
+#include <Game/ResourceLocator.h>
+#include <Game/ShipDeSerializer.h>
+#include <Game/ShipFactory.h>
+#include <Game/ShipStrengthRandomizer.h>
+#include <Game/ShipTexturizer.h>
+#include <Game/VisibleWorld.h>
+
+#include <GameCore/GameChronometer.h>
+#include <GameCore/GameRandomEngine.h>
+#include <GameCore/GameWallClock.h>
+#include <GameCore/TaskThreadPool.h>
+#include <GameCore/Utils.h>
+
+#include <picojson.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+/*
+ * Runs scripted scenarios headlessly - no UI and no rendering - and writes metrics
+ * for each of their runs.
+ *
+ * All the runs of all the scenarios are executed in parallel, each in its own child
+ * process - as the game's random engine and clocks are process-wide singletons - and
+ * their results are collected into one JSON-lines file.
+ *
+ * In validation mode, each run simulates two ships side by side - one with the reference
+ * kernels and one with the optimized kernels - and reports the first stage and element
+ * at which their states diverge.
+ */
+
+struct RunnerOptions
+{
+    size_t ParallelismDegree;
+    std::filesystem::path OutputFilePath;
+    bool DoValidate;
+    float ValidationTolerance;
+
+    RunnerOptions()
+        : ParallelismDegree(std::max(size_t(1), static_cast<size_t>(std::thread::hardware_concurrency())))
+        , OutputFilePath("results.jsonl")
+        , DoValidate(false)
+        , ValidationTolerance(1.0e-4f)
+    {}
+};
+
+/*
+ * The databases shared by the simulations of a run.
+ */
+struct SimulationResources
+{
+    ResourceLocator const & Locator;
+    MaterialDatabase const Materials;
+    FishSpeciesDatabase const FishSpecies;
+    ShipTexturizer const Texturizer;
+
+    explicit SimulationResources(ResourceLocator const & resourceLocator)
+        : Locator(resourceLocator)
+        , Materials(MaterialDatabase::Load(resourceLocator))
+        , FishSpecies(FishSpeciesDatabase::Load(resourceLocator))
+        , Texturizer(Materials, resourceLocator)
+    {}
+};
+
+/*
+ * Collects the metrics of one run from the game events.
+ */
+struct RunMetrics final
+    : public ILifecycleGameEventHandler
+    , public IStructuralGameEventHandler
+    , public IGenericGameEventHandler
+    , public IAtmosphereGameEventHandler
+{
+    float CurrentSimulationTime = 0.0f;
+
+    std::optional<float> SinkingBeginSimulationTime;
+    size_t BreakCount = 0;
+    size_t DestroyCount = 0;
+    float WaterTaken = 0.0f;
+    size_t StormCount = 0;
+    size_t LightningCount = 0;
+
+    void OnSinkingBegin(ShipId /*shipId*/) override
+    {
+        if (!SinkingBeginSimulationTime.has_value())
+        {
+            SinkingBeginSimulationTime = CurrentSimulationTime;
+        }
+    }
+
+    void OnBreak(
+        StructuralMaterial const & /*structuralMaterial*/,
+        bool /*isUnderwater*/,
+        unsigned int size) override
+    {
+        BreakCount += size;
+    }
+
+    void OnDestroy(
+        StructuralMaterial const & /*structuralMaterial*/,
+        bool /*isUnderwater*/,
+        unsigned int size) override
+    {
+        DestroyCount += size;
+    }
+
+    void OnWaterTaken(float waterTaken) override
+    {
+        WaterTaken += waterTaken;
+    }
+
+    void OnStormBegin() override
+    {
+        ++StormCount;
+    }
+
+    void OnLightning() override
+    {
+        ++LightningCount;
+    }
+};
+
+/*
+ * A world with the ship of a run, and the progress of the run's events.
+ */
+struct Simulation
+{
+    std::shared_ptr<GameEventDispatcher> EventDispatcher;
+    std::unique_ptr<Physics::World> World;
+    Physics::Ship * Ship; // Owned by the world
+    ShipId ShipIndex;
+    std::vector<bool> IsEventFired;
+};
+
+int RunScenarios(
+    std::filesystem::path const & executablePath,
+    std::vector<std::filesystem::path> const & scenarioFilePaths,
+    RunnerOptions const & options);
+
+picojson::value RunScenario(
+    Scenario const & scenario,
+    size_t runIndex,
+    ResourceLocator const & resourceLocator);
+
+picojson::value ValidateScenario(
+    Scenario const & scenario,
+    size_t runIndex,
+    ResourceLocator const & resourceLocator,
+    float tolerance);
+
+GameParameters MakeRunGameParameters(Scenario::Run const & run);
+
+VisibleWorld MakeVisibleWorld();
+
+Simulation CreateSimulation(
+    Scenario const & scenario,
+    Scenario::Run const & run,
+    GameParameters const & gameParameters,
+    VisibleWorld const & visibleWorld,
+    SimulationResources const & resources,
+    std::shared_ptr<TaskThreadPool> taskThreadPool);
+
+void StepSimulation(
+    Simulation & simulation,
+    Scenario const & scenario,
+    GameParameters const & gameParameters,
+    VisibleWorld const & visibleWorld,
+    PerfStats & perfStats,
+    RunMetrics * metrics);
+
+picojson::object MakeRunResultObject(
+    Scenario const & scenario,
+    Scenario::Run const & run);
+
+void ApplyToolEvent(
+    Scenario::ToolEvent const & toolEvent,
+    Physics::World & world,
+    GameParameters const & gameParameters);
+
+void PrintUsage();
+
+int main(int argc, char ** argv)
+{
+    RunnerOptions options;
+    std::vector<std::filesystem::path> scenarioFilePaths;
+    std::optional<size_t> childRunIndex;
+
+    try
+    {
+        for (int i = 1; i < argc; ++i)
+        {
+            std::string option(argv[i]);
+            if (option == "-j" || option == "-o" || option == "--run" || option == "--tolerance")
+            {
+                ++i;
+                if (i == argc)
+                {
+                    throw std::runtime_error(option + " option specified without a value");
+                }
+
+                if (option == "-j")
+                    options.ParallelismDegree = std::max(size_t(1), static_cast<size_t>(std::stoul(argv[i])));
+                else if (option == "-o")
+                    options.OutputFilePath = std::filesystem::path(argv[i]);
+                else if (option == "--tolerance")
+                    options.ValidationTolerance = std::stof(argv[i]);
+                else
+                    childRunIndex = static_cast<size_t>(std::stoul(argv[i]));
+            }
+            else if (option == "--validate")
+            {
+                options.DoValidate = true;
+            }
+            else if (option == "-h" || option == "--help")
+            {
+                PrintUsage();
+                return 0;
+            }
+            else if (!option.empty() && option[0] == '-')
+            {
+                throw std::runtime_error("Unrecognized option '" + option + "'");
+            }
+            else
+            {
+                scenarioFilePaths.emplace_back(option);
+            }
+        }
+
+        if (scenarioFilePaths.empty())
+        {
+            PrintUsage();
+            return -1;
+        }
+
+        if (!(options.ValidationTolerance > 0.0f))
+        {
+            throw std::runtime_error("--tolerance must be positive");
+        }
+
+        std::filesystem::path const executablePath = std::filesystem::absolute(argv[0]);
+
+        if (childRunIndex.has_value())
+        {
+            //
+            // Child: run one run of one scenario
+            //
+
+            if (scenarioFilePaths.size() != 1)
+            {
+                throw std::runtime_error("--run requires exactly one scenario");
+            }
+
+            ResourceLocator const resourceLocator(executablePath.string());
+
+            auto const scenario = Scenario::Load(scenarioFilePaths[0]);
+            if (*childRunIndex >= scenario.GetRunCount())
+            {
+                throw std::runtime_error("Run index " + std::to_string(*childRunIndex) + " is out of range");
+            }
+
+            auto const result = options.DoValidate
+                ? ValidateScenario(scenario, *childRunIndex, resourceLocator, options.ValidationTolerance)
+                : RunScenario(scenario, *childRunIndex, resourceLocator);
+
+            Utils::SaveJSONFile(result, options.OutputFilePath);
+        }
+        else
+        {
+            //
+            // Parent: fan out all runs of all scenarios
+            //
+
+            return RunScenarios(executablePath, scenarioFilePaths, options);
+        }
+    }
+    catch (std::exception & ex)
+    {
+        std::cout << "ERROR: " << ex.what() << std::endl;
+        return -1;
+    }
+
+    return 0;
+}
+
+int RunScenarios(
+    std::filesystem::path const & executablePath,
+    std::vector<std::filesystem::path> const & scenarioFilePaths,
+    RunnerOptions const & options)
+{
+    struct Job
+    {
+        std::filesystem::path ScenarioFilePath;
+        size_t RunIndex;
+        std::filesystem::path ResultFilePath;
+        int ExitCode;
+    };
+
+    //
+    // Expand all scenarios into jobs; loading them here also validates them upfront
+    //
+
+    std::vector<Job> jobs;
+    for (auto const & scenarioFilePath : scenarioFilePaths)
+    {
+        auto const scenario = Scenario::Load(scenarioFilePath);
+        for (size_t r = 0; r < scenario.GetRunCount(); ++r)
+        {
+            std::filesystem::path resultFilePath = options.OutputFilePath;
+            resultFilePath += "." + std::to_string(jobs.size()) + ".tmp";
+
+            jobs.push_back(
+                Job{
+                    std::filesystem::absolute(scenarioFilePath),
+                    r,
+                    std::move(resultFilePath),
+                    -1 });
+        }
+    }
+
+    size_t const workerCount = std::min(options.ParallelismDegree, jobs.size());
+
+    std::cout << "Running " << jobs.size() << " run(s) of " << scenarioFilePaths.size() << " scenario(s) on " << workerCount << " process(es)..." << std::endl;
+
+    //
+    // Run jobs
+    //
+
+    std::string validationArguments;
+    if (options.DoValidate)
+    {
+        std::ostringstream ss;
+        ss << " --validate --tolerance " << std::setprecision(9) << options.ValidationTolerance;
+        validationArguments = ss.str();
+    }
+
+    std::atomic<size_t> nextJobIndex{ 0 };
+    std::atomic<size_t> completedJobCount{ 0 };
+    std::mutex outputMutex;
+
+    auto const worker = [&]()
+    {
+        for (size_t j = nextJobIndex++; j < jobs.size(); j = nextJobIndex++)
+        {
+            Job & job = jobs[j];
+
+            std::string command =
+                "\"" + executablePath.string() + "\""
+                + " --run " + std::to_string(job.RunIndex)
+                + " -o \"" + job.ResultFilePath.string() + "\""
+                + validationArguments
+                + " \"" + job.ScenarioFilePath.string() + "\"";
+
+#ifdef _WIN32
+            // cmd strips the outermost quotes
+            command = "\"" + command + "\"";
+#endif
+
+            job.ExitCode = std::system(command.c_str());
+
+            std::lock_guard const lock{ outputMutex };
+
+            std::cout << "  [" << ++completedJobCount << "/" << jobs.size() << "] "
+                << job.ScenarioFilePath.filename().string() << " #" << job.RunIndex
+                << (job.ExitCode == 0 ? "" : " FAILED (exit code " + std::to_string(job.ExitCode) + ")")
+                << std::endl;
+        }
+    };
+
+    std::vector<std::thread> workers;
+    for (size_t w = 0; w < workerCount; ++w)
+    {
+        workers.emplace_back(worker);
+    }
+
+    for (auto & w : workers)
+    {
+        w.join();
+    }
+
+    //
+    // Collect results, in job order
+    //
+
+    std::ofstream outputFile(options.OutputFilePath, std::ios_base::out | std::ios_base::trunc);
+    if (!outputFile.is_open())
+    {
+        throw std::runtime_error("Cannot open output file \"" + options.OutputFilePath.string() + "\"");
+    }
+
+    size_t failedJobCount = 0;
+
+    for (auto const & job : jobs)
+    {
+        picojson::value result;
+
+        if (job.ExitCode == 0 && std::filesystem::exists(job.ResultFilePath))
+        {
+            result = Utils::ParseJSONFile(job.ResultFilePath);
+            std::filesystem::remove(job.ResultFilePath);
+        }
+        else
+        {
+            picojson::object failure;
+            failure["scenario"] = picojson::value(job.ScenarioFilePath.string());
+            failure["run"] = picojson::value(static_cast<std::int64_t>(job.RunIndex));
+            failure["error"] = picojson::value("Run process exited with code " + std::to_string(job.ExitCode));
+            result = picojson::value(failure);
+
+            ++failedJobCount;
+        }
+
+        // One run per line
+        outputFile << result.serialize(false) << std::endl;
+    }
+
+    std::cout << "Results saved to " << options.OutputFilePath;
+    if (failedJobCount > 0)
+    {
+        std::cout << " (" << failedJobCount << " failed run(s))";
+    }
+
+    std::cout << std::endl;
+
+    return failedJobCount == 0 ? 0 : -1;
+}
+
+picojson::value RunScenario(
+    Scenario const & scenario,
+    size_t runIndex,
+    ResourceLocator const & resourceLocator)
+{
+    auto const run = scenario.GetRun(runIndex);
+
+    // Each run sees the same random sequence, hence runs are reproducible
+    GameRandomEngine::GetInstance().Reset();
+
+    GameParameters const gameParameters = MakeRunGameParameters(run);
+
+    SimulationResources const resources(resourceLocator);
+    VisibleWorld const visibleWorld = MakeVisibleWorld();
+    auto taskThreadPool = std::make_shared<TaskThreadPool>();
+
+    auto simulation = CreateSimulation(
+        scenario,
+        run,
+        gameParameters,
+        visibleWorld,
+        resources,
+        taskThreadPool);
+
+    RunMetrics metrics;
+    simulation.EventDispatcher->RegisterLifecycleEventHandler(&metrics);
+    simulation.EventDispatcher->RegisterStructuralEventHandler(&metrics, StructuralGameEventMask::Break);
+    simulation.EventDispatcher->RegisterGenericEventHandler(&metrics);
+    simulation.EventDispatcher->RegisterAtmosphereEventHandler(&metrics);
+
+    size_t const initialPointCount = simulation.World->GetShipPointCount(simulation.ShipIndex);
+
+    //
+    // Run
+    //
+
+    PerfStats perfStats;
+    size_t stepCount = 0;
+
+    auto const startTime = GameChronometer::now();
+
+    while (simulation.World->GetCurrentSimulationTime() < scenario.GetDuration())
+    {
+        StepSimulation(
+            simulation,
+            scenario,
+            gameParameters,
+            visibleWorld,
+            perfStats,
+            &metrics);
+
+        ++stepCount;
+    }
+
+    auto const elapsed = std::chrono::duration<double>(GameChronometer::now() - startTime);
+
+    //
+    // Report
+    //
+
+    picojson::object metricsObject;
+    metricsObject["simulation_time"] = picojson::value(static_cast<double>(simulation.World->GetCurrentSimulationTime()));
+    metricsObject["wall_clock_time"] = picojson::value(elapsed.count());
+    metricsObject["steps"] = picojson::value(static_cast<std::int64_t>(stepCount));
+    metricsObject["points"] = picojson::value(static_cast<std::int64_t>(initialPointCount));
+    metricsObject["sinking_begin_time"] = metrics.SinkingBeginSimulationTime.has_value()
+        ? picojson::value(static_cast<double>(*metrics.SinkingBeginSimulationTime))
+        : picojson::value(); // null: did not sink
+    metricsObject["breaks"] = picojson::value(static_cast<std::int64_t>(metrics.BreakCount));
+    metricsObject["destroys"] = picojson::value(static_cast<std::int64_t>(metrics.DestroyCount));
+    metricsObject["water_taken"] = picojson::value(static_cast<double>(metrics.WaterTaken));
+    metricsObject["storms"] = picojson::value(static_cast<std::int64_t>(metrics.StormCount));
+    metricsObject["lightnings"] = picojson::value(static_cast<std::int64_t>(metrics.LightningCount));
+    metricsObject["mechanical_iterations"] = picojson::value(static_cast<double>(perfStats.TotalShipsMechanicalDynamicsIterations.ToAverage()));
+
+    picojson::object resultObject = MakeRunResultObject(scenario, run);
+    resultObject["metrics"] = picojson::value(metricsObject);
+
+    return picojson::value(resultObject);
+}
+
+picojson::value ValidateScenario(
+    Scenario const & scenario,
+    size_t runIndex,
+    ResourceLocator const & resourceLocator,
+    float tolerance)
+{
+    auto const run = scenario.GetRun(runIndex);
+
+    GameRandomEngine::GetInstance().Reset();
+
+    // Both ships must see the same wall-clock time, even though they are updated one after the other
+    GameWallClock::GetInstance().SetPaused(true);
+
+    //
+    // The reference ship runs the reference kernels, and the candidate ship the optimized ones;
+    // all other parameters are the run's
+    //
+
+    GameParameters referenceGameParameters = MakeRunGameParameters(run);
+    referenceGameParameters.SpringForcesKernel = SpringForcesKernelType::Scalar;
+    referenceGameParameters.DoUpdateWaterAndPressureConcurrently = false;
+    referenceGameParameters.DoCompactDestroyedSprings = false;
+
+    GameParameters candidateGameParameters = MakeRunGameParameters(run);
+    candidateGameParameters.SpringForcesKernel = SpringForcesKernelType::Vectorized;
+    candidateGameParameters.DoUpdateWaterAndPressureConcurrently = true;
+    candidateGameParameters.DoCompactDestroyedSprings = true;
+
+    SimulationResources const resources(resourceLocator);
+    VisibleWorld const visibleWorld = MakeVisibleWorld();
+    auto taskThreadPool = std::make_shared<TaskThreadPool>();
+
+    auto referenceSimulation = CreateSimulation(scenario, run, referenceGameParameters, visibleWorld, resources, taskThreadPool);
+    auto candidateSimulation = CreateSimulation(scenario, run, candidateGameParameters, visibleWorld, resources, taskThreadPool);
+
+    ShipStateValidator validator(ShipStateValidator::Tolerance(tolerance, tolerance));
+    validator.Attach(*referenceSimulation.Ship, *candidateSimulation.Ship);
+
+    //
+    // Run, until the end or the first divergence
+    //
+
+    PerfStats perfStats;
+    size_t stepCount = 0;
+
+    while (referenceSimulation.World->GetCurrentSimulationTime() < scenario.GetDuration()
+        && !validator.GetFirstDivergence().has_value())
+    {
+        validator.BeginStep();
+
+        // Both ships draw from the same random sequence
+        auto const randomState = GameRandomEngine::GetInstance().GetState();
+
+        StepSimulation(referenceSimulation, scenario, referenceGameParameters, visibleWorld, perfStats, nullptr);
+
+        auto const referenceRandomState = GameRandomEngine::GetInstance().GetState();
+        GameRandomEngine::GetInstance().SetState(randomState);
+
+        StepSimulation(candidateSimulation, scenario, candidateGameParameters, visibleWorld, perfStats, nullptr);
+
+        validator.EndStep();
+
+        if (!(GameRandomEngine::GetInstance().GetState() == referenceRandomState))
+        {
+            // The ships have drawn different random numbers, hence they are bound to diverge
+            validator.ReportDivergence("RandomSequence");
+        }
+
+        ++stepCount;
+    }
+
+    GameWallClock::GetInstance().SetPaused(false);
+
+    //
+    // Report
+    //
+
+    picojson::object validationObject;
+    validationObject["tolerance"] = picojson::value(static_cast<double>(tolerance));
+    validationObject["steps"] = picojson::value(static_cast<std::int64_t>(stepCount));
+    validationObject["compared_stages"] = picojson::value(static_cast<std::int64_t>(validator.GetComparedStageCount()));
+    validationObject["checksum_mismatches"] = picojson::value(static_cast<std::int64_t>(validator.GetChecksumMismatchCount()));
+
+    if (auto const & divergence = validator.GetFirstDivergence(); divergence.has_value())
+    {
+        picojson::object divergenceObject;
+        divergenceObject["step"] = picojson::value(static_cast<std::int64_t>(divergence->Step));
+        divergenceObject["stage"] = picojson::value(divergence->Stage);
+
+        if (!divergence->Buffer.empty())
+        {
+            divergenceObject["buffer"] = picojson::value(divergence->Buffer);
+            divergenceObject["element"] = picojson::value(static_cast<std::int64_t>(divergence->ElementIndex));
+            divergenceObject["reference_value"] = picojson::value(static_cast<double>(divergence->ReferenceValue));
+            divergenceObject["candidate_value"] = picojson::value(static_cast<double>(divergence->CandidateValue));
+        }
+
+        validationObject["first_divergence"] = picojson::value(divergenceObject);
+
+        std::cout << "Run #" << runIndex << " diverged at step " << divergence->Step << ", stage \"" << divergence->Stage << "\"";
+        if (!divergence->Buffer.empty())
+        {
+            std::cout << ", " << divergence->Buffer << "[" << divergence->ElementIndex << "]: "
+                << divergence->ReferenceValue << " vs " << divergence->CandidateValue;
+        }
+
+        std::cout << std::endl;
+    }
+    else
+    {
+        validationObject["first_divergence"] = picojson::value(); // null: did not diverge
+    }
+
+    picojson::object resultObject = MakeRunResultObject(scenario, run);
+    resultObject["validation"] = picojson::value(validationObject);
+
+    return picojson::value(resultObject);
+}
+
+GameParameters MakeRunGameParameters(Scenario::Run const & run)
+{
+    GameParameters gameParameters;
+    for (auto const & [name, value] : run.Parameters)
+    {
+        Scenario::ApplyParameter(name, value, gameParameters);
+    }
+
+    return gameParameters;
+}
+
+VisibleWorld MakeVisibleWorld()
+{
+    // A view of the default zoom, centered on the ship
+    VisibleWorld visibleWorld;
+    visibleWorld.Center = vec2f::zero();
+    visibleWorld.Width = 200.0f;
+    visibleWorld.Height = 100.0f;
+    visibleWorld.TopLeft = vec2f(-visibleWorld.Width / 2.0f, visibleWorld.Height / 2.0f);
+    visibleWorld.BottomRight = vec2f(visibleWorld.Width / 2.0f, -visibleWorld.Height / 2.0f);
+
+    return visibleWorld;
+}
+
+Simulation CreateSimulation(
+    Scenario const & scenario,
+    Scenario::Run const & run,
+    GameParameters const & gameParameters,
+    VisibleWorld const & visibleWorld,
+    SimulationResources const & resources,
+    std::shared_ptr<TaskThreadPool> taskThreadPool)
+{
+    auto gameEventDispatcher = std::make_shared<GameEventDispatcher>();
+    ShipStrengthRandomizer const shipStrengthRandomizer;
+
+    auto world = std::make_unique<Physics::World>(
+        OceanFloorTerrain::LoadFromImage(resources.Locator.GetDefaultOceanFloorTerrainFilePath()),
+        resources.FishSpecies,
+        gameEventDispatcher,
+        taskThreadPool,
+        gameParameters,
+        visibleWorld);
+
+    auto shipDefinition = ShipDeSerializer::LoadShip(run.ShipFilePath, resources.Materials);
+
+    auto [ship, textureImage] = ShipFactory::Create(
+        world->GetNextShipId(),
+        *world,
+        std::move(shipDefinition),
+        ShipLoadOptions(),
+        resources.Materials,
+        resources.Texturizer,
+        shipStrengthRandomizer,
+        gameEventDispatcher,
+        taskThreadPool,
+        gameParameters);
+
+    Physics::Ship * const shipPointer = ship.get();
+    ShipId const shipId = ship->GetId();
+    world->AddShip(std::move(ship));
+
+    return Simulation{
+        std::move(gameEventDispatcher),
+        std::move(world),
+        shipPointer,
+        shipId,
+        std::vector<bool>(scenario.GetEvents().size(), false) };
+}
+
+void StepSimulation(
+    Simulation & simulation,
+    Scenario const & scenario,
+    GameParameters const & gameParameters,
+    VisibleWorld const & visibleWorld,
+    PerfStats & perfStats,
+    RunMetrics * metrics)
+{
+    Physics::World & world = *simulation.World;
+
+    float const simulationTime = world.GetCurrentSimulationTime();
+
+    for (size_t e = 0; e < scenario.GetEvents().size(); ++e)
+    {
+        auto const & toolEvent = scenario.GetEvents()[e];
+
+        if (toolEvent.IsContinuous())
+        {
+            if (simulationTime >= toolEvent.StartTime && simulationTime < toolEvent.StartTime + toolEvent.Duration)
+            {
+                ApplyToolEvent(toolEvent, world, gameParameters);
+            }
+        }
+        else if (!simulation.IsEventFired[e] && simulationTime >= toolEvent.StartTime)
+        {
+            ApplyToolEvent(toolEvent, world, gameParameters);
+            simulation.IsEventFired[e] = true;
+        }
+    }
+
+    world.Update(
+        gameParameters,
+        visibleWorld,
+        StressRenderModeType::None,
+        perfStats);
+
+    if (metrics != nullptr)
+    {
+        metrics->CurrentSimulationTime = world.GetCurrentSimulationTime();
+    }
+
+    simulation.EventDispatcher->Flush();
+
+    world.UpdateStructureHeadless();
+}
+
+picojson::object MakeRunResultObject(
+    Scenario const & scenario,
+    Scenario::Run const & run)
+{
+    picojson::object parametersObject;
+    for (auto const & [name, value] : run.Parameters)
+    {
+        parametersObject[name] = value;
+    }
+
+    picojson::object resultObject;
+    resultObject["scenario"] = picojson::value(scenario.GetFilePath().string());
+    resultObject["run"] = picojson::value(static_cast<std::int64_t>(run.Index));
+    resultObject["ship"] = picojson::value(run.ShipFilePath.string());
+    resultObject["parameters"] = picojson::value(parametersObject);
+
+    return resultObject;
+}
+
+void ApplyToolEvent(
+    Scenario::ToolEvent const & toolEvent,
+    Physics::World & world,
+    GameParameters const & gameParameters)
+{
+    switch (toolEvent.Tool)
+    {
+        case Scenario::ToolEvent::ToolType::Destroy:
+        {
+            world.DestroyAt(toolEvent.Position, toolEvent.Strength, gameParameters);
+            break;
+        }
+
+        case Scenario::ToolEvent::ToolType::Heat:
+        case Scenario::ToolEvent::ToolType::Cool:
+        {
+            world.ApplyHeatBlasterAt(
+                toolEvent.Position,
+                toolEvent.Tool == Scenario::ToolEvent::ToolType::Heat ? HeatBlasterActionType::Heat : HeatBlasterActionType::Cool,
+                gameParameters.HeatBlasterRadius * toolEvent.Strength,
+                gameParameters);
+            break;
+        }
+
+        case Scenario::ToolEvent::ToolType::Flood:
+        {
+            world.FloodAt(toolEvent.Position, toolEvent.Strength, gameParameters);
+            break;
+        }
+
+        case Scenario::ToolEvent::ToolType::Blast:
+        {
+            world.ApplyBlastAt(
+                toolEvent.Position,
+                gameParameters.BlastToolRadius * toolEvent.Strength,
+                toolEvent.Strength,
+                gameParameters);
+            break;
+        }
+
+        case Scenario::ToolEvent::ToolType::InjectPressure:
+        {
+            world.InjectPressureAt(toolEvent.Position, toolEvent.Strength, gameParameters);
+            break;
+        }
+
+        case Scenario::ToolEvent::ToolType::Storm:
+        {
+            world.TriggerStorm();
+            break;
+        }
+
+        case Scenario::ToolEvent::ToolType::Tsunami:
+        {
+            world.TriggerTsunami();
+            break;
+        }
+
+        case Scenario::ToolEvent::ToolType::RogueWave:
+        {
+            world.TriggerRogueWave();
+            break;
+        }
+
+        case Scenario::ToolEvent::ToolType::Lightning:
+        {
+            world.TriggerLightning(gameParameters);
+            break;
+        }
+    }
+}
+
+void PrintUsage()
+{
+    std::cout << std::endl;
+    std::cout << "Usage:" << std::endl;
+    std::cout << "  SimulationRunner [-j <processes>] [-o <results.jsonl>] [--validate [--tolerance <t>]] <scenario.json>..." << std::endl;
+    std::cout << std::endl;
+    std::cout << "  -j : number of runs executed in parallel (default: number of cores)" << std::endl;
+    std::cout << "  -o : file the results are written to, one JSON object per run (default: results.jsonl)" << std::endl;
+    std::cout << "  --validate : simulates each run with both the reference and the optimized kernels, and" << std::endl;
+    std::cout << "               reports the first stage and element at which the two diverge" << std::endl;
+    std::cout << "  --tolerance : the absolute and relative difference below which values are considered" << std::endl;
+    std::cout << "                equal when validating (default: 0.0001)" << std::endl;
+    std::cout << std::endl;
+    std::cout << "Each scenario expands into one run for each combination of its ships" << std::endl;
+    std::cout << "and of the values of its swept parameters." << std::endl;
+}
@@ -0,0 +1,357 @@
+/***************************************************************************************
+ * Original Author:     Gabriele Giuseppini
+ * Created:             2026-10-14
+ * Copyright:           Gabriele Giuseppini  (https://github.com/GabrieleGiuseppini)
+ ***************************************************************************************/
+#include "Scenario.h"
+
+#include <GameCore/GameException.h>
+#include <GameCore/Utils.h>
+
+#include <cassert>
+#include <cstdint>
+#include <functional>
+#include <map>
+
+namespace /* anonymous */ {
+
+    using ParameterSetter = std::function<void(GameParameters &, picojson::value const &)>;
+
+#define FLOAT_PARAMETER(Name) \
+    { #Name, [](GameParameters & gp, picojson::value const & v) { gp.Name = static_cast<float>(Utils::GetJsonValueAs<double>(v, #Name)); } }
+
+#define BOOL_PARAMETER(Name) \
+    { #Name, [](GameParameters & gp, picojson::value const & v) { gp.Name = Utils::GetJsonValueAs<bool>(v, #Name); } }
+
+#define UINT_PARAMETER(Name) \
+    { #Name, [](GameParameters & gp, picojson::value const & v) { gp.Name = static_cast<unsigned int>(Utils::GetJsonValueAs<std::int64_t>(v, #Name)); } }
+
+#define DURATION_PARAMETER(Name) \
+    { #Name, [](GameParameters & gp, picojson::value const & v) { gp.Name = decltype(gp.Name)(Utils::GetJsonValueAs<std::int64_t>(v, #Name)); } }
+
+    // The game parameters that scenarios may set; the ones that only affect rendering
+    // and the UI are left out
+    std::map<std::string, ParameterSetter> const ParameterSetters = {
+        FLOAT_PARAMETER(NumMechanicalDynamicsIterationsAdjustment),
+        FLOAT_PARAMETER(SpringStiffnessAdjustment),
+        FLOAT_PARAMETER(SpringDampingAdjustment),
+        FLOAT_PARAMETER(SpringStrengthAdjustment),
+        FLOAT_PARAMETER(GlobalDampingAdjustment),
+        FLOAT_PARAMETER(StaticPressureForceAdjustment),
+        FLOAT_PARAMETER(AirDensityAdjustment),
+        FLOAT_PARAMETER(AirFrictionDragAdjustment),
+        FLOAT_PARAMETER(AirPressureDragAdjustment),
+        FLOAT_PARAMETER(WaterDensityAdjustment),
+        FLOAT_PARAMETER(WaterFrictionDragAdjustment),
+        FLOAT_PARAMETER(WaterPressureDragAdjustment),
+        FLOAT_PARAMETER(WaterImpactForceAdjustment),
+        FLOAT_PARAMETER(HydrostaticPressureCounterbalanceAdjustment),
+        FLOAT_PARAMETER(WaterIntakeAdjustment),
+        FLOAT_PARAMETER(WaterDiffusionSpeedAdjustment),
+        FLOAT_PARAMETER(WaterCrazyness),
+        FLOAT_PARAMETER(SmokeEmissionDensityAdjustment),
+        FLOAT_PARAMETER(SmokeParticleLifetimeAdjustment),
+        FLOAT_PARAMETER(AirBubblesDensity),
+        FLOAT_PARAMETER(WindSpeedBase),
+        FLOAT_PARAMETER(WindSpeedMaxFactor),
+        FLOAT_PARAMETER(WindGustFrequencyAdjustment),
+        FLOAT_PARAMETER(BasalWaveHeightAdjustment),
+        FLOAT_PARAMETER(BasalWaveLengthAdjustment),
+        FLOAT_PARAMETER(BasalWaveSpeedAdjustment),
+        FLOAT_PARAMETER(WaterDisplacementWaveHeightAdjustment),
+        FLOAT_PARAMETER(WaveSmoothnessAdjustment),
+        FLOAT_PARAMETER(StormStrengthAdjustment),
+        FLOAT_PARAMETER(LightningBlastProbability),
+        FLOAT_PARAMETER(LightningBlastRadius),
+        FLOAT_PARAMETER(LightningBlastHeat),
+        FLOAT_PARAMETER(RainFloodAdjustment),
+        FLOAT_PARAMETER(AirTemperature),
+        FLOAT_PARAMETER(WaterTemperature),
+        FLOAT_PARAMETER(ThermalConductivityAdjustment),
+        FLOAT_PARAMETER(HeatDissipationAdjustment),
+        FLOAT_PARAMETER(IgnitionTemperatureAdjustment),
+        FLOAT_PARAMETER(MeltingTemperatureAdjustment),
+        FLOAT_PARAMETER(CombustionSpeedAdjustment),
+        FLOAT_PARAMETER(CombustionHeatAdjustment),
+        FLOAT_PARAMETER(HeatBlasterHeatFlow),
+        FLOAT_PARAMETER(HeatBlasterRadius),
+        FLOAT_PARAMETER(LaserRayHeatFlow),
+        FLOAT_PARAMETER(LuminiscenceAdjustment),
+        FLOAT_PARAMETER(LightSpreadAdjustment),
+        FLOAT_PARAMETER(ElectricalElementHeatProducedAdjustment),
+        FLOAT_PARAMETER(EngineThrustAdjustment),
+        FLOAT_PARAMETER(WaterPumpPowerAdjustment),
+        FLOAT_PARAMETER(FishSizeMultiplier),
+        FLOAT_PARAMETER(FishSpeedAdjustment),
+        FLOAT_PARAMETER(FishShoalRadiusAdjustment),
+        FLOAT_PARAMETER(SeaDepth),
+        FLOAT_PARAMETER(OceanFloorBumpiness),
+        FLOAT_PARAMETER(OceanFloorDetailAmplification),
+        FLOAT_PARAMETER(OceanFloorElasticity),
+        FLOAT_PARAMETER(OceanFloorFriction),
+        FLOAT_PARAMETER(OceanFloorSiltHardness),
+        FLOAT_PARAMETER(ToolSearchRadius),
+        FLOAT_PARAMETER(DestroyRadius),
+        FLOAT_PARAMETER(RepairRadius),
+        FLOAT_PARAMETER(RepairSpeedAdjustment),
+        FLOAT_PARAMETER(BombBlastRadius),
+        FLOAT_PARAMETER(BombBlastForceAdjustment),
+        FLOAT_PARAMETER(BombBlastHeat),
+        FLOAT_PARAMETER(AntiMatterBombImplosionStrength),
+        FLOAT_PARAMETER(InjectPressureQuantity),
+        FLOAT_PARAMETER(FloodRadius),
+        FLOAT_PARAMETER(FloodQuantity),
+        FLOAT_PARAMETER(FireExtinguisherRadius),
+        FLOAT_PARAMETER(BlastToolRadius),
+        FLOAT_PARAMETER(BlastToolForceAdjustment),
+        FLOAT_PARAMETER(ScrubRotToolRadius),
+        FLOAT_PARAMETER(WindMakerToolWindSpeed),
+        FLOAT_PARAMETER(MoveToolInertia),
+
+        BOOL_PARAMETER(DoGenerateDebris),
+        BOOL_PARAMETER(DoGenerateSparklesForCuts),
+        BOOL_PARAMETER(DoGenerateEngineWakeParticles),
+        BOOL_PARAMETER(DoModulateWind),
+        BOOL_PARAMETER(DoDisplaceWater),
+        BOOL_PARAMETER(DoRainWithStorm),
+        BOOL_PARAMETER(DoFishShoaling),
+        BOOL_PARAMETER(DoDayLightCycle),
+        BOOL_PARAMETER(DoUpdateShipsConcurrently),
+        BOOL_PARAMETER(DoUpdateOceanSurfaceConcurrently),
+        BOOL_PARAMETER(DoUpdateWaterAndPressureConcurrently),
+        BOOL_PARAMETER(DoAdaptMechanicalDynamicsIterations),
+        BOOL_PARAMETER(DoPutRestingConnectedComponentsToSleep),
+        BOOL_PARAMETER(DoCompactDestroyedSprings),
+        BOOL_PARAMETER(DoSplitDetachedFragments),
+        BOOL_PARAMETER(DoUseImplicitHeatPropagation),
+        BOOL_PARAMETER(DoGovernSimulationTimeBudget),
+        BOOL_PARAMETER(IsUltraViolentMode),
+
+        UINT_PARAMETER(MaxBurningParticles),
+        UINT_PARAMETER(NumberOfFishes),
+        UINT_PARAMETER(NumberOfStars),
+        UINT_PARAMETER(NumberOfClouds),
+
+        DURATION_PARAMETER(TsunamiRate),
+        DURATION_PARAMETER(StormRate),
+        DURATION_PARAMETER(DayLightCycleDuration),
+        DURATION_PARAMETER(RogueWaveRate),
+        DURATION_PARAMETER(StormDuration),
+        DURATION_PARAMETER(TimerBombInterval)
+    };
+
+#undef FLOAT_PARAMETER
+#undef BOOL_PARAMETER
+#undef UINT_PARAMETER
+#undef DURATION_PARAMETER
+
+    std::map<std::string, Scenario::ToolEvent::ToolType> const ToolTypes = {
+        { "destroy", Scenario::ToolEvent::ToolType::Destroy },
+        { "heat", Scenario::ToolEvent::ToolType::Heat },
+        { "cool", Scenario::ToolEvent::ToolType::Cool },
+        { "flood", Scenario::ToolEvent::ToolType::Flood },
+        { "blast", Scenario::ToolEvent::ToolType::Blast },
+        { "inject_pressure", Scenario::ToolEvent::ToolType::InjectPressure },
+        { "storm", Scenario::ToolEvent::ToolType::Storm },
+        { "tsunami", Scenario::ToolEvent::ToolType::Tsunami },
+        { "rogue_wave", Scenario::ToolEvent::ToolType::RogueWave },
+        { "lightning", Scenario::ToolEvent::ToolType::Lightning }
+    };
+}
+
+Scenario Scenario::Load(std::filesystem::path const & scenarioFilePath)
+{
+    auto const rootValue = Utils::ParseJSONFile(scenarioFilePath);
+    if (!rootValue.is<picojson::object>())
+    {
+        throw GameException("Scenario file \"" + scenarioFilePath.filename().string() + "\" does not contain a JSON object");
+    }
+
+    auto const & rootObject = rootValue.get<picojson::object>();
+
+    //
+    // Ships
+    //
+
+    std::vector<std::filesystem::path> shipFilePaths;
+
+    auto const resolveShipFilePath = [&scenarioFilePath](std::string const & shipFilePath)
+    {
+        return scenarioFilePath.parent_path() / std::filesystem::path(shipFilePath);
+    };
+
+    if (auto const shipFilePath = Utils::GetOptionalJsonMember<std::string>(rootObject, "ship"); shipFilePath.has_value())
+    {
+        shipFilePaths.emplace_back(resolveShipFilePath(*shipFilePath));
+    }
+
+    if (auto const shipsArray = Utils::GetOptionalJsonMember<picojson::array>(rootObject, "ships"); shipsArray.has_value())
+    {
+        for (auto const & shipValue : *shipsArray)
+        {
+            shipFilePaths.emplace_back(resolveShipFilePath(Utils::GetJsonValueAs<std::string>(shipValue, "ships")));
+        }
+    }
+
+    if (shipFilePaths.empty())
+    {
+        throw GameException("Scenario file \"" + scenarioFilePath.filename().string() + "\" does not specify any ships");
+    }
+
+    //
+    // Duration
+    //
+
+    float const duration = Utils::GetMandatoryJsonMember<float>(rootObject, "duration");
+    if (duration <= 0.0f)
+    {
+        throw GameException("Scenario duration must be positive");
+    }
+
+    //
+    // Parameters
+    //
+
+    std::vector<std::pair<std::string, std::vector<picojson::value>>> parameterAxes;
+
+    if (auto const parametersObject = Utils::GetOptionalJsonObject(rootObject, "parameters"); parametersObject.has_value())
+    {
+        GameParameters scratchGameParameters;
+
+        for (auto const & [name, value] : *parametersObject)
+        {
+            std::vector<picojson::value> values;
+            if (value.is<picojson::array>())
+            {
+                values = value.get<picojson::array>();
+                if (values.empty())
+                {
+                    throw GameException("Scenario parameter \"" + name + "\" has no values to sweep");
+                }
+            }
+            else
+            {
+                values.push_back(value);
+            }
+
+            // Validate now, rather than in each run
+            for (auto const & v : values)
+            {
+                ApplyParameter(name, v, scratchGameParameters);
+            }
+
+            parameterAxes.emplace_back(name, std::move(values));
+        }
+    }
+
+    //
+    // Events
+    //
+
+    std::vector<ToolEvent> events;
+
+    if (auto const eventsArray = Utils::GetOptionalJsonMember<picojson::array>(rootObject, "events"); eventsArray.has_value())
+    {
+        for (auto const & eventValue : *eventsArray)
+        {
+            events.push_back(ParseToolEvent(Utils::GetJsonValueAs<picojson::object>(eventValue, "events")));
+        }
+    }
+
+    return Scenario(
+        scenarioFilePath,
+        std::move(shipFilePaths),
+        duration,
+        std::move(parameterAxes),
+        std::move(events));
+}
+
+size_t Scenario::GetRunCount() const
+{
+    size_t runCount = mShipFilePaths.size();
+    for (auto const & axis : mParameterAxes)
+    {
+        runCount *= axis.second.size();
+    }
+
+    return runCount;
+}
+
+Scenario::Run Scenario::GetRun(size_t runIndex) const
+{
+    assert(runIndex < GetRunCount());
+
+    // The run index is a mixed-radix number, whose least significant digit is the ship
+    size_t remainder = runIndex;
+
+    std::filesystem::path const shipFilePath = mShipFilePaths[remainder % mShipFilePaths.size()];
+    remainder /= mShipFilePaths.size();
+
+    std::vector<std::pair<std::string, picojson::value>> parameters;
+    for (auto const & [name, values] : mParameterAxes)
+    {
+        parameters.emplace_back(name, values[remainder % values.size()]);
+        remainder /= values.size();
+    }
+
+    return Run{
+        runIndex,
+        shipFilePath,
+        std::move(parameters) };
+}
+
+void Scenario::ApplyParameter(
+    std::string const & name,
+    picojson::value const & value,
+    GameParameters & gameParameters)
+{
+    auto const it = ParameterSetters.find(name);
+    if (it == ParameterSetters.cend())
+    {
+        throw GameException("Unknown scenario parameter \"" + name + "\"");
+    }
+
+    it->second(gameParameters, value);
+}
+
+Scenario::ToolEvent Scenario::ParseToolEvent(picojson::object const & eventObject)
+{
+    std::string const toolName = Utils::GetMandatoryJsonMember<std::string>(eventObject, "tool");
+    auto const toolIt = ToolTypes.find(toolName);
+    if (toolIt == ToolTypes.cend())
+    {
+        throw GameException("Unknown scenario tool \"" + toolName + "\"");
+    }
+
+    vec2f position = vec2f::zero();
+    if (auto const positionArray = Utils::GetOptionalJsonMember<picojson::array>(eventObject, "position"); positionArray.has_value())
+    {
+        if (positionArray->size() != 2)
+        {
+            throw GameException("Scenario event position must have two coordinates");
+        }
+
+        position = vec2f(
+            static_cast<float>(Utils::GetJsonValueAs<double>((*positionArray)[0], "position")),
+            static_cast<float>(Utils::GetJsonValueAs<double>((*positionArray)[1], "position")));
+    }
+
+    ToolEvent toolEvent{
+        Utils::GetMandatoryJsonMember<float>(eventObject, "time"),
+        Utils::GetOptionalJsonMember<float>(eventObject, "duration", 0.0f),
+        toolIt->second,
+        position,
+        Utils::GetOptionalJsonMember<float>(eventObject, "strength", 1.0f) };
+
+    if (!toolEvent.IsContinuous())
+    {
+        toolEvent.Duration = 0.0f;
+    }
+    else if (toolEvent.Duration == 0.0f)
+    {
+        // At least one step
+        toolEvent.Duration = GameParameters::SimulationStepTimeDuration<float>;
+    }
+
+    return toolEvent;
+}
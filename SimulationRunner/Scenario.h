@@ -0,0 +1,145 @@
+/***************************************************************************************
+ * Original Author:     Gabriele Giuseppini
+ * Created:             2026-10-14
+ * Copyright:           Gabriele Giuseppini  (https://github.com/GabrieleGiuseppini)
+ ***************************************************************************************/
+#pragma once
+
+#include <Game/GameParameters.h>
+
+#include <GameCore/Vectors.h>
+
+#include <picojson.h>
+
+#include <filesystem>
+#include <string>
+#include <utility>
+#include <vector>
+
+/*
+ * A scripted, headless simulation: one or more ships, a set of game parameters, and a
+ * timeline of tool events, all simulated for a fixed amount of simulated time.
+ *
+ * Scenarios are JSON files:
+ *
+ *  {
+ *      "ships": [ "MyShip.shp2" ],            // Or "ship"; relative to the scenario file
+ *      "duration": 120.0,                     // Simulated seconds
+ *      "parameters": {
+ *          "SpringStrengthAdjustment": [ 0.5, 1.0, 2.0 ],  // An array is a sweep
+ *          "DoRainWithStorm": false
+ *      },
+ *      "events": [
+ *          { "time": 10.0, "tool": "destroy", "position": [ 0.0, -5.0 ], "strength": 2.0 },
+ *          { "time": 20.0, "duration": 5.0, "tool": "flood", "position": [ 3.0, 0.0 ] }
+ *      ]
+ *  }
+ *
+ * A scenario expands into the cartesian product of its ships and of the values of all of
+ * its swept parameters, each combination being one run.
+ */
+class Scenario final
+{
+public:
+
+    struct ToolEvent
+    {
+        enum class ToolType
+        {
+            Destroy,
+            Heat,
+            Cool,
+            Flood,
+            Blast,
+            InjectPressure,
+            Storm,
+            Tsunami,
+            RogueWave,
+            Lightning
+        };
+
+        float StartTime;
+        float Duration; // Zero for events that fire once
+        ToolType Tool;
+        vec2f Position;
+        float Strength; // Multiplier of the tool's own parameters
+
+        // Whether the tool is applied at each step of its duration, rather than once
+        bool IsContinuous() const
+        {
+            return Tool == ToolType::Destroy
+                || Tool == ToolType::Heat
+                || Tool == ToolType::Cool
+                || Tool == ToolType::Flood
+                || Tool == ToolType::Blast
+                || Tool == ToolType::InjectPressure;
+        }
+    };
+
+    struct Run
+    {
+        size_t Index;
+        std::filesystem::path ShipFilePath;
+        std::vector<std::pair<std::string, picojson::value>> Parameters;
+    };
+
+public:
+
+    static Scenario Load(std::filesystem::path const & scenarioFilePath);
+
+    std::filesystem::path const & GetFilePath() const
+    {
+        return mFilePath;
+    }
+
+    float GetDuration() const
+    {
+        return mDuration;
+    }
+
+    std::vector<ToolEvent> const & GetEvents() const
+    {
+        return mEvents;
+    }
+
+    size_t GetRunCount() const;
+
+    Run GetRun(size_t runIndex) const;
+
+    /*
+     * Sets the specified game parameter, throwing if the parameter is unknown
+     * or the value is not of its type.
+     */
+    static void ApplyParameter(
+        std::string const & name,
+        picojson::value const & value,
+        GameParameters & gameParameters);
+
+private:
+
+    Scenario(
+        std::filesystem::path const & filePath,
+        std::vector<std::filesystem::path> && shipFilePaths,
+        float duration,
+        std::vector<std::pair<std::string, std::vector<picojson::value>>> && parameterAxes,
+        std::vector<ToolEvent> && events)
+        : mFilePath(filePath)
+        , mShipFilePaths(std::move(shipFilePaths))
+        , mDuration(duration)
+        , mParameterAxes(std::move(parameterAxes))
+        , mEvents(std::move(events))
+    {}
+
+    static ToolEvent ParseToolEvent(picojson::object const & eventObject);
+
+private:
+
+    std::filesystem::path const mFilePath;
+    std::vector<std::filesystem::path> const mShipFilePaths;
+    float const mDuration;
+
+    // One axis per parameter, with one value for parameters that are not swept
+    std::vector<std::pair<std::string, std::vector<picojson::value>>> const mParameterAxes;
+
+    std::vector<ToolEvent> const mEvents;
+};
@@ -0,0 +1,217 @@
+/***************************************************************************************
+ * Original Author:     Gabriele Giuseppini
+ * Created:             2026-10-14
+ * Copyright:           Gabriele Giuseppini  (https://github.com/GabrieleGiuseppini)
+ ***************************************************************************************/
+#include "ShipStateValidator.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstring>
+
+ShipStateValidator::ShipStateValidator(Tolerance const & tolerance)
+    : mTolerance(tolerance)
+    , mReferenceShip(nullptr)
+    , mCandidateShip(nullptr)
+    , mReferenceStages()
+    , mReferenceStageCount(0)
+    , mCandidateStageIndex(0)
+    , mStep(0)
+    , mFirstDivergence()
+    , mComparedStageCount(0)
+    , mChecksumMismatchCount(0)
+{
+    assert(tolerance.Absolute > 0.0f);
+}
+
+void ShipStateValidator::Attach(
+    Physics::Ship & referenceShip,
+    Physics::Ship & candidateShip)
+{
+    mReferenceShip = &referenceShip;
+    mCandidateShip = &candidateShip;
+
+    mReferenceShip->SetStageObserver(
+        [this](std::string const & stageName)
+        {
+            OnReferenceStage(stageName);
+        });
+
+    mCandidateShip->SetStageObserver(
+        [this](std::string const & stageName)
+        {
+            OnCandidateStage(stageName);
+        });
+}
+
+void ShipStateValidator::BeginStep()
+{
+    ++mStep;
+
+    mReferenceStageCount = 0;
+    mCandidateStageIndex = 0;
+}
+
+void ShipStateValidator::EndStep()
+{
+    if (!mFirstDivergence.has_value() && mCandidateStageIndex != mReferenceStageCount)
+    {
+        // The candidate ran fewer stages than the reference
+        ReportDivergence(mReferenceStages[mCandidateStageIndex].Name);
+    }
+}
+
+void ShipStateValidator::ReportDivergence(std::string const & stage)
+{
+    if (!mFirstDivergence.has_value())
+    {
+        mFirstDivergence = Divergence{ mStep, stage, std::string(), 0, 0.0f, 0.0f };
+    }
+}
+
+void ShipStateValidator::OnReferenceStage(std::string const & stageName)
+{
+    if (mFirstDivergence.has_value())
+    {
+        // Nothing more to learn
+        return;
+    }
+
+    if (mReferenceStageCount == mReferenceStages.size())
+    {
+        mReferenceStages.emplace_back();
+    }
+
+    StageState & stage = mReferenceStages[mReferenceStageCount++];
+    stage.Name = stageName;
+
+    size_t b = 0;
+    mReferenceShip->GetPoints().VisitStateBuffers(
+        [&](char const * bufferName, float const * values, size_t count)
+        {
+            if (b == stage.Buffers.size())
+            {
+                stage.Buffers.emplace_back();
+            }
+
+            BufferState & buffer = stage.Buffers[b++];
+            buffer.Name = bufferName;
+            buffer.Checksum = CalculateChecksum(values, count);
+            buffer.Values.assign(values, values + count);
+        });
+
+    stage.Buffers.resize(b);
+}
+
+void ShipStateValidator::OnCandidateStage(std::string const & stageName)
+{
+    if (mFirstDivergence.has_value())
+    {
+        // Nothing more to learn
+        return;
+    }
+
+    if (mCandidateStageIndex == mReferenceStageCount
+        || mReferenceStages[mCandidateStageIndex].Name != stageName)
+    {
+        // The candidate ran a stage the reference did not run at this point
+        ReportDivergence(stageName);
+        return;
+    }
+
+    StageState const & stage = mReferenceStages[mCandidateStageIndex++];
+
+    size_t b = 0;
+    mCandidateShip->GetPoints().VisitStateBuffers(
+        [&](char const * bufferName, float const * values, size_t count)
+        {
+            if (mFirstDivergence.has_value())
+            {
+                return;
+            }
+
+            BufferState const & buffer = stage.Buffers[b++];
+
+            assert(buffer.Name == bufferName);
+
+            if (count != buffer.Values.size())
+            {
+                mFirstDivergence = Divergence{ mStep, stageName, bufferName, std::min(count, buffer.Values.size()), 0.0f, 0.0f };
+                return;
+            }
+
+            if (CalculateChecksum(values, count) == buffer.Checksum)
+            {
+                // All values fall in the same quanta
+                return;
+            }
+
+            ++mChecksumMismatchCount;
+
+            for (size_t i = 0; i < count; ++i)
+            {
+                if (!AreWithinTolerance(buffer.Values[i], values[i]))
+                {
+                    mFirstDivergence = Divergence{ mStep, stageName, bufferName, i, buffer.Values[i], values[i] };
+                    return;
+                }
+            }
+        });
+
+    ++mComparedStageCount;
+}
+
+std::uint64_t ShipStateValidator::CalculateChecksum(
+    float const * values,
+    size_t count) const
+{
+    // FNV-1a over the quanta of the values
+    std::uint64_t checksum = 14695981039346656037ull;
+
+    float const quantumReciprocal = 1.0f / mTolerance.Absolute;
+
+    for (size_t i = 0; i < count; ++i)
+    {
+        std::uint64_t quantum;
+
+        float const scaledValue = std::floor(values[i] * quantumReciprocal);
+        if (std::isfinite(scaledValue) && std::abs(scaledValue) < 9.0e18f)
+        {
+            quantum = static_cast<std::uint64_t>(static_cast<std::int64_t>(scaledValue));
+        }
+        else
+        {
+            // Huge or not a number; these only match when they're identical
+            std::uint32_t bits;
+            std::memcpy(&bits, &values[i], sizeof(bits));
+            quantum = 0x8000000000000000ull | bits;
+        }
+
+        checksum ^= quantum;
+        checksum *= 1099511628211ull;
+    }
+
+    return checksum;
+}
+
+bool ShipStateValidator::AreWithinTolerance(
+    float referenceValue,
+    float candidateValue) const
+{
+    if (std::isnan(referenceValue) || std::isnan(candidateValue))
+    {
+        return std::isnan(referenceValue) && std::isnan(candidateValue);
+    }
+
+    if (referenceValue == candidateValue)
+    {
+        // Includes infinities
+        return true;
+    }
+
+    float const delta = std::abs(referenceValue - candidateValue);
+
+    return delta <= mTolerance.Absolute
+        || delta <= mTolerance.Relative * std::max(std::abs(referenceValue), std::abs(candidateValue));
+}
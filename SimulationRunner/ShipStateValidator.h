@@ -0,0 +1,143 @@
+/***************************************************************************************
+ * Original Author:     Gabriele Giuseppini
+ * Created:             2026-10-14
+ * Copyright:           Gabriele Giuseppini  (https://github.com/GabrieleGiuseppini)
+ ***************************************************************************************/
+#pragma once
+
+#include <Game/Physics.h>
+
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <vector>
+
+/*
+ * Compares, stage by stage, the updates of two ships created from the same definition:
+ * a reference ship - e.g. running the reference kernels - and a candidate ship - e.g.
+ * running the optimized kernels - so that optimizations changing results beyond rounding
+ * are caught at the stage that introduces the difference, rather than as drift at the
+ * end of a run.
+ *
+ * At each step the reference ship is updated first, capturing the state of its points
+ * after each stage; then the candidate ship is updated, comparing the state of its points
+ * after each stage with the one captured at the same stage. States are compared by their
+ * tolerance-aware checksums - hashes of the values quantized to the absolute tolerance -
+ * falling back on comparing values one by one only when checksums differ, as values that
+ * are close may still straddle a quantum.
+ */
+class ShipStateValidator final
+{
+public:
+
+    struct Tolerance
+    {
+        float Absolute;
+        float Relative; // Of the larger of the two values
+
+        Tolerance(
+            float absolute,
+            float relative)
+            : Absolute(absolute)
+            , Relative(relative)
+        {}
+    };
+
+    struct Divergence
+    {
+        std::uint64_t Step;
+        std::string Stage;
+        std::string Buffer; // Empty when the ships ran different stages
+        size_t ElementIndex; // Of the float in the buffer
+        float ReferenceValue;
+        float CandidateValue;
+    };
+
+public:
+
+    explicit ShipStateValidator(Tolerance const & tolerance);
+
+    /*
+     * Hooks the validator to the stages of the two ships, which must outlive it.
+     */
+    void Attach(
+        Physics::Ship & referenceShip,
+        Physics::Ship & candidateShip);
+
+    /*
+     * Invoked before updating the reference ship at each step.
+     */
+    void BeginStep();
+
+    /*
+     * Invoked after updating the candidate ship at each step.
+     */
+    void EndStep();
+
+    /*
+     * Records a divergence not pertaining to any buffer, e.g. of the random sequence.
+     */
+    void ReportDivergence(std::string const & stage);
+
+    std::optional<Divergence> const & GetFirstDivergence() const
+    {
+        return mFirstDivergence;
+    }
+
+    std::uint64_t GetComparedStageCount() const
+    {
+        return mComparedStageCount;
+    }
+
+    std::uint64_t GetChecksumMismatchCount() const
+    {
+        return mChecksumMismatchCount;
+    }
+
+private:
+
+    struct BufferState
+    {
+        std::string Name;
+        std::uint64_t Checksum;
+        std::vector<float> Values;
+    };
+
+    struct StageState
+    {
+        std::string Name;
+        std::vector<BufferState> Buffers;
+    };
+
+    void OnReferenceStage(std::string const & stageName);
+
+    void OnCandidateStage(std::string const & stageName);
+
+    std::uint64_t CalculateChecksum(
+        float const * values,
+        size_t count) const;
+
+    bool AreWithinTolerance(
+        float referenceValue,
+        float candidateValue) const;
+
+private:
+
+    Tolerance const mTolerance;
+
+    Physics::Ship * mReferenceShip;
+    Physics::Ship * mCandidateShip;
+
+    // The stages of the reference ship at the current step; the storage
+    // of the stages beyond the current count is kept for the next steps
+    std::vector<StageState> mReferenceStages;
+    size_t mReferenceStageCount;
+
+    // The next stage of the candidate ship at the current step
+    size_t mCandidateStageIndex;
+
+    std::uint64_t mStep;
+    std::optional<Divergence> mFirstDivergence;
+    std::uint64_t mComparedStageCount;
+    std::uint64_t mChecksumMismatchCount;
+};
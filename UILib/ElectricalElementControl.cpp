@@ -80,13 +80,19 @@ void GaugeElectricalElementControl::UpdateSimulation()
     // Update hand endpoint
     //
 
-    mHandEndpoint = CalculateHandEndpoint(mCenterPoint, mHandLength, mCurrentAngle);
+    wxPoint const newHandEndpoint = CalculateHandEndpoint(mCenterPoint, mHandLength, mCurrentAngle);
 
     //
-    // Redraw
+    // Redraw, only if the hand has moved by at least one pixel - which is
+    // never the case with a gauge at rest
     //
 
-    mImagePanel->Refresh();
+    if (newHandEndpoint != mHandEndpoint)
+    {
+        mHandEndpoint = newHandEndpoint;
+
+        mImagePanel->Refresh();
+    }
 }
 
 void GaugeElectricalElementControl::Render(wxDC & dc)
@@ -132,6 +138,9 @@ void EngineControllerTelegraphElectricalElementControl::OnKeyboardShortcutDown(b
                 --mCurrentValue;
         }
 
+        // Redraw now, as the event travelling back won't change our value
+        Refresh();
+
         mOnControllerUpdated(TelegraphValueToControllerValue(mCurrentValue));
     }
 }
@@ -266,6 +275,9 @@ void EngineControllerTelegraphElectricalElementControl::MoveToPoint(wxPoint cons
     {
         mCurrentValue = *value;
 
+        // Redraw now, as the event travelling back won't change our value
+        Refresh();
+
         // Notify
         mOnControllerUpdated(TelegraphValueToControllerValue(mCurrentValue));
     }
@@ -306,6 +318,9 @@ void EngineControllerJetEngineThrottleElectricalElementControl::OnKeyboardShortc
             }
         }
 
+        // Redraw now, as the event travelling back won't change our value
+        Refresh();
+
         mOnControllerUpdated(mCurrentValue);
     }
 }
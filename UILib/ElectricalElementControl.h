@@ -151,9 +151,12 @@ public:
 
     void SetState(ElectricalState state)
     {
-        mCurrentState = state;
+        if (state != mCurrentState)
+        {
+            mCurrentState = state;
 
-        SetImageForCurrentState();
+            SetImageForCurrentState();
+        }
     }
 
     virtual bool IsEnabled() const override
@@ -163,9 +166,12 @@ public:
 
     virtual void SetEnabled(bool isEnabled) override
     {
-        mIsEnabled = isEnabled;
+        if (isEnabled != mIsEnabled)
+        {
+            mIsEnabled = isEnabled;
 
-        SetImageForCurrentState();
+            SetImageForCurrentState();
+        }
     }
 
 protected:
@@ -533,9 +539,12 @@ public:
 
     void SetState(ElectricalState state)
     {
-        mCurrentState = state;
+        if (state != mCurrentState)
+        {
+            mCurrentState = state;
 
-        SetImageForCurrentState();
+            SetImageForCurrentState();
+        }
     }
 
 private:
@@ -717,9 +726,13 @@ public:
 
     void SetValue(float controllerValue) override
     {
-        mCurrentValue = ControllerValueToTelegraphValue(controllerValue);
+        TelegraphValue const newValue = ControllerValueToTelegraphValue(controllerValue);
+        if (newValue != mCurrentValue)
+        {
+            mCurrentValue = newValue;
 
-        Refresh();
+            Refresh();
+        }
     }
 
     virtual bool IsEnabled() const override
@@ -729,9 +742,12 @@ public:
 
     virtual void SetEnabled(bool isEnabled) override
     {
-        mIsEnabled = isEnabled;
+        if (isEnabled != mIsEnabled)
+        {
+            mIsEnabled = isEnabled;
 
-        Refresh();
+            Refresh();
+        }
     }
 
     virtual void SetKeyboardShortcutLabel(std::string const & label) override
@@ -851,9 +867,12 @@ public:
 
     void SetValue(float controllerValue) override
     {
-        mCurrentValue = controllerValue;
+        if (controllerValue != mCurrentValue)
+        {
+            mCurrentValue = controllerValue;
 
-        Refresh();
+            Refresh();
+        }
     }
 
     virtual bool IsEnabled() const override
@@ -863,9 +882,12 @@ public:
 
     virtual void SetEnabled(bool isEnabled) override
     {
-        mIsEnabled = isEnabled;
+        if (isEnabled != mIsEnabled)
+        {
+            mIsEnabled = isEnabled;
 
-        Refresh();
+            Refresh();
+        }
     }
 
     virtual void SetKeyboardShortcutLabel(std::string const & label) override
@@ -963,11 +985,14 @@ public:
 
     void SetValue(float controllerValue) override
     {
-        mCurrentValue = controllerValue;
+        if (controllerValue != mCurrentValue)
+        {
+            mCurrentValue = controllerValue;
 
-        mImageBitmap->SetBitmap(GetImageForCurrentState());
+            mImageBitmap->SetBitmap(GetImageForCurrentState());
 
-        Refresh();
+            Refresh();
+        }
     }
 
     virtual bool IsEnabled() const override
@@ -977,11 +1002,14 @@ public:
 
     virtual void SetEnabled(bool isEnabled) override
     {
-        mIsEnabled = isEnabled;
+        if (isEnabled != mIsEnabled)
+        {
+            mIsEnabled = isEnabled;
 
-        mImageBitmap->SetBitmap(GetImageForCurrentState());
+            mImageBitmap->SetBitmap(GetImageForCurrentState());
 
-        Refresh();
+            Refresh();
+        }
     }
 
     virtual void SetKeyboardShortcutLabel(std::string const & label) override
@@ -1017,7 +1045,10 @@ private:
         {
             mCurrentValue = 1.0f;
 
-            // Just invoke the callback, we'll end up being toggled when the event travels back
+            // Redraw now, as the event travelling back won't change our value
+            mImageBitmap->SetBitmap(GetImageForCurrentState());
+            Refresh();
+
             mOnControllerUpdated(mCurrentValue);
         }
     }
@@ -1028,7 +1059,10 @@ private:
         {
             mCurrentValue = 0.0f;
 
-            // Just invoke the callback, we'll end up being toggled when the event travels back
+            // Redraw now, as the event travelling back won't change our value
+            mImageBitmap->SetBitmap(GetImageForCurrentState());
+            Refresh();
+
             mOnControllerUpdated(mCurrentValue);
         }
     }
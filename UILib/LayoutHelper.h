@@ -12,7 +12,6 @@
 #include <cassert>
 #include <functional>
 #include <optional>
-#include <set>
 #include <utility>
 #include <vector>
 
@@ -39,10 +38,12 @@ public:
      * Expected coordinates:
      *  x = 0 is center, x = -1, -2, ... are on the left, x = +1, +2, ... are on the right
      *  y = 0 is top, y = +1, +2, ... are below
+     *
+     * Runs in O(n log n), with n the number of elements.
      */
     template<typename TElement>
     static void Layout(
-        std::vector<LayoutElement<TElement>> layoutElements,
+        std::vector<LayoutElement<TElement>> const & layoutElements,
         int maxElementsPerRow,
         std::function<void(int nCols, int nRows)> const & onBegin,
         std::function<void(std::optional<TElement> element, IntegralCoordinates const & coords)> const & onPosition)
@@ -53,30 +54,56 @@ public:
 
         //
         // - Split elements between those with coordinates ("decorated") and those without ("undecorated")
-        //      - Consider elements with conflicting coordinates as undecorated
+        //      - Consider elements with conflicting coordinates as undecorated, except for the first one
         // - Calculate max x and y among decorated elements
         //
+        // We sort the elements with coordinates by y, x - which is also the order in which we position
+        // them - and find conflicts among neighbors; the sort is stable, hence of all the elements with
+        // the same coordinates the first one is the first in the input
+        //
 
-        std::vector<LayoutElement<TElement>> decoratedElements;
-        std::vector<TElement> undecoratedElements;
+        std::vector<size_t> coordinatesElementIndices;
+        for (size_t e = 0; e < layoutElements.size(); ++e)
+        {
+            if (layoutElements[e].Coordinates.has_value())
+            {
+                coordinatesElementIndices.push_back(e);
+            }
+        }
+
+        std::stable_sort(
+            coordinatesElementIndices.begin(),
+            coordinatesElementIndices.end(),
+            [&layoutElements](size_t lhs, size_t rhs)
+            {
+                return IsBefore(*layoutElements[lhs].Coordinates, *layoutElements[rhs].Coordinates);
+            });
+
+        std::vector<LayoutElement<TElement>> decoratedElements; // Sorted by y, x
+        std::vector<bool> isDecorated(layoutElements.size(), false);
 
         int maxDecoratedX = 0;
         int maxDecoratedY = 0;
 
-        std::set<IntegralCoordinates> knownCoordinates;
-        for (auto const & element : layoutElements)
+        for (size_t i = 0; i < coordinatesElementIndices.size(); ++i)
         {
-            if (element.Coordinates.has_value() && knownCoordinates.count(*element.Coordinates) == 0)
+            auto const & element = layoutElements[coordinatesElementIndices[i]];
+            if (i == 0 || *element.Coordinates != *layoutElements[coordinatesElementIndices[i - 1]].Coordinates)
             {
                 maxDecoratedX = std::max(maxDecoratedX, abs(element.Coordinates->x));
                 maxDecoratedY = std::max(maxDecoratedY, element.Coordinates->y);
                 decoratedElements.emplace_back(element);
 
-                knownCoordinates.insert(*element.Coordinates);
+                isDecorated[coordinatesElementIndices[i]] = true;
             }
-            else
+        }
+
+        std::vector<TElement> undecoratedElements;
+        for (size_t e = 0; e < layoutElements.size(); ++e)
+        {
+            if (!isDecorated[e])
             {
-                undecoratedElements.emplace_back(element.Element);
+                undecoratedElements.emplace_back(layoutElements[e].Element);
             }
         }
 
@@ -162,20 +189,6 @@ public:
 
         onBegin(nCols, nRows);
 
-        //
-        // Sort decorated elements by y, x
-        //
-
-        std::sort(
-            decoratedElements.begin(),
-            decoratedElements.end(),
-            [](auto const & lhs, auto const & rhs)
-            {
-                assert(!!(lhs.Coordinates));
-                return lhs.Coordinates->y < rhs.Coordinates->y
-                    || (lhs.Coordinates->y == rhs.Coordinates->y && lhs.Coordinates->x < rhs.Coordinates->x);
-            });
-
         //
         // Position all items
         //
@@ -219,4 +232,15 @@ public:
         assert(decoratedIt == decoratedElements.cend());
         assert(undecoratedIt == undecoratedElements.cend());
     }
+
+private:
+
+    // Order of positioning: by y, then by x
+    static bool IsBefore(
+        IntegralCoordinates const & lhs,
+        IntegralCoordinates const & rhs)
+    {
+        return lhs.y < rhs.y
+            || (lhs.y == rhs.y && lhs.x < rhs.x);
+    }
 };
\ No newline at end of file
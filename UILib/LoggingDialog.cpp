@@ -9,19 +9,138 @@
 #include <GameCore/Log.h>
 
 #include <wx/clipbrd.h>
+#include <wx/listctrl.h>
 #include <wx/settings.h>
 
 #include <cassert>
 #include <chrono>
 
+// How often the messages delivered meanwhile are shown
+int constexpr FlushIntervalMilliseconds = 100;
+
+/*
+ * A virtual list of the most recent lines of the log, which renders only the
+ * lines that are visible.
+ */
+class LogListCtrl final : public wxListCtrl
+{
+public:
+
+    explicit LogListCtrl(wxWindow * parent)
+        : wxListCtrl(
+            parent,
+            wxID_ANY,
+            wxDefaultPosition,
+            wxSize(200, 200),
+            wxLC_REPORT | wxLC_VIRTUAL | wxLC_NO_HEADER | wxLC_SINGLE_SEL | wxBORDER_NONE)
+        , mLines()
+        , mFirstLineIndex(0)
+    {
+        // Wide enough for the longest lines
+        AppendColumn(wxEmptyString, wxLIST_FORMAT_LEFT, 4000);
+    }
+
+    void AppendMessages(std::vector<std::string> const & messages)
+    {
+        for (auto const & message : messages)
+        {
+            // Messages end with a newline, and may span multiple lines
+            for (size_t lineStart = 0; lineStart < message.size(); )
+            {
+                size_t lineEnd = message.find('\n', lineStart);
+                if (lineEnd == std::string::npos)
+                {
+                    lineEnd = message.size();
+                }
+
+                AppendLine(message.substr(lineStart, lineEnd - lineStart));
+
+                lineStart = lineEnd + 1;
+            }
+        }
+
+        SetItemCount(static_cast<long>(mLines.size()));
+
+        if (!mLines.empty())
+        {
+            EnsureVisible(static_cast<long>(mLines.size()) - 1);
+        }
+
+        Refresh();
+    }
+
+    void ClearLines()
+    {
+        mLines.clear();
+        mFirstLineIndex = 0;
+
+        SetItemCount(0);
+        Refresh();
+    }
+
+    std::string GetAllLines() const
+    {
+        std::string allLines;
+        for (size_t l = 0; l < mLines.size(); ++l)
+        {
+            allLines += GetLine(l);
+            allLines += '\n';
+        }
+
+        return allLines;
+    }
+
+protected:
+
+    wxString OnGetItemText(long item, long /*column*/) const override
+    {
+        // The control might still ask for a line it knew of before a clear
+        if (item < 0 || static_cast<size_t>(item) >= mLines.size())
+        {
+            return wxEmptyString;
+        }
+
+        return wxString(GetLine(static_cast<size_t>(item)));
+    }
+
+private:
+
+    std::string const & GetLine(size_t lineIndex) const
+    {
+        return mLines[(mFirstLineIndex + lineIndex) % mLines.size()];
+    }
+
+    void AppendLine(std::string && line)
+    {
+        if (mLines.size() < MaxLines)
+        {
+            mLines.emplace_back(std::move(line));
+        }
+        else
+        {
+            // Overwrite the oldest line
+            mLines[mFirstLineIndex] = std::move(line);
+            mFirstLineIndex = (mFirstLineIndex + 1) % MaxLines;
+        }
+    }
+
+private:
+
+    static size_t constexpr MaxLines = 10000;
+
+    // A ring, whose oldest line is at mFirstLineIndex once full
+    std::vector<std::string> mLines;
+    size_t mFirstLineIndex;
+};
+
 wxBEGIN_EVENT_TABLE(LoggingDialog, wxDialog)
 	EVT_CLOSE(LoggingDialog::OnClose)
 wxEND_EVENT_TABLE()
 
-wxDEFINE_EVENT(fsEVT_LOG_MESSAGE, fsLogMessageEvent);
-
 LoggingDialog::LoggingDialog(wxWindow * parent)
 	: mParent(parent)
+    , mPendingMessagesMutex()
+    , mPendingMessages()
 {
 	Create(
 		mParent,
@@ -35,32 +154,34 @@ LoggingDialog::LoggingDialog(wxWindow * parent)
 	SetBackgroundColour(wxSystemSettings::GetColour(wxSYS_COLOUR_BTNFACE));
 
 	//
-	// Create Text control
+	// Create list control
 	//
 
-	mTextCtrl = new wxTextCtrl(
-		this,
-		wxID_ANY,
-		wxEmptyString,
-		wxDefaultPosition,
-		wxSize(200, 200),
-		wxTE_MULTILINE | wxTE_READONLY | wxTE_RICH | wxVSCROLL | wxHSCROLL | wxBORDER_NONE);
+	mLogListCtrl = new LogListCtrl(this);
 
 	wxFont font(10, wxFONTFAMILY_TELETYPE, wxFONTSTYLE_NORMAL, wxFONTWEIGHT_NORMAL);
-	mTextCtrl->SetFont(font);
+	mLogListCtrl->SetFont(font);
+
+    //
+    // Create flush timer
+    //
+
+    mFlushTimer = std::make_unique<wxTimer>(this, wxID_ANY);
 
     //
     // Connect events
     //
 
     Bind(wxEVT_KEY_DOWN, &LoggingDialog::OnKeyDown, this);
-    mTextCtrl->Bind(wxEVT_KEY_DOWN, &LoggingDialog::OnKeyDown, this);
-    Bind(fsEVT_LOG_MESSAGE, &LoggingDialog::OnLogMessage, this);
+    mLogListCtrl->Bind(wxEVT_KEY_DOWN, &LoggingDialog::OnKeyDown, this);
+    Bind(wxEVT_TIMER, &LoggingDialog::OnFlushTimer, this, mFlushTimer->GetId());
 }
 
 LoggingDialog::~LoggingDialog()
 {
     Logger::Instance.UnregisterListener();
+
+    mFlushTimer->Stop();
 }
 
 void LoggingDialog::Open()
@@ -68,11 +189,17 @@ void LoggingDialog::Open()
     if (!this->IsShown())
     {
         Logger::Instance.RegisterListener(
-            [this, windowId = this->GetId()](std::string const & message)
-        {
-            fsLogMessageEvent * event = new fsLogMessageEvent(fsEVT_LOG_MESSAGE, windowId, message);
-            QueueEvent(event);
-        });
+            [this](std::string const & message)
+            {
+                // Invoked on the logger's delivery thread, or on ours while registering
+                std::lock_guard const lock{ mPendingMessagesMutex };
+                mPendingMessages.push_back(message);
+            });
+
+        // Show the messages so far right away
+        FlushPendingMessages();
+
+        mFlushTimer->Start(FlushIntervalMilliseconds, false);
 
         this->Show();
     }
@@ -89,7 +216,7 @@ void LoggingDialog::OnKeyDown(wxKeyEvent& event)
         if (wxTheClipboard->Open())
         {
             wxTheClipboard->Clear();
-            wxTheClipboard->SetData(new wxTextDataObject(this->mTextCtrl->GetValue()));
+            wxTheClipboard->SetData(new wxTextDataObject(this->mLogListCtrl->GetAllLines()));
             wxTheClipboard->Flush();
             wxTheClipboard->Close();
         }
@@ -108,8 +235,13 @@ void LoggingDialog::OnKeyDown(wxKeyEvent& event)
         // Clear
         //
 
-        assert(this->mTextCtrl != nullptr);
-        this->mTextCtrl->Clear();
+        assert(this->mLogListCtrl != nullptr);
+        this->mLogListCtrl->ClearLines();
+    }
+    else
+    {
+        // Let the list scroll with the navigation keys
+        event.Skip();
     }
 }
 
@@ -117,15 +249,38 @@ void LoggingDialog::OnClose(wxCloseEvent & event)
 {
 	Logger::Instance.UnregisterListener();
 
+    mFlushTimer->Stop();
+
+    // Forget the messages that have not been shown
+    {
+        std::lock_guard const lock{ mPendingMessagesMutex };
+        mPendingMessages.clear();
+    }
+
 	// Be nice, clear the control
-	assert(this->mTextCtrl != nullptr);
-	this->mTextCtrl->Clear();
+	assert(this->mLogListCtrl != nullptr);
+	this->mLogListCtrl->ClearLines();
 
 	event.Skip();
 }
 
-void LoggingDialog::OnLogMessage(fsLogMessageEvent & event)
+void LoggingDialog::OnFlushTimer(wxTimerEvent & /*event*/)
 {
-    assert(this->mTextCtrl != nullptr);
-    this->mTextCtrl->WriteText(event.GetMessage());
-}
\ No newline at end of file
+    FlushPendingMessages();
+}
+
+void LoggingDialog::FlushPendingMessages()
+{
+    std::vector<std::string> messages;
+
+    {
+        std::lock_guard const lock{ mPendingMessagesMutex };
+        messages.swap(mPendingMessages);
+    }
+
+    if (!messages.empty())
+    {
+        assert(this->mLogListCtrl != nullptr);
+        this->mLogListCtrl->AppendMessages(messages);
+    }
+}
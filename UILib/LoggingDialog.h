@@ -6,46 +6,23 @@
 #pragma once
 
 #include <wx/dialog.h>
-#include <wx/textctrl.h>
+#include <wx/timer.h>
 
 #include <memory>
-
-class fsLogMessageEvent : public wxEvent
-{
-public:
-
-    fsLogMessageEvent(
-        wxEventType eventType,
-        int winid,
-        std::string const & message)
-        : wxEvent(winid, eventType)
-        , mMessage(message)
-    {
-    }
-
-    fsLogMessageEvent(fsLogMessageEvent const & other)
-        : wxEvent(other)
-        , mMessage(other.mMessage)
-    {
-    }
-
-    virtual wxEvent *Clone() const override
-    {
-        return new fsLogMessageEvent(*this);
-    }
-
-    std::string const & GetMessage() const
-    {
-        return mMessage;
-    }
-
-private:
-    std::string const mMessage;
-};
-
-wxDECLARE_EVENT(fsEVT_LOG_MESSAGE, fsLogMessageEvent);
-
-
+#include <mutex>
+#include <string>
+#include <vector>
+
+class LogListCtrl;
+
+/*
+ * Shows the log, as long as it's open.
+ *
+ * Messages are collected - from whichever thread they're delivered on - and shown in
+ * batches at a fixed interval, so that noisy operations don't flood the UI with one
+ * event per message; they're shown in a virtual list backed by a bounded ring of lines,
+ * which only renders the lines that are visible.
+ */
 class LoggingDialog : public wxDialog
 {
 public:
@@ -60,13 +37,21 @@ private:
 
     void OnKeyDown(wxKeyEvent& event);
 	void OnClose(wxCloseEvent& event);
-    void OnLogMessage(fsLogMessageEvent & event);
+    void OnFlushTimer(wxTimerEvent & event);
+
+    void FlushPendingMessages();
 
 private:
 
 	wxWindow * const mParent;
 
-	wxTextCtrl * mTextCtrl;
+	LogListCtrl * mLogListCtrl;
+
+    std::unique_ptr<wxTimer> mFlushTimer;
+
+    // The messages delivered since the last flush
+    std::mutex mPendingMessagesMutex;
+    std::vector<std::string> mPendingMessages;
 
 	DECLARE_EVENT_TABLE()
 };
@@ -5,7 +5,7 @@
 ***************************************************************************************/
 #include "ScalarTimeSeriesProbeControl.h"
 
-#include <wx/dcbuffer.h>
+#include <wx/dcmemory.h>
 
 #include <algorithm>
 #include <cassert>
@@ -18,7 +18,8 @@ static constexpr int Height = 80;
 
 ScalarTimeSeriesProbeControl::ScalarTimeSeriesProbeControl(
     wxWindow * parent,
-    int width)
+    int width,
+    int samplesPerColumn)
     : wxPanel(
         parent,
         wxID_ANY,
@@ -26,10 +27,15 @@ ScalarTimeSeriesProbeControl::ScalarTimeSeriesProbeControl(
         wxDefaultSize,
         wxBORDER_SIMPLE)
     , mWidth(width)
-    , mBufferedDCBitmap()
+    , mSamplesPerColumn(samplesPerColumn)
     , mTimeSeriesPen(wxColor("BLACK"), 2, wxPENSTYLE_SOLID)
     , mGridPen(wxColor(0xa0, 0xa0, 0xa0), 1, wxPENSTYLE_SOLID)
+    , mBackgroundBrush(wxColour("WHITE"), wxBRUSHSTYLE_SOLID)
+    , mChartBitmap()
 {
+    assert(width > 0 && static_cast<size_t>(width) <= MaxColumns);
+    assert(samplesPerColumn > 0);
+
     SetMinSize(wxSize(width, Height));
     SetMaxSize(wxSize(width, Height));
 
@@ -54,24 +60,55 @@ void ScalarTimeSeriesProbeControl::RegisterSample(float value)
     mMaxValue = std::max(mMaxValue, value);
     mMinValue = std::min(mMinValue, value);
 
-    mSamples.emplace(
-        [](float) {},
-        value);
+    if (mCurrentColumnSampleCount == 0)
+    {
+        mColumns.emplace(
+            [](Column const &) {},
+            value);
+
+        ++mTotalColumnCount;
+        ++mNewColumnCount;
+    }
+    else
+    {
+        Column & currentColumn = *mColumns.begin();
+        currentColumn.Min = std::min(currentColumn.Min, value);
+        currentColumn.Max = std::max(currentColumn.Max, value);
+        currentColumn.Last = value;
+    }
+
+    mCurrentColumnSampleCount = (mCurrentColumnSampleCount + 1) % mSamplesPerColumn;
+
+    mHasNewSamples = true;
 }
 
 void ScalarTimeSeriesProbeControl::UpdateSimulation()
 {
-    Refresh();
+    if (mHasNewSamples)
+    {
+        Refresh();
+    }
 }
 
 void ScalarTimeSeriesProbeControl::Reset()
 {
-    mSamples.clear();
+    mColumns.clear();
+    mCurrentColumnSampleCount = 0;
+    mTotalColumnCount = 0;
 
     mMaxValue = std::numeric_limits<float>::lowest();
     mMinValue = std::numeric_limits<float>::max();
 
+    mIsChartDirty = true;
+    mNewColumnCount = 0;
+    mHasNewSamples = false;
+
+    mChartMaxValue = mMaxValue;
+    mChartMinValue = mMinValue;
     mGridValueSize = 0.0f;
+    mYGridStepSize = Height;
+
+    Refresh();
 }
 
 ///////////////////////////////////////////////////////////////////////////////////////
@@ -81,10 +118,10 @@ void ScalarTimeSeriesProbeControl::OnMouseClick(wxMouseEvent & /*event*/)
     // Reset extent
     mMaxValue = std::numeric_limits<float>::lowest();
     mMinValue = std::numeric_limits<float>::max();
-    for (auto it : mSamples)
+    for (auto const & column : mColumns)
     {
-        mMaxValue = std::max(mMaxValue, it);
-        mMinValue = std::min(mMinValue, it);
+        mMaxValue = std::max(mMaxValue, column.Max);
+        mMinValue = std::min(mMinValue, column.Min);
     }
 
     Refresh();
@@ -92,14 +129,29 @@ void ScalarTimeSeriesProbeControl::OnMouseClick(wxMouseEvent & /*event*/)
 
 void ScalarTimeSeriesProbeControl::OnPaint(wxPaintEvent & /*event*/)
 {
-    if (!mBufferedDCBitmap || mBufferedDCBitmap->GetSize() != this->GetSize())
+    UpdateChart();
+
+    wxPaintDC dc(this);
+
+    if (!mChartBitmap)
     {
-        mBufferedDCBitmap = std::make_unique<wxBitmap>(this->GetSize());
+        return;
     }
 
-    wxBufferedPaintDC bufDc(this, *mBufferedDCBitmap);
+    dc.DrawBitmap(*mChartBitmap, 0, 0);
+
+    //
+    // Draw label - not part of the chart, as it doesn't scroll
+    //
+
+    if (!mColumns.empty())
+    {
+        std::stringstream ss;
+        ss << std::fixed << std::setprecision(3) << mColumns.cbegin()->Last << " (" << mMaxValue << ")";
 
-    Render(bufDc);
+        wxString labelText(ss.str());
+        dc.DrawText(labelText, 0, 1);
+    }
 }
 
 void ScalarTimeSeriesProbeControl::OnEraseBackground(wxPaintEvent & /*event*/)
@@ -109,18 +161,37 @@ void ScalarTimeSeriesProbeControl::OnEraseBackground(wxPaintEvent & /*event*/)
 
 int ScalarTimeSeriesProbeControl::MapValueToY(float value) const
 {
-    if (mMaxValue == mMinValue)
+    if (mChartMaxValue == mChartMinValue)
         return Height / 2;
 
-    float y = static_cast<float>(Height - 4) * (value - mMinValue) / (mMaxValue - mMinValue);
+    float y = static_cast<float>(Height - 4) * (value - mChartMinValue) / (mChartMaxValue - mChartMinValue);
     return Height - 3 - static_cast<int>(round(y));
 }
 
-void ScalarTimeSeriesProbeControl::Render(wxDC & dc)
+void ScalarTimeSeriesProbeControl::UpdateChart()
 {
-    dc.Clear();
+    wxSize const size = this->GetClientSize();
+    if (size.GetWidth() <= 0 || size.GetHeight() <= 0)
+    {
+        // Not laid out yet
+        return;
+    }
+
+    if (!mChartBitmap || mChartBitmap->GetSize() != size)
+    {
+        mChartBitmap = std::make_unique<wxBitmap>(size);
+        mIsChartDirty = true;
+    }
 
-    if (!mSamples.empty())
+    if (mMaxValue != mChartMaxValue || mMinValue != mChartMinValue)
+    {
+        // Extent has changed, hence the y mapping
+        mChartMaxValue = mMaxValue;
+        mChartMinValue = mMinValue;
+        mIsChartDirty = true;
+    }
+
+    if (mIsChartDirty || mNewColumnCount >= static_cast<size_t>(size.GetWidth()))
     {
         //
         // Check if need to resize grid
@@ -128,7 +199,7 @@ void ScalarTimeSeriesProbeControl::Render(wxDC & dc)
 
         // Calculate new grid step
         float numberOfGridLines = 6.0f;
-        float const currentValueExtent = mMaxValue - mMinValue;
+        float const currentValueExtent = mChartMaxValue - mChartMinValue;
         if (currentValueExtent > 0.0f)
         {
             if (mGridValueSize == 0.0f)
@@ -144,73 +215,103 @@ void ScalarTimeSeriesProbeControl::Render(wxDC & dc)
             }
         }
 
-        static const int xGridStepSize = mWidth / 6;
-        int yGridStepSize = std::min(mWidth, Height) / static_cast<int>(ceil(numberOfGridLines));
-
+        mYGridStepSize = std::max(std::min(mWidth, Height) / static_cast<int>(ceil(numberOfGridLines)), 1);
 
+        wxMemoryDC dc(*mChartBitmap);
+        RenderChart(dc, 0);
+    }
+    else if (mHasNewSamples)
+    {
         //
-        // Draw grid
+        // Scroll left by the new columns, and redraw the new columns together with the
+        // newest one we had already drawn, which might have changed since
         //
 
-        dc.SetPen(mGridPen);
+        int const shift = static_cast<int>(mNewColumnCount);
 
-        for (int y = yGridStepSize; y < Height - 1; y += yGridStepSize)
+        // Taken before selecting the bitmap into the DC, as required on some platforms
+        wxBitmap scrolledChart;
+        if (shift > 0)
         {
-            dc.DrawLine(0, y, mWidth - 1, y);
+            scrolledChart = mChartBitmap->GetSubBitmap(wxRect(shift, 0, size.GetWidth() - shift, size.GetHeight()));
         }
 
-        for (int x = xGridStepSize; x < mWidth - 1; x += xGridStepSize)
+        wxMemoryDC dc(*mChartBitmap);
+
+        if (shift > 0)
         {
-            dc.DrawLine(x, 0, x, Height - 1);
+            dc.DrawBitmap(scrolledChart, 0, 0);
         }
 
+        RenderChart(dc, mWidth - 2 - shift - 1);
+    }
 
-        //
-        // Draw chart
-        //
+    mIsChartDirty = false;
+    mNewColumnCount = 0;
+    mHasNewSamples = false;
+}
 
-        dc.SetPen(mTimeSeriesPen);
+void ScalarTimeSeriesProbeControl::RenderChart(
+    wxDC & dc,
+    int startX)
+{
+    startX = std::max(startX, 0);
 
-        auto it = mSamples.cbegin();
-        int lastX = mWidth - 2;
-        int lastY = MapValueToY(*it);
-        ++it;
+    dc.SetPen(*wxTRANSPARENT_PEN);
+    dc.SetBrush(mBackgroundBrush);
+    dc.DrawRectangle(startX, 0, mWidth - startX, Height);
 
-        if (it == mSamples.cend())
-        {
-            // Draw just a point
-            dc.DrawPoint(lastX, lastY);
-        }
-        else
-        {
-            // Draw lines
-            do
-            {
-                int newX = lastX - 1;
-                if (newX == 0)
-                    break;
+    if (mColumns.empty())
+    {
+        return;
+    }
 
-                int newY = MapValueToY(*it);
+    //
+    // Draw horizontal grid
+    //
 
-                dc.DrawLine(newX, newY, lastX, lastY);
+    dc.SetPen(mGridPen);
 
-                lastX = newX;
-                lastY = newY;
+    for (int y = mYGridStepSize; y < Height - 1; y += mYGridStepSize)
+    {
+        dc.DrawLine(startX, y, mWidth - 1, y);
+    }
 
-                ++it;
-            }
-            while (it != mSamples.cend());
+    //
+    // Draw vertical grid and chart, from the newest column (at the right) leftwards
+    //
+
+    int const xGridStepSize = std::max(mWidth / 6, 1);
+
+    int x = mWidth - 2;
+    size_t columnOrdinal = mTotalColumnCount - 1;
+    int lastY = 0;
+    for (auto it = mColumns.cbegin(); it != mColumns.cend() && x > 0 && x >= startX - 1; ++it, --x, --columnOrdinal)
+    {
+        int const y = MapValueToY(it->Last);
+
+        if (x >= startX && (columnOrdinal % xGridStepSize) == 0)
+        {
+            dc.SetPen(mGridPen);
+            dc.DrawLine(x, 0, x, Height - 1);
         }
 
+        dc.SetPen(mTimeSeriesPen);
 
-        //
-        // Draw label
-        //
+        if (it == mColumns.cbegin())
+        {
+            dc.DrawPoint(x, y);
+        }
+        else
+        {
+            dc.DrawLine(x, y, x + 1, lastY);
+        }
 
-        std::stringstream ss;
-        ss << std::fixed << std::setprecision(3) << *mSamples.cbegin() << " (" << mMaxValue << ")";
+        if (it->Min != it->Max)
+        {
+            dc.DrawLine(x, MapValueToY(it->Min), x, MapValueToY(it->Max));
+        }
 
-        wxString labelText(ss.str());
-        dc.DrawText(labelText, 0, 1);
+        lastY = y;
     }
-}
\ No newline at end of file
+}
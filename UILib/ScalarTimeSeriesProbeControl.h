@@ -11,13 +11,21 @@
 
 #include <memory>
 
+/*
+ * Plots a time series of scalar samples, newest at the right.
+ *
+ * Each pixel column aggregates a fixed number of consecutive samples, drawn as their min-max
+ * range; the chart is kept in a cached bitmap, which is only scrolled by the columns added
+ * since the last paint - the whole chart is only redrawn when the value extent changes.
+ */
 class ScalarTimeSeriesProbeControl : public wxPanel
 {
 public:
 
     ScalarTimeSeriesProbeControl(
         wxWindow * parent,
-        int width);
+        int width,
+        int samplesPerColumn = 1);
 
     virtual ~ScalarTimeSeriesProbeControl() = default;
 
@@ -33,23 +41,62 @@ private:
     void OnPaint(wxPaintEvent & event);
     void OnEraseBackground(wxPaintEvent & event);
 
-    void Render(wxDC& dc);
+    // Brings the cached chart up-to-date with the columns
+    void UpdateChart();
+
+    // Redraws the chart from the specified x to its right edge
+    void RenderChart(
+        wxDC & dc,
+        int startX);
 
     inline int MapValueToY(float value) const;
 
 private:
 
+    struct Column
+    {
+        float Min;
+        float Max;
+        float Last;
+
+        Column(float value)
+            : Min(value)
+            , Max(value)
+            , Last(value)
+        {}
+    };
+
+    static size_t constexpr MaxColumns = 200;
+
     int const mWidth;
+    int const mSamplesPerColumn;
 
-    std::unique_ptr<wxBitmap> mBufferedDCBitmap;
     wxPen const mTimeSeriesPen;
-    wxPen mGridPen;
+    wxPen const mGridPen;
+    wxBrush const mBackgroundBrush;
 
     float mMaxValue;
     float mMinValue;
-    float mGridValueSize;
 
-    CircularList<float, 200> mSamples;
+    // Newest first; the newest column might not have all of its samples yet
+    CircularList<Column, MaxColumns> mColumns;
+    int mCurrentColumnSampleCount;
+    size_t mTotalColumnCount; // Anchors the vertical grid lines to the scrolling columns
+
+    //
+    // Cached chart
+    //
+
+    std::unique_ptr<wxBitmap> mChartBitmap;
+    bool mIsChartDirty; // When set, the whole chart needs to be redrawn
+    size_t mNewColumnCount; // Columns added since the chart was last updated
+    bool mHasNewSamples; // Samples registered since the chart was last updated
+
+    // The extent and grid the chart was drawn with
+    float mChartMaxValue;
+    float mChartMinValue;
+    float mGridValueSize;
+    int mYGridStepSize;
 };
 
 class IntegratingScalarTimeSeriesProbeControl : public ScalarTimeSeriesProbeControl
@@ -58,8 +105,9 @@ public:
 
     IntegratingScalarTimeSeriesProbeControl(
         wxWindow * parent,
-        int width)
-        : ScalarTimeSeriesProbeControl(parent, width)
+        int width,
+        int samplesPerColumn = 1)
+        : ScalarTimeSeriesProbeControl(parent, width, samplesPerColumn)
         , mCurrentSum(0.0f)
     {}
 
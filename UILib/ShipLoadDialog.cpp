@@ -7,6 +7,8 @@
 
 #include "StandardSystemPaths.h"
 
+#include <Game/ShipDeSerializer.h>
+
 #include <GameCore/Log.h>
 
 #include <UILib/ShipDescriptionDialog.h>
@@ -21,7 +23,8 @@ constexpr int MaxDirComboWidth = 650;
 template<ShipLoadDialogUsageType TUsageType>
 ShipLoadDialog<TUsageType>::ShipLoadDialog(
     wxWindow * parent,
-    ResourceLocator const & resourceLocator)
+    ResourceLocator const & resourceLocator,
+    MaterialDatabase const * prefetchMaterialDatabase)
     : mParent(parent)
     , mResourceLocator(resourceLocator)
     ///
@@ -29,6 +32,9 @@ ShipLoadDialog<TUsageType>::ShipLoadDialog(
     ///
     , mStandardInstalledShipFolderPath(resourceLocator.GetInstalledShipFolderPath())
     , mUserShipFolderPath(StandardSystemPaths::GetInstance().GetUserShipFolderPath())
+    , mPrefetchMaterialDatabase(prefetchMaterialDatabase)
+    , mShipPrefetch()
+    , mShipPrefetchThread(prefetchMaterialDatabase != nullptr ? std::make_unique<TaskThread>() : nullptr)
 {
     Create(
         mParent,
@@ -579,6 +585,8 @@ ShipLoadDialog<TUsageType>::ShipLoadDialog(
 template<ShipLoadDialogUsageType TUsageType>
 ShipLoadDialog<TUsageType>::~ShipLoadDialog()
 {
+    // Do not wait for a prefetch we don't need anymore
+    CancelShipPrefetch();
 }
 
 template<ShipLoadDialogUsageType TUsageType>
@@ -588,6 +596,7 @@ int ShipLoadDialog<TUsageType>::ShowModal(std::vector<std::filesystem::path> con
     mSelectedShipMetadata.reset();
     mSelectedShipFilepath.reset();
     mChosenShipFilepath.reset();
+    CancelShipPrefetch();
 
     // Disable controls
     mInfoButton->Enable(false);
@@ -643,6 +652,9 @@ void ShipLoadDialog<TUsageType>::OnShipFileSelected(ShipPreviewWindow::fsShipFil
         mPasswordProtectedButton->Enable(!!(event.GetShipMetadata()) && !!(event.GetShipMetadata()->Password));
     }
     mLoadButton->Enable(true);
+
+    // Start loading it, in case it's the one
+    StartShipPrefetch(*mSelectedShipFilepath);
 }
 
 template<ShipLoadDialogUsageType TUsageType>
@@ -775,6 +787,7 @@ void ShipLoadDialog<TUsageType>::OnDirectorySelected(std::filesystem::path direc
     // Reset our current selection
     mSelectedShipMetadata.reset();
     mSelectedShipFilepath.reset();
+    CancelShipPrefetch();
 
     // Disable controls
     mInfoButton->Enable(false);
@@ -813,6 +826,11 @@ void ShipLoadDialog<TUsageType>::EndModal(int retCode)
 
     mShipPreviewWindow->OnClose();
 
+    if (retCode != wxID_OK)
+    {
+        CancelShipPrefetch();
+    }
+
     wxDialog::EndModal(retCode);
 }
 
@@ -904,5 +922,70 @@ void ShipLoadDialog<TUsageType>::RepopulateRecentDirectoriesComboBox(std::vector
     mRecentDirectoriesComboBox->SetValue(dirToSelect);
 }
 
+template<ShipLoadDialogUsageType TUsageType>
+void ShipLoadDialog<TUsageType>::StartShipPrefetch(std::filesystem::path const & shipFilepath)
+{
+    if (!mShipPrefetchThread)
+    {
+        // Not prefetching
+        return;
+    }
+
+    if (mShipPrefetch && mShipPrefetch->ShipFilepath == shipFilepath)
+    {
+        // Already on it
+        return;
+    }
+
+    CancelShipPrefetch();
+
+    mShipPrefetch = std::make_shared<ShipPrefetch>(shipFilepath);
+
+    mShipPrefetchThread->QueueTask(
+        [shipPrefetch = mShipPrefetch, materialDatabase = mPrefetchMaterialDatabase]()
+        {
+            // The selection might have moved on while this was queued
+            if (shipPrefetch->IsCancelled)
+                return;
+
+            try
+            {
+                auto definition = std::make_shared<ShipDefinition const>(
+                    ShipDeSerializer::LoadShip(shipPrefetch->ShipFilepath, *materialDatabase));
+
+                std::lock_guard<std::mutex> lock(shipPrefetch->DefinitionMutex);
+                shipPrefetch->Definition = std::move(definition);
+            }
+            catch (std::exception const & exc)
+            {
+                // The load proper will report it
+                LogMessage("ShipLoadDialog: cannot prefetch ship ", shipPrefetch->ShipFilepath, ": ", exc.what());
+            }
+        });
+}
+
+template<ShipLoadDialogUsageType TUsageType>
+void ShipLoadDialog<TUsageType>::CancelShipPrefetch()
+{
+    if (mShipPrefetch)
+    {
+        mShipPrefetch->IsCancelled = true;
+        mShipPrefetch.reset();
+    }
+}
+
+template<ShipLoadDialogUsageType TUsageType>
+std::shared_ptr<ShipDefinition const> ShipLoadDialog<TUsageType>::GetPrefetchedShipDefinition(std::filesystem::path const & shipFilepath) const
+{
+    if (!mShipPrefetch || mShipPrefetch->ShipFilepath != shipFilepath)
+    {
+        return nullptr;
+    }
+
+    // Not waiting for it, if it's still loading, so as not to block the UI
+    std::lock_guard<std::mutex> lock(mShipPrefetch->DefinitionMutex);
+    return mShipPrefetch->Definition;
+}
+
 template class ShipLoadDialog<ShipLoadDialogUsageType::ForGame>;
 template class ShipLoadDialog<ShipLoadDialogUsageType::ForShipBuilder>;
\ No newline at end of file
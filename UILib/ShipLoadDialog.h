@@ -7,9 +7,13 @@
 
 #include "ShipPreviewWindow.h"
 
+#include <Game/MaterialDatabase.h>
 #include <Game/ResourceLocator.h>
+#include <Game/ShipDefinition.h>
 #include <Game/ShipLoadSpecifications.h>
 
+#include <GameCore/TaskThread.h>
+
 #include <UILib/BitmapButton.h>
 #include <UILib/BitmapToggleButton.h>
 
@@ -19,7 +23,10 @@
 #include <wx/popupwin.h>
 #include <wx/srchctrl.h>
 
+#include <atomic>
 #include <filesystem>
+#include <memory>
+#include <mutex>
 #include <optional>
 #include <string>
 #include <vector>
@@ -35,9 +42,14 @@ class ShipLoadDialog : public wxDialog
 {
 public:
 
+    /*
+     * When a material database is specified, the definition of the selected ship is
+     * already loaded in the background while the user makes up their mind.
+     */
     ShipLoadDialog(
         wxWindow* parent,
-        ResourceLocator const & resourceLocator);
+        ResourceLocator const & resourceLocator,
+        MaterialDatabase const * prefetchMaterialDatabase = nullptr);
 
     virtual ~ShipLoadDialog();
 
@@ -53,12 +65,17 @@ public:
             assert(mFlipVButton);
             assert(mRotate90CWButton);
             
-            return ShipLoadSpecifications(
+            ShipLoadSpecifications shipLoadSpecs(
                 *mChosenShipFilepath,
                 ShipLoadOptions(
                 mFlipHButton->GetValue(),
                 mFlipVButton->GetValue(),
                 mRotate90CWButton->GetValue()));
+
+            // Use the prefetched definition, if it's there already
+            shipLoadSpecs.Definition = GetPrefetchedShipDefinition(*mChosenShipFilepath);
+
+            return shipLoadSpecs;
         }
         else
         {
@@ -98,6 +115,10 @@ private:
     void StartShipSearch();
     void RepopulateRecentDirectoriesComboBox(std::vector<std::filesystem::path> const & shipLoadDirectories);
 
+    void StartShipPrefetch(std::filesystem::path const & shipFilepath);
+    void CancelShipPrefetch();
+    std::shared_ptr<ShipDefinition const> GetPrefetchedShipDefinition(std::filesystem::path const & shipFilepath) const;
+
 private:
 
     wxWindow * const mParent;
@@ -135,4 +156,28 @@ private:
     std::optional<ShipMetadata> mSelectedShipMetadata;
     std::optional<std::filesystem::path> mSelectedShipFilepath;
     std::optional<std::filesystem::path> mChosenShipFilepath;
+
+    //
+    // Ship prefetch
+    //
+
+    struct ShipPrefetch
+    {
+        std::filesystem::path const ShipFilepath;
+        std::atomic<bool> IsCancelled;
+
+        std::mutex DefinitionMutex;
+        std::shared_ptr<ShipDefinition const> Definition; // Set once loaded
+
+        explicit ShipPrefetch(std::filesystem::path const & shipFilepath)
+            : ShipFilepath(shipFilepath)
+            , IsCancelled(false)
+            , DefinitionMutex()
+            , Definition()
+        {}
+    };
+
+    MaterialDatabase const * const mPrefetchMaterialDatabase;
+    std::shared_ptr<ShipPrefetch> mShipPrefetch; // The latest one
+    std::unique_ptr<TaskThread> mShipPrefetchThread; // Only when prefetching
 };
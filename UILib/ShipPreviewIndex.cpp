@@ -0,0 +1,382 @@
+/***************************************************************************************
+* Original Author:		Gabriele Giuseppini
+* Created:				2026-10-14
+* Copyright:			Gabriele Giuseppini  (https://github.com/GabrieleGiuseppini)
+***************************************************************************************/
+#include "ShipPreviewIndex.h"
+
+#include <GameCore/Utils.h>
+
+#include <algorithm>
+#include <iterator>
+
+ShipPreviewIndex::ShipPreviewIndex(
+    SortMethod sortMethod,
+    bool isSortDescending)
+    : mEntries()
+    , mTrigramIndex()
+    , mPermutations()
+    , mCurrentPermutationSlot(GetPermutationSlot(sortMethod, isSortDescending))
+{
+    mPermutations[mCurrentPermutationSlot].emplace(Permutation{ sortMethod, isSortDescending, {}, {} });
+}
+
+void ShipPreviewIndex::Reset(std::vector<std::string> const & filenames)
+{
+    mEntries.clear();
+    mEntries.reserve(filenames.size());
+    mTrigramIndex.clear();
+
+    for (auto const & filename : filenames)
+    {
+        EntryId const entryId = mEntries.size();
+        mEntries.emplace_back(filename);
+
+        AddSearchString(entryId, Utils::ToLower(filename));
+    }
+
+    // Forget all the other sort orders, and rebuild the current one
+    for (size_t p = 0; p < mPermutations.size(); ++p)
+    {
+        if (p != mCurrentPermutationSlot)
+        {
+            mPermutations[p].reset();
+        }
+    }
+
+    BuildPermutation(*mPermutations[mCurrentPermutationSlot]);
+}
+
+void ShipPreviewIndex::SetMetadata(
+    EntryId entryId,
+    ShipMetadata const & metadata,
+    int featureScore,
+    PortableTimepoint lastWriteTime)
+{
+    assert(entryId < mEntries.size());
+
+    Entry & entry = mEntries[entryId];
+
+    entry.HasMetadata = true;
+    entry.ShipNameLCase = Utils::ToLower(metadata.ShipName);
+    entry.FeatureScore = featureScore;
+    entry.LastWriteTime = lastWriteTime;
+    entry.YearBuilt = metadata.YearBuilt;
+
+    //
+    // Search strings
+    //
+
+    entry.SearchStrings.clear();
+
+    AddSearchString(entryId, Utils::ToLower(entry.Filename));
+    AddSearchString(entryId, std::string(entry.ShipNameLCase));
+
+    if (metadata.Author.has_value())
+        AddSearchString(entryId, Utils::ToLower(*metadata.Author));
+
+    if (metadata.ArtCredits.has_value())
+        AddSearchString(entryId, Utils::ToLower(*metadata.ArtCredits));
+
+    if (metadata.YearBuilt.has_value())
+        AddSearchString(entryId, Utils::ToLower(*metadata.YearBuilt));
+
+    //
+    // Sort orders
+    //
+
+    for (auto & permutation : mPermutations)
+    {
+        if (permutation.has_value())
+        {
+            ResortEntry(entryId, *permutation);
+        }
+    }
+}
+
+void ShipPreviewIndex::SetSortMethod(
+    SortMethod sortMethod,
+    bool isSortDescending)
+{
+    mCurrentPermutationSlot = GetPermutationSlot(sortMethod, isSortDescending);
+
+    if (!mPermutations[mCurrentPermutationSlot].has_value())
+    {
+        mPermutations[mCurrentPermutationSlot].emplace(Permutation{ sortMethod, isSortDescending, {}, {} });
+        BuildPermutation(*mPermutations[mCurrentPermutationSlot]);
+    }
+}
+
+std::optional<size_t> ShipPreviewIndex::FindNext(
+    std::string const & text,
+    size_t startPosition) const
+{
+    if (text.empty() || mEntries.empty())
+        return std::nullopt;
+
+    std::string const textLCase = Utils::ToLower(text);
+
+    auto const matches = [this, &textLCase](EntryId entryId)
+    {
+        return std::any_of(
+            mEntries[entryId].SearchStrings.cbegin(),
+            mEntries[entryId].SearchStrings.cend(),
+            [&textLCase](std::string const & str)
+            {
+                return str.find(textLCase) != std::string::npos;
+            });
+    };
+
+    //
+    // Find the matching entry that comes first after the start position
+    //
+
+    size_t const entryCount = mEntries.size();
+    startPosition %= entryCount;
+
+    std::optional<size_t> bestPosition;
+    size_t bestDistance = entryCount;
+
+    auto const visitCandidate = [&](EntryId entryId)
+    {
+        size_t const position = GetPositionOf(entryId);
+        size_t const distance = (position + entryCount - startPosition) % entryCount;
+        if (distance < bestDistance && matches(entryId))
+        {
+            bestPosition = position;
+            bestDistance = distance;
+        }
+    };
+
+    auto const trigrams = MakeTrigrams(textLCase);
+    if (trigrams.empty())
+    {
+        // Too short for the index; a linear scan in sort order will do, as it stops at the first match
+        for (size_t i = 0; i < entryCount; ++i)
+        {
+            size_t const position = (startPosition + i) % entryCount;
+            if (matches(GetEntryAt(position)))
+            {
+                return position;
+            }
+        }
+
+        return std::nullopt;
+    }
+
+    //
+    // Intersect the posting lists of all trigrams, shortest first
+    //
+
+    std::vector<std::vector<EntryId> const *> postingLists;
+    for (Trigram const trigram : trigrams)
+    {
+        auto const it = mTrigramIndex.find(trigram);
+        if (it == mTrigramIndex.cend())
+            return std::nullopt;
+
+        postingLists.push_back(&(it->second));
+    }
+
+    std::sort(
+        postingLists.begin(),
+        postingLists.end(),
+        [](auto const * l, auto const * r)
+        {
+            return l->size() < r->size();
+        });
+
+    std::vector<EntryId> candidates = *postingLists.front();
+    for (size_t l = 1; l < postingLists.size() && !candidates.empty(); ++l)
+    {
+        std::vector<EntryId> intersection;
+        std::set_intersection(
+            candidates.cbegin(),
+            candidates.cend(),
+            postingLists[l]->cbegin(),
+            postingLists[l]->cend(),
+            std::back_inserter(intersection));
+
+        candidates = std::move(intersection);
+    }
+
+    // Verify candidates, as trigrams may come from different strings or not be contiguous
+    for (EntryId const entryId : candidates)
+    {
+        visitCandidate(entryId);
+    }
+
+    return bestPosition;
+}
+
+bool ShipPreviewIndex::IsLess(
+    EntryId l,
+    EntryId r,
+    SortMethod sortMethod,
+    bool isSortDescending) const
+{
+    Entry const & lEntry = mEntries[l];
+    Entry const & rEntry = mEntries[r];
+
+    if (!lEntry.HasMetadata || !rEntry.HasMetadata)
+    {
+        if (lEntry.HasMetadata != rEntry.HasMetadata)
+        {
+            // All metadata-having ones before non-metadata having ones
+            return lEntry.HasMetadata;
+        }
+
+        // Neither has metadata...
+        // ...sort on filename
+        bool const ascendingResult =
+            (lEntry.Filename < rEntry.Filename)
+            || ((lEntry.Filename == rEntry.Filename) && (l < r));
+
+        return (ascendingResult) != (isSortDescending);
+    }
+
+    bool const isNameLess =
+        (lEntry.ShipNameLCase < rEntry.ShipNameLCase)
+        || ((lEntry.ShipNameLCase == rEntry.ShipNameLCase) && (l < r));
+
+    switch (sortMethod)
+    {
+        case SortMethod::ByFeatures:
+        {
+            if (lEntry.FeatureScore != rEntry.FeatureScore)
+            {
+                // We want highest score to be at top
+                return (lEntry.FeatureScore > rEntry.FeatureScore) != (isSortDescending);
+            }
+
+            return isNameLess;
+        }
+
+        case SortMethod::ByLastModified:
+        {
+            if (lEntry.LastWriteTime != rEntry.LastWriteTime)
+            {
+                // We want most recent at top
+                return (lEntry.LastWriteTime > rEntry.LastWriteTime) != (isSortDescending);
+            }
+
+            return isNameLess;
+        }
+
+        case SortMethod::ByName:
+        {
+            return (isNameLess) != (isSortDescending);
+        }
+
+        case SortMethod::ByYearBuilt:
+        {
+            if (lEntry.YearBuilt.has_value()
+                && rEntry.YearBuilt.has_value()
+                && *(lEntry.YearBuilt) != *(rEntry.YearBuilt))
+            {
+                return (*(lEntry.YearBuilt) < *(rEntry.YearBuilt)) != (isSortDescending);
+            }
+            else if (lEntry.YearBuilt == rEntry.YearBuilt) // Either both are set and match values, or neither is set
+            {
+                return isNameLess;
+            }
+            else
+            {
+                // The one with year built on top
+                return lEntry.YearBuilt.has_value();
+            }
+        }
+    }
+
+    assert(false);
+    return false;
+}
+
+void ShipPreviewIndex::BuildPermutation(Permutation & permutation) const
+{
+    permutation.Order.resize(mEntries.size());
+    for (EntryId e = 0; e < mEntries.size(); ++e)
+    {
+        permutation.Order[e] = e;
+    }
+
+    std::sort(
+        permutation.Order.begin(),
+        permutation.Order.end(),
+        [this, &permutation](EntryId l, EntryId r)
+        {
+            return IsLess(l, r, permutation.Method, permutation.IsDescending);
+        });
+
+    permutation.Positions.resize(mEntries.size());
+    for (size_t p = 0; p < permutation.Order.size(); ++p)
+    {
+        permutation.Positions[permutation.Order[p]] = p;
+    }
+}
+
+void ShipPreviewIndex::ResortEntry(
+    EntryId entryId,
+    Permutation & permutation) const
+{
+    // Extract entry
+    size_t const oldPosition = permutation.Positions[entryId];
+    permutation.Order.erase(permutation.Order.cbegin() + oldPosition);
+
+    // Find position
+    auto const it = std::upper_bound(
+        permutation.Order.cbegin(),
+        permutation.Order.cend(),
+        entryId,
+        [this, &permutation](EntryId l, EntryId r)
+        {
+            return IsLess(l, r, permutation.Method, permutation.IsDescending);
+        });
+
+    size_t const newPosition = static_cast<size_t>(std::distance(permutation.Order.cbegin(), it));
+
+    // Insert
+    permutation.Order.insert(it, entryId);
+
+    // Only the entries in between have moved
+    for (size_t p = std::min(oldPosition, newPosition); p <= std::max(oldPosition, newPosition); ++p)
+    {
+        permutation.Positions[permutation.Order[p]] = p;
+    }
+}
+
+void ShipPreviewIndex::AddSearchString(
+    EntryId entryId,
+    std::string && searchString)
+{
+    for (Trigram const trigram : MakeTrigrams(searchString))
+    {
+        auto & postingList = mTrigramIndex[trigram];
+
+        auto const it = std::lower_bound(postingList.begin(), postingList.end(), entryId);
+        if (it == postingList.end() || *it != entryId)
+        {
+            postingList.insert(it, entryId);
+        }
+    }
+
+    mEntries[entryId].SearchStrings.emplace_back(std::move(searchString));
+}
+
+std::vector<ShipPreviewIndex::Trigram> ShipPreviewIndex::MakeTrigrams(std::string const & str)
+{
+    std::vector<Trigram> trigrams;
+
+    for (size_t i = 0; i + 3 <= str.size(); ++i)
+    {
+        trigrams.push_back(
+            (static_cast<Trigram>(static_cast<unsigned char>(str[i])) << 16)
+            | (static_cast<Trigram>(static_cast<unsigned char>(str[i + 1])) << 8)
+            | static_cast<Trigram>(static_cast<unsigned char>(str[i + 2])));
+    }
+
+    std::sort(trigrams.begin(), trigrams.end());
+    trigrams.erase(std::unique(trigrams.begin(), trigrams.end()), trigrams.end());
+
+    return trigrams;
+}
@@ -0,0 +1,175 @@
+/***************************************************************************************
+* Original Author:		Gabriele Giuseppini
+* Created:				2026-10-14
+* Copyright:			Gabriele Giuseppini  (https://github.com/GabrieleGiuseppini)
+***************************************************************************************/
+#pragma once
+
+#include <Game/ShipMetadata.h>
+
+#include <GameCore/PortableTimepoint.h>
+
+#include <array>
+#include <cassert>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/*
+ * The metadata of all the ships in a directory, indexed for searching and sorting.
+ *
+ * Entries are identified by dense IDs (the ship file IDs of the preview window), and are
+ * populated incrementally as their previews arrive.
+ *
+ * Searching looks up a trigram index of the lower-cased search strings of each entry;
+ * sorting is maintained as one permutation of the entries per sort order, each built
+ * the first time it's needed and kept sorted incrementally from then on.
+ */
+class ShipPreviewIndex final
+{
+public:
+
+    using EntryId = size_t;
+
+    enum class SortMethod
+    {
+        ByName = 0,
+        ByLastModified = 1,
+        ByYearBuilt = 2,
+        ByFeatures = 3
+    };
+
+public:
+
+    ShipPreviewIndex(
+        SortMethod sortMethod,
+        bool isSortDescending);
+
+    /*
+     * Replaces all entries with entries without metadata, one for each of the specified
+     * filenames; the ID of each entry is the index of its filename.
+     */
+    void Reset(std::vector<std::string> const & filenames);
+
+    void SetMetadata(
+        EntryId entryId,
+        ShipMetadata const & metadata,
+        int featureScore,
+        PortableTimepoint lastWriteTime);
+
+    void SetSortMethod(
+        SortMethod sortMethod,
+        bool isSortDescending);
+
+    size_t GetEntryCount() const
+    {
+        return mEntries.size();
+    }
+
+    /*
+     * Returns the entry at the specified position of the current sort order.
+     */
+    EntryId GetEntryAt(size_t position) const
+    {
+        assert(position < GetCurrentPermutation().Order.size());
+        return GetCurrentPermutation().Order[position];
+    }
+
+    /*
+     * Returns the position of the specified entry in the current sort order.
+     */
+    size_t GetPositionOf(EntryId entryId) const
+    {
+        assert(entryId < GetCurrentPermutation().Positions.size());
+        return GetCurrentPermutation().Positions[entryId];
+    }
+
+    /*
+     * Finds the position of the first entry - in the current sort order, starting
+     * at the specified position and wrapping around - that has a search string
+     * containing the specified (case-insensitive) text.
+     */
+    std::optional<size_t> FindNext(
+        std::string const & text,
+        size_t startPosition) const;
+
+private:
+
+    struct Entry
+    {
+        std::string Filename;
+        bool HasMetadata;
+        std::string ShipNameLCase;
+        int FeatureScore;
+        PortableTimepoint LastWriteTime;
+        std::optional<std::string> YearBuilt;
+
+        std::vector<std::string> SearchStrings; // Lower-cased
+
+        explicit Entry(std::string const & filename)
+            : Filename(filename)
+            , HasMetadata(false)
+            , ShipNameLCase()
+            , FeatureScore(0)
+            , LastWriteTime(0)
+            , YearBuilt()
+            , SearchStrings()
+        {}
+    };
+
+    struct Permutation
+    {
+        SortMethod Method;
+        bool IsDescending;
+
+        std::vector<EntryId> Order; // Position -> entry
+        std::vector<size_t> Positions; // Entry -> position
+    };
+
+    using Trigram = std::uint32_t;
+
+    static size_t GetPermutationSlot(
+        SortMethod sortMethod,
+        bool isSortDescending)
+    {
+        return static_cast<size_t>(sortMethod) * 2 + (isSortDescending ? 1 : 0);
+    }
+
+    Permutation const & GetCurrentPermutation() const
+    {
+        assert(mPermutations[mCurrentPermutationSlot].has_value());
+        return *mPermutations[mCurrentPermutationSlot];
+    }
+
+    bool IsLess(
+        EntryId l,
+        EntryId r,
+        SortMethod sortMethod,
+        bool isSortDescending) const;
+
+    void BuildPermutation(Permutation & permutation) const;
+
+    void ResortEntry(
+        EntryId entryId,
+        Permutation & permutation) const;
+
+    void AddSearchString(
+        EntryId entryId,
+        std::string && searchString);
+
+    static std::vector<Trigram> MakeTrigrams(std::string const & str);
+
+private:
+
+    std::vector<Entry> mEntries;
+
+    // Trigram -> entries with a search string containing it, sorted by ID; entries
+    // are never removed, hence these are a superset of the entries to be verified
+    std::unordered_map<Trigram, std::vector<EntryId>> mTrigramIndex;
+
+    // One slot per sort method and direction
+    std::array<std::optional<Permutation>, 8> mPermutations;
+    size_t mCurrentPermutationSlot;
+};
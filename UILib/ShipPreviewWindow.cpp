@@ -47,13 +47,16 @@ ShipPreviewWindow::ShipPreviewWindow(
     //
     , mPollQueueTimer()
     , mInfoTiles()
+    , mInfoTileIndex(SortMethod::ByName, false)
     , mSelectedShipFileId()
     , mSortMethod(SortMethod::ByName)
     , mIsSortDescending(false)
-    , mSortPredicate(MakeSortPredicate(mSortMethod, mIsSortDescending))
     , mCurrentlyCompletedDirectorySnapshot()
     //
+    , mThumbnailStore(ShipPreviewThumbnailStore::GetShared(resourceLocator.GetShipPreviewThumbnailStoreFilePath()))
     , mPreviewThread()
+    , mVisibleShipFileIds()
+    , mVisibleShipFileIdsMutex()
     , mPanelToThreadMessage()
     , mPanelToThreadMessageMutex()
     , mPanelToThreadMessageEvent()
@@ -222,31 +225,13 @@ bool ShipPreviewWindow::Search(std::string const & shipName)
 {
     assert(!shipName.empty());
 
-    std::string const shipNameLCase = Utils::ToLower(shipName);
-
     //
     // Find next ship that contains the requested name as a substring,
     // doing a circular search from the currently-selected ship
     //
 
-    std::optional<size_t> foundShipIndex;
-    size_t startInfoTileIndex = mSelectedShipFileId ? (ShipFileIdToInfoTileIndex(*mSelectedShipFileId) + 1) : 0;
-    for (size_t i = 0; i < mInfoTiles.size(); ++i)
-    {
-        size_t const shipInfoTileIndex = (startInfoTileIndex + i) % mInfoTiles.size();
-
-        if (std::any_of(
-            mInfoTiles[shipInfoTileIndex].SearchStrings.cbegin(),
-            mInfoTiles[shipInfoTileIndex].SearchStrings.cend(),
-            [&shipNameLCase](auto const & str)
-            {
-                return str.find(shipNameLCase) != std::string::npos;
-            }))
-        {
-            foundShipIndex = shipInfoTileIndex;
-            break;
-        }
-    }
+    size_t const startInfoTileIndex = mSelectedShipFileId ? (ShipFileIdToInfoTileIndex(*mSelectedShipFileId) + 1) : 0;
+    std::optional<size_t> const foundShipIndex = mInfoTileIndex.FindNext(shipName, startInfoTileIndex);
 
     if (foundShipIndex.has_value())
     {
@@ -269,7 +254,6 @@ bool ShipPreviewWindow::Search(std::string const & shipName)
 void ShipPreviewWindow::SetSortMethod(SortMethod sortMethod)
 {
     mSortMethod = sortMethod;
-    RefreshSortPredicate();
     SortInfoTiles();
     Refresh();
 }
@@ -277,7 +261,6 @@ void ShipPreviewWindow::SetSortMethod(SortMethod sortMethod)
 void ShipPreviewWindow::SetIsSortDescending(bool isSortDescending)
 {
     mIsSortDescending = isSortDescending;
-    RefreshSortPredicate();
     SortInfoTiles();
     Refresh();
 }
@@ -413,10 +396,7 @@ void ShipPreviewWindow::OnPollQueueTimer(wxTimerEvent & /*event*/)
                 // Populate info tile
                 //
 
-                size_t const infoTileIndex = ShipFileIdToInfoTileIndex(message->GetShipFileId());
-                assert(infoTileIndex < mInfoTiles.size());
-
-                auto & infoTile = mInfoTiles[infoTileIndex];
+                auto & infoTile = GetInfoTile(message->GetShipFileId());
 
                 ShipPreviewData const & shipPreviewData = message->GetShipPreviewData();
 
@@ -456,37 +436,12 @@ void ShipPreviewWindow::OnPollQueueTimer(wxTimerEvent & /*event*/)
 
                 infoTile.Metadata.emplace(shipPreviewData.Metadata);
 
-                // Add ship name to search map
-                infoTile.SearchStrings.push_back(
-                    Utils::ToLower(
-                        shipPreviewData.Metadata.ShipName));
-
-                // Add author to search map
-                if (shipPreviewData.Metadata.Author.has_value())
-                {
-                    infoTile.SearchStrings.push_back(
-                        Utils::ToLower(
-                            *(shipPreviewData.Metadata.Author)));
-                }
-
-                // Add art credits to search map
-                if (shipPreviewData.Metadata.ArtCredits.has_value())
-                {
-                    infoTile.SearchStrings.push_back(
-                        Utils::ToLower(
-                            *(shipPreviewData.Metadata.ArtCredits)));
-                }
-
-                // Add ship year to search map
-                if (shipPreviewData.Metadata.YearBuilt.has_value())
-                {
-                    infoTile.SearchStrings.push_back(
-                        Utils::ToLower(
-                            *(shipPreviewData.Metadata.YearBuilt)));
-                }
-
-                // Re-sort this info tile
-                ResortInfoTile(infoTileIndex);
+                // Index this info tile for search, and re-sort it
+                mInfoTileIndex.SetMetadata(
+                    infoTile.ShipFileId.Value,
+                    shipPreviewData.Metadata,
+                    infoTile.FeatureScore,
+                    infoTile.LastWriteTime);
 
                 // Remember we need to refresh now
                 haveInfoTilesBeenUpdated = true;
@@ -500,15 +455,13 @@ void ShipPreviewWindow::OnPollQueueTimer(wxTimerEvent & /*event*/)
                 // Set error image
                 //
 
-                size_t const infoTileIndex = ShipFileIdToInfoTileIndex(message->GetShipFileId());
-                assert(infoTileIndex < mInfoTiles.size());
-                
-                mInfoTiles[infoTileIndex].Bitmap = mErrorBitmap;
-                mInfoTiles[infoTileIndex].OriginalDescription1 = message->GetErrorMessage();
-                mInfoTiles[infoTileIndex].DescriptionLabel1Size.reset();
+                auto & infoTile = GetInfoTile(message->GetShipFileId());
+
+                infoTile.Bitmap = mErrorBitmap;
+                infoTile.OriginalDescription1 = message->GetErrorMessage();
+                infoTile.DescriptionLabel1Size.reset();
 
-                // Re-sort this info tile
-                ResortInfoTile(infoTileIndex);
+                // No need to re-sort this info tile, as without metadata it keeps being sorted by filename
 
                 // Remember we need to refresh now
                 haveInfoTilesBeenUpdated = true;
@@ -540,9 +493,11 @@ void ShipPreviewWindow::OnPollQueueTimer(wxTimerEvent & /*event*/)
 
 void ShipPreviewWindow::SelectInfoTile(size_t infoTileIndex)
 {
-    bool isDirty = (mSelectedShipFileId != mInfoTiles[infoTileIndex].ShipFileId);
+    auto const & infoTile = GetInfoTileAt(infoTileIndex);
+
+    bool isDirty = (mSelectedShipFileId != infoTile.ShipFileId);
 
-    mSelectedShipFileId = mInfoTiles[infoTileIndex].ShipFileId;
+    mSelectedShipFileId = infoTile.ShipFileId;
 
     if (isDirty)
     {
@@ -556,8 +511,8 @@ void ShipPreviewWindow::SelectInfoTile(size_t infoTileIndex)
         auto event = fsShipFileSelectedEvent(
             fsEVT_SHIP_FILE_SELECTED,
             this->GetId(),
-            mInfoTiles[infoTileIndex].Metadata,
-            mInfoTiles[infoTileIndex].ShipFilepath);
+            infoTile.Metadata,
+            infoTile.ShipFilepath);
 
         ProcessWindowEvent(event);
     }
@@ -572,7 +527,7 @@ void ShipPreviewWindow::ChooseInfoTile(size_t infoTileIndex)
     auto event = fsShipFileChosenEvent(
         fsEVT_SHIP_FILE_CHOSEN,
         this->GetId(),
-        mInfoTiles[infoTileIndex].ShipFilepath);
+        GetInfoTileAt(infoTileIndex).ShipFilepath);
 
     ProcessWindowEvent(event);
 }
@@ -590,15 +545,29 @@ void ShipPreviewWindow::ResetInfoTiles(DirectorySnapshot const & directorySnapsh
             fileEntry.ShipFileId,
             fileEntry.FilePath,
             mWaitBitmap);
+    }
+
+    // Store info tiles by ship file ID - which are dense
+    std::sort(
+        mInfoTiles.begin(),
+        mInfoTiles.end(),
+        [](InfoTile const & l, InfoTile const & r)
+        {
+            return l.ShipFileId < r.ShipFileId;
+        });
 
-        // Add ship filename to search map
-        mInfoTiles.back().SearchStrings.push_back(
-            Utils::ToLower(
-                fileEntry.FilePath.filename().string()));
+    // Index info tiles, which sorts them according to the current sort method
+    std::vector<std::string> filenames;
+    filenames.reserve(mInfoTiles.size());
+    for (auto const & infoTile : mInfoTiles)
+    {
+        assert(infoTile.ShipFileId.Value == filenames.size());
+        filenames.emplace_back(infoTile.ShipFilepath.filename().string());
     }
 
-    // Sort info tiles according to current sort method
-    SortInfoTiles();
+    mInfoTileIndex.Reset(filenames);
+
+    EnsureSelectedShipIsVisible();
 
     // Recalculate geometry
     RecalculateGeometry(mClientSize, static_cast<int>(mInfoTiles.size()));
@@ -610,46 +579,13 @@ void ShipPreviewWindow::ResetInfoTiles(DirectorySnapshot const & directorySnapsh
 
 void ShipPreviewWindow::SortInfoTiles()
 {
-    std::sort(
-        mInfoTiles.begin(),
-        mInfoTiles.end(),
-        mSortPredicate);
+    // Cheap when we've been sorted this way before, as the index keeps
+    // all the sort orders it has made up-to-date
+    mInfoTileIndex.SetSortMethod(mSortMethod, mIsSortDescending);
 
     EnsureSelectedShipIsVisible();
 }
 
-void ShipPreviewWindow::ResortInfoTile(size_t infoTileIndex)
-{
-    // Extract item
-    InfoTile infoTile = std::move(mInfoTiles[infoTileIndex]);
-    mInfoTiles.erase(mInfoTiles.cbegin() + infoTileIndex);
-
-    // Find position
-    auto const it = std::upper_bound(
-        mInfoTiles.cbegin(),
-        mInfoTiles.cend(),
-        infoTile,
-        mSortPredicate);
-
-    // Insert
-    mInfoTiles.insert(it, std::move(infoTile));
-}
-
-size_t ShipPreviewWindow::ShipFileIdToInfoTileIndex(ShipFileId_t shipFileId) const
-{
-    // Search for info tile with this ship file ID
-    for (size_t i = 0; i < mInfoTiles.size(); ++i)
-    {
-        if (mInfoTiles[i].ShipFileId == shipFileId)
-        {
-            return i;
-        }
-    }
-
-    assert(false);
-    return std::numeric_limits<size_t>::max();
-}
-
 wxRect ShipPreviewWindow::InfoTileIndexToRectVirtual(size_t infoTileIndex) const
 {
     int const iCol = static_cast<int>(infoTileIndex % mCols);
@@ -660,162 +596,6 @@ wxRect ShipPreviewWindow::InfoTileIndexToRectVirtual(size_t infoTileIndex) const
     return wxRect(x, y, mColumnWidth, RowHeight);
 }
 
-void ShipPreviewWindow::RefreshSortPredicate()
-{
-    mSortPredicate = MakeSortPredicate(mSortMethod, mIsSortDescending);
-}
-
-std::function<bool(ShipPreviewWindow::InfoTile const &, ShipPreviewWindow::InfoTile const &)> ShipPreviewWindow::MakeSortPredicate(SortMethod sortMethod, bool isSortDescending)
-{
-    std::function<bool(InfoTile const &, InfoTile const &)> metadataPredicate;
-
-    switch (sortMethod)
-    {
-        case SortMethod::ByFeatures:
-        {
-            metadataPredicate = [isSortDescending](InfoTile const & l, InfoTile const & r) -> bool
-            {
-                assert(l.Metadata.has_value() && r.Metadata.has_value());
-
-                if (l.FeatureScore > r.FeatureScore) // We want highest score to be at top
-                {
-                    return (true) != (isSortDescending);
-                }
-                else if (l.FeatureScore == r.FeatureScore)
-                {
-                    auto const lShipNameI = Utils::ToLower(l.Metadata->ShipName);
-                    auto const rShipNameI = Utils::ToLower(r.Metadata->ShipName);
-
-                    return
-                        (lShipNameI < rShipNameI)
-                        || ((lShipNameI == rShipNameI) && (l.ShipFileId < r.ShipFileId));
-                }
-                else
-                {
-                    return (false) != (isSortDescending);
-                }
-            };
-
-            break;
-        }
-
-        case SortMethod::ByLastModified:
-        {
-            metadataPredicate = [isSortDescending](InfoTile const & l, InfoTile const & r) -> bool
-            {
-                assert(l.Metadata.has_value() && r.Metadata.has_value());
-
-                if (l.LastWriteTime > r.LastWriteTime) // We want most recent at top
-                {
-                    return (true) != (isSortDescending);
-                }
-                else if (l.LastWriteTime == r.LastWriteTime)
-                {
-                    auto const lShipNameI = Utils::ToLower(l.Metadata->ShipName);
-                    auto const rShipNameI = Utils::ToLower(r.Metadata->ShipName);
-
-                    return
-                        (lShipNameI < rShipNameI)
-                        || ((lShipNameI == rShipNameI) && (l.ShipFileId < r.ShipFileId));
-                }
-                else
-                {
-                    return (false) != (isSortDescending);
-                }
-            };
-
-            break;
-        }
-
-        case SortMethod::ByName:
-        {
-            metadataPredicate = [isSortDescending](InfoTile const & l, InfoTile const & r) -> bool
-            {
-                assert(l.Metadata.has_value() && r.Metadata.has_value());
-
-                auto const lShipNameI = Utils::ToLower(l.Metadata->ShipName);
-                auto const rShipNameI = Utils::ToLower(r.Metadata->ShipName);
-
-                bool const ascendingResult =
-                    (lShipNameI < rShipNameI)
-                    || ((lShipNameI == rShipNameI) && (l.ShipFileId < r.ShipFileId));
-
-                return (ascendingResult) != (isSortDescending);
-            };
-
-            break;
-        }
-
-        case SortMethod::ByYearBuilt:
-        {
-            metadataPredicate = [isSortDescending](InfoTile const & l, InfoTile const & r) -> bool
-            {
-                assert(l.Metadata.has_value() && r.Metadata.has_value());
-
-                if (l.Metadata->YearBuilt.has_value() 
-                    && r.Metadata->YearBuilt.has_value()
-                    && *(l.Metadata->YearBuilt) != *(r.Metadata->YearBuilt))
-                {
-                    return (*(l.Metadata->YearBuilt) < *(r.Metadata->YearBuilt)) != (isSortDescending);
-                }
-                else if (l.Metadata->YearBuilt == r.Metadata->YearBuilt) // Either both are set and match values, or neither is set
-                {
-                    auto const lShipNameI = Utils::ToLower(l.Metadata->ShipName);
-                    auto const rShipNameI = Utils::ToLower(r.Metadata->ShipName);
-
-                    return
-                        (lShipNameI < rShipNameI)
-                        || ((lShipNameI == rShipNameI) && (l.ShipFileId < r.ShipFileId));
-                }
-                else
-                {
-                    assert(l.Metadata->YearBuilt.has_value() != r.Metadata->YearBuilt.has_value());
-
-                    if (l.Metadata->YearBuilt.has_value())
-                    {
-                        // L has year built, R has not: L on top
-                        return true;
-                    }
-                    else
-                    {
-                        // L has no year built, R has it: R on top
-                        return false;
-                    }
-                }
-            };
-
-            break;
-        }
-    }
-
-    return [isSortDescending, metadataPredicate=std::move(metadataPredicate)](InfoTile const & l, InfoTile const & r) -> bool
-    {
-        if (l.Metadata.has_value())
-        {
-            if (r.Metadata.has_value())
-            {
-                return metadataPredicate(l, r);
-            }
-            else
-            {
-                // L has metadata, R not
-                return true; // All metadata-having ones before non-metadata having ones
-            }
-        }
-        else if (r.Metadata.has_value())
-        {
-            // L has no metadata, R has metadata
-            return false; // All metadata-having ones before non-metadata having ones
-        }
-        else
-        {
-            // Neither has metadata...
-            // ...sort on filename
-            return (l.ShipFilepath.filename() < r.ShipFilepath.filename()) != (isSortDescending);
-        }
-    };
-}
-
 ShipPreviewWindow::DirectorySnapshot ShipPreviewWindow::EnumerateShipFiles(std::filesystem::path const & directoryPath)
 {
     std::vector<std::tuple<std::filesystem::path, std::filesystem::file_time_type>> files;
@@ -997,15 +777,24 @@ void ShipPreviewWindow::Render(wxDC & dc)
         // Calculate left margin for content of info tile
         int const infoTileContentLeftMargin = mExpandedHorizontalMargin / 2 + InfoTileInset;
 
-        // Process all info tiles
-        for (size_t i = 0; i < mInfoTiles.size(); ++i)
+        std::vector<ShipFileId_t> visibleShipFileIds;
+
+        // Process the info tiles in the visible rows
+        assert(mCols > 0);
+        size_t const firstVisibleInfoTileIndex = static_cast<size_t>(std::max(visibleRectVirtual.GetTop() / RowHeight, 0) * mCols);
+        size_t const endVisibleInfoTileIndex = std::min(
+            static_cast<size_t>((std::max(visibleRectVirtual.GetBottom() / RowHeight, 0) + 1) * mCols),
+            mInfoTiles.size());
+        for (size_t i = firstVisibleInfoTileIndex; i < endVisibleInfoTileIndex; ++i)
         {
             wxRect const infoTileRectVirtual = InfoTileIndexToRectVirtual(i);
-            auto & infoTile = mInfoTiles[i];
+            auto & infoTile = GetInfoTileAt(i);
 
             // Check if this info tile's virtual rect intersects the visible one
             if (visibleRectVirtual.Intersects(infoTileRectVirtual))
             {
+                visibleShipFileIds.push_back(infoTile.ShipFileId);
+
                 //
                 // Bitmap
                 //
@@ -1147,7 +936,7 @@ void ShipPreviewWindow::Render(wxDC & dc)
                 // Selection
                 //
 
-                if (mInfoTiles[i].ShipFileId == mSelectedShipFileId)
+                if (infoTile.ShipFileId == mSelectedShipFileId)
                 {
                     dc.SetPen(mSelectionPen);
                     dc.SetBrush(*wxTRANSPARENT_BRUSH);
@@ -1159,6 +948,9 @@ void ShipPreviewWindow::Render(wxDC & dc)
                 }
             }
         }
+
+        // Tell the preview thread what to load first
+        PublishVisibleShipFileIds(std::move(visibleShipFileIds));
     }
 }
 
@@ -1185,6 +977,9 @@ void ShipPreviewWindow::RunPreviewThread()
 {
     LogMessage("PreviewThread::Enter");
 
+    // The pool previews are loaded on - together with this thread
+    TaskThreadPool taskThreadPool;
+
     while (true)
     {
         //
@@ -1222,7 +1017,9 @@ void ShipPreviewWindow::RunPreviewThread()
 
             try
             {
-                ScanDirectorySnapshot(std::move(message->GetDirectorySnapshot()));
+                ScanDirectorySnapshot(
+                    std::move(message->GetDirectorySnapshot()),
+                    taskThreadPool);
             }
             catch (std::exception const & ex)
             {
@@ -1258,60 +1055,115 @@ void ShipPreviewWindow::RunPreviewThread()
     LogMessage("PreviewThread::Exit");
 }
 
-void ShipPreviewWindow::ScanDirectorySnapshot(DirectorySnapshot && directorySnapshot)
+void ShipPreviewWindow::ScanDirectorySnapshot(
+    DirectorySnapshot && directorySnapshot,
+    TaskThreadPool & taskThreadPool)
 {
     LogMessage("PreviewThread::ScanDirectorySnapshot(", directorySnapshot.DirectoryPath.string(), "): processing...");
 
-    auto previewDirectoryManager = ShipPreviewDirectoryManager::Create(directorySnapshot.DirectoryPath);
+    auto previewDirectoryManager = ShipPreviewDirectoryManager::Create(
+        directorySnapshot.DirectoryPath,
+        mThumbnailStore);
 
     //
-    // Process all files and create previews
+    // Process all files and create previews, in batches of a few files each;
+    // at each batch we pick first the files whose tiles are visible at that moment
     //
 
-    for (auto fileIt = directorySnapshot.FileEntries.cbegin(); fileIt != directorySnapshot.FileEntries.cend(); ++fileIt)
+    size_t const fileCount = directorySnapshot.FileEntries.size();
+
+    // Ship file IDs are assigned before files are sorted
+    std::vector<size_t> fileEntryIndexByShipFileId(fileCount);
+    for (size_t f = 0; f < fileCount; ++f)
+    {
+        assert(directorySnapshot.FileEntries[f].ShipFileId.Value < fileCount);
+        fileEntryIndexByShipFileId[directorySnapshot.FileEntries[f].ShipFileId.Value] = f;
+    }
+
+    std::vector<bool> isFileEntryProcessed(fileCount, false);
+    size_t nextFileEntryIndex = 0;
+    size_t processedFileCount = 0;
+
+    size_t const batchSize = taskThreadPool.GetParallelism() * 2;
+    std::vector<size_t> batchFileEntryIndices;
+    std::vector<TaskThreadPool::Task> tasks;
+
+    while (processedFileCount < fileCount)
     {
         // Check whether we have been interrupted
         if (!!mPanelToThreadMessage)
         {
-            LogMessage("PreviewThread::ScanDirectorySnapshot(): interrupted, exiting");
+            break;
+        }
 
-            // Commit - with a partial visit
-            previewDirectoryManager->Commit(false);
+        //
+        // Build batch
+        //
 
-            return;
-        }
+        batchFileEntryIndices.clear();
 
-        try
         {
-            // Load preview data
-            auto shipPreviewData = ShipDeSerializer::LoadShipPreviewData(fileIt->FilePath);
-
-            // Load preview image
-            auto shipPreviewImage = previewDirectoryManager->LoadPreviewImage(shipPreviewData, PreviewImageSize);
-
-            // Notify
-            QueueThreadToPanelMessage(
-                ThreadToPanelMessage::MakePreviewReadyMessage(
-                    fileIt->ShipFileId,
-                    std::move(shipPreviewData),
-                    std::move(shipPreviewImage)));
+            std::lock_guard const lock{ mVisibleShipFileIdsMutex };
+
+            for (auto const & shipFileId : mVisibleShipFileIds)
+            {
+                if (batchFileEntryIndices.size() == batchSize)
+                    break;
+
+                if (shipFileId.Value < fileCount)
+                {
+                    size_t const f = fileEntryIndexByShipFileId[shipFileId.Value];
+                    if (!isFileEntryProcessed[f])
+                    {
+                        batchFileEntryIndices.push_back(f);
+                        isFileEntryProcessed[f] = true;
+                    }
+                }
+            }
         }
-        catch (std::exception const & ex)
+
+        for (; nextFileEntryIndex < fileCount && batchFileEntryIndices.size() < batchSize; ++nextFileEntryIndex)
         {
-            LogMessage("PreviewThread::ScanDirectorySnapshot(): encountered error (", std::string(ex.what()), "), notifying...");
+            if (!isFileEntryProcessed[nextFileEntryIndex])
+            {
+                batchFileEntryIndices.push_back(nextFileEntryIndex);
+                isFileEntryProcessed[nextFileEntryIndex] = true;
+            }
+        }
 
-            // Notify
-            QueueThreadToPanelMessage(
-                ThreadToPanelMessage::MakePreviewErrorMessage(
-                    fileIt->ShipFileId,
-                    "Cannot load preview"));
+        processedFileCount += batchFileEntryIndices.size();
 
-            LogMessage("PreviewThread::ScanDirectorySnapshot(): ...error notified.");
+        //
+        // Run batch
+        //
 
-            // Keep going
+        tasks.clear();
+
+        for (size_t const f : batchFileEntryIndices)
+        {
+            tasks.emplace_back(
+                [this, &fileEntry = directorySnapshot.FileEntries[f], &previewDirectoryManager]()
+                {
+                    // Don't bother if we have been interrupted in the meantime
+                    if (!mPanelToThreadMessage)
+                    {
+                        LoadPreview(fileEntry, *previewDirectoryManager);
+                    }
+                });
         }
+
+        taskThreadPool.Run(tasks);
     }
 
+    if (!!mPanelToThreadMessage)
+    {
+        LogMessage("PreviewThread::ScanDirectorySnapshot(): interrupted, exiting");
+
+        // Commit - with a partial visit
+        previewDirectoryManager->Commit(false);
+
+        return;
+    }
 
     //
     // Notify completion
@@ -1330,6 +1182,49 @@ void ShipPreviewWindow::ScanDirectorySnapshot(DirectorySnapshot && directorySnap
     LogMessage("PreviewThread::ScanDirectorySnapshot(): ...preview completed.");
 }
 
+void ShipPreviewWindow::LoadPreview(
+    DirectorySnapshot::FileEntry const & fileEntry,
+    ShipPreviewDirectoryManager & previewDirectoryManager)
+{
+    try
+    {
+        // Load preview data
+        auto shipPreviewData = ShipDeSerializer::LoadShipPreviewData(fileEntry.FilePath);
+
+        // Load preview image
+        auto shipPreviewImage = previewDirectoryManager.LoadPreviewImage(shipPreviewData, PreviewImageSize);
+
+        // Notify
+        QueueThreadToPanelMessage(
+            ThreadToPanelMessage::MakePreviewReadyMessage(
+                fileEntry.ShipFileId,
+                std::move(shipPreviewData),
+                std::move(shipPreviewImage)));
+    }
+    catch (std::exception const & ex)
+    {
+        LogMessage("PreviewThread::LoadPreview(): encountered error (", std::string(ex.what()), "), notifying...");
+
+        // Notify
+        QueueThreadToPanelMessage(
+            ThreadToPanelMessage::MakePreviewErrorMessage(
+                fileEntry.ShipFileId,
+                "Cannot load preview"));
+
+        LogMessage("PreviewThread::LoadPreview(): ...error notified.");
+    }
+}
+
+void ShipPreviewWindow::PublishVisibleShipFileIds(std::vector<ShipFileId_t> && visibleShipFileIds)
+{
+    std::lock_guard const lock{ mVisibleShipFileIdsMutex };
+
+    if (visibleShipFileIds != mVisibleShipFileIds)
+    {
+        mVisibleShipFileIds = std::move(visibleShipFileIds);
+    }
+}
+
 void ShipPreviewWindow::QueueThreadToPanelMessage(std::unique_ptr<ThreadToPanelMessage> message)
 {
     // Lock queue
@@ -5,12 +5,17 @@
 ***************************************************************************************/
 #pragma once
 
+#include "ShipPreviewIndex.h"
+
 #include <Game/ResourceLocator.h>
 #include <Game/ShipPreviewData.h>
+#include <Game/ShipPreviewDirectoryManager.h>
+#include <Game/ShipPreviewThumbnailStore.h>
 
 #include <GameCore/ImageData.h>
 #include <GameCore/PortableTimepoint.h>
 #include <GameCore/StrongTypeDef.h>
+#include <GameCore/TaskThreadPool.h>
 
 #include <wx/timer.h>
 #include <wx/wx.h>
@@ -131,13 +136,7 @@ public:
     // Sort method
     //
 
-    enum class SortMethod
-    {
-        ByName = 0,
-        ByLastModified = 1,
-        ByYearBuilt = 2,
-        ByFeatures = 3
-    };
+    using SortMethod = ShipPreviewIndex::SortMethod;
 
 public:
 
@@ -333,8 +332,6 @@ private:
 
         std::optional<ShipMetadata> Metadata;
 
-        std::vector<std::string> SearchStrings;
-
         InfoTile(
             ShipFileId_t shipFileId,
             std::filesystem::path const & shipFilepath,
@@ -362,15 +359,23 @@ private:
 
     void SortInfoTiles();
 
-    void ResortInfoTile(size_t infoTileIndex);
-
-    size_t ShipFileIdToInfoTileIndex(ShipFileId_t shipFileId) const;
+    InfoTile & GetInfoTileAt(size_t infoTileIndex)
+    {
+        return mInfoTiles[mInfoTileIndex.GetEntryAt(infoTileIndex)];
+    }
 
-    wxRect InfoTileIndexToRectVirtual(size_t infoTileIndex) const;
+    InfoTile & GetInfoTile(ShipFileId_t shipFileId)
+    {
+        assert(shipFileId.Value < mInfoTiles.size());
+        return mInfoTiles[shipFileId.Value];
+    }
 
-    void RefreshSortPredicate();
+    size_t ShipFileIdToInfoTileIndex(ShipFileId_t shipFileId) const
+    {
+        return mInfoTileIndex.GetPositionOf(shipFileId.Value);
+    }
 
-    static std::function<bool(InfoTile const &, InfoTile const &)> MakeSortPredicate(SortMethod sortMethod, bool isSortDescending);
+    wxRect InfoTileIndexToRectVirtual(size_t infoTileIndex) const;
 
     DirectorySnapshot EnumerateShipFiles(std::filesystem::path const & directoryPath);
 
@@ -419,8 +424,10 @@ private:
 
     std::unique_ptr<wxTimer> mPollQueueTimer;
 
-    // The info tiles currently populated; always sorted by the current sort method
+    // The info tiles currently populated, by ship file ID; info tile indices are
+    // positions in the current sort order of the index
     std::vector<InfoTile> mInfoTiles;
+    ShipPreviewIndex mInfoTileIndex;
 
     // The currently-selected ship file ID (hence info tile index)
     std::optional<ShipFileId_t> mSelectedShipFileId;
@@ -428,7 +435,6 @@ private:
     // The current sorting of the info tiles
     SortMethod mSortMethod;
     bool mIsSortDescending;
-    std::function<bool(InfoTile const &, InfoTile const &)> mSortPredicate;
 
     // When set, indicates that the preview of this directory is completed
     std::optional<DirectorySnapshot> mCurrentlyCompletedDirectorySnapshot;
@@ -437,10 +443,31 @@ private:
     // Preview Thread
     ////////////////////////////////////////////////
 
+    // The thumbnails shared by all ship load dialogs
+    std::shared_ptr<ShipPreviewThumbnailStore> mThumbnailStore;
+
     std::thread mPreviewThread;
 
     void RunPreviewThread();
-    void ScanDirectorySnapshot(DirectorySnapshot && directorySnapshot);
+
+    void ScanDirectorySnapshot(
+        DirectorySnapshot && directorySnapshot,
+        TaskThreadPool & taskThreadPool);
+
+    void LoadPreview(
+        DirectorySnapshot::FileEntry const & fileEntry,
+        ShipPreviewDirectoryManager & previewDirectoryManager);
+
+    //
+    // Panel-to-Thread visibility
+    //
+
+    void PublishVisibleShipFileIds(std::vector<ShipFileId_t> && visibleShipFileIds);
+
+    // The ship files whose info tiles are currently visible, which the
+    // preview thread loads first
+    std::vector<ShipFileId_t> mVisibleShipFileIds;
+    std::mutex mVisibleShipFileIdsMutex;
 
     //
     // Panel-to-Thread communication
@@ -3,6 +3,11 @@
 
 #include "gtest/gtest.h"
 
+#include <algorithm>
+#include <tuple>
+#include <utility>
+#include <vector>
+
 TEST(AABBTests, AABB_Contains)
 {
     Geometry::AABB t(10.0f, 20.0f, 100.0f, 90.0f);
@@ -48,3 +53,98 @@ TEST(AABBTests, AABBSet_MakeUnion)
     EXPECT_EQ(res->TopRight, vec2f(25.0f, 100.0f));
     EXPECT_EQ(res->BottomLeft, vec2f(10.0f, 70.0f));
 }
+
+TEST(AABBTests, AABB_Intersects)
+{
+    Geometry::AABB t(10.0f, 20.0f, 100.0f, 90.0f);
+
+    EXPECT_TRUE(t.Intersects(Geometry::AABB(15.0f, 25.0f, 95.0f, 85.0f)));
+    EXPECT_TRUE(t.Intersects(Geometry::AABB(20.0f, 30.0f, 100.0f, 90.0f))); // Touching
+    EXPECT_FALSE(t.Intersects(Geometry::AABB(21.0f, 30.0f, 100.0f, 90.0f)));
+    EXPECT_FALSE(t.Intersects(Geometry::AABB(10.0f, 20.0f, 80.0f, 70.0f)));
+}
+
+TEST(AABBTests, AABBSet_BroadPhaseQueriesMatchLinearScans)
+{
+    Geometry::AABBSet t;
+    t.Add(Geometry::AABB(50.0f, 60.0f, 10.0f, 0.0f));
+    t.Add(Geometry::AABB(0.0f, 10.0f, 10.0f, 0.0f));
+    t.Add(Geometry::AABB(5.0f, 15.0f, 5.0f, -5.0f));
+    t.Add(Geometry::AABB(55.0f, 58.0f, 30.0f, 20.0f));
+
+    auto const runQueries = [&t]()
+    {
+        std::vector<size_t> overlapping;
+        t.ForEachOverlapping(
+            Geometry::AABB(8.0f, 52.0f, 2.0f, 1.0f),
+            [&](size_t i)
+            {
+                overlapping.push_back(i);
+            });
+        std::sort(overlapping.begin(), overlapping.end());
+
+        std::vector<std::pair<size_t, size_t>> pairs;
+        t.ForEachOverlappingPair(
+            [&](size_t i, size_t j)
+            {
+                pairs.emplace_back(i, j);
+            });
+        std::sort(pairs.begin(), pairs.end());
+
+        return std::make_tuple(
+            overlapping,
+            pairs,
+            t.Contains(vec2f(12.0f, -4.0f)),
+            t.Contains(vec2f(56.0f, 15.0f)),
+            t.Contains(vec2f(56.0f, 15.0f), 5.0f));
+    };
+
+    // Linear scans
+    auto const linearResults = runQueries();
+
+    EXPECT_EQ(std::get<0>(linearResults), std::vector<size_t>({ 0, 1, 2 }));
+    EXPECT_EQ(std::get<1>(linearResults), (std::vector<std::pair<size_t, size_t>>({ { 1, 2 } })));
+    EXPECT_TRUE(std::get<2>(linearResults));
+    EXPECT_FALSE(std::get<3>(linearResults));
+    EXPECT_TRUE(std::get<4>(linearResults));
+
+    // Broad phase
+    t.UpdateBroadPhase();
+
+    EXPECT_EQ(runQueries(), linearResults);
+}
+
+TEST(AABBTests, AABBSet_BroadPhaseIsRebuiltAfterRefill)
+{
+    Geometry::AABBSet t;
+    t.Add(Geometry::AABB(0.0f, 10.0f, 10.0f, 0.0f));
+    t.Add(Geometry::AABB(20.0f, 30.0f, 10.0f, 0.0f));
+    t.Add(Geometry::AABB(40.0f, 50.0f, 10.0f, 0.0f));
+    t.UpdateBroadPhase();
+
+    // Fewer AABBs, in reverse order
+    t.Clear();
+    t.Add(Geometry::AABB(100.0f, 110.0f, 10.0f, 0.0f));
+    t.Add(Geometry::AABB(-10.0f, 5.0f, 10.0f, 0.0f));
+    t.UpdateBroadPhase();
+
+    EXPECT_TRUE(t.Contains(vec2f(105.0f, 5.0f)));
+    EXPECT_TRUE(t.Contains(vec2f(0.0f, 5.0f)));
+    EXPECT_FALSE(t.Contains(vec2f(25.0f, 5.0f)));
+
+    // More AABBs
+    t.Add(Geometry::AABB(20.0f, 30.0f, 10.0f, 0.0f));
+    t.Add(Geometry::AABB(25.0f, 35.0f, 10.0f, 0.0f));
+    t.UpdateBroadPhase();
+
+    EXPECT_TRUE(t.Contains(vec2f(25.0f, 5.0f)));
+
+    std::vector<std::pair<size_t, size_t>> pairs;
+    t.ForEachOverlappingPair(
+        [&](size_t i, size_t j)
+        {
+            pairs.emplace_back(i, j);
+        });
+
+    EXPECT_EQ(pairs, (std::vector<std::pair<size_t, size_t>>({ { 2, 3 } })));
+}
@@ -0,0 +1,100 @@
+#include <GameCore/ActiveElementSet.h>
+
+#include "gtest/gtest.h"
+
+TEST(ActiveElementSetTests, Empty)
+{
+    ActiveElementSet set(10, 2);
+
+    EXPECT_TRUE(set.IsEmpty());
+    EXPECT_EQ(0u, set.GetSize());
+    EXPECT_FALSE(set.Contains(0));
+    EXPECT_TRUE(set.GetMembers().empty());
+}
+
+TEST(ActiveElementSetTests, Add_MembersAreSortedAndUnique)
+{
+    ActiveElementSet set(10, 2);
+
+    set.Add(7);
+    set.Add(2);
+    set.Add(7);
+    set.Add(5);
+
+    EXPECT_EQ(3u, set.GetSize());
+    EXPECT_TRUE(set.Contains(2));
+    EXPECT_TRUE(set.Contains(5));
+    EXPECT_TRUE(set.Contains(7));
+    EXPECT_FALSE(set.Contains(3));
+
+    EXPECT_EQ(std::vector<ElementIndex>({ 2, 5, 7 }), set.GetMembers());
+
+    // Merge with previously-sorted members
+    set.Add(9);
+    set.Add(0);
+    set.Add(6);
+
+    EXPECT_EQ(std::vector<ElementIndex>({ 0, 2, 5, 6, 7, 9 }), set.GetMembers());
+}
+
+TEST(ActiveElementSetTests, Update_RemovesAfterHysteresis)
+{
+    ActiveElementSet set(10, 2);
+
+    set.Add(3);
+    set.Add(4);
+
+    auto const isInactive = [](ElementIndex e) { return e == 3; };
+
+    set.Update(isInactive);
+    set.Update(isInactive);
+    EXPECT_TRUE(set.Contains(3));
+
+    set.Update(isInactive);
+    EXPECT_FALSE(set.Contains(3));
+    EXPECT_TRUE(set.Contains(4));
+    EXPECT_EQ(std::vector<ElementIndex>({ 4 }), set.GetMembers());
+}
+
+TEST(ActiveElementSetTests, Update_ActivityResetsHysteresis)
+{
+    ActiveElementSet set(10, 1);
+
+    set.Add(3);
+
+    set.Update([](ElementIndex) { return true; });
+    EXPECT_TRUE(set.Contains(3));
+
+    // Active again
+    set.Update([](ElementIndex) { return false; });
+
+    set.Update([](ElementIndex) { return true; });
+    EXPECT_TRUE(set.Contains(3));
+
+    // Re-adding also resets
+    set.Add(3);
+
+    set.Update([](ElementIndex) { return true; });
+    EXPECT_TRUE(set.Contains(3));
+
+    set.Update([](ElementIndex) { return true; });
+    EXPECT_FALSE(set.Contains(3));
+    EXPECT_TRUE(set.IsEmpty());
+}
+
+TEST(ActiveElementSetTests, Clear)
+{
+    ActiveElementSet set(10, 2);
+
+    set.Add(1);
+    set.Add(8);
+
+    set.Clear();
+
+    EXPECT_TRUE(set.IsEmpty());
+    EXPECT_FALSE(set.Contains(1));
+    EXPECT_FALSE(set.Contains(8));
+
+    set.Add(8);
+    EXPECT_EQ(std::vector<ElementIndex>({ 8 }), set.GetMembers());
+}
@@ -0,0 +1,129 @@
+#include <GameCore/AgeOrderedElementPool.h>
+
+#include "gtest/gtest.h"
+
+TEST(AgeOrderedElementPoolTests, Allocate_ReturnsAllElementsThenFails)
+{
+    AgeOrderedElementPool pool(10, 3);
+
+    EXPECT_EQ(0u, pool.GetAllocatedCount());
+
+    EXPECT_EQ(10u, pool.Allocate());
+    EXPECT_EQ(11u, pool.Allocate());
+    EXPECT_EQ(12u, pool.Allocate());
+
+    EXPECT_EQ(3u, pool.GetAllocatedCount());
+    EXPECT_TRUE(pool.IsAllocated(11));
+
+    EXPECT_EQ(NoneElementIndex, pool.Allocate());
+
+    EXPECT_EQ(3u, pool.GetStatistics().AllocationCount);
+    EXPECT_EQ(0u, pool.GetStatistics().RecycleCount);
+    EXPECT_EQ(1u, pool.GetStatistics().FailureCount);
+}
+
+TEST(AgeOrderedElementPoolTests, Free_MakesElementAvailableAgain)
+{
+    AgeOrderedElementPool pool(0, 3);
+
+    pool.Allocate();
+    pool.Allocate();
+    pool.Allocate();
+
+    pool.Free(1);
+
+    EXPECT_FALSE(pool.IsAllocated(1));
+    EXPECT_EQ(2u, pool.GetAllocatedCount());
+
+    EXPECT_EQ(1u, pool.Allocate());
+    EXPECT_EQ(NoneElementIndex, pool.Allocate());
+}
+
+TEST(AgeOrderedElementPoolTests, AllocateOrRecycleOldest_RecyclesInAgeOrder)
+{
+    AgeOrderedElementPool pool(0, 3);
+
+    pool.Allocate(); // 0
+    pool.Allocate(); // 1
+    pool.Allocate(); // 2
+
+    // Freeing and re-allocating makes the element the newest
+    pool.Free(0);
+    EXPECT_EQ(0u, pool.AllocateOrRecycleOldest());
+
+    // Age order is now 1, 2, 0
+    EXPECT_EQ(1u, pool.AllocateOrRecycleOldest());
+    EXPECT_EQ(2u, pool.AllocateOrRecycleOldest());
+    EXPECT_EQ(0u, pool.AllocateOrRecycleOldest());
+    EXPECT_EQ(1u, pool.AllocateOrRecycleOldest());
+
+    // Freeing the oldest element unlinks it from the age order
+    pool.Free(2);
+    pool.Free(0);
+    EXPECT_EQ(1u, pool.GetAllocatedCount());
+    EXPECT_EQ(0u, pool.AllocateOrRecycleOldest());
+    EXPECT_EQ(2u, pool.AllocateOrRecycleOldest());
+    EXPECT_EQ(1u, pool.AllocateOrRecycleOldest());
+
+    EXPECT_EQ(11u, pool.GetStatistics().AllocationCount);
+    EXPECT_EQ(5u, pool.GetStatistics().RecycleCount);
+
+    pool.ResetStatistics();
+
+    EXPECT_EQ(0u, pool.GetStatistics().AllocationCount);
+    EXPECT_EQ(0u, pool.GetStatistics().RecycleCount);
+    EXPECT_EQ(0u, pool.GetStatistics().FailureCount);
+}
+
+TEST(AgeOrderedElementPoolTests, Empty)
+{
+    AgeOrderedElementPool pool(5, 0);
+
+    EXPECT_EQ(NoneElementIndex, pool.Allocate());
+    EXPECT_EQ(0u, pool.GetAllocatedCount());
+}
+
+TEST(AgeOrderedElementPoolTests, SetCapacity_LimitsAllocations)
+{
+    AgeOrderedElementPool pool(0, 4);
+
+    EXPECT_EQ(4u, pool.GetCapacity());
+
+    pool.SetCapacity(2);
+
+    EXPECT_EQ(0u, pool.Allocate());
+    EXPECT_EQ(1u, pool.Allocate());
+    EXPECT_EQ(NoneElementIndex, pool.Allocate());
+
+    // At capacity, we recycle the oldest even though there are free elements
+    EXPECT_EQ(0u, pool.AllocateOrRecycleOldest());
+    EXPECT_EQ(2u, pool.GetAllocatedCount());
+
+    // Restoring the capacity makes the free elements available again
+    pool.SetCapacity(4);
+
+    EXPECT_EQ(2u, pool.Allocate());
+    EXPECT_EQ(3u, pool.AllocateOrRecycleOldest());
+    EXPECT_EQ(4u, pool.GetAllocatedCount());
+}
+
+TEST(AgeOrderedElementPoolTests, GetOldest_And_RecycleOldest)
+{
+    AgeOrderedElementPool pool(5, 2);
+
+    EXPECT_TRUE(pool.CanAllocate());
+    EXPECT_EQ(NoneElementIndex, pool.GetOldest());
+
+    pool.Allocate(); // 5
+    pool.Allocate(); // 6
+
+    EXPECT_FALSE(pool.CanAllocate());
+    EXPECT_EQ(5u, pool.GetOldest());
+
+    EXPECT_EQ(5u, pool.RecycleOldest());
+    EXPECT_EQ(6u, pool.GetOldest());
+
+    EXPECT_EQ(2u, pool.GetAllocatedCount());
+    EXPECT_EQ(3u, pool.GetStatistics().AllocationCount);
+    EXPECT_EQ(1u, pool.GetStatistics().RecycleCount);
+}
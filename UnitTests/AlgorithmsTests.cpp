@@ -7,6 +7,8 @@
 
 #include <array>
 #include <cmath>
+#include <cstdint>
+#include <limits>
 
 #include "gtest/gtest.h"
 
@@ -345,6 +347,75 @@ TEST(AlgorithmsTests, DiffuseLight_SSEVectorized_8Lamps)
 }
 #endif
 
+TEST(AlgorithmsTests, DiffuseLight_Culled_MatchesNaive)
+{
+    // Points laid out in rows, as in a ship, across more than one tile
+    size_t constexpr PointCount = 200;
+    size_t constexpr RowWidth = 20;
+
+    aligned_to_vword vec2f pointPositions[PointCount];
+    aligned_to_vword PlaneId pointPlaneIds[PointCount];
+    for (size_t p = 0; p < PointCount; ++p)
+    {
+        pointPositions[p] = vec2f(static_cast<float>(p % RowWidth), static_cast<float>(p / RowWidth));
+        pointPlaneIds[p] = static_cast<PlaneId>(p / 50);
+    }
+
+    size_t constexpr LampCount = 5;
+
+    aligned_to_vword vec2f lampPositions[LampCount] = { {2.0f, 1.0f}, {15.0f, 8.0f}, {100.0f, 100.0f}, {10.0f, 5.0f}, {3.0f, 9.0f} };
+    aligned_to_vword PlaneId lampPlaneIds[LampCount] = { 3, 1, 3, 0, 2 };
+    aligned_to_vword float lampDistanceCoeffs[LampCount] = { 0.5f, 0.3f, 10.0f, 0.0f, 0.2f };
+    aligned_to_vword float lampSpreadMaxDistances[LampCount] = { 3.0f, 6.0f, 4.0f, 8.0f, 5.0f };
+
+    aligned_to_vword float expectedLightBuffer[PointCount];
+
+    Algorithms::DiffuseLight_Naive(
+        pointPositions,
+        pointPlaneIds,
+        PointCount,
+        lampPositions,
+        lampPlaneIds,
+        lampDistanceCoeffs,
+        lampSpreadMaxDistances,
+        LampCount,
+        expectedLightBuffer);
+
+    size_t constexpr BufferLampCount = make_aligned_float_element_count(LampCount);
+
+    aligned_to_vword vec2f culledLampPositions[BufferLampCount];
+    aligned_to_vword PlaneId culledLampPlaneIds[BufferLampCount];
+    aligned_to_vword float culledLampDistanceCoeffs[BufferLampCount];
+    aligned_to_vword float culledLampSpreadMaxDistances[BufferLampCount];
+
+    aligned_to_vword float outLightBuffer[PointCount];
+
+    // In two ranges, as from two partitions
+    for (auto const & [startPointIndex, endPointIndex] : std::array<std::pair<ElementIndex, ElementIndex>, 2>{ { {0, 96}, {96, 200} } })
+    {
+        Algorithms::DiffuseLight_Culled(
+            pointPositions,
+            pointPlaneIds,
+            startPointIndex,
+            endPointIndex,
+            lampPositions,
+            lampPlaneIds,
+            lampDistanceCoeffs,
+            lampSpreadMaxDistances,
+            LampCount,
+            culledLampPositions,
+            culledLampPlaneIds,
+            culledLampDistanceCoeffs,
+            culledLampSpreadMaxDistances,
+            outLightBuffer);
+    }
+
+    for (size_t p = 0; p < PointCount; ++p)
+    {
+        EXPECT_FLOAT_EQ(expectedLightBuffer[p], outLightBuffer[p]);
+    }
+}
+
 ///////////////////////////////////////////////////////////////////////////////////////////////////////
 // BufferSmoothing
 ///////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -406,4 +477,288 @@ TEST(AlgorithmsTests, SmoothBufferAndAdd_12_5_SSEVectorized)
 {
     RunSmoothBufferAndAddTest_12_5(Algorithms::SmoothBufferAndAdd_SSEVectorized<12, 5>);
 }
-#endif
\ No newline at end of file
+#endif
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////
+// Rotting
+///////////////////////////////////////////////////////////////////////////////////////////////////////
+
+template<typename Algorithm>
+void RunRotPointsTest(Algorithm algorithm)
+{
+    float constexpr x_uw = 0.2f;
+    float constexpr beta = 0.01f;
+
+    size_t constexpr PointCount = 11;
+
+    float const cachedDepthBuffer[PointCount] = { 1.0f, -1.0f, 2.0f, 0.0f, 5.0f, -3.0f, 1.0f, 1.0f, -1.0f, 4.0f, 4.0f };
+    float const waterBuffer[PointCount] = { 0.0f, 0.5f, 3.0f, 0.0f, 0.2f, 1.5f, 0.0f, 0.7f, 0.0f, 0.0f, 1.0f };
+    float const leakingSourcesBuffer[PointCount * 2] = {
+        0.0f, 0.5f,   1.0f, -1.0f,   1.0f, 0.0f,   0.0f, 0.0f,
+        1.0f, 0.0f,   0.0f, 1.0f,    1.0f, 0.5f,   0.0f, 0.0f,
+        1.0f, 0.0f,   0.0f, 0.0f,    1.0f, 0.0f };
+    float const rustReceptivityBuffer[PointCount] = { 1.0f, 1.0f, 0.5f, 1.0f, 0.0f, 1.0f, 1000.0f, 1.0f, 1.0f, 2.0f, 1.0f };
+
+    float decayBuffer[PointCount];
+    for (size_t p = 0; p < PointCount; ++p)
+        decayBuffer[p] = 0.5f + static_cast<float>(p) * 0.01f;
+
+    // Skip first point, to exercise unaligned partition starts
+    algorithm(
+        cachedDepthBuffer,
+        waterBuffer,
+        leakingSourcesBuffer,
+        rustReceptivityBuffer,
+        decayBuffer,
+        1,
+        PointCount,
+        x_uw,
+        beta);
+
+    EXPECT_FLOAT_EQ(0.5f, decayBuffer[0]);
+
+    for (size_t p = 1; p < PointCount; ++p)
+    {
+        float x = (cachedDepthBuffer[p] > 0.0f ? x_uw : 0.0f) + std::min(waterBuffer[p], 1.0f);
+        x += leakingSourcesBuffer[p * 2] * x * x_uw;
+        x *= rustReceptivityBuffer[p];
+        float const expectedDecay = (0.5f + static_cast<float>(p) * 0.01f) * std::max(1.0f - beta * x, 0.0f);
+
+        EXPECT_FLOAT_EQ(expectedDecay, decayBuffer[p]);
+    }
+
+    // Rust receptivity of 1000 makes alpha negative, hence clamped
+    EXPECT_EQ(0.0f, decayBuffer[6]);
+}
+
+TEST(AlgorithmsTests, RotPoints_Naive)
+{
+    RunRotPointsTest(Algorithms::RotPoints_Naive);
+}
+
+#if FS_IS_ARCHITECTURE_X86_32() || FS_IS_ARCHITECTURE_X86_64()
+TEST(AlgorithmsTests, RotPoints_SSEVectorized)
+{
+    RunRotPointsTest(Algorithms::RotPoints_SSEVectorized);
+}
+#endif
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////
+// Vertex attribute packing
+///////////////////////////////////////////////////////////////////////////////////////////////////////
+
+template<typename TPackColors>
+void RunPackColorsToRgba8Test(TPackColors packColors)
+{
+    // More than one vectorized batch, plus a tail
+    std::array<vec4f, 7> const colors{
+        vec4f(0.0f, 0.5f, 1.0f, 1.0f),
+        vec4f(-1.0f, 2.0f, 0.25f, 0.75f),
+        vec4f(0.1f, 0.2f, 0.3f, 0.4f),
+        vec4f(1.0f, 1.0f, 1.0f, 0.0f),
+        vec4f(0.9f, 0.8f, 0.7f, 0.6f),
+        vec4f(std::numeric_limits<float>::quiet_NaN(), 0.0f, 0.0f, 1.0f),
+        vec4f(0.002f, 0.998f, 0.5f, 0.5f) };
+
+    std::array<rgbaColor, 7> packedColors;
+    packColors(colors.data(), packedColors.data(), colors.size());
+
+    EXPECT_EQ(rgbaColor(0, 128, 255, 255), packedColors[0]);
+    EXPECT_EQ(rgbaColor(0, 255, 64, 191), packedColors[1]);
+    EXPECT_EQ(rgbaColor(colors[2]), packedColors[2]);
+    EXPECT_EQ(rgbaColor(255, 255, 255, 0), packedColors[3]);
+    EXPECT_EQ(rgbaColor(colors[4]), packedColors[4]);
+    EXPECT_EQ(rgbaColor(0, 0, 0, 255), packedColors[5]);
+    EXPECT_EQ(rgbaColor(1, 254, 128, 128), packedColors[6]);
+}
+
+TEST(AlgorithmsTests, PackColorsToRgba8_Naive)
+{
+    RunPackColorsToRgba8Test(Algorithms::PackColorsToRgba8_Naive);
+}
+
+#if FS_IS_ARCHITECTURE_X86_32() || FS_IS_ARCHITECTURE_X86_64()
+TEST(AlgorithmsTests, PackColorsToRgba8_SSEVectorized)
+{
+    RunPackColorsToRgba8Test(Algorithms::PackColorsToRgba8_SSEVectorized);
+}
+#endif
+
+template<typename TPackFloats>
+void RunPackFloatsToHalfFloatsTest(TPackFloats packFloats)
+{
+    // More than one vectorized batch, plus a tail
+    std::array<float, 13> const values{
+        0.0f,
+        1.0f,
+        -2.0f,
+        0.5f,
+        300.0f,
+        2049.0f, // Halfway between two halves, rounds up
+        65504.0f,
+        1.0e6f, // Clamped
+        -std::numeric_limits<float>::infinity(), // Clamped
+        0.333333343f,
+        1500.25f,
+        -0.0f,
+        6.103515625e-05f }; // Smallest normal half
+
+    std::array<std::uint16_t, 13> packedValues;
+    packFloats(values.data(), packedValues.data(), values.size());
+
+    EXPECT_EQ(0x0000, packedValues[0]);
+    EXPECT_EQ(0x3c00, packedValues[1]);
+    EXPECT_EQ(0xc000, packedValues[2]);
+    EXPECT_EQ(0x3800, packedValues[3]);
+    EXPECT_EQ(0x5cb0, packedValues[4]);
+    EXPECT_EQ(0x6801, packedValues[5]);
+    EXPECT_EQ(0x7bff, packedValues[6]);
+    EXPECT_EQ(0x7bff, packedValues[7]);
+    EXPECT_EQ(0xfbff, packedValues[8]);
+    EXPECT_EQ(0x3555, packedValues[9]);
+    EXPECT_EQ(0x65dc, packedValues[10]);
+    EXPECT_EQ(0x8000, packedValues[11]);
+    EXPECT_EQ(0x0400, packedValues[12]);
+}
+
+TEST(AlgorithmsTests, PackFloatsToHalfFloats_Naive)
+{
+    RunPackFloatsToHalfFloatsTest(Algorithms::PackFloatsToHalfFloats_Naive);
+}
+
+#if FS_IS_ARCHITECTURE_X86_32() || FS_IS_ARCHITECTURE_X86_64()
+TEST(AlgorithmsTests, PackFloatsToHalfFloats_SSEVectorized)
+{
+    RunPackFloatsToHalfFloatsTest(Algorithms::PackFloatsToHalfFloats_SSEVectorized);
+}
+#endif
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////
+// Shallow water equations
+///////////////////////////////////////////////////////////////////////////////////////////////////////
+
+class UpdateSWEFieldsTest : public testing::Test
+{
+protected:
+
+    static size_t constexpr SampleCount = 1024;
+
+    static float constexpr HeightFieldOffset = 20.0f;
+    static float constexpr DtOverDx = (1.0f / 64.0f) / 0.61f;
+    static float constexpr GDtOverDx = 9.80f * DtOverDx;
+    static float constexpr PreviousVWeight1 = 1.0f - 0.203125f;
+    static float constexpr PreviousVWeight2 = 0.203125f / 2.0f;
+
+    void SetUp() override
+    {
+        HeightField.resize(SampleCount);
+        VelocityField.resize(SampleCount + 1, 0.0f);
+
+        // A bump in the middle and one close to a boundary
+        for (size_t i = 0; i < SampleCount; ++i)
+        {
+            float const x1 = (static_cast<float>(i) - static_cast<float>(SampleCount) / 2.0f) / 20.0f;
+            float const x2 = (static_cast<float>(i) - 40.0f) / 10.0f;
+            HeightField[i] = HeightFieldOffset + 0.2f * std::exp(-x1 * x1) + 0.1f * std::exp(-x2 * x2);
+        }
+    }
+
+    void RunSlabbed(
+        std::vector<float> & heightField,
+        std::vector<float> & velocityField,
+        size_t slabSize,
+        size_t steps)
+    {
+        std::vector<float> outHeightField(heightField.size());
+        std::vector<float> outVelocityField(velocityField.size());
+
+        for (size_t step = 0; step < steps; ++step)
+        {
+            for (size_t startSample = 0; startSample < SampleCount; startSample += slabSize)
+            {
+                Algorithms::UpdateSWEFieldsSlab(
+                    heightField.data(),
+                    velocityField.data(),
+                    outHeightField.data(),
+                    outVelocityField.data(),
+                    SampleCount,
+                    startSample,
+                    std::min(startSample + slabSize, SampleCount),
+                    DtOverDx,
+                    GDtOverDx,
+                    PreviousVWeight1,
+                    PreviousVWeight2);
+            }
+
+            heightField.swap(outHeightField);
+            velocityField.swap(outVelocityField);
+        }
+    }
+
+    std::vector<float> HeightField;
+    std::vector<float> VelocityField;
+};
+
+TEST_F(UpdateSWEFieldsTest, Slabbed_MatchesSerial)
+{
+    std::vector<float> serialHeightField = HeightField;
+    std::vector<float> serialVelocityField = VelocityField;
+
+    std::vector<float> slabbedHeightField = HeightField;
+    std::vector<float> slabbedVelocityField = VelocityField;
+
+    float maxPerturbation = 0.0f;
+    float maxError = 0.0f;
+
+    for (size_t step = 0; step < 500; ++step)
+    {
+        Algorithms::UpdateSWEFields(
+            serialHeightField.data(),
+            serialVelocityField.data(),
+            SampleCount,
+            DtOverDx,
+            GDtOverDx,
+            PreviousVWeight1,
+            PreviousVWeight2);
+
+        RunSlabbed(slabbedHeightField, slabbedVelocityField, 100, 1); // Not a divisor, on purpose
+
+        for (size_t i = 0; i < SampleCount; ++i)
+        {
+            maxPerturbation = std::max(maxPerturbation, std::abs(serialHeightField[i] - HeightFieldOffset));
+            maxError = std::max(maxError, std::abs(serialHeightField[i] - slabbedHeightField[i]));
+        }
+    }
+
+    EXPECT_GT(maxPerturbation, 0.05f);
+    EXPECT_LT(maxError / maxPerturbation, 0.0001f);
+}
+
+TEST_F(UpdateSWEFieldsTest, Slabbed_SingleSlabIsSerial)
+{
+    std::vector<float> serialHeightField = HeightField;
+    std::vector<float> serialVelocityField = VelocityField;
+
+    std::vector<float> slabbedHeightField = HeightField;
+    std::vector<float> slabbedVelocityField = VelocityField;
+
+    for (size_t step = 0; step < 100; ++step)
+    {
+        Algorithms::UpdateSWEFields(
+            serialHeightField.data(),
+            serialVelocityField.data(),
+            SampleCount,
+            DtOverDx,
+            GDtOverDx,
+            PreviousVWeight1,
+            PreviousVWeight2);
+    }
+
+    RunSlabbed(slabbedHeightField, slabbedVelocityField, SampleCount, 100);
+
+    for (size_t i = 0; i < SampleCount; ++i)
+    {
+        EXPECT_FLOAT_EQ(serialHeightField[i], slabbedHeightField[i]);
+        EXPECT_FLOAT_EQ(serialVelocityField[i], slabbedVelocityField[i]);
+    }
+}
@@ -0,0 +1,214 @@
+#include <GameCore/BatchMath.h>
+#include <GameCore/GameMath.h>
+#include <GameCore/SysSpecifics.h>
+#include <GameCore/Vectors.h>
+
+#include <cmath>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+// Not a multiple of any vector width, so that remainders are exercised
+static size_t constexpr ElementCount = 37;
+
+static std::vector<float> MakeInputs(
+    float minValue,
+    float maxValue)
+{
+    std::vector<float> values;
+    for (size_t i = 0; i < ElementCount; ++i)
+    {
+        values.push_back(minValue + (maxValue - minValue) * static_cast<float>(i) / static_cast<float>(ElementCount - 1));
+    }
+
+    return values;
+}
+
+static std::vector<vec2f> MakeVectorInputs()
+{
+    std::vector<vec2f> vectors;
+    for (size_t i = 0; i < ElementCount; ++i)
+    {
+        if (i % 5 == 3)
+            vectors.emplace_back(vec2f::zero());
+        else
+            vectors.emplace_back(static_cast<float>(i) - 18.5f, 3.0f - static_cast<float>(i % 7) * 1.25f);
+    }
+
+    return vectors;
+}
+
+static void ExpectMatchesNaive(
+    std::vector<float> const & expected,
+    std::vector<float> const & actual)
+{
+    ASSERT_EQ(expected.size(), actual.size());
+    for (size_t i = 0; i < expected.size(); ++i)
+    {
+        EXPECT_NEAR(expected[i], actual[i], std::abs(expected[i]) * 0.00001f) << "at " << i;
+    }
+}
+
+static void ExpectMatchesNaive(
+    std::vector<vec2f> const & expected,
+    std::vector<vec2f> const & actual)
+{
+    ASSERT_EQ(expected.size(), actual.size());
+    for (size_t i = 0; i < expected.size(); ++i)
+    {
+        EXPECT_NEAR(expected[i].x, actual[i].x, 0.00001f) << "at " << i;
+        EXPECT_NEAR(expected[i].y, actual[i].y, 0.00001f) << "at " << i;
+    }
+}
+
+TEST(BatchMathTests, Naive_MatchesScalar)
+{
+    auto const x = MakeInputs(0.1f, 10.0f);
+    std::vector<float> out(ElementCount);
+
+    BatchMath::FastLog_Naive(x.data(), out.data(), ElementCount);
+    for (size_t i = 0; i < ElementCount; ++i)
+        EXPECT_EQ(FastLog(x[i]), out[i]);
+
+    BatchMath::FastExp_Naive(x.data(), out.data(), ElementCount);
+    for (size_t i = 0; i < ElementCount; ++i)
+        EXPECT_EQ(FastExp(x[i]), out[i]);
+
+    BatchMath::FastPow_Naive(x.data(), 1.7f, out.data(), ElementCount);
+    for (size_t i = 0; i < ElementCount; ++i)
+        EXPECT_EQ(FastPow(x[i], 1.7f), out[i]);
+
+    BatchMath::Step_Naive(5.0f, x.data(), out.data(), ElementCount);
+    for (size_t i = 0; i < ElementCount; ++i)
+        EXPECT_EQ(Step(5.0f, x[i]), out[i]);
+}
+
+TEST(BatchMathTests, Dispatched_MatchesNaive)
+{
+    auto const logX = MakeInputs(0.01f, 1000.0f);
+    auto const expX = MakeInputs(-20.0f, 20.0f);
+    auto const powX = MakeInputs(0.05f, 20.0f);
+    auto const vectors = MakeVectorInputs();
+
+    std::vector<float> expected(ElementCount);
+    std::vector<float> actual(ElementCount);
+
+    BatchMath::FastLog_Naive(logX.data(), expected.data(), ElementCount);
+    BatchMath::FastLog(logX.data(), actual.data(), ElementCount);
+    ExpectMatchesNaive(expected, actual);
+
+    BatchMath::FastExp_Naive(expX.data(), expected.data(), ElementCount);
+    BatchMath::FastExp(expX.data(), actual.data(), ElementCount);
+    ExpectMatchesNaive(expected, actual);
+
+    BatchMath::FastPow_Naive(powX.data(), 2.3f, expected.data(), ElementCount);
+    BatchMath::FastPow(powX.data(), 2.3f, actual.data(), ElementCount);
+    ExpectMatchesNaive(expected, actual);
+
+    BatchMath::Step_Naive(0.0f, expX.data(), expected.data(), ElementCount);
+    BatchMath::Step(0.0f, expX.data(), actual.data(), ElementCount);
+    ExpectMatchesNaive(expected, actual);
+
+    BatchMath::Length_Naive(vectors.data(), expected.data(), ElementCount);
+    BatchMath::Length(vectors.data(), actual.data(), ElementCount);
+    ExpectMatchesNaive(expected, actual);
+
+    std::vector<vec2f> expectedVectors(ElementCount);
+    std::vector<vec2f> actualVectors(ElementCount);
+    BatchMath::Normalize_Naive(vectors.data(), expectedVectors.data(), ElementCount);
+    BatchMath::Normalize(vectors.data(), actualVectors.data(), ElementCount);
+    ExpectMatchesNaive(expectedVectors, actualVectors);
+}
+
+TEST(BatchMathTests, Normalize_ZeroVectorIsZero)
+{
+    std::vector<vec2f> const vectors(ElementCount, vec2f::zero());
+    std::vector<vec2f> normalized(ElementCount, vec2f(1.0f, 1.0f));
+
+    BatchMath::Normalize(vectors.data(), normalized.data(), ElementCount);
+
+    for (size_t i = 0; i < ElementCount; ++i)
+    {
+        EXPECT_EQ(0.0f, normalized[i].x);
+        EXPECT_EQ(0.0f, normalized[i].y);
+    }
+}
+
+#if FS_IS_ARCHITECTURE_X86_32() || FS_IS_ARCHITECTURE_X86_64()
+
+TEST(BatchMathTests, SSE2_MatchesNaive)
+{
+    auto const x = MakeInputs(0.01f, 50.0f);
+    auto const vectors = MakeVectorInputs();
+
+    std::vector<float> expected(ElementCount);
+    std::vector<float> actual(ElementCount);
+
+    BatchMath::FastLog_Naive(x.data(), expected.data(), ElementCount);
+    BatchMath::FastLog_SSE2(x.data(), actual.data(), ElementCount);
+    ExpectMatchesNaive(expected, actual);
+
+    BatchMath::FastExp_Naive(x.data(), expected.data(), ElementCount);
+    BatchMath::FastExp_SSE2(x.data(), actual.data(), ElementCount);
+    ExpectMatchesNaive(expected, actual);
+
+    BatchMath::FastPow_Naive(x.data(), 0.5f, expected.data(), ElementCount);
+    BatchMath::FastPow_SSE2(x.data(), 0.5f, actual.data(), ElementCount);
+    ExpectMatchesNaive(expected, actual);
+
+    BatchMath::Step_Naive(25.0f, x.data(), expected.data(), ElementCount);
+    BatchMath::Step_SSE2(25.0f, x.data(), actual.data(), ElementCount);
+    ExpectMatchesNaive(expected, actual);
+
+    BatchMath::Length_Naive(vectors.data(), expected.data(), ElementCount);
+    BatchMath::Length_SSE2(vectors.data(), actual.data(), ElementCount);
+    ExpectMatchesNaive(expected, actual);
+
+    std::vector<vec2f> expectedVectors(ElementCount);
+    std::vector<vec2f> actualVectors(ElementCount);
+    BatchMath::Normalize_Naive(vectors.data(), expectedVectors.data(), ElementCount);
+    BatchMath::Normalize_SSE2(vectors.data(), actualVectors.data(), ElementCount);
+    ExpectMatchesNaive(expectedVectors, actualVectors);
+}
+
+TEST(BatchMathTests, AVX2_MatchesNaive)
+{
+    if (!IsAVX2Supported())
+    {
+        GTEST_SKIP() << "AVX2 is not supported";
+    }
+
+    auto const x = MakeInputs(0.01f, 50.0f);
+    auto const vectors = MakeVectorInputs();
+
+    std::vector<float> expected(ElementCount);
+    std::vector<float> actual(ElementCount);
+
+    BatchMath::FastLog_Naive(x.data(), expected.data(), ElementCount);
+    BatchMath::FastLog_AVX2(x.data(), actual.data(), ElementCount);
+    ExpectMatchesNaive(expected, actual);
+
+    BatchMath::FastExp_Naive(x.data(), expected.data(), ElementCount);
+    BatchMath::FastExp_AVX2(x.data(), actual.data(), ElementCount);
+    ExpectMatchesNaive(expected, actual);
+
+    BatchMath::FastPow_Naive(x.data(), 0.5f, expected.data(), ElementCount);
+    BatchMath::FastPow_AVX2(x.data(), 0.5f, actual.data(), ElementCount);
+    ExpectMatchesNaive(expected, actual);
+
+    BatchMath::Step_Naive(25.0f, x.data(), expected.data(), ElementCount);
+    BatchMath::Step_AVX2(25.0f, x.data(), actual.data(), ElementCount);
+    ExpectMatchesNaive(expected, actual);
+
+    BatchMath::Length_Naive(vectors.data(), expected.data(), ElementCount);
+    BatchMath::Length_AVX2(vectors.data(), actual.data(), ElementCount);
+    ExpectMatchesNaive(expected, actual);
+
+    std::vector<vec2f> expectedVectors(ElementCount);
+    std::vector<vec2f> actualVectors(ElementCount);
+    BatchMath::Normalize_Naive(vectors.data(), expectedVectors.data(), ElementCount);
+    BatchMath::Normalize_AVX2(vectors.data(), actualVectors.data(), ElementCount);
+    ExpectMatchesNaive(expectedVectors, actualVectors);
+}
+
+#endif
@@ -436,6 +436,34 @@ TEST(Buffer2DTests, Flip_HorizontalAndVertical)
     }
 }
 
+TEST(Buffer2DTests, Flip_OddSizes)
+{
+    for (auto const direction : { DirectionType::Horizontal, DirectionType::Vertical, DirectionType::Horizontal | DirectionType::Vertical })
+    {
+        Buffer2D<int, struct IntegralTag> buffer(5, 3);
+
+        for (int y = 0; y < buffer.Size.height; ++y)
+        {
+            for (int x = 0; x < buffer.Size.width; ++x)
+            {
+                buffer[IntegralCoordinates(x, y)] = y * 100 + x;
+            }
+        }
+
+        buffer.Flip(direction);
+
+        for (int y = 0; y < buffer.Size.height; ++y)
+        {
+            for (int x = 0; x < buffer.Size.width; ++x)
+            {
+                int const srcX = (direction & DirectionType::Horizontal) == DirectionType::Horizontal ? buffer.Size.width - 1 - x : x;
+                int const srcY = (direction & DirectionType::Vertical) == DirectionType::Vertical ? buffer.Size.height - 1 - y : y;
+                EXPECT_EQ(buffer[IntegralCoordinates(x, y)], srcY * 100 + srcX);
+            }
+        }
+    }
+}
+
 TEST(Buffer2DTests, MakeReframed_SameRect)
 {
     Buffer2D<int, struct IntegralTag> sourceBuffer(8, 8);
@@ -932,3 +960,152 @@ TEST(Buffer2DTests, MakeTransformed)
         }
     }
 }
+
+TEST(Buffer2DTests, View_Region_Indexing)
+{
+    Buffer2D<int, struct IntegralTag> buffer(8, 6);
+
+    int iVal = 100;
+    for (int y = 0; y < buffer.Size.height; ++y)
+    {
+        for (int x = 0; x < buffer.Size.width; ++x)
+        {
+            buffer[IntegralCoordinates(x, y)] = iVal++;
+        }
+    }
+
+    auto const view = static_cast<Buffer2D<int, struct IntegralTag> const &>(buffer).MakeView(IntegralRect(IntegralCoordinates(2, 1), IntegralRectSize(4, 3)));
+
+    ASSERT_EQ(view.Size, IntegralRectSize(4, 3));
+    EXPECT_FALSE(view.IsContiguous());
+
+    for (int y = 0; y < view.Size.height; ++y)
+    {
+        for (int x = 0; x < view.Size.width; ++x)
+        {
+            EXPECT_EQ(view[IntegralCoordinates(x, y)], 100 + (y + 1) * 8 + (x + 2));
+        }
+    }
+
+    // Region of region
+
+    auto const subView = view.GetRegion(IntegralRect(IntegralCoordinates(1, 1), IntegralRectSize(2, 2)));
+
+    ASSERT_EQ(subView.Size, IntegralRectSize(2, 2));
+    EXPECT_EQ(subView[IntegralCoordinates(0, 0)], 100 + 2 * 8 + 3);
+    EXPECT_EQ(subView[IntegralCoordinates(1, 1)], 100 + 3 * 8 + 4);
+}
+
+TEST(Buffer2DTests, View_Region_Writes)
+{
+    Buffer2D<int, struct IntegralTag> buffer(8, 6, 0);
+
+    auto const view = buffer.MakeView(IntegralRect(IntegralCoordinates(2, 1), IntegralRectSize(4, 3)));
+
+    view[IntegralCoordinates(1, 2)] = 42;
+
+    EXPECT_EQ(buffer[IntegralCoordinates(3, 3)], 42);
+}
+
+TEST(Buffer2DTests, View_BlitFrom_BetweenRegions)
+{
+    Buffer2D<int, struct IntegralTag> sourceBuffer(8, 6);
+
+    int iVal = 100;
+    for (int y = 0; y < sourceBuffer.Size.height; ++y)
+    {
+        for (int x = 0; x < sourceBuffer.Size.width; ++x)
+        {
+            sourceBuffer[IntegralCoordinates(x, y)] = iVal++;
+        }
+    }
+
+    Buffer2D<int, struct IntegralTag> targetBuffer(5, 5, 0);
+
+    targetBuffer.MakeView(IntegralRect(IntegralCoordinates(1, 2), IntegralRectSize(3, 2))).BlitFrom(sourceBuffer.MakeView(IntegralRect(IntegralCoordinates(4, 3), IntegralRectSize(3, 2))));
+
+    for (int y = 0; y < targetBuffer.Size.height; ++y)
+    {
+        for (int x = 0; x < targetBuffer.Size.width; ++x)
+        {
+            if (x >= 1 && x < 4 && y >= 2 && y < 4)
+            {
+                EXPECT_EQ(targetBuffer[IntegralCoordinates(x, y)], 100 + (y - 2 + 3) * 8 + (x - 1 + 4));
+            }
+            else
+            {
+                EXPECT_EQ(targetBuffer[IntegralCoordinates(x, y)], 0);
+            }
+        }
+    }
+}
+
+TEST(Buffer2DTests, View_Fill_Region)
+{
+    Buffer2D<int, struct IntegralTag> buffer(6, 5, 0);
+
+    buffer.MakeView(IntegralRect(IntegralCoordinates(1, 1), IntegralRectSize(3, 2))).Fill(7);
+
+    for (int y = 0; y < buffer.Size.height; ++y)
+    {
+        for (int x = 0; x < buffer.Size.width; ++x)
+        {
+            int const expected = (x >= 1 && x < 4 && y >= 1 && y < 3) ? 7 : 0;
+            EXPECT_EQ(buffer[IntegralCoordinates(x, y)], expected);
+        }
+    }
+}
+
+class View_Flip_RegionTest : public testing::TestWithParam<DirectionType>
+{
+};
+
+INSTANTIATE_TEST_SUITE_P(
+    Buffer2DTests,
+    View_Flip_RegionTest,
+    ::testing::Values(
+        DirectionType::Horizontal,
+        DirectionType::Vertical,
+        DirectionType::Horizontal | DirectionType::Vertical
+    ));
+
+TEST_P(View_Flip_RegionTest, View_Flip_RegionTest)
+{
+    DirectionType const direction = GetParam();
+
+    Buffer2D<int, struct IntegralTag> buffer(7, 6);
+
+    int iVal = 100;
+    for (int y = 0; y < buffer.Size.height; ++y)
+    {
+        for (int x = 0; x < buffer.Size.width; ++x)
+        {
+            buffer[IntegralCoordinates(x, y)] = iVal++;
+        }
+    }
+
+    IntegralRect const region(IntegralCoordinates(1, 2), IntegralRectSize(3, 3));
+
+    buffer.MakeView(region).Flip(direction);
+
+    bool const isHorizontal = (direction & DirectionType::Horizontal) == DirectionType::Horizontal;
+    bool const isVertical = (direction & DirectionType::Vertical) == DirectionType::Vertical;
+
+    for (int y = 0; y < buffer.Size.height; ++y)
+    {
+        for (int x = 0; x < buffer.Size.width; ++x)
+        {
+            int srcX = x;
+            int srcY = y;
+            if (IntegralCoordinates(x, y).IsInRect(region))
+            {
+                if (isHorizontal)
+                    srcX = region.origin.x + region.size.width - 1 - (x - region.origin.x);
+                if (isVertical)
+                    srcY = region.origin.y + region.size.height - 1 - (y - region.origin.y);
+            }
+
+            EXPECT_EQ(buffer[IntegralCoordinates(x, y)], 100 + srcY * 7 + srcX);
+        }
+    }
+}
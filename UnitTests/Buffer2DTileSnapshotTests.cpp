@@ -0,0 +1,112 @@
+#include <GameCore/Buffer2DTileSnapshot.h>
+
+#include <algorithm>
+
+#include "gtest/gtest.h"
+
+using TestBuffer = Buffer2D<int, struct IntegralTag>;
+using TestSnapshot = Buffer2DTileSnapshot<int, struct IntegralTag>;
+
+namespace {
+
+    TestBuffer MakeBuffer(int width, int height)
+    {
+        TestBuffer buffer(width, height);
+        for (int y = 0; y < height; ++y)
+        {
+            for (int x = 0; x < width; ++x)
+            {
+                buffer[IntegralCoordinates(x, y)] = y * 1000 + x;
+            }
+        }
+
+        return buffer;
+    }
+
+    bool AreEqual(TestBuffer const & lhs, TestBuffer const & rhs)
+    {
+        return lhs.Size == rhs.Size
+            && std::equal(lhs.Data.get(), lhs.Data.get() + lhs.Size.GetLinearSize(), rhs.Data.get());
+    }
+}
+
+TEST(Buffer2DTileSnapshotTests, BlitRegionOnto_RestoresSnapshottedContent)
+{
+    int const width = TestSnapshot::TileSize * 2 + 5;
+    int const height = TestSnapshot::TileSize + 3;
+
+    TestBuffer buffer = MakeBuffer(width, height);
+    TestSnapshot const snapshot(buffer);
+
+    ASSERT_EQ(buffer.Size, snapshot.GetSize());
+
+    // Trash a region straddling tiles, including the clipped ones
+    IntegralRect const region(IntegralCoordinates(TestSnapshot::TileSize - 2, 1), IntegralRectSize(TestSnapshot::TileSize + 7, height - 1));
+    for (int y = region.origin.y; y < region.origin.y + region.size.height; ++y)
+    {
+        for (int x = region.origin.x; x < region.origin.x + region.size.width; ++x)
+        {
+            buffer[IntegralCoordinates(x, y)] = -1;
+        }
+    }
+
+    snapshot.BlitRegionOnto(region, buffer);
+
+    EXPECT_TRUE(AreEqual(MakeBuffer(width, height), buffer));
+}
+
+TEST(Buffer2DTileSnapshotTests, Update_RetakesOnlyDirtyTiles)
+{
+    int const width = TestSnapshot::TileSize * 3;
+    int const height = TestSnapshot::TileSize * 2;
+
+    TestBuffer buffer = MakeBuffer(width, height);
+    TestSnapshot snapshot(buffer);
+
+    // Nothing dirty
+    auto const noTiles = snapshot.Update(buffer);
+    EXPECT_TRUE(noTiles.IsEmpty());
+    EXPECT_FALSE(noTiles.GetRect().has_value());
+
+    // Edit two pixels in two tiles
+    buffer[IntegralCoordinates(1, 1)] = -1;
+    snapshot.MarkDirty(IntegralRect(IntegralCoordinates(1, 1), IntegralRectSize(1, 1)));
+    buffer[IntegralCoordinates(TestSnapshot::TileSize * 2 + 1, TestSnapshot::TileSize + 1)] = -2;
+    snapshot.MarkDirty(IntegralRect(IntegralCoordinates(TestSnapshot::TileSize * 2 + 1, TestSnapshot::TileSize + 1), IntegralRectSize(1, 1)));
+
+    auto const replacedTiles = snapshot.Update(buffer);
+
+    ASSERT_EQ(2u, replacedTiles.Tiles.size());
+    EXPECT_EQ(2u * TestSnapshot::TileSize * TestSnapshot::TileSize * sizeof(int), replacedTiles.GetByteSize());
+
+    // Replaced tiles span from the first to the last edited tile
+    auto const replacedTilesRect = replacedTiles.GetRect();
+    ASSERT_TRUE(replacedTilesRect.has_value());
+    EXPECT_EQ(IntegralRect(IntegralCoordinates(0, 0), IntegralRectSize(width, height)), *replacedTilesRect);
+
+    // Snapshot now follows the buffer
+    TestBuffer restored = MakeBuffer(width, height);
+    snapshot.BlitRegionOnto(IntegralRect(buffer.Size), restored);
+    EXPECT_TRUE(AreEqual(buffer, restored));
+
+    // Replaced tiles bring the buffer back to its original content
+    replacedTiles.BlitOnto(buffer);
+    EXPECT_TRUE(AreEqual(MakeBuffer(width, height), buffer));
+
+    // Dirtiness has been consumed
+    EXPECT_TRUE(snapshot.Update(buffer).IsEmpty());
+}
+
+TEST(Buffer2DTileSnapshotTests, MarkDirty_ClipsToBuffer)
+{
+    TestBuffer buffer = MakeBuffer(10, 10);
+    TestSnapshot snapshot(buffer);
+
+    snapshot.MarkDirty(IntegralRect(IntegralCoordinates(-5, -5), IntegralRectSize(3, 3)));
+    EXPECT_TRUE(snapshot.Update(buffer).IsEmpty());
+
+    snapshot.MarkDirty(IntegralRect(IntegralCoordinates(-5, -5), IntegralRectSize(100, 100)));
+    auto const replacedTiles = snapshot.Update(buffer);
+    ASSERT_EQ(1u, replacedTiles.Tiles.size());
+    EXPECT_EQ(100u * sizeof(int), replacedTiles.GetByteSize());
+}
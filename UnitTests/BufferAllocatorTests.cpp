@@ -0,0 +1,64 @@
+#include <GameCore/BufferAllocator.h>
+
+#include "gtest/gtest.h"
+
+TEST(BufferAllocatorTests, Allocate_RecyclesReleasedBuffers)
+{
+    BufferAllocator<float> allocator(16);
+
+    float const * firstData;
+
+    {
+        auto buffer = allocator.Allocate();
+        EXPECT_EQ(16u, buffer->GetSize());
+
+        firstData = buffer->data();
+    }
+
+    auto buffer = allocator.Allocate();
+    EXPECT_EQ(firstData, buffer->data());
+
+    auto otherBuffer = allocator.Allocate();
+    EXPECT_NE(firstData, otherBuffer->data());
+}
+
+TEST(BufferAllocatorTests, AllocateSnapshot_CopiesRangeAtSameIndices)
+{
+    BufferAllocator<float> allocator(8);
+
+    float source[8];
+    for (size_t i = 0; i < 8; ++i)
+        source[i] = static_cast<float>(i) * 2.0f;
+
+    auto snapshot = allocator.AllocateSnapshot(source, 2, 4);
+
+    // Changes to the source are not seen by the snapshot
+    for (size_t i = 0; i < 8; ++i)
+        source[i] = -1.0f;
+
+    for (size_t i = 2; i < 6; ++i)
+    {
+        EXPECT_EQ(static_cast<float>(i) * 2.0f, (*snapshot)[i]);
+    }
+}
+
+TEST(BufferAllocatorTests, Allocate_DoesNotRecycleBuffersStillReferenced)
+{
+    BufferAllocator<float> allocator(16);
+
+    auto buffer = allocator.Allocate();
+    auto bufferCopy = buffer;
+
+    float const * const firstData = buffer->data();
+
+    buffer.reset();
+
+    // Still referenced by the copy
+    auto otherBuffer = allocator.Allocate();
+    EXPECT_NE(firstData, otherBuffer->data());
+
+    bufferCopy.reset();
+
+    auto thirdBuffer = allocator.Allocate();
+    EXPECT_EQ(firstData, thirdBuffer->data());
+}
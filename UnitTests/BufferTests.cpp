@@ -18,6 +18,13 @@ TEST(BufferTests, Buffer_EmplaceBack)
     EXPECT_EQ(24, buf[0]);
 }
 
+TEST(BufferTests, Buffer_GetByteSize)
+{
+    Buffer<vec2f> buf(64);
+
+    EXPECT_EQ(64u * sizeof(vec2f), buf.GetByteSize());
+}
+
 TEST(BufferTests, Buffer_Clear)
 {
     Buffer<int> buf(64);
@@ -49,6 +56,26 @@ TEST(BufferTests, Buffer_Move)
     EXPECT_EQ(41, buf2[2]);
 }
 
+TEST(BufferTests, Buffer_Permute)
+{
+    Buffer<int> buf(64, 0, 0);
+    buf[0] = 10;
+    buf[1] = 11;
+    buf[2] = 12;
+    buf[3] = 13;
+    buf[4] = 14;
+
+    buf.permute(std::vector<size_t>({ 2, 0, 3, 1 }));
+
+    EXPECT_EQ(12, buf[0]);
+    EXPECT_EQ(10, buf[1]);
+    EXPECT_EQ(13, buf[2]);
+    EXPECT_EQ(11, buf[3]);
+
+    // Elements past the permutation are untouched
+    EXPECT_EQ(14, buf[4]);
+}
+
 TEST(BufferTests, Buffer_CopyFrom)
 {
     Buffer<int> buf1(64);
@@ -67,6 +94,27 @@ TEST(BufferTests, Buffer_CopyFrom)
     EXPECT_EQ(41, buf2[2]);
 }
 
+TEST(BufferTests, Buffer_EmplaceBackFrom)
+{
+    Buffer<int> buf1(64);
+
+    buf1.emplace_back(24);
+    buf1.emplace_back(13);
+    buf1.emplace_back(41);
+    buf1.emplace_back(7);
+
+    Buffer<int> buf2(64);
+
+    buf2.emplace_back(99);
+    buf2.emplace_back_from(buf1, std::vector<size_t>({ 0, 2, 3 }));
+
+    EXPECT_EQ(4u, buf2.GetCurrentPopulatedSize());
+    EXPECT_EQ(99, buf2[0]);
+    EXPECT_EQ(24, buf2[1]);
+    EXPECT_EQ(41, buf2[2]);
+    EXPECT_EQ(7, buf2[3]);
+}
+
 TEST(BufferTests, Buffer_Fill)
 {
     Buffer<int> buf(64);
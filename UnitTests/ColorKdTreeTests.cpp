@@ -0,0 +1,92 @@
+#include <GameCore/ColorKdTree.h>
+
+#include <limits>
+#include <random>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace /* anonymous */ {
+
+    size_t FindNearestLinearly(
+        std::vector<vec3f> const & palette,
+        vec3f const & color)
+    {
+        size_t bestIndex = 0;
+        float bestSquareDistance = std::numeric_limits<float>::max();
+        for (size_t i = 0; i < palette.size(); ++i)
+        {
+            float const squareDistance = (color - palette[i]).squareLength();
+            if (squareDistance < bestSquareDistance)
+            {
+                bestIndex = i;
+                bestSquareDistance = squareDistance;
+            }
+        }
+
+        return bestIndex;
+    }
+}
+
+TEST(ColorKdTreeTests, SingleColor)
+{
+    ColorKdTree const tree({ vec3f(0.5f, 0.5f, 0.5f) });
+
+    EXPECT_EQ(1u, tree.GetPaletteSize());
+    EXPECT_EQ(0u, tree.FindNearest(vec3f(0.0f, 0.0f, 0.0f)));
+    EXPECT_EQ(0u, tree.FindNearest(vec3f(1.0f, 1.0f, 1.0f)));
+}
+
+TEST(ColorKdTreeTests, MatchesLinearScan)
+{
+    std::mt19937 randomEngine(42);
+    std::uniform_int_distribution<int> channelDistribution(0, 255);
+
+    auto const makeColor = [&]()
+    {
+        return vec3f(
+            static_cast<float>(channelDistribution(randomEngine)) / 255.0f,
+            static_cast<float>(channelDistribution(randomEngine)) / 255.0f,
+            static_cast<float>(channelDistribution(randomEngine)) / 255.0f);
+    };
+
+    std::vector<vec3f> palette;
+    for (int i = 0; i < 500; ++i)
+    {
+        palette.push_back(makeColor());
+    }
+
+    ColorKdTree const tree(palette);
+
+    for (int i = 0; i < 20000; ++i)
+    {
+        vec3f const color = makeColor();
+        ASSERT_EQ(FindNearestLinearly(palette, color), tree.FindNearest(color));
+    }
+}
+
+TEST(ColorKdTreeTests, Ties_GoToFirstInPalette)
+{
+    // Duplicates, and colors at the same distance from the queries
+    std::vector<vec3f> const palette = {
+        vec3f(1.0f, 0.0f, 0.0f),
+        vec3f(0.0f, 0.0f, 0.0f),
+        vec3f(0.0f, 0.0f, 0.0f),
+        vec3f(0.0f, 1.0f, 0.0f),
+        vec3f(0.5f, 0.5f, 0.5f),
+        vec3f(1.0f, 0.0f, 0.0f),
+        vec3f(0.0f, 0.0f, 1.0f)
+    };
+
+    ColorKdTree const tree(palette);
+
+    for (vec3f const & color : {
+        vec3f(0.0f, 0.0f, 0.0f),
+        vec3f(1.0f, 0.0f, 0.0f),
+        vec3f(0.5f, 0.5f, 0.0f),
+        vec3f(0.25f, 0.25f, 0.25f),
+        vec3f(0.0f, 0.5f, 0.5f) })
+    {
+        EXPECT_EQ(FindNearestLinearly(palette, color), tree.FindNearest(color));
+    }
+}
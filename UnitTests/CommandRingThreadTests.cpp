@@ -0,0 +1,175 @@
+#include <GameCore/CommandRingThread.h>
+
+#include <array>
+#include <atomic>
+#include <memory>
+#include <stdexcept>
+#include <thread>
+
+#include "gtest/gtest.h"
+
+TEST(CommandRingThreadTests, Synchronous)
+{
+    CommandRingThread t;
+
+    bool isDone = false;
+    auto const ticket = t.QueueTask(
+        [&isDone]()
+        {
+            isDone = true;
+        });
+
+    t.Wait(ticket);
+
+    EXPECT_TRUE(isDone);
+}
+
+TEST(CommandRingThreadTests, Tickets_AreSequential)
+{
+    CommandRingThread t;
+
+    EXPECT_EQ(1u, t.QueueTask([]() {}));
+    EXPECT_EQ(2u, t.QueueTask([]() {}));
+    EXPECT_EQ(3u, t.QueueSynchronizationPoint());
+
+    t.Wait(3);
+
+    EXPECT_TRUE(t.IsCompleted(1));
+    EXPECT_TRUE(t.IsCompleted(2));
+    EXPECT_TRUE(t.IsCompleted(3));
+}
+
+TEST(CommandRingThreadTests, IsCompleted)
+{
+    CommandRingThread t;
+
+    // Without a thread, the task would run - and block - right away
+    std::atomic<bool> isReleased(!t.HasThread());
+    auto const ticket = t.QueueTask(
+        [&isReleased]()
+        {
+            while (!isReleased)
+            {
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            }
+        });
+
+    if (t.HasThread())
+    {
+        EXPECT_FALSE(t.IsCompleted(ticket));
+    }
+
+    isReleased = true;
+
+    t.Wait(ticket);
+
+    EXPECT_TRUE(t.IsCompleted(ticket));
+}
+
+TEST(CommandRingThreadTests, ManyTasks_RunInOrder)
+{
+    CommandRingThread t;
+
+    // More than fit in the ring, hence we also wait for room
+    int constexpr TaskCount = static_cast<int>(CommandRingThread::Capacity) * 4 + 3;
+
+    int lastValue = 0;
+    bool isInOrder = true;
+    for (int i = 1; i <= TaskCount; ++i)
+    {
+        t.QueueTask(
+            [&lastValue, &isInOrder, i]()
+            {
+                isInOrder = isInOrder && (lastValue == i - 1);
+                lastValue = i;
+            });
+    }
+
+    t.Wait(t.QueueSynchronizationPoint());
+
+    EXPECT_TRUE(isInOrder);
+    EXPECT_EQ(TaskCount, lastValue);
+}
+
+TEST(CommandRingThreadTests, BigTasks_AreBoxed)
+{
+    CommandRingThread t;
+
+    std::array<int, 64> bigCapture;
+    bigCapture.fill(7);
+    static_assert(sizeof(bigCapture) > CommandRingThread::InlineTaskSize);
+
+    int sum = 0;
+    t.RunSynchronously(
+        [&sum, bigCapture]()
+        {
+            for (int v : bigCapture)
+                sum += v;
+        });
+
+    EXPECT_EQ(7 * 64, sum);
+}
+
+TEST(CommandRingThreadTests, Captures_AreReleasedOnceRun)
+{
+    CommandRingThread t;
+
+    auto resource = std::make_shared<int>(42);
+    std::weak_ptr<int> weakResource = resource;
+
+    auto const ticket = t.QueueTask(
+        [resource = std::move(resource)]()
+        {
+            EXPECT_EQ(42, *resource);
+        });
+
+    t.Wait(ticket);
+
+    EXPECT_TRUE(weakResource.expired());
+}
+
+TEST(CommandRingThreadTests, Wait_ThrowsTaskException)
+{
+    CommandRingThread t;
+
+    auto const failingTicket = t.QueueTask(
+        []()
+        {
+            throw std::runtime_error("Boom");
+        });
+
+    auto const succeedingTicket = t.QueueTask([]() {});
+
+    EXPECT_THROW(t.Wait(failingTicket), std::runtime_error);
+    EXPECT_NO_THROW(t.Wait(succeedingTicket));
+}
+
+TEST(CommandRingThreadTests, Wait_ForgetsExceptionsOfEarlierTasks)
+{
+    CommandRingThread t;
+
+    t.QueueTask(
+        []()
+        {
+            throw std::runtime_error("Boom");
+        });
+
+    EXPECT_NO_THROW(t.Wait(t.QueueSynchronizationPoint()));
+}
+
+TEST(CommandRingThreadTests, NoThread)
+{
+    CommandRingThread t(true);
+
+    EXPECT_FALSE(t.HasThread());
+
+    bool isDone = false;
+    auto const ticket = t.QueueTask(
+        [&isDone]()
+        {
+            isDone = true;
+        });
+
+    EXPECT_TRUE(isDone);
+    EXPECT_TRUE(t.IsCompleted(ticket));
+}
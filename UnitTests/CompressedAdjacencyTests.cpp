@@ -0,0 +1,81 @@
+#include <GameCore/CompressedAdjacency.h>
+
+#include "gtest/gtest.h"
+
+TEST(CompressedAdjacencyTests, BuildLayout_RowsAreEmpty)
+{
+    CompressedAdjacency adjacency;
+
+    adjacency.BuildLayout(
+        3,
+        [](ElementIndex v)
+        {
+            return static_cast<ElementCount>(v + 1);
+        });
+
+    ASSERT_EQ(3u, adjacency.GetVertexCount());
+
+    EXPECT_EQ(1u, adjacency.GetRowCapacity(0));
+    EXPECT_EQ(2u, adjacency.GetRowCapacity(1));
+    EXPECT_EQ(3u, adjacency.GetRowCapacity(2));
+
+    EXPECT_TRUE(adjacency.GetRow(0).empty());
+    EXPECT_TRUE(adjacency.GetRow(1).empty());
+    EXPECT_TRUE(adjacency.GetRow(2).empty());
+}
+
+TEST(CompressedAdjacencyTests, AppendToRow)
+{
+    CompressedAdjacency adjacency;
+
+    adjacency.BuildLayout(
+        3,
+        [](ElementIndex)
+        {
+            return ElementCount(2);
+        });
+
+    adjacency.AppendToRow(1, 10, 0);
+    adjacency.AppendToRow(1, 11, 2);
+    adjacency.AppendToRow(0, 10, 1);
+
+    auto const row0 = adjacency.GetRow(0);
+    ASSERT_EQ(1u, row0.size());
+    EXPECT_EQ(10u, row0.EdgeIndices[0]);
+    EXPECT_EQ(1u, row0.NeighborIndices[0]);
+
+    auto const row1 = adjacency.GetRow(1);
+    ASSERT_EQ(2u, row1.size());
+    EXPECT_EQ(10u, row1.EdgeIndices[0]);
+    EXPECT_EQ(0u, row1.NeighborIndices[0]);
+    EXPECT_EQ(11u, row1.EdgeIndices[1]);
+    EXPECT_EQ(2u, row1.NeighborIndices[1]);
+
+    EXPECT_TRUE(adjacency.GetRow(2).empty());
+}
+
+TEST(CompressedAdjacencyTests, ClearRow_OnlyClearsThatRow)
+{
+    CompressedAdjacency adjacency;
+
+    adjacency.BuildLayout(
+        2,
+        [](ElementIndex)
+        {
+            return ElementCount(1);
+        });
+
+    adjacency.AppendToRow(0, 5, 1);
+    adjacency.AppendToRow(1, 5, 0);
+
+    adjacency.ClearRow(0);
+
+    EXPECT_TRUE(adjacency.GetRow(0).empty());
+    ASSERT_EQ(1u, adjacency.GetRow(1).size());
+    EXPECT_EQ(5u, adjacency.GetRow(1).EdgeIndices[0]);
+
+    // Room is retained
+    adjacency.AppendToRow(0, 6, 1);
+    ASSERT_EQ(1u, adjacency.GetRow(0).size());
+    EXPECT_EQ(6u, adjacency.GetRow(0).EdgeIndices[0]);
+}
@@ -0,0 +1,83 @@
+#include <GameCore/CounterBasedRandom.h>
+
+#include "gtest/gtest.h"
+
+#include <set>
+#include <vector>
+
+TEST(CounterBasedRandomTests, SameKey_SameValue)
+{
+    CounterBasedRandom const random1(42);
+    CounterBasedRandom const random2(42);
+
+    for (std::uint64_t e = 0; e < 100; ++e)
+    {
+        EXPECT_EQ(random1.GenerateRaw(7, e), random2.GenerateRaw(7, e));
+        EXPECT_EQ(random1.GenerateRaw(7, e, 3), random2.GenerateRaw(7, e, 3));
+    }
+}
+
+TEST(CounterBasedRandomTests, DifferentKeys_DifferentValues)
+{
+    CounterBasedRandom const random(42);
+    CounterBasedRandom const otherRandom(43);
+
+    std::set<std::uint64_t> values;
+    for (std::uint64_t s = 0; s < 10; ++s)
+    {
+        for (std::uint64_t e = 0; e < 10; ++e)
+        {
+            for (std::uint32_t d = 0; d < 10; ++d)
+            {
+                values.insert(random.GenerateRaw(s, e, d));
+                values.insert(otherRandom.GenerateRaw(s, e, d));
+            }
+        }
+    }
+
+    EXPECT_EQ(values.size(), 2000u);
+}
+
+TEST(CounterBasedRandomTests, NormalizedUniformReal_IsInRangeAndUniform)
+{
+    CounterBasedRandom const random(1);
+
+    size_t constexpr Count = 100000;
+    std::vector<size_t> histogram(10, 0);
+    float sum = 0.0f;
+    for (std::uint64_t e = 0; e < Count; ++e)
+    {
+        float const value = random.GenerateNormalizedUniformReal(5, e);
+        ASSERT_GE(value, 0.0f);
+        ASSERT_LT(value, 1.0f);
+
+        sum += value;
+        ++histogram[static_cast<size_t>(value * 10.0f)];
+    }
+
+    EXPECT_NEAR(sum / static_cast<float>(Count), 0.5f, 0.01f);
+    for (auto const bucketCount : histogram)
+    {
+        EXPECT_NEAR(static_cast<float>(bucketCount) / static_cast<float>(Count), 0.1f, 0.01f);
+    }
+}
+
+TEST(CounterBasedRandomTests, UniformInteger_CoversWholeRange)
+{
+    CounterBasedRandom const random(1);
+
+    std::vector<size_t> histogram(6, 0);
+    for (std::uint64_t e = 0; e < 6000; ++e)
+    {
+        int const value = random.GenerateUniformInteger<int>(-2, 3, 0, e);
+        ASSERT_GE(value, -2);
+        ASSERT_LE(value, 3);
+
+        ++histogram[value + 2];
+    }
+
+    for (auto const bucketCount : histogram)
+    {
+        EXPECT_GT(bucketCount, 800u);
+    }
+}
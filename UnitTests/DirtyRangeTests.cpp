@@ -0,0 +1,48 @@
+#include <GameCore/DirtyRange.h>
+
+#include "gtest/gtest.h"
+
+TEST(DirtyRangeTests, Empty)
+{
+    DirtyRange range;
+
+    EXPECT_TRUE(range.IsEmpty());
+    EXPECT_EQ(0u, range.GetSize());
+}
+
+TEST(DirtyRangeTests, Add_CoversAllElements)
+{
+    DirtyRange range;
+
+    range.Add(7);
+    EXPECT_FALSE(range.IsEmpty());
+    EXPECT_EQ(7u, range.GetStart());
+    EXPECT_EQ(1u, range.GetSize());
+
+    range.Add(3);
+    range.Add(5);
+    EXPECT_EQ(3u, range.GetStart());
+    EXPECT_EQ(5u, range.GetSize());
+
+    range.Add(10, 12);
+    EXPECT_EQ(3u, range.GetStart());
+    EXPECT_EQ(9u, range.GetSize());
+
+    // Empty ranges are ignored
+    range.Add(20, 20);
+    EXPECT_EQ(9u, range.GetSize());
+}
+
+TEST(DirtyRangeTests, Clear)
+{
+    DirtyRange range;
+
+    range.Add(0, 100);
+    range.Clear();
+
+    EXPECT_TRUE(range.IsEmpty());
+
+    range.Add(42);
+    EXPECT_EQ(42u, range.GetStart());
+    EXPECT_EQ(1u, range.GetSize());
+}
@@ -0,0 +1,153 @@
+#include <GameCore/ElementBitmap.h>
+
+#include "gtest/gtest.h"
+
+#include <utility>
+#include <vector>
+
+TEST(ElementBitmapTests, StartsClear)
+{
+    ElementBitmap bitmap(130);
+
+    EXPECT_EQ(bitmap.GetElementCount(), 130u);
+    EXPECT_EQ(bitmap.CountSet(), 0u);
+
+    for (ElementIndex i = 0; i < 130; ++i)
+    {
+        EXPECT_FALSE(bitmap.Test(i));
+    }
+}
+
+TEST(ElementBitmapTests, GetByteSize_IsOneBitPerElement)
+{
+    EXPECT_EQ(8u, ElementBitmap(1).GetByteSize());
+    EXPECT_EQ(8u, ElementBitmap(64).GetByteSize());
+    EXPECT_EQ(16u, ElementBitmap(65).GetByteSize());
+    EXPECT_EQ(1024u / 8u, ElementBitmap(1024).GetByteSize());
+}
+
+TEST(ElementBitmapTests, SetAndClear)
+{
+    ElementBitmap bitmap(130);
+
+    bitmap.Set(0);
+    bitmap.Set(63);
+    bitmap.Set(64);
+    bitmap.Set(129);
+
+    EXPECT_TRUE(bitmap.Test(0));
+    EXPECT_FALSE(bitmap.Test(1));
+    EXPECT_TRUE(bitmap.Test(63));
+    EXPECT_TRUE(bitmap.Test(64));
+    EXPECT_TRUE(bitmap.Test(129));
+    EXPECT_EQ(bitmap.CountSet(), 4u);
+
+    bitmap.Clear(63);
+    bitmap.Assign(64, false);
+    bitmap.Assign(5, true);
+
+    EXPECT_FALSE(bitmap.Test(63));
+    EXPECT_FALSE(bitmap.Test(64));
+    EXPECT_TRUE(bitmap.Test(5));
+    EXPECT_EQ(bitmap.CountSet(), 3u);
+
+    bitmap.ClearAll();
+
+    EXPECT_EQ(bitmap.CountSet(), 0u);
+}
+
+TEST(ElementBitmapTests, ForEachSet_VisitsSetElementsInOrder)
+{
+    ElementBitmap bitmap(200);
+
+    std::vector<ElementIndex> const expected = { 1, 2, 63, 64, 100, 127, 128, 199 };
+    for (auto i : expected)
+    {
+        bitmap.Set(i);
+    }
+
+    std::vector<ElementIndex> visited;
+    bitmap.ForEachSet(
+        [&](ElementIndex i)
+        {
+            visited.push_back(i);
+        });
+
+    EXPECT_EQ(visited, expected);
+}
+
+TEST(ElementBitmapTests, ForEachSet_HonorsRange)
+{
+    ElementBitmap bitmap(200);
+
+    for (ElementIndex i = 0; i < 200; ++i)
+    {
+        bitmap.Set(i);
+    }
+
+    std::vector<ElementIndex> visited;
+    bitmap.ForEachSet(
+        62, 130,
+        [&](ElementIndex i)
+        {
+            visited.push_back(i);
+        });
+
+    ASSERT_EQ(visited.size(), 68u);
+    EXPECT_EQ(visited.front(), 62u);
+    EXPECT_EQ(visited.back(), 129u);
+
+    visited.clear();
+    bitmap.ForEachSet(
+        10, 10,
+        [&](ElementIndex i)
+        {
+            visited.push_back(i);
+        });
+
+    EXPECT_TRUE(visited.empty());
+}
+
+TEST(ElementBitmapTests, ForEachSetRun_CoalescesRunsAcrossWords)
+{
+    ElementBitmap bitmap(300);
+
+    // Run within a word, run across two words, run spanning full words, isolated element at end
+    for (ElementIndex i = 3; i < 7; ++i)
+        bitmap.Set(i);
+    for (ElementIndex i = 60; i < 70; ++i)
+        bitmap.Set(i);
+    for (ElementIndex i = 100; i < 260; ++i)
+        bitmap.Set(i);
+    bitmap.Set(299);
+
+    std::vector<std::pair<ElementIndex, ElementIndex>> runs;
+    bitmap.ForEachSetRun(
+        [&](ElementIndex runStart, ElementIndex runEnd)
+        {
+            runs.emplace_back(runStart, runEnd);
+        });
+
+    std::vector<std::pair<ElementIndex, ElementIndex>> const expected = {
+        { 3, 7 },
+        { 60, 70 },
+        { 100, 260 },
+        { 299, 300 } };
+
+    EXPECT_EQ(runs, expected);
+
+    // Clipped to range
+    runs.clear();
+    bitmap.ForEachSetRun(
+        65, 150,
+        [&](ElementIndex runStart, ElementIndex runEnd)
+        {
+            runs.emplace_back(runStart, runEnd);
+        });
+
+    std::vector<std::pair<ElementIndex, ElementIndex>> const expectedClipped = {
+        { 65, 70 },
+        { 100, 150 } };
+
+    EXPECT_EQ(runs, expectedClipped);
+}
@@ -0,0 +1,96 @@
+#include <Game/EphemeralParticleBudget.h>
+
+#include "gtest/gtest.h"
+
+using Budget = Physics::EphemeralParticleBudget<3>;
+
+namespace /* anonymous */ {
+
+    Budget MakeBudget(ElementCount capacity)
+    {
+        return Budget(
+            {
+                Budget::TypeBudget(0.5f, 0, true), // 0: abundant, unimportant
+                Budget::TypeBudget(0.5f, 1, false), // 1: never replaces
+                Budget::TypeBudget(0.25f, 2, true) // 2: important
+            },
+            capacity);
+    }
+}
+
+TEST(EphemeralParticleBudgetTests, Caps_AreFractionsOfCapacity)
+{
+    auto budget = MakeBudget(100);
+
+    EXPECT_EQ(50u, budget.GetCap(0));
+    EXPECT_EQ(50u, budget.GetCap(1));
+    EXPECT_EQ(25u, budget.GetCap(2));
+
+    budget.SetCapacity(2);
+
+    EXPECT_EQ(1u, budget.GetCap(0));
+    EXPECT_EQ(1u, budget.GetCap(2)); // Never zero
+}
+
+TEST(EphemeralParticleBudgetTests, IsOverBudget_FollowsCounts)
+{
+    auto budget = MakeBudget(4);
+
+    EXPECT_FALSE(budget.IsOverBudget(0));
+
+    budget.OnSpawned(0);
+    EXPECT_FALSE(budget.IsOverBudget(0));
+
+    budget.OnSpawned(0);
+    EXPECT_TRUE(budget.IsOverBudget(0));
+    EXPECT_EQ(2u, budget.GetCount(0));
+
+    budget.OnExpired(0);
+    EXPECT_FALSE(budget.IsOverBudget(0));
+}
+
+TEST(EphemeralParticleBudgetTests, CanReplace_FollowsPriorities)
+{
+    auto budget = MakeBudget(8);
+
+    // Under budget: lower or equal priorities only
+    EXPECT_TRUE(budget.CanReplace(2, 0));
+    EXPECT_TRUE(budget.CanReplace(2, 2));
+    EXPECT_TRUE(budget.CanReplace(0, 0));
+    EXPECT_FALSE(budget.CanReplace(0, 2));
+
+    // Not allowed to replace at all
+    EXPECT_FALSE(budget.CanReplace(1, 0));
+
+    // Over budget: own type only
+    budget.OnSpawned(2);
+    budget.OnSpawned(2);
+    ASSERT_TRUE(budget.IsOverBudget(2));
+    EXPECT_FALSE(budget.CanReplace(2, 0));
+    EXPECT_TRUE(budget.CanReplace(2, 2));
+}
+
+TEST(EphemeralParticleBudgetTests, LevelOfDetail_ThinsOutSpawns)
+{
+    auto budget = MakeBudget(8);
+
+    budget.SetLevelOfDetail(0.25f);
+
+    size_t spawnCount = 0;
+    for (int i = 0; i < 100; ++i)
+    {
+        if (budget.ShouldSpawn(0))
+            ++spawnCount;
+    }
+
+    EXPECT_EQ(25u, spawnCount);
+    EXPECT_EQ(75u, budget.GetStatistics().LevelOfDetailSkipCount);
+
+    // At full detail all requests are spawned
+    budget.SetLevelOfDetail(1.0f);
+    EXPECT_TRUE(budget.ShouldSpawn(1));
+    EXPECT_TRUE(budget.ShouldSpawn(1));
+
+    budget.ResetStatistics();
+    EXPECT_EQ(0u, budget.GetStatistics().LevelOfDetailSkipCount);
+}
@@ -0,0 +1,50 @@
+#include <Game/EphemeralParticleSpawnGrid.h>
+
+#include "gtest/gtest.h"
+
+TEST(EphemeralParticleSpawnGridTests, TrySpawn_CapsSpawnsPerCell)
+{
+    Physics::EphemeralParticleSpawnGrid grid(4.0f, 3);
+
+    EXPECT_TRUE(grid.TrySpawn(vec2f(0.5f, 0.5f), 10.0f));
+    EXPECT_TRUE(grid.TrySpawn(vec2f(1.5f, 3.5f), 10.1f));
+    EXPECT_TRUE(grid.TrySpawn(vec2f(3.9f, 0.1f), 10.2f));
+    EXPECT_FALSE(grid.TrySpawn(vec2f(2.0f, 2.0f), 10.3f));
+
+    // Another cell has its own cap
+    EXPECT_TRUE(grid.TrySpawn(vec2f(-0.5f, 0.5f), 10.3f));
+
+    EXPECT_EQ(1u, grid.ResetSkipCount());
+    EXPECT_EQ(0u, grid.ResetSkipCount());
+}
+
+TEST(EphemeralParticleSpawnGridTests, TrySpawn_CapIsPerSecond)
+{
+    Physics::EphemeralParticleSpawnGrid grid(4.0f, 1);
+
+    EXPECT_TRUE(grid.TrySpawn(vec2f(0.5f, 0.5f), 10.0f));
+    EXPECT_FALSE(grid.TrySpawn(vec2f(0.5f, 0.5f), 10.9f));
+    EXPECT_TRUE(grid.TrySpawn(vec2f(0.5f, 0.5f), 11.0f));
+    EXPECT_FALSE(grid.TrySpawn(vec2f(0.5f, 0.5f), 11.5f));
+}
+
+TEST(EphemeralParticleSpawnGridTests, TrySpawn_RestartsWhenTimeGoesBackwards)
+{
+    Physics::EphemeralParticleSpawnGrid grid(4.0f, 1);
+
+    EXPECT_TRUE(grid.TrySpawn(vec2f(0.5f, 0.5f), 10.0f));
+    EXPECT_FALSE(grid.TrySpawn(vec2f(0.5f, 0.5f), 10.5f));
+    EXPECT_TRUE(grid.TrySpawn(vec2f(0.5f, 0.5f), 5.0f));
+}
+
+TEST(EphemeralParticleSpawnGridTests, Reset)
+{
+    Physics::EphemeralParticleSpawnGrid grid(4.0f, 1);
+
+    EXPECT_TRUE(grid.TrySpawn(vec2f(0.5f, 0.5f), 10.0f));
+    EXPECT_FALSE(grid.TrySpawn(vec2f(0.5f, 0.5f), 10.5f));
+
+    grid.Reset();
+
+    EXPECT_TRUE(grid.TrySpawn(vec2f(0.5f, 0.5f), 10.5f));
+}
@@ -0,0 +1,59 @@
+#include <Game/EventRecorder.h>
+
+#include <GameCore/GameException.h>
+
+#include "gtest/gtest.h"
+
+TEST(EventRecorderTests, SerializationRoundTrip)
+{
+    std::vector<std::unique_ptr<RecordedEvent>> events;
+    events.emplace_back(new RecordedPointDetachForDestroyEvent(42, vec2f(1.5f, -2.25f), 123.5f));
+    events.emplace_back(new RecordedTriangleDestroyEvent(7));
+    events.emplace_back(new RecordedTriangleDestroyEvent(0xfffffffe));
+
+    RecordedEvents const recordedEvents(std::move(events));
+
+    DeSerializationBuffer<BigEndianess> buffer(16);
+    recordedEvents.Serialize(buffer);
+
+    auto const deserializedEvents = RecordedEvents::Deserialize(buffer);
+
+    ASSERT_EQ(deserializedEvents.GetSize(), 3u);
+
+    ASSERT_EQ(deserializedEvents.GetEvent(0).GetType(), RecordedEvent::RecordedEventType::PointDetachForDestroy);
+    auto const & event0 = dynamic_cast<RecordedPointDetachForDestroyEvent const &>(deserializedEvents.GetEvent(0));
+    EXPECT_EQ(event0.GetPointIndex(), 42u);
+    EXPECT_EQ(event0.GetDetachVelocity(), vec2f(1.5f, -2.25f));
+    EXPECT_EQ(event0.GetSimulationTime(), 123.5f);
+
+    ASSERT_EQ(deserializedEvents.GetEvent(1).GetType(), RecordedEvent::RecordedEventType::TriangleDestroy);
+    EXPECT_EQ(dynamic_cast<RecordedTriangleDestroyEvent const &>(deserializedEvents.GetEvent(1)).GetPointIndex(), 7u);
+
+    ASSERT_EQ(deserializedEvents.GetEvent(2).GetType(), RecordedEvent::RecordedEventType::TriangleDestroy);
+    EXPECT_EQ(dynamic_cast<RecordedTriangleDestroyEvent const &>(deserializedEvents.GetEvent(2)).GetPointIndex(), 0xfffffffeu);
+}
+
+TEST(EventRecorderTests, Deserialize_ThrowsOnTruncatedData)
+{
+    std::vector<std::unique_ptr<RecordedEvent>> events;
+    events.emplace_back(new RecordedPointDetachForDestroyEvent(42, vec2f(1.5f, -2.25f), 123.5f));
+
+    RecordedEvents const recordedEvents(std::move(events));
+
+    DeSerializationBuffer<BigEndianess> buffer(16);
+    recordedEvents.Serialize(buffer);
+
+    DeSerializationBuffer<BigEndianess> truncatedBuffer(buffer.GetSize());
+    truncatedBuffer.Append(buffer.GetData(), buffer.GetSize() - 1);
+
+    EXPECT_THROW(RecordedEvents::Deserialize(truncatedBuffer), GameException);
+}
+
+TEST(EventRecorderTests, Deserialize_ThrowsOnForeignData)
+{
+    DeSerializationBuffer<BigEndianess> buffer(16);
+    buffer.Append(std::uint32_t(0x12345678));
+    buffer.Append(std::uint32_t(0));
+
+    EXPECT_THROW(RecordedEvents::Deserialize(buffer), GameException);
+}
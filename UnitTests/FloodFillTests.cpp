@@ -0,0 +1,200 @@
+#include <ShipBuilderLib/FloodFill.h>
+
+#include "gtest/gtest.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <queue>
+#include <random>
+
+namespace ShipBuilder {
+
+namespace {
+
+    // Per-pixel reference fill
+    Buffer2D<bool, ImageTag> MakeReferenceFill(
+        Buffer2D<bool, ImageTag> const & insideMask,
+        ImageCoordinates const & start,
+        bool isEightConnected)
+    {
+        Buffer2D<bool, ImageTag> region(insideMask.Size, false);
+
+        std::queue<ImageCoordinates> pixels;
+        region[start] = true;
+        pixels.push(start);
+
+        while (!pixels.empty())
+        {
+            auto const p = pixels.front();
+            pixels.pop();
+
+            for (int yn = p.y - 1; yn <= p.y + 1; ++yn)
+            {
+                for (int xn = p.x - 1; xn <= p.x + 1; ++xn)
+                {
+                    if (!isEightConnected && xn != p.x && yn != p.y)
+                        continue;
+
+                    ImageCoordinates const n(xn, yn);
+                    if (n.IsInSize(insideMask.Size) && insideMask[n] && !region[n])
+                    {
+                        region[n] = true;
+                        pixels.push(n);
+                    }
+                }
+            }
+        }
+
+        return region;
+    }
+
+}
+
+class FloodFillConnectivityTests : public testing::TestWithParam<bool>
+{
+};
+
+INSTANTIATE_TEST_SUITE_P(
+    FloodFillTests,
+    FloodFillConnectivityTests,
+    ::testing::Values(false, true));
+
+TEST_P(FloodFillConnectivityTests, FillContiguous_MatchesPerPixelFill)
+{
+    bool const isEightConnected = GetParam();
+
+    std::mt19937 randomEngine(42);
+    std::bernoulli_distribution isInsideDistribution(0.6);
+
+    Buffer2D<bool, ImageTag> insideMask(37, 23);
+    for (int y = 0; y < insideMask.Size.height; ++y)
+    {
+        for (int x = 0; x < insideMask.Size.width; ++x)
+        {
+            insideMask[ImageCoordinates(x, y)] = isInsideDistribution(randomEngine);
+        }
+    }
+
+    ImageCoordinates const start(18, 11);
+    insideMask[start] = true;
+
+    Buffer2D<bool, ImageTag> regionMask(insideMask.Size, false);
+    auto const affectedRect = FloodFill::FillContiguous(
+        start,
+        isEightConnected,
+        [&insideMask](int x, int y)
+        {
+            return insideMask[ImageCoordinates(x, y)];
+        },
+        regionMask);
+
+    auto const referenceRegionMask = MakeReferenceFill(insideMask, start, isEightConnected);
+
+    ASSERT_TRUE(affectedRect.has_value());
+
+    std::optional<ImageRect> referenceRect;
+    for (int y = 0; y < insideMask.Size.height; ++y)
+    {
+        for (int x = 0; x < insideMask.Size.width; ++x)
+        {
+            EXPECT_EQ(referenceRegionMask[ImageCoordinates(x, y)], regionMask[ImageCoordinates(x, y)]);
+
+            if (referenceRegionMask[ImageCoordinates(x, y)])
+            {
+                if (!referenceRect)
+                    referenceRect = ImageRect(ImageCoordinates(x, y));
+                else
+                    referenceRect->UnionWith(ImageCoordinates(x, y));
+            }
+        }
+    }
+
+    EXPECT_EQ(*referenceRect, *affectedRect);
+}
+
+TEST(FloodFillTests, FillContiguous_Diagonals)
+{
+    //
+    // X.
+    // .X
+    //
+
+    Buffer2D<bool, ImageTag> insideMask(2, 2, false);
+    insideMask[ImageCoordinates(0, 0)] = true;
+    insideMask[ImageCoordinates(1, 1)] = true;
+
+    auto const isInside = [&insideMask](int x, int y)
+    {
+        return insideMask[ImageCoordinates(x, y)];
+    };
+
+    Buffer2D<bool, ImageTag> fourConnectedRegionMask(insideMask.Size, false);
+    auto const fourConnectedRect = FloodFill::FillContiguous(ImageCoordinates(0, 0), false, isInside, fourConnectedRegionMask);
+    ASSERT_TRUE(fourConnectedRect.has_value());
+    EXPECT_EQ(ImageRect(ImageCoordinates(0, 0)), *fourConnectedRect);
+    EXPECT_FALSE(fourConnectedRegionMask[ImageCoordinates(1, 1)]);
+
+    Buffer2D<bool, ImageTag> eightConnectedRegionMask(insideMask.Size, false);
+    auto const eightConnectedRect = FloodFill::FillContiguous(ImageCoordinates(0, 0), true, isInside, eightConnectedRegionMask);
+    ASSERT_TRUE(eightConnectedRect.has_value());
+    EXPECT_EQ(ImageRect(ImageCoordinates(0, 0), ImageSize(2, 2)), *eightConnectedRect);
+    EXPECT_TRUE(eightConnectedRegionMask[ImageCoordinates(1, 1)]);
+}
+
+TEST(FloodFillTests, FillContiguous_StartOutside)
+{
+    Buffer2D<bool, ImageTag> regionMask(4, 4, false);
+    auto const affectedRect = FloodFill::FillContiguous(
+        ImageCoordinates(1, 1),
+        true,
+        [](int, int) { return false; },
+        regionMask);
+
+    EXPECT_FALSE(affectedRect.has_value());
+}
+
+TEST(FloodFillTests, MakeColorToleranceMask_MatchesScalarDistance)
+{
+    std::mt19937 randomEngine(7);
+    std::uniform_int_distribution<int> channelDistribution(0, 255);
+
+    // Odd size, to exercise the non-vectorized tail too
+    Buffer2D<rgbaColor, ImageTag> image(31, 17);
+    for (int y = 0; y < image.Size.height; ++y)
+    {
+        for (int x = 0; x < image.Size.width; ++x)
+        {
+            image[ImageCoordinates(x, y)] = rgbaColor(
+                static_cast<uint8_t>(channelDistribution(randomEngine)),
+                static_cast<uint8_t>(channelDistribution(randomEngine)),
+                static_cast<uint8_t>(channelDistribution(randomEngine)),
+                (x % 5) == 0 ? 0 : static_cast<uint8_t>(channelDistribution(randomEngine)));
+        }
+    }
+
+    rgbaColor const seedColor(120, 60, 200, 255);
+
+    for (unsigned int tolerance : { 0u, 10u, 33u, 50u, 100u })
+    {
+        auto const mask = FloodFill::MakeColorToleranceMask(image, seedColor, tolerance);
+
+        for (int y = 0; y < image.Size.height; ++y)
+        {
+            for (int x = 0; x < image.Size.width; ++x)
+            {
+                rgbaColor const & pixel = image[ImageCoordinates(x, y)];
+
+                int const dr = std::abs(pixel.r - seedColor.r);
+                int const dg = std::abs(pixel.g - seedColor.g);
+                int const db = std::abs(pixel.b - seedColor.b);
+                int const distance = std::max({ dr, dg, db, std::abs(dr - dg), std::abs(dg - db), std::abs(db - dr) });
+
+                bool const expected = pixel.a != 0 && 100 * distance <= 255 * static_cast<int>(tolerance);
+
+                EXPECT_EQ(expected, mask[ImageCoordinates(x, y)]) << "x=" << x << " y=" << y << " tolerance=" << tolerance;
+            }
+        }
+    }
+}
+
+}
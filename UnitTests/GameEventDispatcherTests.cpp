@@ -133,4 +133,63 @@ TEST(GameEventDispatcherTests, ClearsStateAtUpdate)
     dispatcher.Flush();
 
     Mock::VerifyAndClear(&handler);
-}
\ No newline at end of file
+}
+TEST(GameEventDispatcherTests, OnlyDispatchesSubscribedEvents)
+{
+    MockHandler handler;
+
+    GameEventDispatcher dispatcher;
+    dispatcher.RegisterStructuralEventHandler(&handler, StructuralGameEventMask::Break);
+
+    StructuralMaterial sm = MakeTestStructuralMaterial("Foo", rgbColor(1, 2, 3));
+
+    dispatcher.OnStress(sm, false, 3);
+    dispatcher.OnBreak(sm, false, 2);
+
+    EXPECT_CALL(handler, OnStress(_, _, _)).Times(0);
+    EXPECT_CALL(handler, OnBreak(Field(&StructuralMaterial::Name, "Foo"), false, 2)).Times(1);
+
+    dispatcher.Flush();
+
+    Mock::VerifyAndClear(&handler);
+}
+
+TEST(GameEventDispatcherTests, DispatchesBatches)
+{
+    struct BatchHandler : public IStructuralGameEventHandler
+    {
+        size_t BatchCount = 0;
+        unsigned int TotalSize = 0;
+
+        void OnBreakBatch(StructuralMaterialEventAggregation const & events) override
+        {
+            ++BatchCount;
+            for (auto const & entry : events)
+            {
+                TotalSize += entry.second;
+            }
+        }
+    };
+
+    BatchHandler handler;
+
+    GameEventDispatcher dispatcher;
+    dispatcher.RegisterStructuralEventHandler(&handler);
+
+    StructuralMaterial sm1 = MakeTestStructuralMaterial("Foo1", rgbColor(1, 2, 3));
+    StructuralMaterial sm2 = MakeTestStructuralMaterial("Foo2", rgbColor(1, 2, 3));
+
+    dispatcher.OnBreak(sm1, false, 3);
+    dispatcher.OnBreak(sm2, false, 2);
+    dispatcher.OnBreak(sm2, true, 4);
+
+    dispatcher.Flush();
+
+    EXPECT_EQ(handler.BatchCount, 1u);
+    EXPECT_EQ(handler.TotalSize, 9u);
+
+    // No batch when there are no events
+    dispatcher.Flush();
+
+    EXPECT_EQ(handler.BatchCount, 1u);
+}
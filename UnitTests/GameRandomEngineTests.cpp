@@ -0,0 +1,70 @@
+#include <GameCore/GameRandomEngine.h>
+
+#include "gtest/gtest.h"
+
+#include <thread>
+
+TEST(GameRandomEngineTests, Scope_RedirectsInstanceOnCurrentThreadOnly)
+{
+    GameRandomEngine & singleton = GameRandomEngine::GetInstance();
+
+    GameRandomEngine stream(1);
+
+    {
+        GameRandomEngine::Scope const scope(stream);
+
+        EXPECT_EQ(&GameRandomEngine::GetInstance(), &stream);
+
+        GameRandomEngine * otherThreadInstance = nullptr;
+        std::thread otherThread(
+            [&otherThreadInstance]()
+            {
+                otherThreadInstance = &GameRandomEngine::GetInstance();
+            });
+        otherThread.join();
+
+        EXPECT_EQ(otherThreadInstance, &singleton);
+    }
+
+    EXPECT_EQ(&GameRandomEngine::GetInstance(), &singleton);
+}
+
+TEST(GameRandomEngineTests, Scope_Nests)
+{
+    GameRandomEngine stream1(1);
+    GameRandomEngine stream2(2);
+
+    {
+        GameRandomEngine::Scope const scope1(stream1);
+
+        {
+            GameRandomEngine::Scope const scope2(stream2);
+
+            EXPECT_EQ(&GameRandomEngine::GetInstance(), &stream2);
+        }
+
+        EXPECT_EQ(&GameRandomEngine::GetInstance(), &stream1);
+    }
+}
+
+TEST(GameRandomEngineTests, Streams_DifferentSequences)
+{
+    GameRandomEngine stream1(1);
+    GameRandomEngine stream1Again(1);
+    GameRandomEngine stream2(2);
+
+    bool areAllEqualToStream2 = true;
+    for (int i = 0; i < 16; ++i)
+    {
+        float const value1 = stream1.GenerateNormalizedUniformReal();
+
+        EXPECT_EQ(value1, stream1Again.GenerateNormalizedUniformReal());
+
+        if (value1 != stream2.GenerateNormalizedUniformReal())
+        {
+            areAllEqualToStream2 = false;
+        }
+    }
+
+    EXPECT_FALSE(areAllEqualToStream2);
+}
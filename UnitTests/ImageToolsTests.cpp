@@ -0,0 +1,217 @@
+#include <GameCore/ImageTools.h>
+#include <GameCore/TaskThreadPool.h>
+
+#include "gtest/gtest.h"
+
+namespace {
+
+RgbaImageData MakeImage(
+    int width,
+    int height,
+    std::function<rgbaColor(int x, int y)> pixelFunction)
+{
+    auto data = std::make_unique<rgbaColor[]>(width * height);
+    for (int y = 0; y < height; ++y)
+    {
+        for (int x = 0; x < width; ++x)
+        {
+            data[y * width + x] = pixelFunction(x, y);
+        }
+    }
+
+    return RgbaImageData(ImageSize(width, height), std::move(data));
+}
+
+// Covers all channel values, with a width that is not a multiple of the SIMD widths
+RgbaImageData MakeNoiseImage()
+{
+    return MakeImage(
+        37,
+        301,
+        [](int x, int y)
+        {
+            auto const i = static_cast<std::uint32_t>(y * 37 + x) * 2654435761u;
+            return rgbaColor(
+                static_cast<std::uint8_t>(i >> 24),
+                static_cast<std::uint8_t>(i >> 16),
+                static_cast<std::uint8_t>(i >> 8),
+                static_cast<std::uint8_t>((y * 37 + x) % 256));
+        });
+}
+
+}
+
+TEST(ImageToolsTests, Downsample_UniformImage)
+{
+    auto const image = MakeImage(
+        37,
+        23,
+        [](int, int)
+        {
+            return rgbaColor(10, 100, 200, 255);
+        });
+
+    auto const downsampled = ImageTools::Downsample(image, ImageSize(10, 7));
+
+    ASSERT_EQ(ImageSize(10, 7), downsampled.Size);
+
+    for (int i = 0; i < 10 * 7; ++i)
+    {
+        EXPECT_EQ(rgbaColor(10, 100, 200, 255), downsampled.Data[i]);
+    }
+}
+
+TEST(ImageToolsTests, Downsample_AveragesCoveredPixels)
+{
+    // 2x2 blocks, each with the four pixels being 0, 40, 80, 120
+    auto const image = MakeImage(
+        6,
+        4,
+        [](int x, int y)
+        {
+            auto const v = static_cast<std::uint8_t>(((y % 2) * 2 + (x % 2)) * 40);
+            return rgbaColor(v, v, static_cast<std::uint8_t>(x * 10), 255);
+        });
+
+    auto const downsampled = ImageTools::Downsample(image, ImageSize(3, 2));
+
+    ASSERT_EQ(ImageSize(3, 2), downsampled.Size);
+
+    EXPECT_EQ(rgbaColor(60, 60, 5, 255), downsampled.Data[0]);
+    EXPECT_EQ(rgbaColor(60, 60, 25, 255), downsampled.Data[1]);
+    EXPECT_EQ(rgbaColor(60, 60, 45, 255), downsampled.Data[2]);
+    EXPECT_EQ(rgbaColor(60, 60, 5, 255), downsampled.Data[3]);
+}
+
+TEST(ImageToolsTests, Downsample_FractionalCoverage)
+{
+    // Three pixels into two: each target pixel takes one pixel and a half
+    auto const image = MakeImage(
+        3,
+        1,
+        [](int x, int)
+        {
+            return x == 1
+                ? rgbaColor(90, 0, 255, 255)
+                : rgbaColor(0, 0, 255, 0);
+        });
+
+    auto const downsampled = ImageTools::Downsample(image, ImageSize(2, 1));
+
+    ASSERT_EQ(ImageSize(2, 1), downsampled.Size);
+
+    EXPECT_EQ(rgbaColor(30, 0, 255, 85), downsampled.Data[0]);
+    EXPECT_EQ(rgbaColor(30, 0, 255, 85), downsampled.Data[1]);
+}
+
+TEST(ImageToolsTests, Downsample_SameSize)
+{
+    auto const image = MakeImage(
+        5,
+        3,
+        [](int x, int y)
+        {
+            return rgbaColor(static_cast<std::uint8_t>(x), static_cast<std::uint8_t>(y), 7, 9);
+        });
+
+    auto const downsampled = ImageTools::Downsample(image, image.Size);
+
+    ASSERT_EQ(image.Size, downsampled.Size);
+
+    for (int i = 0; i < 5 * 3; ++i)
+    {
+        EXPECT_EQ(image.Data[i], downsampled.Data[i]);
+    }
+}
+
+TEST(ImageToolsTests, BlendWithColor_MatchesPerPixel)
+{
+    TaskThreadPool taskThreadPool(4);
+
+    for (TaskThreadPool * pool : { static_cast<TaskThreadPool *>(nullptr), &taskThreadPool })
+    {
+        auto image = MakeNoiseImage();
+        auto const original = MakeNoiseImage();
+
+        ImageTools::BlendWithColor(image, rgbColor(12, 200, 77), 0.37f, pool);
+
+        for (size_t i = 0; i < image.Size.GetLinearSize(); ++i)
+        {
+            ASSERT_EQ(original.Data[i].mix(rgbColor(12, 200, 77), 0.37f), image.Data[i]) << "i=" << i;
+        }
+    }
+}
+
+TEST(ImageToolsTests, Overlay_MatchesPerPixel)
+{
+    TaskThreadPool taskThreadPool(4);
+
+    for (TaskThreadPool * pool : { static_cast<TaskThreadPool *>(nullptr), &taskThreadPool })
+    {
+        auto const original = MakeNoiseImage();
+        auto base = MakeNoiseImage();
+        auto const overlay = MakeImage(
+            30,
+            400, // Taller than the base from its offset
+            [](int x, int y)
+            {
+                return rgbaColor(
+                    static_cast<std::uint8_t>(x * 7),
+                    static_cast<std::uint8_t>(y * 3),
+                    static_cast<std::uint8_t>(x + y),
+                    static_cast<std::uint8_t>((x * y) % 256));
+            });
+
+        ImageTools::Overlay(base, overlay, 11, 5, pool);
+
+        for (int y = 0; y < base.Size.height; ++y)
+        {
+            for (int x = 0; x < base.Size.width; ++x)
+            {
+                auto const i = y * base.Size.width + x;
+                rgbaColor const expected = (x >= 11 && y >= 5)
+                    ? original.Data[i].blend(overlay.Data[(y - 5) * overlay.Size.width + (x - 11)])
+                    : original.Data[i];
+
+                ASSERT_EQ(expected, base.Data[i]) << "x=" << x << " y=" << y;
+            }
+        }
+    }
+}
+
+TEST(ImageToolsTests, AlphaPreMultiply_MatchesPerPixel)
+{
+    TaskThreadPool taskThreadPool(4);
+
+    for (TaskThreadPool * pool : { static_cast<TaskThreadPool *>(nullptr), &taskThreadPool })
+    {
+        auto image = MakeNoiseImage();
+        auto const original = MakeNoiseImage();
+
+        ImageTools::AlphaPreMultiply(image, pool);
+
+        for (size_t i = 0; i < image.Size.GetLinearSize(); ++i)
+        {
+            rgbaColor expected = original.Data[i];
+            expected.alpha_multiply();
+
+            ASSERT_EQ(expected, image.Data[i]) << "i=" << i;
+        }
+    }
+}
+
+TEST(ImageToolsTests, ToRgbAndToAlpha_Parallel)
+{
+    TaskThreadPool taskThreadPool(4);
+
+    auto const image = MakeNoiseImage();
+
+    auto const rgb = ImageTools::ToRgb(image, &taskThreadPool);
+    auto const alpha = ImageTools::ToAlpha(image, &taskThreadPool);
+
+    for (size_t i = 0; i < image.Size.GetLinearSize(); ++i)
+    {
+        EXPECT_EQ(image.Data[i].toRgbColor(), rgb.Data[i]);
+        EXPECT_EQ(rgbColor(image.Data[i].a, image.Data[i].a, image.Data[i].a), alpha.Data[i]);
+    }
+}
@@ -379,6 +379,58 @@ TEST(LayerTests, ElectricalLayer_Trim)
     }
 }
 
+TEST(LayerTests, ElectricalLayer_Sparse_RoundTrip)
+{
+    //
+    // Create source layer
+    //
+
+    Buffer2D<ElectricalElement, struct ShipSpaceTag> sourceBuffer(8, 6);
+    ElectricalPanelMetadata sourcePanel;
+
+    auto const nonInstancedMaterial = MakeTestElectricalMaterial("Foo", rgbColor(1, 2, 3), false);
+    auto const instancedMaterial = MakeTestElectricalMaterial("Bar", rgbColor(4, 5, 6), true);
+
+    sourceBuffer[ShipSpaceCoordinates(0, 0)] = ElectricalElement(&nonInstancedMaterial, NoneElectricalElementInstanceIndex);
+    sourceBuffer[ShipSpaceCoordinates(1, 0)] = ElectricalElement(&nonInstancedMaterial, NoneElectricalElementInstanceIndex);
+    sourceBuffer[ShipSpaceCoordinates(4, 3)] = ElectricalElement(&instancedMaterial, 7);
+    sourceBuffer[ShipSpaceCoordinates(7, 5)] = ElectricalElement(&instancedMaterial, 9);
+
+    sourcePanel.try_emplace(7, IntegralCoordinates(1, 2), "Foo", false);
+    sourcePanel.try_emplace(9, std::nullopt, std::nullopt, true);
+
+    ElectricalLayerData sourceLayer(std::move(sourceBuffer), std::move(sourcePanel));
+
+    //
+    // Make sparse and back
+    //
+
+    SparseElectricalLayerData sparseLayer(sourceLayer);
+
+    EXPECT_EQ(sparseLayer.Buffer.GetOccupiedCount(), 4u);
+    EXPECT_LT(sparseLayer.GetByteSize(), sourceLayer.Buffer.GetByteSize());
+
+    ElectricalLayerData targetLayer = sparseLayer.MakeDense();
+
+    //
+    // Verify
+    //
+
+    ASSERT_EQ(targetLayer.Buffer.Size, sourceLayer.Buffer.Size);
+    for (int y = 0; y < targetLayer.Buffer.Size.height; ++y)
+    {
+        for (int x = 0; x < targetLayer.Buffer.Size.width; ++x)
+        {
+            auto const coords = ShipSpaceCoordinates(x, y);
+            EXPECT_EQ(targetLayer.Buffer[coords], sourceLayer.Buffer[coords]);
+        }
+    }
+
+    ASSERT_EQ(targetLayer.Panel.size(), 2u);
+    EXPECT_EQ(targetLayer.Panel.at(7).PanelCoordinates, IntegralCoordinates(1, 2));
+    EXPECT_TRUE(targetLayer.Panel.at(9).IsHidden);
+}
+
 TEST(LayerTests, ElectricalLayer_Reframe_Smaller)
 {
     //
@@ -408,6 +408,44 @@ TEST(LayoutHelperTests, DecoratedConflict_FirstSlot)
     Mock::VerifyAndClear(&handler);
 }
 
+TEST(LayoutHelperTests, DecoratedConflict_InputOrderIsPreserved)
+{
+    // Prepare data
+
+    std::vector<LayoutHelper::LayoutElement<int>> elements{
+        { 1, IntegralCoordinates(0, 0) },
+        { 2, std::nullopt },
+        { 3, IntegralCoordinates(0, 0) },
+        { 4, std::nullopt }
+    };
+
+    // Setup expectations
+
+    MockHandler handler;
+
+    InSequence s;
+
+    EXPECT_CALL(handler, OnBegin(5, 1)).Times(1);
+
+    EXPECT_CALL(handler, OnLayout(std::optional<int>(2), IntegralCoordinates(-2, 0))).Times(1);
+    EXPECT_CALL(handler, OnLayout(std::optional<int>(3), IntegralCoordinates(-1, 0))).Times(1);
+    EXPECT_CALL(handler, OnLayout(std::optional<int>(1), IntegralCoordinates(0, 0))).Times(1);
+    EXPECT_CALL(handler, OnLayout(std::optional<int>(4), IntegralCoordinates(1, 0))).Times(1);
+    EXPECT_CALL(handler, OnLayout(std::optional<int>(std::nullopt), IntegralCoordinates(2, 0))).Times(1);
+
+    // Layout
+
+    LayoutHelper::Layout<int>(
+        elements,
+        11,
+        handler.onBegin,
+        handler.onLayout);
+
+    // Verify
+
+    Mock::VerifyAndClear(&handler);
+}
+
 TEST(LayoutHelperTests, DecoratedConflict_MiddleSlot)
 {
     // Prepare data
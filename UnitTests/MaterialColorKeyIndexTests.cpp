@@ -0,0 +1,92 @@
+#include <Game/MaterialColorKeyIndex.h>
+
+#include <map>
+#include <random>
+
+#include "gtest/gtest.h"
+
+namespace {
+    struct TestMaterial
+    {
+        int Id;
+    };
+}
+
+TEST(MaterialColorKeyIndexTests, Empty)
+{
+    MaterialColorKeyIndex<TestMaterial> index;
+
+    EXPECT_EQ(0u, index.GetSize());
+    EXPECT_EQ(nullptr, index.Find(MaterialColorKey(0, 0, 0)));
+    EXPECT_EQ(nullptr, index.Find(MaterialColorKey(255, 255, 255)));
+}
+
+TEST(MaterialColorKeyIndexTests, FindsInsertedKeys)
+{
+    TestMaterial const m1{ 1 };
+    TestMaterial const m2{ 2 };
+
+    MaterialColorKeyIndex<TestMaterial> index;
+    EXPECT_TRUE(index.TryInsert(MaterialColorKey(1, 2, 3), &m1));
+    EXPECT_TRUE(index.TryInsert(MaterialColorKey(255, 255, 255), &m2));
+
+    EXPECT_EQ(2u, index.GetSize());
+    EXPECT_EQ(&m1, index.Find(MaterialColorKey(1, 2, 3)));
+    EXPECT_EQ(&m2, index.Find(MaterialColorKey(255, 255, 255)));
+    EXPECT_EQ(nullptr, index.Find(MaterialColorKey(3, 2, 1)));
+}
+
+TEST(MaterialColorKeyIndexTests, FirstInsertionWins)
+{
+    TestMaterial const m1{ 1 };
+    TestMaterial const m2{ 2 };
+
+    MaterialColorKeyIndex<TestMaterial> index;
+    EXPECT_TRUE(index.TryInsert(MaterialColorKey(1, 2, 3), &m1));
+    EXPECT_FALSE(index.TryInsert(MaterialColorKey(1, 2, 3), &m2));
+
+    EXPECT_EQ(1u, index.GetSize());
+    EXPECT_EQ(&m1, index.Find(MaterialColorKey(1, 2, 3)));
+}
+
+TEST(MaterialColorKeyIndexTests, MatchesMap_ManyKeys)
+{
+    std::vector<TestMaterial> materials(5000);
+    std::map<MaterialColorKey, TestMaterial const *> expected;
+
+    std::mt19937 random(42);
+    std::uniform_int_distribution<int> component(0, 255);
+
+    MaterialColorKeyIndex<TestMaterial> index;
+    index.Reserve(1000); // Also grows past this
+    for (size_t i = 0; i < materials.size(); ++i)
+    {
+        materials[i].Id = static_cast<int>(i);
+
+        MaterialColorKey const colorKey(
+            static_cast<MaterialColorKey::data_type>(component(random)),
+            static_cast<MaterialColorKey::data_type>(component(random)),
+            static_cast<MaterialColorKey::data_type>(component(random)));
+
+        bool const isNew = expected.emplace(colorKey, &materials[i]).second;
+        EXPECT_EQ(isNew, index.TryInsert(colorKey, &materials[i]));
+    }
+
+    EXPECT_EQ(expected.size(), index.GetSize());
+
+    for (int i = 0; i < 20000; ++i)
+    {
+        MaterialColorKey const colorKey(
+            static_cast<MaterialColorKey::data_type>(component(random)),
+            static_cast<MaterialColorKey::data_type>(component(random)),
+            static_cast<MaterialColorKey::data_type>(component(random)));
+
+        auto const searchIt = expected.find(colorKey);
+        EXPECT_EQ(searchIt != expected.end() ? searchIt->second : nullptr, index.Find(colorKey));
+    }
+
+    for (auto const & [colorKey, material] : expected)
+    {
+        EXPECT_EQ(material, index.Find(colorKey));
+    }
+}
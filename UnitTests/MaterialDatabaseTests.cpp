@@ -0,0 +1,188 @@
+#include <Game/MaterialDatabase.h>
+
+#include <filesystem>
+#include <fstream>
+#include <string>
+
+#include "gtest/gtest.h"
+
+class MaterialDatabaseTests : public testing::Test
+{
+protected:
+
+    void SetUp() override
+    {
+        mRootFolderPath = std::filesystem::temp_directory_path() / "FloatingSandboxTests" / ("materialdatabase_" + std::string(testing::UnitTest::GetInstance()->current_test_info()->name()));
+        std::filesystem::remove_all(mRootFolderPath);
+        std::filesystem::create_directories(mRootFolderPath);
+
+        mCompiledDatabaseFilePath = mRootFolderPath / "Compiled" / "MaterialDatabase.bin";
+
+        WriteDefinitions(1000.0f);
+    }
+
+    void TearDown() override
+    {
+        std::filesystem::remove_all(mRootFolderPath);
+    }
+
+    void WriteDefinitions(float ironStrength)
+    {
+        std::ofstream structuralFile(mRootFolderPath / "materials_structural.json", std::ios::out | std::ios::trunc);
+        structuralFile << R"({
+            "palettes": {
+                "structural_palette": [ { "category": "Metals", "groups": [ { "name": "Iron Group", "sub_categories": [ "Iron" ] } ] } ],
+                "ropes_palette": []
+            },
+            "materials": [
+                )" << MakeStructuralMaterial("#010000", "Air", "\"unique_type\": \"Air\",") << R"(,
+                )" << MakeStructuralMaterial("#020000", "Glass", "\"unique_type\": \"Glass\",") << R"(,
+                )" << MakeStructuralMaterial("#030000", "Water", "\"unique_type\": \"Water\",") << R"(,
+                )" << MakeStructuralMaterial("#101000", "Rope", "\"unique_type\": \"Rope\",") << R"(,
+                {
+                    "color_key": "#404040", "render_color": "#454545", "name": "Iron", "strength": )" << std::to_string(ironStrength) << R"(,
+                    "mass": { "nominal_mass": 1000.0, "density": 2.5 }, "buoyancy_volume_fill": 0.5,
+                    "sound_type": "Metal", "texture_name": "iron",
+                    "is_hull": true, "water_diffusion_speed": 0.5, "water_retention": 0.1,
+                    "ignition_temperature": 2000.0, "melting_temperature": 1800.0, "thermal_conductivity": 50.0,
+                    "specific_heat": 450.0, "combustion_type": "Combustion", "wind_receptivity": 0.0,
+                    "palette_coordinates": { "category": "Metals", "sub_category": "Iron", "sub_category_ordinal": 0 }
+                }
+            ]
+        })";
+
+        std::ofstream electricalFile(mRootFolderPath / "materials_electrical.json", std::ios::out | std::ios::trunc);
+        electricalFile << R"({
+            "palettes": { "electrical_palette": [] },
+            "materials": [
+                {
+                    "color_key": "#505050", "name": "Cable", "electrical_type": "Cable", "conducts_electricity": true,
+                    "heat_generated": 0.0, "minimum_operating_temperature": 0.0, "maximum_operating_temperature": 400.0
+                },
+                {
+                    "color_key": "#606000", "name": "Generator", "electrical_type": "Generator", "conducts_electricity": true,
+                    "is_self_powered": true, "is_instanced": true,
+                    "heat_generated": 10.0, "minimum_operating_temperature": 0.0, "maximum_operating_temperature": 500.0
+                }
+            ]
+        })";
+    }
+
+    static std::string MakeStructuralMaterial(
+        std::string const & colorKey,
+        std::string const & name,
+        std::string const & extraMembers)
+    {
+        return R"({ "color_key": ")" + colorKey + R"(", "name": ")" + name + R"(", )" + extraMembers + R"(
+            "strength": 1.0, "mass": { "nominal_mass": 1.0, "density": 1.0 }, "buoyancy_volume_fill": 1.0,
+            "is_hull": false, "water_diffusion_speed": 0.5, "water_retention": 0.1,
+            "ignition_temperature": 1000.0, "melting_temperature": 1000.0, "thermal_conductivity": 1.0,
+            "specific_heat": 1.0, "combustion_type": "Combustion", "wind_receptivity": 0.0 })";
+    }
+
+    std::filesystem::path mRootFolderPath;
+    std::filesystem::path mCompiledDatabaseFilePath;
+};
+
+TEST_F(MaterialDatabaseTests, Load_CreatesCompiledDatabase)
+{
+    ASSERT_FALSE(std::filesystem::exists(mCompiledDatabaseFilePath));
+
+    MaterialDatabase const database = MaterialDatabase::Load(mRootFolderPath, mCompiledDatabaseFilePath);
+
+    EXPECT_TRUE(std::filesystem::exists(mCompiledDatabaseFilePath));
+    EXPECT_EQ(5u, database.GetStructuralMaterialMap().size());
+    EXPECT_EQ(2u, database.GetElectricalMaterialMap().size());
+}
+
+TEST_F(MaterialDatabaseTests, Load_CompiledDatabaseMatchesDefinitions)
+{
+    MaterialDatabase const parsedDatabase = MaterialDatabase::Load(mRootFolderPath);
+
+    MaterialDatabase::Load(mRootFolderPath, mCompiledDatabaseFilePath);
+    MaterialDatabase const compiledDatabase = MaterialDatabase::Load(mRootFolderPath, mCompiledDatabaseFilePath);
+
+    // Structural
+
+    ASSERT_EQ(parsedDatabase.GetStructuralMaterialMap().size(), compiledDatabase.GetStructuralMaterialMap().size());
+
+    StructuralMaterial const * iron = compiledDatabase.FindStructuralMaterial(MaterialColorKey(0x40, 0x40, 0x40));
+    ASSERT_NE(nullptr, iron);
+    EXPECT_EQ("Iron", iron->Name);
+    EXPECT_EQ(rgbaColor(0x45, 0x45, 0x45, 0xff), iron->RenderColor);
+    EXPECT_EQ(1000.0f, iron->Strength);
+    EXPECT_EQ(2500.0f, iron->GetMass());
+    EXPECT_TRUE(iron->IsHull);
+    ASSERT_TRUE(iron->MaterialSound.has_value());
+    EXPECT_EQ(StructuralMaterial::MaterialSoundType::Metal, *iron->MaterialSound);
+    ASSERT_TRUE(iron->MaterialTextureName.has_value());
+    EXPECT_EQ("iron", *iron->MaterialTextureName);
+    EXPECT_FALSE(iron->UniqueType.has_value());
+    ASSERT_TRUE(iron->PaletteCoordinates.has_value());
+    EXPECT_EQ("Metals", iron->PaletteCoordinates->Category);
+    EXPECT_EQ("Iron", iron->PaletteCoordinates->SubCategory);
+
+    EXPECT_EQ(parsedDatabase.GetLargestMass(), compiledDatabase.GetLargestMass());
+    EXPECT_EQ(parsedDatabase.GetLargestStrength(), compiledDatabase.GetLargestStrength());
+
+    EXPECT_EQ("Water", compiledDatabase.GetUniqueStructuralMaterial(StructuralMaterial::MaterialUniqueType::Water).Name);
+
+    // Rope endpoints
+    StructuralMaterial const * ropeEndpoint = compiledDatabase.FindStructuralMaterial(MaterialColorKey(0x10, 0x1a, 0x33));
+    ASSERT_NE(nullptr, ropeEndpoint);
+    EXPECT_EQ("Rope", ropeEndpoint->Name);
+
+    // Palettes
+
+    auto const & palette = compiledDatabase.GetStructuralMaterialPalette();
+    ASSERT_EQ(1u, palette.Categories.size());
+    EXPECT_EQ("Metals", palette.Categories[0].Name);
+    ASSERT_EQ(1u, palette.Categories[0].SubCategories.size());
+    EXPECT_EQ("Iron Group", palette.Categories[0].SubCategories[0].ParentGroup.Name);
+    ASSERT_EQ(1u, palette.Categories[0].SubCategories[0].Materials.size());
+    EXPECT_EQ(iron, &(palette.Categories[0].SubCategories[0].Materials[0].get()));
+
+    EXPECT_TRUE(compiledDatabase.GetRopeMaterialPalette().Categories.empty());
+
+    // Electrical
+
+    ElectricalMaterial const * generator = compiledDatabase.FindElectricalMaterial(MaterialColorKey(0x60, 0x60, 0x00));
+    ASSERT_NE(nullptr, generator);
+    EXPECT_EQ(ElectricalMaterial::ElectricalElementType::Generator, generator->ElectricalType);
+    EXPECT_TRUE(generator->IsSelfPowered);
+    EXPECT_TRUE(generator->IsInstanced);
+    EXPECT_EQ(10.0f, generator->HeatGenerated);
+    EXPECT_EQ(500.0f, generator->MaximumOperatingTemperature);
+
+    EXPECT_EQ(nullptr, compiledDatabase.FindElectricalMaterial(MaterialColorKey(0x60, 0x60, 0x07)));
+    EXPECT_EQ(generator, compiledDatabase.FindElectricalMaterialLegacy(MaterialColorKey(0x60, 0x60, 0x07)));
+}
+
+TEST_F(MaterialDatabaseTests, Load_RecompilesWhenDefinitionsChange)
+{
+    MaterialDatabase::Load(mRootFolderPath, mCompiledDatabaseFilePath);
+
+    WriteDefinitions(2000.0f);
+
+    MaterialDatabase const database = MaterialDatabase::Load(mRootFolderPath, mCompiledDatabaseFilePath);
+
+    StructuralMaterial const * iron = database.FindStructuralMaterial(MaterialColorKey(0x40, 0x40, 0x40));
+    ASSERT_NE(nullptr, iron);
+    EXPECT_EQ(2000.0f, iron->Strength);
+}
+
+TEST_F(MaterialDatabaseTests, Load_FallsBackToDefinitionsWhenCompiledDatabaseIsTruncated)
+{
+    MaterialDatabase::Load(mRootFolderPath, mCompiledDatabaseFilePath);
+
+    std::filesystem::resize_file(mCompiledDatabaseFilePath, std::filesystem::file_size(mCompiledDatabaseFilePath) / 2);
+
+    MaterialDatabase const database = MaterialDatabase::Load(mRootFolderPath, mCompiledDatabaseFilePath);
+
+    EXPECT_EQ(5u, database.GetStructuralMaterialMap().size());
+    EXPECT_EQ(2u, database.GetElectricalMaterialMap().size());
+
+    // Rewritten in full
+    MaterialDatabase const reloadedDatabase = MaterialDatabase::Load(mRootFolderPath, mCompiledDatabaseFilePath);
+    EXPECT_EQ(5u, reloadedDatabase.GetStructuralMaterialMap().size());
+}
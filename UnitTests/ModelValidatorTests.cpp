@@ -0,0 +1,216 @@
+#include <ShipBuilderLib/ModelValidator.h>
+
+#include "Utils.h"
+
+#include "gtest/gtest.h"
+
+#include <random>
+
+namespace ShipBuilder {
+
+namespace {
+
+    std::vector<std::pair<ModelValidationIssue::CheckClassType, ModelValidationIssue::SeverityType>> ToComparable(ModelValidationResults const & results)
+    {
+        std::vector<std::pair<ModelValidationIssue::CheckClassType, ModelValidationIssue::SeverityType>> comparable;
+        for (auto const & issue : results.GetIssues())
+        {
+            comparable.emplace_back(issue.GetCheckClass(), issue.GetSeverity());
+        }
+
+        return comparable;
+    }
+
+    ModelValidationIssue::SeverityType GetSeverity(
+        ModelValidationResults const & results,
+        ModelValidationIssue::CheckClassType checkClass)
+    {
+        for (auto const & issue : results.GetIssues())
+        {
+            if (issue.GetCheckClass() == checkClass)
+            {
+                return issue.GetSeverity();
+            }
+        }
+
+        throw std::runtime_error("Check not found");
+    }
+}
+
+TEST(ModelValidatorTests, EmptyStructuralLayer)
+{
+    Model model(ShipSpaceSize(8, 6), "Test");
+
+    ModelValidator validator;
+    auto const results = validator.Validate(model);
+
+    EXPECT_EQ(ModelValidationIssue::SeverityType::Error, GetSeverity(results, ModelValidationIssue::CheckClassType::EmptyStructuralLayer));
+    EXPECT_TRUE(results.HasErrors());
+}
+
+TEST(ModelValidatorTests, Incremental_SeesChangesInDirtyRegions)
+{
+    auto const structuralMaterial = MakeTestStructuralMaterial("struct", rgbColor(1, 2, 3));
+
+    auto generatorMaterial = MakeTestElectricalMaterial("gen", rgbColor(1, 2, 3));
+    generatorMaterial.ElectricalType = ElectricalMaterial::ElectricalElementType::Generator;
+    auto lampMaterial = MakeTestElectricalMaterial("lamp", rgbColor(1, 2, 4));
+    lampMaterial.ElectricalType = ElectricalMaterial::ElectricalElementType::Lamp;
+    auto const cableMaterial = MakeTestElectricalMaterial("cable", rgbColor(1, 2, 5));
+
+    Model model(ShipSpaceSize(8, 6), "Test");
+    model.SetElectricalLayer(ElectricalLayerData(ShipSpaceSize(8, 6)));
+
+    for (int x = 0; x < 8; ++x)
+    {
+        model.GetStructuralLayer().Buffer[ShipSpaceCoordinates(x, 2)] = StructuralElement(&structuralMaterial);
+    }
+
+    model.GetElectricalLayer().Buffer[ShipSpaceCoordinates(0, 2)] = ElectricalElement(&generatorMaterial, NoneElectricalElementInstanceIndex);
+    model.GetElectricalLayer().Buffer[ShipSpaceCoordinates(4, 2)] = ElectricalElement(&lampMaterial, NoneElectricalElementInstanceIndex);
+
+    ModelValidator validator;
+
+    auto results = validator.Validate(model);
+    EXPECT_EQ(ModelValidationIssue::SeverityType::Success, GetSeverity(results, ModelValidationIssue::CheckClassType::EmptyStructuralLayer));
+    EXPECT_EQ(ModelValidationIssue::SeverityType::Warning, GetSeverity(results, ModelValidationIssue::CheckClassType::UnpoweredElectricalComponent));
+    EXPECT_EQ(ModelValidationIssue::SeverityType::Success, GetSeverity(results, ModelValidationIssue::CheckClassType::MissingElectricalSubstratum));
+
+    // Connect lamp to generator
+    for (int x = 1; x < 4; ++x)
+    {
+        model.GetElectricalLayer().Buffer[ShipSpaceCoordinates(x, 2)] = ElectricalElement(&cableMaterial, NoneElectricalElementInstanceIndex);
+    }
+
+    validator.RegisterDirtyElectricalLayerRegion(ShipSpaceRect(ShipSpaceCoordinates(1, 2), ShipSpaceSize(3, 1)));
+
+    results = validator.Validate(model);
+    EXPECT_EQ(ModelValidationIssue::SeverityType::Success, GetSeverity(results, ModelValidationIssue::CheckClassType::UnpoweredElectricalComponent));
+    EXPECT_EQ(ModelValidationIssue::SeverityType::Success, GetSeverity(results, ModelValidationIssue::CheckClassType::UnconsumedElectricalSource));
+
+    // Remove substratum under lamp
+    model.GetStructuralLayer().Buffer[ShipSpaceCoordinates(4, 2)] = StructuralElement(nullptr);
+
+    validator.RegisterDirtyStructuralLayerRegion(ShipSpaceRect(ShipSpaceCoordinates(4, 2), ShipSpaceSize(1, 1)));
+
+    results = validator.Validate(model);
+    EXPECT_EQ(ModelValidationIssue::SeverityType::Error, GetSeverity(results, ModelValidationIssue::CheckClassType::MissingElectricalSubstratum));
+}
+
+TEST(ModelValidatorTests, Incremental_SeesChangesToPanelVisibility)
+{
+    auto const structuralMaterial = MakeTestStructuralMaterial("struct", rgbColor(1, 2, 3));
+    auto instancedMaterial = MakeTestElectricalMaterial("switch", rgbColor(1, 2, 3), true);
+    instancedMaterial.ElectricalType = ElectricalMaterial::ElectricalElementType::InteractiveSwitch;
+
+    Model model(ShipSpaceSize(30, 2), "Test");
+    model.SetElectricalLayer(ElectricalLayerData(ShipSpaceSize(30, 2)));
+
+    for (int x = 0; x < 30; ++x)
+    {
+        model.GetStructuralLayer().Buffer[ShipSpaceCoordinates(x, 0)] = StructuralElement(&structuralMaterial);
+        model.GetElectricalLayer().Buffer[ShipSpaceCoordinates(x, 0)] = ElectricalElement(&instancedMaterial, static_cast<ElectricalElementInstanceIndex>(x));
+    }
+
+    ModelValidator validator;
+
+    auto results = validator.Validate(model);
+    EXPECT_EQ(ModelValidationIssue::SeverityType::Warning, GetSeverity(results, ModelValidationIssue::CheckClassType::TooManyVisibleElectricalPanelElements));
+
+    // Hide some - without any dirty region
+    ElectricalPanelMetadata panel;
+    for (int x = 0; x < 10; ++x)
+    {
+        panel.emplace(static_cast<ElectricalElementInstanceIndex>(x), ElectricalPanelElementMetadata(std::nullopt, std::nullopt, true));
+    }
+
+    model.SetElectricalPanelMetadata(std::move(panel));
+
+    results = validator.Validate(model);
+    EXPECT_EQ(ModelValidationIssue::SeverityType::Success, GetSeverity(results, ModelValidationIssue::CheckClassType::TooManyVisibleElectricalPanelElements));
+}
+
+TEST(ModelValidatorTests, Incremental_MatchesFromScratch_AfterRandomEdits)
+{
+    int constexpr Width = 24;
+    int constexpr Height = 16;
+
+    auto const structuralMaterial = MakeTestStructuralMaterial("struct", rgbColor(1, 2, 3));
+
+    std::vector<ElectricalMaterial> electricalMaterials;
+    for (auto const electricalType : {
+        ElectricalMaterial::ElectricalElementType::Cable,
+        ElectricalMaterial::ElectricalElementType::Engine,
+        ElectricalMaterial::ElectricalElementType::EngineController,
+        ElectricalMaterial::ElectricalElementType::EngineTransmission,
+        ElectricalMaterial::ElectricalElementType::Generator,
+        ElectricalMaterial::ElectricalElementType::Lamp })
+    {
+        auto material = MakeTestElectricalMaterial("mat", rgbColor(1, 2, 3));
+        material.ElectricalType = electricalType;
+        material.Luminiscence = (electricalType == ElectricalMaterial::ElectricalElementType::Lamp) ? 1.0f : 0.0f;
+        electricalMaterials.emplace_back(material);
+    }
+
+    Model model(ShipSpaceSize(Width, Height), "Test");
+    model.SetElectricalLayer(ElectricalLayerData(ShipSpaceSize(Width, Height)));
+
+    ModelValidator validator;
+    validator.Validate(model);
+
+    std::mt19937 randomEngine(42);
+    std::uniform_int_distribution<int> xDistribution(0, Width - 1);
+    std::uniform_int_distribution<int> yDistribution(0, Height - 1);
+    std::uniform_int_distribution<int> sizeDistribution(1, 4);
+    std::uniform_int_distribution<int> materialDistribution(-1, static_cast<int>(electricalMaterials.size()) - 1);
+
+    for (int edit = 0; edit < 200; ++edit)
+    {
+        ShipSpaceRect const rect(
+            ShipSpaceCoordinates(xDistribution(randomEngine), yDistribution(randomEngine)),
+            ShipSpaceSize(sizeDistribution(randomEngine), sizeDistribution(randomEngine)));
+
+        bool const isStructural = (edit % 2) == 0;
+        int const materialIndex = materialDistribution(randomEngine);
+
+        for (int y = rect.origin.y; y < std::min(rect.origin.y + rect.size.height, Height); ++y)
+        {
+            for (int x = rect.origin.x; x < std::min(rect.origin.x + rect.size.width, Width); ++x)
+            {
+                if (isStructural)
+                {
+                    model.GetStructuralLayer().Buffer[ShipSpaceCoordinates(x, y)] = StructuralElement(materialIndex >= 0 ? &structuralMaterial : nullptr);
+                }
+                else
+                {
+                    model.GetElectricalLayer().Buffer[ShipSpaceCoordinates(x, y)] = ElectricalElement(
+                        materialIndex >= 0 ? &(electricalMaterials[materialIndex]) : nullptr,
+                        NoneElectricalElementInstanceIndex);
+                }
+            }
+        }
+
+        // Regions may well stick out of the ship
+        if (isStructural)
+        {
+            validator.RegisterDirtyStructuralLayerRegion(rect);
+        }
+        else
+        {
+            validator.RegisterDirtyElectricalLayerRegion(rect);
+        }
+
+        if ((edit % 5) == 0)
+        {
+            EXPECT_EQ(
+                ToComparable(ModelValidator::ValidateModel(model)),
+                ToComparable(validator.Validate(model)));
+        }
+    }
+
+    EXPECT_EQ(
+        ToComparable(ModelValidator::ValidateModel(model)),
+        ToComparable(validator.Validate(model)));
+}
+
+}
@@ -0,0 +1,118 @@
+#include <Game/Physics.h>
+
+#include "gtest/gtest.h"
+
+#include <vector>
+
+namespace /* anonymous */ {
+
+    // Two triangles sharing the 1-2 edge: (0,0)-(0,1)-(1,0) and (1,0)-(0,1)-(1,1)
+    Physics::Triangles MakeTriangles()
+    {
+        Physics::Triangles triangles(2);
+        triangles.Add(0, 1, 2, NoneElementIndex, NoneElementIndex, NoneElementIndex, std::nullopt);
+        triangles.Add(2, 1, 3, NoneElementIndex, NoneElementIndex, NoneElementIndex, std::nullopt);
+        return triangles;
+    }
+
+    std::vector<vec2f> MakePointPositions()
+    {
+        return { vec2f(0.0f, 0.0f), vec2f(0.0f, 1.0f), vec2f(1.0f, 0.0f), vec2f(1.0f, 1.0f) };
+    }
+}
+
+TEST(NPCsTests, CalculateBarycentricCoordinates_Vertices)
+{
+    vec2f const a(0.0f, 0.0f);
+    vec2f const b(0.0f, 2.0f);
+    vec2f const c(2.0f, 0.0f);
+
+    vec3f const bcA = Physics::NPCs::CalculateBarycentricCoordinates(a, a, b, c);
+    EXPECT_FLOAT_EQ(bcA.x, 1.0f);
+    EXPECT_FLOAT_EQ(bcA.y, 0.0f);
+    EXPECT_FLOAT_EQ(bcA.z, 0.0f);
+
+    vec3f const bcB = Physics::NPCs::CalculateBarycentricCoordinates(b, a, b, c);
+    EXPECT_FLOAT_EQ(bcB.x, 0.0f);
+    EXPECT_FLOAT_EQ(bcB.y, 1.0f);
+    EXPECT_FLOAT_EQ(bcB.z, 0.0f);
+}
+
+TEST(NPCsTests, CalculateBarycentricCoordinates_Outside)
+{
+    vec3f const bc = Physics::NPCs::CalculateBarycentricCoordinates(
+        vec2f(2.0f, 2.0f),
+        vec2f(0.0f, 0.0f),
+        vec2f(0.0f, 1.0f),
+        vec2f(1.0f, 0.0f));
+
+    EXPECT_LT(bc.x, 0.0f);
+    EXPECT_FLOAT_EQ(bc.x + bc.y + bc.z, 1.0f);
+}
+
+TEST(NPCsTests, FindTriangleAt)
+{
+    auto const triangles = MakeTriangles();
+    auto const positions = MakePointPositions();
+
+    auto const t0 = Physics::NPCs::FindTriangleAt(vec2f(0.2f, 0.2f), positions.data(), triangles);
+    ASSERT_TRUE(t0.has_value());
+    EXPECT_EQ(*t0, 0u);
+
+    auto const t1 = Physics::NPCs::FindTriangleAt(vec2f(0.8f, 0.8f), positions.data(), triangles);
+    ASSERT_TRUE(t1.has_value());
+    EXPECT_EQ(*t1, 1u);
+
+    EXPECT_FALSE(Physics::NPCs::FindTriangleAt(vec2f(2.0f, 2.0f), positions.data(), triangles).has_value());
+}
+
+TEST(NPCsTests, Update_ConstrainedNPCsFollowTheirTriangles)
+{
+    auto const triangles = MakeTriangles();
+    auto positions = MakePointPositions();
+
+    Physics::NPCs npcs;
+    npcs.Add(vec2f(0.8f, 0.8f), 1, positions.data(), triangles);
+    npcs.Add(vec2f(0.2f, 0.2f), 0, positions.data(), triangles);
+    npcs.Add(vec2f(0.7f, 0.7f), 1, positions.data(), triangles);
+
+    // Move the whole ship
+    for (auto & p : positions)
+    {
+        p += vec2f(1.0f, -2.0f);
+    }
+
+    npcs.Update(0.5f, vec2f(0.0f, -10.0f), positions.data(), triangles);
+
+    ASSERT_EQ(npcs.GetNpcCount(), 3u);
+
+    // In bucket order, with the order within a bucket preserved
+    EXPECT_EQ(npcs.GetTriangle(0), 0u);
+    EXPECT_EQ(npcs.GetTriangle(1), 1u);
+    EXPECT_EQ(npcs.GetTriangle(2), 1u);
+
+    EXPECT_FLOAT_EQ(npcs.GetPosition(0).x, 1.2f);
+    EXPECT_FLOAT_EQ(npcs.GetPosition(0).y, -1.8f);
+    EXPECT_FLOAT_EQ(npcs.GetPosition(1).x, 1.8f);
+    EXPECT_FLOAT_EQ(npcs.GetPosition(1).y, -1.2f);
+    EXPECT_FLOAT_EQ(npcs.GetPosition(2).x, 1.7f);
+    EXPECT_FLOAT_EQ(npcs.GetPosition(2).y, -1.3f);
+
+    // Gravity has no effect while constrained
+    EXPECT_EQ(npcs.GetRegime(0), Physics::NPCs::RegimeType::Constrained);
+    EXPECT_FLOAT_EQ(npcs.GetVelocity(0).x, 2.0f);
+    EXPECT_FLOAT_EQ(npcs.GetVelocity(0).y, -4.0f);
+}
+
+TEST(NPCsTests, Clear)
+{
+    auto const triangles = MakeTriangles();
+    auto const positions = MakePointPositions();
+
+    Physics::NPCs npcs;
+    npcs.Add(vec2f(0.2f, 0.2f), 0, positions.data(), triangles);
+    ASSERT_EQ(npcs.GetNpcCount(), 1u);
+
+    npcs.Clear();
+    EXPECT_EQ(npcs.GetNpcCount(), 0u);
+}
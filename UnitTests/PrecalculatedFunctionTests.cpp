@@ -124,4 +124,28 @@ TEST(PrecalculatedFunctionTests, LinearlyInterpolatedPeriodic)
     EXPECT_NEAR(sin(2.0f * Pi<float> * -0.67f), pf.GetLinearlyInterpolatedPeriodic(-1.67f), 0.0001);
     EXPECT_NEAR(sin(2.0f * Pi<float> * -0.67f), pf.GetLinearlyInterpolatedPeriodic(-2.67f), 0.0001);
     EXPECT_NEAR(sin(2.0f * Pi<float> * -0.67f), pf.GetLinearlyInterpolatedPeriodic(-100.67f), 0.0001);
-}
\ No newline at end of file
+}
+TEST(PrecalculatedFunctionTests, LinearlyInterpolatedPeriodic_Batch_MatchesScalar)
+{
+    PrecalculatedFunction<512> pf(
+        [](float x)
+        {
+            return sin(2.0f * Pi<float> * x);
+        });
+
+    size_t constexpr Count = 37;
+
+    float x[Count];
+    for (size_t i = 0; i < Count; ++i)
+    {
+        x[i] = -2.3f + static_cast<float>(i) * 0.137f;
+    }
+
+    float out[Count];
+    pf.GetLinearlyInterpolatedPeriodic(x, out, Count);
+
+    for (size_t i = 0; i < Count; ++i)
+    {
+        EXPECT_EQ(pf.GetLinearlyInterpolatedPeriodic(x[i]), out[i]);
+    }
+}
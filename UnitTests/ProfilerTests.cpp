@@ -0,0 +1,167 @@
+#include <GameCore/Profiler.h>
+
+#include <GameCore/Utils.h>
+
+#include <algorithm>
+#include <filesystem>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace {
+
+    std::vector<Profiler::ZoneSample> GetSamplesByName(std::string const & name)
+    {
+        auto samples = Profiler::GetInstance().GetSamples();
+        samples.erase(
+            std::remove_if(
+                samples.begin(),
+                samples.end(),
+                [&name](Profiler::ZoneSample const & s)
+                {
+                    return std::string(s.Name) != name;
+                }),
+            samples.end());
+
+        return samples;
+    }
+}
+
+TEST(ProfilerTests, Disabled_RecordsNothing)
+{
+    Profiler::GetInstance().SetEnabled(false);
+    Profiler::GetInstance().Clear();
+
+    {
+        FS_PROFILE_SCOPE("ProfilerTests_Disabled");
+    }
+
+    EXPECT_EQ(GetSamplesByName("ProfilerTests_Disabled").size(), 0u);
+}
+
+TEST(ProfilerTests, NestedScopes)
+{
+    Profiler::GetInstance().Clear();
+    Profiler::GetInstance().SetEnabled(true);
+
+    {
+        FS_PROFILE_SCOPE("ProfilerTests_Outer");
+
+        {
+            FS_PROFILE_SCOPE("ProfilerTests_Inner");
+        }
+    }
+
+    Profiler::GetInstance().SetEnabled(false);
+
+    auto const outer = GetSamplesByName("ProfilerTests_Outer");
+    auto const inner = GetSamplesByName("ProfilerTests_Inner");
+
+    ASSERT_EQ(outer.size(), 1u);
+    ASSERT_EQ(inner.size(), 1u);
+
+    EXPECT_EQ(outer[0].Depth + 1, inner[0].Depth);
+    EXPECT_EQ(outer[0].ThreadId, inner[0].ThreadId);
+    EXPECT_LE(outer[0].StartTicks, inner[0].StartTicks);
+    EXPECT_GE(outer[0].EndTicks, inner[0].EndTicks);
+}
+
+TEST(ProfilerTests, Clear)
+{
+    Profiler::GetInstance().Clear();
+    Profiler::GetInstance().SetEnabled(true);
+
+    {
+        FS_PROFILE_SCOPE("ProfilerTests_Cleared");
+    }
+
+    Profiler::GetInstance().SetEnabled(false);
+
+    EXPECT_EQ(GetSamplesByName("ProfilerTests_Cleared").size(), 1u);
+
+    Profiler::GetInstance().Clear();
+
+    EXPECT_EQ(GetSamplesByName("ProfilerTests_Cleared").size(), 0u);
+}
+
+TEST(ProfilerTests, RingBufferKeepsMostRecentZones)
+{
+    Profiler::GetInstance().Clear();
+    Profiler::GetInstance().SetEnabled(true);
+
+    for (int i = 0; i < 100000; ++i)
+    {
+        FS_PROFILE_SCOPE("ProfilerTests_Many");
+    }
+
+    Profiler::GetInstance().SetEnabled(false);
+
+    auto const samples = GetSamplesByName("ProfilerTests_Many");
+    EXPECT_GT(samples.size(), 0u);
+    EXPECT_LT(samples.size(), 100000u);
+}
+
+TEST(ProfilerTests, ThreadsHaveDistinctProfiles)
+{
+    Profiler::GetInstance().Clear();
+    Profiler::GetInstance().SetEnabled(true);
+
+    {
+        FS_PROFILE_SCOPE("ProfilerTests_Thread");
+    }
+
+    std::thread thread(
+        []()
+        {
+            Profiler::GetInstance().SetCurrentThreadName("ProfilerTests Thread");
+
+            FS_PROFILE_SCOPE("ProfilerTests_Thread");
+        });
+
+    thread.join();
+
+    Profiler::GetInstance().SetEnabled(false);
+
+    auto const samples = GetSamplesByName("ProfilerTests_Thread");
+    ASSERT_EQ(samples.size(), 2u);
+    EXPECT_NE(samples[0].ThreadId, samples[1].ThreadId);
+}
+
+TEST(ProfilerTests, ExportChromeTrace)
+{
+    Profiler::GetInstance().Clear();
+    Profiler::GetInstance().SetEnabled(true);
+
+    {
+        FS_PROFILE_SCOPE("ProfilerTests_Export");
+    }
+
+    Profiler::GetInstance().SetEnabled(false);
+
+    auto const filePath = std::filesystem::temp_directory_path() / "ProfilerTests_Export.json";
+
+    Profiler::GetInstance().ExportChromeTrace(filePath);
+
+    auto const root = Utils::ParseJSONFile(filePath);
+    std::filesystem::remove(filePath);
+
+    ASSERT_TRUE(root.is<picojson::object>());
+    auto const & traceEvents = root.get<picojson::object>().at("traceEvents");
+    ASSERT_TRUE(traceEvents.is<picojson::array>());
+
+    size_t exportedCount = 0;
+    for (auto const & traceEvent : traceEvents.get<picojson::array>())
+    {
+        auto const & traceEventObj = traceEvent.get<picojson::object>();
+        if (traceEventObj.at("name").get<std::string>() == "ProfilerTests_Export")
+        {
+            EXPECT_EQ(traceEventObj.at("ph").get<std::string>(), "X");
+            EXPECT_GE(traceEventObj.at("dur").get<double>(), 0.0);
+            ++exportedCount;
+        }
+    }
+
+    EXPECT_EQ(exportedCount, 1u);
+}
@@ -7,6 +7,9 @@
 #include <picojson.h>
 
 #include <algorithm>
+#include <cstring>
+#include <iterator>
+#include <vector>
 
 #include "gtest/gtest.h"
 
@@ -778,6 +781,134 @@ TEST(SettingsTests, Serialization_E2E_SerializationAndDeserialization)
     EXPECT_EQ(123, settings2.GetValue<CustomValue>(TestSettings::Setting5_custom).Int);
 }
 
+TEST(SettingsTests, Serialization_E2E_SerializationAndDeserialization_Binary)
+{
+    //
+    // 1. Serialize
+    //
+
+    auto testFileSystem = std::make_shared<TestFileSystem>();
+
+    SettingsStorage storage(
+        TestRootSystemDirectory,
+        TestRootUserDirectory,
+        testFileSystem);
+
+
+    Settings<TestSettings> settings1(MakeTestSettings());
+
+    settings1.ClearAllDirty();
+
+    settings1.SetValue<float>(TestSettings::Setting1_float, 242.0f);
+    settings1.SetValue<uint32_t>(TestSettings::Setting2_uint32, 999);
+    settings1.SetValue<bool>(TestSettings::Setting3_bool, false);
+    settings1.SetValue<std::string>(TestSettings::Setting4_string, std::string("Test!"));
+    settings1.SetValue<CustomValue>(TestSettings::Setting5_custom, CustomValue("Foo", 123));
+
+    {
+        SettingsSerializationContext sContext(
+            PersistedSettingsKey("Test Settings", PersistedSettingsStorageTypes::User),
+            "Test description",
+            storage,
+            PersistedSettingsFormats::Binary);
+
+        settings1.SerializeDirty(sContext);
+        // Context destruction happens here
+    }
+
+    // Named streams are embedded in the one and only file
+    ASSERT_EQ(testFileSystem->GetFileMap().size(), 1u);
+    EXPECT_EQ(testFileSystem->GetFileMap().count(TestRootUserDirectory / "Test Settings.settings.fsbin"), 1u);
+
+    EXPECT_TRUE(storage.HasSettings(PersistedSettingsKey("Test Settings", PersistedSettingsStorageTypes::User)));
+
+    auto const listedSettings = storage.ListSettings();
+    ASSERT_EQ(listedSettings.size(), 1u);
+    EXPECT_EQ(listedSettings[0].Key, PersistedSettingsKey("Test Settings", PersistedSettingsStorageTypes::User));
+    EXPECT_EQ(listedSettings[0].Description, "Test description");
+
+
+    //
+    // 2. De-serialize
+    //
+
+    Settings<TestSettings> settings2(MakeTestSettings());
+
+    settings2.MarkAllAsDirty();
+
+    {
+        SettingsDeserializationContext sContext(
+            PersistedSettingsKey("Test Settings", PersistedSettingsStorageTypes::User),
+            storage);
+
+        EXPECT_EQ(Version::CurrentVersion(), sContext.GetSettingsVersion());
+
+        settings2.Deserialize(sContext);
+
+        EXPECT_FALSE(!!sContext.GetNamedStream("nonexistent", "bin"));
+    }
+
+
+    //
+    // 3. Verify
+    //
+
+    EXPECT_EQ(242.0f, settings2.GetValue<float>(TestSettings::Setting1_float));
+    EXPECT_EQ(999u, settings2.GetValue<uint32_t>(TestSettings::Setting2_uint32));
+    EXPECT_EQ(false, settings2.GetValue<bool>(TestSettings::Setting3_bool));
+    EXPECT_EQ(std::string("Test!"), settings2.GetValue<std::string>(TestSettings::Setting4_string));
+    EXPECT_EQ(std::string("Foo"), settings2.GetValue<CustomValue>(TestSettings::Setting5_custom).Str);
+    EXPECT_EQ(123, settings2.GetValue<CustomValue>(TestSettings::Setting5_custom).Int);
+}
+
+TEST(SettingsTests, Serialization_Binary_CompressesSmoothNamedStreams)
+{
+    auto testFileSystem = std::make_shared<TestFileSystem>();
+
+    SettingsStorage storage(
+        TestRootSystemDirectory,
+        TestRootUserDirectory,
+        testFileSystem);
+
+    // A terrain-like blob, plus a few bytes that are not a multiple of a word
+    std::vector<float> samples;
+    for (int i = 0; i < 2048; ++i)
+    {
+        samples.push_back(static_cast<float>(i / 64));
+    }
+
+    std::string const tail = "xyz";
+
+    {
+        SettingsSerializationContext sContext(
+            PersistedSettingsKey("Test Settings", PersistedSettingsStorageTypes::User),
+            "Test description",
+            storage,
+            PersistedSettingsFormats::Binary);
+
+        auto os = sContext.GetNamedStream("terrain", "bin");
+        os->write(reinterpret_cast<char const *>(samples.data()), samples.size() * sizeof(float));
+        os->write(tail.data(), tail.size());
+    }
+
+    size_t const rawSize = samples.size() * sizeof(float) + tail.size();
+
+    std::string const fileContent = testFileSystem->GetTestFileContent(TestRootUserDirectory / "Test Settings.settings.fsbin");
+    EXPECT_LT(fileContent.size(), rawSize / 4);
+
+    SettingsDeserializationContext sContext(
+        PersistedSettingsKey("Test Settings", PersistedSettingsStorageTypes::User),
+        storage);
+
+    auto is = sContext.GetNamedStream("terrain", "bin");
+    ASSERT_TRUE(!!is);
+
+    std::string const content{ std::istreambuf_iterator<char>(*is), std::istreambuf_iterator<char>() };
+    ASSERT_EQ(content.size(), rawSize);
+    EXPECT_EQ(0, std::memcmp(content.data(), samples.data(), samples.size() * sizeof(float)));
+    EXPECT_EQ(content.substr(samples.size() * sizeof(float)), tail);
+}
+
 enum class RgbColorTestSettings : size_t
 {
     Setting1 = 0,
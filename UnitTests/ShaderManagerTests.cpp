@@ -276,4 +276,29 @@ TEST_F(ShaderManagerTests, SubstitutesStaticParameters_ErrorsOnUnrecognizedParam
     EXPECT_THROW(
         TestShaderManager::SubstituteStaticParameters(source, MakeStaticParameters()),
         GameException);
-}
\ No newline at end of file
+}
+TEST_F(ShaderManagerTests, ProgramBinaryCacheKey_IsStable)
+{
+    auto const key1 = TestShaderManager::CalculateProgramBinaryCacheKey("vertex", "fragment", "driver");
+    auto const key2 = TestShaderManager::CalculateProgramBinaryCacheKey("vertex", "fragment", "driver");
+
+    EXPECT_EQ(key1, key2);
+}
+
+TEST_F(ShaderManagerTests, ProgramBinaryCacheKey_ChangesWithSources)
+{
+    auto const key = TestShaderManager::CalculateProgramBinaryCacheKey("vertex", "fragment", "driver");
+
+    EXPECT_NE(key, TestShaderManager::CalculateProgramBinaryCacheKey("vertex2", "fragment", "driver"));
+    EXPECT_NE(key, TestShaderManager::CalculateProgramBinaryCacheKey("vertex", "fragment2", "driver"));
+
+    // Moving text between the sources changes the key
+    EXPECT_NE(key, TestShaderManager::CalculateProgramBinaryCacheKey("vertexf", "ragment", "driver"));
+}
+
+TEST_F(ShaderManagerTests, ProgramBinaryCacheKey_ChangesWithDriver)
+{
+    auto const key = TestShaderManager::CalculateProgramBinaryCacheKey("vertex", "fragment", "Vendor|Renderer|4.6.0");
+
+    EXPECT_NE(key, TestShaderManager::CalculateProgramBinaryCacheKey("vertex", "fragment", "Vendor|Renderer|4.6.1"));
+}
@@ -0,0 +1,87 @@
+#include <Game/ShipDefinitionDelta.h>
+
+#include "gtest/gtest.h"
+
+namespace {
+
+ShipDefinition MakeShipDefinition(ShipSpaceSize const & shipSize)
+{
+    return ShipDefinition(
+        shipSize,
+        ShipLayers(
+            StructuralLayerData(shipSize),
+            nullptr,
+            nullptr,
+            nullptr),
+        ShipMetadata("Original"),
+        ShipPhysicsData(),
+        std::nullopt);
+}
+
+}
+
+TEST(ShipDefinitionDeltaTests, ApplyTo_StructuralLayerRegion)
+{
+    MaterialColorKey const colorKey(1, 2, 3);
+    StructuralMaterial const material(colorKey, "Test Material", rgbaColor(colorKey, 255));
+
+    ShipDefinitionDelta delta(ShipSpaceSize(8, 6));
+    delta.StructuralLayerRegion.emplace(
+        ShipSpaceCoordinates(3, 2),
+        StructuralLayerData(ShipSpaceSize(2, 3), StructuralElement(&material)));
+
+    ShipDefinition shipDefinition = MakeShipDefinition(ShipSpaceSize(8, 6));
+    ASSERT_TRUE(delta.IsApplicableTo(shipDefinition));
+
+    ShipDefinition const result = delta.ApplyTo(std::move(shipDefinition));
+
+    for (int y = 0; y < 6; ++y)
+    {
+        for (int x = 0; x < 8; ++x)
+        {
+            bool const isInRegion = (x >= 3 && x < 5 && y >= 2 && y < 5);
+            EXPECT_EQ(result.Layers.StructuralLayer.Buffer[ShipSpaceCoordinates(x, y)].Material, isInRegion ? &material : nullptr);
+        }
+    }
+
+    // Untouched properties
+    EXPECT_EQ(result.Metadata.ShipName, "Original");
+}
+
+TEST(ShipDefinitionDeltaTests, ApplyTo_Properties)
+{
+    ShipDefinitionDelta delta(ShipSpaceSize(8, 6));
+    delta.Metadata.emplace("Changed");
+    delta.AutoTexturizationSettings.emplace(ShipAutoTexturizationSettings());
+
+    ShipDefinition const result = delta.ApplyTo(MakeShipDefinition(ShipSpaceSize(8, 6)));
+
+    EXPECT_EQ(result.Metadata.ShipName, "Changed");
+    EXPECT_TRUE(result.AutoTexturizationSettings.has_value());
+}
+
+TEST(ShipDefinitionDeltaTests, IsApplicableTo_ShapeMismatch)
+{
+    ShipDefinition const shipDefinition = MakeShipDefinition(ShipSpaceSize(8, 6));
+
+    // Different size
+    EXPECT_FALSE(ShipDefinitionDelta(ShipSpaceSize(6, 8)).IsApplicableTo(shipDefinition));
+
+    // Region out of the ship
+    {
+        ShipDefinitionDelta delta(ShipSpaceSize(8, 6));
+        delta.StructuralLayerRegion.emplace(
+            ShipSpaceCoordinates(7, 0),
+            StructuralLayerData(ShipSpaceSize(2, 2)));
+
+        EXPECT_FALSE(delta.IsApplicableTo(shipDefinition));
+    }
+
+    // Missing layer
+    {
+        ShipDefinitionDelta delta(ShipSpaceSize(8, 6));
+        delta.RopesLayer.emplace();
+
+        EXPECT_FALSE(delta.IsApplicableTo(shipDefinition));
+    }
+}
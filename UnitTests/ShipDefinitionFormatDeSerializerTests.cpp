@@ -84,6 +84,33 @@ TEST(ShipDefinitionFormatDeSerializerTests, ShipAttributes)
     EXPECT_EQ(sourceShipAttributes.LastWriteTime, targetShipAttributes.LastWriteTime);
 }
 
+TEST(ShipDefinitionFormatDeSerializerTests, SectionIndex)
+{
+    DeSerializationBuffer<BigEndianess> buffer(256);
+
+    // Write
+
+    std::vector<ShipDefinitionFormatDeSerializer::SectionIndexEntry> sourceSectionIndex;
+    sourceSectionIndex.emplace_back(static_cast<std::uint32_t>(ShipDefinitionFormatDeSerializer::MainSectionTagType::ShipAttributes), 32, 45);
+    sourceSectionIndex.emplace_back(static_cast<std::uint32_t>(ShipDefinitionFormatDeSerializer::MainSectionTagType::Metadata), 85, 1000);
+    sourceSectionIndex.emplace_back(static_cast<std::uint32_t>(ShipDefinitionFormatDeSerializer::MainSectionTagType::Tail), 1093, 0);
+
+    size_t const sectionBodySize = ShipDefinitionFormatDeSerializer::AppendSectionIndex(sourceSectionIndex, buffer);
+    EXPECT_EQ(sectionBodySize, buffer.GetSize());
+
+    // Read
+
+    auto const targetSectionIndex = ShipDefinitionFormatDeSerializer::ReadSectionIndex(buffer);
+
+    ASSERT_EQ(sourceSectionIndex.size(), targetSectionIndex.size());
+    for (size_t e = 0; e < sourceSectionIndex.size(); ++e)
+    {
+        EXPECT_EQ(sourceSectionIndex[e].Tag, targetSectionIndex[e].Tag);
+        EXPECT_EQ(sourceSectionIndex[e].SectionOffset, targetSectionIndex[e].SectionOffset);
+        EXPECT_EQ(sourceSectionIndex[e].SectionBodySize, targetSectionIndex[e].SectionBodySize);
+    }
+}
+
 TEST(ShipDefinitionFormatDeSerializerTests, Metadata_Full)
 {
     DeSerializationBuffer<BigEndianess> buffer(256);
@@ -0,0 +1,146 @@
+#include <Game/ShipFactoryCache.h>
+
+#include "Utils.h"
+
+#include <filesystem>
+
+#include "gtest/gtest.h"
+
+class ShipFactoryCacheTests : public testing::Test
+{
+protected:
+
+    void SetUp() override
+    {
+        mCacheFolderPath = std::filesystem::temp_directory_path() / "FloatingSandboxTests" / ("shipfactorycache_" + std::string(testing::UnitTest::GetInstance()->current_test_info()->name()));
+        std::filesystem::remove_all(mCacheFolderPath);
+    }
+
+    void TearDown() override
+    {
+        std::filesystem::remove_all(mCacheFolderPath);
+    }
+
+    static StructuralLayerData MakeStructuralLayer(
+        StructuralMaterial const & material1,
+        StructuralMaterial const & material2)
+    {
+        StructuralLayerData layer(ShipSpaceSize(4, 3));
+        layer.Buffer[ShipSpaceCoordinates(0, 0)] = StructuralElement(&material1);
+        layer.Buffer[ShipSpaceCoordinates(1, 0)] = StructuralElement(&material1);
+        layer.Buffer[ShipSpaceCoordinates(2, 1)] = StructuralElement(&material2);
+        return layer;
+    }
+
+    static std::vector<ShipFactoryFrontier> MakeFrontiers()
+    {
+        std::vector<ShipFactoryFrontier> frontiers;
+        frontiers.emplace_back(FrontierType::External, std::vector<ElementIndex>{ 0, 2, 1 });
+        frontiers.emplace_back(FrontierType::Internal, std::vector<ElementIndex>{ 3 });
+        return frontiers;
+    }
+
+    std::filesystem::path mCacheFolderPath;
+};
+
+TEST_F(ShipFactoryCacheTests, Key_DependsOnContent)
+{
+    StructuralMaterial const m1 = MakeTestStructuralMaterial("Foo", rgbColor(1, 2, 3));
+    StructuralMaterial const m2 = MakeTestStructuralMaterial("Bar", rgbColor(4, 5, 6));
+    StructuralMaterial const m1Copy = MakeTestStructuralMaterial("Foo", rgbColor(1, 2, 3));
+    StructuralMaterial const m2Copy = MakeTestStructuralMaterial("Bar", rgbColor(4, 5, 6));
+
+    auto const key = ShipFactoryCache::CalculateKey(MakeStructuralLayer(m1, m2), nullptr, std::nullopt);
+
+    // Same content, different material instances
+    EXPECT_EQ(key, ShipFactoryCache::CalculateKey(MakeStructuralLayer(m1Copy, m2Copy), nullptr, std::nullopt));
+
+    // Different structure
+    EXPECT_NE(key, ShipFactoryCache::CalculateKey(MakeStructuralLayer(m2, m1), nullptr, std::nullopt));
+
+    // Different ropes
+    RopesLayerData ropesLayer;
+    ropesLayer.Buffer.EmplaceBack(ShipSpaceCoordinates(0, 0), ShipSpaceCoordinates(2, 1), &m1, rgbaColor(1, 2, 3, 4));
+    EXPECT_NE(key, ShipFactoryCache::CalculateKey(MakeStructuralLayer(m1, m2), &ropesLayer, std::nullopt));
+
+    // Different texturization
+    EXPECT_NE(key, ShipFactoryCache::CalculateKey(MakeStructuralLayer(m1, m2), nullptr, ShipAutoTexturizationSettings()));
+    EXPECT_NE(
+        ShipFactoryCache::CalculateKey(MakeStructuralLayer(m1, m2), nullptr, ShipAutoTexturizationSettings()),
+        ShipFactoryCache::CalculateKey(MakeStructuralLayer(m1, m2), nullptr, ShipAutoTexturizationSettings(ShipAutoTexturizationModeType::FlatStructure, 1.0f, 0.0f)));
+}
+
+TEST_F(ShipFactoryCacheTests, StoreAndLoad)
+{
+    ShipFactoryCache cache(mCacheFolderPath);
+
+    std::vector<ElementIndex> const pointIndexRemap{ 2, 0, 1 };
+    std::vector<ElementIndex> const springIndexRemap{ 3, 1, 0, 2 };
+
+    RgbaImageData texture(ImageSize(2, 2));
+    for (int i = 0; i < 4; ++i)
+    {
+        texture.Data[i] = rgbaColor(static_cast<std::uint8_t>(i), 10, 20, 255);
+    }
+
+    EXPECT_FALSE(cache.TryLoad(42, 3, 4).has_value());
+
+    cache.TryStore(42, pointIndexRemap, springIndexRemap, MakeFrontiers(), &texture);
+
+    auto const entry = cache.TryLoad(42, 3, 4);
+    ASSERT_TRUE(entry.has_value());
+
+    EXPECT_EQ(pointIndexRemap, entry->PointIndexRemap);
+    EXPECT_EQ(springIndexRemap, entry->SpringIndexRemap);
+
+    ASSERT_EQ(2u, entry->Frontiers.size());
+    EXPECT_EQ(FrontierType::External, entry->Frontiers[0].Type);
+    EXPECT_EQ(std::vector<ElementIndex>({ 0, 2, 1 }), entry->Frontiers[0].EdgeIndices2);
+    EXPECT_EQ(FrontierType::Internal, entry->Frontiers[1].Type);
+    EXPECT_EQ(std::vector<ElementIndex>({ 3 }), entry->Frontiers[1].EdgeIndices2);
+
+    ASSERT_TRUE(entry->AutoTexture.has_value());
+    ASSERT_EQ(ImageSize(2, 2), entry->AutoTexture->Size);
+    for (int i = 0; i < 4; ++i)
+    {
+        EXPECT_EQ(texture.Data[i], entry->AutoTexture->Data[i]);
+    }
+}
+
+TEST_F(ShipFactoryCacheTests, StoreAndLoad_NoTexture)
+{
+    ShipFactoryCache cache(mCacheFolderPath);
+
+    cache.TryStore(42, { 0, 1 }, { 1, 0 }, {}, nullptr);
+
+    auto const entry = cache.TryLoad(42, 2, 2);
+    ASSERT_TRUE(entry.has_value());
+    EXPECT_TRUE(entry->Frontiers.empty());
+    EXPECT_FALSE(entry->AutoTexture.has_value());
+}
+
+TEST_F(ShipFactoryCacheTests, Load_MismatchingCounts)
+{
+    ShipFactoryCache cache(mCacheFolderPath);
+
+    cache.TryStore(42, { 2, 0, 1 }, { 3, 1, 0, 2 }, MakeFrontiers(), nullptr);
+
+    EXPECT_FALSE(cache.TryLoad(42, 4, 4).has_value());
+    EXPECT_FALSE(cache.TryLoad(42, 3, 3).has_value());
+    EXPECT_TRUE(cache.TryLoad(42, 3, 4).has_value());
+}
+
+TEST_F(ShipFactoryCacheTests, EvictsOldestEntries)
+{
+    ShipFactoryCache cache(mCacheFolderPath, 2);
+
+    cache.TryStore(1, { 0 }, { 0 }, {}, nullptr);
+    std::filesystem::last_write_time(mCacheFolderPath / "0000000000000001.shipcache", std::filesystem::file_time_type::clock::now() - std::chrono::hours(2));
+    cache.TryStore(2, { 0 }, { 0 }, {}, nullptr);
+    std::filesystem::last_write_time(mCacheFolderPath / "0000000000000002.shipcache", std::filesystem::file_time_type::clock::now() - std::chrono::hours(1));
+    cache.TryStore(3, { 0 }, { 0 }, {}, nullptr);
+
+    EXPECT_FALSE(cache.TryLoad(1, 1, 1).has_value());
+    EXPECT_TRUE(cache.TryLoad(2, 1, 1).has_value());
+    EXPECT_TRUE(cache.TryLoad(3, 1, 1).has_value());
+}
@@ -0,0 +1,148 @@
+#include <UILib/ShipPreviewIndex.h>
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace /* anonymous */ {
+
+    ShipMetadata MakeMetadata(
+        std::string const & shipName,
+        std::optional<std::string> const & author = std::nullopt,
+        std::optional<std::string> const & yearBuilt = std::nullopt)
+    {
+        ShipMetadata metadata(shipName);
+        metadata.Author = author;
+        metadata.YearBuilt = yearBuilt;
+        return metadata;
+    }
+
+    std::vector<ShipPreviewIndex::EntryId> GetOrder(ShipPreviewIndex const & index)
+    {
+        std::vector<ShipPreviewIndex::EntryId> order;
+        for (size_t p = 0; p < index.GetEntryCount(); ++p)
+        {
+            order.push_back(index.GetEntryAt(p));
+            EXPECT_EQ(p, index.GetPositionOf(order.back()));
+        }
+
+        return order;
+    }
+}
+
+TEST(ShipPreviewIndexTests, Sort_WithoutMetadata_ByFilename)
+{
+    ShipPreviewIndex index(ShipPreviewIndex::SortMethod::ByName, false);
+    index.Reset({ "c.shp", "a.shp", "b.shp" });
+
+    EXPECT_EQ(std::vector<ShipPreviewIndex::EntryId>({ 1, 2, 0 }), GetOrder(index));
+
+    index.SetSortMethod(ShipPreviewIndex::SortMethod::ByName, true);
+
+    EXPECT_EQ(std::vector<ShipPreviewIndex::EntryId>({ 0, 2, 1 }), GetOrder(index));
+}
+
+TEST(ShipPreviewIndexTests, Sort_IncrementalMetadata)
+{
+    ShipPreviewIndex index(ShipPreviewIndex::SortMethod::ByName, false);
+    index.Reset({ "1.shp", "2.shp", "3.shp", "4.shp" });
+
+    // Metadata-having entries come first
+    index.SetMetadata(2, MakeMetadata("Titanic"), 0, PortableTimepoint(10));
+    EXPECT_EQ(std::vector<ShipPreviewIndex::EntryId>({ 2, 0, 1, 3 }), GetOrder(index));
+
+    index.SetMetadata(3, MakeMetadata("andrea doria"), 3, PortableTimepoint(30));
+    index.SetMetadata(0, MakeMetadata("Lusitania"), 1, PortableTimepoint(20));
+    EXPECT_EQ(std::vector<ShipPreviewIndex::EntryId>({ 3, 0, 2, 1 }), GetOrder(index));
+
+    // Other sort orders see all the metadata that arrived before them...
+    index.SetSortMethod(ShipPreviewIndex::SortMethod::ByLastModified, false);
+    EXPECT_EQ(std::vector<ShipPreviewIndex::EntryId>({ 3, 0, 2, 1 }), GetOrder(index));
+
+    index.SetSortMethod(ShipPreviewIndex::SortMethod::ByFeatures, true);
+    EXPECT_EQ(std::vector<ShipPreviewIndex::EntryId>({ 2, 0, 3, 1 }), GetOrder(index));
+
+    // ...and after them
+    index.SetMetadata(1, MakeMetadata("Britannic"), 2, PortableTimepoint(40));
+    EXPECT_EQ(std::vector<ShipPreviewIndex::EntryId>({ 2, 0, 1, 3 }), GetOrder(index));
+
+    index.SetSortMethod(ShipPreviewIndex::SortMethod::ByName, false);
+    EXPECT_EQ(std::vector<ShipPreviewIndex::EntryId>({ 3, 1, 0, 2 }), GetOrder(index));
+}
+
+TEST(ShipPreviewIndexTests, Sort_ByYearBuilt_MissingYearsLast)
+{
+    ShipPreviewIndex index(ShipPreviewIndex::SortMethod::ByYearBuilt, true);
+    index.Reset({ "1.shp", "2.shp", "3.shp" });
+
+    index.SetMetadata(0, MakeMetadata("A"), 0, PortableTimepoint(0));
+    index.SetMetadata(1, MakeMetadata("B", std::nullopt, std::string("1912")), 0, PortableTimepoint(0));
+    index.SetMetadata(2, MakeMetadata("C", std::nullopt, std::string("1915")), 0, PortableTimepoint(0));
+
+    EXPECT_EQ(std::vector<ShipPreviewIndex::EntryId>({ 2, 1, 0 }), GetOrder(index));
+}
+
+TEST(ShipPreviewIndexTests, FindNext)
+{
+    ShipPreviewIndex index(ShipPreviewIndex::SortMethod::ByName, false);
+    index.Reset({ "one.shp", "two.shp", "three.shp" });
+
+    index.SetMetadata(0, MakeMetadata("Queen Mary", std::string("Someone")), 0, PortableTimepoint(0));
+    index.SetMetadata(1, MakeMetadata("Queen Elizabeth", std::string("Someone Else")), 0, PortableTimepoint(0));
+
+    // Positions: 1 (Queen Elizabeth), 0 (Queen Mary), 2 (three.shp)
+
+    EXPECT_EQ(std::optional<size_t>(0), index.FindNext("QUEEN", 0));
+    EXPECT_EQ(std::optional<size_t>(1), index.FindNext("queen", 1));
+    EXPECT_EQ(std::optional<size_t>(0), index.FindNext("queen", 2)); // Wraps around
+    EXPECT_EQ(std::optional<size_t>(1), index.FindNext("mary", 0));
+    EXPECT_EQ(std::optional<size_t>(0), index.FindNext("else", 1)); // Author
+    EXPECT_EQ(std::optional<size_t>(2), index.FindNext("three.", 0)); // Filename
+    EXPECT_EQ(std::optional<size_t>(1), index.FindNext("y", 2)); // Shorter than a trigram
+
+    EXPECT_FALSE(index.FindNext("queen mary elizabeth", 0).has_value());
+    EXPECT_FALSE(index.FindNext("zzz", 0).has_value());
+    EXPECT_FALSE(index.FindNext("maryqueen", 0).has_value()); // Trigrams from different strings
+}
+
+TEST(ShipPreviewIndexTests, FindNext_MatchesLinearScan)
+{
+    ShipPreviewIndex index(ShipPreviewIndex::SortMethod::ByName, false);
+
+    std::vector<std::string> filenames;
+    std::vector<std::string> names;
+    for (size_t i = 0; i < 200; ++i)
+    {
+        filenames.push_back("ship" + std::to_string(i) + ".shp");
+        names.push_back("Name" + std::to_string((i * 37) % 101));
+    }
+
+    index.Reset(filenames);
+    for (size_t i = 0; i < names.size(); i += 2)
+    {
+        index.SetMetadata(i, MakeMetadata(names[i]), 0, PortableTimepoint(0));
+    }
+
+    for (std::string const & text : { std::string("name1"), std::string("e5"), std::string("p19"), std::string("ame99") })
+    {
+        for (size_t start : { size_t(0), size_t(57), size_t(199) })
+        {
+            std::optional<size_t> expected;
+            for (size_t i = 0; i < filenames.size(); ++i)
+            {
+                size_t const position = (start + i) % filenames.size();
+                size_t const e = index.GetEntryAt(position);
+                std::string const name = (e % 2 == 0) ? "name" + std::to_string((e * 37) % 101) : std::string();
+                if (filenames[e].find(text) != std::string::npos || name.find(text) != std::string::npos)
+                {
+                    expected = position;
+                    break;
+                }
+            }
+
+            EXPECT_EQ(expected, index.FindNext(text, start));
+        }
+    }
+}
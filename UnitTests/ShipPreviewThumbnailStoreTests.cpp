@@ -0,0 +1,189 @@
+#include <Game/ShipPreviewThumbnailStore.h>
+
+#include <filesystem>
+#include <sstream>
+
+#include "gtest/gtest.h"
+
+class ShipPreviewThumbnailStoreTests : public testing::Test
+{
+protected:
+
+    void SetUp() override
+    {
+        mPackFilePath = std::filesystem::temp_directory_path() / "FloatingSandboxTests" / ("thumbnails_" + std::string(testing::UnitTest::GetInstance()->current_test_info()->name()) + ".pack");
+        std::filesystem::remove(mPackFilePath);
+    }
+
+    void TearDown() override
+    {
+        std::filesystem::remove(mPackFilePath);
+    }
+
+    static RgbaImageData MakeThumbnail(
+        int width,
+        int height,
+        std::uint8_t seed)
+    {
+        auto data = std::make_unique<rgbaColor[]>(width * height);
+        for (int i = 0; i < width * height; ++i)
+        {
+            data[i] = rgbaColor(seed, static_cast<std::uint8_t>(i), static_cast<std::uint8_t>(i * 3), 255);
+        }
+
+        return RgbaImageData(ImageSize(width, height), std::move(data));
+    }
+
+    static void VerifyThumbnail(
+        std::optional<RgbaImageData> const & thumbnail,
+        int width,
+        int height,
+        std::uint8_t seed)
+    {
+        ASSERT_TRUE(thumbnail.has_value());
+        ASSERT_EQ(ImageSize(width, height), thumbnail->Size);
+
+        auto const expected = MakeThumbnail(width, height, seed);
+        for (int i = 0; i < width * height; ++i)
+        {
+            EXPECT_EQ(expected.Data[i], thumbnail->Data[i]);
+        }
+    }
+
+    std::filesystem::path mPackFilePath;
+};
+
+TEST_F(ShipPreviewThumbnailStoreTests, ContentHash)
+{
+    std::istringstream s1("Some preview content");
+    std::istringstream s2("Some preview content");
+    std::istringstream s3("Some other preview content");
+    std::istringstream s4("Some preview content");
+
+    auto const h1 = ShipPreviewThumbnailStore::CalculateContentHash(s1, ImageSize(200, 150));
+    auto const h2 = ShipPreviewThumbnailStore::CalculateContentHash(s2, ImageSize(200, 150));
+    auto const h3 = ShipPreviewThumbnailStore::CalculateContentHash(s3, ImageSize(200, 150));
+    auto const h4 = ShipPreviewThumbnailStore::CalculateContentHash(s4, ImageSize(100, 75));
+
+    EXPECT_EQ(h1, h2);
+    EXPECT_NE(h1, h3);
+    EXPECT_NE(h1, h4);
+}
+
+TEST_F(ShipPreviewThumbnailStoreTests, PutAndGet)
+{
+    ShipPreviewThumbnailStore store(mPackFilePath);
+
+    EXPECT_EQ(0u, store.GetThumbnailCount());
+    EXPECT_FALSE(store.TryGet(1).has_value());
+
+    store.Put(1, MakeThumbnail(10, 8, 1));
+    store.Put(2, MakeThumbnail(7, 3, 2));
+
+    EXPECT_EQ(2u, store.GetThumbnailCount());
+    VerifyThumbnail(store.TryGet(1), 10, 8, 1);
+    VerifyThumbnail(store.TryGet(2), 7, 3, 2);
+    EXPECT_FALSE(store.TryGet(3).has_value());
+}
+
+TEST_F(ShipPreviewThumbnailStoreTests, PersistsAcrossInstances)
+{
+    {
+        ShipPreviewThumbnailStore store(mPackFilePath);
+
+        store.Put(1, MakeThumbnail(10, 8, 1));
+        store.Flush();
+
+        store.Put(2, MakeThumbnail(7, 3, 2));
+
+        // Flushes at destruction
+    }
+
+    {
+        ShipPreviewThumbnailStore store(mPackFilePath);
+
+        EXPECT_EQ(2u, store.GetThumbnailCount());
+        VerifyThumbnail(store.TryGet(1), 10, 8, 1);
+        VerifyThumbnail(store.TryGet(2), 7, 3, 2);
+
+        store.Put(3, MakeThumbnail(4, 4, 3));
+    }
+
+    {
+        ShipPreviewThumbnailStore store(mPackFilePath);
+
+        EXPECT_EQ(3u, store.GetThumbnailCount());
+        VerifyThumbnail(store.TryGet(1), 10, 8, 1);
+        VerifyThumbnail(store.TryGet(2), 7, 3, 2);
+        VerifyThumbnail(store.TryGet(3), 4, 4, 3);
+    }
+}
+
+TEST_F(ShipPreviewThumbnailStoreTests, EvictsLeastRecentlyUsed)
+{
+    // Room for three 10x10 thumbnails
+    ShipPreviewThumbnailStore store(mPackFilePath, 3 * 10 * 10 * sizeof(rgbaColor));
+
+    store.Put(1, MakeThumbnail(10, 10, 1));
+    store.Put(2, MakeThumbnail(10, 10, 2));
+    store.Put(3, MakeThumbnail(10, 10, 3));
+
+    // Use 1, so that 2 becomes the least recently used
+    VerifyThumbnail(store.TryGet(1), 10, 10, 1);
+
+    store.Put(4, MakeThumbnail(10, 10, 4));
+
+    EXPECT_FALSE(store.TryGet(2).has_value());
+    VerifyThumbnail(store.TryGet(1), 10, 10, 1);
+    VerifyThumbnail(store.TryGet(4), 10, 10, 4);
+}
+
+TEST_F(ShipPreviewThumbnailStoreTests, CompactsAfterEvictions)
+{
+    {
+        ShipPreviewThumbnailStore store(mPackFilePath, 2 * 10 * 10 * sizeof(rgbaColor));
+
+        for (ShipPreviewThumbnailStore::ContentHash h = 1; h <= 10; ++h)
+        {
+            store.Put(h, MakeThumbnail(10, 10, static_cast<std::uint8_t>(h)));
+        }
+
+        store.Flush();
+    }
+
+    // Only the live thumbnails are left in the file
+    EXPECT_LT(std::filesystem::file_size(mPackFilePath), 3u * 10u * 10u * sizeof(rgbaColor));
+
+    {
+        ShipPreviewThumbnailStore store(mPackFilePath, 2 * 10 * 10 * sizeof(rgbaColor));
+
+        EXPECT_GE(store.GetThumbnailCount(), 1u);
+        VerifyThumbnail(store.TryGet(10), 10, 10, 10);
+    }
+}
+
+TEST_F(ShipPreviewThumbnailStoreTests, UnflushedAppendsInvalidatePack)
+{
+    {
+        ShipPreviewThumbnailStore store(mPackFilePath);
+
+        store.Put(1, MakeThumbnail(10, 8, 1));
+        store.Flush();
+    }
+
+    // Simulate a crash after appending over the index
+    {
+        std::fstream packFile(mPackFilePath, std::ios_base::in | std::ios_base::out | std::ios_base::binary);
+        packFile.seekp(0, std::ios_base::end);
+        packFile.seekp(-4, std::ios_base::cur);
+        packFile.write("XXXX", 4);
+    }
+
+    ShipPreviewThumbnailStore store(mPackFilePath);
+
+    EXPECT_EQ(0u, store.GetThumbnailCount());
+
+    // And still usable
+    store.Put(2, MakeThumbnail(7, 3, 2));
+    VerifyThumbnail(store.TryGet(2), 7, 3, 2);
+}
@@ -0,0 +1,158 @@
+#include <GameCore/SnapshotHistory.h>
+
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace /* anonymous */ {
+
+    std::vector<std::uint8_t> MakeData(
+        size_t size,
+        std::uint8_t seed)
+    {
+        std::vector<std::uint8_t> data(size, 0);
+        for (size_t i = 0; i < size; i += 16)
+        {
+            data[i] = static_cast<std::uint8_t>(seed + i);
+        }
+
+        return data;
+    }
+
+    void WaitForFrames(
+        SnapshotHistory & history,
+        size_t frameCount)
+    {
+        history.WaitForPendingPushes();
+        ASSERT_EQ(frameCount, history.GetFrameCount());
+    }
+}
+
+TEST(SnapshotHistoryTests, Codec_RoundTrip_Keyframe)
+{
+    auto const data = MakeData(1000, 3);
+
+    auto const encoded = SnapshotHistory::Encode(data, nullptr);
+
+    // Mostly zeroes, hence it compresses
+    EXPECT_LT(encoded.size(), data.size());
+
+    std::vector<std::uint8_t> decoded(data.size(), 0);
+    SnapshotHistory::DecodeInto(encoded, decoded);
+
+    EXPECT_EQ(data, decoded);
+}
+
+TEST(SnapshotHistoryTests, Codec_RoundTrip_Delta)
+{
+    auto const reference = MakeData(1001, 3);
+    auto data = reference;
+    data[0] ^= 0xff;
+    data[500] = 42;
+    data[501] = 43;
+    data[1000] = 1;
+
+    auto const encoded = SnapshotHistory::Encode(data, &reference);
+
+    // Only a few bytes differ
+    EXPECT_LT(encoded.size(), 64u);
+
+    auto decoded = reference;
+    SnapshotHistory::DecodeInto(encoded, decoded);
+
+    EXPECT_EQ(data, decoded);
+}
+
+TEST(SnapshotHistoryTests, Codec_RoundTrip_Edges)
+{
+    for (std::vector<std::uint8_t> const & data : {
+        std::vector<std::uint8_t>(),
+        std::vector<std::uint8_t>(13, 0),
+        std::vector<std::uint8_t>(13, 0xab),
+        std::vector<std::uint8_t>({ 1, 0, 0, 2, 0, 0, 0, 0, 0, 0, 0, 0, 0, 3, 0, 0 }) })
+    {
+        auto const encoded = SnapshotHistory::Encode(data, nullptr);
+
+        std::vector<std::uint8_t> decoded(data.size(), 0);
+        SnapshotHistory::DecodeInto(encoded, decoded);
+
+        EXPECT_EQ(data, decoded);
+    }
+}
+
+TEST(SnapshotHistoryTests, DecodeFrame_ReconstructsAllFrames)
+{
+    SnapshotHistory history(std::numeric_limits<size_t>::max(), 3);
+
+    std::vector<std::vector<std::uint8_t>> frames;
+    for (std::uint8_t f = 0; f < 7; ++f)
+    {
+        frames.emplace_back(MakeData(500, f));
+        history.Push(static_cast<float>(f), StateSnapshot(std::vector<std::uint8_t>(frames.back())));
+
+        // So that no snapshot is dropped
+        WaitForFrames(history, f + 1u);
+    }
+
+    for (size_t f = 0; f < frames.size(); ++f)
+    {
+        EXPECT_EQ(static_cast<float>(f), history.GetFrameSimulationTime(f));
+        EXPECT_EQ(frames[f], history.DecodeFrame(f).GetData());
+    }
+}
+
+TEST(SnapshotHistoryTests, MaxByteSize_EvictsOldestKeyframeWithDeltas)
+{
+    // Room for about two groups of (keyframe + delta)
+    SnapshotHistory history(300, 2);
+
+    for (std::uint8_t f = 0; f < 10; ++f)
+    {
+        std::vector<std::uint8_t> data(64, f);
+        history.Push(static_cast<float>(f), StateSnapshot(std::move(data)));
+        WaitForFrames(history, history.GetFrameCount());
+    }
+
+    EXPECT_LE(history.GetByteSize(), 300u);
+
+    // Evicted in whole groups, hence the oldest frame is a keyframe and the newest is kept
+    size_t const frameCount = history.GetFrameCount();
+    ASSERT_GE(frameCount, 1u);
+    EXPECT_EQ(9.0f, history.GetFrameSimulationTime(frameCount - 1));
+    EXPECT_EQ(std::vector<std::uint8_t>(64, 9), history.DecodeFrame(frameCount - 1).GetData());
+    EXPECT_EQ(0, static_cast<int>(history.GetFrameSimulationTime(0)) % 2);
+}
+
+TEST(SnapshotHistoryTests, TruncateAfter_RestartsFromKeyframe)
+{
+    SnapshotHistory history(std::numeric_limits<size_t>::max(), 10);
+
+    for (std::uint8_t f = 0; f < 5; ++f)
+    {
+        history.Push(static_cast<float>(f), StateSnapshot(MakeData(100, f)));
+        WaitForFrames(history, f + 1u);
+    }
+
+    history.TruncateAfter(1);
+    EXPECT_EQ(2u, history.GetFrameCount());
+
+    history.Push(10.0f, StateSnapshot(MakeData(100, 10)));
+    WaitForFrames(history, 3);
+
+    EXPECT_EQ(MakeData(100, 1), history.DecodeFrame(1).GetData());
+    EXPECT_EQ(MakeData(100, 10), history.DecodeFrame(2).GetData());
+    EXPECT_EQ(10.0f, history.GetFrameSimulationTime(2));
+}
+
+TEST(SnapshotHistoryTests, Clear)
+{
+    SnapshotHistory history(std::numeric_limits<size_t>::max(), 10);
+
+    history.Push(0.0f, StateSnapshot(MakeData(100, 0)));
+    history.Clear();
+
+    EXPECT_EQ(0u, history.GetFrameCount());
+    EXPECT_EQ(0u, history.GetByteSize());
+}
@@ -0,0 +1,107 @@
+#include <GameCore/SparseBuffer2D.h>
+
+#include "gtest/gtest.h"
+
+#include <vector>
+
+TEST(SparseBuffer2DTests, Empty)
+{
+    Buffer2D<int, struct IntegralTag> buffer(10, 20, 0);
+
+    SparseBuffer2D<int, struct IntegralTag> sparseBuffer(buffer);
+
+    EXPECT_EQ(sparseBuffer.Size, IntegralRectSize(10, 20));
+    EXPECT_EQ(sparseBuffer.GetOccupiedCount(), 0u);
+
+    size_t visitCount = 0;
+    sparseBuffer.ForEachOccupied(
+        [&](IntegralCoordinates const &, int)
+        {
+            ++visitCount;
+        });
+
+    EXPECT_EQ(visitCount, 0u);
+
+    auto const denseBuffer = sparseBuffer.MakeDense();
+
+    ASSERT_EQ(denseBuffer.Size, IntegralRectSize(10, 20));
+    for (int y = 0; y < 20; ++y)
+    {
+        for (int x = 0; x < 10; ++x)
+        {
+            EXPECT_EQ(denseBuffer[IntegralCoordinates(x, y)], 0);
+        }
+    }
+}
+
+TEST(SparseBuffer2DTests, RoundTrip)
+{
+    Buffer2D<int, struct IntegralTag> buffer(6, 4, 0);
+
+    // Runs at row edges, in the middle, and a full row
+    buffer[IntegralCoordinates(0, 0)] = 1;
+    buffer[IntegralCoordinates(1, 0)] = 2;
+    buffer[IntegralCoordinates(5, 0)] = 3;
+    buffer[IntegralCoordinates(2, 1)] = 4;
+    buffer[IntegralCoordinates(4, 1)] = 5;
+    for (int x = 0; x < 6; ++x)
+    {
+        buffer[IntegralCoordinates(x, 3)] = 10 + x;
+    }
+
+    SparseBuffer2D<int, struct IntegralTag> sparseBuffer(buffer);
+
+    EXPECT_EQ(sparseBuffer.GetOccupiedCount(), 11u);
+
+    auto const denseBuffer = sparseBuffer.MakeDense();
+
+    ASSERT_EQ(denseBuffer.Size, buffer.Size);
+    for (int y = 0; y < 4; ++y)
+    {
+        for (int x = 0; x < 6; ++x)
+        {
+            EXPECT_EQ(denseBuffer[IntegralCoordinates(x, y)], buffer[IntegralCoordinates(x, y)]);
+        }
+    }
+}
+
+TEST(SparseBuffer2DTests, ForEachOccupied_VisitsOccupiedInRowMajorOrder)
+{
+    Buffer2D<int, struct IntegralTag> buffer(5, 3, 0);
+
+    buffer[IntegralCoordinates(3, 0)] = 1;
+    buffer[IntegralCoordinates(4, 0)] = 2;
+    buffer[IntegralCoordinates(0, 2)] = 3;
+    buffer[IntegralCoordinates(2, 2)] = 4;
+
+    SparseBuffer2D<int, struct IntegralTag> sparseBuffer(buffer);
+
+    std::vector<std::pair<IntegralCoordinates, int>> visited;
+    sparseBuffer.ForEachOccupied(
+        [&](IntegralCoordinates const & coords, int value)
+        {
+            visited.emplace_back(coords, value);
+        });
+
+    ASSERT_EQ(visited.size(), 4u);
+    EXPECT_EQ(visited[0].first, IntegralCoordinates(3, 0));
+    EXPECT_EQ(visited[0].second, 1);
+    EXPECT_EQ(visited[1].first, IntegralCoordinates(4, 0));
+    EXPECT_EQ(visited[1].second, 2);
+    EXPECT_EQ(visited[2].first, IntegralCoordinates(0, 2));
+    EXPECT_EQ(visited[2].second, 3);
+    EXPECT_EQ(visited[3].first, IntegralCoordinates(2, 2));
+    EXPECT_EQ(visited[3].second, 4);
+}
+
+TEST(SparseBuffer2DTests, ByteSize_IsProportionalToOccupied)
+{
+    Buffer2D<int, struct IntegralTag> buffer(200, 100, 0);
+
+    buffer[IntegralCoordinates(10, 10)] = 1;
+    buffer[IntegralCoordinates(11, 10)] = 1;
+
+    SparseBuffer2D<int, struct IntegralTag> sparseBuffer(buffer);
+
+    EXPECT_LT(sparseBuffer.GetByteSize(), buffer.GetByteSize() / 10);
+}
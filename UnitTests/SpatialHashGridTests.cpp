@@ -0,0 +1,155 @@
+#include <GameCore/GameGeometry.h>
+#include <GameCore/SpatialHashGrid.h>
+
+#include "gtest/gtest.h"
+
+#include <limits>
+#include <random>
+
+namespace {
+
+std::vector<ElementIndex> BruteForceQuery(
+    std::vector<vec2f> const & positions,
+    Geometry::AABB const & box)
+{
+    std::vector<ElementIndex> result;
+    for (ElementIndex e = 0; e < positions.size(); ++e)
+    {
+        if (positions[e].x >= box.BottomLeft.x && positions[e].x <= box.TopRight.x
+            && positions[e].y >= box.BottomLeft.y && positions[e].y <= box.TopRight.y)
+        {
+            result.push_back(e);
+        }
+    }
+
+    return result;
+}
+
+}
+
+TEST(SpatialHashGridTests, Empty)
+{
+    SpatialHashGrid grid(2.0f);
+    grid.Rebuild(nullptr, 0);
+
+    std::vector<ElementIndex> result;
+    grid.Query(Geometry::AABB(-10.0f, 10.0f, 10.0f, -10.0f), result);
+
+    EXPECT_TRUE(result.empty());
+}
+
+TEST(SpatialHashGridTests, Query_IsSortedSupersetOfBruteForce)
+{
+    std::mt19937 engine(42);
+    std::uniform_real_distribution<float> distribution(-100.0f, 100.0f);
+
+    std::vector<vec2f> positions;
+    for (int i = 0; i < 2000; ++i)
+        positions.emplace_back(distribution(engine), distribution(engine));
+
+    SpatialHashGrid grid(2.0f);
+    grid.Rebuild(positions.data(), static_cast<ElementCount>(positions.size()));
+
+    std::vector<ElementIndex> result;
+    for (int q = 0; q < 100; ++q)
+    {
+        vec2f const center(distribution(engine), distribution(engine));
+        float const radius = 0.5f + static_cast<float>(q % 10);
+        Geometry::AABB const box(center.x - radius, center.x + radius, center.y + radius, center.y - radius);
+
+        grid.Query(box, result);
+
+        ASSERT_TRUE(std::is_sorted(result.cbegin(), result.cend()));
+        ASSERT_EQ(result.cend(), std::adjacent_find(result.cbegin(), result.cend()));
+
+        auto const expected = BruteForceQuery(positions, box);
+        ASSERT_TRUE(std::includes(result.cbegin(), result.cend(), expected.cbegin(), expected.cend()));
+    }
+}
+
+TEST(SpatialHashGridTests, Query_LargeBoxReturnsAllElements)
+{
+    std::vector<vec2f> positions{ vec2f(0.0f, 0.0f), vec2f(1000.0f, 1000.0f), vec2f(-1000.0f, 50.0f) };
+
+    SpatialHashGrid grid(1.0f);
+    grid.Rebuild(positions.data(), static_cast<ElementCount>(positions.size()));
+
+    std::vector<ElementIndex> result;
+    grid.Query(Geometry::AABB(-2000.0f, 2000.0f, 2000.0f, -2000.0f), result);
+
+    EXPECT_EQ(std::vector<ElementIndex>({ 0, 1, 2 }), result);
+}
+
+TEST(SpatialHashGridTests, NonFinitePositions)
+{
+    float const nan = std::numeric_limits<float>::quiet_NaN();
+    float const inf = std::numeric_limits<float>::infinity();
+
+    std::vector<vec2f> positions{ vec2f(1.0f, 1.0f), vec2f(nan, nan), vec2f(inf, -inf), vec2f(1.5f, 1.5f) };
+
+    SpatialHashGrid grid(2.0f);
+    grid.Rebuild(positions.data(), static_cast<ElementCount>(positions.size()));
+
+    std::vector<ElementIndex> result;
+    grid.Query(Geometry::AABB(0.0f, 2.0f, 2.0f, 0.0f), result);
+
+    std::vector<ElementIndex> const expected{ 0, 3 };
+    EXPECT_TRUE(std::includes(result.cbegin(), result.cend(), expected.cbegin(), expected.cend()));
+}
+
+TEST(SpatialHashGridTests, QuerySegment_IsSortedSupersetOfBruteForce)
+{
+    std::mt19937 engine(42);
+    std::uniform_real_distribution<float> positionDistribution(-50.0f, 50.0f);
+    std::uniform_real_distribution<float> offsetDistribution(-1.5f, 1.5f);
+
+    // Short segments, like springs, plus a few long ones
+    std::vector<vec2f> positions;
+    std::vector<ElementIndex> endpointAIndices;
+    std::vector<ElementIndex> endpointBIndices;
+    for (int i = 0; i < 2000; ++i)
+    {
+        vec2f const a(positionDistribution(engine), positionDistribution(engine));
+        vec2f const b = (i % 100 == 0)
+            ? vec2f(positionDistribution(engine), positionDistribution(engine))
+            : a + vec2f(offsetDistribution(engine), offsetDistribution(engine));
+
+        endpointAIndices.push_back(static_cast<ElementIndex>(positions.size()));
+        positions.push_back(a);
+        endpointBIndices.push_back(static_cast<ElementIndex>(positions.size()));
+        positions.push_back(b);
+    }
+
+    SpatialHashGrid grid(2.0f);
+    grid.RebuildForSegments(
+        endpointAIndices.data(),
+        endpointBIndices.data(),
+        positions.data(),
+        static_cast<ElementCount>(endpointAIndices.size()));
+
+    std::vector<ElementIndex> result;
+    for (int q = 0; q < 200; ++q)
+    {
+        vec2f const start(positionDistribution(engine), positionDistribution(engine));
+        vec2f const end = (q % 2 == 0)
+            ? start + vec2f(offsetDistribution(engine), offsetDistribution(engine))
+            : vec2f(positionDistribution(engine), positionDistribution(engine));
+
+        grid.QuerySegment(start, end, result);
+
+        ASSERT_TRUE(std::is_sorted(result.cbegin(), result.cend()));
+        ASSERT_EQ(result.cend(), std::adjacent_find(result.cbegin(), result.cend()));
+
+        for (ElementIndex s = 0; s < endpointAIndices.size(); ++s)
+        {
+            if (Segment::ProperIntersectionTest(
+                start,
+                end,
+                positions[endpointAIndices[s]],
+                positions[endpointBIndices[s]]))
+            {
+                ASSERT_TRUE(std::binary_search(result.cbegin(), result.cend(), s));
+            }
+        }
+    }
+}
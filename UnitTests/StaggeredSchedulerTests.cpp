@@ -0,0 +1,100 @@
+#include <GameCore/StaggeredScheduler.h>
+
+#include <map>
+#include <utility>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+TEST(StaggeredSchedulerTests, EachPartitionRunsOncePerPeriod)
+{
+    StaggeredScheduler scheduler(36, { 4, 4, 4, 1 });
+
+    EXPECT_EQ(36u, scheduler.GetPeriod());
+    EXPECT_EQ(4u, scheduler.GetPartitionCount(0));
+    EXPECT_EQ(1u, scheduler.GetPartitionCount(3));
+
+    std::map<std::pair<size_t, std::uint32_t>, size_t> runCounts;
+    for (std::uint32_t step = 0; step < 36; ++step)
+    {
+        size_t stagesAtStep = 0;
+        for (size_t stage = 0; stage < 4; ++stage)
+        {
+            auto const partition = scheduler.GetScheduledPartition(stage, step);
+            if (partition.has_value())
+            {
+                EXPECT_LT(*partition, scheduler.GetPartitionCount(stage));
+                ++runCounts[std::make_pair(stage, *partition)];
+                ++stagesAtStep;
+            }
+        }
+
+        // At most one heavy pass per step
+        EXPECT_LE(stagesAtStep, 1u);
+    }
+
+    ASSERT_EQ(13u, runCounts.size());
+    for (auto const & entry : runCounts)
+    {
+        EXPECT_EQ(1u, entry.second);
+    }
+}
+
+TEST(StaggeredSchedulerTests, PartitionsAreEvenlySpread)
+{
+    StaggeredScheduler scheduler(36, { 4, 4, 4, 1 });
+
+    // Steps of all scheduled partitions, and of the partitions of the first stage
+    std::vector<std::uint32_t> allSteps;
+    std::vector<std::uint32_t> stage0Steps;
+    for (std::uint32_t step = 0; step < 36; ++step)
+    {
+        for (size_t stage = 0; stage < 4; ++stage)
+        {
+            auto const partition = scheduler.GetScheduledPartition(stage, step);
+            if (partition.has_value())
+            {
+                allSteps.push_back(step);
+
+                if (stage == 0)
+                {
+                    // Partitions of a stage run in order
+                    EXPECT_EQ(static_cast<std::uint32_t>(stage0Steps.size()), *partition);
+                    stage0Steps.push_back(step);
+                }
+            }
+        }
+    }
+
+    // 36 / 13 steps between consecutive partitions, rounded either way
+    for (size_t s = 1; s < allSteps.size(); ++s)
+    {
+        EXPECT_GE(allSteps[s] - allSteps[s - 1], 2u);
+        EXPECT_LE(allSteps[s] - allSteps[s - 1], 3u);
+    }
+
+    // Wrapping around the period, too
+    EXPECT_GE(allSteps.front() + 36 - allSteps.back(), 2u);
+    EXPECT_LE(allSteps.front() + 36 - allSteps.back(), 3u);
+
+    // The partitions of a stage are spread across the whole period
+    ASSERT_EQ(4u, stage0Steps.size());
+    for (size_t s = 1; s < stage0Steps.size(); ++s)
+    {
+        EXPECT_GE(stage0Steps[s] - stage0Steps[s - 1], 8u);
+        EXPECT_LE(stage0Steps[s] - stage0Steps[s - 1], 11u);
+    }
+}
+
+TEST(StaggeredSchedulerTests, FullPeriod)
+{
+    StaggeredScheduler scheduler(4, { 2, 2 });
+
+    EXPECT_EQ(0u, *scheduler.GetScheduledPartition(0, 0));
+    EXPECT_EQ(0u, *scheduler.GetScheduledPartition(1, 1));
+    EXPECT_EQ(1u, *scheduler.GetScheduledPartition(0, 2));
+    EXPECT_EQ(1u, *scheduler.GetScheduledPartition(1, 3));
+
+    EXPECT_FALSE(scheduler.GetScheduledPartition(1, 0).has_value());
+    EXPECT_FALSE(scheduler.GetScheduledPartition(0, 1).has_value());
+}
@@ -0,0 +1,230 @@
+#include <GameCore/ActiveElementSet.h>
+#include <GameCore/AgeOrderedElementPool.h>
+#include <GameCore/Buffer.h>
+#include <GameCore/ElementBitmap.h>
+#include <GameCore/GameException.h>
+#include <GameCore/StateSnapshot.h>
+#include <GameCore/Vectors.h>
+
+#include <cstdint>
+#include <filesystem>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace /* anonymous */ {
+
+    struct TestContainer
+    {
+        Buffer<float> Floats;
+        Buffer<vec2f> Vectors;
+        ElementBitmap Bitmap;
+        std::vector<std::uint32_t> Members;
+        std::vector<bool> Flags;
+        std::uint64_t Counter;
+
+        explicit TestContainer(size_t size)
+            : Floats(size, 0, 0.0f)
+            , Vectors(size, 0, vec2f::zero())
+            , Bitmap(static_cast<ElementCount>(size))
+            , Members()
+            , Flags()
+            , Counter(0)
+        {}
+
+        void SaveState(StateSnapshotWriter & writer) const
+        {
+            ArchiveState(*this, writer);
+        }
+
+        void LoadState(StateSnapshotReader & reader)
+        {
+            ArchiveState(*this, reader);
+        }
+
+        template<typename TSelf, typename TArchive>
+        static void ArchiveState(
+            TSelf & self,
+            TArchive & archive)
+        {
+            archive.BeginSection(42);
+            archive.Archive(self.Floats);
+            archive.Archive(self.Vectors);
+            archive.Archive(self.Bitmap);
+            archive.Archive(self.Members);
+            archive.Archive(self.Flags);
+            archive.Archive(self.Counter);
+        }
+    };
+
+    StateSnapshot TakeSnapshot(TestContainer const & container)
+    {
+        StateSnapshotWriter writer;
+        writer.ArchiveContainer(container);
+        return writer.Finish();
+    }
+
+    void RestoreSnapshot(
+        StateSnapshot const & snapshot,
+        TestContainer & container)
+    {
+        StateSnapshotReader reader(snapshot);
+        reader.ArchiveContainer(container);
+        reader.Finish();
+    }
+}
+
+TEST(StateSnapshotTests, RoundTrip)
+{
+    TestContainer source(13);
+    for (size_t i = 0; i < 13; ++i)
+    {
+        source.Floats[i] = static_cast<float>(i) * 1.5f;
+        source.Vectors[i] = vec2f(static_cast<float>(i), -static_cast<float>(i));
+    }
+
+    source.Bitmap.Set(2);
+    source.Bitmap.Set(11);
+    source.Members = { 5, 3, 8 };
+    source.Flags = { true, false, true, true };
+    source.Counter = 0x123456789ull;
+
+    auto const snapshot = TakeSnapshot(source);
+
+    TestContainer target(13);
+    target.Members = { 1, 2, 3, 4, 5, 6 };
+    RestoreSnapshot(snapshot, target);
+
+    for (size_t i = 0; i < 13; ++i)
+    {
+        EXPECT_EQ(source.Floats[i], target.Floats[i]);
+        EXPECT_EQ(source.Vectors[i], target.Vectors[i]);
+        EXPECT_EQ(source.Bitmap.Test(static_cast<ElementIndex>(i)), target.Bitmap.Test(static_cast<ElementIndex>(i)));
+    }
+
+    EXPECT_EQ(source.Members, target.Members);
+    EXPECT_EQ(source.Flags, target.Flags);
+    EXPECT_EQ(source.Counter, target.Counter);
+}
+
+TEST(StateSnapshotTests, RoundTrip_Containers)
+{
+    ActiveElementSet sourceSet(10, 2);
+    sourceSet.Add(7);
+    sourceSet.Add(2);
+
+    AgeOrderedElementPool sourcePool(10, 4);
+    sourcePool.Allocate();
+    auto const second = sourcePool.Allocate();
+    sourcePool.Allocate();
+    sourcePool.Free(second);
+
+    StateSnapshotWriter writer;
+    writer.ArchiveContainer(sourceSet);
+    writer.ArchiveContainer(sourcePool);
+    auto const snapshot = writer.Finish();
+
+    ActiveElementSet targetSet(10, 2);
+    targetSet.Add(1);
+
+    AgeOrderedElementPool targetPool(10, 4);
+
+    StateSnapshotReader reader(snapshot);
+    reader.ArchiveContainer(targetSet);
+    reader.ArchiveContainer(targetPool);
+    reader.Finish();
+
+    EXPECT_EQ(std::vector<ElementIndex>({ 2, 7 }), targetSet.GetMembers());
+    EXPECT_FALSE(targetSet.Contains(1));
+
+    EXPECT_EQ(2u, targetPool.GetAllocatedCount());
+    EXPECT_FALSE(targetPool.IsAllocated(second));
+    EXPECT_EQ(second, targetPool.Allocate());
+}
+
+TEST(StateSnapshotTests, SizeMismatch_Throws)
+{
+    TestContainer source(13);
+    auto const snapshot = TakeSnapshot(source);
+
+    TestContainer target(14);
+    EXPECT_THROW(
+        RestoreSnapshot(snapshot, target),
+        GameException);
+}
+
+TEST(StateSnapshotTests, SectionMismatch_Throws)
+{
+    StateSnapshotWriter writer;
+    writer.BeginSection(1);
+    auto const snapshot = writer.Finish();
+
+    StateSnapshotReader reader(snapshot);
+    EXPECT_THROW(
+        reader.BeginSection(2),
+        GameException);
+}
+
+TEST(StateSnapshotTests, Truncated_Throws)
+{
+    TestContainer source(13);
+    auto const snapshot = TakeSnapshot(source);
+
+    auto data = snapshot.GetData();
+    data.resize(data.size() - 1);
+    StateSnapshot const truncatedSnapshot(std::move(data));
+
+    TestContainer target(13);
+    EXPECT_THROW(
+        RestoreSnapshot(truncatedSnapshot, target),
+        GameException);
+}
+
+TEST(StateSnapshotTests, NotConsumed_Throws)
+{
+    StateSnapshotWriter writer;
+    writer.Archive(std::uint32_t(5));
+    auto const snapshot = writer.Finish();
+
+    StateSnapshotReader reader(snapshot);
+    EXPECT_THROW(
+        reader.Finish(),
+        GameException);
+}
+
+TEST(StateSnapshotTests, NotASnapshot_Throws)
+{
+    StateSnapshot const snapshot(std::vector<std::uint8_t>(16, 0xab));
+
+    EXPECT_THROW(
+        StateSnapshotReader reader(snapshot),
+        GameException);
+}
+
+TEST(StateSnapshotTests, File_RoundTrip)
+{
+    TestContainer source(5);
+    source.Floats[3] = 42.0f;
+    source.Counter = 7;
+
+    auto const filePath = std::filesystem::temp_directory_path() / "StateSnapshotTests" / "Snapshot.bin";
+
+    TakeSnapshot(source).SaveToFile(filePath);
+
+    auto const snapshot = StateSnapshot::LoadFromFile(filePath);
+
+    TestContainer target(5);
+    RestoreSnapshot(snapshot, target);
+
+    EXPECT_EQ(42.0f, target.Floats[3]);
+    EXPECT_EQ(7u, target.Counter);
+
+    std::filesystem::remove_all(filePath.parent_path());
+}
+
+TEST(StateSnapshotTests, File_Missing_Throws)
+{
+    EXPECT_THROW(
+        StateSnapshot::LoadFromFile(std::filesystem::temp_directory_path() / "StateSnapshotTests_DoesNotExist.bin"),
+        GameException);
+}
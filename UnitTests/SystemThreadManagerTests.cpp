@@ -0,0 +1,113 @@
+#include <GameCore/SystemThreadManager.h>
+
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace /* anonymous */ {
+
+    using CpuIds = std::vector<SystemThreadManager::CpuIdType>;
+
+    // 2 performance cores with SMT (CPUs 0-3), followed by 2 efficiency cores (CPUs 4-5)
+    std::vector<SystemThreadManager::LogicalProcessor> MakeHybridTopology()
+    {
+        return {
+            { 0, 0, 1, false },
+            { 1, 0, 1, true },
+            { 2, 1, 1, false },
+            { 3, 1, 1, true },
+            { 4, 2, 0, false },
+            { 5, 3, 0, false }
+        };
+    }
+
+    // 3 cores with SMT
+    std::vector<SystemThreadManager::LogicalProcessor> MakeUniformTopology()
+    {
+        return {
+            { 0, 0, 0, false },
+            { 1, 0, 0, true },
+            { 2, 1, 0, false },
+            { 3, 1, 0, true },
+            { 4, 2, 0, false },
+            { 5, 2, 0, true }
+        };
+    }
+}
+
+TEST(SystemThreadManagerTests, ChooseProcessors_NoPolicies)
+{
+    for (auto const role : { SystemThreadManager::ThreadRole::Main, SystemThreadManager::ThreadRole::Simulation, SystemThreadManager::ThreadRole::Render })
+    {
+        EXPECT_FALSE(SystemThreadManager::ChooseProcessors(MakeHybridTopology(), role, SystemThreadManager::ThreadPolicies(), {}).has_value());
+    }
+}
+
+TEST(SystemThreadManagerTests, ChooseProcessors_Simulation_PrefersPhysicalPerformanceCores)
+{
+    SystemThreadManager::ThreadPolicies const policies(true, false, false);
+    auto const topology = MakeHybridTopology();
+
+    std::set<SystemThreadManager::CpuIdType> allocatedProcessors;
+    CpuIds chosen;
+
+    for (int t = 0; t < 6; ++t)
+    {
+        auto const cpuIds = SystemThreadManager::ChooseProcessors(topology, SystemThreadManager::ThreadRole::Simulation, policies, allocatedProcessors);
+        ASSERT_TRUE(cpuIds.has_value());
+        ASSERT_EQ(1u, cpuIds->size());
+
+        chosen.push_back(cpuIds->front());
+        allocatedProcessors.insert(cpuIds->front());
+    }
+
+    // Physical performance cores, then their SMT siblings, then efficiency cores
+    EXPECT_EQ(CpuIds({ 0, 2, 1, 3, 4, 5 }), chosen);
+
+    // Once all are taken, it's free to float
+    auto const cpuIds = SystemThreadManager::ChooseProcessors(topology, SystemThreadManager::ThreadRole::Simulation, policies, allocatedProcessors);
+    ASSERT_TRUE(cpuIds.has_value());
+    EXPECT_EQ(CpuIds({ 0, 1, 2, 3, 4, 5 }), *cpuIds);
+}
+
+TEST(SystemThreadManagerTests, ChooseProcessors_Hybrid_SeparatesRenderThread)
+{
+    SystemThreadManager::ThreadPolicies const policies(true, true, false);
+    auto const topology = MakeHybridTopology();
+
+    auto const renderCpuIds = SystemThreadManager::ChooseProcessors(topology, SystemThreadManager::ThreadRole::Render, policies, {});
+    ASSERT_TRUE(renderCpuIds.has_value());
+    EXPECT_EQ(CpuIds({ 4, 5 }), *renderCpuIds);
+
+    // Background threads stay off the performance cores
+    auto const otherCpuIds = SystemThreadManager::ChooseProcessors(topology, SystemThreadManager::ThreadRole::Other, policies, {});
+    ASSERT_TRUE(otherCpuIds.has_value());
+    EXPECT_EQ(CpuIds({ 4, 5 }), *otherCpuIds);
+
+    // Simulation threads only go to the render processors once all others are taken
+    auto const cpuIds = SystemThreadManager::ChooseProcessors(topology, SystemThreadManager::ThreadRole::Simulation, policies, { 0, 1, 2, 3 });
+    ASSERT_TRUE(cpuIds.has_value());
+    EXPECT_EQ(CpuIds({ 4 }), *cpuIds);
+}
+
+TEST(SystemThreadManagerTests, ChooseProcessors_Uniform_SeparatesRenderThreadOnLastCore)
+{
+    SystemThreadManager::ThreadPolicies const policies(false, true, false);
+    auto const topology = MakeUniformTopology();
+
+    auto const renderCpuIds = SystemThreadManager::ChooseProcessors(topology, SystemThreadManager::ThreadRole::Render, policies, {});
+    ASSERT_TRUE(renderCpuIds.has_value());
+    EXPECT_EQ(CpuIds({ 4, 5 }), *renderCpuIds);
+
+    // Simulation threads avoid the render core until they have no choice
+    auto const cpuIds1 = SystemThreadManager::ChooseProcessors(topology, SystemThreadManager::ThreadRole::Main, policies, {});
+    ASSERT_TRUE(cpuIds1.has_value());
+    EXPECT_EQ(CpuIds({ 0 }), *cpuIds1);
+
+    auto const cpuIds2 = SystemThreadManager::ChooseProcessors(topology, SystemThreadManager::ThreadRole::Simulation, policies, { 0, 1, 2, 3 });
+    ASSERT_TRUE(cpuIds2.has_value());
+    EXPECT_EQ(CpuIds({ 4 }), *cpuIds2);
+
+    // Not subject to any policy
+    EXPECT_FALSE(SystemThreadManager::ChooseProcessors(topology, SystemThreadManager::ThreadRole::Other, policies, {}).has_value());
+}
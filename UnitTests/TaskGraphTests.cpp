@@ -0,0 +1,256 @@
+#include <GameCore/GameException.h>
+#include <GameCore/TaskGraph.h>
+
+#include <algorithm>
+#include <atomic>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+TEST(TaskGraphTests, CalculatesWaves)
+{
+    TaskGraph graph;
+
+    auto const a = graph.AddTask("A", []() {});
+    auto const b = graph.AddTask("B", []() {});
+    auto const c = graph.AddTask("C", []() {}, { a });
+    auto const d = graph.AddTask("D", []() {}, { b, c });
+    auto const e = graph.AddTask("E", []() {}, { a });
+
+    auto const waves = graph.CalculateWaves();
+
+    ASSERT_EQ(3u, waves.size());
+    EXPECT_EQ(std::vector<TaskGraph::TaskId>({ a, b }), waves[0]);
+    EXPECT_EQ(std::vector<TaskGraph::TaskId>({ c, e }), waves[1]);
+    EXPECT_EQ(std::vector<TaskGraph::TaskId>({ d }), waves[2]);
+}
+
+TEST(TaskGraphTests, RunsDependenciesFirst)
+{
+    TaskThreadPool threadPool(4);
+
+    std::atomic<int> counter(0);
+    int aOrder = -1;
+    int bOrder = -1;
+    int cOrder = -1;
+
+    TaskGraph graph;
+    auto const a = graph.AddTask("A", [&]() { aOrder = counter++; });
+    auto const b = graph.AddTask("B", [&]() { bOrder = counter++; }, { a });
+    graph.AddTask("C", [&]() { cOrder = counter++; }, { b });
+
+    graph.Run(threadPool);
+
+    EXPECT_EQ(0, aOrder);
+    EXPECT_EQ(1, bOrder);
+    EXPECT_EQ(2, cOrder);
+}
+
+TEST(TaskGraphTests, RunsAllIndependentTasks)
+{
+    TaskThreadPool threadPool(4);
+
+    std::vector<int> results(20, 0);
+
+    TaskGraph graph;
+    for (size_t t = 0; t < results.size(); ++t)
+    {
+        graph.AddTask("T" + std::to_string(t), [&results, t]() { results[t] = static_cast<int>(t) + 1; });
+    }
+
+    graph.Run(threadPool);
+
+    for (size_t t = 0; t < results.size(); ++t)
+    {
+        EXPECT_EQ(static_cast<int>(t) + 1, results[t]);
+    }
+}
+
+TEST(TaskGraphTests, StopsAtFailedWave)
+{
+    TaskThreadPool threadPool(2);
+
+    bool hasRunB = false;
+    bool hasRunDependent = false;
+
+    TaskGraph graph;
+    auto const a = graph.AddTask("A", []() { throw GameException("Boom"); });
+    auto const b = graph.AddTask("B", [&]() { hasRunB = true; });
+    graph.AddTask("C", [&]() { hasRunDependent = true; }, { a, b });
+
+    try
+    {
+        graph.Run(threadPool);
+        FAIL();
+    }
+    catch (GameException const & ex)
+    {
+        EXPECT_EQ(std::string("Error running \"A\": Boom"), std::string(ex.what()));
+    }
+
+    EXPECT_TRUE(hasRunB);
+    EXPECT_FALSE(hasRunDependent);
+}
+
+TEST(TaskGraphTests, RunsRepeatedly_ReadingReboundArguments)
+{
+    TaskThreadPool threadPool(2);
+
+    int argument = 0;
+    int result = 0;
+
+    TaskGraph graph;
+    auto const valueResource = graph.AddResource("Value");
+
+    graph.AddStage(
+        "Check",
+        [&]()
+        {
+            if (argument < 0)
+                throw GameException("Negative");
+        },
+        { {}, {} });
+    graph.AddStage("Square", [&]() { result = argument * argument; }, { {}, { valueResource } });
+
+    argument = -1;
+    EXPECT_THROW(graph.Run(threadPool, false), GameException);
+
+    argument = 3;
+    graph.Run(threadPool, false);
+    EXPECT_EQ(9, result);
+
+    argument = 4;
+    graph.Run(threadPool, false);
+    EXPECT_EQ(16, result);
+
+    // Changes to the graph are seen by the next run
+    graph.AddStage("Increment", [&]() { result += 1; }, { {}, { valueResource } });
+
+    graph.Run(threadPool, false);
+    EXPECT_EQ(17, result);
+}
+
+TEST(TaskGraphTests, DerivesDependenciesFromResources)
+{
+    TaskGraph graph;
+
+    auto const water = graph.AddResource("Water");
+    auto const temperature = graph.AddResource("Temperature");
+    auto const light = graph.AddResource("Light");
+
+    auto const a = graph.AddStage("A", []() {}, { {}, { water } });
+    auto const b = graph.AddStage("B", []() {}, { {}, { light } });
+    auto const c = graph.AddStage("C", []() {}, { { water }, { temperature } });
+    auto const d = graph.AddStage("D", []() {}, { { water }, {} });
+    auto const e = graph.AddStage("E", []() {}, { {}, { water } }); // After readers C and D
+    auto const f = graph.AddStage("F", []() {}, { { light }, {} });
+
+    auto const waves = graph.CalculateWaves();
+
+    ASSERT_EQ(3u, waves.size());
+    EXPECT_EQ(std::vector<TaskGraph::TaskId>({ a, b }), waves[0]);
+    EXPECT_EQ(std::vector<TaskGraph::TaskId>({ c, d, f }), waves[1]);
+    EXPECT_EQ(std::vector<TaskGraph::TaskId>({ e }), waves[2]);
+}
+
+TEST(TaskGraphTests, RunsPartitionsConcurrently_MainThreadTasksOnePerWave)
+{
+    TaskGraph graph;
+
+    auto const light = graph.AddResource("Light");
+    auto const sparks = graph.AddResource("Sparks");
+
+    std::vector<TaskGraph::Task> partitions;
+    partitions.emplace_back([]() {});
+    partitions.emplace_back([]() {});
+
+    auto const a = graph.AddStage("A", []() {}, { {}, { sparks } }, false);
+    auto const m1 = graph.AddStage("M1", []() {}, { {}, {} }, true);
+    auto const p = graph.AddStage("P", std::move(partitions), { {}, { light } });
+    auto const m2 = graph.AddStage("M2", []() {}, { {}, {} }, true);
+
+    auto const waves = graph.CalculateWaves();
+
+    // Main thread tasks come first in their wave
+    ASSERT_EQ(2u, waves.size());
+    EXPECT_EQ(std::vector<TaskGraph::TaskId>({ m1, a, p, p + 1 }), waves[0]);
+    EXPECT_EQ(std::vector<TaskGraph::TaskId>({ m2 }), waves[1]);
+}
+
+TEST(TaskGraphTests, RunsStagesInDeclarationOrderSemantics)
+{
+    TaskThreadPool threadPool(4);
+
+    std::vector<int> buffer(100, 1);
+    int sum = 0;
+
+    TaskGraph graph;
+    auto const bufferResource = graph.AddResource("Buffer", buffer.data(), buffer.size() * sizeof(int));
+    auto const sumResource = graph.AddResource("Sum", &sum, sizeof(sum));
+
+    graph.AddStage("Double", [&]() { for (auto & v : buffer) v *= 2; }, { {}, { bufferResource } });
+    graph.AddStage("Sum", [&]() { for (auto v : buffer) sum += v; }, { { bufferResource }, { sumResource } });
+    graph.AddStage("Reset", [&]() { std::fill(buffer.begin(), buffer.end(), 0); }, { {}, { bufferResource } });
+
+    graph.SetAccessVerification(true);
+    graph.Run(threadPool, false);
+
+    EXPECT_EQ(200, sum);
+    EXPECT_EQ(std::vector<int>(100, 0), buffer);
+}
+
+TEST(TaskGraphTests, AccessVerification_DetectsUndeclaredWrite)
+{
+    TaskThreadPool threadPool(2);
+
+    std::vector<float> buffer(16, 0.0f);
+
+    TaskGraph graph;
+    auto const bufferResource = graph.AddResource("Buffer", buffer.data(), buffer.size() * sizeof(float));
+
+    graph.AddStage("Reader", [&]() { buffer[3] = 1.0f; }, { { bufferResource }, {} });
+
+    graph.SetAccessVerification(true);
+
+    try
+    {
+        graph.Run(threadPool, false);
+        FAIL();
+    }
+    catch (GameException const & ex)
+    {
+        EXPECT_EQ(std::string("Error running \"Reader\": wrote undeclared resource \"Buffer\""), std::string(ex.what()));
+    }
+}
+
+TEST(TaskGraphTests, TaskObserver_SeesEachTaskAfterItRuns)
+{
+    TaskThreadPool threadPool(2);
+
+    int value = 0;
+
+    TaskGraph graph;
+    auto const valueResource = graph.AddResource("Value");
+
+    graph.AddStage("Set", [&]() { value = 5; }, { {}, { valueResource } });
+    graph.AddStage("Double", [&]() { value *= 2; }, { {}, { valueResource } });
+    graph.AddStage("Increment", [&]() { value += 1; }, { {}, { valueResource } });
+
+    std::vector<std::pair<std::string, int>> observations;
+    graph.SetTaskObserver(
+        [&](std::string const & taskName)
+        {
+            observations.emplace_back(taskName, value);
+        });
+
+    graph.Run(threadPool, false);
+
+    std::vector<std::pair<std::string, int>> const expected{
+        { "Set", 5 },
+        { "Double", 10 },
+        { "Increment", 11 } };
+
+    EXPECT_EQ(expected, observations);
+}
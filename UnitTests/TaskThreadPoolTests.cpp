@@ -2,6 +2,8 @@
 
 #include <algorithm>
 #include <functional>
+#include <stdexcept>
+#include <tuple>
 #include <vector>
 
 #include "gtest/gtest.h"
@@ -90,4 +92,168 @@ TEST_P(TaskThreadPoolTests_FourRuns, Four_Runs)
     t.Run(tasks);
 
     ASSERT_TRUE(std::all_of(results.cbegin(), results.cend(), [](bool b) { return b; }));
-}
\ No newline at end of file
+}
+class TaskThreadPoolTests_ParallelFor : public testing::TestWithParam<std::tuple<size_t, size_t, size_t>>
+{
+public:
+    virtual void SetUp() {}
+    virtual void TearDown() {}
+};
+
+INSTANTIATE_TEST_SUITE_P(
+    ParallelFor,
+    TaskThreadPoolTests_ParallelFor,
+    ::testing::Values(
+        std::make_tuple(1, 0, 1),
+        std::make_tuple(1, 1, 1),
+        std::make_tuple(1, 1000, 7),
+        std::make_tuple(4, 0, 1),
+        std::make_tuple(4, 1, 1),
+        std::make_tuple(4, 2, 1),
+        std::make_tuple(4, 1000, 1),
+        std::make_tuple(4, 1000, 64),
+        std::make_tuple(4, 100000, 1),
+        std::make_tuple(4, 100000, 100000)
+    ));
+
+TEST_P(TaskThreadPoolTests_ParallelFor, ParallelFor)
+{
+    size_t const elementCount = std::get<1>(GetParam());
+    size_t const grain = std::get<2>(GetParam());
+
+    std::vector<int> results(elementCount, 0);
+
+    TaskThreadPool t(std::get<0>(GetParam()));
+
+    // Run multiple times, to exercise reuse of the pool
+    for (int r = 0; r < 3; ++r)
+    {
+        t.ParallelFor(
+            0,
+            elementCount,
+            grain,
+            [&results](size_t chunkStart, size_t chunkEnd)
+            {
+                for (size_t i = chunkStart; i < chunkEnd; ++i)
+                {
+                    ++results[i];
+                }
+            });
+
+        ASSERT_TRUE(std::all_of(results.cbegin(), results.cend(), [r](int v) { return v == r + 1; }));
+    }
+}
+
+TEST(TaskThreadPoolTests, ParallelFor_InterleavedWithRun)
+{
+    TaskThreadPool t(4);
+
+    std::vector<int> results(500, 0);
+
+    std::vector<TaskThreadPool::Task> tasks;
+    for (size_t i = 0; i < 10; ++i)
+    {
+        tasks.emplace_back(
+            [&results, idx = i]()
+            {
+                ++results[idx];
+            });
+    }
+
+    for (int r = 0; r < 50; ++r)
+    {
+        t.Run(tasks);
+
+        t.ParallelFor(
+            10,
+            results.size(),
+            3,
+            [&results](size_t chunkStart, size_t chunkEnd)
+            {
+                for (size_t i = chunkStart; i < chunkEnd; ++i)
+                {
+                    ++results[i];
+                }
+            });
+    }
+
+    EXPECT_TRUE(std::all_of(results.cbegin(), results.cend(), [](int v) { return v == 50; }));
+}
+
+TEST(TaskThreadPoolTests, ParallelFor_Nested)
+{
+    TaskThreadPool t(4);
+
+    std::vector<int> results(64 * 64, 0);
+
+    t.ParallelFor(
+        0,
+        64,
+        1,
+        [&](size_t outerStart, size_t outerEnd)
+        {
+            for (size_t o = outerStart; o < outerEnd; ++o)
+            {
+                t.ParallelFor(
+                    0,
+                    64,
+                    1,
+                    [&results, o](size_t innerStart, size_t innerEnd)
+                    {
+                        for (size_t i = innerStart; i < innerEnd; ++i)
+                        {
+                            ++results[o * 64 + i];
+                        }
+                    });
+            }
+        });
+
+    EXPECT_TRUE(std::all_of(results.cbegin(), results.cend(), [](int v) { return v == 1; }));
+}
+
+TEST(TaskThreadPoolTests, ParallelFor_Throwing_RethrowsAfterAllChunks)
+{
+    TaskThreadPool t(4);
+
+    std::vector<int> results(256, 0);
+
+    auto const runThrowing = [&]()
+    {
+        t.ParallelFor(
+            0,
+            results.size(),
+            1,
+            [&results](size_t chunkStart, size_t chunkEnd)
+            {
+                for (size_t i = chunkStart; i < chunkEnd; ++i)
+                {
+                    ++results[i];
+
+                    if (i % 64 == 7)
+                    {
+                        throw std::runtime_error("Chunk failure");
+                    }
+                }
+            });
+    };
+
+    EXPECT_THROW(runThrowing(), std::runtime_error);
+
+    // All chunks have run
+    EXPECT_TRUE(std::all_of(results.cbegin(), results.cend(), [](int v) { return v == 1; }));
+
+    // The pool is still usable, and the exception is not rethrown again
+    t.ParallelFor(
+        0,
+        results.size(),
+        1,
+        [&results](size_t chunkStart, size_t chunkEnd)
+        {
+            for (size_t i = chunkStart; i < chunkEnd; ++i)
+            {
+                ++results[i];
+            }
+        });
+
+    EXPECT_TRUE(std::all_of(results.cbegin(), results.cend(), [](int v) { return v == 2; }));
+}
@@ -1,5 +1,6 @@
 #include <GameCore/TaskThread.h>
 
+#include <atomic>
 #include <thread>
 
 #include "gtest/gtest.h"
@@ -39,6 +40,38 @@ TEST(TaskThreadTests, Asynchronous)
     EXPECT_TRUE(isDone);
 }
 
+TEST(TaskThreadTests, IsCompleted)
+{
+    TaskThread t;
+
+    // Without a thread, the task would run - and block - right away
+    std::atomic<bool> isReleased(!t.HasThread());
+    auto tc = t.QueueTask(
+        [&isReleased]()
+        {
+            while (!isReleased)
+            {
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            }
+        });
+
+    if (t.HasThread())
+    {
+        EXPECT_FALSE(tc->IsCompleted());
+    }
+
+    isReleased = true;
+
+    for (int i = 0; !tc->IsCompleted() && i < 100; ++i)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    }
+
+    EXPECT_TRUE(tc->IsCompleted());
+
+    tc->Wait();
+}
+
 TEST(TaskThreadTests, RunSynchronously)
 {
     TaskThread t;
@@ -0,0 +1,188 @@
+#include <Game/TelemetrySink.h>
+
+#include <Game/ShipMetadata.h>
+
+#include <GameCore/Profiler.h>
+#include <GameCore/Utils.h>
+
+#include <filesystem>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace {
+
+    bool StartsWith(
+        std::string const & str,
+        std::string const & prefix)
+    {
+        return str.compare(0, prefix.size(), prefix) == 0;
+    }
+}
+
+TEST(TelemetrySinkTests, NotStarted_RecordsNothing)
+{
+    TelemetrySink sink;
+
+    EXPECT_FALSE(sink.IsStarted());
+
+    // Must not crash
+    sink.OnFrameRateUpdated(60.0f, 59.0f);
+    sink.OnSinkingBegin(1);
+    sink.RecordPerfStats(PerfStats());
+    sink.Flush();
+    sink.Stop();
+}
+
+TEST(TelemetrySinkTests, StreamsLineProtocol)
+{
+    auto const filePath = std::filesystem::temp_directory_path() / "TelemetrySinkTests_Stream.txt";
+
+    {
+        TelemetrySink sink;
+
+        sink.Start(filePath);
+        EXPECT_TRUE(sink.IsStarted());
+
+        sink.OnFrameRateUpdated(60.0f, 59.5f);
+        sink.OnShipLoaded(3, ShipMetadata("My Ship, \"The\" One"));
+        sink.OnSinkingBegin(3);
+        sink.OnStormBegin();
+        sink.RecordPerfStats(PerfStats());
+        sink.Flush();
+
+        sink.Stop();
+        EXPECT_FALSE(sink.IsStarted());
+
+        // Ignored after stopping
+        sink.OnSinkingEnd(3);
+    }
+
+    auto const lines = Utils::LoadTextFileLines(filePath);
+    std::filesystem::remove(filePath);
+
+    ASSERT_EQ(lines.size(), 5u);
+    EXPECT_TRUE(StartsWith(lines[0], "frame_rate immediate=60,average=59.5 "));
+    EXPECT_TRUE(StartsWith(lines[1], "event,type=ship_loaded,ship=3 name=\"My Ship, \\\"The\\\" One\" "));
+    EXPECT_TRUE(StartsWith(lines[2], "event,type=sinking_begin,ship=3 count=1i "));
+    EXPECT_TRUE(StartsWith(lines[3], "event,type=storm_begin count=1i "));
+    EXPECT_TRUE(StartsWith(lines[4], "perf update_ms=0,"));
+}
+
+TEST(TelemetrySinkTests, RecordPerfStats_ShipsAndStages)
+{
+    auto const filePath = std::filesystem::temp_directory_path() / "TelemetrySinkTests_ShipPerf.txt";
+
+    PerfStats perfStats;
+    perfStats.EnsureShipCount(2);
+
+    // Ship 0 not updated; ship 1 updated twice, running a single stage
+    perfStats.Ships[1].UpdateDuration.Update(std::chrono::milliseconds(2));
+    perfStats.Ships[1].UpdateDuration.Update(std::chrono::milliseconds(4));
+    perfStats.Ships[1].StageDurations[static_cast<size_t>(PerfStats::ShipUpdateStageType::Strains)].Update(std::chrono::milliseconds(1));
+    perfStats.Ships[1].StageDurations[static_cast<size_t>(PerfStats::ShipUpdateStageType::Strains)].Update(std::chrono::milliseconds(1));
+    perfStats.Ships[1].LiveSprings.Update(10);
+    perfStats.Ships[1].LiveSprings.Update(20);
+
+    {
+        TelemetrySink sink;
+
+        sink.Start(filePath);
+        sink.RecordPerfStats(perfStats);
+        sink.Stop();
+    }
+
+    auto const lines = Utils::LoadTextFileLines(filePath);
+    std::filesystem::remove(filePath);
+
+    ASSERT_EQ(lines.size(), 3u);
+    EXPECT_TRUE(StartsWith(lines[0], "perf "));
+    EXPECT_TRUE(StartsWith(lines[1], "ship_perf,ship=1 update_ms=3,live_points=0,live_springs=15,"));
+    EXPECT_TRUE(StartsWith(lines[2], "ship_stage,ship=1,stage=Strains ms=1,count=2i "));
+}
+
+TEST(TelemetrySinkTests, PerfStatsDelta_IncludesShipsAddedSince)
+{
+    PerfStats earlier;
+    earlier.EnsureShipCount(1);
+    earlier.Ships[0].UpdateDuration.Update(std::chrono::milliseconds(1));
+
+    PerfStats later = earlier;
+    later.EnsureShipCount(2);
+    later.Ships[0].UpdateDuration.Update(std::chrono::milliseconds(3));
+    later.Ships[1].UpdateDuration.Update(std::chrono::milliseconds(5));
+
+    PerfStats const delta = later - earlier;
+
+    ASSERT_EQ(delta.Ships.size(), 2u);
+    EXPECT_EQ(delta.Ships[0].UpdateDuration.GetCount(), 1u);
+    EXPECT_FLOAT_EQ(delta.Ships[0].UpdateDuration.ToRatio<std::chrono::milliseconds>(), 3.0f);
+    EXPECT_EQ(delta.Ships[1].UpdateDuration.GetCount(), 1u);
+    EXPECT_FLOAT_EQ(delta.Ships[1].UpdateDuration.ToRatio<std::chrono::milliseconds>(), 5.0f);
+}
+
+TEST(TelemetrySinkTests, Stop_FlushesPendingLines)
+{
+    auto const filePath = std::filesystem::temp_directory_path() / "TelemetrySinkTests_Stop.txt";
+
+    {
+        TelemetrySink sink;
+
+        sink.Start(filePath);
+        sink.OnLightning();
+    }
+
+    auto const lines = Utils::LoadTextFileLines(filePath);
+    std::filesystem::remove(filePath);
+
+    ASSERT_EQ(lines.size(), 1u);
+    EXPECT_TRUE(StartsWith(lines[0], "event,type=lightning count=1i "));
+}
+
+TEST(TelemetrySinkTests, RecordProfilerZones_OnlyNewZones)
+{
+    auto const filePath = std::filesystem::temp_directory_path() / "TelemetrySinkTests_Zones.txt";
+
+    Profiler::GetInstance().Clear();
+    Profiler::GetInstance().SetEnabled(true);
+
+    {
+        FS_PROFILE_SCOPE("TelemetrySinkTests_Before");
+    }
+
+    {
+        TelemetrySink sink;
+        sink.Start(filePath);
+
+        {
+            FS_PROFILE_SCOPE("TelemetrySinkTests Zone");
+        }
+
+        {
+            FS_PROFILE_SCOPE("TelemetrySinkTests Zone");
+        }
+
+        sink.RecordProfilerZones();
+
+        // Nothing new
+        sink.RecordProfilerZones();
+
+        sink.Stop();
+    }
+
+    Profiler::GetInstance().SetEnabled(false);
+
+    auto const lines = Utils::LoadTextFileLines(filePath);
+    std::filesystem::remove(filePath);
+
+    ASSERT_EQ(lines.size(), 1u);
+    EXPECT_TRUE(StartsWith(lines[0], "zone,name=TelemetrySinkTests\\ Zone total_ms="));
+    EXPECT_NE(lines[0].find(",count=2i "), std::string::npos);
+}
+
+TEST(TelemetrySinkTests, EscapeTagValue)
+{
+    EXPECT_EQ(TelemetrySink::EscapeTagValue("a b,c=d"), "a\\ b\\,c\\=d");
+    EXPECT_EQ(TelemetrySink::EscapeTagValue("plain"), "plain");
+}
@@ -2,6 +2,11 @@
 
 #include <Game/TextureTypes.h>
 
+#include <algorithm>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
 #include "gtest/gtest.h"
 
 namespace Render {
@@ -209,4 +214,96 @@ TEST(TextureAtlasTests, RegularAtlas)
     EXPECT_EQ(128 + 64, atlasSpecification.TexturePositions[15].FrameBottomY);
 }
 
-}
\ No newline at end of file
+namespace /* anonymous */ {
+
+    template<typename TSpecification, typename TTextureInfo>
+    void VerifyPacking(
+        TSpecification const & atlasSpecification,
+        std::vector<TTextureInfo> const & textureInfos)
+    {
+        ASSERT_EQ(textureInfos.size(), atlasSpecification.TexturePositions.size());
+
+        std::vector<std::pair<ImageCoordinates, ImageSize>> rects;
+        for (auto const & position : atlasSpecification.TexturePositions)
+        {
+            auto const it = std::find_if(
+                textureInfos.cbegin(),
+                textureInfos.cend(),
+                [&position](auto const & ti)
+                {
+                    return ti.FrameId == position.FrameId;
+                });
+
+            ASSERT_NE(it, textureInfos.cend());
+
+            // In bounds
+            EXPECT_GE(position.FrameLeftX, 0);
+            EXPECT_GE(position.FrameBottomY, 0);
+            EXPECT_LE(position.FrameLeftX + it->Size.width, atlasSpecification.AtlasSize.width);
+            EXPECT_LE(position.FrameBottomY + it->Size.height, atlasSpecification.AtlasSize.height);
+
+            rects.emplace_back(ImageCoordinates(position.FrameLeftX, position.FrameBottomY), it->Size);
+        }
+
+        // No overlaps
+        for (size_t r1 = 0; r1 < rects.size(); ++r1)
+        {
+            for (size_t r2 = r1 + 1; r2 < rects.size(); ++r2)
+            {
+                bool const isDisjoint =
+                    rects[r1].first.x + rects[r1].second.width <= rects[r2].first.x
+                    || rects[r2].first.x + rects[r2].second.width <= rects[r1].first.x
+                    || rects[r1].first.y + rects[r1].second.height <= rects[r2].first.y
+                    || rects[r2].first.y + rects[r2].second.height <= rects[r1].first.y;
+
+                EXPECT_TRUE(isDisjoint);
+            }
+        }
+    }
+}
+
+TEST(TextureAtlasTests, Packing_NonMipMappable_IdenticalFramesFillAtlas)
+{
+    std::vector<TextureAtlasBuilder<CloudTextureGroups>::TextureInfo> textureInfos;
+    for (TextureFrameIndex f = 0; f < 32; ++f)
+    {
+        textureInfos.emplace_back(TextureFrameId<CloudTextureGroups>(CloudTextureGroups::Cloud, f), ImageSize(64, 32));
+    }
+
+    auto atlasSpecification = TextureAtlasBuilder<CloudTextureGroups>::BuildAtlasSpecification(textureInfos);
+
+    EXPECT_EQ(256, atlasSpecification.AtlasSize.width);
+    EXPECT_EQ(256, atlasSpecification.AtlasSize.height);
+
+    VerifyPacking(atlasSpecification, textureInfos);
+}
+
+TEST(TextureAtlasTests, Packing_NonMipMappable_MixedFrames)
+{
+    // Deterministic sizes in [8, 200)
+    std::uint32_t seed = 42;
+    auto const nextSize = [&seed]()
+    {
+        seed = seed * 1664525u + 1013904223u;
+        return 8 + static_cast<int>((seed >> 16) % 192);
+    };
+
+    std::vector<TextureAtlasBuilder<CloudTextureGroups>::TextureInfo> textureInfos;
+    size_t totalArea = 0;
+    for (TextureFrameIndex f = 0; f < 100; ++f)
+    {
+        ImageSize const size(nextSize(), nextSize());
+        textureInfos.emplace_back(TextureFrameId<CloudTextureGroups>(CloudTextureGroups::Cloud, f), size);
+        totalArea += size.GetLinearSize();
+    }
+
+    auto atlasSpecification = TextureAtlasBuilder<CloudTextureGroups>::BuildAtlasSpecification(textureInfos);
+
+    VerifyPacking(atlasSpecification, textureInfos);
+
+    // Power-of-two sides alone may waste up to three quarters of the atlas
+    float const density = static_cast<float>(totalArea) / static_cast<float>(atlasSpecification.AtlasSize.GetLinearSize());
+    EXPECT_GE(density, 0.45f);
+}
+
+}
@@ -0,0 +1,111 @@
+#include <GameCore/TextureCompression.h>
+
+#include <GameCore/TaskThreadPool.h>
+
+#include <algorithm>
+#include <cstdlib>
+
+#include "gtest/gtest.h"
+
+namespace /* anonymous */ {
+
+    RgbaImageData MakeGradientImage(ImageSize const & size)
+    {
+        RgbaImageData image(size);
+        for (int y = 0; y < size.height; ++y)
+        {
+            for (int x = 0; x < size.width; ++x)
+            {
+                image.Data[y * size.width + x] = rgbaColor(
+                    static_cast<rgbaColor::data_type>(x * 255 / std::max(size.width - 1, 1)),
+                    static_cast<rgbaColor::data_type>(y * 255 / std::max(size.height - 1, 1)),
+                    static_cast<rgbaColor::data_type>(128),
+                    static_cast<rgbaColor::data_type>(((x / 3) % 2 == 0) ? 255 : 0));
+            }
+        }
+
+        return image;
+    }
+
+    int MaxChannelError(
+        RgbaImageData const & expected,
+        RgbaImageData const & actual,
+        bool doIgnoreTransparentColors)
+    {
+        int maxError = 0;
+        for (size_t p = 0; p < expected.Size.GetLinearSize(); ++p)
+        {
+            auto const & e = expected.Data[p];
+            auto const & a = actual.Data[p];
+
+            maxError = std::max(maxError, std::abs(static_cast<int>(e.a) - static_cast<int>(a.a)));
+
+            if (!doIgnoreTransparentColors || e.a > 0)
+            {
+                maxError = std::max(maxError, std::abs(static_cast<int>(e.r) - static_cast<int>(a.r)));
+                maxError = std::max(maxError, std::abs(static_cast<int>(e.g) - static_cast<int>(a.g)));
+                maxError = std::max(maxError, std::abs(static_cast<int>(e.b) - static_cast<int>(a.b)));
+            }
+        }
+
+        return maxError;
+    }
+}
+
+TEST(TextureCompressionTests, BC3_SolidColor)
+{
+    RgbaImageData image(ImageSize(8, 4));
+    std::fill_n(image.Data.get(), image.Size.GetLinearSize(), rgbaColor(200, 100, 50, 180));
+
+    auto const compressed = TextureCompression::CompressBC3(image);
+    EXPECT_EQ(2u * TextureCompression::BC3BlockByteSize, compressed.Data.size());
+
+    auto const decompressed = TextureCompression::DecompressBC3(compressed);
+
+    // Only the 565 quantization error
+    EXPECT_LE(MaxChannelError(image, decompressed, false), 4);
+}
+
+TEST(TextureCompressionTests, BC3_Gradient_NonMultipleOfBlockSize)
+{
+    auto const image = MakeGradientImage(ImageSize(37, 21));
+
+    auto const compressed = TextureCompression::CompressBC3(image);
+    EXPECT_EQ(10u * 6u * TextureCompression::BC3BlockByteSize, compressed.Data.size());
+
+    auto const decompressed = TextureCompression::DecompressBC3(compressed);
+    ASSERT_EQ(image.Size, decompressed.Size);
+
+    // Alpha is binary, hence exact; colors are smooth within each block
+    EXPECT_LE(MaxChannelError(image, decompressed, true), 16);
+}
+
+TEST(TextureCompressionTests, BC3_ParallelMatchesSequential)
+{
+    auto const image = MakeGradientImage(ImageSize(300, 200));
+
+    TaskThreadPool taskThreadPool(4);
+
+    auto const sequential = TextureCompression::CompressBC3(image);
+    auto const parallel = TextureCompression::CompressBC3(image, &taskThreadPool);
+
+    EXPECT_EQ(sequential.Data, parallel.Data);
+}
+
+TEST(TextureCompressionTests, BC3_Mipmapped)
+{
+    auto const image = MakeGradientImage(ImageSize(64, 16));
+
+    auto const levels = TextureCompression::CompressMipmappedBC3(image);
+
+    ASSERT_EQ(7u, levels.size());
+    EXPECT_EQ(ImageSize(64, 16), levels[0].Size);
+    EXPECT_EQ(ImageSize(32, 8), levels[1].Size);
+    EXPECT_EQ(ImageSize(4, 1), levels[4].Size);
+    EXPECT_EQ(ImageSize(1, 1), levels[6].Size);
+
+    for (auto const & level : levels)
+    {
+        EXPECT_EQ(static_cast<size_t>((level.Size.width + 3) / 4 * ((level.Size.height + 3) / 4)) * TextureCompression::BC3BlockByteSize, level.Data.size());
+    }
+}
@@ -0,0 +1,147 @@
+#include <ShipBuilderLib/WaterlineAnalyzer.h>
+
+#include "Utils.h"
+
+#include "gtest/gtest.h"
+
+namespace ShipBuilder {
+
+namespace {
+
+    class TestModel final : public IModelObservable
+    {
+    public:
+
+        explicit TestModel(ShipSpaceSize const & shipSize)
+            : mShipSize(shipSize)
+            , mStructuralLayer(shipSize)
+            , mShipMetadata("Test")
+            , mShipPhysicsData()
+            , mShipAutoTexturizationSettings()
+        {}
+
+        void Fill(
+            ShipSpaceRect const & rect,
+            StructuralMaterial const * material)
+        {
+            for (int y = rect.origin.y; y < rect.origin.y + rect.size.height; ++y)
+            {
+                for (int x = rect.origin.x; x < rect.origin.x + rect.size.width; ++x)
+                {
+                    mStructuralLayer.Buffer[ShipSpaceCoordinates(x, y)] = StructuralElement(material);
+                }
+            }
+        }
+
+        ShipSpaceSize const & GetShipSize() const override { return mShipSize; }
+        bool HasLayer(LayerType layer) const override { return layer == LayerType::Structural; }
+        bool IsDirty() const override { return false; }
+        bool IsLayerDirty(LayerType) const override { return false; }
+        ShipMetadata const & GetShipMetadata() const override { return mShipMetadata; }
+        ShipPhysicsData const & GetShipPhysicsData() const override { return mShipPhysicsData; }
+        std::optional<ShipAutoTexturizationSettings> const & GetShipAutoTexturizationSettings() const override { return mShipAutoTexturizationSettings; }
+        StructuralLayerData const & GetStructuralLayer() const override { return mStructuralLayer; }
+
+        ModelMacroProperties GetModelMacroProperties() const override
+        {
+            size_t count = 0;
+            float totalMass = 0.0f;
+            vec2f centerOfMass = vec2f::zero();
+            for (int y = 0; y < mShipSize.height; ++y)
+            {
+                for (int x = 0; x < mShipSize.width; ++x)
+                {
+                    auto const * material = mStructuralLayer.Buffer[ShipSpaceCoordinates(x, y)].Material;
+                    if (material != nullptr)
+                    {
+                        ++count;
+                        totalMass += material->GetMass();
+                        centerOfMass += ShipSpaceCoordinates(x, y).ToFloat() * material->GetMass();
+                    }
+                }
+            }
+
+            return ModelMacroProperties(
+                count,
+                totalMass,
+                count != 0 ? std::optional<vec2f>(centerOfMass / totalMass) : std::nullopt);
+        }
+
+    private:
+
+        ShipSpaceSize const mShipSize;
+        StructuralLayerData mStructuralLayer;
+        ShipMetadata mShipMetadata;
+        ShipPhysicsData mShipPhysicsData;
+        std::optional<ShipAutoTexturizationSettings> mShipAutoTexturizationSettings;
+    };
+
+    void RunToCompletion(WaterlineAnalyzer & analyzer)
+    {
+        for (int i = 0; i < 10000; ++i)
+        {
+            if (analyzer.Update())
+                return;
+        }
+
+        FAIL() << "Analysis did not complete";
+    }
+}
+
+TEST(WaterlineAnalyzerTests, EmptyModel)
+{
+    TestModel model(ShipSpaceSize(10, 10));
+
+    WaterlineAnalyzer analyzer(model);
+
+    EXPECT_TRUE(analyzer.Update());
+    EXPECT_FALSE(analyzer.GetWaterline().has_value());
+}
+
+TEST(WaterlineAnalyzerTests, FullySubmergedBuoyancy)
+{
+    StructuralMaterial material = MakeTestStructuralMaterial("Foo", rgbColor(1, 2, 3));
+    material.BuoyancyVolumeFill = 0.5f;
+
+    TestModel model(ShipSpaceSize(30, 20));
+    model.Fill(ShipSpaceRect(ShipSpaceCoordinates(5, 2), ShipSpaceSize(10, 4)), &material);
+
+    WaterlineAnalyzer analyzer(model);
+
+    EXPECT_FALSE(analyzer.Update());
+
+    ASSERT_TRUE(analyzer.GetTotalBuoyantForceWhenFullySubmerged().has_value());
+    EXPECT_FLOAT_EQ(40.0f * 1000.0f * 0.5f, *analyzer.GetTotalBuoyantForceWhenFullySubmerged());
+}
+
+TEST(WaterlineAnalyzerTests, SymmetricFloatingBox)
+{
+    // Half as dense as water
+    StructuralMaterial material = MakeTestStructuralMaterial("Foo", rgbColor(1, 2, 3));
+    material.NominalMass = 500.0f;
+    material.BuoyancyVolumeFill = 1.0f;
+
+    TestModel model(ShipSpaceSize(60, 40));
+    model.Fill(ShipSpaceRect(ShipSpaceCoordinates(10, 10), ShipSpaceSize(40, 20)), &material);
+
+    WaterlineAnalyzer analyzer(model);
+    RunToCompletion(analyzer);
+
+    ASSERT_TRUE(analyzer.GetWaterline().has_value());
+    ASSERT_TRUE(analyzer.GetTotalBuoyantForce().has_value());
+    ASSERT_TRUE(analyzer.GetCenterOfBuoyancy().has_value());
+
+    // Level
+    EXPECT_NEAR(0.0f, analyzer.GetWaterline()->WaterDirection.x, 0.01f);
+    EXPECT_NEAR(-1.0f, analyzer.GetWaterline()->WaterDirection.y, 0.01f);
+
+    // Displaces its own mass, give or take a row
+    float const totalMass = analyzer.GetModelMacroProperties().TotalMass;
+    EXPECT_NEAR(totalMass, *analyzer.GetTotalBuoyantForce(), 40.0f * 1000.0f);
+
+    // Buoyancy under the center of mass
+    EXPECT_NEAR(analyzer.GetModelMacroProperties().CenterOfMass->x, analyzer.GetCenterOfBuoyancy()->x, 0.5f);
+    EXPECT_LT(analyzer.GetCenterOfBuoyancy()->y, analyzer.GetModelMacroProperties().CenterOfMass->y);
+}
+
+}